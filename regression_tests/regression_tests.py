@@ -29,9 +29,17 @@ regression_dict = {'id': [], 'source': [], 'target': [], 'error': []}
 timing_dict = {'command':[], 'average_time': [], 'num_runs': []}
 time_pkl_file = baseline_path+'timing_data.pkl'
 
+# Performance mode: wall time and peak RSS of the expensive remapping steps
+perf_stages = ['GenerateOverlapMesh', 'GenerateOfflineMap', 'ApplyOfflineMap']
+perf_dict = {'stage': [], 'command': [], 'wall_time': [], 'peak_rss_mb': []}
+perf_pkl_file = baseline_path+'perf_data.pkl'
+
 timing_objects = []
 generate_baseline = False
 baseline_average = False
+perf_mode = False
+perf_threshold = 20.0
+rss_threshold = 10.0
 verbose=False
 
 exitsTimeFile = True
@@ -98,6 +106,84 @@ def populate_timing_data(cmd, t, loc):
         timing_dict['average_time'].append(t)
         timing_dict['num_runs'].append(1)
 
+# record wall time and peak RSS of the steps tracked in performance mode
+def populate_perf_data(cmd, t, rss):
+    if not perf_mode:
+        return
+
+    # remove the bin path from the command, as for the timing data
+    stage = os.path.basename(cmd[0])
+    if stage not in perf_stages:
+        return
+
+    mycmd = stage
+    for j in range(1, len(cmd)):
+        mycmd+=" "+cmd[j]
+
+    perf_dict['stage'].append(stage)
+    perf_dict['command'].append(mycmd)
+    perf_dict['wall_time'].append(t)
+    perf_dict['peak_rss_mb'].append(rss)
+
+# compare performance data against the performance baseline and
+# return the number of commands that regressed beyond the thresholds
+def compare_perf_data():
+    try:
+        df_base = pickle.load(open(perf_pkl_file, 'rb'))
+    except (OSError, EOFError, IOError) as e:
+        print("performance baseline ", perf_pkl_file, " not found")
+        print("Generate it using: python regression_tests.py -g --perf")
+        raise
+
+    perfcomp_dict = {'stage':[], 'command':[], 'base_time':[], 'time':[], 'time_diff':[],
+                     'base_rss_mb':[], 'rss_mb':[], 'rss_diff':[], 'flagged':[]}
+
+    nflagged = 0
+    for j in range(len(perf_dict['command'])):
+        m = np.where(df_base['command']==perf_dict['command'][j])
+        if (m[0].size == 0):
+            print("performance baseline does not have the command (skipped): \n", perf_dict['command'][j])
+            continue
+        val=m[0][0]
+
+        base_time = df_base['wall_time'][val]
+        base_rss = df_base['peak_rss_mb'][val]
+        time_diff = (perf_dict['wall_time'][j] - base_time)*100/base_time
+        rss_diff = (perf_dict['peak_rss_mb'][j] - base_rss)*100/base_rss
+
+        flagged = (time_diff > perf_threshold) or (rss_diff > rss_threshold)
+        if flagged:
+            nflagged += 1
+
+        perfcomp_dict['stage'].append(perf_dict['stage'][j])
+        perfcomp_dict['command'].append(perf_dict['command'][j])
+        perfcomp_dict['base_time'].append(base_time)
+        perfcomp_dict['time'].append(perf_dict['wall_time'][j])
+        perfcomp_dict['time_diff'].append(time_diff)
+        perfcomp_dict['base_rss_mb'].append(base_rss)
+        perfcomp_dict['rss_mb'].append(perf_dict['peak_rss_mb'][j])
+        perfcomp_dict['rss_diff'].append(rss_diff)
+        perfcomp_dict['flagged'].append(flagged)
+
+    dfperf = pd.DataFrame(perfcomp_dict)
+
+    print('\nPerformance against baselines (time threshold %.1f%%, rss threshold %.1f%%)' % (perf_threshold, rss_threshold))
+    for j in range(dfperf.shape[0]):
+        print('%s %-20s time %9.3f s -> %9.3f s (%+7.1f%%)  rss %9.1f MB -> %9.1f MB (%+7.1f%%)  %s' % (
+            "SLOWER" if dfperf['flagged'][j] else "      ",
+            dfperf['stage'][j],
+            dfperf['base_time'][j], dfperf['time'][j], dfperf['time_diff'][j],
+            dfperf['base_rss_mb'][j], dfperf['rss_mb'][j], dfperf['rss_diff'][j],
+            dfperf['command'][j][len(dfperf['stage'][j])+1:]))
+
+    # saving the dataframe
+    perfcomp_pkl_file = perf_pkl_file.replace('perf_data', 'perfcomp')
+    with open(perfcomp_pkl_file, 'wb') as perfcomp_file:
+        pickle.dump(dfperf, perfcomp_file)
+    print("\n Saved", perfcomp_pkl_file, "file")
+
+    return nflagged
+
 # a function to run a command and
 # parse the output. 
 def run_command(cmd):
@@ -113,17 +199,26 @@ def run_command(cmd):
     # cmd = "time "+ cmd
     if verbose:
         print("Running:", cmd,)
-    temp = subprocess.Popen(cmd, shell=True, stdout = subprocess.PIPE)
     timeStarted = time.time()         
+    temp = subprocess.Popen(cmd, shell=True, stdout = subprocess.PIPE)
 
     # TODO: dump each command line output to file(s)
     res = []
     success = True
 
-    # use the communicate function to fetch the output
-    output, errs = temp.communicate()
+    # read the output and reap the child with wait4 so that the resource
+    # usage (peak RSS) of this command alone is available
+    output = temp.stdout.read()
+    temp.stdout.close()
+    pid, status, rusage = os.wait4(temp.pid, 0)
+    temp.returncode = os.waitstatus_to_exitcode(status)
     timeDelta = time.time() - timeStarted                     # Get execution time.
 
+    # ru_maxrss is reported in kilobytes on Linux and bytes on macOS
+    peakRSS = rusage.ru_maxrss / 1024.0
+    if sys.platform == 'darwin':
+        peakRSS = peakRSS / 1024.0
+
     # parse pickle file for getting old counter and command
     counter = 0
 
@@ -157,7 +252,7 @@ def run_command(cmd):
 
 
 
-    return res, success, timeDelta
+    return res, success, timeDelta, peakRSS
 
 def to_float(inp):
     #return Decimal(inp)
@@ -257,10 +352,16 @@ if __name__ == '__main__':
     parser.add_argument("-u", "--baseline_average", help="Don't average baseline with previous runs", action = "store_true")    
     parser.add_argument("-p", "--path", type=str, help="run parallel tests", default="../bin")
     parser.add_argument("-n", "--procs", type=int, help="number of processors used for running regression tests",default=2)
+    parser.add_argument("--perf", help="Record wall time and peak RSS of the overlap mesh, offline map and apply steps and compare against the performance baseline (runs serially)", action = "store_true")
+    parser.add_argument("--perf_threshold", type=float, help="percentage slowdown in wall time flagged as a regression", default=20.0)
+    parser.add_argument("--rss_threshold", type=float, help="percentage increase in peak RSS flagged as a regression", default=10.0)
+    parser.add_argument("--large", help="Also run the larger resolutions in test_matrix_large.ini (uses separate baselines)", action = "store_true")
 
     # ex arguments:
     # generate baselines:                   python regression_tests.py -v -g -n 3 -p ../bin/ 
     # regression compare against baselines: python regression_tests.py -v -n 3 -p ../bin/ 
+    # performance baselines and comparison: python regression_tests.py -g --perf -p ../bin/
+    #                                       python regression_tests.py --perf --perf_threshold 15 -p ../bin/
     args = parser.parse_args()
     if args.verbose:
         print("verbose mode enabled")
@@ -277,6 +378,21 @@ if __name__ == '__main__':
     if args.baseline_average:
         baseline_average=True
         print("average from previous baseline:", baseline_average)
+    if args.perf:
+        perf_mode=True
+        perf_threshold=args.perf_threshold
+        rss_threshold=args.rss_threshold
+        # timings of concurrent commands interfere with each other
+        procs=1
+        print("performance mode enabled, running serially")
+    # larger resolutions store their own baselines so that the default
+    # baselines remain comparable with the default test matrix
+    baseline_suffix = ""
+    if args.large:
+        baseline_suffix = "_large"
+        print("including larger resolutions from test_matrix_large.ini")
+    time_pkl_file = baseline_path+'timing_data'+baseline_suffix+'.pkl'
+    perf_pkl_file = baseline_path+'perf_data'+baseline_suffix+'.pkl'
 
     # open the timingfile
     time_file, timing_objects, df_timingfile = open_timingfile(baseline_average)
@@ -284,9 +400,11 @@ if __name__ == '__main__':
     # Run a pipeline
     # read inputs
     command = []
-    args=[]
     # space seperated table with keywords
     tm = pd.read_table('./test_matrix.ini', delim_whitespace=True, comment='#')
+    if args.large:
+        tm_large = pd.read_table('./test_matrix_large.ini', delim_whitespace=True, comment='#')
+        tm = pd.concat([tm, tm_large], ignore_index=True)
 
     # figure out order of commands to call
     # For each pipeline:
@@ -393,7 +511,7 @@ if __name__ == '__main__':
         os.mkdir("maps")
 
     # Each for loop below runs the commands to create results
-    for result, ss, timeDelta in pool.map(run_command, mesh_cmds):
+    for result, ss, timeDelta, peakRSS in pool.map(run_command, mesh_cmds):
 
         populate_timing_data(mesh_cmds[count], timeDelta, splitLoc)
         count=count+1
@@ -410,7 +528,7 @@ if __name__ == '__main__':
     results = []
     count =0
     #  print(generate_test_cmds) 
-    for result, ss, timeDelta in pool.map(run_command, generate_test_cmds):
+    for result, ss, timeDelta, peakRSS in pool.map(run_command, generate_test_cmds):
 
        populate_timing_data(generate_test_cmds[count], timeDelta, splitLoc)
        count=count+1
@@ -427,8 +545,9 @@ if __name__ == '__main__':
     results = [] 
     count = 0
     #  print(overlap_test_cmds)
-    for result, ss, timeDelta in pool.map(run_command, overlap_test_cmds):
+    for result, ss, timeDelta, peakRSS in pool.map(run_command, overlap_test_cmds):
 
+       populate_perf_data(overlap_test_cmds[count], timeDelta, peakRSS)
        populate_timing_data(overlap_test_cmds[count], timeDelta, splitLoc)
        count=count+1
        if verbose:
@@ -444,8 +563,9 @@ if __name__ == '__main__':
     results = []    
     count = 0
     #  print(g_offmap_cmds)
-    for result, ss, timeDelta in pool.map(run_command, g_offmap_cmds):
+    for result, ss, timeDelta, peakRSS in pool.map(run_command, g_offmap_cmds):
 
+       populate_perf_data(g_offmap_cmds[count], timeDelta, peakRSS)
        populate_timing_data(g_offmap_cmds[count], timeDelta, splitLoc)
        count=count+1
        if verbose:
@@ -461,8 +581,9 @@ if __name__ == '__main__':
     results = []   
     count =0 
     #  print(a_offmap_cmds)
-    for result, ss, timeDelta in pool.map(run_command, a_offmap_cmds):
+    for result, ss, timeDelta, peakRSS in pool.map(run_command, a_offmap_cmds):
 
+       populate_perf_data(a_offmap_cmds[count], timeDelta, peakRSS)
        populate_timing_data(a_offmap_cmds[count], timeDelta, splitLoc)
        count=count+1
        if verbose:
@@ -493,26 +614,33 @@ if __name__ == '__main__':
         df['error'] = df['error'].astype(np.float64)
 
         # saving the dataframe
-        base_pkl_file = baseline_path+'baseline_data.pkl'
+        base_pkl_file = baseline_path+'baseline_data'+baseline_suffix+'.pkl'
         pkl_file = open(base_pkl_file, 'wb')
         pickle.dump(df, pkl_file)
-        print("\n Saved baseline/baseline_data.pkl file")
+        print("\n Saved", base_pkl_file, "file")
 
         # write current results to a file
         #  check if timing_objects populated from existing timing file is available
         if timing_objects == []:
             df_t = pd.DataFrame(timing_dict)
             pickle.dump(df_t, time_file)
-            print("\n Saved baseline/timing_data.pkl file")
+            print("\n Saved", time_pkl_file, "file")
         else:
             # open the file again with write mode
             with open(time_pkl_file, 'wb') as time_file:
                 pickle.dump(df_timingfile, time_file)  
-                print("\n Updated baseline/timing_data.pkl file")
+                print("\n Updated", time_pkl_file, "file")
+
+        # write the performance baseline
+        if perf_mode:
+            df_p = pd.DataFrame(perf_dict)
+            with open(perf_pkl_file, 'wb') as perf_file:
+                pickle.dump(df_p, perf_file)
+            print("\n Saved", perf_pkl_file, "file")
     # compare against existing baseline
     else:
         # read baseline results from baseline_data.csv file
-        base_pkl_file = baseline_path+'baseline_data.pkl'
+        base_pkl_file = baseline_path+'baseline_data'+baseline_suffix+'.pkl'
         bpfile = open(base_pkl_file, 'rb')
 
         df = pickle.load(bpfile)
@@ -542,10 +670,10 @@ if __name__ == '__main__':
             count += 1
 
         # write current results to a file
-        rpt_pkl_file = baseline_path+'baseline_data_repeat.pkl'
+        rpt_pkl_file = baseline_path+'baseline_data_repeat'+baseline_suffix+'.pkl'
         pkl_file = open(rpt_pkl_file, 'wb')
         pickle.dump(df_current, pkl_file)
-        print("\n Saved baseline/baseline_data_repeat.pkl file")
+        print("\n Saved", rpt_pkl_file, "file")
 
         # write a new timing pickle file that compares against the previous run
         # cmd avg/time_baseline  current_average_time  percentage_difference
@@ -589,10 +717,16 @@ if __name__ == '__main__':
 
 
         # saving the dataframe
-        regtime_pkl_file = baseline_path+'regtime.pkl'
+        regtime_pkl_file = baseline_path+'regtime'+baseline_suffix+'.pkl'
         regt_file = open(regtime_pkl_file, 'wb')
         pickle.dump(dfcomp, regt_file)
-        print("\n Saved baseline/regtime.pkl file")
+        print("\n Saved", regtime_pkl_file, "file")
 
         # print(comptime_dict)
 
+        # compare wall time and peak RSS against the performance baseline
+        if perf_mode:
+            nflagged = compare_perf_data()
+            if nflagged > 0:
+                print("\n", nflagged, "command(s) regressed beyond the performance thresholds")
+                sys.exit(1)
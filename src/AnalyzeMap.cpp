@@ -17,6 +17,463 @@
 #include "CommandLine.h"
 #include "OfflineMap.h"
 #include "Announce.h"
+#include "DataArray2D.h"
+
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Number of rows in each chunk of the analysis reductions.  Partial
+///		results are formed over fixed chunks and combined pairwise, so that
+///		statistics do not depend on the number of threads.
+///	</summary>
+static const int AnalyzeMapChunkSize = 4096;
+
+///	<summary>
+///		Number of bins in the error histograms.  Bin 0 holds errors below
+///		1e-16, bins 1 to AnalyzeMapHistogramBins-2 hold errors in successive
+///		intervals of two decades and the last bin holds errors above 1e-2.
+///	</summary>
+static const int AnalyzeMapHistogramBins = 9;
+
+///	<summary>
+///		Number of analytic test fields.
+///	</summary>
+static const int AnalyzeMapFieldCount = 4;
+
+///	<summary>
+///		Names of the analytic test fields, which match the test data of
+///		GenerateTestData.  Field 0 is the constant used for consistency.
+///	</summary>
+static const char * const AnalyzeMapFieldNames[AnalyzeMapFieldCount] = {
+	"constant", "Y2b2", "Y16b32", "vortex"
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Evaluate an analytic test field at the given longitude and latitude
+///		(in radians).
+///	</summary>
+static double EvaluateAnalyzeMapField(
+	int iField,
+	double dLon,
+	double dLat
+) {
+	if (iField == 0) {
+		return 1.0;
+
+	} else if (iField == 1) {
+		return (2.0 + cos(dLat) * cos(dLat) * cos(2.0 * dLon));
+
+	} else if (iField == 2) {
+		return (2.0 + pow(sin(2.0 * dLat), 16.0) * cos(16.0 * dLon));
+
+	} else {
+		const double dLon0 = 0.0;
+		const double dLat0 = 0.6;
+		const double dR0 = 3.0;
+		const double dD = 5.0;
+		const double dT = 6.0;
+
+		// Rotate to the frame with pole at (dLon0, dLat0)
+		double dSinC = sin(dLat0);
+		double dCosC = cos(dLat0);
+		double dCosT = cos(dLat);
+		double dSinT = sin(dLat);
+
+		double dTrm  = dCosT * cos(dLon - dLon0);
+		double dX = dSinC * dTrm - dCosC * dSinT;
+		double dY = dCosT * sin(dLon - dLon0);
+		double dZ = dSinC * dSinT + dCosC * dTrm;
+
+		double dLonT = atan2(dY, dX);
+		if (dLonT < 0.0) {
+			dLonT += 2.0 * M_PI;
+		}
+		double dLatT = asin(dZ);
+
+		double dRho = dR0 * cos(dLatT);
+		double dVt = 3.0 * sqrt(3.0) / 2.0
+			/ cosh(dRho) / cosh(dRho) * tanh(dRho);
+
+		double dOmega;
+		if (dRho == 0.0) {
+			dOmega = 0.0;
+		} else {
+			dOmega = dVt / dRho;
+		}
+
+		return (1.0 - tanh(dRho / dD * sin(dLonT - dOmega * dT)));
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Get the histogram bin of an error.
+///	</summary>
+static int GetAnalyzeMapHistogramBin(
+	double dError
+) {
+	if (dError < 1.0e-16) {
+		return 0;
+	}
+	if (!(dError < 1.0e-2)) {
+		return (AnalyzeMapHistogramBins-1);
+	}
+	int iBin = 1 + static_cast<int>(floor((log10(dError) + 16.0) / 2.0));
+	return std::min(iBin, AnalyzeMapHistogramBins-1);
+}
+
+///	<summary>
+///		Announce a histogram of errors.
+///	</summary>
+static void AnnounceAnalyzeMapHistogram(
+	const char * szTitle,
+	const size_t (&nHistogram)[AnalyzeMapHistogramBins]
+) {
+	AnnounceStartBlock(szTitle);
+	Announce("         < 1e-16 : %lu", nHistogram[0]);
+	for (int b = 1; b < AnalyzeMapHistogramBins-1; b++) {
+		Announce("[1e%+03i, 1e%+03i) : %lu",
+			2 * b - 18, 2 * b - 16, nHistogram[b]);
+	}
+	Announce("        >= 1e-02 : %lu", nHistogram[AnalyzeMapHistogramBins-1]);
+	AnnounceEndBlock(NULL);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Partial sums, extrema and histogram accumulated for one test field
+///		over a chunk of rows.
+///	</summary>
+struct AnalyzeMapPartial {
+	double dErrorL1;
+	double dErrorL2;
+	double dErrorLi;
+
+	double dSumL1;
+	double dSumL2;
+	double dSumLi;
+
+	double dIntegral;
+	double dMin;
+	double dMax;
+
+	size_t nHistogram[AnalyzeMapHistogramBins];
+
+	void Initialize() {
+		dErrorL1 = 0.0;
+		dErrorL2 = 0.0;
+		dErrorLi = 0.0;
+		dSumL1 = 0.0;
+		dSumL2 = 0.0;
+		dSumLi = 0.0;
+		dIntegral = 0.0;
+		dMin = DBL_MAX;
+		dMax = -DBL_MAX;
+		for (int b = 0; b < AnalyzeMapHistogramBins; b++) {
+			nHistogram[b] = 0;
+		}
+	}
+
+	void Combine(const AnalyzeMapPartial & b) {
+		dErrorL1 += b.dErrorL1;
+		dErrorL2 += b.dErrorL2;
+		dErrorLi = std::max(dErrorLi, b.dErrorLi);
+		dSumL1 += b.dSumL1;
+		dSumL2 += b.dSumL2;
+		dSumLi = std::max(dSumLi, b.dSumLi);
+		dIntegral += b.dIntegral;
+		dMin = std::min(dMin, b.dMin);
+		dMax = std::max(dMax, b.dMax);
+		for (int i = 0; i < AnalyzeMapHistogramBins; i++) {
+			nHistogram[i] += b.nHistogram[i];
+		}
+	}
+};
+
+///	<summary>
+///		Combine the partial results of all chunks pairwise in a fixed order.
+///	</summary>
+static void CombineAnalyzeMapPartials(
+	std::vector<AnalyzeMapPartial> & vecPartials
+) {
+	const int nChunks = static_cast<int>(vecPartials.size());
+	for (int iStride = 1; iStride < nChunks; iStride *= 2) {
+		for (int c = 0; c + iStride < nChunks; c += 2 * iStride) {
+			vecPartials[c].Combine(vecPartials[c + iStride]);
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Apply the map to a block of analytic test fields sampled at the
+///		cell centers with a single sparse matrix-matrix product, and report
+///		error norms, conservation and consistency statistics and per-row
+///		error histograms.  Returns the number of rows whose errors in the
+///		constant field exceed dTolerance.
+///	</summary>
+static int AnalyzeMapTestFields(
+	OfflineMap & mapRemap,
+	double dTolerance
+) {
+	SparseMatrix<double> & smatRemap = mapRemap.GetSparseMatrix();
+	smatRemap.Finalize();
+
+	const DataArray1D<double> & dSourceAreas = mapRemap.GetSourceAreas();
+	const DataArray1D<double> & dTargetAreas = mapRemap.GetTargetAreas();
+
+	const int nSource = dSourceAreas.GetRows();
+	const int nTarget = dTargetAreas.GetRows();
+
+	const DataArray1D<double> & dSourceLon = mapRemap.GetSourceCenterLon();
+	const DataArray1D<double> & dSourceLat = mapRemap.GetSourceCenterLat();
+	const DataArray1D<double> & dTargetLon = mapRemap.GetTargetCenterLon();
+	const DataArray1D<double> & dTargetLat = mapRemap.GetTargetCenterLat();
+
+	if ((dSourceLon.GetRows() != nSource) ||
+	    (dSourceLat.GetRows() != nSource) ||
+	    (dTargetLon.GetRows() != nTarget) ||
+	    (dTargetLat.GetRows() != nTarget)
+	) {
+		_EXCEPTIONT("Map does not contain source and target cell centers "
+			"(xc_a, yc_a, xc_b, yc_b)");
+	}
+	if ((smatRemap.GetRows() > nTarget) || (smatRemap.GetColumns() > nSource)) {
+		_EXCEPTIONT("Map entries exceed the source or target dimensions");
+	}
+
+	const double dDegToRad = M_PI / 180.0;
+
+	// Sample the test fields at the source and target cell centers
+	AnnounceStartBlock("Sampling %i test fields", AnalyzeMapFieldCount);
+
+	DataArray2D<double> dataSource(nSource, AnalyzeMapFieldCount);
+	DataArray2D<double> dataTargetExact(nTarget, AnalyzeMapFieldCount);
+	DataArray2D<double> dataTarget(nTarget, AnalyzeMapFieldCount);
+
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < nSource; i++) {
+		for (int f = 0; f < AnalyzeMapFieldCount; f++) {
+			dataSource[i][f] = EvaluateAnalyzeMapField(f,
+				dDegToRad * dSourceLon[i], dDegToRad * dSourceLat[i]);
+		}
+	}
+
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < nTarget; i++) {
+		for (int f = 0; f < AnalyzeMapFieldCount; f++) {
+			dataTargetExact[i][f] = EvaluateAnalyzeMapField(f,
+				dDegToRad * dTargetLon[i], dDegToRad * dTargetLat[i]);
+		}
+	}
+	AnnounceEndBlock("Done");
+
+	// Apply the map to all fields at once
+	AnnounceStartBlock("Applying map to test fields");
+	smatRemap.Apply(dataSource, dataTarget, AnalyzeMapFieldCount);
+	AnnounceEndBlock("Done");
+
+	AnnounceStartBlock("Analyzing");
+
+	// Source integrals and extrema
+	const int nSourceChunks =
+		(nSource + AnalyzeMapChunkSize - 1) / AnalyzeMapChunkSize;
+
+	std::vector< std::vector<AnalyzeMapPartial> >
+		vecSourcePartials(AnalyzeMapFieldCount,
+			std::vector<AnalyzeMapPartial>(std::max(nSourceChunks, 1)));
+
+#pragma omp parallel for schedule(static)
+	for (int c = 0; c < nSourceChunks; c++) {
+		const int iBegin = c * AnalyzeMapChunkSize;
+		const int iEnd = std::min(iBegin + AnalyzeMapChunkSize, nSource);
+
+		for (int f = 0; f < AnalyzeMapFieldCount; f++) {
+			AnalyzeMapPartial & part = vecSourcePartials[f][c];
+			part.Initialize();
+			for (int i = iBegin; i < iEnd; i++) {
+				const double dValue = dataSource[i][f];
+				part.dIntegral += dValue * dSourceAreas[i];
+				part.dMin = std::min(part.dMin, dValue);
+				part.dMax = std::max(part.dMax, dValue);
+			}
+		}
+	}
+
+	// Target errors, integrals, extrema and histograms of pointwise errors
+	// relative to the maximum of each field
+	const int nTargetChunks =
+		(nTarget + AnalyzeMapChunkSize - 1) / AnalyzeMapChunkSize;
+
+	std::vector< std::vector<AnalyzeMapPartial> >
+		vecTargetPartials(AnalyzeMapFieldCount,
+			std::vector<AnalyzeMapPartial>(std::max(nTargetChunks, 1)));
+
+	for (int f = 0; f < AnalyzeMapFieldCount; f++) {
+		CombineAnalyzeMapPartials(vecSourcePartials[f]);
+	}
+
+	double dFieldScale[AnalyzeMapFieldCount];
+	for (int f = 0; f < AnalyzeMapFieldCount; f++) {
+		const AnalyzeMapPartial & part = vecSourcePartials[f][0];
+		dFieldScale[f] = std::max(fabs(part.dMin), fabs(part.dMax));
+		if (dFieldScale[f] == 0.0) {
+			dFieldScale[f] = 1.0;
+		}
+	}
+
+	int nInconsistent = 0;
+
+#pragma omp parallel for schedule(static) reduction(+:nInconsistent)
+	for (int c = 0; c < nTargetChunks; c++) {
+		const int iBegin = c * AnalyzeMapChunkSize;
+		const int iEnd = std::min(iBegin + AnalyzeMapChunkSize, nTarget);
+
+		for (int f = 0; f < AnalyzeMapFieldCount; f++) {
+			AnalyzeMapPartial & part = vecTargetPartials[f][c];
+			part.Initialize();
+			for (int i = iBegin; i < iEnd; i++) {
+				const double dValue = dataTarget[i][f];
+				const double dExact = dataTargetExact[i][f];
+				const double dDiff = fabs(dValue - dExact);
+				const double dWeight = dTargetAreas[i];
+
+				part.dErrorL1 += dDiff * dWeight;
+				part.dErrorL2 += dDiff * dDiff * dWeight;
+				part.dErrorLi = std::max(part.dErrorLi, dDiff);
+
+				part.dSumL1 += fabs(dExact) * dWeight;
+				part.dSumL2 += dExact * dExact * dWeight;
+				part.dSumLi = std::max(part.dSumLi, fabs(dExact));
+
+				part.dIntegral += dValue * dWeight;
+				part.dMin = std::min(part.dMin, dValue);
+				part.dMax = std::max(part.dMax, dValue);
+
+				part.nHistogram[
+					GetAnalyzeMapHistogramBin(dDiff / dFieldScale[f])]++;
+
+				if ((f == 0) && (dDiff > dTolerance)) {
+					nInconsistent++;
+				}
+			}
+		}
+	}
+
+	for (int f = 0; f < AnalyzeMapFieldCount; f++) {
+		CombineAnalyzeMapPartials(vecTargetPartials[f]);
+	}
+
+	// Area-weighted column sums, which equal one for a conservative map
+	SparseMatrix<double> smatRemapTranspose;
+	smatRemap.Transpose(smatRemapTranspose);
+
+	const DataArray1D<size_t> & dataRowPtrT =
+		smatRemapTranspose.GetCSRRowPointers();
+	const DataArray1D<int> & dataColsT =
+		smatRemapTranspose.GetCSRColumns();
+	const DataArray1D<double> & dataValuesT =
+		smatRemapTranspose.GetCSRValues();
+
+	const int nCols = smatRemapTranspose.GetRows();
+
+	std::vector<AnalyzeMapPartial> vecColumnPartials(
+		std::max(nSourceChunks, 1));
+
+	int nNonConservative = 0;
+
+#pragma omp parallel for schedule(static) reduction(+:nNonConservative)
+	for (int c = 0; c < nSourceChunks; c++) {
+		const int iBegin = c * AnalyzeMapChunkSize;
+		const int iEnd = std::min(iBegin + AnalyzeMapChunkSize, nSource);
+
+		AnalyzeMapPartial & part = vecColumnPartials[c];
+		part.Initialize();
+		for (int i = iBegin; i < iEnd; i++) {
+			double dSum = 0.0;
+			if (i < nCols) {
+				for (size_t j = dataRowPtrT[i]; j < dataRowPtrT[i+1]; j++) {
+					dSum += dataValuesT[j] * dTargetAreas[dataColsT[j]];
+				}
+			}
+			const double dDiff = fabs(dSum / dSourceAreas[i] - 1.0);
+
+			part.dErrorLi = std::max(part.dErrorLi, dDiff);
+			part.nHistogram[GetAnalyzeMapHistogramBin(dDiff)]++;
+
+			if (dDiff > dTolerance) {
+				nNonConservative++;
+			}
+		}
+	}
+
+	CombineAnalyzeMapPartials(vecColumnPartials);
+
+	// Rows of the map with no entries
+	const DataArray1D<size_t> & dataRowPtr = smatRemap.GetCSRRowPointers();
+	const int nRows = smatRemap.GetRows();
+
+	int nEmptyRows = nTarget - nRows;
+#pragma omp parallel for schedule(static) reduction(+:nEmptyRows)
+	for (int i = 0; i < nRows; i++) {
+		if (dataRowPtr[i] == dataRowPtr[i+1]) {
+			nEmptyRows++;
+		}
+	}
+
+	AnnounceEndBlock("Done");
+
+	// Report
+	AnnounceStartBlock("Consistency and conservation");
+	Announce("Target dofs with no entries: %i", nEmptyRows);
+	Announce("Max |row sum - 1|:           %1.15e",
+		vecTargetPartials[0][0].dErrorLi);
+	Announce("Max |column sum - 1|:        %1.15e",
+		vecColumnPartials[0].dErrorLi);
+	Announce("Rows exceeding tolerance:    %i", nInconsistent);
+	Announce("Columns exceeding tolerance: %i", nNonConservative);
+	AnnounceAnalyzeMapHistogram(
+		"Histogram of |row sum - 1|", vecTargetPartials[0][0].nHistogram);
+	AnnounceAnalyzeMapHistogram(
+		"Histogram of |column sum - 1|", vecColumnPartials[0].nHistogram);
+	AnnounceEndBlock(NULL);
+
+	for (int f = 1; f < AnalyzeMapFieldCount; f++) {
+		const AnalyzeMapPartial & partSource = vecSourcePartials[f][0];
+		const AnalyzeMapPartial & partTarget = vecTargetPartials[f][0];
+
+		AnnounceStartBlock("Test field %s", AnalyzeMapFieldNames[f]);
+		Announce("L1:   %1.15e",
+			partTarget.dErrorL1 / partTarget.dSumL1);
+		Announce("L2:   %1.15e",
+			sqrt(partTarget.dErrorL2 / partTarget.dSumL2));
+		Announce("Li:   %1.15e",
+			partTarget.dErrorLi / partTarget.dSumLi);
+		Announce("Conservation error: %1.15e",
+			(partTarget.dIntegral - partSource.dIntegral)
+				/ partSource.dIntegral);
+		Announce("Source range: [%1.15e, %1.15e]",
+			partSource.dMin, partSource.dMax);
+		Announce("Target range: [%1.15e, %1.15e]",
+			partTarget.dMin, partTarget.dMax);
+		AnnounceAnalyzeMapHistogram(
+			"Histogram of pointwise errors relative to max |field|",
+			partTarget.nHistogram);
+		AnnounceEndBlock(NULL);
+	}
+
+	return nInconsistent;
+}
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -40,6 +497,9 @@ try {
 	// Strict tolerance
 	double dStrictTolerance;
 
+	// Apply the map to analytic test fields
+	bool fTestFields;
+
 	// Parse the command line
 	BeginCommandLine()
 		CommandLineString(strInputMap,  "map",  "");
@@ -47,7 +507,8 @@ try {
 		CommandLineBool(fNoCheck, "nocheck");
 		CommandLineDouble(dNormalTolerance, "tol", 1.0e-8);
 		CommandLineDouble(dStrictTolerance, "stricttol", 1.0e-12);
-		
+		CommandLineBool(fTestFields, "testfields");
+
 		ParseCommandLine(argc, argv);
 	EndCommandLine(argv)
 	AnnounceBanner();
@@ -69,6 +530,13 @@ try {
 		dNormalTolerance,
 		dStrictTolerance);
 
+	// Analyze the map using analytic test fields
+	if (fTestFields) {
+		AnnounceStartBlock("Analyzing map with test fields");
+		AnalyzeMapTestFields(mapRemap, dNormalTolerance);
+		AnnounceEndBlock(NULL);
+	}
+
 } catch(Exception & e) {
 	Announce(e.ToString().c_str());
 	return (-1);
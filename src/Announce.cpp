@@ -23,6 +23,16 @@
 #include <cstdio>
 #include <cstring>
 #include <cstdarg>
+#include <cstdlib>
+#include <ctime>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -70,6 +80,269 @@ static bool s_fBlockFlag = false;
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		Accumulated timings of all blocks with the same path.
+///	</summary>
+struct AnnounceTimerRecord {
+
+	///	<summary>
+	///		Block texts from the outermost block, separated by '/'.
+	///	</summary>
+	std::string strPath;
+
+	///	<summary>
+	///		Indentation level of the block.
+	///	</summary>
+	int nLevel;
+
+	///	<summary>
+	///		Number of times the block was completed.
+	///	</summary>
+	int nCalls;
+
+	///	<summary>
+	///		Accumulated wall and CPU time, in seconds.
+	///	</summary>
+	double dWallTime;
+	double dCPUTime;
+
+	///	<summary>
+	///		Largest memory high-water mark at the end of the block, in kB.
+	///	</summary>
+	long lMaxRSS;
+
+	///	<summary>
+	///		Counters, in order of first use.
+	///	</summary>
+	std::vector< std::pair<std::string, double> > vecCounters;
+};
+
+///	<summary>
+///		An open block.
+///	</summary>
+struct AnnounceOpenBlock {
+
+	///	<summary>
+	///		Index of the record of this block.
+	///	</summary>
+	size_t ixRecord;
+
+	///	<summary>
+	///		Wall and CPU time at the start of the block.
+	///	</summary>
+	std::chrono::steady_clock::time_point tpWallStart;
+	double dCPUStart;
+};
+
+///	<summary>
+///		Flag indicating timers are enabled.
+///	</summary>
+static bool s_fTimersEnabled = false;
+
+///	<summary>
+///		Flag indicating the TEMPEST_TIMERS environment variable was checked.
+///	</summary>
+static bool s_fTimersEnvironmentChecked = false;
+
+///	<summary>
+///		File to which the timer summary is written at exit.
+///	</summary>
+static std::string s_strTimerSummaryFile;
+
+///	<summary>
+///		Timer records, in order of first completion.
+///	</summary>
+static std::vector<AnnounceTimerRecord> s_vecTimerRecords;
+
+///	<summary>
+///		Map from block path to timer record.
+///	</summary>
+static std::map<std::string, size_t> s_mapTimerRecords;
+
+///	<summary>
+///		Open blocks, one per indentation level.
+///	</summary>
+static std::vector<AnnounceOpenBlock> s_vecOpenBlocks;
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Get the CPU time consumed by all threads of the process, in seconds.
+///	</summary>
+static double AnnounceGetCPUTime() {
+#if defined(__unix__) || defined(__APPLE__)
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) == 0) {
+		return
+			static_cast<double>(usage.ru_utime.tv_sec)
+			+ 1.0e-6 * static_cast<double>(usage.ru_utime.tv_usec)
+			+ static_cast<double>(usage.ru_stime.tv_sec)
+			+ 1.0e-6 * static_cast<double>(usage.ru_stime.tv_usec);
+	}
+#endif
+	return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Get the memory high-water mark of the process, in kB, or zero if
+///		not available.
+///	</summary>
+static long AnnounceGetMaxRSS() {
+#if defined(__unix__) || defined(__APPLE__)
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(__APPLE__)
+		return static_cast<long>(usage.ru_maxrss / 1024);
+#else
+		return static_cast<long>(usage.ru_maxrss);
+#endif
+	}
+#endif
+	return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Write the timer summary to the file given to AnnounceEnableTimers().
+///	</summary>
+static void AnnounceWriteTimerSummaryAtExit() {
+	if (s_strTimerSummaryFile.length() != 0) {
+		AnnounceWriteTimerSummary(s_strTimerSummaryFile.c_str());
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Enable timers if the TEMPEST_TIMERS environment variable is set.
+///	</summary>
+static void AnnounceCheckTimersEnvironment() {
+	if (s_fTimersEnvironmentChecked) {
+		return;
+	}
+	s_fTimersEnvironmentChecked = true;
+
+	const char * szTimers = getenv("TEMPEST_TIMERS");
+	if ((szTimers != NULL) && (!s_fTimersEnabled)) {
+		AnnounceEnableTimers((szTimers[0] == '\0')?(NULL):(szTimers));
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Start timing a block at the current indentation level.
+///	</summary>
+static void AnnounceStartBlockTimer(const char * szBlockText) {
+
+	std::string strPath;
+	if (s_vecOpenBlocks.size() != 0) {
+		strPath = s_vecTimerRecords[s_vecOpenBlocks.back().ixRecord].strPath;
+		strPath += "/";
+	}
+	strPath += szBlockText;
+
+	std::map<std::string, size_t>::const_iterator iter =
+		s_mapTimerRecords.find(strPath);
+
+	size_t ixRecord;
+	if (iter != s_mapTimerRecords.end()) {
+		ixRecord = iter->second;
+	} else {
+		ixRecord = s_vecTimerRecords.size();
+		s_mapTimerRecords.insert(
+			std::pair<std::string, size_t>(strPath, ixRecord));
+
+		AnnounceTimerRecord record;
+		record.strPath = strPath;
+		record.nLevel = static_cast<int>(s_vecOpenBlocks.size());
+		record.nCalls = 0;
+		record.dWallTime = 0.0;
+		record.dCPUTime = 0.0;
+		record.lMaxRSS = 0;
+		s_vecTimerRecords.push_back(record);
+	}
+
+	AnnounceOpenBlock block;
+	block.ixRecord = ixRecord;
+	block.tpWallStart = std::chrono::steady_clock::now();
+	block.dCPUStart = AnnounceGetCPUTime();
+	s_vecOpenBlocks.push_back(block);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Stop timing the innermost block, returning its wall time.
+///	</summary>
+static double AnnounceEndBlockTimer() {
+	if (s_vecOpenBlocks.size() == 0) {
+		return 0.0;
+	}
+
+	const AnnounceOpenBlock & block = s_vecOpenBlocks.back();
+	AnnounceTimerRecord & record = s_vecTimerRecords[block.ixRecord];
+
+	double dWallTime =
+		std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - block.tpWallStart).count();
+
+	record.nCalls++;
+	record.dWallTime += dWallTime;
+	record.dCPUTime += AnnounceGetCPUTime() - block.dCPUStart;
+
+	long lMaxRSS = AnnounceGetMaxRSS();
+	if (lMaxRSS > record.lMaxRSS) {
+		record.lMaxRSS = lMaxRSS;
+	}
+
+	s_vecOpenBlocks.pop_back();
+
+	return dWallTime;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Write a string with JSON escapes.
+///	</summary>
+static void AnnounceWriteJSONString(FILE * fp, const std::string & str) {
+	fprintf(fp, "\"");
+	for (size_t i = 0; i < str.length(); i++) {
+		const unsigned char c = static_cast<unsigned char>(str[i]);
+		if ((c == '"') || (c == '\\')) {
+			fprintf(fp, "\\%c", c);
+		} else if (c < 0x20) {
+			fprintf(fp, "\\u%04x", c);
+		} else {
+			fprintf(fp, "%c", c);
+		}
+	}
+	fprintf(fp, "\"");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Write a string as a quoted CSV field.
+///	</summary>
+static void AnnounceWriteCSVString(FILE * fp, const std::string & str) {
+	fprintf(fp, "\"");
+	for (size_t i = 0; i < str.length(); i++) {
+		if (str[i] == '"') {
+			fprintf(fp, "\"\"");
+		} else {
+			fprintf(fp, "%c", str[i]);
+		}
+	}
+	fprintf(fp, "\"");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 FILE * AnnounceGetOutputBuffer() {
 	return g_fpAnnounceOutput;
 }
@@ -144,6 +417,12 @@ void AnnounceStartBlock(
 	}
 	fprintf(g_fpAnnounceOutput, "%s", szBuffer);
 
+	// Start the block timer
+	AnnounceCheckTimersEnvironment();
+	if (s_fTimersEnabled) {
+		AnnounceStartBlockTimer(szBuffer);
+	}
+
 	s_fBlockFlag = true;
 	s_nIndentationLevel++;
 
@@ -187,6 +466,12 @@ void AnnounceEndBlock(
 	}
 #endif
 
+	// Stop the block timer
+	double dWallTime = 0.0;
+	if (s_fTimersEnabled) {
+		dWallTime = AnnounceEndBlockTimer();
+	}
+
 	// Check block flag
 	if (szText != NULL) {
 
@@ -198,6 +483,13 @@ void AnnounceEndBlock(
 		vsprintf(szBuffer, szText, arguments);
 		va_end(arguments);
 
+		// Append elapsed time
+		if (s_fTimersEnabled) {
+			size_t sLength = strlen(szBuffer);
+			snprintf(szBuffer + sLength, AnnouncementBufferSize - sLength,
+				" [%1.3f s]", dWallTime);
+		}
+
 		if (s_fBlockFlag) {
 			s_fBlockFlag = false;
 
@@ -396,3 +688,127 @@ void AnnounceBanner(const char * szText) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void AnnounceEnableTimers(const char * szSummaryFile) {
+	s_fTimersEnvironmentChecked = true;
+
+	if (szSummaryFile != NULL) {
+		if (s_strTimerSummaryFile.length() == 0) {
+			atexit(AnnounceWriteTimerSummaryAtExit);
+		}
+		s_strTimerSummaryFile = szSummaryFile;
+	}
+
+	s_fTimersEnabled = true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void AnnounceCounter(const char * szName, double dValue) {
+	if ((!s_fTimersEnabled) || (s_vecOpenBlocks.size() == 0)) {
+		return;
+	}
+	if (szName == NULL) {
+		return;
+	}
+
+	std::vector< std::pair<std::string, double> > & vecCounters =
+		s_vecTimerRecords[s_vecOpenBlocks.back().ixRecord].vecCounters;
+
+	for (size_t i = 0; i < vecCounters.size(); i++) {
+		if (vecCounters[i].first == szName) {
+			vecCounters[i].second += dValue;
+			return;
+		}
+	}
+	vecCounters.push_back(
+		std::pair<std::string, double>(std::string(szName), dValue));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void AnnounceWriteTimerSummary(const char * szSummaryFile) {
+
+	if (szSummaryFile == NULL) {
+		return;
+	}
+
+#ifdef TEMPEST_MPIOMP
+	// Only output on rank zero
+	if (g_fOnlyOutputOnRankZero) {
+		int nRank;
+
+		MPI_Comm_rank(MPI_COMM_WORLD, &nRank);
+
+		if (nRank > 0) {
+			return;
+		}
+	}
+#endif
+
+	FILE * fp = fopen(szSummaryFile, "w");
+	if (fp == NULL) {
+		fprintf(stderr, "WARNING: Unable to open timer summary file \"%s\"\n",
+			szSummaryFile);
+		return;
+	}
+
+	const size_t sLength = strlen(szSummaryFile);
+	const bool fJSON =
+		(sLength >= 5) && (strcmp(szSummaryFile + sLength - 5, ".json") == 0);
+
+	// JSON array of blocks
+	if (fJSON) {
+		fprintf(fp, "{\n  \"max_rss_kb\": %li,\n  \"blocks\": [", AnnounceGetMaxRSS());
+		for (size_t i = 0; i < s_vecTimerRecords.size(); i++) {
+			const AnnounceTimerRecord & record = s_vecTimerRecords[i];
+
+			fprintf(fp, "%s\n    {\"path\": ", (i == 0)?(""):(","));
+			AnnounceWriteJSONString(fp, record.strPath);
+			fprintf(fp, ", \"level\": %i, \"calls\": %i, "
+				"\"wall_seconds\": %1.6f, \"cpu_seconds\": %1.6f, "
+				"\"max_rss_kb\": %li",
+				record.nLevel, record.nCalls,
+				record.dWallTime, record.dCPUTime, record.lMaxRSS);
+
+			if (record.vecCounters.size() != 0) {
+				fprintf(fp, ", \"counters\": {");
+				for (size_t j = 0; j < record.vecCounters.size(); j++) {
+					if (j != 0) {
+						fprintf(fp, ", ");
+					}
+					AnnounceWriteJSONString(fp, record.vecCounters[j].first);
+					fprintf(fp, ": %1.15g", record.vecCounters[j].second);
+				}
+				fprintf(fp, "}");
+			}
+			fprintf(fp, "}");
+		}
+		fprintf(fp, "\n  ]\n}\n");
+
+	// CSV with one row per block and one row per counter
+	} else {
+		fprintf(fp, "type,path,level,calls,wall_seconds,cpu_seconds,max_rss_kb,name,value\n");
+		for (size_t i = 0; i < s_vecTimerRecords.size(); i++) {
+			const AnnounceTimerRecord & record = s_vecTimerRecords[i];
+
+			fprintf(fp, "block,");
+			AnnounceWriteCSVString(fp, record.strPath);
+			fprintf(fp, ",%i,%i,%1.6f,%1.6f,%li,,\n",
+				record.nLevel, record.nCalls,
+				record.dWallTime, record.dCPUTime, record.lMaxRSS);
+
+			for (size_t j = 0; j < record.vecCounters.size(); j++) {
+				fprintf(fp, "counter,");
+				AnnounceWriteCSVString(fp, record.strPath);
+				fprintf(fp, ",%i,,,,,", record.nLevel);
+				AnnounceWriteCSVString(fp, record.vecCounters[j].first);
+				fprintf(fp, ",%1.15g\n", record.vecCounters[j].second);
+			}
+		}
+	}
+
+	fclose(fp);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
@@ -95,5 +95,31 @@ void AnnounceBanner(const char * szText = NULL);
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		Enable timing of announcement blocks.  Wall time, CPU time and the
+///		memory high-water mark are recorded for every block, keyed by the
+///		path of block texts from the outermost block, and the elapsed time
+///		is appended to the text of each completed block.  If szSummaryFile
+///		is not NULL a summary of all blocks is written to this file at exit,
+///		as JSON if the file name ends in ".json" and as CSV otherwise.
+///		Timers are also enabled at the first block if the environment
+///		variable TEMPEST_TIMERS is set, with its value as the summary file.
+///	</summary>
+void AnnounceEnableTimers(const char * szSummaryFile = NULL);
+
+///	<summary>
+///		Add a value to the named counter of the innermost open block, which
+///		is included in the timer summary.
+///	</summary>
+void AnnounceCounter(const char * szName, double dValue);
+
+///	<summary>
+///		Write the timer summary to the given file (as JSON or CSV according
+///		to its extension).
+///	</summary>
+void AnnounceWriteTimerSummary(const char * szSummaryFile);
+
+///////////////////////////////////////////////////////////////////////////////
+
 #endif
 
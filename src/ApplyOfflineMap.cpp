@@ -18,10 +18,27 @@
 #include "Exception.h"
 #include "TempestRemapAPI.h"
 #include "OfflineMap.h"
+#include "RemapServer.h"
+#include "OfflineMapApplySession.h"
+#include "NetCDFUtilities.h"
+#include "STLStringHelper.h"
+#include "PerformanceOptions.h"
 #include "netcdfcpp.h"
 
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
 #include <fstream>
 
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
 #if defined(TEMPEST_MPIOMP)
 #include <mpi.h>
 #endif
@@ -96,6 +113,243 @@ void ParseInputFiles(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		Get the wall time in seconds since an arbitrary epoch.
+///	</summary>
+static double BenchmarkWallTime() {
+	return std::chrono::duration<double>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Announce the throughput of one stage of the benchmark.
+///	</summary>
+static void AnnounceBenchmarkStage(
+	int nThreads,
+	const char * szStage,
+	double dBytes,
+	double dSlices,
+	double dSeconds
+) {
+	if (dSeconds <= 0.0) {
+		dSeconds = 1.0e-9;
+	}
+	Announce("%8i  %-6s %12.3f %14.1f %12.4f",
+		nThreads,
+		szStage,
+		dBytes / dSeconds * 1.0e-9,
+		dSlices / dSeconds,
+		dSeconds);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Measure the throughput of the read, apply and write stages of
+///		ApplyOfflineMap on synthetic fields of nBenchmarkLevels levels and
+///		nBenchmarkTimes time slices, for each requested thread count.  A
+///		slice is one level of one time.  The read and write stages move
+///		source fields to and from a scratch NetCDF file (the --out_data
+///		file if given, otherwise a file in TMPDIR which is removed).  The
+///		apply stage uses an OfflineMapApplySession, so it measures the
+///		SpMV / SpMM kernel on the device the map is resident on, and counts
+///		the map and both fields as the bytes moved by each application.
+///	</summary>
+static void BenchmarkOfflineMap(
+	OfflineMap & mapApply,
+	const ApplyOfflineMapOptions & optsApply
+) {
+	const int nLevels = optsApply.nBenchmarkLevels;
+	const int nTimes = optsApply.nBenchmarkTimes;
+
+	if (nLevels < 1) {
+		_EXCEPTIONT("--bench_levels must be positive");
+	}
+	if (nTimes < 1) {
+		_EXCEPTIONT("--bench_times must be positive");
+	}
+
+	// Thread counts
+	std::vector<int> vecThreads;
+	{
+		std::vector<std::string> vecThreadStrings;
+		ParseVariableList(optsApply.strBenchmarkThreads, vecThreadStrings);
+		for (int i = 0; i < vecThreadStrings.size(); i++) {
+			const int nThreads = atoi(vecThreadStrings[i].c_str());
+			if (nThreads < 1) {
+				_EXCEPTION1("Invalid thread count \"%s\" in --bench_threads",
+					vecThreadStrings[i].c_str());
+			}
+			vecThreads.push_back(nThreads);
+		}
+	}
+	if (vecThreads.size() == 0) {
+#if defined(_OPENMP)
+		vecThreads.push_back(omp_get_max_threads());
+#else
+		vecThreads.push_back(1);
+#endif
+	}
+#if !defined(_OPENMP)
+	if ((vecThreads.size() > 1) || (vecThreads[0] != 1)) {
+		Announce("WARNING: Built without OpenMP; all stages use one thread");
+	}
+#endif
+
+	// Scratch file
+	std::string strScratchFile = optsApply.strOutputData;
+	const bool fRemoveScratchFile = (strScratchFile == "");
+	if (fRemoveScratchFile) {
+		strScratchFile = GetDefaultSpillDirectory() + "/tempest_benchmark";
+#if !defined(_WIN32)
+		char szPid[32];
+		snprintf(szPid, 32, "_%li", static_cast<long>(getpid()));
+		strScratchFile += szPid;
+#endif
+		strScratchFile += ".nc";
+	}
+
+	// Prepare the map for repeated application
+	AnnounceStartBlock("Preparing map for benchmark");
+	OfflineMapApplySession session(mapApply);
+
+	const int nSourceCount = session.GetSourceCount();
+	const int nTargetCount = session.GetTargetCount();
+	const size_t sNonZeros =
+		mapApply.GetSparseMatrix().GetNonZeroCount();
+
+	Announce("Source points: %i", nSourceCount);
+	Announce("Target points: %i", nTargetCount);
+	Announce("Nonzero weights: %lu", sNonZeros);
+	Announce("Levels x times: %i x %i", nLevels, nTimes);
+	AnnounceEndBlock("Done");
+
+	// Synthetic fields, smooth in the point index and varying with level
+	const size_t sSourceValues = static_cast<size_t>(nSourceCount) * nLevels;
+	const size_t sTargetValues = static_cast<size_t>(nTargetCount) * nLevels;
+
+	DataArray1D<double> dataSource(sSourceValues);
+	DataArray1D<double> dataTarget(sTargetValues);
+
+#pragma omp parallel for schedule(static)
+	for (int k = 0; k < nLevels; k++) {
+		double * pLevel = &(dataSource[static_cast<size_t>(k) * nSourceCount]);
+		for (int i = 0; i < nSourceCount; i++) {
+			pLevel[i] = 2.0 + sin(1.0e-3 * static_cast<double>(i) + 0.1 * k);
+		}
+	}
+
+	session.Reserve(nLevels);
+
+	// Bytes moved by each stage
+	const double dSlices = static_cast<double>(nLevels) * nTimes;
+	const double dFieldBytes =
+		static_cast<double>(sSourceValues) * sizeof(double) * nTimes;
+	const double dApplyBytes =
+		(static_cast<double>(sNonZeros) * (sizeof(double) + sizeof(int))
+		 + static_cast<double>(nTargetCount + 1) * sizeof(size_t)
+		 + static_cast<double>(sSourceValues + sTargetValues) * sizeof(double))
+		* nTimes;
+
+	const NcFile::FileFormat eFileFormat =
+		GetNcFileFormatForSize(
+			GetNcFileFormatFromString(optsApply.strOutputFormat),
+			static_cast<size_t>(dFieldBytes),
+			static_cast<size_t>(dFieldBytes));
+
+	AnnounceStartBlock("Running benchmark");
+	Announce("%8s  %-6s %12s %14s %12s",
+		"threads", "stage", "GB/s", "slices/s", "seconds");
+
+	double dChecksum = 0.0;
+
+	for (int n = 0; n < vecThreads.size(); n++) {
+#if defined(_OPENMP)
+		omp_set_num_threads(vecThreads[n]);
+#endif
+
+		// Write stage
+		double dTimeStart = BenchmarkWallTime();
+		{
+			NcFile ncScratch(
+				strScratchFile.c_str(), NcFile::Replace, NULL, 0, eFileFormat);
+			if (!ncScratch.is_valid()) {
+				_EXCEPTION1("Cannot open benchmark file \"%s\"",
+					strScratchFile.c_str());
+			}
+
+			NcDim * dimTime = ncScratch.add_dim("time", nTimes);
+			NcDim * dimLev = ncScratch.add_dim("lev", nLevels);
+			NcDim * dimCol = ncScratch.add_dim(
+				optsApply.strNColName.c_str(), nSourceCount);
+
+			NcVar * varField = ncScratch.add_var(
+				"field", ncDouble, dimTime, dimLev, dimCol);
+			if (varField == NULL) {
+				_EXCEPTIONT("Unable to create variable \"field\"");
+			}
+
+			for (int t = 0; t < nTimes; t++) {
+				varField->set_cur(t, 0, 0);
+				if (!varField->put(&(dataSource[0]), 1, nLevels, nSourceCount)) {
+					_EXCEPTION1("Unable to write benchmark file \"%s\"",
+						strScratchFile.c_str());
+				}
+			}
+		}
+		AnnounceBenchmarkStage(vecThreads[n], "write",
+			dFieldBytes, dSlices, BenchmarkWallTime() - dTimeStart);
+
+		// Read stage
+		dTimeStart = BenchmarkWallTime();
+		{
+			NcFile ncScratch(strScratchFile.c_str());
+			if (!ncScratch.is_valid()) {
+				_EXCEPTION1("Cannot open benchmark file \"%s\"",
+					strScratchFile.c_str());
+			}
+
+			NcVar * varField = ncScratch.get_var("field");
+			if (varField == NULL) {
+				_EXCEPTIONT("Unable to read variable \"field\"");
+			}
+
+			for (int t = 0; t < nTimes; t++) {
+				varField->set_cur(t, 0, 0);
+				if (!varField->get(&(dataSource[0]), 1, nLevels, nSourceCount)) {
+					_EXCEPTION1("Unable to read benchmark file \"%s\"",
+						strScratchFile.c_str());
+				}
+			}
+		}
+		AnnounceBenchmarkStage(vecThreads[n], "read",
+			dFieldBytes, dSlices, BenchmarkWallTime() - dTimeStart);
+
+		// Apply stage, after one untimed application
+		session.Apply(&(dataSource[0]), &(dataTarget[0]), nLevels);
+
+		dTimeStart = BenchmarkWallTime();
+		for (int t = 0; t < nTimes; t++) {
+			session.Apply(&(dataSource[0]), &(dataTarget[0]), nLevels);
+			dChecksum += dataTarget[static_cast<size_t>(t) % sTargetValues];
+		}
+		AnnounceBenchmarkStage(vecThreads[n], "spmv",
+			dApplyBytes, dSlices, BenchmarkWallTime() - dTimeStart);
+	}
+
+	AnnounceEndBlock(NULL);
+
+	if (fRemoveScratchFile) {
+		remove(strScratchFile.c_str());
+	}
+
+	Announce("Checksum: %1.15e", dChecksum);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 extern "C" 
 int ApplyOfflineMap(
 	std::string strInputMap,
@@ -106,27 +360,78 @@ int ApplyOfflineMap(
 
 try {
 
-	// Check parameters
-	if (strInputMap == "") {
-		_EXCEPTIONT("No map specified");
-	}
-	if ((optsApply.strInputData == "") && (optsApply.strInputDataList == "")) {
-		_EXCEPTIONT("No input data (--in_data) or (--in_data_list) specified");
-	}
-	if ((optsApply.strInputData != "") && (optsApply.strInputDataList != "")) {
-		_EXCEPTIONT("Only one of --in_data or --in_data_list may be specified");
-	}
-	if ((optsApply.strOutputData == "") && (optsApply.strOutputDataList == "")) {
-		_EXCEPTIONT("No output data (--out_data) or (--out_data_list)");
+	// Keep the maps resident and serve requests
+	if (optsApply.strServerSocket != "") {
+		if (optsApply.strConnectSocket != "") {
+			_EXCEPTIONT("--server and --connect cannot both be specified");
+		}
+		if (strInputMap == "") {
+			_EXCEPTIONT("No map specified");
+		}
+		if ((optsApply.strInputData != "") || (optsApply.strInputDataList != "")) {
+			_EXCEPTIONT("Input data is specified in requests to --server");
+		}
+#if defined(TEMPEST_MPIOMP)
+		int nMPISize;
+		MPI_Comm_size(MPI_COMM_WORLD, &nMPISize);
+		if (nMPISize > 1) {
+			_EXCEPTIONT("--server must be run on a single MPI rank");
+		}
+#endif
+		std::vector<std::string> vecMapFiles;
+		ParseVariableList(strInputMap, vecMapFiles);
+
+		RemapServer server(optsApply);
+		for (int m = 0; m < vecMapFiles.size(); m++) {
+			server.AddMap(vecMapFiles[m]);
+		}
+		server.Serve(optsApply.strServerSocket, optsApply.nServerWorkers);
+		return 0;
 	}
-	if ((optsApply.strOutputData != "") && (optsApply.strOutputDataList != "")) {
-		_EXCEPTIONT("Only one of --out_data or --out_data_list may be specified");
+
+	// Stop a server
+	if (optsApply.fServerShutdown) {
+		if (optsApply.strConnectSocket == "") {
+			_EXCEPTIONT("--shutdown requires --connect");
+		}
+		RemapServerRequest req;
+		req.fShutdown = true;
+		RemapServer::SendRequest(optsApply.strConnectSocket, req);
+		Announce("Shutdown requested");
+		return 0;
 	}
-	if ((optsApply.strInputData != "") && (optsApply.strOutputData == "")) {
-		_EXCEPTIONT("If --in_data is specified then --out_data must also be specified");
+
+	// Check parameters
+	if ((strInputMap == "") && (optsApply.strConnectSocket == "")) {
+		_EXCEPTIONT("No map specified");
 	}
-	if ((optsApply.strInputDataList != "") && (optsApply.strOutputDataList == "")) {
-		_EXCEPTIONT("If --in_data_list is specified then --out_data_list must also be specified");
+	if (optsApply.fBenchmark) {
+		if (optsApply.strConnectSocket != "") {
+			_EXCEPTIONT("--benchmark and --connect cannot both be specified");
+		}
+		if ((optsApply.strInputData != "") || (optsApply.strInputDataList != "")) {
+			_EXCEPTIONT("--benchmark uses synthetic data; "
+				"--in_data and --in_data_list cannot be specified");
+		}
+	} else {
+		if ((optsApply.strInputData == "") && (optsApply.strInputDataList == "")) {
+			_EXCEPTIONT("No input data (--in_data) or (--in_data_list) specified");
+		}
+		if ((optsApply.strInputData != "") && (optsApply.strInputDataList != "")) {
+			_EXCEPTIONT("Only one of --in_data or --in_data_list may be specified");
+		}
+		if ((optsApply.strOutputData == "") && (optsApply.strOutputDataList == "")) {
+			_EXCEPTIONT("No output data (--out_data) or (--out_data_list)");
+		}
+		if ((optsApply.strOutputData != "") && (optsApply.strOutputDataList != "")) {
+			_EXCEPTIONT("Only one of --out_data or --out_data_list may be specified");
+		}
+		if ((optsApply.strInputData != "") && (optsApply.strOutputData == "")) {
+			_EXCEPTIONT("If --in_data is specified then --out_data must also be specified");
+		}
+		if ((optsApply.strInputDataList != "") && (optsApply.strOutputDataList == "")) {
+			_EXCEPTIONT("If --in_data_list is specified then --out_data_list must also be specified");
+		}
 	}
 
 	// Load input file list
@@ -134,47 +439,19 @@ try {
 
 	if (optsApply.strInputData.length() != 0) {
 		vecInputDataFiles.push_back(optsApply.strInputData);
-
-	} else {
-		std::ifstream ifInputFileList(optsApply.strInputDataList.c_str());
-		if (!ifInputFileList.is_open()) {
-			_EXCEPTION1("Unable to open file \"%s\"",
-				optsApply.strInputDataList.c_str());
-		}
-		std::string strFileLine;
-		while (std::getline(ifInputFileList, strFileLine)) {
-			if (strFileLine.length() == 0) {
-				continue;
-			}
-			if (strFileLine[0] == '#') {
-				continue;
-			}
-			vecInputDataFiles.push_back(strFileLine);
-		}
+	} else if (optsApply.strInputDataList.length() != 0) {
+		STLStringHelper::ParseFileList(optsApply.strInputDataList, vecInputDataFiles);
 	}
 
 	// Load output file list
 	std::vector<std::string> vecOutputDataFiles;
 
-	if (optsApply.strOutputData.length() != 0) {
+	if (optsApply.fBenchmark) {
+		// --out_data only names the scratch file of the benchmark
+	} else if (optsApply.strOutputData.length() != 0) {
 		vecOutputDataFiles.push_back(optsApply.strOutputData);
-
 	} else {
-		std::ifstream ifOutputFileList(optsApply.strOutputDataList.c_str());
-		if (!ifOutputFileList.is_open()) {
-			_EXCEPTION1("Unable to open file \"%s\"",
-				optsApply.strOutputDataList.c_str());
-		}
-		std::string strFileLine;
-		while (std::getline(ifOutputFileList, strFileLine)) {
-			if (strFileLine.length() == 0) {
-				continue;
-			}
-			if (strFileLine[0] == '#') {
-				continue;
-			}
-			vecOutputDataFiles.push_back(strFileLine);
-		}
+		STLStringHelper::ParseFileList(optsApply.strOutputDataList, vecOutputDataFiles);
 	}
 
 	// Check length
@@ -193,6 +470,32 @@ try {
 	if (optsApply.fPreserveAll && (vecPreserveVariableStrings.size() != 0)) {
 		_EXCEPTIONT("--preserveall and --preserve cannot both be specified");
 	}
+	if (optsApply.fTranspose && optsApply.fAdjoint) {
+		_EXCEPTIONT("--transpose and --adjoint cannot both be specified");
+	}
+
+	// Send the requests to the server holding the map, which applies its
+	// own map options
+	if (optsApply.strConnectSocket != "") {
+		for (int f = 0; f < vecInputDataFiles.size(); f++) {
+			AnnounceStartBlock("Requesting \"%s\"", vecInputDataFiles[f].c_str());
+
+			RemapServerRequest req;
+			req.strMap = strInputMap;
+			req.strInputData = vecInputDataFiles[f];
+			req.strOutputData = vecOutputDataFiles[f];
+			req.strVariables = optsApply.strVariables;
+			req.strNColName = optsApply.strNColName;
+			req.fOutputDouble = optsApply.fOutputDouble;
+			req.strPreserveVariables = optsApply.strPreserveVariables;
+			req.fPreserveAll = optsApply.fPreserveAll;
+
+			RemapServer::SendRequest(optsApply.strConnectSocket, req);
+
+			AnnounceEndBlock("Done");
+		}
+		return 0;
+	}
 
 #if defined(TEMPEST_MPIOMP)
 	// Spread files across nodes
@@ -202,8 +505,13 @@ try {
 	int nMPISize;
 	MPI_Comm_size(MPI_COMM_WORLD, &nMPISize);
 
-	Announce("Executing ApplyOfflineMap with %i threads over %i files",
-		nMPISize, vecInputDataFiles.size());
+	if (optsApply.fDistributeSlices) {
+		Announce("Executing ApplyOfflineMap with %i threads over the slices of %i files",
+			nMPISize, vecInputDataFiles.size());
+	} else {
+		Announce("Executing ApplyOfflineMap with %i threads over %i files",
+			nMPISize, vecInputDataFiles.size());
+	}
 #endif
 
 #if defined(TEMPEST_MPIOMP)
@@ -276,43 +584,82 @@ try {
 	// OfflineMap
 	AnnounceStartBlock("Loading offline map");
 
+	// Coordinates other than the target cell centers are not needed
 	OfflineMap mapRemap;
+	mapRemap.SetReadVertexArrays(false);
+	if ((!optsApply.fTranspose) && (!optsApply.fAdjoint)) {
+		mapRemap.SetReadSourceCenters(false);
+	}
 	mapRemap.Read(strInputMap);
-	mapRemap.SetFillValueOverrideDbl(optsApply.dFillValueOverride);
-	mapRemap.SetFillValueOverride(static_cast<float>(optsApply.dFillValueOverride));
-	mapRemap.SetEnforcementBounds(optsApply.strEnforceBounds);
 
 	AnnounceEndBlock("Done");
 
+	// The transpose is formed once from the weights in memory (its CSR
+	// form is the CSC form of the map) and reused for every file
+	OfflineMap mapTranspose;
+	OfflineMap * pmapApply = &mapRemap;
+
+	if (optsApply.fTranspose || optsApply.fAdjoint) {
+		if (optsApply.fAdjoint) {
+			AnnounceStartBlock("Forming adjoint of offline map");
+		} else {
+			AnnounceStartBlock("Forming transpose of offline map");
+		}
+		mapTranspose.SetTranspose(mapRemap, optsApply.fAdjoint);
+		pmapApply = &mapTranspose;
+		AnnounceEndBlock("Done");
+	}
+
+	pmapApply->SetFillValueOverrideDbl(optsApply.dFillValueOverride);
+	pmapApply->SetFillValueOverride(static_cast<float>(optsApply.dFillValueOverride));
+	pmapApply->SetEnforcementBounds(optsApply.strEnforceBounds);
+	pmapApply->SetDistributeSlices(optsApply.fDistributeSlices);
+	pmapApply->SetParallelVariables(optsApply.fParallelVariables);
+	pmapApply->SetRenormalizeFillValues(optsApply.fRenormalize);
+	pmapApply->SetReorderForApply(optsApply.fReorder);
+
+	// Measure throughput on synthetic data rather than remapping files
+	if (optsApply.fBenchmark) {
+		BenchmarkOfflineMap(*pmapApply, optsApply);
+	}
+
 	for (int f = 0; f < vecInputDataFiles.size(); f++) {
 
 #if defined(TEMPEST_MPIOMP)
-		if (f % nMPISize != nMPIRank) {
+		if ((!optsApply.fDistributeSlices) && (f % nMPISize != nMPIRank)) {
 			continue;
 		}
 #endif
 		AnnounceStartBlock("Processing \"%s\"", vecInputDataFiles[f].c_str());
 
 		// Apply the map
-		mapRemap.Apply(
+		pmapApply->Apply(
 			vecInputDataFiles[f],
 			vecOutputDataFiles[f],
 			vecVariableStrings,
 			optsApply.strNColName,
 			optsApply.fOutputDouble,
 			false);
-	
+
+#if defined(TEMPEST_MPIOMP)
+		// Only rank 0 writes the output file of a distributed application
+		if (optsApply.fDistributeSlices && (nMPIRank != 0)) {
+			AnnounceEndBlock("Done");
+			continue;
+		}
+#endif
+
 		// Copy variables from input file to output file
 		if (optsApply.fPreserveAll) {
 			AnnounceStartBlock("Preserving variables");
-			mapRemap.PreserveAllVariables(
+			pmapApply->PreserveAllVariables(
 				vecInputDataFiles[f],
 				vecOutputDataFiles[f]);
 			AnnounceEndBlock(NULL);
 
 		} else if (vecPreserveVariableStrings.size() != 0) {
 			AnnounceStartBlock("Preserving variables");
-			mapRemap.PreserveVariables(
+			pmapApply->PreserveVariables(
 				vecInputDataFiles[f],
 				vecOutputDataFiles[f],
 				vecPreserveVariableStrings);
@@ -357,6 +704,12 @@ try {
 
 } catch(Exception & e) {
 	Announce(e.ToString().c_str());
+#if defined(TEMPEST_MPIOMP)
+	// Other ranks of a distributed application would wait indefinitely
+	if (optsApply.fDistributeSlices) {
+		MPI_Abort(MPI_COMM_WORLD, -1);
+	}
+#endif
 	return (-1);
 
 } catch(...) {
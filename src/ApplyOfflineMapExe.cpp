@@ -61,6 +61,20 @@ int main(int argc, char** argv) {
 		CommandLineBool(optsApply.fPreserveAll, "preserveall");
 		CommandLineDouble(optsApply.dFillValueOverride, "fillvalue", 0.0);
 		CommandLineString(optsApply.strLogDir, "logdir", "");
+		CommandLineBool(optsApply.fDistributeSlices, "distribute_slices");
+		CommandLineBool(optsApply.fParallelVariables, "parallel_vars");
+		CommandLineBool(optsApply.fRenormalize, "renormalize");
+		CommandLineBool(optsApply.fTranspose, "transpose");
+		CommandLineBool(optsApply.fAdjoint, "adjoint");
+		CommandLineBool(optsApply.fReorder, "reorder");
+		CommandLineString(optsApply.strServerSocket, "server", "");
+		CommandLineInt(optsApply.nServerWorkers, "server_workers", 2);
+		CommandLineString(optsApply.strConnectSocket, "connect", "");
+		CommandLineBool(optsApply.fServerShutdown, "shutdown");
+		CommandLineBool(optsApply.fBenchmark, "benchmark");
+		CommandLineInt(optsApply.nBenchmarkLevels, "bench_levels", 32);
+		CommandLineInt(optsApply.nBenchmarkTimes, "bench_times", 4);
+		CommandLineString(optsApply.strBenchmarkThreads, "bench_threads", "");
 
 		ParseCommandLine(argc, argv);
 	EndCommandLine(argv)
@@ -0,0 +1,615 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    BenchmarkKernels.cpp
+///	\author  Paul Ullrich
+///	\version October 14, 2026
+///
+///	<remarks>
+///		Copyright 2026 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "CommandLine.h"
+#include "Announce.h"
+#include "Exception.h"
+#include "GridElements.h"
+#include "MeshUtilitiesFuzzy.h"
+#include "SparseMatrix.h"
+#include "FiniteVolumeTools.h"
+#include "TriangularQuadrature.h"
+#include "LinearRemapSE0.h"
+#include "TempestRemapAPI.h"
+
+#include "netcdfcpp.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Maximum number of faces sampled by the per-face kernels (fit arrays
+///		and consistency / conservation), so that the cost of a benchmark
+///		grows slowly with resolution.
+///	</summary>
+static const int BenchmarkMaximumSampledFaces = 4096;
+
+///	<summary>
+///		Sink for kernel results, so that no kernel can be optimized away.
+///	</summary>
+static volatile double s_dBenchmarkSink = 0.0;
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Parse a comma-separated list.
+///	</summary>
+static void ParseList(
+	const std::string & strList,
+	std::vector<std::string> & vecItems
+) {
+	size_t iLast = 0;
+	for (size_t i = 0; i <= strList.length(); i++) {
+		if ((i == strList.length()) || (strList[i] == ',')) {
+			if (i != iLast) {
+				vecItems.push_back(strList.substr(iLast, i - iLast));
+			}
+			iLast = i+1;
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A mesh on which kernels are benchmarked.
+///	</summary>
+struct BenchmarkMesh {
+
+	///	<summary>
+	///		Mesh type ("cs", "ico" or "rll").
+	///	</summary>
+	std::string strType;
+
+	///	<summary>
+	///		Resolution parameter used to generate the mesh.
+	///	</summary>
+	int nResolution;
+
+	///	<summary>
+	///		The mesh, with EdgeMap and ReverseNodeArray constructed.
+	///	</summary>
+	Mesh mesh;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Time a kernel nRepeat times after one untimed warm-up call, and
+///		write the minimum and median times as a row of the CSV output.
+///	</summary>
+template <typename Kernel>
+static void RunBenchmark(
+	FILE * fp,
+	const char * szKernel,
+	const BenchmarkMesh & bmesh,
+	long long nItems,
+	int nRepeat,
+	Kernel kernel
+) {
+	kernel();
+
+	std::vector<double> vecSeconds(nRepeat);
+	for (int r = 0; r < nRepeat; r++) {
+		std::chrono::steady_clock::time_point tpStart =
+			std::chrono::steady_clock::now();
+
+		kernel();
+
+		vecSeconds[r] =
+			std::chrono::duration<double>(
+				std::chrono::steady_clock::now() - tpStart).count();
+	}
+
+	std::sort(vecSeconds.begin(), vecSeconds.end());
+
+	const double dMin = vecSeconds[0];
+	const double dMedian = vecSeconds[nRepeat / 2];
+	const double dNsPerItem =
+		(nItems > 0)?(1.0e9 * dMin / static_cast<double>(nItems)):(0.0);
+
+	fprintf(fp, "%s,%s,%i,%i,%lli,%i,%1.6e,%1.6e,%1.4f\n",
+		szKernel,
+		bmesh.strType.c_str(),
+		bmesh.nResolution,
+		static_cast<int>(bmesh.mesh.faces.size()),
+		nItems,
+		nRepeat,
+		dMin,
+		dMedian,
+		dNsPerItem);
+	fflush(fp);
+
+	Announce("%-32s %8.3f ms (%1.2f ns per item)",
+		szKernel, 1.0e3 * dMin, dNsPerItem);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Get the centroid of a Face, projected onto the unit sphere.
+///	</summary>
+static Node GetFaceCentroid(
+	const Mesh & mesh,
+	int iFace
+) {
+	const Face & face = mesh.faces[iFace];
+
+	Node nodeCentroid;
+	for (int i = 0; i < face.edges.size(); i++) {
+		nodeCentroid = nodeCentroid + mesh.nodes[face[i]];
+	}
+	return nodeCentroid.Normalized();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Generate a benchmark mesh of the given type and resolution.
+///	</summary>
+static void GenerateBenchmarkMesh(
+	const std::string & strType,
+	int nResolution,
+	BenchmarkMesh & bmesh
+) {
+	bmesh.strType = strType;
+	bmesh.nResolution = nResolution;
+
+	int iResult;
+	if (strType == "cs") {
+		iResult = GenerateCSMesh(bmesh.mesh, nResolution, "", "Netcdf4");
+
+	} else if (strType == "ico") {
+		iResult = GenerateICOMesh(bmesh.mesh, nResolution, false, "", "Netcdf4");
+
+	} else if (strType == "rll") {
+		iResult = GenerateRLLMesh(
+			bmesh.mesh,
+			2 * nResolution, nResolution,
+			0.0, 360.0, -90.0, 90.0,
+			false, false, false,
+			"", "lon", "lat",
+			"", "Netcdf4",
+			false);
+
+	} else {
+		_EXCEPTION1("Unknown mesh type \"%s\" (expected cs, ico or rll)",
+			strType.c_str());
+	}
+
+	if (iResult != 0) {
+		_EXCEPTION2("Unable to generate %s mesh at resolution %i",
+			strType.c_str(), nResolution);
+	}
+
+	bmesh.mesh.RemoveZeroEdges();
+	bmesh.mesh.ConstructEdgeMap(false);
+	bmesh.mesh.ConstructReverseNodeArray();
+	bmesh.mesh.CalculateFaceAreas(false);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Benchmark all kernels on a mesh.
+///	</summary>
+static void BenchmarkMeshKernels(
+	FILE * fp,
+	const BenchmarkMesh & bmesh,
+	int nRepeat
+) {
+	const Mesh & mesh = bmesh.mesh;
+
+	const int nFaces = static_cast<int>(mesh.faces.size());
+	const int nNodes = static_cast<int>(mesh.nodes.size());
+
+	// Faces sampled by the per-face kernels
+	const int nSampleStride =
+		(nFaces + BenchmarkMaximumSampledFaces - 1)
+			/ BenchmarkMaximumSampledFaces;
+
+	std::vector<int> vecSampleFaces;
+	for (int f = 0; f < nFaces; f += nSampleStride) {
+		vecSampleFaces.push_back(f);
+	}
+
+	// Neighbors of each face across its edges, excluding the face itself
+	std::vector< std::vector<int> > vecNeighbors(nFaces);
+	for (int f = 0; f < nFaces; f++) {
+		const Face & face = mesh.faces[f];
+		for (int i = 0; i < face.edges.size(); i++) {
+			EdgeMapConstIterator iter = mesh.edgemap.find(face.edges[i]);
+			if (iter == mesh.edgemap.end()) {
+				continue;
+			}
+			int iOther =
+				(iter->second[0] == f)?(iter->second[1]):(iter->second[0]);
+			if ((iOther != InvalidFace) && (iOther != f)) {
+				vecNeighbors[f].push_back(iOther);
+			}
+		}
+	}
+
+	// Mesh::ConstructEdgeMap
+	{
+		Mesh meshCopy;
+		meshCopy.nodes = mesh.nodes;
+		meshCopy.faces = mesh.faces;
+
+		RunBenchmark(fp, "ConstructEdgeMap", bmesh, nFaces, nRepeat,
+			[&]() {
+				meshCopy.edgemap.clear();
+				meshCopy.ConstructEdgeMap(false);
+				s_dBenchmarkSink += meshCopy.edgemap.size();
+			});
+	}
+
+	// Mesh::CalculateFaceAreas
+	{
+		Mesh meshCopy;
+		meshCopy.nodes = mesh.nodes;
+		meshCopy.faces = mesh.faces;
+
+		RunBenchmark(fp, "CalculateFaceAreas", bmesh, nFaces, nRepeat,
+			[&]() {
+				s_dBenchmarkSink += meshCopy.CalculateFaceAreas(false);
+			});
+	}
+
+	// MeshUtilitiesFuzzy::CalculateEdgeIntersections, between each edge and
+	// the arc joining the centroids of the two faces sharing it
+	{
+		std::vector<Node> vecCentroid(nFaces);
+		for (int f = 0; f < nFaces; f++) {
+			vecCentroid[f] = GetFaceCentroid(mesh, f);
+		}
+
+		std::vector<Node> vecArcNodes;
+		std::vector<Node> vecEdgeNodes;
+		EdgeMapConstIterator iter = mesh.edgemap.begin();
+		for (; iter != mesh.edgemap.end(); iter++) {
+			if ((iter->second[0] == InvalidFace) ||
+			    (iter->second[1] == InvalidFace)
+			) {
+				continue;
+			}
+			vecArcNodes.push_back(vecCentroid[iter->second[0]]);
+			vecArcNodes.push_back(vecCentroid[iter->second[1]]);
+			vecEdgeNodes.push_back(mesh.nodes[iter->first[0]]);
+			vecEdgeNodes.push_back(mesh.nodes[iter->first[1]]);
+		}
+
+		const int nArcs = static_cast<int>(vecArcNodes.size() / 2);
+
+		RunBenchmark(fp, "CalculateEdgeIntersections", bmesh, nArcs, nRepeat,
+			[&]() {
+				MeshUtilitiesFuzzy utils;
+				std::vector<Node> vecIntersections;
+				size_t sIntersections = 0;
+				for (int i = 0; i < nArcs; i++) {
+					vecIntersections.clear();
+					utils.CalculateEdgeIntersections(
+						vecEdgeNodes[2*i], vecEdgeNodes[2*i+1],
+						Edge::Type_GreatCircleArc,
+						vecArcNodes[2*i], vecArcNodes[2*i+1],
+						Edge::Type_GreatCircleArc,
+						vecIntersections);
+					sIntersections += vecIntersections.size();
+				}
+				s_dBenchmarkSink += sIntersections;
+			});
+	}
+
+	// MeshUtilitiesFuzzy::FindFaceNearNode, from each node with at least
+	// three adjacent faces towards the centroid of its first adjacent face
+	{
+		std::vector<int> vecNodes;
+		std::vector<Node> vecTowards;
+		for (int n = 0; n < nNodes; n++) {
+			const ReverseNodeArray::FaceRange range = mesh.revnodearray[n];
+			if (range.size() < 3) {
+				continue;
+			}
+			vecNodes.push_back(n);
+			vecTowards.push_back(GetFaceCentroid(mesh, range[0]));
+		}
+
+		RunBenchmark(fp, "FindFaceNearNode", bmesh, vecNodes.size(), nRepeat,
+			[&]() {
+				MeshUtilitiesFuzzy utils;
+				long long lSum = 0;
+				for (size_t i = 0; i < vecNodes.size(); i++) {
+					lSum += utils.FindFaceNearNode(
+						mesh,
+						vecNodes[i],
+						vecTowards[i],
+						Edge::Type_GreatCircleArc);
+				}
+				s_dBenchmarkSink += static_cast<double>(lSum);
+			});
+	}
+
+	// SparseMatrix::Apply, for an averaging operator over each face and
+	// its neighbors
+	{
+		SparseMatrix<double> smat;
+		for (int f = 0; f < nFaces; f++) {
+			const double dWeight = 1.0 / (vecNeighbors[f].size() + 1);
+			smat(f, f) = dWeight;
+			for (size_t i = 0; i < vecNeighbors[f].size(); i++) {
+				smat(f, vecNeighbors[f][i]) = dWeight;
+			}
+		}
+		smat.Finalize();
+
+		DataArray1D<double> dataIn(nFaces);
+		DataArray1D<double> dataOut(nFaces);
+		for (int f = 0; f < nFaces; f++) {
+			dataIn[f] = mesh.nodes[mesh.faces[f][0]].z;
+		}
+
+		RunBenchmark(fp, "SparseMatrix::Apply", bmesh,
+			smat.GetCSRValues().GetRows(), nRepeat,
+			[&]() {
+				smat.Apply(dataIn, dataOut);
+				s_dBenchmarkSink += dataOut[nFaces / 2];
+			});
+	}
+
+	// BuildFitArray and InvertFitArray_Corrected, for a fourth-order finite
+	// volume reconstruction as in LinearRemapFVtoFV
+	{
+		const int nOrder = 4;
+		const int nFitWeightsExponent = nOrder + 2;
+
+		TriangularQuadratureRule triquadrule(8);
+
+#ifdef RECTANGULAR_TRUNCATION
+		const int nRequiredFaceSetSize = nOrder * nOrder;
+#endif
+#ifdef TRIANGULAR_TRUNCATION
+		const int nRequiredFaceSetSize = nOrder * (nOrder + 1) / 2;
+#endif
+
+		std::vector<AdjacentFaceVector> vecAdjFaces(vecSampleFaces.size());
+		for (size_t i = 0; i < vecSampleFaces.size(); i++) {
+			GetAdjacentFaceVectorByEdge(
+				mesh,
+				vecSampleFaces[i],
+				nRequiredFaceSetSize,
+				vecAdjFaces[i]);
+		}
+
+		RunBenchmark(fp, "BuildFitArray+InvertFitArray", bmesh,
+			vecSampleFaces.size(), nRepeat,
+			[&]() {
+				DataArray1D<double> dConstraint;
+				DataArray2D<double> dFitArray;
+				DataArray1D<double> dFitWeights;
+				DataArray2D<double> dFitArrayPlus;
+
+				double dSum = 0.0;
+				for (size_t i = 0; i < vecSampleFaces.size(); i++) {
+					BuildFitArray(
+						mesh,
+						triquadrule,
+						vecSampleFaces[i],
+						vecAdjFaces[i],
+						nOrder,
+						nFitWeightsExponent,
+						dConstraint,
+						dFitArray,
+						dFitWeights);
+
+					InvertFitArray_Corrected(
+						dConstraint,
+						dFitArray,
+						dFitWeights,
+						dFitArrayPlus);
+
+					dSum += dFitArrayPlus(0,0);
+				}
+				s_dBenchmarkSink += dSum;
+			});
+	}
+
+	// ForceConsistencyConservation3, for a fourth-order spectral element
+	// (16 nodes) overlapping the face and its neighbors as in LinearRemapSE4
+	{
+		const int nP = 4;
+
+		std::vector< DataArray1D<double> > vecSourceArea(vecSampleFaces.size());
+		std::vector< DataArray1D<double> > vecTargetArea(vecSampleFaces.size());
+		std::vector< DataArray2D<double> > vecCoeff(vecSampleFaces.size());
+
+		for (size_t i = 0; i < vecSampleFaces.size(); i++) {
+			const int f = vecSampleFaces[i];
+			const int nTargets = static_cast<int>(vecNeighbors[f].size()) + 1;
+			const double dArea = mesh.vecFaceArea[f];
+
+			vecSourceArea[i].Allocate(nP * nP);
+			vecTargetArea[i].Allocate(nTargets);
+
+			double dSourceWeight = 0.0;
+			for (int k = 0; k < nP * nP; k++) {
+				vecSourceArea[i][k] = 1.0 + 0.5 * static_cast<double>(k % 3);
+				dSourceWeight += vecSourceArea[i][k];
+			}
+			for (int k = 0; k < nP * nP; k++) {
+				vecSourceArea[i][k] *= dArea / dSourceWeight;
+			}
+
+			double dTargetWeight = 0.0;
+			for (int j = 0; j < nTargets; j++) {
+				vecTargetArea[i][j] = 1.0 + 0.25 * static_cast<double>(j % 4);
+				dTargetWeight += vecTargetArea[i][j];
+			}
+			for (int j = 0; j < nTargets; j++) {
+				vecTargetArea[i][j] *= dArea / dTargetWeight;
+			}
+		}
+
+		// Dense and sparse constraint paths
+		for (int iSparse = 0; iSparse < 2; iSparse++) {
+			const bool fSparse = (iSparse == 1);
+
+			RunBenchmark(fp,
+				(fSparse)?("ForceConsistencyConservation3_Sparse")
+				         :("ForceConsistencyConservation3"), bmesh,
+				vecSampleFaces.size(), nRepeat,
+				[&, fSparse]() {
+					double dSum = 0.0;
+					for (size_t i = 0; i < vecSampleFaces.size(); i++) {
+						const int nTargets = vecTargetArea[i].GetRows();
+
+						// Perturbed first-order coefficients
+						DataArray2D<double> & dCoeff = vecCoeff[i];
+						dCoeff.Allocate(nTargets, nP * nP);
+						for (int j = 0; j < nTargets; j++) {
+						for (int k = 0; k < nP * nP; k++) {
+							dCoeff[j][k] =
+								vecTargetArea[i][j] / mesh.vecFaceArea[vecSampleFaces[i]]
+								* (1.0 + 0.01 * static_cast<double>((j + k) % 5));
+						}
+						}
+
+						ForceConsistencyConservation3(
+							vecSourceArea[i],
+							vecTargetArea[i],
+							dCoeff,
+							false,
+							fSparse);
+
+						dSum += dCoeff[0][0];
+					}
+					s_dBenchmarkSink += dSum;
+				});
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv) {
+
+	NcError error(NcError::silent_nonfatal);
+
+try {
+	// Output file
+	std::string strOutputFile;
+
+	// Mesh types
+	std::string strMeshTypes;
+
+	// Resolutions of CS meshes
+	std::string strCSResolutions;
+
+	// Resolutions of ICO meshes
+	std::string strICOResolutions;
+
+	// Resolutions (number of latitudes) of RLL meshes
+	std::string strRLLResolutions;
+
+	// Number of timed repetitions of each kernel
+	int nRepeat;
+
+	// Parse the command line
+	BeginCommandLine()
+		CommandLineString(strOutputFile, "out", "benchmark.csv");
+		CommandLineString(strMeshTypes, "mesh", "cs,ico,rll");
+		CommandLineString(strCSResolutions, "cs_res", "16,32,64");
+		CommandLineString(strICOResolutions, "ico_res", "16,32,64");
+		CommandLineString(strRLLResolutions, "rll_res", "45,90,180");
+		CommandLineInt(nRepeat, "repeat", 5);
+
+		ParseCommandLine(argc, argv);
+	EndCommandLine(argv)
+
+	AnnounceBanner();
+
+	if (nRepeat < 1) {
+		_EXCEPTIONT("--repeat must be at least 1");
+	}
+
+	std::vector<std::string> vecMeshTypes;
+	ParseList(strMeshTypes, vecMeshTypes);
+
+	FILE * fp = fopen(strOutputFile.c_str(), "w");
+	if (fp == NULL) {
+		_EXCEPTION1("Unable to open output file \"%s\"", strOutputFile.c_str());
+	}
+
+	fprintf(fp, "kernel,mesh,resolution,faces,items,repeats,"
+		"min_seconds,median_seconds,ns_per_item\n");
+
+	for (size_t m = 0; m < vecMeshTypes.size(); m++) {
+		const std::string & strType = vecMeshTypes[m];
+
+		std::string strResolutions;
+		if (strType == "cs") {
+			strResolutions = strCSResolutions;
+		} else if (strType == "ico") {
+			strResolutions = strICOResolutions;
+		} else if (strType == "rll") {
+			strResolutions = strRLLResolutions;
+		} else {
+			_EXCEPTION1("Unknown mesh type \"%s\" (expected cs, ico or rll)",
+				strType.c_str());
+		}
+
+		std::vector<std::string> vecResolutions;
+		ParseList(strResolutions, vecResolutions);
+
+		for (size_t r = 0; r < vecResolutions.size(); r++) {
+			const int nResolution = std::stoi(vecResolutions[r]);
+
+			BenchmarkMesh bmesh;
+
+			AnnounceStartBlock("Generating %s mesh (resolution %i)",
+				strType.c_str(), nResolution);
+			GenerateBenchmarkMesh(strType, nResolution, bmesh);
+			AnnounceEndBlock("Done");
+
+			AnnounceStartBlock("Benchmarking %s mesh with %i faces",
+				strType.c_str(), static_cast<int>(bmesh.mesh.faces.size()));
+			BenchmarkMeshKernels(fp, bmesh, nRepeat);
+			AnnounceEndBlock("Done");
+		}
+	}
+
+	fclose(fp);
+
+	AnnounceBanner();
+
+	return (0);
+
+} catch(Exception & e) {
+	Announce(e.ToString().c_str());
+	return (-1);
+
+} catch(...) {
+	return (-2);
+}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
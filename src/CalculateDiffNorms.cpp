@@ -26,7 +26,185 @@
 #include "netcdfcpp.h"
 
 #include <cmath>
+#include <algorithm>
 #include <iostream>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Number of data points in each chunk of the norm reductions.  Partial
+///		results are formed over fixed chunks and combined pairwise, so that
+///		norms do not depend on the number of threads.
+///	</summary>
+static const int DiffNormsChunkSize = 4096;
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Partial sums and extrema accumulated by the norm reductions.
+///	</summary>
+struct DiffNormsPartial {
+	double dNormL1;
+	double dNormL2;
+	double dNormLi;
+
+	double dSumL1;
+	double dSumL2;
+	double dSumLi;
+
+	double dMinA;
+	double dMaxA;
+	double dMinB;
+	double dMaxB;
+
+	// First value of A that is not positive, if any
+	bool fHasNonPositiveA;
+	double dFirstNonPositiveA;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Combine the partial results of two chunks, the second of which
+///		follows the first.
+///	</summary>
+static void CombineDiffNormsPartial(
+	DiffNormsPartial & a,
+	const DiffNormsPartial & b
+) {
+	a.dNormL1 += b.dNormL1;
+	a.dNormL2 += b.dNormL2;
+	a.dSumL1 += b.dSumL1;
+	a.dSumL2 += b.dSumL2;
+
+	a.dNormLi = std::max(a.dNormLi, b.dNormLi);
+	a.dSumLi = std::max(a.dSumLi, b.dSumLi);
+
+	a.dMinA = std::min(a.dMinA, b.dMinA);
+	a.dMaxA = std::max(a.dMaxA, b.dMaxA);
+	a.dMinB = std::min(a.dMinB, b.dMinB);
+	a.dMaxB = std::max(a.dMaxB, b.dMaxB);
+
+	if (!a.fHasNonPositiveA) {
+		a.fHasNonPositiveA = b.fHasNonPositiveA;
+		a.dFirstNonPositiveA = b.dFirstNonPositiveA;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Accumulate weighted norms of the difference between two fields.
+///		vecPartials is work space that is retained between calls.
+///	</summary>
+static void CalculateDiffNormsPartial(
+	const DataArray1D<double> & dDataA,
+	const DataArray1D<double> & dDataB,
+	const double * pWeights,
+	int nTotalDataSize,
+	std::vector<DiffNormsPartial> & vecPartials,
+	DiffNormsPartial & result
+) {
+	if (nTotalDataSize <= 0) {
+		_EXCEPTIONT("No data to compare");
+	}
+
+	const int nChunks =
+		(nTotalDataSize + DiffNormsChunkSize - 1) / DiffNormsChunkSize;
+
+	vecPartials.resize(nChunks);
+
+#pragma omp parallel for schedule(static)
+	for (int c = 0; c < nChunks; c++) {
+		const int iBegin = c * DiffNormsChunkSize;
+		const int iEnd = std::min(iBegin + DiffNormsChunkSize, nTotalDataSize);
+
+		DiffNormsPartial & part = vecPartials[c];
+
+		part.dNormL1 = 0.0;
+		part.dNormL2 = 0.0;
+		part.dNormLi = 0.0;
+		part.dSumL1 = 0.0;
+		part.dSumL2 = 0.0;
+		part.dSumLi = 0.0;
+		part.dMinA = dDataA[iBegin];
+		part.dMaxA = dDataA[iBegin];
+		part.dMinB = dDataB[iBegin];
+		part.dMaxB = dDataB[iBegin];
+		part.fHasNonPositiveA = false;
+		part.dFirstNonPositiveA = 0.0;
+
+		for (int i = iBegin; i < iEnd; i++) {
+			const double dA = dDataA[i];
+			const double dB = dDataB[i];
+			const double dDiff = fabs(dA - dB);
+			const double dWeight = pWeights[i];
+
+			if (dA > part.dMaxA) {
+				part.dMaxA = dA;
+			}
+			if (dA < part.dMinA) {
+				part.dMinA = dA;
+			}
+			if ((!part.fHasNonPositiveA) && (dA <= 0.0)) {
+				part.fHasNonPositiveA = true;
+				part.dFirstNonPositiveA = dA;
+			}
+			if (dB > part.dMaxB) {
+				part.dMaxB = dB;
+			}
+			if (dB < part.dMinB) {
+				part.dMinB = dB;
+			}
+
+			part.dNormL1 += dDiff * dWeight;
+			part.dNormL2 += dDiff * dDiff * dWeight;
+
+			if (dDiff > part.dNormLi) {
+				part.dNormLi = dDiff;
+			}
+
+			part.dSumL1 += dB * dWeight;
+			part.dSumL2 += dB * dB * dWeight;
+
+			if (dB > part.dSumLi) {
+				part.dSumLi = dB;
+			}
+		}
+	}
+
+	// Pairwise combination in a fixed order
+	for (int iStride = 1; iStride < nChunks; iStride *= 2) {
+		for (int c = 0; c + iStride < nChunks; c += 2 * iStride) {
+			CombineDiffNormsPartial(vecPartials[c], vecPartials[c + iStride]);
+		}
+	}
+
+	result = vecPartials[0];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Parse a comma-separated list of variable names.
+///	</summary>
+static void ParseVariableList(
+	const std::string & strVariables,
+	std::vector<std::string> & vecVariableNames
+) {
+	size_t iLast = 0;
+	for (size_t i = 0; i <= strVariables.length(); i++) {
+		if ((i == strVariables.length()) || (strVariables[i] == ',')) {
+			if (i != iLast) {
+				vecVariableNames.push_back(
+					strVariables.substr(iLast, i - iLast));
+			}
+			iLast = i+1;
+		}
+	}
+}
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -41,8 +219,8 @@ try {
 	// Second data file
 	std::string strFileB;
 
-	// Variable to compare
-	std::string strVariableName;
+	// Variables to compare
+	std::string strVariableNames;
 
 	// Mesh file to use
 	std::string strMeshFile;
@@ -66,7 +244,7 @@ try {
 	BeginCommandLine()
 		CommandLineString(strFileA, "a", "");
 		CommandLineString(strFileB, "b", "");
-		CommandLineString(strVariableName, "var", "Psi");
+		CommandLineString(strVariableNames, "var", "Psi");
 		CommandLineBool(fGLL, "gll");
 		CommandLineInt(nP, "np", 4);
 		CommandLineBool(fNoBubble, "no_bubble");
@@ -169,172 +347,171 @@ try {
 		nTotalDataSize = vecOutputDimSizes[0];
 	}
 
-	// Load data from file A
-	AnnounceStartBlock("Loading data from file A");
+	// Parse variable names
+	std::vector<std::string> vecVariableNames;
+	ParseVariableList(strVariableNames, vecVariableNames);
+	if (vecVariableNames.size() == 0) {
+		_EXCEPTIONT("No variables specified");
+	}
 
-	DataArray1D<double> dDataA(nTotalDataSize);
+	// Weights of each data point
+	const double * pWeights = NULL;
+	if (!fGLL) {
+		mesh.CalculateFaceAreas(fContainsConcaveFaces);
+		if (mesh.vecFaceArea.GetRows() < nTotalDataSize) {
+			_EXCEPTION2("Mesh face count (%lu) smaller than data size (%i)",
+				mesh.vecFaceArea.GetRows(), nTotalDataSize);
+		}
+		pWeights = &(mesh.vecFaceArea[0]);
+	} else {
+		pWeights = &(dataUniqueJacobian[0]);
+	}
 
+	// Open data files
 	NcFile ncFileA(strFileA.c_str(), NcFile::ReadOnly);
 	if (!ncFileA.is_valid()) {
 		_EXCEPTION1("Unable to open file \"%s\"", strFileA.c_str());
 	}
 
-	NcVar * varA = ncFileA.get_var(strVariableName.c_str());
-	if (varA == NULL) {
-		_EXCEPTION2("File \"%s\" does not contain variable \"%s\"",
-			strFileA.c_str(), strVariableName.c_str());
-	}
-
-	varA->get(&(dDataA[0]), &(vecOutputDimSizes[0]));
-
-	int nVarASize = varA->get_dim(0)->size();
-
-	ncFileA.close();
-
-	AnnounceEndBlock("Done");
-
-	// Load data from file B
-	AnnounceStartBlock("Loading data from file B");
-
-	DataArray1D<double> dDataB(nTotalDataSize);
-
 	NcFile ncFileB(strFileB.c_str(), NcFile::ReadOnly);
 	if (!ncFileB.is_valid()) {
 		_EXCEPTION1("Unable to open file \"%s\"", strFileB.c_str());
 	}
 
-	NcVar * varB = ncFileB.get_var(strVariableName.c_str());
-	if (varB == NULL) {
-		_EXCEPTION2("File \"%s\" does not contain variable \"%s\"",
-			strFileB.c_str(), strVariableName.c_str());
+	// Output file
+	FILE * fpOutput = NULL;
+	if (strOutputFile != "") {
+		fpOutput = fopen(strOutputFile.c_str(), "a");
+		if (fpOutput == NULL) {
+			_EXCEPTION1("Unable to open output file \"%s\"",
+				strOutputFile.c_str());
+		}
 	}
 
-	varB->get(&(dDataB[0]), &(vecOutputDimSizes[0]));
-
-	int nVarBSize = varB->get_dim(0)->size();
+	// Data are read one slice at a time, and the work arrays are reused
+	// for every variable and slice
+	DataArray1D<double> dDataA(nTotalDataSize);
+	DataArray1D<double> dDataB(nTotalDataSize);
 
-	ncFileB.close();
+	std::vector<DiffNormsPartial> vecPartials;
 
-	AnnounceEndBlock("Done");
-
-	// Check sizes
-	if (nVarASize != nVarBSize) {
-		_EXCEPTION2("Variable size mismatch [%i,%i]", nVarASize, nVarBSize);
-	}
+	const int nSpatialDims = static_cast<int>(vecOutputDimSizes.size());
 
-	// Calculate the difference and store in dDataA
-	double dMaxA = dDataA[0];
-	double dMinA = dDataA[0];
+	for (int v = 0; v < vecVariableNames.size(); v++) {
+		const std::string & strVariableName = vecVariableNames[v];
 
-	double dMaxB = dDataB[0];
-	double dMinB = dDataB[0];
-
-	for (int i = 0; i < nTotalDataSize; i++) {
-		if (dDataA[i] > dMaxA) {
-			dMaxA = dDataA[i];
-		}
-		if (dDataA[i] < dMinA) {
-			dMinA = dDataA[i];
+		NcVar * varA = ncFileA.get_var(strVariableName.c_str());
+		if (varA == NULL) {
+			_EXCEPTION2("File \"%s\" does not contain variable \"%s\"",
+				strFileA.c_str(), strVariableName.c_str());
 		}
 
-		if (dMinA == 0.0) {
-			_EXCEPTIONT("Zero minimum field value");
+		NcVar * varB = ncFileB.get_var(strVariableName.c_str());
+		if (varB == NULL) {
+			_EXCEPTION2("File \"%s\" does not contain variable \"%s\"",
+				strFileB.c_str(), strVariableName.c_str());
 		}
 
-		if (dDataB[i] > dMaxB) {
-			dMaxB = dDataB[i];
+		// Check sizes
+		const int nVarDims = varA->num_dims();
+		if (varB->num_dims() != nVarDims) {
+			_EXCEPTION3("Variable \"%s\" dimension count mismatch [%i,%i]",
+				strVariableName.c_str(), nVarDims, varB->num_dims());
 		}
-		if (dDataB[i] < dMinB) {
-			dMinB = dDataB[i];
+		if (nVarDims < nSpatialDims) {
+			_EXCEPTION2("Variable \"%s\" must have at least %i dimension(s)",
+				strVariableName.c_str(), nSpatialDims);
 		}
 
-		dDataA[i] = fabs(dDataA[i] - dDataB[i]);
-	}
-
-	// Min / Max Norm
-	double dNormLmin;
-	double dNormLmax;
-
-	if (dMaxB == dMinB) {
-		dNormLmin = dMinB - dMinA;
-		dNormLmax = dMaxA - dMaxB;
-	} else {
-		dNormLmin = (dMinB - dMinA) / (dMaxB - dMinB);
-		dNormLmax = (dMaxA - dMaxB) / (dMaxB - dMinB);
-	}
-
-	// Norms and Sums
-	double dNormL1 = 0.0;
-	double dNormL2 = 0.0;
-	double dNormLi = 0.0;
+		int nSlices = 1;
+		std::vector<long> vecPos(nVarDims, 0);
+		std::vector<long> vecSize(nVarDims, 1);
+		for (int d = 0; d < nVarDims; d++) {
+			const long lSizeA = varA->get_dim(d)->size();
+			const long lSizeB = varB->get_dim(d)->size();
+			if (lSizeA != lSizeB) {
+				_EXCEPTION3("Variable \"%s\" size mismatch [%li,%li]",
+					strVariableName.c_str(), lSizeA, lSizeB);
+			}
+			if (d < nVarDims - nSpatialDims) {
+				nSlices *= static_cast<int>(lSizeA);
+			} else {
+				vecSize[d] = vecOutputDimSizes[d - (nVarDims - nSpatialDims)];
+			}
+		}
 
-	double dSumL1 = 0.0;
-	double dSumL2 = 0.0;
-	double dSumLi = 0.0;
+		for (int t = 0; t < nSlices; t++) {
 
-	// Use face areas
-	if (!fGLL) {
-		mesh.CalculateFaceAreas(fContainsConcaveFaces);
+			// Position of this slice
+			int iSlice = t;
+			std::string strSliceIndex;
+			for (int d = nVarDims - nSpatialDims - 1; d >= 0; d--) {
+				vecPos[d] = iSlice % varA->get_dim(d)->size();
+				iSlice /= varA->get_dim(d)->size();
+				strSliceIndex =
+					std::to_string((long long) vecPos[d]) + "," + strSliceIndex;
+			}
 
-		for (int i = 0; i < nTotalDataSize; i++) {
-			dNormL1 += dDataA[i] * mesh.vecFaceArea[i];
-			dNormL2 += dDataA[i] * dDataA[i] * mesh.vecFaceArea[i];
+			AnnounceStartBlock("Comparing %s(%s:)",
+				strVariableName.c_str(), strSliceIndex.c_str());
 
-			if (dDataA[i] > dNormLi) {
-				dNormLi = dDataA[i];
+			varA->set_cur(&(vecPos[0]));
+			if (!varA->get(&(dDataA[0]), &(vecSize[0]))) {
+				_EXCEPTION2("Unable to read variable \"%s\" from \"%s\"",
+					strVariableName.c_str(), strFileA.c_str());
 			}
 
-			dSumL1 += dDataB[i] * mesh.vecFaceArea[i];
-			dSumL2 += dDataB[i] * dDataB[i] * mesh.vecFaceArea[i];
-
-			if (dDataB[i] > dSumLi) {
-				dSumLi = dDataB[i];
+			varB->set_cur(&(vecPos[0]));
+			if (!varB->get(&(dDataB[0]), &(vecSize[0]))) {
+				_EXCEPTION2("Unable to read variable \"%s\" from \"%s\"",
+					strVariableName.c_str(), strFileB.c_str());
 			}
-		}
 
-		dNormL1 = dNormL1 / dSumL1;
-		dNormL2 = sqrt(dNormL2 / dSumL2);
-		dNormLi = dNormLi / dSumLi;
+			DiffNormsPartial norms;
+			CalculateDiffNormsPartial(
+				dDataA, dDataB, pWeights, nTotalDataSize, vecPartials, norms);
 
-	} else {
+			if (norms.fHasNonPositiveA && (norms.dFirstNonPositiveA == 0.0)) {
+				_EXCEPTIONT("Zero minimum field value");
+			}
 
-		// Calculate differences
-		for (int i = 0; i < nTotalDataSize; i++) {
-			dNormL1 += dDataA[i] * dataUniqueJacobian[i];
-			dNormL2 += dDataA[i] * dDataA[i] * dataUniqueJacobian[i];
+			// Min / Max Norm
+			double dNormLmin;
+			double dNormLmax;
 
-			if (dDataA[i] > dNormLi) {
-				dNormLi = dDataA[i];
+			if (norms.dMaxB == norms.dMinB) {
+				dNormLmin = norms.dMinB - norms.dMinA;
+				dNormLmax = norms.dMaxA - norms.dMaxB;
+			} else {
+				dNormLmin = (norms.dMinB - norms.dMinA) / (norms.dMaxB - norms.dMinB);
+				dNormLmax = (norms.dMaxA - norms.dMaxB) / (norms.dMaxB - norms.dMinB);
 			}
 
-			dSumL1 += dDataB[i] * dataUniqueJacobian[i];
-			dSumL2 += dDataB[i] * dDataB[i] * dataUniqueJacobian[i];
-
-			if (dDataB[i] > dSumLi) {
-				dSumLi = dDataB[i];
+			const double dNormL1 = norms.dNormL1 / norms.dSumL1;
+			const double dNormL2 = sqrt(norms.dNormL2 / norms.dSumL2);
+			const double dNormLi = norms.dNormLi / norms.dSumLi;
+
+			// Announce results
+			AnnounceStartBlock("Results:");
+			Announce("L1:   %1.15e | %1.15e", dNormL1, norms.dSumL1);
+			Announce("L2:   %1.15e | %1.15e", dNormL2, norms.dSumL2);
+			Announce("Li:   %1.15e | %1.15e", dNormLi, norms.dSumLi);
+			Announce("Lmin: %1.15e | %1.5e %1.5e", dNormLmin, norms.dMinA, norms.dMinB);
+			Announce("Lmax: %1.15e | %1.5e %1.5e", dNormLmax, norms.dMaxA, norms.dMaxB);
+			AnnounceEndBlock(NULL);
+
+			AnnounceEndBlock(NULL);
+
+			// Print results to file
+			if (fpOutput != NULL) {
+				fprintf(fpOutput, "%1.15e %1.15e %1.15e %1.15e %1.15e\n",
+					dNormL1, dNormL2, dNormLi, dNormLmin, dNormLmax);
 			}
 		}
-
-		dNormL1 = dNormL1 / dSumL1;
-		dNormL2 = sqrt(dNormL2 / dSumL2);
-		dNormLi = dNormLi / dSumLi;
 	}
 
-	// Announce results
-	AnnounceStartBlock("Results:");
-	Announce("L1:   %1.15e | %1.15e", dNormL1, dSumL1);
-	Announce("L2:   %1.15e | %1.15e", dNormL2, dSumL2);
-	Announce("Li:   %1.15e | %1.15e", dNormLi, dSumLi);
-	Announce("Lmin: %1.15e | %1.5e %1.5e", dNormLmin, dMinA, dMinB);
-	Announce("Lmax: %1.15e | %1.5e %1.5e", dNormLmax, dMaxA, dMaxB);
-	AnnounceEndBlock(NULL);
-
-	// Print results to file
-	if (strOutputFile != "") {
-		FILE * fp = fopen(strOutputFile.c_str(), "a");
-		fprintf(fp, "%1.15e %1.15e %1.15e %1.15e %1.15e\n",
-			dNormL1, dNormL2, dNormLi, dNormLmin, dNormLmax);
-		fclose(fp);
+	if (fpOutput != NULL) {
+		fclose(fpOutput);
 	}
 
 	return (0);
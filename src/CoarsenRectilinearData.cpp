@@ -172,6 +172,7 @@ inline void FindReplace(
 	const int nX = data.GetRows();
 	const int nY = data.GetColumns();
 
+#pragma omp parallel for schedule(static)
 	for (int i = 0; i < nX; i++) {
 	for (int j = 0; j < nY; j++) {
 		if (data[i][j] == find) {
@@ -208,41 +209,47 @@ inline void ApplyMap(
 	const DataArray2D<T> & dataIn,
 	const ConservativeMap1D & mapX,
 	const ConservativeMap1D & mapY,
+	DataArray2D<double> & dataTemp,
 	DataArray2D<Tout> & dataOut
 ) {
 	const int nX = dataIn.GetRows();
-	const int nY = dataIn.GetColumns();
 
 	const int nXout = dataOut.GetRows();
 	const int nYout = dataOut.GetColumns();
 
-	for (int i = 0; i < nXout; i++) {
-	for (int j = 0; j < nYout; j++) {
+	if ((dataTemp.GetRows() != nX) || (dataTemp.GetColumns() != nYout)) {
+		_EXCEPTIONT("Work array has incorrect dimensions");
+	}
 
-		double dOut = 0.0;
+	// The map is separable, so it is applied as a pass in Y over each
+	// input row followed by a pass in X over the partially remapped rows
+#pragma omp parallel for schedule(static)
+	for (int ii = 0; ii < nX; ii++) {
+		const T * pIn = dataIn[ii];
+		double * pTemp = dataTemp[ii];
 
-		for (int ix = 0; ix < mapX[i].size(); ix++) {
-		for (int iy = 0; iy < mapY[j].size(); iy++) {
+		for (int j = 0; j < nYout; j++) {
+			double dOut = 0.0;
+			for (int iy = 0; iy < mapY[j].size(); iy++) {
+				dOut += mapY[j][iy].second
+					* static_cast<double>(pIn[mapY[j][iy].first]);
+			}
+			pTemp[j] = dOut;
+		}
+	}
 
-			const int ii = mapX[i][ix].first;
-			const int jj = mapY[j][iy].first;
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < nXout; i++) {
+		Tout * pOut = dataOut[i];
 
-			const double dCoeffX = mapX[i][ix].second;
-			const double dCoeffY = mapY[j][iy].second;
-/*
-			if (ii >= dataIn.GetRows()) {
-				_EXCEPTION();
-			}
-			if (jj >= dataIn.GetColumns()) {
-				_EXCEPTION();
+		for (int j = 0; j < nYout; j++) {
+			double dOut = 0.0;
+			for (int ix = 0; ix < mapX[i].size(); ix++) {
+				dOut += mapX[i][ix].second
+					* dataTemp[mapX[i][ix].first][j];
 			}
-*/
-			dOut += dCoeffX * dCoeffY * static_cast<double>(dataIn[ii][jj]);
+			pOut[j] = static_cast<Tout>(dOut);
 		}
-		}
-
-		dataOut[i][j] = static_cast<Tout>(dOut);
-	}
 	}
 }
 
@@ -679,6 +686,9 @@ try {
 		dDoubleDataOut.Allocate(nXout, nYout);
 	}
 
+	// Input data remapped in Y only
+	DataArray2D<double> dDataTemp(nX, nYout);
+
 	NcType vartype = varData->type();
 	if (fOutputDouble) {
 		vartype = ncDouble;
@@ -741,7 +751,7 @@ try {
 				FindReplace<short>(dShortData, sFindShort, sReplaceShort);
 			} else if (varData->type() == ncInt) {
 				FindReplace<int>(dIntData, iFindInt, iReplaceInt);
-			} else if (varData->type() == ncShort) {
+			} else if (varData->type() == ncFloat) {
 				FindReplace<float>(dFloatData, dFindFloat, dReplaceFloat);
 			} else if (varData->type() == ncDouble) {
 				FindReplace<double>(dDoubleData, dFindDouble, dReplaceDouble);
@@ -771,34 +781,34 @@ try {
 
 			if (varData->type() == ncByte) {
 				if (fOutputDouble) {
-					ApplyMap<char,double>(dByteData, matX1D, matY1D, dDoubleDataOut);
+					ApplyMap<char,double>(dByteData, matX1D, matY1D, dDataTemp, dDoubleDataOut);
 				} else {
-					ApplyMap<char>(dByteData, matX1D, matY1D, dByteDataOut);
+					ApplyMap<char>(dByteData, matX1D, matY1D, dDataTemp, dByteDataOut);
 				}
 
 			} else if (varData->type() == ncShort) {
 				if (fOutputDouble) {
-					ApplyMap<short,double>(dShortData, matX1D, matY1D, dDoubleDataOut);
+					ApplyMap<short,double>(dShortData, matX1D, matY1D, dDataTemp, dDoubleDataOut);
 				} else {
-					ApplyMap<short>(dShortData, matX1D, matY1D, dShortDataOut);
+					ApplyMap<short>(dShortData, matX1D, matY1D, dDataTemp, dShortDataOut);
 				}
 
 			} else if (varData->type() == ncInt) {
 				if (fOutputDouble) {
-					ApplyMap<int,double>(dIntData, matX1D, matY1D, dDoubleDataOut);
+					ApplyMap<int,double>(dIntData, matX1D, matY1D, dDataTemp, dDoubleDataOut);
 				} else {
-					ApplyMap<int>(dIntData, matX1D, matY1D, dIntDataOut);
+					ApplyMap<int>(dIntData, matX1D, matY1D, dDataTemp, dIntDataOut);
 				}
 
-			} else if (varData->type() == ncShort) {
+			} else if (varData->type() == ncFloat) {
 				if (fOutputDouble) {
-					ApplyMap<float,double>(dFloatData, matX1D, matY1D, dDoubleDataOut);
+					ApplyMap<float,double>(dFloatData, matX1D, matY1D, dDataTemp, dDoubleDataOut);
 				} else {
-					ApplyMap<float>(dFloatData, matX1D, matY1D, dFloatDataOut);
+					ApplyMap<float>(dFloatData, matX1D, matY1D, dDataTemp, dFloatDataOut);
 				}
 
 			} else if (varData->type() == ncDouble) {
-				ApplyMap<double>(dDoubleData, matX1D, matY1D, dDoubleDataOut);
+				ApplyMap<double>(dDoubleData, matX1D, matY1D, dDataTemp, dDoubleDataOut);
 			}
 
 			if (fValidate) {
@@ -19,6 +19,7 @@
 
 #include "Announce.h"
 #include "Exception.h"
+#include "PerformanceOptions.h"
 
 #include <vector>
 #include <string>
@@ -26,6 +27,10 @@
 #include <cstring>
 #include <fstream>
 
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 
 ///	<summary>
@@ -466,11 +471,72 @@ void _ParseCommandLine(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		Set the number of OpenMP threads used by all parallel regions of
+///		the library, as given by the --threads parameter which is accepted
+///		by every tool.  A count of zero keeps the OpenMP default, such as
+///		that set with OMP_NUM_THREADS.  Nested regions are not given threads
+///		of their own unless a region requests them, so work started from
+///		within a parallel region does not oversubscribe the processors.
+///	</summary>
+inline void SetCommandLineThreads(
+	int nThreads
+) {
+	if (nThreads < 0) {
+		_EXCEPTIONT("--threads must be nonnegative");
+	}
+#if defined(_OPENMP)
+	if (nThreads > 0) {
+		omp_set_num_threads(nThreads);
+	}
+	omp_set_max_active_levels(1);
+#else
+	if (nThreads > 1) {
+		Announce("WARNING: Built without OpenMP; --threads ignored");
+	}
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Apply the performance parameters accepted by every tool:  the
+///		memory limit for map weights and the I/O buffer size (both in MB),
+///		and the file to which the timer summary is written.
+///	</summary>
+inline void SetCommandLinePerformanceOptions(
+	int nMemoryLimitMB,
+	int nIOBufferMB,
+	const std::string & strProfileFile
+) {
+	if (nMemoryLimitMB < 0) {
+		_EXCEPTIONT("--mem_limit must be nonnegative");
+	}
+	if (nIOBufferMB < 0) {
+		_EXCEPTIONT("--io_buffer_mb must be nonnegative");
+	}
+
+	PerformanceOptions & opts = GetPerformanceOptions();
+	opts.sMemoryLimitBytes = static_cast<size_t>(nMemoryLimitMB) << 20;
+	opts.sIOBufferBytes = static_cast<size_t>(nIOBufferMB) << 20;
+	opts.strProfileFile = strProfileFile;
+
+	if (strProfileFile != "") {
+		AnnounceEnableTimers(strProfileFile.c_str());
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 ///	<summary>
 ///		Begin the definition of command line parameters.
 ///	</summary>
 #define BeginCommandLine() \
 	{ bool _errorCommandLine = false; \
+	  int _nCommandLineThreads = 0; \
+	  int _nCommandLineMemoryLimitMB = 0; \
+	  int _nCommandLineIOBufferMB = 0; \
+	  std::string _strCommandLineProfileFile; \
 	  std::vector<CommandLineParameter*> _vecParameters;
 
 ///	<summary>
@@ -533,6 +599,21 @@ void _ParseCommandLine(
 ///		Begin the loop for command line parameters.
 ///	</summary>
 #define ParseCommandLine(argc, argv) \
+	_vecParameters.push_back( \
+		new CommandLineParameterInt( \
+			_nCommandLineThreads, "threads", 0, "(0 for OpenMP default)")); \
+	_vecParameters.push_back( \
+		new CommandLineParameterInt( \
+			_nCommandLineMemoryLimitMB, "mem_limit", 0, \
+			"(MB of map weights held before spilling to disk, 0 for none)")); \
+	_vecParameters.push_back( \
+		new CommandLineParameterInt( \
+			_nCommandLineIOBufferMB, "io_buffer_mb", 0, \
+			"(MB per buffer for chunked reads, 0 for default)")); \
+	_vecParameters.push_back( \
+		new CommandLineParameterString( \
+			_strCommandLineProfileFile, "profile_out", "", \
+			"(timer summary file, .json or .csv)")); \
 	_ParseCommandLine(argc, argv, _vecParameters, _errorCommandLine);
 /*
     for(int _command = 1; _command < argc; _command++) { \
@@ -595,6 +676,11 @@ void _ParseCommandLine(
 	PrintCommandLineUsage(argv); \
 	for (int _p = 0; _p < _vecParameters.size(); _p++) \
 		delete _vecParameters[_p]; \
+	SetCommandLineThreads(_nCommandLineThreads); \
+	SetCommandLinePerformanceOptions( \
+		_nCommandLineMemoryLimitMB, \
+		_nCommandLineIOBufferMB, \
+		_strCommandLineProfileFile); \
 	}
 
 ///////////////////////////////////////////////////////////////////////////////
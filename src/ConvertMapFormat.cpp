@@ -0,0 +1,132 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    ConvertMapFormat.cpp
+///	\author  Paul Ullrich
+///	\version October 14, 2026
+///
+///	<remarks>
+///		Copyright 2026 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "CommandLine.h"
+#include "Announce.h"
+#include "OfflineMap.h"
+#include "NetCDFUtilities.h"
+#include "STLStringHelper.h"
+
+#include "netcdfcpp.h"
+
+///////////////////////////////////////////////////////////////////////////////
+
+typedef std::map<std::string, std::string> AttributeMap;
+
+///////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv) {
+
+	NcError error(NcError::silent_nonfatal);
+
+try {
+	// Map file for input (SCRIP NetCDF or native binary)
+	std::string strInputMapFile;
+
+	// Map file for output
+	std::string strOutputMapFile;
+
+	// Output format
+	std::string strOutputFormat;
+
+	// Storage of the weights of binary output
+	std::string strOutputWeights;
+
+	// Deflate level and target chunk size of NetCDF-4 output
+	int iDeflateLevel;
+	int nChunkKB;
+
+	// Parse the command line
+	BeginCommandLine()
+		CommandLineString(strInputMapFile, "in", "");
+		CommandLineString(strOutputMapFile, "out", "");
+		CommandLineStringD(strOutputFormat, "out_format", "Binary", "[Binary|Classic|Offset64Bits|Netcdf4|Netcdf4Classic]");
+		CommandLineStringD(strOutputWeights, "out_weights", "double", "[double|single|q16]");
+		CommandLineIntD(iDeflateLevel, "out_deflate", 0, "(0-9)");
+		CommandLineInt(nChunkKB, "out_chunk_kb", 0);
+
+		ParseCommandLine(argc, argv);
+	EndCommandLine(argv)
+
+	AnnounceBanner();
+
+	// Check arguments
+	if (strInputMapFile == "") {
+		_EXCEPTIONT("Input map file (--in) must be specified");
+	}
+	if (strOutputMapFile == "") {
+		_EXCEPTIONT("Output map file (--out) must be specified");
+	}
+
+	STLStringHelper::ToLower(strOutputFormat);
+
+	NcFile::FileFormat eOutputFormat = NcFile::BadFormat;
+	if (strOutputFormat != "binary") {
+		eOutputFormat = GetNcFileFormatFromString(strOutputFormat);
+		if (eOutputFormat == NcFile::BadFormat) {
+			_EXCEPTION1("Invalid \"out_format\" value (%s), "
+				"expected [Binary|Classic|Offset64Bits|Netcdf4|Netcdf4Classic]",
+				strOutputFormat.c_str());
+		}
+	}
+
+	BinaryMapWeights eOutputWeights = ParseBinaryMapWeights(strOutputWeights);
+	if ((eOutputWeights != BinaryMapWeights_Double) &&
+	    (eOutputFormat != NcFile::BadFormat)
+	) {
+		_EXCEPTIONT("--out_weights requires --out_format Binary");
+	}
+
+	if (nChunkKB < 0) {
+		_EXCEPTIONT("--out_chunk_kb must be nonnegative");
+	}
+
+	NcCompressionOptions optsCompression;
+	optsCompression.iDeflateLevel = iDeflateLevel;
+	optsCompression.sChunkBytes = static_cast<size_t>(nChunkKB) * 1024;
+	SetNcCompressionOptions(optsCompression);
+
+	// Load map from file
+	AnnounceStartBlock("Loading input map");
+	AttributeMap mapAttributes;
+	OfflineMap mapRemap;
+	mapRemap.Read(strInputMapFile, &mapAttributes);
+	AnnounceEndBlock("Done");
+
+	// Write map to file
+	AnnounceStartBlock("Writing output map");
+	if (eOutputFormat == NcFile::BadFormat) {
+		mapRemap.WriteBinary(strOutputMapFile, mapAttributes, eOutputWeights);
+	} else {
+		mapRemap.Write(strOutputMapFile, mapAttributes, eOutputFormat);
+	}
+	AnnounceEndBlock("Done");
+
+	AnnounceBanner();
+
+	return (0);
+
+} catch(Exception & e) {
+	Announce(e.ToString().c_str());
+	return (-1);
+
+} catch(...) {
+	return (-2);
+}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,105 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///   \file    ConvertMeshToCache.cpp
+///   \author  Paul Ullrich
+///   \version October 14, 2026
+///
+///   <remarks>
+///      Copyright 2026 Paul Ullrich
+///
+///      This file is distributed as part of the Tempest source code package.
+///      Permission is granted to use, copy, modify and distribute this
+///      source code and its documentation under the terms of the GNU General
+///      Public License.  This software is provided "as is" without express
+///      or implied warranty.
+///   </remarks>
+
+#include "CommandLine.h"
+#include "GridElements.h"
+#include "Exception.h"
+#include "Announce.h"
+
+#include "netcdfcpp.h"
+
+///////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv) {
+
+	NcError error(NcError::silent_nonfatal);
+
+try {
+	// Input filename
+	std::string strInputFile;
+
+	// Output cache filename
+	std::string strOutputFile;
+
+	// Include Face areas
+	bool fAreas;
+
+	// Concave Faces in the input mesh (used for Face areas)
+	bool fConcave;
+
+	// Include the EdgeMap
+	bool fEdgeMap;
+
+	// Parse the command line
+	BeginCommandLine()
+		CommandLineString(strInputFile,  "in",  "");
+		CommandLineString(strOutputFile, "out", "");
+		CommandLineBool(fAreas, "areas");
+		CommandLineBool(fConcave, "concave");
+		CommandLineBool(fEdgeMap, "edgemap");
+
+		ParseCommandLine(argc, argv);
+	EndCommandLine(argv)
+
+	AnnounceBanner();
+
+	// Check file names
+	if (strInputFile  == "") {
+		_EXCEPTIONT("No input file specified");
+	}
+	if (strOutputFile == "") {
+		_EXCEPTIONT("No output file specified");
+	}
+
+	// Load input mesh
+	AnnounceStartBlock("Loading input mesh");
+	Mesh meshIn(strInputFile);
+	meshIn.RemoveZeroEdges();
+	AnnounceEndBlock(NULL);
+
+	// Derived sections
+	if (fAreas) {
+		AnnounceStartBlock("Calculating Face areas");
+		meshIn.CalculateFaceAreas(fConcave);
+		AnnounceEndBlock(NULL);
+	}
+
+	if (fEdgeMap) {
+		AnnounceStartBlock("Constructing edge map");
+		meshIn.ConstructEdgeMap(false);
+		AnnounceEndBlock(NULL);
+	}
+
+	// Write the cache
+	AnnounceStartBlock("Writing mesh cache");
+	meshIn.WriteCache(strOutputFile);
+	AnnounceEndBlock(NULL);
+
+	AnnounceBanner();
+
+	return (0);
+
+} catch(Exception & e) {
+	Announce(e.ToString().c_str());
+	return (-1);
+
+} catch(...) {
+	return (-2);
+}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
@@ -43,11 +43,17 @@ try {
 	// Output format
 	std::string strOutputFormat;
 
+	// Deflate level and target chunk size of NetCDF-4 output
+	int iDeflateLevel;
+	int nChunkKB;
+
 	// Parse the command line
 	BeginCommandLine()
 		CommandLineString(strInputFile,  "in",  "");
 		CommandLineString(strOutputFile, "out", "");
 		CommandLineString(strOutputFormat, "out_format", "netcdf4");
+		CommandLineIntD(iDeflateLevel, "out_deflate", 0, "(0-9)");
+		CommandLineInt(nChunkKB, "out_chunk_kb", 0);
 		
 		ParseCommandLine(argc, argv);
 	EndCommandLine(argv)
@@ -90,6 +96,15 @@ try {
 			strOutputFormat.c_str());
 	}
 
+	if (nChunkKB < 0) {
+		_EXCEPTIONT("--out_chunk_kb must be nonnegative");
+	}
+
+	NcCompressionOptions optsCompression;
+	optsCompression.iDeflateLevel = iDeflateLevel;
+	optsCompression.sChunkBytes = static_cast<size_t>(nChunkKB) * 1024;
+	SetNcCompressionOptions(optsCompression);
+
 	meshIn.WriteScrip(strOutputFile, eOutputFormat);
 
 	std::cout << "..Done writing" << std::endl;
@@ -20,9 +20,11 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "Exception.h"
+#include "DataArrayAllocator.h"
 
 #include <cstdlib>
 #include <cstring>
+#include <memory>
 
 template <typename T>
 class DataArray1D {
@@ -66,6 +68,22 @@ public:
 		Assign(da);
 	}
 
+	///	<summary>
+	///		Move constructor.  Owned data and data attached with an owner
+	///		are transferred without a copy; other attached arrays are copied.
+	///	</summary>
+	DataArray1D(DataArray1D<T> && da) noexcept :
+		m_fOwnsData(true),
+		m_sSize(0),
+		m_data(NULL)
+	{
+		if ((!da.m_fOwnsData) && (!da.m_pDataOwner)) {
+			Assign(da);
+			return;
+		}
+		Take(da);
+	}
+
 	///	<summary>
 	///		Destructor.
 	///	</summary>
@@ -93,7 +111,7 @@ public:
 	void Allocate(
 		size_t sSize
 	) {
-		if (!m_fOwnsData) {
+		if ((!m_fOwnsData) && (!m_pDataOwner)) {
 			_EXCEPTIONT("Attempting to Allocate() on attached DataArray1D");
 		}
 
@@ -107,7 +125,7 @@ public:
 		if ((m_data == NULL) || (m_sSize != sSize)) {
 			m_sSize = sSize;
 
-			m_data = reinterpret_cast<T *>(malloc(GetByteSize()));
+			m_data = reinterpret_cast<T *>(DataArrayAllocate(GetByteSize()));
 
 			if (m_data == NULL) {
 				_EXCEPTION1("Failed malloc call (%lu bytes)", GetByteSize());
@@ -150,14 +168,30 @@ public:
 		m_fOwnsData = false;
 	}
 
+	///	<summary>
+	///		Attach this DataChunk to externally owned data, such as a region
+	///		of a memory mapped file or a buffer of the NetCDF layer, without
+	///		a copy.  The owner is retained until the data is detached, so the
+	///		array may outlive the object that attached it, and unlike a plain
+	///		attachment the array may be reallocated or moved.
+	///	</summary>
+	void AttachToData(
+		void * ptr,
+		const std::shared_ptr<const void> & pOwner
+	) {
+		AttachToData(ptr);
+		m_pDataOwner = pOwner;
+	}
+
 	///	<summary>
 	///		Detach data from this DataChunk.
 	///	</summary>
 	virtual void Detach() {
 		if ((m_fOwnsData) && (m_data != NULL)) {
-		        free(m_data);
+			DataArrayFree(m_data, GetByteSize());
 		}
 		m_fOwnsData = true;
+		m_pDataOwner.reset();
 		m_data = NULL;
 	}
 
@@ -165,7 +199,7 @@ public:
 	///		Deallocate data from this DataChunk.
 	///	</summary>
 	void Deallocate() {
-		if (!m_fOwnsData) {
+		if ((!m_fOwnsData) && (!m_pDataOwner)) {
 			_EXCEPTIONT("Attempting to Deallocate an attached DataArray1D");
 		}
 
@@ -208,7 +242,7 @@ public:
 		if (!IsAttached()) {
 			Allocate(da.m_sSize);
 		}
-		if (IsAttached() && m_fOwnsData) {
+		if (IsAttached() && (m_fOwnsData || m_pDataOwner)) {
 			if (m_sSize != da.m_sSize) {
 				Deallocate();
 				Allocate(da.m_sSize);
@@ -232,6 +266,42 @@ public:
 		return (*this);
 	}
 
+	///	<summary>
+	///		Move assignment operator.  Owned data and data attached with an
+	///		owner are transferred without a copy, unless this array is
+	///		attached to external data without an owner.
+	///	</summary>
+	DataArray1D<T> & operator= (DataArray1D<T> && da) {
+		if (this == &da) {
+			return (*this);
+		}
+		if (((!m_fOwnsData) && (!m_pDataOwner)) ||
+		    ((!da.m_fOwnsData) && (!da.m_pDataOwner))
+		) {
+			Assign(da);
+			return (*this);
+		}
+		Detach();
+		Take(da);
+		return (*this);
+	}
+
+private:
+	///	<summary>
+	///		Take the data of another array, leaving it empty.  This array
+	///		must be detached and the other array must own its data or have
+	///		been attached with an owner.
+	///	</summary>
+	void Take(DataArray1D<T> & da) noexcept {
+		m_sSize = da.m_sSize;
+		m_data = da.m_data;
+		da.m_sSize = 0;
+		da.m_data = NULL;
+		m_fOwnsData = da.m_fOwnsData;
+		m_pDataOwner.swap(da.m_pDataOwner);
+		da.m_fOwnsData = true;
+	}
+
 public:
 	///	<summary>
 	///		Zero the data content of this object.
@@ -244,7 +314,7 @@ public:
 		}
 
 		// Set content to zero
-		memset(m_data, 0, m_sSize * sizeof(T));
+		DataArrayZero(m_data, m_sSize * sizeof(T));
 	}
 
 	///	<summary>
@@ -331,6 +401,11 @@ private:
 	///	</summary>
 	bool m_fOwnsData;
 
+	///	<summary>
+	///		Owner of external data attached to this array, if any.
+	///	</summary>
+	std::shared_ptr<const void> m_pDataOwner;
+
 	///	<summary>
 	///		The number of rows in this DataArray1D.
 	///	</summary>
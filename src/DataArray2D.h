@@ -20,10 +20,12 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "Exception.h"
+#include "DataArrayAllocator.h"
 #include "Subscript.h"
 
 #include <cstdlib>
 #include <cstring>
+#include <memory>
 
 template <typename T>
 class DataArray2D {
@@ -84,6 +86,23 @@ public:
 		}
 	}
 
+	///	<summary>
+	///		Move constructor.  Owned data and data attached with an owner
+	///		are transferred without a copy; other attached arrays are copied.
+	///	</summary>
+	DataArray2D(DataArray2D<T> && da) noexcept :
+		m_fOwnsData(true),
+		m_data1D(NULL)
+	{
+		if ((!da.m_fOwnsData) && (!da.m_pDataOwner)) {
+			m_sSize[0] = 0;
+			m_sSize[1] = 0;
+			Assign(da);
+			return;
+		}
+		Take(da);
+	}
+
 	///	<summary>
 	///		Destructor.
 	///	</summary>
@@ -111,7 +130,7 @@ public:
 		size_t sSize0,
 		size_t sSize1
 	) {
-		if (!m_fOwnsData) {
+		if ((!m_fOwnsData) && (!m_pDataOwner)) {
 			_EXCEPTIONT("Attempting to Allocate() on attached DataArray2D");
 		}
 
@@ -130,7 +149,7 @@ public:
 			m_sSize[0] = sSize0;
 			m_sSize[1] = sSize1;
 
-			m_data1D = reinterpret_cast<T *>(malloc(GetByteSize()));
+			m_data1D = reinterpret_cast<T *>(DataArrayAllocate(GetByteSize()));
 
 			if (m_data1D == NULL) {
 				_EXCEPTION1("Failed malloc call (%lu bytes)", GetByteSize());
@@ -175,14 +194,30 @@ public:
 		m_fOwnsData = false;
 	}
 
+	///	<summary>
+	///		Attach this DataChunk to externally owned data, such as a region
+	///		of a memory mapped file or a buffer of the NetCDF layer, without
+	///		a copy.  The owner is retained until the data is detached, so the
+	///		array may outlive the object that attached it, and unlike a plain
+	///		attachment the array may be reallocated or moved.
+	///	</summary>
+	void AttachToData(
+		void * ptr,
+		const std::shared_ptr<const void> & pOwner
+	) {
+		AttachToData(ptr);
+		m_pDataOwner = pOwner;
+	}
+
 	///	<summary>
 	///		Detach data from this DataChunk.
 	///	</summary>
 	virtual void Detach() {
 		if ((m_fOwnsData) && (m_data1D != NULL)) {
-		        free(m_data1D);
+			DataArrayFree(m_data1D, GetByteSize());
 		}
 		m_fOwnsData = true;
+		m_pDataOwner.reset();
 		m_data1D = NULL;
 	}
 
@@ -190,7 +225,7 @@ public:
 	///		Deallocate data from this DataChunk.
 	///	</summary>
 	void Deallocate() {
-		if (!m_fOwnsData) {
+		if ((!m_fOwnsData) && (!m_pDataOwner)) {
 			_EXCEPTIONT("Attempting Deallocate() on attached DataArray2D");
 		}
 
@@ -241,7 +276,7 @@ public:
 		if (!IsAttached()) {
 			Allocate(da.m_sSize[0], da.m_sSize[1]);
 		}
-		if (IsAttached() && m_fOwnsData) {
+		if (IsAttached() && (m_fOwnsData || m_pDataOwner)) {
 			if ((m_sSize[0] != da.m_sSize[0]) ||
 			    (m_sSize[1] != da.m_sSize[1])
 			) {
@@ -273,6 +308,44 @@ public:
 		return (*this);
 	}
 
+	///	<summary>
+	///		Move assignment operator.  Owned data and data attached with an
+	///		owner are transferred without a copy, unless this array is
+	///		attached to external data without an owner.
+	///	</summary>
+	DataArray2D<T> & operator= (DataArray2D<T> && da) {
+		if (this == &da) {
+			return (*this);
+		}
+		if (((!m_fOwnsData) && (!m_pDataOwner)) ||
+		    ((!da.m_fOwnsData) && (!da.m_pDataOwner))
+		) {
+			Assign(da);
+			return (*this);
+		}
+		Detach();
+		Take(da);
+		return (*this);
+	}
+
+private:
+	///	<summary>
+	///		Take the data of another array, leaving it empty.  This array
+	///		must be detached and the other array must own its data or have
+	///		been attached with an owner.
+	///	</summary>
+	void Take(DataArray2D<T> & da) noexcept {
+		m_sSize[0] = da.m_sSize[0];
+		m_sSize[1] = da.m_sSize[1];
+		m_data1D = da.m_data1D;
+		da.m_sSize[0] = 0;
+		da.m_sSize[1] = 0;
+		da.m_data1D = NULL;
+		m_fOwnsData = da.m_fOwnsData;
+		m_pDataOwner.swap(da.m_pDataOwner);
+		da.m_fOwnsData = true;
+	}
+
 public:
 	///	<summary>
 	///		Zero the data content of this object.
@@ -285,7 +358,7 @@ public:
 		}
 
 		// Set content to zero
-		memset(m_data1D, 0, GetByteSize());
+		DataArrayZero(m_data1D, GetByteSize());
 	}
 
 	///	<summary>
@@ -490,6 +563,11 @@ private:
 	///	</summary>
 	bool m_fOwnsData;
 
+	///	<summary>
+	///		Owner of external data attached to this array, if any.
+	///	</summary>
+	std::shared_ptr<const void> m_pDataOwner;
+
 	///	<summary>
 	///		The size of each dimension of this DataArray3D.
 	///	</summary>
@@ -0,0 +1,284 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    DataArrayAllocator.h
+///	\author  Paul Ullrich
+///	\version October 14, 2026
+///
+///	<remarks>
+///		Copyright 2026 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#ifndef _DATAARRAYALLOCATOR_H_
+#define _DATAARRAYALLOCATOR_H_
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Defines.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Alignment of the data of DataArray1D, DataArray2D and DataArray3D,
+///		in bytes.  This corresponds to a cache line and to the widest vector
+///		registers.
+///	</summary>
+#define DATAARRAY_ALIGNMENT 64
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Allocate an aligned block of memory directly from the system.
+///	</summary>
+inline void * DataArrayAlignedMalloc(
+	size_t sBytes
+) {
+#if defined(_WIN32)
+	return _aligned_malloc(sBytes, DATAARRAY_ALIGNMENT);
+#else
+	void * ptr = NULL;
+	if (posix_memalign(&ptr, DATAARRAY_ALIGNMENT, sBytes) != 0) {
+		return NULL;
+	}
+	return ptr;
+#endif
+}
+
+///	<summary>
+///		Free a block allocated with DataArrayAlignedMalloc.
+///	</summary>
+inline void DataArrayAlignedFree(
+	void * ptr
+) {
+#if defined(_WIN32)
+	_aligned_free(ptr);
+#else
+	free(ptr);
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+#if defined(DATAARRAY_USE_POOL)
+
+///	<summary>
+///		A cache of freed blocks for one thread, sorted into power-of-two
+///		size classes from DATAARRAY_ALIGNMENT bytes up to PoolMaxBytes.
+///		Larger blocks bypass the pool.  Blocks come from
+///		DataArrayAlignedMalloc so a block freed by one thread may be
+///		reused by another.
+///	</summary>
+class DataArrayPool {
+
+public:
+	///	<summary>
+	///		Number of size classes.
+	///	</summary>
+	static const int PoolClasses = 11;
+
+	///	<summary>
+	///		Largest block size managed by the pool, in bytes.
+	///	</summary>
+	static const size_t PoolMaxBytes =
+		static_cast<size_t>(DATAARRAY_ALIGNMENT) << (PoolClasses - 1);
+
+	///	<summary>
+	///		Maximum number of cached blocks in each size class.
+	///	</summary>
+	static const int PoolMaxBlocks = 64;
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	DataArrayPool() {
+		for (int c = 0; c < PoolClasses; c++) {
+			m_nBlocks[c] = 0;
+		}
+	}
+
+	///	<summary>
+	///		Destructor, returning all cached blocks to the system.
+	///	</summary>
+	~DataArrayPool() {
+		IsDestroyed() = true;
+		for (int c = 0; c < PoolClasses; c++) {
+			for (int i = 0; i < m_nBlocks[c]; i++) {
+				DataArrayAlignedFree(m_pBlocks[c][i]);
+			}
+		}
+	}
+
+	///	<summary>
+	///		Flag indicating the pool of the calling thread has been destroyed,
+	///		so that arrays outliving it (such as static arrays) are returned
+	///		directly to the system.
+	///	</summary>
+	static bool & IsDestroyed() {
+		static thread_local bool s_fDestroyed = false;
+		return s_fDestroyed;
+	}
+
+	///	<summary>
+	///		Get the pool of the calling thread, or NULL if it has been
+	///		destroyed.
+	///	</summary>
+	static DataArrayPool * Local() {
+		if (IsDestroyed()) {
+			return NULL;
+		}
+		static thread_local DataArrayPool s_pool;
+		return (&s_pool);
+	}
+
+	///	<summary>
+	///		Get the size class of a block, or -1 if it bypasses the pool.
+	///	</summary>
+	static inline int GetSizeClass(size_t sBytes) {
+		if (sBytes > PoolMaxBytes) {
+			return (-1);
+		}
+		int iClass = 0;
+		size_t sClassBytes = DATAARRAY_ALIGNMENT;
+		while (sClassBytes < sBytes) {
+			sClassBytes <<= 1;
+			iClass++;
+		}
+		return iClass;
+	}
+
+	///	<summary>
+	///		Allocate a block of the given size.
+	///	</summary>
+	void * Allocate(size_t sBytes) {
+		int iClass = GetSizeClass(sBytes);
+		if (iClass < 0) {
+			return DataArrayAlignedMalloc(sBytes);
+		}
+		if (m_nBlocks[iClass] > 0) {
+			m_nBlocks[iClass]--;
+			return m_pBlocks[iClass][m_nBlocks[iClass]];
+		}
+		return DataArrayAlignedMalloc(
+			static_cast<size_t>(DATAARRAY_ALIGNMENT) << iClass);
+	}
+
+	///	<summary>
+	///		Free a block of the given size.
+	///	</summary>
+	void Free(void * ptr, size_t sBytes) {
+		int iClass = GetSizeClass(sBytes);
+		if ((iClass < 0) || (m_nBlocks[iClass] == PoolMaxBlocks)) {
+			DataArrayAlignedFree(ptr);
+			return;
+		}
+		m_pBlocks[iClass][m_nBlocks[iClass]] = ptr;
+		m_nBlocks[iClass]++;
+	}
+
+private:
+	///	<summary>
+	///		Number of cached blocks in each size class.
+	///	</summary>
+	int m_nBlocks[PoolClasses];
+
+	///	<summary>
+	///		Cached blocks in each size class.
+	///	</summary>
+	void * m_pBlocks[PoolClasses][PoolMaxBlocks];
+};
+
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Allocate memory for a DataArray, aligned to DATAARRAY_ALIGNMENT.
+///		Returns NULL on failure.
+///	</summary>
+inline void * DataArrayAllocate(
+	size_t sBytes
+) {
+#if defined(DATAARRAY_USE_POOL)
+	DataArrayPool * pPool = DataArrayPool::Local();
+	if (pPool != NULL) {
+		return pPool->Allocate(sBytes);
+	}
+
+	// Round up to the size class, since the block may be freed into
+	// the pool of another thread
+	int iClass = DataArrayPool::GetSizeClass(sBytes);
+	if (iClass >= 0) {
+		sBytes = static_cast<size_t>(DATAARRAY_ALIGNMENT) << iClass;
+	}
+#endif
+	return DataArrayAlignedMalloc(sBytes);
+}
+
+///	<summary>
+///		Free memory allocated with DataArrayAllocate.  The size must match
+///		the size passed to DataArrayAllocate.
+///	</summary>
+inline void DataArrayFree(
+	void * ptr,
+	size_t sBytes
+) {
+#if defined(DATAARRAY_USE_POOL)
+	DataArrayPool * pPool = DataArrayPool::Local();
+	if (pPool != NULL) {
+		pPool->Free(ptr, sBytes);
+		return;
+	}
+#endif
+	(void)sBytes;
+	DataArrayAlignedFree(ptr);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Zero memory for a DataArray.  Blocks of at least
+///		DataArrayParallelZeroBytes are zeroed by OpenMP threads in
+///		contiguous static ranges, so that each page is first touched by the
+///		thread that processes it in statically scheduled loops.
+///	</summary>
+inline void DataArrayZero(
+	void * ptr,
+	size_t sBytes
+) {
+	if (sBytes < DataArrayParallelZeroBytes) {
+		memset(ptr, 0, sBytes);
+		return;
+	}
+
+	const size_t sChunkBytes = 65536;
+	const long lChunks =
+		static_cast<long>((sBytes + sChunkBytes - 1) / sChunkBytes);
+
+	char * pData = static_cast<char *>(ptr);
+
+#pragma omp parallel for schedule(static)
+	for (long c = 0; c < lChunks; c++) {
+		const size_t sBegin = static_cast<size_t>(c) * sChunkBytes;
+		const size_t sEnd = std::min(sBegin + sChunkBytes, sBytes);
+		memset(pData + sBegin, 0, sEnd - sBegin);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif
+
@@ -17,6 +17,8 @@
 #ifndef _DEFINES_H_
 #define _DEFINES_H_
 
+#include <cstddef>
+
 ///////////////////////////////////////////////////////////////////////////////
 
 typedef double Real;
@@ -67,9 +69,15 @@ static const Real ReferenceTolerance = 1.0e-12;
 // node_multimap_3d which is guaranteed to produce no coincident nodes (but
 // is the slowest).
 //
+// If OVERLAPMESH_USE_NODE_HASHMAP is specified node removal will use the
+// node_hashmap_3d which is guaranteed to produce no coincident nodes and
+// is the fastest.  The parallel overlap mesh generator then also merges
+// nodes concurrently using node_hashmap_3d_concurrent.
+//
 //#define OVERLAPMESH_RETAIN_REPEATED_NODES
-#define OVERLAPMESH_USE_UNSORTED_MAP
+//#define OVERLAPMESH_USE_UNSORTED_MAP
 //#define OVERLAPMESH_USE_NODE_MULTIMAP
+#define OVERLAPMESH_USE_NODE_HASHMAP
 
 ///////////////////////////////////////////////////////////////////////////////
 //
@@ -78,6 +86,32 @@ static const Real ReferenceTolerance = 1.0e-12;
 //
 #define OVERLAPMESH_BIN_WIDTH 1.0e-1
 
+///////////////////////////////////////////////////////////////////////////////
+//
+// This define specifies the cell width for the node_hashmap_3d.  Lookups
+// only probe neighboring cells within tolerance of the boundary, so narrow
+// cells are inexpensive.
+//
+#define OVERLAPMESH_HASHMAP_CELL_WIDTH 1.0e-3
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// If OVERLAPMESH_STATISTICS is specified overlap mesh generation records
+// phase timings, counts of edge intersection tests and histograms of
+// overlap faces per source face and of search walk lengths, which are
+// reported at the end of GenerateOverlapMesh (see OverlapMeshStatistics.h).
+//
+//#define OVERLAPMESH_STATISTICS
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// If DATAARRAY_USE_POOL is specified the data of DataArray1D, DataArray2D
+// and DataArray3D is drawn from a thread-local pool of freed blocks in
+// power-of-two size classes, which avoids repeated calls to malloc and free
+// for arrays constructed inside loops (see DataArrayAllocator.h).
+//
+//#define DATAARRAY_USE_POOL
+
 ///////////////////////////////////////////////////////////////////////////////
 //
 // This define specifies that exact arithmetic should be used in the overlap
@@ -112,6 +146,167 @@ static const Real ReferenceTolerance = 1.0e-12;
 //
 static const int OverlapFaceSearchMaximumFaces = (-1);
 
+///////////////////////////////////////////////////////////////////////////////
+//
+// Minimum number of nonzeros in a finalized SparseMatrix before Apply() is
+// distributed over OpenMP threads.
+//
+static const size_t SparseMatrixParallelApplyThreshold = 16384;
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Minimum size in bytes of a DataArray before it is zeroed by OpenMP threads
+// in contiguous static blocks.  Since pages are placed on the memory of the
+// socket that first touches them, this spreads large arrays over sockets in
+// the same way as the statically scheduled loops that use them.
+//
+static const size_t DataArrayParallelZeroBytes = 8388608;
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Minimum number of points in a batch coordinate transform (see
+// CoordTransforms.h) before it is distributed over OpenMP threads.
+//
+static const int CoordTransformParallelThreshold = 4096;
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Number of slices (levels, times, etc.) of a variable that are remapped
+// together by OfflineMap::Apply().  Each block touches each map entry once,
+// so this should be small enough that the block row associated with a
+// single source column (nBlockSize doubles) stays in cache.
+//
+static const int OfflineMapApplyBlockSize = 16;
+
+//
+// Maximum memory (in bytes) used by the source and target blocks in
+// OfflineMap::Apply().  The block size is reduced to meet this limit.
+//
+static const size_t OfflineMapApplyBlockMaximumBytes = 512 * 1024 * 1024;
+
+//
+// OfflineMap::Apply() only reads the part of each source slice referenced
+// by the map if it is at most this fraction of the slice.  Unstructured
+// source columns are read in contiguous runs, and runs separated by no more
+// than OfflineMapApplyPartialReadGap unused columns are read together.
+//
+static const double OfflineMapApplyPartialReadMaximumFraction = 0.5;
+
+static const int OfflineMapApplyPartialReadGap = 1024;
+
+//
+// Number of map entries read at a time by OfflineMap::Read() when only a
+// subset of the rows of the map are kept.
+//
+static const long OfflineMapReadChunkEntries = 1048576;
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Number of source faces grouped into each unit of work when the overlap
+// mesh is generated with OpenMP threads.  Each block is built into its own
+// mesh and node map and then merged in order, so results do not depend on
+// the number of threads.
+//
+static const int OverlapMeshParallelBlockSize = 1024;
+
+//
+// Minimum time in seconds between checkpoints of a partially generated
+// overlap mesh.  Checkpoints are written at block boundaries, and also when
+// generation fails.
+//
+static const double OverlapMeshCheckpointInterval = 300.0;
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Number of faces grouped into each unit of work when face areas are
+// calculated with OpenMP threads.
+//
+static const int FaceAreaParallelBlockSize = 256;
+
+//
+// Number of spherical triangles whose quadrature Jacobians are evaluated
+// together when calculating face areas.
+//
+static const int FaceAreaTriangleBatchSize = 16;
+
+//
+// Number of spherical triangles whose spherical excess is evaluated
+// together when calculating face areas.
+//
+static const int FaceAreaExcessBatchSize = 64;
+
+//
+// Face areas are calculated from the spherical excess of their
+// sub-triangles when the estimated rounding error in the excess is below
+// this tolerance relative to the area, and by quadrature otherwise.  The
+// error estimate is the triple product bound scaled by
+// FaceAreaExcessRoundingFactor times machine epsilon.
+//
+static const Real FaceAreaExcessTolerance = 1.0e-10;
+
+static const Real FaceAreaExcessRoundingFactor = 8.0 * 2.220446049250313e-16;
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Padding added to the radius of the bounding cap around each face in
+// FaceBVH, so that nodes within tolerance of a face boundary are still
+// returned as candidates.
+//
+static const Real FaceBVHCapTolerance = 1.0e-8;
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Number of source faces grouped into each unit of work when map weights
+// are computed with OpenMP threads.  Weights are added to the map in order
+// of the source faces, so results do not depend on the number of threads.
+//
+static const int LinearRemapParallelBlockSize = 256;
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Number of blocks of source faces whose weights are computed before they
+// are added to the map.  This bounds the memory held in per-block weight
+// buffers, and the size of each run when map weights are spilled to disk.
+//
+static const int LinearRemapAssemblyChunkBlocks = 64;
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Number of entries buffered from each run of spilled SparseMatrix entries
+// while the runs are merged.
+//
+static const size_t SparseMatrixSpillReadBufferSize = 16384;
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Highest finite volume reconstruction order with a specialized kernel
+// for building the integration and fit arrays.  Higher orders use the
+// general kernel.
+//
+static const int FiniteVolumeMaxSpecializedOrder = 4;
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Highest number of GLL nodes per element direction with a precomputed
+// table of nodes, weights and barycentric weights.  Higher orders compute
+// the GLL nodes on each call.
+//
+static const int GLLBasisTableMaxNp = 8;
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Number of elements grouped into each unit of work when GLL metadata is
+// computed with OpenMP threads.
+//
+static const int GLLMetaDataParallelBlockSize = 1024;
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Approximate number of faces generated and written together when a mesh
+// generator streams its output to file.
+//
+static const int MeshStreamChunkFaces = 1048576;
+
 ///////////////////////////////////////////////////////////////////////////////
 
 #endif
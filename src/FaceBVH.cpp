@@ -0,0 +1,349 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    FaceBVH.cpp
+///	\author  Paul Ullrich
+///	\version October 14, 2026
+///
+///	<remarks>
+///		Copyright 2026 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "FaceBVH.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Number of points sampled along each line of constant latitude when
+///		bounding a Face.
+///	</summary>
+static const int FaceBVHLatitudeSamples = 8;
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Chord distance between a Node and the center of a cap.
+///	</summary>
+static inline double ChordDistance(
+	const double dX[3],
+	const Node & node
+) {
+	const double dDx = node.x - dX[0];
+	const double dDy = node.y - dX[1];
+	const double dDz = node.z - dX[2];
+
+	return sqrt(dDx * dDx + dDy * dDy + dDz * dDz);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void FaceBVH::Build(
+	const Mesh & mesh
+) {
+	const int nFaces = mesh.faces.size();
+
+	m_vecCaps.resize(nFaces);
+	m_vecTreeNodes.clear();
+
+	if (nFaces == 0) {
+		return;
+	}
+
+	// Bound each Face by a cap around its normalized centroid.  A cap
+	// smaller than a hemisphere is convex, so if it contains all edges it
+	// also contains the Face.  Great circle arcs between two points in such
+	// a cap are contained in the cap; lines of constant latitude are
+	// sampled and the radius is padded by the arc length between samples.
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < nFaces; i++) {
+		const Face & face = mesh.faces[i];
+
+		FaceCap & cap = m_vecCaps[i];
+		cap.ixFace = i;
+
+		Node nodeCenter(0.0, 0.0, 0.0);
+		for (int j = 0; j < face.edges.size(); j++) {
+			nodeCenter = nodeCenter + mesh.nodes[face[j]];
+		}
+
+		const double dCenterMag = nodeCenter.Magnitude();
+
+		double dRadius = 0.0;
+
+		if (dCenterMag > HighTolerance) {
+			cap.dX[0] = nodeCenter.x / dCenterMag;
+			cap.dX[1] = nodeCenter.y / dCenterMag;
+			cap.dX[2] = nodeCenter.z / dCenterMag;
+
+			for (int j = 0; j < face.edges.size(); j++) {
+				const Edge & edge = face.edges[j];
+
+				const Node & node0 = mesh.nodes[edge[0]];
+				const Node & node1 = mesh.nodes[edge[1]];
+
+				dRadius = std::max(dRadius, ChordDistance(cap.dX, node0));
+
+				if (edge.type != Edge::Type_ConstantLatitude) {
+					continue;
+				}
+
+				const double dLatRadius =
+					sqrt(node0.x * node0.x + node0.y * node0.y);
+
+				const double dLon0 = atan2(node0.y, node0.x);
+
+				double dDeltaLon = atan2(node1.y, node1.x) - dLon0;
+				if (dDeltaLon > M_PI) {
+					dDeltaLon -= 2.0 * M_PI;
+				}
+				if (dDeltaLon < -M_PI) {
+					dDeltaLon += 2.0 * M_PI;
+				}
+
+				double dSampleRadius = 0.0;
+				for (int k = 1; k < FaceBVHLatitudeSamples; k++) {
+					const double dLon =
+						dLon0 + dDeltaLon * static_cast<double>(k)
+							/ static_cast<double>(FaceBVHLatitudeSamples);
+
+					Node nodeSample(
+						dLatRadius * cos(dLon),
+						dLatRadius * sin(dLon),
+						node0.z);
+
+					dSampleRadius =
+						std::max(dSampleRadius, ChordDistance(cap.dX, nodeSample));
+				}
+
+				dSampleRadius +=
+					0.5 * dLatRadius * fabs(dDeltaLon)
+						/ static_cast<double>(FaceBVHLatitudeSamples);
+
+				dRadius = std::max(dRadius, dSampleRadius);
+			}
+		}
+
+		// Faces that do not fit in a hemisphere are bounded by the whole
+		// sphere
+		if ((dCenterMag <= HighTolerance) || (dRadius >= sqrt(2.0))) {
+			cap.dX[0] = 0.0;
+			cap.dX[1] = 0.0;
+			cap.dX[2] = 0.0;
+			dRadius = 1.0;
+		}
+
+		cap.dRadius = dRadius + FaceBVHCapTolerance;
+	}
+
+	BuildSubtree(0, nFaces);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void FaceBVH::BuildSubtree(
+	int ixBegin,
+	int ixEnd
+) {
+	const int ixTreeNode = m_vecTreeNodes.size();
+
+	m_vecTreeNodes.resize(ixTreeNode + 1);
+
+	// Bounding box of all caps, and of their centers
+	double dMin[3] = { DBL_MAX, DBL_MAX, DBL_MAX };
+	double dMax[3] = { -DBL_MAX, -DBL_MAX, -DBL_MAX };
+
+	double dCenterMin[3] = { DBL_MAX, DBL_MAX, DBL_MAX };
+	double dCenterMax[3] = { -DBL_MAX, -DBL_MAX, -DBL_MAX };
+
+	for (int i = ixBegin; i < ixEnd; i++) {
+		const FaceCap & cap = m_vecCaps[i];
+		for (int d = 0; d < 3; d++) {
+			dMin[d] = std::min(dMin[d], cap.dX[d] - cap.dRadius);
+			dMax[d] = std::max(dMax[d], cap.dX[d] + cap.dRadius);
+			dCenterMin[d] = std::min(dCenterMin[d], cap.dX[d]);
+			dCenterMax[d] = std::max(dCenterMax[d], cap.dX[d]);
+		}
+	}
+
+	TreeNode & treenode = m_vecTreeNodes[ixTreeNode];
+	for (int d = 0; d < 3; d++) {
+		treenode.dMin[d] = dMin[d];
+		treenode.dMax[d] = dMax[d];
+	}
+	treenode.ixBegin = ixBegin;
+	treenode.ixEnd = ixEnd;
+	treenode.ixRight = (-1);
+
+	if (ixEnd - ixBegin <= LeafSize) {
+		return;
+	}
+
+	// Split at the median center along the axis of greatest extent
+	int iAxis = 0;
+	for (int d = 1; d < 3; d++) {
+		if (dCenterMax[d] - dCenterMin[d]
+		    > dCenterMax[iAxis] - dCenterMin[iAxis]
+		) {
+			iAxis = d;
+		}
+	}
+
+	const int ixMid = ixBegin + (ixEnd - ixBegin) / 2;
+
+	std::nth_element(
+		m_vecCaps.begin() + ixBegin,
+		m_vecCaps.begin() + ixMid,
+		m_vecCaps.begin() + ixEnd,
+		[iAxis](const FaceCap & a, const FaceCap & b) {
+			return (a.dX[iAxis] < b.dX[iAxis]);
+		});
+
+	BuildSubtree(ixBegin, ixMid);
+
+	const int ixRight = m_vecTreeNodes.size();
+	m_vecTreeNodes[ixTreeNode].ixRight = ixRight;
+
+	BuildSubtree(ixMid, ixEnd);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void FaceBVH::FindCandidateFaces(
+	const Node & node,
+	std::vector<int> & vecFaces
+) const {
+	vecFaces.clear();
+
+	if (m_vecTreeNodes.size() == 0) {
+		return;
+	}
+
+	const double dX[3] = { node.x, node.y, node.z };
+
+	// Median splits bound the depth of the tree by log2 of the number of
+	// Faces, and at most one pending right child is stored per level
+	int ixStack[128];
+	int nStack = 0;
+
+	ixStack[nStack++] = 0;
+
+	while (nStack > 0) {
+		const int ixTreeNode = ixStack[--nStack];
+		const TreeNode & treenode = m_vecTreeNodes[ixTreeNode];
+
+		if ((dX[0] < treenode.dMin[0]) || (dX[0] > treenode.dMax[0]) ||
+		    (dX[1] < treenode.dMin[1]) || (dX[1] > treenode.dMax[1]) ||
+		    (dX[2] < treenode.dMin[2]) || (dX[2] > treenode.dMax[2])
+		) {
+			continue;
+		}
+
+		if (treenode.ixRight == (-1)) {
+			for (int i = treenode.ixBegin; i < treenode.ixEnd; i++) {
+				const FaceCap & cap = m_vecCaps[i];
+
+				const double dDx = dX[0] - cap.dX[0];
+				const double dDy = dX[1] - cap.dX[1];
+				const double dDz = dX[2] - cap.dX[2];
+
+				if (dDx * dDx + dDy * dDy + dDz * dDz
+				    <= cap.dRadius * cap.dRadius
+				) {
+					vecFaces.push_back(cap.ixFace);
+				}
+			}
+			continue;
+		}
+
+		ixStack[nStack++] = treenode.ixRight;
+		ixStack[nStack++] = ixTreeNode + 1;
+	}
+
+	std::sort(vecFaces.begin(), vecFaces.end());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void FaceBVH::FindCandidateFaces(
+	const Node & node,
+	double dRadius,
+	std::vector<int> & vecFaces
+) const {
+	vecFaces.clear();
+
+	if (m_vecTreeNodes.size() == 0) {
+		return;
+	}
+
+	const double dX[3] = { node.x, node.y, node.z };
+
+	int ixStack[128];
+	int nStack = 0;
+
+	ixStack[nStack++] = 0;
+
+	while (nStack > 0) {
+		const int ixTreeNode = ixStack[--nStack];
+		const TreeNode & treenode = m_vecTreeNodes[ixTreeNode];
+
+		if ((dX[0] + dRadius < treenode.dMin[0]) ||
+		    (dX[0] - dRadius > treenode.dMax[0]) ||
+		    (dX[1] + dRadius < treenode.dMin[1]) ||
+		    (dX[1] - dRadius > treenode.dMax[1]) ||
+		    (dX[2] + dRadius < treenode.dMin[2]) ||
+		    (dX[2] - dRadius > treenode.dMax[2])
+		) {
+			continue;
+		}
+
+		if (treenode.ixRight == (-1)) {
+			for (int i = treenode.ixBegin; i < treenode.ixEnd; i++) {
+				const FaceCap & cap = m_vecCaps[i];
+
+				const double dDx = dX[0] - cap.dX[0];
+				const double dDy = dX[1] - cap.dX[1];
+				const double dDz = dX[2] - cap.dX[2];
+
+				const double dReach = cap.dRadius + dRadius;
+
+				if (dDx * dDx + dDy * dDy + dDz * dDz <= dReach * dReach) {
+					vecFaces.push_back(cap.ixFace);
+				}
+			}
+			continue;
+		}
+
+		ixStack[nStack++] = treenode.ixRight;
+		ixStack[nStack++] = ixTreeNode + 1;
+	}
+
+	std::sort(vecFaces.begin(), vecFaces.end());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void FaceBVH::FindCandidateFaces(
+	const NodeVector & vecNodes,
+	std::vector< std::vector<int> > & vecFaces
+) const {
+	const int nNodes = vecNodes.size();
+
+	vecFaces.resize(nNodes);
+
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < nNodes; i++) {
+		FindCandidateFaces(vecNodes[i], vecFaces[i]);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
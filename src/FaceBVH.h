@@ -0,0 +1,156 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    FaceBVH.h
+///	\author  Paul Ullrich
+///	\version October 14, 2026
+///
+///	<remarks>
+///		Copyright 2026 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#ifndef _FACEBVH_H_
+#define _FACEBVH_H_
+
+#include "GridElements.h"
+
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A bounding volume hierarchy over the Faces of a Mesh.  Each Face is
+///		bounded by a spherical cap, stored as a ball in 3D Cartesian
+///		geometry, and the hierarchy is a tree of axis-aligned boxes around
+///		these balls.  Queries return every Face whose cap contains a point,
+///		which is a superset of the Faces that contain the point, and may be
+///		issued concurrently from multiple threads.
+///	</summary>
+class FaceBVH {
+
+public:
+	///	<summary>
+	///		Maximum number of Faces in a leaf of the hierarchy.
+	///	</summary>
+	static const int LeafSize = 8;
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	FaceBVH() { }
+
+	///	<summary>
+	///		Construct the hierarchy over the Faces of a Mesh.
+	///	</summary>
+	FaceBVH(
+		const Mesh & mesh
+	) {
+		Build(mesh);
+	}
+
+public:
+	///	<summary>
+	///		Build the hierarchy over the Faces of a Mesh, replacing the
+	///		existing contents.
+	///	</summary>
+	void Build(
+		const Mesh & mesh
+	);
+
+	///	<summary>
+	///		Remove all Faces from the hierarchy.
+	///	</summary>
+	void Clear() {
+		m_vecCaps.clear();
+		m_vecTreeNodes.clear();
+	}
+
+	///	<summary>
+	///		Number of Faces in the hierarchy.
+	///	</summary>
+	size_t size() const {
+		return m_vecCaps.size();
+	}
+
+	///	<summary>
+	///		Find all Faces whose bounding cap contains the given Node.  Face
+	///		indices are returned in ascending order.
+	///	</summary>
+	void FindCandidateFaces(
+		const Node & node,
+		std::vector<int> & vecFaces
+	) const;
+
+	///	<summary>
+	///		Find all Faces whose bounding cap intersects the ball of radius
+	///		dRadius (chord distance) around the given Node, which is a
+	///		superset of the Faces that overlap any region contained in that
+	///		ball.  Face indices are returned in ascending order.
+	///	</summary>
+	void FindCandidateFaces(
+		const Node & node,
+		double dRadius,
+		std::vector<int> & vecFaces
+	) const;
+
+	///	<summary>
+	///		Find all Faces whose bounding cap contains each of the given
+	///		Nodes.  Queries are distributed over OpenMP threads.
+	///	</summary>
+	void FindCandidateFaces(
+		const NodeVector & vecNodes,
+		std::vector< std::vector<int> > & vecFaces
+	) const;
+
+private:
+	///	<summary>
+	///		A ball bounding the spherical cap around one Face.
+	///	</summary>
+	struct FaceCap {
+		double dX[3];
+		double dRadius;
+		int ixFace;
+	};
+
+	///	<summary>
+	///		A node of the hierarchy, covering caps [ixBegin, ixEnd).  The
+	///		left child of an interior node immediately follows it.
+	///	</summary>
+	struct TreeNode {
+		double dMin[3];
+		double dMax[3];
+		int ixBegin;
+		int ixEnd;
+		int ixRight;
+	};
+
+	///	<summary>
+	///		Recursively build the subtree over caps [ixBegin, ixEnd).
+	///	</summary>
+	void BuildSubtree(
+		int ixBegin,
+		int ixEnd
+	);
+
+private:
+	///	<summary>
+	///		Bounding caps in hierarchy order.
+	///	</summary>
+	std::vector<FaceCap> m_vecCaps;
+
+	///	<summary>
+	///		Nodes of the hierarchy in depth-first order.
+	///	</summary>
+	std::vector<TreeNode> m_vecTreeNodes;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif
+
@@ -19,7 +19,10 @@
 #include "GridElements.h"
 #include "GaussLobattoQuadrature.h"
 
+#include <algorithm>
 #include <map>
+#include <string>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -28,8 +31,91 @@ void GetDefaultNodalLocations(
 	DataArray1D<double> & dG
 ) {
 	// GLL Quadrature nodes on [0,1]
+	if (GLLBasisTable::IsAvailable(nP)) {
+		const GLLBasisTable & tableGLL = GLLBasisTable::Get(nP);
+
+		dG.Allocate(nP);
+		for (int i = 0; i < nP; i++) {
+			dG[i] = tableGLL.GetNodes()[i];
+		}
+
+	} else {
+		DataArray1D<double> dW;
+		GaussLobattoQuadrature::GetPoints(nP, 0.0, 1.0, dG, dW);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+const GLLBasisTable & GLLBasisTable::Get(
+	int nP
+) {
+	if (!IsAvailable(nP)) {
+		_EXCEPTION2("GLL basis table unavailable for %i nodes (maximum %i)",
+			nP, GLLBasisTableMaxNp);
+	}
+
+	// Initialization of function-scope statics is thread-safe
+	static const std::vector<GLLBasisTable> s_vecTables = []() {
+		std::vector<GLLBasisTable> vecTables(GLLBasisTableMaxNp + 1);
+		for (int n = 2; n <= GLLBasisTableMaxNp; n++) {
+			vecTables[n].Initialize(n);
+		}
+		return vecTables;
+	}();
+
+	return s_vecTables[nP];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void GLLBasisTable::Initialize(
+	int nP
+) {
+	m_nP = nP;
+
+	DataArray1D<double> dG;
 	DataArray1D<double> dW;
 	GaussLobattoQuadrature::GetPoints(nP, 0.0, 1.0, dG, dW);
+
+	for (int i = 0; i < nP; i++) {
+		m_dG[i] = dG[i];
+		m_dW[i] = dW[i];
+	}
+
+	// Barycentric weights 1 / prod_{j != i} (x_i - x_j)
+	for (int i = 0; i < nP; i++) {
+		double dProd = 1.0;
+		for (int j = 0; j < nP; j++) {
+			if (j != i) {
+				dProd *= (m_dG[i] - m_dG[j]);
+			}
+		}
+		m_dBaryW[i] = 1.0 / dProd;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void GLLBasisTable::EvaluateBasis(
+	double dX,
+	double * dCoeff
+) const {
+	// First form of the barycentric formula
+	//   l_i(x) = w_i * prod_{j != i} (x - x_j)
+	// evaluated with running products to the left and right of node i,
+	// which requires no divisions and vanishes exactly at the other nodes
+	double dLeft = 1.0;
+	for (int i = 0; i < m_nP; i++) {
+		dCoeff[i] = dLeft * m_dBaryW[i];
+		dLeft *= (dX - m_dG[i]);
+	}
+
+	double dRight = 1.0;
+	for (int i = m_nP - 1; i >= 0; i--) {
+		dCoeff[i] *= dRight;
+		dRight *= (dX - m_dG[i]);
+	}
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -264,6 +350,298 @@ void ApplyInverseMap(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		Get the local coordinates (i,j) of the GLL node at position p along
+///		edge e of a quadrilateral element, where edge e runs from node e to
+///		node (e+1)%4 of the Face and p is counted from node e.
+///	</summary>
+static inline void GetGLLEdgeNodeIndex(
+	int nP,
+	int e,
+	int p,
+	int & i,
+	int & j
+) {
+	if (e == 0) {
+		i = p;
+		j = 0;
+	} else if (e == 1) {
+		i = nP - 1;
+		j = p;
+	} else if (e == 2) {
+		i = nP - 1 - p;
+		j = nP - 1;
+	} else {
+		i = 0;
+		j = nP - 1 - p;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Find the first element which contains GLL node (i,j) of element k,
+///		and the local coordinates of this node in that element.  GLL nodes
+///		are identified by the connectivity of the mesh: corner nodes by
+///		their mesh node, edge nodes by their mesh edge and position along
+///		it, and interior nodes by their element.
+///	</summary>
+static void FindGLLNodeOwner(
+	const Mesh & mesh,
+	const std::vector<int> & vecNodeFaceBegin,
+	const std::vector<int> & vecNodeFaces,
+	int nP,
+	int k,
+	int i,
+	int j,
+	int & kOwner,
+	int & iOwner,
+	int & jOwner
+) {
+	kOwner = k;
+	iOwner = i;
+	jOwner = j;
+
+	const bool fBoundaryI = ((i == 0) || (i == nP-1));
+	const bool fBoundaryJ = ((j == 0) || (j == nP-1));
+
+	// Interior nodes belong to this element
+	if (!fBoundaryI && !fBoundaryJ) {
+		return;
+	}
+
+	const Face & face = mesh.faces[k];
+
+	// Corner nodes belong to the first element containing the mesh node
+	if (fBoundaryI && fBoundaryJ) {
+		int c;
+		if (j == 0) {
+			c = (i == 0)?(0):(1);
+		} else {
+			c = (i == 0)?(3):(2);
+		}
+
+		const int ixNode = face[c];
+
+		kOwner = vecNodeFaces[vecNodeFaceBegin[ixNode]];
+
+		const Face & faceOwner = mesh.faces[kOwner];
+		for (int cOwner = 0; cOwner < 4; cOwner++) {
+			if (faceOwner[cOwner] == ixNode) {
+				GetGLLEdgeNodeIndex(nP, cOwner, 0, iOwner, jOwner);
+				return;
+			}
+		}
+		return;
+	}
+
+	// Edge nodes belong to the first element containing the mesh edge
+	int e;
+	int p;
+	if (j == 0) {
+		e = 0;
+		p = i;
+	} else if (i == nP-1) {
+		e = 1;
+		p = j;
+	} else if (j == nP-1) {
+		e = 2;
+		p = nP - 1 - i;
+	} else {
+		e = 3;
+		p = nP - 1 - j;
+	}
+
+	const int ixNode0 = face[e];
+	const int ixNode1 = face[(e+1)%4];
+
+	// Faces containing ixNode0 are in increasing order and include k
+	for (int n = vecNodeFaceBegin[ixNode0]; n < vecNodeFaceBegin[ixNode0+1]; n++) {
+		const int kOther = vecNodeFaces[n];
+		const Face & faceOther = mesh.faces[kOther];
+
+		for (int eOther = 0; eOther < 4; eOther++) {
+			const int ixOther0 = faceOther[eOther];
+			const int ixOther1 = faceOther[(eOther+1)%4];
+
+			if ((ixOther0 == ixNode0) && (ixOther1 == ixNode1)) {
+				kOwner = kOther;
+				GetGLLEdgeNodeIndex(nP, eOther, p, iOwner, jOwner);
+				return;
+			}
+			if ((ixOther0 == ixNode1) && (ixOther1 == ixNode0)) {
+				kOwner = kOther;
+				GetGLLEdgeNodeIndex(nP, eOther, nP - 1 - p, iOwner, jOwner);
+				return;
+			}
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Number the unique GLL nodes of a mesh using its connectivity.  Nodes
+///		are numbered in order of first appearance over elements and local
+///		nodes, which is computed in parallel: each element counts the nodes
+///		it contains first, and a prefix sum over these counts gives the
+///		first index of each element.
+///	</summary>
+static void NumberGLLNodesByConnectivity(
+	const Mesh & mesh,
+	int nP,
+	DataArray3D<int> & dataGLLnodes
+) {
+	const int nElements = static_cast<int>(mesh.faces.size());
+	const int nNodes = static_cast<int>(mesh.nodes.size());
+
+	// Faces containing each mesh node, in increasing order
+	std::vector<int> vecNodeFaceBegin(nNodes+1, 0);
+	for (int k = 0; k < nElements; k++) {
+		for (int c = 0; c < 4; c++) {
+			vecNodeFaceBegin[mesh.faces[k][c]+1]++;
+		}
+	}
+	for (int n = 0; n < nNodes; n++) {
+		vecNodeFaceBegin[n+1] += vecNodeFaceBegin[n];
+	}
+
+	std::vector<int> vecNodeFaces(vecNodeFaceBegin[nNodes]);
+	{
+		std::vector<int> vecNodeFaceNext(
+			vecNodeFaceBegin.begin(), vecNodeFaceBegin.end() - 1);
+
+		for (int k = 0; k < nElements; k++) {
+			for (int c = 0; c < 4; c++) {
+				vecNodeFaces[vecNodeFaceNext[mesh.faces[k][c]]++] = k;
+			}
+		}
+	}
+
+	// Count the GLL nodes which first appear in each element
+	std::vector<int> vecOwnedBegin(nElements+1, 0);
+
+#pragma omp parallel for schedule(static)
+	for (int k = 0; k < nElements; k++) {
+		int nOwned = 0;
+		for (int j = 0; j < nP; j++) {
+		for (int i = 0; i < nP; i++) {
+			int kOwner;
+			int iOwner;
+			int jOwner;
+
+			FindGLLNodeOwner(
+				mesh, vecNodeFaceBegin, vecNodeFaces,
+				nP, k, i, j,
+				kOwner, iOwner, jOwner);
+
+			if (kOwner == k) {
+				nOwned++;
+			}
+		}
+		}
+		vecOwnedBegin[k+1] = nOwned;
+	}
+
+	for (int k = 0; k < nElements; k++) {
+		vecOwnedBegin[k+1] += vecOwnedBegin[k];
+	}
+
+	// Number GLL nodes which first appear in each element
+#pragma omp parallel for schedule(static)
+	for (int k = 0; k < nElements; k++) {
+		int ixNode = vecOwnedBegin[k];
+		for (int j = 0; j < nP; j++) {
+		for (int i = 0; i < nP; i++) {
+			int kOwner;
+			int iOwner;
+			int jOwner;
+
+			FindGLLNodeOwner(
+				mesh, vecNodeFaceBegin, vecNodeFaces,
+				nP, k, i, j,
+				kOwner, iOwner, jOwner);
+
+			if (kOwner == k) {
+				ixNode++;
+				dataGLLnodes[j][i][k] = ixNode;
+			}
+		}
+		}
+	}
+
+	// Copy the index of shared GLL nodes from their first element
+#pragma omp parallel for schedule(static)
+	for (int k = 0; k < nElements; k++) {
+		for (int j = 0; j < nP; j++) {
+		for (int i = 0; i < nP; i++) {
+			int kOwner;
+			int iOwner;
+			int jOwner;
+
+			FindGLLNodeOwner(
+				mesh, vecNodeFaceBegin, vecNodeFaces,
+				nP, k, i, j,
+				kOwner, iOwner, jOwner);
+
+			if (kOwner != k) {
+				dataGLLnodes[j][i][k] = dataGLLnodes[jOwner][iOwner][kOwner];
+			}
+		}
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Number the unique GLL nodes of a mesh by their coordinates.  This is
+///		used for meshes with degenerate elements, where distinct local GLL
+///		nodes of an element may coincide.
+///	</summary>
+static void NumberGLLNodesByCoordinate(
+	const Mesh & mesh,
+	const DataArray1D<double> & dG,
+	DataArray3D<int> & dataGLLnodes
+) {
+	const int nElements = static_cast<int>(mesh.faces.size());
+	const int nP = static_cast<int>(dG.GetRows());
+
+	std::map<Node, int> mapNodes;
+
+	for (int k = 0; k < nElements; k++) {
+		const Face & face = mesh.faces[k];
+
+		for (int j = 0; j < nP; j++) {
+		for (int i = 0; i < nP; i++) {
+			Node nodeGLL;
+
+			ApplyLocalMap(
+				face,
+				mesh.nodes,
+				dG[i],
+				dG[j],
+				nodeGLL);
+
+			// Determine if this is a unique Node
+			std::map<Node, int>::const_iterator iter = mapNodes.find(nodeGLL);
+			if (iter == mapNodes.end()) {
+
+				// Insert new unique node into map
+				int ixNode = static_cast<int>(mapNodes.size());
+				mapNodes.insert(std::pair<Node, int>(nodeGLL, ixNode));
+				dataGLLnodes[j][i][k] = ixNode + 1;
+
+			} else {
+				dataGLLnodes[j][i][k] = iter->second + 1;
+			}
+		}
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 double GenerateMetaData(
 	const Mesh & mesh,
 	int nP,
@@ -279,8 +657,6 @@ double GenerateMetaData(
 	dataGLLnodes.Allocate(nP, nP, nElements);
 	dataGLLJacobian.Allocate(nP, nP, nElements);
 
-	std::map<Node, int> mapNodes;
-
 	// GLL Quadrature nodes
 	DataArray1D<double> dG;
 	DataArray1D<double> dW;
@@ -289,9 +665,6 @@ double GenerateMetaData(
 	// Accumulated Jacobian
 	double dAccumulatedJacobian = 0.0;
 
-	// Growing array of Jacobian values
-	std::vector<double> vecGLLJacobian;
-
 	// Verify face areas are available
 	if (!fNoBubble) {
 		if (mesh.vecFaceArea.GetRows() != nElements) {
@@ -299,15 +672,47 @@ double GenerateMetaData(
 		}
 	}
 
-	// Write metadata
+	// Verify all elements are quadrilaterals and check for degenerate
+	// elements with repeated nodes
+	bool fDegenerateElements = false;
+
 	for (int k = 0; k < nElements; k++) {
 		const Face & face = mesh.faces[k];
-		const NodeVector & nodevec = mesh.nodes;
 
 		if (face.edges.size() != 4) {
 			_EXCEPTIONT("Mesh must only contain quadrilateral elements");
 		}
 
+		for (int c = 0; c < 4; c++) {
+		for (int d = c+1; d < 4; d++) {
+			if (face[c] == face[d]) {
+				fDegenerateElements = true;
+			}
+		}
+		}
+	}
+
+	// Numerical area of each element
+	std::vector<double> vecFaceNumericalArea(nElements);
+
+	// Jacobians are computed for blocks of elements in parallel
+	const int nBlocks =
+		(nElements + GLLMetaDataParallelBlockSize - 1)
+			/ GLLMetaDataParallelBlockSize;
+
+	std::vector<std::string> vecBlockError(nBlocks);
+
+#pragma omp parallel for schedule(dynamic)
+	for (int b = 0; b < nBlocks; b++) {
+		const int kBegin = b * GLLMetaDataParallelBlockSize;
+		const int kEnd =
+			std::min(kBegin + GLLMetaDataParallelBlockSize, nElements);
+
+		try {
+		for (int k = kBegin; k < kEnd; k++) {
+		const Face & face = mesh.faces[k];
+		const NodeVector & nodevec = mesh.nodes;
+
 		double dFaceNumericalArea = 0.0;
 
 		for (int j = 0; j < nP; j++) {
@@ -399,19 +804,6 @@ double GenerateMetaData(
 				dDx1G,
 				dDx2G);
 
-			// Determine if this is a unique Node
-			std::map<Node, int>::const_iterator iter = mapNodes.find(nodeGLL);
-			if (iter == mapNodes.end()) {
-
-				// Insert new unique node into map
-				int ixNode = static_cast<int>(mapNodes.size());
-				mapNodes.insert(std::pair<Node, int>(nodeGLL, ixNode));
-				dataGLLnodes[j][i][k] = ixNode + 1;
-
-			} else {
-				dataGLLnodes[j][i][k] = iter->second + 1;
-			}
-
 			// Cross product gives local Jacobian
 			Node nodeCross = CrossProduct(dDx1G, dDx2G);
 
@@ -487,8 +879,31 @@ double GenerateMetaData(
 			}
 		}
 
-		// Accumulate area from element
-		dAccumulatedJacobian += dFaceNumericalArea;
+		vecFaceNumericalArea[k] = dFaceNumericalArea;
+		}
+
+		} catch(Exception & e) {
+			vecBlockError[b] = e.ToString();
+		}
+	}
+
+	// Report the error from the first failing element
+	for (int b = 0; b < nBlocks; b++) {
+		if (vecBlockError[b] != "") {
+			_EXCEPTION1("%s", vecBlockError[b].c_str());
+		}
+	}
+
+	// Accumulate area from elements in order
+	for (int k = 0; k < nElements; k++) {
+		dAccumulatedJacobian += vecFaceNumericalArea[k];
+	}
+
+	// Number the unique GLL nodes
+	if (fDegenerateElements) {
+		NumberGLLNodesByCoordinate(mesh, dG, dataGLLnodes);
+	} else {
+		NumberGLLNodesByConnectivity(mesh, nP, dataGLLnodes);
 	}
 
 	return dAccumulatedJacobian;
@@ -564,38 +979,40 @@ void GenerateDiscontinuousJacobian(
 ///////////////////////////////////////////////////////////////////////////////
 
 ///	<summary>
-///		Global coefficient arrays (kept global to minimize reallocation)
+///		Get the one-dimensional interpolation coefficients in each direction
+///		for sampling a 2D finite element at the specified point.  The
+///		arrays dCoeffAlpha and dCoeffBeta must be zero on entry.
 ///	</summary>
-DataArray1D<double> g_dCoeffAlpha;
-DataArray1D<double> g_dCoeffBeta;
-
-void SampleGLLFiniteElement(
+static void SampleGLLFiniteElementCoeffs(
 	int nMonotoneType,
 	int nP,
 	double dAlpha,
 	double dBeta,
-	DataArray2D<double> & dCoeff
+	double * dCoeffAlpha,
+	double * dCoeffBeta
 ) {
-	// Interpolation coefficients
-	g_dCoeffAlpha.Allocate(nP);
-	g_dCoeffBeta.Allocate(nP);
-
 	// Non-monotone interpolation
 	if (nMonotoneType == 0) {
 
 		if (nP > 4) {
-			// GLL Quadrature nodes on [0,1]
-			DataArray1D<double> dG;
-			GetDefaultNodalLocations(nP, dG);
-			//DataArray1D<double> dW;
-			//GaussLobattoQuadrature::GetPoints(nP, 0.0, 1.0, dG, dW);
-
 			// Get interpolation coefficients in each direction
-			PolynomialInterp::LagrangianPolynomialCoeffs(
-				nP, dG, g_dCoeffAlpha, dAlpha);
+			if (GLLBasisTable::IsAvailable(nP)) {
+				const GLLBasisTable & tableGLL = GLLBasisTable::Get(nP);
+
+				tableGLL.EvaluateBasis(dAlpha, dCoeffAlpha);
+				tableGLL.EvaluateBasis(dBeta, dCoeffBeta);
+
+			} else {
+				// GLL Quadrature nodes on [0,1]
+				DataArray1D<double> dG;
+				GetDefaultNodalLocations(nP, dG);
+
+				PolynomialInterp::LagrangianPolynomialCoeffs(
+					nP, dG, dCoeffAlpha, dAlpha);
 
-			PolynomialInterp::LagrangianPolynomialCoeffs(
-				nP, dG, g_dCoeffBeta, dBeta);
+				PolynomialInterp::LagrangianPolynomialCoeffs(
+					nP, dG, dCoeffBeta, dBeta);
+			}
 		}
 
 		// Map dAlpha and dBeta to [-1,1]
@@ -604,44 +1021,44 @@ void SampleGLLFiniteElement(
 
 		// Second order monotone interpolation
 		if (nP == 2) {
-			g_dCoeffAlpha[0] = 0.5 * (1.0 - dAlpha);
-			g_dCoeffAlpha[1] = 0.5 * (1.0 + dAlpha);
+			dCoeffAlpha[0] = 0.5 * (1.0 - dAlpha);
+			dCoeffAlpha[1] = 0.5 * (1.0 + dAlpha);
 
-			g_dCoeffBeta[0] = 0.5 * (1.0 - dBeta);
-			g_dCoeffBeta[1] = 0.5 * (1.0 + dBeta);
+			dCoeffBeta[0] = 0.5 * (1.0 - dBeta);
+			dCoeffBeta[1] = 0.5 * (1.0 + dBeta);
 
 		// Third order interpolation
 		} else if (nP == 3) {
-			g_dCoeffAlpha[0] = 0.5 * (dAlpha * dAlpha - dAlpha);
-			g_dCoeffAlpha[1] = 1.0 - dAlpha * dAlpha;
-			g_dCoeffAlpha[2] = 0.5 * (dAlpha * dAlpha + dAlpha);
+			dCoeffAlpha[0] = 0.5 * (dAlpha * dAlpha - dAlpha);
+			dCoeffAlpha[1] = 1.0 - dAlpha * dAlpha;
+			dCoeffAlpha[2] = 0.5 * (dAlpha * dAlpha + dAlpha);
 
-			g_dCoeffBeta[0] = 0.5 * (dBeta * dBeta - dBeta);
-			g_dCoeffBeta[1] = 1.0 - dBeta * dBeta;
-			g_dCoeffBeta[2] = 0.5 * (dBeta * dBeta + dBeta);
+			dCoeffBeta[0] = 0.5 * (dBeta * dBeta - dBeta);
+			dCoeffBeta[1] = 1.0 - dBeta * dBeta;
+			dCoeffBeta[2] = 0.5 * (dBeta * dBeta + dBeta);
 
 		// Fourth order interpolation
 		} else if (nP == 4) {
-			g_dCoeffAlpha[0] = -1.0/8.0
+			dCoeffAlpha[0] = -1.0/8.0
 				* (dAlpha - 1.0) * (5.0 * dAlpha * dAlpha - 1.0);
-			g_dCoeffAlpha[1] = - sqrt(5.0)/8.0
+			dCoeffAlpha[1] = - sqrt(5.0)/8.0
 				* (sqrt(5.0) - 5.0 * dAlpha)
 				* (dAlpha * dAlpha - 1.0);
-			g_dCoeffAlpha[2] = - sqrt(5.0)/8.0
+			dCoeffAlpha[2] = - sqrt(5.0)/8.0
 				* (sqrt(5.0) + 5.0 * dAlpha)
 				* (dAlpha * dAlpha - 1.0);
-			g_dCoeffAlpha[3] =  1.0/8.0
+			dCoeffAlpha[3] =  1.0/8.0
 				* (dAlpha + 1.0) * (5.0 * dAlpha * dAlpha - 1.0);
 
-			g_dCoeffBeta[0] = -1.0/8.0
+			dCoeffBeta[0] = -1.0/8.0
 				* (dBeta - 1.0) * (5.0 * dBeta * dBeta - 1.0);
-			g_dCoeffBeta[1] = - sqrt(5.0)/8.0
+			dCoeffBeta[1] = - sqrt(5.0)/8.0
 				* (sqrt(5.0) - 5.0 * dBeta)
 				* (dBeta * dBeta - 1.0);
-			g_dCoeffBeta[2] = - sqrt(5.0)/8.0
+			dCoeffBeta[2] = - sqrt(5.0)/8.0
 				* (sqrt(5.0) + 5.0 * dBeta)
 				* (dBeta * dBeta - 1.0);
-			g_dCoeffBeta[3] =  1.0/8.0
+			dCoeffBeta[3] =  1.0/8.0
 				* (dBeta + 1.0) * (5.0 * dBeta * dBeta - 1.0);
 		}
 
@@ -655,28 +1072,28 @@ void SampleGLLFiniteElement(
 		// Second order monotone interpolation
 		if (nP == 2) {
 
-			g_dCoeffAlpha[0] = 0.5 * (1.0 - dAlpha);
-			g_dCoeffAlpha[1] = 0.5 * (1.0 + dAlpha);
+			dCoeffAlpha[0] = 0.5 * (1.0 - dAlpha);
+			dCoeffAlpha[1] = 0.5 * (1.0 + dAlpha);
 
-			g_dCoeffBeta[0] = 0.5 * (1.0 - dBeta);
-			g_dCoeffBeta[1] = 0.5 * (1.0 + dBeta);
+			dCoeffBeta[0] = 0.5 * (1.0 - dBeta);
+			dCoeffBeta[1] = 0.5 * (1.0 + dBeta);
 
 		// Third order monotone interpolation
 		} else if (nP == 3) {
 
 			if (dAlpha < 0.0) {
-				g_dCoeffAlpha[0] = dAlpha * dAlpha;
-				g_dCoeffAlpha[1] = 1.0 - dAlpha * dAlpha;
+				dCoeffAlpha[0] = dAlpha * dAlpha;
+				dCoeffAlpha[1] = 1.0 - dAlpha * dAlpha;
 			} else {
-				g_dCoeffAlpha[1] = 1.0 - dAlpha * dAlpha;
-				g_dCoeffAlpha[2] = dAlpha * dAlpha;
+				dCoeffAlpha[1] = 1.0 - dAlpha * dAlpha;
+				dCoeffAlpha[2] = dAlpha * dAlpha;
 			}
 			if (dBeta < 0.0) {
-				g_dCoeffBeta[0] = dBeta * dBeta;
-				g_dCoeffBeta[1] = 1.0 - dBeta * dBeta;
+				dCoeffBeta[0] = dBeta * dBeta;
+				dCoeffBeta[1] = 1.0 - dBeta * dBeta;
 			} else {
-				g_dCoeffBeta[1] = 1.0 - dBeta * dBeta;
-				g_dCoeffBeta[2] = dBeta * dBeta;
+				dCoeffBeta[1] = 1.0 - dBeta * dBeta;
+				dCoeffBeta[2] = dBeta * dBeta;
 			}
 
 		// Fourth order monotone interpolation
@@ -695,37 +1112,37 @@ void SampleGLLFiniteElement(
 			const double dD1 = (5.0 / 4.0) * sqrt(5.0);
 
 			if ((dAlpha >= -dGLL1) && (dAlpha <= dGLL1)) {
-				g_dCoeffAlpha[1] =
+				dCoeffAlpha[1] =
 					dA1 + dAlpha * (dB1 + dAlpha * (dC1 + dAlpha * dD1));
-				g_dCoeffAlpha[2] =
-					1.0 - g_dCoeffAlpha[1];
+				dCoeffAlpha[2] =
+					1.0 - dCoeffAlpha[1];
 			} else if (dAlpha < -dGLL1) {
-				g_dCoeffAlpha[0] =
+				dCoeffAlpha[0] =
 					dA0 + dAlpha * (dB0 + dAlpha * (dC0 + dAlpha * dD0));
-				g_dCoeffAlpha[1] =
-					1.0 - g_dCoeffAlpha[0];
+				dCoeffAlpha[1] =
+					1.0 - dCoeffAlpha[0];
 			} else {
-				g_dCoeffAlpha[3] =
+				dCoeffAlpha[3] =
 					dA0 - dAlpha * (dB0 - dAlpha * (dC0 - dAlpha * dD0));
-				g_dCoeffAlpha[2] =
-					1.0 - g_dCoeffAlpha[3];
+				dCoeffAlpha[2] =
+					1.0 - dCoeffAlpha[3];
 			}
 
 			if ((dBeta >= -dGLL1) && (dBeta <= dGLL1)) {
-				g_dCoeffBeta[1] =
+				dCoeffBeta[1] =
 					dA1 + dBeta * (dB1 + dBeta * (dC1 + dBeta * dD1));
-				g_dCoeffBeta[2] =
-					1.0 - g_dCoeffBeta[1];
+				dCoeffBeta[2] =
+					1.0 - dCoeffBeta[1];
 			} else if (dBeta < -dGLL1) {
-				g_dCoeffBeta[0] =
+				dCoeffBeta[0] =
 					dA0 + dBeta * (dB0 + dBeta * (dC0 + dBeta * dD0));
-				g_dCoeffBeta[1] =
-					1.0 - g_dCoeffBeta[0];
+				dCoeffBeta[1] =
+					1.0 - dCoeffBeta[0];
 			} else {
-				g_dCoeffBeta[3] =
+				dCoeffBeta[3] =
 					dA0 - dBeta * (dB0 - dBeta * (dC0 - dBeta * dD0));
-				g_dCoeffBeta[2] =
-					1.0 - g_dCoeffBeta[3];
+				dCoeffBeta[2] =
+					1.0 - dCoeffBeta[3];
 			}
 
 		} else {
@@ -742,65 +1159,56 @@ void SampleGLLFiniteElement(
 		// Second order monotone interpolation
 		if (nP == 2) {
 
-			g_dCoeffAlpha.Zero();
-			g_dCoeffBeta.Zero();
-
 			if (dAlpha < 0.0) {
-				g_dCoeffAlpha[0] = 1.0;
+				dCoeffAlpha[0] = 1.0;
 			} else {
-				g_dCoeffAlpha[1] = 1.0;
+				dCoeffAlpha[1] = 1.0;
 			}
 			if (dBeta < 0.0) {
-				g_dCoeffBeta[0] = 1.0;
+				dCoeffBeta[0] = 1.0;
 			} else {
-				g_dCoeffBeta[1] = 1.0;
+				dCoeffBeta[1] = 1.0;
 			}
 
 		// Third order monotone interpolation
 		} else if (nP == 3) {
 
-			g_dCoeffAlpha.Zero();
-			g_dCoeffBeta.Zero();
-
 			if (dAlpha < -2.0/3.0) {
-				g_dCoeffAlpha[0] = 1.0;
+				dCoeffAlpha[0] = 1.0;
 			} else if (dAlpha <= 2.0/3.0) {
-				g_dCoeffAlpha[1] = 1.0;
+				dCoeffAlpha[1] = 1.0;
 			} else {
-				g_dCoeffAlpha[2] = 1.0;
+				dCoeffAlpha[2] = 1.0;
 			}
 			if (dBeta < -2.0/3.0) {
-				g_dCoeffBeta[0] = 1.0;
+				dCoeffBeta[0] = 1.0;
 			} else if (dBeta <= 2.0/3.0) {
-				g_dCoeffBeta[1] = 1.0;
+				dCoeffBeta[1] = 1.0;
 			} else {
-				g_dCoeffBeta[2] = 1.0;
+				dCoeffBeta[2] = 1.0;
 			}
 
 		// Fourth order monotone interpolation
 		} else if (nP == 4) {
 
-			g_dCoeffAlpha.Zero();
-			g_dCoeffBeta.Zero();
-
 			if (dAlpha < -5.0/6.0) {
-				g_dCoeffAlpha[0] = 1.0;
+				dCoeffAlpha[0] = 1.0;
 			} else if (dAlpha <= 0.0) {
-				g_dCoeffAlpha[1] = 1.0;
+				dCoeffAlpha[1] = 1.0;
 			} else if (dAlpha <= 5.0/6.0) {
-				g_dCoeffAlpha[2] = 1.0;
+				dCoeffAlpha[2] = 1.0;
 			} else {
-				g_dCoeffAlpha[3] = 1.0;
+				dCoeffAlpha[3] = 1.0;
 			}
 
 			if (dBeta < -5.0/6.0) {
-				g_dCoeffBeta[0] = 1.0;
+				dCoeffBeta[0] = 1.0;
 			} else if (dBeta <= 0.0) {
-				g_dCoeffBeta[1] = 1.0;
+				dCoeffBeta[1] = 1.0;
 			} else if (dBeta <= 5.0/6.0) {
-				g_dCoeffBeta[2] = 1.0;
+				dCoeffBeta[2] = 1.0;
 			} else {
-				g_dCoeffBeta[3] = 1.0;
+				dCoeffBeta[3] = 1.0;
 			}
 
 		} else {
@@ -817,28 +1225,28 @@ void SampleGLLFiniteElement(
 		// Second order monotone interpolation
 		if (nP == 2) {
 
-			g_dCoeffAlpha[0] = 0.5 * (1.0 - dAlpha);
-			g_dCoeffAlpha[1] = 0.5 * (1.0 + dAlpha);
+			dCoeffAlpha[0] = 0.5 * (1.0 - dAlpha);
+			dCoeffAlpha[1] = 0.5 * (1.0 + dAlpha);
 
-			g_dCoeffBeta[0] = 0.5 * (1.0 - dBeta);
-			g_dCoeffBeta[1] = 0.5 * (1.0 + dBeta);
+			dCoeffBeta[0] = 0.5 * (1.0 - dBeta);
+			dCoeffBeta[1] = 0.5 * (1.0 + dBeta);
 
 		// Third order monotone interpolation
 		} else if (nP == 3) {
 
 			if (dAlpha < 0.0) {
-				g_dCoeffAlpha[0] = - dAlpha;
-				g_dCoeffAlpha[1] = 1.0 + dAlpha;
+				dCoeffAlpha[0] = - dAlpha;
+				dCoeffAlpha[1] = 1.0 + dAlpha;
 			} else {
-				g_dCoeffAlpha[1] = 1.0 - dAlpha;
-				g_dCoeffAlpha[2] = dAlpha;
+				dCoeffAlpha[1] = 1.0 - dAlpha;
+				dCoeffAlpha[2] = dAlpha;
 			}
 			if (dBeta < 0.0) {
-				g_dCoeffBeta[0] = - dBeta;
-				g_dCoeffBeta[1] = 1.0 + dBeta;
+				dCoeffBeta[0] = - dBeta;
+				dCoeffBeta[1] = 1.0 + dBeta;
 			} else {
-				g_dCoeffBeta[1] = 1.0 - dBeta;
-				g_dCoeffBeta[2] = dBeta;
+				dCoeffBeta[1] = 1.0 - dBeta;
+				dCoeffBeta[2] = dBeta;
 			}
 
 		// Fourth order monotone interpolation
@@ -849,36 +1257,36 @@ void SampleGLLFiniteElement(
 			const double dA = 5.0 + sqrt(5.0);
 
 			if (dAlpha < -dGLL1) {
-				g_dCoeffAlpha[0] =
+				dCoeffAlpha[0] =
 					-1.0 / 20.0 * dA * (5.0 * dAlpha + sqrt(5.0));
-				g_dCoeffAlpha[1] =
+				dCoeffAlpha[1] =
 					1.0 / 4.0 * dA * (dAlpha + 1.0);
 
 			} else if (dAlpha < dGLL1) {
-				g_dCoeffAlpha[1] = 0.5 * (1.0 - sqrt(5.0) * dAlpha);
-				g_dCoeffAlpha[2] = 0.5 * (1.0 + sqrt(5.0) * dAlpha);
+				dCoeffAlpha[1] = 0.5 * (1.0 - sqrt(5.0) * dAlpha);
+				dCoeffAlpha[2] = 0.5 * (1.0 + sqrt(5.0) * dAlpha);
 
 			} else {
-				g_dCoeffAlpha[2] =
+				dCoeffAlpha[2] =
 					- 1.0 / 4.0 * dA * (dAlpha - 1.0);
-				g_dCoeffAlpha[3] =
+				dCoeffAlpha[3] =
 					- 1.0 / 20.0 * dA * (-5.0 * dAlpha + sqrt(5.0));
 			}
 
 			if (dBeta < -dGLL1) {
-				g_dCoeffBeta[0] =
+				dCoeffBeta[0] =
 					-1.0 / 20.0 * dA * (5.0 * dBeta + sqrt(5.0));
-				g_dCoeffBeta[1] =
+				dCoeffBeta[1] =
 					1.0 / 4.0 * dA * (dBeta + 1.0);
 
 			} else if (dBeta < dGLL1) {
-				g_dCoeffBeta[1] = 0.5 * (1.0 - sqrt(5.0) * dBeta);
-				g_dCoeffBeta[2] = 0.5 * (1.0 + sqrt(5.0) * dBeta);
+				dCoeffBeta[1] = 0.5 * (1.0 - sqrt(5.0) * dBeta);
+				dCoeffBeta[2] = 0.5 * (1.0 + sqrt(5.0) * dBeta);
 
 			} else {
-				g_dCoeffBeta[2] =
+				dCoeffBeta[2] =
 					- 1.0 / 4.0 * dA * (dBeta - 1.0);
-				g_dCoeffBeta[3] =
+				dCoeffBeta[3] =
 					- 1.0 / 20.0 * dA * (-5.0 * dBeta + sqrt(5.0));
 			}
 
@@ -889,15 +1297,79 @@ void SampleGLLFiniteElement(
 	} else {
 		_EXCEPTIONT("Invalid monotone type");
 	}
+}
 
-	// Combine coefficients
-	dCoeff.Allocate(nP, nP);
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Sample a 2D finite element at the specified point, storing the
+///		coefficient of node (i,j) in dCoeff[j * nP + i].  The arrays
+///		dCoeffAlpha and dCoeffBeta are used as workspace of size nP.
+///	</summary>
+static void SampleGLLFiniteElementPoint(
+	int nMonotoneType,
+	int nP,
+	double dAlpha,
+	double dBeta,
+	double * dCoeffAlpha,
+	double * dCoeffBeta,
+	double * dCoeff
+) {
+	for (int i = 0; i < nP; i++) {
+		dCoeffAlpha[i] = 0.0;
+		dCoeffBeta[i] = 0.0;
+	}
+
+	SampleGLLFiniteElementCoeffs(
+		nMonotoneType,
+		nP,
+		dAlpha,
+		dBeta,
+		dCoeffAlpha,
+		dCoeffBeta);
 
+	// Combine coefficients
 	for (int i = 0; i < nP; i++) {
 	for (int j = 0; j < nP; j++) {
-		dCoeff[j][i] = g_dCoeffAlpha[i] * g_dCoeffBeta[j];
+		dCoeff[j * nP + i] = dCoeffAlpha[i] * dCoeffBeta[j];
+	}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void SampleGLLFiniteElement(
+	int nMonotoneType,
+	int nP,
+	double dAlpha,
+	double dBeta,
+	DataArray2D<double> & dCoeff
+) {
+	// Interpolation coefficients are kept on the stack for tabulated orders
+	// so that this function does not allocate and may be called
+	// concurrently from multiple threads
+	double dCoeffBuffer[2 * GLLBasisTableMaxNp];
+	std::vector<double> vecCoeffBuffer;
+
+	double * dCoeffAlpha = dCoeffBuffer;
+	if (nP > GLLBasisTableMaxNp) {
+		vecCoeffBuffer.resize(2 * nP);
+		dCoeffAlpha = &(vecCoeffBuffer[0]);
 	}
+	double * dCoeffBeta = dCoeffAlpha + nP;
+
+	if ((dCoeff.GetRows() != nP) || (dCoeff.GetColumns() != nP)) {
+		dCoeff.Allocate(nP, nP);
 	}
+
+	SampleGLLFiniteElementPoint(
+		nMonotoneType,
+		nP,
+		dAlpha,
+		dBeta,
+		dCoeffAlpha,
+		dCoeffBeta,
+		&(dCoeff(0,0)));
 /*
 	// DEBUG: Override
 	if (fMonotone && (nP == 4)) {
@@ -972,3 +1444,42 @@ void SampleGLLFiniteElement(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void SampleGLLFiniteElement(
+	int nMonotoneType,
+	int nP,
+	int nPoints,
+	const double * dAlpha,
+	const double * dBeta,
+	DataArray3D<double> & dCoeff
+) {
+	double dCoeffBuffer[2 * GLLBasisTableMaxNp];
+	std::vector<double> vecCoeffBuffer;
+
+	double * dCoeffAlpha = dCoeffBuffer;
+	if (nP > GLLBasisTableMaxNp) {
+		vecCoeffBuffer.resize(2 * nP);
+		dCoeffAlpha = &(vecCoeffBuffer[0]);
+	}
+	double * dCoeffBeta = dCoeffAlpha + nP;
+
+	if ((dCoeff.GetRows() != nPoints) ||
+	    (dCoeff.GetColumns() != nP) ||
+	    (dCoeff.GetSubColumns() != nP)
+	) {
+		dCoeff.Allocate(nPoints, nP, nP);
+	}
+
+	for (int k = 0; k < nPoints; k++) {
+		SampleGLLFiniteElementPoint(
+			nMonotoneType,
+			nP,
+			dAlpha[k],
+			dBeta[k],
+			dCoeffAlpha,
+			dCoeffBeta,
+			&(dCoeff(k,0,0)));
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
@@ -40,6 +40,102 @@ void GetDefaultNodalLocations(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		A process-wide table of the GLL nodes and weights on [0,1] for a
+///		given number of nodes, along with the barycentric weights of the
+///		associated Lagrange basis.  Tables are available for
+///		2 <= nP <= GLLBasisTableMaxNp.
+///	</summary>
+class GLLBasisTable {
+
+public:
+	///	<summary>
+	///		Get the table for the given number of nodes.  The tables are
+	///		built once and may be shared among threads.
+	///	</summary>
+	static const GLLBasisTable & Get(
+		int nP
+	);
+
+	///	<summary>
+	///		Determine if a table is available for the given number of nodes.
+	///	</summary>
+	static bool IsAvailable(
+		int nP
+	) {
+		return ((nP >= 2) && (nP <= GLLBasisTableMaxNp));
+	}
+
+public:
+	///	<summary>
+	///		Number of nodes.
+	///	</summary>
+	int GetNp() const {
+		return m_nP;
+	}
+
+	///	<summary>
+	///		GLL nodes on [0,1].
+	///	</summary>
+	const double * GetNodes() const {
+		return m_dG;
+	}
+
+	///	<summary>
+	///		GLL weights on [0,1].
+	///	</summary>
+	const double * GetWeights() const {
+		return m_dW;
+	}
+
+	///	<summary>
+	///		Barycentric weights of the Lagrange basis on the GLL nodes.
+	///	</summary>
+	const double * GetBarycentricWeights() const {
+		return m_dBaryW;
+	}
+
+	///	<summary>
+	///		Evaluate the nP Lagrange basis functions at dX using the
+	///		barycentric formula.
+	///	</summary>
+	void EvaluateBasis(
+		double dX,
+		double * dCoeff
+	) const;
+
+protected:
+	///	<summary>
+	///		Initialize the table for the given number of nodes.
+	///	</summary>
+	void Initialize(
+		int nP
+	);
+
+protected:
+	///	<summary>
+	///		Number of nodes.
+	///	</summary>
+	int m_nP;
+
+	///	<summary>
+	///		GLL nodes on [0,1].
+	///	</summary>
+	double m_dG[GLLBasisTableMaxNp];
+
+	///	<summary>
+	///		GLL weights on [0,1].
+	///	</summary>
+	double m_dW[GLLBasisTableMaxNp];
+
+	///	<summary>
+	///		Barycentric weights.
+	///	</summary>
+	double m_dBaryW[GLLBasisTableMaxNp];
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
 ///	<summary>
 ///		Apply the local map.
 ///	</summary>
@@ -82,7 +178,10 @@ void ApplyInverseMap(
 ///////////////////////////////////////////////////////////////////////////////
 
 ///	<summary>
-///		Generate Mesh meta data for a spectral element grid.
+///		Generate Mesh meta data for a spectral element grid.  Unique GLL
+///		nodes are identified by the connectivity of the mesh (or by their
+///		coordinates if the mesh has degenerate elements) and are numbered
+///		in order of first appearance over elements.
 ///	</summary>
 double GenerateMetaData(
 	const Mesh & mesh,
@@ -129,3 +228,19 @@ void SampleGLLFiniteElement(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		Get the coefficients for sampling a 2D finite element at a batch of
+///		points, such as all quadrature points of one overlap face.  The
+///		coefficients of point k are stored in dCoeff[k].
+///	</summary>
+void SampleGLLFiniteElement(
+	int nMonotoneType,
+	int nP,
+	int nPoints,
+	const double * dAlpha,
+	const double * dBeta,
+	DataArray3D<double> & dCoeff
+);
+
+///////////////////////////////////////////////////////////////////////////////
+
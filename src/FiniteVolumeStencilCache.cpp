@@ -0,0 +1,398 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    FiniteVolumeStencilCache.cpp
+///	\author  Paul Ullrich
+///	\version October 14, 2026
+///
+///	<remarks>
+///		Copyright 2026 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "FiniteVolumeStencilCache.h"
+#include "Announce.h"
+#include "Exception.h"
+
+#include <cstdio>
+#include <cstring>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Identifier at the start of every stencil cache file.
+///	</summary>
+static const char StencilCacheMagic[8] = {'T','R','F','V','S','T','N','C'};
+
+///	<summary>
+///		Version of the stencil cache format.
+///	</summary>
+static const uint32_t StencilCacheVersion = 1;
+
+///	<summary>
+///		Marker used to detect files written with a different byte order.
+///	</summary>
+static const uint32_t StencilCacheByteOrderMark = 0x01020304;
+
+///	<summary>
+///		Header of a stencil cache file.  The header is followed by the
+///		adjacent Face offsets, adjacent Face indices, adjacent Face distances
+///		and fit moments.
+///	</summary>
+struct StencilCacheHeader {
+	char szMagic[8];
+	uint32_t uVersion;
+	uint32_t uByteOrderMark;
+	uint64_t uMeshHash;
+	int32_t nFaces;
+	int32_t nOrder;
+	int32_t nCoefficients;
+	int32_t nRequiredFaceSetSize;
+	int32_t nQuadraturePoints;
+	int32_t nTruncation;
+	uint64_t nAdjFaces;
+};
+
+///	<summary>
+///		Identifier of the compiled polynomial truncation.
+///	</summary>
+#ifdef RECTANGULAR_TRUNCATION
+static const int32_t StencilCacheTruncation = 1;
+#endif
+#ifdef TRIANGULAR_TRUNCATION
+static const int32_t StencilCacheTruncation = 2;
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint64_t FiniteVolumeStencilCache::CalculateMeshHash(
+	const Mesh & mesh
+) {
+	return mesh.CalculateHash();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void FiniteVolumeStencilCache::Prepare(
+	const Mesh & mesh,
+	const TriangularQuadratureRule & triquadrule,
+	int nOrder,
+	int nRequiredFaceSetSize
+) {
+	// Number of coefficients needed at this order
+#ifdef RECTANGULAR_TRUNCATION
+	const int nCoefficients = nOrder * nOrder;
+#endif
+#ifdef TRIANGULAR_TRUNCATION
+	const int nCoefficients = nOrder * (nOrder + 1) / 2;
+#endif
+
+	const uint64_t uMeshHash = CalculateMeshHash(mesh);
+
+	// Reuse stencils already in memory
+	if ((m_vecAdjBegin.size() != 0) &&
+	    (m_uMeshHash == uMeshHash) &&
+	    (m_nFaces == static_cast<int>(mesh.faces.size())) &&
+	    (m_nOrder == nOrder) &&
+	    (m_nCoefficients == nCoefficients) &&
+	    (m_nRequiredFaceSetSize == nRequiredFaceSetSize) &&
+	    (m_nQuadraturePoints == triquadrule.GetPoints())
+	) {
+		Announce("Reusing reconstruction stencils in memory");
+		return;
+	}
+
+	m_uMeshHash = uMeshHash;
+	m_nFaces = static_cast<int>(mesh.faces.size());
+	m_nOrder = nOrder;
+	m_nCoefficients = nCoefficients;
+	m_nRequiredFaceSetSize = nRequiredFaceSetSize;
+	m_nQuadraturePoints = triquadrule.GetPoints();
+
+	// Read stencils from the cache directory
+	if (m_strCacheDir != "") {
+		std::string strFile = GetCacheFileName();
+		if (Read(strFile)) {
+			Announce("Read reconstruction stencils from \"%s\"",
+				strFile.c_str());
+			return;
+		}
+	}
+
+	// Build stencils
+	Announce("Building reconstruction stencils");
+	Build(mesh, triquadrule);
+
+	// Write stencils to the cache directory
+	if (m_strCacheDir != "") {
+		std::string strFile = GetCacheFileName();
+		Write(strFile);
+		Announce("Wrote reconstruction stencils to \"%s\"",
+			strFile.c_str());
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void FiniteVolumeStencilCache::GetAdjacentFaces(
+	int ixFace,
+	AdjacentFaceVector & vecAdjFaces
+) const {
+	if ((ixFace < 0) || (ixFace >= m_nFaces)) {
+		_EXCEPTION1("Face index %i out of range of stencil cache", ixFace);
+	}
+
+	vecAdjFaces.clear();
+	for (int i = m_vecAdjBegin[ixFace]; i < m_vecAdjBegin[ixFace+1]; i++) {
+		vecAdjFaces.push_back(
+			FaceDistancePair(m_vecAdjFace[i], m_vecAdjDistance[i]));
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void FiniteVolumeStencilCache::GetFitMoments(
+	int ixFace,
+	DataArray2D<double> & dFitMoments
+) const {
+	if ((ixFace < 0) || (ixFace >= m_nFaces)) {
+		_EXCEPTION1("Face index %i out of range of stencil cache", ixFace);
+	}
+
+	const int nAdjFaces = m_vecAdjBegin[ixFace+1] - m_vecAdjBegin[ixFace];
+
+	dFitMoments.Allocate(m_nCoefficients, nAdjFaces);
+
+	const double * pMoments =
+		&(m_vecFitMoments[0])
+		+ static_cast<size_t>(m_vecAdjBegin[ixFace]) * m_nCoefficients;
+
+	memcpy(
+		&(dFitMoments(0,0)),
+		pMoments,
+		static_cast<size_t>(m_nCoefficients) * nAdjFaces * sizeof(double));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void FiniteVolumeStencilCache::Build(
+	const Mesh & mesh,
+	const TriangularQuadratureRule & triquadrule
+) {
+	const int nFaces = m_nFaces;
+
+	std::vector<AdjacentFaceVector> vecAllAdjFaces(nFaces);
+	std::vector< DataArray2D<double> > vecAllFitMoments(nFaces);
+
+	std::vector<std::string> vecFaceError(nFaces);
+
+#pragma omp parallel for schedule(dynamic,64)
+	for (int i = 0; i < nFaces; i++) {
+		try {
+			GetAdjacentFaceVectorByEdge(
+				mesh,
+				i,
+				m_nRequiredFaceSetSize,
+				vecAllAdjFaces[i]);
+
+			BuildFitMoments(
+				mesh,
+				triquadrule,
+				i,
+				vecAllAdjFaces[i],
+				m_nOrder,
+				vecAllFitMoments[i]);
+
+		} catch(Exception & e) {
+			vecFaceError[i] = e.ToString();
+		}
+	}
+
+	for (int i = 0; i < nFaces; i++) {
+		if (vecFaceError[i] != "") {
+			_EXCEPTION1("%s", vecFaceError[i].c_str());
+		}
+	}
+
+	// Pack stencils into contiguous arrays
+	m_vecAdjBegin.resize(nFaces+1);
+	m_vecAdjBegin[0] = 0;
+	for (int i = 0; i < nFaces; i++) {
+		m_vecAdjBegin[i+1] = m_vecAdjBegin[i] + vecAllAdjFaces[i].size();
+	}
+
+	const size_t sAdjFaces = m_vecAdjBegin[nFaces];
+
+	m_vecAdjFace.resize(sAdjFaces);
+	m_vecAdjDistance.resize(sAdjFaces);
+	m_vecFitMoments.resize(sAdjFaces * m_nCoefficients);
+
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < nFaces; i++) {
+		const AdjacentFaceVector & vecAdjFaces = vecAllAdjFaces[i];
+		const int ixBegin = m_vecAdjBegin[i];
+
+		for (int j = 0; j < vecAdjFaces.size(); j++) {
+			m_vecAdjFace[ixBegin + j] = vecAdjFaces[j].first;
+			m_vecAdjDistance[ixBegin + j] = vecAdjFaces[j].second;
+		}
+
+		if (vecAdjFaces.size() != 0) {
+			memcpy(
+				&(m_vecFitMoments[static_cast<size_t>(ixBegin) * m_nCoefficients]),
+				&(vecAllFitMoments[i](0,0)),
+				vecAdjFaces.size() * m_nCoefficients * sizeof(double));
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool FiniteVolumeStencilCache::Read(
+	const std::string & strFile
+) {
+	FILE * fp = fopen(strFile.c_str(), "rb");
+	if (fp == NULL) {
+		return false;
+	}
+
+	StencilCacheHeader header;
+	if (fread(&header, sizeof(StencilCacheHeader), 1, fp) != 1) {
+		fclose(fp);
+		return false;
+	}
+
+	if ((memcmp(header.szMagic, StencilCacheMagic, sizeof(StencilCacheMagic)) != 0) ||
+	    (header.uVersion != StencilCacheVersion) ||
+	    (header.uByteOrderMark != StencilCacheByteOrderMark) ||
+	    (header.uMeshHash != m_uMeshHash) ||
+	    (header.nFaces != m_nFaces) ||
+	    (header.nOrder != m_nOrder) ||
+	    (header.nCoefficients != m_nCoefficients) ||
+	    (header.nRequiredFaceSetSize != m_nRequiredFaceSetSize) ||
+	    (header.nQuadraturePoints != m_nQuadraturePoints) ||
+	    (header.nTruncation != StencilCacheTruncation)
+	) {
+		fclose(fp);
+		return false;
+	}
+
+	const size_t sAdjFaces = header.nAdjFaces;
+
+	m_vecAdjBegin.resize(m_nFaces+1);
+	m_vecAdjFace.resize(sAdjFaces);
+	m_vecAdjDistance.resize(sAdjFaces);
+	m_vecFitMoments.resize(sAdjFaces * m_nCoefficients);
+
+	bool fSuccess =
+		(fread(&(m_vecAdjBegin[0]), sizeof(int), m_nFaces+1, fp)
+			== static_cast<size_t>(m_nFaces+1));
+
+	if (fSuccess && (sAdjFaces != 0)) {
+		fSuccess =
+			(fread(&(m_vecAdjFace[0]), sizeof(int), sAdjFaces, fp)
+				== sAdjFaces) &&
+			(fread(&(m_vecAdjDistance[0]), sizeof(int), sAdjFaces, fp)
+				== sAdjFaces) &&
+			(fread(&(m_vecFitMoments[0]), sizeof(double), m_vecFitMoments.size(), fp)
+				== m_vecFitMoments.size());
+	}
+
+	fclose(fp);
+
+	// Verify offsets are consistent with the stencil arrays
+	if (fSuccess) {
+		fSuccess = (m_vecAdjBegin[0] == 0)
+			&& (static_cast<size_t>(m_vecAdjBegin[m_nFaces]) == sAdjFaces);
+
+		for (int i = 0; fSuccess && (i < m_nFaces); i++) {
+			fSuccess = (m_vecAdjBegin[i] <= m_vecAdjBegin[i+1]);
+		}
+		for (size_t i = 0; fSuccess && (i < sAdjFaces); i++) {
+			fSuccess = (m_vecAdjFace[i] >= 0) && (m_vecAdjFace[i] < m_nFaces);
+		}
+	}
+
+	if (!fSuccess) {
+		Announce("WARNING: Stencil cache file \"%s\" is corrupt; rebuilding",
+			strFile.c_str());
+		m_vecAdjBegin.clear();
+		m_vecAdjFace.clear();
+		m_vecAdjDistance.clear();
+		m_vecFitMoments.clear();
+	}
+
+	return fSuccess;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void FiniteVolumeStencilCache::Write(
+	const std::string & strFile
+) const {
+	FILE * fp = fopen(strFile.c_str(), "wb");
+	if (fp == NULL) {
+		_EXCEPTION1("Unable to open stencil cache file \"%s\"",
+			strFile.c_str());
+	}
+
+	StencilCacheHeader header;
+	memset(&header, 0, sizeof(StencilCacheHeader));
+	memcpy(header.szMagic, StencilCacheMagic, sizeof(StencilCacheMagic));
+	header.uVersion = StencilCacheVersion;
+	header.uByteOrderMark = StencilCacheByteOrderMark;
+	header.uMeshHash = m_uMeshHash;
+	header.nFaces = m_nFaces;
+	header.nOrder = m_nOrder;
+	header.nCoefficients = m_nCoefficients;
+	header.nRequiredFaceSetSize = m_nRequiredFaceSetSize;
+	header.nQuadraturePoints = m_nQuadraturePoints;
+	header.nTruncation = StencilCacheTruncation;
+	header.nAdjFaces = m_vecAdjFace.size();
+
+	const size_t sAdjFaces = m_vecAdjFace.size();
+
+	bool fSuccess =
+		(fwrite(&header, sizeof(StencilCacheHeader), 1, fp) == 1) &&
+		(fwrite(&(m_vecAdjBegin[0]), sizeof(int), m_vecAdjBegin.size(), fp)
+			== m_vecAdjBegin.size());
+
+	if (fSuccess && (sAdjFaces != 0)) {
+		fSuccess =
+			(fwrite(&(m_vecAdjFace[0]), sizeof(int), sAdjFaces, fp)
+				== sAdjFaces) &&
+			(fwrite(&(m_vecAdjDistance[0]), sizeof(int), sAdjFaces, fp)
+				== sAdjFaces) &&
+			(fwrite(&(m_vecFitMoments[0]), sizeof(double), m_vecFitMoments.size(), fp)
+				== m_vecFitMoments.size());
+	}
+
+	if ((fclose(fp) != 0) || (!fSuccess)) {
+		remove(strFile.c_str());
+		_EXCEPTION1("Error writing stencil cache file \"%s\"",
+			strFile.c_str());
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+std::string FiniteVolumeStencilCache::GetCacheFileName() const {
+	char szFile[64];
+	snprintf(szFile, sizeof(szFile), "fvstencil_%016llx_np%i_n%i.dat",
+		static_cast<unsigned long long>(m_uMeshHash),
+		m_nOrder,
+		m_nRequiredFaceSetSize);
+
+	std::string strFile = m_strCacheDir;
+	if ((strFile.length() != 0) && (strFile[strFile.length()-1] != '/')) {
+		strFile += "/";
+	}
+	return (strFile + szFile);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
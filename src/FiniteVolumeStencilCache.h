@@ -0,0 +1,183 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    FiniteVolumeStencilCache.h
+///	\author  Paul Ullrich
+///	\version October 14, 2026
+///
+///	<remarks>
+///		Copyright 2026 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#ifndef _FINITEVOLUMESTENCILCACHE_H_
+#define _FINITEVOLUMESTENCILCACHE_H_
+
+#include "FiniteVolumeTools.h"
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A cache of the reconstruction stencils of a finite volume source
+///		mesh, consisting of the adjacent Faces and fit moments of every Face.
+///		These depend only on the geometry of the source mesh and the order
+///		of the reconstruction, so they can be shared among maps to different
+///		target meshes.  If a cache directory is given the stencils are read
+///		from, or written to, a file in that directory named by the mesh hash
+///		and order.
+///	</summary>
+class FiniteVolumeStencilCache {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	FiniteVolumeStencilCache(
+		const std::string & strCacheDir = ""
+	) :
+		m_strCacheDir(strCacheDir),
+		m_uMeshHash(0),
+		m_nFaces(0),
+		m_nOrder(0),
+		m_nCoefficients(0),
+		m_nRequiredFaceSetSize(0),
+		m_nQuadraturePoints(0)
+	{ }
+
+public:
+	///	<summary>
+	///		Calculate a hash of the node coordinates and Face connectivity
+	///		of a Mesh.
+	///	</summary>
+	static uint64_t CalculateMeshHash(
+		const Mesh & mesh
+	);
+
+	///	<summary>
+	///		Ensure the cache holds the stencils of the given Mesh and order.
+	///		Stencils already in memory are reused, then stencils are read from
+	///		the cache directory, and otherwise they are built and written to
+	///		the cache directory.
+	///	</summary>
+	void Prepare(
+		const Mesh & mesh,
+		const TriangularQuadratureRule & triquadrule,
+		int nOrder,
+		int nRequiredFaceSetSize
+	);
+
+	///	<summary>
+	///		Get the adjacent Faces of a Face.
+	///	</summary>
+	void GetAdjacentFaces(
+		int ixFace,
+		AdjacentFaceVector & vecAdjFaces
+	) const;
+
+	///	<summary>
+	///		Get the fit moments of a Face, as computed by BuildFitMoments().
+	///	</summary>
+	void GetFitMoments(
+		int ixFace,
+		DataArray2D<double> & dFitMoments
+	) const;
+
+protected:
+	///	<summary>
+	///		Build the stencils of every Face of a Mesh.
+	///	</summary>
+	void Build(
+		const Mesh & mesh,
+		const TriangularQuadratureRule & triquadrule
+	);
+
+	///	<summary>
+	///		Read the stencils from a file.  Returns false if the file does not
+	///		exist or was written for a different mesh or order.
+	///	</summary>
+	bool Read(
+		const std::string & strFile
+	);
+
+	///	<summary>
+	///		Write the stencils to a file.
+	///	</summary>
+	void Write(
+		const std::string & strFile
+	) const;
+
+	///	<summary>
+	///		Name of the cache file for the current key.
+	///	</summary>
+	std::string GetCacheFileName() const;
+
+protected:
+	///	<summary>
+	///		Directory containing cache files, or empty to cache in memory only.
+	///	</summary>
+	std::string m_strCacheDir;
+
+	///	<summary>
+	///		Hash of the source mesh.
+	///	</summary>
+	uint64_t m_uMeshHash;
+
+	///	<summary>
+	///		Number of Faces in the source mesh.
+	///	</summary>
+	int m_nFaces;
+
+	///	<summary>
+	///		Order of the reconstruction.
+	///	</summary>
+	int m_nOrder;
+
+	///	<summary>
+	///		Number of coefficients of the reconstruction.
+	///	</summary>
+	int m_nCoefficients;
+
+	///	<summary>
+	///		Required number of adjacent Faces.
+	///	</summary>
+	int m_nRequiredFaceSetSize;
+
+	///	<summary>
+	///		Number of points in the triangular quadrature rule.
+	///	</summary>
+	int m_nQuadraturePoints;
+
+	///	<summary>
+	///		Offset of the first adjacent Face of each Face.
+	///	</summary>
+	std::vector<int> m_vecAdjBegin;
+
+	///	<summary>
+	///		Indices of adjacent Faces.
+	///	</summary>
+	std::vector<int> m_vecAdjFace;
+
+	///	<summary>
+	///		Distance metric of adjacent Faces.
+	///	</summary>
+	std::vector<int> m_vecAdjDistance;
+
+	///	<summary>
+	///		Fit moments of each Face, stored contiguously as a
+	///		(coefficient, adjacent Face) array.
+	///	</summary>
+	std::vector<double> m_vecFitMoments;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif
+
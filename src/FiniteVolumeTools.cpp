@@ -20,6 +20,7 @@
 #include "Announce.h"
 #include "Exception.h"
 #include "CoordTransforms.h"
+#include "SmallMatrixSolve.h"
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -278,10 +279,11 @@ void GetAdjacentFaceVectorByNode(
 		std::set<int>::const_iterator iterNode = setPerimeterNodesOld.begin();
 
 		for (; iterNode != setPerimeterNodesOld.end(); iterNode++) {
-			const std::set<int> & setAdjFaces =
+			const ReverseNodeArray::FaceRange setAdjFaces =
 				mesh.revnodearray[*iterNode];
 
-			std::set<int>::const_iterator iterFace = setAdjFaces.begin();
+			ReverseNodeArray::FaceRange::const_iterator iterFace =
+				setAdjFaces.begin();
 			for (; iterFace != setAdjFaces.end(); iterFace++) {
 
 				// Verify this Face has not already been added
@@ -310,31 +312,44 @@ void GetAdjacentFaceVectorByNode(
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void BuildIntegrationArray(
+///	<summary>
+///		Implementation of BuildIntegrationArray().  If Order is positive it
+///		replaces nOrder, so the loops over coefficients have fixed bounds
+///		and can be fully unrolled; otherwise nOrder is used.
+///	</summary>
+template <int Order>
+static void BuildIntegrationArrayImpl(
 	const Mesh & meshInput,
 	const Mesh & meshOverlap,
 	const TriangularQuadratureRule & triquadrule,
 	int ixFirstFace,
 	int ixOverlapBegin,
 	int ixOverlapEnd,
-	int nOrder,
-	DataArray2D<double> & dIntArray
+	int nOrderIn,
+	DataArray2D<double> & dIntArray,
+	double dQuadratureTolerance
 ) {
+	// Order of the reconstruction
+	const int nOrder = (Order > 0) ? Order : nOrderIn;
+
 	// Number of coefficients needed at this order
 #ifdef RECTANGULAR_TRUNCATION
-	int nCoefficients = nOrder * nOrder;
+	const int nCoefficients = nOrder * nOrder;
 #endif
 #ifdef TRIANGULAR_TRUNCATION
-	int nCoefficients = nOrder * (nOrder + 1) / 2;
+	const int nCoefficients = nOrder * (nOrder + 1) / 2;
 #endif
 
-	// Triangular quadrature rule
-	const DataArray2D<double> & dG = triquadrule.GetG();
-	const DataArray1D<double> & dW = triquadrule.GetW();
+	// Triangular quadrature rules, selected on each overlap triangle
+	AdaptiveTriangularQuadratureRule triquadadapt(
+		triquadrule, dQuadratureTolerance);
 
 	// This Face
 	const Face & faceFirst = meshInput.faces[ixFirstFace];
 
+	const double dFirstArea =
+		(dQuadratureTolerance > 0.0)?(meshInput.vecFaceArea[ixFirstFace]):(0.0);
+
 	// Coordinate axes
 	Node nodeRef = GetFaceCentroid(faceFirst, meshInput.nodes);
 
@@ -348,14 +363,16 @@ void BuildIntegrationArray(
 	Node nodeC = CrossProduct(nodeA1, nodeA2);
 #endif
 
-	// Fit matrix
-	DataArray2D<double> dFit(3,3);
+	// Fit matrix, with the basis vectors stored as columns
+	const double dFit[9] = {
+		nodeA1.x, nodeA1.y, nodeA1.z,
+		nodeA2.x, nodeA2.y, nodeA2.z,
+		nodeC.x,  nodeC.y,  nodeC.z
+	};
 
-	dFit(0,0) = nodeA1.x; dFit(0,1) = nodeA1.y; dFit(0,2) = nodeA1.z;
-	dFit(1,0) = nodeA2.x; dFit(1,1) = nodeA2.y; dFit(1,2) = nodeA2.z;
-	dFit(2,0) = nodeC.x;  dFit(2,1) = nodeC.y;  dFit(2,2) = nodeC.z;
-
-	DataArray2D<double> dFitTemp;
+	// Factor the fit matrix once for all quadrature points
+	SmallLUSolver<3> lusolveFit;
+	lusolveFit.Factor(dFit);
 
 	// Number of overlapping faces and triangles
 	int nOverlapFaces = ixOverlapEnd - ixOverlapBegin;
@@ -365,47 +382,24 @@ void BuildIntegrationArray(
 
 	// Loop through all overlap Faces
 	for (int i = 0; i < nOverlapFaces; i++) {
-		const Face &faceOverlap = meshOverlap.faces[ixOverlapBegin + i];
-
-		const NodeVector &nodesOverlap = meshOverlap.nodes;
-
-		int nbEdges = faceOverlap.edges.size();
-		int nOverlapTriangles = 1;
-		Node nodeCenter; // not used if nbEdges == 3
-		if (nbEdges > 3) { // decompose from center in this case
-			nOverlapTriangles = nbEdges;
-			for (int k = 0; k < nbEdges; k++) {
-				const Node & currNode = nodesOverlap[faceOverlap[k]];
-				nodeCenter = nodeCenter + currNode;
-			}
-			nodeCenter = nodeCenter / nbEdges;
-			double dMagni = sqrt(
-					nodeCenter.x * nodeCenter.x + nodeCenter.y * nodeCenter.y
-							+ nodeCenter.z * nodeCenter.z);
-			nodeCenter = nodeCenter / dMagni; // project back on sphere of radius 1
-		}
+		MeshFaceTriangles triangles(meshOverlap, ixOverlapBegin + i);
 
 		Node node0, node1, node2;
 		double dTriArea;
 
 		// Loop over all sub-triangles of this Overlap Face
-		for (int j = 0; j < nOverlapTriangles; j++) {
+		for (int j = 0; j < triangles.size(); j++) {
+			triangles.GetTriangle(j, node0, node1, node2);
+			dTriArea = triangles.GetArea(j, node0, node1, node2);
 
-			if (nbEdges == 3) {
-				node0 = nodesOverlap[faceOverlap[0]];
-				node1 = nodesOverlap[faceOverlap[1]];
-				node2 = nodesOverlap[faceOverlap[2]];
-			}
-			else { // decompose polygon in triangles around the center
-				node0 = nodeCenter;
-				node1 = nodesOverlap[faceOverlap[j]];
-				int j1 = (j + 1) % nbEdges;
-				node2 = nodesOverlap[faceOverlap[j1]];
-			}
-			dTriArea = CalculateTriangleAreaQuadratureMethod(node0, node1,
-					node2);
+			const TriangularQuadratureRule & triquadruleTri =
+				triquadadapt.GetRule(triquadadapt.SelectRule(
+					node0, node1, node2, dTriArea, dFirstArea));
 
-			for (int k = 0; k < triquadrule.GetPoints(); k++) {
+			const DataArray2D<double> & dG = triquadruleTri.GetG();
+			const DataArray1D<double> & dW = triquadruleTri.GetW();
+
+			for (int k = 0; k < triquadruleTri.GetPoints(); k++) {
 
 				// Get the nodal location of this point
 				double dX[3];
@@ -426,16 +420,7 @@ void BuildIntegrationArray(
 				dX[2] -= nodeRef.z;
 
 				// Find the coefficients for this point
-				int n = 3;
-				int nrhs = 1;
-				int lda = 3;
-				int ipiv[3];
-				int ldb = 3;
-				int info;
-
-				dFitTemp = dFit;
-				dgesv_(
-					&n, &nrhs, &(dFitTemp(0,0)), &lda, ipiv, dX, &ldb, &info);
+				lusolveFit.Solve(dX);
 
 				// Sample this point
 				int ixp = 0;
@@ -464,35 +449,101 @@ void BuildIntegrationArray(
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void BuildFitArray(
+///	<summary>
+///		Signature of BuildIntegrationArrayImpl().
+///	</summary>
+typedef void (*BuildIntegrationArrayKernel)(
+	const Mesh &,
+	const Mesh &,
+	const TriangularQuadratureRule &,
+	int,
+	int,
+	int,
+	int,
+	DataArray2D<double> &,
+	double
+);
+
+///	<summary>
+///		Kernels of BuildIntegrationArray() specialized for each order up to
+///		FiniteVolumeMaxSpecializedOrder, with the general kernel at index 0.
+///	</summary>
+static const BuildIntegrationArrayKernel
+	BuildIntegrationArrayKernels[FiniteVolumeMaxSpecializedOrder + 1] =
+{
+	&BuildIntegrationArrayImpl<0>,
+	&BuildIntegrationArrayImpl<1>,
+	&BuildIntegrationArrayImpl<2>,
+	&BuildIntegrationArrayImpl<3>,
+	&BuildIntegrationArrayImpl<4>
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+void BuildIntegrationArray(
+	const Mesh & meshInput,
+	const Mesh & meshOverlap,
+	const TriangularQuadratureRule & triquadrule,
+	int ixFirstFace,
+	int ixOverlapBegin,
+	int ixOverlapEnd,
+	int nOrder,
+	DataArray2D<double> & dIntArray,
+	double dQuadratureTolerance
+) {
+	int iKernel = 0;
+	if ((nOrder > 0) && (nOrder <= FiniteVolumeMaxSpecializedOrder)) {
+		iKernel = nOrder;
+	}
+
+	(*BuildIntegrationArrayKernels[iKernel])(
+		meshInput,
+		meshOverlap,
+		triquadrule,
+		ixFirstFace,
+		ixOverlapBegin,
+		ixOverlapEnd,
+		nOrder,
+		dIntArray,
+		dQuadratureTolerance);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Implementation of BuildFitMoments().  If Order is positive it
+///		replaces nOrder, so the loops over coefficients have fixed bounds
+///		and can be fully unrolled; otherwise nOrder is used.
+///	</summary>
+template <int Order>
+static void BuildFitMomentsImpl(
 	const Mesh & mesh,
 	const TriangularQuadratureRule & triquadrule,
 	int ixFirst,
 	const AdjacentFaceVector & vecAdjFaces,
-	int nOrder,
-	int nFitWeightsExponent,
-	const DataArray1D<double> & dConstraint,
-	DataArray2D<double> & dFitArray,
-	DataArray1D<double> & dFitWeights
+	int nOrderIn,
+	DataArray2D<double> & dFitMoments
 ) {
 
 	// Reference to active Face
 	const Face & faceFirst = mesh.faces[ixFirst];
 
+	// Order of the reconstruction
+	const int nOrder = (Order > 0) ? Order : nOrderIn;
+
 	// Number of coefficients needed at this order
 #ifdef RECTANGULAR_TRUNCATION
-	int nCoefficients = nOrder * nOrder;
+	const int nCoefficients = nOrder * nOrder;
 #endif
 #ifdef TRIANGULAR_TRUNCATION 
-	int nCoefficients = nOrder * (nOrder + 1) / 2;
+	const int nCoefficients = nOrder * (nOrder + 1) / 2;
 #endif
 
 	// Number of adjacent Faces
 	int nAdjFaces = vecAdjFaces.size();
 
-	// Initialize arrays,
-	dFitArray.Allocate(nCoefficients, nAdjFaces);
-	dFitWeights.Allocate(nAdjFaces);
+	// Initialize arrays
+	dFitMoments.Allocate(nCoefficients, nAdjFaces);
 
 	// Triangular quadrature rule
 	const DataArray2D<double> & dG = triquadrule.GetG();
@@ -511,12 +562,21 @@ void BuildFitArray(
 	Node nodeC = CrossProduct(nodeA1, nodeA2);
 #endif
 
-	// Fit matrix
-	DataArray2D<double> dFit(3,3);
+	// Fit matrix, with the basis vectors stored as columns
+	const double dFit[9] = {
+		nodeA1.x, nodeA1.y, nodeA1.z,
+		nodeA2.x, nodeA2.y, nodeA2.z,
+		nodeC.x,  nodeC.y,  nodeC.z
+	};
+
+	// Factor the fit matrix once for all quadrature points
+	SmallLUSolver<3> lusolveFit;
+	if (!lusolveFit.Factor(dFit)) {
+		_EXCEPTIONT("Singular fit matrix");
+	}
 
-	dFit(0,0) = nodeA1.x; dFit(0,1) = nodeA1.y; dFit(0,2) = nodeA1.z;
-	dFit(1,0) = nodeA2.x; dFit(1,1) = nodeA2.y; dFit(1,2) = nodeA2.z;
-	dFit(2,0) = nodeC.x;  dFit(2,1) = nodeC.y;  dFit(2,2) = nodeC.z;
+	// Sub-triangle of an adjacent Face
+	Face faceTri(3);
 
 	// Loop through all adjacent Faces
 	for (int iAdjFace = 0; iAdjFace < vecAdjFaces.size(); iAdjFace++) {
@@ -525,9 +585,6 @@ void BuildFitArray(
 
 		const Face & faceAdj = mesh.faces[fdp.first];
 
-		// Adjacent face area
-		double dAdjFaceArea = mesh.vecFaceArea[fdp.first];
-
 		// Loop through all sub-triangles
 		for (int j = 0; j < faceAdj.edges.size()-2; j++) {
 
@@ -536,7 +593,6 @@ void BuildFitArray(
 			const Node & node2 = mesh.nodes[faceAdj[j+2]];
 
 			// Calculate sub-triangular area
-			Face faceTri(3);
 			faceTri.SetNode(0, faceAdj[0]);
 			faceTri.SetNode(1, faceAdj[j+1]);
 			faceTri.SetNode(2, faceAdj[j+2]);
@@ -565,22 +621,7 @@ void BuildFitArray(
 				dX[2] -= nodeRef.z;
 
 				// Find the coefficients for this point
-				int n = 3;
-				int nrhs = 1;
-				int lda = 3;
-				int ipiv[9];
-				int ldb = 3;
-				int info;
-
-//#pragma message "Pre-triangularize this matrix for efficiency"
-				DataArray2D<double> dFitTemp;
-				dFitTemp = dFit;
-				dgesv_(
-					&n, &nrhs, &(dFitTemp(0,0)), &lda, ipiv, dX, &ldb, &info);
-
-				if (info != 0) {
-					_EXCEPTIONT("Solve failure in dgesv");
-				}
+				lusolveFit.Solve(dX);
 
 				// Loop through all coefficients
 				int ixp = 0;
@@ -593,24 +634,115 @@ void BuildFitArray(
 				for (int p = 0; p < nOrder; p++) {
 				for (int q = 0; q < nOrder - p; q++) {
 #endif
-					dFitArray(ixp,iAdjFace) +=
+					dFitMoments(ixp,iAdjFace) +=
 						  IPow(dX[0], p)
 						* IPow(dX[1], q)
 						* dW[k]
-						* dTriArea
-						/ dAdjFaceArea;
+						* dTriArea;
 
 					ixp++;
 				}
 				}
 			}
 		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Signature of BuildFitMomentsImpl().
+///	</summary>
+typedef void (*BuildFitMomentsKernel)(
+	const Mesh &,
+	const TriangularQuadratureRule &,
+	int,
+	const AdjacentFaceVector &,
+	int,
+	DataArray2D<double> &
+);
+
+///	<summary>
+///		Kernels of BuildFitMoments() specialized for each order up to
+///		FiniteVolumeMaxSpecializedOrder, with the general kernel at index 0.
+///	</summary>
+static const BuildFitMomentsKernel
+	BuildFitMomentsKernels[FiniteVolumeMaxSpecializedOrder + 1] =
+{
+	&BuildFitMomentsImpl<0>,
+	&BuildFitMomentsImpl<1>,
+	&BuildFitMomentsImpl<2>,
+	&BuildFitMomentsImpl<3>,
+	&BuildFitMomentsImpl<4>
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+void BuildFitMoments(
+	const Mesh & mesh,
+	const TriangularQuadratureRule & triquadrule,
+	int ixFirst,
+	const AdjacentFaceVector & vecAdjFaces,
+	int nOrder,
+	DataArray2D<double> & dFitMoments
+) {
+	int iKernel = 0;
+	if ((nOrder > 0) && (nOrder <= FiniteVolumeMaxSpecializedOrder)) {
+		iKernel = nOrder;
+	}
+
+	(*BuildFitMomentsKernels[iKernel])(
+		mesh,
+		triquadrule,
+		ixFirst,
+		vecAdjFaces,
+		nOrder,
+		dFitMoments);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void NormalizeFitArray(
+	const Mesh & mesh,
+	const AdjacentFaceVector & vecAdjFaces,
+	int nFitWeightsExponent,
+	const DataArray1D<double> & dConstraint,
+	const DataArray2D<double> & dFitMoments,
+	DataArray2D<double> & dFitArray,
+	DataArray1D<double> & dFitWeights
+) {
+	// Dimensions of the fit operator
+	int nCoefficients = dFitMoments.GetRows();
+	int nAdjFaces = vecAdjFaces.size();
+
+	if (dFitMoments.GetColumns() != nAdjFaces) {
+		_EXCEPTIONT("Dimension mismatch between dFitMoments and vecAdjFaces");
+	}
+
+	// Initialize arrays
+	dFitArray.Allocate(nCoefficients, nAdjFaces);
+	dFitWeights.Allocate(nAdjFaces);
+
+	// Loop through all adjacent Faces
+	for (int iAdjFace = 0; iAdjFace < nAdjFaces; iAdjFace++) {
+
+		const FaceDistancePair & fdp = vecAdjFaces[iAdjFace];
+
+		// Adjacent face area
+		double dAdjFaceArea = mesh.vecFaceArea[fdp.first];
 
 		// Integrate locally using the constraint
 		if ((dConstraint.GetRows() != 0) && (iAdjFace == 0)) {
 			for (int p = 0; p < nCoefficients; p++) {
 				dFitArray(p,0) = dConstraint[p];
 			}
+
+		// Area averages over the adjacent Face
+		} else {
+			for (int p = 0; p < nCoefficients; p++) {
+				dFitArray(p,iAdjFace) =
+					dFitMoments(p,iAdjFace) / dAdjFaceArea;
+			}
 		}
 
 		// Reweight the fit array
@@ -618,7 +750,7 @@ void BuildFitArray(
 			pow(static_cast<double>(fdp.second),
 			    - static_cast<double>(nFitWeightsExponent));
 
-		for (int j = 0; j < dFitArray.GetRows(); j++) {
+		for (int j = 0; j < nCoefficients; j++) {
 			dFitArray(j,iAdjFace) *= dFitWeights[iAdjFace];
 		}
 	}
@@ -626,6 +758,39 @@ void BuildFitArray(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void BuildFitArray(
+	const Mesh & mesh,
+	const TriangularQuadratureRule & triquadrule,
+	int ixFirst,
+	const AdjacentFaceVector & vecAdjFaces,
+	int nOrder,
+	int nFitWeightsExponent,
+	const DataArray1D<double> & dConstraint,
+	DataArray2D<double> & dFitArray,
+	DataArray1D<double> & dFitWeights
+) {
+	DataArray2D<double> dFitMoments;
+
+	BuildFitMoments(
+		mesh,
+		triquadrule,
+		ixFirst,
+		vecAdjFaces,
+		nOrder,
+		dFitMoments);
+
+	NormalizeFitArray(
+		mesh,
+		vecAdjFaces,
+		nFitWeightsExponent,
+		dConstraint,
+		dFitMoments,
+		dFitArray,
+		dFitWeights);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 bool InvertFitArray_Corrected(
 	const DataArray1D<double> & dConstraint,
 	DataArray2D<double> & dFitArray,
@@ -131,7 +131,9 @@ void GetAdjacentFaceVectorByNode(
 ///	<summary>
 ///		Build the integration array, an operator that integrates a polynomial
 ///		reconstruction (specified as a vector of polynomial coefficients) to
-///		the integral over all overlap faces.
+///		the integral over all overlap faces.  If dQuadratureTolerance is
+///		positive, overlap triangles are integrated with the lowest order
+///		rule (up to the order of triquadrule) within this tolerance.
 ///	</summary>
 void BuildIntegrationArray(
 	const Mesh & meshInput,
@@ -141,7 +143,40 @@ void BuildIntegrationArray(
 	int ixOverlapBegin,
 	int ixOverlapEnd,
 	int nOrder,
-	DataArray2D<double> & dIntArray
+	DataArray2D<double> & dIntArray,
+	double dQuadratureTolerance = 0.0
+);
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Build the fit moments, the integrals of each monomial of the
+///		polynomial reconstruction over each Face in the AdjacentFaceVector.
+///		The moments depend only on the geometry of the mesh.
+///	</summary>
+void BuildFitMoments(
+	const Mesh & mesh,
+	const TriangularQuadratureRule & triquadrule,
+	int ixFirst,
+	const AdjacentFaceVector & vecAdjFaces,
+	int nOrder,
+	DataArray2D<double> & dFitMoments
+);
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Build the fit array from the fit moments by converting integrals to
+///		area averages, applying the constraint and reweighting.
+///	</summary>
+void NormalizeFitArray(
+	const Mesh & mesh,
+	const AdjacentFaceVector & vecAdjFaces,
+	int nFitWeightsExponent,
+	const DataArray1D<double> & dConstraint,
+	const DataArray2D<double> & dFitMoments,
+	DataArray2D<double> & dFitArray,
+	DataArray1D<double> & dFitWeights
 );
 
 ///////////////////////////////////////////////////////////////////////////////
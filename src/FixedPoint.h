@@ -77,7 +77,9 @@ public:
 		for (int i = 0; i < Digits; i++) {
 			nCarryover = m_vecDigits[i] / MaximumDigit;
 			m_vecDigits[i] = m_vecDigits[i] % MaximumDigit;
-			m_vecDigits[i+1] += nCarryover;
+			if (i + 1 < Digits) {
+				m_vecDigits[i+1] += nCarryover;
+			}
 		}
 		if (nCarryover != 0) {
 			_EXCEPTIONT("FixedPoint overflow");
@@ -404,6 +406,33 @@ public:
 	}
 
 public:
+	///	<summary>
+	///		Convert a number that occupies only the first digit, such as any
+	///		number set from a double, to a double approximating its value
+	///		multiplied by MaximumDigit with relative error of at most 2^-53.
+	///		Returns false if the number occupies more than one digit.
+	///	</summary>
+	inline bool ToScaledReal(double & d) const {
+		if (m_iSign == 0) {
+			d = 0.0;
+			return true;
+		}
+		if (m_iDecimal != 1) {
+			return false;
+		}
+		for (int i = 1; i < Digits; i++) {
+			if (m_vecDigits[i] != 0) {
+				return false;
+			}
+		}
+
+		d = static_cast<double>(m_vecDigits[0]);
+		if (m_iSign < 0) {
+			d = -d;
+		}
+		return true;
+	}
+
 	///	<summary>
 	///		Convert this number to a double.
 	///	</summary>
@@ -22,6 +22,92 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		Tabulated Gauss-Lobatto quadrature points on [-1,1], indexed by
+///		the number of points.
+///	</summary>
+static constexpr double GaussLobattoQuadratureTableG
+	[GaussLobattoQuadrature::MaxTabulatedCount+1]
+	[GaussLobattoQuadrature::MaxTabulatedCount] =
+{
+	{},
+	{},
+	// 2 points
+	{-1.0, +1.0},
+	// 3 points
+	{-1.0,  0.0, +1.0},
+	// 4 points
+	{-1.0, -0.447213595499958, +0.447213595499958,
+	 +1.0},
+	// 5 points
+	{-1.0, -0.654653670707977,  0.0,
+	 +0.654653670707977, +1.0},
+	// 6 points
+	{-1.0, -0.765055323929465, -0.285231516480645,
+	 +0.285231516480645, +0.765055323929465, +1.0},
+	// 7 points
+	{-1.0, -0.830223896278567, -0.468848793470714,
+	  0.0, +0.468848793470714, +0.830223896278567,
+	 +1.0},
+	// 8 points
+	{-1.0, -0.871740148509607, -0.591700181433142,
+	 -0.209299217902479, +0.209299217902479, +0.591700181433142,
+	 +0.871740148509607, +1.0},
+	// 9 points
+	{-1.0, -0.899757995411460, -0.677186279510738,
+	 -0.363117463826178,  0.0, +0.363117463826178,
+	 +0.677186279510738, +0.899757995411460, +1.0},
+	// 10 points
+	{-1.0, -0.919533908166459, -0.738773865105505,
+	 -0.477924949810444, -0.165278957666387, +0.165278957666387,
+	 +0.477924949810444, +0.738773865105505, +0.919533908166459,
+	 +1.0}
+};
+
+///	<summary>
+///		Tabulated Gauss-Lobatto quadrature weights on [-1,1], indexed by
+///		the number of points.
+///	</summary>
+static constexpr double GaussLobattoQuadratureTableW
+	[GaussLobattoQuadrature::MaxTabulatedCount+1]
+	[GaussLobattoQuadrature::MaxTabulatedCount] =
+{
+	{},
+	{},
+	// 2 points
+	{+1.0, +1.0},
+	// 3 points
+	{+0.333333333333333, +1.333333333333334, +0.333333333333333},
+	// 4 points
+	{+0.166666666666667, +0.833333333333333, +0.833333333333333,
+	 +0.166666666666667},
+	// 5 points
+	{+0.100000000000000, +0.544444444444445, +0.711111111111110,
+	 +0.544444444444445, +0.100000000000000},
+	// 6 points
+	{+0.066666666666667, +0.378474956297847, +0.554858377035486,
+	 +0.554858377035486, +0.378474956297847, +0.066666666666667},
+	// 7 points
+	{+0.047619047619048, +0.276826047361566, +0.431745381209862,
+	 +0.487619047619048, +0.431745381209862, +0.276826047361566,
+	 +0.047619047619048},
+	// 8 points
+	{+0.035714285714286, +0.210704227143506, +0.341122692483505,
+	 +0.412458794658703, +0.412458794658703, +0.341122692483505,
+	 +0.210704227143506, +0.035714285714286},
+	// 9 points
+	{+0.027777777777778, +0.165495361560806, +0.274538712500162,
+	 +0.346428510973046, +0.371519274376417, +0.346428510973046,
+	 +0.274538712500162, +0.165495361560806, +0.027777777777778},
+	// 10 points
+	{+0.022222222222222, +0.133305990851070, +0.224889342063126,
+	 +0.292042683679684, +0.327539761183897, +0.327539761183897,
+	 +0.292042683679684, +0.224889342063126, +0.133305990851070,
+	 +0.022222222222222}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
 void GaussLobattoQuadrature::GetPoints(
 	int nCount,
 	DataArray1D<double> & dG,
@@ -36,149 +122,12 @@ void GaussLobattoQuadrature::GetPoints(
 	dG.Allocate(nCount);
 	dW.Allocate(nCount);
 
-	// Degree 2
-	if (nCount == 2) {
-		dG[0] = -1.0;
-		dG[1] = +1.0;
-
-		dW[0] = +1.0;
-		dW[1] = +1.0;
-
-	// Degree 3
-	} else if (nCount == 3) {
-		dG[0] = -1.0;
-		dG[1] =  0.0;
-		dG[2] = +1.0;
-
-		dW[0] = +0.333333333333333;
-		dW[1] = +1.333333333333334;
-		dW[2] = +0.333333333333333;
-
-	// Degree 4
-	} else if (nCount == 4) {
-		dG[0] = -1.0;
-		dG[1] = -0.447213595499958;
-		dG[2] = +0.447213595499958;
-		dG[3] = +1.0;
-
-		dW[0] = 0.166666666666667;
-		dW[1] = 0.833333333333333;
-		dW[2] = 0.833333333333333;
-		dW[3] = 0.166666666666667;
-
-	// Degree 5
-	} else if (nCount == 5) {
-		dG[0] = -1.0;
-		dG[1] = -0.654653670707977;
-		dG[2] =  0.0;
-		dG[3] = +0.654653670707977;
-		dG[4] = +1.0;
-
-		dW[0] = 0.100000000000000;
-		dW[1] = 0.544444444444445;
-		dW[2] = 0.711111111111110;
-		dW[3] = 0.544444444444445;
-		dW[4] = 0.100000000000000;
-
-	// Degree 6
-	} else if (nCount == 6) {
-		dG[0] = -1.0;
-		dG[1] = -0.765055323929465;
-		dG[2] = -0.285231516480645;
-		dG[3] = +0.285231516480645;
-		dG[4] = +0.765055323929465;
-		dG[5] = +1.0;
-
-		dW[0] = 0.066666666666667;
-		dW[1] = 0.378474956297847;
-		dW[2] = 0.554858377035486;
-		dW[3] = 0.554858377035486;
-		dW[4] = 0.378474956297847;
-		dW[5] = 0.066666666666667;
-
-	// Degree 7
-	} else if (nCount == 7) {
-		dG[0] = -1.0;
-		dG[1] = -0.830223896278567;
-		dG[2] = -0.468848793470714;
-		dG[3] =  0.0;
-		dG[4] = +0.468848793470714;
-		dG[5] = +0.830223896278567;
-		dG[6] = +1.0;
-
-		dW[0] = 0.047619047619048;
-		dW[1] = 0.276826047361566;
-		dW[2] = 0.431745381209862;
-		dW[3] = 0.487619047619048;
-		dW[4] = 0.431745381209862;
-		dW[5] = 0.276826047361566;
-		dW[6] = 0.047619047619048;
-
-	// Degree 8
-	} else if (nCount == 8) {
-		dG[0] = -1.0;
-		dG[1] = -0.871740148509607;
-		dG[2] = -0.591700181433142;
-		dG[3] = -0.209299217902479;
-		dG[4] = +0.209299217902479;
-		dG[5] = +0.591700181433142;
-		dG[6] = +0.871740148509607;
-		dG[7] = +1.0;
-
-		dW[0] = 0.035714285714286;
-		dW[1] = 0.210704227143506;
-		dW[2] = 0.341122692483505;
-		dW[3] = 0.412458794658703;
-		dW[4] = 0.412458794658703;
-		dW[5] = 0.341122692483505;
-		dW[6] = 0.210704227143506;
-		dW[7] = 0.035714285714286;
-
-	// Degree 9
-	} else if (nCount == 9) {
-		dG[0] = -1.0;
-		dG[1] = -0.899757995411460;
-		dG[2] = -0.677186279510738;
-		dG[3] = -0.363117463826178;
-		dG[4] =  0.0;
-		dG[5] = +0.363117463826178;
-		dG[6] = +0.677186279510738;
-		dG[7] = +0.899757995411460;
-		dG[8] = +1.0;
-
-		dW[0] = 0.027777777777778;
-		dW[1] = 0.165495361560806;
-		dW[2] = 0.274538712500162;
-		dW[3] = 0.346428510973046;
-		dW[4] = 0.371519274376417;
-		dW[5] = 0.346428510973046;
-		dW[6] = 0.274538712500162;
-		dW[7] = 0.165495361560806;
-		dW[8] = 0.027777777777778;
-
-	// Degree 10
-	} else if (nCount == 10) {
-		dG[0] = -1.0;
-		dG[1] = -0.919533908166459;
-		dG[2] = -0.738773865105505;
-		dG[3] = -0.477924949810444;
-		dG[4] = -0.165278957666387;
-		dG[5] = +0.165278957666387;
-		dG[6] = +0.477924949810444;
-		dG[7] = +0.738773865105505;
-		dG[8] = +0.919533908166459;
-		dG[9] = +1.0;
-
-		dW[0] = 0.022222222222222;
-		dW[1] = 0.133305990851070;
-		dW[2] = 0.224889342063126;
-		dW[3] = 0.292042683679684;
-		dW[4] = 0.327539761183897;
-		dW[5] = 0.327539761183897;
-		dW[6] = 0.292042683679684;
-		dW[7] = 0.224889342063126;
-		dW[8] = 0.133305990851070;
-		dW[9] = 0.022222222222222;
+	// Tabulated degrees
+	if (nCount <= MaxTabulatedCount) {
+		for (int k = 0; k < nCount; k++) {
+			dG[k] = GaussLobattoQuadratureTableG[nCount][k];
+			dW[k] = GaussLobattoQuadratureTableW[nCount][k];
+		}
 
 	// Higher degrees
 	} else {
@@ -20,6 +20,94 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		Tabulated Gauss quadrature points on [-1,1], indexed by the number
+///		of points.
+///	</summary>
+static constexpr double GaussQuadratureTableG
+	[GaussQuadrature::MaxTabulatedCount+1]
+	[GaussQuadrature::MaxTabulatedCount] =
+{
+	{},
+	// 1 point
+	{ 0.0},
+	// 2 points
+	{-0.5773502691896257, +0.5773502691896257},
+	// 3 points
+	{-0.7745966692414834,  0.0, +0.7745966692414834},
+	// 4 points
+	{-0.8611363115940526, -0.3399810435848563, +0.3399810435848563,
+	 +0.8611363115940526},
+	// 5 points
+	{-0.9061798459386640, -0.5384693101056831,  0.0,
+	 +0.5384693101056831, +0.9061798459386640},
+	// 6 points
+	{-0.9324695142031521, -0.6612093864662645, -0.2386191860831969,
+	 +0.2386191860831969, +0.6612093864662645, +0.9324695142031521},
+	// 7 points
+	{-0.9491079123427585, -0.7415311855993945, -0.4058451513773972,
+	  0.0, +0.4058451513773972, +0.7415311855993945,
+	 +0.9491079123427585},
+	// 8 points
+	{-0.9602898564975363, -0.7966664774136267, -0.5255324099163290,
+	 -0.1834346424956498, +0.1834346424956498, +0.5255324099163290,
+	 +0.7966664774136267, +0.9602898564975363},
+	// 9 points
+	{-0.9681602395076261, -0.8360311073266359, -0.6133714327005905,
+	 -0.3242534234038089,  0.0, +0.3242534234038089,
+	 +0.6133714327005905, +0.8360311073266359, +0.9681602395076261},
+	// 10 points
+	{-0.9739065285171717, -0.8650633666889845, -0.6794095682990244,
+	 -0.4333953941292472, -0.1488743389816312, +0.1488743389816312,
+	 +0.4333953941292472, +0.6794095682990244, +0.8650633666889845,
+	 +0.9739065285171717}
+};
+
+///	<summary>
+///		Tabulated Gauss quadrature weights on [-1,1], indexed by the number
+///		of points.
+///	</summary>
+static constexpr double GaussQuadratureTableW
+	[GaussQuadrature::MaxTabulatedCount+1]
+	[GaussQuadrature::MaxTabulatedCount] =
+{
+	{},
+	// 1 point
+	{+2.0},
+	// 2 points
+	{+1.0, +1.0},
+	// 3 points
+	{+0.5555555555555556, +0.8888888888888888, +0.5555555555555556},
+	// 4 points
+	{+0.3478548451374538, +0.6521451548625461, +0.6521451548625461,
+	 +0.3478548451374538},
+	// 5 points
+	{+0.2369268850561891, +0.4786286704993665, +0.5688888888888889,
+	 +0.4786286704993665, +0.2369268850561891},
+	// 6 points
+	{+0.1713244923791704, +0.3607615730481386, +0.4679139345726910,
+	 +0.4679139345726910, +0.3607615730481386, +0.1713244923791704},
+	// 7 points
+	{+0.1294849661688697, +0.2797053914892766, +0.3818300505051189,
+	 +0.4179591836734694, +0.3818300505051189, +0.2797053914892766,
+	 +0.1294849661688697},
+	// 8 points
+	{+0.1012285362903763, +0.2223810344533745, +0.3137066458778873,
+	 +0.3626837833783620, +0.3626837833783620, +0.3137066458778873,
+	 +0.2223810344533745, +0.1012285362903763},
+	// 9 points
+	{+0.0812743883615744, +0.1806481606948574, +0.2606106964029354,
+	 +0.3123470770400029, +0.3302393550012598, +0.3123470770400029,
+	 +0.2606106964029354, +0.1806481606948574, +0.0812743883615744},
+	// 10 points
+	{+0.0666713443086881, +0.1494513491505806, +0.2190863625159820,
+	 +0.2692667193099963, +0.2955242247147529, +0.2955242247147529,
+	 +0.2692667193099963, +0.2190863625159820, +0.1494513491505806,
+	 +0.0666713443086881}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
 void GaussQuadrature::GetPoints(
 	int nCount,
 	DataArray1D<double> & dG,
@@ -34,154 +122,12 @@ void GaussQuadrature::GetPoints(
 	dG.Allocate(nCount);
 	dW.Allocate(nCount);
 
-	// Degree 1
-	if (nCount == 1) {
-		dG[0] =  0.0;
-		dW[0] = +2.0;
-
-	// Degree 2
-	} else if (nCount == 2) {
-		dG[0] = -0.5773502691896257;
-		dG[1] = +0.5773502691896257;
-
-		dW[0] = +1.0;
-		dW[1] = +1.0;
-
-	// Degree 3
-	} else if (nCount == 3) {
-		dG[0] = -0.7745966692414834;
-		dG[1] =  0.0;
-		dG[2] = +0.7745966692414834;
-
-		dW[0] = +0.5555555555555556;
-		dW[1] = +0.8888888888888888;
-		dW[2] = +0.5555555555555556;
-
-	// Degree 4
-	} else if (nCount == 4) {
-		dG[0] = -0.8611363115940526;
-		dG[1] = -0.3399810435848563;
-		dG[2] = +0.3399810435848563;
-		dG[3] = +0.8611363115940526;
-
-		dW[0] = 0.3478548451374538;
-		dW[1] = 0.6521451548625461;
-		dW[2] = 0.6521451548625461;
-		dW[3] = 0.3478548451374538;
-
-	// Degree 5
-	} else if (nCount == 5) {
-		dG[0] = -0.9061798459386640;
-		dG[1] = -0.5384693101056831;
-		dG[2] =  0.0;
-		dG[3] = +0.5384693101056831;
-		dG[4] = +0.9061798459386640;
-
-		dW[0] = 0.2369268850561891;
-		dW[1] = 0.4786286704993665;
-		dW[2] = 0.5688888888888889;
-		dW[3] = 0.4786286704993665;
-		dW[4] = 0.2369268850561891;
-
-	// Degree 6
-	} else if (nCount == 6) {
-		dG[0] = -0.9324695142031521;
-		dG[1] = -0.6612093864662645;
-		dG[2] = -0.2386191860831969;
-		dG[3] = +0.2386191860831969;
-		dG[4] = +0.6612093864662645;
-		dG[5] = +0.9324695142031521;
-
-		dW[0] = 0.1713244923791704;
-		dW[1] = 0.3607615730481386;
-		dW[2] = 0.4679139345726910;
-		dW[3] = 0.4679139345726910;
-		dW[4] = 0.3607615730481386;
-		dW[5] = 0.1713244923791704;
-
-	// Degree 7
-	} else if (nCount == 7) {
-		dG[0] = -0.9491079123427585;
-		dG[1] = -0.7415311855993945;
-		dG[2] = -0.4058451513773972;
-		dG[3] =  0.0;
-		dG[4] = +0.4058451513773972;
-		dG[5] = +0.7415311855993945;
-		dG[6] = +0.9491079123427585;
-
-		dW[0] = 0.1294849661688697;
-		dW[1] = 0.2797053914892766;
-		dW[2] = 0.3818300505051189;
-		dW[3] = 0.4179591836734694;
-		dW[4] = 0.3818300505051189;
-		dW[5] = 0.2797053914892766;
-		dW[6] = 0.1294849661688697;
-
-	// Degree 8
-	} else if (nCount == 8) {
-		dG[0] = -0.9602898564975363;
-		dG[1] = -0.7966664774136267;
-		dG[2] = -0.5255324099163290;
-		dG[3] = -0.1834346424956498;
-		dG[4] = +0.1834346424956498;
-		dG[5] = +0.5255324099163290;
-		dG[6] = +0.7966664774136267;
-		dG[7] = +0.9602898564975363;
-
-		dW[0] = 0.1012285362903763;
-		dW[1] = 0.2223810344533745;
-		dW[2] = 0.3137066458778873;
-		dW[3] = 0.3626837833783620;
-		dW[4] = 0.3626837833783620;
-		dW[5] = 0.3137066458778873;
-		dW[6] = 0.2223810344533745;
-		dW[7] = 0.1012285362903763;
-
-	// Degree 9
-	} else if (nCount == 9) {
-		dG[0] = -1.0;
-		dG[1] = -0.899757995411460;
-		dG[2] = -0.677186279510738;
-		dG[3] = -0.363117463826178;
-		dG[4] =  0.0;
-		dG[5] = +0.363117463826178;
-		dG[6] = +0.677186279510738;
-		dG[7] = +0.899757995411460;
-		dG[8] = +1.0;
-
-		dW[0] = 0.0812743883615744;
-		dW[1] = 0.1806481606948574;
-		dW[2] = 0.2606106964029354;
-		dW[3] = 0.3123470770400029;
-		dW[4] = 0.3302393550012598;
-		dW[5] = 0.3123470770400029;
-		dW[6] = 0.2606106964029354;
-		dW[7] = 0.1806481606948574;
-		dW[8] = 0.0812743883615744;
-
-	// Degree 10
-	} else if (nCount == 10) {
-		dG[0] = -0.9739065285171717;
-		dG[1] = -0.8650633666889845;
-		dG[2] = -0.6794095682990244;
-		dG[3] = -0.4333953941292472;
-		dG[4] = -0.1488743389816312;
-		dG[5] = +0.1488743389816312;
-		dG[6] = +0.4333953941292472;
-		dG[7] = +0.6794095682990244;
-		dG[8] = +0.8650633666889845;
-		dG[9] = +0.9739065285171717;
-
-		dW[0] = 0.0666713443086881;
-		dW[1] = 0.1494513491505806;
-		dW[2] = 0.2190863625159820;
-		dW[3] = 0.2692667193099963;
-		dW[4] = 0.2955242247147529;
-		dW[5] = 0.2955242247147529;
-		dW[6] = 0.2692667193099963;
-		dW[7] = 0.2190863625159820;
-		dW[8] = 0.1494513491505806;
-		dW[9] = 0.0666713443086881;
+	// Tabulated degrees
+	if (nCount <= MaxTabulatedCount) {
+		for (int k = 0; k < nCount; k++) {
+			dG[k] = GaussQuadratureTableG[nCount][k];
+			dW[k] = GaussQuadratureTableW[nCount][k];
+		}
 
 	// Higher degrees
 	} else {
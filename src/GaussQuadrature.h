@@ -26,6 +26,14 @@
 ///	</summary>
 class GaussQuadrature {
 
+public:
+	///	<summary>
+	///		Largest number of points with a compile-time table of points and
+	///		weights.  Rules with more points are computed from the roots
+	///		of the Legendre polynomials.
+	///	</summary>
+	static const int MaxTabulatedCount = 10;
+
 public:
 	///	<summary>
 	///		Return the Gauss-Lobatto quadrature points and their corresponding
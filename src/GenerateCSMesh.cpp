@@ -24,110 +24,288 @@
 
 #include <cmath>
 #include <iostream>
+#include <algorithm>
 
 ///////////////////////////////////////////////////////////////////////////////
 
-int InsertCSSubNode(
-	int ix0,
-	int ix1,
-	Real alpha,
-	NodeVector & nodes
-) {
-	Real dX = nodes[ix0].x + (nodes[ix1].x - nodes[ix0].x) * alpha;
-	Real dY = nodes[ix0].y + (nodes[ix1].y - nodes[ix0].y) * alpha;
-	Real dZ = nodes[ix0].z + (nodes[ix1].z - nodes[ix0].z) * alpha;
-
-	// Project to sphere
-	Real dRadius = sqrt(dX*dX + dY*dY + dZ*dZ);
+///	<summary>
+///		A closed-form numbering of the Nodes and Faces of an equiangular
+///		cubed-sphere mesh.  Nodes are numbered as the 8 cube corners, then
+///		the interior nodes of the 12 cube edges, then the interior nodes of
+///		each panel in row-major order.  Faces are numbered by panel and then
+///		row-major within each panel, so that any Node or Face can be
+///		generated independently of all others.
+///	</summary>
+class CSMeshIndexer {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	CSMeshIndexer(
+		int nResolution
+	) :
+		m_nResolution(nResolution),
+		m_nEdgeInterior(nResolution - 1)
+	{
+		Real dInvDeltaX = 1.0 / sqrt(3.0);
+
+		m_nodeCorner[0] = Node(+dInvDeltaX, -dInvDeltaX, -dInvDeltaX);
+		m_nodeCorner[1] = Node(+dInvDeltaX, +dInvDeltaX, -dInvDeltaX);
+		m_nodeCorner[2] = Node(-dInvDeltaX, +dInvDeltaX, -dInvDeltaX);
+		m_nodeCorner[3] = Node(-dInvDeltaX, -dInvDeltaX, -dInvDeltaX);
+		m_nodeCorner[4] = Node(+dInvDeltaX, -dInvDeltaX, +dInvDeltaX);
+		m_nodeCorner[5] = Node(+dInvDeltaX, +dInvDeltaX, +dInvDeltaX);
+		m_nodeCorner[6] = Node(-dInvDeltaX, +dInvDeltaX, +dInvDeltaX);
+		m_nodeCorner[7] = Node(-dInvDeltaX, -dInvDeltaX, +dInvDeltaX);
+	}
 
-	dX /= dRadius;
-	dY /= dRadius;
-	dZ /= dRadius;
+	///	<summary>
+	///		Total number of Nodes.
+	///	</summary>
+	int GetNodeCount() const {
+		return GetPanelNodeBegin(6);
+	}
 
-	// Index
-	int ix = nodes.size();
+	///	<summary>
+	///		Total number of Faces.
+	///	</summary>
+	int GetFaceCount() const {
+		return 6 * m_nResolution * m_nResolution;
+	}
 
-	// Insert node
-	nodes.push_back(Node(dX, dY, dZ));
+	///	<summary>
+	///		Number of corner and cube edge Nodes, which precede the panel
+	///		interior Nodes.
+	///	</summary>
+	int GetEdgeNodeCount() const {
+		return 8 + 12 * m_nEdgeInterior;
+	}
 
-	return ix;
-}
+	///	<summary>
+	///		Index of the first interior Node of the given panel.
+	///	</summary>
+	int GetPanelNodeBegin(int iPanel) const {
+		return GetEdgeNodeCount() + iPanel * m_nEdgeInterior * m_nEdgeInterior;
+	}
 
-///////////////////////////////////////////////////////////////////////////////
+	///	<summary>
+	///		Index of Node k along cube edge e.
+	///	</summary>
+	int GetEdgeNodeIndex(int e, int k, bool fFlip = false) const {
+		if (fFlip) {
+			k = m_nResolution - k;
+		}
+		if (k == 0) {
+			return CubeEdgeCorners[e][0];
+		}
+		if (k == m_nResolution) {
+			return CubeEdgeCorners[e][1];
+		}
+		return 8 + e * m_nEdgeInterior + (k - 1);
+	}
 
-void GenerateCSMultiEdgeVertices(
-	int nRefineLevel,
-	int ix0,
-	int ix1,
-	NodeVector & nodes,
-	MultiEdge & edge
-) {
-	edge.clear();
-	edge.push_back(ix0);
+	///	<summary>
+	///		Index of Node (i,j) of the given panel, where i and j are in
+	///		the range [0, nResolution].
+	///	</summary>
+	int GetPanelNodeIndex(int iPanel, int i, int j) const {
+		const int (&edges)[4][2] = PanelEdges[iPanel];
 
-	int i;
-	for (i = 1; i < nRefineLevel; i++) {
+		if (j == 0) {
+			return GetEdgeNodeIndex(edges[0][0], i, edges[0][1] != 0);
+		}
+		if (j == m_nResolution) {
+			return GetEdgeNodeIndex(edges[3][0], i, edges[3][1] != 0);
+		}
+		if (i == 0) {
+			return GetEdgeNodeIndex(edges[1][0], j, edges[1][1] != 0);
+		}
+		if (i == m_nResolution) {
+			return GetEdgeNodeIndex(edges[2][0], j, edges[2][1] != 0);
+		}
+		return GetPanelNodeBegin(iPanel)
+			+ (j - 1) * m_nEdgeInterior + (i - 1);
+	}
 
-		// Nodes along line in Cartesian geometry
-		Real alpha =
-			static_cast<Real>(i) / static_cast<Real>(nRefineLevel);
+	///	<summary>
+	///		Position of Node k along cube edge e.
+	///	</summary>
+	Node GetEdgeNode(int e, int k, bool fFlip = false) const {
+		if (fFlip) {
+			k = m_nResolution - k;
+		}
+		if (k == 0) {
+			return m_nodeCorner[CubeEdgeCorners[e][0]];
+		}
+		if (k == m_nResolution) {
+			return m_nodeCorner[CubeEdgeCorners[e][1]];
+		}
+		return InterpolateNode(
+			m_nodeCorner[CubeEdgeCorners[e][0]],
+			m_nodeCorner[CubeEdgeCorners[e][1]],
+			k);
+	}
 
-		alpha = 0.5 * (tan(0.25 * M_PI * (2.0 * alpha - 1.0)) + 1.0);
+	///	<summary>
+	///		Position of interior Node (i,j) of the given panel, interpolated
+	///		along the row between the left and right panel edges.
+	///	</summary>
+	Node GetPanelInteriorNode(int iPanel, int i, int j) const {
+		const int (&edges)[4][2] = PanelEdges[iPanel];
+
+		return InterpolateNode(
+			GetEdgeNode(edges[1][0], j, edges[1][1] != 0),
+			GetEdgeNode(edges[2][0], j, edges[2][1] != 0),
+			i);
+	}
 
-		// Insert node along edge
-		int ixNode = InsertCSSubNode(ix0, ix1, alpha, nodes);
+	///	<summary>
+	///		Index of Face (i,j) of the given panel.
+	///	</summary>
+	int GetFaceIndex(int iPanel, int i, int j) const {
+		return (iPanel * m_nResolution + j) * m_nResolution + i;
+	}
 
-		// Add node to edge
-		edge.push_back(ixNode);
+	///	<summary>
+	///		Get Face (i,j) of the given panel.
+	///	</summary>
+	void GetFace(int iPanel, int i, int j, Face & face) const {
+		face.SetNode(0, GetPanelNodeIndex(iPanel, i,   j));
+		face.SetNode(1, GetPanelNodeIndex(iPanel, i+1, j));
+		face.SetNode(2, GetPanelNodeIndex(iPanel, i+1, j+1));
+		face.SetNode(3, GetPanelNodeIndex(iPanel, i,   j+1));
 	}
 
-	edge.push_back(ix1);
-}
+	///	<summary>
+	///		Generate the corner and cube edge Nodes.
+	///	</summary>
+	void GenerateEdgeNodes(NodeVector & nodes) const {
+		nodes.resize(GetEdgeNodeCount());
 
-///////////////////////////////////////////////////////////////////////////////
+		for (int c = 0; c < 8; c++) {
+			nodes[c] = m_nodeCorner[c];
+		}
 
-void GenerateFacesFromQuad(
-	int nResolution,
-	int iPanel,
-	const MultiEdge & edge0,
-	const MultiEdge & edge1,
-	const MultiEdge & edge2,
-	const MultiEdge & edge3,
-	NodeVector & nodes,
-	FaceVector & vecFaces
-) {
-	MultiEdge edgeTop;
-	MultiEdge edgeBot = edge0;
+#pragma omp parallel for schedule(static)
+		for (int e = 0; e < 12; e++) {
+		for (int k = 1; k < m_nResolution; k++) {
+			nodes[GetEdgeNodeIndex(e, k)] = GetEdgeNode(e, k);
+		}
+		}
+	}
 
-	for (int j = 0; j < nResolution; j++) {
+	///	<summary>
+	///		Generate the interior Nodes of rows [jBegin, jEnd) of the given
+	///		panel, which are written to nodes starting at ixOffset.
+	///	</summary>
+	void GeneratePanelNodes(
+		int iPanel,
+		int jBegin,
+		int jEnd,
+		int ixOffset,
+		NodeVector & nodes
+	) const {
+		jBegin = std::max(jBegin, 1);
+		jEnd = std::min(jEnd, m_nResolution);
+
+#pragma omp parallel for schedule(static)
+		for (int j = jBegin; j < jEnd; j++) {
+		for (int i = 1; i < m_nResolution; i++) {
+			nodes[GetPanelNodeIndex(iPanel, i, j) - ixOffset] =
+				GetPanelInteriorNode(iPanel, i, j);
+		}
+		}
+	}
 
-		// Generate top level edge
-		if (j != nResolution-1) {
-			int ix0 = edge1[j+1];
-			int ix1 = edge2[j+1];
+	///	<summary>
+	///		Generate the Faces of rows [jBegin, jEnd) of the given panel,
+	///		which are written to faces starting at ixOffset.  Faces must
+	///		already have four edges.
+	///	</summary>
+	void GeneratePanelFaces(
+		int iPanel,
+		int jBegin,
+		int jEnd,
+		int ixOffset,
+		FaceVector & faces
+	) const {
+#pragma omp parallel for schedule(static)
+		for (int j = jBegin; j < jEnd; j++) {
+		for (int i = 0; i < m_nResolution; i++) {
+			GetFace(iPanel, i, j, faces[GetFaceIndex(iPanel, i, j) - ixOffset]);
+		}
+		}
+	}
 
-			GenerateCSMultiEdgeVertices(nResolution, ix0, ix1, nodes, edgeTop);
+protected:
+	///	<summary>
+	///		Interpolate Node k of the equiangular subdivision of the great
+	///		circle arc between two Nodes.
+	///	</summary>
+	Node InterpolateNode(
+		const Node & node0,
+		const Node & node1,
+		int k
+	) const {
+		Real alpha =
+			static_cast<Real>(k) / static_cast<Real>(m_nResolution);
 
-		} else {
-			edgeTop = edge3;
-		}
+		alpha = 0.5 * (tan(0.25 * M_PI * (2.0 * alpha - 1.0)) + 1.0);
 
-		// Generate face
-		for (int i = 0; i < nResolution; i++) {
-			Face face(4);
-			face.SetNode(0, edgeBot[i+1]);
-			face.SetNode(1, edgeTop[i+1]);
-			face.SetNode(2, edgeTop[i]);
-			face.SetNode(3, edgeBot[i]);
+		Real dX = node0.x + (node1.x - node0.x) * alpha;
+		Real dY = node0.y + (node1.y - node0.y) * alpha;
+		Real dZ = node0.z + (node1.z - node0.z) * alpha;
 
-			vecFaces.push_back(face);
-		}
+		// Project to sphere
+		Real dRadius = sqrt(dX*dX + dY*dY + dZ*dZ);
 
-		// Increment row
-		edgeBot = edgeTop;
+		return Node(dX / dRadius, dY / dRadius, dZ / dRadius);
 	}
-}
 
+protected:
+	///	<summary>
+	///		Corners of each cube edge.
+	///	</summary>
+	static const int CubeEdgeCorners[12][2];
+
+	///	<summary>
+	///		Bottom, left, right and top cube edges of each panel, in the
+	///		order panels are numbered, and whether each is reversed.
+	///	</summary>
+	static const int PanelEdges[6][4][2];
+
+	///	<summary>
+	///		Number of elements along each cube edge.
+	///	</summary>
+	int m_nResolution;
+
+	///	<summary>
+	///		Number of interior Nodes along each cube edge.
+	///	</summary>
+	int m_nEdgeInterior;
+
+	///	<summary>
+	///		Cube corners.
+	///	</summary>
+	Node m_nodeCorner[8];
+};
+
+const int CSMeshIndexer::CubeEdgeCorners[12][2] = {
+	{0, 1}, {1, 2}, {2, 3}, {3, 0},
+	{0, 4}, {1, 5}, {2, 6}, {3, 7},
+	{4, 5}, {5, 6}, {6, 7}, {7, 4}
+};
+
+// Equatorial panels, then the south and north polar panels
+const int CSMeshIndexer::PanelEdges[6][4][2] = {
+	{{0, 0}, {4, 0}, {5, 0}, {8, 0}},
+	{{1, 0}, {5, 0}, {6, 0}, {9, 0}},
+	{{2, 0}, {6, 0}, {7, 0}, {10, 0}},
+	{{3, 0}, {7, 0}, {4, 0}, {11, 0}},
+	{{2, 1}, {3, 0}, {1, 1}, {0, 0}},
+	{{8, 0}, {11, 1}, {9, 0}, {10, 1}}
+};
 
 ///////////////////////////////////////////////////////////////////////////////
 // 
@@ -167,115 +345,23 @@ try {
 	std::cout << "..Generating mesh with resolution [" << nResolution << "]";
 	std::cout << std::endl;
 
+	mesh.Clear();
+
 	NodeVector & nodes = mesh.nodes;
 	FaceVector & faces = mesh.faces;
     mesh.type = Mesh::MeshType_CubedSphere;
 
-	// Generate corner points
-	Real dInvDeltaX = 1.0 / sqrt(3.0);
-
-	nodes.push_back(Node(+dInvDeltaX, -dInvDeltaX, -dInvDeltaX));
-	nodes.push_back(Node(+dInvDeltaX, +dInvDeltaX, -dInvDeltaX));
-	nodes.push_back(Node(-dInvDeltaX, +dInvDeltaX, -dInvDeltaX));
-	nodes.push_back(Node(-dInvDeltaX, -dInvDeltaX, -dInvDeltaX));
-	nodes.push_back(Node(+dInvDeltaX, -dInvDeltaX, +dInvDeltaX));
-	nodes.push_back(Node(+dInvDeltaX, +dInvDeltaX, +dInvDeltaX));
-	nodes.push_back(Node(-dInvDeltaX, +dInvDeltaX, +dInvDeltaX));
-	nodes.push_back(Node(-dInvDeltaX, -dInvDeltaX, +dInvDeltaX));
-
-	// Generate edges
-	MultiEdgeVector vecMultiEdges;
-	vecMultiEdges.resize(12);
-
-	GenerateCSMultiEdgeVertices(nResolution, 0, 1, nodes, vecMultiEdges[0]);
-	GenerateCSMultiEdgeVertices(nResolution, 1, 2, nodes, vecMultiEdges[1]);
-	GenerateCSMultiEdgeVertices(nResolution, 2, 3, nodes, vecMultiEdges[2]);
-	GenerateCSMultiEdgeVertices(nResolution, 3, 0, nodes, vecMultiEdges[3]);
-
-	GenerateCSMultiEdgeVertices(nResolution, 0, 4, nodes, vecMultiEdges[4]);
-	GenerateCSMultiEdgeVertices(nResolution, 1, 5, nodes, vecMultiEdges[5]);
-	GenerateCSMultiEdgeVertices(nResolution, 2, 6, nodes, vecMultiEdges[6]);
-	GenerateCSMultiEdgeVertices(nResolution, 3, 7, nodes, vecMultiEdges[7]);
-
-	GenerateCSMultiEdgeVertices(nResolution, 4, 5, nodes, vecMultiEdges[8]);
-	GenerateCSMultiEdgeVertices(nResolution, 5, 6, nodes, vecMultiEdges[9]);
-	GenerateCSMultiEdgeVertices(nResolution, 6, 7, nodes, vecMultiEdges[10]);
-	GenerateCSMultiEdgeVertices(nResolution, 7, 4, nodes, vecMultiEdges[11]);
-
-	// Generate equatorial faces
-	GenerateFacesFromQuad(
-		nResolution,
-		0,
-		vecMultiEdges[0],
-		vecMultiEdges[4],
-		vecMultiEdges[5],
-		vecMultiEdges[8],
-		nodes,
-		faces);
-
-	GenerateFacesFromQuad(
-		nResolution,
-		1,
-		vecMultiEdges[1],
-		vecMultiEdges[5],
-		vecMultiEdges[6],
-		vecMultiEdges[9],
-		nodes,
-		faces);
-
-	GenerateFacesFromQuad(
-		nResolution,
-		2,
-		vecMultiEdges[2],
-		vecMultiEdges[6],
-		vecMultiEdges[7],
-		vecMultiEdges[10],
-		nodes,
-		faces);
-
-	GenerateFacesFromQuad(
-		nResolution,
-		3,
-		vecMultiEdges[3],
-		vecMultiEdges[7],
-		vecMultiEdges[4],
-		vecMultiEdges[11],
-		nodes,
-		faces);
-
-	// Generate south polar face
-	GenerateFacesFromQuad(
-		nResolution,
-		5,
-		vecMultiEdges[2].Flip(),
-		vecMultiEdges[3],
-		vecMultiEdges[1].Flip(),
-		vecMultiEdges[0],
-		nodes,
-		faces);
-
-	// Generate north polar face
-	GenerateFacesFromQuad(
-		nResolution,
-		4,
-		vecMultiEdges[8],
-		vecMultiEdges[11].Flip(),
-		vecMultiEdges[9],
-		vecMultiEdges[10].Flip(),
-		nodes,
-		faces);
-
-	// Alternative arrangement of nodes on Faces (now always on)
-	{
-		for (int i = 0; i < faces.size(); i++) {
-			int ix[4];
-			for (int j = 0; j < 4; j++) {
-				ix[j] = faces[i][j];
-			}
-			for (int j = 0; j < 4; j++) {
-				faces[i].SetNode((j+1)%4, ix[j]);
-			}
-		}
+	// Generate Nodes and Faces in closed form
+	CSMeshIndexer indexer(nResolution);
+
+	indexer.GenerateEdgeNodes(nodes);
+	nodes.resize(indexer.GetNodeCount());
+
+	faces.resize(indexer.GetFaceCount(), Face(4));
+
+	for (int p = 0; p < 6; p++) {
+		indexer.GeneratePanelNodes(p, 0, nResolution, 0, nodes);
+		indexer.GeneratePanelFaces(p, 0, nResolution, 0, faces);
 	}
 
 	// Output the mesh
@@ -304,3 +390,102 @@ try {
 }
 
 ///////////////////////////////////////////////////////////////////////////////
+
+extern "C" 
+int GenerateCSMeshStreamed(
+	int nResolution,
+	std::string strOutputFile,
+	std::string strOutputFormat
+) {
+
+	NcError error(NcError::silent_nonfatal);
+
+try {
+
+    // Check command line parameters (data type arguments)
+    STLStringHelper::ToLower(strOutputFormat);
+
+	NcFile::FileFormat eOutputFormat =
+		GetNcFileFormatFromString(strOutputFormat);
+	if (eOutputFormat == NcFile::BadFormat) {
+		_EXCEPTION1("Invalid \"out_format\" value (%s), "
+			"expected [Classic|Offset64Bits|Netcdf4|Netcdf4Classic]",
+			strOutputFormat.c_str());
+	}
+	if (strOutputFile.size() == 0) {
+		_EXCEPTIONT("Output file must be specified when streaming");
+	}
+
+	// Announce
+	std::cout << "=========================================================";
+	std::cout << std::endl;
+	std::cout << "..Generating mesh with resolution [" << nResolution << "]";
+	std::cout << std::endl;
+	std::cout << "..Streaming mesh to file [" << strOutputFile.c_str() << "] ";
+	std::cout << std::endl;
+
+	CSMeshIndexer indexer(nResolution);
+
+	ExodusMeshWriter writer;
+	writer.Open(
+		strOutputFile,
+		indexer.GetNodeCount(),
+		indexer.GetFaceCount(),
+		4,
+		eOutputFormat);
+
+	// Corner and cube edge Nodes
+	{
+		NodeVector nodes;
+		indexer.GenerateEdgeNodes(nodes);
+		writer.WriteNodes(0, nodes);
+	}
+
+	// Panels are written in chunks of rows
+	const int nChunkRows = std::max(1, MeshStreamChunkFaces / nResolution);
+
+	NodeVector nodes;
+	FaceVector faces;
+
+	for (int p = 0; p < 6; p++) {
+	for (int jBegin = 0; jBegin < nResolution; jBegin += nChunkRows) {
+		const int jEnd = std::min(jBegin + nChunkRows, nResolution);
+
+		// Interior Nodes of rows [max(jBegin,1), jEnd)
+		const int jNodeBegin = std::max(jBegin, 1);
+		if (jNodeBegin < jEnd) {
+			const int ixNodeBegin =
+				indexer.GetPanelNodeIndex(p, 1, jNodeBegin);
+
+			nodes.resize((jEnd - jNodeBegin) * (nResolution - 1));
+			indexer.GeneratePanelNodes(p, jBegin, jEnd, ixNodeBegin, nodes);
+			writer.WriteNodes(ixNodeBegin, nodes);
+		}
+
+		// Faces of rows [jBegin, jEnd)
+		const int ixFaceBegin = indexer.GetFaceIndex(p, 0, jBegin);
+
+		faces.resize((jEnd - jBegin) * nResolution, Face(4));
+		indexer.GeneratePanelFaces(p, jBegin, jEnd, ixFaceBegin, faces);
+		writer.WriteFaces(ixFaceBegin, faces);
+	}
+	}
+
+	writer.Close();
+
+	// Announce
+	std::cout << "..Mesh generator exited successfully" << std::endl;
+	std::cout << "=========================================================";
+	std::cout << std::endl;
+
+} catch(Exception & e) {
+	Announce(e.ToString().c_str());
+	return (0);
+
+} catch(...) {
+	return (0);
+}
+    return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
@@ -40,19 +40,28 @@ int main(int argc, char** argv) {
 	// Alternative method (removed)
 	bool fAlt;
 
+	// Write the mesh in chunks without storing it in memory
+	bool fStream;
+
 	// Parse the command line
 	BeginCommandLine()
 		CommandLineInt(nResolution, "res", 10);
 		CommandLineString(strOutputFile, "file", "outCSMesh.g");
 		CommandLineString(strOutputFormat, "out_format", "Netcdf4");
 		CommandLineBool(fAlt, "alt");
+		CommandLineBool(fStream, "stream");
 
 		ParseCommandLine(argc, argv);
 	EndCommandLine(argv)
 
 	// Call the actual mesh generator
-    Mesh mesh;
-	int err = GenerateCSMesh(mesh, nResolution, strOutputFile, strOutputFormat);
+	int err;
+	if (fStream) {
+		err = GenerateCSMeshStreamed(nResolution, strOutputFile, strOutputFormat);
+	} else {
+		Mesh mesh;
+		err = GenerateCSMesh(mesh, nResolution, strOutputFile, strOutputFormat);
+	}
 	if (err) exit(err);
 	else return 0;
 }
@@ -0,0 +1,178 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    GenerateCompositeMap.cpp
+///	\author  Paul Ullrich
+///	\version October 14, 2026
+///
+///	<remarks>
+///		Copyright 2026 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "CommandLine.h"
+#include "Announce.h"
+#include "OfflineMap.h"
+
+#include "netcdfcpp.h"
+
+#include <cmath>
+#include <iostream>
+
+///////////////////////////////////////////////////////////////////////////////
+
+typedef std::map<std::string, std::string> AttributeMap;
+typedef AttributeMap::value_type AttributePair;
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Replace attributes of mapAttributes ending in any of the given
+///		extensions with the corresponding attributes of mapSource.
+///	</summary>
+void ReplaceAttributes(
+	AttributeMap & mapAttributes,
+	const AttributeMap & mapSource,
+	const std::string & strFirstExt,
+	const std::string & strSecondExt
+) {
+	const std::string strExt[2] = {strFirstExt, strSecondExt};
+
+	for (int e = 0; e < 2; e++) {
+		const int nExt = strExt[e].length();
+
+		AttributeMap::iterator iterAtt = mapAttributes.begin();
+		while (iterAtt != mapAttributes.end()) {
+			const std::string & strName = iterAtt->first;
+			if ((strName.length() > nExt) &&
+			    (strName.substr(strName.length()-nExt) == strExt[e])
+			) {
+				mapAttributes.erase(iterAtt++);
+			} else {
+				iterAtt++;
+			}
+		}
+
+		AttributeMap::const_iterator iterSrc = mapSource.begin();
+		for (; iterSrc != mapSource.end(); iterSrc++) {
+			const std::string & strName = iterSrc->first;
+			if ((strName.length() > nExt) &&
+			    (strName.substr(strName.length()-nExt) == strExt[e])
+			) {
+				mapAttributes.insert(*iterSrc);
+			}
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv) {
+
+	NcError error(NcError::silent_nonfatal);
+
+try {
+	// First map file for input
+	std::string strFirstMapFile;
+
+	// Second map file for input
+	std::string strSecondMapFile;
+
+	// Map file for output
+	std::string strOutputMapFile;
+
+	// Do not verify the mesh
+	bool fNoCheck;
+
+	// Check monotonicity
+	bool fCheckMonotone;
+
+	// Parse the command line
+	BeginCommandLine()
+		CommandLineString(strFirstMapFile, "in_first", "");
+		CommandLineString(strSecondMapFile, "in_second", "");
+		CommandLineString(strOutputMapFile, "out", "");
+		CommandLineBool(fNoCheck, "nocheck");
+		CommandLineBool(fCheckMonotone, "checkmono");
+
+		ParseCommandLine(argc, argv);
+	EndCommandLine(argv)
+
+	// Check arguments
+	if (strFirstMapFile == "") {
+		_EXCEPTIONT("First input map file (--in_first) must be specified");
+	}
+	if (strSecondMapFile == "") {
+		_EXCEPTIONT("Second input map file (--in_second) must be specified");
+	}
+	if (strOutputMapFile == "") {
+		_EXCEPTIONT("Output map file (--out) must be specified");
+	}
+
+	// Atribute maps
+	AttributeMap mapAttributes;
+	AttributeMap mapSecondAttributes;
+
+	// Load maps from file
+	AnnounceStartBlock("Loading input maps");
+	OfflineMap mapFirst;
+	NcFile::FileFormat eFileFormat;
+	mapFirst.Read(strFirstMapFile, &mapAttributes, &eFileFormat);
+
+	OfflineMap mapSecond;
+	mapSecond.Read(strSecondMapFile, &mapSecondAttributes);
+	AnnounceEndBlock("Done");
+
+	// Generate composite map
+	AnnounceStartBlock("Generating composite map");
+	OfflineMap mapOut;
+	mapOut.SetComposition(mapFirst, mapSecond);
+	AnnounceEndBlock("Done");
+
+	// Verify map
+	if (!fNoCheck) {
+		AnnounceStartBlock("Verifying map");
+		mapOut.IsConsistent(1.0e-8);
+		mapOut.IsConservative(1.0e-8);
+
+		if (fCheckMonotone) {
+			mapOut.IsMonotone(1.0e-12);
+		}
+		AnnounceEndBlock("Done");
+	}
+
+	// Target attributes are taken from the second map
+	ReplaceAttributes(mapAttributes, mapSecondAttributes, "_dst", "_b");
+
+	// Find version name
+	AttributeMap::iterator iterVersion = mapAttributes.find("version");
+	if (iterVersion == mapAttributes.end()) {
+		mapAttributes.insert(
+			AttributePair("version", "GenerateCompositeMap 1.0 : 2026-10-14"));
+	} else {
+		iterVersion->second =
+			"GenerateCompositeMap 1.0 : 2026-10-14 :: " + iterVersion->second;
+	}
+
+	// Write map to file
+	AnnounceStartBlock("Writing composite map");
+	mapOut.Write(strOutputMapFile, mapAttributes, eFileFormat);
+	AnnounceEndBlock("Done");
+
+	return (0);
+
+} catch(Exception & e) {
+	Announce(e.ToString().c_str());
+	return (-1);
+
+} catch(...) {
+	return (-2);
+}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
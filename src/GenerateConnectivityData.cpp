@@ -2,38 +2,182 @@
 #include "Exception.h"
 #include "Announce.h"
 
+#include <algorithm>
 #include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		Collect the faces adjacent to face f, sorted without repeats.
+///		Returns the number of face indices that were out of range.
+///	</summary>
+static int CollectAdjacentFaces(
+	const Mesh & meshIn,
+	int f,
+	bool fNodeAdjacency,
+	std::vector<int> & vecAdjacent
+) {
+	const int nElements = static_cast<int>(meshIn.faces.size());
+	const Face & face = meshIn.faces[f];
+
+	int nOutOfRange = 0;
+
+	vecAdjacent.clear();
+
+	// Faces sharing a node with this face
+	if (fNodeAdjacency) {
+		for (size_t i = 0; i < face.edges.size(); i++) {
+			const int ixNode = face[i];
+			if ((ixNode < 0) ||
+			    (ixNode >= static_cast<int>(meshIn.revnodearray.size()))
+			) {
+				continue;
+			}
+
+			ReverseNodeArray::FaceRange rangeFaces =
+				meshIn.revnodearray[ixNode];
+
+			ReverseNodeArray::FaceRange::const_iterator iter =
+				rangeFaces.begin();
+			for (; iter != rangeFaces.end(); iter++) {
+				if (*iter == f) {
+					continue;
+				}
+				if ((*iter < 0) || (*iter >= nElements)) {
+					nOutOfRange++;
+					continue;
+				}
+				vecAdjacent.push_back(*iter);
+			}
+		}
+
+	// Faces sharing an edge with this face
+	} else {
+		for (size_t i = 0; i < face.edges.size(); i++) {
+			EdgeMapConstIterator iter = meshIn.edgemap.find(face.edges[i]);
+			if (iter == meshIn.edgemap.end()) {
+				continue;
+			}
+			if ((iter->second[0] == InvalidFace) ||
+			    (iter->second[1] == InvalidFace)
+			) {
+				continue;
+			}
+			if ((iter->second[0] < 0) || (iter->second[0] >= nElements) ||
+			    (iter->second[1] < 0) || (iter->second[1] >= nElements)
+			) {
+				nOutOfRange++;
+				continue;
+			}
+
+			if (iter->second[0] == f) {
+				vecAdjacent.push_back(iter->second[1]);
+			} else if (iter->second[1] == f) {
+				vecAdjacent.push_back(iter->second[0]);
+			}
+		}
+	}
+
+	std::sort(vecAdjacent.begin(), vecAdjacent.end());
+	vecAdjacent.erase(
+		std::unique(vecAdjacent.begin(), vecAdjacent.end()),
+		vecAdjacent.end());
+
+	return nOutOfRange;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+extern "C"
+int GenerateConnectivityDataCSR(
+	const Mesh & meshIn,
+	bool fNodeAdjacency,
+	std::vector<size_t> & vecAdjacencyOffsets,
+	std::vector<int> & vecAdjacency
+) {
+
+	// Number of elements
+	const int nElements = meshIn.faces.size();
+
+	if (fNodeAdjacency) {
+		if (meshIn.revnodearray.size() != meshIn.nodes.size()) {
+			_EXCEPTIONT("ReverseNodeArray must be constructed for node adjacency");
+		}
+	} else {
+		if ((nElements != 0) && (meshIn.edgemap.size() == 0)) {
+			_EXCEPTIONT("EdgeMap must be constructed for edge adjacency");
+		}
+	}
+
+	// Count adjacent faces of each face
+	vecAdjacencyOffsets.resize(nElements + 1);
+	vecAdjacencyOffsets[0] = 0;
+
+	int nOutOfRange = 0;
+
+#pragma omp parallel reduction(+:nOutOfRange)
+	{
+		std::vector<int> vecAdjacent;
+
+#pragma omp for schedule(dynamic, 256)
+		for (int f = 0; f < nElements; f++) {
+			nOutOfRange +=
+				CollectAdjacentFaces(meshIn, f, fNodeAdjacency, vecAdjacent);
+			vecAdjacencyOffsets[f+1] = vecAdjacent.size();
+		}
+	}
+
+	if (nOutOfRange != 0) {
+		_EXCEPTION1("Face index out of range in %i adjacencies", nOutOfRange);
+	}
+
+	for (int f = 0; f < nElements; f++) {
+		vecAdjacencyOffsets[f+1] += vecAdjacencyOffsets[f];
+	}
+
+	// Fill adjacent faces of each face
+	vecAdjacency.resize(vecAdjacencyOffsets[nElements]);
+
+#pragma omp parallel
+	{
+		std::vector<int> vecAdjacent;
+
+#pragma omp for schedule(dynamic, 256)
+		for (int f = 0; f < nElements; f++) {
+			CollectAdjacentFaces(meshIn, f, fNodeAdjacency, vecAdjacent);
+			std::copy(
+				vecAdjacent.begin(),
+				vecAdjacent.end(),
+				vecAdjacency.begin() + vecAdjacencyOffsets[f]);
+		}
+	}
+
+	return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 extern "C"
 int GenerateConnectivityData(
 	const Mesh & meshIn,
 	std::vector< std::set<int> > & vecConnectivity
 ) {
 
+	std::vector<size_t> vecAdjacencyOffsets;
+	std::vector<int> vecAdjacency;
+
+	GenerateConnectivityDataCSR(
+		meshIn, false, vecAdjacencyOffsets, vecAdjacency);
+
 	// Number of elements
 	int nElements = meshIn.faces.size();
 
+	vecConnectivity.clear();
 	vecConnectivity.resize(nElements);
 
-	EdgeMapConstIterator iter = meshIn.edgemap.begin();
-	for (; iter != meshIn.edgemap.end(); iter++) {
-
-		if ((iter->second[0] != InvalidFace) &&
-			(iter->second[1] != InvalidFace)
-			) {
-			if ((iter->second[0] < 0) || (iter->second[0] >= nElements)) {
-				_EXCEPTION1("Face index (%i) out of range",
-							iter->second[0]);
-			}
-			if ((iter->second[1] < 0) || (iter->second[1] >= nElements)) {
-				_EXCEPTION1("Face index (%i) out of range",
-							iter->second[1]);
-			}
-			
-			vecConnectivity[iter->second[0]].insert(iter->second[1]+1);
-			vecConnectivity[iter->second[1]].insert(iter->second[0]+1);
+	for (int f = 0; f < nElements; f++) {
+		for (size_t j = vecAdjacencyOffsets[f]; j < vecAdjacencyOffsets[f+1]; j++) {
+			vecConnectivity[f].insert(vecConnectivity[f].end(), vecAdjacency[j]+1);
 		}
 	}
 
@@ -21,9 +21,12 @@
 #include "DataArray3D.h"
 #include "GaussLobattoQuadrature.h"
 #include "FiniteElementTools.h"
+#include "NetCDFUtilities.h"
 
 #include "netcdfcpp.h"
 
+#include <algorithm>
+
 ///////////////////////////////////////////////////////////////////////////////
 
 extern "C" 
@@ -34,7 +37,8 @@ int GenerateGLLMetaData(
 	bool fNoBubble,
 	std::string strOutput,
 	DataArray3D<int>& dataGLLnodes,
-	DataArray3D<double>& dataGLLJacobian
+	DataArray3D<double>& dataGLLJacobian,
+	NcFile::FileFormat eOutputFormat
 ) {
 
 try {
@@ -73,10 +77,17 @@ try {
 	// Write to file
 	if (strOutput.size()) {
 
+		AnnounceStartBlock("Writing metadata");
+
 		// Number of Faces
 		int nElements = static_cast<int>(meshInput.faces.size());
 
-		NcFile ncOut(strOutput.c_str(), NcFile::Replace);
+		NcFile ncOut(strOutput.c_str(), NcFile::Replace, NULL, 0, eOutputFormat);
+		if (!ncOut.is_valid()) {
+			_EXCEPTION1("Unable to open metadata file \"%s\" for writing",
+				strOutput.c_str());
+		}
+
 		NcDim * dimElements = ncOut.add_dim("nelem", nElements);
 		NcDim * dimNp = ncOut.add_dim("np", nP);
 
@@ -86,9 +97,50 @@ try {
 		NcVar * varJacobian =
 			ncOut.add_var("J", ncDouble, dimNp, dimNp, dimElements);
 
-		varGLLnodes->put(&(dataGLLnodes[0][0][0]), nP, nP, nElements);
-
-		varJacobian->put(&(dataGLLJacobian[0][0][0]), nP, nP, nElements);
+		if ((varGLLnodes == NULL) || (varJacobian == NULL)) {
+			_EXCEPTIONT("Error creating variables \"GLLnodes\" and \"J\"");
+		}
+
+		// Elements are written in slabs, which are also the NetCDF-4 chunks,
+		// so that all nodes of an element are stored together
+		size_t sChunkBytes = GetNcCompressionOptions().sChunkBytes;
+		if (sChunkBytes == 0) {
+			sChunkBytes = DefaultNcChunkBytes;
+		}
+
+		const int nSlabElements =
+			std::max(1, std::min(nElements,
+				static_cast<int>(sChunkBytes / (sizeof(double) * nP * nP))));
+
+		const long lChunkShape[3] = {nP, nP, nSlabElements};
+		SetNcVarChunking(ncOut, varGLLnodes, lChunkShape);
+		SetNcVarChunking(ncOut, varJacobian, lChunkShape);
+
+		// Slab buffers, stored with the shape (np, np, nCount) of each slab
+		DataArray1D<int> dataGLLnodesSlab(nP * nP * nSlabElements);
+		DataArray1D<double> dataGLLJacobianSlab(nP * nP * nSlabElements);
+
+		for (int k0 = 0; k0 < nElements; k0 += nSlabElements) {
+			const int nCount = std::min(nSlabElements, nElements - k0);
+
+			for (int i = 0; i < nP; i++) {
+			for (int j = 0; j < nP; j++) {
+				const int ixSlab = (i * nP + j) * nCount;
+				for (int k = 0; k < nCount; k++) {
+					dataGLLnodesSlab[ixSlab + k] = dataGLLnodes[i][j][k0 + k];
+					dataGLLJacobianSlab[ixSlab + k] = dataGLLJacobian[i][j][k0 + k];
+				}
+			}
+			}
+
+			varGLLnodes->set_cur(0, 0, k0);
+			varGLLnodes->put(&(dataGLLnodesSlab[0]), nP, nP, nCount);
+
+			varJacobian->set_cur(0, 0, k0);
+			varJacobian->put(&(dataGLLJacobianSlab[0]), nP, nP, nCount);
+		}
+
+		AnnounceEndBlock("Done");
 	}
 
 } catch(Exception & e) {
@@ -19,6 +19,8 @@
 #include "Exception.h"
 #include "GridElements.h"
 #include "DataArray3D.h"
+#include "NetCDFUtilities.h"
+#include "STLStringHelper.h"
 
 #include "TempestRemapAPI.h"
 
@@ -38,18 +40,49 @@ int main(int argc, char** argv) {
 	// Output metadata file
 	std::string strOutput;
 
+	// Output format
+	std::string strOutputFormat;
+
+	// Deflate level and target chunk size of NetCDF-4 output
+	int iDeflateLevel;
+	int nChunkKB;
+
 	// Parse the command line
 	BeginCommandLine()
 		CommandLineString(strMesh, "mesh", "");
 		CommandLineInt(nP, "np", 4);
 		CommandLineBool(fNoBubble, "no_bubble");
 		CommandLineString(strOutput, "out", "gllmeta.nc");
+		CommandLineString(strOutputFormat, "out_format", "netcdf4");
+		CommandLineIntD(iDeflateLevel, "out_deflate", 0, "(0-9)");
+		CommandLineInt(nChunkKB, "out_chunk_kb", 0);
 
 		ParseCommandLine(argc, argv);
 	EndCommandLine(argv)
 
 	AnnounceBanner();
 
+	// Output format
+	STLStringHelper::ToLower(strOutputFormat);
+
+	NcFile::FileFormat eOutputFormat =
+		GetNcFileFormatFromString(strOutputFormat);
+	if (eOutputFormat == NcFile::BadFormat) {
+		Announce("ERROR: Invalid \"out_format\" value (%s), "
+			"expected [Classic|Offset64Bits|Netcdf4|Netcdf4Classic]",
+			strOutputFormat.c_str());
+		return (-1);
+	}
+	if (nChunkKB < 0) {
+		Announce("ERROR: --out_chunk_kb must be nonnegative");
+		return (-1);
+	}
+
+	NcCompressionOptions optsCompression;
+	optsCompression.iDeflateLevel = iDeflateLevel;
+	optsCompression.sChunkBytes = static_cast<size_t>(nChunkKB) * 1024;
+	SetNcCompressionOptions(optsCompression);
+
 	// Calculate metadata
 	DataArray3D<int> dataGLLnodes;
 	DataArray3D<double> dataGLLJacobian;
@@ -63,7 +96,8 @@ int main(int argc, char** argv) {
 			fNoBubble,
 			strOutput,
 			dataGLLnodes,
-			dataGLLJacobian);
+			dataGLLJacobian,
+			eOutputFormat);
 
 	if (err) exit(err);
 
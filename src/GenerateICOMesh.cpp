@@ -47,188 +47,353 @@ typedef std::vector<LonLatNode> LonLatNodeVector;
 
 ///////////////////////////////////////////////////////////////////////////////
 
-int InsertSubNode(
-	int ix0,
-	int ix1,
-	double alpha,
+void ConvertFromLonLatToCartesian(
+	const LonLatNodeVector & vecLonLatNodes,
 	NodeVector & vecNodes
 ) {
-	double dDeltaX = (vecNodes[ix1].x - vecNodes[ix0].x);
-	double dDeltaY = (vecNodes[ix1].y - vecNodes[ix0].y);
-	double dDeltaZ = (vecNodes[ix1].z - vecNodes[ix0].z);
-	double dCartLength =
-		sqrt(dDeltaX*dDeltaX + dDeltaY*dDeltaY + dDeltaZ*dDeltaZ);
-
-	double dGamma = acos(0.5 * dCartLength);
-	double dTheta = acos(1.0 - 0.5 * dCartLength * dCartLength);
-	double dAlphaTheta = alpha * dTheta;
-	double dBeta = M_PI - dGamma - dAlphaTheta;
+	vecNodes.resize(vecLonLatNodes.size());
 
-	alpha = sin(dAlphaTheta) / sin(dBeta) / dCartLength;
+	// Loop over all nodes
+	int i;
+	for (i = 0; i < vecLonLatNodes.size(); i++) {
+		vecNodes[i].x =
+			sin(vecLonLatNodes[i].lon) * cos(vecLonLatNodes[i].lat);
+		vecNodes[i].y =
+			cos(vecLonLatNodes[i].lon) * cos(vecLonLatNodes[i].lat);
+		vecNodes[i].z =
+			sin(vecLonLatNodes[i].lat);
+	}
+}
 
-	double dX = vecNodes[ix0].x + (vecNodes[ix1].x - vecNodes[ix0].x) * alpha;
-	double dY = vecNodes[ix0].y + (vecNodes[ix1].y - vecNodes[ix0].y) * alpha;
-	double dZ = vecNodes[ix0].z + (vecNodes[ix1].z - vecNodes[ix0].z) * alpha;
+///////////////////////////////////////////////////////////////////////////////
 
-	// Project to sphere
-	double dRadius = sqrt(dX*dX + dY*dY + dZ*dZ);
+///	<summary>
+///		A closed-form numbering of the Nodes and Faces of a refined
+///		icosahedral mesh.  Nodes are numbered as the 12 icosahedral
+///		vertices, then the interior nodes of the 30 icosahedral edges, then
+///		the interior nodes of each of the 20 icosahedral triangles by row.
+///		Faces are numbered by triangle and then by row, so that any Node or
+///		Face can be generated independently of all others.
+///	</summary>
+class ICOMeshIndexer {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	ICOMeshIndexer(
+		int nRefineLevel
+	) :
+		m_nRefineLevel(nRefineLevel),
+		m_nEdgeInterior(nRefineLevel - 1),
+		m_nTriangleInterior((nRefineLevel - 1) * (nRefineLevel - 2) / 2)
+	{
+		// Latitude of nodes (Northern Hemisphere)
+		const double NodeLat = atan(0.5);
+
+		// Store all icosahedral nodes
+		LonLatNodeVector vecLonLatNodes;
+
+		vecLonLatNodes.push_back(LonLatNode(0.0,          -0.5*M_PI));
+		vecLonLatNodes.push_back(LonLatNode(0.0,          -NodeLat));
+		vecLonLatNodes.push_back(LonLatNode(2.0*M_PI*0.2, -NodeLat));
+		vecLonLatNodes.push_back(LonLatNode(2.0*M_PI*0.4, -NodeLat));
+		vecLonLatNodes.push_back(LonLatNode(2.0*M_PI*0.6, -NodeLat));
+		vecLonLatNodes.push_back(LonLatNode(2.0*M_PI*0.8, -NodeLat));
+		vecLonLatNodes.push_back(LonLatNode(2.0*M_PI*0.1, +NodeLat));
+		vecLonLatNodes.push_back(LonLatNode(2.0*M_PI*0.3, +NodeLat));
+		vecLonLatNodes.push_back(LonLatNode(2.0*M_PI*0.5, +NodeLat));
+		vecLonLatNodes.push_back(LonLatNode(2.0*M_PI*0.7, +NodeLat));
+		vecLonLatNodes.push_back(LonLatNode(2.0*M_PI*0.9, +NodeLat));
+		vecLonLatNodes.push_back(LonLatNode(0.0,          +0.5*M_PI));
+
+		// Convert icosahedral nodes to Cartesian geometry
+		ConvertFromLonLatToCartesian(vecLonLatNodes, m_vecCorners);
+
+		// Icosahedral edges
+		for (int i = 0; i < 5; i++) {
+			SetEdge(i, 0, i+1);
+		}
+		for (int i = 0; i < 5; i++) {
+			SetEdge(i+5, i+1, ((i+1)%5)+1);
+		}
 
-	dX /= dRadius;
-	dY /= dRadius;
-	dZ /= dRadius;
+		SetEdge(10, 1, 6);
+		SetEdge(11, 6, 2);
+		SetEdge(12, 2, 7);
+		SetEdge(13, 7, 3);
+		SetEdge(14, 3, 8);
+		SetEdge(15, 8, 4);
+		SetEdge(16, 4, 9);
+		SetEdge(17, 9, 5);
+		SetEdge(18, 5, 10);
+		SetEdge(19, 10, 1);
+
+		for (int i = 0; i < 5; i++) {
+			SetEdge(i+20, i+6, ((i+1)%5)+6);
+		}
+		for (int i = 0; i < 5; i++) {
+			SetEdge(i+25, i+6, 11);
+		}
 
-	// Index
-	int ix = vecNodes.size();
+		// South polar triangles
+		for (int i = 0; i < 5; i++) {
+			SetTriangle(i, i, false, (i+1)%5, false, i+5, false);
+		}
 
-	// Insert node
-	vecNodes.push_back(Node(dX, dY, dZ));
+		// South equatorial triangles
+		for (int i = 0; i < 5; i++) {
+			SetTriangle(i+5, 2*i+10, false, i+5, false, 2*i+11, false);
+		}
 
-	return ix;
-}
+		// North equatorial triangles
+		for (int i = 0; i < 5; i++) {
+			SetTriangle(i+10,
+				i+20, false, 2*i+11, false, 2*((i+1)%5)+10, true);
+		}
 
-///////////////////////////////////////////////////////////////////////////////
+		// North polar triangles
+		for (int i = 0; i < 5; i++) {
+			SetTriangle(i+15, i+25, false, i+20, false, ((i+1)%5)+25, true);
+		}
+	}
 
-int InsertTriFaceCentroidNode(
-	int ix0,
-	int ix1,
-	int ix2,
-	NodeVector & vecNodes
-) {
-	double dX = (vecNodes[ix0].x + vecNodes[ix1].x + vecNodes[ix2].x) / 3.0;
-	double dY = (vecNodes[ix0].y + vecNodes[ix1].y + vecNodes[ix2].y) / 3.0;
-	double dZ = (vecNodes[ix0].z + vecNodes[ix1].z + vecNodes[ix2].z) / 3.0;
+	///	<summary>
+	///		Total number of Nodes.
+	///	</summary>
+	int GetNodeCount() const {
+		return 12 + 30 * m_nEdgeInterior + 20 * m_nTriangleInterior;
+	}
 
-	// Project to sphere
-	double dRadius = sqrt(dX*dX + dY*dY + dZ*dZ);
+	///	<summary>
+	///		Total number of Faces.
+	///	</summary>
+	int GetFaceCount() const {
+		return 20 * m_nRefineLevel * m_nRefineLevel;
+	}
 
-	dX /= dRadius;
-	dY /= dRadius;
-	dZ /= dRadius;
+	///	<summary>
+	///		Index of Node k along icosahedral edge e.
+	///	</summary>
+	int GetEdgeNodeIndex(int e, int k, bool fFlip = false) const {
+		if (fFlip) {
+			k = m_nRefineLevel - k;
+		}
+		if (k == 0) {
+			return m_nEdgeCorners[e][0];
+		}
+		if (k == m_nRefineLevel) {
+			return m_nEdgeCorners[e][1];
+		}
+		return 12 + e * m_nEdgeInterior + (k - 1);
+	}
 
-	// Index
-	int ix = vecNodes.size();
+	///	<summary>
+	///		Index of Node i of row r of the given triangle, where r is in
+	///		the range [0, nRefineLevel] and i is in the range [0, r].
+	///	</summary>
+	int GetTriangleNodeIndex(int t, int r, int i) const {
+		const int (&edges)[3][2] = m_nTriangleEdges[t];
 
-	// Insert node
-	vecNodes.push_back(Node(dX, dY, dZ));
+		if (r == m_nRefineLevel) {
+			return GetEdgeNodeIndex(edges[2][0], i, edges[2][1] != 0);
+		}
+		if (i == 0) {
+			return GetEdgeNodeIndex(edges[0][0], r, edges[0][1] != 0);
+		}
+		if (i == r) {
+			return GetEdgeNodeIndex(edges[1][0], r, edges[1][1] != 0);
+		}
+		return 12 + 30 * m_nEdgeInterior + t * m_nTriangleInterior
+			+ (r - 1) * (r - 2) / 2 + (i - 1);
+	}
 
-	return ix;
-}
+	///	<summary>
+	///		Position of Node k along icosahedral edge e.
+	///	</summary>
+	Node GetEdgeNode(int e, int k, bool fFlip = false) const {
+		if (fFlip) {
+			k = m_nRefineLevel - k;
+		}
+		if (k == 0) {
+			return m_vecCorners[m_nEdgeCorners[e][0]];
+		}
+		if (k == m_nRefineLevel) {
+			return m_vecCorners[m_nEdgeCorners[e][1]];
+		}
+		return InterpolateNode(
+			m_vecCorners[m_nEdgeCorners[e][0]],
+			m_vecCorners[m_nEdgeCorners[e][1]],
+			static_cast<double>(k) / static_cast<double>(m_nRefineLevel));
+	}
 
-///////////////////////////////////////////////////////////////////////////////
+	///	<summary>
+	///		Position of interior Node i of row r of the given triangle,
+	///		interpolated between the ends of the row.
+	///	</summary>
+	Node GetTriangleInteriorNode(int t, int r, int i) const {
+		const int (&edges)[3][2] = m_nTriangleEdges[t];
 
-void GenerateEdgeVertices(
-	int nRefineLevel,
-	int ix0,
-	int ix1,
-	NodeVector & vecNodes,
-	MultiEdge & edge
-) {
-	edge.clear();
-	edge.push_back(ix0);
+		return InterpolateNode(
+			GetEdgeNode(edges[0][0], r, edges[0][1] != 0),
+			GetEdgeNode(edges[1][0], r, edges[1][1] != 0),
+			static_cast<double>(i) / static_cast<double>(r));
+	}
 
-	for (int i = 1; i < nRefineLevel; i++) {
+	///	<summary>
+	///		Generate all Nodes.
+	///	</summary>
+	void GenerateNodes(NodeVector & vecNodes) const {
+		vecNodes.resize(GetNodeCount());
 
-		// Nodes along line in Cartesian geometry
-		double alpha =
-			static_cast<double>(i) / static_cast<double>(nRefineLevel);
+		for (int c = 0; c < 12; c++) {
+			vecNodes[c] = m_vecCorners[c];
+		}
 
-		// Insert node along edge
-		int ixNode = InsertSubNode(ix0, ix1, alpha, vecNodes);
+#pragma omp parallel for schedule(static)
+		for (int e = 0; e < 30; e++) {
+		for (int k = 1; k < m_nRefineLevel; k++) {
+			vecNodes[GetEdgeNodeIndex(e, k)] = GetEdgeNode(e, k);
+		}
+		}
 
-		// Add node to edge
-		edge.push_back(ixNode);
+#pragma omp parallel for schedule(dynamic)
+		for (int tr = 0; tr < 20 * m_nRefineLevel; tr++) {
+			const int t = tr / m_nRefineLevel;
+			const int r = tr % m_nRefineLevel;
+			for (int i = 1; i < r; i++) {
+				vecNodes[GetTriangleNodeIndex(t, r, i)] =
+					GetTriangleInteriorNode(t, r, i);
+			}
+		}
 	}
 
-	edge.push_back(ix1);
-}
+	///	<summary>
+	///		Generate all Faces.
+	///	</summary>
+	void GenerateFaces(FaceVector & vecFaces) const {
+		vecFaces.resize(GetFaceCount(), Face(3));
 
-///////////////////////////////////////////////////////////////////////////////
+#pragma omp parallel for schedule(dynamic)
+		for (int tj = 0; tj < 20 * m_nRefineLevel; tj++) {
+			const int t = tj / m_nRefineLevel;
+			const int j = tj % m_nRefineLevel;
 
-void GenerateFacesFromTriangle(
-	int nRefineLevel,
-	const MultiEdge & edge0,
-	const MultiEdge & edge1,
-	const MultiEdge & edge2,
-	NodeVector & vecNodes,
-	FaceVector & vecFaces
-) {
-	int i;
-	int j;
-	int k;
-
-	int ixEndNode;
+			int ixFace = t * m_nRefineLevel * m_nRefineLevel + j * j;
 
-	int ixInt;
+			for (int i = 0; i < 2*j+1; i++) {
+				Face & face = vecFaces[ixFace + i];
 
-	// MultiEdges
-	MultiEdge edgeBot;
-	MultiEdge edgeMid;
-	MultiEdge edgeTop;
+				// Downward pointing faces
+				if (i % 2 == 0) {
+					int ix = i/2;
 
-	// Initial bottom edge
-	edgeBot.push_back(edge0[0]);
+					face.SetNode(0, GetTriangleNodeIndex(t, j,   ix));
+					face.SetNode(1, GetTriangleNodeIndex(t, j+1, ix));
+					face.SetNode(2, GetTriangleNodeIndex(t, j+1, ix+1));
 
-	// Loop over all refined faces
-	for (j = 0; j < nRefineLevel; j++) {
+				// Upward pointing faces
+				} else {
+					int ix = (i-1)/2;
 
-		// Generate top level vertices
-		if (j == nRefineLevel-1) {
-			edgeTop = edge2;
-		} else {
-			GenerateEdgeVertices(
-				j+1, edge0[j+1], edge1[j+1], vecNodes, edgeTop);
+					face.SetNode(0, GetTriangleNodeIndex(t, j+1, ix+1));
+					face.SetNode(1, GetTriangleNodeIndex(t, j,   ix+1));
+					face.SetNode(2, GetTriangleNodeIndex(t, j,   ix));
+				}
+			}
 		}
+	}
 
-		// Generate faces
-		for (i = 0; i < 2*j+1; i++) {
-			// Downward pointing faces
-			if (i % 2 == 0) {
-				int ix = i/2;
-
-				Face face(3);
-				face.SetNode(0, edgeBot[ix]);
-				face.SetNode(1, edgeTop[ix]);
-				face.SetNode(2, edgeTop[ix+1]);
+protected:
+	///	<summary>
+	///		Set the corners of icosahedral edge e.
+	///	</summary>
+	void SetEdge(int e, int ix0, int ix1) {
+		m_nEdgeCorners[e][0] = ix0;
+		m_nEdgeCorners[e][1] = ix1;
+	}
 
-				vecFaces.push_back(face);
+	///	<summary>
+	///		Set the left, right and bottom edges of triangle t, and whether
+	///		each is reversed.
+	///	</summary>
+	void SetTriangle(
+		int t,
+		int e0, bool fFlip0,
+		int e1, bool fFlip1,
+		int e2, bool fFlip2
+	) {
+		m_nTriangleEdges[t][0][0] = e0;
+		m_nTriangleEdges[t][0][1] = (fFlip0)?(1):(0);
+		m_nTriangleEdges[t][1][0] = e1;
+		m_nTriangleEdges[t][1][1] = (fFlip1)?(1):(0);
+		m_nTriangleEdges[t][2][0] = e2;
+		m_nTriangleEdges[t][2][1] = (fFlip2)?(1):(0);
+	}
 
-			// Upward pointing faces
-			} else {
-				int ix = (i-1)/2;
+	///	<summary>
+	///		Interpolate a Node a fraction alpha of the way along the great
+	///		circle arc between two Nodes, with equal angular spacing.
+	///	</summary>
+	static Node InterpolateNode(
+		const Node & node0,
+		const Node & node1,
+		double alpha
+	) {
+		double dDeltaX = (node1.x - node0.x);
+		double dDeltaY = (node1.y - node0.y);
+		double dDeltaZ = (node1.z - node0.z);
+		double dCartLength =
+			sqrt(dDeltaX*dDeltaX + dDeltaY*dDeltaY + dDeltaZ*dDeltaZ);
+
+		double dGamma = acos(0.5 * dCartLength);
+		double dTheta = acos(1.0 - 0.5 * dCartLength * dCartLength);
+		double dAlphaTheta = alpha * dTheta;
+		double dBeta = M_PI - dGamma - dAlphaTheta;
+
+		alpha = sin(dAlphaTheta) / sin(dBeta) / dCartLength;
+
+		double dX = node0.x + (node1.x - node0.x) * alpha;
+		double dY = node0.y + (node1.y - node0.y) * alpha;
+		double dZ = node0.z + (node1.z - node0.z) * alpha;
+
+		// Project to sphere
+		double dRadius = sqrt(dX*dX + dY*dY + dZ*dZ);
+
+		return Node(dX / dRadius, dY / dRadius, dZ / dRadius);
+	}
 
-				Face face(3);
-				face.SetNode(0, edgeTop[ix+1]);
-				face.SetNode(1, edgeBot[ix+1]);
-				face.SetNode(2, edgeBot[ix]);
+protected:
+	///	<summary>
+	///		Number of elements along each icosahedral edge.
+	///	</summary>
+	int m_nRefineLevel;
 
-				vecFaces.push_back(face);
-			}
-		}
+	///	<summary>
+	///		Number of interior Nodes along each icosahedral edge.
+	///	</summary>
+	int m_nEdgeInterior;
 
-		// New bottom edge
-		edgeBot = edgeTop;
-	}
-}
+	///	<summary>
+	///		Number of interior Nodes of each icosahedral triangle.
+	///	</summary>
+	int m_nTriangleInterior;
 
-///////////////////////////////////////////////////////////////////////////////
+	///	<summary>
+	///		Icosahedral vertices.
+	///	</summary>
+	NodeVector m_vecCorners;
 
-void ConvertFromLonLatToCartesian(
-	const LonLatNodeVector & vecLonLatNodes,
-	NodeVector & vecNodes
-) {
-	vecNodes.resize(vecLonLatNodes.size());
+	///	<summary>
+	///		Corners of each icosahedral edge.
+	///	</summary>
+	int m_nEdgeCorners[30][2];
 
-	// Loop over all nodes
-	int i;
-	for (i = 0; i < vecLonLatNodes.size(); i++) {
-		vecNodes[i].x =
-			sin(vecLonLatNodes[i].lon) * cos(vecLonLatNodes[i].lat);
-		vecNodes[i].y =
-			cos(vecLonLatNodes[i].lon) * cos(vecLonLatNodes[i].lat);
-		vecNodes[i].z =
-			sin(vecLonLatNodes[i].lat);
-	}
-}
+	///	<summary>
+	///		Edges of each icosahedral triangle.
+	///	</summary>
+	int m_nTriangleEdges[20][3][2];
+};
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -237,111 +402,10 @@ void GenerateIcosahedralQuadGrid(
 	NodeVector & vecNodes,
 	FaceVector & vecFaces
 ) {
-	// Latitude of nodes (Northern Hemisphere)
-	const double NodeLat = atan(0.5);
-
-	// Store all icosahedral nodes
-	LonLatNodeVector vecLonLatNodes;
-
-	vecLonLatNodes.push_back(LonLatNode(0.0,          -0.5*M_PI));
-	vecLonLatNodes.push_back(LonLatNode(0.0,          -NodeLat));
-	vecLonLatNodes.push_back(LonLatNode(2.0*M_PI*0.2, -NodeLat));
-	vecLonLatNodes.push_back(LonLatNode(2.0*M_PI*0.4, -NodeLat));
-	vecLonLatNodes.push_back(LonLatNode(2.0*M_PI*0.6, -NodeLat));
-	vecLonLatNodes.push_back(LonLatNode(2.0*M_PI*0.8, -NodeLat));
-	vecLonLatNodes.push_back(LonLatNode(2.0*M_PI*0.1, +NodeLat));
-	vecLonLatNodes.push_back(LonLatNode(2.0*M_PI*0.3, +NodeLat));
-	vecLonLatNodes.push_back(LonLatNode(2.0*M_PI*0.5, +NodeLat));
-	vecLonLatNodes.push_back(LonLatNode(2.0*M_PI*0.7, +NodeLat));
-	vecLonLatNodes.push_back(LonLatNode(2.0*M_PI*0.9, +NodeLat));
-	vecLonLatNodes.push_back(LonLatNode(0.0,          +0.5*M_PI));
-
-	// Convert icosahedral nodes to Cartesian geometry
-	ConvertFromLonLatToCartesian(vecLonLatNodes, vecNodes);
-
-	// Vector of edges
-	MultiEdgeVector vecEdges;
-	vecEdges.resize(30);
-
-	// Generate vertices along edges
-	for (int i = 0; i < 5; i++) {
-		GenerateEdgeVertices(
-			nRefineLevel, 0, i+1, vecNodes, vecEdges[i]);
-	}
+	ICOMeshIndexer indexer(nRefineLevel);
 
-	for (int i = 0; i < 5; i++) {
-		GenerateEdgeVertices(
-			nRefineLevel, i+1, ((i+1)%5)+1, vecNodes, vecEdges[i+5]);
-	}
-
-	GenerateEdgeVertices(nRefineLevel, 1, 6, vecNodes, vecEdges[10]);
-	GenerateEdgeVertices(nRefineLevel, 6, 2, vecNodes, vecEdges[11]);
-	GenerateEdgeVertices(nRefineLevel, 2, 7, vecNodes, vecEdges[12]);
-	GenerateEdgeVertices(nRefineLevel, 7, 3, vecNodes, vecEdges[13]);
-	GenerateEdgeVertices(nRefineLevel, 3, 8, vecNodes, vecEdges[14]);
-	GenerateEdgeVertices(nRefineLevel, 8, 4, vecNodes, vecEdges[15]);
-	GenerateEdgeVertices(nRefineLevel, 4, 9, vecNodes, vecEdges[16]);
-	GenerateEdgeVertices(nRefineLevel, 9, 5, vecNodes, vecEdges[17]);
-	GenerateEdgeVertices(nRefineLevel, 5, 10, vecNodes, vecEdges[18]);
-	GenerateEdgeVertices(nRefineLevel, 10, 1, vecNodes, vecEdges[19]);
-
-	for (int i = 0; i < 5; i++) {
-		GenerateEdgeVertices(
-			nRefineLevel, i+6, ((i+1)%5)+6, vecNodes, vecEdges[i+20]);
-	}
-
-	for (int i = 0; i < 5; i++) {
-		GenerateEdgeVertices(
-			nRefineLevel, i+6, 11, vecNodes, vecEdges[i+25]);
-	}
-
-	// Generate south polar faces
-	for (int i = 0; i < 5; i++) {
-		GenerateFacesFromTriangle(
-			nRefineLevel,
-			vecEdges[i],
-			vecEdges[(i+1)%5],
-			vecEdges[i+5],
-			vecNodes,
-			vecFaces
-		);
-	}
-
-	// Generate south equatorial faces
-	for (int i = 0; i < 5; i++) {
-		GenerateFacesFromTriangle(
-			nRefineLevel,
-			vecEdges[2*i+10],
-			vecEdges[i+5],
-			vecEdges[2*i+11],
-			vecNodes,
-			vecFaces
-		);
-	}
-
-	// Generate north equatorial faces
-	for (int i = 0; i < 5; i++) {
-		GenerateFacesFromTriangle(
-			nRefineLevel,
-			vecEdges[i+20],
-			vecEdges[2*i+11],
-			vecEdges[2*((i+1)%5)+10].Flip(),
-			vecNodes,
-			vecFaces
-		);
-	}
-
-	// Generate north polar faces
-	for (int i = 0; i < 5; i++) {
-		GenerateFacesFromTriangle(
-			nRefineLevel,
-			vecEdges[i+25],
-			vecEdges[i+20],
-			vecEdges[((i+1)%5)+25].Flip(),
-			vecNodes,
-			vecFaces
-		);
-	}
+	indexer.GenerateNodes(vecNodes);
+	indexer.GenerateFaces(vecFaces);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -351,111 +415,32 @@ void Dual(
 ) {
 	const int EdgeCountHexagon = 6;
 
-	// Generate ReverseNodeArray
-	mesh.ConstructReverseNodeArray();
-
-	// Backup Nodes and Faces
-	NodeVector nodesOld = mesh.nodes;
-	FaceVector facesOld = mesh.faces;
+	Mesh meshDual;
+	GenerateDualMesh(mesh, meshDual);
 
-	mesh.nodes.clear();
-	mesh.faces.clear();
+	// Fill in missing edges of pentagons, so all Faces are hexagons
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < meshDual.faces.size(); i++) {
+		const Face & faceDual = meshDual.faces[i];
+		const int nEdges = faceDual.edges.size();
 
-	// Generate new Node array
-	for (int i = 0; i < facesOld.size(); i++) {
-		Node node;
-		for (int j = 0; j < facesOld[i].edges.size(); j++) {
-			node.x += nodesOld[facesOld[i][j]].x;
-			node.y += nodesOld[facesOld[i][j]].y;
-			node.z += nodesOld[facesOld[i][j]].z;
+		if (nEdges == EdgeCountHexagon) {
+			continue;
 		}
 
-		node.x /= static_cast<double>(facesOld[i].edges.size());
-		node.y /= static_cast<double>(facesOld[i].edges.size());
-		node.z /= static_cast<double>(facesOld[i].edges.size());
-
-		double dMag = node.Magnitude();
-
-		node.x /= dMag;
-		node.y /= dMag;
-		node.z /= dMag;
-
-		mesh.nodes.push_back(node);
-	}
-
-	// Generate new Face array
-	for (int i = 0; i < nodesOld.size(); i++) {
-		const int nEdges = mesh.revnodearray[i].size();
-
 		Face face(EdgeCountHexagon);
-		Face faceTemp(EdgeCountHexagon);
-
-		int ixNode = 0;
-		std::set<int>::const_iterator iter = mesh.revnodearray[i].begin();
-		for (; iter != mesh.revnodearray[i].end(); iter++) {
-			faceTemp.SetNode(ixNode, *iter);
-			ixNode++;
+		for (int j = 0; j < nEdges; j++) {
+			face.SetNode(j, faceDual[j]);
 		}
-
-		// Reorient Faces
-		Node nodeCentral = nodesOld[i];
-		Node node0 = mesh.nodes[faceTemp[0]] - nodeCentral;
-
-		Node nodeCross = CrossProduct(mesh.nodes[faceTemp[0]], nodeCentral);
-		
-		double dNode0Mag = node0.Magnitude();
-
-		// Determine the angles about the central Node of each Face Node
-		std::vector<double> dAngles;
-		dAngles.resize(faceTemp.edges.size());
-		dAngles[0] = 0.0;
-
-		for (int j = 1; j < nEdges; j++) {
-			Node nodeDiff = mesh.nodes[faceTemp[j]] - nodeCentral;
-			double dNodeDiffMag = nodeDiff.Magnitude();
-
-			double dSide = DotProduct(nodeCross, nodeDiff);
-
-			double dDotNorm =
-				DotProduct(node0, nodeDiff) / (dNode0Mag * dNodeDiffMag);
-
-			double dAngle;
-			if (dDotNorm > 1.0) {
-				dDotNorm = 1.0;
-			}
-
-			dAngles[j] = acos(dDotNorm);
-
-			if (dSide > 0.0) {
-				dAngles[j] = - dAngles[j] + 2.0 * M_PI;
-			}
-		}
-
-		// Orient each Face by putting Nodes in order of increasing angle
-		double dCurrentAngle = 0.0;
-		face.SetNode(0, faceTemp[0]);
-		for (int j = 1; j < nEdges; j++) {
-			int ixNextNode = 1;
-			double dNextAngle = 2.0 * M_PI;
-
-			for (int k = 1; k < nEdges; k++) {
-				if ((dAngles[k] > dCurrentAngle) && (dAngles[k] < dNextAngle)) {
-					ixNextNode = k;
-					dNextAngle = dAngles[k];
-				}
-			}
-
-			face.SetNode(j, faceTemp[ixNextNode]);
-			dCurrentAngle = dNextAngle;
-		}
-
-		// Fill in missing edges
 		for (int j = nEdges; j < EdgeCountHexagon; j++) {
 			face.SetNode(j, face[nEdges-1]);
 		}
-
-		mesh.faces.push_back(face);
+		meshDual.faces[i] = face;
 	}
+
+	mesh.nodes.swap(meshDual.nodes);
+	mesh.faces.swap(meshDual.faces);
+	mesh.revnodearray.clear();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -25,6 +25,30 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		Invert the Lambert conformal conic projection at the point
+///		(dXX, dYY), given in Earth radii.
+///	</summary>
+static void LambertConfConicInv(
+	double dN,
+	double dF,
+	double dRho0,
+	double dLon0,
+	double dXX,
+	double dYY,
+	double & dLambda,
+	double & dPhi
+) {
+	double dTheta = atan2(dXX, dRho0 - dYY);
+	double dRho = dN / fabs(dN)
+		* sqrt(dXX * dXX + (dRho0 - dYY) * (dRho0 - dYY));
+
+	dLambda = dLon0 + dTheta / dN;
+	dPhi = 2.0 * atan( pow(dF / dRho, 1.0/dN)) - 0.5 * M_PI;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 extern "C" int GenerateLambertConfConicMesh(  Mesh& mesh, int nNCol, int nNRow,
 												double dLon0, double dLat0, 
 												double dLat1, double dLat2, 
@@ -66,46 +90,49 @@ try {
 
 	double dRho0 = dF * pow(1.0 / tan(0.25 * M_PI + 0.5 * dLat0), dN);
 
+	mesh.Clear();
+
 	NodeVector & nodes = mesh.nodes;
 	FaceVector & faces = mesh.faces;
 
 	// Announce
 	AnnounceStartBlock("Distributing nodes");
 
-	// Add all nodal locations
+	// Announce the corners of the domain
+	const int iCornerRow[4] = {0, 0, nNRow, nNRow};
+	const int iCornerCol[4] = {0, nNCol, 0, nNCol};
+
+	for (int c = 0; c < 4; c++) {
+		double dXX = dXLL + dDX * static_cast<double>(iCornerRow[c]);
+		double dYY = dYLL + dDX * static_cast<double>(iCornerCol[c]);
+
+		double dLambda;
+		double dPhi;
+		LambertConfConicInv(dN, dF, dRho0, dLon0, dXX, dYY, dLambda, dPhi);
+
+		Announce("Corner: %3.3f %3.3f",
+			dLambda * 180.0 / M_PI, dPhi * 180.0 / M_PI);
+	}
+
+	// Add all nodal locations, one row per iteration
+	nodes.resize((nNRow + 1) * (nNCol + 1));
+
+#pragma omp parallel for schedule(static)
 	for (int i = 0; i <= nNRow; i++) {
 	for (int j = 0; j <= nNCol; j++) {
 
 		double dXX = dXLL + dDX * static_cast<double>(i);
 		double dYY = dYLL + dDX * static_cast<double>(j);
 
-		double dTheta = atan2(dXX, dRho0 - dYY);
-		double dRho = dN / fabs(dN)
-			* sqrt(dXX * dXX + (dRho0 - dYY) * (dRho0 - dYY));
-
-		double dLambda = dLon0 + dTheta / dN;
-		double dPhi = 2.0 * atan( pow(dF / dRho, 1.0/dN)) - 0.5 * M_PI;
-
-		if ((i == 0) || (i == nNRow)) {
-			if ((j == 0) || (j == nNCol)) {
-				Announce("Corner: %3.3f %3.3f",
-					dLambda * 180.0 / M_PI, dPhi * 180.0 / M_PI);
-/*
-				double dRho2 = dF * pow(1/tan(0.25 * M_PI + 0.5 * dPhi), dN);
-				double dXX2 = dRho2 * sin(dN * (dLambda - dLon0));
-				double dYY2 = dRho0 - dRho2 * cos(dN * (dLambda - dLon0));
-
-				printf("%1.5e %1.5e : %1.5e %1.5e\n",
-					dXX, dYY, dXX2, dYY2);
-*/
-			}
-		}
+		double dLambda;
+		double dPhi;
+		LambertConfConicInv(dN, dF, dRho0, dLon0, dXX, dYY, dLambda, dPhi);
 
 		double dX = cos(dPhi) * cos(dLambda);
 		double dY = cos(dPhi) * sin(dLambda);
 		double dZ = sin(dPhi);
 
-		nodes.push_back(Node(dX, dY, dZ));
+		nodes[i * (nNCol + 1) + j] = Node(dX, dY, dZ);
 	}
 	}
 
@@ -114,18 +141,19 @@ try {
 	AnnounceStartBlock("Assigning faces");
 
 	// Add all faces 
+	faces.resize(nNRow * nNCol, Face(4));
+
+#pragma omp parallel for schedule(static)
 	for (int j = 0; j < nNRow; j++) {
 		int iThisYNodeIx =  j    * (nNCol + 1);
 		int iNextYNodeIx = (j+1) * (nNCol + 1);
 
 		for (int i = 0; i < nNCol; i++) {
-			Face face(4);
+			Face & face = faces[j * nNCol + i];
 			face.SetNode(0, iThisYNodeIx + i);
 			face.SetNode(1, iThisYNodeIx + (i + 1));
 			face.SetNode(2, iNextYNodeIx + (i + 1));
 			face.SetNode(3, iNextYNodeIx + i);
-
-			faces.push_back(face);
 		}
 	}
 
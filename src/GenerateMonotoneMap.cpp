@@ -0,0 +1,148 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    GenerateMonotoneMap.cpp
+///	\author  Paul Ullrich
+///	\version October 14, 2026
+///
+///	<remarks>
+///		Copyright 2026 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "CommandLine.h"
+#include "Announce.h"
+#include "OfflineMap.h"
+
+#include "netcdfcpp.h"
+
+#include <cmath>
+#include <iostream>
+
+///////////////////////////////////////////////////////////////////////////////
+
+typedef std::map<std::string, std::string> AttributeMap;
+typedef AttributeMap::value_type AttributePair;
+
+///////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv) {
+
+	NcError error(NcError::silent_nonfatal);
+
+try {
+	// Map file for input
+	std::string strInputMapFile;
+
+	// Monotone low-order map file
+	std::string strLowOrderMapFile;
+
+	// Map file for output
+	std::string strOutputMapFile;
+
+	// Tolerance for monotonicity
+	double dTolerance;
+
+	// Do not verify the mesh
+	bool fNoCheck;
+
+	// Parse the command line
+	BeginCommandLine()
+		CommandLineString(strInputMapFile, "in", "");
+		CommandLineString(strLowOrderMapFile, "lowmap", "");
+		CommandLineString(strOutputMapFile, "out", "");
+		CommandLineDouble(dTolerance, "tol", 0.0);
+		CommandLineBool(fNoCheck, "nocheck");
+
+		ParseCommandLine(argc, argv);
+	EndCommandLine(argv)
+
+	// Check arguments
+	if (strInputMapFile == "") {
+		_EXCEPTIONT("Input map file (--in) must be specified");
+	}
+	if (strLowOrderMapFile == "") {
+		_EXCEPTIONT("Low-order map file (--lowmap) must be specified");
+	}
+	if (strOutputMapFile == "") {
+		_EXCEPTIONT("Output map file (--out) must be specified");
+	}
+
+	// Atribute map
+	AttributeMap mapAttributes;
+
+	// Load maps from file
+	AnnounceStartBlock("Loading input map");
+	OfflineMap mapIn;
+	NcFile::FileFormat eFileFormat;
+	mapIn.Read(strInputMapFile, &mapAttributes, &eFileFormat);
+	AnnounceEndBlock("Done");
+
+	AnnounceStartBlock("Loading low-order map");
+	OfflineMap mapLowOrder;
+	mapLowOrder.Read(strLowOrderMapFile);
+	AnnounceEndBlock("Done");
+
+	if ((mapIn.GetSourceAreas().GetRows() !=
+	     mapLowOrder.GetSourceAreas().GetRows()) ||
+	    (mapIn.GetTargetAreas().GetRows() !=
+	     mapLowOrder.GetTargetAreas().GetRows())
+	) {
+		_EXCEPTIONT("Input map and low-order map must have the same "
+			"source and target degrees of freedom");
+	}
+
+	// Blend the maps
+	AnnounceStartBlock("Enforcing monotonicity");
+	mapIn.EnforceMonotonicity(mapLowOrder.GetSparseMatrix(), dTolerance);
+	AnnounceEndBlock("Done");
+
+	// Verify map
+	if (!fNoCheck) {
+		AnnounceStartBlock("Verifying map");
+		mapIn.IsConsistent(1.0e-8);
+		mapIn.IsConservative(1.0e-8);
+		mapIn.IsMonotone(std::max(dTolerance, 1.0e-12));
+		AnnounceEndBlock("Done");
+	}
+
+	// Update attributes
+	AttributeMap::iterator iterMono = mapAttributes.find("mono");
+	if (iterMono == mapAttributes.end()) {
+		mapAttributes.insert(AttributePair("mono", "true"));
+	} else {
+		iterMono->second = "true";
+	}
+
+	// Find version name
+	AttributeMap::iterator iterVersion = mapAttributes.find("version");
+	if (iterVersion == mapAttributes.end()) {
+		mapAttributes.insert(
+			AttributePair("version", "GenerateMonotoneMap 1.0 : 2026-10-14"));
+	} else {
+		iterVersion->second =
+			"GenerateMonotoneMap 1.0 : 2026-10-14 :: " + iterVersion->second;
+	}
+
+	// Write map to file
+	AnnounceStartBlock("Writing monotone map");
+	mapIn.Write(strOutputMapFile, mapAttributes, eFileFormat);
+	AnnounceEndBlock("Done");
+
+	return (0);
+
+} catch(Exception & e) {
+	Announce(e.ToString().c_str());
+	return (-1);
+
+} catch(...) {
+	return (-2);
+}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
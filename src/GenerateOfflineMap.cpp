@@ -30,9 +30,13 @@
 #include "OfflineMap.h"
 #include "LinearRemapSE0.h"
 #include "LinearRemapFV.h"
+#include "FiniteVolumeStencilCache.h"
+#include "OverlapMeshCache.h"
+#include "RemapMeshContext.h"
 
 #include "netcdfcpp.h"
 #include <cmath>
+#include <memory>
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -79,6 +83,10 @@ void LoadMetaDataFile(
 	DataArray3D<double> & dataGLLJacobian
 ) {
 	NcFile ncMeta(strSourceMeta.c_str(), NcFile::ReadOnly);
+	if (!ncMeta.is_valid()) {
+		_EXCEPTION1("Unable to open metadata file \"%s\"",
+			strSourceMeta.c_str());
+	}
 
 	NcDim * dimNp = ncMeta.get_dim("np");
 	if (dimNp == NULL) {
@@ -91,50 +99,91 @@ void LoadMetaDataFile(
 	}
 
 	NcVar * varGLLNodes = ncMeta.get_var("GLLnodes");
-	if (dimNelem == NULL) {
+	if (varGLLNodes == NULL) {
 		_EXCEPTIONT("Variable \"GLLnodes\" missing from metadata file");
 	}
 
 	NcVar * varGLLJacobian = ncMeta.get_var("J");
-	if (dimNelem == NULL) {
+	if (varGLLJacobian == NULL) {
 		_EXCEPTIONT("Variable \"J\" missing from metadata file");
 	}
 
 	int nP = dimNp->size();
 	int nElem = dimNelem->size();
 
-	DataArray3D<int> dataGLLNodes_tmp;
-	DataArray3D<double> dataGLLJacobian_tmp;
- 
 	dataGLLNodes.Allocate(nP, nP, nElem);
 	dataGLLJacobian.Allocate(nP, nP, nElem);
-	dataGLLNodes_tmp.Allocate(nP, nP, nElem);
-	dataGLLJacobian_tmp.Allocate(nP, nP, nElem);
- 
-	varGLLNodes->get(&(dataGLLNodes_tmp[0][0][0]), nP, nP, nElem);
- 	varGLLJacobian->get(&(dataGLLJacobian_tmp[0][0][0]), nP, nP, nElem);
 
-	for (int i = 0; i < nP; i++) {
+	// Read slabs of elements, so that the file layout is transposed into
+	// place without a second copy of the metadata
+	const int nSlabElements =
+		std::max(1, std::min(nElem,
+			static_cast<int>(DefaultNcChunkBytes / (sizeof(double) * nP * nP))));
+
+	DataArray1D<int> dataGLLNodesSlab(nP * nP * nSlabElements);
+	DataArray1D<double> dataGLLJacobianSlab(nP * nP * nSlabElements);
+
+	for (int k0 = 0; k0 < nElem; k0 += nSlabElements) {
+		const int nCount = std::min(nSlabElements, nElem - k0);
+
+		varGLLNodes->set_cur(0, 0, k0);
+		varGLLNodes->get(&(dataGLLNodesSlab[0]), nP, nP, nCount);
+
+		varGLLJacobian->set_cur(0, 0, k0);
+		varGLLJacobian->get(&(dataGLLJacobianSlab[0]), nP, nP, nCount);
+
+		for (int i = 0; i < nP; i++) {
 		for (int j = 0; j < nP; j++) {
-			for (int k = 0; k < nElem; k++) {
-				dataGLLNodes[i][j][k] = dataGLLNodes_tmp[j][i][k];
-				dataGLLJacobian[i][j][k] = dataGLLJacobian_tmp[j][i][k];
+			const int ixSlab = (j * nP + i) * nCount;
+			for (int k = 0; k < nCount; k++) {
+				dataGLLNodes[i][j][k0 + k] = dataGLLNodesSlab[ixSlab + k];
+				dataGLLJacobian[i][j][k0 + k] = dataGLLJacobianSlab[ixSlab + k];
 			}
 		}
+		}
 	}
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
-extern "C"
-int GenerateOfflineMapWithMeshes (
+///	<summary>
+///		Generate GLL metadata for a Mesh, reusing the metadata held by its
+///		RemapMeshContext if one is given.
+///	</summary>
+static double GenerateMetaDataWithContext(
+	RemapMeshContext * pctx,
+	Mesh & mesh,
+	int nP,
+	bool fNoBubble,
+	DataArray3D<int> & dataGLLNodes,
+	DataArray3D<double> & dataGLLJacobian
+) {
+	if (pctx != NULL) {
+		return pctx->GetGLLMetaData(
+			nP, fNoBubble, dataGLLNodes, dataGLLJacobian);
+	}
+
+	return GenerateMetaData(
+		mesh, nP, fNoBubble, dataGLLNodes, dataGLLJacobian);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Generate the OfflineMap between input and output meshes.  If
+///		RemapMeshContexts are given for the input and output meshes, their
+///		cached Face areas, connectivity, metadata and stencils are used.
+///	</summary>
+static int GenerateOfflineMapWithMeshesAndContexts(
 	Mesh & meshSource,
 	Mesh & meshTarget,
 	Mesh & meshOverlap,
 	std::string strSourceType,
 	std::string strTargetType,
 	const GenerateOfflineMapAlgorithmOptions & optsAlg,
-	OfflineMap & mapRemap
+	OfflineMap & mapRemap,
+	RemapMeshContext * pctxSource,
+	RemapMeshContext * pctxTarget
 ) {
 	NcError error(NcError::silent_nonfatal);
 
@@ -166,6 +215,17 @@ try {
 			"expected [Classic|Offset64Bits|Netcdf4|Netcdf4Classic]",
 			optsAlg.strOutputFormat.c_str());
 	}
+
+	// Chunking and compression of NetCDF-4 output
+	if (optsAlg.nOutputChunkKB < 0) {
+		_EXCEPTIONT("--out_chunk_kb must be nonnegative");
+	}
+
+	NcCompressionOptions optsCompression;
+	optsCompression.iDeflateLevel = optsAlg.iOutputDeflateLevel;
+	optsCompression.sChunkBytes =
+		static_cast<size_t>(optsAlg.nOutputChunkKB) * 1024;
+	SetNcCompressionOptions(optsCompression);
    
 	STLStringHelper::ToLower(strSourceType);
 	STLStringHelper::ToLower(strTargetType);
@@ -275,13 +335,19 @@ try {
 
 	// Calculate Face areas
 	AnnounceStartBlock("Calculating input mesh Face areas");
-	double dTotalAreaInput = meshSource.CalculateFaceAreas(optsAlg.fSourceConcave);
+	double dTotalAreaInput =
+		(pctxSource != NULL)
+		?(pctxSource->RequireFaceAreas())
+		:(meshSource.CalculateFaceAreas(optsAlg.fSourceConcave));
 	Announce("Input Mesh Geometric Area: %1.15e (%1.15e)", dTotalAreaInput, dTotalAreaInput / (4.0 * M_PI));
 	AnnounceEndBlock(NULL);
 
 	// Calculate Face areas
 	AnnounceStartBlock("Calculating output mesh Face areas");
-	Real dTotalAreaOutput = meshTarget.CalculateFaceAreas(optsAlg.fTargetConcave);
+	Real dTotalAreaOutput =
+		(pctxTarget != NULL)
+		?(pctxTarget->RequireFaceAreas())
+		:(meshTarget.CalculateFaceAreas(optsAlg.fTargetConcave));
 	Announce("Output Mesh Geometric Area: %1.15e (%1.15e)", dTotalAreaOutput, dTotalAreaOutput / (4.0 * M_PI));
 	AnnounceEndBlock(NULL);
 
@@ -330,30 +396,33 @@ try {
 
 	AnnounceEndBlock(NULL);
 
-	// Calculate Face areas
-	AnnounceStartBlock("Calculating overlap mesh Face areas");
-	Real dTotalAreaOverlap = meshOverlap.CalculateFaceAreas(false);
+	// Calculate Face areas (overlap meshes generated in memory already
+	// carry their Face areas) and, in the same pass, the overlap mesh area
+	// within each source and target Face for area correction
+	DataArray1D<double> dSourceArea;
+	DataArray1D<double> dTargetArea;
+
+	if (meshOverlap.vecFaceArea.GetRows() == meshOverlap.faces.size()) {
+		AnnounceStartBlock("Using existing overlap mesh Face areas");
+	} else {
+		AnnounceStartBlock("Calculating overlap mesh Face areas");
+	}
+	Real dTotalAreaOverlap =
+		meshOverlap.CalculateOverlapParentAreas(
+			meshSource.faces.size(),
+			meshTarget.faces.size(),
+			(optsAlg.fNoCorrectAreas)?(NULL):(&dSourceArea),
+			(optsAlg.fNoCorrectAreas)?(NULL):(&dTargetArea));
 	Announce("Overlap Mesh Area: %1.15e (%1.15e)", dTotalAreaOverlap, dTotalAreaOverlap / (4.0 * M_PI));
 	AnnounceEndBlock(NULL);
 
 	// Correct areas to match the areas calculated in the overlap mesh
 	if (!optsAlg.fNoCorrectAreas) {
 		AnnounceStartBlock("Correcting source/target areas to overlap mesh areas");
-		DataArray1D<double> dSourceArea(meshSource.faces.size());
-		DataArray1D<double> dTargetArea(meshTarget.faces.size());
-
-		_ASSERT(meshOverlap.vecSourceFaceIx.size() == meshOverlap.faces.size());
-		_ASSERT(meshOverlap.vecTargetFaceIx.size() == meshOverlap.faces.size());
-		_ASSERT(meshOverlap.vecFaceArea.GetRows() == meshOverlap.faces.size());
 
 		_ASSERT(meshSource.vecFaceArea.GetRows() == meshSource.faces.size());
 		_ASSERT(meshTarget.vecFaceArea.GetRows() == meshTarget.faces.size());
 
-		for (int i = 0; i < meshOverlap.faces.size(); i++) {
-			dSourceArea[ meshOverlap.vecSourceFaceIx[i] ] += meshOverlap.vecFaceArea[i];
-			dTargetArea[ meshOverlap.vecTargetFaceIx[i] ] += meshOverlap.vecFaceArea[i];
-		}
-
 		for (int i = 0; i < meshSource.faces.size(); i++) {
 			if (fabs(dSourceArea[i] - meshSource.vecFaceArea[i]) < 1.0e-10) {
 				meshSource.vecFaceArea[i] = dSourceArea[i];
@@ -407,14 +476,43 @@ try {
 		AnnounceEndBlock(NULL);
 	}
 */
+	// Triangulate the overlap mesh once for all quadrature-based remap
+	// routines (a no-op if the overlap mesh has already been triangulated)
+	if (strMapAlgorithm != "invdist") {
+		meshOverlap.ConstructTriangulation();
+	}
+
+	// Spill map weights to disk as they are computed, or once they exceed
+	// the memory limit
+	{
+		const size_t sMemoryLimitBytes =
+			GetPerformanceOptions().sMemoryLimitBytes;
+
+		if (sMemoryLimitBytes != 0) {
+			mapRemap.GetSparseMatrix().SetSpillDirectory(
+				(optsAlg.strSpillDir != "")
+					?(optsAlg.strSpillDir)
+					:(GetDefaultSpillDirectory()),
+				sMemoryLimitBytes);
+
+		} else if (optsAlg.strSpillDir != "") {
+			mapRemap.GetSparseMatrix().SetSpillDirectory(optsAlg.strSpillDir);
+		}
+	}
+
 	// Finite volume input / Finite volume output
 	if ((eSourceType  == DiscretizationType_FV) &&
 		(eTargetType == DiscretizationType_FV)
 	) {
 
 		// Generate reverse node array and edge map
-		meshSource.ConstructReverseNodeArray();
-		meshSource.ConstructEdgeMap();
+		if (pctxSource != NULL) {
+			pctxSource->RequireReverseNodeArray();
+			pctxSource->RequireEdgeMap();
+		} else {
+			meshSource.ConstructReverseNodeArray();
+			meshSource.ConstructEdgeMap();
+		}
 
 		// Initialize coordinates for map
 		mapRemap.InitializeSourceCoordinatesFromMeshFV(meshSource);
@@ -431,12 +529,38 @@ try {
 
 		} else {
 			AnnounceStartBlock("Calculating offline map (default)");
-			LinearRemapFVtoFV(
-				meshSource,
-				meshTarget,
-				meshOverlap,
-				(optsAlg.fMonotone)?(1):(optsAlg.nPin),
-				mapRemap);
+			if (optsAlg.strStencilCacheDir != "") {
+				FiniteVolumeStencilCache cacheStencil(optsAlg.strStencilCacheDir);
+
+				LinearRemapFVtoFV(
+					meshSource,
+					meshTarget,
+					meshOverlap,
+					(optsAlg.fMonotone)?(1):(optsAlg.nPin),
+					mapRemap,
+					&cacheStencil,
+					optsAlg.dQuadratureTolerance);
+
+			} else if (pctxSource != NULL) {
+				LinearRemapFVtoFV(
+					meshSource,
+					meshTarget,
+					meshOverlap,
+					(optsAlg.fMonotone)?(1):(optsAlg.nPin),
+					mapRemap,
+					&(pctxSource->GetStencilCache()),
+					optsAlg.dQuadratureTolerance);
+
+			} else {
+				LinearRemapFVtoFV(
+					meshSource,
+					meshTarget,
+					meshOverlap,
+					(optsAlg.fMonotone)?(1):(optsAlg.nPin),
+					mapRemap,
+					NULL,
+					optsAlg.dQuadratureTolerance);
+			}
 		}
 
 	// Finite volume input / Finite element output
@@ -452,7 +576,8 @@ try {
 		} else {
 			AnnounceStartBlock("Generating output mesh meta data");
 			double dNumericalArea =
-				GenerateMetaData(
+				GenerateMetaDataWithContext(
+					pctxTarget,
 					meshTarget,
 					optsAlg.nPout,
 					optsAlg.fNoBubble,
@@ -484,8 +609,13 @@ try {
 		}
 
 		// Generate reverse node array and edge map
-		meshSource.ConstructReverseNodeArray();
-		meshSource.ConstructEdgeMap();
+		if (pctxSource != NULL) {
+			pctxSource->RequireReverseNodeArray();
+			pctxSource->RequireEdgeMap();
+		} else {
+			meshSource.ConstructReverseNodeArray();
+			meshSource.ConstructEdgeMap();
+		}
 
 		// Generate remap weights
 		if (strMapAlgorithm == "volumetric") {
@@ -516,7 +646,8 @@ try {
 				mapRemap,
 				nMonotoneType,
 				fContinuous,
-				optsAlg.fNoConservation);
+				optsAlg.fNoConservation,
+				optsAlg.dQuadratureTolerance);
 		}
 
 	// Finite element input / Finite volume output
@@ -535,7 +666,8 @@ try {
 		} else {
 			AnnounceStartBlock("Generating input mesh meta data");
 			double dNumericalArea =
-				GenerateMetaData(
+				GenerateMetaDataWithContext(
+					pctxSource,
 					meshSource,
 					optsAlg.nPin,
 					optsAlg.fNoBubble,
@@ -589,7 +721,8 @@ try {
 			fContinuousIn,
 			optsAlg.fNoConservation,
 			optsAlg.fSparseConstraints,
-			mapRemap
+			mapRemap,
+			optsAlg.dQuadratureTolerance
 		);
 
 	// Finite element input / Finite element output
@@ -613,7 +746,8 @@ try {
 		} else {
 			AnnounceStartBlock("Generating input mesh meta data");
 			double dNumericalAreaIn =
-				GenerateMetaData(
+				GenerateMetaDataWithContext(
+					pctxSource,
 					meshSource,
 					optsAlg.nPin,
 					optsAlg.fNoBubble,
@@ -639,7 +773,8 @@ try {
 		} else {
 			AnnounceStartBlock("Generating output mesh meta data");
 			double dNumericalAreaOut =
-				GenerateMetaData(
+				GenerateMetaDataWithContext(
+					pctxTarget,
 					meshTarget,
 					optsAlg.nPout,
 					optsAlg.fNoBubble,
@@ -719,6 +854,13 @@ try {
 	Announce("Map generation complete");
 	AnnounceEndBlock(NULL);
 
+	// Merge spilled map weights directly into CSR form
+	if (mapRemap.GetSparseMatrix().HasSpilledEntries()) {
+		AnnounceStartBlock("Merging spilled map weights");
+		mapRemap.GetSparseMatrix().Finalize();
+		AnnounceEndBlock("Done");
+	}
+
 	// Verify consistency, conservation and monotonicity
 	if (!optsAlg.fNoCheck) {
 		mapRemap.CheckMap(
@@ -730,6 +872,11 @@ try {
 			dTotalAreaOverlap);
 	}
 
+	// The map is written from the same CSR arrays that are then applied
+	if (optsAlg.fFinalizeMap) {
+		mapRemap.GetSparseMatrix().Finalize();
+	}
+
 	// Output the Offline Map
 	if (optsAlg.strOutputMapFile != "") {
 		AnnounceStartBlock("Writing offline map");
@@ -764,6 +911,7 @@ try {
 		mapAttributes.insert(AttributePair("method", optsAlg.strMethod));
 		mapAttributes.insert(AttributePair("version", g_strVersion));
 
+		mapRemap.SetWriteVertexArrays(!optsAlg.fOutputNoVertices);
 		mapRemap.Write(optsAlg.strOutputMapFile, mapAttributes, eOutputFormat);
 		AnnounceEndBlock("Done");
 		AnnounceBanner();
@@ -782,6 +930,256 @@ try {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+extern "C"
+int GenerateOfflineMapWithMeshes (
+	Mesh & meshSource,
+	Mesh & meshTarget,
+	Mesh & meshOverlap,
+	std::string strSourceType,
+	std::string strTargetType,
+	const GenerateOfflineMapAlgorithmOptions & optsAlg,
+	OfflineMap & mapRemap
+) {
+	return
+		GenerateOfflineMapWithMeshesAndContexts(
+			meshSource,
+			meshTarget,
+			meshOverlap,
+			strSourceType,
+			strTargetType,
+			optsAlg,
+			mapRemap,
+			NULL,
+			NULL);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+extern "C"
+int GenerateOfflineMapWithContexts (
+	RemapMeshContext & ctxSource,
+	RemapMeshContext & ctxTarget,
+	Mesh & meshOverlap,
+	std::string strSourceType,
+	std::string strTargetType,
+	const GenerateOfflineMapAlgorithmOptions & optsAlg,
+	OfflineMap & mapRemap
+) {
+	if (ctxSource.IsConcave() != optsAlg.fSourceConcave) {
+		Announce("WARNING: --in_concave does not match the source mesh context");
+	}
+	if (ctxTarget.IsConcave() != optsAlg.fTargetConcave) {
+		Announce("WARNING: --out_concave does not match the target mesh context");
+	}
+
+	return
+		GenerateOfflineMapWithMeshesAndContexts(
+			ctxSource.GetMesh(),
+			ctxTarget.GetMesh(),
+			meshOverlap,
+			strSourceType,
+			strTargetType,
+			optsAlg,
+			mapRemap,
+			&ctxSource,
+			&ctxTarget);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Generate the overlap mesh between input and output meshes in memory,
+///		or read it from the overlap mesh cache.  If RemapMeshContexts are
+///		given, the meshes they hold for overlap mesh generation (convexified
+///		and with edge maps) are used rather than being rebuilt.
+///	</summary>
+static void GenerateOverlapMeshForMap(
+	Mesh & meshSource,
+	Mesh & meshTarget,
+	const GenerateOfflineMapAlgorithmOptions & optsAlg,
+	Mesh & meshOverlap,
+	RemapMeshContext * pctxSource,
+	RemapMeshContext * pctxTarget
+) {
+	// Overlap mesh method
+	std::string strOverlapMethod = optsAlg.strOverlapMethod;
+	STLStringHelper::ToLower(strOverlapMethod);
+
+	OverlapMeshMethod method;
+	if (strOverlapMethod == "fuzzy") {
+		method = OverlapMeshMethod_Fuzzy;
+	} else if (strOverlapMethod == "exact") {
+		method = OverlapMeshMethod_Exact;
+	} else if (strOverlapMethod == "mixed") {
+		method = OverlapMeshMethod_Mixed;
+	} else if (strOverlapMethod == "clip") {
+		method = OverlapMeshMethod_Clip;
+	} else {
+		_EXCEPTION1("Invalid \"ov_method\" value (%s), expected [fuzzy|exact|mixed|clip]",
+			optsAlg.strOverlapMethod.c_str());
+	}
+
+	meshOverlap.type = Mesh::MeshType_Overlap;
+
+	// Look up the overlap mesh in the cache, keyed by the source and target
+	// meshes and the options affecting the overlap
+	bool fCachedOverlap = false;
+
+	std::unique_ptr<OverlapMeshCache> pcacheOverlap;
+	if (optsAlg.strOverlapCacheDir != "") {
+		std::string strKey = strOverlapMethod;
+		if (optsAlg.fSourceConcave) {
+			strKey += "_inconcave";
+		}
+		if (optsAlg.fTargetConcave) {
+			strKey += "_outconcave";
+		}
+		if (optsAlg.fAllowNoOverlap) {
+			strKey += "_allownooverlap";
+		}
+		if (optsAlg.fOverlapTargetMajor) {
+			strKey += "_targetmajor";
+		}
+
+		pcacheOverlap.reset(
+			new OverlapMeshCache(
+				optsAlg.strOverlapCacheDir,
+				meshSource,
+				meshTarget,
+				strKey));
+
+		if (pcacheOverlap->Read(meshOverlap)) {
+			Announce("Read overlap mesh from cache \"%s\"",
+				pcacheOverlap->GetCacheFileName().c_str());
+			fCachedOverlap = true;
+		}
+	}
+
+	if (!fCachedOverlap) {
+		// Concave meshes are subdivided into convex faces for the overlap
+		// computation; overlap faces refer back to the original faces through
+		// the MultiFaceMap of the convexified mesh
+		Mesh meshSourceConvex;
+		Mesh meshTargetConvex;
+
+		Mesh * pmeshA = &meshSource;
+		if (pctxSource != NULL) {
+			pmeshA = &(pctxSource->GetMeshForOverlap());
+		} else if (optsAlg.fSourceConcave) {
+			ConvexifyMesh(meshSource, meshSourceConvex, false);
+			pmeshA = &meshSourceConvex;
+		}
+
+		Mesh * pmeshB = &meshTarget;
+		if (pctxTarget != NULL) {
+			pmeshB = &(pctxTarget->GetMeshForOverlap());
+		} else if (optsAlg.fTargetConcave) {
+			ConvexifyMesh(meshTarget, meshTargetConvex, false);
+			pmeshB = &meshTargetConvex;
+		}
+
+		Mesh & meshA = *pmeshA;
+		Mesh & meshB = *pmeshB;
+
+		AnnounceStartBlock("Construct overlap mesh");
+
+		// Overlaps of rectilinear lat-lon meshes are computed directly
+		bool fRectilinearOverlap = false;
+		if (!optsAlg.fSourceConcave && !optsAlg.fTargetConcave) {
+			fRectilinearOverlap =
+				GenerateOverlapMeshRLL(meshA, meshB, meshOverlap);
+		}
+
+		if (!fRectilinearOverlap) {
+
+			// Construct the edge map on both meshes
+			if (meshA.edgemap.size() == 0) {
+				AnnounceStartBlock("Constructing edge map on input mesh");
+				meshA.ConstructEdgeMap();
+				AnnounceEndBlock(NULL);
+			}
+			if (meshB.edgemap.size() == 0) {
+				AnnounceStartBlock("Constructing edge map on output mesh");
+				meshB.ConstructEdgeMap();
+				AnnounceEndBlock(NULL);
+			}
+
+			GenerateOverlapMesh_v2(
+				meshA,
+				meshB,
+				meshOverlap,
+				method,
+				optsAlg.fAllowNoOverlap,
+				false,
+				optsAlg.fOverlapTargetMajor,
+				optsAlg.strOverlapCheckpointDir);
+		}
+		AnnounceEndBlock(NULL);
+
+		// Release the convexified meshes prior to map generation
+		meshSourceConvex.Clear();
+		meshTargetConvex.Clear();
+
+		// Store the overlap mesh, with Face areas, in the cache
+		if (pcacheOverlap != NULL) {
+			if (meshOverlap.vecFaceArea.GetRows() != meshOverlap.faces.size()) {
+				meshOverlap.CalculateFaceAreas(false);
+			}
+			pcacheOverlap->Write(meshOverlap);
+			Announce("Wrote overlap mesh to cache \"%s\"",
+				pcacheOverlap->GetCacheFileName().c_str());
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+extern "C"
+int GenerateOverlapAndOfflineMapWithMeshes (
+	Mesh & meshSource,
+	Mesh & meshTarget,
+	std::string strSourceType,
+	std::string strTargetType,
+	const GenerateOfflineMapAlgorithmOptions & optsAlg,
+	OfflineMap & mapRemap
+) {
+	NcError error(NcError::silent_nonfatal);
+
+try {
+
+	// Generate the overlap mesh, which is passed directly to map generation
+	// rather than written to disk and read back
+	Mesh meshOverlap;
+
+	GenerateOverlapMeshForMap(
+		meshSource,
+		meshTarget,
+		optsAlg,
+		meshOverlap,
+		NULL,
+		NULL);
+
+	return
+		GenerateOfflineMapWithMeshes(
+			meshSource,
+			meshTarget,
+			meshOverlap,
+			strSourceType,
+			strTargetType,
+			optsAlg,
+			mapRemap);
+
+} catch(Exception & e) {
+	Announce(e.ToString().c_str());
+	return (0);
+
+} catch(...) {
+	return (0);
+}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 extern "C" 
 int GenerateOfflineMap (
 	std::string strSourceMesh,
@@ -811,11 +1209,6 @@ try {
 		_EXCEPTIONT("No output mesh (--out_mesh) specified");
 	}
 
-	// Overlap mesh
-	if (strOverlapMesh == "") {
-		_EXCEPTIONT("No overlap mesh specified");
-	}
-
 	// Initialize dimension information from file
 	AnnounceStartBlock("Initializing dimensions of map");
 	Announce("Input mesh");
@@ -836,6 +1229,25 @@ try {
 	meshTarget.RemoveZeroEdges();
 	AnnounceEndBlock(NULL);
 
+	// Generate the overlap mesh in memory if no overlap mesh file is given
+	if (strOverlapMesh == "") {
+		Announce("No overlap mesh specified; generating overlap mesh in memory");
+
+		int err =
+			GenerateOverlapAndOfflineMapWithMeshes(
+				meshSource,
+				meshTarget,
+				strSourceType,
+				strTargetType,
+				optsAlg,
+				mapRemap);
+
+		// Coordinates may refer to the meshes, which are released on return
+		mapRemap.ResolveCoordinates();
+
+		return err;
+	}
+
 	// Load overlap mesh
 	AnnounceStartBlock("Loading overlap mesh");
 	Mesh meshOverlap(strOverlapMesh);
@@ -851,6 +1263,9 @@ try {
 			optsAlg,
 			mapRemap);
 
+	// Coordinates may refer to the meshes, which are released on return
+	mapRemap.ResolveCoordinates();
+
 	return err;
 
 } catch(Exception & e) {
@@ -864,6 +1279,122 @@ try {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+extern "C"
+int GenerateOfflineMapMultiTarget (
+	std::string strSourceMesh,
+	std::string strTargetMeshList,
+	std::string strOutputMapList,
+	std::string strSourceType,
+	std::string strTargetType,
+	const GenerateOfflineMapAlgorithmOptions & optsAlg
+) {
+	NcError error(NcError::silent_nonfatal);
+
+try {
+
+	// Check command line parameters (mesh arguments)
+	if (strSourceMesh == "") {
+		_EXCEPTIONT("No input mesh (--in_mesh) specified");
+	}
+	if (strTargetMeshList == "") {
+		_EXCEPTIONT("No output mesh list (--out_mesh_list) specified");
+	}
+	if (strOutputMapList == "") {
+		_EXCEPTIONT("--out_mesh_list specified without --out_map_list");
+	}
+	if (optsAlg.strTargetMeta != "") {
+		_EXCEPTIONT("--out_meta cannot be used with --out_mesh_list");
+	}
+
+	std::vector<std::string> vecTargetMeshFiles;
+	std::vector<std::string> vecOutputMapFiles;
+
+	STLStringHelper::ParseFileList(strTargetMeshList, vecTargetMeshFiles);
+	STLStringHelper::ParseFileList(strOutputMapList, vecOutputMapFiles);
+
+	if (vecTargetMeshFiles.size() != vecOutputMapFiles.size()) {
+		_EXCEPTIONT("Mismatch in --out_mesh_list and --out_map_list file length");
+	}
+
+	// Load the input mesh once and build the structures derived from it
+	// that do not depend on the output mesh.  Each map is generated with
+	// all threads, one after another, since map generation temporarily
+	// replaces the Face areas of the input mesh.
+	AnnounceStartBlock("Loading input mesh");
+	RemapMeshContext ctxSource(strSourceMesh, optsAlg.fSourceConcave);
+	AnnounceEndBlock(NULL);
+
+	AnnounceStartBlock("Preparing input mesh");
+	ctxSource.RequireFaceAreas();
+	ctxSource.RequireReverseNodeArray();
+	ctxSource.GetMeshForOverlap();
+
+	std::string strSourceTypeLower = strSourceType;
+	STLStringHelper::ToLower(strSourceTypeLower);
+	if ((strSourceTypeLower != "fv") && (optsAlg.strSourceMeta == "")) {
+		DataArray3D<int> dataGLLNodes;
+		DataArray3D<double> dataGLLJacobian;
+		ctxSource.GetGLLMetaData(
+			optsAlg.nPin, optsAlg.fNoBubble, dataGLLNodes, dataGLLJacobian);
+	}
+	AnnounceEndBlock(NULL);
+
+	const int nTargets = vecTargetMeshFiles.size();
+
+	for (int t = 0; t < nTargets; t++) {
+		AnnounceStartBlock("Output mesh %i of %i: \"%s\"",
+			t+1, nTargets, vecTargetMeshFiles[t].c_str());
+
+		GenerateOfflineMapAlgorithmOptions optsTarget = optsAlg;
+		optsTarget.strOutputMapFile = vecOutputMapFiles[t];
+
+		OfflineMap mapRemap;
+		mapRemap.InitializeSourceDimensionsFromFile(strSourceMesh);
+		mapRemap.InitializeTargetDimensionsFromFile(vecTargetMeshFiles[t]);
+
+		RemapMeshContext ctxTarget(
+			vecTargetMeshFiles[t], optsAlg.fTargetConcave);
+
+		Mesh meshOverlap;
+
+		GenerateOverlapMeshForMap(
+			ctxSource.GetMesh(),
+			ctxTarget.GetMesh(),
+			optsTarget,
+			meshOverlap,
+			&ctxSource,
+			&ctxTarget);
+
+		int err =
+			GenerateOfflineMapWithContexts(
+				ctxSource,
+				ctxTarget,
+				meshOverlap,
+				strSourceType,
+				strTargetType,
+				optsTarget,
+				mapRemap);
+
+		if (err != 0) {
+			return err;
+		}
+
+		AnnounceEndBlock(NULL);
+	}
+
+	return (0);
+
+} catch(Exception & e) {
+	Announce(e.ToString().c_str());
+	return (-1);
+
+} catch(...) {
+	return (-2);
+}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 extern "C"
 int GenerateOfflineMapAndApply (
 	std::string strSourceMesh,
@@ -898,9 +1429,39 @@ try {
 	if ((optsApply.strInputData == "") && (optsApply.strOutputData != "")) {
 		_EXCEPTIONT("--out_data specified without --in_data");
 	}
+	if ((optsApply.strInputDataList != "") && (optsApply.strOutputDataList == "")) {
+		_EXCEPTIONT("--in_data_list specified without --out_data_list");
+	}
+	if ((optsApply.strInputDataList == "") && (optsApply.strOutputDataList != "")) {
+		_EXCEPTIONT("--out_data_list specified without --in_data_list");
+	}
+	if ((optsApply.strInputData != "") && (optsApply.strInputDataList != "")) {
+		_EXCEPTIONT("Only one of --in_data or --in_data_list may be specified");
+	}
+
+	// Load input and output file lists
+	std::vector<std::string> vecInputDataFiles;
+	std::vector<std::string> vecOutputDataFiles;
+
+	if (optsApply.strInputData != "") {
+		vecInputDataFiles.push_back(optsApply.strInputData);
+		vecOutputDataFiles.push_back(optsApply.strOutputData);
+
+	} else if (optsApply.strInputDataList != "") {
+		STLStringHelper::ParseFileList(optsApply.strInputDataList, vecInputDataFiles);
+		STLStringHelper::ParseFileList(optsApply.strOutputDataList, vecOutputDataFiles);
+
+		if (vecInputDataFiles.size() != vecOutputDataFiles.size()) {
+			_EXCEPTIONT("Mismatch in --in_data_list and --out_data_list file length");
+		}
+	}
+
+	// Generate OfflineMap, which is applied directly from memory
+	GenerateOfflineMapAlgorithmOptions optsGenerate = optsAlg;
+	if (vecInputDataFiles.size() != 0) {
+		optsGenerate.fFinalizeMap = true;
+	}
 
-	// Generate OfflineMap
-	OfflineMap mapRemap;
 	int err =
 		GenerateOfflineMap(
 			strSourceMesh,
@@ -908,48 +1469,59 @@ try {
 			strOverlapMesh,
 			strSourceType,
 			strTargetType,
-			optsAlg,
+			optsGenerate,
 			mapRemap);
 
 	if (err != 0) return err;
 
 	// Apply OfflineMap to data
-	if (optsApply.strInputData != "") {
+	if (vecInputDataFiles.size() != 0) {
 		AnnounceStartBlock("Applying offline map to data");
 
 		mapRemap.SetFillValueOverrideDbl(optsApply.dFillValueOverride);
 		mapRemap.SetFillValueOverride(static_cast<float>(optsApply.dFillValueOverride));
+	}
+
+	for (int f = 0; f < vecInputDataFiles.size(); f++) {
+		if (vecInputDataFiles.size() > 1) {
+			AnnounceStartBlock("Processing \"%s\"", vecInputDataFiles[f].c_str());
+		}
+
 		mapRemap.Apply(
-			optsApply.strInputData,
-			optsApply.strOutputData,
+			vecInputDataFiles[f],
+			vecOutputDataFiles[f],
 			vecVariableStrings,
 			optsApply.strNColName,
 			optsApply.fOutputDouble,
 			false);
 
-		AnnounceEndBlock("Done");
-	}
-	AnnounceEndBlock(NULL);
-
-	// Copy variables from input file to output file
-	if ((optsApply.strInputData != "") && (optsApply.strOutputData != "")) {
+		// Copy variables from input file to output file
 		if (optsApply.fPreserveAll) {
 			AnnounceStartBlock("Preserving variables");
 			mapRemap.PreserveAllVariables(
-				optsApply.strInputData,
-				optsApply.strOutputData);
+				vecInputDataFiles[f],
+				vecOutputDataFiles[f]);
 			AnnounceEndBlock("Done");
 
 		} else if (vecPreserveVariableStrings.size() != 0) {
 			AnnounceStartBlock("Preserving variables");
 			mapRemap.PreserveVariables(
-				optsApply.strInputData,
-				optsApply.strOutputData,
+				vecInputDataFiles[f],
+				vecOutputDataFiles[f],
 				vecPreserveVariableStrings);
 			AnnounceEndBlock("Done");
 		}
+
+		if (vecInputDataFiles.size() > 1) {
+			AnnounceEndBlock("Done");
+		}
 	}
 
+	if (vecInputDataFiles.size() != 0) {
+		AnnounceEndBlock("Done");
+	}
+	AnnounceEndBlock(NULL);
+
 	return (0);
 
 } catch(Exception & e) {
@@ -974,6 +1546,12 @@ int main(int argc, char** argv) {
 	// Output mesh file
 	std::string strTargetMesh;
 
+	// List of output mesh files
+	std::string strTargetMeshList;
+
+	// List of output map files
+	std::string strOutputMapList;
+
 	// Overlap mesh file
 	std::string strOverlapMesh;
 
@@ -996,12 +1574,14 @@ int main(int argc, char** argv) {
 	BeginCommandLine()
 		CommandLineString(strSourceMesh, "in_mesh", "");
 		CommandLineString(strTargetMesh, "out_mesh", "");
+		CommandLineString(strTargetMeshList, "out_mesh_list", "");
 		CommandLineString(strOverlapMesh, "ov_mesh", "");
 		CommandLineStringD(strSourceType, "in_type", "fv", "[fv|cgll|dgll]");
 		CommandLineStringD(strTargetType, "out_type", "fv", "[fv|cgll|dgll]");
 
 		// Optional algorithm arguments
 		CommandLineString(optsAlg.strOutputMapFile, "out_map", "");
+		CommandLineString(strOutputMapList, "out_map_list", "");
 		CommandLineString(optsAlg.strSourceMeta, "in_meta", "");
 		CommandLineString(optsAlg.strTargetMeta, "out_meta", "");
 		CommandLineBool(optsAlg.fSourceConcave, "in_concave");
@@ -1015,6 +1595,12 @@ int main(int argc, char** argv) {
 		CommandLineBool(optsAlg.fNoConservation, "noconserve");
 		CommandLineBool(optsAlg.fNoCheck, "nocheck");
 		CommandLineBool(optsAlg.fSparseConstraints, "sparse_constraints");
+		CommandLineString(optsAlg.strStencilCacheDir, "fv_stencil_cache", "");
+		CommandLineStringD(optsAlg.strOverlapMethod, "ov_method", "fuzzy", "(fuzzy|exact|mixed|clip) [unless both meshes are RLL with constant latitude edges]");
+		CommandLineBool(optsAlg.fAllowNoOverlap, "allow_no_overlap");
+		CommandLineString(optsAlg.strOverlapCacheDir, "ov_cache", "");
+		CommandLineBool(optsAlg.fOverlapTargetMajor, "ov_target_major");
+		CommandLineString(optsAlg.strOverlapCheckpointDir, "ov_checkpoint_dir", "");
 
 		// Absorbed into --method
 		//CommandLineBool(fVolumetric, "volumetric");
@@ -1024,8 +1610,8 @@ int main(int argc, char** argv) {
 		// Optional apply arguments
 		CommandLineString(optsApply.strInputData, "in_data", "");
 		CommandLineString(optsApply.strOutputData, "out_data", "");
-		//CommandLineString(optsApply.strInputDataList, "in_data_list", "");
-		//CommandLineString(optsApply.strOutputDataList, "out_data_list", "");
+		CommandLineString(optsApply.strInputDataList, "in_data_list", "");
+		CommandLineString(optsApply.strOutputDataList, "out_data_list", "");
 		CommandLineString(optsApply.strVariables, "var", "");
 		CommandLineString(optsApply.strNColName, "ncol_name", "ncol");
 		CommandLineBool(optsApply.fOutputDouble, "out_double");
@@ -1036,6 +1622,11 @@ int main(int argc, char** argv) {
 
 		// Optional output format
 		CommandLineStringD(strOutputFormat, "out_format","Netcdf4","[Classic|Offset64Bits|Netcdf4|Netcdf4Classic]");
+		CommandLineIntD(optsAlg.iOutputDeflateLevel, "out_deflate", 0, "(0-9)");
+		CommandLineBool(optsAlg.fOutputNoVertices, "out_novertices");
+		CommandLineInt(optsAlg.nOutputChunkKB, "out_chunk_kb", 0);
+		CommandLineDouble(optsAlg.dQuadratureTolerance, "quad_tol", 0.0);
+		CommandLineString(optsAlg.strSpillDir, "spill_dir", "");
 
 		ParseCommandLine(argc, argv);
 	EndCommandLine(argv)
@@ -1046,6 +1637,30 @@ int main(int argc, char** argv) {
 	optsAlg.strOutputFormat = strOutputFormat;
 	optsApply.strOutputFormat = strOutputFormat;
 
+	// Generate maps to several output meshes from one input mesh
+	if (strTargetMeshList != "") {
+		if ((strTargetMesh != "") || (strOverlapMesh != "") ||
+		    (optsApply.strInputData != "") || (optsApply.strInputDataList != "")
+		) {
+			Announce("ERROR: --out_mesh_list cannot be used with --out_mesh, "
+				"--ov_mesh, --in_data or --in_data_list");
+			exit(-1);
+		}
+
+		int err =
+			GenerateOfflineMapMultiTarget(
+				strSourceMesh,
+				strTargetMeshList,
+				strOutputMapList,
+				strSourceType,
+				strTargetType,
+				optsAlg);
+
+		if (err) exit(err);
+
+		return 0;
+	}
+
 	// Call the actual mesh generator
 	OfflineMap mapRemap;
 	int err =
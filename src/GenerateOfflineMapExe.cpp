@@ -33,6 +33,12 @@ int main(int argc, char** argv) {
 	// Output mesh file
 	std::string strTargetMesh;
 
+	// List of output mesh files
+	std::string strTargetMeshList;
+
+	// List of output map files
+	std::string strOutputMapList;
+
 	// Overlap mesh file
 	std::string strOverlapMesh;
 
@@ -55,12 +61,14 @@ int main(int argc, char** argv) {
 	BeginCommandLine()
 		CommandLineString(strSourceMesh, "in_mesh", "");
 		CommandLineString(strTargetMesh, "out_mesh", "");
+		CommandLineString(strTargetMeshList, "out_mesh_list", "");
 		CommandLineString(strOverlapMesh, "ov_mesh", "");
 		CommandLineStringD(strSourceType, "in_type", "fv", "[fv|cgll|dgll]");
 		CommandLineStringD(strTargetType, "out_type", "fv", "[fv|cgll|dgll]");
 
 		// Optional algorithm arguments
 		CommandLineString(optsAlg.strOutputMapFile, "out_map", "");
+		CommandLineString(strOutputMapList, "out_map_list", "");
 		CommandLineString(optsAlg.strSourceMeta, "in_meta", "");
 		CommandLineString(optsAlg.strTargetMeta, "out_meta", "");
 		CommandLineBool(optsAlg.fSourceConcave, "in_concave");
@@ -74,6 +82,12 @@ int main(int argc, char** argv) {
 		CommandLineBool(optsAlg.fNoConservation, "noconserve");
 		CommandLineBool(optsAlg.fNoCheck, "nocheck");
 		CommandLineBool(optsAlg.fSparseConstraints, "sparse_constraints");
+		CommandLineString(optsAlg.strStencilCacheDir, "fv_stencil_cache", "");
+		CommandLineStringD(optsAlg.strOverlapMethod, "ov_method", "fuzzy", "(fuzzy|exact|mixed|clip)");
+		CommandLineBool(optsAlg.fAllowNoOverlap, "allow_no_overlap");
+		CommandLineString(optsAlg.strOverlapCacheDir, "ov_cache", "");
+		CommandLineBool(optsAlg.fOverlapTargetMajor, "ov_target_major");
+		CommandLineString(optsAlg.strOverlapCheckpointDir, "ov_checkpoint_dir", "");
 
 		// Absorbed into --method
 		//CommandLineBool(fVolumetric, "volumetric");
@@ -83,8 +97,8 @@ int main(int argc, char** argv) {
 		// Optional apply arguments
 		CommandLineString(optsApply.strInputData, "in_data", "");
 		CommandLineString(optsApply.strOutputData, "out_data", "");
-		//CommandLineString(optsApply.strInputDataList, "in_data_list", "");
-		//CommandLineString(optsApply.strOutputDataList, "out_data_list", "");
+		CommandLineString(optsApply.strInputDataList, "in_data_list", "");
+		CommandLineString(optsApply.strOutputDataList, "out_data_list", "");
 		CommandLineString(optsApply.strVariables, "var", "");
 		CommandLineString(optsApply.strNColName, "ncol_name", "ncol");
 		CommandLineBool(optsApply.fOutputDouble, "out_double");
@@ -95,6 +109,11 @@ int main(int argc, char** argv) {
 
 		// Optional output format
 		CommandLineStringD(strOutputFormat, "out_format","Netcdf4","[Classic|Offset64Bits|Netcdf4|Netcdf4Classic]");
+		CommandLineIntD(optsAlg.iOutputDeflateLevel, "out_deflate", 0, "(0-9)");
+		CommandLineBool(optsAlg.fOutputNoVertices, "out_novertices");
+		CommandLineInt(optsAlg.nOutputChunkKB, "out_chunk_kb", 0);
+		CommandLineDouble(optsAlg.dQuadratureTolerance, "quad_tol", 0.0);
+		CommandLineString(optsAlg.strSpillDir, "spill_dir", "");
 
 		ParseCommandLine(argc, argv);
 	EndCommandLine(argv)
@@ -105,6 +124,30 @@ int main(int argc, char** argv) {
 	optsAlg.strOutputFormat = strOutputFormat;
 	optsApply.strOutputFormat = strOutputFormat;
 
+	// Generate maps to several output meshes from one input mesh
+	if (strTargetMeshList != "") {
+		if ((strTargetMesh != "") || (strOverlapMesh != "") ||
+		    (optsApply.strInputData != "") || (optsApply.strInputDataList != "")
+		) {
+			Announce("ERROR: --out_mesh_list cannot be used with --out_mesh, "
+				"--ov_mesh, --in_data or --in_data_list");
+			exit(-1);
+		}
+
+		int err =
+			GenerateOfflineMapMultiTarget(
+				strSourceMesh,
+				strTargetMeshList,
+				strOutputMapList,
+				strSourceType,
+				strTargetType,
+				optsAlg);
+
+		if (err) exit(err);
+
+		return 0;
+	}
+
 	// Call the actual mesh generator
 	OfflineMap mapRemap;
 	int err =
@@ -20,12 +20,17 @@
 #include "Exception.h"
 #include "GridElements.h"
 #include "OverlapMesh.h"
+#include "RemapMeshContext.h"
 
 #include "netcdfcpp.h"
 #include "NetCDFUtilities.h"
 
 #include <cmath>
 
+#if defined(TEMPEST_MPIOMP)
+#include <mpi.h>
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 
 extern "C"
@@ -39,7 +44,9 @@ int GenerateOverlapWithMeshes (
 	const bool fHasConcaveFacesA,
 	const bool fHasConcaveFacesB,
 	const bool fAllowNoOverlap,
-	const bool fVerbose
+	const bool fVerbose,
+	const bool fTargetMajor,
+	std::string strCheckpointDir
 ) {
 
     NcError error ( NcError::silent_nonfatal );
@@ -73,6 +80,10 @@ int GenerateOverlapWithMeshes (
         {
             method = OverlapMeshMethod_Mixed;
         }
+        else if ( strMethod == "clip" )
+        {
+            method = OverlapMeshMethod_Clip;
+        }
         else
         {
             _EXCEPTIONT ( "Invalid \"method\" value" );
@@ -81,12 +92,26 @@ int GenerateOverlapWithMeshes (
         meshOverlap.type = Mesh::MeshType_Overlap;
 
         AnnounceStartBlock ( "Construct overlap mesh" );
-        GenerateOverlapMesh_v2 (
-			meshA, meshB,
-			meshOverlap,
-			method,
-			fAllowNoOverlap,
-			fVerbose );
+
+        // Overlaps of rectilinear lat-lon meshes are computed directly
+        bool fRectilinearOverlap = false;
+        if ( !fHasConcaveFacesA && !fHasConcaveFacesB )
+        {
+            fRectilinearOverlap =
+                GenerateOverlapMeshRLL ( meshA, meshB, meshOverlap );
+        }
+
+        if ( !fRectilinearOverlap )
+        {
+            GenerateOverlapMesh_v2 (
+				meshA, meshB,
+				meshOverlap,
+				method,
+				fAllowNoOverlap,
+				fVerbose,
+				fTargetMajor,
+				strCheckpointDir );
+        }
         AnnounceEndBlock ( NULL );
 
         /*
@@ -119,8 +144,24 @@ int GenerateOverlapWithMeshes (
             AnnounceEndBlock(NULL);
         */
 
-        // Write the overlap mesh
-        if ( strOverlapMesh.size() )
+        // Write the overlap mesh (only rank 0 holds the gathered mesh)
+        bool fWriteOverlapMesh = ( strOverlapMesh.size() != 0 );
+
+#if defined(TEMPEST_MPIOMP)
+        int fMPIInitialized = 0;
+        MPI_Initialized ( &fMPIInitialized );
+        if ( fMPIInitialized )
+        {
+            int nMPIRank;
+            MPI_Comm_rank ( MPI_COMM_WORLD, &nMPIRank );
+            if ( nMPIRank != 0 )
+            {
+                fWriteOverlapMesh = false;
+            }
+        }
+#endif
+
+        if ( fWriteOverlapMesh )
         {
             AnnounceStartBlock("Writing overlap mesh");
             meshOverlap.Write(strOverlapMesh.c_str(), eOutputFormat);
@@ -144,6 +185,48 @@ int GenerateOverlapWithMeshes (
 
 ///////////////////////////////////////////////////////////////////////////////
 
+extern "C"
+int GenerateOverlapWithContexts (
+	RemapMeshContext & ctxA,
+	RemapMeshContext & ctxB,
+	Mesh & meshOverlap,
+	std::string strOverlapMesh,
+	std::string strOutputFormat,
+	std::string strMethod,
+	const bool fAllowNoOverlap,
+	const bool fVerbose
+) {
+    try
+    {
+        return GenerateOverlapWithMeshes (
+			ctxA.GetMeshForOverlap(),
+			ctxB.GetMeshForOverlap(),
+			meshOverlap,
+			strOverlapMesh,
+			strOutputFormat,
+			strMethod,
+			ctxA.IsConcave(),
+			ctxB.IsConcave(),
+			fAllowNoOverlap,
+			fVerbose,
+			false,
+			"" );
+
+    }
+    catch ( Exception& e )
+    {
+        Announce ( e.ToString().c_str() );
+        return ( 0 );
+
+    }
+    catch ( ... )
+    {
+        return ( 0 );
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 extern "C"
 int GenerateOverlapMesh(
 	std::string strMeshA,
@@ -156,7 +239,13 @@ int GenerateOverlapMesh(
 	const bool fHasConcaveFacesA,
 	const bool fHasConcaveFacesB,
 	const bool fAllowNoOverlap,
-	const bool fVerbose
+	const bool fVerbose,
+	const bool fReorder,
+	std::string strPrevMeshA,
+	std::string strPrevMeshB,
+	std::string strPrevOverlapMesh,
+	const bool fTargetMajor,
+	std::string strCheckpointDir
 ) {
 
     NcError error ( NcError::silent_nonfatal );
@@ -174,6 +263,19 @@ int GenerateOverlapMesh(
 				strOutputFormat.c_str());
 		}
 
+		// Check incremental generation arguments
+		const bool fIncremental = (strPrevOverlapMesh != "");
+		if (fIncremental) {
+			if ((strPrevMeshA == "") || (strPrevMeshB == "")) {
+				_EXCEPTIONT("Incremental generation requires the previous "
+					"mesh A, mesh B and overlap mesh");
+			}
+			if (fHasConcaveFacesA || fHasConcaveFacesB) {
+				_EXCEPTIONT("Incremental generation does not support "
+					"concave meshes");
+			}
+		}
+
         // Load input mesh
         AnnounceStartBlock ( "Loading mesh A" );
         Mesh meshA ( strMeshA );
@@ -183,8 +285,15 @@ int GenerateOverlapMesh(
         // Convexify Mesh
         if ( fHasConcaveFacesA )
         {
-            Mesh meshTemp = meshA;
-            ConvexifyMesh ( meshTemp, meshA, fVerbose );
+            ConvexifyMesh ( meshA, fVerbose );
+        }
+
+        // Reorder mesh for locality
+        if ( fReorder )
+        {
+            AnnounceStartBlock ( "Reordering mesh A along space-filling curve" );
+            meshA.ReorderAlongSpaceFillingCurve();
+            AnnounceEndBlock ( NULL );
         }
 
         // Validate mesh
@@ -204,8 +313,15 @@ int GenerateOverlapMesh(
         // Convexify Mesh
         if ( fHasConcaveFacesB )
         {
-            Mesh meshTemp = meshB;
-            ConvexifyMesh ( meshTemp, meshB, fVerbose );
+            ConvexifyMesh ( meshB, fVerbose );
+        }
+
+        // Reorder mesh for locality
+        if ( fReorder )
+        {
+            AnnounceStartBlock ( "Reordering mesh B along space-filling curve" );
+            meshB.ReorderAlongSpaceFillingCurve();
+            AnnounceEndBlock ( NULL );
         }
 
         // Validate mesh
@@ -225,6 +341,83 @@ int GenerateOverlapMesh(
         meshB.ConstructEdgeMap();
         AnnounceEndBlock ( NULL );
 
+        // Update the previous overlap mesh
+        if ( fIncremental )
+        {
+            OverlapMeshMethod method;
+            STLStringHelper::ToLower ( strMethod );
+            if ( strMethod == "fuzzy" )
+            {
+                method = OverlapMeshMethod_Fuzzy;
+            }
+            else if ( strMethod == "exact" )
+            {
+                method = OverlapMeshMethod_Exact;
+            }
+            else if ( strMethod == "mixed" )
+            {
+                method = OverlapMeshMethod_Mixed;
+            }
+            else if ( strMethod == "clip" )
+            {
+                method = OverlapMeshMethod_Clip;
+            }
+            else
+            {
+                _EXCEPTIONT ( "Invalid \"method\" value" );
+            }
+
+            // The previous meshes are prepared as in the previous run, so
+            // that the parent indices of the previous overlap mesh apply
+            AnnounceStartBlock ( "Loading previous meshes" );
+            Mesh meshPrevA ( strPrevMeshA );
+            meshPrevA.RemoveZeroEdges();
+            Mesh meshPrevB ( strPrevMeshB );
+            meshPrevB.RemoveZeroEdges();
+            if ( fReorder )
+            {
+                meshPrevA.ReorderAlongSpaceFillingCurve();
+                meshPrevB.ReorderAlongSpaceFillingCurve();
+            }
+            Mesh meshPrevOverlap ( strPrevOverlapMesh );
+            AnnounceEndBlock ( NULL );
+
+            AnnounceStartBlock ( "Construct overlap mesh incrementally" );
+            GenerateOverlapMeshIncremental (
+				meshA, meshB,
+				meshPrevA, meshPrevB, meshPrevOverlap,
+				meshOverlap,
+				method,
+				fAllowNoOverlap,
+				fVerbose );
+            AnnounceEndBlock ( NULL );
+
+            bool fWriteOverlapMesh = ( strOverlapMesh.size() != 0 );
+
+#if defined(TEMPEST_MPIOMP)
+            int fMPIInitialized = 0;
+            MPI_Initialized ( &fMPIInitialized );
+            if ( fMPIInitialized )
+            {
+                int nMPIRank;
+                MPI_Comm_rank ( MPI_COMM_WORLD, &nMPIRank );
+                if ( nMPIRank != 0 )
+                {
+                    fWriteOverlapMesh = false;
+                }
+            }
+#endif
+
+            if ( fWriteOverlapMesh )
+            {
+                AnnounceStartBlock("Writing overlap mesh");
+                meshOverlap.Write(strOverlapMesh.c_str(), eOutputFormat);
+                AnnounceEndBlock(NULL);
+            }
+
+            return 0;
+        }
+
         int err =
 			GenerateOverlapWithMeshes (
 				meshA, meshB,
@@ -235,7 +428,9 @@ int GenerateOverlapMesh(
 				fHasConcaveFacesA,
 				fHasConcaveFacesB,
 				fAllowNoOverlap,
-				fVerbose);
+				fVerbose,
+				fTargetMajor,
+				strCheckpointDir);
 
         return err;
 
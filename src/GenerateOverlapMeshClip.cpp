@@ -0,0 +1,567 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    GenerateOverlapMeshClip.cpp
+///	\author  Paul Ullrich
+///	\version October 15, 2026
+///
+///	<remarks>
+///		Copyright 2026 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "OverlapMesh.h"
+#include "FaceBVH.h"
+#include "Announce.h"
+#include "Exception.h"
+
+#include <cmath>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Scratch storage for clipping one source Face.  Buffers are reserved
+///		once per thread for the largest possible overlap polygon, so that
+///		clipping a pair of Faces does not allocate.
+///	</summary>
+struct OverlapClipWorkspace {
+
+	///	<summary>
+	///		Polygon being clipped.
+	///	</summary>
+	std::vector<Node> vecPolygon;
+
+	///	<summary>
+	///		Output of clipping vecPolygon against one plane.
+	///	</summary>
+	std::vector<Node> vecClipped;
+
+	///	<summary>
+	///		Unit normals of the planes of the edges of the source Face.
+	///	</summary>
+	std::vector<Node> vecSourcePlanes;
+
+	///	<summary>
+	///		Candidate target Faces.
+	///	</summary>
+	std::vector<int> vecCandidates;
+
+	///	<summary>
+	///		Reserve storage for Faces with at most the given number of edges.
+	///	</summary>
+	void Reserve(
+		int nMaxSourceEdges,
+		int nMaxTargetEdges
+	) {
+		vecPolygon.reserve(nMaxSourceEdges + nMaxTargetEdges + 1);
+		vecClipped.reserve(nMaxSourceEdges + nMaxTargetEdges + 1);
+		vecSourcePlanes.reserve(nMaxSourceEdges);
+	}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Determine if a Face can be clipped:  it must have great circle arc
+///		edges, be convex and lie within an open hemisphere.
+///	</summary>
+static bool IsFaceClippable(
+	const Face & face,
+	const NodeVector & nodes
+) {
+	const int nEdges = face.edges.size();
+	if (nEdges < 3) {
+		return false;
+	}
+
+	Node nodeCenter(0.0, 0.0, 0.0);
+	for (int j = 0; j < nEdges; j++) {
+		if (face.edges[j].type != Edge::Type_GreatCircleArc) {
+			return false;
+		}
+		nodeCenter = nodeCenter + nodes[face[j]];
+	}
+
+	for (int j = 0; j < nEdges; j++) {
+		if (DotProduct(nodeCenter, nodes[face[j]]) <= 0.0) {
+			return false;
+		}
+	}
+
+	return !IsFaceConcave(face, nodes);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Determine if all Faces of a Mesh can be clipped, and get the
+///		largest number of edges of any Face.
+///	</summary>
+static bool IsMeshClippable(
+	const Mesh & mesh,
+	int & nMaxEdges
+) {
+	const int nFaces = mesh.faces.size();
+
+	bool fClippable = true;
+	int nMax = 0;
+
+#pragma omp parallel for schedule(static) reduction(&&:fClippable) reduction(max:nMax)
+	for (int i = 0; i < nFaces; i++) {
+		fClippable = fClippable && IsFaceClippable(mesh.faces[i], mesh.nodes);
+		nMax = std::max(nMax, static_cast<int>(mesh.faces[i].edges.size()));
+	}
+
+	nMaxEdges = nMax;
+	return fClippable;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Get the unit normal of the plane of the great circle arc from
+///		node0 to node1, which points into a counter-clockwise Face.  Returns
+///		false if the arc is degenerate.
+///	</summary>
+static inline bool GetArcPlane(
+	const Node & node0,
+	const Node & node1,
+	Node & nodeNormal
+) {
+	nodeNormal = CrossProduct(node0, node1);
+
+	const double dMag = nodeNormal.Magnitude();
+	if (dMag < ReferenceTolerance) {
+		return false;
+	}
+
+	nodeNormal = nodeNormal / dMag;
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Clip a convex spherical polygon against the hemisphere on the
+///		positive side of the plane through the origin with unit normal
+///		nodeNormal (one step of Sutherland-Hodgman clipping).  Nodes within
+///		ReferenceTolerance of the plane are retained and are not split.
+///	</summary>
+static void ClipPolygonByPlane(
+	const std::vector<Node> & vecPolygon,
+	const Node & nodeNormal,
+	std::vector<Node> & vecClipped
+) {
+	vecClipped.clear();
+
+	const int nNodes = vecPolygon.size();
+	if (nNodes == 0) {
+		return;
+	}
+
+	const Node * pnodePrev = &(vecPolygon[nNodes-1]);
+	double dPrev = DotProduct(nodeNormal, *pnodePrev);
+
+	for (int i = 0; i < nNodes; i++) {
+		const Node & nodeCurr = vecPolygon[i];
+		const double dCurr = DotProduct(nodeNormal, nodeCurr);
+
+		// The arc crosses the plane strictly between the two nodes;  the
+		// crossing is the positive combination of the nodes on the plane
+		if (((dPrev > ReferenceTolerance) && (dCurr < -ReferenceTolerance)) ||
+		    ((dPrev < -ReferenceTolerance) && (dCurr > ReferenceTolerance))
+		) {
+			Node nodeCross =
+				nodeCurr * fabs(dPrev) + (*pnodePrev) * fabs(dCurr);
+			nodeCross = nodeCross / nodeCross.Magnitude();
+			vecClipped.push_back(nodeCross);
+		}
+
+		if (dCurr >= -ReferenceTolerance) {
+			vecClipped.push_back(nodeCurr);
+		}
+
+		pnodePrev = &nodeCurr;
+		dPrev = dCurr;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Remove consecutive Nodes of a polygon that are within
+///		ReferenceTolerance of each other.
+///	</summary>
+static void RemoveRepeatedPolygonNodes(
+	std::vector<Node> & vecPolygon
+) {
+	int nNodes = 0;
+	for (int i = 0; i < vecPolygon.size(); i++) {
+		if ((nNodes > 0) &&
+		    ((vecPolygon[i] - vecPolygon[nNodes-1]).Magnitude()
+				< ReferenceTolerance)
+		) {
+			continue;
+		}
+		vecPolygon[nNodes++] = vecPolygon[i];
+	}
+	while ((nNodes > 1) &&
+	       ((vecPolygon[nNodes-1] - vecPolygon[0]).Magnitude()
+				< ReferenceTolerance)
+	) {
+		nNodes--;
+	}
+	vecPolygon.resize(nNodes);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Area of a convex spherical polygon with great circle arc edges,
+///		as the sum of the spherical excess of a fan of triangles.
+///	</summary>
+static double CalculateClippedPolygonArea(
+	const std::vector<Node> & vecPolygon
+) {
+	double dArea = 0.0;
+
+	const Node & node0 = vecPolygon[0];
+	for (int i = 1; i < vecPolygon.size()-1; i++) {
+		const Node & node1 = vecPolygon[i];
+		const Node & node2 = vecPolygon[i+1];
+
+		const double dNumer = DotProduct(node0, CrossProduct(node1, node2));
+		const double dDenom =
+			1.0
+			+ DotProduct(node0, node1)
+			+ DotProduct(node1, node2)
+			+ DotProduct(node2, node0);
+
+		dArea += 2.0 * atan2(dNumer, dDenom);
+	}
+
+	return dArea;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Perimeter of a polygon, measured in chord distance.
+///	</summary>
+static double CalculateClippedPolygonPerimeter(
+	const std::vector<Node> & vecPolygon
+) {
+	const int nNodes = vecPolygon.size();
+
+	double dPerimeter = 0.0;
+	for (int i = 0; i < nNodes; i++) {
+		dPerimeter +=
+			(vecPolygon[(i+1) % nNodes] - vecPolygon[i]).Magnitude();
+	}
+	return dPerimeter;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Clip one source Face against all candidate target Faces, appending
+///		the overlap Faces to meshBlock with unmerged Nodes.
+///	</summary>
+static void GenerateOverlapMeshClipFromFace(
+	const Mesh & meshSource,
+	const Mesh & meshTarget,
+	const FaceBVH & bvhTarget,
+	int ixSourceFace,
+	OverlapClipWorkspace & workspace,
+	Mesh & meshBlock,
+	const bool fAllowNoOverlap
+) {
+	const Face & faceSource = meshSource.faces[ixSourceFace];
+	const int nSourceEdges = faceSource.edges.size();
+
+	// Planes of the source edges, and the cap bounding the source Face
+	Node nodeCenter(0.0, 0.0, 0.0);
+	for (int j = 0; j < nSourceEdges; j++) {
+		nodeCenter = nodeCenter + meshSource.nodes[faceSource[j]];
+	}
+	nodeCenter = nodeCenter / nodeCenter.Magnitude();
+
+	double dRadius = 0.0;
+	workspace.vecSourcePlanes.clear();
+	for (int j = 0; j < nSourceEdges; j++) {
+		const Node & node0 = meshSource.nodes[faceSource[j]];
+		const Node & node1 = meshSource.nodes[faceSource[(j+1) % nSourceEdges]];
+
+		dRadius = std::max(dRadius, (node0 - nodeCenter).Magnitude());
+
+		Node nodeNormal;
+		if (GetArcPlane(node0, node1, nodeNormal)) {
+			workspace.vecSourcePlanes.push_back(nodeNormal);
+		}
+	}
+
+	bvhTarget.FindCandidateFaces(
+		nodeCenter,
+		dRadius + FaceBVHCapTolerance,
+		workspace.vecCandidates);
+
+	const size_t sInitialOverlapFaces = meshBlock.faces.size();
+
+	for (int c = 0; c < workspace.vecCandidates.size(); c++) {
+		const int ixTargetFace = workspace.vecCandidates[c];
+		const Face & faceTarget = meshTarget.faces[ixTargetFace];
+		const int nTargetEdges = faceTarget.edges.size();
+
+		// Clip the target Face by the source Face, so that Nodes of the
+		// target Face are reproduced exactly
+		workspace.vecPolygon.resize(nTargetEdges);
+		for (int j = 0; j < nTargetEdges; j++) {
+			workspace.vecPolygon[j] = meshTarget.nodes[faceTarget[j]];
+		}
+
+		for (int k = 0; k < workspace.vecSourcePlanes.size(); k++) {
+			ClipPolygonByPlane(
+				workspace.vecPolygon,
+				workspace.vecSourcePlanes[k],
+				workspace.vecClipped);
+
+			workspace.vecPolygon.swap(workspace.vecClipped);
+
+			if (workspace.vecPolygon.size() < 3) {
+				break;
+			}
+		}
+
+		RemoveRepeatedPolygonNodes(workspace.vecPolygon);
+
+		if (workspace.vecPolygon.size() < 3) {
+			continue;
+		}
+
+		// Polygons that are only a shared edge or node within tolerance
+		// have width below ReferenceTolerance
+		const double dArea = CalculateClippedPolygonArea(workspace.vecPolygon);
+		const double dPerimeter =
+			CalculateClippedPolygonPerimeter(workspace.vecPolygon);
+
+		if (dArea <= ReferenceTolerance * dPerimeter) {
+			continue;
+		}
+
+		const int ixNodeBegin = meshBlock.nodes.size();
+		const int nNodes = workspace.vecPolygon.size();
+
+		Face faceOverlap(nNodes);
+		for (int j = 0; j < nNodes; j++) {
+			meshBlock.nodes.push_back(workspace.vecPolygon[j]);
+			faceOverlap.SetNode(j, ixNodeBegin + j);
+		}
+
+		meshBlock.faces.push_back(faceOverlap);
+		meshBlock.vecSourceFaceIx.push_back(ixSourceFace);
+		meshBlock.vecTargetFaceIx.push_back(ixTargetFace);
+	}
+
+	if (meshBlock.faces.size() == sInitialOverlapFaces) {
+		if (fAllowNoOverlap) {
+			Announce("WARNING: No overlapping face found");
+			return;
+		}
+		Announce("ERROR: No overlapping face found");
+		Announce("This may be caused by mesh B being a subset of mesh A");
+		Announce("Try swapping order of mesh A and B, or override with --allow_no_overlap");
+		_EXCEPTIONT("Exiting");
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Append an overlap mesh generated for a block of source Faces to the
+///		global overlap mesh, merging coincident Nodes in order of first
+///		appearance so that the numbering follows the order of source Faces.
+///	</summary>
+static void MergeOverlapMeshClipBlock(
+	const Mesh & meshBlock,
+	Mesh & meshOverlap,
+	NodeMap & nodemapOverlap
+) {
+	std::vector<int> vecNodeIx(meshBlock.nodes.size());
+
+#if defined(OVERLAPMESH_RETAIN_REPEATED_NODES)
+	const int ixNodeOffset = meshOverlap.nodes.size();
+	meshOverlap.nodes.insert(
+		meshOverlap.nodes.end(),
+		meshBlock.nodes.begin(),
+		meshBlock.nodes.end());
+
+	for (int i = 0; i < vecNodeIx.size(); i++) {
+		vecNodeIx[i] = ixNodeOffset + i;
+	}
+#else
+	for (int i = 0; i < vecNodeIx.size(); i++) {
+		NodeMapConstIterator iter = nodemapOverlap.find(meshBlock.nodes[i]);
+
+		if (iter != nodemapOverlap.end()) {
+			vecNodeIx[i] = iter->second;
+		} else {
+			int iNextNodeMapOverlapIx = nodemapOverlap.size();
+			vecNodeIx[i] = iNextNodeMapOverlapIx;
+			nodemapOverlap.insert(
+				NodeMapPair(meshBlock.nodes[i], iNextNodeMapOverlapIx));
+			meshOverlap.nodes.push_back(meshBlock.nodes[i]);
+		}
+	}
+#endif
+
+	for (int f = 0; f < meshBlock.faces.size(); f++) {
+		const Face & faceBlock = meshBlock.faces[f];
+
+		Face faceNew(faceBlock.edges.size());
+		for (int i = 0; i < faceBlock.edges.size(); i++) {
+			faceNew.SetNode(i, vecNodeIx[faceBlock[i]]);
+		}
+		meshOverlap.faces.push_back(faceNew);
+	}
+
+	meshOverlap.vecSourceFaceIx.insert(
+		meshOverlap.vecSourceFaceIx.end(),
+		meshBlock.vecSourceFaceIx.begin(),
+		meshBlock.vecSourceFaceIx.end());
+
+	meshOverlap.vecTargetFaceIx.insert(
+		meshOverlap.vecTargetFaceIx.end(),
+		meshBlock.vecTargetFaceIx.begin(),
+		meshBlock.vecTargetFaceIx.end());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool GenerateOverlapMeshClip(
+	const Mesh & meshSource,
+	const Mesh & meshTarget,
+	const std::vector<int> & vecSourceFaceIx,
+	Mesh & meshOverlap,
+	const bool fAllowNoOverlap
+) {
+	int nMaxSourceEdges;
+	int nMaxTargetEdges;
+
+	if (!IsMeshClippable(meshSource, nMaxSourceEdges)) {
+		return false;
+	}
+	if (!IsMeshClippable(meshTarget, nMaxTargetEdges)) {
+		return false;
+	}
+
+	const int nSourceFaces = vecSourceFaceIx.size();
+
+#if defined(_OPENMP)
+	const int nThreads = omp_get_max_threads();
+#else
+	const int nThreads = 1;
+#endif
+
+	Announce("Clipping %i source faces using %i threads",
+		nSourceFaces, nThreads);
+
+	FaceBVH bvhTarget(meshTarget);
+
+	std::vector<OverlapClipWorkspace> vecWorkspace(nThreads);
+	for (int t = 0; t < nThreads; t++) {
+		vecWorkspace[t].Reserve(nMaxSourceEdges, nMaxTargetEdges);
+	}
+
+#if defined(OVERLAPMESH_USE_NODE_MULTIMAP)
+	NodeMap nodemapOverlap(ReferenceTolerance, OVERLAPMESH_BIN_WIDTH);
+#elif defined(OVERLAPMESH_USE_NODE_HASHMAP)
+	NodeMap nodemapOverlap(ReferenceTolerance, OVERLAPMESH_HASHMAP_CELL_WIDTH);
+#else
+	NodeMap nodemapOverlap;
+#endif
+
+	const int nBlocks =
+		(nSourceFaces + OverlapMeshParallelBlockSize - 1)
+			/ OverlapMeshParallelBlockSize;
+
+	int iError = 0;
+	std::string strError;
+
+	// Each pair of faces is clipped independently; blocks of source faces
+	// are merged in order so the result does not depend on thread count
+#pragma omp parallel for schedule(dynamic) ordered
+	for (int b = 0; b < nBlocks; b++) {
+		const int ixBegin = b * OverlapMeshParallelBlockSize;
+		const int ixEnd =
+			std::min(ixBegin + OverlapMeshParallelBlockSize, nSourceFaces);
+
+#if defined(_OPENMP)
+		OverlapClipWorkspace & workspace = vecWorkspace[omp_get_thread_num()];
+#else
+		OverlapClipWorkspace & workspace = vecWorkspace[0];
+#endif
+
+		Mesh meshBlock;
+
+		int iErrorSoFar;
+#pragma omp atomic read
+		iErrorSoFar = iError;
+
+		std::string strBlockError;
+		if (iErrorSoFar == 0) {
+			try {
+				for (int ix = ixBegin; ix < ixEnd; ix++) {
+					GenerateOverlapMeshClipFromFace(
+						meshSource,
+						meshTarget,
+						bvhTarget,
+						vecSourceFaceIx[ix],
+						workspace,
+						meshBlock,
+						fAllowNoOverlap);
+				}
+
+			} catch(Exception & e) {
+				strBlockError = e.ToString();
+			}
+		}
+
+#pragma omp ordered
+		{
+			if ((iError == 0) && (strBlockError != "")) {
+				strError = strBlockError;
+#pragma omp atomic write
+				iError = 1;
+			}
+			if (iError == 0) {
+				if ((ixBegin / 1000) != (ixEnd / 1000)) {
+					Announce("Source Face %i", ixEnd);
+				}
+				MergeOverlapMeshClipBlock(
+					meshBlock,
+					meshOverlap,
+					nodemapOverlap);
+			}
+		}
+	}
+
+	if (iError != 0) {
+		_EXCEPTION1("%s", strError.c_str());
+	}
+
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
@@ -20,10 +20,22 @@
 
 #include "TempestRemapAPI.h"
 
+#if defined(TEMPEST_MPIOMP)
+#include <mpi.h>
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 
 int main(int argc, char** argv) {
 
+#if defined(TEMPEST_MPIOMP)
+	// Initialize MPI
+	MPI_Init(&argc, &argv);
+
+	// Enable output only on rank zero
+	AnnounceOnlyOutputOnRankZero();
+#endif
+
 	// Input mesh A
 	std::string strMeshA;
 
@@ -55,18 +67,38 @@ int main(int argc, char** argv) {
 	// Verbose
 	bool fVerbose;
 
+	// Reorder input meshes along a space-filling curve
+	bool fReorder;
+
+	// Iterate over faces of mesh B when generating the overlap mesh
+	bool fTargetMajor;
+
+	// Directory for checkpoints of the partial overlap mesh
+	std::string strCheckpointDir;
+
+	// Previous mesh A, mesh B and overlap mesh, for incremental generation
+	std::string strPrevMeshA;
+	std::string strPrevMeshB;
+	std::string strPrevOverlapMesh;
+
 	// Parse the command line
 	BeginCommandLine()
 		CommandLineString(strMeshA, "a", "");
 		CommandLineString(strMeshB, "b", "");
 		CommandLineString(strOverlapMesh, "out", "overlap.g");
 		CommandLineString(strOutputFormat, "out_format", "netcdf4");
-		CommandLineStringD(strMethod, "method", "fuzzy", "(fuzzy|exact|mixed)");
+		CommandLineStringD(strMethod, "method", "fuzzy", "(fuzzy|exact|mixed|clip) [unless both meshes are RLL with constant latitude edges]");
 		CommandLineBool(fNoValidate, "novalidate");
 		CommandLineBool(fHasConcaveFacesA, "concavea");
 		CommandLineBool(fHasConcaveFacesB, "concaveb");
 		CommandLineBool(fAllowNoOverlap, "allow_no_overlap");
 		CommandLineBool(fVerbose, "verbose");
+		CommandLineBool(fReorder, "reorder");
+		CommandLineBool(fTargetMajor, "target_major");
+		CommandLineString(strCheckpointDir, "checkpoint_dir", "");
+		CommandLineString(strPrevMeshA, "prev_a", "");
+		CommandLineString(strPrevMeshB, "prev_b", "");
+		CommandLineString(strPrevOverlapMesh, "prev_ov", "");
 
 		ParseCommandLine(argc, argv);
 	EndCommandLine(argv)
@@ -82,12 +114,23 @@ int main(int argc, char** argv) {
 			strMethod, fNoValidate,
 			fHasConcaveFacesA, fHasConcaveFacesB,
 			fAllowNoOverlap,
-			fVerbose);
-
-	if (err) exit(err);
+			fVerbose,
+			fReorder,
+			strPrevMeshA,
+			strPrevMeshB,
+			strPrevOverlapMesh,
+			fTargetMajor,
+			strCheckpointDir);
 
 	AnnounceBanner();
 
+#if defined(TEMPEST_MPIOMP)
+	// Deinitialize MPI
+	MPI_Finalize();
+#endif
+
+	if (err) exit(err);
+
 	return 0;
 }
 
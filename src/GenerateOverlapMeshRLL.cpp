@@ -0,0 +1,722 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    GenerateOverlapMeshRLL.cpp
+///	\author  Paul Ullrich
+///	\version October 14, 2026
+///
+///	<remarks>
+///		Copyright 2026 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "OverlapMesh.h"
+#include "Announce.h"
+#include "Exception.h"
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#if defined(TEMPEST_MPIOMP)
+#include <mpi.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Tolerance (in radians) used to identify equal latitudes and
+///		longitudes of rectilinear Mesh nodes.
+///	</summary>
+static const double RLLOverlapTolerance = 1.0e-10;
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A Mesh whose Faces are the cells of a tensor product of latitude
+///		and longitude intervals.
+///	</summary>
+struct RLLMeshGrid {
+
+	///	<summary>
+	///		Latitude edges, in increasing order.
+	///	</summary>
+	std::vector<double> vecLatEdges;
+
+	///	<summary>
+	///		Longitude edges in [0, 2pi), in increasing order.  Longitude
+	///		cell i spans from vecLonEdges[i] to the next edge, wrapping
+	///		around the circle after the last edge.
+	///	</summary>
+	std::vector<double> vecLonEdges;
+
+	///	<summary>
+	///		Longitude cells that contain Faces.
+	///	</summary>
+	std::vector<int> vecLonCells;
+
+	///	<summary>
+	///		Face index of each cell (latitude-major), or -1.
+	///	</summary>
+	std::vector<int> vecCellFace;
+
+	///	<summary>
+	///		Get the width of the given longitude cell.
+	///	</summary>
+	double GetLonWidth(int i) const {
+		const int nLonEdges = static_cast<int>(vecLonEdges.size());
+		double dWidth = vecLonEdges[(i+1) % nLonEdges] - vecLonEdges[i];
+		if (dWidth <= 0.0) {
+			dWidth += 2.0 * M_PI;
+		}
+		return dWidth;
+	}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		The latitude and longitude extent of a single Face.
+///	</summary>
+struct RLLFaceExtent {
+	double dLatBegin;
+	double dLatEnd;
+	double dLonBegin;
+	double dLonWidth;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Sort and remove duplicate values (within tolerance).
+///	</summary>
+static void SortUniqueWithTolerance(
+	std::vector<double> & vec
+) {
+	std::sort(vec.begin(), vec.end());
+
+	size_t sUnique = 0;
+	for (size_t i = 0; i < vec.size(); i++) {
+		if ((sUnique == 0) ||
+		    (vec[i] - vec[sUnique-1] > RLLOverlapTolerance)
+		) {
+			vec[sUnique++] = vec[i];
+		}
+	}
+	vec.resize(sUnique);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Find the index of a value in a sorted vector (within tolerance),
+///		or -1 if it is not present.
+///	</summary>
+static int FindWithTolerance(
+	const std::vector<double> & vec,
+	double dValue
+) {
+	std::vector<double>::const_iterator iter =
+		std::lower_bound(vec.begin(), vec.end(), dValue - RLLOverlapTolerance);
+
+	if ((iter == vec.end()) || (fabs(*iter - dValue) > RLLOverlapTolerance)) {
+		return (-1);
+	}
+	return static_cast<int>(iter - vec.begin());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Normalize a longitude to [0, 2pi), mapping values within tolerance
+///		of 2pi to 0.
+///	</summary>
+static double NormalizeLon(
+	double dLon
+) {
+	dLon = fmod(dLon, 2.0 * M_PI);
+	if (dLon < 0.0) {
+		dLon += 2.0 * M_PI;
+	}
+	if (dLon > 2.0 * M_PI - RLLOverlapTolerance) {
+		dLon = 0.0;
+	}
+	return dLon;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Determine the extent of a Face, returning false if the Face is not
+///		bounded by meridians and lines of constant latitude.
+///	</summary>
+static bool GetRLLFaceExtent(
+	const Mesh & mesh,
+	const std::vector<double> & vecNodeLon,
+	const std::vector<double> & vecNodeLat,
+	const std::vector<char> & vecNodePole,
+	const Face & face,
+	RLLFaceExtent & extent
+) {
+	double dLat[2];
+	double dLon[2];
+	int nLat = 0;
+	int nLon = 0;
+
+	for (int i = 0; i < face.edges.size(); i++) {
+		const Edge & edge = face.edges[i];
+		const int ix0 = edge[0];
+		const int ix1 = edge[1];
+
+		if (ix0 == ix1) {
+			continue;
+		}
+
+		// Collect distinct latitudes and longitudes
+		bool fFound = false;
+		for (int k = 0; k < nLat; k++) {
+			if (fabs(dLat[k] - vecNodeLat[ix0]) < RLLOverlapTolerance) {
+				fFound = true;
+			}
+		}
+		if (!fFound) {
+			if (nLat == 2) {
+				return false;
+			}
+			dLat[nLat++] = vecNodeLat[ix0];
+		}
+
+		if (!vecNodePole[ix0]) {
+			fFound = false;
+			for (int k = 0; k < nLon; k++) {
+				if (fabs(NormalizeLon(dLon[k] - vecNodeLon[ix0] + M_PI) - M_PI)
+				    < RLLOverlapTolerance
+				) {
+					fFound = true;
+				}
+			}
+			if (!fFound) {
+				if (nLon == 2) {
+					return false;
+				}
+				dLon[nLon++] = vecNodeLon[ix0];
+			}
+		}
+
+		// Verify the type of the edge
+		const bool fSameLat =
+			(fabs(vecNodeLat[ix0] - vecNodeLat[ix1]) < RLLOverlapTolerance);
+
+		const bool fSameLon =
+			vecNodePole[ix0] || vecNodePole[ix1] ||
+			(fabs(NormalizeLon(vecNodeLon[ix0] - vecNodeLon[ix1] + M_PI) - M_PI)
+			    < RLLOverlapTolerance);
+
+		// Great circle arcs only follow a line of constant latitude on
+		// the equator, so meshes with great circle arcs between nodes of
+		// equal latitude (such as those from GenerateRLLMesh when built
+		// with ONLY_GREAT_CIRCLES) are left to GenerateOverlapMesh_v2()
+		if (fSameLat && !fSameLon) {
+			if ((edge.type != Edge::Type_ConstantLatitude) &&
+			    (fabs(vecNodeLat[ix0]) > RLLOverlapTolerance)
+			) {
+				return false;
+			}
+
+		} else if (fSameLon && !fSameLat) {
+			if (edge.type != Edge::Type_GreatCircleArc) {
+				return false;
+			}
+
+		} else {
+			return false;
+		}
+	}
+
+	if ((nLat != 2) || (nLon != 2)) {
+		return false;
+	}
+
+	extent.dLatBegin = std::min(dLat[0], dLat[1]);
+	extent.dLatEnd = std::max(dLat[0], dLat[1]);
+
+	// Faces span less than half of the circle in longitude
+	double dWidth = NormalizeLon(dLon[1] - dLon[0]);
+	if (dWidth < M_PI) {
+		extent.dLonBegin = NormalizeLon(dLon[0]);
+		extent.dLonWidth = dWidth;
+	} else {
+		extent.dLonBegin = NormalizeLon(dLon[1]);
+		extent.dLonWidth = 2.0 * M_PI - dWidth;
+	}
+
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Identify the latitude and longitude cells of a rectilinear Mesh,
+///		returning false if the Mesh is not rectilinear.
+///	</summary>
+static bool GetRLLMeshGrid(
+	const Mesh & mesh,
+	RLLMeshGrid & grid
+) {
+	const int nNodes = static_cast<int>(mesh.nodes.size());
+	const int nFaces = static_cast<int>(mesh.faces.size());
+
+	if (nFaces == 0) {
+		return false;
+	}
+
+	// Latitude and longitude of each Node
+	std::vector<double> vecNodeLon(nNodes);
+	std::vector<double> vecNodeLat(nNodes);
+	std::vector<char> vecNodePole(nNodes);
+
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < nNodes; i++) {
+		const Node & node = mesh.nodes[i];
+		const double dMag = node.Magnitude();
+		const double dZ = node.z / dMag;
+
+		if (fabs(dZ) >= 1.0 - ReferenceTolerance) {
+			vecNodePole[i] = 1;
+			vecNodeLon[i] = 0.0;
+			vecNodeLat[i] = (dZ > 0.0)?(0.5 * M_PI):(-0.5 * M_PI);
+		} else {
+			vecNodePole[i] = 0;
+			vecNodeLon[i] = NormalizeLon(atan2(node.y, node.x));
+			vecNodeLat[i] = asin(dZ);
+		}
+	}
+
+	// Extent of each Face
+	std::vector<RLLFaceExtent> vecExtents(nFaces);
+
+	bool fRectilinear = true;
+
+#pragma omp parallel for schedule(static) reduction(&&:fRectilinear)
+	for (int f = 0; f < nFaces; f++) {
+		fRectilinear = fRectilinear &&
+			GetRLLFaceExtent(
+				mesh,
+				vecNodeLon,
+				vecNodeLat,
+				vecNodePole,
+				mesh.faces[f],
+				vecExtents[f]);
+	}
+
+	if (!fRectilinear) {
+		return false;
+	}
+
+	// Latitude and longitude edges
+	grid.vecLatEdges.clear();
+	grid.vecLonEdges.clear();
+	for (int f = 0; f < nFaces; f++) {
+		grid.vecLatEdges.push_back(vecExtents[f].dLatBegin);
+		grid.vecLatEdges.push_back(vecExtents[f].dLatEnd);
+		grid.vecLonEdges.push_back(vecExtents[f].dLonBegin);
+		grid.vecLonEdges.push_back(
+			NormalizeLon(vecExtents[f].dLonBegin + vecExtents[f].dLonWidth));
+	}
+
+	SortUniqueWithTolerance(grid.vecLatEdges);
+	SortUniqueWithTolerance(grid.vecLonEdges);
+
+	const int nLatCells = static_cast<int>(grid.vecLatEdges.size()) - 1;
+	const int nLonEdges = static_cast<int>(grid.vecLonEdges.size());
+
+	if ((nLatCells < 1) || (nLonEdges < 2)) {
+		return false;
+	}
+
+	// Assign each Face to a cell
+	grid.vecCellFace.clear();
+	grid.vecCellFace.resize(
+		static_cast<size_t>(nLatCells) * static_cast<size_t>(nLonEdges), -1);
+
+	std::vector<char> vecLonCellUsed(nLonEdges, 0);
+
+	for (int f = 0; f < nFaces; f++) {
+		const RLLFaceExtent & extent = vecExtents[f];
+
+		int iLat = FindWithTolerance(grid.vecLatEdges, extent.dLatBegin);
+		if ((iLat < 0) || (iLat >= nLatCells) ||
+		    (fabs(grid.vecLatEdges[iLat+1] - extent.dLatEnd) > RLLOverlapTolerance)
+		) {
+			return false;
+		}
+
+		int iLon = FindWithTolerance(grid.vecLonEdges, extent.dLonBegin);
+		if ((iLon < 0) ||
+		    (fabs(grid.GetLonWidth(iLon) - extent.dLonWidth) > RLLOverlapTolerance)
+		) {
+			return false;
+		}
+
+		int & iCellFace =
+			grid.vecCellFace[static_cast<size_t>(iLat) * nLonEdges + iLon];
+		if (iCellFace != (-1)) {
+			return false;
+		}
+		iCellFace = f;
+
+		vecLonCellUsed[iLon] = 1;
+	}
+
+	grid.vecLonCells.clear();
+	for (int i = 0; i < nLonEdges; i++) {
+		if (vecLonCellUsed[i]) {
+			grid.vecLonCells.push_back(i);
+		}
+	}
+
+	// Every latitude cell must contain the same longitude cells
+	if (static_cast<size_t>(nFaces) !=
+	    static_cast<size_t>(nLatCells) * grid.vecLonCells.size()
+	) {
+		return false;
+	}
+
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		An interval of the overlap of source and target cells in one
+///		coordinate direction.
+///	</summary>
+struct RLLOverlapInterval {
+	int iSource;
+	int iTarget;
+	double dBegin;
+	double dEnd;
+
+	RLLOverlapInterval(int _iSource, int _iTarget, double _dBegin, double _dEnd) :
+		iSource(_iSource), iTarget(_iTarget), dBegin(_dBegin), dEnd(_dEnd)
+	{ }
+};
+
+///	<summary>
+///		An interval of a single grid in one coordinate direction.
+///	</summary>
+struct RLLGridInterval {
+	int iCell;
+	double dBegin;
+	double dEnd;
+
+	RLLGridInterval(int _iCell, double _dBegin, double _dEnd) :
+		iCell(_iCell), dBegin(_dBegin), dEnd(_dEnd)
+	{ }
+
+	bool operator<(const RLLGridInterval & interval) const {
+		return (dBegin < interval.dBegin);
+	}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Intersect two sorted sequences of disjoint intervals.
+///	</summary>
+static void IntersectIntervals(
+	const std::vector<RLLGridInterval> & vecSource,
+	const std::vector<RLLGridInterval> & vecTarget,
+	std::vector<RLLOverlapInterval> & vecOverlap
+) {
+	size_t i = 0;
+	size_t j = 0;
+	while ((i < vecSource.size()) && (j < vecTarget.size())) {
+		const double dBegin = std::max(vecSource[i].dBegin, vecTarget[j].dBegin);
+		const double dEnd = std::min(vecSource[i].dEnd, vecTarget[j].dEnd);
+
+		if (dEnd - dBegin > RLLOverlapTolerance) {
+			vecOverlap.push_back(
+				RLLOverlapInterval(
+					vecSource[i].iCell, vecTarget[j].iCell, dBegin, dEnd));
+		}
+
+		if (vecSource[i].dEnd < vecTarget[j].dEnd) {
+			i++;
+		} else {
+			j++;
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Get the longitude intervals of a grid in [0, 2pi], splitting cells
+///		that wrap around the circle.
+///	</summary>
+static void GetLonIntervals(
+	const RLLMeshGrid & grid,
+	std::vector<RLLGridInterval> & vecIntervals
+) {
+	vecIntervals.clear();
+	for (int k = 0; k < grid.vecLonCells.size(); k++) {
+		const int i = grid.vecLonCells[k];
+		const double dBegin = grid.vecLonEdges[i];
+		const double dEnd = dBegin + grid.GetLonWidth(i);
+
+		if (dEnd > 2.0 * M_PI + RLLOverlapTolerance) {
+			vecIntervals.push_back(RLLGridInterval(i, dBegin, 2.0 * M_PI));
+			vecIntervals.push_back(RLLGridInterval(i, 0.0, dEnd - 2.0 * M_PI));
+		} else {
+			vecIntervals.push_back(RLLGridInterval(i, dBegin, dEnd));
+		}
+	}
+	std::sort(vecIntervals.begin(), vecIntervals.end());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool GenerateOverlapMeshRLL(
+	const Mesh & meshSource,
+	const Mesh & meshTarget,
+	Mesh & meshOverlap
+) {
+	RLLMeshGrid gridSource;
+	RLLMeshGrid gridTarget;
+
+	if (!GetRLLMeshGrid(meshSource, gridSource)) {
+		return false;
+	}
+	if (!GetRLLMeshGrid(meshTarget, gridTarget)) {
+		return false;
+	}
+
+	// Overlap in latitude
+	std::vector<RLLOverlapInterval> vecLatOverlap;
+	{
+		std::vector<RLLGridInterval> vecSourceLat;
+		for (int i = 0; i < gridSource.vecLatEdges.size()-1; i++) {
+			vecSourceLat.push_back(
+				RLLGridInterval(i,
+					gridSource.vecLatEdges[i], gridSource.vecLatEdges[i+1]));
+		}
+
+		std::vector<RLLGridInterval> vecTargetLat;
+		for (int i = 0; i < gridTarget.vecLatEdges.size()-1; i++) {
+			vecTargetLat.push_back(
+				RLLGridInterval(i,
+					gridTarget.vecLatEdges[i], gridTarget.vecLatEdges[i+1]));
+		}
+
+		IntersectIntervals(vecSourceLat, vecTargetLat, vecLatOverlap);
+	}
+
+	// Overlap in longitude, rejoining intervals split at 2pi
+	std::vector<RLLOverlapInterval> vecLonOverlap;
+	{
+		std::vector<RLLGridInterval> vecSourceLon;
+		std::vector<RLLGridInterval> vecTargetLon;
+
+		GetLonIntervals(gridSource, vecSourceLon);
+		GetLonIntervals(gridTarget, vecTargetLon);
+
+		IntersectIntervals(vecSourceLon, vecTargetLon, vecLonOverlap);
+
+		if (vecLonOverlap.size() > 1) {
+			RLLOverlapInterval & first = vecLonOverlap.front();
+			RLLOverlapInterval & last = vecLonOverlap.back();
+
+			if ((first.iSource == last.iSource) &&
+			    (first.iTarget == last.iTarget) &&
+			    (first.dBegin < RLLOverlapTolerance) &&
+			    (last.dEnd > 2.0 * M_PI - RLLOverlapTolerance)
+			) {
+				last.dEnd = first.dEnd + 2.0 * M_PI;
+				vecLonOverlap.erase(vecLonOverlap.begin());
+			}
+		}
+	}
+
+	// A single overlap interval can not contain both poles
+	for (int p = 0; p < vecLatOverlap.size(); p++) {
+		if ((vecLatOverlap[p].dBegin < -0.5 * M_PI + RLLOverlapTolerance) &&
+		    (vecLatOverlap[p].dEnd > 0.5 * M_PI - RLLOverlapTolerance)
+		) {
+			return false;
+		}
+	}
+
+	Announce("Using rectilinear overlap (%lu x %lu intervals)",
+		vecLatOverlap.size(), vecLonOverlap.size());
+
+	// As with GenerateOverlapMesh_v2(), the overlap mesh is only returned
+	// on rank 0
+	meshOverlap.Clear();
+	meshOverlap.type = Mesh::MeshType_Overlap;
+
+#if defined(TEMPEST_MPIOMP)
+	int fMPIInitialized = 0;
+	MPI_Initialized(&fMPIInitialized);
+	if (fMPIInitialized) {
+		int nMPIRank;
+		MPI_Comm_rank(MPI_COMM_WORLD, &nMPIRank);
+		if (nMPIRank != 0) {
+			return true;
+		}
+	}
+#endif
+
+	// Latitude and longitude breakpoints of the overlap mesh
+	std::vector<double> vecLatBreaks;
+	for (int p = 0; p < vecLatOverlap.size(); p++) {
+		vecLatBreaks.push_back(vecLatOverlap[p].dBegin);
+		vecLatBreaks.push_back(vecLatOverlap[p].dEnd);
+	}
+	SortUniqueWithTolerance(vecLatBreaks);
+
+	std::vector<double> vecLonBreaks;
+	for (int q = 0; q < vecLonOverlap.size(); q++) {
+		vecLonBreaks.push_back(NormalizeLon(vecLonOverlap[q].dBegin));
+		vecLonBreaks.push_back(NormalizeLon(vecLonOverlap[q].dEnd));
+	}
+	SortUniqueWithTolerance(vecLonBreaks);
+
+	const int nLatBreaks = static_cast<int>(vecLatBreaks.size());
+	const int nLonBreaks = static_cast<int>(vecLonBreaks.size());
+
+	// Generate Nodes, with a single Node at each pole
+	std::vector<int> vecLatRowBegin(nLatBreaks);
+	std::vector<char> vecLatRowPole(nLatBreaks);
+
+	for (int r = 0; r < nLatBreaks; r++) {
+		const double dLat = vecLatBreaks[r];
+
+		vecLatRowBegin[r] = static_cast<int>(meshOverlap.nodes.size());
+		vecLatRowPole[r] = (fabs(fabs(dLat) - 0.5 * M_PI) < RLLOverlapTolerance);
+
+		if (vecLatRowPole[r]) {
+			meshOverlap.nodes.push_back(
+				Node(0.0, 0.0, (dLat > 0.0)?(1.0):(-1.0)));
+			continue;
+		}
+
+		const double dCosLat = cos(dLat);
+		const double dSinLat = sin(dLat);
+		for (int c = 0; c < nLonBreaks; c++) {
+			meshOverlap.nodes.push_back(
+				Node(
+					dCosLat * cos(vecLonBreaks[c]),
+					dCosLat * sin(vecLonBreaks[c]),
+					dSinLat));
+		}
+	}
+
+	// Generate Faces from the product of latitude and longitude intervals
+	const size_t sOverlapFaces = vecLatOverlap.size() * vecLonOverlap.size();
+	const int nSourceLonEdges = static_cast<int>(gridSource.vecLonEdges.size());
+	const int nTargetLonEdges = static_cast<int>(gridTarget.vecLonEdges.size());
+
+	meshOverlap.faces.resize(sOverlapFaces, Face(4));
+	meshOverlap.vecSourceFaceIx.resize(sOverlapFaces);
+	meshOverlap.vecTargetFaceIx.resize(sOverlapFaces);
+	meshOverlap.vecFaceArea.Allocate(sOverlapFaces);
+
+#pragma omp parallel for schedule(static)
+	for (int p = 0; p < vecLatOverlap.size(); p++) {
+		const RLLOverlapInterval & lat = vecLatOverlap[p];
+
+		const int rBegin = FindWithTolerance(vecLatBreaks, lat.dBegin);
+		const int rEnd = FindWithTolerance(vecLatBreaks, lat.dEnd);
+
+		const double dSinLatDiff = sin(lat.dEnd) - sin(lat.dBegin);
+
+		for (int q = 0; q < vecLonOverlap.size(); q++) {
+			const RLLOverlapInterval & lon = vecLonOverlap[q];
+
+			const int cBegin =
+				FindWithTolerance(vecLonBreaks, NormalizeLon(lon.dBegin));
+			const int cEnd =
+				FindWithTolerance(vecLonBreaks, NormalizeLon(lon.dEnd));
+
+			const int ixNodeLL = (vecLatRowPole[rBegin])
+				?(vecLatRowBegin[rBegin]):(vecLatRowBegin[rBegin] + cBegin);
+			const int ixNodeLR = (vecLatRowPole[rBegin])
+				?(vecLatRowBegin[rBegin]):(vecLatRowBegin[rBegin] + cEnd);
+			const int ixNodeUL = (vecLatRowPole[rEnd])
+				?(vecLatRowBegin[rEnd]):(vecLatRowBegin[rEnd] + cBegin);
+			const int ixNodeUR = (vecLatRowPole[rEnd])
+				?(vecLatRowBegin[rEnd]):(vecLatRowBegin[rEnd] + cEnd);
+
+			const size_t ixFace =
+				static_cast<size_t>(p) * vecLonOverlap.size() + q;
+
+			// Faces are oriented counter-clockwise, as in GenerateRLLMesh
+			Face & face = meshOverlap.faces[ixFace];
+			if (vecLatRowPole[rBegin]) {
+				face = Face(3);
+				face.SetNode(0, ixNodeLL);
+				face.SetNode(1, ixNodeUR);
+				face.SetNode(2, ixNodeUL);
+				face.edges[1].type = Edge::Type_ConstantLatitude;
+
+			} else if (vecLatRowPole[rEnd]) {
+				face = Face(3);
+				face.SetNode(0, ixNodeLR);
+				face.SetNode(1, ixNodeUR);
+				face.SetNode(2, ixNodeLL);
+				face.edges[2].type = Edge::Type_ConstantLatitude;
+
+			} else {
+				face.SetNode(0, ixNodeLR);
+				face.SetNode(1, ixNodeUR);
+				face.SetNode(2, ixNodeUL);
+				face.SetNode(3, ixNodeLL);
+				face.edges[1].type = Edge::Type_ConstantLatitude;
+				face.edges[3].type = Edge::Type_ConstantLatitude;
+			}
+
+			meshOverlap.vecSourceFaceIx[ixFace] =
+				gridSource.vecCellFace[
+					static_cast<size_t>(lat.iSource) * nSourceLonEdges
+					+ lon.iSource];
+
+			meshOverlap.vecTargetFaceIx[ixFace] =
+				gridTarget.vecCellFace[
+					static_cast<size_t>(lat.iTarget) * nTargetLonEdges
+					+ lon.iTarget];
+
+			meshOverlap.vecFaceArea[ixFace] =
+				(lon.dEnd - lon.dBegin) * dSinLatDiff;
+		}
+	}
+
+	// Map Face indices back to the original meshes, as in
+	// GenerateOverlapMesh_v2()
+	if (meshSource.vecMultiFaceMap.size() != 0) {
+		for (size_t f = 0; f < sOverlapFaces; f++) {
+			meshOverlap.vecSourceFaceIx[f] =
+				meshSource.vecMultiFaceMap[meshOverlap.vecSourceFaceIx[f]];
+		}
+	}
+	if (meshTarget.vecMultiFaceMap.size() != 0) {
+		for (size_t f = 0; f < sOverlapFaces; f++) {
+			meshOverlap.vecTargetFaceIx[f] =
+				meshTarget.vecMultiFaceMap[meshOverlap.vecTargetFaceIx[f]];
+		}
+	}
+
+	// Faces are generated in order of latitude and then longitude interval,
+	// but the remapping kernels require the overlap Faces of each source
+	// Face to be contiguous
+	meshOverlap.SortBySourceFace();
+
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
@@ -23,6 +23,7 @@
 
 #include <cmath>
 #include <iostream>
+#include <algorithm>
 
 #include "netcdfcpp.h"
 
@@ -31,53 +32,267 @@
 #define ONLY_GREAT_CIRCLES
 
 
-///////////////////////////////////////////////////////////////////////////////
-// 
-// Input Parameters:
-// Number of longitudes in mesh: int nLongitudes;
-// Number of latitudes in mesh: int nLatitudes;
-// First longitude line on mesh: double dLonBegin;
-// Last longitude line on mesh: double dLonEnd;
-// First latitude line on mesh: double dLatBegin;
-// Last latitude line on mesh: double dLatEnd;
-// Flip latitude and longitude dimension in FaceVector ordering: bool fFlipLatLon;
-// Output filename:  std::string strOutputFile;
-// 
-extern "C" 
-int GenerateRLLMesh(
-	Mesh & mesh, 
-	int nLongitudes,
-	int nLatitudes, 
-	double dLonBegin,
-	double dLonEnd, 
-	double dLatBegin,
-	double dLatEnd, 
-	bool fGlobalCap,
-	bool fFlipLatLon,
-	bool fForceGlobal,
-	std::string strInputFile,
-	std::string strInputFileLonName,
-	std::string strInputFileLatName,
-	std::string strOutputFile, 
-	std::string strOutputFormat,
-	bool fVerbose
-) {
+///	<summary>
+///		An implicit representation of a rectilinear latitude-longitude
+///		mesh, from which any Node or Face can be generated on demand.
+///		Nodes are numbered as the south pole (if present), then each
+///		latitude line in order of increasing index, then the north pole (if
+///		present).  Faces are numbered latitude-major, or longitude-major if
+///		fFlipLatLon is set.
+///	</summary>
+class RLLMeshStructure {
+
+public:
+	///	<summary>
+	///		Constructor, from longitude and latitude edges in radians.
+	///	</summary>
+	RLLMeshStructure(
+		const DataArray1D<double> & dLonEdge,
+		const DataArray1D<double> & dLatEdge,
+		bool fFlipLatLon
+	) :
+		m_dLonEdge(dLonEdge),
+		m_dLatEdge(dLatEdge),
+		m_fFlipLatLon(fFlipLatLon)
+	{
+		m_nLongitudes = static_cast<int>(dLonEdge.GetRows()) - 1;
+		m_nLatitudes = static_cast<int>(dLatEdge.GetRows()) - 1;
+
+		const double dLonBegin = dLonEdge[0];
+		const double dLonEnd = dLonEdge[m_nLongitudes];
+		const double dLatBegin = dLatEdge[0];
+		const double dLatEnd = dLatEdge[m_nLatitudes];
+
+		// Check if longitudes wrap
+		bool fWrapLongitudes = false;
+		if (fmod(dLonEnd - dLonBegin, 2.0 * M_PI) < 1.0e-12) {
+			fWrapLongitudes = true;
+		}
+		m_fIncludeSouthPole = (fabs(dLatBegin + 0.5 * M_PI) < 1.0e-12);
+		m_fIncludeNorthPole = (fabs(dLatEnd   - 0.5 * M_PI) < 1.0e-12);
+
+		m_iSouthPoleOffset = (m_fIncludeSouthPole)?(1):(0);
+
+		// Increase number of latitudes if south pole is not included
+		m_iInteriorLatBegin = (m_fIncludeSouthPole)?(1):(0);
+		m_iInteriorLatEnd   =
+			(m_fIncludeNorthPole)?(m_nLatitudes-1):(m_nLatitudes);
+
+		// Number of longitude nodes
+		m_nLongitudeNodes = m_nLongitudes;
+		if (!fWrapLongitudes) {
+			m_nLongitudeNodes++;
+		}
+
+		// Flip orientation
+		m_fFlipOrientation = false;
+
+		if (dLatEdge[1] < dLatEdge[0]) {
+			m_fFlipOrientation = !m_fFlipOrientation;
+		}
+		if (dLonEdge[1] < dLonEdge[0]) {
+			m_fFlipOrientation = !m_fFlipOrientation;
+		}
+	}
 
-	NcError error(NcError::silent_nonfatal);
+	///	<summary>
+	///		Total number of Nodes.
+	///	</summary>
+	int GetNodeCount() const {
+		return m_iSouthPoleOffset
+			+ (m_iInteriorLatEnd - m_iInteriorLatBegin + 1) * m_nLongitudeNodes
+			+ ((m_fIncludeNorthPole)?(1):(0));
+	}
 
-try {
+	///	<summary>
+	///		Total number of Faces.
+	///	</summary>
+	int GetFaceCount() const {
+		return m_nLongitudes * m_nLatitudes;
+	}
 
-    // Check command line parameters (data type arguments)
-    STLStringHelper::ToLower(strOutputFormat);
+	///	<summary>
+	///		Size of each grid dimension, as stored in Mesh::vecGridDimSize.
+	///	</summary>
+	void GetGridDimSize(std::vector<int> & vecGridDimSize) const {
+		vecGridDimSize.resize(2);
+		if (m_fFlipLatLon) {
+			vecGridDimSize[0] = m_nLongitudes;
+			vecGridDimSize[1] = m_nLatitudes;
+		} else {
+			vecGridDimSize[0] = m_nLatitudes;
+			vecGridDimSize[1] = m_nLongitudes;
+		}
+	}
 
-	NcFile::FileFormat eOutputFormat =
-		GetNcFileFormatFromString(strOutputFormat);
-	if (eOutputFormat == NcFile::BadFormat) {
-		_EXCEPTION1("Invalid \"out_format\" value (%s), "
-			"expected [Classic|Offset64Bits|Netcdf4|Netcdf4Classic]",
-			strOutputFormat.c_str());
+	///	<summary>
+	///		Get the Node with the given index.
+	///	</summary>
+	Node GetNode(int ix) const {
+		if (m_fIncludeSouthPole && (ix == 0)) {
+			return Node(0.0, 0.0, -1.0);
+		}
+		if (m_fIncludeNorthPole && (ix == GetNodeCount()-1)) {
+			return Node(0.0, 0.0, +1.0);
+		}
+
+		const int ixRow = ix - m_iSouthPoleOffset;
+		const int j = m_iInteriorLatBegin + ixRow / m_nLongitudeNodes;
+		const int i = ixRow % m_nLongitudeNodes;
+
+		double dLambda = m_dLonEdge[i];
+		double dPhi = m_dLatEdge[j];
+
+		double dX = cos(dPhi) * cos(dLambda);
+		double dY = cos(dPhi) * sin(dLambda);
+		double dZ = sin(dPhi);
+
+		return Node(dX, dY, dZ);
+	}
+
+	///	<summary>
+	///		Get the Face with the given index.  The Face must have four
+	///		edges.
+	///	</summary>
+	void GetFace(int ixFace, Face & face) const {
+		int i;
+		int j;
+		if (m_fFlipLatLon) {
+			i = ixFace / m_nLatitudes;
+			j = ixFace % m_nLatitudes;
+		} else {
+			j = ixFace / m_nLongitudes;
+			i = ixFace % m_nLongitudes;
+		}
+
+		const int nLongitudeNodes = m_nLongitudeNodes;
+
+		// South polar faces
+		if (m_fIncludeSouthPole && (j == 0)) {
+			face.SetNode(0, 0);
+			face.SetNode(2, i + 1);
+			if (!m_fFlipOrientation) {
+				face.SetNode(1, (i+1) % nLongitudeNodes + 1);
+				face.SetNode(3, 0);
+			} else {
+				face.SetNode(1, 0);
+				face.SetNode(3, (i+1) % nLongitudeNodes + 1);
+			}
+
+		// North polar faces
+		} else if (m_fIncludeNorthPole && (j == m_nLatitudes-1)) {
+			int jx = m_nLatitudes - m_iInteriorLatBegin - 1;
+
+			int iThisLatNodeIx = jx * nLongitudeNodes + m_iSouthPoleOffset;
+
+			int iNorthPolarNodeIx = GetNodeCount()-1;
+
+			face.SetNode(0, iNorthPolarNodeIx);
+			face.SetNode(2, iThisLatNodeIx + (i + 1) % nLongitudeNodes);
+
+			if (!m_fFlipOrientation) {
+				face.SetNode(1, iThisLatNodeIx + i);
+				face.SetNode(3, iNorthPolarNodeIx);
+			} else {
+				face.SetNode(1, iNorthPolarNodeIx);
+				face.SetNode(3, iThisLatNodeIx + i);
+			}
+
+		// Interior faces
+		} else {
+			int jx = j - m_iInteriorLatBegin;
+
+			int iThisLatNodeIx =  jx    * nLongitudeNodes + m_iSouthPoleOffset;
+			int iNextLatNodeIx = (jx+1) * nLongitudeNodes + m_iSouthPoleOffset;
+
+			face.SetNode(0, iThisLatNodeIx + (i + 1) % nLongitudeNodes);
+			face.SetNode(2, iNextLatNodeIx + i);
+
+			if (!m_fFlipOrientation) {
+				face.SetNode(1, iNextLatNodeIx + (i + 1) % nLongitudeNodes);
+				face.SetNode(3, iThisLatNodeIx + i);
+			} else {
+				face.SetNode(1, iThisLatNodeIx + i);
+				face.SetNode(3, iNextLatNodeIx + (i + 1) % nLongitudeNodes);
+			}
+		}
+
+#ifndef ONLY_GREAT_CIRCLES
+		face.edges[1].type = Edge::Type_ConstantLatitude;
+		face.edges[3].type = Edge::Type_ConstantLatitude;
+#endif
 	}
 
+protected:
+	///	<summary>
+	///		Longitude and latitude edges (in radians).
+	///	</summary>
+	const DataArray1D<double> & m_dLonEdge;
+	const DataArray1D<double> & m_dLatEdge;
+
+	///	<summary>
+	///		Order Faces longitude-major.
+	///	</summary>
+	bool m_fFlipLatLon;
+
+	///	<summary>
+	///		Number of longitudes and latitudes.
+	///	</summary>
+	int m_nLongitudes;
+	int m_nLatitudes;
+
+	///	<summary>
+	///		Number of Nodes along each latitude line.
+	///	</summary>
+	int m_nLongitudeNodes;
+
+	///	<summary>
+	///		Flags indicating the poles are Nodes of the mesh.
+	///	</summary>
+	bool m_fIncludeSouthPole;
+	bool m_fIncludeNorthPole;
+
+	///	<summary>
+	///		Index of the first Node on a latitude line.
+	///	</summary>
+	int m_iSouthPoleOffset;
+
+	///	<summary>
+	///		Range of latitude lines with non-polar Nodes.
+	///	</summary>
+	int m_iInteriorLatBegin;
+	int m_iInteriorLatEnd;
+
+	///	<summary>
+	///		Faces are oriented clockwise in longitude-latitude space.
+	///	</summary>
+	bool m_fFlipOrientation;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Determine the longitude and latitude edges (in radians) of a
+///		rectilinear mesh, either from the given parameters or from the
+///		coordinates in an input file.  Returns a nonzero value if the
+///		arguments are invalid.
+///	</summary>
+static int GetRLLMeshEdges(
+	int & nLongitudes,
+	int & nLatitudes,
+	double dLonBegin,
+	double dLonEnd,
+	double dLatBegin,
+	double dLatEnd,
+	bool fGlobalCap,
+	bool fForceGlobal,
+	const std::string & strInputFile,
+	const std::string & strInputFileLonName,
+	const std::string & strInputFileLatName,
+	bool fVerbose,
+	DataArray1D<double> & dLonEdge,
+	DataArray1D<double> & dLatEdge
+) {
 	// Check fGlobalCap argument
 	bool fCapBegin = false;
 	bool fCapEnd = false;
@@ -102,10 +317,6 @@ try {
 		}
 	}
 
-	// Longitude and latitude arrays
-	DataArray1D<double> dLonEdge;
-	DataArray1D<double> dLatEdge;
-
 	// Generate mesh from input datafile
 	if (strInputFile != "") {
 
@@ -356,182 +567,311 @@ try {
 		return -5; // Argument error
 	}
 
-	NodeVector & nodes = mesh.nodes;
-	FaceVector & faces = mesh.faces;
-    mesh.type = Mesh::MeshType_RLL;
+	return 0;
+}
+
+///	<summary>
+///		Add the rectilinear properties of the mesh to an Exodus mesh file.
+///	</summary>
+static void AddRLLMeshAttributes(
+	const std::string & strOutputFile,
+	int nLongitudes,
+	int nLatitudes,
+	bool fFlipLatLon
+) {
+	NcFile ncOutput(strOutputFile.c_str(), NcFile::Write);
+	ncOutput.add_att("rectilinear", "true");
 
-	// Check if longitudes wrap
-	bool fWrapLongitudes = false;
-	if (fmod(dLonEnd - dLonBegin, 2.0 * M_PI) < 1.0e-12) {
-		fWrapLongitudes = true;
+	if (fFlipLatLon) {
+		ncOutput.add_att("rectilinear_dim0_size", nLongitudes);
+		ncOutput.add_att("rectilinear_dim1_size", nLatitudes);
+		ncOutput.add_att("rectilinear_dim0_name", "lon");
+		ncOutput.add_att("rectilinear_dim1_name", "lat");
+	} else {
+		ncOutput.add_att("rectilinear_dim0_size", nLatitudes);
+		ncOutput.add_att("rectilinear_dim1_size", nLongitudes);
+		ncOutput.add_att("rectilinear_dim0_name", "lat");
+		ncOutput.add_att("rectilinear_dim1_name", "lon");
 	}
-	bool fIncludeSouthPole = (fabs(dLatBegin + 0.5 * M_PI) < 1.0e-12);
-	bool fIncludeNorthPole = (fabs(dLatEnd   - 0.5 * M_PI) < 1.0e-12);
+	ncOutput.close();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// 
+// Input Parameters:
+// Number of longitudes in mesh: int nLongitudes;
+// Number of latitudes in mesh: int nLatitudes;
+// First longitude line on mesh: double dLonBegin;
+// Last longitude line on mesh: double dLonEnd;
+// First latitude line on mesh: double dLatBegin;
+// Last latitude line on mesh: double dLatEnd;
+// Flip latitude and longitude dimension in FaceVector ordering: bool fFlipLatLon;
+// Output filename:  std::string strOutputFile;
+// 
+extern "C" 
+int GenerateRLLMesh(
+	Mesh & mesh, 
+	int nLongitudes,
+	int nLatitudes, 
+	double dLonBegin,
+	double dLonEnd, 
+	double dLatBegin,
+	double dLatEnd, 
+	bool fGlobalCap,
+	bool fFlipLatLon,
+	bool fForceGlobal,
+	std::string strInputFile,
+	std::string strInputFileLonName,
+	std::string strInputFileLatName,
+	std::string strOutputFile, 
+	std::string strOutputFormat,
+	bool fVerbose
+) {
+
+	NcError error(NcError::silent_nonfatal);
 
-	int iSouthPoleOffset = (fIncludeSouthPole)?(1):(0);
+try {
 
-	// Increase number of latitudes if south pole is not included
-	int iInteriorLatBegin = (fIncludeSouthPole)?(1):(0);
-	int iInteriorLatEnd   = (fIncludeNorthPole)?(nLatitudes-1):(nLatitudes);
+    // Check command line parameters (data type arguments)
+    STLStringHelper::ToLower(strOutputFormat);
 
-	// Number of longitude nodes
-	int nLongitudeNodes = nLongitudes;
-	if (!fWrapLongitudes) {
-		nLongitudeNodes++;
+	NcFile::FileFormat eOutputFormat =
+		GetNcFileFormatFromString(strOutputFormat);
+	if (eOutputFormat == NcFile::BadFormat) {
+		_EXCEPTION1("Invalid \"out_format\" value (%s), "
+			"expected [Classic|Offset64Bits|Netcdf4|Netcdf4Classic]",
+			strOutputFormat.c_str());
 	}
 
-	// Generate nodes
-	if (fIncludeSouthPole) {
-		nodes.push_back(Node(0.0, 0.0, -1.0));
+	// Longitude and latitude arrays
+	DataArray1D<double> dLonEdge;
+	DataArray1D<double> dLatEdge;
+
+	int err = GetRLLMeshEdges(
+		nLongitudes, nLatitudes,
+		dLonBegin, dLonEnd,
+		dLatBegin, dLatEnd,
+		fGlobalCap,
+		fForceGlobal,
+		strInputFile, strInputFileLonName, strInputFileLatName,
+		fVerbose,
+		dLonEdge, dLatEdge);
+
+	if (err) {
+		return err;
 	}
-	for (int j = iInteriorLatBegin; j < iInteriorLatEnd+1; j++) {
-		for (int i = 0; i < nLongitudeNodes; i++) {
 
-			double dLambda = dLonEdge[i];
-			double dPhi = dLatEdge[j];
+	RLLMeshStructure rllmesh(dLonEdge, dLatEdge, fFlipLatLon);
 
-			double dX = cos(dPhi) * cos(dLambda);
-			double dY = cos(dPhi) * sin(dLambda);
-			double dZ = sin(dPhi);
+	mesh.Clear();
 
-			nodes.push_back(Node(dX, dY, dZ));
-		}
-	}
-	if (fIncludeNorthPole) {
-		nodes.push_back(Node(0.0, 0.0, +1.0));
-	}
+	NodeVector & nodes = mesh.nodes;
+	FaceVector & faces = mesh.faces;
+    mesh.type = Mesh::MeshType_RLL;
 
-	// Flip orientation
-	bool fFlipOrientation = false;
+	// Generate nodes
+	const int nNodes = rllmesh.GetNodeCount();
+	nodes.resize(nNodes);
 
-	if (dLatEdge[1] < dLatEdge[0]) {
-		fFlipOrientation = !fFlipOrientation;
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < nNodes; i++) {
+		nodes[i] = rllmesh.GetNode(i);
 	}
-	if (dLonEdge[1] < dLonEdge[0]) {
-		fFlipOrientation = !fFlipOrientation;
+
+	// Generate faces
+	const int nFaces = rllmesh.GetFaceCount();
+	faces.resize(nFaces, Face(4));
+
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < nFaces; i++) {
+		rllmesh.GetFace(i, faces[i]);
 	}
 
-	// Generate south polar faces
-	if (fIncludeSouthPole) {
-		for (int i = 0; i < nLongitudes; i++) {
-			Face face(4);
-			face.SetNode(0, 0);
-			face.SetNode(2, i + 1);
-			if (!fFlipOrientation) {
-				face.SetNode(1, (i+1) % nLongitudeNodes + 1);
-				face.SetNode(3, 0);
-			} else {
-				face.SetNode(1, 0);
-				face.SetNode(3, (i+1) % nLongitudeNodes + 1);
-			}
+	// Output the mesh
+	if (strOutputFile.size()) {
 
-#ifndef ONLY_GREAT_CIRCLES
-			face.edges[1].type = Edge::Type_ConstantLatitude;
-			face.edges[3].type = Edge::Type_ConstantLatitude;
-#endif
+		// Announce
+		std::cout << "..Writing mesh to file [" << strOutputFile.c_str() << "] ";
+		std::cout << std::endl;
 
-			faces.push_back(face);
-		}
+		mesh.Write(strOutputFile, eOutputFormat);
+
+		// Add rectilinear properties
+		AddRLLMeshAttributes(
+			strOutputFile, nLongitudes, nLatitudes, fFlipLatLon);
 	}
 
-	// Generate interior faces
-	for (int j = iInteriorLatBegin; j < iInteriorLatEnd; j++) {
-		int jx = j - iInteriorLatBegin;
+	// Announce
+	std::cout << "..Mesh generator exited successfully" << std::endl;
+	std::cout << "=========================================================";
+	std::cout << std::endl;
 
-		int iThisLatNodeIx =  jx    * nLongitudeNodes + iSouthPoleOffset;
-		int iNextLatNodeIx = (jx+1) * nLongitudeNodes + iSouthPoleOffset;
+  return 0;
 
-		for (int i = 0; i < nLongitudes; i++) {
-			Face face(4);
-			face.SetNode(0, iThisLatNodeIx + (i + 1) % nLongitudeNodes);
-			face.SetNode(2, iNextLatNodeIx + i);
+} catch(Exception & e) {
+	Announce(e.ToString().c_str());
+	return (0);
 
-			if (!fFlipOrientation) {
-				face.SetNode(1, iNextLatNodeIx + (i + 1) % nLongitudeNodes);
-				face.SetNode(3, iThisLatNodeIx + i);
-			} else {
-				face.SetNode(1, iThisLatNodeIx + i);
-				face.SetNode(3, iNextLatNodeIx + (i + 1) % nLongitudeNodes);
-			}
-#ifndef ONLY_GREAT_CIRCLES
-			face.edges[1].type = Edge::Type_ConstantLatitude;
-			face.edges[3].type = Edge::Type_ConstantLatitude;
-#endif
+} catch(...) {
+	return (0);
+}
+}
 
-			faces.push_back(face);
-		}
-	}
+///////////////////////////////////////////////////////////////////////////////
+
+extern "C" 
+int GenerateRLLMeshStreamed(
+	int nLongitudes,
+	int nLatitudes, 
+	double dLonBegin,
+	double dLonEnd, 
+	double dLatBegin,
+	double dLatEnd, 
+	bool fGlobalCap,
+	bool fFlipLatLon,
+	bool fForceGlobal,
+	std::string strInputFile,
+	std::string strInputFileLonName,
+	std::string strInputFileLatName,
+	std::string strOutputFile, 
+	std::string strOutputFormat,
+	std::string strOutputType,
+	bool fVerbose
+) {
 
-	// Generate north polar faces
-	if (fIncludeNorthPole) {
-		int jx = nLatitudes - iInteriorLatBegin - 1;
+	NcError error(NcError::silent_nonfatal);
 
-		int iThisLatNodeIx =  jx    * nLongitudeNodes + iSouthPoleOffset;
-		int iNextLatNodeIx = (jx+1) * nLongitudeNodes + iSouthPoleOffset;
+try {
 
-		int iNorthPolarNodeIx = static_cast<int>(nodes.size()-1);
-		for (int i = 0; i < nLongitudes; i++) {
-			Face face(4);
-			face.SetNode(0, iNorthPolarNodeIx);
-			face.SetNode(2, iThisLatNodeIx + (i + 1) % nLongitudeNodes);
+    // Check command line parameters (data type arguments)
+    STLStringHelper::ToLower(strOutputFormat);
+    STLStringHelper::ToLower(strOutputType);
 
-			if (!fFlipOrientation) {
-				face.SetNode(1, iThisLatNodeIx + i);
-				face.SetNode(3, iNorthPolarNodeIx);
-			} else {
-				face.SetNode(1, iNorthPolarNodeIx);
-				face.SetNode(3, iThisLatNodeIx + i);
-			}
+	NcFile::FileFormat eOutputFormat =
+		GetNcFileFormatFromString(strOutputFormat);
+	if (eOutputFormat == NcFile::BadFormat) {
+		_EXCEPTION1("Invalid \"out_format\" value (%s), "
+			"expected [Classic|Offset64Bits|Netcdf4|Netcdf4Classic]",
+			strOutputFormat.c_str());
+	}
+	if ((strOutputType != "exodus") && (strOutputType != "scrip")) {
+		_EXCEPTION1("Invalid \"out_type\" value (%s), "
+			"expected [exodus|scrip]",
+			strOutputType.c_str());
+	}
+	if (strOutputFile.size() == 0) {
+		_EXCEPTIONT("Output file must be specified when streaming");
+	}
 
-#ifndef ONLY_GREAT_CIRCLES
-			face.edges[1].type = Edge::Type_ConstantLatitude;
-			face.edges[3].type = Edge::Type_ConstantLatitude;
-#endif
+	// Longitude and latitude arrays
+	DataArray1D<double> dLonEdge;
+	DataArray1D<double> dLatEdge;
 
-			faces.push_back(face);
-		}
+	int err = GetRLLMeshEdges(
+		nLongitudes, nLatitudes,
+		dLonBegin, dLonEnd,
+		dLatBegin, dLatEnd,
+		fGlobalCap,
+		fForceGlobal,
+		strInputFile, strInputFileLonName, strInputFileLatName,
+		fVerbose,
+		dLonEdge, dLatEdge);
+
+	if (err) {
+		return err;
 	}
 
-	// Reorder the faces
-	if (fFlipLatLon) {
-		FaceVector faceTemp = mesh.faces;
-		mesh.faces.clear();
-		for (int i = 0; i < nLongitudes; i++) {
-		for (int j = 0; j < nLatitudes; j++) {
-			mesh.faces.push_back(faceTemp[j * nLongitudes + i]);
-		}
+	RLLMeshStructure rllmesh(dLonEdge, dLatEdge, fFlipLatLon);
+
+	const int nNodes = rllmesh.GetNodeCount();
+	const int nFaces = rllmesh.GetFaceCount();
+
+	// Announce
+	std::cout << "..Streaming mesh to file [" << strOutputFile.c_str() << "] ";
+	std::cout << std::endl;
+
+	int nChunkFaces = MeshStreamChunkFaces;
+
+	// Exodus output
+	if (strOutputType == "exodus") {
+		ExodusMeshWriter writer;
+		writer.Open(strOutputFile, nNodes, nFaces, 4, eOutputFormat);
+
+		NodeVector nodes;
+		for (int ixBegin = 0; ixBegin < nNodes; ixBegin += nChunkFaces) {
+			const int nCount = std::min(nChunkFaces, nNodes - ixBegin);
+
+			nodes.resize(nCount);
+
+#pragma omp parallel for schedule(static)
+			for (int i = 0; i < nCount; i++) {
+				nodes[i] = rllmesh.GetNode(ixBegin + i);
+			}
+
+			writer.WriteNodes(ixBegin, nodes);
 		}
-	}
 
-	// Output the mesh
-	if (strOutputFile.size()) {
+		FaceVector faces;
+		for (int ixBegin = 0; ixBegin < nFaces; ixBegin += nChunkFaces) {
+			const int nCount = std::min(nChunkFaces, nFaces - ixBegin);
 
-		// Announce
-		std::cout << "..Writing mesh to file [" << strOutputFile.c_str() << "] ";
-		std::cout << std::endl;
+			faces.resize(nCount, Face(4));
 
-		mesh.Write(strOutputFile, eOutputFormat);
+#pragma omp parallel for schedule(static)
+			for (int i = 0; i < nCount; i++) {
+				rllmesh.GetFace(ixBegin + i, faces[i]);
+			}
+
+			writer.WriteFaces(ixBegin, faces);
+		}
+
+		writer.Close();
 
 		// Add rectilinear properties
-		//if (!fIncludeSouthPole) {
-		//	nLatitudes--;
-		//}
-
-		NcFile ncOutput(strOutputFile.c_str(), NcFile::Write);
-		ncOutput.add_att("rectilinear", "true");
-
-		if (fFlipLatLon) {
-			ncOutput.add_att("rectilinear_dim0_size", nLongitudes);
-			ncOutput.add_att("rectilinear_dim1_size", nLatitudes);
-			ncOutput.add_att("rectilinear_dim0_name", "lon");
-			ncOutput.add_att("rectilinear_dim1_name", "lat");
-		} else {
-			ncOutput.add_att("rectilinear_dim0_size", nLatitudes);
-			ncOutput.add_att("rectilinear_dim1_size", nLongitudes);
-			ncOutput.add_att("rectilinear_dim0_name", "lat");
-			ncOutput.add_att("rectilinear_dim1_name", "lon");
+		AddRLLMeshAttributes(
+			strOutputFile, nLongitudes, nLatitudes, fFlipLatLon);
+
+	// SCRIP output, where the Faces of each chunk refer to a local copy
+	// of their Nodes
+	} else {
+		std::vector<int> vecGridDimSize;
+		rllmesh.GetGridDimSize(vecGridDimSize);
+
+		ScripMeshWriter writer;
+		writer.Open(strOutputFile, nFaces, 4, vecGridDimSize, eOutputFormat);
+
+		NodeVector nodes;
+		FaceVector faces;
+		for (int ixBegin = 0; ixBegin < nFaces; ixBegin += nChunkFaces) {
+			const int nCount = std::min(nChunkFaces, nFaces - ixBegin);
+
+			nodes.resize(4 * nCount);
+			faces.resize(nCount, Face(4));
+
+#pragma omp parallel for schedule(static)
+			for (int i = 0; i < nCount; i++) {
+				Face faceGlobal(4);
+				rllmesh.GetFace(ixBegin + i, faceGlobal);
+
+				// Repeated Nodes (at the poles) share a local index
+				for (int k = 0; k < 4; k++) {
+					int ixLocal = 4 * i + k;
+					for (int l = 0; l < k; l++) {
+						if (faceGlobal[l] == faceGlobal[k]) {
+							ixLocal = 4 * i + l;
+							break;
+						}
+					}
+					nodes[ixLocal] = rllmesh.GetNode(faceGlobal[k]);
+					faces[i].SetNode(k, ixLocal);
+					faces[i].edges[k].type = faceGlobal.edges[k].type;
+				}
+			}
+
+			writer.WriteFaces(ixBegin, faces, nodes);
 		}
-		ncOutput.close();
+
+		writer.Close();
 	}
 
 	// Announce
@@ -72,6 +72,12 @@ int main(int argc, char** argv) {
 	// Output format
 	std::string strOutputFormat;
 
+	// Write the mesh in chunks without storing it in memory
+	bool fStream;
+
+	// Type of mesh file written when streaming
+	std::string strOutputType;
+
     // Parse the command line
     BeginCommandLine()
     CommandLineInt(nLongitudes, "lon", 128);
@@ -89,6 +95,8 @@ int main(int argc, char** argv) {
     CommandLineBool(fVerbose, "verbose");
     CommandLineString(strOutputFile, "file", "outRLLMesh.g");
 	CommandLineString(strOutputFormat, "out_format", "Netcdf4");
+	CommandLineBool(fStream, "stream");
+	CommandLineStringD(strOutputType, "out_type", "exodus", "[exodus|scrip] (with --stream)");
 
     ParseCommandLine(argc, argv);
     EndCommandLine(argv)
@@ -105,18 +113,33 @@ int main(int argc, char** argv) {
     std::cout << std::endl;
 
 	// Call the actual mesh generator
-    Mesh mesh;
-    int err = GenerateRLLMesh(
-		mesh,
-		nLongitudes, nLatitudes,
-		dLonBegin, dLonEnd,
-		dLatBegin, dLatEnd,
-		fGlobalCap,
-		fFlipLatLon,
-		fForceGlobal,
-		strInputFile, strInputFileLonName, strInputFileLatName,
-		strOutputFile, strOutputFormat,
-		fVerbose);
+	int err;
+	if (fStream) {
+		err = GenerateRLLMeshStreamed(
+			nLongitudes, nLatitudes,
+			dLonBegin, dLonEnd,
+			dLatBegin, dLatEnd,
+			fGlobalCap,
+			fFlipLatLon,
+			fForceGlobal,
+			strInputFile, strInputFileLonName, strInputFileLatName,
+			strOutputFile, strOutputFormat, strOutputType,
+			fVerbose);
+
+	} else {
+		Mesh mesh;
+		err = GenerateRLLMesh(
+			mesh,
+			nLongitudes, nLatitudes,
+			dLonBegin, dLonEnd,
+			dLatBegin, dLatEnd,
+			fGlobalCap,
+			fFlipLatLon,
+			fForceGlobal,
+			strInputFile, strInputFileLonName, strInputFileLatName,
+			strOutputFile, strOutputFormat,
+			fVerbose);
+	}
 	if (err) exit(err);
 
 	return 0;
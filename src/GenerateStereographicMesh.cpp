@@ -88,6 +88,8 @@ try {
 	// Announce
 	std::cout << "..Generating polar stereographic mesh" << std::endl;
 
+	mesh.Clear();
+
 	NodeVector & nodes = mesh.nodes;
 	FaceVector & faces = mesh.faces;
     mesh.type = Mesh::MeshType_Transect;
@@ -170,7 +172,12 @@ try {
 		dDeltaB = (dB1 - dB0) / static_cast<double>(nYElements);
 	}
 
-	// Insert vertices into mesh
+	// Insert vertices into mesh, one row per iteration
+	nodes.resize((nYElements + 1) * (nXElements + 1));
+
+	int nNonUnitNodes = 0;
+
+#pragma omp parallel for schedule(static) reduction(+:nNonUnitNodes)
 	for (int j = 0; j <= nYElements; j++) {
 		double dB = dB0 + dDeltaB * static_cast<double>(j);
 
@@ -191,23 +198,29 @@ try {
 			double dY = sin(dLonRad) * cos(dLatRad);
 			double dZ = sin(dLatRad);
 
-			_ASSERT(fabs(dX * dX + dY * dY + dZ * dZ - 1.0) < ReferenceTolerance);
+			if (!(fabs(dX * dX + dY * dY + dZ * dZ - 1.0) < ReferenceTolerance)) {
+				nNonUnitNodes++;
+			}
 
-			nodes.push_back(Node(dX,dY,dZ));
+			nodes[j * (nXElements + 1) + i] = Node(dX,dY,dZ);
 		}
 	}
 
+	_ASSERT(nNonUnitNodes == 0);
+
 	std::cout << "..Inserting faces" << std::endl;
 
 	// Insert faces
+	faces.resize(nYElements * nXElements, Face(4));
+
+#pragma omp parallel for schedule(static)
 	for (int j = 0; j < nYElements; j++) {
 	for (int i = 0; i < nXElements; i++) {
-		Face face(4);
+		Face & face = faces[j * nXElements + i];
 		face.SetNode(0,  i      +  j      * (nXElements+1));
 		face.SetNode(1, (i + 1) +  j      * (nXElements+1));
 		face.SetNode(2, (i + 1) + (j + 1) * (nXElements+1));
 		face.SetNode(3,  i      + (j + 1) * (nXElements+1));
-		faces.push_back(face);
 	}
 	}
 
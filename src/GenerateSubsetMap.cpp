@@ -0,0 +1,274 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    GenerateSubsetMap.cpp
+///	\author  Paul Ullrich
+///	\version October 14, 2026
+///
+///	<remarks>
+///		Copyright 2026 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "CommandLine.h"
+#include "Announce.h"
+#include "OfflineMap.h"
+
+#include "netcdfcpp.h"
+
+#include <cmath>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+///////////////////////////////////////////////////////////////////////////////
+
+typedef std::map<std::string, std::string> AttributeMap;
+typedef AttributeMap::value_type AttributePair;
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Read a list of 1-based target indices from a text file, separated by
+///		whitespace.  Lines beginning with '#' are ignored.
+///	</summary>
+static void ParseTargetList(
+	const std::string & strTargetList,
+	std::vector<int> & vecTargetIx
+) {
+	std::ifstream ifTargetList(strTargetList.c_str());
+	if (!ifTargetList.is_open()) {
+		_EXCEPTION1("Unable to open file \"%s\"",
+			strTargetList.c_str());
+	}
+	std::string strLine;
+	while (std::getline(ifTargetList, strLine)) {
+		if ((strLine.length() != 0) && (strLine[0] == '#')) {
+			continue;
+		}
+		std::istringstream issLine(strLine);
+		std::string strIx;
+		while (issLine >> strIx) {
+			char * pszEnd = NULL;
+			long lIx = strtol(strIx.c_str(), &pszEnd, 10);
+			if ((*pszEnd != '\0') || (lIx < 1) || (lIx > INT_MAX)) {
+				_EXCEPTION2("Invalid target index \"%s\" in \"%s\"",
+					strIx.c_str(), strTargetList.c_str());
+			}
+			vecTargetIx.push_back(static_cast<int>(lIx - 1));
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Read the target indices with nonzero values of a mask variable.
+///	</summary>
+static void ParseTargetMask(
+	const std::string & strTargetMask,
+	const std::string & strTargetMaskVar,
+	std::vector<int> & vecTargetIx
+) {
+	NcFile ncMask(strTargetMask.c_str(), NcFile::ReadOnly);
+	if (!ncMask.is_valid()) {
+		_EXCEPTION1("Unable to open mask file \"%s\"",
+			strTargetMask.c_str());
+	}
+
+	NcVar * varMask = ncMask.get_var(strTargetMaskVar.c_str());
+	if (varMask == NULL) {
+		_EXCEPTION2("Mask file \"%s\" does not contain variable \"%s\"",
+			strTargetMask.c_str(), strTargetMaskVar.c_str());
+	}
+
+	std::vector<long> vecCounts(varMask->num_dims());
+	for (int d = 0; d < varMask->num_dims(); d++) {
+		vecCounts[d] = varMask->get_dim(d)->size();
+	}
+
+	DataArray1D<double> dMask(varMask->num_vals());
+	if (dMask.GetRows() != 0) {
+		varMask->get(&(dMask[0]), &(vecCounts[0]));
+	}
+
+	for (size_t i = 0; i < dMask.GetRows(); i++) {
+		if (dMask[i] != 0.0) {
+			vecTargetIx.push_back(static_cast<int>(i));
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Add a variable with the 1-based index in the input map of each
+///		degree of freedom of a subset map.
+///	</summary>
+static void WriteSubsetIndices(
+	NcFile & ncMap,
+	const char * szVarName,
+	const char * szDimName,
+	const std::vector<int> & vecIx
+) {
+	NcDim * dim = ncMap.get_dim(szDimName);
+	if (dim == NULL) {
+		_EXCEPTION1("Output map missing dimension \"%s\"", szDimName);
+	}
+
+	DataArray1D<int> vecIxOut(vecIx.size());
+	for (size_t i = 0; i < vecIx.size(); i++) {
+		vecIxOut[i] = vecIx[i] + 1;
+	}
+
+	NcVar * var = ncMap.add_var(szVarName, ncInt, dim);
+	if (var == NULL) {
+		_EXCEPTION1("Unable to add variable \"%s\" to output map", szVarName);
+	}
+	if (vecIxOut.GetRows() != 0) {
+		var->put(&(vecIxOut[0]), vecIxOut.GetRows());
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv) {
+
+	NcError error(NcError::silent_nonfatal);
+
+try {
+	// Map file for input
+	std::string strInputMapFile;
+
+	// Map file for output
+	std::string strOutputMapFile;
+
+	// Text file with the 1-based target indices to extract
+	std::string strTargetList;
+
+	// NetCDF file with a mask of the target degrees of freedom to extract
+	std::string strTargetMask;
+
+	// Variable containing the mask
+	std::string strTargetMaskVar;
+
+	// Do not verify the map
+	bool fNoCheck;
+
+	// Parse the command line
+	BeginCommandLine()
+		CommandLineString(strInputMapFile, "in", "");
+		CommandLineString(strOutputMapFile, "out", "");
+		CommandLineString(strTargetList, "target_list", "");
+		CommandLineString(strTargetMask, "target_mask", "");
+		CommandLineString(strTargetMaskVar, "target_mask_var", "mask");
+		CommandLineBool(fNoCheck, "nocheck");
+
+		ParseCommandLine(argc, argv);
+	EndCommandLine(argv)
+
+	AnnounceBanner();
+
+	// Check arguments
+	if (strInputMapFile == "") {
+		_EXCEPTIONT("Input map file (--in) must be specified");
+	}
+	if (strOutputMapFile == "") {
+		_EXCEPTIONT("Output map file (--out) must be specified");
+	}
+	if ((strTargetList == "") == (strTargetMask == "")) {
+		_EXCEPTIONT("Exactly one of --target_list or --target_mask "
+			"must be specified");
+	}
+
+	// Target degrees of freedom to extract
+	std::vector<int> vecTargetIx;
+
+	AnnounceStartBlock("Loading target subset");
+	if (strTargetList != "") {
+		ParseTargetList(strTargetList, vecTargetIx);
+	} else {
+		ParseTargetMask(strTargetMask, strTargetMaskVar, vecTargetIx);
+	}
+	Announce("Target degrees of freedom: %lu", vecTargetIx.size());
+	AnnounceEndBlock("Done");
+
+	// Load map from file.  Binary maps are memory mapped and NetCDF maps
+	// only retain the selected rows, so the full map is never in memory.
+	const bool fBinary = OfflineMap::IsBinaryMapFile(strInputMapFile);
+
+	AnnounceStartBlock("Loading input map");
+	AttributeMap mapAttributes;
+	OfflineMap mapIn;
+	NcFile::FileFormat eFileFormat;
+	mapIn.SetReadTargetRows(vecTargetIx);
+	mapIn.Read(strInputMapFile, &mapAttributes, &eFileFormat);
+	AnnounceEndBlock("Done");
+
+	// Extract the subset
+	AnnounceStartBlock("Extracting subset");
+	OfflineMap mapOut;
+	std::vector<int> vecSourceIx;
+	mapOut.SetSubset(mapIn, vecTargetIx, &vecSourceIx);
+	Announce("Source degrees of freedom: %lu", vecSourceIx.size());
+	Announce("Nonzero entries: %lu",
+		mapOut.GetSparseMatrix().GetNonZeroCount());
+	AnnounceEndBlock("Done");
+
+	// Verify map
+	if (!fNoCheck) {
+		AnnounceStartBlock("Verifying map");
+		mapOut.IsConsistent(1.0e-8);
+		AnnounceEndBlock("Done");
+	}
+
+	// Find version name
+	AttributeMap::iterator iterVersion = mapAttributes.find("version");
+	if (iterVersion == mapAttributes.end()) {
+		mapAttributes.insert(
+			AttributePair("version", "GenerateSubsetMap 1.0 : 2026-10-14"));
+	} else {
+		iterVersion->second =
+			"GenerateSubsetMap 1.0 : 2026-10-14 :: " + iterVersion->second;
+	}
+
+	// Write map to file in the format of the input map
+	AnnounceStartBlock("Writing subset map");
+	if (fBinary) {
+		mapOut.WriteBinary(strOutputMapFile, mapAttributes);
+
+	} else {
+		mapOut.Write(strOutputMapFile, mapAttributes, eFileFormat);
+
+		// Record where each degree of freedom is found in the input map
+		NcFile ncMap(strOutputMapFile.c_str(), NcFile::Write);
+		if (!ncMap.is_valid()) {
+			_EXCEPTION1("Unable to open output map file \"%s\"",
+				strOutputMapFile.c_str());
+		}
+		WriteSubsetIndices(ncMap, "subset_ix_a", "n_a", vecSourceIx);
+		WriteSubsetIndices(ncMap, "subset_ix_b", "n_b", vecTargetIx);
+	}
+	AnnounceEndBlock("Done");
+
+	AnnounceBanner();
+
+	return (0);
+
+} catch(Exception & e) {
+	Announce(e.ToString().c_str());
+	return (-1);
+
+} catch(...) {
+	return (-2);
+}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
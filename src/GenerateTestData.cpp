@@ -28,6 +28,7 @@
 
 #include <cmath>
 #include <iostream>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -49,7 +50,44 @@ public:
 	virtual double operator()(
 		double dLon,
 		double dLat
-	) = 0;
+	) const = 0;
+
+	///	<summary>
+	///		Evaluate the test function at a batch of points.
+	///	</summary>
+	virtual void Evaluate(
+		int nPoints,
+		const double * dLon,
+		const double * dLat,
+		double * dValue
+	) const = 0;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A TestFunction whose batch evaluation calls the operator() of the
+///		derived class directly, rather than through a virtual call for
+///		each point.
+///	</summary>
+template <class Derived>
+class TestFunctionBatched : public TestFunction {
+
+public:
+	///	<summary>
+	///		Evaluate the test function at a batch of points.
+	///	</summary>
+	virtual void Evaluate(
+		int nPoints,
+		const double * dLon,
+		const double * dLat,
+		double * dValue
+	) const {
+		const Derived & func = static_cast<const Derived &>(*this);
+		for (int i = 0; i < nPoints; i++) {
+			dValue[i] = func.Derived::operator()(dLon[i], dLat[i]);
+		}
+	}
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -57,7 +95,7 @@ public:
 ///	<summary>
 ///		A relatively smooth low-order harmonic.
 ///	</summary>
-class TestFunctionY2b2 : public TestFunction {
+class TestFunctionY2b2 : public TestFunctionBatched<TestFunctionY2b2> {
 
 public:
 	///	<summary>
@@ -66,7 +104,7 @@ public:
 	virtual double operator()(
 		double dLon,
 		double dLat
-	) {
+	) const {
 		return (2.0 + cos(dLat) * cos(dLat) * cos(2.0 * dLon));
 	}
 };
@@ -76,7 +114,7 @@ public:
 ///	<summary>
 ///		A high frequency spherical harmonic.
 ///	</summary>
-class TestFunctionY16b32 : public TestFunction {
+class TestFunctionY16b32 : public TestFunctionBatched<TestFunctionY16b32> {
 
 public:
 	///	<summary>
@@ -85,7 +123,7 @@ public:
 	virtual double operator()(
 		double dLon,
 		double dLat
-	) {
+	) const {
 		return (2.0 + pow(sin(2.0 * dLat), 16.0) * cos(16.0 * dLon));
 		//return (2.0 + pow(cos(2.0 * dLat), 16.0) * cos(16.0 * dLon));
 	}
@@ -96,7 +134,7 @@ public:
 ///	<summary>
 ///		The constant function
 ///	</summary>
-class TestFunction1 : public TestFunction {
+class TestFunction1 : public TestFunctionBatched<TestFunction1> {
 
 public:
 	///	<summary>
@@ -105,7 +143,7 @@ public:
 	virtual double operator()(
 		double dLon,
 		double dLat
-	) {
+	) const {
           return 1;
 	}
 };
@@ -115,7 +153,7 @@ public:
 ///	<summary>
 ///		The longitude function.
 ///	</summary>
-class TestFunctionLonDeg : public TestFunction {
+class TestFunctionLonDeg : public TestFunctionBatched<TestFunctionLonDeg> {
 
 public:
 	///	<summary>
@@ -124,7 +162,7 @@ public:
 	virtual double operator()(
 		double dLon,
 		double dLat
-	) {
+	) const {
           return 180.0 / M_PI * dLon;
 	}
 };
@@ -134,7 +172,7 @@ public:
 ///	<summary>
 ///		The latitude function.
 ///	</summary>
-class TestFunctionLatDeg : public TestFunction {
+class TestFunctionLatDeg : public TestFunctionBatched<TestFunctionLatDeg> {
 
 public:
 	///	<summary>
@@ -143,7 +181,7 @@ public:
 	virtual double operator()(
 		double dLon,
 		double dLat
-	) {
+	) const {
           return 180.0 / M_PI * dLat;
 	}
 };
@@ -153,7 +191,7 @@ public:
 ///	<summary>
 ///		Stationary vortex fields.
 ///	</summary>
-class TestFunctionVortex : public TestFunction {
+class TestFunctionVortex : public TestFunctionBatched<TestFunctionVortex> {
 
 public:
 	///	<summary>
@@ -165,7 +203,7 @@ public:
 		double dLatC,
 		double & dLonT,
 		double & dLatT
-	) {
+	) const {
 		double dSinC = sin(dLatC);
 		double dCosC = cos(dLatC);
 		double dCosT = cos(dLatT);
@@ -189,7 +227,7 @@ public:
 	virtual double operator()(
 		double dLon,
 		double dLat
-	) {
+	) const {
 		const double dLon0 = 0.0;
 		const double dLat0 = 0.6;
 		const double dR0 = 3.0;
@@ -415,30 +453,39 @@ try {
 		// Resize the array
 		dVar.Allocate(mesh.faces.size());
 
-		// Loop through all Faces
-		for (int i = 0; i < mesh.faces.size(); i++) {
+		const int nFaces = static_cast<int>(mesh.faces.size());
+
+		// Faces are sampled in parallel; all quadrature points of a Face
+		// are evaluated as one batch
+#pragma omp parallel
+		{
+		std::vector<double> dSampleLon;
+		std::vector<double> dSampleLat;
+		std::vector<double> dSample;
+
+#pragma omp for schedule(static)
+		for (int i = 0; i < nFaces; i++) {
 
 			const Face & face = mesh.faces[i];
 
-			// Loop through all sub-triangles
-			for (int j = 0; j < face.edges.size()-2; j++) {
+			const int nTriangles = static_cast<int>(face.edges.size()) - 2;
+			const int nFacePoints = nTriangles * TriQuadraturePoints;
 
-				const Node & node0 = mesh.nodes[face[0]];
-				const Node & node1 = mesh.nodes[face[j+1]];
-				const Node & node2 = mesh.nodes[face[j+2]];
+			if (nFacePoints <= 0) {
+				continue;
+			}
 
-				// Triangle area
-				Face faceTri(3);
-				faceTri.SetNode(0, face[0]);
-				faceTri.SetNode(1, face[j+1]);
-				faceTri.SetNode(2, face[j+2]);
+			dSampleLon.resize(nFacePoints);
+			dSampleLat.resize(nFacePoints);
+			dSample.resize(nFacePoints);
 
-				double dTriangleArea = CalculateFaceArea(faceTri, mesh.nodes);
+			// Quadrature points of all sub-triangles
+			for (int j = 0; j < nTriangles; j++) {
 
-				// Calculate the element average
-				double dTotalSample = 0.0;
+				const Node & node0 = mesh.nodes[face[0]];
+				const Node & node1 = mesh.nodes[face[j+1]];
+				const Node & node2 = mesh.nodes[face[j+2]];
 
-				// Loop through all quadrature points
 				for (int k = 0; k < TriQuadraturePoints; k++) {
 					Node node(
 						  TriQuadratureG[k][0] * node0.x
@@ -462,23 +509,51 @@ try {
 					}
 					double dLat = asin(node.z);
 
-					double dSample = (*pTest)(dLon, dLat);
-
-					dTotalSample += dSample * TriQuadratureW[k] * dTriangleArea;
+					dSampleLon[j * TriQuadraturePoints + k] = dLon;
+					dSampleLat[j * TriQuadraturePoints + k] = dLat;
 				}
+			}
+
+			pTest->Evaluate(
+				nFacePoints,
+				&(dSampleLon[0]),
+				&(dSampleLat[0]),
+				&(dSample[0]));
+
+			// Flip the rectilinear coordinate
+			int iv = i;
+			if (fFlipRectilinear) {
+				int i0 = i % vecOutputDimSizes[0];
+				int i1 = i / vecOutputDimSizes[0];
+
+				iv = i0 * vecOutputDimSizes[1] + i1;
+			}
+
+			// Loop through all sub-triangles
+			for (int j = 0; j < nTriangles; j++) {
 
-				// Flip the rectilinear coordinate
-				int iv = i;
-				if (fFlipRectilinear) {
-					int i0 = i % vecOutputDimSizes[0];
-					int i1 = i / vecOutputDimSizes[0];
+				// Triangle area
+				Face faceTri(3);
+				faceTri.SetNode(0, face[0]);
+				faceTri.SetNode(1, face[j+1]);
+				faceTri.SetNode(2, face[j+2]);
+
+				double dTriangleArea = CalculateFaceArea(faceTri, mesh.nodes);
 
-					iv = i0 * vecOutputDimSizes[1] + i1;
+				// Calculate the element average
+				double dTotalSample = 0.0;
+
+				// Loop through all quadrature points
+				for (int k = 0; k < TriQuadraturePoints; k++) {
+					dTotalSample +=
+						dSample[j * TriQuadraturePoints + k]
+						* TriQuadratureW[k] * dTriangleArea;
 				}
+
 				dVar[iv] += dTotalSample / mesh.vecFaceArea[i];
-				//dVar[i] += dTotalSample / mesh.vecFaceArea[i];
 			}
 		}
+		}
 
 	// Finite element data
 	} else {
@@ -543,13 +618,31 @@ try {
 		dVar.Allocate(iMaxNode);
 		dNodeArea.Allocate(iMaxNode);
 
-		// Sample data
-		for (int k = 0; k < nElements; k++) {
+		// Sample data at GLL nodes
+		if (fGLL) {
 
-			const Face & face = mesh.faces[k];
+			// A node shared by several elements takes its value from the
+			// last of them, as when elements are sampled in order
+			DataArray1D<int> iNodeOwner(iMaxNode);
+			for (int k = 0; k < nElements; k++) {
+				for (int i = 0; i < nP; i++) {
+				for (int j = 0; j < nP; j++) {
+					iNodeOwner[dataGLLNodes[j][i][k]-1] = k;
+				}
+				}
+			}
+
+#pragma omp parallel
+			{
+			DataArray1D<double> dSampleLon(nP * nP);
+			DataArray1D<double> dSampleLat(nP * nP);
+			DataArray1D<double> dSample(nP * nP);
+
+#pragma omp for schedule(static)
+			for (int k = 0; k < nElements; k++) {
+
+				const Face & face = mesh.faces[k];
 
-			// Sample data at GLL nodes
-			if (fGLL) {
 				for (int i = 0; i < nP; i++) {
 				for (int j = 0; j < nP; j++) {
 
@@ -574,21 +667,80 @@ try {
 					}
 					double dNodeLat = asin(node.z);
 
-					double dSample = (*pTest)(dNodeLon, dNodeLat);
+					dSampleLon[i * nP + j] = dNodeLon;
+					dSampleLat[i * nP + j] = dNodeLat;
+				}
+				}
+
+				pTest->Evaluate(
+					nP * nP, &(dSampleLon[0]), &(dSampleLat[0]), &(dSample[0]));
+
+				for (int i = 0; i < nP; i++) {
+				for (int j = 0; j < nP; j++) {
+					const int ix = dataGLLNodes[j][i][k]-1;
+					if (iNodeOwner[ix] != k) {
+						continue;
+					}
 
-					dVar[dataGLLNodes[j][i][k]-1] = dSample;
+					dVar[ix] = dSample[i * nP + j];
 
 					if (fHOMMEFormat) {
-						dLat[dataGLLNodes[j][i][k]-1] = dNodeLat * 180.0 / M_PI;
-						dLon[dataGLLNodes[j][i][k]-1] = dNodeLon * 180.0 / M_PI;
-						dArea[dataGLLNodes[j][i][k]-1] += dataGLLJacobian[j][i][k];
+						dLat[ix] = dSampleLat[i * nP + j] * 180.0 / M_PI;
+						dLon[ix] = dSampleLon[i * nP + j] * 180.0 / M_PI;
 					}
 				}
 				}
+			}
+			}
 
-			// High-order Gaussian integration over basis function
-			} else {
-				DataArray2D<double> dCoeff(nP, nP);
+			if (fHOMMEFormat) {
+				for (int k = 0; k < nElements; k++) {
+					for (int i = 0; i < nP; i++) {
+					for (int j = 0; j < nP; j++) {
+						dArea[dataGLLNodes[j][i][k]-1] += dataGLLJacobian[j][i][k];
+					}
+					}
+				}
+			}
+
+		// High-order Gaussian integration over basis function
+		} else {
+
+			// Coefficients of the basis functions at each Gauss point are
+			// the same for all elements
+			const int nGaussPoints = nGaussP * nGaussP;
+
+			DataArray1D<double> dGaussAlpha(nGaussPoints);
+			DataArray1D<double> dGaussBeta(nGaussPoints);
+			for (int p = 0; p < nGaussP; p++) {
+			for (int q = 0; q < nGaussP; q++) {
+				dGaussAlpha[p * nGaussP + q] = dGaussG[p];
+				dGaussBeta[p * nGaussP + q] = dGaussG[q];
+			}
+			}
+
+			DataArray3D<double> dGaussCoeff(nGaussPoints, nP, nP);
+			SampleGLLFiniteElement(
+				0, nP, nGaussPoints,
+				&(dGaussAlpha[0]), &(dGaussBeta[0]),
+				dGaussCoeff);
+
+			// Integrals over each element are formed in parallel and then
+			// summed into the shared nodes in element order
+			DataArray3D<double> dElementVar(nElements, nP, nP);
+			DataArray3D<double> dElementArea(nElements, nP, nP);
+
+#pragma omp parallel
+			{
+			DataArray1D<double> dSampleLon(nGaussPoints);
+			DataArray1D<double> dSampleLat(nGaussPoints);
+			DataArray1D<double> dSample(nGaussPoints);
+			DataArray1D<double> dJacobian(nGaussPoints);
+
+#pragma omp for schedule(static)
+			for (int k = 0; k < nElements; k++) {
+
+				const Face & face = mesh.faces[k];
 
 				for (int p = 0; p < nGaussP; p++) {
 				for (int q = 0; q < nGaussP; q++) {
@@ -610,20 +762,11 @@ try {
 					// Cross product gives local Jacobian
 					Node nodeCross = CrossProduct(dDx1G, dDx2G);
 
-					double dJacobian = sqrt(
+					dJacobian[p * nGaussP + q] = sqrt(
 						  nodeCross.x * nodeCross.x
 						+ nodeCross.y * nodeCross.y
 						+ nodeCross.z * nodeCross.z);
 
-					// Find components of quadrature point in basis
-					// of the first Face
-					SampleGLLFiniteElement(
-						0,
-						nP,
-						dGaussG[p],
-						dGaussG[q],
-						dCoeff);
-
 					// Sample data at this point
 					double dNodeLon = atan2(node.y, node.x);
 					if (dNodeLon < 0.0) {
@@ -631,31 +774,50 @@ try {
 					}
 					double dNodeLat = asin(node.z);
 
-					double dSample = (*pTest)(dNodeLon, dNodeLat);
+					dSampleLon[p * nGaussP + q] = dNodeLon;
+					dSampleLat[p * nGaussP + q] = dNodeLat;
+				}
+				}
+
+				pTest->Evaluate(
+					nGaussPoints,
+					&(dSampleLon[0]),
+					&(dSampleLat[0]),
+					&(dSample[0]));
+
+				// Integrate
+				for (int p = 0; p < nGaussP; p++) {
+				for (int q = 0; q < nGaussP; q++) {
+					const int g = p * nGaussP + q;
 
-					// Integrate
 					for (int i = 0; i < nP; i++) {
 					for (int j = 0; j < nP; j++) {
 
 						double dNodalArea =
-							dCoeff[i][j]
+							dGaussCoeff[g][i][j]
 							* dGaussW[p]
 							* dGaussW[q]
-							* dJacobian;
-
-						dVar[dataGLLNodes[i][j][k]-1] +=
-							dSample * dNodalArea;
+							* dJacobian[g];
 
-						dNodeArea[dataGLLNodes[i][j][k]-1] +=
-							dNodalArea;
+						dElementVar[k][i][j] += dSample[g] * dNodalArea;
+						dElementArea[k][i][j] += dNodalArea;
 					}
 					}
+				}
+				}
+			}
+			}
 
+			for (int k = 0; k < nElements; k++) {
+				for (int i = 0; i < nP; i++) {
+				for (int j = 0; j < nP; j++) {
+					dVar[dataGLLNodes[i][j][k]-1] += dElementVar[k][i][j];
+					dNodeArea[dataGLLNodes[i][j][k]-1] += dElementArea[k][i][j];
 				}
 				}
 			}
 		}
-	
+
 		// Divide by area
 		if (fGLLIntegrate) {
 			for (int i = 0; i < dVar.GetRows(); i++) {
@@ -76,6 +76,8 @@ try {
 	std::cout << std::endl;
 	std::cout << "..Generating transect mesh" << std::endl;
 
+	mesh.Clear();
+
 	NodeVector & nodes = mesh.nodes;
 	FaceVector & faces = mesh.faces;
     mesh.type = Mesh::MeshType_Transect;
@@ -139,7 +141,17 @@ try {
 	// Perpendicular angle start
 	double dPerpTheta0 = - 0.5 * static_cast<double>(nPerpElements) * dPerpDtheta;
 
-	// Insert vertices of transect
+	// Perpendicular offsets are the same for every point along the transect
+	std::vector<double> vecPerpTanTheta(nPerpElements+1);
+	for (int i = 0; i <= nPerpElements; i++) {
+		vecPerpTanTheta[i] =
+			tan(dPerpTheta0 + static_cast<double>(i) * dPerpDtheta);
+	}
+
+	// Insert vertices of transect, one row per iteration
+	nodes.resize((nParaElements + 1) * (nPerpElements + 1));
+
+#pragma omp parallel for schedule(static)
 	for (int j = 0; j <= nParaElements; j++) {
 		//double dS = (cos(dParaDtheta * static_cast<double>(j)) - 1.0) / (dDot - 1.0);
 		double dDeltaTheta = dParaDtheta * static_cast<double>(j);
@@ -156,34 +168,32 @@ try {
 		dZn /= dMag;
 
 		for (int i = 0; i <= nPerpElements; i++) {
-			double dTanTheta =
-				tan(dPerpTheta0 + static_cast<double>(i) * dPerpDtheta);
-
-			double dX = dXn + dXp * dTanTheta / dMagp;
-			double dY = dYn + dYp * dTanTheta / dMagp;
-			double dZ = dZn + dZp * dTanTheta / dMagp;
+			double dX = dXn + dXp * vecPerpTanTheta[i] / dMagp;
+			double dY = dYn + dYp * vecPerpTanTheta[i] / dMagp;
+			double dZ = dZn + dZp * vecPerpTanTheta[i] / dMagp;
 			dMag = sqrt(dX * dX + dY * dY + dZ * dZ);
 
 			dX /= dMag;
 			dY /= dMag;
 			dZ /= dMag;
 
-			nodes.push_back(Node(dX,dY,dZ));
+			nodes[j * (nPerpElements + 1) + i] = Node(dX,dY,dZ);
 		}
 	}
 
 	std::cout << "..Inserting faces" << std::endl;
 
-
 	// Insert faces
+	faces.resize(nParaElements * nPerpElements, Face(4));
+
+#pragma omp parallel for schedule(static)
 	for (int j = 0; j < nParaElements; j++) {
 	for (int i = 0; i < nPerpElements; i++) {
-		Face face(4);
+		Face & face = faces[j * nPerpElements + i];
 		face.SetNode(0,  i      +  j      * (nPerpElements+1));
 		face.SetNode(1, (i + 1) +  j      * (nPerpElements+1));
 		face.SetNode(2, (i + 1) + (j + 1) * (nPerpElements+1));
 		face.SetNode(3,  i      + (j + 1) * (nPerpElements+1));
-		faces.push_back(face);
 	}
 	}
 
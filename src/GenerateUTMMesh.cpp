@@ -154,100 +154,161 @@ void ConvertUTMtoRLL_Coeff(
 }
 
 ///	<summary>
-///		Convert a coordinate from UTM to RLL.
+///		Precomputed UTM to RLL projection for a single zone.  The series
+///		coefficients depend only on the zone and ellipsoid, so they are
+///		evaluated once on construction rather than for every point.
 ///	</summary>
-void ConvertUTMtoRLL(
-	int nZone,
-	double dX,
-	double dY,
-	double & dLon,
-	double & dLat
-) {
-	// Conversion from rad to degree
-	static const double dD0 = 180.0 / M_PI;
-
-	// Semi-major axis (in meters) from WGS84 standard
-	static const double dA1 = 6378137.0;
+class UTMtoRLLProjection {
 
-	// Flattening of the ellipsoid from WGS84 standard
-	static const double dF1 = 298.257223563;
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	UTMtoRLLProjection(
+		int nZone
+	) {
+		// Conversion from rad to degree
+		static const double dD0 = 180.0 / M_PI;
 
-	// Maximum iteration for latitude computation
-	static const int nMaxIter = 100;
+		// Semi-major axis (in meters) from WGS84 standard
+		static const double dA1 = 6378137.0;
 
-	// Minimum residue for latitude computation
-	static const double dEps = 1.0e-11;
+		// Flattening of the ellipsoid from WGS84 standard
+		static const double dF1 = 298.257223563;
 
-	// UTM scale factor
-	static const double dK0 = 0.9996;
+		// UTM scale factor
+		static const double dK0 = 0.9996;
 
-	// UTM false East (m)
-	static const double dX0 = 500000.0;
+		// UTM false North (m)
+		const double dY0 = 1.0e7 * static_cast<double>(nZone < 0);
 
-	// UTM false North (m)
-	const double dY0 = 1.0e7 * static_cast<double>(nZone < 0);
+		// UTM origin latitude (rad)
+		static const double dP0 = 0.0;
 
-	// UTM origin latitude (rad)
-	static const double dP0 = 0.0;
+		// UTM origin longitude (rad)
+		m_dL0 = (6.0 * fabs(static_cast<double>(nZone)) - 183.0) / dD0;
 
-	// UTM origin longitude (rad)
-	const double dL0 = (6.0 * fabs(static_cast<double>(nZone)) - 183.0) / dD0;
+		// Ellipsoid eccentricity
+		const double dE1x = dA1 * (1.0 - 1.0/dF1);
+		m_dE1 = sqrt((dA1 * dA1 - dE1x * dE1x)/(dA1 * dA1));
 
-	// Ellipsoid eccentricity
-	const double dE1x = dA1 * (1.0 - 1.0/dF1);
-	const double dE1 = sqrt((dA1 * dA1 - dE1x * dE1x)/(dA1 * dA1));
+		m_dN = dK0 * dA1;
 
-	const double dN = dK0 * dA1;
+		// Computing parameters for Mercator Transverse projection
+		double dC[5];
 
-	// Computing parameters for Mercator Transverse projection
-	double dC[5];
+		ConvertUTMtoRLL_Coeff(m_dE1, 0, dC);
 
-	ConvertUTMtoRLL_Coeff(dE1, 0, dC);
+		m_dYS =
+			dY0 - m_dN * (
+				  dC[0] * dP0
+				+ dC[1] * sin(2.0 * dP0)
+				+ dC[2] * sin(4.0 * dP0)
+				+ dC[3] * sin(6.0 * dP0)
+				+ dC[4] * sin(8.0 * dP0));
 
-	const double dYS =
-		dY0 - dN * (
-			  dC[0] * dP0
-			+ dC[1] * sin(2.0 * dP0)
-			+ dC[2] * sin(4.0 * dP0)
-			+ dC[3] * sin(6.0 * dP0)
-			+ dC[4] * sin(8.0 * dP0));
-
-	ConvertUTMtoRLL_Coeff(dE1, 1, dC);
+		ConvertUTMtoRLL_Coeff(m_dE1, 1, m_dC);
+	}
 
-	std::complex<double> dZT((dY - dYS)/dN/dC[0], (dX - dX0)/dN/dC[0]);
+	///	<summary>
+	///		Convert a coordinate from UTM to RLL (in radians).  Returns
+	///		false if the latitude iteration fails to converge.  Does not
+	///		throw, so it may be called from within a parallel region.
+	///	</summary>
+	bool Convert(
+		double dX,
+		double dY,
+		double & dLon,
+		double & dLat
+	) const {
+
+		// Maximum iteration for latitude computation
+		static const int nMaxIter = 100;
+
+		// Minimum residue for latitude computation
+		static const double dEps = 1.0e-11;
+
+		// UTM false East (m)
+		static const double dX0 = 500000.0;
+
+		std::complex<double> dZT(
+			(dY - m_dYS)/m_dN/m_dC[0], (dX - dX0)/m_dN/m_dC[0]);
+
+		std::complex<double> dZ =
+			dZT
+			- m_dC[1] * sin(2.0 * dZT)
+			- m_dC[2] * sin(4.0 * dZT)
+			- m_dC[3] * sin(6.0 * dZT)
+			- m_dC[4] * sin(8.0 * dZT);
+
+		double dL = dZ.real();
+		double dLS = dZ.imag();
+
+		double dl = m_dL0 + atan(sinh(dLS) / cos(dL));
+		double dp = asin(sin(dL) / cosh(dLS));
+
+		dL = log(tan(M_PI/4.0 + dp/2.0));
+
+		dp = 2.0 * atan(exp(dL)) - M_PI/2.0;
+
+		int i = 0;
+		double dp0 = DBL_MAX;
+		while (((dp0 == DBL_MAX) || (fabs(dp - dp0) > dEps)) && (i < nMaxIter)) {
+			dp0 = dp;
+			double dES = m_dE1 * sin(dp0);
+			dp = pow(2.0 * atan((1.0 + dES) / (1.0 - dES)), m_dE1/2.0) * exp(dL) - M_PI/2.0;
+			i++;
+		}
 
-	std::complex<double> dZ =
-		dZT
-		- dC[1] * sin(2.0 * dZT)
-		- dC[2] * sin(4.0 * dZT)
-		- dC[3] * sin(6.0 * dZT)
-		- dC[4] * sin(8.0 * dZT);
+		dLat = dp;
+		dLon = dl;
 
-	double dL = dZ.real();
-	double dLS = dZ.imag();
+		return (i != nMaxIter);
+	}
 
-	double dl = dL0 + atan(sinh(dLS) / cos(dL));
-	double dp = asin(sin(dL) / cosh(dLS));
+protected:
+	///	<summary>
+	///		UTM origin longitude (rad).
+	///	</summary>
+	double m_dL0;
+
+	///	<summary>
+	///		Ellipsoid eccentricity.
+	///	</summary>
+	double m_dE1;
+
+	///	<summary>
+	///		Scaled semi-major axis.
+	///	</summary>
+	double m_dN;
+
+	///	<summary>
+	///		Northing offset of the origin latitude.
+	///	</summary>
+	double m_dYS;
+
+	///	<summary>
+	///		Transverse mercator reverse coefficients.
+	///	</summary>
+	double m_dC[5];
+};
 
-	dL = log(tan(M_PI/4.0 + dp/2.0));
+///	<summary>
+///		Convert a coordinate from UTM to RLL.
+///	</summary>
+void ConvertUTMtoRLL(
+	int nZone,
+	double dX,
+	double dY,
+	double & dLon,
+	double & dLat
+) {
+	UTMtoRLLProjection utm(nZone);
 
-	dp = 2.0 * atan(exp(dL)) - M_PI/2.0;
-	
-	int i = 0;
-	double dp0 = DBL_MAX;
-	while (((dp0 == DBL_MAX) || (fabs(dp - dp0) > dEps)) && (i < nMaxIter)) {
-		dp0 = dp;
-		double dES = dE1 * sin(dp0);
-		dp = pow(2.0 * atan((1.0 + dES) / (1.0 - dES)), dE1/2.0) * exp(dL) - M_PI/2.0;
-		i++;
-	}
-	if (i == nMaxIter) {
+	if (!utm.Convert(dX, dY, dLon, dLat)) {
 		_EXCEPTIONT("Convergence failure");
 	}
 
-	dLat = dp;
-	dLon = dl;
-
 /*
 	% constants
 D0 = 180/pi;	% conversion rad to deg
@@ -336,41 +397,63 @@ try {
 	NodeVector & nodes = mesh.nodes;
 	FaceVector & faces = mesh.faces;
 
-	// Loop through all nodes
+	// Precompute the projection for this zone
+	const UTMtoRLLProjection utm(nZone);
+
+	// Loop through all nodes, one row per iteration
+	const int nNodeCols = nCols + 1;
+
+	nodes.resize((nRows + 1) * nNodeCols);
+
+	int nFailedRows = 0;
+
+#pragma omp parallel for schedule(static) reduction(+:nFailedRows)
 	for (int j = 0; j < nRows+1; j++) {
-	for (int i = 0; i < nCols+1; i++) {
-		double dXLL = dXLLCorner + static_cast<double>(i) * dCellSize;
-		double dYLL = dYLLCorner + static_cast<double>(j) * dCellSize;
+		bool fRowConverged = true;
 
-		double dLon;
-		double dLat;
+		for (int i = 0; i < nCols+1; i++) {
+			double dXLL = dXLLCorner + static_cast<double>(i) * dCellSize;
+			double dYLL = dYLLCorner + static_cast<double>(j) * dCellSize;
 
-		ConvertUTMtoRLL(nZone, dXLL, dYLL, dLon, dLat);
+			double dLon;
+			double dLat;
 
-		//printf("%i %1.5e %1.5e\n", nodes.size(), dLon, dLat);
+			if (!utm.Convert(dXLL, dYLL, dLon, dLat)) {
+				fRowConverged = false;
+			}
 
-		double dX = cos(dLat) * cos(dLon);
-		double dY = cos(dLat) * sin(dLon);
-		double dZ = sin(dLat);
+			double dX = cos(dLat) * cos(dLon);
+			double dY = cos(dLat) * sin(dLon);
+			double dZ = sin(dLat);
+
+			nodes[j * nNodeCols + i] = Node(dX, dY, dZ);
+		}
 
-		nodes.push_back(Node(dX, dY, dZ));
+		if (!fRowConverged) {
+			nFailedRows++;
+		}
 	}
+
+	if (nFailedRows != 0) {
+		_EXCEPTION1("Convergence failure in UTM to RLL conversion "
+			"(%i rows affected)", nFailedRows);
 	}
 
 	// Generate faces
+	faces.resize(nRows * nCols, Face(4));
+
+#pragma omp parallel for schedule(static)
 	for (int j = 0; j < nRows; j++) {
 
 		int iThisLatNodeIx =  j    * (nCols + 1);
 		int iNextLatNodeIx = (j+1) * (nCols + 1);
 
 		for (int i = 0; i < nCols; i++) {
-			Face face(4);
+			Face & face = faces[j * nCols + i];
 			face.SetNode(0, iThisLatNodeIx + i);
 			face.SetNode(1, iThisLatNodeIx + (i + 1) % (nCols + 1));
 			face.SetNode(2, iNextLatNodeIx + (i + 1) % (nCols + 1));
 			face.SetNode(3, iNextLatNodeIx + i);
-
-			faces.push_back(face);
 		}
 	}
 
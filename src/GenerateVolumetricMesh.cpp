@@ -54,6 +54,9 @@ try {
 	// Nodes appear at GLL nodes
 	bool fCGLL = true;
 
+	// Generate the dual of the GLL nodes
+	bool fDual = false;
+
 	// Parse the command line
 	BeginCommandLine()
 		CommandLineString(strInputFile, "in", "");
@@ -61,6 +64,7 @@ try {
 		//CommandLineString(strOutputConnectivity, "out_connect", "");
 		CommandLineInt(nP, "np", 2);
 		CommandLineBool(fUniformSpacing, "uniform");
+		CommandLineBool(fDual, "dual");
 		//CommandLineBool(fNoMergeFaces, "no-merge-face");
 		//CommandLineBool(fCGLL, "cgll");
 
@@ -121,41 +125,33 @@ try {
 		_EXCEPTIONT("Logic error in accumulated weight");
 	}
 
-	// Data structures used for generating connectivity
-	DataArray3D<int> dataGLLnodes(nP, nP, nElements);
-	std::vector<Node> vecNodes;
-	std::map<Node, int> mapFaces;
-
-	// Data structure used for avoiding coincident nodes on the fly
-	std::map<Node, int> mapNewNodes;
-
-	// Generate new mesh
-	std::cout << "..Generating sub-volumes" << std::endl;
-	Mesh meshOut;
-
+	// Check element types
 	for (size_t f = 0; f < nElements; f++) {
-
-		const Face & face = meshIn.faces[f];
-
-		if (face.edges.size() != 4) {
+		if (meshIn.faces[f].edges.size() != 4) {
 			_EXCEPTIONT("Input mesh must only contain quadrilaterals");
 		}
+	}
+
+	// Generate new mesh
+	Mesh meshOut;
 
-		const Node & node0 = meshIn.nodes[face[0]];
-		const Node & node1 = meshIn.nodes[face[1]];
-		const Node & node2 = meshIn.nodes[face[2]];
-		const Node & node3 = meshIn.nodes[face[3]];
+	// Finite volume dual of the continuous GLL nodes:  the GLL nodes of
+	// all elements are joined into quadrilaterals, coincident nodes are
+	// merged and the dual is taken, giving one volume per unique GLL node
+	if (fDual) {
+		std::cout << "..Generating GLL node mesh" << std::endl;
 
-		for (int q = 0; q < nP; q++) {
-		for (int p = 0; p < nP; p++) {
+		Mesh meshGLL;
+		meshGLL.nodes.resize(nElements * nP * nP);
+		meshGLL.faces.resize(nElements * (nP-1) * (nP-1));
 
-			bool fNewFace = true;
+#pragma omp parallel for schedule(static)
+		for (int f = 0; f < nElements; f++) {
 
-			// Build unique node array if CGLL
-			if (fCGLL) {
+			const Face & face = meshIn.faces[f];
 
-				// Get local nodal location
-				Node nodeGLL;
+			for (int q = 0; q < nP; q++) {
+			for (int p = 0; p < nP; p++) {
 				Node dDx1G;
 				Node dDx2G;
 
@@ -164,77 +160,139 @@ try {
 					meshIn.nodes,
 					dG[p],
 					dG[q],
-					nodeGLL,
+					meshGLL.nodes[(f * nP + q) * nP + p],
 					dDx1G,
 					dDx2G);
+			}
+			}
 
-				// Determine if this is a unique Node
-				std::map<Node, int>::const_iterator iter =
-					mapFaces.find(nodeGLL);
+			for (int q = 0; q < nP-1; q++) {
+			for (int p = 0; p < nP-1; p++) {
+				Face faceNew(4);
+				faceNew.SetNode(0, (f * nP + q) * nP + p);
+				faceNew.SetNode(1, (f * nP + q) * nP + p + 1);
+				faceNew.SetNode(2, (f * nP + q + 1) * nP + p + 1);
+				faceNew.SetNode(3, (f * nP + q + 1) * nP + p);
 
-				if (iter == mapFaces.end()) {
+				meshGLL.faces[(f * (nP-1) + q) * (nP-1) + p] = faceNew;
+			}
+			}
+		}
 
-					// Insert new unique node into map
-					int ixNode = static_cast<int>(mapFaces.size());
-					mapFaces.insert(std::pair<Node, int>(nodeGLL, ixNode));
-					dataGLLnodes[q][p][f] = ixNode + 1;
-					vecNodes.push_back(nodeGLL);
+		meshGLL.RemoveCoincidentNodes();
 
-				} else {
-					dataGLLnodes[q][p][f] = iter->second + 1;
+		std::cout << "..Generating dual mesh" << std::endl;
 
-					fNewFace = false;
-				}
+		GenerateDualMesh(meshGLL, meshOut);
 
-			// Non-unique node array if DGLL
-			} else {
-				dataGLLnodes[q][p][f] = nP * nP * f + q * nP + p;
-			}
+	// Sub-volumes of each element; the four nodes of each sub-volume are
+	// generated independently and coincident nodes are then merged, which
+	// numbers nodes in order of first appearance
+	} else {
+		std::cout << "..Generating sub-volumes" << std::endl;
 
-			// Get volumetric region
-			Face faceNew(4);
-
-			for (int i = 0; i < 4; i++) {
-				int px = p+((i+1)/2)%2; // p,p+1,p+1,p
-				int qx = q+(i/2);       // q,q,q+1,q+1
-
-				Node nodeOut =
-					InterpolateQuadrilateralNode(
-						node0, node1, node2, node3,
-						dAccumW[px], dAccumW[qx]);
-	
-				std::map<Node, int>::const_iterator iterNode =
-					mapNewNodes.find(nodeOut);
-				if (iterNode == mapNewNodes.end()) {
-					mapNewNodes.insert(
-						std::pair<Node, int>(nodeOut, meshOut.nodes.size()));
-					faceNew.SetNode(i, meshOut.nodes.size());
-					meshOut.nodes.push_back(nodeOut);
-				} else {
-					faceNew.SetNode(i, iterNode->second);
+		const int nSubVolumeNodes = 4 * nP * nP;
+
+		meshOut.nodes.resize(nElements * nSubVolumeNodes);
+		meshOut.faces.resize(nElements * nP * nP);
+
+#pragma omp parallel for schedule(static)
+		for (int f = 0; f < nElements; f++) {
+
+			const Face & face = meshIn.faces[f];
+
+			const Node & node0 = meshIn.nodes[face[0]];
+			const Node & node1 = meshIn.nodes[face[1]];
+			const Node & node2 = meshIn.nodes[face[2]];
+			const Node & node3 = meshIn.nodes[face[3]];
+
+			for (int q = 0; q < nP; q++) {
+			for (int p = 0; p < nP; p++) {
+
+				// Get volumetric region
+				Face faceNew(4);
+
+				for (int i = 0; i < 4; i++) {
+					int px = p+((i+1)/2)%2; // p,p+1,p+1,p
+					int qx = q+(i/2);       // q,q,q+1,q+1
+
+					const int ixNode =
+						f * nSubVolumeNodes + (q * nP + p) * 4 + i;
+
+					meshOut.nodes[ixNode] =
+						InterpolateQuadrilateralNode(
+							node0, node1, node2, node3,
+							dAccumW[px], dAccumW[qx]);
+
+					faceNew.SetNode(i, ixNode);
 				}
-			}
 
-			// Insert new Face or merge with existing Face
-			meshOut.faces.push_back(faceNew);
-/*
-			if ((fNoMergeFaces) || (fNewFace)) {
-			} else {
-				std::cout << dataGLLnodes[q][p][f]-1 << " " << mapFaces.size()-1 << std::endl;
-				meshOut.faces[dataGLLnodes[q][p][f]-1].Merge(faceNew);
+				meshOut.faces[(f * nP + q) * nP + p] = faceNew;
+			}
 			}
-*/
-		}
 		}
-	}
 
-	meshOut.RemoveCoincidentNodes();
+		meshOut.RemoveCoincidentNodes();
+	}
 
 	// Build connectivity and write to file
 	if (strOutputConnectivity != "") {
 
 		std::cout << "..Constructing connectivity file" << std::endl;
 
+		// Unique GLL node indices
+		DataArray3D<int> dataGLLnodes(nP, nP, nElements);
+		std::vector<Node> vecNodes;
+		std::map<Node, int> mapFaces;
+
+		for (size_t f = 0; f < nElements; f++) {
+
+			const Face & face = meshIn.faces[f];
+
+			for (int q = 0; q < nP; q++) {
+			for (int p = 0; p < nP; p++) {
+
+				// Build unique node array if CGLL
+				if (fCGLL) {
+
+					// Get local nodal location
+					Node nodeGLL;
+					Node dDx1G;
+					Node dDx2G;
+
+					ApplyLocalMap(
+						face,
+						meshIn.nodes,
+						dG[p],
+						dG[q],
+						nodeGLL,
+						dDx1G,
+						dDx2G);
+
+					// Determine if this is a unique Node
+					std::map<Node, int>::const_iterator iter =
+						mapFaces.find(nodeGLL);
+
+					if (iter == mapFaces.end()) {
+
+						// Insert new unique node into map
+						int ixNode = static_cast<int>(mapFaces.size());
+						mapFaces.insert(std::pair<Node, int>(nodeGLL, ixNode));
+						dataGLLnodes[q][p][f] = ixNode + 1;
+						vecNodes.push_back(nodeGLL);
+
+					} else {
+						dataGLLnodes[q][p][f] = iter->second + 1;
+					}
+
+				// Non-unique node array if DGLL
+				} else {
+					dataGLLnodes[q][p][f] = nP * nP * f + q * nP + p;
+				}
+			}
+			}
+		}
+
 		std::vector< std::set<int> > vecConnectivity;
 		vecConnectivity.resize(mapFaces.size());
 
@@ -23,15 +23,77 @@
 #include "GaussQuadrature.h"
 #include "STLStringHelper.h"
 #include "MeshUtilitiesFuzzy.h"
+#include "MemoryMappedFile.h"
+#include "NetCDFUtilities.h"
 
 #include <ctime>
 #include <cmath>
+#include <cstdlib>
 #include <cstring>
+#include <cstdint>
+#include <cstdio>
 #include <algorithm>
+#include <memory>
 #include "netcdfcpp.h"
 
 #include "triangle.h"
 
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+/// NodeCoordinateArrays
+///////////////////////////////////////////////////////////////////////////////
+
+void NodeCoordinateArrays::Assign(
+	const NodeVector & nodes
+) {
+	// Number of Real values per array, rounded up to a multiple of 64 bytes
+	static const size_t Alignment = 64;
+	static const size_t RealsPerBlock = Alignment / sizeof(Real);
+
+	const size_t sStride =
+		((nodes.size() + RealsPerBlock - 1) / RealsPerBlock) * RealsPerBlock;
+
+	Deallocate();
+
+	if (nodes.size() == 0) {
+		return;
+	}
+
+	if (posix_memalign(&m_pBuffer, Alignment, 3 * sStride * sizeof(Real)) != 0) {
+		m_pBuffer = NULL;
+		_EXCEPTION1("Failed posix_memalign call (%lu bytes)",
+			3 * sStride * sizeof(Real));
+	}
+
+	m_sSize = nodes.size();
+	m_pX = reinterpret_cast<Real *>(m_pBuffer);
+	m_pY = m_pX + sStride;
+	m_pZ = m_pY + sStride;
+
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < static_cast<int>(m_sSize); i++) {
+		m_pX[i] = nodes[i].x;
+		m_pY[i] = nodes[i].y;
+		m_pZ[i] = nodes[i].z;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void NodeCoordinateArrays::Deallocate() {
+	if (m_pBuffer != NULL) {
+		free(m_pBuffer);
+	}
+	m_pBuffer = NULL;
+	m_sSize = 0;
+	m_pX = NULL;
+	m_pY = NULL;
+	m_pZ = NULL;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// Face
 ///////////////////////////////////////////////////////////////////////////////
@@ -51,17 +113,131 @@ int Face::GetEdgeIndex(
 
 void Face::RemoveZeroEdges() {
 
-	// Loop through all edges of this face
+	// Compact the remaining edges of this face in a single pass
+	int nKeep = 0;
 	for (int i = 0; i < edges.size(); i++) {
+		if (edges[i][0] != edges[i][1]) {
+			if (nKeep != i) {
+				edges[nKeep] = edges[i];
+			}
+			nKeep++;
+		}
+	}
+	if (nKeep != edges.size()) {
+		edges.resize(nKeep);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// PackedFaceVector
+///////////////////////////////////////////////////////////////////////////////
+
+void PackedFaceVector::Assign(
+	const FaceVector & faces
+) {
+	Deallocate();
+
+	if (faces.size() == 0) {
+		return;
+	}
+
+	m_sSize = faces.size();
 
-		// Remove zero edges
-		if (edges[i][0] == edges[i][1]) {
-			edges.erase(edges.begin()+i);
-			i--;
+	// Determine if the number of nodes is uniform and if any edge is not
+	// a great circle arc
+	bool fUniform = true;
+	bool fGreatCircleArcs = true;
+
+	const int nFirstDegree = static_cast<int>(faces[0].edges.size());
+	for (size_t i = 0; i < m_sSize; i++) {
+		const Face & face = faces[i];
+		const int nDegree = static_cast<int>(face.edges.size());
+		if (nDegree != nFirstDegree) {
+			fUniform = false;
+		}
+		if (nDegree > m_nMaxDegree) {
+			m_nMaxDegree = nDegree;
+		}
+		if (fGreatCircleArcs) {
+			for (int j = 0; j < nDegree; j++) {
+				if (face.edges[j].type != Edge::Type_GreatCircleArc) {
+					fGreatCircleArcs = false;
+					break;
+				}
+			}
+		}
+	}
+
+	// Offsets are only needed for Faces with different numbers of nodes
+	size_t sNodes;
+	if (fUniform && (nFirstDegree != 0)) {
+		m_nUniformDegree = nFirstDegree;
+		sNodes = m_sSize * static_cast<size_t>(nFirstDegree);
+
+	} else {
+		m_vecOffsets.resize(m_sSize + 1);
+		m_vecOffsets[0] = 0;
+		for (size_t i = 0; i < m_sSize; i++) {
+			m_vecOffsets[i+1] = m_vecOffsets[i] + faces[i].edges.size();
+		}
+		sNodes = m_vecOffsets[m_sSize];
+	}
+
+	m_vecNodes.resize(sNodes);
+	if (!fGreatCircleArcs) {
+		m_vecEdgeTypes.resize(sNodes);
+	}
+
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < static_cast<int>(m_sSize); i++) {
+		const Face & face = faces[i];
+		const size_t ixBegin = GetOffset(i);
+		for (size_t j = 0; j < face.edges.size(); j++) {
+			m_vecNodes[ixBegin + j] = face.edges[j][0];
+		}
+		if (!fGreatCircleArcs) {
+			for (size_t j = 0; j < face.edges.size(); j++) {
+				m_vecEdgeTypes[ixBegin + j] =
+					static_cast<signed char>(face.edges[j].type);
+			}
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void PackedFaceVector::Unpack(
+	FaceVector & faces
+) const {
+	faces.clear();
+	faces.resize(m_sSize);
+
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < static_cast<int>(m_sSize); i++) {
+		const int * pNodes = GetNodes(i);
+		const int nEdges = GetDegree(i);
+
+		Face & face = faces[i];
+		face.edges.resize(nEdges);
+		for (int j = 0; j < nEdges; j++) {
+			face.edges[j].node[0] = pNodes[j];
+			face.edges[j].node[1] = pNodes[(j + 1) % nEdges];
+			face.edges[j].type = GetEdgeType(i, j);
 		}
 	}
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+void PackedFaceVector::Deallocate() {
+	m_sSize = 0;
+	m_nUniformDegree = 0;
+	m_nMaxDegree = 0;
+	std::vector<int>().swap(m_vecNodes);
+	std::vector<size_t>().swap(m_vecOffsets);
+	std::vector<signed char>().swap(m_vecEdgeTypes);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// Mesh
 ///////////////////////////////////////////////////////////////////////////////
@@ -71,238 +247,1138 @@ void Mesh::Clear() {
 	faces.clear();
 	edgemap.clear();
 	revnodearray.clear();
+	triangulation.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A reference to an edge of a Face, used for constructing the EdgeMap.
+///		Edges are bucketed by their smaller Node index, so only the larger
+///		Node index is stored.
+///	</summary>
+struct FaceEdgeRef {
+
+	///	<summary>
+	///		Larger Node index of the edge.
+	///	</summary>
+	int ixNodeBig;
+
+	///	<summary>
+	///		Face containing this edge.
+	///	</summary>
+	int ixFace;
+
+	///	<summary>
+	///		Local index of this edge within the Face.
+	///	</summary>
+	int ixLocal;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Mesh::ConstructEdgeMap(
+  bool fVerbose
+) {
+
+	// Construct the edge map
+	edgemap.clear();
+
+	// Determine the range of Node indices referenced by Faces
+	int nNodeIx = 0;
+	for (int i = 0; i < faces.size(); i++) {
+		const Face & face = faces[i];
+		for (int k = 0; k < face.edges.size(); k++) {
+			if (face[k] < 0) {
+				_EXCEPTION2("Face %i contains invalid node index %i", i, face[k]);
+			}
+			if (face[k] >= nNodeIx) {
+				nNodeIx = face[k] + 1;
+			}
+		}
+	}
+
+	// Count edges by their smaller Node index
+	std::vector<size_t> vecBucketBegin(nNodeIx + 1, 0);
+
+	for (int i = 0; i < faces.size(); i++) {
+		const Face & face = faces[i];
+
+		int nEdges = face.edges.size();
+
+		for (int k = 0; k < nEdges; k++) {
+			if (faces[i][k] == face[(k+1)%nEdges]) {
+				continue;
+			}
+			vecBucketBegin[std::min(face[k], face[(k+1)%nEdges]) + 1]++;
+		}
+	}
+
+	for (int n = 0; n < nNodeIx; n++) {
+		vecBucketBegin[n+1] += vecBucketBegin[n];
+	}
+
+	// Place edges in buckets; within a bucket edges are in Face order
+	std::vector<FaceEdgeRef> vecRefs(vecBucketBegin[nNodeIx]);
+	std::vector<size_t> vecBucketNext(vecBucketBegin.begin(), vecBucketBegin.end() - 1);
+
+	for (int i = 0; i < faces.size(); i++) {
+		const Face & face = faces[i];
+
+		int nEdges = face.edges.size();
+
+		for (int k = 0; k < nEdges; k++) {
+			if (faces[i][k] == face[(k+1)%nEdges]) {
+				continue;
+			}
+
+			int ixNodeSmall;
+			int ixNodeBig;
+			Edge(face[k], face[(k+1)%nEdges]).GetOrderedNodes(
+				ixNodeSmall, ixNodeBig);
+
+			FaceEdgeRef & ref = vecRefs[vecBucketNext[ixNodeSmall]++];
+			ref.ixNodeBig = ixNodeBig;
+			ref.ixFace = i;
+			ref.ixLocal = k;
+		}
+	}
+
+	std::vector<size_t>().swap(vecBucketNext);
+
+	// Sort each bucket by larger Node index, retaining Face order
+#pragma omp parallel for schedule(static)
+	for (int n = 0; n < nNodeIx; n++) {
+		std::stable_sort(
+			vecRefs.begin() + vecBucketBegin[n],
+			vecRefs.begin() + vecBucketBegin[n+1],
+			[](const FaceEdgeRef & refA, const FaceEdgeRef & refB) {
+				return (refA.ixNodeBig < refB.ixNodeBig);
+			});
+	}
+
+	// Combine copies of the same edge; the first Face to reference an edge
+	// determines its orientation
+	std::vector<EdgeMapPair> vecEntries;
+	vecEntries.reserve(vecRefs.size() / 2 + 1);
+
+	for (int n = 0; n < nNodeIx; n++) {
+		for (size_t ix = vecBucketBegin[n]; ix < vecBucketBegin[n+1]; ix++) {
+			const FaceEdgeRef & ref = vecRefs[ix];
+
+			if ((ix == vecBucketBegin[n]) ||
+				(ref.ixNodeBig != vecRefs[ix-1].ixNodeBig)
+			) {
+				const Face & face = faces[ref.ixFace];
+				const int nEdges = face.edges.size();
+
+				vecEntries.push_back(
+					EdgeMapPair(
+						Edge(face[ref.ixLocal], face[(ref.ixLocal+1)%nEdges]),
+						FacePair()));
+			}
+
+			vecEntries.back().second.AddFace(ref.ixFace);
+		}
+	}
+
+	edgemap.Assign(vecEntries);
+
+	if (fVerbose) Announce("Mesh size: Edges [%i]", edgemap.size());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Mesh::ConstructReverseNodeArray() {
+
+	const int nNodes = nodes.size();
+	const int nFaces = faces.size();
+
+	// Count faces associated with each node; repeated nodes within a face
+	// are only counted once
+	std::vector<size_t> vecOffsets(nNodes + 1, 0);
+
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < nFaces; i++) {
+		const Face & face = faces[i];
+		for (int k = 0; k < face.edges.size(); k++) {
+			int ixNode = face.edges[k][0];
+			if ((ixNode < 0) || (ixNode >= nNodes)) {
+				continue;
+			}
+
+			bool fRepeated = false;
+			for (int j = 0; j < k; j++) {
+				if (face.edges[j][0] == ixNode) {
+					fRepeated = true;
+					break;
+				}
+			}
+			if (!fRepeated) {
+#pragma omp atomic
+				vecOffsets[ixNode+1]++;
+			}
+		}
+	}
+
+	for (int n = 0; n < nNodes; n++) {
+		vecOffsets[n+1] += vecOffsets[n];
+	}
+
+	// Place faces
+	std::vector<int> vecFaces(vecOffsets[nNodes]);
+	std::vector<size_t> vecNext(vecOffsets.begin(), vecOffsets.end() - 1);
+
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < nFaces; i++) {
+		const Face & face = faces[i];
+		for (int k = 0; k < face.edges.size(); k++) {
+			int ixNode = face.edges[k][0];
+			if ((ixNode < 0) || (ixNode >= nNodes)) {
+				continue;
+			}
+
+			bool fRepeated = false;
+			for (int j = 0; j < k; j++) {
+				if (face.edges[j][0] == ixNode) {
+					fRepeated = true;
+					break;
+				}
+			}
+			if (!fRepeated) {
+				size_t ix;
+#pragma omp atomic capture
+				ix = vecNext[ixNode]++;
+
+				vecFaces[ix] = i;
+			}
+		}
+	}
+
+	std::vector<size_t>().swap(vecNext);
+
+	// Sort the faces of each node (faces are placed out of order by threads)
+#pragma omp parallel for schedule(static)
+	for (int n = 0; n < nNodes; n++) {
+		std::sort(
+			vecFaces.begin() + vecOffsets[n],
+			vecFaces.begin() + vecOffsets[n+1]);
+	}
+
+	revnodearray.Assign(vecOffsets, vecFaces);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Mesh::ConstructTriangulation() {
+
+	if (triangulation.size() == faces.size()) {
+		return;
+	}
+
+	const int nFaces = faces.size();
+
+	// Offsets of the sub-triangles of each face
+	std::vector<size_t> vecTriangleBegin(nFaces + 1, 0);
+	for (int i = 0; i < nFaces; i++) {
+		vecTriangleBegin[i+1] =
+			vecTriangleBegin[i]
+			+ FaceTriangulation::GetTriangleCount(faces[i]);
+	}
+
+	std::vector<double> vecCenterX(nFaces, 0.0);
+	std::vector<double> vecCenterY(nFaces, 0.0);
+	std::vector<double> vecCenterZ(nFaces, 0.0);
+	std::vector<double> vecTriangleArea(vecTriangleBegin[nFaces], 0.0);
+
+	// Fan centers and sub-triangle areas
+#pragma omp parallel for schedule(dynamic, 64)
+	for (int i = 0; i < nFaces; i++) {
+		const Face & face = faces[i];
+
+		Node nodeCenter;
+		if (face.edges.size() > 3) {
+			nodeCenter = FaceTriangulation::CalculateCenter(face, nodes);
+			vecCenterX[i] = nodeCenter.x;
+			vecCenterY[i] = nodeCenter.y;
+			vecCenterZ[i] = nodeCenter.z;
+		}
+
+		Node node0, node1, node2;
+		const int nTriangles = FaceTriangulation::GetTriangleCount(face);
+		for (int j = 0; j < nTriangles; j++) {
+			FaceTriangulation::GetTriangle(
+				face, nodes, nodeCenter, j, node0, node1, node2);
+
+			vecTriangleArea[vecTriangleBegin[i] + j] =
+				CalculateTriangleAreaQuadratureMethod(node0, node1, node2);
+		}
+	}
+
+	triangulation.Assign(
+		vecTriangleBegin,
+		vecCenterX,
+		vecCenterY,
+		vecCenterZ,
+		vecTriangleArea);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Announce a warning if any Face areas are very small.
+///	</summary>
+static void WarnSmallFaceAreas(
+	const DataArray1D<double> & vecFaceArea
+) {
+	int nCount = 0;
+	for (size_t i = 0; i < vecFaceArea.GetRows(); i++) {
+		if (vecFaceArea[i] < 1.0e-13) {
+			nCount++;
+		}
+	}
+
+	if (nCount != 0) {
+		Announce("WARNING: %i small elements found", nCount);
+	}
+}
+
+///	<summary>
+///		Calculate the sum of an array of Face areas carefully, by summing
+///		groups of Jump Faces recursively.
+///	</summary>
+static Real SumFaceAreas(
+	const DataArray1D<double> & vecFaceArea
+) {
+	if (vecFaceArea.GetRows() == 0) {
+		return 0.0;
+	}
+
+	static const int Jump = 10;
+	std::vector<double> vecFaceAreaBak;
+	vecFaceAreaBak.resize(vecFaceArea.GetRows());
+	memcpy(&(vecFaceAreaBak[0]), &(vecFaceArea[0]),
+		vecFaceArea.GetRows() * sizeof(double));
+
+	for (;;) {
+		if (vecFaceAreaBak.size() == 1) {
+			break;
+		}
+		for (int i = 0; i <= (vecFaceAreaBak.size()-1) / Jump; i++) {
+			int ixRef = Jump * i;
+			vecFaceAreaBak[i] = vecFaceAreaBak[ixRef];
+			for (int j = 1; j < Jump; j++) {
+				if (ixRef + j >= vecFaceAreaBak.size()) {
+					break;
+				}
+				vecFaceAreaBak[i] += vecFaceAreaBak[ixRef + j];
+			}
+		}
+		vecFaceAreaBak.resize((vecFaceAreaBak.size()-1) / Jump + 1);
+	}
+
+	return vecFaceAreaBak[0];
+}
+
+///	<summary>
+///		Check if overlap Faces are sorted by parent Face index, so that the
+///		Faces with each parent are contiguous, and all parent Face indices
+///		are valid.
+///	</summary>
+static bool IsOverlapSegmentedByParent(
+	const std::vector<int> & vecParentFaceIx,
+	int nParentFaces
+) {
+	if (vecParentFaceIx.size() == 0) {
+		return true;
+	}
+	if ((vecParentFaceIx.front() < 0) ||
+	    (vecParentFaceIx.back() >= nParentFaces)
+	) {
+		return false;
+	}
+	return std::is_sorted(vecParentFaceIx.begin(), vecParentFaceIx.end());
+}
+
+///	<summary>
+///		Get the boundaries of blocks of about FaceAreaParallelBlockSize
+///		overlap Faces.  If fSegmented is set the boundaries are moved so
+///		that the Faces with each parent Face fall in a single block.
+///	</summary>
+static void GetOverlapFaceBlocks(
+	const std::vector<int> * pvecParentFaceIx,
+	bool fSegmented,
+	std::vector<int> & vecBlockBegin
+) {
+	const int nFaces = static_cast<int>(pvecParentFaceIx->size());
+	const std::vector<int> & vecParentFaceIx = *pvecParentFaceIx;
+
+	vecBlockBegin.clear();
+	vecBlockBegin.push_back(0);
+
+	int ix = 0;
+	while (ix < nFaces) {
+		ix = std::min(ix + FaceAreaParallelBlockSize, nFaces);
+		if (fSegmented) {
+			while ((ix < nFaces) &&
+			       (vecParentFaceIx[ix] == vecParentFaceIx[ix-1])
+			) {
+				ix++;
+			}
+		}
+		vecBlockBegin.push_back(ix);
+	}
+}
+
+///	<summary>
+///		Accumulate the areas of overlap Faces onto their parent Faces.  Each
+///		parent area is the sum of its overlap Face areas in order, so the
+///		result does not depend on the number of threads.  Overlap Faces
+///		sorted by parent are reduced in place in blocks; otherwise they are
+///		first grouped by parent with a counting sort.
+///	</summary>
+static void AccumulateOverlapFaceAreas(
+	const std::vector<int> & vecParentFaceIx,
+	const DataArray1D<double> & vecOverlapFaceArea,
+	size_t sParentFaces,
+	DataArray1D<double> & vecParentFaceArea
+) {
+	const int nParentFaces = static_cast<int>(sParentFaces);
+	const int nFaces = static_cast<int>(vecParentFaceIx.size());
+
+	vecParentFaceArea.Allocate(nParentFaces);
+
+	// Segmented reduction over sorted overlap Faces
+	if (IsOverlapSegmentedByParent(vecParentFaceIx, nParentFaces)) {
+		std::vector<int> vecBlockBegin;
+		GetOverlapFaceBlocks(&vecParentFaceIx, true, vecBlockBegin);
+
+		const int nBlocks = static_cast<int>(vecBlockBegin.size()) - 1;
+
+#pragma omp parallel for schedule(static)
+		for (int b = 0; b < nBlocks; b++) {
+			for (int i = vecBlockBegin[b]; i < vecBlockBegin[b+1]; i++) {
+				vecParentFaceArea[vecParentFaceIx[i]] += vecOverlapFaceArea[i];
+			}
+		}
+		return;
+	}
+
+	// Group overlap Faces by parent, preserving their order
+	std::vector<int> vecParentBegin(nParentFaces + 1, 0);
+	for (int i = 0; i < nFaces; i++) {
+		const int ixParent = vecParentFaceIx[i];
+		if ((ixParent < 0) || (ixParent >= nParentFaces)) {
+			_EXCEPTIONT("Overlap Mesh FirstFaceIx contains invalid "
+				"Face index");
+		}
+		vecParentBegin[ixParent+1]++;
+	}
+	for (int p = 0; p < nParentFaces; p++) {
+		vecParentBegin[p+1] += vecParentBegin[p];
+	}
+
+	std::vector<int> vecOrder(nFaces);
+	{
+		std::vector<int> vecParentNext(
+			vecParentBegin.begin(), vecParentBegin.end() - 1);
+		for (int i = 0; i < nFaces; i++) {
+			vecOrder[vecParentNext[vecParentFaceIx[i]]++] = i;
+		}
+	}
+
+#pragma omp parallel for schedule(static)
+	for (int p = 0; p < nParentFaces; p++) {
+		double dArea = 0.0;
+		for (int j = vecParentBegin[p]; j < vecParentBegin[p+1]; j++) {
+			dArea += vecOverlapFaceArea[vecOrder[j]];
+		}
+		vecParentFaceArea[p] = dArea;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+Real Mesh::CalculateFaceAreas(
+	bool fContainsConcaveFaces
+) {
+	// If no faces, then zero area
+	if (faces.size() == 0) {
+		return 0.0;
+	}
+
+	// Calculate areas
+	vecFaceArea.Allocate(faces.size());
+
+	// Calculate the area of each Face
+	const int nFaces = faces.size();
+
+	if (fContainsConcaveFaces) {
+
+		// Concave Faces are decomposed by ear clipping, which is reentrant;
+		// the fallback to Triangle is serialized within ConvexifyFace()
+#pragma omp parallel for schedule(dynamic, FaceAreaParallelBlockSize)
+		for (int i = 0; i < nFaces; i++) {
+			if (IsFaceConcave(faces[i], nodes)) {
+				vecFaceArea[i] = CalculateFaceArea_Concave(faces[i], nodes);
+			} else {
+				vecFaceArea[i] = CalculateFaceArea(faces[i], nodes);
+			}
+		}
+
+	} else {
+
+		NodeCoordinateArrays coords(nodes);
+		PackedFaceVector packed(faces);
+
+		const int nBlocks =
+			(nFaces + FaceAreaParallelBlockSize - 1)
+				/ FaceAreaParallelBlockSize;
+
+#pragma omp parallel for schedule(static)
+		for (int b = 0; b < nBlocks; b++) {
+			const int ixBegin = b * FaceAreaParallelBlockSize;
+			const int ixEnd =
+				std::min(ixBegin + FaceAreaParallelBlockSize, nFaces);
+
+			CalculateFaceAreasExcessMethod(
+				packed, coords, ixBegin, ixEnd, vecFaceArea);
+		}
+	}
+
+	WarnSmallFaceAreas(vecFaceArea);
+
+	return SumFaceAreas(vecFaceArea);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+Real Mesh::CalculateFaceAreasFromOverlap(
+	const Mesh & meshOverlap
+) {
+	if (meshOverlap.vecFaceArea.GetRows() == 0) {
+		_EXCEPTIONT("MeshOverlap Face Areas have not been calculated");
+	}
+	if (meshOverlap.vecSourceFaceIx.size() != meshOverlap.faces.size()) {
+		_EXCEPTIONT("Overlap Mesh FirstFaceIx has not been set");
+	}
+
+	AccumulateOverlapFaceAreas(
+		meshOverlap.vecSourceFaceIx,
+		meshOverlap.vecFaceArea,
+		faces.size(),
+		vecFaceArea);
+
+	return SumFaceAreas(meshOverlap.vecFaceArea);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+Real Mesh::CalculateOverlapParentAreas(
+	int nSourceFaces,
+	int nTargetFaces,
+	DataArray1D<double> * pdSourceArea,
+	DataArray1D<double> * pdTargetArea
+) {
+	const int nFaces = static_cast<int>(faces.size());
+
+	if ((vecSourceFaceIx.size() != nFaces) ||
+	    (vecTargetFaceIx.size() != nFaces)
+	) {
+		_EXCEPTIONT("Overlap mesh Face indices have not been set");
+	}
+
+	// Calculate the overlap Face areas if they are not present, and in the
+	// same pass accumulate them onto source (or target) Faces when the
+	// overlap Faces are sorted by source (or target) Face
+	const bool fSourceSegmented =
+		IsOverlapSegmentedByParent(vecSourceFaceIx, nSourceFaces);
+	const bool fTargetSegmented =
+		IsOverlapSegmentedByParent(vecTargetFaceIx, nTargetFaces);
+
+	const std::vector<int> * pvecFusedParentIx = NULL;
+	DataArray1D<double> * pdFusedArea = NULL;
+	if (fSourceSegmented && (pdSourceArea != NULL)) {
+		pvecFusedParentIx = &vecSourceFaceIx;
+		pdFusedArea = pdSourceArea;
+		pdFusedArea->Allocate(nSourceFaces);
+	} else if (fTargetSegmented && (pdTargetArea != NULL)) {
+		pvecFusedParentIx = &vecTargetFaceIx;
+		pdFusedArea = pdTargetArea;
+		pdFusedArea->Allocate(nTargetFaces);
+	}
+
+	if (vecFaceArea.GetRows() != nFaces) {
+		vecFaceArea.Allocate(nFaces);
+
+		NodeCoordinateArrays coords(nodes);
+		PackedFaceVector packed(faces);
+
+		std::vector<int> vecBlockBegin;
+		GetOverlapFaceBlocks(
+			(pvecFusedParentIx != NULL)?(pvecFusedParentIx):(&vecSourceFaceIx),
+			pvecFusedParentIx != NULL,
+			vecBlockBegin);
+
+		const int nBlocks = static_cast<int>(vecBlockBegin.size()) - 1;
+
+#pragma omp parallel for schedule(static)
+		for (int b = 0; b < nBlocks; b++) {
+			CalculateFaceAreasExcessMethod(
+				packed, coords, vecBlockBegin[b], vecBlockBegin[b+1],
+				vecFaceArea);
+
+			if (pdFusedArea != NULL) {
+				for (int i = vecBlockBegin[b]; i < vecBlockBegin[b+1]; i++) {
+					(*pdFusedArea)[(*pvecFusedParentIx)[i]] += vecFaceArea[i];
+				}
+			}
+		}
+
+		WarnSmallFaceAreas(vecFaceArea);
+
+	} else if (pdFusedArea != NULL) {
+		AccumulateOverlapFaceAreas(
+			*pvecFusedParentIx, vecFaceArea, pdFusedArea->GetRows(), *pdFusedArea);
+	}
+
+	// Accumulate the remaining areas
+	if ((pdSourceArea != NULL) && (pdSourceArea != pdFusedArea)) {
+		AccumulateOverlapFaceAreas(
+			vecSourceFaceIx, vecFaceArea, nSourceFaces, *pdSourceArea);
+	}
+	if ((pdTargetArea != NULL) && (pdTargetArea != pdFusedArea)) {
+		AccumulateOverlapFaceAreas(
+			vecTargetFaceIx, vecFaceArea, nTargetFaces, *pdTargetArea);
+	}
+
+	return SumFaceAreas(vecFaceArea);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Stably reorder the Faces of an overlap mesh by the given Face
+///		indices, moving rather than copying the Faces.  Face areas, if
+///		present, are reordered with their Faces.  If fExchange is set the
+///		first and second mesh Face indices are also exchanged.
+///	</summary>
+static void ReorderOverlapFaces(
+	Mesh & mesh,
+	const std::vector<int> & vecKeyIx,
+	bool fExchange
+) {
+	const int nFaces = static_cast<int>(mesh.faces.size());
+
+	std::vector<int> vecOrder(nFaces);
+	for (int i = 0; i < nFaces; i++) {
+		vecOrder[i] = i;
+	}
+	std::stable_sort(vecOrder.begin(), vecOrder.end(),
+		[&vecKeyIx](int a, int b) { return (vecKeyIx[a] < vecKeyIx[b]); });
+
+	FaceVector facesOld;
+	facesOld.swap(mesh.faces);
+	mesh.faces.reserve(nFaces);
+
+	std::vector<int> vecSourceFaceIx(nFaces);
+	std::vector<int> vecTargetFaceIx(nFaces);
+
+	for (int i = 0; i < nFaces; i++) {
+		const int ix = vecOrder[i];
+		mesh.faces.push_back(std::move(facesOld[ix]));
+		if (fExchange) {
+			vecSourceFaceIx[i] = mesh.vecTargetFaceIx[ix];
+			vecTargetFaceIx[i] = mesh.vecSourceFaceIx[ix];
+		} else {
+			vecSourceFaceIx[i] = mesh.vecSourceFaceIx[ix];
+			vecTargetFaceIx[i] = mesh.vecTargetFaceIx[ix];
+		}
+	}
+
+	mesh.vecSourceFaceIx.swap(vecSourceFaceIx);
+	mesh.vecTargetFaceIx.swap(vecTargetFaceIx);
+
+	// Face areas follow their Faces
+	if (mesh.vecFaceArea.GetRows() == nFaces) {
+		DataArray1D<double> vecFaceArea(nFaces);
+		for (int i = 0; i < nFaces; i++) {
+			vecFaceArea[i] = mesh.vecFaceArea[vecOrder[i]];
+		}
+		mesh.vecFaceArea = std::move(vecFaceArea);
+	}
+
+	// The triangulation refers to the old order
+	mesh.triangulation.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Mesh::ExchangeFirstAndSecondMesh() {
+
+	// Verify all vectors are the same size
+	if ((faces.size() != vecSourceFaceIx.size()) ||
+		(faces.size() != vecTargetFaceIx.size())
+	) {
+		_EXCEPTIONT("");
+	}
+
+	// Reorder by second mesh Face index
+	ReorderOverlapFaces(*this, vecTargetFaceIx, true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Mesh::SortBySourceFace() {
+
+	// Verify all vectors are the same size
+	if ((faces.size() != vecSourceFaceIx.size()) ||
+		(faces.size() != vecTargetFaceIx.size())
+	) {
+		_EXCEPTIONT("");
+	}
+
+	// Reorder by first mesh Face index
+	ReorderOverlapFaces(*this, vecSourceFaceIx, false);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void Mesh::ConstructEdgeMap(
-  bool fVerbose
-) {
+void Mesh::GetSpaceFillingCurveOrder(
+	std::vector<int> & vecFaceOrder
+) const {
 
-	// Construct the edge map
-	edgemap.clear();
-	for (int i = 0; i < faces.size(); i++) {
-		const Face & face = faces[i];
+	// Bits of resolution in each panel coordinate
+	const int nBits = 21;
+	const unsigned int nMaxCoord = (1u << nBits) - 1;
 
-		int nEdges = face.edges.size();
+	std::vector< std::pair<unsigned long long, int> > vecKeys(faces.size());
 
-		for (int k = 0; k < nEdges; k++) {
-			if (faces[i][k] == face[(k+1)%nEdges]) {
-				continue;
-			}
+	for (int f = 0; f < faces.size(); f++) {
+		const Face & face = faces[f];
+
+		Real dX = 0.0;
+		Real dY = 0.0;
+		Real dZ = 0.0;
+		for (int i = 0; i < face.edges.size(); i++) {
+			const Node & node = nodes[face[i]];
+			dX += node.x;
+			dY += node.y;
+			dZ += node.z;
+		}
 
-			Edge edge(face[k], face[(k+1)%nEdges]);
-			FacePair facepair;
+		// Gnomonic projection of the centroid onto the cube
+		const Real dAbsX = fabs(dX);
+		const Real dAbsY = fabs(dY);
+		const Real dAbsZ = fabs(dZ);
 
-			EdgeMapIterator iter =
-				edgemap.insert(EdgeMapPair(edge, facepair)).first;
+		int iPanel = 0;
+		Real dA = 0.0;
+		Real dB = 0.0;
 
-			iter->second.AddFace(i);
+		if ((dAbsX >= dAbsY) && (dAbsX >= dAbsZ)) {
+			if (dAbsX > 0.0) {
+				iPanel = (dX > 0.0)?(0):(1);
+				dA = dY / dAbsX;
+				dB = dZ / dAbsX;
+			}
+		} else if (dAbsY >= dAbsZ) {
+			iPanel = (dY > 0.0)?(2):(3);
+			dA = dX / dAbsY;
+			dB = dZ / dAbsY;
+		} else {
+			iPanel = (dZ > 0.0)?(4):(5);
+			dA = dX / dAbsZ;
+			dB = dY / dAbsZ;
 		}
-	}
 
-	if (fVerbose) Announce("Mesh size: Edges [%i]", edgemap.size());
-}
+		unsigned int iA = static_cast<unsigned int>(
+			0.5 * (dA + 1.0) * static_cast<Real>(nMaxCoord));
+		unsigned int iB = static_cast<unsigned int>(
+			0.5 * (dB + 1.0) * static_cast<Real>(nMaxCoord));
 
-///////////////////////////////////////////////////////////////////////////////
+		iA = std::min(iA, nMaxCoord);
+		iB = std::min(iB, nMaxCoord);
 
-void Mesh::ConstructReverseNodeArray() {
+		// Interleave the bits of the two panel coordinates
+		unsigned long long iKey = 0;
+		for (int b = 0; b < nBits; b++) {
+			iKey |= static_cast<unsigned long long>((iA >> b) & 1u) << (2 * b);
+			iKey |= static_cast<unsigned long long>((iB >> b) & 1u) << (2 * b + 1);
+		}
+		iKey |= static_cast<unsigned long long>(iPanel) << (2 * nBits);
 
-	// Initialize the object
-	revnodearray.resize(nodes.size());
-	for (int i = 0; i < revnodearray.size(); i++) {
-		revnodearray[i].clear();
+		vecKeys[f] = std::pair<unsigned long long, int>(iKey, f);
 	}
 
-	// Build set for each node
-	for (int i = 0; i < faces.size(); i++) {
-		for (int k = 0; k < faces[i].edges.size(); k++) {
-			int ixNode = faces[i].edges[k][0];
-			revnodearray[ixNode].insert(i);
-		}
+	std::sort(vecKeys.begin(), vecKeys.end());
+
+	vecFaceOrder.resize(faces.size());
+	for (int f = 0; f < faces.size(); f++) {
+		vecFaceOrder[f] = vecKeys[f].second;
 	}
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
-Real Mesh::CalculateFaceAreas(
-	bool fContainsConcaveFaces
-) {
-	// If no faces, then zero area
-	if (faces.size() == 0) {
-		return 0.0;
-	}
+void Mesh::ReorderAlongSpaceFillingCurve() {
 
-	// Calculate areas
-	int nCount = 0;
-	vecFaceArea.Allocate(faces.size());
+	std::vector<int> vecFaceOrder;
+	GetSpaceFillingCurveOrder(vecFaceOrder);
 
-	// Calculate the area of each Face
-	if (fContainsConcaveFaces) {
+	// Renumber Nodes in order of first appearance; unreferenced Nodes
+	// are placed at the end in their original order
+	std::vector<int> vecNodeIx(nodes.size(), InvalidNode);
 
-		for (int i = 0; i < faces.size(); i++) {
-			vecFaceArea[i] = CalculateFaceArea_Concave(faces[i], nodes);
-			if (vecFaceArea[i] < 1.0e-13) {
-				nCount++;
+	NodeVector nodesOld;
+	nodesOld.swap(nodes);
+	nodes.reserve(nodesOld.size());
+
+	for (int f = 0; f < vecFaceOrder.size(); f++) {
+		const Face & face = faces[vecFaceOrder[f]];
+		for (int i = 0; i < face.edges.size(); i++) {
+			if (vecNodeIx[face[i]] == InvalidNode) {
+				vecNodeIx[face[i]] = nodes.size();
+				nodes.push_back(nodesOld[face[i]]);
 			}
 		}
-
-		if (nCount != 0) {
-			Announce("WARNING: %i small elements found", nCount);
+	}
+	for (int i = 0; i < nodesOld.size(); i++) {
+		if (vecNodeIx[i] == InvalidNode) {
+			vecNodeIx[i] = nodes.size();
+			nodes.push_back(nodesOld[i]);
 		}
+	}
 
-	} else {
+	// Reorder Faces and per-Face data
+	FaceVector facesOld;
+	facesOld.swap(faces);
+	faces.reserve(facesOld.size());
 
-		for (int i = 0; i < faces.size(); i++) {
-			vecFaceArea[i] = CalculateFaceArea(faces[i], nodes);
-			if (vecFaceArea[i] < 1.0e-13) {
-				nCount++;
-			}
+	for (int f = 0; f < vecFaceOrder.size(); f++) {
+		Face & face = facesOld[vecFaceOrder[f]];
+		for (int i = 0; i < face.edges.size(); i++) {
+			face.edges[i][0] = vecNodeIx[face.edges[i][0]];
+			face.edges[i][1] = vecNodeIx[face.edges[i][1]];
 		}
+		faces.push_back(std::move(face));
+	}
 
-		if (nCount != 0) {
-			Announce("WARNING: %i small elements found", nCount);
+	if (vecFaceArea.GetRows() == vecFaceOrder.size()) {
+		DataArray1D<double> vecFaceAreaOld = vecFaceArea;
+		for (int f = 0; f < vecFaceOrder.size(); f++) {
+			vecFaceArea[f] = vecFaceAreaOld[vecFaceOrder[f]];
 		}
 	}
 
-	// Calculate accumulated area carefully
-	static const int Jump = 10;
-	std::vector<double> vecFaceAreaBak;
-	vecFaceAreaBak.resize(vecFaceArea.GetRows());
-	memcpy(&(vecFaceAreaBak[0]), &(vecFaceArea[0]),
-		vecFaceArea.GetRows() * sizeof(double));
+	if (vecMask.size() == vecFaceOrder.size()) {
+		std::vector<int> vecMaskOld = vecMask;
+		for (int f = 0; f < vecFaceOrder.size(); f++) {
+			vecMask[f] = vecMaskOld[vecFaceOrder[f]];
+		}
+	}
 
-	for (;;) {
-		if (vecFaceAreaBak.size() == 1) {
-			break;
+	if (vecSourceFaceIx.size() == vecFaceOrder.size()) {
+		std::vector<int> vecSourceFaceIxOld = vecSourceFaceIx;
+		for (int f = 0; f < vecFaceOrder.size(); f++) {
+			vecSourceFaceIx[f] = vecSourceFaceIxOld[vecFaceOrder[f]];
 		}
-		for (int i = 0; i <= (vecFaceAreaBak.size()-1) / Jump; i++) {
-			int ixRef = Jump * i;
-			vecFaceAreaBak[i] = vecFaceAreaBak[ixRef];
-			for (int j = 1; j < Jump; j++) {
-				if (ixRef + j >= vecFaceAreaBak.size()) {
-					break;
-				}
-				vecFaceAreaBak[i] += vecFaceAreaBak[ixRef + j];
-			}
+	}
+
+	if (vecTargetFaceIx.size() == vecFaceOrder.size()) {
+		std::vector<int> vecTargetFaceIxOld = vecTargetFaceIx;
+		for (int f = 0; f < vecFaceOrder.size(); f++) {
+			vecTargetFaceIx[f] = vecTargetFaceIxOld[vecFaceOrder[f]];
 		}
-		vecFaceAreaBak.resize((vecFaceAreaBak.size()-1) / Jump + 1);
 	}
 
-	return vecFaceAreaBak[0];
+	// Compose the permutation with any existing map to original Faces
+	if (vecMultiFaceMap.size() == vecFaceOrder.size()) {
+		std::vector<int> vecMultiFaceMapOld = vecMultiFaceMap;
+		for (int f = 0; f < vecFaceOrder.size(); f++) {
+			vecMultiFaceMap[f] = vecMultiFaceMapOld[vecFaceOrder[f]];
+		}
+	} else {
+		vecMultiFaceMap = vecFaceOrder;
+	}
+
+	// Connectivity refers to the old numbering
+	edgemap.clear();
+	revnodearray.clear();
+	triangulation.clear();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
-Real Mesh::CalculateFaceAreasFromOverlap(
-	const Mesh & meshOverlap
-) {
-	if (meshOverlap.vecFaceArea.GetRows() == 0) {
-		_EXCEPTIONT("MeshOverlap Face Areas have not been calculated");
+#if !defined(_OPENMP) || !defined(OVERLAPMESH_USE_NODE_HASHMAP)
+
+///	<summary>
+///		Comparator ordering node indices by x coordinate, then by index.
+///	</summary>
+class NodeIndexXCompare {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	NodeIndexXCompare(
+		const NodeVector & nodes
+	) :
+		m_nodes(nodes)
+	{ }
+
+	///	<summary>
+	///		Comparator.
+	///	</summary>
+	bool operator()(int i, int j) const {
+		if (m_nodes[i].x != m_nodes[j].x) {
+			return (m_nodes[i].x < m_nodes[j].x);
+		}
+		return (i < j);
 	}
 
-	// Set all Face areas to zero
-	vecFaceArea.Allocate(faces.size());
+private:
+	///	<summary>
+	///		Nodes.
+	///	</summary>
+	const NodeVector & m_nodes;
+};
 
-	// Loop over all Faces in meshOverlap
-	double dTotalArea = 0.0;
+///////////////////////////////////////////////////////////////////////////////
 
-	for (int i = 0; i < meshOverlap.faces.size(); i++) {
-		int ixFirstFace = meshOverlap.vecSourceFaceIx[i];
+///	<summary>
+///		Find the index of the unique node corresponding to each node, with
+///		the same result as merging nodes serially through a
+///		std::map<Node, int>: uniques are numbered in order of first
+///		appearance and a node is merged with the first unique node it is
+///		coincident to.  Node indices are sorted by x coordinate in parallel
+///		and each node is compared only with nodes whose x coordinate lies
+///		within tolerance.  Returns the number of unique nodes; vecUniques
+///		holds the index of the first occurrence of each unique node.
+///	</summary>
+static int FindCoincidentNodesSorted(
+	const NodeVector & nodes,
+	std::vector<int> & vecNodeIndex,
+	std::vector<int> & vecUniques
+) {
+	static const Real Tolerance = ReferenceTolerance;
 
-		if (ixFirstFace >= vecFaceArea.GetRows()) {
-			_EXCEPTIONT("Overlap Mesh FirstFaceIx contains invalid "
-				"Face index");
-		}
+	const int nNodes = nodes.size();
+
+	vecNodeIndex.resize(nNodes);
+	vecUniques.clear();
 
-		vecFaceArea[ixFirstFace] += meshOverlap.vecFaceArea[i];
-		dTotalArea += meshOverlap.vecFaceArea[i];
+	// Sort node indices in chunks, then merge chunks pairwise
+	std::vector<int> vecOrder(nNodes);
+	for (int i = 0; i < nNodes; i++) {
+		vecOrder[i] = i;
 	}
-	return dTotalArea;
-}
 
-///////////////////////////////////////////////////////////////////////////////
+	NodeIndexXCompare comp(nodes);
 
-void Mesh::ExchangeFirstAndSecondMesh() {
+	int nChunks = 1;
+#if defined(_OPENMP)
+	if (nNodes >= CoordTransformParallelThreshold) {
+		nChunks = omp_get_max_threads();
+	}
+#endif
+	std::vector<int> vecChunkBegin(nChunks + 1);
+	for (int c = 0; c <= nChunks; c++) {
+		vecChunkBegin[c] = static_cast<int>(
+			(static_cast<long>(nNodes) * c) / nChunks);
+	}
 
-	// Verify all vectors are the same size
-	if ((faces.size() != vecSourceFaceIx.size()) ||
-		(faces.size() != vecTargetFaceIx.size())
-	) {
-		_EXCEPTIONT("");
+#pragma omp parallel for schedule(static) if (nChunks > 1)
+	for (int c = 0; c < nChunks; c++) {
+		std::sort(
+			vecOrder.begin() + vecChunkBegin[c],
+			vecOrder.begin() + vecChunkBegin[c+1],
+			comp);
+	}
+
+	for (int nWidth = 1; nWidth < nChunks; nWidth *= 2) {
+#pragma omp parallel for schedule(static)
+		for (int c = 0; c < nChunks - nWidth; c += 2 * nWidth) {
+			const int cEnd = std::min(c + 2 * nWidth, nChunks);
+			std::inplace_merge(
+				vecOrder.begin() + vecChunkBegin[c],
+				vecOrder.begin() + vecChunkBegin[c + nWidth],
+				vecOrder.begin() + vecChunkBegin[cEnd],
+				comp);
+		}
 	}
 
-	// Reorder vectors
-	FaceVector facesOld = faces;
+	// Find the earliest coincident node of each node and whether more
+	// than one earlier coincident node exists
+	std::vector<int> vecFirstMatch(nNodes, (-1));
+	std::vector<char> vecMultiMatch(nNodes, 0);
+	std::vector<int> vecSortedPos(nNodes);
 
-	std::vector<int> vecSourceFaceIxOld = vecSourceFaceIx;
+#pragma omp parallel for schedule(static)
+	for (int p = 0; p < nNodes; p++) {
+		const int i = vecOrder[p];
+		const Node & node = nodes[i];
+
+		vecSortedPos[i] = p;
+
+		int nMatches = 0;
+		int iFirstMatch = (-1);
+
+		for (int q = p - 1; q >= 0; q--) {
+			const int j = vecOrder[q];
+			if (node.x - nodes[j].x >= Tolerance) {
+				break;
+			}
+			if ((j < i) && (nodes[j] == node)) {
+				if ((iFirstMatch == (-1)) || (j < iFirstMatch)) {
+					iFirstMatch = j;
+				}
+				nMatches++;
+			}
+		}
+		for (int q = p + 1; q < nNodes; q++) {
+			const int j = vecOrder[q];
+			if (nodes[j].x - node.x >= Tolerance) {
+				break;
+			}
+			if ((j < i) && (nodes[j] == node)) {
+				if ((iFirstMatch == (-1)) || (j < iFirstMatch)) {
+					iFirstMatch = j;
+				}
+				nMatches++;
+			}
+		}
 
-	// Reordering map
-	std::multimap<int,int> multimapReorder;
-	for (int i = 0; i < vecTargetFaceIx.size(); i++) {
-		multimapReorder.insert(std::pair<int,int>(vecTargetFaceIx[i], i));
+		vecFirstMatch[i] = iFirstMatch;
+		vecMultiMatch[i] = (nMatches > 1)?(1):(0);
 	}
 
-	// Apply reordering
-	faces.clear();
-	vecSourceFaceIx.clear();
-	vecTargetFaceIx.clear();
+	// Number unique nodes in order of first appearance
+	std::vector<char> vecIsUnique(nNodes, 0);
+
+	for (int i = 0; i < nNodes; i++) {
+		int iMatch = vecFirstMatch[i];
+
+		// Several earlier coincident nodes, or the earliest is not itself
+		// unique; find the first coincident unique node
+		if ((iMatch != (-1)) && (vecMultiMatch[i] || !vecIsUnique[iMatch])) {
+			const int p = vecSortedPos[i];
+			const Node & node = nodes[i];
 
-	std::multimap<int,int>::const_iterator iterReorder
-		= multimapReorder.begin();
+			iMatch = (-1);
+			for (int q = p - 1; q >= 0; q--) {
+				const int j = vecOrder[q];
+				if (node.x - nodes[j].x >= Tolerance) {
+					break;
+				}
+				if ((j < i) && vecIsUnique[j] && (nodes[j] == node)) {
+					if ((iMatch == (-1)) || (j < iMatch)) {
+						iMatch = j;
+					}
+				}
+			}
+			for (int q = p + 1; q < nNodes; q++) {
+				const int j = vecOrder[q];
+				if (nodes[j].x - node.x >= Tolerance) {
+					break;
+				}
+				if ((j < i) && vecIsUnique[j] && (nodes[j] == node)) {
+					if ((iMatch == (-1)) || (j < iMatch)) {
+						iMatch = j;
+					}
+				}
+			}
+		}
 
-	for (; iterReorder != multimapReorder.end(); iterReorder++) {
-		faces.push_back(facesOld[iterReorder->second]);
-		vecSourceFaceIx.push_back(iterReorder->first);
-		vecTargetFaceIx.push_back(vecSourceFaceIxOld[iterReorder->second]);
+		if (iMatch != (-1)) {
+			vecNodeIndex[i] = vecNodeIndex[iMatch];
+		} else {
+			vecIsUnique[i] = 1;
+			vecNodeIndex[i] = vecUniques.size();
+			vecUniques.push_back(i);
+		}
 	}
+
+	return static_cast<int>(vecUniques.size());
 }
 
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 
 void Mesh::RemoveCoincidentNodes(
   bool fVerbose
 ) {
+	const int nNodes = nodes.size();
 
-	// Put nodes into a map, tagging uniques
-	std::map<Node, int> mapNodes;
+	// Index of the unique node corresponding to each node
+	std::vector<int> vecNodeIndex(nNodes);
 
-	std::vector<int> vecNodeIndex;
-	std::vector<int> vecUniques;
+	int nUniques;
+
+#if defined(_OPENMP) && defined(OVERLAPMESH_USE_NODE_HASHMAP)
+	// Merge nodes concurrently; the priority of each node is its index,
+	// so unique nodes are numbered in order of first appearance and take
+	// the coordinates of their first occurrence, as in a serial merge
+	{
+		ConcurrentNodeMap nodemap(
+			ReferenceTolerance, OVERLAPMESH_HASHMAP_CELL_WIDTH);
 
-	vecNodeIndex.reserve(nodes.size());
-	vecUniques.reserve(nodes.size());
+#pragma omp parallel for schedule(static)
+		for (int i = 0; i < nNodes; i++) {
+			vecNodeIndex[i] =
+				nodemap.find_or_insert(nodes[i], static_cast<uint64_t>(i));
+		}
 
-	for (int i = 0; i < nodes.size(); i++) {
-		std::map<Node, int>::const_iterator iter = mapNodes.find(nodes[i]);
+		nUniques = static_cast<int>(nodemap.size());
 
-		if (iter != mapNodes.end()) {
-			vecNodeIndex[i] = vecNodeIndex[iter->second];
-		} else {
-			mapNodes.insert(std::pair<Node, int>(nodes[i], i));
-			vecNodeIndex[i] = vecUniques.size();
-			vecUniques.push_back(i);
+		if (nUniques == nNodes) {
+			return;
 		}
-	}
 
-	if (vecUniques.size() == nodes.size()) {
-		return;
-	}
+		NodeVector nodesUnique;
+		std::vector<int> vecProvisionalIndex;
+		nodemap.assign_indices(nodesUnique, vecProvisionalIndex);
 
-	if(fVerbose) {
-		Announce("%i duplicate nodes detected", nodes.size() - vecUniques.size());
+#pragma omp parallel for schedule(static)
+		for (int i = 0; i < nNodes; i++) {
+			vecNodeIndex[i] = vecProvisionalIndex[vecNodeIndex[i]];
+		}
+
+		nodes.swap(nodesUnique);
 	}
+#else
+	// Find coincident nodes by sorting, tagging uniques
+	{
+		std::vector<int> vecUniques;
+
+		nUniques = FindCoincidentNodesSorted(nodes, vecNodeIndex, vecUniques);
 
-	// Remove duplicates
-	NodeVector nodesOld = nodes;
+		if (nUniques == nNodes) {
+			return;
+		}
+
+		// Remove duplicates
+		NodeVector nodesUnique(nUniques);
+
+#pragma omp parallel for schedule(static)
+		for (int i = 0; i < nUniques; i++) {
+			nodesUnique[i] = nodes[vecUniques[i]];
+		}
 
-	nodes.resize(vecUniques.size());
-	for (int i = 0; i < vecUniques.size(); i++) {
-		nodes[i] = nodesOld[vecUniques[i]];
+		nodes.swap(nodesUnique);
+	}
+#endif
+
+	if(fVerbose) {
+		Announce("%i duplicate nodes detected", nNodes - nUniques);
 	}
 
 	// Adjust node indices in Faces
-	for (int i = 0; i < faces.size(); i++) {
+	const int nFaces = faces.size();
+
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < nFaces; i++) {
 	for (int j = 0; j < faces[i].edges.size(); j++) {
 		faces[i].edges[j].node[0] =
 			vecNodeIndex[faces[i].edges[j].node[0]];
@@ -314,61 +1390,34 @@ void Mesh::RemoveCoincidentNodes(
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void Mesh::Write(
+///	<summary>
+///		Variables of an Exodus mesh file created by WriteExodusHeader().
+///	</summary>
+struct ExodusHeaderVars {
+	std::vector<NcDim *> vecElementBlockDim;
+	std::vector<NcVar *> vecConnectVar;
+	std::vector<NcVar *> vecGlobalIdVar;
+	std::vector<NcVar *> vecEdgeTypeVar;
+	NcVar * varNodes;
+};
+
+///	<summary>
+///		Write the dimensions, attributes and block metadata of an Exodus
+///		mesh file and create its connectivity, global id, edge type and
+///		coordinate variables.  Element block n contains vecBlockSizeFaces[n]
+///		Faces with vecBlockSizes[n] nodes each.
+///	</summary>
+static void WriteExodusHeader(
+	NcFile & ncOut,
 	const std::string & strFile,
-	NcFile::FileFormat eFileFormat
-) const {
+	int nNodeCount,
+	const std::vector<int> & vecBlockSizes,
+	const std::vector<int> & vecBlockSizeFaces,
+	ExodusHeaderVars & vars
+) {
 	const int ParamFour = 4;
 	const int ParamLenString = 33;
 
-	// Temporarily change error reporting
-	NcError error_temp(NcError::verbose_fatal);
-
-	// Determine block sizes
-	std::vector<int> vecBlockSizes;
-	std::vector<int> vecBlockSizeFaces;
-	{
-		std::map<int, int> mapBlockSizes;
-		std::map<int, int>::iterator iterBlockSize;
-		int iBlock;
-		char szBuffer[ParamLenString];
-
-		for (int i = 0; i < faces.size(); i++) {
-			iterBlockSize = mapBlockSizes.find(faces[i].edges.size());
-
-			if (iterBlockSize == mapBlockSizes.end()) {
-				mapBlockSizes.insert(
-					std::pair<int,int>(faces[i].edges.size(), 1));
-			} else {
-				(iterBlockSize->second)++;
-			}
-		}
-
-		vecBlockSizes.resize(mapBlockSizes.size());
-		vecBlockSizeFaces.resize(mapBlockSizes.size());
-
-		AnnounceStartBlock("Nodes per element");
-		iterBlockSize = mapBlockSizes.begin();
-		iBlock = 1;
-		for (; iterBlockSize != mapBlockSizes.end(); iterBlockSize++) {
-			vecBlockSizes[iBlock-1] = iterBlockSize->first;
-			vecBlockSizeFaces[iBlock-1] = iterBlockSize->second;
-
-			Announce("Block %i (%i nodes): %i",
-				iBlock, vecBlockSizes[iBlock-1], vecBlockSizeFaces[iBlock-1]);
-
-			iBlock++;
-		}
-		AnnounceEndBlock(NULL);
-	}
-
-	// Output to a NetCDF Exodus file
-	NcFile ncOut(strFile.c_str(), NcFile::Replace, NULL, 0, eFileFormat);
-	if (!ncOut.is_valid()) {
-		_EXCEPTION1("Unable to open grid file \"%s\" for writing",
-			strFile.c_str());
-	}
-
 	// Auxiliary Exodus dimensions
 	NcDim * dimLenString = ncOut.add_dim("len_string", ParamLenString);
 	NcDim * dimLenLine = ncOut.add_dim("len_line", 81);
@@ -377,11 +1426,13 @@ void Mesh::Write(
 	NcDim * dimDimension = ncOut.add_dim("num_dim", 3);
 
 	// Number of nodes
-	int nNodeCount = nodes.size();
 	NcDim * dimNodes = ncOut.add_dim("num_nodes", nNodeCount);
 
 	// Number of elements
-	int nElementCount = faces.size();
+	int nElementCount = 0;
+	for (int n = 0; n < vecBlockSizeFaces.size(); n++) {
+		nElementCount += vecBlockSizeFaces[n];
+	}
 	NcDim * dimElements = ncOut.add_dim("num_elem", nElementCount);
 
 	// Other dimensions
@@ -456,7 +1507,7 @@ void Mesh::Write(
 		_EXCEPTIONT("Error creating dimension \"num_el_blk\"");
 	}
 
-	std::vector<NcDim *> vecElementBlockDim;
+	std::vector<NcDim *> & vecElementBlockDim = vars.vecElementBlockDim;
 	std::vector<NcDim *> vecNodesPerElementDim;
 	std::vector<NcDim *> vecAttBlockDim;
 
@@ -526,133 +1577,237 @@ void Mesh::Write(
 		NcVar * varElementProperty =
 			ncOut.add_var("eb_prop1", ncInt, dimNumElementBlocks);
 
-		if (varElementProperty == NULL) {
-			_EXCEPTIONT("Error creating variable \"eb_prop1\"");
+		if (varElementProperty == NULL) {
+			_EXCEPTIONT("Error creating variable \"eb_prop1\"");
+		}
+
+		varElementProperty->put(&(vecProp[0]), vecBlockSizes.size());
+		varElementProperty->add_att("name", "ID");
+	}
+
+	// Attributes (written once all variables are defined)
+	std::vector<NcVar *> vecAttribVar(vecBlockSizes.size());
+	for (int n = 0; n < vecBlockSizes.size(); n++) {
+		char szAttribName[ParamLenString];
+		sprintf(szAttribName, "attrib%i", n+1);
+
+		vecAttribVar[n] =
+			ncOut.add_var(
+				szAttribName, ncDouble,
+				vecElementBlockDim[n],
+				vecAttBlockDim[n]);
+
+		if (vecAttribVar[n] == NULL) {
+			_EXCEPTION1("Error creating variable \"%s\"", szAttribName);
+		}
+	}
+
+	// Face nodes (1-indexed), global ids and edge types
+	vars.vecConnectVar.resize(vecBlockSizes.size());
+	vars.vecGlobalIdVar.resize(vecBlockSizes.size());
+	vars.vecEdgeTypeVar.resize(vecBlockSizes.size());
+
+	for (int n = 0; n < vecBlockSizes.size(); n++) {
+		char szConnectVarName[ParamLenString];
+		sprintf(szConnectVarName, "connect%i", n+1);
+		vars.vecConnectVar[n] =
+			ncOut.add_var(
+				szConnectVarName, ncInt,
+				vecElementBlockDim[n],
+				vecNodesPerElementDim[n]);
+
+		if (vars.vecConnectVar[n] == NULL) {
+			_EXCEPTION1("Error creating variable \"%s\"",
+				szConnectVarName);
+		}
+		SetNcVarChunking(ncOut, vars.vecConnectVar[n]);
+
+		char szConnectAttrib[ParamLenString];
+		sprintf(szConnectAttrib, "SHELL%i", vecBlockSizes[n]);
+		vars.vecConnectVar[n]->add_att("elem_type", szConnectAttrib);
+
+		char szGlobalIdVarName[ParamLenString];
+		sprintf(szGlobalIdVarName, "global_id%i", n+1);
+		vars.vecGlobalIdVar[n] = 
+			ncOut.add_var(
+				szGlobalIdVarName, ncInt,
+				vecElementBlockDim[n]);
+
+		if (vars.vecGlobalIdVar[n] == NULL) {
+			_EXCEPTION1("Error creating variable \"%s\"",
+				szGlobalIdVarName);
+		}
+		SetNcVarChunking(ncOut, vars.vecGlobalIdVar[n]);
+
+		char szEdgeTypeVarName[ParamLenString];
+		sprintf(szEdgeTypeVarName, "edge_type%i", n+1);
+		vars.vecEdgeTypeVar[n] =
+			ncOut.add_var(
+				szEdgeTypeVarName, ncInt,
+				vecElementBlockDim[n],
+				vecNodesPerElementDim[n]);
+
+		if (vars.vecEdgeTypeVar[n] == NULL) {
+			_EXCEPTION1("Error creating variable \"%s\"",
+				szEdgeTypeVarName);
+		}
+		SetNcVarChunking(ncOut, vars.vecEdgeTypeVar[n]);
+	}
+
+	// Node list
+	vars.varNodes =
+		ncOut.add_var("coord", ncDouble, dimDimension, dimNodes);
+
+	if (vars.varNodes == NULL) {
+		_EXCEPTIONT("Error creating variable \"coord\"");
+	}
+	SetNcVarChunking(ncOut, vars.varNodes);
+
+	// Attribute values, in chunks so that their size is independent of
+	// the size of the Mesh
+	{
+		const int nAttribChunk =
+			static_cast<int>(DefaultNcChunkBytes / sizeof(double));
+
+		std::vector<double> dAttrib(nAttribChunk, 1.0);
+
+		for (int n = 0; n < vecBlockSizes.size(); n++) {
+			for (int i = 0; i < vecBlockSizeFaces[n]; i += nAttribChunk) {
+				int nCount = std::min(nAttribChunk, vecBlockSizeFaces[n] - i);
+
+				vecAttribVar[n]->set_cur(i, 0);
+				vecAttribVar[n]->put(&(dAttrib[0]), nCount, 1);
+			}
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Get the format used to write an Exodus mesh file with the given
+///		element blocks, announcing if it differs from the requested format.
+///	</summary>
+static NcFile::FileFormat GetExodusFileFormat(
+	NcFile::FileFormat eFileFormat,
+	int nNodeCount,
+	const std::vector<int> & vecBlockSizes,
+	const std::vector<int> & vecBlockSizeFaces
+) {
+	size_t sLargestVarBytes = 3 * sizeof(double) * static_cast<size_t>(nNodeCount);
+	size_t sTotalBytes = sLargestVarBytes;
+	for (int n = 0; n < vecBlockSizes.size(); n++) {
+		const size_t sFaces = static_cast<size_t>(vecBlockSizeFaces[n]);
+		const size_t sConnectBytes =
+			sizeof(int) * sFaces * static_cast<size_t>(vecBlockSizes[n]);
+
+		// Connectivity, edge types, global ids, parents and attributes
+		sTotalBytes += 2 * sConnectBytes + sFaces * (3 * sizeof(int) + sizeof(double));
+		if (sConnectBytes > sLargestVarBytes) {
+			sLargestVarBytes = sConnectBytes;
 		}
+	}
 
-		varElementProperty->put(&(vecProp[0]), vecBlockSizes.size());
-		varElementProperty->add_att("name", "ID");
+	NcFile::FileFormat eFormatOut =
+		GetNcFileFormatForSize(eFileFormat, sLargestVarBytes, sTotalBytes);
+
+	if (eFormatOut != eFileFormat) {
+		Announce("Mesh is too large for the requested file format; "
+			"writing in %s format",
+			(eFormatOut == NcFile::Offset64Bits)?("64-bit offset"):("NetCDF-4"));
 	}
 
-	// Attributes
+	return eFormatOut;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Mesh::Write(
+	const std::string & strFile,
+	NcFile::FileFormat eFileFormat
+) const {
+	const int ParamLenString = 33;
+
+	// Temporarily change error reporting
+	NcError error_temp(NcError::verbose_fatal);
+
+	// Determine block sizes
+	std::vector<int> vecBlockSizes;
+	std::vector<int> vecBlockSizeFaces;
 	{
-		for (int n = 0; n < vecBlockSizes.size(); n++) {
-			std::vector<double> dAttrib;
-			dAttrib.resize(vecBlockSizeFaces[n]);
-			for (int i = 0; i < vecBlockSizeFaces[n]; i++) {
-				dAttrib[i] = 1.0;
+		std::map<int, int> mapBlockSizes;
+		std::map<int, int>::iterator iterBlockSize;
+		int iBlock;
+		char szBuffer[ParamLenString];
+
+		for (int i = 0; i < faces.size(); i++) {
+			iterBlockSize = mapBlockSizes.find(faces[i].edges.size());
+
+			if (iterBlockSize == mapBlockSizes.end()) {
+				mapBlockSizes.insert(
+					std::pair<int,int>(faces[i].edges.size(), 1));
+			} else {
+				(iterBlockSize->second)++;
 			}
+		}
 
-			char szAttribName[ParamLenString];
-			sprintf(szAttribName, "attrib%i", n+1);
+		vecBlockSizes.resize(mapBlockSizes.size());
+		vecBlockSizeFaces.resize(mapBlockSizes.size());
 
-			NcVar * varAttrib =
-				ncOut.add_var(
-					szAttribName, ncDouble,
-					vecElementBlockDim[n],
-					vecAttBlockDim[n]);
+		AnnounceStartBlock("Nodes per element");
+		iterBlockSize = mapBlockSizes.begin();
+		iBlock = 1;
+		for (; iterBlockSize != mapBlockSizes.end(); iterBlockSize++) {
+			vecBlockSizes[iBlock-1] = iterBlockSize->first;
+			vecBlockSizeFaces[iBlock-1] = iterBlockSize->second;
 
-			if (varAttrib == NULL) {
-				_EXCEPTION1("Error creating variable \"%s\"", szAttribName);
-			}
+			Announce("Block %i (%i nodes): %i",
+				iBlock, vecBlockSizes[iBlock-1], vecBlockSizeFaces[iBlock-1]);
 
-			varAttrib->set_cur((long)0);
-			varAttrib->put(&(dAttrib[0]), vecBlockSizeFaces[n]);
+			iBlock++;
 		}
+		AnnounceEndBlock(NULL);
 	}
 
-	// Face-specific variables
-	{
-		// Face nodes (1-indexed)
-		std::vector<NcVar*> vecConnectVar;
-		vecConnectVar.resize(vecBlockSizes.size());
-
-		std::vector< DataArray2D<int> > vecConnect;
-		vecConnect.resize(vecBlockSizes.size());
+	// Dimensions, attributes and block metadata
+	int nNodeCount = nodes.size();
+	int nElementCount = faces.size();
 
-		// Number of elements added to each connectivity array
-		std::vector<int> vecConnectCount;
-		vecConnectCount.resize(vecBlockSizes.size());
+	// Output to a NetCDF Exodus file
+	eFileFormat =
+		GetExodusFileFormat(
+			eFileFormat, nNodeCount, vecBlockSizes, vecBlockSizeFaces);
 
-		// Global ids
-		std::vector<NcVar*> vecGlobalIdVar;
-		vecGlobalIdVar.resize(vecBlockSizes.size());
+	NcFile ncOut(strFile.c_str(), NcFile::Replace, NULL, 0, eFileFormat);
+	if (!ncOut.is_valid()) {
+		_EXCEPTION1("Unable to open grid file \"%s\" for writing",
+			strFile.c_str());
+	}
 
-		std::vector< DataArray1D<int> > vecGlobalId;
-		vecGlobalId.resize(vecBlockSizes.size());
+	ExodusHeaderVars vars;
+	WriteExodusHeader(
+		ncOut, strFile, nNodeCount, vecBlockSizes, vecBlockSizeFaces, vars);
 
-		// Edge types
-		std::vector<NcVar*> vecEdgeTypeVar;
-		vecEdgeTypeVar.resize(vecBlockSizes.size());
+	std::vector<NcDim *> & vecElementBlockDim = vars.vecElementBlockDim;
 
-		std::vector< DataArray2D<int> > vecEdgeType;
-		vecEdgeType.resize(vecBlockSizes.size());
+	// Face-specific variables
+	{
+		// Face nodes (1-indexed), global ids and edge types
+		std::vector<NcVar*> & vecConnectVar = vars.vecConnectVar;
+		std::vector<NcVar*> & vecGlobalIdVar = vars.vecGlobalIdVar;
+		std::vector<NcVar*> & vecEdgeTypeVar = vars.vecEdgeTypeVar;
 
 		// Parent on source mesh
 		std::vector<NcVar*> vecFaceParentAVar;
 		vecFaceParentAVar.resize(vecBlockSizes.size());
 
-		std::vector< DataArray1D<int> > vecFaceParentA;
-		vecFaceParentA.resize(vecBlockSizes.size());
-
 		// Parent on target mesh
 		std::vector<NcVar*> vecFaceParentBVar;
 		vecFaceParentBVar.resize(vecBlockSizes.size());
 
-		std::vector< DataArray1D<int> > vecFaceParentB;
-		vecFaceParentB.resize(vecBlockSizes.size());
-
-		// Initialize block-local storage arrays and create output variables
+		// Create parent variables
 		for (int n = 0; n < vecBlockSizes.size(); n++) {
-			vecConnect[n].Allocate(vecBlockSizeFaces[n], vecBlockSizes[n]);
-			vecGlobalId[n].Allocate(vecBlockSizeFaces[n]);
-			vecEdgeType[n].Allocate(vecBlockSizeFaces[n], vecBlockSizes[n]);
-	
-			char szConnectVarName[ParamLenString];
-			sprintf(szConnectVarName, "connect%i", n+1);
-			vecConnectVar[n] =
-				ncOut.add_var(
-					szConnectVarName, ncInt,
-					vecElementBlockDim[n],
-					vecNodesPerElementDim[n]);
-
-			if (vecConnectVar[n] == NULL) {
-				_EXCEPTION1("Error creating variable \"%s\"",
-					szConnectVarName);
-			}
-
-			char szConnectAttrib[ParamLenString];
-			sprintf(szConnectAttrib, "SHELL%i", vecBlockSizes[n]);
-			vecConnectVar[n]->add_att("elem_type", szConnectAttrib);
-
-			char szGlobalIdVarName[ParamLenString];
-			sprintf(szGlobalIdVarName, "global_id%i", n+1);
-			vecGlobalIdVar[n] = 
-				ncOut.add_var(
-					szGlobalIdVarName, ncInt,
-					vecElementBlockDim[n]);
-
-			if (vecGlobalIdVar[n] == NULL) {
-				_EXCEPTION1("Error creating variable \"%s\"",
-					szGlobalIdVarName);
-			}
-
-			char szEdgeTypeVarName[ParamLenString];
-			sprintf(szEdgeTypeVarName, "edge_type%i", n+1);
-			vecEdgeTypeVar[n] =
-				ncOut.add_var(
-					szEdgeTypeVarName, ncInt,
-					vecElementBlockDim[n],
-					vecNodesPerElementDim[n]);
-
-			if (vecEdgeTypeVar[n] == NULL) {
-				_EXCEPTION1("Error creating variable \"%s\"",
-					szEdgeTypeVarName);
-			}
-
 			if (vecSourceFaceIx.size() != 0) {
-				vecFaceParentA[n].Allocate(vecBlockSizeFaces[n]);
-
 				char szParentAVarName[ParamLenString];
 				sprintf(szParentAVarName, "el_parent_a%i", n+1);
 				vecFaceParentAVar[n] =
@@ -664,11 +1819,10 @@ void Mesh::Write(
 					_EXCEPTION1("Error creating variable \"%s\"",
 						szParentAVarName);
 				}
+				SetNcVarChunking(ncOut, vecFaceParentAVar[n]);
 			}
 
 			if (vecTargetFaceIx.size() != 0) {
-				vecFaceParentB[n].Allocate(vecBlockSizeFaces[n]);
-
 				char szParentBVarName[ParamLenString];
 				sprintf(szParentBVarName, "el_parent_b%i", n+1);
 				vecFaceParentBVar[n] =
@@ -680,102 +1834,117 @@ void Mesh::Write(
 					_EXCEPTION1("Error creating variable \"%s\"",
 						szParentBVarName);
 				}
+				SetNcVarChunking(ncOut, vecFaceParentBVar[n]);
 			}
 		}
 
-		// Rebuild global data structures in local block arrays
-		for (int i = 0; i < nElementCount; i++) {
-			int iBlock = 0;
-			for (; iBlock < vecBlockSizes.size(); iBlock++) {
-				if (vecBlockSizes[iBlock] == faces[i].edges.size()) {
-					break;
-				}
+		// Stream each block in chunks of Faces, so that memory use does
+		// not depend on the size of the Mesh
+		for (int n = 0; n < vecBlockSizes.size(); n++) {
+			const int nBlockSize = vecBlockSizes[n];
+			const int nChunkFaces =
+				std::max(1, static_cast<int>(
+					DefaultNcChunkBytes / (sizeof(int) * nBlockSize)));
+
+			DataArray2D<int> nConnect(nChunkFaces, nBlockSize);
+			DataArray2D<int> nEdgeType(nChunkFaces, nBlockSize);
+			DataArray1D<int> nGlobalId(nChunkFaces);
+			DataArray1D<int> nFaceParentA;
+			DataArray1D<int> nFaceParentB;
+			if (vecSourceFaceIx.size() != 0) {
+				nFaceParentA.Allocate(nChunkFaces);
 			}
-			if (iBlock == vecBlockSizes.size()) {
-				_EXCEPTIONT("Logic error");
+			if (vecTargetFaceIx.size() != 0) {
+				nFaceParentB.Allocate(nChunkFaces);
 			}
 
-			int iLocal = vecConnectCount[iBlock];
-			for (int k = 0; k < faces[i].edges.size(); k++) {
-				vecConnect[iBlock][iLocal][k] = faces[i][k] + 1;
+			// Number of Faces in the current chunk and index of its first
+			// Face within the block
+			int nCount = 0;
+			int ixChunkBegin = 0;
 
-				vecEdgeType[iBlock][iLocal][k] =
-					static_cast<int>(faces[i].edges[k].type);
-			}
+			for (int i = 0; i <= nElementCount; i++) {
+				if ((i < nElementCount) && (faces[i].edges.size() != nBlockSize)) {
+					continue;
+				}
 
-			vecGlobalId[iBlock][iLocal] = i + 1;
+				if (i < nElementCount) {
+					for (int k = 0; k < nBlockSize; k++) {
+						nConnect[nCount][k] = faces[i][k] + 1;
+						nEdgeType[nCount][k] =
+							static_cast<int>(faces[i].edges[k].type);
+					}
 
-			if (vecSourceFaceIx.size() != 0) {
-				vecFaceParentA[iBlock][iLocal] = vecSourceFaceIx[i] + 1;
-			}
-			if (vecTargetFaceIx.size() != 0) {
-				vecFaceParentB[iBlock][iLocal] = vecTargetFaceIx[i] + 1;
-			}
+					nGlobalId[nCount] = i + 1;
 
-			vecConnectCount[iBlock]++;
-		}
+					if (vecSourceFaceIx.size() != 0) {
+						nFaceParentA[nCount] = vecSourceFaceIx[i] + 1;
+					}
+					if (vecTargetFaceIx.size() != 0) {
+						nFaceParentB[nCount] = vecTargetFaceIx[i] + 1;
+					}
 
-		// Write data to NetCDF file
-		for (int n = 0; n < vecBlockSizes.size(); n++) {
-			vecConnectVar[n]->set_cur(0, 0);
-			vecConnectVar[n]->put(
-				&(vecConnect[n][0][0]),
-				vecBlockSizeFaces[n],
-				vecBlockSizes[n]);
-
-			vecGlobalIdVar[n]->set_cur((long)0);
-			vecGlobalIdVar[n]->put(
-				&(vecGlobalId[n][0]),
-				vecBlockSizeFaces[n]);
-
-			vecEdgeTypeVar[n]->set_cur(0, 0);
-			vecEdgeTypeVar[n]->put(
-				&(vecEdgeType[n][0][0]),
-				vecBlockSizeFaces[n],
-				vecBlockSizes[n]);
+					nCount++;
+				}
 
-			if (vecSourceFaceIx.size() != 0) {
-				vecFaceParentAVar[n]->set_cur((long)0);
-				vecFaceParentAVar[n]->put(
-					&(vecFaceParentA[n][0]),
-					vecBlockSizeFaces[n]);
+				// Write a full chunk, or the remainder after the last Face
+				if ((nCount == nChunkFaces) ||
+				    ((i == nElementCount) && (nCount != 0))
+				) {
+					vecConnectVar[n]->set_cur(ixChunkBegin, 0);
+					vecConnectVar[n]->put(
+						&(nConnect[0][0]), nCount, nBlockSize);
+
+					vecGlobalIdVar[n]->set_cur((long)ixChunkBegin);
+					vecGlobalIdVar[n]->put(&(nGlobalId[0]), nCount);
+
+					vecEdgeTypeVar[n]->set_cur(ixChunkBegin, 0);
+					vecEdgeTypeVar[n]->put(
+						&(nEdgeType[0][0]), nCount, nBlockSize);
+
+					if (vecSourceFaceIx.size() != 0) {
+						vecFaceParentAVar[n]->set_cur((long)ixChunkBegin);
+						vecFaceParentAVar[n]->put(&(nFaceParentA[0]), nCount);
+					}
+					if (vecTargetFaceIx.size() != 0) {
+						vecFaceParentBVar[n]->set_cur((long)ixChunkBegin);
+						vecFaceParentBVar[n]->put(&(nFaceParentB[0]), nCount);
+					}
+
+					ixChunkBegin += nCount;
+					nCount = 0;
+				}
 			}
 
-			if (vecTargetFaceIx.size() != 0) {
-				vecFaceParentBVar[n]->set_cur((long)0);
-				vecFaceParentBVar[n]->put(
-					&(vecFaceParentB[n][0]),
-					vecBlockSizeFaces[n]);
+			if (ixChunkBegin != vecBlockSizeFaces[n]) {
+				_EXCEPTIONT("Logic error");
 			}
 		}
 	}
 
-	// Node list
+	// Node list, in chunks of Nodes
 	{
-		NcVar * varNodes =
-			ncOut.add_var("coord", ncDouble, dimDimension, dimNodes);
+		NcVar * varNodes = vars.varNodes;
 
-		if (varNodes == NULL) {
-			_EXCEPTIONT("Error creating variable \"coord\"");
-		}
+		const int nChunkNodes =
+			std::min(nNodeCount,
+				static_cast<int>(DefaultNcChunkBytes / sizeof(double)));
 
-		DataArray1D<double> dCoord(nNodeCount);
+		DataArray1D<double> dCoord(nChunkNodes);
 
-		for (int i = 0; i < nNodeCount; i++) {
-			dCoord[i] = static_cast<double>(nodes[i].x);
-		}
-		varNodes->set_cur(0, 0);
-		varNodes->put(dCoord, 1, nNodeCount);
-		for (int i = 0; i < nNodeCount; i++) {
-			dCoord[i] = static_cast<double>(nodes[i].y);
-		}
-		varNodes->set_cur(1, 0);
-		varNodes->put(dCoord, 1, nNodeCount);
-		for (int i = 0; i < nNodeCount; i++) {
-			dCoord[i] = static_cast<double>(nodes[i].z);
+		for (int ixBegin = 0; ixBegin < nNodeCount; ixBegin += nChunkNodes) {
+			const int nCount = std::min(nChunkNodes, nNodeCount - ixBegin);
+
+			for (int d = 0; d < 3; d++) {
+				for (int i = 0; i < nCount; i++) {
+					const Node & node = nodes[ixBegin + i];
+					dCoord[i] = static_cast<double>(
+						(d == 0)?(node.x):((d == 1)?(node.y):(node.z)));
+				}
+				varNodes->set_cur(d, ixBegin);
+				varNodes->put(dCoord, 1, nCount);
+			}
 		}
-		varNodes->set_cur(2, 0);
-		varNodes->put(dCoord, 1, nNodeCount);
 	}
 
 	// Grid dimensions
@@ -792,6 +1961,169 @@ void Mesh::Write(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void ExodusMeshWriter::Open(
+	const std::string & strFile,
+	int nNodes,
+	int nFaces,
+	int nNodesPerFace,
+	NcFile::FileFormat eFileFormat
+) {
+	Close();
+
+	std::vector<int> vecBlockSizes(1, nNodesPerFace);
+	std::vector<int> vecBlockSizeFaces(1, nFaces);
+
+	eFileFormat =
+		GetExodusFileFormat(
+			eFileFormat, nNodes, vecBlockSizes, vecBlockSizeFaces);
+
+	m_pncOut = new NcFile(strFile.c_str(), NcFile::Replace, NULL, 0, eFileFormat);
+	if (!m_pncOut->is_valid()) {
+		delete m_pncOut;
+		m_pncOut = NULL;
+		_EXCEPTION1("Unable to open grid file \"%s\" for writing",
+			strFile.c_str());
+	}
+
+	m_nNodes = nNodes;
+	m_nFaces = nFaces;
+	m_nNodesPerFace = nNodesPerFace;
+
+	ExodusHeaderVars vars;
+	WriteExodusHeader(
+		*m_pncOut, strFile, nNodes, vecBlockSizes, vecBlockSizeFaces, vars);
+
+	m_varNodes = vars.varNodes;
+	m_varConnect = vars.vecConnectVar[0];
+	m_varGlobalId = vars.vecGlobalIdVar[0];
+	m_varEdgeType = vars.vecEdgeTypeVar[0];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ExodusMeshWriter::WriteNodes(
+	int ixBegin,
+	const NodeVector & nodes
+) {
+	if (m_pncOut == NULL) {
+		_EXCEPTIONT("ExodusMeshWriter is not open");
+	}
+
+	const int nNodes = static_cast<int>(nodes.size());
+	if ((ixBegin < 0) || (ixBegin + nNodes > m_nNodes)) {
+		_EXCEPTION3("Node range [%i, %i) out of bounds (%i)",
+			ixBegin, ixBegin + nNodes, m_nNodes);
+	}
+	if (nNodes == 0) {
+		return;
+	}
+
+	DataArray1D<double> dCoord(nNodes);
+
+	for (int d = 0; d < 3; d++) {
+		for (int i = 0; i < nNodes; i++) {
+			dCoord[i] = static_cast<double>(
+				(d == 0)?(nodes[i].x):((d == 1)?(nodes[i].y):(nodes[i].z)));
+		}
+		m_varNodes->set_cur(d, ixBegin);
+		if (!m_varNodes->put(dCoord, 1, nNodes)) {
+			_EXCEPTIONT("Error writing variable \"coord\"");
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ExodusMeshWriter::WriteFaces(
+	int ixBegin,
+	const FaceVector & faces
+) {
+	WriteFaces(ixBegin, PackedFaceVector(faces));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ExodusMeshWriter::WriteFaces(
+	int ixBegin,
+	const PackedFaceVector & faces
+) {
+	if (m_pncOut == NULL) {
+		_EXCEPTIONT("ExodusMeshWriter is not open");
+	}
+
+	const int nFaces = static_cast<int>(faces.size());
+	if ((ixBegin < 0) || (ixBegin + nFaces > m_nFaces)) {
+		_EXCEPTION3("Face range [%i, %i) out of bounds (%i)",
+			ixBegin, ixBegin + nFaces, m_nFaces);
+	}
+	if (nFaces == 0) {
+		return;
+	}
+
+	if (faces.GetUniformDegree() != m_nNodesPerFace) {
+		for (int i = 0; i < nFaces; i++) {
+			if (faces.GetDegree(i) != m_nNodesPerFace) {
+				_EXCEPTION2("Face %i has %i nodes",
+					ixBegin + i, faces.GetDegree(i));
+			}
+		}
+	}
+
+	DataArray2D<int> nConnect(nFaces, m_nNodesPerFace);
+	DataArray2D<int> nEdgeType(nFaces, m_nNodesPerFace);
+	DataArray1D<int> nGlobalId(nFaces);
+
+	// Node indices of uniform Faces are contiguous
+	const int * pNodes = faces.GetNodes(0);
+	const size_t sConnect = nConnect.GetTotalSize();
+	for (size_t i = 0; i < sConnect; i++) {
+		(&(nConnect[0][0]))[i] = pNodes[i] + 1;
+	}
+
+	if (!faces.HasOnlyGreatCircleArcs()) {
+		for (int i = 0; i < nFaces; i++) {
+			for (int k = 0; k < m_nNodesPerFace; k++) {
+				nEdgeType[i][k] = static_cast<int>(faces.GetEdgeType(i, k));
+			}
+		}
+	}
+
+	for (int i = 0; i < nFaces; i++) {
+		nGlobalId[i] = ixBegin + i + 1;
+	}
+
+	m_varConnect->set_cur(ixBegin, 0);
+	if (!m_varConnect->put(&(nConnect[0][0]), nFaces, m_nNodesPerFace)) {
+		_EXCEPTIONT("Error writing variable \"connect1\"");
+	}
+
+	m_varGlobalId->set_cur((long)ixBegin);
+	if (!m_varGlobalId->put(&(nGlobalId[0]), nFaces)) {
+		_EXCEPTIONT("Error writing variable \"global_id1\"");
+	}
+
+	m_varEdgeType->set_cur(ixBegin, 0);
+	if (!m_varEdgeType->put(&(nEdgeType[0][0]), nFaces, m_nNodesPerFace)) {
+		_EXCEPTIONT("Error writing variable \"edge_type1\"");
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ExodusMeshWriter::Close() {
+	if (m_pncOut != NULL) {
+		m_pncOut->close();
+		delete m_pncOut;
+		m_pncOut = NULL;
+	}
+	m_varNodes = NULL;
+	m_varConnect = NULL;
+	m_varGlobalId = NULL;
+	m_varEdgeType = NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void Mesh::WriteScrip(
 	const std::string & strFile,
 	NcFile::FileFormat eFileFormat
@@ -839,13 +2171,6 @@ void Mesh::WriteScrip(
 		AnnounceEndBlock(NULL);
 	}
 
-	// Output to a NetCDF SCRIP file
-	NcFile ncOut(strFile.c_str(), NcFile::Replace, NULL, 0, eFileFormat);
-	if (!ncOut.is_valid()) {
-		_EXCEPTION1("Unable to open grid file \"%s\" for writing",
-			strFile.c_str());
-	}
-
 	// Find max number of corners oer all faces
 	int nElementCount = faces.size();
 	int nCornersMax = 0;
@@ -853,8 +2178,48 @@ void Mesh::WriteScrip(
 		nCornersMax = std::max( nCornersMax, (int)(faces[i].edges.size()) );
 	}
 
+	// Output to a NetCDF SCRIP file in chunks of Faces, so that the
+	// coordinate arrays do not depend on the size of the Mesh
+	const int nChunkFaces = 65536;
+
+	ScripMeshWriter writer;
+	writer.Open(strFile, nElementCount, nCornersMax, vecGridDimSize, eFileFormat);
+	for (int ixBegin = 0; ixBegin < nElementCount; ixBegin += nChunkFaces) {
+		writer.WriteFaces(
+			ixBegin,
+			&(faces[ixBegin]),
+			std::min(nChunkFaces, nElementCount - ixBegin),
+			nodes);
+	}
+	writer.Close();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ScripMeshWriter::Open(
+	const std::string & strFile,
+	int nFaces,
+	int nCornersMax,
+	const std::vector<int> & vecGridDimSize,
+	NcFile::FileFormat eFileFormat
+) {
+	Close();
+
+	m_pncOut = new NcFile(strFile.c_str(), NcFile::Replace, NULL, 0, eFileFormat);
+	if (!m_pncOut->is_valid()) {
+		delete m_pncOut;
+		m_pncOut = NULL;
+		_EXCEPTION1("Unable to open grid file \"%s\" for writing",
+			strFile.c_str());
+	}
+
+	NcFile & ncOut = *m_pncOut;
+
+	m_nFaces = nFaces;
+	m_nCornersMax = nCornersMax;
+
 	// SCRIP dimensions
-	NcDim * dimGridSize   = ncOut.add_dim("grid_size", nElementCount);
+	NcDim * dimGridSize   = ncOut.add_dim("grid_size", nFaces);
 	NcDim * dimGridCorner = ncOut.add_dim("grid_corners", nCornersMax);
 
 	NcDim * dimGridRank;
@@ -871,156 +2236,242 @@ void Mesh::WriteScrip(
 	ncOut.add_att("file_size", 0);
 
 	// Grid Area
+	m_varArea = ncOut.add_var("grid_area", ncDouble, dimGridSize);
+	if (m_varArea == NULL) {
+		_EXCEPTIONT("Error creating variable \"grid_area\"");
+	}
+	SetNcVarChunking(ncOut, m_varArea);
+	m_varArea->add_att("units", "radians^2");
+
+	// Grid center and corner coordinates
+	m_varCenterLat = ncOut.add_var("grid_center_lat", ncDouble, dimGridSize);
+	m_varCenterLon = ncOut.add_var("grid_center_lon", ncDouble, dimGridSize);
+	m_varCornerLat = ncOut.add_var("grid_corner_lat", ncDouble, dimGridSize, dimGridCorner);
+	m_varCornerLon = ncOut.add_var("grid_corner_lon", ncDouble, dimGridSize, dimGridCorner);
+	if (m_varCenterLat == NULL) {
+		_EXCEPTIONT("Error creating variable \"grid_center_lat\"");
+	}
+	if (m_varCenterLon == NULL) {
+		_EXCEPTIONT("Error creating variable \"grid_center_lon\"");
+	}
+	if (m_varCornerLat == NULL) {
+		_EXCEPTIONT("Error creating variable \"grid_corner_lat\"");
+	}
+	if (m_varCornerLon == NULL) {
+		_EXCEPTIONT("Error creating variable \"grid_corner_lon\"");
+	}
+	SetNcVarChunking(ncOut, m_varCenterLat);
+	SetNcVarChunking(ncOut, m_varCenterLon);
+	SetNcVarChunking(ncOut, m_varCornerLat);
+	SetNcVarChunking(ncOut, m_varCornerLon);
+
+	m_varCenterLat->add_att("_FillValue", 9.96920996838687e+36 );
+	m_varCenterLon->add_att("_FillValue", 9.96920996838687e+36 );
+	m_varCornerLat->add_att("_FillValue", 9.96920996838687e+36 );
+	m_varCornerLon->add_att("_FillValue", 9.96920996838687e+36 );
+
+	m_varCenterLat->add_att("units", "degrees");
+	m_varCenterLon->add_att("units", "degrees");
+	m_varCornerLat->add_att("units", "degrees");
+	m_varCornerLon->add_att("units", "degrees");
+
+	// Grid mask
+	m_varMask = ncOut.add_var("grid_imask", ncInt, dimGridSize);
+	if (m_varMask == NULL) {
+		_EXCEPTIONT("Error creating variable \"grid_imask\"");
+	}
+	SetNcVarChunking(ncOut, m_varMask);
+
+	// Grid dims
 	{
-		NcVar * varArea = ncOut.add_var("grid_area", ncDouble, dimGridSize);
-		if (varArea == NULL) {
-			_EXCEPTIONT("Error creating variable \"grid_area\"");
+		NcVar * varDims = ncOut.add_var("grid_dims", ncInt, dimGridRank);
+		if (varDims == NULL) {
+			_EXCEPTIONT("Error creating variable \"grid_dims\"");
+		}
+		if (vecGridDimSize.size() <= 1) {
+			int nSize = nFaces;
+			varDims->set_cur((long)0);
+			varDims->put(&nSize, 1);
+		} else {
+			varDims->set_cur((long)0);
+			int nGridDimSize[2];
+			nGridDimSize[0] = vecGridDimSize[1];
+			nGridDimSize[1] = vecGridDimSize[0];
+			varDims->put(&(nGridDimSize[0]), (long)vecGridDimSize.size());
 		}
-		DataArray1D<double> area(nElementCount);
-		for (int i = 0; i < nElementCount; i++) {
-			area[i] = static_cast<double>( CalculateFaceArea(faces[i], nodes) );
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ScripMeshWriter::WriteFaces(
+	int ixBegin,
+	const FaceVector & faces,
+	const NodeVector & nodes
+) {
+	WriteFaces(
+		ixBegin,
+		(faces.size() == 0)?(NULL):(&(faces[0])),
+		static_cast<int>(faces.size()),
+		nodes);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ScripMeshWriter::WriteFaces(
+	int ixBegin,
+	const Face * pFaces,
+	int nFaces,
+	const NodeVector & nodes
+) {
+	if (m_pncOut == NULL) {
+		_EXCEPTIONT("ScripMeshWriter is not open");
+	}
+
+	const int nElementCount = nFaces;
+	if ((ixBegin < 0) || (ixBegin + nElementCount > m_nFaces)) {
+		_EXCEPTION3("Face range [%i, %i) out of bounds (%i)",
+			ixBegin, ixBegin + nElementCount, m_nFaces);
+	}
+	if (nElementCount == 0) {
+		return;
+	}
+
+	const int nCornersMax = m_nCornersMax;
+
+	for (int i = 0; i < nElementCount; i++) {
+		if (pFaces[i].edges.size() > nCornersMax) {
+			_EXCEPTION2("Face %i has more than %i corners",
+				ixBegin + i, nCornersMax);
 		}
-		varArea->set_cur((long)0);
-		varArea->put(area, nElementCount);
-		varArea->add_att("units", "radians^2");
 	}
 
-	// Grid center and corner coordinates
-	{
-		NcVar * varCenterLat = ncOut.add_var("grid_center_lat", ncDouble, dimGridSize);
-		NcVar * varCenterLon = ncOut.add_var("grid_center_lon", ncDouble, dimGridSize);
-		NcVar * varCornerLat = ncOut.add_var("grid_corner_lat", ncDouble, dimGridSize, dimGridCorner);
-		NcVar * varCornerLon = ncOut.add_var("grid_corner_lon", ncDouble, dimGridSize, dimGridCorner);
-		if (varCenterLat == NULL) {
-			_EXCEPTIONT("Error creating variable \"grid_center_lat\"");
-		}
-		if (varCenterLon == NULL) {
-			_EXCEPTIONT("Error creating variable \"grid_center_lon\"");
-		}
-		if (varCornerLat == NULL) {
-			_EXCEPTIONT("Error creating variable \"grid_corner_lat\"");
-		}
-		if (varCornerLon == NULL) {
-			_EXCEPTIONT("Error creating variable \"grid_corner_lon\"");
-		}
+	DataArray1D<double> area(nElementCount);
+	DataArray1D<double> centerLat(nElementCount);
+	DataArray1D<double> centerLon(nElementCount);
+	DataArray2D<double> cornerLat(nElementCount, nCornersMax);
+	DataArray2D<double> cornerLon(nElementCount, nCornersMax);
+	DataArray1D<int> mask(nElementCount);
+
+	// Gather corners and centers in Cartesian coordinates
+	DataArray2D<double> cornerX(nElementCount, nCornersMax);
+	DataArray2D<double> cornerY(nElementCount, nCornersMax);
+	DataArray2D<double> cornerZ(nElementCount, nCornersMax);
+
+	DataArray1D<double> centerX(nElementCount);
+	DataArray1D<double> centerY(nElementCount);
+	DataArray1D<double> centerZ(nElementCount);
+
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < nElementCount; i++) {
+		area[i] = static_cast<double>( CalculateFaceArea(pFaces[i], nodes) );
 
-		DataArray1D<double> centerLat(nElementCount);
-		DataArray1D<double> centerLon(nElementCount);
-		DataArray2D<double> cornerLat(nElementCount, nCornersMax);
-		DataArray2D<double> cornerLon(nElementCount, nCornersMax);
 		Node corner(0,0,0);
-		for (int i = 0; i < nElementCount; i++) {
-			Node center(0,0,0);
-
-			// int nCorners = faces[i].edges.size()+1;
-			int nCorners = faces[i].edges.size();
-			for (int j = 0; j < nCorners; j++) {
-				corner = nodes[ faces[i][j] ];
-				XYZtoRLL_Deg(
-					corner.x, corner.y, corner.z,
-					cornerLon[i][j],
-					cornerLat[i][j]);
+		Node center(0,0,0);
+
+		// int nCorners = faces[i].edges.size()+1;
+		int nCorners = pFaces[i].edges.size();
+		for (int j = 0; j < nCornersMax; j++) {
+			corner = nodes[ pFaces[i][std::min(j, nCorners-1)] ];
+			cornerX[i][j] = corner.x;
+			cornerY[i][j] = corner.y;
+			cornerZ[i][j] = corner.z;
+			if (j < nCorners) {
 				center = center + corner;
 			}
+		}
 
-			center = center / nCorners;
+		center = center / nCorners;
 
-			double dMag = sqrt(center.x * center.x + 
-							   center.y * center.y + 
-							   center.z * center.z);
-			center.x /= dMag;
-			center.y /= dMag;
-			center.z /= dMag;
+		double dMag = sqrt(center.x * center.x + 
+						   center.y * center.y + 
+						   center.z * center.z);
+		centerX[i] = center.x / dMag;
+		centerY[i] = center.y / dMag;
+		centerZ[i] = center.z / dMag;
+	}
 
-			XYZtoRLL_Deg(
-				center.x, center.y, center.z,
-				centerLon[i],
-				centerLat[i]);
+	// Convert to latitude and longitude in batches
+	int nInvalid =
+		XYZtoRLL_Deg_Batch(
+			nElementCount * nCornersMax,
+			&(cornerX[0][0]), &(cornerY[0][0]), &(cornerZ[0][0]),
+			&(cornerLon[0][0]), &(cornerLat[0][0]))
+		+ XYZtoRLL_Deg_Batch(
+			nElementCount,
+			&(centerX[0]), &(centerY[0]), &(centerZ[0]),
+			&(centerLon[0]), &(centerLat[0]));
+
+	if (nInvalid != 0) {
+		_EXCEPTION1("Mesh contains %i points with non-unit magnitude",
+			nInvalid);
+	}
 
-			// Adjust corner logitudes
-			double lonDiff;
-			for (int j = 0; j < nCorners; j++) {
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < nElementCount; i++) {
+		int nCorners = pFaces[i].edges.size();
 
-				// First check for polar point
-				if (cornerLat[i][j]==90. || cornerLat[i][j]==-90.) {
-					cornerLon[i][j] = centerLon[i];
-				}
+		// Adjust corner logitudes
+		double lonDiff;
+		for (int j = 0; j < nCorners; j++) {
 
-				// Next check for corners that wrap around prime meridian
-				lonDiff = centerLon[i] - cornerLon[i][j];
-				if (lonDiff>180) {
-					cornerLon[i][j] = cornerLon[i][j] + (double)360.0;
-				}
+			// First check for polar point
+			if (cornerLat[i][j]==90. || cornerLat[i][j]==-90.) {
+				cornerLon[i][j] = centerLon[i];
+			}
 
-				if (lonDiff<-180) {
-					cornerLon[i][j] = cornerLon[i][j] - (double)360.0;
-				}
+			// Next check for corners that wrap around prime meridian
+			lonDiff = centerLon[i] - cornerLon[i][j];
+			if (lonDiff>180) {
+				cornerLon[i][j] = cornerLon[i][j] + (double)360.0;
 			}
-			// Make sure the padded coordinate data is same as last vertex
-			for (int j = nCorners; j < nCornersMax; j++) {
-				cornerLon[i][j] = cornerLon[i][nCorners-1];
-				cornerLat[i][j] = cornerLat[i][nCorners-1];
+
+			if (lonDiff<-180) {
+				cornerLon[i][j] = cornerLon[i][j] - (double)360.0;
 			}
 		}
+		// Make sure the padded coordinate data is same as last vertex
+		for (int j = nCorners; j < nCornersMax; j++) {
+			cornerLon[i][j] = cornerLon[i][nCorners-1];
+			cornerLat[i][j] = cornerLat[i][nCorners-1];
+		}
 
-		varCenterLat->add_att("_FillValue", 9.96920996838687e+36 );
-		varCenterLon->add_att("_FillValue", 9.96920996838687e+36 );
-		varCornerLat->add_att("_FillValue", 9.96920996838687e+36 );
-		varCornerLon->add_att("_FillValue", 9.96920996838687e+36 );
+		mask[i] = ( 1 );
+	}
 
-		varCenterLat->set_cur((long)0);
-		varCenterLat->put(centerLat, nElementCount);
-		varCenterLat->add_att("units", "degrees");
+	m_varArea->set_cur((long)ixBegin);
+	m_varArea->put(area, nElementCount);
 
-		varCenterLon->set_cur((long)0);
-		varCenterLon->put(centerLon, nElementCount);
-		varCenterLon->add_att("units", "degrees");
+	m_varCenterLat->set_cur((long)ixBegin);
+	m_varCenterLat->put(centerLat, nElementCount);
 
+	m_varCenterLon->set_cur((long)ixBegin);
+	m_varCenterLon->put(centerLon, nElementCount);
 
-		for (int i=0; i<nElementCount; i++) {
-			varCornerLat->set_cur(i,0);
-			varCornerLat->put(cornerLat[i], 1, nCornersMax);
-			varCornerLon->set_cur(i,0);
-			varCornerLon->put(cornerLon[i], 1, nCornersMax);
-		}
-		varCornerLat->add_att("units", "degrees");
-		varCornerLon->add_att("units", "degrees");
-	}
+	m_varCornerLat->set_cur(ixBegin, 0);
+	m_varCornerLat->put(&(cornerLat[0][0]), nElementCount, nCornersMax);
 
-	// Grid mask
-	{
-		NcVar * varMask = ncOut.add_var("grid_imask", ncInt, dimGridSize);
-		if (varMask == NULL) {
-			_EXCEPTIONT("Error creating variable \"grid_imask\"");
-		}
-		// varMask->add_att("_FillValue", 9.96920996838687e+36 );
-		DataArray1D<int> mask(nElementCount);
-		for (int i = 0; i < nElementCount; i++) {
-			mask[i] = ( 1 );
-		}
-		varMask->set_cur((long)0);
-		varMask->put(mask, nElementCount);
+	m_varCornerLon->set_cur(ixBegin, 0);
+	m_varCornerLon->put(&(cornerLon[0][0]), nElementCount, nCornersMax);
 
-	}
+	m_varMask->set_cur((long)ixBegin);
+	m_varMask->put(mask, nElementCount);
+}
 
-	// Grid dims
-	{
-		NcVar * varDims = ncOut.add_var("grid_dims", ncInt, dimGridRank);
-		if (varDims == NULL) {
-			_EXCEPTIONT("Error creating variable \"grid_dims\"");
-		}
-		if (vecGridDimSize.size() <= 1) {
-			int nSize = faces.size();
-			varDims->set_cur((long)0);
-			varDims->put(&nSize, 1);
-		} else {
-			varDims->set_cur((long)0);
-			int nGridDimSize[2];
-			nGridDimSize[0] = vecGridDimSize[1];
-			nGridDimSize[1] = vecGridDimSize[0];
-			varDims->put(&(nGridDimSize[0]), (long)vecGridDimSize.size());
-		}
+///////////////////////////////////////////////////////////////////////////////
+
+void ScripMeshWriter::Close() {
+	if (m_pncOut != NULL) {
+		m_pncOut->close();
+		delete m_pncOut;
+		m_pncOut = NULL;
 	}
+	m_varArea = NULL;
+	m_varCenterLat = NULL;
+	m_varCenterLon = NULL;
+	m_varCornerLat = NULL;
+	m_varCornerLon = NULL;
+	m_varMask = NULL;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -1047,16 +2498,12 @@ void Mesh::WriteUGRID(
 		nCornersMax = std::max( nCornersMax, (int)(faces[i].edges.size()) );
 	}
 
-	// Generate face nodes array
-	DataArray2D<int> nFaceNodes(faces.size(), nCornersMax);
-	for (int i = 0; i < faces.size(); i++) {
-		for (int j = 0; j < faces[i].edges.size(); j++) {
-			nFaceNodes(i,j) = faces[i][j];
-		}
-		for (int j = faces[i].edges.size(); j < nCornersMax; j++) {
-			nFaceNodes(i,j) = -1;
-		}
-	}
+	// Faces and nodes are written in chunks, so that memory use does not
+	// depend on the size of the Mesh
+	const int nChunkSize = 65536;
+
+	const int nFaceCount = faces.size();
+	const int nNodeCount = nodes.size();
 
 	// Number of nodes
 	NcDim * dimNodes = ncOut.add_dim("nMesh2_node", nodes.size());
@@ -1075,36 +2522,91 @@ void Mesh::WriteUGRID(
 
 	// Face nodes
 	NcVar * varFaceNodes = ncOut.add_var("Mesh2_face_nodes", ncInt, dimFaces, dimMaxNodesPerFace);
+	SetNcVarChunking(ncOut, varFaceNodes);
 	varFaceNodes->add_att("cf_role", "face_node_connectivity");
 	varFaceNodes->add_att("_FillValue", -1);
 	varFaceNodes->add_att("start_index", 0);
-	varFaceNodes->put(&(nFaceNodes(0,0)), faces.size(), nCornersMax);
 
-	// Mesh node coordinates
-	DataArray1D<double> dNodeLon(nodes.size());
-	DataArray1D<double> dNodeLat(nodes.size());
+	{
+		DataArray2D<int> nFaceNodes(
+			std::min(nChunkSize, nFaceCount), nCornersMax);
+
+		for (int ixBegin = 0; ixBegin < nFaceCount; ixBegin += nChunkSize) {
+			const int nCount = std::min(nChunkSize, nFaceCount - ixBegin);
 
-	for (int i = 0; i < nodes.size(); i++) {
-		XYZtoRLL_Deg(nodes[i].x, nodes[i].y, nodes[i].z, dNodeLon[i], dNodeLat[i]);
+#pragma omp parallel for schedule(static)
+			for (int i = 0; i < nCount; i++) {
+				const Face & face = faces[ixBegin + i];
+				for (int j = 0; j < face.edges.size(); j++) {
+					nFaceNodes(i,j) = face[j];
+				}
+				for (int j = face.edges.size(); j < nCornersMax; j++) {
+					nFaceNodes(i,j) = -1;
+				}
+			}
+
+			varFaceNodes->set_cur(ixBegin, 0);
+			varFaceNodes->put(&(nFaceNodes(0,0)), nCount, nCornersMax);
+		}
 	}
 
+	// Mesh node coordinates
 	NcVar * varNodeX = ncOut.add_var("Mesh2_node_x", ncDouble, dimNodes);
+	SetNcVarChunking(ncOut, varNodeX);
 	varNodeX->add_att("standard_name", "longitude");
 	varNodeX->add_att("long_name", "longitude of 2D mesh nodes");
 	varNodeX->add_att("units", "degrees_east");
-	varNodeX->put(&(dNodeLon[0]), nodes.size());
 
 	NcVar * varNodeY = ncOut.add_var("Mesh2_node_y", ncDouble, dimNodes);
+	SetNcVarChunking(ncOut, varNodeY);
 	varNodeY->add_att("standard_name", "latitude");
 	varNodeY->add_att("long_name", "latitude of 2D mesh nodes");
 	varNodeY->add_att("units", "degrees_north");
-	varNodeY->put(&(dNodeLat[0]), nodes.size());
+
+	{
+		const int nChunkNodes = std::min(nChunkSize, nNodeCount);
+
+		DataArray1D<double> dNodeX(nChunkNodes);
+		DataArray1D<double> dNodeY(nChunkNodes);
+		DataArray1D<double> dNodeZ(nChunkNodes);
+		DataArray1D<double> dNodeLon(nChunkNodes);
+		DataArray1D<double> dNodeLat(nChunkNodes);
+
+		for (int ixBegin = 0; ixBegin < nNodeCount; ixBegin += nChunkNodes) {
+			const int nCount = std::min(nChunkNodes, nNodeCount - ixBegin);
+
+#pragma omp parallel for schedule(static)
+			for (int i = 0; i < nCount; i++) {
+				const Node & node = nodes[ixBegin + i];
+				dNodeX[i] = static_cast<double>(node.x);
+				dNodeY[i] = static_cast<double>(node.y);
+				dNodeZ[i] = static_cast<double>(node.z);
+			}
+
+			int nInvalid = XYZtoRLL_Deg_Batch(
+				nCount,
+				&(dNodeX[0]), &(dNodeY[0]), &(dNodeZ[0]),
+				&(dNodeLon[0]), &(dNodeLat[0]));
+
+			if (nInvalid != 0) {
+				_EXCEPTION1("Mesh contains %i nodes with non-unit magnitude",
+					nInvalid);
+			}
+
+			varNodeX->set_cur((long)ixBegin);
+			varNodeX->put(&(dNodeLon[0]), nCount);
+
+			varNodeY->set_cur((long)ixBegin);
+			varNodeY->put(&(dNodeLat[0]), nCount);
+		}
+	}
 
 	// Mask
 	if (vecMask.size() == faces.size()) {
 		varMesh2->add_att("face_mask", "Mesh2_face_mask");
 
 		NcVar * varIMask = ncOut.add_var("Mesh2_face_mask", ncInt, dimFaces);
+		SetNcVarChunking(ncOut, varIMask);
 		varIMask->add_att("standard_name", "mask");
 		varIMask->add_att("long_name", "integer mask of faces");
 		varIMask->add_att("units", "none");
@@ -1122,10 +2624,18 @@ void Mesh::Read(const std::string & strFile) {
 	// Store the file name
 	strFileName = strFile;
 
-	// Open the NetCDF file
 	if (strFile == "") {
 		_EXCEPTIONT("No grid file specified for reading");
 	}
+
+	// Native binary mesh cache files are memory mapped rather than decoded
+	if (IsCacheFile(strFile)) {
+		Announce("Mesh cache file detected");
+		ReadCache(strFile);
+		return;
+	}
+
+	// Open the NetCDF file
 	NcFile ncFile(strFile.c_str(), NcFile::ReadOnly);
 	if (!ncFile.is_valid()) {
 		_EXCEPTION1("Unable to open grid file \"%s\" for reading",
@@ -1226,12 +2736,14 @@ void Mesh::Read(const std::string & strFile) {
 			varMask->get(&(vecMask[0]), nGridSize);
 		}
 
-		// Current global node index
-		int ixNode = 0;
-
+		// Create Faces and insert Face corners into node table; corner j
+		// of cell i is node (i * nGridCorners + j)
+#pragma omp parallel for schedule(static)
 		for (int i = 0; i < nGridSize; i++) {
 
 			// Create a new Face
+			const int ixNode = i * nGridCorners;
+
 			Face faceNew(nGridCorners);
 			for (int j = 0; j < nGridCorners; j++) {
 				faceNew.SetNode(j, ixNode + j);
@@ -1257,11 +2769,9 @@ void Mesh::Read(const std::string & strFile) {
 					dLat = -0.5 * M_PI;
 				}
 
-				nodes[ixNode].x = cos(dLon) * cos(dLat);
-				nodes[ixNode].y = sin(dLon) * cos(dLat);
-				nodes[ixNode].z = sin(dLat);
-
-				ixNode++;
+				nodes[ixNode + j].x = cos(dLon) * cos(dLat);
+				nodes[ixNode + j].y = sin(dLon) * cos(dLat);
+				nodes[ixNode + j].z = sin(dLat);
 			}
 		}
 
@@ -1591,19 +3101,627 @@ void Mesh::Read(const std::string & strFile) {
 			vecGridDimSize.resize(2);
 			vecGridDimName.resize(2);
 
-			vecGridDimSize[0] = attDim0Size->as_int(0);
-			vecGridDimSize[1] = attDim1Size->as_int(0);
-			vecGridDimName[0] = attDim0Name->as_string(0);
-			vecGridDimName[1] = attDim1Name->as_string(0);
+			vecGridDimSize[0] = attDim0Size->as_int(0);
+			vecGridDimSize[1] = attDim1Size->as_int(0);
+			vecGridDimName[0] = attDim0Name->as_string(0);
+			vecGridDimName[1] = attDim1Name->as_string(0);
+
+			if (vecGridDimSize[0] * vecGridDimSize[1] != faces.size()) {
+				_EXCEPTION4("Exodus grid file \"%s\" grid_dims (%i,%i) do not agree with grid_size (%i)",
+					strFile.c_str(), vecGridDimSize[0], vecGridDimSize[1], faces.size());
+			}
+		}
+
+		// Remove coincident nodes.
+		RemoveCoincidentNodes();
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Identifier at the start of every native binary mesh cache file.
+///	</summary>
+static const char MeshCacheMagic[8] = {'T','R','M','E','S','H','C','1'};
+
+///	<summary>
+///		Version of the native binary mesh cache format.
+///	</summary>
+static const uint32_t MeshCacheVersion = 1;
+
+///	<summary>
+///		Marker used to detect files written with a different byte order.
+///	</summary>
+static const uint32_t MeshCacheByteOrderMark = 0x01020304;
+
+///	<summary>
+///		Identifiers of the physical sections of a mesh cache file.
+///	</summary>
+enum MeshCacheSectionId {
+	MeshCacheSectionId_Nodes = 1,
+	MeshCacheSectionId_FaceOffsets = 2,
+	MeshCacheSectionId_FaceNodes = 3,
+	MeshCacheSectionId_EdgeTypes = 4,
+	MeshCacheSectionId_SourceFaceIx = 5,
+	MeshCacheSectionId_TargetFaceIx = 6,
+	MeshCacheSectionId_Mask = 7,
+	MeshCacheSectionId_GridDimSizes = 8,
+	MeshCacheSectionId_GridDimNames = 9,
+	MeshCacheSectionId_FaceAreas = 10,
+	MeshCacheSectionId_EdgeMap = 11
+};
+
+///	<summary>
+///		Header of a native binary mesh cache file.  The header is followed by
+///		a table of nSections entries, and then by the data of each section
+///		padded to a multiple of 8 bytes.  Faces are stored in compressed
+///		sparse row format with the type of each edge alongside its first
+///		node, and EdgeMap entries are stored as five integers (edge nodes,
+///		edge type and the adjacent faces).
+///	</summary>
+struct MeshCacheHeader {
+	char szMagic[8];
+	uint32_t uVersion;
+	uint32_t uByteOrderMark;
+	int32_t iMeshType;
+	uint32_t nSections;
+	uint64_t nNodes;
+	uint64_t nFaces;
+	uint64_t nFaceNodes;
+};
+
+///	<summary>
+///		Entry of the section table of a native binary mesh cache file.  The
+///		checksum is the 64-bit FNV-1a hash of the unpadded section data.
+///	</summary>
+struct MeshCacheSectionEntry {
+	uint32_t uId;
+	uint32_t uReserved;
+	uint64_t sOffset;
+	uint64_t sBytes;
+	uint64_t uChecksum;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		64-bit FNV-1a hash of a block of memory.
+///	</summary>
+static uint64_t MeshCacheChecksum(
+	const void * pData,
+	size_t sBytes
+) {
+	const unsigned char * pBytes = static_cast<const unsigned char *>(pData);
+	uint64_t uHash = 14695981039346656037ULL;
+	for (size_t i = 0; i < sBytes; i++) {
+		uHash ^= static_cast<uint64_t>(pBytes[i]);
+		uHash *= 1099511628211ULL;
+	}
+	return uHash;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A section of a native binary mesh cache file to be written.
+///	</summary>
+struct MeshCacheSectionData {
+	MeshCacheSectionData(
+		uint32_t _uId,
+		const void * _pData,
+		size_t _sBytes
+	) :
+		uId(_uId),
+		pData(_pData),
+		sBytes(_sBytes)
+	{ }
+
+	uint32_t uId;
+	const void * pData;
+	size_t sBytes;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Mesh::WriteCache(const std::string & strFile) const {
+
+	const size_t nNodes = nodes.size();
+	const size_t nFaces = faces.size();
+
+	// Pack Faces in compressed sparse row format
+	std::vector<uint64_t> vecFaceOffsets(nFaces + 1);
+	vecFaceOffsets[0] = 0;
+	for (size_t i = 0; i < nFaces; i++) {
+		vecFaceOffsets[i+1] = vecFaceOffsets[i] + faces[i].edges.size();
+	}
+
+	const size_t nFaceNodes = vecFaceOffsets[nFaces];
+
+	std::vector<int32_t> vecFaceNodes(nFaceNodes);
+	std::vector<int8_t> vecEdgeTypes(nFaceNodes);
+
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < static_cast<int>(nFaces); i++) {
+		const Face & face = faces[i];
+		const size_t ixBegin = vecFaceOffsets[i];
+		for (size_t j = 0; j < face.edges.size(); j++) {
+			vecFaceNodes[ixBegin + j] = face.edges[j][0];
+			vecEdgeTypes[ixBegin + j] = static_cast<int8_t>(face.edges[j].type);
+		}
+	}
+
+	// Pack Nodes
+	std::vector<double> vecNodes(3 * nNodes);
+	for (size_t i = 0; i < nNodes; i++) {
+		vecNodes[3*i  ] = nodes[i].x;
+		vecNodes[3*i+1] = nodes[i].y;
+		vecNodes[3*i+2] = nodes[i].z;
+	}
+
+	std::vector<MeshCacheSectionData> vecSections;
+	vecSections.push_back(MeshCacheSectionData(
+		MeshCacheSectionId_Nodes,
+		vecNodes.data(), vecNodes.size() * sizeof(double)));
+	vecSections.push_back(MeshCacheSectionData(
+		MeshCacheSectionId_FaceOffsets,
+		vecFaceOffsets.data(), vecFaceOffsets.size() * sizeof(uint64_t)));
+	vecSections.push_back(MeshCacheSectionData(
+		MeshCacheSectionId_FaceNodes,
+		vecFaceNodes.data(), vecFaceNodes.size() * sizeof(int32_t)));
+	vecSections.push_back(MeshCacheSectionData(
+		MeshCacheSectionId_EdgeTypes,
+		vecEdgeTypes.data(), vecEdgeTypes.size() * sizeof(int8_t)));
+
+	// Parent Faces of overlap meshes
+	if (vecSourceFaceIx.size() != 0) {
+		vecSections.push_back(MeshCacheSectionData(
+			MeshCacheSectionId_SourceFaceIx,
+			vecSourceFaceIx.data(), vecSourceFaceIx.size() * sizeof(int)));
+	}
+	if (vecTargetFaceIx.size() != 0) {
+		vecSections.push_back(MeshCacheSectionData(
+			MeshCacheSectionId_TargetFaceIx,
+			vecTargetFaceIx.data(), vecTargetFaceIx.size() * sizeof(int)));
+	}
+
+	// Mask
+	if (vecMask.size() != 0) {
+		vecSections.push_back(MeshCacheSectionData(
+			MeshCacheSectionId_Mask,
+			vecMask.data(), vecMask.size() * sizeof(int)));
+	}
+
+	// Grid dimensions
+	std::string strGridDimNames;
+	if (vecGridDimSize.size() != 0) {
+		for (size_t i = 0; i < vecGridDimName.size(); i++) {
+			strGridDimNames += vecGridDimName[i];
+			strGridDimNames += '\0';
+		}
+		vecSections.push_back(MeshCacheSectionData(
+			MeshCacheSectionId_GridDimSizes,
+			vecGridDimSize.data(), vecGridDimSize.size() * sizeof(int)));
+		vecSections.push_back(MeshCacheSectionData(
+			MeshCacheSectionId_GridDimNames,
+			strGridDimNames.data(), strGridDimNames.length()));
+	}
+
+	// Face areas
+	if ((nFaces != 0) && (vecFaceArea.GetRows() == nFaces)) {
+		vecSections.push_back(MeshCacheSectionData(
+			MeshCacheSectionId_FaceAreas,
+			&(vecFaceArea[0]), nFaces * sizeof(double)));
+	}
+
+	// EdgeMap
+	std::vector<int32_t> vecEdgeMap;
+	if (edgemap.size() != 0) {
+		vecEdgeMap.reserve(5 * edgemap.size());
+		EdgeMapConstIterator iter = edgemap.begin();
+		for (; iter != edgemap.end(); iter++) {
+			vecEdgeMap.push_back(iter->first[0]);
+			vecEdgeMap.push_back(iter->first[1]);
+			vecEdgeMap.push_back(static_cast<int32_t>(iter->first.type));
+			vecEdgeMap.push_back(iter->second[0]);
+			vecEdgeMap.push_back(iter->second[1]);
+		}
+		vecSections.push_back(MeshCacheSectionData(
+			MeshCacheSectionId_EdgeMap,
+			vecEdgeMap.data(), vecEdgeMap.size() * sizeof(int32_t)));
+	}
+
+	// Header and section table
+	MeshCacheHeader header;
+	memset(&header, 0, sizeof(MeshCacheHeader));
+	memcpy(header.szMagic, MeshCacheMagic, sizeof(MeshCacheMagic));
+	header.uVersion = MeshCacheVersion;
+	header.uByteOrderMark = MeshCacheByteOrderMark;
+	header.iMeshType = static_cast<int32_t>(type);
+	header.nSections = static_cast<uint32_t>(vecSections.size());
+	header.nNodes = nNodes;
+	header.nFaces = nFaces;
+	header.nFaceNodes = nFaceNodes;
+
+	std::vector<MeshCacheSectionEntry> vecTable(vecSections.size());
+
+	uint64_t sOffset =
+		sizeof(MeshCacheHeader)
+		+ vecSections.size() * sizeof(MeshCacheSectionEntry);
+
+	for (size_t s = 0; s < vecSections.size(); s++) {
+		vecTable[s].uId = vecSections[s].uId;
+		vecTable[s].uReserved = 0;
+		vecTable[s].sOffset = sOffset;
+		vecTable[s].sBytes = vecSections[s].sBytes;
+		vecTable[s].uChecksum =
+			MeshCacheChecksum(vecSections[s].pData, vecSections[s].sBytes);
+
+		sOffset += (vecSections[s].sBytes + 7) / 8 * 8;
+	}
+
+	// Write the file
+	FILE * fp = fopen(strFile.c_str(), "wb");
+	if (fp == NULL) {
+		_EXCEPTION1("Unable to open mesh cache file \"%s\" for writing",
+			strFile.c_str());
+	}
+
+	bool fSuccess =
+		(fwrite(&header, sizeof(MeshCacheHeader), 1, fp) == 1);
+
+	if (fSuccess && (vecTable.size() != 0)) {
+		fSuccess =
+			(fwrite(&(vecTable[0]), sizeof(MeshCacheSectionEntry),
+				vecTable.size(), fp) == vecTable.size());
+	}
+
+	const char szPadding[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+	for (size_t s = 0; fSuccess && (s < vecSections.size()); s++) {
+		const size_t sBytes = vecSections[s].sBytes;
+		if (sBytes != 0) {
+			fSuccess =
+				(fwrite(vecSections[s].pData, 1, sBytes, fp) == sBytes);
+		}
+		const size_t sPadding = (sBytes + 7) / 8 * 8 - sBytes;
+		if (fSuccess && (sPadding != 0)) {
+			fSuccess = (fwrite(szPadding, 1, sPadding, fp) == sPadding);
+		}
+	}
+
+	if (fclose(fp) != 0) {
+		fSuccess = false;
+	}
+	if (!fSuccess) {
+		_EXCEPTION1("Error writing mesh cache file \"%s\"", strFile.c_str());
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Locate a section of a memory mapped mesh cache file, verifying its
+///		size and checksum.  Returns NULL if the section is not present.
+///	</summary>
+static const char * FindMeshCacheSection(
+	const MemoryMappedFile & mmapFile,
+	const MeshCacheHeader & header,
+	uint32_t uId,
+	size_t sExpectedBytes,
+	size_t * psBytes = NULL
+) {
+	const char * pFileData = static_cast<const char *>(mmapFile.GetData());
+
+	const MeshCacheSectionEntry * pTable =
+		reinterpret_cast<const MeshCacheSectionEntry *>(
+			pFileData + sizeof(MeshCacheHeader));
+
+	for (uint32_t s = 0; s < header.nSections; s++) {
+		if (pTable[s].uId != uId) {
+			continue;
+		}
+		if (pTable[s].sOffset + pTable[s].sBytes > mmapFile.GetSize()) {
+			_EXCEPTION1("Mesh cache file truncated in section %u", uId);
+		}
+		if (psBytes != NULL) {
+			*psBytes = pTable[s].sBytes;
+		} else if (pTable[s].sBytes != sExpectedBytes) {
+			_EXCEPTION3("Mesh cache section %u has size %lu (expected %lu)",
+				uId,
+				static_cast<unsigned long>(pTable[s].sBytes),
+				static_cast<unsigned long>(sExpectedBytes));
+		}
+
+		const char * pData = pFileData + pTable[s].sOffset;
+		if (MeshCacheChecksum(pData, pTable[s].sBytes) != pTable[s].uChecksum) {
+			_EXCEPTION1("Checksum mismatch in mesh cache section %u", uId);
+		}
+		return pData;
+	}
+
+	return NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool Mesh::IsCacheFile(const std::string & strFile) {
+	FILE * fp = fopen(strFile.c_str(), "rb");
+	if (fp == NULL) {
+		return false;
+	}
+
+	char szMagic[8];
+	size_t sRead = fread(szMagic, 1, sizeof(szMagic), fp);
+	fclose(fp);
+
+	if (sRead != sizeof(szMagic)) {
+		return false;
+	}
+	return (memcmp(szMagic, MeshCacheMagic, sizeof(szMagic)) == 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Add a block of bytes to a 64-bit FNV-1a hash.
+///	</summary>
+static inline uint64_t MeshHashBytes(
+	const void * pData,
+	size_t sBytes,
+	uint64_t uHash
+) {
+	const unsigned char * pBytes = static_cast<const unsigned char *>(pData);
+	for (size_t i = 0; i < sBytes; i++) {
+		uHash ^= static_cast<uint64_t>(pBytes[i]);
+		uHash *= 1099511628211ULL;
+	}
+	return uHash;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint64_t Mesh::CalculateHash() const {
+	uint64_t uHash = 14695981039346656037ULL;
+
+	const uint64_t nNodes = nodes.size();
+	uHash = MeshHashBytes(&nNodes, sizeof(uint64_t), uHash);
+
+	for (size_t i = 0; i < nodes.size(); i++) {
+		const Real dX[3] = { nodes[i].x, nodes[i].y, nodes[i].z };
+		uHash = MeshHashBytes(dX, sizeof(dX), uHash);
+	}
+
+	const uint64_t nFaces = faces.size();
+	uHash = MeshHashBytes(&nFaces, sizeof(uint64_t), uHash);
+
+	for (size_t i = 0; i < faces.size(); i++) {
+		const Face & face = faces[i];
+
+		const int nEdges = face.edges.size();
+		uHash = MeshHashBytes(&nEdges, sizeof(int), uHash);
+
+		for (int j = 0; j < nEdges; j++) {
+			const int ixNode = face[j];
+			uHash = MeshHashBytes(&ixNode, sizeof(int), uHash);
+		}
+	}
+
+	return uHash;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Mesh::ReadCache(
+	const std::string & strFile,
+	int iSections
+) {
+	// The mapping is copy-on-write so that arrays attached to it may be
+	// modified without affecting the file
+	std::shared_ptr<MemoryMappedFile> pmmapFile(new MemoryMappedFile);
+	pmmapFile->Open(strFile, true);
+
+	const MemoryMappedFile & mmapFile = *pmmapFile;
+
+	// Verify header
+	if (mmapFile.GetSize() < sizeof(MeshCacheHeader)) {
+		_EXCEPTION1("File \"%s\" is too small to be a mesh cache file",
+			strFile.c_str());
+	}
+
+	MeshCacheHeader header;
+	memcpy(&header, mmapFile.GetData(), sizeof(MeshCacheHeader));
+
+	if (memcmp(header.szMagic, MeshCacheMagic, sizeof(MeshCacheMagic)) != 0) {
+		_EXCEPTION1("File \"%s\" is not a mesh cache file",
+			strFile.c_str());
+	}
+	if (header.uByteOrderMark != MeshCacheByteOrderMark) {
+		_EXCEPTION1("Mesh cache file \"%s\" was written with a different byte order",
+			strFile.c_str());
+	}
+	if (header.uVersion != MeshCacheVersion) {
+		_EXCEPTION2("Mesh cache file \"%s\" has unsupported version %u",
+			strFile.c_str(), header.uVersion);
+	}
+	if (sizeof(MeshCacheHeader)
+		+ header.nSections * sizeof(MeshCacheSectionEntry)
+			> mmapFile.GetSize()
+	) {
+		_EXCEPTION1("Mesh cache file \"%s\" is truncated", strFile.c_str());
+	}
+
+	const size_t nNodes = header.nNodes;
+	const size_t nFaces = header.nFaces;
+	const size_t nFaceNodes = header.nFaceNodes;
+
+	// Sections loaded incrementally must refer to the same Mesh
+	if (!(iSections & CacheSection_Nodes) && (nodes.size() != nNodes)) {
+		_EXCEPTION1("Mesh cache file \"%s\" does not match the number of "
+			"Nodes in this Mesh", strFile.c_str());
+	}
+	if (!(iSections & CacheSection_Faces) && (faces.size() != nFaces)) {
+		_EXCEPTION1("Mesh cache file \"%s\" does not match the number of "
+			"Faces in this Mesh", strFile.c_str());
+	}
+
+	if (iSections & CacheSection_Nodes) {
+		strFileName = strFile;
+		type = static_cast<MeshType>(header.iMeshType);
+	}
+
+	// Nodes
+	if (iSections & CacheSection_Nodes) {
+		const double * pNodes = reinterpret_cast<const double *>(
+			FindMeshCacheSection(mmapFile, header,
+				MeshCacheSectionId_Nodes, 3 * nNodes * sizeof(double)));
+		if (pNodes == NULL) {
+			_EXCEPTION1("Mesh cache file \"%s\" has no Nodes", strFile.c_str());
+		}
+
+		nodes.resize(nNodes);
+		for (size_t i = 0; i < nNodes; i++) {
+			nodes[i].x = pNodes[3*i  ];
+			nodes[i].y = pNodes[3*i+1];
+			nodes[i].z = pNodes[3*i+2];
+		}
+	}
+
+	// Faces
+	if (iSections & CacheSection_Faces) {
+		const uint64_t * pFaceOffsets = reinterpret_cast<const uint64_t *>(
+			FindMeshCacheSection(mmapFile, header,
+				MeshCacheSectionId_FaceOffsets, (nFaces + 1) * sizeof(uint64_t)));
+		const int32_t * pFaceNodes = reinterpret_cast<const int32_t *>(
+			FindMeshCacheSection(mmapFile, header,
+				MeshCacheSectionId_FaceNodes, nFaceNodes * sizeof(int32_t)));
+		const int8_t * pEdgeTypes = reinterpret_cast<const int8_t *>(
+			FindMeshCacheSection(mmapFile, header,
+				MeshCacheSectionId_EdgeTypes, nFaceNodes * sizeof(int8_t)));
+
+		if ((pFaceOffsets == NULL) || (pFaceNodes == NULL) || (pEdgeTypes == NULL)) {
+			_EXCEPTION1("Mesh cache file \"%s\" has no Faces", strFile.c_str());
+		}
+		if (pFaceOffsets[nFaces] != nFaceNodes) {
+			_EXCEPTION1("Mesh cache file \"%s\" has inconsistent Faces",
+				strFile.c_str());
+		}
+
+		faces.clear();
+		faces.resize(nFaces);
+
+#pragma omp parallel for schedule(static)
+		for (int i = 0; i < static_cast<int>(nFaces); i++) {
+			const size_t ixBegin = pFaceOffsets[i];
+			const int nEdges = static_cast<int>(pFaceOffsets[i+1] - ixBegin);
+
+			Face & face = faces[i];
+			face.edges.resize(nEdges);
+			for (int j = 0; j < nEdges; j++) {
+				face.edges[j].node[0] = pFaceNodes[ixBegin + j];
+				face.edges[j].node[1] = pFaceNodes[ixBegin + (j + 1) % nEdges];
+				face.edges[j].type =
+					static_cast<Edge::Type>(pEdgeTypes[ixBegin + j]);
+			}
+		}
+	}
+
+	// Parent Faces
+	if (iSections & CacheSection_Parents) {
+		const int * pSourceFaceIx = reinterpret_cast<const int *>(
+			FindMeshCacheSection(mmapFile, header,
+				MeshCacheSectionId_SourceFaceIx, nFaces * sizeof(int)));
+		if (pSourceFaceIx != NULL) {
+			vecSourceFaceIx.assign(pSourceFaceIx, pSourceFaceIx + nFaces);
+		}
+
+		const int * pTargetFaceIx = reinterpret_cast<const int *>(
+			FindMeshCacheSection(mmapFile, header,
+				MeshCacheSectionId_TargetFaceIx, nFaces * sizeof(int)));
+		if (pTargetFaceIx != NULL) {
+			vecTargetFaceIx.assign(pTargetFaceIx, pTargetFaceIx + nFaces);
+		}
+	}
+
+	// Mask
+	if (iSections & CacheSection_Mask) {
+		const int * pMask = reinterpret_cast<const int *>(
+			FindMeshCacheSection(mmapFile, header,
+				MeshCacheSectionId_Mask, nFaces * sizeof(int)));
+		if (pMask != NULL) {
+			vecMask.assign(pMask, pMask + nFaces);
+		}
+	}
+
+	// Grid dimensions
+	if (iSections & CacheSection_GridDims) {
+		size_t sSizeBytes = 0;
+		const int * pGridDimSize = reinterpret_cast<const int *>(
+			FindMeshCacheSection(mmapFile, header,
+				MeshCacheSectionId_GridDimSizes, 0, &sSizeBytes));
+
+		size_t sNameBytes = 0;
+		const char * pGridDimNames =
+			FindMeshCacheSection(mmapFile, header,
+				MeshCacheSectionId_GridDimNames, 0, &sNameBytes);
+
+		if ((pGridDimSize != NULL) && (pGridDimNames != NULL)) {
+			vecGridDimSize.assign(
+				pGridDimSize, pGridDimSize + sSizeBytes / sizeof(int));
+
+			vecGridDimName.clear();
+			size_t sBegin = 0;
+			for (size_t i = 0; i < sNameBytes; i++) {
+				if (pGridDimNames[i] == '\0') {
+					vecGridDimName.push_back(
+						std::string(pGridDimNames + sBegin, i - sBegin));
+					sBegin = i + 1;
+				}
+			}
+			if (vecGridDimName.size() != vecGridDimSize.size()) {
+				_EXCEPTION1("Mesh cache file \"%s\" has inconsistent grid "
+					"dimensions", strFile.c_str());
+			}
+		}
+	}
+
+	// Face areas are attached to the mapping rather than copied
+	if (iSections & CacheSection_FaceAreas) {
+		const double * pFaceArea = reinterpret_cast<const double *>(
+			FindMeshCacheSection(mmapFile, header,
+				MeshCacheSectionId_FaceAreas, nFaces * sizeof(double)));
+		if ((pFaceArea != NULL) && (nFaces != 0)) {
+			vecFaceArea.Detach();
+			vecFaceArea.SetSize(nFaces);
+			vecFaceArea.AttachToData(
+				const_cast<double *>(pFaceArea), pmmapFile);
+		}
+	}
 
-			if (vecGridDimSize[0] * vecGridDimSize[1] != faces.size()) {
-				_EXCEPTION4("Exodus grid file \"%s\" grid_dims (%i,%i) do not agree with grid_size (%i)",
-					strFile.c_str(), vecGridDimSize[0], vecGridDimSize[1], faces.size());
+	// EdgeMap
+	if (iSections & CacheSection_EdgeMap) {
+		size_t sBytes = 0;
+		const int32_t * pEdgeMap = reinterpret_cast<const int32_t *>(
+			FindMeshCacheSection(mmapFile, header,
+				MeshCacheSectionId_EdgeMap, 0, &sBytes));
+
+		if (pEdgeMap != NULL) {
+			const size_t nEdges = sBytes / (5 * sizeof(int32_t));
+
+			std::vector<EdgeMapPair> vecEntries(nEdges);
+			for (size_t i = 0; i < nEdges; i++) {
+				const int32_t * pEntry = pEdgeMap + 5 * i;
+				vecEntries[i].first =
+					Edge(pEntry[0], pEntry[1],
+						static_cast<Edge::Type>(pEntry[2]));
+				vecEntries[i].second.face[0] = pEntry[3];
+				vecEntries[i].second.face[1] = pEntry[4];
 			}
+			edgemap.Assign(vecEntries);
 		}
+	}
 
-		// Remove coincident nodes.
-		RemoveCoincidentNodes();
+	if (iSections & CacheSection_Nodes) {
+		Announce("Mesh size: Nodes [%i] Elements [%i]",
+			static_cast<int>(nodes.size()), static_cast<int>(faces.size()));
 	}
 }
 
@@ -1612,163 +3730,237 @@ void Mesh::Read(const std::string & strFile) {
 void Mesh::RemoveZeroEdges() {
 
 	// Remove zero edges from all Faces
-	for (int i = 0; i < faces.size(); i++) {
+	const int nFaces = faces.size();
+
+#pragma omp parallel for schedule(dynamic, 1024)
+	for (int i = 0; i < nFaces; i++) {
 		faces[i].RemoveZeroEdges();
 	}
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void Mesh::Validate() const {
-
-	// Valid that Nodes have magnitude 1
-	for (int i = 0; i < nodes.size(); i++) {
-		double dMag = nodes[i].Magnitude();
-
-		if (fabs(dMag - 1.0) > ReferenceTolerance) {
-			_EXCEPTION5("Mesh validation failed: "
-				"Node[%i] of non-unit magnitude detected (%1.10e, %1.10e, %1.10e) = %1.10e",
-				i, nodes[i].x, nodes[i].y, nodes[i].z, dMag);
-
-		}
-	}
-
-	// Validate that edges are oriented counter-clockwise
-	for (int i = 0; i < faces.size(); i++) {
-		const Face & face = faces[i];
+///	<summary>
+///		Validate the orientation and edge consistency of Face i.  If fThrow
+///		is set a diagnostic is printed and an Exception is thrown on error;
+///		otherwise false is returned.
+///	</summary>
+static bool ValidateFace(
+	const FaceVector & faces,
+	const NodeVector & nodes,
+	int i,
+	bool fThrow
+) {
+	const Face & face = faces[i];
 
-		const int nEdges = face.edges.size();
+	const int nEdges = face.edges.size();
 
-		for (int j = 0; j < nEdges; j++) {
+	for (int j = 0; j < nEdges; j++) {
 
-			// Check for zero edges
-			for(;;) {
-				if (face.edges[j][0] == face.edges[j][1]) {
-					j++;
-				} else {
-					break;
-				}
-				if (j == nEdges) {
-					break;
-				}
+		// Check for zero edges
+		for(;;) {
+			if (face.edges[j][0] == face.edges[j][1]) {
+				j++;
+			} else {
+				break;
 			}
-
 			if (j == nEdges) {
 				break;
 			}
+		}
 
-			// Find the next non-zero edge
-			int jNext = (j + 1) % nEdges;
+		if (j == nEdges) {
+			break;
+		}
 
-			for(;;) {
-				if (face.edges[jNext][0] == face.edges[jNext][1]) {
-					jNext++;
-				} else {
-					break;
-				}
-				if (jNext == nEdges) {
-					jNext = 0;
-				}
-				if (jNext == ((j + 1) % nEdges)) {
-					_EXCEPTIONT("Mesh validation failed: "
-						"No edge information on Face");
+		// Find the next non-zero edge
+		int jNext = (j + 1) % nEdges;
+
+		for(;;) {
+			if (face.edges[jNext][0] == face.edges[jNext][1]) {
+				jNext++;
+			} else {
+				break;
+			}
+			if (jNext == nEdges) {
+				jNext = 0;
+			}
+			if (jNext == ((j + 1) % nEdges)) {
+				if (!fThrow) {
+					return false;
 				}
+				_EXCEPTIONT("Mesh validation failed: "
+					"No edge information on Face");
 			}
+		}
 
-			// Get edges
-			const Edge & edge0 = face.edges[j];
-			const Edge & edge1 = face.edges[(j + 1) % nEdges];
+		// Get edges
+		const Edge & edge0 = face.edges[j];
+		const Edge & edge1 = face.edges[(j + 1) % nEdges];
 
-			if (edge0[1] != edge1[0]) {
-				_EXCEPTIONT("Mesh validation failed: Edge cyclicity error");
+		if (edge0[1] != edge1[0]) {
+			if (!fThrow) {
+				return false;
 			}
+			_EXCEPTIONT("Mesh validation failed: Edge cyclicity error");
+		}
 
-			const Node & node0 = nodes[edge0[0]];
-			const Node & node1 = nodes[edge0[1]];
-			const Node & node2 = nodes[edge1[1]];
+		const Node & node0 = nodes[edge0[0]];
+		const Node & node1 = nodes[edge0[1]];
+		const Node & node2 = nodes[edge1[1]];
 
-			// Vectors along edges
-			Node nodeD1 = node0 - node1;
-			Node nodeD2 = node2 - node1;
+		// Vectors along edges
+		Node nodeD1 = node0 - node1;
+		Node nodeD2 = node2 - node1;
 
-			// Compute cross-product
-			Node nodeCross(CrossProduct(nodeD1, nodeD2));
+		// Compute cross-product
+		Node nodeCross(CrossProduct(nodeD1, nodeD2));
 
-			// Dot cross product with radial vector
-			Real dDot = DotProduct(node1, nodeCross);
+		// Dot cross product with radial vector
+		Real dDot = DotProduct(node1, nodeCross);
 /*
 #ifdef USE_EXACT_ARITHMETIC
-			FixedPoint dDotX = DotProductX(node1, nodeCross);
+		FixedPoint dDotX = DotProductX(node1, nodeCross);
+
+		printf("%1.15e : ", nodeCross.x); nodeCross.fx.Print(); printf("\n");
+
+		if (fabs(nodeCross.x - nodeCross.fx.ToReal()) > ReferenceTolerance) {
+			printf("X0: %1.15e : ", node0.x); node0.fx.Print(); printf("\n");
+			printf("Y0: %1.15e : ", node0.y); node0.fy.Print(); printf("\n");
+			printf("Z0: %1.15e : ", node0.z); node0.fz.Print(); printf("\n");
+			printf("X1: %1.15e : ", node1.x); node1.fx.Print(); printf("\n");
+			printf("Y1: %1.15e : ", node1.y); node1.fy.Print(); printf("\n");
+			printf("Z1: %1.15e : ", node1.z); node1.fz.Print(); printf("\n");
+			printf("X2: %1.15e : ", node2.x); node2.fx.Print(); printf("\n");
+			printf("Y2: %1.15e : ", node2.y); node2.fy.Print(); printf("\n");
+			printf("Z2: %1.15e : ", node2.z); node2.fz.Print(); printf("\n");
+
+			printf("X1: %1.15e : ", nodeD1.x); nodeD1.fx.Print(); printf("\n");
+			printf("Y1: %1.15e : ", nodeD1.y); nodeD1.fy.Print(); printf("\n");
+			printf("Z1: %1.15e : ", nodeD1.z); nodeD1.fz.Print(); printf("\n");
+			printf("X2: %1.15e : ", nodeD2.x); nodeD2.fx.Print(); printf("\n");
+			printf("Y2: %1.15e : ", nodeD2.y); nodeD2.fy.Print(); printf("\n");
+			printf("Z2: %1.15e : ", nodeD2.z); nodeD2.fz.Print(); printf("\n");
+			_EXCEPTIONT("FixedPoint mismatch (X)");
+		}
+		if (fabs(nodeCross.y - nodeCross.fy.ToReal()) > ReferenceTolerance) {
+			_EXCEPTIONT("FixedPoint mismatch (Y)");
+		}
+		if (fabs(nodeCross.z - nodeCross.fz.ToReal()) > ReferenceTolerance) {
+			_EXCEPTIONT("FixedPoint mismatch (Z)");
+		}
 
-			printf("%1.15e : ", nodeCross.x); nodeCross.fx.Print(); printf("\n");
+#endif
+*/
+		if (dDot > 0.0) {
+			if (!fThrow) {
+				return false;
+			}
 
-			if (fabs(nodeCross.x - nodeCross.fx.ToReal()) > ReferenceTolerance) {
-				printf("X0: %1.15e : ", node0.x); node0.fx.Print(); printf("\n");
-				printf("Y0: %1.15e : ", node0.y); node0.fy.Print(); printf("\n");
-				printf("Z0: %1.15e : ", node0.z); node0.fz.Print(); printf("\n");
-				printf("X1: %1.15e : ", node1.x); node1.fx.Print(); printf("\n");
-				printf("Y1: %1.15e : ", node1.y); node1.fy.Print(); printf("\n");
-				printf("Z1: %1.15e : ", node1.z); node1.fz.Print(); printf("\n");
-				printf("X2: %1.15e : ", node2.x); node2.fx.Print(); printf("\n");
-				printf("Y2: %1.15e : ", node2.y); node2.fy.Print(); printf("\n");
-				printf("Z2: %1.15e : ", node2.z); node2.fz.Print(); printf("\n");
+			printf("\nError detected (orientation):\n");
+			printf("  Face %i, Edge %i, Orientation %1.5e\n",
+				i, j, dDot);
+
+			printf("  (x,y,z):\n");
+			printf("    n0: %1.5e %1.5e %1.5e\n", node0.x, node0.y, node0.z);
+			printf("    n1: %1.5e %1.5e %1.5e\n", node1.x, node1.y, node1.z);
+			printf("    n2: %1.5e %1.5e %1.5e\n", node2.x, node2.y, node2.z);
+
+			Real dR0 = sqrt(
+				node0.x * node0.x + node0.y * node0.y + node0.z * node0.z);
+			Real dLat0 = asin(node0.z / dR0);
+			Real dLon0 = atan2(node0.y, node0.x);
+
+			Real dR1 = sqrt(
+				node1.x * node1.x + node1.y * node1.y + node1.z * node1.z);
+			Real dLat1 = asin(node1.z / dR1);
+			Real dLon1 = atan2(node1.y, node1.x);
+
+			Real dR2 = sqrt(
+				node2.x * node2.x + node2.y * node2.y + node2.z * node2.z);
+			Real dLat2 = asin(node2.z / dR2);
+			Real dLon2 = atan2(node2.y, node2.x);
+
+			printf("  (lambda, phi):\n");
+			printf("    n0: %1.5e %1.5e\n", dLon0, dLat0);
+			printf("    n1: %1.5e %1.5e\n", dLon1, dLat1);
+			printf("    n2: %1.5e %1.5e\n", dLon2, dLat2);
+
+			printf("  X-Product:\n");
+			printf("    %1.5e %1.5e %1.5e\n",
+				nodeCross.x, nodeCross.y, nodeCross.z);
+
+			_EXCEPTIONT(
+				"Mesh validation failed: Clockwise or concave face detected");
+		}
+	}
 
-				printf("X1: %1.15e : ", nodeD1.x); nodeD1.fx.Print(); printf("\n");
-				printf("Y1: %1.15e : ", nodeD1.y); nodeD1.fy.Print(); printf("\n");
-				printf("Z1: %1.15e : ", nodeD1.z); nodeD1.fz.Print(); printf("\n");
-				printf("X2: %1.15e : ", nodeD2.x); nodeD2.fx.Print(); printf("\n");
-				printf("Y2: %1.15e : ", nodeD2.y); nodeD2.fy.Print(); printf("\n");
-				printf("Z2: %1.15e : ", nodeD2.z); nodeD2.fz.Print(); printf("\n");
-				_EXCEPTIONT("FixedPoint mismatch (X)");
-			}
-			if (fabs(nodeCross.y - nodeCross.fy.ToReal()) > ReferenceTolerance) {
-				_EXCEPTIONT("FixedPoint mismatch (Y)");
-			}
-			if (fabs(nodeCross.z - nodeCross.fz.ToReal()) > ReferenceTolerance) {
-				_EXCEPTIONT("FixedPoint mismatch (Z)");
-			}
+	return true;
+}
 
-#endif
-*/
-			if (dDot > 0.0) {
-				printf("\nError detected (orientation):\n");
-				printf("  Face %i, Edge %i, Orientation %1.5e\n",
-					i, j, dDot);
+///////////////////////////////////////////////////////////////////////////////
+
+void Mesh::Validate() const {
+
+	// Valid that Nodes have magnitude 1
+	const int nNodes = nodes.size();
+
+	int iFirstInvalidNode = nNodes;
+
+#pragma omp parallel for schedule(static) reduction(min:iFirstInvalidNode)
+	for (int i = 0; i < nNodes; i++) {
+		if (i > iFirstInvalidNode) {
+			continue;
+		}
+
+		double dMag = nodes[i].Magnitude();
+
+		if (fabs(dMag - 1.0) > ReferenceTolerance) {
+			iFirstInvalidNode = i;
+		}
+	}
 
-				printf("  (x,y,z):\n");
-				printf("    n0: %1.5e %1.5e %1.5e\n", node0.x, node0.y, node0.z);
-				printf("    n1: %1.5e %1.5e %1.5e\n", node1.x, node1.y, node1.z);
-				printf("    n2: %1.5e %1.5e %1.5e\n", node2.x, node2.y, node2.z);
+	if (iFirstInvalidNode != nNodes) {
+		const int i = iFirstInvalidNode;
+		double dMag = nodes[i].Magnitude();
 
-				Real dR0 = sqrt(
-					node0.x * node0.x + node0.y * node0.y + node0.z * node0.z);
-				Real dLat0 = asin(node0.z / dR0);
-				Real dLon0 = atan2(node0.y, node0.x);
+		_EXCEPTION5("Mesh validation failed: "
+			"Node[%i] of non-unit magnitude detected (%1.10e, %1.10e, %1.10e) = %1.10e",
+			i, nodes[i].x, nodes[i].y, nodes[i].z, dMag);
+	}
 
-				Real dR1 = sqrt(
-					node1.x * node1.x + node1.y * node1.y + node1.z * node1.z);
-				Real dLat1 = asin(node1.z / dR1);
-				Real dLon1 = atan2(node1.y, node1.x);
+	// Validate that edges are oriented counter-clockwise.  Threads skip
+	// Faces beyond the lowest invalid Face found so far, and the lowest
+	// invalid Face is then validated again to report the error.
+	const int nFaces = faces.size();
 
-				Real dR2 = sqrt(
-					node2.x * node2.x + node2.y * node2.y + node2.z * node2.z);
-				Real dLat2 = asin(node2.z / dR2);
-				Real dLon2 = atan2(node2.y, node2.x);
+	int iFirstInvalidFace = nFaces;
 
-				printf("  (lambda, phi):\n");
-				printf("    n0: %1.5e %1.5e\n", dLon0, dLat0);
-				printf("    n1: %1.5e %1.5e\n", dLon1, dLat1);
-				printf("    n2: %1.5e %1.5e\n", dLon2, dLat2);
+#pragma omp parallel for schedule(dynamic, 1024)
+	for (int i = 0; i < nFaces; i++) {
+		int iCurrentFirstInvalidFace;
+#pragma omp atomic read
+		iCurrentFirstInvalidFace = iFirstInvalidFace;
 
-				printf("  X-Product:\n");
-				printf("    %1.5e %1.5e %1.5e\n",
-					nodeCross.x, nodeCross.y, nodeCross.z);
+		if (i > iCurrentFirstInvalidFace) {
+			continue;
+		}
 
-				_EXCEPTIONT(
-					"Mesh validation failed: Clockwise or concave face detected");
+		if (!ValidateFace(faces, nodes, i, false)) {
+#pragma omp critical(MeshValidate)
+			{
+				if (i < iFirstInvalidFace) {
+#pragma omp atomic write
+					iFirstInvalidFace = i;
+				}
 			}
 		}
 	}
+
+	if (iFirstInvalidFace != nFaces) {
+		ValidateFace(faces, nodes, iFirstInvalidFace, true);
+		_EXCEPTIONT("Mesh validation failed");
+	}
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -1985,76 +4177,122 @@ int BuildCoincidentNodeVector(
 	return nCoincidentNodes;
 }
 
-Real CalculateTriangleAreaQuadratureMethod(Node & node1, Node & node2,
-		Node & node3) {
-
-	const int nOrder = 6;
-
-	DataArray1D<double> dG;
-	DataArray1D<double> dW;
-	GaussQuadrature::GetPoints(nOrder, 0.0, 1.0, dG, dW);
-
-	double dArea = 0.0;
-	// Calculate area at quadrature node
-	for (int p = 0; p < dW.GetRows(); p++) {
-		for (int q = 0; q < dW.GetRows(); q++) {
-
-			double dA = dG[p];
-			double dB = dG[q];
-
-			Node dF(
-					(1.0 - dB) * ((1.0 - dA) * node1.x + dA * node2.x)
-							+ dB * node3.x,
-					(1.0 - dB) * ((1.0 - dA) * node1.y + dA * node2.y)
-							+ dB * node3.y,
-					(1.0 - dB) * ((1.0 - dA) * node1.z + dA * node2.z)
-							+ dB * node3.z);
-
-			Node dDaF((1.0 - dB) * (node2.x - node1.x),
-					(1.0 - dB) * (node2.y - node1.y),
-					(1.0 - dB) * (node2.z - node1.z));
-
-			Node dDbF(-(1.0 - dA) * node1.x - dA * node2.x + node3.x,
-					-(1.0 - dA) * node1.y - dA * node2.y + node3.y,
-					-(1.0 - dA) * node1.z - dA * node2.z + node3.z);
-
-			double dR = sqrt(dF.x * dF.x + dF.y * dF.y + dF.z * dF.z);
-
-			Node dDaG(
-					dDaF.x * (dF.y * dF.y + dF.z * dF.z)
-							- dF.x * (dDaF.y * dF.y + dDaF.z * dF.z),
-					dDaF.y * (dF.x * dF.x + dF.z * dF.z)
-							- dF.y * (dDaF.x * dF.x + dDaF.z * dF.z),
-					dDaF.z * (dF.x * dF.x + dF.y * dF.y)
-							- dF.z * (dDaF.x * dF.x + dDaF.y * dF.y));
+///	<summary>
+///		Gauss quadrature points and weights on the unit square used for
+///		calculating the area of spherical triangles.
+///	</summary>
+class SphericalTriangleQuadrature {
+
+public:
+	///	<summary>
+	///		Order of the Gauss quadrature rule in each direction.
+	///	</summary>
+	static const int Order = 6;
+
+	///	<summary>
+	///		Number of quadrature points.
+	///	</summary>
+	static const int Count = Order * Order;
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	SphericalTriangleQuadrature() {
+		DataArray1D<double> dG;
+		DataArray1D<double> dW;
+		GaussQuadrature::GetPoints(Order, 0.0, 1.0, dG, dW);
+
+		for (int p = 0; p < Order; p++) {
+		for (int q = 0; q < Order; q++) {
+			dA[p * Order + q] = dG[p];
+			dB[p * Order + q] = dG[q];
+			dWeight[p * Order + q] = dW[p] * dW[q];
+		}
+		}
+	}
 
-			Node dDbG(
-					dDbF.x * (dF.y * dF.y + dF.z * dF.z)
-							- dF.x * (dDbF.y * dF.y + dDbF.z * dF.z),
-					dDbF.y * (dF.x * dF.x + dF.z * dF.z)
-							- dF.y * (dDbF.x * dF.x + dDbF.z * dF.z),
-					dDbF.z * (dF.x * dF.x + dF.y * dF.y)
-							- dF.z * (dDbF.x * dF.x + dDbF.y * dF.y));
+public:
+	///	<summary>
+	///		Quadrature points and weights.
+	///	</summary>
+	double dA[Count];
+	double dB[Count];
+	double dWeight[Count];
+};
 
-			double dDenomTerm = 1.0 / (dR * dR * dR);
+///////////////////////////////////////////////////////////////////////////////
 
-			dDaG.x *= dDenomTerm;
-			dDaG.y *= dDenomTerm;
-			dDaG.z *= dDenomTerm;
+///	<summary>
+///		Quadrature rule used for calculating the area of spherical triangles.
+///	</summary>
+static const SphericalTriangleQuadrature s_quadSphericalTriangle;
 
-			dDbG.x *= dDenomTerm;
-			dDbG.y *= dDenomTerm;
-			dDbG.z *= dDenomTerm;
+///////////////////////////////////////////////////////////////////////////////
 
-			// Cross product gives local Jacobian
-			Node nodeCross = CrossProduct(dDaG, dDbG);
+Real CalculateTriangleAreaQuadratureMethod(Node & node1, Node & node2,
+		Node & node3) {
 
-			double dJacobian = sqrt(
-					nodeCross.x * nodeCross.x + nodeCross.y * nodeCross.y
-							+ nodeCross.z * nodeCross.z);
+	const SphericalTriangleQuadrature & quad = s_quadSphericalTriangle;
 
-			dArea += dW[p] * dW[q] * dJacobian;
-		}
+	double dArea = 0.0;
+	// Calculate area at quadrature node
+	for (int k = 0; k < SphericalTriangleQuadrature::Count; k++) {
+		double dA = quad.dA[k];
+		double dB = quad.dB[k];
+
+		Node dF(
+				(1.0 - dB) * ((1.0 - dA) * node1.x + dA * node2.x)
+						+ dB * node3.x,
+				(1.0 - dB) * ((1.0 - dA) * node1.y + dA * node2.y)
+						+ dB * node3.y,
+				(1.0 - dB) * ((1.0 - dA) * node1.z + dA * node2.z)
+						+ dB * node3.z);
+
+		Node dDaF((1.0 - dB) * (node2.x - node1.x),
+				(1.0 - dB) * (node2.y - node1.y),
+				(1.0 - dB) * (node2.z - node1.z));
+
+		Node dDbF(-(1.0 - dA) * node1.x - dA * node2.x + node3.x,
+				-(1.0 - dA) * node1.y - dA * node2.y + node3.y,
+				-(1.0 - dA) * node1.z - dA * node2.z + node3.z);
+
+		double dR = sqrt(dF.x * dF.x + dF.y * dF.y + dF.z * dF.z);
+
+		Node dDaG(
+				dDaF.x * (dF.y * dF.y + dF.z * dF.z)
+						- dF.x * (dDaF.y * dF.y + dDaF.z * dF.z),
+				dDaF.y * (dF.x * dF.x + dF.z * dF.z)
+						- dF.y * (dDaF.x * dF.x + dDaF.z * dF.z),
+				dDaF.z * (dF.x * dF.x + dF.y * dF.y)
+						- dF.z * (dDaF.x * dF.x + dDaF.y * dF.y));
+
+		Node dDbG(
+				dDbF.x * (dF.y * dF.y + dF.z * dF.z)
+						- dF.x * (dDbF.y * dF.y + dDbF.z * dF.z),
+				dDbF.y * (dF.x * dF.x + dF.z * dF.z)
+						- dF.y * (dDbF.x * dF.x + dDbF.z * dF.z),
+				dDbF.z * (dF.x * dF.x + dF.y * dF.y)
+						- dF.z * (dDbF.x * dF.x + dDbF.y * dF.y));
+
+		double dDenomTerm = 1.0 / (dR * dR * dR);
+
+		dDaG.x *= dDenomTerm;
+		dDaG.y *= dDenomTerm;
+		dDaG.z *= dDenomTerm;
+
+		dDbG.x *= dDenomTerm;
+		dDbG.y *= dDenomTerm;
+		dDbG.z *= dDenomTerm;
+
+		// Cross product gives local Jacobian
+		Node nodeCross = CrossProduct(dDaG, dDbG);
+
+		double dJacobian = sqrt(
+				nodeCross.x * nodeCross.x + nodeCross.y * nodeCross.y
+						+ nodeCross.z * nodeCross.z);
+
+		dArea += quad.dWeight[k] * dJacobian;
 	}
 	return dArea;
 }
@@ -2165,85 +4403,608 @@ Real CalculateSphericalTriangleJacobianBarycentric(
 		pnode->z = dF.z * dInvR;
 	}
 
-	Node dDaG(
-		dDaF.x * (dF.y * dF.y + dF.z * dF.z)
-			- dF.x * (dDaF.y * dF.y + dDaF.z * dF.z),
-		dDaF.y * (dF.x * dF.x + dF.z * dF.z)
-			- dF.y * (dDaF.x * dF.x + dDaF.z * dF.z),
-		dDaF.z * (dF.x * dF.x + dF.y * dF.y)
-			- dF.z * (dDaF.x * dF.x + dDaF.y * dF.y));
+	Node dDaG(
+		dDaF.x * (dF.y * dF.y + dF.z * dF.z)
+			- dF.x * (dDaF.y * dF.y + dDaF.z * dF.z),
+		dDaF.y * (dF.x * dF.x + dF.z * dF.z)
+			- dF.y * (dDaF.x * dF.x + dDaF.z * dF.z),
+		dDaF.z * (dF.x * dF.x + dF.y * dF.y)
+			- dF.z * (dDaF.x * dF.x + dDaF.y * dF.y));
+
+	Node dDbG(
+		dDbF.x * (dF.y * dF.y + dF.z * dF.z)
+			- dF.x * (dDbF.y * dF.y + dDbF.z * dF.z),
+		dDbF.y * (dF.x * dF.x + dF.z * dF.z)
+			- dF.y * (dDbF.x * dF.x + dDbF.z * dF.z),
+		dDbF.z * (dF.x * dF.x + dF.y * dF.y)
+			- dF.z * (dDbF.x * dF.x + dDbF.y * dF.y));
+
+	double dDenomTerm = dInvR * dInvR * dInvR;
+
+	dDaG.x *= dDenomTerm;
+	dDaG.y *= dDenomTerm;
+	dDaG.z *= dDenomTerm;
+
+	dDbG.x *= dDenomTerm;
+	dDbG.y *= dDenomTerm;
+	dDbG.z *= dDenomTerm;
+
+	// Cross product gives local Jacobian
+	Node nodeCross = CrossProduct(dDaG, dDbG);
+
+	double dJacobian = sqrt(
+		  nodeCross.x * nodeCross.x
+		+ nodeCross.y * nodeCross.y
+		+ nodeCross.z * nodeCross.z);
+
+	return 0.5 * dJacobian;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Jacobian of the map from the unit square to the spherical triangle
+///		with given vertices at the point (dA, dB).  This uses the same
+///		arithmetic as CalculateSphericalTriangleJacobian() on raw
+///		coordinates, so that it can be inlined into vectorized loops.
+///	</summary>
+static inline double SphericalTriangleJacobian(
+	const double dA, const double dB,
+	const double dX1, const double dY1, const double dZ1,
+	const double dX2, const double dY2, const double dZ2,
+	const double dX3, const double dY3, const double dZ3
+) {
+	const double dFx = (1.0 - dB) * ((1.0 - dA) * dX1 + dA * dX2) + dB * dX3;
+	const double dFy = (1.0 - dB) * ((1.0 - dA) * dY1 + dA * dY2) + dB * dY3;
+	const double dFz = (1.0 - dB) * ((1.0 - dA) * dZ1 + dA * dZ2) + dB * dZ3;
+
+	const double dDaFx = (1.0 - dB) * (dX2 - dX1);
+	const double dDaFy = (1.0 - dB) * (dY2 - dY1);
+	const double dDaFz = (1.0 - dB) * (dZ2 - dZ1);
+
+	const double dDbFx = - (1.0 - dA) * dX1 - dA * dX2 + dX3;
+	const double dDbFy = - (1.0 - dA) * dY1 - dA * dY2 + dY3;
+	const double dDbFz = - (1.0 - dA) * dZ1 - dA * dZ2 + dZ3;
+
+	const double dInvR = 1.0 / sqrt(dFx * dFx + dFy * dFy + dFz * dFz);
+
+	const double dDenomTerm = dInvR * dInvR * dInvR;
+
+	const double dDaGx = (dDaFx * (dFy * dFy + dFz * dFz)
+		- dFx * (dDaFy * dFy + dDaFz * dFz)) * dDenomTerm;
+	const double dDaGy = (dDaFy * (dFx * dFx + dFz * dFz)
+		- dFy * (dDaFx * dFx + dDaFz * dFz)) * dDenomTerm;
+	const double dDaGz = (dDaFz * (dFx * dFx + dFy * dFy)
+		- dFz * (dDaFx * dFx + dDaFy * dFy)) * dDenomTerm;
+
+	const double dDbGx = (dDbFx * (dFy * dFy + dFz * dFz)
+		- dFx * (dDbFy * dFy + dDbFz * dFz)) * dDenomTerm;
+	const double dDbGy = (dDbFy * (dFx * dFx + dFz * dFz)
+		- dFy * (dDbFx * dFx + dDbFz * dFz)) * dDenomTerm;
+	const double dDbGz = (dDbFz * (dFx * dFx + dFy * dFy)
+		- dFz * (dDbFx * dFx + dDbFy * dFy)) * dDenomTerm;
+
+	// Cross product gives local Jacobian
+	const double dCrossX = dDaGy * dDbGz - dDaGz * dDbGy;
+	const double dCrossY = dDaGz * dDbGx - dDaGx * dDbGz;
+	const double dCrossZ = dDaGx * dDbGy - dDaGy * dDbGx;
+
+	return sqrt(
+		  dCrossX * dCrossX
+		+ dCrossY * dCrossY
+		+ dCrossZ * dCrossZ);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Accumulate the area of the spherical triangle with given vertices
+///		into dArea.  The Jacobian at all quadrature points is computed as
+///		one batch and then accumulated in order.
+///	</summary>
+static void AccumulateSphericalTriangleArea(
+	const Real dX1, const Real dY1, const Real dZ1,
+	const Real dX2, const Real dY2, const Real dZ2,
+	const Real dX3, const Real dY3, const Real dZ3,
+	double & dArea
+) {
+	const SphericalTriangleQuadrature & quad = s_quadSphericalTriangle;
+
+	double dJacobian[SphericalTriangleQuadrature::Count];
+
+#pragma omp simd
+	for (int k = 0; k < SphericalTriangleQuadrature::Count; k++) {
+		dJacobian[k] = SphericalTriangleJacobian(
+			quad.dA[k], quad.dB[k],
+			dX1, dY1, dZ1,
+			dX2, dY2, dZ2,
+			dX3, dY3, dZ3);
+	}
+
+	for (int k = 0; k < SphericalTriangleQuadrature::Count; k++) {
+		dArea += quad.dWeight[k] * dJacobian[k];
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A batch of spherical triangles, each belonging to a Face, whose
+///		Jacobians are evaluated together with the innermost loop running
+///		over triangles.  Contributions are added to the owning Face in the
+///		same order as AccumulateSphericalTriangleArea(), so the resulting
+///		areas are identical.
+///	</summary>
+class SphericalTriangleBatch {
+
+public:
+	///	<summary>
+	///		Maximum number of triangles in the batch.
+	///	</summary>
+	static const int Size = FaceAreaTriangleBatchSize;
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	SphericalTriangleBatch(
+		DataArray1D<double> & vecFaceArea
+	) :
+		m_vecFaceArea(vecFaceArea),
+		m_nTriangles(0)
+	{ }
+
+	///	<summary>
+	///		Add a triangle to the batch, evaluating the batch if full.
+	///	</summary>
+	inline void Add(
+		int ixFace,
+		const Real dX1, const Real dY1, const Real dZ1,
+		const Real dX2, const Real dY2, const Real dZ2,
+		const Real dX3, const Real dY3, const Real dZ3
+	) {
+		if (m_nTriangles == Size) {
+			Evaluate();
+		}
+
+		const int t = m_nTriangles;
+		m_ixFace[t] = ixFace;
+		m_dX1[t] = dX1; m_dY1[t] = dY1; m_dZ1[t] = dZ1;
+		m_dX2[t] = dX2; m_dY2[t] = dY2; m_dZ2[t] = dZ2;
+		m_dX3[t] = dX3; m_dY3[t] = dY3; m_dZ3[t] = dZ3;
+		m_nTriangles++;
+	}
+
+	///	<summary>
+	///		Evaluate all triangles in the batch and accumulate their areas.
+	///	</summary>
+	void Evaluate() {
+		const SphericalTriangleQuadrature & quad = s_quadSphericalTriangle;
+
+		const int nTriangles = m_nTriangles;
+
+		for (int k = 0; k < SphericalTriangleQuadrature::Count; k++) {
+			const double dA = quad.dA[k];
+			const double dB = quad.dB[k];
+
+			double * const dJacobian = m_dJacobian[k];
+
+#pragma omp simd
+			for (int t = 0; t < nTriangles; t++) {
+				dJacobian[t] = SphericalTriangleJacobian(
+					dA, dB,
+					m_dX1[t], m_dY1[t], m_dZ1[t],
+					m_dX2[t], m_dY2[t], m_dZ2[t],
+					m_dX3[t], m_dY3[t], m_dZ3[t]);
+			}
+		}
+
+		for (int t = 0; t < nTriangles; t++) {
+			double & dArea = m_vecFaceArea[m_ixFace[t]];
+			for (int k = 0; k < SphericalTriangleQuadrature::Count; k++) {
+				dArea += quad.dWeight[k] * m_dJacobian[k][t];
+			}
+		}
+
+		m_nTriangles = 0;
+	}
+
+private:
+	///	<summary>
+	///		Face areas being accumulated.
+	///	</summary>
+	DataArray1D<double> & m_vecFaceArea;
+
+	///	<summary>
+	///		Number of triangles in the batch.
+	///	</summary>
+	int m_nTriangles;
+
+	///	<summary>
+	///		Face associated with each triangle.
+	///	</summary>
+	int m_ixFace[Size];
+
+	///	<summary>
+	///		Coordinates of the vertices of each triangle.
+	///	</summary>
+	double m_dX1[Size], m_dY1[Size], m_dZ1[Size];
+	double m_dX2[Size], m_dY2[Size], m_dZ2[Size];
+	double m_dX3[Size], m_dY3[Size], m_dZ3[Size];
+
+	///	<summary>
+	///		Jacobian at each quadrature point of each triangle.
+	///	</summary>
+	double m_dJacobian[SphericalTriangleQuadrature::Count][Size];
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+Real CalculateFaceAreaQuadratureMethod(
+	const Face & face,
+	const NodeVector & nodes
+) {
+	int nTriangles = face.edges.size() - 2;
+
+	double dFaceArea = 0.0;
+
+	// Loop over all sub-triangles of this Face
+	for (int j = 0; j < nTriangles; j++) {
+		const Node & node1 = nodes[face[0]];
+		const Node & node2 = nodes[face[j+1]];
+		const Node & node3 = nodes[face[j+2]];
+
+		AccumulateSphericalTriangleArea(
+			node1.x, node1.y, node1.z,
+			node2.x, node2.y, node2.z,
+			node3.x, node3.y, node3.z,
+			dFaceArea);
+	}
+
+	return dFaceArea;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void CalculateFaceAreasQuadratureMethod(
+	const FaceVector & faces,
+	const NodeCoordinateArrays & coords,
+	int ixBegin,
+	int ixEnd,
+	DataArray1D<double> & vecFaceArea
+) {
+	const Real * dX = coords.X();
+	const Real * dY = coords.Y();
+	const Real * dZ = coords.Z();
+
+	SphericalTriangleBatch batch(vecFaceArea);
+
+	for (int i = ixBegin; i < ixEnd; i++) {
+		const Face & face = faces[i];
+
+		vecFaceArea[i] = 0.0;
+
+		// Add all sub-triangles of this Face to the batch
+		int nTriangles = face.edges.size() - 2;
+		for (int j = 0; j < nTriangles; j++) {
+			const int ix1 = face[0];
+			const int ix2 = face[j+1];
+			const int ix3 = face[j+2];
+
+			batch.Add(i,
+				dX[ix1], dY[ix1], dZ[ix1],
+				dX[ix2], dY[ix2], dZ[ix2],
+				dX[ix3], dY[ix3], dZ[ix3]);
+		}
+	}
+
+	batch.Evaluate();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void CalculateFaceAreasQuadratureMethod(
+	const PackedFaceVector & faces,
+	const NodeCoordinateArrays & coords,
+	int ixBegin,
+	int ixEnd,
+	DataArray1D<double> & vecFaceArea
+) {
+	const Real * dX = coords.X();
+	const Real * dY = coords.Y();
+	const Real * dZ = coords.Z();
+
+	SphericalTriangleBatch batch(vecFaceArea);
+
+	for (int i = ixBegin; i < ixEnd; i++) {
+		const int * pNodes = faces.GetNodes(i);
+
+		vecFaceArea[i] = 0.0;
+
+		// Add all sub-triangles of this Face to the batch
+		int nTriangles = faces.GetDegree(i) - 2;
+		for (int j = 0; j < nTriangles; j++) {
+			const int ix1 = pNodes[0];
+			const int ix2 = pNodes[j+1];
+			const int ix3 = pNodes[j+2];
+
+			batch.Add(i,
+				dX[ix1], dY[ix1], dZ[ix1],
+				dX[ix2], dY[ix2], dZ[ix2],
+				dX[ix3], dY[ix3], dZ[ix3]);
+		}
+	}
+
+	batch.Evaluate();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Signed spherical excess of the geodesic triangle with given vertices,
+///		from the vector form of L'Huilier's theorem
+///		  tan(E/2) = a.(b x c) / (|a||b||c| + (a.b)|c| + (a.c)|b| + (b.c)|a|).
+///		The triple product is formed from the edge vectors b-a and c-a so
+///		that it remains accurate for small triangles.  An estimate of the
+///		rounding error in the excess is returned in dError.
+///	</summary>
+static inline double SphericalTriangleExcess(
+	const double dX1, const double dY1, const double dZ1,
+	const double dX2, const double dY2, const double dZ2,
+	const double dX3, const double dY3, const double dZ3,
+	double & dError
+) {
+	const double dUx = dX2 - dX1;
+	const double dUy = dY2 - dY1;
+	const double dUz = dZ2 - dZ1;
+
+	const double dVx = dX3 - dX1;
+	const double dVy = dY3 - dY1;
+	const double dVz = dZ3 - dZ1;
+
+	const double dWx = dUy * dVz - dUz * dVy;
+	const double dWy = dUz * dVx - dUx * dVz;
+	const double dWz = dUx * dVy - dUy * dVx;
+
+	const double dTriple = dX1 * dWx + dY1 * dWy + dZ1 * dWz;
+
+	const double dMag1 = sqrt(dX1 * dX1 + dY1 * dY1 + dZ1 * dZ1);
+	const double dMag2 = sqrt(dX2 * dX2 + dY2 * dY2 + dZ2 * dZ2);
+	const double dMag3 = sqrt(dX3 * dX3 + dY3 * dY3 + dZ3 * dZ3);
+
+	const double dDenom =
+		  dMag1 * dMag2 * dMag3
+		+ (dX1 * dX2 + dY1 * dY2 + dZ1 * dZ2) * dMag3
+		+ (dX1 * dX3 + dY1 * dY3 + dZ1 * dZ3) * dMag2
+		+ (dX2 * dX3 + dY2 * dY3 + dZ2 * dZ3) * dMag1;
+
+	// Rounding error in the triple product, propagated through atan2
+	const double dTripleError =
+		FaceAreaExcessRoundingFactor * dMag1
+		* sqrt((dUx * dUx + dUy * dUy + dUz * dUz)
+			* (dVx * dVx + dVy * dVy + dVz * dVz));
+
+	dError = 2.0 * dTripleError
+		/ (sqrt(dTriple * dTriple + dDenom * dDenom) + 1.0e-300);
+
+	return 2.0 * atan2(dTriple, dDenom);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A batch of spherical triangles, each belonging to a Face, whose
+///		signed excess and error estimate are evaluated together with the
+///		innermost loop running over triangles.  Contributions are added to
+///		the owning Face in order.
+///	</summary>
+class SphericalExcessBatch {
+
+public:
+	///	<summary>
+	///		Maximum number of triangles in the batch.
+	///	</summary>
+	static const int Size = FaceAreaExcessBatchSize;
+
+public:
+	///	<summary>
+	///		Constructor.  The excess of each Face is accumulated into
+	///		dFaceExcess and its error estimate into dFaceError, both indexed
+	///		relative to ixFaceBegin.
+	///	</summary>
+	SphericalExcessBatch(
+		int ixFaceBegin,
+		double * dFaceExcess,
+		double * dFaceError
+	) :
+		m_ixFaceBegin(ixFaceBegin),
+		m_dFaceExcess(dFaceExcess),
+		m_dFaceError(dFaceError),
+		m_nTriangles(0)
+	{ }
+
+	///	<summary>
+	///		Add a triangle to the batch, evaluating the batch if full.
+	///	</summary>
+	inline void Add(
+		int ixFace,
+		const Real dX1, const Real dY1, const Real dZ1,
+		const Real dX2, const Real dY2, const Real dZ2,
+		const Real dX3, const Real dY3, const Real dZ3
+	) {
+		if (m_nTriangles == Size) {
+			Evaluate();
+		}
+
+		const int t = m_nTriangles;
+		m_ixFace[t] = ixFace - m_ixFaceBegin;
+		m_dX1[t] = dX1; m_dY1[t] = dY1; m_dZ1[t] = dZ1;
+		m_dX2[t] = dX2; m_dY2[t] = dY2; m_dZ2[t] = dZ2;
+		m_dX3[t] = dX3; m_dY3[t] = dY3; m_dZ3[t] = dZ3;
+		m_nTriangles++;
+	}
+
+	///	<summary>
+	///		Evaluate all triangles in the batch and accumulate their excess.
+	///	</summary>
+	void Evaluate() {
+		const int nTriangles = m_nTriangles;
+
+#pragma omp simd
+		for (int t = 0; t < nTriangles; t++) {
+			m_dExcess[t] = SphericalTriangleExcess(
+				m_dX1[t], m_dY1[t], m_dZ1[t],
+				m_dX2[t], m_dY2[t], m_dZ2[t],
+				m_dX3[t], m_dY3[t], m_dZ3[t],
+				m_dError[t]);
+		}
 
-	Node dDbG(
-		dDbF.x * (dF.y * dF.y + dF.z * dF.z)
-			- dF.x * (dDbF.y * dF.y + dDbF.z * dF.z),
-		dDbF.y * (dF.x * dF.x + dF.z * dF.z)
-			- dF.y * (dDbF.x * dF.x + dDbF.z * dF.z),
-		dDbF.z * (dF.x * dF.x + dF.y * dF.y)
-			- dF.z * (dDbF.x * dF.x + dDbF.y * dF.y));
+		for (int t = 0; t < nTriangles; t++) {
+			m_dFaceExcess[m_ixFace[t]] += m_dExcess[t];
+			m_dFaceError[m_ixFace[t]] += m_dError[t];
+		}
 
-	double dDenomTerm = dInvR * dInvR * dInvR;
+		m_nTriangles = 0;
+	}
 
-	dDaG.x *= dDenomTerm;
-	dDaG.y *= dDenomTerm;
-	dDaG.z *= dDenomTerm;
+private:
+	///	<summary>
+	///		Index of the first Face of the accumulators.
+	///	</summary>
+	int m_ixFaceBegin;
+
+	///	<summary>
+	///		Excess and error estimate being accumulated for each Face.
+	///	</summary>
+	double * m_dFaceExcess;
+	double * m_dFaceError;
+
+	///	<summary>
+	///		Number of triangles in the batch.
+	///	</summary>
+	int m_nTriangles;
+
+	///	<summary>
+	///		Face associated with each triangle, relative to m_ixFaceBegin.
+	///	</summary>
+	int m_ixFace[Size];
+
+	///	<summary>
+	///		Coordinates of the vertices of each triangle.
+	///	</summary>
+	double m_dX1[Size], m_dY1[Size], m_dZ1[Size];
+	double m_dX2[Size], m_dY2[Size], m_dZ2[Size];
+	double m_dX3[Size], m_dY3[Size], m_dZ3[Size];
+
+	///	<summary>
+	///		Excess and error estimate of each triangle.
+	///	</summary>
+	double m_dExcess[Size];
+	double m_dError[Size];
+};
 
-	dDbG.x *= dDenomTerm;
-	dDbG.y *= dDenomTerm;
-	dDbG.z *= dDenomTerm;
+///////////////////////////////////////////////////////////////////////////////
 
-	// Cross product gives local Jacobian
-	Node nodeCross = CrossProduct(dDaG, dDbG);
+Real CalculateFaceAreaExcessMethod(
+	const Face & face,
+	const NodeVector & nodes,
+	double * pdError
+) {
+	int nTriangles = face.edges.size() - 2;
 
-	double dJacobian = sqrt(
-		  nodeCross.x * nodeCross.x
-		+ nodeCross.y * nodeCross.y
-		+ nodeCross.z * nodeCross.z);
+	double dFaceExcess = 0.0;
+	double dFaceError = 0.0;
 
-	return 0.5 * dJacobian;
+	// Loop over all sub-triangles of this Face
+	for (int j = 0; j < nTriangles; j++) {
+		const Node & node1 = nodes[face[0]];
+		const Node & node2 = nodes[face[j+1]];
+		const Node & node3 = nodes[face[j+2]];
+
+		double dError;
+		dFaceExcess += SphericalTriangleExcess(
+			node1.x, node1.y, node1.z,
+			node2.x, node2.y, node2.z,
+			node3.x, node3.y, node3.z,
+			dError);
+		dFaceError += dError;
+	}
+
+	if (pdError != NULL) {
+		*pdError = dFaceError;
+	}
+
+	return fabs(dFaceExcess);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
-Real CalculateFaceAreaQuadratureMethod(
-	const Face & face,
-	const NodeVector & nodes
+void CalculateFaceAreasExcessMethod(
+	const PackedFaceVector & faces,
+	const NodeCoordinateArrays & coords,
+	int ixBegin,
+	int ixEnd,
+	DataArray1D<double> & vecFaceArea
 ) {
-	int nTriangles = face.edges.size() - 2;
+	const Real * dX = coords.X();
+	const Real * dY = coords.Y();
+	const Real * dZ = coords.Z();
 
-	const int nOrder = 6;
+	if (ixEnd <= ixBegin) {
+		return;
+	}
 
-	DataArray1D<double> dG;
-	DataArray1D<double> dW;
-	GaussQuadrature::GetPoints(nOrder, 0.0, 1.0, dG, dW);
+	std::vector<double> vecFaceExcess(ixEnd - ixBegin, 0.0);
+	std::vector<double> vecFaceError(ixEnd - ixBegin, 0.0);
 
-	double dFaceArea = 0.0;
+	SphericalExcessBatch batch(
+		ixBegin, &(vecFaceExcess[0]), &(vecFaceError[0]));
 
-	// Loop over all sub-triangles of this Face
-	for (int j = 0; j < nTriangles; j++) {
+	for (int i = ixBegin; i < ixEnd; i++) {
+		const int * pNodes = faces.GetNodes(i);
 
-		// Calculate the area of the modified Face
-		Node node1 = nodes[face[0]];
-		Node node2 = nodes[face[j+1]];
-		Node node3 = nodes[face[j+2]];
+		// Add all sub-triangles of this Face to the batch
+		int nTriangles = faces.GetDegree(i) - 2;
+		for (int j = 0; j < nTriangles; j++) {
+			const int ix1 = pNodes[0];
+			const int ix2 = pNodes[j+1];
+			const int ix3 = pNodes[j+2];
 
-		// Calculate area at quadrature node
-		for (int p = 0; p < dW.GetRows(); p++) {
-		for (int q = 0; q < dW.GetRows(); q++) {
+			batch.Add(i,
+				dX[ix1], dY[ix1], dZ[ix1],
+				dX[ix2], dY[ix2], dZ[ix2],
+				dX[ix3], dY[ix3], dZ[ix3]);
+		}
+	}
 
-			double dA = dG[p];
-			double dB = dG[q];
+	batch.Evaluate();
 
-			double dJacobian =
-				CalculateSphericalTriangleJacobian(
-					node1, node2, node3,
-					dA, dB);
+	// Accept the excess where it is accurate and use quadrature elsewhere
+	for (int i = ixBegin; i < ixEnd; i++) {
+		const double dArea = fabs(vecFaceExcess[i - ixBegin]);
 
-			dFaceArea += dW[p] * dW[q] * dJacobian;
+		if (vecFaceError[i - ixBegin] <= FaceAreaExcessTolerance * dArea) {
+			vecFaceArea[i] = dArea;
+			continue;
 		}
+
+		const int * pNodes = faces.GetNodes(i);
+
+		vecFaceArea[i] = 0.0;
+
+		int nTriangles = faces.GetDegree(i) - 2;
+		for (int j = 0; j < nTriangles; j++) {
+			const int ix1 = pNodes[0];
+			const int ix2 = pNodes[j+1];
+			const int ix3 = pNodes[j+2];
+
+			AccumulateSphericalTriangleArea(
+				dX[ix1], dY[ix1], dZ[ix1],
+				dX[ix2], dY[ix2], dZ[ix2],
+				dX[ix3], dY[ix3], dZ[ix3],
+				vecFaceArea[i]);
 		}
 	}
-
-	return dFaceArea;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -2389,6 +5150,15 @@ Real CalculateFaceArea_Concave(
 
 	if (IsFaceConcave(face, nodes)) {
 
+		// Sum the areas of a convex decomposition of this Face
+		std::vector<Face> vecConvexFaces;
+		if (ConvexifyFaceEarClipping(face, nodes, vecConvexFaces)) {
+			for (size_t i = 0; i < vecConvexFaces.size(); i++) {
+				dArea += CalculateFaceArea(vecConvexFaces[i], nodes);
+			}
+			return dArea;
+		}
+
 		// Generate a new Mesh only including this Face
 		Mesh mesh;
 		for (int j = 0; j < face.edges.size(); j++) {
@@ -2419,17 +5189,14 @@ Real CalculateFaceArea(
 	const Face & face,
 	const NodeVector & nodes
 ) {
-/*
-	double dArea1 = CalculateFaceAreaQuadratureMethod(face, nodes);
+	double dError;
+	double dArea = CalculateFaceAreaExcessMethod(face, nodes, &dError);
 
-	double dArea2 = CalculateFaceAreaKarneysMethod(face, nodes);
-
-	printf("%1.15e %1.15e\n", dArea1, dArea2);
-*/
+	if (dError <= FaceAreaExcessTolerance * dArea) {
+		return dArea;
+	}
 
 	return CalculateFaceAreaQuadratureMethod(face, nodes);
-
-	// return CalculateFaceAreaKarneysMethod(face, nodes);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -2442,7 +5209,15 @@ bool ConvexifyFace(
 	bool fVerbose
 ) {
 	Face & face = mesh.faces[iFace];
-	const int nNodes = face.edges.size()-1;
+
+	// Shapefile polygons repeat the first node at the end
+	int nNodes = face.edges.size();
+	if ((nNodes > 3) &&
+	    ((face[nNodes-1] == face[0]) ||
+	     (mesh.nodes[face[nNodes-1]] == mesh.nodes[face[0]]))
+	) {
+		nNodes--;
+	}
 	if(fVerbose) {
 		Announce("ConvexifyFace via Triangle package");
 		Announce("iFace=%i	nNodes: %i", iFace, nNodes);
@@ -2535,6 +5310,9 @@ bool ConvexifyFace(
 	// Y   -> no new nodes on the boundary (so it remains conforming)
 	// Q,V -> quiet or verbose output
 
+	// Triangle is not reentrant
+#pragma omp critical(TriangleLibrary)
+	{
 	if (fVerbose) {
 		char options[256] ="pq5jzYV";
 		AnnounceBanner();
@@ -2545,6 +5323,7 @@ bool ConvexifyFace(
 		char options[256] ="pq5jzYQ";
 		triangulate(options, &in, &out, &vorout);
 	}
+	}
 
 	// project new planar nodes onto the unit sphere
 	NodeVector newNodes;
@@ -2587,6 +5366,312 @@ bool ConvexifyFace(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		Orientation of node c relative to the great circle arc from node a
+///		to node b; positive if c lies to the left of the arc.
+///	</summary>
+inline Real ConvexifyOrientation(
+	const Node & nodeA,
+	const Node & nodeB,
+	const Node & nodeC
+) {
+	return DotProduct(CrossProduct(nodeA, nodeB), nodeC);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool ConvexifyFaceEarClipping(
+	const Face & face,
+	const NodeVector & nodes,
+	std::vector<Face> & vecFacesOut
+) {
+	static const Real Tolerance = ReferenceTolerance;
+
+	vecFacesOut.clear();
+
+	// Remove repeated nodes, including a closing node equal to the first
+	std::vector<int> vecIx;
+	vecIx.reserve(face.edges.size());
+	for (size_t i = 0; i < face.edges.size(); i++) {
+		if ((vecIx.size() != 0) &&
+		    ((face[i] == vecIx.back()) || (nodes[face[i]] == nodes[vecIx.back()]))
+		) {
+			continue;
+		}
+		vecIx.push_back(face[i]);
+	}
+	while ((vecIx.size() > 1) &&
+	       ((vecIx.back() == vecIx[0]) || (nodes[vecIx.back()] == nodes[vecIx[0]]))
+	) {
+		vecIx.pop_back();
+	}
+
+	const int nNodes = static_cast<int>(vecIx.size());
+	if (nNodes < 3) {
+		return false;
+	}
+
+	// Orientation tests on great circle arcs are only meaningful when the
+	// Face lies within a hemisphere
+	Node nodeCenter(0.0, 0.0, 0.0);
+	for (int i = 0; i < nNodes; i++) {
+		nodeCenter = nodeCenter + nodes[vecIx[i]];
+	}
+	for (int i = 0; i < nNodes; i++) {
+		if (DotProduct(nodeCenter, nodes[vecIx[i]]) <= 0.0) {
+			return false;
+		}
+	}
+
+	// Reflex and collinear nodes, which are the only nodes that may lie
+	// within an ear
+	std::vector<int> vecPrev(nNodes);
+	std::vector<int> vecNext(nNodes);
+	std::vector<char> vecRemoved(nNodes, 0);
+	std::vector<int> vecNonConvex;
+
+	for (int i = 0; i < nNodes; i++) {
+		vecPrev[i] = (i + nNodes - 1) % nNodes;
+		vecNext[i] = (i + 1) % nNodes;
+
+		Real dOrient =
+			ConvexifyOrientation(
+				nodes[vecIx[vecPrev[i]]],
+				nodes[vecIx[i]],
+				nodes[vecIx[vecNext[i]]]);
+
+		if (dOrient < Tolerance) {
+			vecNonConvex.push_back(i);
+		}
+	}
+
+	// Already convex
+	if ((nNodes == 3) || (vecNonConvex.size() == 0)) {
+		Face faceOut(nNodes);
+		for (int i = 0; i < nNodes; i++) {
+			faceOut.SetNode(i, vecIx[i]);
+		}
+		vecFacesOut.push_back(faceOut);
+		return true;
+	}
+
+	// Triangulate by ear clipping
+	std::vector< std::vector<int> > vecPieces;
+	vecPieces.reserve(nNodes - 2);
+
+	int nRemaining = nNodes;
+	int i = 0;
+	int nSinceLastEar = 0;
+
+	while (nRemaining > 3) {
+		const int ixPrev = vecPrev[i];
+		const int ixNext = vecNext[i];
+
+		const Node & nodePrev = nodes[vecIx[ixPrev]];
+		const Node & nodeCurr = nodes[vecIx[i]];
+		const Node & nodeNext = nodes[vecIx[ixNext]];
+
+		bool fEar =
+			(ConvexifyOrientation(nodePrev, nodeCurr, nodeNext) >= Tolerance);
+
+		for (size_t k = 0; fEar && (k < vecNonConvex.size()); k++) {
+			const int ixTest = vecNonConvex[k];
+			if (vecRemoved[ixTest] ||
+			    (ixTest == ixPrev) || (ixTest == i) || (ixTest == ixNext)
+			) {
+				continue;
+			}
+
+			const Node & nodeTest = nodes[vecIx[ixTest]];
+			if ((nodeTest == nodePrev) ||
+			    (nodeTest == nodeCurr) ||
+			    (nodeTest == nodeNext)
+			) {
+				continue;
+			}
+
+			if ((ConvexifyOrientation(nodePrev, nodeCurr, nodeTest) > -Tolerance) &&
+			    (ConvexifyOrientation(nodeCurr, nodeNext, nodeTest) > -Tolerance) &&
+			    (ConvexifyOrientation(nodeNext, nodePrev, nodeTest) > -Tolerance)
+			) {
+				fEar = false;
+			}
+		}
+
+		if (!fEar) {
+			i = ixNext;
+			nSinceLastEar++;
+			if (nSinceLastEar > nRemaining) {
+				return false;
+			}
+			continue;
+		}
+
+		// Clip the ear
+		std::vector<int> vecTriangle(3);
+		vecTriangle[0] = ixPrev;
+		vecTriangle[1] = i;
+		vecTriangle[2] = ixNext;
+		vecPieces.push_back(vecTriangle);
+
+		vecRemoved[i] = 1;
+		vecNext[ixPrev] = ixNext;
+		vecPrev[ixNext] = ixPrev;
+		nRemaining--;
+
+		i = ixPrev;
+		nSinceLastEar = 0;
+	}
+
+	// Remaining triangle, unless it is degenerate
+	{
+		std::vector<int> vecTriangle(3);
+		vecTriangle[0] = vecPrev[i];
+		vecTriangle[1] = i;
+		vecTriangle[2] = vecNext[i];
+
+		if (ConvexifyOrientation(
+				nodes[vecIx[vecTriangle[0]]],
+				nodes[vecIx[vecTriangle[1]]],
+				nodes[vecIx[vecTriangle[2]]]) > -Tolerance
+		) {
+			vecPieces.push_back(vecTriangle);
+		}
+	}
+
+	// Diagonals of the triangulation, as (node, node, triangle) with the
+	// smaller node first; edges of the Face are not diagonals
+	std::vector< std::pair< std::pair<int,int>, int> > vecDiagonalSides;
+	for (size_t t = 0; t < vecPieces.size(); t++) {
+		for (int k = 0; k < 3; k++) {
+			int ixA = vecPieces[t][k];
+			int ixB = vecPieces[t][(k+1)%3];
+			if ((ixB == (ixA + 1) % nNodes) || (ixA == (ixB + 1) % nNodes)) {
+				continue;
+			}
+			vecDiagonalSides.push_back(
+				std::pair< std::pair<int,int>, int>(
+					std::pair<int,int>(std::min(ixA,ixB), std::max(ixA,ixB)),
+					static_cast<int>(t)));
+		}
+	}
+	std::sort(vecDiagonalSides.begin(), vecDiagonalSides.end());
+
+	// Hertel-Mehlhorn: remove diagonals that are not needed for convexity
+	std::vector<int> vecPieceParent(vecPieces.size());
+	for (size_t t = 0; t < vecPieces.size(); t++) {
+		vecPieceParent[t] = static_cast<int>(t);
+	}
+
+	for (size_t d = 0; d + 1 < vecDiagonalSides.size(); d++) {
+		if (vecDiagonalSides[d].first != vecDiagonalSides[d+1].first) {
+			continue;
+		}
+
+		int iP = vecDiagonalSides[d].second;
+		while (vecPieceParent[iP] != iP) {
+			iP = vecPieceParent[iP];
+		}
+		int iQ = vecDiagonalSides[d+1].second;
+		while (vecPieceParent[iQ] != iQ) {
+			iQ = vecPieceParent[iQ];
+		}
+		d++;
+
+		if (iP == iQ) {
+			continue;
+		}
+
+		const std::vector<int> & vecP = vecPieces[iP];
+		const std::vector<int> & vecQ = vecPieces[iQ];
+
+		const int ixU = vecDiagonalSides[d].first.first;
+		const int ixV = vecDiagonalSides[d].first.second;
+
+		// Find directed edge A->B in P; Q then contains B->A
+		int nP = static_cast<int>(vecP.size());
+		int nQ = static_cast<int>(vecQ.size());
+		int kP = (-1);
+		for (int k = 0; k < nP; k++) {
+			int ixA = vecP[k];
+			int ixB = vecP[(k+1)%nP];
+			if (((ixA == ixU) && (ixB == ixV)) || ((ixA == ixV) && (ixB == ixU))) {
+				kP = k;
+				break;
+			}
+		}
+		if (kP == (-1)) {
+			continue;
+		}
+		const int ixA = vecP[kP];
+		const int ixB = vecP[(kP+1)%nP];
+
+		int kQ = (-1);
+		for (int k = 0; k < nQ; k++) {
+			if ((vecQ[k] == ixB) && (vecQ[(k+1)%nQ] == ixA)) {
+				kQ = k;
+				break;
+			}
+		}
+		if (kQ == (-1)) {
+			continue;
+		}
+
+		// Merged piece is P from B around to A followed by Q strictly
+		// between A and B
+		std::vector<int> vecMerged;
+		vecMerged.reserve(nP + nQ - 2);
+		for (int k = 0; k < nP; k++) {
+			vecMerged.push_back(vecP[(kP + 1 + k) % nP]);
+		}
+		for (int k = 2; k < nQ; k++) {
+			vecMerged.push_back(vecQ[(kQ + k) % nQ]);
+		}
+
+		// Check convexity at A and B
+		const int nMerged = static_cast<int>(vecMerged.size());
+		const int kA = nP - 1;
+		const int kB = 0;
+
+		Real dOrientA =
+			ConvexifyOrientation(
+				nodes[vecIx[vecMerged[kA-1]]],
+				nodes[vecIx[vecMerged[kA]]],
+				nodes[vecIx[vecMerged[(kA+1)%nMerged]]]);
+
+		Real dOrientB =
+			ConvexifyOrientation(
+				nodes[vecIx[vecMerged[nMerged-1]]],
+				nodes[vecIx[vecMerged[kB]]],
+				nodes[vecIx[vecMerged[kB+1]]]);
+
+		if ((dOrientA <= -Tolerance) || (dOrientB <= -Tolerance)) {
+			continue;
+		}
+
+		vecPieces[iP].swap(vecMerged);
+		vecPieces[iQ].clear();
+		vecPieceParent[iQ] = iP;
+	}
+
+	// Output convex Faces
+	for (size_t t = 0; t < vecPieces.size(); t++) {
+		const int nPieceNodes = static_cast<int>(vecPieces[t].size());
+		if (nPieceNodes < 3) {
+			continue;
+		}
+		Face faceOut(nPieceNodes);
+		for (int k = 0; k < nPieceNodes; k++) {
+			faceOut.SetNode(k, vecIx[vecPieces[t][k]]);
+		}
+		vecFacesOut.push_back(faceOut);
+	}
+
+	return (vecFacesOut.size() != 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 bool ConvexifyFaceBayazit(
 	Mesh & mesh,
 	Mesh & meshout,
@@ -2843,30 +5928,13 @@ void ConvexifyMesh(
 	Mesh & mesh,
 	bool fVerbose
 ) {
-	_EXCEPTION();
-/*
-	char szBuffer[256];
-
-	// Loop through all Faces in the Mesh
-	int nFaces = mesh.faces.size();
-	for (int f = 0; f < nFaces; f++) {
-		if (fVerbose) {
-			sprintf(szBuffer, "Face %i", f);
-			AnnounceStartBlock(szBuffer);
-		}
-
-		// Adjust current Face index
-		bool fConcaveFace = ConvexifyFace(mesh, mesh, f, true, fVerbose);
-		if (fConcaveFace) {
-			f--;
-			nFaces--;
-		}
+	// Move the nodes and Faces out of the mesh rather than copying the
+	// whole mesh; all other data (masks, dimensions, file name) is retained
+	Mesh meshIn;
+	meshIn.nodes.swap(mesh.nodes);
+	meshIn.faces.swap(mesh.faces);
 
-		if (fVerbose) {
-			AnnounceEndBlock("Done");
-		}
-	}
-*/
+	ConvexifyMesh(meshIn, mesh, fVerbose);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -2876,10 +5944,9 @@ void ConvexifyMesh(
 	Mesh & meshout,
 	bool fVerbose
 ) {
-	char szBuffer[256];
-
-	// Copy all nodes to output mesh
-	meshout.nodes.clear();
+	// Concave Faces are divided without adding nodes, so all nodes are
+	// retained in the output mesh
+	meshout.nodes = mesh.nodes;
 
 	// Remove all Faces from output mesh
 	meshout.faces.clear();
@@ -2887,32 +5954,74 @@ void ConvexifyMesh(
 	// Clear the MultiFaceMap
 	meshout.vecMultiFaceMap.clear();
 
-	// Loop through all Faces in the input Mesh
-	int nFaces = mesh.faces.size();
+	// Decompose concave Faces in parallel
+	const int nFaces = mesh.faces.size();
+
+	enum {
+		FaceConvex = 0,
+		FaceDecomposed = 1,
+		FaceNotDecomposed = 2
+	};
+
+	std::vector<char> vecFaceStatus(nFaces, FaceConvex);
+	std::vector< std::vector<Face> > vecConvexFaces(nFaces);
+
+#pragma omp parallel for schedule(dynamic, 64)
 	for (int f = 0; f < nFaces; f++) {
-		if (fVerbose) {
-			sprintf(szBuffer, "Face %i", f);
-			AnnounceStartBlock(szBuffer);
+		if (!IsFaceConcave(mesh.faces[f], mesh.nodes)) {
+			continue;
+		}
+		if (ConvexifyFaceEarClipping(
+				mesh.faces[f], mesh.nodes, vecConvexFaces[f])
+		) {
+			vecFaceStatus[f] = FaceDecomposed;
+		} else {
+			vecFaceStatus[f] = FaceNotDecomposed;
 		}
+	}
 
-		// Adjust current Face index
-		int nMeshSize = meshout.faces.size();
+	// Assemble the output mesh in order of the input Faces
+	int nConcaveFaces = 0;
+	int nFallbackFaces = 0;
+
+	for (int f = 0; f < nFaces; f++) {
+		if (vecFaceStatus[f] == FaceConvex) {
+			meshout.faces.push_back(mesh.faces[f]);
+			meshout.vecMultiFaceMap.push_back(f);
+			continue;
+		}
 
-		bool fConcaveFace = ConvexifyFace(mesh, meshout, f, false, fVerbose);
+		nConcaveFaces++;
 
-		if (fConcaveFace) {
-			int nAddedFaces = meshout.faces.size() - nMeshSize;
-			for (int i = 0; i < nAddedFaces; i++) {
+		if (vecFaceStatus[f] == FaceDecomposed) {
+			for (size_t i = 0; i < vecConvexFaces[f].size(); i++) {
+				meshout.faces.push_back(vecConvexFaces[f][i]);
 				meshout.vecMultiFaceMap.push_back(f);
 			}
+			std::vector<Face>().swap(vecConvexFaces[f]);
+			continue;
+		}
 
-		} else {
-			meshout.faces.push_back(mesh.faces[f]);
+		// Ear clipping failed on this Face; use Triangle
+		nFallbackFaces++;
+
+		int nMeshSize = meshout.faces.size();
+
+		ConvexifyFace(mesh, meshout, f, false, fVerbose);
+
+		int nAddedFaces = meshout.faces.size() - nMeshSize;
+		for (int i = 0; i < nAddedFaces; i++) {
 			meshout.vecMultiFaceMap.push_back(f);
 		}
+	}
 
-		if (fVerbose) {
-			AnnounceEndBlock("Done");
+	if (fVerbose) {
+		Announce("%i concave faces divided into %i convex faces",
+			nConcaveFaces,
+			static_cast<int>(meshout.faces.size()) - (nFaces - nConcaveFaces));
+		if (nFallbackFaces != 0) {
+			Announce("%i faces triangulated via Triangle package",
+				nFallbackFaces);
 		}
 	}
 
@@ -2923,3 +6032,105 @@ void ConvexifyMesh(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+
+void GenerateDualMesh(
+	Mesh & meshin,
+	Mesh & meshout,
+	bool fVerbose
+) {
+	const int nNodes = meshin.nodes.size();
+	const int nFaces = meshin.faces.size();
+
+	if (meshin.revnodearray.size() != static_cast<size_t>(nNodes)) {
+		meshin.ConstructReverseNodeArray();
+	}
+
+	meshout.Clear();
+	meshout.nodes.resize(nFaces);
+	meshout.faces.resize(nNodes);
+
+	// Nodes of the dual at the normalized centroid of each Face
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < nFaces; i++) {
+		const Face & face = meshin.faces[i];
+		const int nEdges = face.edges.size();
+
+		Node node;
+		for (int j = 0; j < nEdges; j++) {
+			node.x += meshin.nodes[face[j]].x;
+			node.y += meshin.nodes[face[j]].y;
+			node.z += meshin.nodes[face[j]].z;
+		}
+
+		node.x /= static_cast<double>(nEdges);
+		node.y /= static_cast<double>(nEdges);
+		node.z /= static_cast<double>(nEdges);
+
+		double dMag = node.Magnitude();
+
+		node.x /= dMag;
+		node.y /= dMag;
+		node.z /= dMag;
+
+		meshout.nodes[i] = node;
+	}
+
+	// Faces of the dual, with the adjacent Faces of each node ordered by
+	// angle about the node starting from the lowest Face index
+	int ixInvalidNode = nNodes;
+
+#pragma omp parallel for schedule(static) reduction(min:ixInvalidNode)
+	for (int i = 0; i < nNodes; i++) {
+		const ReverseNodeArray::FaceRange rangeFaces = meshin.revnodearray[i];
+		const int nAdjFaces = rangeFaces.size();
+
+		if (nAdjFaces < 3) {
+			ixInvalidNode = std::min(ixInvalidNode, i);
+			continue;
+		}
+
+		// Tangent frame at the node
+		const Node & nodeCentral = meshin.nodes[i];
+
+		Node nodeE1 = meshout.nodes[rangeFaces[0]];
+		nodeE1 = nodeE1 - nodeCentral * DotProduct(nodeE1, nodeCentral);
+		nodeE1 = nodeE1 / nodeE1.Magnitude();
+
+		const Node nodeE2 = CrossProduct(nodeCentral, nodeE1);
+
+		std::vector< std::pair<double, int> > vecAngles(nAdjFaces);
+		vecAngles[0] = std::pair<double, int>(0.0, rangeFaces[0]);
+		for (int j = 1; j < nAdjFaces; j++) {
+			const Node & nodeAdj = meshout.nodes[rangeFaces[j]];
+
+			double dAngle =
+				atan2(DotProduct(nodeAdj, nodeE2), DotProduct(nodeAdj, nodeE1));
+			if (dAngle < 0.0) {
+				dAngle += 2.0 * M_PI;
+			}
+			vecAngles[j] = std::pair<double, int>(dAngle, rangeFaces[j]);
+		}
+
+		std::sort(vecAngles.begin() + 1, vecAngles.end());
+
+		Face face(nAdjFaces);
+		for (int j = 0; j < nAdjFaces; j++) {
+			face.SetNode(j, vecAngles[j].second);
+		}
+		meshout.faces[i] = face;
+	}
+
+	if (ixInvalidNode != nNodes) {
+		_EXCEPTION1("Node %i is adjacent to fewer than three Faces; "
+			"the dual can only be generated for meshes covering the sphere",
+			ixInvalidNode);
+	}
+
+	if (fVerbose) {
+		Announce("Dual mesh size: Nodes [%i] Elements [%i]",
+			meshout.nodes.size(), meshout.faces.size());
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
@@ -28,6 +28,8 @@
 #include <string>
 #include <cmath>
 #include <cassert>
+#include <cstdint>
+#include <algorithm>
 
 #if defined(OVERLAPMESH_USE_UNSORTED_MAP)
 #include <unordered_map>
@@ -35,6 +37,9 @@
 #if defined(OVERLAPMESH_USE_NODE_MULTIMAP)
 #include "node_multimap_3d.h"
 #endif
+#if defined(OVERLAPMESH_USE_NODE_HASHMAP)
+#include "node_hashmap_3d.h"
+#endif
 
 #include "Exception.h"
 #include "DataArray1D.h"
@@ -225,6 +230,115 @@ public:
 ///	</summary>
 typedef std::vector<Node> NodeVector;
 
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Coordinates of the Nodes in a NodeVector, stored as separate
+///		x, y and z arrays (structure-of-arrays) aligned to a 64-byte
+///		boundary.  This is a snapshot of the NodeVector and must be
+///		reassigned after the NodeVector is modified.
+///	</summary>
+class NodeCoordinateArrays {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	NodeCoordinateArrays() :
+		m_pBuffer(NULL),
+		m_sSize(0),
+		m_pX(NULL),
+		m_pY(NULL),
+		m_pZ(NULL)
+	{ }
+
+	///	<summary>
+	///		Constructor from a NodeVector.
+	///	</summary>
+	explicit NodeCoordinateArrays(
+		const NodeVector & nodes
+	) :
+		m_pBuffer(NULL),
+		m_sSize(0),
+		m_pX(NULL),
+		m_pY(NULL),
+		m_pZ(NULL)
+	{
+		Assign(nodes);
+	}
+
+	///	<summary>
+	///		Destructor.
+	///	</summary>
+	~NodeCoordinateArrays() {
+		Deallocate();
+	}
+
+private:
+	///	<summary>
+	///		Copy constructor (disabled).
+	///	</summary>
+	NodeCoordinateArrays(const NodeCoordinateArrays &);
+
+	///	<summary>
+	///		Assignment operator (disabled).
+	///	</summary>
+	NodeCoordinateArrays & operator=(const NodeCoordinateArrays &);
+
+public:
+	///	<summary>
+	///		Copy the coordinates of all Nodes in the NodeVector.
+	///	</summary>
+	void Assign(
+		const NodeVector & nodes
+	);
+
+	///	<summary>
+	///		Release all memory.
+	///	</summary>
+	void Deallocate();
+
+	///	<summary>
+	///		Number of Nodes.
+	///	</summary>
+	size_t size() const {
+		return m_sSize;
+	}
+
+	///	<summary>
+	///		Coordinate arrays.
+	///	</summary>
+	const Real * X() const {
+		return m_pX;
+	}
+
+	const Real * Y() const {
+		return m_pY;
+	}
+
+	const Real * Z() const {
+		return m_pZ;
+	}
+
+private:
+	///	<summary>
+	///		Buffer containing all three coordinate arrays.
+	///	</summary>
+	void * m_pBuffer;
+
+	///	<summary>
+	///		Number of Nodes.
+	///	</summary>
+	size_t m_sSize;
+
+	///	<summary>
+	///		Pointers to the coordinate arrays within the buffer.
+	///	</summary>
+	Real * m_pX;
+	Real * m_pY;
+	Real * m_pZ;
+};
+
 ///	<summary>
 ///		A map between Nodes and indices.
 ///	</summary>
@@ -236,6 +350,15 @@ typedef std::map<Node, int> NodeMap;
 typedef node_multimap_3d<Node, int> NodeMap;
 #endif
 
+#if defined(OVERLAPMESH_USE_NODE_HASHMAP)
+typedef node_hashmap_3d<Node, int> NodeMap;
+
+///	<summary>
+///		A map between Nodes and indices that may be updated concurrently.
+///	</summary>
+typedef node_hashmap_3d_concurrent<Node> ConcurrentNodeMap;
+#endif
+
 #if defined(OVERLAPMESH_USE_UNSORTED_MAP)
 ///	<summary>
 ///		Hasher for a Node.
@@ -529,7 +652,112 @@ public:
 
 typedef std::vector<Edge> EdgeVector;
 
-typedef std::map<Edge, FacePair> EdgeMap;
+///	<summary>
+///		A map between Edges and the pair of Faces on either side.  Entries
+///		are stored contiguously and sorted by Edge, so lookup is a binary
+///		search and iteration visits Edges in the same order as a
+///		std::map<Edge, FacePair>.  The map is populated in bulk by
+///		Mesh::ConstructEdgeMap().
+///	</summary>
+class EdgeMap {
+
+public:
+	typedef std::pair<Edge, FacePair> value_type;
+
+	typedef std::vector<value_type>::iterator iterator;
+
+	typedef std::vector<value_type>::const_iterator const_iterator;
+
+public:
+	///	<summary>
+	///		Iterators.
+	///	</summary>
+	iterator begin() {
+		return m_vecEntries.begin();
+	}
+
+	const_iterator begin() const {
+		return m_vecEntries.begin();
+	}
+
+	iterator end() {
+		return m_vecEntries.end();
+	}
+
+	const_iterator end() const {
+		return m_vecEntries.end();
+	}
+
+	///	<summary>
+	///		Number of Edges in the map.
+	///	</summary>
+	size_t size() const {
+		return m_vecEntries.size();
+	}
+
+	///	<summary>
+	///		Check if the map is empty.
+	///	</summary>
+	bool empty() const {
+		return m_vecEntries.empty();
+	}
+
+	///	<summary>
+	///		Remove all Edges from the map.
+	///	</summary>
+	void clear() {
+		std::vector<value_type>().swap(m_vecEntries);
+	}
+
+	///	<summary>
+	///		Find the entry associated with the given Edge, or end() if the
+	///		Edge is not in the map.
+	///	</summary>
+	iterator find(const Edge & edge) {
+		iterator iter =
+			std::lower_bound(
+				m_vecEntries.begin(), m_vecEntries.end(), edge, CompareKey);
+
+		if ((iter != m_vecEntries.end()) && !(edge < iter->first)) {
+			return iter;
+		}
+		return m_vecEntries.end();
+	}
+
+	const_iterator find(const Edge & edge) const {
+		const_iterator iter =
+			std::lower_bound(
+				m_vecEntries.begin(), m_vecEntries.end(), edge, CompareKey);
+
+		if ((iter != m_vecEntries.end()) && !(edge < iter->first)) {
+			return iter;
+		}
+		return m_vecEntries.end();
+	}
+
+	///	<summary>
+	///		Replace the contents of the map with a vector of entries, which
+	///		must be sorted by Edge without repeated Edges.
+	///	</summary>
+	void Assign(std::vector<value_type> & vecEntries) {
+		m_vecEntries.swap(vecEntries);
+		std::vector<value_type>().swap(vecEntries);
+	}
+
+private:
+	///	<summary>
+	///		Comparator between an entry and an Edge.
+	///	</summary>
+	static bool CompareKey(const value_type & entry, const Edge & edge) {
+		return (entry.first < edge);
+	}
+
+private:
+	///	<summary>
+	///		Entries of the map, sorted by Edge.
+	///	</summary>
+	std::vector<value_type> m_vecEntries;
+};
 
 typedef EdgeMap::value_type EdgeMapPair;
 
@@ -537,7 +765,7 @@ typedef EdgeMap::iterator EdgeMapIterator;
 
 typedef EdgeMap::const_iterator EdgeMapConstIterator;
 
-typedef std::vector<EdgeMap::iterator> EdgeMapIteratorVector;
+typedef std::vector<EdgeMapIterator> EdgeMapIteratorVector;
 
 typedef std::set<Edge> EdgeSet;
 
@@ -620,203 +848,991 @@ typedef std::vector<Face> FaceVector;
 ///////////////////////////////////////////////////////////////////////////////
 
 ///	<summary>
-///		A reverse node array stores all faces associated with a given node.
-///	</summary>
-typedef std::vector< std::set<int> > ReverseNodeArray;
-
-///////////////////////////////////////////////////////////////////////////////
-
-///	<summary>
-///		A mesh.
+///		A read-only view of the node indices of one Face in a
+///		PackedFaceVector.
 ///	</summary>
-class Mesh {
-
-public:
-    ///	<summary>
-    ///		Type of standard mesh
-    ///	</summary>
-    enum MeshType {
-        MeshType_Unknown = -1,
-        MeshType_CubedSphere = 0,
-        MeshType_RLL = 1,
-        MeshType_IcosaHedral = 2,
-        MeshType_IcosaHedralDual = 3,
-        MeshType_Overlap = 4,
-		MeshType_UTM = 5,
-		MeshType_Transect = 6
-    };
-
-    MeshType type;
+class PackedFaceView {
 
 public:
 	///	<summary>
-	///		Filename for this mesh.
+	///		Constructor.
 	///	</summary>
-	std::string strFileName;
+	PackedFaceView(
+		const int * pNodes,
+		int nDegree
+	) :
+		m_pNodes(pNodes),
+		m_nDegree(nDegree)
+	{ }
 
 	///	<summary>
-	///		Vector of Nodes for this mesh.
+	///		Number of nodes (and edges) of the Face.
 	///	</summary>
-	NodeVector nodes;
-
-	///	<summary>
-	///		Vector of Faces for this mesh.
-	///	<summary>
-	FaceVector faces;
+	inline int size() const {
+		return m_nDegree;
+	}
 
 	///	<summary>
-	///		Vector of first mesh Face indices.
+	///		Node index accessor, equivalent to Face::operator[].
 	///	</summary>
-	std::vector<int> vecSourceFaceIx;
+	inline int operator[](int ix) const {
+		return m_pNodes[ix];
+	}
 
 	///	<summary>
-	///		Vector of second mesh Face indices.
+	///		Iterators over the node indices.
 	///	</summary>
-	std::vector<int> vecTargetFaceIx;
+	inline const int * begin() const {
+		return m_pNodes;
+	}
+
+	inline const int * end() const {
+		return m_pNodes + m_nDegree;
+	}
 
+private:
 	///	<summary>
-	///		Vector of Face areas.
+	///		Node indices of the Face.
 	///	</summary>
-	DataArray1D<double> vecFaceArea;
+	const int * m_pNodes;
 
 	///	<summary>
-	///		Vector storing mask variable for this mesh.
+	///		Number of nodes of the Face.
 	///	</summary>
-	std::vector<int> vecMask;
+	int m_nDegree;
+};
+
+///	<summary>
+///		The Faces of a FaceVector packed into a single array of node indices
+///		in compressed sparse row format.  If all Faces have the same number
+///		of nodes the offsets are not stored, and if all edges are great
+///		circle arcs the edge types are not stored, so that a quadrilateral
+///		mesh requires 16 bytes per Face.  Edges are implied by consecutive
+///		node indices, as in Face::SetNode().
+///	</summary>
+class PackedFaceVector {
 
+public:
 	///	<summary>
-	///		EdgeMap for this mesh.
+	///		Constructor.
 	///	</summary>
-	EdgeMap edgemap;
+	PackedFaceVector() :
+		m_sSize(0),
+		m_nUniformDegree(0),
+		m_nMaxDegree(0)
+	{ }
 
 	///	<summary>
-	///		ReverseNodeArray for this mesh.
+	///		Constructor from a FaceVector.
 	///	</summary>
-	ReverseNodeArray revnodearray;
+	explicit PackedFaceVector(
+		const FaceVector & faces
+	) :
+		m_sSize(0),
+		m_nUniformDegree(0),
+		m_nMaxDegree(0)
+	{
+		Assign(faces);
+	}
 
+public:
 	///	<summary>
-	///		Indices of the original Faces for this mesh (for use when
-	///		the original mesh has been subdivided).
+	///		Pack all Faces of the FaceVector.
 	///	</summary>
-	std::vector<int> vecMultiFaceMap;
+	void Assign(
+		const FaceVector & faces
+	);
 
 	///	<summary>
-	///		Grid dimensions.
-	///	</sumamry>
-	std::vector<int> vecGridDimSize;
+	///		Unpack all Faces into a FaceVector.
+	///	</summary>
+	void Unpack(
+		FaceVector & faces
+	) const;
 
 	///	<summary>
-	///		Grid dimension names.
-	///	</sumamry>
-	std::vector<std::string> vecGridDimName;
+	///		Release all memory.
+	///	</summary>
+	void Deallocate();
 
-public:
 	///	<summary>
-	///		Default constructor.
+	///		Number of Faces.
 	///	</summary>
-    Mesh() : type(MeshType_Unknown) {
+	inline size_t size() const {
+		return m_sSize;
 	}
 
 	///	<summary>
-	///		Constructor with input mesh parameter.
+	///		Number of nodes of every Face, or 0 if Faces have different
+	///		numbers of nodes.
 	///	</summary>
-	Mesh(const std::string & strFile) {
-		Read(strFile);
+	inline int GetUniformDegree() const {
+		return m_nUniformDegree;
 	}
 
-public:
 	///	<summary>
-	///		Clear the contents of the mesh.
+	///		Maximum number of nodes of any Face.
 	///	</summary>
-	void Clear();
+	inline int GetMaxDegree() const {
+		return m_nMaxDegree;
+	}
 
 	///	<summary>
-	///		Construct the EdgeMap from the NodeVector and FaceVector.
+	///		Offset of the first node index of the specified Face.
 	///	</summary>
-	void ConstructEdgeMap(
-	  bool fVerbose = true
-	);
+	inline size_t GetOffset(size_t ix) const {
+		if (m_nUniformDegree != 0) {
+			return ix * static_cast<size_t>(m_nUniformDegree);
+		}
+		return m_vecOffsets[ix];
+	}
 
 	///	<summary>
-	///		Construct the ReverseNodeArray from the NodeVector and FaceVector.
+	///		Number of nodes of the specified Face.
 	///	</summary>
-	void ConstructReverseNodeArray();
+	inline int GetDegree(size_t ix) const {
+		if (m_nUniformDegree != 0) {
+			return m_nUniformDegree;
+		}
+		return static_cast<int>(m_vecOffsets[ix+1] - m_vecOffsets[ix]);
+	}
 
 	///	<summary>
-	///		Calculate Face areas.
+	///		Node indices of the specified Face.
 	///	</summary>
-	Real CalculateFaceAreas(
-		bool fContainsConcaveFaces
-	);
+	inline const int * GetNodes(size_t ix) const {
+		return &(m_vecNodes[GetOffset(ix)]);
+	}
 
 	///	<summary>
-	///		Calculate Face areas from an Overlap mesh.
+	///		View of the specified Face.
 	///	</summary>
-	Real CalculateFaceAreasFromOverlap(
-		const Mesh & meshOverlap
-	);
+	inline PackedFaceView operator[](size_t ix) const {
+		return PackedFaceView(GetNodes(ix), GetDegree(ix));
+	}
 
 	///	<summary>
-	///		Sort Faces by the opposite source mesh.
+	///		Type of the edge from local node ixLocal to the next local node
+	///		of the specified Face.
 	///	</summary>
-	void ExchangeFirstAndSecondMesh();
+	inline Edge::Type GetEdgeType(size_t ix, int ixLocal) const {
+		if (m_vecEdgeTypes.size() == 0) {
+			return Edge::Type_Default;
+		}
+		return static_cast<Edge::Type>(m_vecEdgeTypes[GetOffset(ix) + ixLocal]);
+	}
 
 	///	<summary>
-	///		Remove coincident nodes from the Mesh and adjust indices in faces.
+	///		Check if all edges are great circle arcs.
 	///	</summary>
-	void RemoveCoincidentNodes(
-	  bool fVerbose = true
-	);
+	inline bool HasOnlyGreatCircleArcs() const {
+		return (m_vecEdgeTypes.size() == 0);
+	}
 
+private:
 	///	<summary>
-	///		Write the mesh to a NetCDF file in Exodus format.
+	///		Number of Faces.
 	///	</summary>
-	void Write(
-		const std::string & strFile,
-		NcFile::FileFormat eFileFormat = NcFile::Netcdf4
-	) const;
+	size_t m_sSize;
 
 	///	<summary>
-	///		Write the mesh to a NetCDF file in SCRIP format.
+	///		Number of nodes of every Face, or 0 if not uniform.
 	///	</summary>
-	void WriteScrip(
-		const std::string & strFile,
-		NcFile::FileFormat eFileFormat = NcFile::Netcdf4
-	) const;
+	int m_nUniformDegree;
 
 	///	<summary>
-	///		Write the mesh to a NetCDF file in UGRID format.
+	///		Maximum number of nodes of any Face.
 	///	</summary>
-	void WriteUGRID(
-		const std::string & strFile,
-		NcFile::FileFormat eFileFormat = NcFile::Netcdf4
-	) const;
+	int m_nMaxDegree;
 
 	///	<summary>
-	///		Read the mesh from a NetCDF file.
+	///		Node indices of all Faces.
 	///	</summary>
-	void Read(const std::string & strFile);
+	std::vector<int> m_vecNodes;
 
 	///	<summary>
-	///		Remove zero edges from all Faces.
+	///		Offsets of each Face into m_vecNodes (size() + 1 entries), or
+	///		empty if the number of nodes is uniform.
 	///	</summary>
-	void RemoveZeroEdges();
+	std::vector<size_t> m_vecOffsets;
 
 	///	<summary>
-	///		Validate the Mesh.
+	///		Edge types of all Faces, or empty if all edges are great circle
+	///		arcs.
 	///	</summary>
-	void Validate() const;
+	std::vector<signed char> m_vecEdgeTypes;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
 
 ///	<summary>
-///		Location data returned from FindFaceFromNode()
-///		Generate a PathSegmentVector describing the path around the face
-///		ixCurrentFirstFace.
+///		A reverse node array stores all faces associated with a given node.
+///		Face indices for all nodes are stored contiguously in compressed
+///		sparse row format, in increasing order for each node.  The array
+///		is populated by Mesh::ConstructReverseNodeArray().
 ///	</summary>
-struct FindFaceStruct {
-	
+class ReverseNodeArray {
+
+public:
+	///	<summary>
+	///		A read-only range of face indices associated with a node.
+	///	</summary>
+	class FaceRange {
+
+	public:
+		typedef const int * const_iterator;
+
+	public:
+		///	<summary>
+		///		Constructor.
+		///	</summary>
+		FaceRange(
+			const int * pBegin,
+			const int * pEnd
+		) :
+			m_pBegin(pBegin),
+			m_pEnd(pEnd)
+		{ }
+
+		///	<summary>
+		///		Iterators.
+		///	</summary>
+		const_iterator begin() const {
+			return m_pBegin;
+		}
+
+		const_iterator end() const {
+			return m_pEnd;
+		}
+
+		///	<summary>
+		///		Number of faces in this range.
+		///	</summary>
+		size_t size() const {
+			return static_cast<size_t>(m_pEnd - m_pBegin);
+		}
+
+		///	<summary>
+		///		Accessor.
+		///	</summary>
+		int operator[](size_t i) const {
+			return m_pBegin[i];
+		}
+
+	private:
+		///	<summary>
+		///		Pointers to the first and one past the last face index.
+		///	</summary>
+		const int * m_pBegin;
+		const int * m_pEnd;
+	};
+
+public:
+	///	<summary>
+	///		Number of nodes in the array.
+	///	</summary>
+	size_t size() const {
+		return (m_vecOffsets.size() == 0)?(0):(m_vecOffsets.size() - 1);
+	}
+
+	///	<summary>
+	///		Remove all entries from the array.
+	///	</summary>
+	void clear() {
+		std::vector<size_t>().swap(m_vecOffsets);
+		std::vector<int>().swap(m_vecFaces);
+	}
+
+	///	<summary>
+	///		Get the faces associated with the given node.
+	///	</summary>
+	FaceRange operator[](int ixNode) const {
+		const int * pFaces = m_vecFaces.data();
+		return FaceRange(
+			pFaces + m_vecOffsets[ixNode],
+			pFaces + m_vecOffsets[ixNode+1]);
+	}
+
+	///	<summary>
+	///		Replace the contents of the array.  vecOffsets has one more
+	///		entry than the number of nodes and indexes into vecFaces.
+	///	</summary>
+	void Assign(
+		std::vector<size_t> & vecOffsets,
+		std::vector<int> & vecFaces
+	) {
+		m_vecOffsets.swap(vecOffsets);
+		m_vecFaces.swap(vecFaces);
+		std::vector<size_t>().swap(vecOffsets);
+		std::vector<int>().swap(vecFaces);
+	}
+
+private:
+	///	<summary>
+	///		Offsets into m_vecFaces for each node.
+	///	</summary>
+	std::vector<size_t> m_vecOffsets;
+
+	///	<summary>
+	///		Face indices associated with each node.
+	///	</summary>
+	std::vector<int> m_vecFaces;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		The triangulation of the Faces of a mesh used for quadrature.  A
+///		triangular Face is a single sub-triangle and other Faces are split
+///		into a fan of sub-triangles about the normalized mean of their
+///		Nodes.  The fan centers and the areas of all sub-triangles are
+///		stored in flat arrays, with the sub-triangles of each Face stored
+///		contiguously.  The triangulation is populated by
+///		Mesh::ConstructTriangulation().
+///	</summary>
+class FaceTriangulation {
+
+public:
+	///	<summary>
+	///		Number of Faces in the triangulation.
+	///	</summary>
+	size_t size() const {
+		return (m_vecTriangleBegin.size() == 0)?(0):(m_vecTriangleBegin.size() - 1);
+	}
+
+	///	<summary>
+	///		Remove all entries from the triangulation.
+	///	</summary>
+	void clear() {
+		std::vector<size_t>().swap(m_vecTriangleBegin);
+		std::vector<double>().swap(m_vecCenterX);
+		std::vector<double>().swap(m_vecCenterY);
+		std::vector<double>().swap(m_vecCenterZ);
+		std::vector<double>().swap(m_vecTriangleArea);
+	}
+
+	///	<summary>
+	///		Index of the first sub-triangle of the given Face.
+	///	</summary>
+	size_t GetTriangleBegin(int ixFace) const {
+		return m_vecTriangleBegin[ixFace];
+	}
+
+	///	<summary>
+	///		Fan center of the given Face.
+	///	</summary>
+	Node GetCenter(int ixFace) const {
+		return Node(
+			m_vecCenterX[ixFace],
+			m_vecCenterY[ixFace],
+			m_vecCenterZ[ixFace]);
+	}
+
+	///	<summary>
+	///		Area of the given sub-triangle.
+	///	</summary>
+	double GetTriangleArea(size_t ixTriangle) const {
+		return m_vecTriangleArea[ixTriangle];
+	}
+
+	///	<summary>
+	///		Replace the contents of the triangulation.  vecTriangleBegin has
+	///		one more entry than the number of Faces and indexes into
+	///		vecTriangleArea.
+	///	</summary>
+	void Assign(
+		std::vector<size_t> & vecTriangleBegin,
+		std::vector<double> & vecCenterX,
+		std::vector<double> & vecCenterY,
+		std::vector<double> & vecCenterZ,
+		std::vector<double> & vecTriangleArea
+	) {
+		m_vecTriangleBegin.swap(vecTriangleBegin);
+		m_vecCenterX.swap(vecCenterX);
+		m_vecCenterY.swap(vecCenterY);
+		m_vecCenterZ.swap(vecCenterZ);
+		m_vecTriangleArea.swap(vecTriangleArea);
+	}
+
+public:
+	///	<summary>
+	///		Number of sub-triangles of a Face.
+	///	</summary>
+	static int GetTriangleCount(
+		const Face & face
+	) {
+		const int nEdges = static_cast<int>(face.edges.size());
+		return (nEdges == 3)?(1):(nEdges);
+	}
+
+	///	<summary>
+	///		Calculate the fan center of a Face with more than three edges.
+	///	</summary>
+	static Node CalculateCenter(
+		const Face & face,
+		const NodeVector & nodes
+	) {
+		const int nEdges = static_cast<int>(face.edges.size());
+
+		Node nodeCenter;
+		for (int k = 0; k < nEdges; k++) {
+			nodeCenter = nodeCenter + nodes[face[k]];
+		}
+		nodeCenter = nodeCenter / nEdges;
+
+		double dMag = sqrt(
+			  nodeCenter.x * nodeCenter.x
+			+ nodeCenter.y * nodeCenter.y
+			+ nodeCenter.z * nodeCenter.z);
+
+		return (nodeCenter / dMag);
+	}
+
+	///	<summary>
+	///		Get the vertices of a sub-triangle of a Face.
+	///	</summary>
+	static void GetTriangle(
+		const Face & face,
+		const NodeVector & nodes,
+		const Node & nodeCenter,
+		int j,
+		Node & node0,
+		Node & node1,
+		Node & node2
+	) {
+		const int nEdges = static_cast<int>(face.edges.size());
+		if (nEdges == 3) {
+			node0 = nodes[face[0]];
+			node1 = nodes[face[1]];
+			node2 = nodes[face[2]];
+		} else {
+			node0 = nodeCenter;
+			node1 = nodes[face[j]];
+			node2 = nodes[face[(j + 1) % nEdges]];
+		}
+	}
+
+private:
+	///	<summary>
+	///		Index of the first sub-triangle of each Face.
+	///	</summary>
+	std::vector<size_t> m_vecTriangleBegin;
+
+	///	<summary>
+	///		Fan centers of each Face (unused for triangular Faces).
+	///	</summary>
+	std::vector<double> m_vecCenterX;
+	std::vector<double> m_vecCenterY;
+	std::vector<double> m_vecCenterZ;
+
+	///	<summary>
+	///		Area of each sub-triangle.
+	///	</summary>
+	std::vector<double> m_vecTriangleArea;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A mesh.
+///	</summary>
+class Mesh {
+
+public:
+    ///	<summary>
+    ///		Type of standard mesh
+    ///	</summary>
+    enum MeshType {
+        MeshType_Unknown = -1,
+        MeshType_CubedSphere = 0,
+        MeshType_RLL = 1,
+        MeshType_IcosaHedral = 2,
+        MeshType_IcosaHedralDual = 3,
+        MeshType_Overlap = 4,
+		MeshType_UTM = 5,
+		MeshType_Transect = 6
+    };
+
+    MeshType type;
+
+public:
+	///	<summary>
+	///		Filename for this mesh.
+	///	</summary>
+	std::string strFileName;
+
+	///	<summary>
+	///		Vector of Nodes for this mesh.
+	///	</summary>
+	NodeVector nodes;
+
+	///	<summary>
+	///		Vector of Faces for this mesh.
+	///	<summary>
+	FaceVector faces;
+
+	///	<summary>
+	///		Vector of first mesh Face indices.
+	///	</summary>
+	std::vector<int> vecSourceFaceIx;
+
+	///	<summary>
+	///		Vector of second mesh Face indices.
+	///	</summary>
+	std::vector<int> vecTargetFaceIx;
+
+	///	<summary>
+	///		Vector of Face areas.
+	///	</summary>
+	DataArray1D<double> vecFaceArea;
+
+	///	<summary>
+	///		Vector storing mask variable for this mesh.
+	///	</summary>
+	std::vector<int> vecMask;
+
+	///	<summary>
+	///		EdgeMap for this mesh.
+	///	</summary>
+	EdgeMap edgemap;
+
+	///	<summary>
+	///		ReverseNodeArray for this mesh.
+	///	</summary>
+	ReverseNodeArray revnodearray;
+
+	///	<summary>
+	///		FaceTriangulation for this mesh.
+	///	</summary>
+	FaceTriangulation triangulation;
+
+	///	<summary>
+	///		Indices of the original Faces for this mesh (for use when
+	///		the original mesh has been subdivided).
+	///	</summary>
+	std::vector<int> vecMultiFaceMap;
+
+	///	<summary>
+	///		Grid dimensions.
+	///	</sumamry>
+	std::vector<int> vecGridDimSize;
+
+	///	<summary>
+	///		Grid dimension names.
+	///	</sumamry>
+	std::vector<std::string> vecGridDimName;
+
+public:
+	///	<summary>
+	///		Default constructor.
+	///	</summary>
+    Mesh() : type(MeshType_Unknown) {
+	}
+
+	///	<summary>
+	///		Constructor with input mesh parameter.
+	///	</summary>
+	Mesh(const std::string & strFile) {
+		Read(strFile);
+	}
+
+public:
+	///	<summary>
+	///		Clear the contents of the mesh.
+	///	</summary>
+	void Clear();
+
+	///	<summary>
+	///		Construct the EdgeMap from the NodeVector and FaceVector.
+	///	</summary>
+	void ConstructEdgeMap(
+	  bool fVerbose = true
+	);
+
+	///	<summary>
+	///		Construct the ReverseNodeArray from the NodeVector and FaceVector.
+	///	</summary>
+	void ConstructReverseNodeArray();
+
+	///	<summary>
+	///		Construct the FaceTriangulation from the NodeVector and FaceVector,
+	///		unless it has already been constructed, so that the sub-triangles
+	///		and their areas are shared by all maps generated from this mesh.
+	///	</summary>
+	void ConstructTriangulation();
+
+	///	<summary>
+	///		Calculate Face areas.
+	///	</summary>
+	Real CalculateFaceAreas(
+		bool fContainsConcaveFaces
+	);
+
+	///	<summary>
+	///		Calculate Face areas from an Overlap mesh.
+	///	</summary>
+	Real CalculateFaceAreasFromOverlap(
+		const Mesh & meshOverlap
+	);
+
+	///	<summary>
+	///		Calculate the total area of the Faces of this overlap mesh within
+	///		each source and target Face, either of which may be NULL.  If
+	///		the Face areas of this overlap mesh are not present they are
+	///		calculated in the same pass (the overlap mesh must not contain
+	///		concave Faces).  Returns the total area of the overlap mesh.
+	///	</summary>
+	Real CalculateOverlapParentAreas(
+		int nSourceFaces,
+		int nTargetFaces,
+		DataArray1D<double> * pdSourceArea,
+		DataArray1D<double> * pdTargetArea
+	);
+
+	///	<summary>
+	///		Sort Faces by the opposite source mesh.
+	///	</summary>
+	void ExchangeFirstAndSecondMesh();
+
+	///	<summary>
+	///		Sort Faces of an overlap mesh by source Face index, preserving the
+	///		relative order of Faces with the same source Face.
+	///	</summary>
+	void SortBySourceFace();
+
+	///	<summary>
+	///		Get the indices of all Faces ordered along a space-filling curve.
+	///		The curve is a Morton curve on each panel of the cube that
+	///		circumscribes the sphere, evaluated at the Face centroid.
+	///	</summary>
+	void GetSpaceFillingCurveOrder(
+		std::vector<int> & vecFaceOrder
+	) const;
+
+	///	<summary>
+	///		Reorder Faces along a space-filling curve and renumber Nodes in
+	///		order of first appearance, so that neighboring Faces and Nodes
+	///		are close in memory.  The original index of each Face is stored
+	///		in vecMultiFaceMap, so that overlap meshes generated from this
+	///		Mesh refer to the original Faces.  The EdgeMap and
+	///		ReverseNodeArray must be reconstructed afterwards.
+	///	</summary>
+	void ReorderAlongSpaceFillingCurve();
+
+	///	<summary>
+	///		Remove coincident nodes from the Mesh and adjust indices in faces.
+	///	</summary>
+	void RemoveCoincidentNodes(
+	  bool fVerbose = true
+	);
+
+	///	<summary>
+	///		Write the mesh to a NetCDF file in Exodus format.
+	///	</summary>
+	void Write(
+		const std::string & strFile,
+		NcFile::FileFormat eFileFormat = NcFile::Netcdf4
+	) const;
+
+	///	<summary>
+	///		Write the mesh to a NetCDF file in SCRIP format.
+	///	</summary>
+	void WriteScrip(
+		const std::string & strFile,
+		NcFile::FileFormat eFileFormat = NcFile::Netcdf4
+	) const;
+
+	///	<summary>
+	///		Write the mesh to a NetCDF file in UGRID format.
+	///	</summary>
+	void WriteUGRID(
+		const std::string & strFile,
+		NcFile::FileFormat eFileFormat = NcFile::Netcdf4
+	) const;
+
+	///	<summary>
+	///		Read the mesh from a NetCDF file or a native binary mesh cache
+	///		file written by WriteCache().
+	///	</summary>
+	void Read(const std::string & strFile);
+
+	///	<summary>
+	///		Sections of a native binary mesh cache file, which may be
+	///		combined to select the sections loaded by ReadCache().
+	///	</summary>
+	enum CacheSection {
+		CacheSection_Nodes = (1 << 0),
+		CacheSection_Faces = (1 << 1),
+		CacheSection_Parents = (1 << 2),
+		CacheSection_Mask = (1 << 3),
+		CacheSection_GridDims = (1 << 4),
+		CacheSection_FaceAreas = (1 << 5),
+		CacheSection_EdgeMap = (1 << 6),
+		CacheSection_Default =
+			CacheSection_Nodes | CacheSection_Faces | CacheSection_Parents
+			| CacheSection_Mask | CacheSection_GridDims,
+		CacheSection_All = CacheSection_Default
+			| CacheSection_FaceAreas | CacheSection_EdgeMap
+	};
+
+	///	<summary>
+	///		Write the mesh to a native binary mesh cache file.  Face areas
+	///		and the EdgeMap are included if they have been computed.
+	///	</summary>
+	void WriteCache(const std::string & strFile) const;
+
+	///	<summary>
+	///		Load the selected sections of a native binary mesh cache file,
+	///		which is memory mapped so that unselected sections are never
+	///		read.  Sections may be loaded incrementally, in which case the
+	///		cache must describe a Mesh with the same numbers of Nodes and
+	///		Faces.  Optional sections missing from the file are skipped.
+	///	</summary>
+	void ReadCache(
+		const std::string & strFile,
+		int iSections = CacheSection_Default
+	);
+
+	///	<summary>
+	///		Check if a file is a native binary mesh cache file.
+	///	</summary>
+	static bool IsCacheFile(const std::string & strFile);
+
+	///	<summary>
+	///		Calculate a 64-bit FNV-1a hash of the node coordinates and Face
+	///		connectivity of the Mesh.
+	///	</summary>
+	uint64_t CalculateHash() const;
+
+	///	<summary>
+	///		Remove zero edges from all Faces.
+	///	</summary>
+	void RemoveZeroEdges();
+
+	///	<summary>
+	///		Validate the Mesh.
+	///	</summary>
+	void Validate() const;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A writer for Exodus mesh files whose Nodes and Faces are written in
+///		chunks, so that a Mesh generator can write a mesh that does not fit
+///		in memory.  All Faces must have the same number of nodes and all
+///		edges are written as great circle arcs.  The file has the same
+///		layout as that written by Mesh::Write() for such a Mesh.
+///	</summary>
+class ExodusMeshWriter {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	ExodusMeshWriter() :
+		m_pncOut(NULL),
+		m_nNodes(0),
+		m_nFaces(0),
+		m_nNodesPerFace(0),
+		m_varNodes(NULL),
+		m_varConnect(NULL),
+		m_varGlobalId(NULL),
+		m_varEdgeType(NULL)
+	{ }
+
+	///	<summary>
+	///		Destructor.
+	///	</summary>
+	~ExodusMeshWriter() {
+		Close();
+	}
+
+	///	<summary>
+	///		Create the mesh file and write its metadata.
+	///	</summary>
+	void Open(
+		const std::string & strFile,
+		int nNodes,
+		int nFaces,
+		int nNodesPerFace,
+		NcFile::FileFormat eFileFormat = NcFile::Netcdf4
+	);
+
+	///	<summary>
+	///		Write Nodes with indices starting at ixBegin.
+	///	</summary>
+	void WriteNodes(
+		int ixBegin,
+		const NodeVector & nodes
+	);
+
+	///	<summary>
+	///		Write Faces with indices starting at ixBegin.
+	///	</summary>
+	void WriteFaces(
+		int ixBegin,
+		const FaceVector & faces
+	);
+
+	///	<summary>
+	///		Write packed Faces with indices starting at ixBegin.
+	///	</summary>
+	void WriteFaces(
+		int ixBegin,
+		const PackedFaceVector & faces
+	);
+
+	///	<summary>
+	///		Close the mesh file.
+	///	</summary>
+	void Close();
+
+private:
+	///	<summary>
+	///		Copy constructor (not implemented).
+	///	</summary>
+	ExodusMeshWriter(const ExodusMeshWriter &);
+
+	///	<summary>
+	///		Assignment operator (not implemented).
+	///	</summary>
+	ExodusMeshWriter & operator=(const ExodusMeshWriter &);
+
+private:
+	///	<summary>
+	///		Output file.
+	///	</summary>
+	NcFile * m_pncOut;
+
+	///	<summary>
+	///		Number of Nodes, number of Faces and number of nodes per Face.
+	///	</summary>
+	int m_nNodes;
+	int m_nFaces;
+	int m_nNodesPerFace;
+
+	///	<summary>
+	///		Output variables.
+	///	</summary>
+	NcVar * m_varNodes;
+	NcVar * m_varConnect;
+	NcVar * m_varGlobalId;
+	NcVar * m_varEdgeType;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A writer for SCRIP mesh files whose Faces are written in chunks, so
+///		that a Mesh generator can write a mesh that does not fit in memory.
+///		The file has the same layout as that written by Mesh::WriteScrip().
+///	</summary>
+class ScripMeshWriter {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	ScripMeshWriter() :
+		m_pncOut(NULL),
+		m_nFaces(0),
+		m_nCornersMax(0),
+		m_varArea(NULL),
+		m_varCenterLat(NULL),
+		m_varCenterLon(NULL),
+		m_varCornerLat(NULL),
+		m_varCornerLon(NULL),
+		m_varMask(NULL)
+	{ }
+
+	///	<summary>
+	///		Destructor.
+	///	</summary>
+	~ScripMeshWriter() {
+		Close();
+	}
+
+	///	<summary>
+	///		Create the mesh file and write its metadata.  vecGridDimSize
+	///		has the same meaning as Mesh::vecGridDimSize.
+	///	</summary>
+	void Open(
+		const std::string & strFile,
+		int nFaces,
+		int nCornersMax,
+		const std::vector<int> & vecGridDimSize,
+		NcFile::FileFormat eFileFormat = NcFile::Netcdf4
+	);
+
+	///	<summary>
+	///		Write Faces with indices starting at ixBegin.  The Faces refer
+	///		to nodes, which need only contain the Nodes of these Faces.
+	///	</summary>
+	void WriteFaces(
+		int ixBegin,
+		const FaceVector & faces,
+		const NodeVector & nodes
+	);
+
+	///	<summary>
+	///		Write the nFaces Faces at pFaces with indices starting at ixBegin.
+	///	</summary>
+	void WriteFaces(
+		int ixBegin,
+		const Face * pFaces,
+		int nFaces,
+		const NodeVector & nodes
+	);
+
+	///	<summary>
+	///		Close the mesh file.
+	///	</summary>
+	void Close();
+
+private:
+	///	<summary>
+	///		Copy constructor (not implemented).
+	///	</summary>
+	ScripMeshWriter(const ScripMeshWriter &);
+
+	///	<summary>
+	///		Assignment operator (not implemented).
+	///	</summary>
+	ScripMeshWriter & operator=(const ScripMeshWriter &);
+
+private:
+	///	<summary>
+	///		Output file.
+	///	</summary>
+	NcFile * m_pncOut;
+
+	///	<summary>
+	///		Number of Faces and maximum number of corners per Face.
+	///	</summary>
+	int m_nFaces;
+	int m_nCornersMax;
+
+	///	<summary>
+	///		Output variables.
+	///	</summary>
+	NcVar * m_varArea;
+	NcVar * m_varCenterLat;
+	NcVar * m_varCenterLon;
+	NcVar * m_varCornerLat;
+	NcVar * m_varCornerLon;
+	NcVar * m_varMask;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Location data returned from FindFaceFromNode()
+///		Generate a PathSegmentVector describing the path around the face
+///		ixCurrentFirstFace.
+///	</summary>
+struct FindFaceStruct {
+	
 	///	<summary>
 	///		A vector of face indices indicating possible Faces.
 	///	</summary>
@@ -999,6 +2015,60 @@ Real CalculateFaceAreaQuadratureMethod(
 	const NodeVector & nodes
 );
 
+///	<summary>
+///		Calculate the areas of Faces [ixBegin, ixEnd) using quadrature, with
+///		Node coordinates taken from coordinate arrays.  Sub-triangles of
+///		consecutive Faces are evaluated in batches.  The result is identical
+///		to CalculateFaceAreaQuadratureMethod() on the original NodeVector.
+///	</summary>
+void CalculateFaceAreasQuadratureMethod(
+	const FaceVector & faces,
+	const NodeCoordinateArrays & coords,
+	int ixBegin,
+	int ixEnd,
+	DataArray1D<double> & vecFaceArea
+);
+
+///	<summary>
+///		Calculate the areas of Faces [ixBegin, ixEnd) of a PackedFaceVector
+///		using quadrature, as above.
+///	</summary>
+void CalculateFaceAreasQuadratureMethod(
+	const PackedFaceVector & faces,
+	const NodeCoordinateArrays & coords,
+	int ixBegin,
+	int ixEnd,
+	DataArray1D<double> & vecFaceArea
+);
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Calculate the area of a Face from the spherical excess of the
+///		sub-triangles of a fan about its first Node.  If pdError is not
+///		NULL an estimate of the rounding error in the area is returned.
+///	</summary>
+Real CalculateFaceAreaExcessMethod(
+	const Face & face,
+	const NodeVector & nodes,
+	double * pdError = NULL
+);
+
+///	<summary>
+///		Calculate the areas of Faces [ixBegin, ixEnd) of a PackedFaceVector
+///		from the spherical excess, with sub-triangles of consecutive Faces
+///		evaluated in batches.  Faces whose estimated rounding error exceeds
+///		FaceAreaExcessTolerance relative to their area (such as slivers) are
+///		calculated using quadrature.
+///	</summary>
+void CalculateFaceAreasExcessMethod(
+	const PackedFaceVector & faces,
+	const NodeCoordinateArrays & coords,
+	int ixBegin,
+	int ixEnd,
+	DataArray1D<double> & vecFaceArea
+);
+
 ///////////////////////////////////////////////////////////////////////////////
 
 ///	<summary>
@@ -1033,7 +2103,8 @@ Real CalculateFaceArea_Concave(
 ///////////////////////////////////////////////////////////////////////////////
 
 ///	<summary>
-///		Calculate the area of a single Face.
+///		Calculate the area of a single Face, using the spherical excess
+///		where it is accurate and quadrature otherwise.
 ///	</summary>
 Real CalculateFaceArea(
 	const Face & face,
@@ -1048,6 +2119,108 @@ Real CalculateTriangleAreaQuadratureMethod(
 	Node &node2,
 	Node &node3
 );
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		The sub-triangles of one Face of a mesh, taken from the
+///		FaceTriangulation of the mesh if it has been constructed and
+///		calculated otherwise.
+///	</summary>
+class MeshFaceTriangles {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	MeshFaceTriangles(
+		const Mesh & mesh,
+		int ixFace
+	) :
+		m_face(mesh.faces[ixFace]),
+		m_nodes(mesh.nodes),
+		m_pTriangulation(NULL),
+		m_ixTriangleBegin(0)
+	{
+		if (mesh.triangulation.size() == mesh.faces.size()) {
+			m_pTriangulation = &(mesh.triangulation);
+			m_ixTriangleBegin = m_pTriangulation->GetTriangleBegin(ixFace);
+		}
+		if (m_face.edges.size() > 3) {
+			if (m_pTriangulation != NULL) {
+				m_nodeCenter = m_pTriangulation->GetCenter(ixFace);
+			} else {
+				m_nodeCenter =
+					FaceTriangulation::CalculateCenter(m_face, m_nodes);
+			}
+		}
+	}
+
+	///	<summary>
+	///		Number of sub-triangles.
+	///	</summary>
+	int size() const {
+		return FaceTriangulation::GetTriangleCount(m_face);
+	}
+
+	///	<summary>
+	///		Get the vertices of a sub-triangle.
+	///	</summary>
+	void GetTriangle(
+		int j,
+		Node & node0,
+		Node & node1,
+		Node & node2
+	) const {
+		FaceTriangulation::GetTriangle(
+			m_face, m_nodes, m_nodeCenter, j, node0, node1, node2);
+	}
+
+	///	<summary>
+	///		Get the area of a sub-triangle with the given vertices.
+	///	</summary>
+	double GetArea(
+		int j,
+		const Node & node0,
+		const Node & node1,
+		const Node & node2
+	) const {
+		if (m_pTriangulation != NULL) {
+			return m_pTriangulation->GetTriangleArea(m_ixTriangleBegin + j);
+		}
+		Node nodeA(node0);
+		Node nodeB(node1);
+		Node nodeC(node2);
+		return CalculateTriangleAreaQuadratureMethod(nodeA, nodeB, nodeC);
+	}
+
+private:
+	///	<summary>
+	///		The Face.
+	///	</summary>
+	const Face & m_face;
+
+	///	<summary>
+	///		Nodes of the mesh.
+	///	</summary>
+	const NodeVector & m_nodes;
+
+	///	<summary>
+	///		Triangulation of the mesh, or NULL if not constructed.
+	///	</summary>
+	const FaceTriangulation * m_pTriangulation;
+
+	///	<summary>
+	///		Index of the first sub-triangle in the triangulation.
+	///	</summary>
+	size_t m_ixTriangleBegin;
+
+	///	<summary>
+	///		Fan center of the Face.
+	///	</summary>
+	Node m_nodeCenter;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 ///	<summary>
@@ -1069,8 +2242,28 @@ bool ConvexifyFace(
 ///////////////////////////////////////////////////////////////////////////////
 
 ///	<summary>
-///		Convert all concave Faces into the Mesh into Concave faces via
-///		subdivision.
+///		Divide a Face into convex Faces on the same nodes, by ear clipping
+///		followed by Hertel-Mehlhorn removal of unneeded diagonals.  Edges
+///		are treated as great circle arcs.  No Steiner nodes are added, and
+///		no allocation beyond small per-Face work vectors is performed, so
+///		this function may be called concurrently on different Faces.
+///	</summary>
+///	<returns>
+///		false if the Face could not be divided, such as when it does not
+///		lie within a hemisphere or is not a simple polygon.
+///	</returns>
+bool ConvexifyFaceEarClipping(
+	const Face & face,
+	const NodeVector & nodes,
+	std::vector<Face> & vecFacesOut
+);
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Convert all concave Faces of the Mesh into convex Faces via
+///		subdivision, in place.  Only the nodes and Faces of the Mesh are
+///		moved into temporary storage, rather than copying the Mesh.
 ///	</summary>
 void ConvexifyMesh(
 	Mesh & mesh,
@@ -1081,7 +2274,9 @@ void ConvexifyMesh(
 
 ///	<summary>
 ///		Convert concave Mesh meshin to convex Mesh meshout by dividing
-///		Faces and populating the MultiFaceMap.
+///		Faces and populating the MultiFaceMap.  Concave Faces are divided
+///		in parallel with ConvexifyFaceEarClipping(), falling back to
+///		ConvexifyFace() for Faces that cannot be divided this way.
 ///	</summary>
 void ConvexifyMesh(
 	Mesh & meshin,
@@ -1091,6 +2286,24 @@ void ConvexifyMesh(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		Generate the dual of meshin in meshout.  Each Face of meshin
+///		becomes a node of meshout at its normalized centroid, and each node
+///		of meshin becomes a Face of meshout on the centroids of its
+///		adjacent Faces, ordered counter-clockwise about the node.  Adjacency
+///		is taken from the ReverseNodeArray of meshin, which is constructed
+///		if needed, and all Faces are built in parallel.  Every node of
+///		meshin must be adjacent to at least three Faces, so meshin must
+///		cover the sphere.
+///	</summary>
+void GenerateDualMesh(
+	Mesh & meshin,
+	Mesh & meshout,
+	bool fVerbose = false
+);
+
+///////////////////////////////////////////////////////////////////////////////
+
 ///	<summary>
 ///		Find a node within the specified quadrilateral.
 ///	</summary>
@@ -17,6 +17,7 @@
 #include "Defines.h"
 #include "LinearRemapFV.h"
 #include "FiniteVolumeTools.h"
+#include "FiniteVolumeStencilCache.h"
 #include "GridElements.h"
 #include "OfflineMap.h"
 #include "FiniteElementTools.h"
@@ -28,10 +29,14 @@
 
 #include "Announce.h"
 #include "MathHelper.h"
-#include "kdtree.h"
+#include "PointKDTree.h"
+#include "SmallMatrixSolve.h"
 
+#include <algorithm>
 #include <cstring>
 #include <map>
+#include <set>
+#include <string>
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -254,7 +259,9 @@ void LinearRemapFVtoFV(
 	const Mesh & meshOutput,
 	const Mesh & meshOverlap,
 	int nOrder,
-	OfflineMap & mapRemap
+	OfflineMap & mapRemap,
+	FiniteVolumeStencilCache * pcacheStencil,
+	double dQuadratureTolerance
 ) {
 	// Use streamlined helper function for first order
 	if (nOrder == 1) {
@@ -296,161 +303,314 @@ void LinearRemapFVtoFV(
 	Announce("Number of coefficients: %i", nCoefficients);
 	Announce("Required adjacency set size: %i", nRequiredFaceSetSize);
 	Announce("Fit weights exponent: %i", nFitWeightsExponent);
+	if (dQuadratureTolerance > 0.0) {
+		Announce("Adaptive quadrature tolerance: %1.5e", dQuadratureTolerance);
+	}
 
-	// Current overlap face
-	int ixOverlap = 0;
-
-	// Arrays used in analysis
-	DataArray2D<double> dIntArray;
-	DataArray1D<double> dConstraint(nCoefficients);
-
-	// Loop through all faces on meshInput
-	for (int ixFirst = 0; ixFirst < meshInput.faces.size(); ixFirst++) {
-
-		// Output every 100 elements
-		if (ixFirst % 1000 == 0) {
-			Announce("Element %i/%i", ixFirst, meshInput.faces.size());
-		}
-
-		// This Face
-		const Face & faceFirst = meshInput.faces[ixFirst];
+	// Load or build the reconstruction stencils
+	if (pcacheStencil != NULL) {
+		pcacheStencil->Prepare(
+			meshInput,
+			triquadrule,
+			nOrder,
+			nRequiredFaceSetSize);
+	}
 
-		// Find the set of Faces that overlap faceFirst
-		int ixOverlapBegin = ixOverlap;
-		int ixOverlapEnd = ixOverlapBegin;
-	
-		for (; ixOverlapEnd < meshOverlap.faces.size(); ixOverlapEnd++) {
-			if (meshOverlap.vecSourceFaceIx[ixOverlapEnd] != ixFirst) {
-				break;
+	// Range of overlap faces associated with each face on meshInput
+	const int nFaces = meshInput.faces.size();
+
+	std::vector<int> vecOverlapBegin(nFaces+1);
+	{
+		int ixOverlap = 0;
+		for (int ixFirst = 0; ixFirst < nFaces; ixFirst++) {
+			vecOverlapBegin[ixFirst] = ixOverlap;
+			for (; ixOverlap < meshOverlap.faces.size(); ixOverlap++) {
+				if (meshOverlap.vecSourceFaceIx[ixOverlap] != ixFirst) {
+					break;
+				}
 			}
 		}
+		vecOverlapBegin[nFaces] = ixOverlap;
+	}
 
-		int nOverlapFaces = ixOverlapEnd - ixOverlapBegin;
-
-		// Build integration array, which maps polynomial coefficients to
-		// area integrals.
-		BuildIntegrationArray(
-			meshInput,
-			meshOverlap,
-			triquadrule,
-			ixFirst,
-			ixOverlapBegin,
-			ixOverlapEnd,
-			nOrder,
-			dIntArray);
+	// Map weights are computed for blocks of faces on meshInput in
+	// parallel and stored as triplets, which are added to the map in
+	// order of the faces on meshInput
+	const int nBlocks =
+		(nFaces + LinearRemapParallelBlockSize - 1)
+			/ LinearRemapParallelBlockSize;
+
+	std::vector<SparseMatrix<double>::TripletVector> vecBlockTriplets(nBlocks);
+	std::vector<std::string> vecBlockError(nBlocks);
+
+	// Blocks are computed in chunks of LinearRemapAssemblyChunkBlocks so
+	// that only the triplets of one chunk are held in memory at a time
+	for (int bBegin = 0; bBegin < nBlocks;
+	     bBegin += LinearRemapAssemblyChunkBlocks
+	) {
+		const int bEnd =
+			std::min(bBegin + LinearRemapAssemblyChunkBlocks, nBlocks);
+
+#pragma omp parallel for schedule(dynamic)
+		for (int b = bBegin; b < bEnd; b++) {
+			const int ixBegin = b * LinearRemapParallelBlockSize;
+			const int ixEnd =
+				std::min(ixBegin + LinearRemapParallelBlockSize, nFaces);
+
+			SparseMatrix<double>::TripletVector & vecTriplets =
+				vecBlockTriplets[b];
+
+			// Arrays used in analysis
+			DataArray2D<double> dIntArray;
+			DataArray1D<double> dConstraint(nCoefficients);
+
+			try {
+			for (int ixFirst = ixBegin; ixFirst < ixEnd; ixFirst++) {
+
+			// Output every 1000 elements
+			if (ixFirst % 1000 == 0) {
+#pragma omp critical
+				Announce("Element %i/%i", ixFirst, nFaces);
+			}
 
-		// Set of Faces to use in building the reconstruction and associated
-		// distance metric.
-		AdjacentFaceVector vecAdjFaces;
+			// Find the set of Faces that overlap faceFirst
+			int ixOverlapBegin = vecOverlapBegin[ixFirst];
+			int ixOverlapEnd = vecOverlapBegin[ixFirst+1];
+
+			int nOverlapFaces = ixOverlapEnd - ixOverlapBegin;
+
+			// Build integration array, which maps polynomial coefficients to
+			// area integrals.
+			BuildIntegrationArray(
+				meshInput,
+				meshOverlap,
+				triquadrule,
+				ixFirst,
+				ixOverlapBegin,
+				ixOverlapEnd,
+				nOrder,
+				dIntArray,
+				dQuadratureTolerance);
+
+			// Set of Faces to use in building the reconstruction and associated
+			// distance metric, and the integrals of each monomial over these
+			// Faces.
+			AdjacentFaceVector vecAdjFaces;
+			DataArray2D<double> dFitMoments;
+
+			if (pcacheStencil != NULL) {
+				pcacheStencil->GetAdjacentFaces(ixFirst, vecAdjFaces);
+				pcacheStencil->GetFitMoments(ixFirst, dFitMoments);
+
+			} else {
+	//#ifdef RECTANGULAR_TRUNCATION
+	//			GetAdjacentFaceVectorByNode(
+	//#endif
+	//#ifdef TRIANGULAR_TRUNCATION
+				GetAdjacentFaceVectorByEdge(
+	//#endif
+					meshInput,
+					ixFirst,
+					nRequiredFaceSetSize,
+					vecAdjFaces);
 
-//#ifdef RECTANGULAR_TRUNCATION
-//		GetAdjacentFaceVectorByNode(
-//#endif
-//#ifdef TRIANGULAR_TRUNCATION
-		GetAdjacentFaceVectorByEdge(
-//#endif
-			meshInput,
-			ixFirst,
-			nRequiredFaceSetSize,
-			vecAdjFaces);
+				BuildFitMoments(
+					meshInput,
+					triquadrule,
+					ixFirst,
+					vecAdjFaces,
+					nOrder,
+					dFitMoments);
+			}
 
-		// Number of adjacent Faces
-		int nAdjFaces = vecAdjFaces.size();
+			// Number of adjacent Faces
+			int nAdjFaces = vecAdjFaces.size();
 
-		// Determine the conservative constraint equation
-		double dFirstArea = meshInput.vecFaceArea[ixFirst];
+			// Determine the conservative constraint equation
+			double dFirstArea = meshInput.vecFaceArea[ixFirst];
 
-		dConstraint.Zero();
-		for (int p = 0; p < nCoefficients; p++) {
-			for (int j = 0; j < nOverlapFaces; j++) {
-				dConstraint[p] += dIntArray(p,j);
+			dConstraint.Zero();
+			for (int p = 0; p < nCoefficients; p++) {
+				for (int j = 0; j < nOverlapFaces; j++) {
+					dConstraint[p] += dIntArray(p,j);
+				}
+				dConstraint[p] /= dFirstArea;
 			}
-			dConstraint[p] /= dFirstArea;
-		}
-
-		// Build the fit array from the integration operator
-		DataArray2D<double> dFitArray;
-		DataArray1D<double> dFitWeights;
-		DataArray2D<double> dFitArrayPlus;
 
-		BuildFitArray(
-			meshInput,
-			triquadrule,
-			ixFirst,
-			vecAdjFaces,
-			nOrder,
-			nFitWeightsExponent,
-			dConstraint,
-			dFitArray,
-			dFitWeights
-		);
+			// Build the fit array from the integration operator
+			DataArray2D<double> dFitArray;
+			DataArray1D<double> dFitWeights;
+			DataArray2D<double> dFitArrayPlus;
 
-		// Compute the inverse fit array
-		bool fSuccess =
-			InvertFitArray_Corrected(
+			NormalizeFitArray(
+				meshInput,
+				vecAdjFaces,
+				nFitWeightsExponent,
 				dConstraint,
+				dFitMoments,
 				dFitArray,
-				dFitWeights,
-				dFitArrayPlus
-			);
+				dFitWeights);
+
+			// Compute the inverse fit array
+			bool fSuccess =
+				InvertFitArray_Corrected(
+					dConstraint,
+					dFitArray,
+					dFitWeights,
+					dFitArrayPlus
+				);
+
+			// Build the composition, which maps average values in adjacent cells
+			// to the integrated values of the reconstruction in overlap faces.
+			DataArray2D<double> dComposedArray(nAdjFaces, nOverlapFaces);
+			if (fSuccess) {
+
+				// Multiply integration array and inverse fit array
+				for (int i = 0; i < nAdjFaces; i++) {
+				for (int j = 0; j < nOverlapFaces; j++) {
+				for (int k = 0; k < nCoefficients; k++) {
+					dComposedArray(i,j) += dIntArray(k,j) * dFitArrayPlus(i,k);
+				}
+				}
+				}
 
-		// Build the composition, which maps average values in adjacent cells
-		// to the integrated values of the reconstruction in overlap faces.
-		DataArray2D<double> dComposedArray(nAdjFaces, nOverlapFaces);
-		if (fSuccess) {
+			// Unable to invert fit array, drop to 1st order.  In this case
+			// dFitArrayPlus(0,0) = 1 and all other entries are zero.
+			} else {
+				dComposedArray.Zero();
+				for (int j = 0; j < nOverlapFaces; j++) {
+					dComposedArray(0,j) += dIntArray(0,j);
+				}
+			}
+
+
+	/*
+			for (int j = 0; j < nOverlapFaces; j++) {
+				dComposedArray(0,j) = meshOverlap.vecFaceArea[ixOverlap + j];
+			}
 
-			// Multiply integration array and inverse fit array
 			for (int i = 0; i < nAdjFaces; i++) {
 			for (int j = 0; j < nOverlapFaces; j++) {
-			for (int k = 0; k < nCoefficients; k++) {
-				dComposedArray(i,j) += dIntArray(k,j) * dFitArrayPlus(i,k);
+			for (int k = 1; k < nCoefficients; k++) {
+				double dOverlapArea =
+					meshOverlap.vecFaceArea[ixOverlap + j];
+
+				dComposedArray(i,j) +=
+					(dIntArray(k,j) - dConstraint[k] * dOverlapArea)
+						* dFitArrayPlus(i,k);
 			}
 			}
 			}
+	*/
 
-		// Unable to invert fit array, drop to 1st order.  In this case
-		// dFitArrayPlus(0,0) = 1 and all other entries are zero.
-		} else {
-			dComposedArray.Zero();
+			// Put composed array into map
+			for (int i = 0; i < vecAdjFaces.size(); i++) {
 			for (int j = 0; j < nOverlapFaces; j++) {
-				dComposedArray(0,j) += dIntArray(0,j);
+				int ixFirstFace = vecAdjFaces[i].first;
+				int ixSecondFace = meshOverlap.vecTargetFaceIx[ixOverlapBegin + j];
+
+				vecTriplets.push_back(
+					SparseMatrix<double>::Triplet(
+						ixSecondFace,
+						ixFirstFace,
+						dComposedArray(i,j)
+						/ meshOutput.vecFaceArea[ixSecondFace]));
+			}
+			}
 			}
-		}
 
+			} catch(Exception & e) {
+				vecBlockError[b] = e.ToString();
+			}
+		}
 
-/*
-		for (int j = 0; j < nOverlapFaces; j++) {
-			dComposedArray(0,j) = meshOverlap.vecFaceArea[ixOverlap + j];
+		// Report the error from the first failing face
+		for (int b = bBegin; b < bEnd; b++) {
+			if (vecBlockError[b] != "") {
+				_EXCEPTION1("%s", vecBlockError[b].c_str());
+			}
 		}
 
-		for (int i = 0; i < nAdjFaces; i++) {
-		for (int j = 0; j < nOverlapFaces; j++) {
-		for (int k = 1; k < nCoefficients; k++) {
-			double dOverlapArea =
-				meshOverlap.vecFaceArea[ixOverlap + j];
+		// Insert the triplets of the chunk into the map in order of the
+		// blocks, releasing them before the next chunk is computed
+		smatMap.AddBlockTriplets(vecBlockTriplets);
+	}
+}
 
-			dComposedArray(i,j) +=
-				(dIntArray(k,j) - dConstraint[k] * dOverlapArea)
-					* dFitArrayPlus(i,k);
-		}
-		}
-		}
-*/
+///////////////////////////////////////////////////////////////////////////////
 
-		// Put composed array into map
-		for (int i = 0; i < vecAdjFaces.size(); i++) {
-		for (int j = 0; j < nOverlapFaces; j++) {
-			int ixFirstFace = vecAdjFaces[i].first;
-			int ixSecondFace = meshOverlap.vecTargetFaceIx[ixOverlap + j];
+///	<summary>
+///		Find the source Faces contributing to the inverse distance weighted
+///		value at a quadrature point, given the nearest source Face.  These
+///		are the nearest Face and each unmasked neighbour lying on the far
+///		side of the nearest centroid from the quadrature point.
+///	</summary>
+static void GetInvDistContributions(
+	const Mesh & meshInput,
+	const NodeVector & vecSourceCentroids,
+	int iNearestFace,
+	const Node & nodeQ,
+	std::vector<int> & vecContributingFaceIxs,
+	std::vector<double> & vecContributingFaceWeights
+) {
+	const Face & faceCurrent = meshInput.faces[iNearestFace];
 
-			smatMap(ixSecondFace, ixFirstFace) +=
-				dComposedArray(i,j)
-				/ meshOutput.vecFaceArea[ixSecondFace];
+	const Node & nodeX1 = vecSourceCentroids[iNearestFace];
+
+	Node nodeX1minusQ = nodeX1;
+	nodeX1minusQ.x -= nodeQ.x;
+	nodeX1minusQ.y -= nodeQ.y;
+	nodeX1minusQ.z -= nodeQ.z;
+
+	vecContributingFaceIxs.clear();
+	vecContributingFaceWeights.clear();
+
+	// TODO: Switch to using great circle distance rather than chord dist
+	// TODO: Be careful about nodeCenter1 being zero
+	double dInvDist1 = 1.0 / nodeX1minusQ.Magnitude();
+	vecContributingFaceIxs.push_back(iNearestFace);
+	vecContributingFaceWeights.push_back(dInvDist1);
+
+	// Push neighboring face if it is on the correct side
+	for (int i = 0; i < faceCurrent.edges.size(); i++) {
+
+		const FacePair & facepair =
+				meshInput.edgemap.find(faceCurrent.edges[i])->second;
+
+		int iNeighborFace;
+		if (iNearestFace == facepair[0]) {
+			iNeighborFace = facepair[1];
+		} else if (iNearestFace == facepair[1]) {
+			iNeighborFace = facepair[0];
+		} else {
+			_EXCEPTIONT("Logic error");
 		}
+
+		// Check mask
+		if (meshInput.vecMask.size() != 0) {
+			if (meshInput.vecMask[iNeighborFace] == 0) {
+				continue;
+			}
 		}
 
-		// Increment the current overlap index
-		ixOverlap += nOverlapFaces;
+		// Add contribution
+		const Node & nodeX2 = vecSourceCentroids[iNeighborFace];
+
+		Node nodeX1minusX2 = nodeX1;
+		nodeX1minusX2.x -= nodeX2.x;
+		nodeX1minusX2.y -= nodeX2.y;
+		nodeX1minusX2.z -= nodeX2.z;
+
+		if (DotProduct(nodeX1minusX2, nodeX1minusQ) > 0.0) {
+			Node nodeX2minusQ = nodeX2;
+			nodeX2minusQ.x -= nodeQ.x;
+			nodeX2minusQ.y -= nodeQ.y;
+			nodeX2minusQ.z -= nodeQ.z;
+
+			double dInvDist2 = 1.0 / nodeX2minusQ.Magnitude();
+			vecContributingFaceIxs.push_back(iNeighborFace);
+			vecContributingFaceWeights.push_back(dInvDist2);
+		}
 	}
 }
 
@@ -476,33 +636,23 @@ void LinearRemapFVtoFVInvDist(
 	const DataArray2D<double> & dG = triquadrule.GetG();
 	const DataArray1D<double> & dW = triquadrule.GetW();
 
+	const int nQuadPts = dW.GetRows();
+
 	// Get SparseMatrix represntation of the OfflineMap
 	SparseMatrix<double> & smatMap = mapRemap.GetSparseMatrix();
 
-	// kd-tree for nearest neighbor search
-    kdtree * kdTarget = kd_create(3);
-
-	// Vectors used in determining contributions from each Face
-	std::vector<int> vecContributingFaceIxs;
-	std::vector<double> vecContributingFaceWeights;
-
 	// Vector of centers of the source mesh
-	for (int i = 0; i < meshInput.faces.size(); i++){
-
-		const Face & face = meshInput.faces[i];
-
-		Node nodeCentroid = GetFaceCentroid(face, meshInput.nodes);
+	const int nSourceFaces = meshInput.faces.size();
 
-		kd_insert3(
-			kdTarget,
-			nodeCentroid.x,
-			nodeCentroid.y,
-			nodeCentroid.z,
-			(void*)(&(meshInput.faces[i])));
+	NodeVector vecSourceCentroids(nSourceFaces);
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < nSourceFaces; i++){
+		vecSourceCentroids[i] =
+			GetFaceCentroid(meshInput.faces[i], meshInput.nodes);
 	}
 
-	// Overlap face index
-	int ixOverlap = 0;
+	// kd-tree for nearest neighbor search
+	PointKDTree kdSource(vecSourceCentroids);
 
 	// Check mask size
 	_ASSERT((meshInput.vecMask.size() == 0) || (meshInput.vecMask.size() == meshInput.faces.size()));
@@ -511,94 +661,112 @@ void LinearRemapFVtoFVInvDist(
 		Announce("Source mesh contains mask information which will be used in map calculation");
 	}
 
-	// Loop through all source faces
-	for (int ixFirst = 0; ixFirst < meshInput.faces.size(); ixFirst++) {
+	const int nOverlapFaces = meshOverlap.faces.size();
 
-		// Output every 1000 overlap elements
-		if (ixFirst % 1000 == 0) {
-			Announce("Element %i/%i", ixFirst, meshInput.faces.size());
-		}
+	// Offset of the first quadrature point of each overlap face
+	std::vector<size_t> vecQuadBegin(nOverlapFaces+1);
+	vecQuadBegin[0] = 0;
+	for (int i = 0; i < nOverlapFaces; i++) {
+		vecQuadBegin[i+1] = vecQuadBegin[i]
+			+ (meshOverlap.faces[i].edges.size() - 2) * nQuadPts;
+	}
 
-		// This Face
-		const Face & faceFirst = meshInput.faces[ixFirst];
+	const size_t sTotalQuadPts = vecQuadBegin[nOverlapFaces];
 
-		// Find the set of Faces that overlap faceFirst
-		int ixOverlapBegin = ixOverlap;
-		int ixOverlapEnd = ixOverlapBegin;
-	
-		for (; ixOverlapEnd < meshOverlap.faces.size(); ixOverlapEnd++) {
-			if (meshOverlap.vecSourceFaceIx[ixOverlapEnd] != ixFirst) {
-				break;
-			}
-		}
+	// Quadrature nodes and pointwise Jacobians on all overlap faces, along
+	// with the quadrature area of each overlap face
+	Announce("Computing quadrature nodes on %i overlap faces", nOverlapFaces);
 
-		int nOverlapFaces = ixOverlapEnd - ixOverlapBegin;
+	NodeVector vecQuadPtNodes(sTotalQuadPts);
+	std::vector<double> vecQuadPtWeight(sTotalQuadPts);
+	std::vector<double> vecQuadratureArea(nOverlapFaces);
 
-		// Check mask
-		if (meshInput.vecMask.size() != 0) {
-			if (meshInput.vecMask[ixFirst] == 0) {
- 		               // Increment the current overlap index
-                		ixOverlap += nOverlapFaces;
+#pragma omp parallel for schedule(dynamic, LinearRemapParallelBlockSize)
+	for (int i = 0; i < nOverlapFaces; i++) {
+		const Face & faceOverlap = meshOverlap.faces[i];
 
-				continue;
+		const int nSubTriangles = faceOverlap.edges.size() - 2;
+
+		double dQuadratureArea = 0.0;
+
+		for (int k = 0; k < nSubTriangles; k++) {
+			for (int p = 0; p < nQuadPts; p++) {
+				const size_t ixQ = vecQuadBegin[i] + k * nQuadPts + p;
+
+				double dQuadPtWeight =
+					CalculateSphericalTriangleJacobianBarycentric(
+						meshOverlap.nodes[faceOverlap[0]],
+						meshOverlap.nodes[faceOverlap[k+1]],
+						meshOverlap.nodes[faceOverlap[k+2]],
+						dG(p,0), dG(p,1),
+						&(vecQuadPtNodes[ixQ]));
+
+				dQuadPtWeight *= dW[p];
+
+				vecQuadPtWeight[ixQ] = dQuadPtWeight;
+
+				dQuadratureArea += dQuadPtWeight;
 			}
 		}
 
-		// Loop through all overlap faces associated with this source face
-		for (int j = 0; j < nOverlapFaces; j++) {
-			int iTargetFace = meshOverlap.vecTargetFaceIx[ixOverlap + j];
-
-			const Face & faceOverlap = meshOverlap.faces[ixOverlap + j];
+		vecQuadratureArea[i] = dQuadratureArea;
+	}
 
-			int nSubTriangles = faceOverlap.edges.size() - 2;
+	// Find the nearest source face to every quadrature node in one batch
+	Announce("Finding nearest source faces to %lu quadrature nodes",
+		sTotalQuadPts);
 
-			// Jacobian at each quadrature point
-			DataArray2D<double> dQuadPtWeight(nSubTriangles, dW.GetRows());
-			DataArray2D<Node> dQuadPtNodes(nSubTriangles, dW.GetRows());
+	std::vector<int> vecNearestFace;
+	kdSource.FindNearest(vecQuadPtNodes, vecNearestFace);
 
-			// Compute quadrature area of each overlap face
-			double dQuadratureArea = 0.0;
+	// Number of source faces contributing at each quadrature node, which
+	// is then accumulated into the offset of its first map entry
+	std::vector<size_t> vecEntryBegin(sTotalQuadPts+1, 0);
 
-			for (int k = 0; k < nSubTriangles; k++) {
-				for (int p = 0; p < dW.GetRows(); p++) {
+	const int nBlocks =
+		(nOverlapFaces + LinearRemapParallelBlockSize - 1)
+			/ LinearRemapParallelBlockSize;
 
-					dQuadPtWeight(k,p) =
-						CalculateSphericalTriangleJacobianBarycentric(
-							meshOverlap.nodes[faceOverlap[0]],
-							meshOverlap.nodes[faceOverlap[k+1]],
-							meshOverlap.nodes[faceOverlap[k+2]],
-							dG(p,0), dG(p,1),
-							&(dQuadPtNodes(k,p)));
+	std::vector<std::string> vecBlockError(nBlocks);
 
-					dQuadPtWeight(k,p) *= dW[p];
+	// Map entries, in order of overlap face and quadrature node, which are
+	// counted on the first pass and written in place on the second pass
+	SparseMatrix<double>::TripletVector vecTriplets;
 
-					dQuadratureArea += dQuadPtWeight(k,p);
-				}
+	for (int iPass = 0; iPass < 2; iPass++) {
+		if (iPass == 1) {
+			for (size_t q = 0; q < sTotalQuadPts; q++) {
+				vecEntryBegin[q+1] += vecEntryBegin[q];
 			}
+			vecTriplets.resize(vecEntryBegin[sTotalQuadPts]);
+		}
 
-			//printf("%1.15e %1.15e %1.15e %1.15e\n", meshOverlap.vecFaceArea[ixOverlap + j], dQuadratureArea, CalculateFaceAreaKarneysMethod(faceOverlap, meshOverlap.nodes), dQuadratureArea / meshOverlap.vecFaceArea[ixOverlap + j]);
-
-			// Loop through all sub-triangles of this overlap Face
-			for (int k = 0; k < nSubTriangles; k++) {
+#pragma omp parallel for schedule(dynamic)
+		for (int b = 0; b < nBlocks; b++) {
+			const int ixBegin = b * LinearRemapParallelBlockSize;
+			const int ixEnd =
+				std::min(ixBegin + LinearRemapParallelBlockSize, nOverlapFaces);
 
-				// Loop through all quadrature nodes on this overlap Face
-				for (int p = 0; p < dW.GetRows(); p++) {
+			// Vectors used in determining contributions from each Face
+			std::vector<int> vecContributingFaceIxs;
+			std::vector<double> vecContributingFaceWeights;
 
-					// Get quadrature node and pointwise Jacobian
-					const Node & nodeQ = dQuadPtNodes(k,p);
+			try {
+			for (int i = ixBegin; i < ixEnd; i++) {
+				const int ixFirst = meshOverlap.vecSourceFaceIx[i];
+				const int iTargetFace = meshOverlap.vecTargetFaceIx[i];
 
-					// Find nearest source mesh face and add its contribution
-					// to the inverse distance.
-					kdres * kdresTarget =
-						kd_nearest3(
-							kdTarget,
-							nodeQ.x,
-							nodeQ.y,
-							nodeQ.z);
+				// Check mask
+				if (meshInput.vecMask.size() != 0) {
+					if (meshInput.vecMask[ixFirst] == 0) {
+						continue;
+					}
+				}
 
-					Face * pFace = (Face *)(kd_res_item_data(kdresTarget));
+				for (size_t ixQ = vecQuadBegin[i]; ixQ < vecQuadBegin[i+1]; ixQ++) {
 
-					int iNearestFace = pFace - &(meshInput.faces[0]);
+					// Nearest source mesh face
+					int iNearestFace = vecNearestFace[ixQ];
 
 					// Check mask
 					if (meshInput.vecMask.size() != 0) {
@@ -607,123 +775,57 @@ void LinearRemapFVtoFVInvDist(
 						}
 					}
 
-					const Face & faceCurrent = meshInput.faces[iNearestFace];
-
-					// TODO: Precompute face centroids on input mesh
-					Node nodeX1 =
-						GetFaceCentroid(
-							meshInput.faces[iNearestFace],
-							meshInput.nodes);
-
-					Node nodeX1minusQ = nodeX1;
-					nodeX1minusQ.x -= nodeQ.x;
-					nodeX1minusQ.y -= nodeQ.y;
-					nodeX1minusQ.z -= nodeQ.z;
-
-					vecContributingFaceIxs.clear();
-					vecContributingFaceWeights.clear();
-
-					// TODO: Switch to using great circle distance rather than chord dist
-					// TODO: Be careful about nodeCenter1 being zero
-					double dInvDist1 = 1.0 / nodeX1minusQ.Magnitude();
-					vecContributingFaceIxs.push_back(iNearestFace);
-					vecContributingFaceWeights.push_back(dInvDist1);
-
-					// Push neighboring face if it is on the correct side
-					for (int i = 0; i < faceCurrent.edges.size(); i++) {
-
-						const FacePair & facepair =
-								meshInput.edgemap.find(faceCurrent.edges[i])->second;
-
-						if (iNearestFace == facepair[0]){
-
-							// Check mask
-							if (meshInput.vecMask.size() != 0) {
-								if (meshInput.vecMask[facepair[1]] == 0) {
-									continue;
-								}
-							}
-
-							// Add contribution
-							Node nodeX2 =
-								GetFaceCentroid(
-									meshInput.faces[facepair[1]],
-									meshInput.nodes);
-
-							Node nodeX1minusX2 = nodeX1;
-							nodeX1minusX2.x -= nodeX2.x;
-							nodeX1minusX2.y -= nodeX2.y;
-							nodeX1minusX2.z -= nodeX2.z;
-
-							if (DotProduct(nodeX1minusX2, nodeX1minusQ) > 0.0) {
-								Node nodeX2minusQ = nodeX2;
-								nodeX2minusQ.x -= nodeQ.x;
-								nodeX2minusQ.y -= nodeQ.y;
-								nodeX2minusQ.z -= nodeQ.z;
-
-								double dInvDist2 = 1.0 / nodeX2minusQ.Magnitude();
-								vecContributingFaceIxs.push_back(facepair[1]);
-								vecContributingFaceWeights.push_back(dInvDist2);
-							}
-
-						} else if (iNearestFace == facepair[1]) {
-
-							// Check mask
-							if (meshInput.vecMask.size() != 0) {
-								if (meshInput.vecMask[facepair[0]] == 0) {
-									continue;
-								}
-							}
-
-							// Add contribution
-							Node nodeX2 =
-								GetFaceCentroid(
-									meshInput.faces[facepair[0]],
-									meshInput.nodes);
-
-							Node nodeX1minusX2 = nodeX1;
-							nodeX1minusX2.x -= nodeX2.x;
-							nodeX1minusX2.y -= nodeX2.y;
-							nodeX1minusX2.z -= nodeX2.z;
-
-							if (DotProduct(nodeX1minusX2, nodeX1minusQ) > 0.0){
-								Node nodeX2minusQ = nodeX2;
-								nodeX2minusQ.x -= nodeQ.x;
-								nodeX2minusQ.y -= nodeQ.y;
-								nodeX2minusQ.z -= nodeQ.z;
-
-								double dInvDist2 = 1.0 / nodeX2minusQ.Magnitude();
-								vecContributingFaceIxs.push_back(facepair[0]);
-								vecContributingFaceWeights.push_back(dInvDist2);
-							}
+					GetInvDistContributions(
+						meshInput,
+						vecSourceCentroids,
+						iNearestFace,
+						vecQuadPtNodes[ixQ],
+						vecContributingFaceIxs,
+						vecContributingFaceWeights);
 
-						} else {
-							_EXCEPTIONT("Logic error");
-						}
+					if (iPass == 0) {
+						vecEntryBegin[ixQ+1] = vecContributingFaceIxs.size();
+						continue;
 					}
 
 					// Total contributions
 					double dInvWeightSum = 0.0;
-					for (int i = 0; i < vecContributingFaceWeights.size(); i++){
-						dInvWeightSum += vecContributingFaceWeights[i];
+					for (int j = 0; j < vecContributingFaceWeights.size(); j++){
+						dInvWeightSum += vecContributingFaceWeights[j];
 					}
 
 					// Contribution of this quadrature point to the map
-					for (int i = 0; i < vecContributingFaceIxs.size(); i++){
-						smatMap(iTargetFace, vecContributingFaceIxs[i]) +=
-							vecContributingFaceWeights[i]
+					SparseMatrix<double>::Triplet * pTriplet =
+						&(vecTriplets[vecEntryBegin[ixQ]]);
+
+					for (int j = 0; j < vecContributingFaceIxs.size(); j++){
+						pTriplet[j] = SparseMatrix<double>::Triplet(
+							iTargetFace,
+							vecContributingFaceIxs[j],
+							vecContributingFaceWeights[j]
 							/ dInvWeightSum
-							* dQuadPtWeight(k,p)
-							* meshOverlap.vecFaceArea[ixOverlap + j]
-							/ dQuadratureArea
-							/ meshOutput.vecFaceArea[iTargetFace];
+							* vecQuadPtWeight[ixQ]
+							* meshOverlap.vecFaceArea[i]
+							/ vecQuadratureArea[i]
+							/ meshOutput.vecFaceArea[iTargetFace]);
 					}
 				}
 			}
+
+			} catch(Exception & e) {
+				vecBlockError[b] = e.ToString();
+			}
 		}
 
-		// Increment the current overlap index
-		ixOverlap += nOverlapFaces;
+		for (int b = 0; b < nBlocks; b++) {
+			if (vecBlockError[b] != "") {
+				_EXCEPTION1("%s", vecBlockError[b].c_str());
+			}
+		}
+
+		if (iPass == 1) {
+			smatMap.AddTriplets(vecTriplets);
+		}
 	}
 }
 
@@ -1030,6 +1132,10 @@ void LinearRemapFVtoGLL_Simple(
 		dFit(1,0) = nodeA2.x; dFit(1,1) = nodeA2.y; dFit(1,2) = nodeA2.z;
 		dFit(2,0) = nodeC.x;  dFit(2,1) = nodeC.y;  dFit(2,2) = nodeC.z;
 
+		// Factor the fit matrix once for all sample points
+		SmallLUSolver<3> lusolveFit;
+		lusolveFit.Factor(&(dFit(0,0)));
+
 		// Set of Faces to use in building the reconstruction and associated
 		// distance metric.
 		AdjacentFaceVector vecAdjFaces;
@@ -1176,17 +1282,7 @@ void LinearRemapFVtoGLL_Simple(
 					printf("%i %1.15e %1.15e\n", ixSecondNode, dLon, dLat);
 				}
 */
-				int n = 3;
-				int nrhs = 1;
-				int lda = 3;
-				int ipiv[3];
-				int ldb = 3;
-				int info;
-
-				DataArray2D<double> dFitTemp;
-				dFitTemp = dFit;
-				dgesv_(
-					&n, &nrhs, &(dFitTemp(0,0)), &lda, ipiv, dX, &ldb, &info);
+				lusolveFit.Solve(dX);
 
 				// Sample the reconstruction at this point
 				int ixp = 0;
@@ -1635,7 +1731,8 @@ void LinearRemapFVtoGLL(
 	OfflineMap & mapRemap,
 	int nMonotoneType,
 	bool fContinuous,
-	bool fNoConservation
+	bool fNoConservation,
+	double dQuadratureTolerance
 ) {
 	// NOTE: Reducing this quadrature rule order greatly affects error norms
 	// Order of triangular quadrature rule
@@ -1652,8 +1749,9 @@ void LinearRemapFVtoGLL(
 	// Triangular quadrature rule
 	TriangularQuadratureRule triquadrule(TriQuadRuleOrder);
 
-	const DataArray2D<double> & dG = triquadrule.GetG();
-	const DataArray1D<double> & dW = triquadrule.GetW();
+	// Lower order rules used on small overlap triangles
+	AdaptiveTriangularQuadratureRule triquadadapt(
+		triquadrule, dQuadratureTolerance);
 
 	// Get SparseMatrix represntation of the OfflineMap
 	SparseMatrix<double> & smatMap = mapRemap.GetSparseMatrix();
@@ -1664,9 +1762,6 @@ void LinearRemapFVtoGLL(
 	// Order of the finite element method
 	int nP = dataGLLNodes.GetRows();
 
-	// Sample coefficients
-	DataArray2D<double> dSampleCoeff(nP, nP);
-
 	// Number of elements needed
 #ifdef RECTANGULAR_TRUNCATION
 	int nCoefficients = nOrder * nOrder;
@@ -1682,9 +1777,9 @@ void LinearRemapFVtoGLL(
 	Announce("Number of coefficients: %i", nCoefficients);
 	Announce("Required adjacency set size: %i", nRequiredFaceSetSize);
 	Announce("Fit weights exponent: %i", nFitWeightsExponent);
-
-	// Current overlap face
-	int ixOverlap = 0;
+	if (dQuadratureTolerance > 0.0) {
+		Announce("Adaptive quadrature tolerance: %1.5e", dQuadratureTolerance);
+	}
 
 	// Build the integration array for each element on meshOverlap
 	DataArray3D<double> dGlobalIntArray(
@@ -1700,38 +1795,67 @@ void LinearRemapFVtoGLL(
 		nP * nP);
 */
 	// Number of overlap Faces per source Face
-	DataArray1D<int> nAllOverlapFaces(meshInput.faces.size());
-	DataArray1D<int> nAllTotalOverlapTriangles(meshInput.faces.size());
+	const int nFaces = meshInput.faces.size();
 
-	for (int ixFirst = 0; ixFirst < meshInput.faces.size(); ixFirst++) {
+	DataArray1D<int> nAllOverlapFaces(nFaces);
+	DataArray1D<int> nAllTotalOverlapTriangles(nFaces);
 
-		int ixOverlapTemp = ixOverlap;
-		for (; ixOverlapTemp < meshOverlap.faces.size(); ixOverlapTemp++) {
+	// First overlap Face associated with each source Face
+	std::vector<int> vecOverlapBegin(nFaces+1);
+	{
+		int ixOverlap = 0;
+		for (int ixFirst = 0; ixFirst < nFaces; ixFirst++) {
+			vecOverlapBegin[ixFirst] = ixOverlap;
 
-			const Face & faceOverlap = meshOverlap.faces[ixOverlapTemp];
+			int ixOverlapTemp = ixOverlap;
+			for (; ixOverlapTemp < meshOverlap.faces.size(); ixOverlapTemp++) {
 
-			if (meshOverlap.vecSourceFaceIx[ixOverlapTemp] != ixFirst) {
-				break;
+				const Face & faceOverlap = meshOverlap.faces[ixOverlapTemp];
+
+				if (meshOverlap.vecSourceFaceIx[ixOverlapTemp] != ixFirst) {
+					break;
+				}
+
+				nAllOverlapFaces[ixFirst]++;
+				nAllTotalOverlapTriangles[ixFirst] += faceOverlap.edges.size() - 2;
 			}
 
-			nAllOverlapFaces[ixFirst]++;
-			nAllTotalOverlapTriangles[ixFirst] += faceOverlap.edges.size() - 2;
+			// Increment the current overlap index
+			ixOverlap += nAllOverlapFaces[ixFirst];
 		}
-
-		// Increment the current overlap index
-		ixOverlap += nAllOverlapFaces[ixFirst];
+		vecOverlapBegin[nFaces] = ixOverlap;
 	}
 
-	// Loop through all faces on meshInput
-	ixOverlap = 0;
+	// Faces on meshInput are processed in blocks in parallel
+	const int nBlocks =
+		(nFaces + LinearRemapParallelBlockSize - 1)
+			/ LinearRemapParallelBlockSize;
 
-	for (int ixFirst = 0; ixFirst < meshInput.faces.size(); ixFirst++) {
+	std::vector<std::string> vecBlockError(nBlocks);
 
-		// Output every 100 elements
+	// Loop through all faces on meshInput.  Each face only writes to the
+	// entries of dGlobalIntArray associated with its own overlap faces.
+#pragma omp parallel for schedule(dynamic)
+	for (int b = 0; b < nBlocks; b++) {
+		const int ixBegin = b * LinearRemapParallelBlockSize;
+		const int ixEnd =
+			std::min(ixBegin + LinearRemapParallelBlockSize, nFaces);
+
+		// Sample coefficients
+		DataArray2D<double> dSampleCoeff(nP, nP);
+
+		try {
+		for (int ixFirst = ixBegin; ixFirst < ixEnd; ixFirst++) {
+
+		// Output every 1000 elements
 		if (ixFirst % 1000 == 0) {
-                        Announce("Element %i/%i", ixFirst, meshInput.faces.size());
+#pragma omp critical
+			Announce("Element %i/%i", ixFirst, nFaces);
 		}
 
+		// Current overlap face
+		const int ixOverlap = vecOverlapBegin[ixFirst];
+
 		// This Face
 		const Face & faceFirst = meshInput.faces[ixFirst];
 
@@ -1753,6 +1877,10 @@ void LinearRemapFVtoGLL(
 		dFit(1,0) = nodeA2.x; dFit(1,1) = nodeA2.y; dFit(1,2) = nodeA2.z;
 		dFit(2,0) = nodeC.x;  dFit(2,1) = nodeC.y;  dFit(2,2) = nodeC.z;
 
+		// Factor the fit matrix once for all sample points
+		SmallLUSolver<3> lusolveFit;
+		lusolveFit.Factor(&(dFit(0,0)));
+
 		// Number of overlapping Faces and triangles
 		int nOverlapFaces = nAllOverlapFaces[ixFirst];
 		int nTotalOverlapTriangles = nAllTotalOverlapTriangles[ixFirst];
@@ -1760,52 +1888,38 @@ void LinearRemapFVtoGLL(
 		// Loop through all Overlap Faces
 		for (int i = 0; i < nOverlapFaces; i++) {
 
-			// Quantities from the overlap Mesh
-			const Face & faceOverlap = meshOverlap.faces[ixOverlap + i];
-
-			const NodeVector & nodesOverlap = meshOverlap.nodes;
-
 			// Quantities from the Second Mesh
 			int ixSecond = meshOverlap.vecTargetFaceIx[ixOverlap + i];
 
 			const NodeVector & nodesSecond = meshOutput.nodes;
 
 			const Face & faceSecond = meshOutput.faces[ixSecond];
-			int nbEdges = faceOverlap.edges.size();
-			int nOverlapTriangles = 1;
-			Node nodeCenter; // not used if nbEdges == 3
-			if (nbEdges > 3) { // decompose from nodeCenter in this case
-				nOverlapTriangles = nbEdges;
-				for (int k = 0; k < nbEdges; k++) {
-					const Node &node = nodesOverlap[faceOverlap[k]];
-					nodeCenter = nodeCenter + node;
-				}
-				nodeCenter = nodeCenter / nbEdges;
-				double dMagni = sqrt(
-						nodeCenter.x * nodeCenter.x + nodeCenter.y * nodeCenter.y
-								+ nodeCenter.z * nodeCenter.z);
-				nodeCenter = nodeCenter / dMagni; // project back on sphere of radius 1
-			}
+			MeshFaceTriangles triangles(meshOverlap, ixOverlap + i);
 
 			Node node0, node1, node2;
 			double dTriArea;
 			// Loop over all sub-triangles of this Overlap Face
-			for (int j = 0; j < nOverlapTriangles; j++) {
-
-				if (nbEdges == 3) { // will come here only once, nOverlapTriangles == 1 in this case
-					node0 = nodesOverlap[faceOverlap[0]];
-					node1 = nodesOverlap[faceOverlap[1]];
-					node2 = nodesOverlap[faceOverlap[2]];
-				}
-				else { // decompose polygon in triangles around the nodeCenter
-					node0 = nodeCenter;
-					node1 = nodesOverlap[faceOverlap[j]];
-					int j1 = (j + 1) % nbEdges;
-					node2 = nodesOverlap[faceOverlap[j1]];
+			for (int j = 0; j < triangles.size(); j++) {
+				triangles.GetTriangle(j, node0, node1, node2);
+				dTriArea = triangles.GetArea(j, node0, node1, node2);
+
+				// The reconstruction and the finite element basis vary on
+				// the scale of the smaller of the two Faces
+				double dRefArea = dFirstArea;
+				if ((dQuadratureTolerance > 0.0) &&
+				    (meshOutput.vecFaceArea[ixSecond] < dRefArea)
+				) {
+					dRefArea = meshOutput.vecFaceArea[ixSecond];
 				}
-				dTriArea = CalculateTriangleAreaQuadratureMethod(node0, node1,
-						node2);
-				for (int k = 0; k < triquadrule.GetPoints(); k++) {
+
+				const TriangularQuadratureRule & triquadruleTri =
+					triquadadapt.GetRule(triquadadapt.SelectRule(
+						node0, node1, node2, dTriArea, dRefArea));
+
+				const DataArray2D<double> & dG = triquadruleTri.GetG();
+				const DataArray1D<double> & dW = triquadruleTri.GetW();
+
+				for (int k = 0; k < triquadruleTri.GetPoints(); k++) {
 
 					// Get the nodal location of this point
 					double dX[3];
@@ -1828,17 +1942,7 @@ void LinearRemapFVtoGLL(
 					dX[2] -= nodeRef.z;
 
 					// Find the coefficients for this point of the polynomial
-					int n = 3;
-					int nrhs = 1;
-					int lda = 3;
-					int ipiv[3];
-					int ldb = 3;
-					int info;
-
-					DataArray2D<double> dFitTemp;
-					dFitTemp = dFit;
-					dgesv_(
-						&n, &nrhs, &(dFitTemp(0,0)), &lda, ipiv, dX, &ldb, &info);
+					lusolveFit.Solve(dX);
 
 					// Find the components of this quadrature point in the basis
 					// of the finite element.
@@ -1914,9 +2018,18 @@ void LinearRemapFVtoGLL(
 				}
 			}
 		}
+		}
 
-		// Increment the current overlap index
-		ixOverlap += nOverlapFaces;
+		} catch(Exception & e) {
+			vecBlockError[b] = e.ToString();
+		}
+	}
+
+	// Report the error from the first failing face
+	for (int b = 0; b < nBlocks; b++) {
+		if (vecBlockError[b] != "") {
+			_EXCEPTION1("%s", vecBlockError[b].c_str());
+		}
 	}
 
 /*
@@ -2013,8 +2126,24 @@ void LinearRemapFVtoGLL(
 		}
 	}
 */
-	// Force consistency and conservation
-	for (int ixSecond = 0; ixSecond < meshOutput.faces.size(); ixSecond++) {
+	// Force consistency and conservation.  Each face on meshOutput only
+	// modifies the entries of dGlobalIntArray of its own overlap faces.
+	const int nSecondFaces = meshOutput.faces.size();
+
+	const int nSecondBlocks =
+		(nSecondFaces + LinearRemapParallelBlockSize - 1)
+			/ LinearRemapParallelBlockSize;
+
+	std::vector<std::string> vecSecondBlockError(nSecondBlocks);
+
+#pragma omp parallel for schedule(dynamic)
+	for (int b = 0; b < nSecondBlocks; b++) {
+		const int ixBegin = b * LinearRemapParallelBlockSize;
+		const int ixEnd =
+			std::min(ixBegin + LinearRemapParallelBlockSize, nSecondFaces);
+
+		try {
+		for (int ixSecond = ixBegin; ixSecond < ixEnd; ixSecond++) {
 
 		if (vecReverseFaceIx[ixSecond].size() == 0) {
 			continue;
@@ -2114,6 +2243,18 @@ void LinearRemapFVtoGLL(
 
 		_EXCEPTION();
 */
+		}
+
+		} catch(Exception & e) {
+			vecSecondBlockError[b] = e.ToString();
+		}
+	}
+
+	// Report the error from the first failing face
+	for (int b = 0; b < nSecondBlocks; b++) {
+		if (vecSecondBlockError[b] != "") {
+			_EXCEPTION1("%s", vecSecondBlockError[b].c_str());
+		}
 	}
 
 /*
@@ -2164,193 +2305,238 @@ void LinearRemapFVtoGLL(
 	// Impose conservative and consistent conditions on integration array
 	//_EXCEPTION();
 
-	// Construct finite-volume fit matrix and compose with integration operator
-	ixOverlap = 0;
-
-	for (int ixFirst = 0; ixFirst < meshInput.faces.size(); ixFirst++) {
-
-		// Output every 100 elements
-		if (ixFirst % 1000 == 0) {
-                        Announce("Element %i/%i", ixFirst, meshInput.faces.size());
-		}
-
-		// This Face
-		const Face & faceFirst = meshInput.faces[ixFirst];
-
-		// Area of the First Face
-		double dFirstArea = meshInput.vecFaceArea[ixFirst];
-
-		// Number of overlapping Faces and triangles
-		int nOverlapFaces = nAllOverlapFaces[ixFirst];
-		int nTotalOverlapTriangles = nAllTotalOverlapTriangles[ixFirst];
-/*
-		// Verify equal partition of mass in integration array
-		double dTotal = 0.0;
-		for (int i = 0; i < nOverlapFaces; i++) {
-			int ixSecond = meshOverlap.vecTargetFaceIx[ixOverlap + i];
-
-			for (int s = 0; s < nP * nP; s++) {
-				dTotal += dGlobalIntArray[0][ixOverlap + i][s]
-					* dataGLLJacobian[s/nP][s%nP][ixSecond]
-					/ dFirstArea;
+	// Construct finite-volume fit matrix and compose with integration
+	// operator.  Map weights are computed for blocks of faces on meshInput
+	// in parallel and stored as triplets, which are added to the map in
+	// order of the faces on meshInput.
+	std::vector<SparseMatrix<double>::TripletVector> vecBlockTriplets(nBlocks);
+
+	// Blocks are computed in chunks of LinearRemapAssemblyChunkBlocks so
+	// that only the triplets of one chunk are held in memory at a time
+	for (int bBegin = 0; bBegin < nBlocks;
+	     bBegin += LinearRemapAssemblyChunkBlocks
+	) {
+		const int bEnd =
+			std::min(bBegin + LinearRemapAssemblyChunkBlocks, nBlocks);
+
+#pragma omp parallel for schedule(dynamic)
+		for (int b = bBegin; b < bEnd; b++) {
+			const int ixBegin = b * LinearRemapParallelBlockSize;
+			const int ixEnd =
+				std::min(ixBegin + LinearRemapParallelBlockSize, nFaces);
+
+			SparseMatrix<double>::TripletVector & vecTriplets =
+				vecBlockTriplets[b];
+
+			try {
+			for (int ixFirst = ixBegin; ixFirst < ixEnd; ixFirst++) {
+
+			// Output every 1000 elements
+			if (ixFirst % 1000 == 0) {
+#pragma omp critical
+				Announce("Element %i/%i", ixFirst, nFaces);
 			}
-		}
-		if (fabs(dTotal - 1.0) > 1.0e-8) {
-			printf("%1.15e\n", dTotal);
-			_EXCEPTION();
-		}
-*/
-		// Determine the conservative constraint equation
-		DataArray1D<double> dConstraint(nCoefficients);
 
-		for (int p = 0; p < nCoefficients; p++) {
-		for (int i = 0; i < nOverlapFaces; i++) {
-			int ixSecond = meshOverlap.vecTargetFaceIx[ixOverlap + i];
-
-			for (int s = 0; s < nP * nP; s++) {
-				dConstraint[p] += dGlobalIntArray[p][ixOverlap + i][s]
-					* dataGLLJacobian[s/nP][s%nP][ixSecond]
-					/ dFirstArea;
-			}
-		}
-		}
+			// Current overlap face
+			const int ixOverlap = vecOverlapBegin[ixFirst];
 
-/*
-		for (int p = 0; p < nCoefficients; p++) {
-		for (int j = 0; j < nOverlapFaces * nP * nP; j++) {
-			dConstraint[p] += dIntArray[p][j] / dFirstArea;
-		}
-		}
-*/
-		// Set of Faces to use in building the reconstruction and associated
-		// distance metric.
-		AdjacentFaceVector vecAdjFaces;
+			// This Face
+			const Face & faceFirst = meshInput.faces[ixFirst];
 
-//#ifdef RECTANGULAR_TRUNCATION
-//		GetAdjacentFaceVectorByNode(
-//#endif
-//#ifdef TRIANGULAR_TRUNCATION
-		GetAdjacentFaceVectorByEdge(
-//#endif
-			meshInput,
-			ixFirst,
-			nRequiredFaceSetSize,
-			vecAdjFaces);
+			// Area of the First Face
+			double dFirstArea = meshInput.vecFaceArea[ixFirst];
 
-		// Number of adjacent Faces
-		int nAdjFaces = vecAdjFaces.size();
+			// Number of overlapping Faces and triangles
+			int nOverlapFaces = nAllOverlapFaces[ixFirst];
+			int nTotalOverlapTriangles = nAllTotalOverlapTriangles[ixFirst];
+	/*
+			// Verify equal partition of mass in integration array
+			double dTotal = 0.0;
+			for (int i = 0; i < nOverlapFaces; i++) {
+				int ixSecond = meshOverlap.vecTargetFaceIx[ixOverlap + i];
 
-		for (int x = 0; x < nAdjFaces; x++) {
-			if (vecAdjFaces[x].first == (-1)) {
+				for (int s = 0; s < nP * nP; s++) {
+					dTotal += dGlobalIntArray[0][ixOverlap + i][s]
+						* dataGLLJacobian[s/nP][s%nP][ixSecond]
+						/ dFirstArea;
+				}
+			}
+			if (fabs(dTotal - 1.0) > 1.0e-8) {
+				printf("%1.15e\n", dTotal);
 				_EXCEPTION();
 			}
-		}
-
-		// Build the fit operator
-		DataArray2D<double> dFitArray;
-		DataArray1D<double> dFitWeights;
-		DataArray2D<double> dFitArrayPlus;
-
-		BuildFitArray(
-			meshInput,
-			triquadrule,
-			ixFirst,
-			vecAdjFaces,
-			nOrder,
-			nFitWeightsExponent,
-			dConstraint,
-			dFitArray,
-			dFitWeights
-		);
+	*/
+			// Determine the conservative constraint equation
+			DataArray1D<double> dConstraint(nCoefficients);
 
-/*
-		DataArray1D<double> dRowSum;
-		dRowSum.Initialize(nCoefficients);
+			for (int p = 0; p < nCoefficients; p++) {
+			for (int i = 0; i < nOverlapFaces; i++) {
+				int ixSecond = meshOverlap.vecTargetFaceIx[ixOverlap + i];
 
-		for (int i = 0; i < nAdjFaces; i++) {
-		for (int k = 0; k < nCoefficients; k++) {
-			dRowSum[k] += dFitArrayPlus[i][k];
-		}
-		}
+				for (int s = 0; s < nP * nP; s++) {
+					dConstraint[p] += dGlobalIntArray[p][ixOverlap + i][s]
+						* dataGLLJacobian[s/nP][s%nP][ixSecond]
+						/ dFirstArea;
+				}
+			}
+			}
 
-		for (int k = 0; k < nCoefficients; k++) {
-			printf("%1.15e\n", dRowSum[k]);
-		}
-		_EXCEPTION();
-*/
+	/*
+			for (int p = 0; p < nCoefficients; p++) {
+			for (int j = 0; j < nOverlapFaces * nP * nP; j++) {
+				dConstraint[p] += dIntArray[p][j] / dFirstArea;
+			}
+			}
+	*/
+			// Set of Faces to use in building the reconstruction and associated
+			// distance metric.
+			AdjacentFaceVector vecAdjFaces;
+
+	//#ifdef RECTANGULAR_TRUNCATION
+	//		GetAdjacentFaceVectorByNode(
+	//#endif
+	//#ifdef TRIANGULAR_TRUNCATION
+			GetAdjacentFaceVectorByEdge(
+	//#endif
+				meshInput,
+				ixFirst,
+				nRequiredFaceSetSize,
+				vecAdjFaces);
+
+			// Number of adjacent Faces
+			int nAdjFaces = vecAdjFaces.size();
+
+			for (int x = 0; x < nAdjFaces; x++) {
+				if (vecAdjFaces[x].first == (-1)) {
+					_EXCEPTION();
+				}
+			}
 
-		// Compute the pseudoinverse fit array
-		bool fSuccess =
-			InvertFitArray_Corrected(
+			// Build the fit operator
+			DataArray2D<double> dFitArray;
+			DataArray1D<double> dFitWeights;
+			DataArray2D<double> dFitArrayPlus;
+
+			BuildFitArray(
+				meshInput,
+				triquadrule,
+				ixFirst,
+				vecAdjFaces,
+				nOrder,
+				nFitWeightsExponent,
 				dConstraint,
 				dFitArray,
-				dFitWeights,
-				dFitArrayPlus
+				dFitWeights
 			);
 
-		// Build the composition, which maps average values in adjacent cells
-		// to the integrated values of the reconstruction in overlap faces.
-		DataArray2D<double> dComposedArray(nAdjFaces, nOverlapFaces * nP * nP);
-		if (fSuccess) {
-			for (int j = 0; j < nOverlapFaces; j++) {
-				//int ixSecond = meshOverlap.vecTargetFaceIx[ixOverlap + j];
+	/*
+			DataArray1D<double> dRowSum;
+			dRowSum.Initialize(nCoefficients);
 
-				for (int i = 0; i < nAdjFaces; i++) {
-				for (int s = 0; s < nP * nP; s++) {
-				for (int k = 0; k < nCoefficients; k++) {
-					dComposedArray[i][j * nP * nP + s] +=
-						dGlobalIntArray[k][ixOverlap + j][s]
-						* dFitArrayPlus[i][k];
-				}
-				}
-				}
+			for (int i = 0; i < nAdjFaces; i++) {
+			for (int k = 0; k < nCoefficients; k++) {
+				dRowSum[k] += dFitArrayPlus[i][k];
+			}
 			}
 
-		// Unable to invert fit array, drop to 1st order.  In this case
-		// dFitArrayPlus(0,0) = 1 and all other entries are zero.
-		} else {
-			for (int j = 0; j < nOverlapFaces; j++) {
-				//int ixSecond = meshOverlap.vecTargetFaceIx[ixOverlap + j];
+			for (int k = 0; k < nCoefficients; k++) {
+				printf("%1.15e\n", dRowSum[k]);
+			}
+			_EXCEPTION();
+	*/
+
+			// Compute the pseudoinverse fit array
+			bool fSuccess =
+				InvertFitArray_Corrected(
+					dConstraint,
+					dFitArray,
+					dFitWeights,
+					dFitArrayPlus
+				);
+
+			// Build the composition, which maps average values in adjacent cells
+			// to the integrated values of the reconstruction in overlap faces.
+			DataArray2D<double> dComposedArray(nAdjFaces, nOverlapFaces * nP * nP);
+			if (fSuccess) {
+				for (int j = 0; j < nOverlapFaces; j++) {
+					//int ixSecond = meshOverlap.vecTargetFaceIx[ixOverlap + j];
+
+					for (int i = 0; i < nAdjFaces; i++) {
+					for (int s = 0; s < nP * nP; s++) {
+					for (int k = 0; k < nCoefficients; k++) {
+						dComposedArray[i][j * nP * nP + s] +=
+							dGlobalIntArray[k][ixOverlap + j][s]
+							* dFitArrayPlus[i][k];
+					}
+					}
+					}
+				}
 
-				for (int s = 0; s < nP * nP; s++) {
-					dComposedArray[0][j * nP * nP + s] +=
-						dGlobalIntArray[0][ixOverlap + j][s];
+			// Unable to invert fit array, drop to 1st order.  In this case
+			// dFitArrayPlus(0,0) = 1 and all other entries are zero.
+			} else {
+				for (int j = 0; j < nOverlapFaces; j++) {
+					//int ixSecond = meshOverlap.vecTargetFaceIx[ixOverlap + j];
+
+					for (int s = 0; s < nP * nP; s++) {
+						dComposedArray[0][j * nP * nP + s] +=
+							dGlobalIntArray[0][ixOverlap + j][s];
+					}
 				}
 			}
-		}
 
-		// Put composed array into map
-		for (int i = 0; i < vecAdjFaces.size(); i++) {
-		for (int j = 0; j < nOverlapFaces; j++) {
-			int ixFirstFace = vecAdjFaces[i].first;
-			int ixSecondFace = meshOverlap.vecTargetFaceIx[ixOverlap + j];
+			// Put composed array into map
+			for (int i = 0; i < vecAdjFaces.size(); i++) {
+			for (int j = 0; j < nOverlapFaces; j++) {
+				int ixFirstFace = vecAdjFaces[i].first;
+				int ixSecondFace = meshOverlap.vecTargetFaceIx[ixOverlap + j];
 
-			for (int s = 0; s < nP; s++) {
-			for (int t = 0; t < nP; t++) {
+				for (int s = 0; s < nP; s++) {
+				for (int t = 0; t < nP; t++) {
 
-				int jx = j * nP * nP + s * nP + t;
+					int jx = j * nP * nP + s * nP + t;
 
-				if (fContinuous) {
-					int ixSecondNode = dataGLLNodes[s][t][ixSecondFace] - 1;
+					if (fContinuous) {
+						int ixSecondNode = dataGLLNodes[s][t][ixSecondFace] - 1;
 
-					smatMap(ixSecondNode, ixFirstFace) +=
-						dComposedArray[i][jx]
-						* dataGLLJacobian[s][t][ixSecondFace]
-						/ dataGLLNodalArea[ixSecondNode];
+						vecTriplets.push_back(
+							SparseMatrix<double>::Triplet(
+								ixSecondNode,
+								ixFirstFace,
+								dComposedArray[i][jx]
+								* dataGLLJacobian[s][t][ixSecondFace]
+								/ dataGLLNodalArea[ixSecondNode]));
 
-				} else {
-					int ixSecondNode = ixSecondFace * nP * nP + s * nP + t;
+					} else {
+						int ixSecondNode = ixSecondFace * nP * nP + s * nP + t;
 
-					smatMap(ixSecondNode, ixFirstFace) +=
-						dComposedArray[i][jx];
+						vecTriplets.push_back(
+							SparseMatrix<double>::Triplet(
+								ixSecondNode,
+								ixFirstFace,
+								dComposedArray[i][jx]));
+					}
 				}
+				}
+			}
 			}
 			}
+
+			} catch(Exception & e) {
+				vecBlockError[b] = e.ToString();
+			}
 		}
+
+		// Report the error from the first failing face
+		for (int b = bBegin; b < bEnd; b++) {
+			if (vecBlockError[b] != "") {
+				_EXCEPTION1("%s", vecBlockError[b].c_str());
+			}
 		}
 
-		// Increment the current overlap index
-		ixOverlap += nOverlapFaces;
+		// Insert the triplets of the chunk into the map in order of the
+		// blocks, releasing them before the next chunk is computed
+		smatMap.AddBlockTriplets(vecBlockTriplets);
 	}
 }
 
@@ -2382,39 +2568,33 @@ void LinearRemapGLLtoGLL2(
 	// Get SparseMatrix represntation of the OfflineMap
 	SparseMatrix<double> & smatMap = mapRemap.GetSparseMatrix();
 
-	// Sample coefficients
-	DataArray2D<double> dSampleCoeffIn(nPin, nPin);
-	DataArray2D<double> dSampleCoeffOut(nPout, nPout);
-
 	// Build the integration array for each element on meshOverlap
 	DataArray3D<double> dGlobalIntArray(
 		nPin * nPin,
 		meshOverlap.faces.size(),
 		nPout * nPout);
 
-	// Number of overlap Faces per source Face
-	DataArray1D<int> nAllOverlapFaces(meshInput.faces.size());
-
-	int ixOverlap = 0;
-
-	for (int ixFirst = 0; ixFirst < meshInput.faces.size(); ixFirst++) {
-
-		int ixOverlapTemp = ixOverlap;
-		for (; ixOverlapTemp < meshOverlap.faces.size(); ixOverlapTemp++) {
-
-			const Face & faceOverlap = meshOverlap.faces[ixOverlapTemp];
-
-			if (meshOverlap.vecSourceFaceIx[ixOverlapTemp] != ixFirst) {
-				break;
+	// Range of overlap faces associated with each face on meshInput
+	const int nFaces = meshInput.faces.size();
+
+	std::vector<int> vecOverlapBegin(nFaces+1);
+	{
+		int ixOverlap = 0;
+		for (int ixFirst = 0; ixFirst < nFaces; ixFirst++) {
+			vecOverlapBegin[ixFirst] = ixOverlap;
+			for (; ixOverlap < meshOverlap.faces.size(); ixOverlap++) {
+				if (meshOverlap.vecSourceFaceIx[ixOverlap] != ixFirst) {
+					break;
+				}
 			}
-
-			nAllOverlapFaces[ixFirst]++;
 		}
-
-		// Increment the current overlap index
-		ixOverlap += nAllOverlapFaces[ixFirst];
+		vecOverlapBegin[nFaces] = ixOverlap;
 	}
 
+	const int nBlocks =
+		(nFaces + LinearRemapParallelBlockSize - 1)
+			/ LinearRemapParallelBlockSize;
+
 	// Geometric area of each output node
 	DataArray2D<double> dGeometricOutputArea(
 		meshOutput.faces.size(), nPout * nPout);
@@ -2423,24 +2603,41 @@ void LinearRemapGLLtoGLL2(
 	DataArray2D<double> dOverlapOutputArea(
 		meshOverlap.faces.size(), nPout * nPout);
 
-	// Loop through all faces on meshInput
-	ixOverlap = 0;
-
+	// Overlap Faces of blocks of faces on meshInput are integrated and
+	// corrected in parallel; each block only writes its own overlap Faces
 	Announce("Building conservative distribution maps");
-	for (int ixFirst = 0; ixFirst < meshInput.faces.size(); ixFirst++) {
 
-		// Output every 100 elements
+	std::vector<std::string> vecBlockError(nBlocks);
+
+#pragma omp parallel for schedule(dynamic)
+	for (int b = 0; b < nBlocks; b++) {
+		const int ixBegin = b * LinearRemapParallelBlockSize;
+		const int ixEnd =
+			std::min(ixBegin + LinearRemapParallelBlockSize, nFaces);
+
+		// Sample coefficients
+		DataArray2D<double> dSampleCoeffIn(nPin, nPin);
+		DataArray2D<double> dSampleCoeffOut(nPout, nPout);
+
+		try {
+		for (int ixFirst = ixBegin; ixFirst < ixEnd; ixFirst++) {
+
+		// Output every 1000 elements
 		if (ixFirst % 1000 == 0) {
-                        Announce("Element %i/%i", ixFirst, meshInput.faces.size());
+#pragma omp critical
+			Announce("Element %i/%i", ixFirst, nFaces);
 		}
 
+		// Overlap Faces associated with this Face
+		const int ixOverlap = vecOverlapBegin[ixFirst];
+
+		const int nOverlapFaces = vecOverlapBegin[ixFirst+1] - ixOverlap;
+
 		// Quantities from the First Mesh
 		const Face & faceFirst = meshInput.faces[ixFirst];
 
 		const NodeVector & nodesFirst = meshInput.nodes;
 
-		// Number of overlapping Faces and triangles
-		int nOverlapFaces = nAllOverlapFaces[ixFirst];
 /*
 		// Calculate total element Jacobian
 		double dTotalJacobian = 0.0;
@@ -2453,48 +2650,19 @@ void LinearRemapGLLtoGLL2(
 		// Loop through all Overlap Faces
 		for (int i = 0; i < nOverlapFaces; i++) {
 
-			// Quantities from the overlap Mesh
-			const Face & faceOverlap = meshOverlap.faces[ixOverlap + i];
-			const NodeVector & nodesOverlap = meshOverlap.nodes;
 			// Quantities from the Second Mesh
 			int ixSecond = meshOverlap.vecTargetFaceIx[ixOverlap + i];
 			const NodeVector & nodesSecond = meshOutput.nodes;
 			const Face & faceSecond = meshOutput.faces[ixSecond];
-			int nbEdges = faceOverlap.edges.size();
-			int nOverlapTriangles = 1;
-			Node nodeCenter; // not used if nbEdges == 3
-			if (nbEdges > 3) { // decompose from nodeCenter in this case
-				nOverlapTriangles = nbEdges;
-				for (int k = 0; k < nbEdges; k++) {
-					const Node &node = nodesOverlap[faceOverlap[k]];
-					nodeCenter = nodeCenter + node;
-				}
-				nodeCenter = nodeCenter / nbEdges;
-				double dMagni = sqrt(
-						nodeCenter.x * nodeCenter.x + nodeCenter.y * nodeCenter.y
-								+ nodeCenter.z * nodeCenter.z);
-				nodeCenter = nodeCenter / dMagni; // project back on sphere of radius 1
-			}
+			MeshFaceTriangles triangles(meshOverlap, ixOverlap + i);
 
 			Node node0, node1, node2;
 			double dTriArea;
 
 			// Loop over all sub-triangles of this Overlap Face
-			for (int j = 0; j < nOverlapTriangles; j++) {
-
-				if (nbEdges == 3) { // will come here only once, nOverlapTriangles == 1 in this case
-					node0 = nodesOverlap[faceOverlap[0]];
-					node1 = nodesOverlap[faceOverlap[1]];
-					node2 = nodesOverlap[faceOverlap[2]];
-				}
-				else { // decompose polygon in triangles around the nodeCenter
-					node0 = nodeCenter;
-					node1 = nodesOverlap[faceOverlap[j]];
-					int j1 = (j + 1) % nbEdges;
-					node2 = nodesOverlap[faceOverlap[j1]];
-				}
-				dTriArea = CalculateTriangleAreaQuadratureMethod(node0, node1,
-						node2);
+			for (int j = 0; j < triangles.size(); j++) {
+				triangles.GetTriangle(j, node0, node1, node2);
+				dTriArea = triangles.GetArea(j, node0, node1, node2);
 
 				for (int k = 0; k < triquadrule.GetPoints(); k++) {
 
@@ -2581,9 +2749,6 @@ void LinearRemapGLLtoGLL2(
 
 						dOverlapOutputArea[ixOverlap + i][s * nPout + t] +=
 							dNodeArea;
-
-						dGeometricOutputArea[ixSecond][s * nPout + t] +=
-							dNodeArea;
 					}
 					}
 
@@ -2725,20 +2890,46 @@ void LinearRemapGLLtoGLL2(
 		}
 		_EXCEPTION();
 */
+		}
 
-		// Increment the current overlap index
-		ixOverlap += nOverlapFaces;
+		} catch(Exception & e) {
+			vecBlockError[b] = e.ToString();
+		}
+	}
+
+	// Report the error from the first failing face
+	for (int b = 0; b < nBlocks; b++) {
+		if (vecBlockError[b] != "") {
+			_EXCEPTION1("%s", vecBlockError[b].c_str());
+		}
+	}
+
+	// Geometric area of each output node, accumulated in order of overlap Face
+	for (int ixOverlap = 0; ixOverlap < meshOverlap.faces.size(); ixOverlap++) {
+		const int ixSecond = meshOverlap.vecTargetFaceIx[ixOverlap];
+
+		for (int s = 0; s < nPout * nPout; s++) {
+			dGeometricOutputArea[ixSecond][s] +=
+				dOverlapOutputArea[ixOverlap][s];
+		}
 	}
 
 	// Build redistribution map within target element
 	Announce("Building redistribution maps on target mesh");
-	DataArray1D<double> dRedistSourceArea(nPout * nPout);
-	DataArray1D<double> dRedistTargetArea(nPout * nPout);
+	const int nTargetFaces = meshOutput.faces.size();
+
 	std::vector< DataArray2D<double> > dRedistributionMaps;
-	dRedistributionMaps.resize(meshOutput.faces.size());
+	dRedistributionMaps.resize(nTargetFaces);
 
-	for (int ixSecond = 0; ixSecond < meshOutput.faces.size(); ixSecond++) {
+	std::vector<std::string> vecTargetFaceError(nTargetFaces);
+
+#pragma omp parallel for schedule(dynamic, LinearRemapParallelBlockSize)
+	for (int ixSecond = 0; ixSecond < nTargetFaces; ixSecond++) {
 
+		DataArray1D<double> dRedistSourceArea(nPout * nPout);
+		DataArray1D<double> dRedistTargetArea(nPout * nPout);
+
+		try {
 		dRedistributionMaps[ixSecond].Allocate(
 			nPout * nPout, nPout * nPout);
 
@@ -2770,6 +2961,16 @@ void LinearRemapGLLtoGLL2(
 			}
 			}
 		}
+
+		} catch(Exception & e) {
+			vecTargetFaceError[ixSecond] = e.ToString();
+		}
+	}
+
+	for (int ixSecond = 0; ixSecond < nTargetFaces; ixSecond++) {
+		if (vecTargetFaceError[ixSecond] != "") {
+			_EXCEPTION1("%s", vecTargetFaceError[ixSecond].c_str());
+		}
 	}
 
 	// Construct the total geometric area
@@ -2784,97 +2985,144 @@ void LinearRemapGLLtoGLL2(
 	}
 
 	// Compose the integration operator with the output map
-	ixOverlap = 0;
-
 	Announce("Assembling map");
 
-	// Map from source DOFs to target DOFs with redistribution applied
-	DataArray2D<double> dRedistributedOp(
-		nPin * nPin, nPout * nPout);
-
-	for (int ixFirst = 0; ixFirst < meshInput.faces.size(); ixFirst++) {
-
-		// Output every 100 elements
-		if (ixFirst % 1000 == 0) {
-                        Announce("Element %i/%i", ixFirst, meshInput.faces.size());
-		}
-
-		// This Face
-		const Face & faceFirst = meshInput.faces[ixFirst];
+	// Map weights are assembled for blocks of faces on meshInput in
+	// parallel and stored as triplets, which are added to the map in
+	// order of the faces on meshInput
+	std::vector<SparseMatrix<double>::TripletVector> vecBlockTriplets(nBlocks);
+
+	// Blocks are computed in chunks of LinearRemapAssemblyChunkBlocks so
+	// that only the triplets of one chunk are held in memory at a time
+	for (int bBegin = 0; bBegin < nBlocks;
+	     bBegin += LinearRemapAssemblyChunkBlocks
+	) {
+		const int bEnd =
+			std::min(bBegin + LinearRemapAssemblyChunkBlocks, nBlocks);
+
+#pragma omp parallel for schedule(dynamic)
+		for (int b = bBegin; b < bEnd; b++) {
+			const int ixBegin = b * LinearRemapParallelBlockSize;
+			const int ixEnd =
+				std::min(ixBegin + LinearRemapParallelBlockSize, nFaces);
+
+			SparseMatrix<double>::TripletVector & vecTriplets =
+				vecBlockTriplets[b];
+
+			// Map from source DOFs to target DOFs with redistribution applied
+			DataArray2D<double> dRedistributedOp(
+				nPin * nPin, nPout * nPout);
+
+			try {
+			for (int ixFirst = ixBegin; ixFirst < ixEnd; ixFirst++) {
+
+			// Output every 1000 elements
+			if (ixFirst % 1000 == 0) {
+#pragma omp critical
+				Announce("Element %i/%i", ixFirst, nFaces);
+			}
 
-		// Number of overlapping Faces and triangles
-		int nOverlapFaces = nAllOverlapFaces[ixFirst];
+			// Overlap Faces associated with this Face
+			const int ixOverlap = vecOverlapBegin[ixFirst];
 
-		// Put composed array into map
-		for (int j = 0; j < nOverlapFaces; j++) {
-			int ixSecondFace = meshOverlap.vecTargetFaceIx[ixOverlap + j];
+			const int nOverlapFaces = vecOverlapBegin[ixFirst+1] - ixOverlap;
 
-			dRedistributedOp.Zero();
-			for (int p = 0; p < nPin * nPin; p++) {
-			for (int s = 0; s < nPout * nPout; s++) {
-				for (int t = 0; t < nPout * nPout; t++) {
-					dRedistributedOp[p][s] +=
-						dRedistributionMaps[ixSecondFace][s][t]
-						* dGlobalIntArray[p][ixOverlap + j][t];
+			// Put composed array into map
+			for (int j = 0; j < nOverlapFaces; j++) {
+				int ixSecondFace = meshOverlap.vecTargetFaceIx[ixOverlap + j];
+
+				dRedistributedOp.Zero();
+				for (int p = 0; p < nPin * nPin; p++) {
+				for (int s = 0; s < nPout * nPout; s++) {
+					for (int t = 0; t < nPout * nPout; t++) {
+						dRedistributedOp[p][s] +=
+							dRedistributionMaps[ixSecondFace][s][t]
+							* dGlobalIntArray[p][ixOverlap + j][t];
+					}
 				}
-			}
-			}
-
-			int ixp = 0;
-			for (int p = 0; p < nPin; p++) {
-			for (int q = 0; q < nPin; q++) {
-
-				int ixFirstNode;
-				if (fContinuousIn) {
-					ixFirstNode = dataGLLNodesIn[p][q][ixFirst] - 1;
-				} else {
-					ixFirstNode = ixFirst * nPin * nPin + p * nPin + q;
 				}
 
-				int ixs = 0;
-				for (int s = 0; s < nPout; s++) {
-				for (int t = 0; t < nPout; t++) {
+				int ixp = 0;
+				for (int p = 0; p < nPin; p++) {
+				for (int q = 0; q < nPin; q++) {
 
-					int ixSecondNode;
-					if (fContinuousOut) {
-						ixSecondNode = dataGLLNodesOut[s][t][ixSecondFace] - 1;
+					int ixFirstNode;
+					if (fContinuousIn) {
+						ixFirstNode = dataGLLNodesIn[p][q][ixFirst] - 1;
+					} else {
+						ixFirstNode = ixFirst * nPin * nPin + p * nPin + q;
+					}
 
-						if (!fNoConservation) {
-							smatMap(ixSecondNode, ixFirstNode) +=
-								dRedistributedOp[ixp][ixs]
-								/ dataNodalAreaOut[ixSecondNode];
-						} else {
-							smatMap(ixSecondNode, ixFirstNode) +=
-								dRedistributedOp[ixp][ixs]
-								/ dTotalGeometricArea[ixSecondNode];
-						}
+					int ixs = 0;
+					for (int s = 0; s < nPout; s++) {
+					for (int t = 0; t < nPout; t++) {
 
-					} else {
-						ixSecondNode =
-							ixSecondFace * nPout * nPout + s * nPout + t;
+						int ixSecondNode;
+						if (fContinuousOut) {
+							ixSecondNode = dataGLLNodesOut[s][t][ixSecondFace] - 1;
+
+							if (!fNoConservation) {
+								vecTriplets.push_back(
+									SparseMatrix<double>::Triplet(
+										ixSecondNode,
+										ixFirstNode,
+										dRedistributedOp[ixp][ixs]
+										/ dataNodalAreaOut[ixSecondNode]));
+							} else {
+								vecTriplets.push_back(
+									SparseMatrix<double>::Triplet(
+										ixSecondNode,
+										ixFirstNode,
+										dRedistributedOp[ixp][ixs]
+										/ dTotalGeometricArea[ixSecondNode]));
+							}
 
-						if (!fNoConservation) {
-							smatMap(ixSecondNode, ixFirstNode) +=
-								dRedistributedOp[ixp][ixs]
-								/ dataGLLJacobianOut[s][t][ixSecondFace];
 						} else {
-							smatMap(ixSecondNode, ixFirstNode) +=
-								dRedistributedOp[ixp][ixs]
-								/ dGeometricOutputArea[ixSecondFace][s * nPout + t];
+							ixSecondNode =
+								ixSecondFace * nPout * nPout + s * nPout + t;
+
+							if (!fNoConservation) {
+								vecTriplets.push_back(
+									SparseMatrix<double>::Triplet(
+										ixSecondNode,
+										ixFirstNode,
+										dRedistributedOp[ixp][ixs]
+										/ dataGLLJacobianOut[s][t][ixSecondFace]));
+							} else {
+								vecTriplets.push_back(
+									SparseMatrix<double>::Triplet(
+										ixSecondNode,
+										ixFirstNode,
+										dRedistributedOp[ixp][ixs]
+										/ dGeometricOutputArea[ixSecondFace][s * nPout + t]));
+							}
 						}
+
+						ixs++;
+					}
 					}
 
-					ixs++;
+					ixp++;
 				}
 				}
+			}
+			}
 
-				ixp++;
+			} catch(Exception & e) {
+				vecBlockError[b] = e.ToString();
 			}
+		}
+
+		// Report the error from the first failing face
+		for (int b = bBegin; b < bEnd; b++) {
+			if (vecBlockError[b] != "") {
+				_EXCEPTION1("%s", vecBlockError[b].c_str());
 			}
 		}
 
-		// Increment the current overlap index
-		ixOverlap += nOverlapFaces;
+		// Insert the triplets of the chunk into the map in order of the
+		// blocks, releasing them before the next chunk is computed
+		smatMap.AddBlockTriplets(vecBlockTriplets);
 	}
 }
 
@@ -2908,53 +3156,75 @@ void LinearRemapGLLtoGLL2_Pointwise(
 	// Get SparseMatrix represntation of the OfflineMap
 	SparseMatrix<double> & smatMap = mapRemap.GetSparseMatrix();
 
-	// Sample coefficients
-	DataArray2D<double> dSampleCoeffIn(nPin, nPin);
-
-	// Number of overlap Faces per source Face
-	DataArray1D<int> nAllOverlapFaces(meshInput.faces.size());
-
-	int ixOverlap = 0;
+	// Range of overlap faces associated with each face on meshInput
+	const int nFaces = meshInput.faces.size();
+
+	std::vector<int> vecOverlapBegin(nFaces+1);
+	{
+		int ixOverlap = 0;
+		for (int ixFirst = 0; ixFirst < nFaces; ixFirst++) {
+			vecOverlapBegin[ixFirst] = ixOverlap;
+			for (; ixOverlap < meshOverlap.faces.size(); ixOverlap++) {
+				if (meshOverlap.vecSourceFaceIx[ixOverlap] != ixFirst) {
+					break;
+				}
+			}
+		}
+		vecOverlapBegin[nFaces] = ixOverlap;
+	}
 
-	for (int ixFirst = 0; ixFirst < meshInput.faces.size(); ixFirst++) {
+	const int nBlocks =
+		(nFaces + LinearRemapParallelBlockSize - 1)
+			/ LinearRemapParallelBlockSize;
 
-		int ixOverlapTemp = ixOverlap;
-		for (; ixOverlapTemp < meshOverlap.faces.size(); ixOverlapTemp++) {
+	// Number of nodes on meshOutput
+	const int nSecondNodes = dataNodalAreaOut.GetRows();
 
-			const Face & faceOverlap = meshOverlap.faces[ixOverlapTemp];
+	// Target nodes are sampled for blocks of faces on meshInput in parallel.
+	// Each block stores the triplets of the first sample of every target
+	// node it finds, and blocks are merged in order so that each target node
+	// is sampled from the same face on meshInput as in a serial search.
+	std::vector<SparseMatrix<double>::TripletVector> vecBlockTriplets(nBlocks);
+	std::vector< std::vector<int> > vecBlockSecondNodes(nBlocks);
+	std::vector<std::string> vecBlockError(nBlocks);
 
-			if (meshOverlap.vecSourceFaceIx[ixOverlapTemp] != ixFirst) {
-				break;
-			}
+#pragma omp parallel for schedule(dynamic)
+	for (int b = 0; b < nBlocks; b++) {
+		const int ixBegin = b * LinearRemapParallelBlockSize;
+		const int ixEnd =
+			std::min(ixBegin + LinearRemapParallelBlockSize, nFaces);
 
-			nAllOverlapFaces[ixFirst]++;
-		}
+		SparseMatrix<double>::TripletVector & vecTriplets =
+			vecBlockTriplets[b];
 
-		// Increment the current overlap index
-		ixOverlap += nAllOverlapFaces[ixFirst];
-	}
+		// Target node of each sample in this block
+		std::vector<int> & vecSecondNodes = vecBlockSecondNodes[b];
 
-	// Number of times this point was found
-	DataArray1D<bool> fSecondNodeFound(dataNodalAreaOut.GetRows());
+		// Target nodes found in this block
+		std::set<int> setSecondNodeFound;
 
-	// Loop through all faces on meshInput
-	ixOverlap = 0;
+		// Sample coefficients
+		DataArray2D<double> dSampleCoeffIn(nPin, nPin);
 
-	for (int ixFirst = 0; ixFirst < meshInput.faces.size(); ixFirst++) {
+		try {
+		for (int ixFirst = ixBegin; ixFirst < ixEnd; ixFirst++) {
 
-		// Output every 100 elements
+		// Output every 1000 elements
 		if (ixFirst % 1000 == 0) {
-                        Announce("Element %i/%i", ixFirst, meshInput.faces.size());
+#pragma omp critical
+			Announce("Element %i/%i", ixFirst, nFaces);
 		}
 
+		// Overlap Faces associated with this Face
+		const int ixOverlap = vecOverlapBegin[ixFirst];
+
+		const int nOverlapFaces = vecOverlapBegin[ixFirst+1] - ixOverlap;
+
 		// Quantities from the First Mesh
 		const Face & faceFirst = meshInput.faces[ixFirst];
 
 		const NodeVector & nodesFirst = meshInput.nodes;
 
-		// Number of overlapping Faces and triangles
-		int nOverlapFaces = nAllOverlapFaces[ixFirst];
-
 		// Loop through all Overlap Faces
 		for (int i = 0; i < nOverlapFaces; i++) {
 
@@ -2983,12 +3253,14 @@ void LinearRemapGLLtoGLL2_Pointwise(
 						ixSecond * nPout * nPout + s * nPout + t;
 				}
 
-				if (ixSecondNode >= fSecondNodeFound.GetRows()) {
+				if (ixSecondNode >= nSecondNodes) {
 					_EXCEPTIONT("Logic error");
 				}
 
 				// Check if this node has been found already
-				if (fSecondNodeFound[ixSecondNode]) {
+				if (setSecondNodeFound.find(ixSecondNode)
+					!= setSecondNodeFound.end()
+				) {
 					continue;
 				}
 
@@ -3026,7 +3298,8 @@ void LinearRemapGLLtoGLL2_Pointwise(
 				}
 
 				// Node is within the overlap region, mark as found
-				fSecondNodeFound[ixSecondNode] = true;
+				setSecondNodeFound.insert(ixSecondNode);
+				vecSecondNodes.push_back(ixSecondNode);
 
 				// Sample the First finite element at this point
 				SampleGLLFiniteElement(
@@ -3049,18 +3322,58 @@ void LinearRemapGLLtoGLL2_Pointwise(
 							ixFirst * nPin * nPin + p * nPin + q;
 					}
 
-					smatMap(ixSecondNode, ixFirstNode) +=
-						dSampleCoeffIn[p][q];
+					vecTriplets.push_back(
+						SparseMatrix<double>::Triplet(
+							ixSecondNode,
+							ixFirstNode,
+							dSampleCoeffIn[p][q]));
 				}
 				}
 			}
 			}
 		}
+		}
 
-		// Increment the current overlap index
-		ixOverlap += nOverlapFaces;
+		} catch(Exception & e) {
+			vecBlockError[b] = e.ToString();
+		}
+	}
+
+	// Report the error from the first failing face
+	for (int b = 0; b < nBlocks; b++) {
+		if (vecBlockError[b] != "") {
+			_EXCEPTION1("%s", vecBlockError[b].c_str());
+		}
+	}
+
+	// Keep the first sample of each target node
+	DataArray1D<bool> fSecondNodeFound(nSecondNodes);
+
+	const int nSampleTriplets = nPin * nPin;
+
+	SparseMatrix<double>::TripletVector vecTriplets;
+
+	for (int b = 0; b < nBlocks; b++) {
+		const std::vector<int> & vecSecondNodes = vecBlockSecondNodes[b];
+
+		for (size_t k = 0; k < vecSecondNodes.size(); k++) {
+			if (fSecondNodeFound[vecSecondNodes[k]]) {
+				continue;
+			}
+			fSecondNodeFound[vecSecondNodes[k]] = true;
+
+			vecTriplets.insert(
+				vecTriplets.end(),
+				vecBlockTriplets[b].begin() + k * nSampleTriplets,
+				vecBlockTriplets[b].begin() + (k+1) * nSampleTriplets);
+		}
+
+		SparseMatrix<double>::TripletVector().swap(vecBlockTriplets[b]);
+		std::vector<int>().swap(vecBlockSecondNodes[b]);
 	}
 
+	smatMap.AddTriplets(vecTriplets);
+
 	// Check for missing samples
 	for (int i = 0; i < fSecondNodeFound.GetRows(); i++) {
 		if (!fSecondNodeFound[i]) {
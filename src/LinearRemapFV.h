@@ -25,6 +25,7 @@
 
 class Mesh;
 class OfflineMap;
+class FiniteVolumeStencilCache;
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -55,14 +56,19 @@ void LinearRemapFVtoFVInvDist(
 
 ///	<summary>
 ///		Generate the OfflineMap for remapping from finite volumes to finite
-///		volumes.
+///		volumes.  If pcacheStencil is not NULL the reconstruction stencils of
+///		meshInput are taken from, or added to, the cache.  If
+///		dQuadratureTolerance is positive, small overlap triangles are
+///		integrated with lower order quadrature rules.
 ///	</summary>
 void LinearRemapFVtoFV(
 	const Mesh & meshInput,
 	const Mesh & meshOutput,
 	const Mesh & meshOverlap,
 	int nOrder,
-	OfflineMap & mapRemap
+	OfflineMap & mapRemap,
+	FiniteVolumeStencilCache * pcacheStencil = NULL,
+	double dQuadratureTolerance = 0.0
 );
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -109,7 +115,8 @@ void LinearRemapFVtoGLL_Volumetric(
 
 ///	<summary>
 ///		Generate the OfflineMap for remapping from finite volumes to finite
-///		elements.
+///		elements.  If dQuadratureTolerance is positive, small overlap
+///		triangles are integrated with lower order quadrature rules.
 ///	</summary>
 void LinearRemapFVtoGLL(
 	const Mesh & meshInput,
@@ -122,7 +129,8 @@ void LinearRemapFVtoGLL(
 	OfflineMap & mapRemap,
 	int nMonotoneType,
 	bool fContinuous,
-	bool fNoConservation
+	bool fNoConservation,
+	double dQuadratureTolerance = 0.0
 );
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -24,6 +24,11 @@
 
 #include "Announce.h"
 
+#include <algorithm>
+#include <set>
+#include <string>
+#include <vector>
+
 ///////////////////////////////////////////////////////////////////////////////
 
 
@@ -287,8 +292,9 @@ void ForceConsistencyConservation(
 	}
 */
 	// Solve least squares problem
-	DataArray2D<double> dWin = dW;
 /*
+	DataArray2D<double> dWin = dW;
+
 	dbocls_(
 		&(dW[0][0]),
 		&mdw,
@@ -502,11 +508,72 @@ void ForceConsistencyConservation2(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		Solve the Schur complement system C*C^T x = r of the consistency and
+///		conservation constraints of ForceConsistencyConservation3() in place.
+///		The first nCondConsistency entries of dX correspond to the
+///		consistency conditions and the remaining nCondConservation-1 entries
+///		to the conservation conditions.  C*C^T has the block structure
+///		[ n I, a 1^T ; 1 a^T, (a.a) I ], where n = nCondConservation and a is
+///		the vector of target areas, so the system is solved in closed form in
+///		O(nCondConsistency + nCondConservation) operations.
+///	</summary>
+static void SolveConsistencyConservationSchur(
+	const DataArray1D<double> & vecTargetArea,
+	int nCondConsistency,
+	int nCondConservation,
+	double * dX
+) {
+	const double dN = static_cast<double>(nCondConservation);
+	const int nRemaining = nCondConservation - 1;
+
+	double * dX1 = dX;
+	double * dX2 = dX + nCondConsistency;
+
+	// Calculate a.a, a.r1 and 1.r2
+	double dP = 0.0;
+	double dAR1 = 0.0;
+	for (int i = 0; i < nCondConsistency; i++) {
+		dP += vecTargetArea[i] * vecTargetArea[i];
+		dAR1 += vecTargetArea[i] * dX1[i];
+	}
+
+	double dSumR2 = 0.0;
+	for (int j = 0; j < nRemaining; j++) {
+		dSumR2 += dX2[j];
+	}
+
+	if ((nRemaining > 0) && (!(dP > 0.0))) {
+		_EXCEPTIONT("Unable to solve SPD Schur system: zero target area");
+	}
+
+	// Sum of the conservation multipliers
+	double dS = 0.0;
+	if (nRemaining > 0) {
+		dS = (dN * dSumR2 - static_cast<double>(nRemaining) * dAR1) / dP;
+	}
+
+	// Consistency multipliers
+	double dT = 0.0;
+	for (int i = 0; i < nCondConsistency; i++) {
+		dX1[i] = (dX1[i] - vecTargetArea[i] * dS) / dN;
+		dT += vecTargetArea[i] * dX1[i];
+	}
+
+	// Conservation multipliers
+	for (int j = 0; j < nRemaining; j++) {
+		dX2[j] = (dX2[j] - dT) / dP;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void ForceConsistencyConservation3(
 	const DataArray1D<double> & vecSourceArea,
 	const DataArray1D<double> & vecTargetArea,
 	DataArray2D<double> & dCoeff,
-	bool fMonotone, bool fSparseConstraints = false
+	bool fMonotone,
+	bool fSparseConstraints
 ) {
 
 	// Number of free coefficients
@@ -519,28 +586,73 @@ void ForceConsistencyConservation3(
 	// One condition is dropped due to linear dependence
 	int nCond = nCondConservation + nCondConsistency - 1;
 
-	// Product matrix
-	DataArray2D<double> dCCt(nCond, nCond);
-	DataArray1D<double> localLK; // (nCond)
-	DataArray2D<double> dC; // (nCoeff, nCond);
-	// RHS
-	DataArray1D<double> dRHS; // (nCoeff + nCond);
-	int ix = 0;
-	if (fSparseConstraints)
-		localLK.Allocate(nCond); // will store lagrange multipliers lambda(nCondConservation)
-	                         // and kappa(nCond-1)
-	else {
-		dC.Allocate(nCoeff, nCond);
-		dRHS.Allocate(nCoeff + nCond);
+	// The constraint matrix C has one nonzero per coefficient in each of
+	// the consistency and conservation conditions, and the product matrix
+	// C*C^T has the block structure
+	//   [ n I       a 1^T ]
+	//   [ 1 a^T   (a.a) I ]
+	// where n is the number of conservation conditions and a is the vector
+	// of target areas, so C*C^T is never formed explicitly.
+	if (fSparseConstraints) {
+
+		// Lagrange multipliers of the consistency conditions (lambda) and
+		// of the conservation conditions (kappa)
+		DataArray1D<double> localLK(nCond);
+
+		double * dLambda = &(localLK[0]);
+		double * dKappa = &(localLK[nCondConsistency]);
+
+		// Calculate C*r1 - r2 in a single pass over dCoeff
+		for (int i = 0; i < nCondConsistency; i++) {
+			const double * dCoeffRow = dCoeff[i];
+			const double dTargetArea = vecTargetArea[i];
+
+			double dRowSum = 0.0;
+			for (int j = 0; j < nCondConservation - 1; j++) {
+				dRowSum += dCoeffRow[j];
+				dKappa[j] += dCoeffRow[j] * dTargetArea;
+			}
+			dRowSum += dCoeffRow[nCondConservation - 1];
+
+			dLambda[i] = dRowSum - 1.0;
+		}
+		for (int j = 0; j < nCondConservation - 1; j++) {
+			dKappa[j] -= vecSourceArea[j];
+		}
+
+		// Solve the Schur complement system
+		SolveConsistencyConservationSchur(
+			vecTargetArea,
+			nCondConsistency,
+			nCondConservation,
+			dLambda);
+
+		// Obtain coefficients: R^_ij = R_ij - lambda_i - kappa_j * a_i,
+		// where the last column has no conservation condition
+		for (int i = 0; i < nCondConsistency; i++) {
+			double * dCoeffRow = dCoeff[i];
+			const double dTargetArea = vecTargetArea[i];
+
+			for (int j = 0; j < nCondConservation - 1; j++) {
+				dCoeffRow[j] -= dLambda[i] + dKappa[j] * dTargetArea;
+			}
+			dCoeffRow[nCondConservation - 1] -= dLambda[i];
+		}
+
+	} else {
+		DataArray2D<double> dC(nCoeff, nCond);
+
+		// RHS
+		DataArray1D<double> dRHS(nCoeff + nCond);
+
+		int ix = 0;
 		for (int i = 0; i < dCoeff.GetRows(); i++) {
 		for (int j = 0; j < dCoeff.GetColumns(); j++) {
 			dRHS[ix] = dCoeff[i][j];
 			ix++;
 		}
 		}
-	}
-	
-	if (!fSparseConstraints){
+
 		// Consistency
 		ix = 0;
 		for (int i = 0; i < dCoeff.GetRows(); i++) {
@@ -559,70 +671,17 @@ void ForceConsistencyConservation3(
 			dRHS[nCoeff + ix] = vecSourceArea[j];
 			ix++;
 		}
-	}
-	// Calculate CCt
-	double dP = 0.0;
-	for (int i = 0; i < dCoeff.GetRows(); i++) {
-		dP += vecTargetArea[i] * vecTargetArea[i];
-	}
 
-	for (int i = 0; i < dCoeff.GetRows(); i++) {
-		dCCt[i][i] = static_cast<double>(dCoeff.GetColumns());
-		for (int j = 0; j < dCoeff.GetColumns()-1; j++) {
-			dCCt[i][dCoeff.GetRows() + j] = vecTargetArea[i];
-			dCCt[dCoeff.GetRows() + j][i] = vecTargetArea[i];
-		}
-	}
+		// Calculate C*r1 - r2
+		char trans = 'n';
+		int m = nCond;
+		int n = nCoeff;
+		int lda = m;
+		int incx = 1;
+		int incy = 1;
+		double posone = 1.0;
+		double negone = -1.0;
 
-	for (int i = 0; i < dCoeff.GetColumns()-1; i++) {
-		int ix = dCoeff.GetRows() + i;
-		dCCt[ix][ix] = dP;
-	}
-/*
-	for (int i = 0; i < nCond; i++) {
-	for (int j = 0; j < nCond; j++) {
-		for (int k = 0; k < nCoeff; k++) {
-			dCCt[i][j] += dC[k][i] * dC[k][j];
-		}
-	}
-	}
-*/
-/*
-	FILE * fp = fopen("cct.dat", "w");
-	for (int i = 0; i < nCond; i++) {
-		for (int j = 0; j < nCond; j++) {
-			fprintf(fp, "%1.15e\t", dCCt[i][j]);
-		}
-		fprintf(fp, "\n");
-	}
-	fclose(fp);
-	_EXCEPTION();
-*/
-	// Calculate C*r1 - r2
-	char trans = 'n';
-	int m = nCond;
-	int n = nCoeff;
-	int lda = m;
-	int incx = 1;
-	int incy = 1;
-	double posone = 1.0;
-	double negone = -1.0;
-	if (fSparseConstraints)
-	{
-		for (int m=0; m < nCondConsistency; m++) { // consistency condition
-			localLK[m] = 0;
-			for (int j=0; j<nCondConservation; j++)
-				localLK[m] += dCoeff[m][j];
-			localLK[m] += -1.;
-		}
-		for (int n=0; n<nCondConservation-1; n++) { // conservation condition
-			localLK[nCondConsistency + n] = 0;
-			for (int i = 0; i < nCondConsistency; i++)
-				localLK[nCondConsistency + n] += dCoeff[i][n] * vecTargetArea[i];
-			localLK[nCondConsistency + n] += -vecSourceArea[n]; //
-		}
-	}
-	else {
 		dgemv_(
 		&trans,
 		&m,
@@ -635,62 +694,15 @@ void ForceConsistencyConservation3(
 		&negone,
 		&(dRHS[nCoeff]),
 		&incy);
-	}
 
-	// Solve the general system
-	int nrhs = 1;
-	int ldb = nCond;
+		// Solve the Schur complement system
+		SolveConsistencyConservationSchur(
+			vecTargetArea,
+			nCondConsistency,
+			nCondConservation,
+			&(dRHS[nCoeff]));
 
-	int nInfo;
-/*
-	DataArray1D<int> iPIV(nCond);
-
-	dgesv_(
-		&m,
-		&nrhs,
-		&(dCCt[0][0]),
-		&lda,
-		&(iPIV[0]),
-		&(dRHS[nCoeff]),
-		&ldb,
-		&nInfo);
-*/
-	char uplo = 'U';
-	if (fSparseConstraints)
-		dposv_(
-		&uplo,
-		&m,
-		&nrhs,
-		&(dCCt[0][0]),
-		&lda,
-		&(localLK[0]),
-		&ldb,
-		&nInfo);
-	else
-		dposv_(
-		&uplo,
-		&m,
-		&nrhs,
-		&(dCCt[0][0]),
-		&lda,
-		&(dRHS[nCoeff]),
-		&ldb,
-		&nInfo);
-	if (nInfo != 0) {
-		_EXCEPTION1("Unable to solve SPD Schur system: %i\n", nInfo);
-	}
-	if (fSparseConstraints) {
-		for (int i = 0; i < nCondConsistency; i++) {
-			for (int j = 0; j < nCondConservation - 1; j++)
-			// R^_ij =  R_ij - lambda_i - kapa_j * JT_i
-				dCoeff[i][j] =
-				dCoeff[i][j] - localLK[i] - localLK[nCondConsistency + j] * vecTargetArea[i];
-			// the last column still needs correction
-			dCoeff[i][nCondConservation - 1] = dCoeff[i][nCondConservation - 1] - localLK[i];
-		}
-	}
-	// Obtain coefficients
-	else {
+		// Obtain coefficients
 		trans = 't';
 		dgemv_(
 		&trans,
@@ -704,6 +716,7 @@ void ForceConsistencyConservation3(
 		&posone,
 		&(dRHS[0]),
 		&incy);
+
 		// Store coefficients in array
 		ix = 0;
 		for (int i = 0; i < dCoeff.GetRows(); i++) {
@@ -713,6 +726,7 @@ void ForceConsistencyConservation3(
 			}
 		}
 	}
+
 	// Force monotonicity
 	if (fMonotone) {
 
@@ -722,16 +736,15 @@ void ForceConsistencyConservation3(
 			dTotalJacobian += vecSourceArea[i];
 		}
 
-		// Determine low-order remap coefficients
-		DataArray2D<double> dMonoCoeff(dCoeff.GetRows(), dCoeff.GetColumns());
+		// Determine low-order remap coefficients, which are the same for
+		// all targets
+		DataArray1D<double> dMonoCoeff(dCoeff.GetColumns());
 
-		for (int i = 0; i < dCoeff.GetRows(); i++) {
 		for (int j = 0; j < dCoeff.GetColumns(); j++) {
-			dMonoCoeff[i][j] =
+			dMonoCoeff[j] =
 				vecSourceArea[j]
 				/ dTotalJacobian;
 		}
-		}
 
 		// Compute scaling factor
 		double dA = 0.0;
@@ -739,7 +752,7 @@ void ForceConsistencyConservation3(
 		for (int j = 0; j < dCoeff.GetColumns(); j++) {
 			if (dCoeff[i][j] < 0.0) {
 				double dNewA =
-					- dCoeff[i][j] / fabs(dMonoCoeff[i][j] - dCoeff[i][j]);
+					- dCoeff[i][j] / fabs(dMonoCoeff[j] - dCoeff[i][j]);
 
 				if (dNewA > dA) {
 					dA = dNewA;
@@ -750,7 +763,7 @@ void ForceConsistencyConservation3(
 
 		for (int i = 0; i < dCoeff.GetRows(); i++) {
 		for (int j = 0; j < dCoeff.GetColumns(); j++) {
-			dCoeff[i][j] = (1.0 - dA) * dCoeff[i][j] + dA * dMonoCoeff[i][j];
+			dCoeff[i][j] = (1.0 - dA) * dCoeff[i][j] + dA * dMonoCoeff[j];
 		}
 		}
 	}
@@ -767,7 +780,8 @@ void LinearRemapSE4(
 	int nMonotoneType,
 	bool fContinuousIn,
 	bool fNoConservation, bool fSparseConstraints,
-	OfflineMap & mapRemap
+	OfflineMap & mapRemap,
+	double dQuadratureTolerance
 ) {
 	// Order of the polynomial interpolant
 	int nP = dataGLLNodes.GetRows();
@@ -775,14 +789,11 @@ void LinearRemapSE4(
 	// Triangular quadrature rule
 	TriangularQuadratureRule triquadrule(4);
 
-	int TriQuadraturePoints = triquadrule.GetPoints();
+	// Lower order rules used on small overlap triangles
+	AdaptiveTriangularQuadratureRule triquadadapt(
+		triquadrule, dQuadratureTolerance);
 
-	const DataArray2D<double> & TriQuadratureG = triquadrule.GetG();
-
-	const DataArray1D<double> & TriQuadratureW = triquadrule.GetW();
-
-	// Sample coefficients
-	DataArray2D<double> dSampleCoeff(nP, nP);
+	const int nMaxTriQuadraturePoints = triquadrule.GetPoints();
 
 	// GLL Quadrature nodes on quadrilateral elements
 	DataArray1D<double> dG;
@@ -792,402 +803,452 @@ void LinearRemapSE4(
 	// Get SparseMatrix represntation of the OfflineMap
 	SparseMatrix<double> & smatMap = mapRemap.GetSparseMatrix();
 
-	// NodeVector from meshOverlap
-	const NodeVector & nodesOverlap = meshOverlap.nodes;
+	// NodeVector from meshInput
 	const NodeVector & nodesFirst   = meshInput.nodes;
 
-	// Vector of source areas
-	DataArray1D<double> vecSourceArea(nP * nP);
-
-	DataArray1D<double> vecTargetArea;
+	// Range of overlap faces associated with each face on meshInput
+	const int nFaces = meshInput.faces.size();
 
-	DataArray2D<double> dCoeff;
-
-	// Current Overlap Face
-	int ixOverlap = 0;
+	std::vector<int> vecOverlapBegin(nFaces+1);
+	{
+		int ixOverlap = 0;
+		for (int ixFirst = 0; ixFirst < nFaces; ixFirst++) {
+			vecOverlapBegin[ixFirst] = ixOverlap;
+			for (; ixOverlap < meshOverlap.faces.size(); ixOverlap++) {
+				if (meshOverlap.vecSourceFaceIx[ixOverlap] != ixFirst) {
+					break;
+				}
+			}
+		}
+		vecOverlapBegin[nFaces] = ixOverlap;
+	}
 
-	// Loop over all input Faces
-	for (int ixFirst = 0; ixFirst < meshInput.faces.size(); ixFirst++) {
+	// Map weights are computed for blocks of faces on meshInput in
+	// parallel and stored as triplets, which are added to the map in
+	// order of the faces on meshInput
+	const int nBlocks =
+		(nFaces + LinearRemapParallelBlockSize - 1)
+			/ LinearRemapParallelBlockSize;
+
+	std::vector<SparseMatrix<double>::TripletVector> vecBlockTriplets(nBlocks);
+	std::vector<std::string> vecBlockError(nBlocks);
+
+	// Blocks are computed in chunks of LinearRemapAssemblyChunkBlocks so
+	// that only the triplets of one chunk are held in memory at a time
+	for (int bBegin = 0; bBegin < nBlocks;
+	     bBegin += LinearRemapAssemblyChunkBlocks
+	) {
+		const int bEnd =
+			std::min(bBegin + LinearRemapAssemblyChunkBlocks, nBlocks);
+
+#pragma omp parallel for schedule(dynamic)
+		for (int b = bBegin; b < bEnd; b++) {
+			const int ixBegin = b * LinearRemapParallelBlockSize;
+			const int ixEnd =
+				std::min(ixBegin + LinearRemapParallelBlockSize, nFaces);
+
+			SparseMatrix<double>::TripletVector & vecTriplets =
+				vecBlockTriplets[b];
+
+			// Sample coefficients at all quadrature points of a triangle,
+			// for each quadrature rule
+			std::vector<double> vecAlpha(nMaxTriQuadraturePoints);
+			std::vector<double> vecBeta(nMaxTriQuadraturePoints);
+
+			std::vector< DataArray3D<double> > vecSampleCoeff(
+				triquadadapt.GetRuleCount());
+			for (int r = 0; r < triquadadapt.GetRuleCount(); r++) {
+				vecSampleCoeff[r].Allocate(
+					triquadadapt.GetRule(r).GetPoints(), nP, nP);
+			}
 
-		const Face & faceFirst = meshInput.faces[ixFirst];
+			// Vector of source areas
+			DataArray1D<double> vecSourceArea(nP * nP);
 
-		if (faceFirst.edges.size() != 4) {
-			_EXCEPTIONT("Only quadrilateral elements allowed for SE remapping");
-		}
+			DataArray1D<double> vecTargetArea;
 
-		// Output every 100 elements
-		if (ixFirst % 1000 == 0) {
-			Announce("Element %i/%i", ixFirst,meshInput.faces.size());
-		}
+			DataArray2D<double> dCoeff;
 
-		// Number of overlapping Faces and triangles
-		int nOverlapFaces = 0;
+			try {
+			for (int ixFirst = ixBegin; ixFirst < ixEnd; ixFirst++) {
 
-		// Determine how many overlap Faces and triangles are present
-		int ixOverlapTemp = ixOverlap;
-		for (; ixOverlapTemp < meshOverlap.faces.size(); ixOverlapTemp++) {
+			const Face & faceFirst = meshInput.faces[ixFirst];
 
-			const Face & faceOverlap = meshOverlap.faces[ixOverlapTemp];
+			if (faceFirst.edges.size() != 4) {
+				_EXCEPTIONT("Only quadrilateral elements allowed for SE remapping");
+			}
 
-			if (meshOverlap.vecSourceFaceIx[ixOverlapTemp] != ixFirst) {
-				break;
+			// Output every 1000 elements
+			if (ixFirst % 1000 == 0) {
+#pragma omp critical
+				Announce("Element %i/%i", ixFirst, nFaces);
 			}
-			nOverlapFaces++;
-		}
 
-		// No overlaps
-		if (nOverlapFaces == 0) {
-			continue;
-		}
+			// Overlap Faces associated with this Face
+			const int ixOverlap = vecOverlapBegin[ixFirst];
 
-		// Allocate remap coefficients array for meshFirst Face
-		DataArray3D<double> dRemapCoeff(nP, nP, nOverlapFaces);
+			const int nOverlapFaces = vecOverlapBegin[ixFirst+1] - ixOverlap;
 
-		// Find the local remap coefficients
-		for (int j = 0; j < nOverlapFaces; j++) {
-			const Face & faceOverlap = meshOverlap.faces[ixOverlap + j];
-			int nbEdges = faceOverlap.edges.size();
-			int nOverlapTriangles = 1;
-			Node nodeCenter; // not used if nbEdges == 3
-			if (nbEdges > 3) { // decompose from nodeCenter in this case
-				nOverlapTriangles = nbEdges;
-				for (int k = 0; k < nbEdges; k++) {
-					const Node &node = nodesOverlap[faceOverlap[k]];
-					nodeCenter = nodeCenter + node;
-				}
-				nodeCenter = nodeCenter / nbEdges;
-				double dMagni = sqrt(
-						nodeCenter.x * nodeCenter.x + nodeCenter.y * nodeCenter.y
-								+ nodeCenter.z * nodeCenter.z);
-				nodeCenter = nodeCenter / dMagni; // project back on sphere of radius 1
+			// No overlaps
+			if (nOverlapFaces == 0) {
+				continue;
 			}
 
-			Node node0, node1, node2;
-			double dTriangleArea;
-
-			// Loop over all sub-triangles of this Overlap Face
-			for (int k = 0; k < nOverlapTriangles; k++) {
-				if (nbEdges == 3) { // will come here only once, nOverlapTriangles == 1 in this case
-					node0 = nodesOverlap[faceOverlap[0]];
-					node1 = nodesOverlap[faceOverlap[1]];
-					node2 = nodesOverlap[faceOverlap[2]];
-				}
-				else { // decompose polygon in triangles around the nodeCenter
-					node0 = nodeCenter;
-					node1 = nodesOverlap[faceOverlap[k]];
-					int k1 = (k + 1) % nbEdges;
-					node2 = nodesOverlap[faceOverlap[k1]];
-				}
-				dTriangleArea = CalculateTriangleAreaQuadratureMethod(node0,
-						node1, node2);
-				// Coordinates of quadrature Node
-				for (int l = 0; l < TriQuadraturePoints; l++) {
-					Node nodeQuadrature;
-					nodeQuadrature.x =
-						  TriQuadratureG[l][0] * node0.x
-						+ TriQuadratureG[l][1] * node1.x
-						+ TriQuadratureG[l][2] * node2.x;
-
-					nodeQuadrature.y =
-						  TriQuadratureG[l][0] * node0.y
-						+ TriQuadratureG[l][1] * node1.y
-						+ TriQuadratureG[l][2] * node2.y;
-
-					nodeQuadrature.z =
-						  TriQuadratureG[l][0] * node0.z
-						+ TriQuadratureG[l][1] * node1.z
-						+ TriQuadratureG[l][2] * node2.z;
-
-					double dMag = sqrt(
-						  nodeQuadrature.x * nodeQuadrature.x
-						+ nodeQuadrature.y * nodeQuadrature.y
-						+ nodeQuadrature.z * nodeQuadrature.z);
-
-					nodeQuadrature.x /= dMag;
-					nodeQuadrature.y /= dMag;
-					nodeQuadrature.z /= dMag;
-
-					// Find components of quadrature point in basis
-					// of the first Face
-					double dAlpha;
-					double dBeta;
-
-					ApplyInverseMap(
-						faceFirst,
-						nodesFirst,
-						nodeQuadrature,
-						dAlpha,
-						dBeta);
+			// Allocate remap coefficients array for meshFirst Face
+			DataArray3D<double> dRemapCoeff(nP, nP, nOverlapFaces);
 
-					// Check inverse map value
-					if ((dAlpha < -InverseMapTolerance)      ||
-						(dAlpha > 1.0 + InverseMapTolerance) ||
-						(dBeta  < -InverseMapTolerance)      ||
-						(dBeta  > 1.0 + InverseMapTolerance)
-					) {
-						printf("\n==== BEGIN DEBUGGING INFO ====\n");
-						printf("WARNING (%s, Line %u) Inverse map out of range\n",
-							__FILE__, __LINE__);
-						int ixSecond = meshOverlap.vecTargetFaceIx[ixOverlap + j];
-						printf("Source face ix %i, Target face ix %i, Overlap face ix %i\n",
-							ixFirst, ixSecond, ixOverlap + j);
-						printf("Face nodes:\n");
-						for (int x = 0; x < faceFirst.edges.size(); x++) {
-							nodesFirst[faceFirst[x]].Print("");
+			// Find the local remap coefficients
+			for (int j = 0; j < nOverlapFaces; j++) {
+				const Face & faceOverlap = meshOverlap.faces[ixOverlap + j];
+				MeshFaceTriangles triangles(meshOverlap, ixOverlap + j);
+
+				Node node0, node1, node2;
+				double dTriangleArea;
+
+				// Loop over all sub-triangles of this Overlap Face
+				for (int k = 0; k < triangles.size(); k++) {
+					triangles.GetTriangle(k, node0, node1, node2);
+					dTriangleArea = triangles.GetArea(k, node0, node1, node2);
+
+					const int iRule =
+						triquadadapt.SelectRule(
+							node0, node1, node2, dTriangleArea,
+							meshInput.vecFaceArea[ixFirst]);
+
+					const TriangularQuadratureRule & triquadruleTri =
+						triquadadapt.GetRule(iRule);
+
+					const int TriQuadraturePoints = triquadruleTri.GetPoints();
+					const DataArray2D<double> & TriQuadratureG = triquadruleTri.GetG();
+					const DataArray1D<double> & TriQuadratureW = triquadruleTri.GetW();
+
+					DataArray3D<double> & dSampleCoeff = vecSampleCoeff[iRule];
+
+					// Coordinates of quadrature Node
+					for (int l = 0; l < TriQuadraturePoints; l++) {
+						Node nodeQuadrature;
+						nodeQuadrature.x =
+							  TriQuadratureG[l][0] * node0.x
+							+ TriQuadratureG[l][1] * node1.x
+							+ TriQuadratureG[l][2] * node2.x;
+
+						nodeQuadrature.y =
+							  TriQuadratureG[l][0] * node0.y
+							+ TriQuadratureG[l][1] * node1.y
+							+ TriQuadratureG[l][2] * node2.y;
+
+						nodeQuadrature.z =
+							  TriQuadratureG[l][0] * node0.z
+							+ TriQuadratureG[l][1] * node1.z
+							+ TriQuadratureG[l][2] * node2.z;
+
+						double dMag = sqrt(
+							  nodeQuadrature.x * nodeQuadrature.x
+							+ nodeQuadrature.y * nodeQuadrature.y
+							+ nodeQuadrature.z * nodeQuadrature.z);
+
+						nodeQuadrature.x /= dMag;
+						nodeQuadrature.y /= dMag;
+						nodeQuadrature.z /= dMag;
+
+						// Find components of quadrature point in basis
+						// of the first Face
+						double & dAlpha = vecAlpha[l];
+						double & dBeta = vecBeta[l];
+
+						ApplyInverseMap(
+							faceFirst,
+							nodesFirst,
+							nodeQuadrature,
+							dAlpha,
+							dBeta);
+
+						// Check inverse map value
+						if ((dAlpha < -InverseMapTolerance)      ||
+							(dAlpha > 1.0 + InverseMapTolerance) ||
+							(dBeta  < -InverseMapTolerance)      ||
+							(dBeta  > 1.0 + InverseMapTolerance)
+						) {
+							printf("\n==== BEGIN DEBUGGING INFO ====\n");
+							printf("WARNING (%s, Line %u) Inverse map out of range\n",
+								__FILE__, __LINE__);
+							int ixSecond = meshOverlap.vecTargetFaceIx[ixOverlap + j];
+							printf("Source face ix %i, Target face ix %i, Overlap face ix %i\n",
+								ixFirst, ixSecond, ixOverlap + j);
+							printf("Face nodes:\n");
+							for (int x = 0; x < faceFirst.edges.size(); x++) {
+								nodesFirst[faceFirst[x]].Print("");
+							}
+							printf("Quadrature node:\n");
+							nodeQuadrature.Print("");
+							printf("Alpha, Beta: %1.15e %1.15e\n", dAlpha, dBeta);
+							printf("==== END DEBUGGING INFO ====\n");
+							//_EXCEPTION2("Inverse Map out of range (%1.5e %1.5e)",
+							//	dAlpha, dBeta);
 						}
-						printf("Quadrature node:\n");
-						nodeQuadrature.Print("");
-						printf("Alpha, Beta: %1.15e %1.15e\n", dAlpha, dBeta);
-						printf("==== END DEBUGGING INFO ====\n");
-						//_EXCEPTION2("Inverse Map out of range (%1.5e %1.5e)",
-						//	dAlpha, dBeta);
+
 					}
 
-					// Sample the finite element at this point
+					// Sample the finite element at all quadrature points
 					SampleGLLFiniteElement(
 						nMonotoneType,
 						nP,
-						dAlpha,
-						dBeta,
+						TriQuadraturePoints,
+						&(vecAlpha[0]),
+						&(vecBeta[0]),
 						dSampleCoeff);
 
 					// Add sample coefficients to the map
-					for (int p = 0; p < nP; p++) {
-					for (int q = 0; q < nP; q++) {
-
-						dRemapCoeff[p][q][j] +=
-							TriQuadratureW[l]
-							* dTriangleArea
-							* dSampleCoeff[p][q]
-							/ meshOverlap.vecFaceArea[ixOverlap + j];
-					}
+					for (int l = 0; l < TriQuadraturePoints; l++) {
+						for (int p = 0; p < nP; p++) {
+						for (int q = 0; q < nP; q++) {
+
+							dRemapCoeff[p][q][j] +=
+								TriQuadratureW[l]
+								* dTriangleArea
+								* dSampleCoeff[l][p][q]
+								/ meshOverlap.vecFaceArea[ixOverlap + j];
+						}
+						}
 					}
 				}
 			}
-		}
 
-		// Force consistency and conservation
-		if (!fNoConservation) {
-			double dTargetArea = 0.0;
-			for (int j = 0; j < nOverlapFaces; j++) {
-				dTargetArea += meshOverlap.vecFaceArea[ixOverlap + j];
-			}
-
-			for (int p = 0; p < nP; p++) {
-			for (int q = 0; q < nP; q++) {
-				vecSourceArea[p * nP + q] = dataGLLJacobian[p][q][ixFirst];
-			}
-			}
-
-			// Source elements are completely covered by target volumes
-			if (fabs(meshInput.vecFaceArea[ixFirst] - dTargetArea) <= HighTolerance) {
-				vecTargetArea.Allocate(nOverlapFaces);
+			// Force consistency and conservation
+			if (!fNoConservation) {
+				double dTargetArea = 0.0;
 				for (int j = 0; j < nOverlapFaces; j++) {
-					vecTargetArea[j] = meshOverlap.vecFaceArea[ixOverlap + j];
+					dTargetArea += meshOverlap.vecFaceArea[ixOverlap + j];
 				}
 
-				dCoeff.Allocate(nOverlapFaces, nP * nP);
-
-				for (int j = 0; j < nOverlapFaces; j++) {
 				for (int p = 0; p < nP; p++) {
 				for (int q = 0; q < nP; q++) {
-					dCoeff[j][p * nP + q] = dRemapCoeff[p][q][j];
-				}
+					vecSourceArea[p * nP + q] = dataGLLJacobian[p][q][ixFirst];
 				}
 				}
 
-			// Target volumes only partially cover source elements
-			} else if (meshInput.vecFaceArea[ixFirst] - dTargetArea > HighTolerance) {
-				double dExtraneousArea = meshInput.vecFaceArea[ixFirst] - dTargetArea;
-
-				vecTargetArea.Allocate(nOverlapFaces+1);
-				for (int j = 0; j < nOverlapFaces; j++) {
-					vecTargetArea[j] = meshOverlap.vecFaceArea[ixOverlap + j];
-				}
-				vecTargetArea[nOverlapFaces] = dExtraneousArea;
-
-				Announce("Partial volume: %i (%1.10e / %1.10e)",
-					ixFirst, dTargetArea, meshInput.vecFaceArea[ixFirst]);
-
-				if (dTargetArea > meshInput.vecFaceArea[ixFirst]) {
-					_EXCEPTIONT("Partial element area exceeds total element area");
-				}
+				// Source elements are completely covered by target volumes
+				if (fabs(meshInput.vecFaceArea[ixFirst] - dTargetArea) <= HighTolerance) {
+					vecTargetArea.Allocate(nOverlapFaces);
+					for (int j = 0; j < nOverlapFaces; j++) {
+						vecTargetArea[j] = meshOverlap.vecFaceArea[ixOverlap + j];
+					}
 
-				dCoeff.Allocate(nOverlapFaces+1, nP * nP);
+					dCoeff.Allocate(nOverlapFaces, nP * nP);
 
-				for (int j = 0; j < nOverlapFaces; j++) {
-				for (int p = 0; p < nP; p++) {
-				for (int q = 0; q < nP; q++) {
-					dCoeff[j][p * nP + q] = dRemapCoeff[p][q][j];
-				}
-				}
-				}
-				for (int p = 0; p < nP; p++) {
-				for (int q = 0; q < nP; q++) {
-					dCoeff[nOverlapFaces][p * nP + q] =
-						dataGLLJacobian[p][q][ixFirst];
-				}
-				}
-				for (int j = 0; j < nOverlapFaces; j++) {
-				for (int p = 0; p < nP; p++) {
-				for (int q = 0; q < nP; q++) {
-					dCoeff[nOverlapFaces][p * nP + q] -=
-						dRemapCoeff[p][q][j]
-						* meshOverlap.vecFaceArea[ixOverlap + j];
-				}
-				}
-				}
-				for (int p = 0; p < nP; p++) {
-				for (int q = 0; q < nP; q++) {
-					dCoeff[nOverlapFaces][p * nP + q] /= dExtraneousArea;
-				}
-				}
+					for (int j = 0; j < nOverlapFaces; j++) {
+					for (int p = 0; p < nP; p++) {
+					for (int q = 0; q < nP; q++) {
+						dCoeff[j][p * nP + q] = dRemapCoeff[p][q][j];
+					}
+					}
+					}
 
-			// Source elements only partially cover target volumes
-			} else {
-				printf("\n==== BEGIN DEBUGGING INFO ====\n");
-				printf("EXCEPTION (%s, Line %u) Target grid must be a subset of source grid\n",
-					__FILE__, __LINE__);
-				printf("Source face ix %i, Overlap face ix [%i,%i]\n",
-					ixFirst, ixOverlap, ixOverlap+nOverlapFaces-1);
-				printf("Target faces / overlap area:\n");
-				for (int j = 0; j < nOverlapFaces; j++) {
-					printf("  (%i) (%i) %1.15e\n",
-						ixOverlap + j,
-						meshOverlap.vecTargetFaceIx[ixOverlap + j],
-						meshOverlap.vecFaceArea[ixOverlap + j]);
-				}
-				printf("Source nodes / source area:\n");
-				for (int p = 0; p < nP; p++) {
-				for (int q = 0; q < nP; q++) {
-					printf("  (%i,%i) %1.15e\n", p, q, dataGLLJacobian[p][q][ixFirst]);
-				}
-				}
-				printf("==== END DEBUGGING INFO ====\n");
+				// Target volumes only partially cover source elements
+				} else if (meshInput.vecFaceArea[ixFirst] - dTargetArea > HighTolerance) {
+					double dExtraneousArea = meshInput.vecFaceArea[ixFirst] - dTargetArea;
 
-				_EXCEPTION2("Target grid must be a subset of source grid:"
-					"\nInput mesh area (%1.15e) Target area (%1.15e)",
-					meshInput.vecFaceArea[ixFirst],
-					dTargetArea);
-			}
+					vecTargetArea.Allocate(nOverlapFaces+1);
+					for (int j = 0; j < nOverlapFaces; j++) {
+						vecTargetArea[j] = meshOverlap.vecFaceArea[ixOverlap + j];
+					}
+					vecTargetArea[nOverlapFaces] = dExtraneousArea;
 
-			// Force consistency and conservation (over all coefficients)
-			if ((FORCECC_MAX_TARGET_FACES == (-1)) || (nOverlapFaces <= FORCECC_MAX_TARGET_FACES)) {
+#pragma omp critical
+					Announce("Partial volume: %i (%1.10e / %1.10e)",
+						ixFirst, dTargetArea, meshInput.vecFaceArea[ixFirst]);
 
-				ForceConsistencyConservation3(
-					vecSourceArea,
-					vecTargetArea,
-					dCoeff,
-					(nMonotoneType != 0),
-					fSparseConstraints);
+					if (dTargetArea > meshInput.vecFaceArea[ixFirst]) {
+						_EXCEPTIONT("Partial element area exceeds total element area");
+					}
 
-			// If too many target faces are included this can greatly slow down the computation and
-			// require a high memory footprint.  In this case only apply forcing to the first
-			// FORCECC_MAX_TARGET_FACES overlap faces.
-			} else {
-				DataArray1D<double> dSubsetTargetArea(FORCECC_MAX_TARGET_FACES);
-				DataArray2D<double> dSubsetCoeff(FORCECC_MAX_TARGET_FACES, nP * nP);
+					dCoeff.Allocate(nOverlapFaces+1, nP * nP);
 
-				for (int j = 0; j < FORCECC_MAX_TARGET_FACES; j++) {
-					dSubsetTargetArea[j] = vecTargetArea[j];
+					for (int j = 0; j < nOverlapFaces; j++) {
 					for (int p = 0; p < nP; p++) {
 					for (int q = 0; q < nP; q++) {
-						dSubsetCoeff[j][p * nP + q] = dCoeff[j][p * nP + q];
+						dCoeff[j][p * nP + q] = dRemapCoeff[p][q][j];
+					}
+					}
+					}
+					for (int p = 0; p < nP; p++) {
+					for (int q = 0; q < nP; q++) {
+						dCoeff[nOverlapFaces][p * nP + q] =
+							dataGLLJacobian[p][q][ixFirst];
+					}
+					}
+					for (int j = 0; j < nOverlapFaces; j++) {
+					for (int p = 0; p < nP; p++) {
+					for (int q = 0; q < nP; q++) {
+						dCoeff[nOverlapFaces][p * nP + q] -=
+							dRemapCoeff[p][q][j]
+							* meshOverlap.vecFaceArea[ixOverlap + j];
+					}
+					}
+					}
+					for (int p = 0; p < nP; p++) {
+					for (int q = 0; q < nP; q++) {
+						dCoeff[nOverlapFaces][p * nP + q] /= dExtraneousArea;
 					}
 					}
-				}
 
-				for (int j = FORCECC_MAX_TARGET_FACES; j < nOverlapFaces; j++) {
+				// Source elements only partially cover target volumes
+				} else {
+					printf("\n==== BEGIN DEBUGGING INFO ====\n");
+					printf("EXCEPTION (%s, Line %u) Target grid must be a subset of source grid\n",
+						__FILE__, __LINE__);
+					printf("Source face ix %i, Overlap face ix [%i,%i]\n",
+						ixFirst, ixOverlap, ixOverlap+nOverlapFaces-1);
+					printf("Target faces / overlap area:\n");
+					for (int j = 0; j < nOverlapFaces; j++) {
+						printf("  (%i) (%i) %1.15e\n",
+							ixOverlap + j,
+							meshOverlap.vecTargetFaceIx[ixOverlap + j],
+							meshOverlap.vecFaceArea[ixOverlap + j]);
+					}
+					printf("Source nodes / source area:\n");
 					for (int p = 0; p < nP; p++) {
 					for (int q = 0; q < nP; q++) {
-						vecSourceArea[p * nP + q] -= dCoeff[j][p * nP + q] * vecTargetArea[j];
+						printf("  (%i,%i) %1.15e\n", p, q, dataGLLJacobian[p][q][ixFirst]);
 					}
 					}
-				}
-/*
-  				// DEBUGGING
-				double dJacobianAreaTot = 0.0;
-				double dSourceAreaTot = 0.0;
-				double dTargetAreaTot = 0.0;
+					printf("==== END DEBUGGING INFO ====\n");
 
-				for (int p = 0; p < nP; p++) {
-				for (int q = 0; q < nP; q++) {
-					//printf("%1.5e : %1.5e %1.5e\n", vecSourceArea[p * nP + q], dataGLLJacobian[p][q][ixFirst], meshInput.vecFaceArea[ixFirst]);
-					dSourceAreaTot += vecSourceArea[p * nP + q];
-					dJacobianAreaTot += dataGLLJacobian[p][q][ixFirst];
-					printf("%i %i %1.5e\n", p, q, vecSourceArea[p * nP + q]);
-					//if (vecSourceArea[p * nP + q] < 0.0) {
-					//	_EXCEPTIONT("Logic error:  Source face has negative area");
-					//}
-				}
-				}
-				for (int j = 0; j < FORCECC_MAX_TARGET_FACES; j++) {
-					dTargetAreaTot += dSubsetTargetArea[j];
-					printf("%i %1.5e\n", j, dSubsetTargetArea[j]);
+					_EXCEPTION2("Target grid must be a subset of source grid:"
+						"\nInput mesh area (%1.15e) Target area (%1.15e)",
+						meshInput.vecFaceArea[ixFirst],
+						dTargetArea);
 				}
 
-				printf("%1.15e %1.15e : %1.15e %1.15e\n", dSourceAreaTot, dTargetAreaTot, dJacobianAreaTot, meshInput.vecFaceArea[ixFirst]);
-*/
-				ForceConsistencyConservation3(
-					vecSourceArea,
-					dSubsetTargetArea,
-					dSubsetCoeff,
-					(nMonotoneType != 0),
-					fSparseConstraints);
-
-				for (int j = 0; j < FORCECC_MAX_TARGET_FACES; j++) {
+				// Force consistency and conservation (over all coefficients)
+				if ((FORCECC_MAX_TARGET_FACES == (-1)) || (nOverlapFaces <= FORCECC_MAX_TARGET_FACES)) {
+
+					ForceConsistencyConservation3(
+						vecSourceArea,
+						vecTargetArea,
+						dCoeff,
+						(nMonotoneType != 0),
+						fSparseConstraints);
+
+				// If too many target faces are included this can greatly slow down the computation and
+				// require a high memory footprint.  In this case only apply forcing to the first
+				// FORCECC_MAX_TARGET_FACES overlap faces.
+				} else {
+					DataArray1D<double> dSubsetTargetArea(FORCECC_MAX_TARGET_FACES);
+					DataArray2D<double> dSubsetCoeff(FORCECC_MAX_TARGET_FACES, nP * nP);
+
+					for (int j = 0; j < FORCECC_MAX_TARGET_FACES; j++) {
+						dSubsetTargetArea[j] = vecTargetArea[j];
+						for (int p = 0; p < nP; p++) {
+						for (int q = 0; q < nP; q++) {
+							dSubsetCoeff[j][p * nP + q] = dCoeff[j][p * nP + q];
+						}
+						}
+					}
+
+					for (int j = FORCECC_MAX_TARGET_FACES; j < nOverlapFaces; j++) {
+						for (int p = 0; p < nP; p++) {
+						for (int q = 0; q < nP; q++) {
+							vecSourceArea[p * nP + q] -= dCoeff[j][p * nP + q] * vecTargetArea[j];
+						}
+						}
+					}
+	/*
+	  				// DEBUGGING
+					double dJacobianAreaTot = 0.0;
+					double dSourceAreaTot = 0.0;
+					double dTargetAreaTot = 0.0;
+
 					for (int p = 0; p < nP; p++) {
 					for (int q = 0; q < nP; q++) {
-						dCoeff[j][p * nP + q] = dSubsetCoeff[j][p * nP + q];
+						//printf("%1.5e : %1.5e %1.5e\n", vecSourceArea[p * nP + q], dataGLLJacobian[p][q][ixFirst], meshInput.vecFaceArea[ixFirst]);
+						dSourceAreaTot += vecSourceArea[p * nP + q];
+						dJacobianAreaTot += dataGLLJacobian[p][q][ixFirst];
+						printf("%i %i %1.5e\n", p, q, vecSourceArea[p * nP + q]);
+						//if (vecSourceArea[p * nP + q] < 0.0) {
+						//	_EXCEPTIONT("Logic error:  Source face has negative area");
+						//}
+					}
 					}
+					for (int j = 0; j < FORCECC_MAX_TARGET_FACES; j++) {
+						dTargetAreaTot += dSubsetTargetArea[j];
+						printf("%i %1.5e\n", j, dSubsetTargetArea[j]);
+					}
+
+					printf("%1.15e %1.15e : %1.15e %1.15e\n", dSourceAreaTot, dTargetAreaTot, dJacobianAreaTot, meshInput.vecFaceArea[ixFirst]);
+	*/
+					ForceConsistencyConservation3(
+						vecSourceArea,
+						dSubsetTargetArea,
+						dSubsetCoeff,
+						(nMonotoneType != 0),
+						fSparseConstraints);
+
+					for (int j = 0; j < FORCECC_MAX_TARGET_FACES; j++) {
+						for (int p = 0; p < nP; p++) {
+						for (int q = 0; q < nP; q++) {
+							dCoeff[j][p * nP + q] = dSubsetCoeff[j][p * nP + q];
+						}
+						}
 					}
 				}
-			}
 
-			//_EXCEPTION();
+				//_EXCEPTION();
 
-			for (int j = 0; j < nOverlapFaces; j++) {
-			for (int p = 0; p < nP; p++) {
-			for (int q = 0; q < nP; q++) {
-				dRemapCoeff[p][q][j] = dCoeff[j][p * nP + q];
-			}
-			}
+				for (int j = 0; j < nOverlapFaces; j++) {
+				for (int p = 0; p < nP; p++) {
+				for (int q = 0; q < nP; q++) {
+					dRemapCoeff[p][q][j] = dCoeff[j][p * nP + q];
+				}
+				}
+				}
 			}
-		}
-
-		// Put these remap coefficients into the SparseMatrix map
-		for (int j = 0; j < nOverlapFaces; j++) {
-			int ixSecondFace = meshOverlap.vecTargetFaceIx[ixOverlap + j];
 
-			for (int p = 0; p < nP; p++) {
-			for (int q = 0; q < nP; q++) {
-
-				if (dRemapCoeff[p][q][j] == 0.0) {
-					continue;
-				}
+			// Put these remap coefficients into the SparseMatrix map
+			for (int j = 0; j < nOverlapFaces; j++) {
+				int ixSecondFace = meshOverlap.vecTargetFaceIx[ixOverlap + j];
 
-				if (fContinuousIn) {
-					int ixFirstNode = dataGLLNodes[p][q][ixFirst] - 1;
+				for (int p = 0; p < nP; p++) {
+				for (int q = 0; q < nP; q++) {
 
-					smatMap(ixSecondFace, ixFirstNode) +=
-						dRemapCoeff[p][q][j]
-						* meshOverlap.vecFaceArea[ixOverlap + j]
-						/ meshOutput.vecFaceArea[ixSecondFace];
+					if (dRemapCoeff[p][q][j] == 0.0) {
+						continue;
+					}
 
-				} else {
-					int ixFirstNode = ixFirst * nP * nP + p * nP + q;
+					int ixFirstNode;
+					if (fContinuousIn) {
+						ixFirstNode = dataGLLNodes[p][q][ixFirst] - 1;
+					} else {
+						ixFirstNode = ixFirst * nP * nP + p * nP + q;
+					}
 
-					smatMap(ixSecondFace, ixFirstNode) +=
-						dRemapCoeff[p][q][j]
-						* meshOverlap.vecFaceArea[ixOverlap + j]
-						/ meshOutput.vecFaceArea[ixSecondFace];
+					vecTriplets.push_back(
+						SparseMatrix<double>::Triplet(
+							ixSecondFace,
+							ixFirstNode,
+							dRemapCoeff[p][q][j]
+							* meshOverlap.vecFaceArea[ixOverlap + j]
+							/ meshOutput.vecFaceArea[ixSecondFace]));
+				}
 				}
 			}
 			}
+
+			} catch(Exception & e) {
+				vecBlockError[b] = e.ToString();
+			}
 		}
 
-		// Increment the current overlap index
-		ixOverlap += nOverlapFaces;
+		// Report the error from the first failing face
+		for (int b = bBegin; b < bEnd; b++) {
+			if (vecBlockError[b] != "") {
+				_EXCEPTION1("%s", vecBlockError[b].c_str());
+			}
+		}
+
+		// Insert the triplets of the chunk into the map in order of the
+		// blocks, releasing them before the next chunk is computed
+		smatMap.AddBlockTriplets(vecBlockTriplets);
 	}
 }
 
@@ -1217,10 +1278,6 @@ void LinearRemapGLLtoGLL_Pointwise(
 	const DataArray2D<double> & dG = triquadrule.GetG();
 	const DataArray1D<double> & dW = triquadrule.GetW();
 
-	// Sample coefficients
-	DataArray2D<double> dSampleCoeffIn(nPin, nPin);
-	DataArray2D<double> dSampleCoeffOut(nPout, nPout);
-
 	// Build the integration array for each element on meshOverlap
 	DataArray3D<double> dGlobalIntArray(
 		nPout * nPout,
@@ -1231,102 +1288,95 @@ void LinearRemapGLLtoGLL_Pointwise(
 		meshOverlap.faces.size(),
 		nPin * nPin);
 
-	// Number of overlap Faces per source Face
-	DataArray1D<int> nAllOverlapFaces(meshInput.faces.size());
-
-	int ixOverlap = 0;
+	// Range of overlap faces associated with each face on meshInput
+	const int nFaces = meshInput.faces.size();
 
-	for (int ixFirst = 0; ixFirst < meshInput.faces.size(); ixFirst++) {
-
-		int ixOverlapTemp = ixOverlap;
-		for (; ixOverlapTemp < meshOverlap.faces.size(); ixOverlapTemp++) {
-
-			const Face & faceOverlap = meshOverlap.faces[ixOverlapTemp];
-
-			if (meshOverlap.vecSourceFaceIx[ixOverlapTemp] != ixFirst) {
-				break;
+	std::vector<int> vecOverlapBegin(nFaces+1);
+	{
+		int ixOverlap = 0;
+		for (int ixFirst = 0; ixFirst < nFaces; ixFirst++) {
+			vecOverlapBegin[ixFirst] = ixOverlap;
+			for (; ixOverlap < meshOverlap.faces.size(); ixOverlap++) {
+				if (meshOverlap.vecSourceFaceIx[ixOverlap] != ixFirst) {
+					break;
+				}
 			}
-
-			nAllOverlapFaces[ixFirst]++;
 		}
-
-		// Increment the current overlap index
-		ixOverlap += nAllOverlapFaces[ixFirst];
+		vecOverlapBegin[nFaces] = ixOverlap;
 	}
 
-	// Mesh utilities
-	MeshUtilitiesFuzzy meshutil;
-
-	// Construct overlap
-	ixOverlap = 0;
-
-	int ixTotal = 0;
-
-	std::set< std::pair<int, int> > setFound;
-
-	for (int ixFirst = 0; ixFirst < meshInput.faces.size(); ixFirst++) {
-
-		// Output every 100 elements
+	const int nBlocks =
+		(nFaces + LinearRemapParallelBlockSize - 1)
+			/ LinearRemapParallelBlockSize;
+
+	// Overlap Faces of blocks of faces on meshInput are integrated and
+	// corrected in parallel; each block only writes its own overlap Faces.
+	// Pointwise samples of each target node are stored in the order they
+	// are found, and blocks are merged in order so that each target node is
+	// sampled from the same overlap Face as in a serial search.
+	std::vector< std::vector<int> > vecBlockSampleOverlap(nBlocks);
+	std::vector< std::vector<int> > vecBlockSamplePoint(nBlocks);
+	std::vector< std::vector<double> > vecBlockSampleCoeff(nBlocks);
+	std::vector<std::string> vecBlockError(nBlocks);
+
+#pragma omp parallel for schedule(dynamic)
+	for (int b = 0; b < nBlocks; b++) {
+		const int ixBegin = b * LinearRemapParallelBlockSize;
+		const int ixEnd =
+			std::min(ixBegin + LinearRemapParallelBlockSize, nFaces);
+
+		// Sample coefficients
+		DataArray2D<double> dSampleCoeffIn(nPin, nPin);
+		DataArray2D<double> dSampleCoeffOut(nPout, nPout);
+
+		// Mesh utilities
+		MeshUtilitiesFuzzy meshutil;
+
+		// Overlap Face, target node and coefficients of each sample
+		std::vector<int> & vecSampleOverlap = vecBlockSampleOverlap[b];
+		std::vector<int> & vecSamplePoint = vecBlockSamplePoint[b];
+		std::vector<double> & vecSampleCoeff = vecBlockSampleCoeff[b];
+
+		// Target nodes found in this block
+		std::set< std::pair<int, int> > setFound;
+
+		try {
+		for (int ixFirst = ixBegin; ixFirst < ixEnd; ixFirst++) {
+
+		// Output every 1000 elements
 		if (ixFirst % 1000 == 0) {
-                  Announce("Element %i/%i", ixFirst,meshInput.faces.size());
+#pragma omp critical
+			Announce("Element %i/%i", ixFirst, nFaces);
 		}
 
+		// Overlap Faces associated with this Face
+		const int ixOverlap = vecOverlapBegin[ixFirst];
+
+		const int nOverlapFaces = vecOverlapBegin[ixFirst+1] - ixOverlap;
+
 		// Quantities from the First Mesh
 		const Face & faceFirst = meshInput.faces[ixFirst];
 
 		const NodeVector &nodesFirst = meshInput.nodes;
 
-		// Number of overlapping Faces and triangles
-		int nOverlapFaces = nAllOverlapFaces[ixFirst];
-
 		// Loop through all Overlap Faces
 		for (int i = 0; i < nOverlapFaces; i++) {
 
-			// Quantities from the overlap Mesh
-			const Face & faceOverlap = meshOverlap.faces[ixOverlap + i];
-
-			const NodeVector & nodesOverlap = meshOverlap.nodes;
-
 			// Quantities from the Second Mesh
 			int ixSecond = meshOverlap.vecTargetFaceIx[ixOverlap + i];
 
 			const NodeVector & nodesSecond = meshOutput.nodes;
 
 			const Face & faceSecond = meshOutput.faces[ixSecond];
-			int nbEdges = faceOverlap.edges.size();
-			int nOverlapTriangles = 1;
-			Node nodeCenter; // not used if nbEdges == 3
-			if (nbEdges > 3) { // decompose from nodeCenter in this case
-				nOverlapTriangles = nbEdges;
-				for (int k = 0; k < nbEdges; k++) {
-					const Node &node = nodesOverlap[faceOverlap[k]];
-					nodeCenter = nodeCenter + node;
-				}
-				nodeCenter = nodeCenter / nbEdges;
-				double dMagni = sqrt(
-						nodeCenter.x * nodeCenter.x + nodeCenter.y * nodeCenter.y
-								+ nodeCenter.z * nodeCenter.z);
-				nodeCenter = nodeCenter / dMagni; // project back on sphere of radius 1
-			}
+			MeshFaceTriangles triangles(meshOverlap, ixOverlap + i);
 
 			Node node0, node1, node2;
 			double dTriArea;
 
 			// Loop over all sub-triangles of this Overlap Face
-			for (int j = 0; j < nOverlapTriangles; j++) {
-				if (nbEdges == 3) { // will come here only once, nOverlapTriangles == 1 in this case
-					node0 = nodesOverlap[faceOverlap[0]];
-					node1 = nodesOverlap[faceOverlap[1]];
-					node2 = nodesOverlap[faceOverlap[2]];
-				}
-				else { // decompose polygon in triangles around the nodeCenter
-					node0 = nodeCenter;
-					node1 = nodesOverlap[faceOverlap[j]];
-					int j1 = (j + 1) % nbEdges;
-					node2 = nodesOverlap[faceOverlap[j1]];
-				}
-				dTriArea = CalculateTriangleAreaQuadratureMethod(node0, node1,
-						node2);
+			for (int j = 0; j < triangles.size(); j++) {
+				triangles.GetTriangle(j, node0, node1, node2);
+				dTriArea = triangles.GetArea(j, node0, node1, node2);
 				for (int k = 0; k < triquadrule.GetPoints(); k++) {
 
 					// Get the nodal location of this point
@@ -1494,8 +1544,6 @@ void LinearRemapGLLtoGLL_Pointwise(
 						setFound.insert(pairFound);
 					}
 
-					ixTotal++;
-
 					// Find the components of this quadrature point in the
 					// basis of the input Face.
 					double dAlphaIn;
@@ -1539,18 +1587,12 @@ void LinearRemapGLLtoGLL_Pointwise(
 						dBetaIn,
 						dSampleCoeffIn);
 
-					int ixs = 0;
+					vecSampleOverlap.push_back(ixOverlap + i);
+					vecSamplePoint.push_back(ixp);
+
 					for (int s = 0; s < nPin; s++) {
 					for (int t = 0; t < nPin; t++) {
-
-						if (dGlobalIntArray[ixp][ixOverlap + i][ixs] != 0.0) {
-							_EXCEPTION();
-						}
-
-						dGlobalIntArray[ixp][ixOverlap + i][ixs] +=
-							dSampleCoeffIn[s][t];
-
-						ixs++;
+						vecSampleCoeff.push_back(dSampleCoeffIn[s][t]);
 					}
 					}
 
@@ -1607,9 +1649,52 @@ void LinearRemapGLLtoGLL_Pointwise(
 			}
 			}
 		}
+		}
 
-		// Increment the current overlap index
-		ixOverlap += nOverlapFaces;
+		} catch(Exception & e) {
+			vecBlockError[b] = e.ToString();
+		}
+	}
+
+	// Report the error from the first failing face
+	for (int b = 0; b < nBlocks; b++) {
+		if (vecBlockError[b] != "") {
+			_EXCEPTION1("%s", vecBlockError[b].c_str());
+		}
+	}
+
+	// Keep the first pointwise sample of each target node
+	std::set< std::pair<int, int> > setFound;
+
+	for (int b = 0; b < nBlocks; b++) {
+		for (size_t k = 0; k < vecBlockSampleOverlap[b].size(); k++) {
+			const int ixOverlap = vecBlockSampleOverlap[b][k];
+			const int ixp = vecBlockSamplePoint[b][k];
+
+			std::pair<int,int> pairFound(
+				meshOverlap.vecTargetFaceIx[ixOverlap], ixp);
+
+			if (setFound.find(pairFound) != setFound.end()) {
+				continue;
+			} else {
+				setFound.insert(pairFound);
+			}
+
+			const double * pSampleCoeff =
+				&(vecBlockSampleCoeff[b][k * nPin * nPin]);
+
+			for (int ixs = 0; ixs < nPin * nPin; ixs++) {
+				if (dGlobalIntArray[ixp][ixOverlap][ixs] != 0.0) {
+					_EXCEPTION();
+				}
+
+				dGlobalIntArray[ixp][ixOverlap][ixs] += pSampleCoeff[ixs];
+			}
+		}
+
+		std::vector<int>().swap(vecBlockSampleOverlap[b]);
+		std::vector<int>().swap(vecBlockSamplePoint[b]);
+		std::vector<double>().swap(vecBlockSampleCoeff[b]);
 	}
 
 	// Reverse map
@@ -1621,10 +1706,16 @@ void LinearRemapGLLtoGLL_Pointwise(
 		vecReverseFaceIx[ixSecond].push_back(i);
 	}
 
-	// Force consistency and conservation on linear sub-map
-	int ixDistBegin = 0;
+	// Force consistency and conservation on linear sub-map of each face on
+	// meshOutput in parallel; each face only writes its own overlap Faces
+	const int nTargetFaces = meshOutput.faces.size();
+
+	std::vector<std::string> vecTargetFaceError(nTargetFaces);
 
-	for (int ixSecond = 0; ixSecond < meshOutput.faces.size(); ixSecond++) {
+#pragma omp parallel for schedule(dynamic, LinearRemapParallelBlockSize)
+	for (int ixSecond = 0; ixSecond < nTargetFaces; ixSecond++) {
+
+		try {
 
 		// Coefficients
 		DataArray2D<double> dCoeff(
@@ -1749,75 +1840,126 @@ void LinearRemapGLLtoGLL_Pointwise(
 			}
 		}
 */
+
+		} catch(Exception & e) {
+			vecTargetFaceError[ixSecond] = e.ToString();
+		}
+	}
+
+	for (int ixSecond = 0; ixSecond < nTargetFaces; ixSecond++) {
+		if (vecTargetFaceError[ixSecond] != "") {
+			_EXCEPTION1("%s", vecTargetFaceError[ixSecond].c_str());
+		}
 	}
 
 	// Get SparseMatrix represntation of the OfflineMap
 	SparseMatrix<double> & smatMap = mapRemap.GetSparseMatrix();
 
 	// Compose the integration operator with the output map
-	ixOverlap = 0;
-
-	for (int ixFirst = 0; ixFirst < meshInput.faces.size(); ixFirst++) {
-
-		// Output every 100 elements
-		if (ixFirst % 1000 == 0) {
-                  Announce("Element %i/%i", ixFirst,meshInput.faces.size());
-		}
-
-		// This Face
-		const Face & faceFirst = meshInput.faces[ixFirst];
-
-		// Number of overlapping Faces and triangles
-		int nOverlapFaces = nAllOverlapFaces[ixFirst];
+	// Map weights are assembled for blocks of faces on meshInput in
+	// parallel and stored as triplets, which are added to the map in
+	// order of the faces on meshInput
+	std::vector<SparseMatrix<double>::TripletVector> vecBlockTriplets(nBlocks);
+
+	// Blocks are computed in chunks of LinearRemapAssemblyChunkBlocks so
+	// that only the triplets of one chunk are held in memory at a time
+	for (int bBegin = 0; bBegin < nBlocks;
+	     bBegin += LinearRemapAssemblyChunkBlocks
+	) {
+		const int bEnd =
+			std::min(bBegin + LinearRemapAssemblyChunkBlocks, nBlocks);
+
+#pragma omp parallel for schedule(dynamic)
+		for (int b = bBegin; b < bEnd; b++) {
+			const int ixBegin = b * LinearRemapParallelBlockSize;
+			const int ixEnd =
+				std::min(ixBegin + LinearRemapParallelBlockSize, nFaces);
+
+			SparseMatrix<double>::TripletVector & vecTriplets =
+				vecBlockTriplets[b];
+
+			try {
+			for (int ixFirst = ixBegin; ixFirst < ixEnd; ixFirst++) {
+
+			// Output every 1000 elements
+			if (ixFirst % 1000 == 0) {
+#pragma omp critical
+				Announce("Element %i/%i", ixFirst, nFaces);
+			}
 
-		// Put composed array into map
-		for (int i = 0; i < nOverlapFaces; i++) {
-			int ixSecond = meshOverlap.vecTargetFaceIx[ixOverlap + i];
+			// Overlap Faces associated with this Face
+			const int ixOverlap = vecOverlapBegin[ixFirst];
 
-			int ixs = 0;
-			for (int s = 0; s < nPin; s++) {
-			for (int t = 0; t < nPin; t++) {
+			const int nOverlapFaces = vecOverlapBegin[ixFirst+1] - ixOverlap;
 
-				int ixFirstNode;
-				if (fContinuousIn) {
-					ixFirstNode = dataGLLNodesIn[s][t][ixFirst] - 1;
-				} else {
-					ixFirstNode = ixFirst * nPin * nPin + s * nPin + t;
-				}
+			// Put composed array into map
+			for (int i = 0; i < nOverlapFaces; i++) {
+				int ixSecond = meshOverlap.vecTargetFaceIx[ixOverlap + i];
 
-				int ixp = 0;
-				for (int p = 0; p < nPout; p++) {
-				for (int q = 0; q < nPout; q++) {
+				int ixs = 0;
+				for (int s = 0; s < nPin; s++) {
+				for (int t = 0; t < nPin; t++) {
 
-					int ixSecondNode;
-					if (fContinuousOut) {
-						ixSecondNode = dataGLLNodesOut[p][q][ixSecond] - 1;
+					int ixFirstNode;
+					if (fContinuousIn) {
+						ixFirstNode = dataGLLNodesIn[s][t][ixFirst] - 1;
+					} else {
+						ixFirstNode = ixFirst * nPin * nPin + s * nPin + t;
+					}
 
-						smatMap(ixSecondNode, ixFirstNode) +=
-							dGlobalIntArray[ixp][ixOverlap + i][ixs]
-							* dataGLLJacobianOut[p][q][ixSecond]
-							/ dataNodalAreaOut[ixSecondNode];
-							// dataIntAreaOut[ixSecondNode];
+					int ixp = 0;
+					for (int p = 0; p < nPout; p++) {
+					for (int q = 0; q < nPout; q++) {
+
+						int ixSecondNode;
+						if (fContinuousOut) {
+							ixSecondNode = dataGLLNodesOut[p][q][ixSecond] - 1;
+
+							vecTriplets.push_back(
+								SparseMatrix<double>::Triplet(
+									ixSecondNode,
+									ixFirstNode,
+									dGlobalIntArray[ixp][ixOverlap + i][ixs]
+									* dataGLLJacobianOut[p][q][ixSecond]
+									/ dataNodalAreaOut[ixSecondNode]));
+								// dataIntAreaOut[ixSecondNode];
+
+						} else {
+							ixSecondNode = ixSecond * nPout * nPout + p * nPout + q;
+						
+							vecTriplets.push_back(
+								SparseMatrix<double>::Triplet(
+									ixSecondNode,
+									ixFirstNode,
+									dGlobalIntArray[ixp][ixOverlap + i][ixs]));
+								// dataIntAreaOut[ixSecondNode];
+						}
 
-					} else {
-						ixSecondNode = ixSecond * nPout * nPout + p * nPout + q;
-					
-						smatMap(ixSecondNode, ixFirstNode) +=
-							dGlobalIntArray[ixp][ixOverlap + i][ixs];
-							// dataIntAreaOut[ixSecondNode];
+						ixp++;
+					}
 					}
 
-					ixp++;
+					ixs++;
 				}
 				}
+			}
+			}
 
-				ixs++;
+			} catch(Exception & e) {
+				vecBlockError[b] = e.ToString();
 			}
+		}
+
+		// Report the error from the first failing face
+		for (int b = bBegin; b < bEnd; b++) {
+			if (vecBlockError[b] != "") {
+				_EXCEPTION1("%s", vecBlockError[b].c_str());
 			}
 		}
 
-		// Increment the current overlap index
-		ixOverlap += nOverlapFaces;
+		// Insert the triplets of the chunk into the map in order of the
+		// blocks, releasing them before the next chunk is computed
+		smatMap.AddBlockTriplets(vecBlockTriplets);
 	}
 }
 
@@ -1846,10 +1988,6 @@ void LinearRemapGLLtoGLL_Integrated(
 	const DataArray2D<double> & dG = triquadrule.GetG();
 	const DataArray1D<double> & dW = triquadrule.GetW();
 
-	// Sample coefficients
-	DataArray2D<double> dSampleCoeffIn(nPin, nPin);
-	DataArray2D<double> dSampleCoeffOut(nPout, nPout);
-
 	// Build the integration array for each element on meshOverlap
 	DataArray3D<double> dGlobalIntArray(
 		nPout * nPout,
@@ -1860,64 +1998,66 @@ void LinearRemapGLLtoGLL_Integrated(
 		meshOverlap.faces.size(),
 		nPin * nPin);
 
-	// Number of overlap Faces per source Face
-	DataArray1D<int> nAllOverlapFaces(meshInput.faces.size());
+	// Range of overlap faces associated with each face on meshInput
+	const int nFaces = meshInput.faces.size();
 
-	int ixOverlap = 0;
-
-	for (int ixFirst = 0; ixFirst < meshInput.faces.size(); ixFirst++) {
-
-		int ixOverlapTemp = ixOverlap;
-		for (; ixOverlapTemp < meshOverlap.faces.size(); ixOverlapTemp++) {
-
-			const Face & faceOverlap = meshOverlap.faces[ixOverlapTemp];
-
-			if (meshOverlap.vecSourceFaceIx[ixOverlapTemp] != ixFirst) {
-				break;
+	std::vector<int> vecOverlapBegin(nFaces+1);
+	{
+		int ixOverlap = 0;
+		for (int ixFirst = 0; ixFirst < nFaces; ixFirst++) {
+			vecOverlapBegin[ixFirst] = ixOverlap;
+			for (; ixOverlap < meshOverlap.faces.size(); ixOverlap++) {
+				if (meshOverlap.vecSourceFaceIx[ixOverlap] != ixFirst) {
+					break;
+				}
 			}
-
-			nAllOverlapFaces[ixFirst]++;
 		}
-
-		// Increment the current overlap index
-		ixOverlap += nAllOverlapFaces[ixFirst];
+		vecOverlapBegin[nFaces] = ixOverlap;
 	}
 
-	// Mesh utilities
-	MeshUtilitiesFuzzy meshutil;
+	const int nBlocks =
+		(nFaces + LinearRemapParallelBlockSize - 1)
+			/ LinearRemapParallelBlockSize;
 
-	// Construct overlap
-	ixOverlap = 0;
+	// Overlap Faces of blocks of faces on meshInput are integrated and
+	// corrected in parallel; each block only writes its own overlap Faces
+	std::vector<std::string> vecBlockError(nBlocks);
 
-	int ixTotal = 0;
+#pragma omp parallel for schedule(dynamic)
+	for (int b = 0; b < nBlocks; b++) {
+		const int ixBegin = b * LinearRemapParallelBlockSize;
+		const int ixEnd =
+			std::min(ixBegin + LinearRemapParallelBlockSize, nFaces);
 
-	std::set<std::pair<int, int> > setFound;
+		// Sample coefficients
+		DataArray2D<double> dSampleCoeffIn(nPin, nPin);
+		DataArray2D<double> dSampleCoeffOut(nPout, nPout);
 
-	// Loop over all input Faces
+		// Mesh utilities
+		MeshUtilitiesFuzzy meshutil;
 
-	for (int ixFirst = 0; ixFirst < meshInput.faces.size(); ixFirst++) {
+		try {
+		for (int ixFirst = ixBegin; ixFirst < ixEnd; ixFirst++) {
 
-		// Output every 100 elements
+		// Output every 1000 elements
 		if (ixFirst % 1000 == 0) {
-			Announce("Element %i/%i", ixFirst, meshInput.faces.size());
+#pragma omp critical
+			Announce("Element %i/%i", ixFirst, nFaces);
 		}
 
+		// Overlap Faces associated with this Face
+		const int ixOverlap = vecOverlapBegin[ixFirst];
+
+		const int nOverlapFaces = vecOverlapBegin[ixFirst+1] - ixOverlap;
+
 		// Quantities from the First Mesh
 		const Face &faceFirst = meshInput.faces[ixFirst];
 
 		const NodeVector &nodesFirst = meshInput.nodes;
 
-		// Number of overlapping Faces and triangles
-		int nOverlapFaces = nAllOverlapFaces[ixFirst];
-
 		// Loop through all Overlap Faces
 		for (int i = 0; i < nOverlapFaces; i++) {
 
-			// Quantities from the overlap Mesh
-			const Face & faceOverlap = meshOverlap.faces[ixOverlap + i];
-
-			const NodeVector & nodesOverlap = meshOverlap.nodes;
-
 			// Quantities from the Second Mesh
 			int ixSecond = meshOverlap.vecTargetFaceIx[ixOverlap + i];
 
@@ -1925,40 +2065,15 @@ void LinearRemapGLLtoGLL_Integrated(
 
 			const Face & faceSecond = meshOutput.faces[ixSecond];
 
-			int nbEdges = faceOverlap.edges.size();
-			int nOverlapTriangles = 1;
-			Node nodeCenter; // not used if nbEdges == 3
-			if (nbEdges > 3) { // decompose from nodeCenter in this case
-				nOverlapTriangles = nbEdges;
-				for (int k = 0; k < nbEdges; k++) {
-					const Node &node = nodesOverlap[faceOverlap[k]];
-					nodeCenter = nodeCenter + node;
-				}
-				nodeCenter = nodeCenter / nbEdges;
-				double dMagni = sqrt(
-						nodeCenter.x * nodeCenter.x + nodeCenter.y * nodeCenter.y
-								+ nodeCenter.z * nodeCenter.z);
-				nodeCenter = nodeCenter / dMagni; // project back on sphere of radius 1
-			}
+			MeshFaceTriangles triangles(meshOverlap, ixOverlap + i);
 
 			Node node0, node1, node2;
 			double dTriArea;
 
 			// Loop over all sub-triangles of this Overlap Face
-			for (int k = 0; k < nOverlapTriangles; k++) {
-				if (nbEdges == 3) { // will come here only once, nOverlapTriangles == 1 in this case
-					node0 = nodesOverlap[faceOverlap[0]];
-					node1 = nodesOverlap[faceOverlap[1]];
-					node2 = nodesOverlap[faceOverlap[2]];
-				}
-				else { // decompose polygon in triangles around the nodeCenter
-					node0 = nodeCenter;
-					node1 = nodesOverlap[faceOverlap[k]];
-					int k1 = (k + 1) % nbEdges;
-					node2 = nodesOverlap[faceOverlap[k1]];
-				}
-				dTriArea = CalculateTriangleAreaQuadratureMethod(node0, node1,
-						node2);
+			for (int k = 0; k < triangles.size(); k++) {
+				triangles.GetTriangle(k, node0, node1, node2);
+				dTriArea = triangles.GetArea(k, node0, node1, node2);
 
 				for (int k = 0; k < triquadrule.GetPoints(); k++) {
 
@@ -2142,9 +2257,18 @@ void LinearRemapGLLtoGLL_Integrated(
 			}
 			}
 		}
+		}
 
-		// Increment the current overlap index
-		ixOverlap += nOverlapFaces;
+		} catch(Exception & e) {
+			vecBlockError[b] = e.ToString();
+		}
+	}
+
+	// Report the error from the first failing face
+	for (int b = 0; b < nBlocks; b++) {
+		if (vecBlockError[b] != "") {
+			_EXCEPTION1("%s", vecBlockError[b].c_str());
+		}
 	}
 
 	// Reverse map
@@ -2156,10 +2280,16 @@ void LinearRemapGLLtoGLL_Integrated(
 		vecReverseFaceIx[ixSecond].push_back(i);
 	}
 
-	// Force consistency and conservation on linear sub-map
-	int ixDistBegin = 0;
+	// Force consistency and conservation on linear sub-map of each face on
+	// meshOutput in parallel; each face only writes its own overlap Faces
+	const int nTargetFaces = meshOutput.faces.size();
+
+	std::vector<std::string> vecTargetFaceError(nTargetFaces);
+
+#pragma omp parallel for schedule(dynamic, LinearRemapParallelBlockSize)
+	for (int ixSecond = 0; ixSecond < nTargetFaces; ixSecond++) {
 
-	for (int ixSecond = 0; ixSecond < meshOutput.faces.size(); ixSecond++) {
+		try {
 
 		// Coefficients
 		DataArray2D<double> dCoeff(
@@ -2258,7 +2388,7 @@ void LinearRemapGLLtoGLL_Integrated(
 		// Coefficients
 		for (int i = 0; i < vecReverseFaceIx[ixSecond].size(); i++) {
 
-			ixOverlap = vecReverseFaceIx[ixSecond][i];
+			const int ixOverlap = vecReverseFaceIx[ixSecond][i];
 
 			if ((ixOverlap < 0) || (ixOverlap > dGlobalIntArray.GetColumns())) {
 				_EXCEPTION();
@@ -2283,75 +2413,126 @@ void LinearRemapGLLtoGLL_Integrated(
 			}
 		}
 
+
+		} catch(Exception & e) {
+			vecTargetFaceError[ixSecond] = e.ToString();
+		}
+	}
+
+	for (int ixSecond = 0; ixSecond < nTargetFaces; ixSecond++) {
+		if (vecTargetFaceError[ixSecond] != "") {
+			_EXCEPTION1("%s", vecTargetFaceError[ixSecond].c_str());
+		}
 	}
 
 	// Get SparseMatrix represntation of the OfflineMap
 	SparseMatrix<double> & smatMap = mapRemap.GetSparseMatrix();
 
 	// Compose the integration operator with the output map
-	ixOverlap = 0;
-
-	for (int ixFirst = 0; ixFirst < meshInput.faces.size(); ixFirst++) {
-
-		// Output every 100 elements
-		if (ixFirst % 1000 == 0) {
-                  Announce("Element %i/%i", ixFirst,meshInput.faces.size());
-		}
+	// Map weights are assembled for blocks of faces on meshInput in
+	// parallel and stored as triplets, which are added to the map in
+	// order of the faces on meshInput
+	std::vector<SparseMatrix<double>::TripletVector> vecBlockTriplets(nBlocks);
+
+	// Blocks are computed in chunks of LinearRemapAssemblyChunkBlocks so
+	// that only the triplets of one chunk are held in memory at a time
+	for (int bBegin = 0; bBegin < nBlocks;
+	     bBegin += LinearRemapAssemblyChunkBlocks
+	) {
+		const int bEnd =
+			std::min(bBegin + LinearRemapAssemblyChunkBlocks, nBlocks);
+
+#pragma omp parallel for schedule(dynamic)
+		for (int b = bBegin; b < bEnd; b++) {
+			const int ixBegin = b * LinearRemapParallelBlockSize;
+			const int ixEnd =
+				std::min(ixBegin + LinearRemapParallelBlockSize, nFaces);
+
+			SparseMatrix<double>::TripletVector & vecTriplets =
+				vecBlockTriplets[b];
+
+			try {
+			for (int ixFirst = ixBegin; ixFirst < ixEnd; ixFirst++) {
+
+			// Output every 1000 elements
+			if (ixFirst % 1000 == 0) {
+#pragma omp critical
+				Announce("Element %i/%i", ixFirst, nFaces);
+			}
 
-		// This Face
-		const Face & faceFirst = meshInput.faces[ixFirst];
+			// Overlap Faces associated with this Face
+			const int ixOverlap = vecOverlapBegin[ixFirst];
 
-		// Number of overlapping Faces and triangles
-		int nOverlapFaces = nAllOverlapFaces[ixFirst];
+			const int nOverlapFaces = vecOverlapBegin[ixFirst+1] - ixOverlap;
 
-		// Put composed array into map
-		for (int i = 0; i < nOverlapFaces; i++) {
-			int ixSecond = meshOverlap.vecTargetFaceIx[ixOverlap + i];
-
-			int ixs = 0;
-			for (int s = 0; s < nPin; s++) {
-			for (int t = 0; t < nPin; t++) {
+			// Put composed array into map
+			for (int i = 0; i < nOverlapFaces; i++) {
+				int ixSecond = meshOverlap.vecTargetFaceIx[ixOverlap + i];
 
-				int ixFirstNode;
-				if (fContinuousIn) {
-					ixFirstNode = dataGLLNodesIn[s][t][ixFirst] - 1;
-				} else {
-					ixFirstNode = ixFirst * nPin * nPin + s * nPin + t;
-				}
+				int ixs = 0;
+				for (int s = 0; s < nPin; s++) {
+				for (int t = 0; t < nPin; t++) {
 
-				int ixp = 0;
-				for (int p = 0; p < nPout; p++) {
-				for (int q = 0; q < nPout; q++) {
-
-					int ixSecondNode;
-					if (fContinuousOut) {
-						ixSecondNode = dataGLLNodesOut[p][q][ixSecond] - 1;
+					int ixFirstNode;
+					if (fContinuousIn) {
+						ixFirstNode = dataGLLNodesIn[s][t][ixFirst] - 1;
+					} else {
+						ixFirstNode = ixFirst * nPin * nPin + s * nPin + t;
+					}
 
-						smatMap(ixSecondNode, ixFirstNode) +=
-							dGlobalIntArray[ixp][ixOverlap + i][ixs]
-							* dataGLLJacobianOut[p][q][ixSecond]
-							/ dataNodalAreaOut[ixSecondNode];
-							// dataIntAreaOut[ixSecondNode];
+					int ixp = 0;
+					for (int p = 0; p < nPout; p++) {
+					for (int q = 0; q < nPout; q++) {
+
+						int ixSecondNode;
+						if (fContinuousOut) {
+							ixSecondNode = dataGLLNodesOut[p][q][ixSecond] - 1;
+
+							vecTriplets.push_back(
+								SparseMatrix<double>::Triplet(
+									ixSecondNode,
+									ixFirstNode,
+									dGlobalIntArray[ixp][ixOverlap + i][ixs]
+									* dataGLLJacobianOut[p][q][ixSecond]
+									/ dataNodalAreaOut[ixSecondNode]));
+								// dataIntAreaOut[ixSecondNode];
+
+						} else {
+							ixSecondNode = ixSecond * nPout * nPout + p * nPout + q;
+						
+							vecTriplets.push_back(
+								SparseMatrix<double>::Triplet(
+									ixSecondNode,
+									ixFirstNode,
+									dGlobalIntArray[ixp][ixOverlap + i][ixs]));
+								// dataIntAreaOut[ixSecondNode];
+						}
 
-					} else {
-						ixSecondNode = ixSecond * nPout * nPout + p * nPout + q;
-					
-						smatMap(ixSecondNode, ixFirstNode) +=
-							dGlobalIntArray[ixp][ixOverlap + i][ixs];
-							// dataIntAreaOut[ixSecondNode];
+						ixp++;
+					}
 					}
 
-					ixp++;
+					ixs++;
 				}
 				}
+			}
+			}
 
-				ixs++;
+			} catch(Exception & e) {
+				vecBlockError[b] = e.ToString();
 			}
+		}
+
+		// Report the error from the first failing face
+		for (int b = bBegin; b < bEnd; b++) {
+			if (vecBlockError[b] != "") {
+				_EXCEPTION1("%s", vecBlockError[b].c_str());
 			}
 		}
 
-		// Increment the current overlap index
-		ixOverlap += nOverlapFaces;
+		// Insert the triplets of the chunk into the map in order of the
+		// blocks, releasing them before the next chunk is computed
+		smatMap.AddBlockTriplets(vecBlockTriplets);
 	}
 }
 
@@ -20,12 +20,32 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "GridElements.h"
+#include "DataArray1D.h"
+#include "DataArray2D.h"
 #include "DataArray3D.h"
 
 class OfflineMap;
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		Adjust the coefficients dCoeff (one row per target and one column
+///		per source) so that the remapping is consistent and conservative
+///		with respect to the given source and target areas, optionally
+///		preserving monotonicity.  If fSparseConstraints is set the constraint
+///		matrix is applied implicitly from its sparsity pattern, without
+///		forming any dense matrices.
+///	</summary>
+void ForceConsistencyConservation3(
+	const DataArray1D<double> & vecSourceArea,
+	const DataArray1D<double> & vecTargetArea,
+	DataArray2D<double> & dCoeff,
+	bool fMonotone,
+	bool fSparseConstraints = false
+);
+
+///////////////////////////////////////////////////////////////////////////////
+
 ///	<summary>
 ///		Generate the OfflineMap for linear conserative element-average
 ///		spectral element to element average remapping.
@@ -43,7 +63,9 @@ void LinearRemapSE0(
 
 ///	<summary>
 ///		Generate the OfflineMap for cubic conserative element-average
-///		spectral element to element average remapping.
+///		spectral element to element average remapping.  If
+///		dQuadratureTolerance is positive, small overlap triangles are
+///		integrated with lower order quadrature rules.
 ///	</summary>
 void LinearRemapSE4(
 	const Mesh & meshInput,
@@ -55,7 +77,8 @@ void LinearRemapSE4(
 	bool fContinuousIn,
 	bool fNoConservation,
 	bool fSparseConstraints,
-	OfflineMap & mapRemap
+	OfflineMap & mapRemap,
+	double dQuadratureTolerance = 0.0
 );
 
 ///////////////////////////////////////////////////////////////////////////////
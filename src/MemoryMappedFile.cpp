@@ -0,0 +1,109 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    MemoryMappedFile.cpp
+///	\author  Paul Ullrich
+///	\version October 14, 2026
+///
+///	<remarks>
+///		Copyright 2026 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "MemoryMappedFile.h"
+#include "Exception.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+///////////////////////////////////////////////////////////////////////////////
+
+void MemoryMappedFile::Open(
+	const std::string & strFile,
+	bool fCopyOnWrite
+) {
+	Close();
+
+	int fd = open(strFile.c_str(), O_RDONLY);
+	if (fd == -1) {
+		_EXCEPTION2("Unable to open file \"%s\" (%s)",
+			strFile.c_str(), strerror(errno));
+	}
+
+	struct stat statFile;
+	if (fstat(fd, &statFile) == -1) {
+		close(fd);
+		_EXCEPTION2("Unable to stat file \"%s\" (%s)",
+			strFile.c_str(), strerror(errno));
+	}
+
+	size_t sSize = static_cast<size_t>(statFile.st_size);
+	if (sSize == 0) {
+		close(fd);
+		_EXCEPTION1("File \"%s\" is empty", strFile.c_str());
+	}
+
+	void * pData;
+	if (fCopyOnWrite) {
+		pData = mmap(NULL, sSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	} else {
+		pData = mmap(NULL, sSize, PROT_READ, MAP_SHARED, fd, 0);
+	}
+
+	// The mapping remains valid after the descriptor is closed
+	close(fd);
+
+	if (pData == MAP_FAILED) {
+		_EXCEPTION2("Unable to memory map file \"%s\" (%s)",
+			strFile.c_str(), strerror(errno));
+	}
+
+#if defined(MADV_WILLNEED)
+	madvise(pData, sSize, MADV_WILLNEED);
+#endif
+
+	m_pData = pData;
+	m_sSize = sSize;
+	m_fCopyOnWrite = fCopyOnWrite;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void MemoryMappedFile::Close() {
+	if (m_pData != NULL) {
+		munmap(m_pData, m_sSize);
+	}
+	m_pData = NULL;
+	m_sSize = 0;
+	m_fCopyOnWrite = false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void MemoryMappedFile::Swap(
+	MemoryMappedFile & mmf
+) {
+	void * pData = m_pData;
+	size_t sSize = m_sSize;
+	bool fCopyOnWrite = m_fCopyOnWrite;
+
+	m_pData = mmf.m_pData;
+	m_sSize = mmf.m_sSize;
+	m_fCopyOnWrite = mmf.m_fCopyOnWrite;
+
+	mmf.m_pData = pData;
+	mmf.m_sSize = sSize;
+	mmf.m_fCopyOnWrite = fCopyOnWrite;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
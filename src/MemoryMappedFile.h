@@ -0,0 +1,157 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    MemoryMappedFile.h
+///	\author  Paul Ullrich
+///	\version October 14, 2026
+///
+///	<remarks>
+///		Copyright 2026 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#ifndef _MEMORYMAPPEDFILE_H_
+#define _MEMORYMAPPEDFILE_H_
+
+#include <string>
+#include <cstddef>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A read-only memory mapping of a file.  Pages are shared through the
+///		operating system page cache between all processes mapping the
+///		same file.
+///	</summary>
+class MemoryMappedFile {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	MemoryMappedFile() :
+		m_pData(NULL),
+		m_sSize(0),
+		m_fCopyOnWrite(false)
+	{ }
+
+	///	<summary>
+	///		Destructor.
+	///	</summary>
+	~MemoryMappedFile() {
+		Close();
+	}
+
+	///	<summary>
+	///		Move constructor, transferring the mapping.
+	///	</summary>
+	MemoryMappedFile(MemoryMappedFile && mmf) :
+		m_pData(NULL),
+		m_sSize(0),
+		m_fCopyOnWrite(false)
+	{
+		Swap(mmf);
+	}
+
+	///	<summary>
+	///		Move assignment operator, transferring the mapping.
+	///	</summary>
+	MemoryMappedFile & operator=(MemoryMappedFile && mmf) {
+		if (this != &mmf) {
+			Close();
+			Swap(mmf);
+		}
+		return (*this);
+	}
+
+private:
+	///	<summary>
+	///		Copy constructor (disabled).
+	///	</summary>
+	MemoryMappedFile(const MemoryMappedFile &);
+
+	///	<summary>
+	///		Assignment operator (disabled).
+	///	</summary>
+	MemoryMappedFile & operator=(const MemoryMappedFile &);
+
+public:
+	///	<summary>
+	///		Map the given file into memory.  If fCopyOnWrite is set the
+	///		mapping is private and writable: pages are shared until they are
+	///		first modified, and modifications are never written to the file.
+	///		This allows arrays attached to the mapping to be modified in place.
+	///	</summary>
+	void Open(
+		const std::string & strFile,
+		bool fCopyOnWrite = false
+	);
+
+	///	<summary>
+	///		Unmap the file.
+	///	</summary>
+	void Close();
+
+	///	<summary>
+	///		Swap the mapping held by this object with another.
+	///	</summary>
+	void Swap(
+		MemoryMappedFile & mmf
+	);
+
+	///	<summary>
+	///		Check if a file is currently mapped.
+	///	</summary>
+	bool IsOpen() const {
+		return (m_pData != NULL);
+	}
+
+	///	<summary>
+	///		Get a pointer to the mapped data.
+	///	</summary>
+	const void * GetData() const {
+		return m_pData;
+	}
+
+	///	<summary>
+	///		Get a pointer to the mapped data of a copy-on-write mapping.
+	///	</summary>
+	void * GetWritableData() const {
+		if (!m_fCopyOnWrite) {
+			return NULL;
+		}
+		return m_pData;
+	}
+
+	///	<summary>
+	///		Get the size of the mapped data, in bytes.
+	///	</summary>
+	size_t GetSize() const {
+		return m_sSize;
+	}
+
+private:
+	///	<summary>
+	///		Pointer to the mapped data.
+	///	</summary>
+	void * m_pData;
+
+	///	<summary>
+	///		Size of the mapped data, in bytes.
+	///	</summary>
+	size_t m_sSize;
+
+	///	<summary>
+	///		Flag indicating the mapping is private and writable.
+	///	</summary>
+	bool m_fCopyOnWrite;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif
+
@@ -15,95 +15,97 @@
 ///	</remarks>
 
 #include "MeshUtilities.h"
+#include "FaceBVH.h"
 
 #include "Exception.h"
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void MeshUtilities::FindFaceFromNode(
+bool MeshUtilities::ExamineFaceForNode(
 	const Mesh & mesh,
 	const Node & node,
+	int ixFace,
 	FindFaceStruct & aFindFaceStruct
 ) {
-	// Reset the FaceStruct
-	aFindFaceStruct.vecFaceIndices.clear();
-	aFindFaceStruct.vecFaceLocations.clear();
-	aFindFaceStruct.loc = Face::NodeLocation_Undefined;
-
-	// Loop through all faces to find overlaps
-	// Note: This algorithm can likely be dramatically improved
-	for (int l = 0; l < mesh.faces.size(); l++) {
-		Face::NodeLocation loc;
-		int ixLocation;
-
-		ContainsNode(
-			mesh.faces[l],
-			mesh.nodes,
-			node,
-			loc,
-			ixLocation);
-
-		if (loc == Face::NodeLocation_Exterior) {
-			continue;
-		}
+	Face::NodeLocation loc;
+	int ixLocation;
+
+	ContainsNode(
+		mesh.faces[ixFace],
+		mesh.nodes,
+		node,
+		loc,
+		ixLocation);
+
+	if (loc == Face::NodeLocation_Exterior) {
+		return false;
+	}
 
 #ifdef VERBOSE
-		printf("%i\n", l);
-		printf("n: %1.5e %1.5e %1.5e\n", node.x, node.y, node.z);
-		printf("n0: %1.5e %1.5e %1.5e\n",
-			mesh.nodes[mesh.faces[l][0]].x,
-			mesh.nodes[mesh.faces[l][0]].y,
-			mesh.nodes[mesh.faces[l][0]].z);
-		printf("n1: %1.5e %1.5e %1.5e\n",
-			mesh.nodes[mesh.faces[l][1]].x,
-			mesh.nodes[mesh.faces[l][1]].y,
-			mesh.nodes[mesh.faces[l][1]].z);
-		printf("n2: %1.5e %1.5e %1.5e\n",
-			mesh.nodes[mesh.faces[l][2]].x,
-			mesh.nodes[mesh.faces[l][2]].y,
-			mesh.nodes[mesh.faces[l][2]].z);
-		printf("n3: %1.5e %1.5e %1.5e\n",
-			mesh.nodes[mesh.faces[l][3]].x,
-			mesh.nodes[mesh.faces[l][3]].y,
-			mesh.nodes[mesh.faces[l][3]].z);
+	printf("%i\n", ixFace);
+	printf("n: %1.5e %1.5e %1.5e\n", node.x, node.y, node.z);
+	printf("n0: %1.5e %1.5e %1.5e\n",
+		mesh.nodes[mesh.faces[ixFace][0]].x,
+		mesh.nodes[mesh.faces[ixFace][0]].y,
+		mesh.nodes[mesh.faces[ixFace][0]].z);
+	printf("n1: %1.5e %1.5e %1.5e\n",
+		mesh.nodes[mesh.faces[ixFace][1]].x,
+		mesh.nodes[mesh.faces[ixFace][1]].y,
+		mesh.nodes[mesh.faces[ixFace][1]].z);
+	printf("n2: %1.5e %1.5e %1.5e\n",
+		mesh.nodes[mesh.faces[ixFace][2]].x,
+		mesh.nodes[mesh.faces[ixFace][2]].y,
+		mesh.nodes[mesh.faces[ixFace][2]].z);
+	printf("n3: %1.5e %1.5e %1.5e\n",
+		mesh.nodes[mesh.faces[ixFace][3]].x,
+		mesh.nodes[mesh.faces[ixFace][3]].y,
+		mesh.nodes[mesh.faces[ixFace][3]].z);
 #endif
 
-		if (aFindFaceStruct.loc == Face::NodeLocation_Undefined) {
-			aFindFaceStruct.loc = loc;
-		}
-
-		// Node is in the interior of this face
-		if (loc == Face::NodeLocation_Interior) {
-			if (loc != aFindFaceStruct.loc) {
-				_EXCEPTIONT("No consensus on location of Node");
-			}
+	if (aFindFaceStruct.loc == Face::NodeLocation_Undefined) {
+		aFindFaceStruct.loc = loc;
+	}
 
-			aFindFaceStruct.vecFaceIndices.push_back(l);
-			aFindFaceStruct.vecFaceLocations.push_back(ixLocation);
-			break;
+	// Node is in the interior of this face
+	if (loc == Face::NodeLocation_Interior) {
+		if (loc != aFindFaceStruct.loc) {
+			_EXCEPTIONT("No consensus on location of Node");
 		}
 
-		// Node is on the edge of this face
-		if (loc == Face::NodeLocation_Edge) {
-			if (loc != aFindFaceStruct.loc) {
-				_EXCEPTIONT("No consensus on location of Node");
-			}
+		aFindFaceStruct.vecFaceIndices.push_back(ixFace);
+		aFindFaceStruct.vecFaceLocations.push_back(ixLocation);
+		return true;
+	}
 
-			aFindFaceStruct.vecFaceIndices.push_back(l);
-			aFindFaceStruct.vecFaceLocations.push_back(ixLocation);
+	// Node is on the edge of this face
+	if (loc == Face::NodeLocation_Edge) {
+		if (loc != aFindFaceStruct.loc) {
+			_EXCEPTIONT("No consensus on location of Node");
 		}
 
-		// Node is at the corner of this face
-		if (loc == Face::NodeLocation_Corner) {
-			if (loc != aFindFaceStruct.loc) {
-				_EXCEPTIONT("No consensus on location of Node");
-			}
+		aFindFaceStruct.vecFaceIndices.push_back(ixFace);
+		aFindFaceStruct.vecFaceLocations.push_back(ixLocation);
+	}
 
-			aFindFaceStruct.vecFaceIndices.push_back(l);
-			aFindFaceStruct.vecFaceLocations.push_back(ixLocation);
+	// Node is at the corner of this face
+	if (loc == Face::NodeLocation_Corner) {
+		if (loc != aFindFaceStruct.loc) {
+			_EXCEPTIONT("No consensus on location of Node");
 		}
+
+		aFindFaceStruct.vecFaceIndices.push_back(ixFace);
+		aFindFaceStruct.vecFaceLocations.push_back(ixLocation);
 	}
 
+	return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void MeshUtilities::ValidateFindFaceStruct(
+	const Node & node,
+	const FindFaceStruct & aFindFaceStruct
+) {
 	// Edges can only have two adjacent Faces
 	if (aFindFaceStruct.loc == Face::NodeLocation_Edge) {
 		if (aFindFaceStruct.vecFaceIndices.size() != 2) {
@@ -126,3 +128,62 @@ void MeshUtilities::FindFaceFromNode(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void MeshUtilities::FindFaceFromNode(
+	const Mesh & mesh,
+	const Node & node,
+	FindFaceStruct & aFindFaceStruct
+) {
+	// Reset the FaceStruct
+	aFindFaceStruct.vecFaceIndices.clear();
+	aFindFaceStruct.vecFaceLocations.clear();
+	aFindFaceStruct.loc = Face::NodeLocation_Undefined;
+
+	// Loop through all faces to find overlaps
+	for (int l = 0; l < mesh.faces.size(); l++) {
+		if (ExamineFaceForNode(mesh, node, l, aFindFaceStruct)) {
+			break;
+		}
+	}
+
+	ValidateFindFaceStruct(node, aFindFaceStruct);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void MeshUtilities::FindFaceFromNode(
+	const Mesh & mesh,
+	const Node & node,
+	const std::vector<int> & vecCandidateFaces,
+	FindFaceStruct & aFindFaceStruct
+) {
+	// Reset the FaceStruct
+	aFindFaceStruct.vecFaceIndices.clear();
+	aFindFaceStruct.vecFaceLocations.clear();
+	aFindFaceStruct.loc = Face::NodeLocation_Undefined;
+
+	// Loop through all candidate faces to find overlaps
+	for (int i = 0; i < vecCandidateFaces.size(); i++) {
+		if (ExamineFaceForNode(mesh, node, vecCandidateFaces[i], aFindFaceStruct)) {
+			break;
+		}
+	}
+
+	ValidateFindFaceStruct(node, aFindFaceStruct);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void MeshUtilities::FindFaceFromNode(
+	const Mesh & mesh,
+	const FaceBVH & bvh,
+	const Node & node,
+	FindFaceStruct & aFindFaceStruct
+) {
+	std::vector<int> vecCandidateFaces;
+	bvh.FindCandidateFaces(node, vecCandidateFaces);
+
+	FindFaceFromNode(mesh, node, vecCandidateFaces, aFindFaceStruct);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
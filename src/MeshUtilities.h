@@ -21,6 +21,10 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 
+class FaceBVH;
+
+///////////////////////////////////////////////////////////////////////////////
+
 class MeshUtilities {
 
 public:
@@ -45,6 +49,51 @@ public:
 		FindFaceStruct & aFindFaceStruct
 	);
 
+	///	<summary>
+	///		Find all Face indices that contain this Node, examining only the
+	///		given candidate Faces.  If the candidates are in ascending order
+	///		and include every Face containing the Node the result is the same
+	///		as when all Faces are examined.
+	///	</summary>
+	void FindFaceFromNode(
+		const Mesh & mesh,
+		const Node & node,
+		const std::vector<int> & vecCandidateFaces,
+		FindFaceStruct & aFindFaceStruct
+	);
+
+	///	<summary>
+	///		Find all Face indices that contain this Node, examining only the
+	///		candidate Faces returned by a FaceBVH built over the mesh.
+	///	</summary>
+	void FindFaceFromNode(
+		const Mesh & mesh,
+		const FaceBVH & bvh,
+		const Node & node,
+		FindFaceStruct & aFindFaceStruct
+	);
+
+private:
+	///	<summary>
+	///		Add a Face to aFindFaceStruct if it contains this Node.  Returns
+	///		true if the Node is in the interior of the Face, in which case no
+	///		other Faces need to be examined.
+	///	</summary>
+	bool ExamineFaceForNode(
+		const Mesh & mesh,
+		const Node & node,
+		int ixFace,
+		FindFaceStruct & aFindFaceStruct
+	);
+
+	///	<summary>
+	///		Verify that the Faces found by FindFaceFromNode() are consistent
+	///		with the location of the Node.
+	///	</summary>
+	void ValidateFindFaceStruct(
+		const Node & node,
+		const FindFaceStruct & aFindFaceStruct
+	);
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -17,11 +17,86 @@
 #include "MeshUtilitiesExact.h"
 
 #include "Exception.h"
+#include "OverlapMeshStatistics.h"
+
+#include <cfloat>
+#include <cmath>
 
 #ifdef USE_EXACT_ARITHMETIC
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		Relative error bound on the triple product of three Nodes evaluated
+///		in double precision from their scaled coordinates.  Each of the six
+///		terms accumulates at most eight roundings (three from converting the
+///		coordinates, two products, one difference and two sums); the bound
+///		includes a safety factor of two.
+///	</summary>
+static const double TripleProductErrorBound = 8.0 * DBL_EPSILON;
+
+///	<summary>
+///		Determine the sign of the exact triple product (node0 x node1) . node2
+///		in double precision.  Returns false if the sign cannot be certified
+///		from the floating point error bound, in which case the FixedPoint
+///		calculation must be used.
+///	</summary>
+static bool FilteredTripleProductSign(
+	const NodeExact & node0,
+	const NodeExact & node1,
+	const NodeExact & node2,
+	int & iSign
+) {
+	double d0[3];
+	double d1[3];
+	double d2[3];
+
+	if (!node0.fx.ToScaledReal(d0[0]) ||
+	    !node0.fy.ToScaledReal(d0[1]) ||
+	    !node0.fz.ToScaledReal(d0[2]) ||
+	    !node1.fx.ToScaledReal(d1[0]) ||
+	    !node1.fy.ToScaledReal(d1[1]) ||
+	    !node1.fz.ToScaledReal(d1[2]) ||
+	    !node2.fx.ToScaledReal(d2[0]) ||
+	    !node2.fy.ToScaledReal(d2[1]) ||
+	    !node2.fz.ToScaledReal(d2[2])
+	) {
+		return false;
+	}
+
+	const double dCrossX = d0[1] * d1[2] - d0[2] * d1[1];
+	const double dCrossY = d0[2] * d1[0] - d0[0] * d1[2];
+	const double dCrossZ = d0[0] * d1[1] - d0[1] * d1[0];
+
+	const double dTriple = dCrossX * d2[0] + dCrossY * d2[1] + dCrossZ * d2[2];
+
+	const double dPermanent =
+		  (fabs(d0[1] * d1[2]) + fabs(d0[2] * d1[1])) * fabs(d2[0])
+		+ (fabs(d0[2] * d1[0]) + fabs(d0[0] * d1[2])) * fabs(d2[1])
+		+ (fabs(d0[0] * d1[1]) + fabs(d0[1] * d1[0])) * fabs(d2[2]);
+
+	const double dErrorBound = TripleProductErrorBound * dPermanent;
+
+	if (dTriple > dErrorBound) {
+		iSign = (+1);
+		return true;
+	}
+	if (dTriple < -dErrorBound) {
+		iSign = (-1);
+		return true;
+	}
+
+	// An exactly zero permanent means every term is zero
+	if (dPermanent == 0.0) {
+		iSign = 0;
+		return true;
+	}
+
+	return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 bool MeshUtilitiesExact::AreNodesEqual(
 	const NodeExact & node0,
 	const NodeExact & node1
@@ -51,6 +126,9 @@ void MeshUtilitiesExact::ContainsNode(
 	// Set of edges which "contain" this node
 	std::set<int> setContainedEdgeIx;
 
+	// Exact representation of the node
+	const NodeExact nodeX(node);
+
 	// Loop through all Edges of this face
 	for (int i = 0; i < face.edges.size(); i++) {
 
@@ -65,7 +143,21 @@ void MeshUtilitiesExact::ContainsNode(
 
 		if (face.edges[i].type == Edge::Type_GreatCircleArc) {
 
-			FixedPoint fpDotNorm = DotProductX(CrossProductX(na, nb), node);
+			// Most nodes are decided by the floating point filter
+			int iSign;
+			if (FilteredTripleProductSign(na, nb, nodeX, iSign)) {
+				if (iSign < 0) {
+					loc = Face::NodeLocation_Exterior;
+					ixLocation = 0;
+					return;
+				}
+				if (iSign == 0) {
+					setContainedEdgeIx.insert(i);
+				}
+				continue;
+			}
+
+			FixedPoint fpDotNorm = DotProductX(CrossProductX(na, nb), nodeX);
 /*
 			Node nx = CrossProductX(na, nb);
 			nx.PrintMX();
@@ -173,6 +265,44 @@ bool MeshUtilitiesExact::CalculateEdgeIntersections(
 	std::vector<NodeExact> & nodeIntersections,
 	bool fIncludeFirstBeginNode
 ) {
+	OVERLAPMESH_STAT_COUNT(Counter_EdgeIntersectionTests);
+
+	// Two great circle arcs cannot intersect if both endpoints of one arc
+	// lie strictly on the same side of the plane of the other.  Decide this
+	// with the floating point filter where possible.  A nonzero triple
+	// product with the endpoints of an arc also certifies that the arc is
+	// non-degenerate.
+	if ((typeFirst  == Edge::Type_GreatCircleArc) &&
+		(typeSecond == Edge::Type_GreatCircleArc)
+	) {
+		int iSign11 = 0;
+		int iSign12 = 0;
+		int iSign21 = 0;
+		int iSign22 = 0;
+
+		bool fSign11 = FilteredTripleProductSign(
+			nodeSecondBegin, nodeSecondEnd, nodeFirstBegin, iSign11);
+		bool fSign12 = FilteredTripleProductSign(
+			nodeSecondBegin, nodeSecondEnd, nodeFirstEnd, iSign12);
+		bool fSign21 = FilteredTripleProductSign(
+			nodeFirstBegin, nodeFirstEnd, nodeSecondBegin, iSign21);
+		bool fSign22 = FilteredTripleProductSign(
+			nodeFirstBegin, nodeFirstEnd, nodeSecondEnd, iSign22);
+
+		bool fFirstNonDegenerate =
+			(fSign21 && (iSign21 != 0)) || (fSign22 && (iSign22 != 0));
+		bool fSecondNonDegenerate =
+			(fSign11 && (iSign11 != 0)) || (fSign12 && (iSign12 != 0));
+
+		if (fFirstNonDegenerate && fSecondNonDegenerate) {
+			if ((fSign21 && fSign22 && (iSign21 * iSign22 > 0)) ||
+			    (fSign11 && fSign12 && (iSign11 * iSign12 > 0))
+			) {
+				nodeIntersections.clear();
+				return false;
+			}
+		}
+	}
 
 	// Make a locally modifyable version of the Nodes
 	NodeExact node11;
@@ -462,7 +592,7 @@ int MeshUtilitiesExact::FindFaceNearNode(
 	NodeExact nodeBegin = mesh.nodes[ixNode];
 
 	// Get the set of faces adjacent this node
-	const std::set<int> & setNearbyFaces = mesh.revnodearray[ixNode];
+	const ReverseNodeArray::FaceRange setNearbyFaces = mesh.revnodearray[ixNode];
 
 	if (setNearbyFaces.size() < 3) {
 		_EXCEPTIONT("Insufficient Faces at Corner; at least three Faces expected");
@@ -485,9 +615,13 @@ int MeshUtilitiesExact::FindFaceNearNode(
 	printf("BENorm: "); fpDotNeNb.Print(); printf("\n");
 */
 	// Loop through all faces
-	std::set<int>::const_iterator iter = setNearbyFaces.begin();
+	OVERLAPMESH_STAT_WALK(walkNearNode, Histogram_FindFaceNearNodeWalkLength);
+
+	ReverseNodeArray::FaceRange::const_iterator iter = setNearbyFaces.begin();
 	for (; iter != setNearbyFaces.end(); iter++) {
 
+		OVERLAPMESH_STAT_STEP(walkNearNode);
+
 		const Face & face = mesh.faces[*iter];
 
 		int nEdges = face.edges.size();
@@ -17,6 +17,7 @@
 #include "MeshUtilitiesFuzzy.h"
 
 #include "Exception.h"
+#include "OverlapMeshStatistics.h"
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -86,6 +87,57 @@ int MeshUtilitiesFuzzy::FindNodeEdgeSide(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void MeshUtilitiesFuzzy::FindNodeEdgeSides(
+	const Node & nodeBegin,
+	const Node & nodeEnd,
+	const Edge::Type edgetype,
+	const NodeVector & vecNodeTest,
+	std::vector<int> & vecSides
+) const {
+	static const Real Tolerance = ReferenceTolerance;
+
+	const int nNodes = vecNodeTest.size();
+
+	vecSides.resize(nNodes);
+
+	const Node * pNodeTest = &(vecNodeTest[0]);
+	int * pSides = &(vecSides[0]);
+
+	// Side is -1 if dDotNorm <= -Tolerance, 0 if dDotNorm < Tolerance
+	// and +1 otherwise
+	if (edgetype == Edge::Type_GreatCircleArc) {
+		const Node nodeNorm = CrossProduct(nodeBegin, nodeEnd);
+
+#pragma omp simd
+		for (int i = 0; i < nNodes; i++) {
+			const Real dDotNorm = DotProduct(nodeNorm, pNodeTest[i]);
+
+			pSides[i] =
+				static_cast<int>(dDotNorm > - Tolerance)
+				+ static_cast<int>(dDotNorm >= Tolerance) - 1;
+		}
+
+	} else if (edgetype == Edge::Type_ConstantLatitude) {
+		const Real dAlignment = (nodeBegin.x * nodeEnd.y - nodeEnd.x * nodeBegin.y);
+		const Real dSign = dAlignment / fabs(dAlignment);
+		const Real dZ = nodeBegin.z;
+
+#pragma omp simd
+		for (int i = 0; i < nNodes; i++) {
+			const Real dDotNorm = dSign * (pNodeTest[i].z - dZ);
+
+			pSides[i] =
+				static_cast<int>(dDotNorm > - Tolerance)
+				+ static_cast<int>(dDotNorm >= Tolerance) - 1;
+		}
+
+	} else {
+		_EXCEPTION1("Invalid EdgeType (%i)", (int)(edgetype));
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void MeshUtilitiesFuzzy::ContainsNode(
 	const Face & face,
 	const NodeVector & nodevec,
@@ -175,6 +227,8 @@ bool MeshUtilitiesFuzzy::CalculateEdgeIntersectionsSemiClip(
 ) {
 	static const Real Tolerance = ReferenceTolerance;
 
+	OVERLAPMESH_STAT_COUNT(Counter_SemiClipIntersectionTests);
+
 	// Make a locally modifyable version of the Nodes
 	Node node11;
 	Node node12;
@@ -338,6 +392,8 @@ bool MeshUtilitiesFuzzy::CalculateEdgeIntersections(
 ) {
 	static const Real Tolerance = ReferenceTolerance;
 
+	OVERLAPMESH_STAT_COUNT(Counter_EdgeIntersectionTests);
+
 	// Make a locally modifyable version of the Nodes
 	Node node11;
 	Node node12;
@@ -1082,7 +1138,7 @@ int MeshUtilitiesFuzzy::FindFaceNearNode(
 	const Node & nodeBegin = mesh.nodes[ixNode];
 
 	// Get the set of faces adjacent this node
-	const std::set<int> & setNearbyFaces = mesh.revnodearray[ixNode];
+	const ReverseNodeArray::FaceRange setNearbyFaces = mesh.revnodearray[ixNode];
 
 	if (setNearbyFaces.size() < 3) {
 		_EXCEPTIONT("Insufficient Faces at Corner; at least three Faces expected");
@@ -1103,9 +1159,13 @@ int MeshUtilitiesFuzzy::FindFaceNearNode(
 		- ScalarProduct(dDotNeNb, nodeBegin);
 */
 	// Loop through all faces
-	std::set<int>::const_iterator iter = setNearbyFaces.begin();
+	OVERLAPMESH_STAT_WALK(walkNearNode, Histogram_FindFaceNearNodeWalkLength);
+
+	ReverseNodeArray::FaceRange::const_iterator iter = setNearbyFaces.begin();
 	for (; iter != setNearbyFaces.end(); iter++) {
 
+		OVERLAPMESH_STAT_STEP(walkNearNode);
+
 		const Face & face = mesh.faces[*iter];
 
 		int nEdges = face.edges.size();
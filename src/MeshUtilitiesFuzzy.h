@@ -62,6 +62,20 @@ public:
 		const Node & nodeTest
 	) const;
 
+	///	<summary>
+	///		Determine if each of a vector of nodes is to the right or left
+	///		of an edge, with the same result as FindNodeEdgeSide().  The
+	///		plane of the edge is computed once and nodes are classified
+	///		without branches so that the loop vectorizes.
+	///	</summary>
+	void FindNodeEdgeSides(
+		const Node & nodeBegin,
+		const Node & nodeEnd,
+		const Edge::Type edgetype,
+		const NodeVector & vecNodeTest,
+		std::vector<int> & vecSides
+	) const;
+
 	///	<summary>
 	///		Determine if face contains node, and whether
 	///		the Node is along an edge or at a corner.
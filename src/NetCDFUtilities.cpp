@@ -20,6 +20,7 @@
 #include "netcdfcpp.h"
 
 #include <vector>
+#include <algorithm>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -41,6 +42,27 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+NcFile::FileFormat GetNcFileFormatForSize(
+	NcFile::FileFormat eFileFormat,
+	size_t sLargestVarBytes,
+	size_t sTotalBytes
+) {
+	const size_t sClassicLimitBytes = static_cast<size_t>(1) << 31;
+	const size_t sOffset64LimitBytes = static_cast<size_t>(1) << 32;
+
+	if ((eFileFormat == NcFile::Classic) && (sTotalBytes >= sClassicLimitBytes)) {
+		eFileFormat = NcFile::Offset64Bits;
+	}
+	if ((eFileFormat == NcFile::Offset64Bits) &&
+	    (sLargestVarBytes >= sOffset64LimitBytes)
+	) {
+		eFileFormat = NcFile::Netcdf4;
+	}
+	return eFileFormat;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void CopyNcFileAttributes(
 	NcFile * fileIn,
 	NcFile * fileOut
@@ -420,4 +442,110 @@ void CopyNcVarIfExists(
 
 ////////////////////////////////////////////////////////////////////////////////
 
+////////////////////////////////////////////////////////////////////////////////
+
+static NcCompressionOptions s_optsNcCompression;
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SetNcCompressionOptions(
+	const NcCompressionOptions & opts
+) {
+	if ((opts.iDeflateLevel < 0) || (opts.iDeflateLevel > 9)) {
+		_EXCEPTION1("Invalid deflate level %i, expected [0,9]",
+			opts.iDeflateLevel);
+	}
+	s_optsNcCompression = opts;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+const NcCompressionOptions & GetNcCompressionOptions() {
+	return s_optsNcCompression;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SetNcVarChunking(
+	NcFile & ncFile,
+	NcVar * var,
+	const long * plChunkShape
+) {
+#if defined(NC_NETCDF4)
+	const NcCompressionOptions & opts = s_optsNcCompression;
+
+	if (var == NULL) {
+		_EXCEPTIONT("Invalid NcVar");
+	}
+	if ((opts.iDeflateLevel == 0) && (opts.sChunkBytes == 0) && (plChunkShape == NULL)) {
+		return;
+	}
+
+	NcFile::FileFormat eFormat = ncFile.get_format();
+	if ((eFormat != NcFile::Netcdf4) && (eFormat != NcFile::Netcdf4Classic)) {
+		return;
+	}
+
+	const int nDims = var->num_dims();
+	if (nDims == 0) {
+		return;
+	}
+
+	// Determine the chunk shape
+	std::vector<size_t> vecChunks(nDims);
+
+	if (plChunkShape != NULL) {
+		for (int d = 0; d < nDims; d++) {
+			vecChunks[d] = static_cast<size_t>(std::max(1L, plChunkShape[d]));
+		}
+
+	} else {
+		size_t sElementBytes = 8;
+		if ((var->type() == ncByte) || (var->type() == ncChar)) {
+			sElementBytes = 1;
+		} else if (var->type() == ncShort) {
+			sElementBytes = 2;
+		} else if ((var->type() == ncInt) || (var->type() == ncFloat)) {
+			sElementBytes = 4;
+		}
+
+		size_t sChunkBytes = opts.sChunkBytes;
+		if (sChunkBytes == 0) {
+			sChunkBytes = DefaultNcChunkBytes;
+		}
+
+		size_t sRemaining = std::max<size_t>(1, sChunkBytes / sElementBytes);
+		for (int d = nDims-1; d >= 0; d--) {
+			NcDim * dim = var->get_dim(d);
+			if (dim->is_unlimited()) {
+				vecChunks[d] = 1;
+				continue;
+			}
+			size_t sDimSize = std::max<size_t>(1, dim->size());
+			vecChunks[d] = std::min(sDimSize, sRemaining);
+			sRemaining = std::max<size_t>(1, sRemaining / vecChunks[d]);
+		}
+	}
+
+	int iStatus =
+		nc_def_var_chunking(ncFile.id(), var->id(), NC_CHUNKED, &(vecChunks[0]));
+	if (iStatus != NC_NOERR) {
+		_EXCEPTION2("Unable to set chunking of variable \"%s\": %s",
+			var->name(), nc_strerror(iStatus));
+	}
+
+	if (opts.iDeflateLevel > 0) {
+		iStatus =
+			nc_def_var_deflate(
+				ncFile.id(), var->id(),
+				(opts.fShuffle)?(1):(0), 1, opts.iDeflateLevel);
+		if (iStatus != NC_NOERR) {
+			_EXCEPTION2("Unable to set compression of variable \"%s\": %s",
+				var->name(), nc_strerror(iStatus));
+		}
+	}
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
 
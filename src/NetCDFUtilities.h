@@ -23,6 +23,7 @@ class NcVar;
 #include "netcdfcpp.h"
 
 #include <string>
+#include <cstddef>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -33,6 +34,19 @@ NcFile::FileFormat GetNcFileFormatFromString(
 	const std::string & strFormat
 );
 
+///	<summary>
+///		Get a file format that can store a file of about sTotalBytes whose
+///		largest variable has sLargestVarBytes.  Classic files are upgraded
+///		to 64-bit offset files beyond 2 GiB, and 64-bit offset files to
+///		NetCDF-4 files when a variable exceeds 4 GiB.  Other formats are
+///		returned unchanged.
+///	</summary>
+NcFile::FileFormat GetNcFileFormatForSize(
+	NcFile::FileFormat eFileFormat,
+	size_t sLargestVarBytes,
+	size_t sTotalBytes
+);
+
 ////////////////////////////////////////////////////////////////////////////////
 
 ///	<summary>
@@ -79,5 +93,75 @@ void CopyNcVarIfExists(
 
 ////////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		Chunking and compression settings for variables written to NetCDF-4
+///		files.  Variables of other file formats are unaffected.
+///	</summary>
+struct NcCompressionOptions {
+
+	///	<summary>
+	///		Default constructor; leaves the library default layout.
+	///	</summary>
+	NcCompressionOptions() :
+		iDeflateLevel(0),
+		fShuffle(true),
+		sChunkBytes(0)
+	{ }
+
+	///	<summary>
+	///		Deflate level (0 to disable, 1 to 9).
+	///	</summary>
+	int iDeflateLevel;
+
+	///	<summary>
+	///		Apply the shuffle filter before deflating.
+	///	</summary>
+	bool fShuffle;
+
+	///	<summary>
+	///		Target size of a chunk in bytes for automatic chunking, or 0 to
+	///		use DefaultNcChunkBytes when deflating and the library default
+	///		layout otherwise.
+	///	</summary>
+	size_t sChunkBytes;
+};
+
+///	<summary>
+///		Target chunk size used when deflating without a chunk size.
+///	</summary>
+static const size_t DefaultNcChunkBytes = 1048576;
+
+////////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Set the chunking and compression settings used by
+///		SetNcVarChunking().
+///	</summary>
+void SetNcCompressionOptions(
+	const NcCompressionOptions & opts
+);
+
+///	<summary>
+///		Get the chunking and compression settings used by
+///		SetNcVarChunking().
+///	</summary>
+const NcCompressionOptions & GetNcCompressionOptions();
+
+///	<summary>
+///		Apply the current chunking and compression settings to a variable
+///		that has just been added to a NetCDF-4 file, before any data is
+///		written to it.  If plChunkShape is NULL the chunk shape is chosen
+///		automatically: the slowest varying dimension is split so that each
+///		chunk holds about the target number of bytes, keeping the faster
+///		varying dimensions (such as nodes per element) whole.
+///	</summary>
+void SetNcVarChunking(
+	NcFile & ncFile,
+	NcVar * var,
+	const long * plChunkShape = NULL
+);
+
+////////////////////////////////////////////////////////////////////////////////
+
 #endif
 
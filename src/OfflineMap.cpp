@@ -26,8 +26,24 @@
 #include "Exception.h"
 #include "DataArray1D.h"
 #include "DataArray2D.h"
+#include "SparseMatrixDevice.h"
+#include "PerformanceOptions.h"
 
 #include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <climits>
+#include <algorithm>
+#include <vector>
+#include <stdint.h>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+#if defined(TEMPEST_MPIOMP)
+#include <mpi.h>
+#endif
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -140,6 +156,27 @@ void ParseEnforceBounds(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+BinaryMapWeights ParseBinaryMapWeights(
+	const std::string & strBinaryMapWeights
+) {
+	std::string strWeights = strBinaryMapWeights;
+	STLStringHelper::ToLower(strWeights);
+
+	if (strWeights == "double") {
+		return BinaryMapWeights_Double;
+	}
+	if (strWeights == "single") {
+		return BinaryMapWeights_Single;
+	}
+	if (strWeights == "q16") {
+		return BinaryMapWeights_Quantized16;
+	}
+	_EXCEPTION1("Invalid weight format \"%s\", expected [double|single|q16]",
+		strBinaryMapWeights.c_str());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void OfflineMap::InitializeDimensionsFromMeshFile(
 	const std::string & strMeshFile,
 	std::vector<std::string> & vecDimNames,
@@ -476,7 +513,38 @@ void OfflineMap::InitializeCoordinatesFromMeshFV(
 	dCenterLon.Allocate(nFaces);
 	dCenterLat.Allocate(nFaces);
 
-	// Store coordinates of each Node and Face centerpoint
+	// Convert all Nodes to latitude and longitude in one batch
+	const int nMeshNodes = mesh.nodes.size();
+
+	DataArray1D<double> dNodeLon(nMeshNodes);
+	DataArray1D<double> dNodeLat(nMeshNodes);
+
+	if (nMeshNodes != 0) {
+		NodeCoordinateArrays coords(mesh.nodes);
+
+		int nInvalid = XYZtoRLL_Deg_Batch(
+			nMeshNodes,
+			coords.X(), coords.Y(), coords.Z(),
+			&(dNodeLon[0]), &(dNodeLat[0]));
+
+		if (nInvalid != 0) {
+			_EXCEPTION1("Mesh contains %i nodes with non-unit magnitude",
+				nInvalid);
+		}
+	}
+
+	// Face centerpoints in Cartesian coordinates
+	DataArray1D<double> dCenterX(nFaces);
+	DataArray1D<double> dCenterY(nFaces);
+	DataArray1D<double> dCenterZ(nFaces);
+
+	// Gather vertex coordinates, compute centerpoints and modify vertex
+	// coordinates of polar volumes in a single pass over the faces
+	const int nNodesMod = dVertexLat.GetColumns();
+
+	int nPolarFailures = 0;
+
+#pragma omp parallel for schedule(static) reduction(+:nPolarFailures)
 	for (int i = 0; i < nFaces; i++) {
 
 		const Face & face = mesh.faces[i];
@@ -490,18 +558,12 @@ void OfflineMap::InitializeCoordinatesFromMeshFV(
 		for (int j = 0; j < nNodes; j++) {
 			const Node & node = mesh.nodes[face[j]];
 
-			double dX = node.x;
-			double dY = node.y;
-			double dZ = node.z;
-
-			dXc += dX;
-			dYc += dY;
-			dZc += dZ;
+			dXc += node.x;
+			dYc += node.y;
+			dZc += node.z;
 
-			XYZtoRLL_Deg(
-				dX, dY, dZ,
-				dVertexLon[i][j],
-				dVertexLat[i][j]);
+			dVertexLon[i][j] = dNodeLon[face[j]];
+			dVertexLat[i][j] = dNodeLat[face[j]];
 		}
 
 		if ((fLatLon) && (nNodes == 3)) {
@@ -515,22 +577,12 @@ void OfflineMap::InitializeCoordinatesFromMeshFV(
 
 		double dMag = sqrt(dXc * dXc + dYc * dYc + dZc * dZc);
 
-		dXc /= dMag;
-		dYc /= dMag;
-		dZc /= dMag;
+		dCenterX[i] = dXc / dMag;
+		dCenterY[i] = dYc / dMag;
+		dCenterZ[i] = dZc / dMag;
 
-		XYZtoRLL_Deg(
-			dXc,
-			dYc,
-			dZc,
-			dCenterLon[i],
-			dCenterLat[i]);
-
-		// Modify vertex coordinates of polar volumes on latlon grid
+		// Change longitudes of polar volumes on latlon grid
 		if (fLatLon) {
-
-			// Change longitudes of polar volumes
-			int nNodesMod = dVertexLat.GetColumns();
 			for (int j = 0; j < nNodesMod; j++) {
 				if (fabs(fabs(dVertexLat[i][j]) - 90.0) < 1.0e-12) {
 					int jn = (j + 1) % nNodesMod;
@@ -541,12 +593,29 @@ void OfflineMap::InitializeCoordinatesFromMeshFV(
 					} else if (fabs(fabs(dVertexLat[i][jp]) - 90.0) > 1.0e-12) {
 						dVertexLon[i][j] = dVertexLon[i][jp];
 					} else {
-						_EXCEPTIONT("Logic error");
+						nPolarFailures++;
 					}
 				}
 			}
 		}
 	}
+
+	if (nPolarFailures != 0) {
+		_EXCEPTIONT("Logic error");
+	}
+
+	// Convert centerpoints to latitude and longitude in one batch
+	if (nFaces != 0) {
+		int nInvalid = XYZtoRLL_Deg_Batch(
+			nFaces,
+			&(dCenterX[0]), &(dCenterY[0]), &(dCenterZ[0]),
+			&(dCenterLon[0]), &(dCenterLat[0]));
+
+		if (nInvalid != 0) {
+			_EXCEPTION1("Mesh contains %i faces with degenerate centerpoints",
+				nInvalid);
+		}
+	}
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -587,9 +656,22 @@ void OfflineMap::InitializeCoordinatesFromMeshFE(
 	DataArray1D<double> dG;
 	GetDefaultNodalLocations(nP, dG);
 
-	for (int i = 0; i < dataGLLnodes.GetRows(); i++) {
-	for (int j = 0; j < dataGLLnodes.GetColumns(); j++) {
-	for (int k = 0; k < dataGLLnodes.GetSubColumns(); k++) {
+	// Evaluate the location of every GLL point in Cartesian coordinates
+	const int nRows = dataGLLnodes.GetRows();
+	const int nCols = dataGLLnodes.GetColumns();
+	const int nSubCols = dataGLLnodes.GetSubColumns();
+	const int nPoints = nRows * nCols * nSubCols;
+
+	DataArray1D<double> dPointX(nPoints);
+	DataArray1D<double> dPointY(nPoints);
+	DataArray1D<double> dPointZ(nPoints);
+
+#pragma omp parallel for schedule(static)
+	for (int ix = 0; ix < nPoints; ix++) {
+		const int i = ix / (nCols * nSubCols);
+		const int j = (ix / nSubCols) % nCols;
+		const int k = ix % nSubCols;
+
 		const Face & face = mesh.faces[k];
 
 		Node node;
@@ -601,14 +683,37 @@ void OfflineMap::InitializeCoordinatesFromMeshFE(
 			dG[i],
 			node);
 
+		dPointX[ix] = node.x;
+		dPointY[ix] = node.y;
+		dPointZ[ix] = node.z;
+	}
+
+	// Convert to latitude and longitude in one batch
+	DataArray1D<double> dPointLon(nPoints);
+	DataArray1D<double> dPointLat(nPoints);
+
+	if (nPoints != 0) {
+		int nInvalid = XYZtoRLL_Deg_Batch(
+			nPoints,
+			&(dPointX[0]), &(dPointY[0]), &(dPointZ[0]),
+			&(dPointLon[0]), &(dPointLat[0]));
+
+		if (nInvalid != 0) {
+			_EXCEPTION1("Mesh contains %i GLL nodes with non-unit magnitude",
+				nInvalid);
+		}
+	}
+
+	// Scatter to the global GLL node index
+	for (int i = 0; i < nRows; i++) {
+	for (int j = 0; j < nCols; j++) {
+	for (int k = 0; k < nSubCols; k++) {
+		const int ix = (i * nCols + j) * nSubCols + k;
+
 		int iNode = dataGLLnodes[i][j][k] - 1;
 
-		XYZtoRLL_Deg(
-			node.x,
-			node.y,
-			node.z,
-			dCenterLon[iNode],
-			dCenterLat[iNode]);
+		dCenterLon[iNode] = dPointLon[ix];
+		dCenterLat[iNode] = dPointLat[ix];
 	}
 	}
 	}
@@ -825,6 +930,12 @@ void OfflineMap::InitializeSourceCoordinatesFromMeshFV(
 		fLatLon = true;
 	}
 
+	// Defer computation of the arrays until they are needed
+	if (!fLatLon) {
+		m_pmeshSourceCoordinates = &meshSource;
+		return;
+	}
+
 	InitializeCoordinatesFromMeshFV(
 		meshSource,
 		m_dSourceCenterLon,
@@ -906,6 +1017,12 @@ void OfflineMap::InitializeTargetCoordinatesFromMeshFV(
 		fLatLon = true;
 	}
 
+	// Defer computation of the arrays until they are needed
+	if (!fLatLon) {
+		m_pmeshTargetCoordinates = &meshTarget;
+		return;
+	}
+
 	InitializeCoordinatesFromMeshFV(
 		meshTarget,
 		m_dTargetCenterLon,
@@ -987,6 +1104,162 @@ void OfflineMap::InitializeTargetCoordinatesFromMeshFV(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void OfflineMap::ResolveCoordinates() {
+	if (m_pmeshSourceCoordinates != NULL) {
+		const Mesh * pmeshSource = m_pmeshSourceCoordinates;
+		m_pmeshSourceCoordinates = NULL;
+
+		InitializeCoordinatesFromMeshFV(
+			*pmeshSource,
+			m_dSourceCenterLon,
+			m_dSourceCenterLat,
+			m_dSourceVertexLon,
+			m_dSourceVertexLat,
+			false);
+	}
+
+	if (m_pmeshTargetCoordinates != NULL) {
+		const Mesh * pmeshTarget = m_pmeshTargetCoordinates;
+		m_pmeshTargetCoordinates = NULL;
+
+		InitializeCoordinatesFromMeshFV(
+			*pmeshTarget,
+			m_dTargetCenterLon,
+			m_dTargetCenterLat,
+			m_dTargetVertexLon,
+			m_dTargetVertexLat,
+			false);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OfflineMap::WriteCoordinatesFromMeshFV(
+	const Mesh & mesh,
+	int nNodesPerFace,
+	NcVar * varCenterLon,
+	NcVar * varCenterLat,
+	NcVar * varVertexLon,
+	NcVar * varVertexLat
+) {
+	// Number of Faces computed and written at a time
+	const int nChunkFaces = 65536;
+
+	const int nFaces = mesh.faces.size();
+
+	// Convert all Nodes to latitude and longitude in one batch
+	const int nMeshNodes = mesh.nodes.size();
+
+	DataArray1D<double> dNodeLon(nMeshNodes);
+	DataArray1D<double> dNodeLat(nMeshNodes);
+
+	if (nMeshNodes != 0) {
+		NodeCoordinateArrays coords(mesh.nodes);
+
+		int nInvalid = XYZtoRLL_Deg_Batch(
+			nMeshNodes,
+			coords.X(), coords.Y(), coords.Z(),
+			&(dNodeLon[0]), &(dNodeLat[0]));
+
+		if (nInvalid != 0) {
+			_EXCEPTION1("Mesh contains %i nodes with non-unit magnitude",
+				nInvalid);
+		}
+	}
+
+	// Buffers for one chunk of Faces
+	const int nBufferFaces = std::min(nChunkFaces, nFaces);
+
+	const bool fVertices = (varVertexLon != NULL) && (varVertexLat != NULL);
+
+	DataArray1D<double> dCenterX(nBufferFaces);
+	DataArray1D<double> dCenterY(nBufferFaces);
+	DataArray1D<double> dCenterZ(nBufferFaces);
+
+	DataArray1D<double> dCenterLon(nBufferFaces);
+	DataArray1D<double> dCenterLat(nBufferFaces);
+
+	DataArray2D<double> dVertexLon;
+	DataArray2D<double> dVertexLat;
+
+	if (fVertices) {
+		dVertexLon.Allocate(nBufferFaces, nNodesPerFace);
+		dVertexLat.Allocate(nBufferFaces, nNodesPerFace);
+	}
+
+	for (int iBegin = 0; iBegin < nFaces; iBegin += nChunkFaces) {
+
+		const int nCount = std::min(nChunkFaces, nFaces - iBegin);
+
+#pragma omp parallel for schedule(static)
+		for (int i = 0; i < nCount; i++) {
+
+			const Face & face = mesh.faces[iBegin + i];
+
+			int nNodes = face.edges.size();
+
+			double dXc = 0.0;
+			double dYc = 0.0;
+			double dZc = 0.0;
+
+			for (int j = 0; j < nNodes; j++) {
+				const Node & node = mesh.nodes[face[j]];
+
+				dXc += node.x;
+				dYc += node.y;
+				dZc += node.z;
+			}
+
+			if (fVertices) {
+				for (int j = 0; j < nNodes; j++) {
+					dVertexLon[i][j] = dNodeLon[face[j]];
+					dVertexLat[i][j] = dNodeLat[face[j]];
+				}
+				for (int j = nNodes; j < nNodesPerFace; j++) {
+					dVertexLon[i][j] = 0.0;
+					dVertexLat[i][j] = 0.0;
+				}
+			}
+
+			dXc /= static_cast<double>(nNodes);
+			dYc /= static_cast<double>(nNodes);
+			dZc /= static_cast<double>(nNodes);
+
+			double dMag = sqrt(dXc * dXc + dYc * dYc + dZc * dZc);
+
+			dCenterX[i] = dXc / dMag;
+			dCenterY[i] = dYc / dMag;
+			dCenterZ[i] = dZc / dMag;
+		}
+
+		int nInvalid = XYZtoRLL_Deg_Batch(
+			nCount,
+			&(dCenterX[0]), &(dCenterY[0]), &(dCenterZ[0]),
+			&(dCenterLon[0]), &(dCenterLat[0]));
+
+		if (nInvalid != 0) {
+			_EXCEPTION1("Mesh contains %i faces with degenerate centerpoints",
+				nInvalid);
+		}
+
+		varCenterLon->set_cur(iBegin);
+		varCenterLon->put(&(dCenterLon[0]), nCount);
+
+		varCenterLat->set_cur(iBegin);
+		varCenterLat->put(&(dCenterLat[0]), nCount);
+
+		if (fVertices) {
+			varVertexLon->set_cur(iBegin, 0);
+			varVertexLon->put(&(dVertexLon[0][0]), nCount, nNodesPerFace);
+
+			varVertexLat->set_cur(iBegin, 0);
+			varVertexLat->put(&(dVertexLat[0][0]), nCount, nNodesPerFace);
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void OfflineMap::InitializeSourceCoordinatesFromMeshFE(
 	const Mesh & meshSource,
 	int nP,
@@ -1165,1357 +1438,4144 @@ void OfflineMap::PreserveAllVariables(
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void OfflineMap::Apply(
-	const std::string & strSourceDataFile,
-	const std::string & strTargetDataFile,
-	const std::vector<std::string> & vecVariables,
-	const std::string & strNColName,
-	bool fTargetDouble,
-	bool fAppend
+///	<summary>
+///		Calculate the total mass and the extreme values of a field.
+///	</summary>
+template <typename T>
+static void CalculateMassMinMax(
+	const DataArray1D<T> & data,
+	const DataArray1D<double> & dAreas,
+	int nCount,
+	double & dMass,
+	double & dMin,
+	double & dMax
 ) {
-
-	// Check variable list for "lat" and "lon"
-	for (int v = 0; v < vecVariables.size(); v++) {
-		if (vecVariables[v] == "lat") {
-			_EXCEPTIONT("Latitude variable \"lat\" in variable list will be overwritten on output");
+	dMass = 0.0;
+	dMin = static_cast<double>(data[0]);
+	dMax = static_cast<double>(data[0]);
+	for (int i = 0; i < nCount; i++) {
+		const double dValue = static_cast<double>(data[i]);
+		dMass += dValue * dAreas[i];
+		if (dValue < dMin) {
+			dMin = dValue;
 		}
-		if (vecVariables[v] == "lon") {
-			_EXCEPTIONT("Longitude variable \"lon\" in variable list will be overwritten on output");
+		if (dValue > dMax) {
+			dMax = dValue;
 		}
 	}
+}
 
-	// Open source data file
-	NcFile ncSource(strSourceDataFile.c_str(), NcFile::ReadOnly);
-	if (!ncSource.is_valid()) {
-		_EXCEPTION1("Cannot open source data file \"%s\"",
-			strSourceDataFile.c_str());
-	}
+///////////////////////////////////////////////////////////////////////////////
 
-	// Open target data file
-	NcFile::FileMode eOpenMode = NcFile::Replace;
-	if (fAppend) {
-		eOpenMode = NcFile::Write;
+///	<summary>
+///		Calculate the mass and extreme values of a slice, excluding entries
+///		equal to the given fill value.
+///	</summary>
+template <typename T>
+static void CalculateMassMinMaxExcluding(
+	const DataArray1D<T> & data,
+	const DataArray1D<double> & dAreas,
+	int nCount,
+	T valueExclude,
+	double & dMass,
+	double & dMin,
+	double & dMax
+) {
+	dMass = 0.0;
+	dMin = DBL_MAX;
+	dMax = -DBL_MAX;
+	for (int i = 0; i < nCount; i++) {
+		if (data[i] == valueExclude) {
+			continue;
+		}
+		const double dValue = static_cast<double>(data[i]);
+		dMass += dValue * dAreas[i];
+		if (dValue < dMin) {
+			dMin = dValue;
+		}
+		if (dValue > dMax) {
+			dMax = dValue;
+		}
 	}
-
-	NcFile ncTarget(strTargetDataFile.c_str(), eOpenMode);
-	if (!ncTarget.is_valid()) {
-		_EXCEPTION1("Cannot open target data file \"%s\"",
-			strTargetDataFile.c_str());
+	if (dMin > dMax) {
+		dMin = 0.0;
+		dMax = 0.0;
 	}
+}
 
-	// Number of source and target regions
-	int nSourceCount = m_dSourceAreas.GetRows();
-	int nTargetCount = m_dTargetAreas.GetRows();
-
-	// Check for rectilinear data
-	bool fSourceRectilinear;
-	if (m_vecSourceDimSizes.size() == 1) {
-		fSourceRectilinear = false;
-	} else if (m_vecSourceDimSizes.size() == 2) {
-		fSourceRectilinear = true;
-	} else {
-		_EXCEPTIONT("m_vecSourceDimSizes undefined");
-	}
+///////////////////////////////////////////////////////////////////////////////
 
-	if (fSourceRectilinear) {
-		if (nSourceCount != m_vecSourceDimSizes[0] * m_vecSourceDimSizes[1]) {
-			_EXCEPTIONT("Rectilinear input expected in finite volume form");
+///	<summary>
+///		A block of slices of a variable that is remapped in one pass by
+///		OfflineMap::Apply().
+///	</summary>
+class OfflineMapApplyBlock {
+
+public:
+	///	<summary>
+	///		Allocate the block.
+	///	</summary>
+	void Allocate(
+		bool fSinglePrecision,
+		int nSourceCount,
+		int nTargetCount,
+		int nBlockSize
+	) {
+		if (fSinglePrecision) {
+			dataInFloat.Allocate(nSourceCount, nBlockSize);
+			dataOutFloat.Allocate(nTargetCount, nBlockSize);
+		} else {
+			dataIn.Allocate(nSourceCount, nBlockSize);
+			dataOut.Allocate(nTargetCount, nBlockSize);
 		}
-	}
-
-	bool fTargetRectilinear;
-	if (m_vecTargetDimSizes.size() == 1) {
-		fTargetRectilinear = false;
-	} else if (m_vecTargetDimSizes.size() == 2) {
-		fTargetRectilinear = true;
-	} else {
-		_EXCEPTIONT("m_vecTargetDimSizes undefined");
-	}
 
-	if (fTargetRectilinear) {
-		if (nTargetCount != m_vecTargetDimSizes[0] * m_vecTargetDimSizes[1]) {
-			printf("%i %i\n", nTargetCount,
-				m_vecTargetDimSizes[0] * m_vecTargetDimSizes[1]);
+		dSourceMass.Allocate(nBlockSize);
+		dSourceMin.Allocate(nBlockSize);
+		dSourceMax.Allocate(nBlockSize);
+
+		iSliceMatches.Allocate(nBlockSize);
+		dataValid.Allocate(0, 0);
+
+		tBegin = 0;
+		nBlock = 0;
+	}
+
+#if defined(TEMPEST_MPIOMP)
+	///	<summary>
+	///		Send the source statistics and target data of the block to
+	///		another rank.
+	///	</summary>
+	void SendTargetData(
+		bool fSinglePrecision,
+		int iRank
+	) const {
+		int nStats = dSourceMass.GetRows();
+		std::vector<double> vecStats(3 * nStats);
+		for (int b = 0; b < nStats; b++) {
+			vecStats[3*b  ] = dSourceMass[b];
+			vecStats[3*b+1] = dSourceMin[b];
+			vecStats[3*b+2] = dSourceMax[b];
+		}
+		MPI_Send(&(vecStats[0]), 3 * nStats, MPI_DOUBLE, iRank, 0, MPI_COMM_WORLD);
 
-			_EXCEPTIONT("Rectilinear output expected in finite volume form");
+		if (fSinglePrecision) {
+			MPI_Send(
+				const_cast<float *>(&(dataOutFloat[0][0])),
+				static_cast<int>(dataOutFloat.GetTotalSize()),
+				MPI_FLOAT, iRank, 1, MPI_COMM_WORLD);
+		} else {
+			MPI_Send(
+				const_cast<double *>(&(dataOut[0][0])),
+				static_cast<int>(dataOut.GetTotalSize()),
+				MPI_DOUBLE, iRank, 1, MPI_COMM_WORLD);
 		}
 	}
 
-	DataArray1D<float> dataIn;
-	if (m_vecSourceDimSizes.size() == 1) {
-		dataIn.Allocate(nSourceCount);
-	} else {
-		dataIn.Allocate(m_vecSourceDimSizes[0] * m_vecSourceDimSizes[1]);
-	}
+	///	<summary>
+	///		Receive the source statistics and target data of the block from
+	///		another rank.
+	///	</summary>
+	void RecvTargetData(
+		bool fSinglePrecision,
+		int iRank
+	) {
+		int nStats = dSourceMass.GetRows();
+		std::vector<double> vecStats(3 * nStats);
+		MPI_Recv(&(vecStats[0]), 3 * nStats, MPI_DOUBLE, iRank, 0,
+			MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+		for (int b = 0; b < nStats; b++) {
+			dSourceMass[b] = vecStats[3*b  ];
+			dSourceMin[b]  = vecStats[3*b+1];
+			dSourceMax[b]  = vecStats[3*b+2];
+		}
 
-	DataArray1D<float> dataOut;
-	if (m_vecTargetDimSizes.size() == 1) {
-		dataOut.Allocate(nTargetCount);
-	} else {
-		dataOut.Allocate(m_vecTargetDimSizes[0] * m_vecTargetDimSizes[1]);
+		if (fSinglePrecision) {
+			MPI_Recv(
+				&(dataOutFloat[0][0]),
+				static_cast<int>(dataOutFloat.GetTotalSize()),
+				MPI_FLOAT, iRank, 1, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+		} else {
+			MPI_Recv(
+				&(dataOut[0][0]),
+				static_cast<int>(dataOut.GetTotalSize()),
+				MPI_DOUBLE, iRank, 1, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+		}
 	}
+#endif
+
+public:
+	///	<summary>
+	///		Index of the first slice in the block.
+	///	</summary>
+	int tBegin;
+
+	///	<summary>
+	///		Number of slices in the block.
+	///	</summary>
+	int nBlock;
+
+	///	<summary>
+	///		Source and target data (double precision).
+	///	</summary>
+	DataArray2D<double> dataIn;
+	DataArray2D<double> dataOut;
+
+	///	<summary>
+	///		Source and target data (single precision).
+	///	</summary>
+	DataArray2D<float> dataInFloat;
+	DataArray2D<float> dataOutFloat;
+
+	///	<summary>
+	///		Mass and extreme values of each source slice.
+	///	</summary>
+	DataArray1D<double> dSourceMass;
+	DataArray1D<double> dSourceMin;
+	DataArray1D<double> dSourceMax;
+
+	///	<summary>
+	///		When renormalizing for missing values, flags indicating slices
+	///		whose missing values match the reference pattern of the variable.
+	///	</summary>
+	DataArray1D<int> iSliceMatches;
+
+	///	<summary>
+	///		Validity (0 or 1) of the source values of slices which do not
+	///		match the reference pattern, allocated on demand.
+	///	</summary>
+	DataArray2D<double> dataValid;
+};
+
+///	<summary>
+///		The part of each source slice referenced by a map, which is read by
+///		OfflineMap::Apply() as a set of hyperslabs.  Source columns inside
+///		the hyperslabs are numbered consecutively and the map is applied
+///		with its column indices compacted to this numbering.
+///	</summary>
+class OfflineMapSourceSupport {
+
+public:
+	///	<summary>
+	///		A hyperslab over the horizontal source dimensions.
+	///	</summary>
+	struct Hyperslab {
+		long lBegin[2];
+		long lCount[2];
+		int ixCompact;
+	};
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	OfflineMapSourceSupport() :
+		m_fPartial(false),
+		m_nCompactCount(0)
+	{ }
+
+	///	<summary>
+	///		Determine the support of a finalized map.  Partial reads are only
+	///		enabled if the hyperslabs cover at most
+	///		OfflineMapApplyPartialReadMaximumFraction of the slice.
+	///	</summary>
+	void Initialize(
+		const SparseMatrix<double> & smatRemap,
+		const std::vector<int> & vecSourceDimSizes,
+		const DataArray1D<double> & dSourceAreas
+	) {
+		const int nSourceCount = dSourceAreas.GetRows();
+		const size_t sNonZeros = smatRemap.GetNonZeroCount();
 
-	DataArray1D<double> dataInDouble(nSourceCount);
-	DataArray1D<double> dataOutDouble(nTargetCount);
+		m_fPartial = false;
+		m_vecHyperslabs.clear();
 
-	// Target
-	if (!fAppend) {
-		CopyNcFileAttributes(&ncSource, &ncTarget);
-	}
+		if ((sNonZeros == 0) || (nSourceCount == 0)) {
+			return;
+		}
 
-	NcDim * dim0;
-	NcDim * dim1;
+		const DataArray1D<int> & dataCols = smatRemap.GetCSRColumns();
 
-	if (!fTargetRectilinear) {
-		dim0 = NcFile_GetDimIfExists(
-			ncTarget,
-			strNColName.c_str(),
-			nTargetCount);
+		std::vector<char> vecUsed(nSourceCount, 0);
+		for (size_t j = 0; j < sNonZeros; j++) {
+			vecUsed[dataCols[j]] = 1;
+		}
 
-	} else {
-		dim0 = NcFile_GetDimIfExists(
-			ncTarget,
-			m_vecTargetDimNames[0].c_str(),
-			m_vecTargetDimSizes[0]);
+		// Full index of each compact column
+		std::vector<int> vecFullIndex;
 
-		dim1 = NcFile_GetDimIfExists(
-			ncTarget,
-			m_vecTargetDimNames[1].c_str(),
-			m_vecTargetDimSizes[1]);
-	}
+		// Rectilinear source data is read as a single bounding box
+		if (vecSourceDimSizes.size() == 2) {
+			const int nDim1 = vecSourceDimSizes[1];
 
-	// Generate variable list
-	std::vector<std::string> vecVariableList = vecVariables;
+			int iBegin[2] = {vecSourceDimSizes[0], nDim1};
+			int iEnd[2] = {-1, -1};
+			for (int i = 0; i < nSourceCount; i++) {
+				if (vecUsed[i]) {
+					iBegin[0] = std::min(iBegin[0], i / nDim1);
+					iBegin[1] = std::min(iBegin[1], i % nDim1);
+					iEnd[0] = std::max(iEnd[0], i / nDim1);
+					iEnd[1] = std::max(iEnd[1], i % nDim1);
+				}
+			}
 
-	if (vecVariables.size() == 0) {
-		for (int v = 0; v < ncSource.num_vars(); v++) {
-			NcVar * var = ncSource.get_var(v);
+			Hyperslab slab;
+			slab.lBegin[0] = iBegin[0];
+			slab.lBegin[1] = iBegin[1];
+			slab.lCount[0] = iEnd[0] - iBegin[0] + 1;
+			slab.lCount[1] = iEnd[1] - iBegin[1] + 1;
+			slab.ixCompact = 0;
+			m_vecHyperslabs.push_back(slab);
+
+			for (int i0 = iBegin[0]; i0 <= iEnd[0]; i0++) {
+			for (int i1 = iBegin[1]; i1 <= iEnd[1]; i1++) {
+				vecFullIndex.push_back(i0 * nDim1 + i1);
+			}
+			}
 
-			if (fSourceRectilinear) {
-				if (var->num_dims() < 2) {
+		// Unstructured source data is read in runs of columns
+		} else {
+			int i = 0;
+			while (i < nSourceCount) {
+				if (!vecUsed[i]) {
+					i++;
 					continue;
+				}
 
-				} else {
-					NcDim * dimA = var->get_dim(var->num_dims()-2);
-					NcDim * dimB = var->get_dim(var->num_dims()-1);
-
-					if (dimA->size() != m_vecSourceDimSizes[0]) {
-						continue;
-					}
-					if (dimB->size() != m_vecSourceDimSizes[1]) {
-						continue;
+				int iRunEnd = i + 1;
+				for (int k = i + 1; k < nSourceCount; k++) {
+					if (vecUsed[k]) {
+						iRunEnd = k + 1;
+					} else if (k - iRunEnd >= OfflineMapApplyPartialReadGap) {
+						break;
 					}
 				}
 
-			} else {
-				if (var->num_dims() < 1) {
-					continue;
+				Hyperslab slab;
+				slab.lBegin[0] = i;
+				slab.lBegin[1] = 0;
+				slab.lCount[0] = iRunEnd - i;
+				slab.lCount[1] = 1;
+				slab.ixCompact = static_cast<int>(vecFullIndex.size());
+				m_vecHyperslabs.push_back(slab);
 
-				} else {
-					NcDim * dim = var->get_dim(var->num_dims()-1);
+				for (int k = i; k < iRunEnd; k++) {
+					vecFullIndex.push_back(k);
+				}
 
-					if (dim->size() != nSourceCount) {
-						continue;
-					}
+				i = iRunEnd;
+			}
+		}
 
-					bool fDimensionName = false;
-					for (int d = 0; d < m_vecTargetDimNames.size(); d++) {
-						const char * szDimName = m_vecTargetDimNames[d].c_str();
-						if (strcmp(var->name(), szDimName) == 0) {
-							fDimensionName = true;
-							break;
-						}
-					}
-					if (fDimensionName) {
-						continue;
-					}
-				}
-			}
+		m_nCompactCount = static_cast<int>(vecFullIndex.size());
 
-			vecVariableList.push_back(var->name());
+		if (static_cast<double>(m_nCompactCount) >
+		    OfflineMapApplyPartialReadMaximumFraction
+		        * static_cast<double>(nSourceCount)
+		) {
+			m_vecHyperslabs.clear();
+			return;
+		}
+
+		// Compact column indices and source areas
+		std::vector<int> vecCompactIndex(nSourceCount, -1);
+		m_dCompactAreas.Allocate(m_nCompactCount);
+		for (int k = 0; k < m_nCompactCount; k++) {
+			vecCompactIndex[vecFullIndex[k]] = k;
+			m_dCompactAreas[k] = dSourceAreas[vecFullIndex[k]];
+		}
+
+		m_dataCompactCols.Allocate(sNonZeros);
+		for (size_t j = 0; j < sNonZeros; j++) {
+			m_dataCompactCols[j] = vecCompactIndex[dataCols[j]];
 		}
+
+		m_smatCompact.AttachCSR(
+			smatRemap.GetRows(),
+			m_nCompactCount,
+			sNonZeros,
+			&(smatRemap.GetCSRRowPointers()[0]),
+			&(m_dataCompactCols[0]),
+			&(smatRemap.GetCSRValues()[0]));
+
+		m_fPartial = true;
 	}
 
-	// Add lat/lon vector dimensions
-	if ((m_dVectorTargetCenterLon.GetRows() != 0) &&
-		(m_dVectorTargetCenterLat.GetRows() != 0)
+	///	<summary>
+	///		Check if only part of each slice is read.
+	///	</summary>
+	bool IsPartial() const {
+		return m_fPartial;
+	}
+
+	///	<summary>
+	///		Number of source columns read from each slice.
+	///	</summary>
+	int GetCompactCount() const {
+		return m_nCompactCount;
+	}
+
+	///	<summary>
+	///		Hyperslabs read from each slice.
+	///	</summary>
+	const std::vector<Hyperslab> & GetHyperslabs() const {
+		return m_vecHyperslabs;
+	}
+
+	///	<summary>
+	///		Source areas of the columns read.
+	///	</summary>
+	const DataArray1D<double> & GetCompactAreas() const {
+		return m_dCompactAreas;
+	}
+
+	///	<summary>
+	///		The map with compacted column indices.  The row pointers and
+	///		values are shared with the original map.
+	///	</summary>
+	const SparseMatrix<double> & GetCompactMatrix() const {
+		return m_smatCompact;
+	}
+
+protected:
+	///	<summary>
+	///		Flag indicating only part of each slice is read.
+	///	</summary>
+	bool m_fPartial;
+
+	///	<summary>
+	///		Number of source columns read from each slice.
+	///	</summary>
+	int m_nCompactCount;
+
+	///	<summary>
+	///		Hyperslabs read from each slice.
+	///	</summary>
+	std::vector<Hyperslab> m_vecHyperslabs;
+
+	///	<summary>
+	///		Source areas of the columns read.
+	///	</summary>
+	DataArray1D<double> m_dCompactAreas;
+
+	///	<summary>
+	///		Compacted column indices and the map using them.
+	///	</summary>
+	DataArray1D<int> m_dataCompactCols;
+	SparseMatrix<double> m_smatCompact;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Per-variable state used by OfflineMap::Apply() to read and write
+///		blocks of slices.
+///	</summary>
+class OfflineMapApplyVariable {
+
+public:
+	///	<summary>
+	///		Read the source columns of the current slice, given by
+	///		nCountsIn, into a buffer.
+	///	</summary>
+	template <typename T>
+	void GetSlice(
+		T * pData
 	) {
-		NcDim * dimLon;
-		if (m_vecTargetDimNames[0] == "lon") {
-			dimLon = dim0;
-		}
-		if (m_vecTargetDimNames[1] == "lon") {
-			dimLon = dim1;
+		if (psupport == NULL) {
+			var->set_cur(&(nCountsIn[0]));
+			var->get(pData, &((*pnGet)[0]));
+			return;
 		}
-		NcVar * varLon = ncTarget.get_var("lon");
-		if (varLon == NULL) {
-			varLon = ncTarget.add_var("lon", ncDouble, dimLon);
-			if (varLon == NULL) {
-				_EXCEPTIONT("Cannot create variable \"lon\" in target file");
-			}
 
-			NcBool fNoErr = varLon->put(
-				&(m_dVectorTargetCenterLon[0]),
-				m_dVectorTargetCenterLon.GetRows());
+		const int nFreeDims = pvecDimSizes->GetRows();
+		const int nHorizontalDims = nCountsIn.GetRows() - nFreeDims;
 
-			if (!fNoErr) {
-				_EXCEPTION1("Error writing \"lon\" to NetCDF file (%i)", NcError::get_err());
+		const std::vector<OfflineMapSourceSupport::Hyperslab> & vecHyperslabs =
+			psupport->GetHyperslabs();
+
+		for (int h = 0; h < vecHyperslabs.size(); h++) {
+			for (int d = 0; d < nHorizontalDims; d++) {
+				nCountsIn[nFreeDims + d] = vecHyperslabs[h].lBegin[d];
+				nGetHyperslab[nFreeDims + d] = vecHyperslabs[h].lCount[d];
 			}
 
-			varLon->add_att("bounds", "lon_bnds");
-			varLon->add_att("units", "degrees_east");
-			varLon->add_att("axis", "X");
-			varLon->add_att("long_name", "longitude");
-			varLon->add_att("standard_name", "longitude");
+			var->set_cur(&(nCountsIn[0]));
+			var->get(pData + vecHyperslabs[h].ixCompact, &(nGetHyperslab[0]));
+		}
+	}
 
-		} else {
-			if (varLon->get_dim(0)->size() != dimLon->size()) {
-				_EXCEPTIONT("\"lon\" variable mismatch");
+	///	<summary>
+	///		Read a block of slices from the source variable, replacing fill
+	///		values with zero.
+	///	</summary>
+	void ReadBlock(
+		OfflineMapApplyBlock & block,
+		int tBegin,
+		int nBlock
+	) {
+		block.tBegin = tBegin;
+		block.nBlock = nBlock;
+
+		for (int b = 0; b < nBlock; b++) {
+
+			long tt = static_cast<long>(tBegin + b);
+			for (int d = pvecDimSizes->GetRows()-1; d >= 0; d--) {
+				nCountsIn[d] = tt % (*pvecDimSizes)[d];
+				tt /= (*pvecDimSizes)[d];
 			}
-		}
 
-		NcDim * dimLat;
-		if (m_vecTargetDimNames[0] == "lat") {
-			dimLat = dim0;
-		}
-		if (m_vecTargetDimNames[1] == "lat") {
-			dimLat = dim1;
-		}
-		NcVar * varLat = ncTarget.get_var("lat");
-		if (varLat == NULL) {
-			varLat = ncTarget.add_var("lat", ncDouble, dimLat);
-			if (varLat == NULL) {
-				_EXCEPTIONT("Cannot create variable \"lat\" in target file");
+			for (int d = pvecDimSizes->GetRows(); d < nCountsIn.GetRows(); d++) {
+				nCountsIn[d] = 0;
 			}
 
-			NcBool fNoErr = varLat->put(
-				&(m_dVectorTargetCenterLat[0]),
-				m_dVectorTargetCenterLat.GetRows());
+			block.iSliceMatches[b] = 1;
 
-			if (!fNoErr) {
-				_EXCEPTION1("Error writing \"lon\" to NetCDF file (%i)", NcError::get_err());
-			}
+			// Load data as Float
+			if (fSinglePrecision) {
+				GetSlice(&(dataIn[0]));
 
-			varLat->add_att("bounds", "lat_bnds");
-			varLat->add_att("units", "degrees_north");
-			varLat->add_att("axis", "Y");
-			varLat->add_att("long_name", "latitude");
-			varLat->add_att("standard_name", "latitude");
+				if (fRenormalize && (flFillValue != 0.0f)) {
+					RecordFillPattern(block, b, &(dataIn[0]), flFillValue);
+				}
 
-		} else {
-			if (varLat->get_dim(0)->size() != dimLat->size()) {
-				_EXCEPTIONT("\"lat\" variable mismatch");
-			}
-		}
+				if (flFillValue != 0.0f) {
+					for (int i = 0; i < nSourceCount; i++) {
+						if (dataIn[i] == flFillValue) {
+							dataIn[i] = 0.0f;
+						}
+					}
+				}
 
-		// Output bounds variables
-		if ((m_dVectorTargetBoundsLon.GetRows() != 0) &&
-		    (m_dVectorTargetBoundsLat.GetRows() != 0) &&
-			(ncTarget.get_dim("bnds") != NULL)
-		) {
-			NcDim * dimBounds = ncTarget.add_dim("bnds", 2);
+			// Load data as Float, cast to Double
+			} else if (var->type() == ncFloat) {
+				GetSlice(&(dataIn[0]));
 
-			NcVar * varLonBounds =
-				ncTarget.add_var("lon_bnds", ncDouble, dimLon, dimBounds);
+				if (fRenormalize && (flFillValue != 0.0f)) {
+					RecordFillPattern(block, b, &(dataIn[0]), flFillValue);
+				}
 
-			if (varLonBounds == NULL) {
-				_EXCEPTIONT("Cannot create variable \"lon_bnds\""
-					" in target file");
+				if (flFillValue != 0.0f) {
+					for (int i = 0; i < nSourceCount; i++) {
+						if (dataIn[i] == flFillValue) {
+							dataInDouble[i] = 0.0;
+						} else {
+							dataInDouble[i] = static_cast<double>(dataIn[i]);
+						}
+					}
+
+				} else {
+					for (int i = 0; i < nSourceCount; i++) {
+						dataInDouble[i] = static_cast<double>(dataIn[i]);
+					}
+				}
+
+			// Load data as Double
+			} else {
+				GetSlice(&(dataInDouble[0]));
+
+				if (fRenormalize && (dFillValue != 0.0)) {
+					RecordFillPattern(block, b, &(dataInDouble[0]), dFillValue);
+				}
+
+				if (dFillValue != 0.0) {
+					for (int i = 0; i < nSourceCount; i++) {
+						if (dataInDouble[i] == dFillValue) {
+							dataInDouble[i] = 0.0;
+						}
+					}
+				}
 			}
 
-			varLonBounds->put(&(m_dVectorTargetBoundsLon[0][0]),
-				m_dVectorTargetBoundsLon.GetRows(), 2);
+			// Calculate input mass and store the data in the block
+			if (fSinglePrecision) {
+				CalculateMassMinMax(
+					dataIn, *pdSourceAreas, nSourceCount,
+					block.dSourceMass[b],
+					block.dSourceMin[b],
+					block.dSourceMax[b]);
 
-			NcVar * varLatBounds =
-				ncTarget.add_var("lat_bnds", ncDouble, dimLat, dimBounds);
+				for (int i = 0; i < nSourceCount; i++) {
+					block.dataInFloat[i][b] = dataIn[i];
+				}
 
-			if (varLatBounds == NULL) {
-				_EXCEPTIONT("Cannot create variable \"lat_bnds\""
-					" in target file");
+			} else {
+				CalculateMassMinMax(
+					dataInDouble, *pdSourceAreas, nSourceCount,
+					block.dSourceMass[b],
+					block.dSourceMin[b],
+					block.dSourceMax[b]);
+
+				for (int i = 0; i < nSourceCount; i++) {
+					block.dataIn[i][b] = dataInDouble[i];
+				}
 			}
+		}
+	}
 
-			varLatBounds->put(&(m_dVectorTargetBoundsLat[0][0]),
-				m_dVectorTargetBoundsLat.GetRows(), 2);
+	///	<summary>
+	///		Apply the map to a block of slices.
+	///	</summary>
+	void ApplyBlock(
+		const SparseMatrixDevice<double> & smatRemap,
+		OfflineMapApplyBlock & block
+	) {
+		if (fSinglePrecision) {
+			smatRemap.Apply(block.dataInFloat, block.dataOutFloat, block.nBlock);
+		} else {
+			smatRemap.Apply(block.dataIn, block.dataOut, block.nBlock);
 		}
 
+		if (fRenormalize) {
+			RenormalizeBlock(smatRemap, block);
+		}
+	}
 
-	// Add lat/lon to unstructured data
-	} else if (!fTargetRectilinear) {
-		NcVar * varLon = ncTarget.get_var("lon");
-		if (varLon == NULL) {
-			varLon = ncTarget.add_var("lon", ncDouble, dim0);
-			if (m_dTargetCenterLon.GetRows() != dim0->size()) {
-				_EXCEPTION2("TargetCenterLon / NCol dimension size mismatch (%i, %i)",
-					m_dTargetCenterLon.GetRows(), dim0->size());
+	///	<summary>
+	///		Compare the missing values of a source slice with the reference
+	///		pattern of the variable, which is taken from the first slice.
+	///	</summary>
+	template <typename T>
+	void RecordFillPattern(
+		OfflineMapApplyBlock & block,
+		int b,
+		const T * pData,
+		T valueFill
+	) {
+		if (!fHasValidReference) {
+			iValidReference.Allocate(nSourceCount);
+			for (int i = 0; i < nSourceCount; i++) {
+				iValidReference[i] = (pData[i] != valueFill)?(1):(0);
 			}
-			if (varLon == NULL) {
-				_EXCEPTIONT("Cannot create variable \"lon\" in target file");
+			fHasValidReference = true;
+			return;
+		}
+
+		int iFirstMismatch = 0;
+		for (; iFirstMismatch < nSourceCount; iFirstMismatch++) {
+			const int i = iFirstMismatch;
+			if ((pData[i] != valueFill) != (iValidReference[i] != 0)) {
+				break;
 			}
+		}
+		if (iFirstMismatch == nSourceCount) {
+			return;
+		}
 
-			varLon->put(
-				&(m_dTargetCenterLon[0]),
-				m_dTargetCenterLon.GetRows());
+		block.iSliceMatches[b] = 0;
 
-			//varLon->add_att("bounds", "lon_bnds");
-			varLon->add_att("units", "degrees_east");
-			varLon->add_att("axis", "X");
-			varLon->add_att("long_name", "longitude");
-			varLon->add_att("standard_name", "longitude");
+		if (block.dataValid.GetRows() == 0) {
+			block.dataValid.Allocate(nSourceCount, block.iSliceMatches.GetRows());
+		}
+		for (int i = 0; i < nSourceCount; i++) {
+			block.dataValid[i][b] = (pData[i] != valueFill)?(1.0):(0.0);
+		}
+	}
 
-		} else {
-			if (varLon->get_dim(0)->size() != dim0->size()) {
-				_EXCEPTIONT("\"lon\" variable mismatch");
-			}
+	///	<summary>
+	///		Get the factor by which a target value is rescaled so that the
+	///		weights of valid source values have the row sum of the map, or
+	///		zero if the target has no valid source values.
+	///	</summary>
+	static double GetRenormalizationScale(
+		double dRowSum,
+		double dValidSum
+	) {
+		if ((dValidSum == dRowSum) || (dRowSum == 0.0)) {
+			return 1.0;
+		}
+		if (fabs(dValidSum) <= 1.0e-12 * fabs(dRowSum)) {
+			return 0.0;
+		}
+		return (dRowSum / dValidSum);
+	}
+
+	///	<summary>
+	///		Rescale a block of remapped slices to account for missing source
+	///		values.  The scaling for the reference pattern is computed once
+	///		per variable; other slices require an additional application of
+	///		the map to their validity.
+	///	</summary>
+	void RenormalizeBlock(
+		const SparseMatrixDevice<double> & smatRemap,
+		OfflineMapApplyBlock & block
+	) {
+		// No missing values have been found
+		if (!fHasValidReference) {
+			return;
 		}
 
-		NcVar * varLat = ncTarget.get_var("lat");
-		if (varLat == NULL) {
-			varLat = ncTarget.add_var("lat", ncDouble, dim0);
-			if (m_dTargetCenterLat.GetRows() != dim0->size()) {
-				_EXCEPTION2("TargetCenterLat / NCol dimension size mismatch (%i, %i)",
-					m_dTargetCenterLat.GetRows(), dim0->size());
+		// Scaling for the reference pattern
+		if (dScaleReference.GetRows() == 0) {
+			DataArray2D<double> dataIn(nSourceCount, 2);
+			DataArray2D<double> dataOut(nTargetCount, 2);
+			for (int i = 0; i < nSourceCount; i++) {
+				dataIn[i][0] = 1.0;
+				dataIn[i][1] = static_cast<double>(iValidReference[i]);
 			}
-			if (varLat == NULL) {
-				_EXCEPTIONT("Cannot create variable \"lat\" in target file");
+
+			smatRemap.Apply(dataIn, dataOut, 2);
+
+			dRowSums.Allocate(nTargetCount);
+			dScaleReference.Allocate(nTargetCount);
+			for (int i = 0; i < nTargetCount; i++) {
+				dRowSums[i] = dataOut[i][0];
+				dScaleReference[i] =
+					GetRenormalizationScale(dataOut[i][0], dataOut[i][1]);
 			}
+		}
 
-			varLat->put(
-				&(m_dTargetCenterLat[0]),
-				m_dTargetCenterLat.GetRows());
+		// Weights of valid source values of non-matching slices
+		DataArray2D<double> dataValidSums;
+		if (block.dataValid.GetRows() != 0) {
+			dataValidSums.Allocate(nTargetCount, block.dataValid.GetColumns());
+			smatRemap.Apply(block.dataValid, dataValidSums, block.nBlock);
+		}
 
-			//varLat->add_att("bounds", "lat_bnds");
-			varLat->add_att("units", "degrees_north");
-			varLat->add_att("axis", "Y");
-			varLat->add_att("long_name", "latitude");
-			varLat->add_att("standard_name", "latitude");
+		const float flFillOut = flFillValue;
+		const double dFillOut =
+			(fTargetDouble)?(dFillValue):(static_cast<double>(flFillValue));
 
-		} else {
-			if (varLat->get_dim(0)->size() != dim0->size()) {
-				_EXCEPTIONT("\"lat\" variable mismatch");
+		for (int b = 0; b < block.nBlock; b++) {
+			for (int i = 0; i < nTargetCount; i++) {
+				double dScale = dScaleReference[i];
+				if (!block.iSliceMatches[b]) {
+					dScale = GetRenormalizationScale(
+						dRowSums[i], dataValidSums[i][b]);
+				}
+				if (dScale == 1.0) {
+					continue;
+				}
+
+				if (fSinglePrecision) {
+					if (dScale == 0.0) {
+						block.dataOutFloat[i][b] = flFillOut;
+					} else {
+						block.dataOutFloat[i][b] = static_cast<float>(
+							dScale * static_cast<double>(block.dataOutFloat[i][b]));
+					}
+
+				} else {
+					if (dScale == 0.0) {
+						block.dataOut[i][b] = dFillOut;
+					} else {
+						block.dataOut[i][b] *= dScale;
+					}
+				}
 			}
 		}
+	}
 
-	// Non-latitude-longitude rectilinear mesh target
-	} else {
-		NcVar * varLon = ncTarget.get_var("lon");
-		if (varLon == NULL) {
-			varLon = ncTarget.add_var("lon", ncDouble, dim0, dim1);
-			if (m_dTargetCenterLon.GetRows() != dim0->size() * dim1->size()) {
-				_EXCEPTION3("TargetCenterLon / NCol dimension size mismatch (%i, %i x %i)",
-					m_dTargetCenterLon.GetRows(), dim0->size(), dim1->size());
+	///	<summary>
+	///		Write a block of slices to the target variable.
+	///	</summary>
+	void WriteBlock(
+		const OfflineMapApplyBlock & block
+	) {
+		for (int b = 0; b < block.nBlock; b++) {
+
+			long tt = static_cast<long>(block.tBegin + b);
+			for (int d = pvecDimSizes->GetRows()-1; d >= 0; d--) {
+				nCountsOut[d] = tt % (*pvecDimSizes)[d];
+				tt /= (*pvecDimSizes)[d];
 			}
-			if (varLon == NULL) {
-				_EXCEPTIONT("Cannot create variable \"lon\" in target file");
+
+			for (int d = pvecDimSizes->GetRows(); d < nCountsOut.GetRows(); d++) {
+				nCountsOut[d] = 0;
 			}
 
-			varLon->put(
-				&(m_dTargetCenterLon[0]),
-				dim0->size(),
-				dim1->size());
+			// Extract the data from the block and calculate output mass
+			double dTargetMass;
+			double dTargetMin;
+			double dTargetMax;
 
-			//varLon->add_att("bounds", "lon_bnds");
-			varLon->add_att("units", "degrees_east");
-			varLon->add_att("axis", "X");
-			varLon->add_att("long_name", "longitude");
-			varLon->add_att("standard_name", "longitude");
+			if (fSinglePrecision) {
+				for (int i = 0; i < nTargetCount; i++) {
+					dataOut[i] = block.dataOutFloat[i][b];
+				}
+				if (fRenormalize) {
+					CalculateMassMinMaxExcluding(
+						dataOut, *pdTargetAreas, nTargetCount, flFillValue,
+						dTargetMass, dTargetMin, dTargetMax);
+				} else {
+					CalculateMassMinMax(
+						dataOut, *pdTargetAreas, nTargetCount,
+						dTargetMass, dTargetMin, dTargetMax);
+				}
 
-		} else {
-			if (varLon->num_dims() != 2) {
-				_EXCEPTIONT("\"lon\" variable mismatch");
+			} else {
+				for (int i = 0; i < nTargetCount; i++) {
+					dataOutDouble[i] = block.dataOut[i][b];
+				}
+				if (fRenormalize) {
+					CalculateMassMinMaxExcluding(
+						dataOutDouble, *pdTargetAreas, nTargetCount,
+						(fTargetDouble)?(dFillValue):(static_cast<double>(flFillValue)),
+						dTargetMass, dTargetMin, dTargetMax);
+				} else {
+					CalculateMassMinMax(
+						dataOutDouble, *pdTargetAreas, nTargetCount,
+						dTargetMass, dTargetMin, dTargetMax);
+				}
 			}
-			if (varLon->get_dim(0)->size() != dim0->size()) {
-				_EXCEPTIONT("\"lon\" variable mismatch");
+
+			// Announce input and output mass
+			Announce("Source Mass: %1.15e Min %1.10e Max %1.10e",
+				block.dSourceMass[b], block.dSourceMin[b], block.dSourceMax[b]);
+
+			Announce("Target Mass: %1.15e Min %1.10e Max %1.10e",
+				dTargetMass, dTargetMin, dTargetMax);
+
+			// Write the data
+			if (fTargetDouble) {
+				varOut->set_cur(&(nCountsOut[0]));
+				NcBool fNoErr = varOut->put(&(dataOutDouble[0]), &((*pnPut)[0]));
+				if (!fNoErr) {
+					_EXCEPTION1("Error writing to NetCDF file (%i)", NcError::get_err());
+				}
+
+			} else {
+				// Cast the data to float
+				if (!fSinglePrecision) {
+					for (int i = 0; i < dataOut.GetRows(); i++) {
+						dataOut[i] = static_cast<float>(dataOutDouble[i]);
+					}
+				}
+
+				// Write the data as float
+				varOut->set_cur(&(nCountsOut[0]));
+				NcBool fNoErr = varOut->put(&(dataOut[0]), &((*pnPut)[0]));
+				if (!fNoErr) {
+					_EXCEPTION1("Error writing to NetCDF file (%i)", NcError::get_err());
+				}
 			}
-			if (varLon->get_dim(1)->size() != dim1->size()) {
-				_EXCEPTIONT("\"lon\" variable mismatch");
+		}
+	}
+
+public:
+	///	<summary>
+	///		Source and target variables.
+	///	</summary>
+	NcVar * var;
+	NcVar * varOut;
+
+	///	<summary>
+	///		Sizes of the free (non-horizontal) dimensions.
+	///	</summary>
+	const DataArray1D<long> * pvecDimSizes;
+
+	///	<summary>
+	///		Get and put sizes.
+	///	</summary>
+	const DataArray1D<long> * pnGet;
+	const DataArray1D<long> * pnPut;
+
+	///	<summary>
+	///		Part of each source slice to read, or NULL to read whole slices.
+	///		Source counts and areas then refer to the compacted columns.
+	///	</summary>
+	const OfflineMapSourceSupport * psupport;
+
+	///	<summary>
+	///		Get size of a single hyperslab.
+	///	</summary>
+	DataArray1D<long> nGetHyperslab;
+
+	///	<summary>
+	///		Source and target offsets.
+	///	</summary>
+	DataArray1D<long> nCountsIn;
+	DataArray1D<long> nCountsOut;
+
+	///	<summary>
+	///		Source and target areas.
+	///	</summary>
+	const DataArray1D<double> * pdSourceAreas;
+	const DataArray1D<double> * pdTargetAreas;
+
+	///	<summary>
+	///		Number of source and target degrees of freedom.
+	///	</summary>
+	int nSourceCount;
+	int nTargetCount;
+
+	///	<summary>
+	///		Remap in single precision.
+	///	</summary>
+	bool fSinglePrecision;
+
+	///	<summary>
+	///		Write output in double precision.
+	///	</summary>
+	bool fTargetDouble;
+
+	///	<summary>
+	///		Fill values.
+	///	</summary>
+	float flFillValue;
+	double dFillValue;
+
+	///	<summary>
+	///		Rescale target values to account for missing source values.
+	///	</summary>
+	bool fRenormalize;
+
+	///	<summary>
+	///		Validity (0 or 1) of the source values of the first slice with
+	///		missing values, which is the reference pattern of the variable.
+	///		Only written by ReadBlock().
+	///	</summary>
+	bool fHasValidReference;
+	DataArray1D<int> iValidReference;
+
+	///	<summary>
+	///		Row sums of the map and scaling of target values for the
+	///		reference pattern.  Only written by ApplyBlock().
+	///	</summary>
+	DataArray1D<double> dRowSums;
+	DataArray1D<double> dScaleReference;
+
+	///	<summary>
+	///		Buffers for a single slice.  The input buffers are only used by
+	///		ReadBlock() and the output buffers only by WriteBlock(), so that
+	///		the two may be executed concurrently.
+	///	</summary>
+	DataArray1D<float> dataIn;
+	DataArray1D<double> dataInDouble;
+	DataArray1D<float> dataOut;
+	DataArray1D<double> dataOutDouble;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A variable set up for remapping by OfflineMap::Apply(), with its
+///		decomposition into blocks of slices.  Slice buffers are only
+///		allocated while the variable is being remapped.
+///	</summary>
+class OfflineMapApplyPlan {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	OfflineMapApplyPlan() :
+		nDataInSize(0),
+		nDataOutSize(0),
+		nTotalEntries(0),
+		nBlockSize(0),
+		nBlocks(0)
+	{ }
+
+	///	<summary>
+	///		Allocate the slice buffers of the variable.
+	///	</summary>
+	void AllocateBuffers() {
+		applyvar.dataIn.Allocate(nDataInSize);
+		applyvar.dataInDouble.Allocate(applyvar.nSourceCount);
+		applyvar.dataOut.Allocate(nDataOutSize);
+		applyvar.dataOutDouble.Allocate(applyvar.nTargetCount);
+	}
+
+	///	<summary>
+	///		Release the slice buffers of the variable.
+	///	</summary>
+	void ReleaseBuffers() {
+		applyvar.dataIn.Allocate(0);
+		applyvar.dataInDouble.Allocate(0);
+		applyvar.dataOut.Allocate(0);
+		applyvar.dataOutDouble.Allocate(0);
+	}
+
+	///	<summary>
+	///		Allocate a block for this variable.
+	///	</summary>
+	void AllocateBlock(
+		OfflineMapApplyBlock & block
+	) const {
+		block.Allocate(
+			applyvar.fSinglePrecision,
+			applyvar.nSourceCount,
+			applyvar.nTargetCount,
+			nBlockSize);
+	}
+
+	///	<summary>
+	///		Read the given block of slices.
+	///	</summary>
+	void ReadBlock(
+		OfflineMapApplyBlock & block,
+		int iBlock
+	) {
+		int tBegin = iBlock * nBlockSize;
+		applyvar.ReadBlock(
+			block, tBegin, std::min(nBlockSize, nTotalEntries - tBegin));
+	}
+
+public:
+	///	<summary>
+	///		Name of the variable.
+	///	</summary>
+	std::string strName;
+
+	///	<summary>
+	///		Sizes of the free dimensions, and get and put sizes, referenced
+	///		by applyvar.
+	///	</summary>
+	DataArray1D<long> vecDimSizes;
+	DataArray1D<long> nGet;
+	DataArray1D<long> nPut;
+
+	///	<summary>
+	///		Reading and writing state of the variable.
+	///	</summary>
+	OfflineMapApplyVariable applyvar;
+
+	///	<summary>
+	///		Sizes of the single precision input and output slice buffers.
+	///	</summary>
+	int nDataInSize;
+	int nDataOutSize;
+
+	///	<summary>
+	///		Number of slices, slices per block and number of blocks.
+	///	</summary>
+	int nTotalEntries;
+	int nBlockSize;
+	int nBlocks;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Replace the given fill values with those of the _FillValue or
+///		missing_value attribute of a variable, if present.
+///	</summary>
+static void GetVariableFillValues(
+	NcVar * var,
+	float & flFillValue,
+	double & dFillValue
+) {
+	for (int a = 0; a < var->num_atts(); a++) {
+		NcAtt * att = var->get_att(a);
+		if ((strcmp(att->name(), "_FillValue") == 0) ||
+		    (strcmp(att->name(), "missing_value") == 0)
+		) {
+			if (att->type() == ncDouble) {
+				dFillValue = att->as_double(0);
+			} else if (att->type() == ncFloat) {
+				flFillValue = att->as_float(0);
+			} else {
+				_EXCEPTION1("Invalid type for attribute \"%s\"", att->name());
+			}
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+#if defined(TEMPEST_MPIOMP)
+///	<summary>
+///		Broadcast a list of strings from rank 0.
+///	</summary>
+static void BroadcastStringList(
+	std::vector<std::string> & vecStrings
+) {
+	int nStrings = static_cast<int>(vecStrings.size());
+	MPI_Bcast(&nStrings, 1, MPI_INT, 0, MPI_COMM_WORLD);
+	vecStrings.resize(nStrings);
+
+	for (int i = 0; i < nStrings; i++) {
+		int nLength = static_cast<int>(vecStrings[i].length());
+		MPI_Bcast(&nLength, 1, MPI_INT, 0, MPI_COMM_WORLD);
+
+		std::vector<char> vecBuffer(nLength + 1, '\0');
+		memcpy(&(vecBuffer[0]), vecStrings[i].c_str(), vecStrings[i].length());
+		MPI_Bcast(&(vecBuffer[0]), nLength, MPI_CHAR, 0, MPI_COMM_WORLD);
+		vecStrings[i] = std::string(&(vecBuffer[0]), nLength);
+	}
+}
+
+///	<summary>
+///		Rank that reads and remaps a given block of slices in a distributed
+///		OfflineMap::Apply().  Rank 0 only writes.
+///	</summary>
+static inline int DistributedBlockOwner(
+	int iBlock,
+	int nMPISize
+) {
+	return 1 + (iBlock % (nMPISize - 1));
+}
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+#if defined(_OPENMP)
+///	<summary>
+///		Allow at least the given number of nested active parallel regions
+///		for the lifetime of this object, restoring the previous limit on
+///		destruction so that the OpenMP state of the caller is unchanged.
+///	</summary>
+class OpenMPActiveLevelsGuard {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	OpenMPActiveLevelsGuard(
+		int nLevels
+	) :
+		m_nPreviousLevels(omp_get_max_active_levels())
+	{
+		if (m_nPreviousLevels < nLevels) {
+			omp_set_max_active_levels(nLevels);
+		}
+	}
+
+	///	<summary>
+	///		Destructor.
+	///	</summary>
+	~OpenMPActiveLevelsGuard() {
+		omp_set_max_active_levels(m_nPreviousLevels);
+	}
+
+private:
+	///	<summary>
+	///		Maximum number of nested active parallel regions on construction.
+	///	</summary>
+	int m_nPreviousLevels;
+};
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OfflineMap::Apply(
+	const std::string & strSourceDataFile,
+	const std::string & strTargetDataFile,
+	const std::vector<std::string> & vecVariables,
+	const std::string & strNColName,
+	bool fTargetDouble,
+	bool fAppend
+) {
+	ResolveCoordinates();
+
+	// Check variable list for "lat" and "lon"
+	for (int v = 0; v < vecVariables.size(); v++) {
+		if (vecVariables[v] == "lat") {
+			_EXCEPTIONT("Latitude variable \"lat\" in variable list will be overwritten on output");
+		}
+		if (vecVariables[v] == "lon") {
+			_EXCEPTIONT("Longitude variable \"lon\" in variable list will be overwritten on output");
+		}
+	}
+
+#if defined(TEMPEST_MPIOMP)
+	// In a distributed application rank 0 writes the target file while
+	// the other ranks read and remap the slices
+	int nMPIRank = 0;
+	int nMPISize = 1;
+	if (m_fDistributeSlices) {
+		MPI_Comm_rank(MPI_COMM_WORLD, &nMPIRank);
+		MPI_Comm_size(MPI_COMM_WORLD, &nMPISize);
+	}
+	if ((nMPISize > 1) && (nMPIRank != 0)) {
+		ApplyDistributedWorker(strSourceDataFile, fTargetDouble);
+		return;
+	}
+#endif
+
+	// Open source data file
+	NcFile ncSource(strSourceDataFile.c_str(), NcFile::ReadOnly);
+	if (!ncSource.is_valid()) {
+		_EXCEPTION1("Cannot open source data file \"%s\"",
+			strSourceDataFile.c_str());
+	}
+
+	// Open target data file
+	NcFile::FileMode eOpenMode = NcFile::Replace;
+	if (fAppend) {
+		eOpenMode = NcFile::Write;
+	}
+
+	NcFile ncTarget(strTargetDataFile.c_str(), eOpenMode);
+	if (!ncTarget.is_valid()) {
+		_EXCEPTION1("Cannot open target data file \"%s\"",
+			strTargetDataFile.c_str());
+	}
+
+	// Number of source and target regions
+	int nSourceCount = m_dSourceAreas.GetRows();
+	int nTargetCount = m_dTargetAreas.GetRows();
+
+	// Convert the map to CSR form for application
+	m_mapRemap.Finalize();
+
+	// Only the part of each source slice referenced by the map is read
+	// when it is small compared to the slice
+	OfflineMapSourceSupport support;
+	support.Initialize(m_mapRemap, m_vecSourceDimSizes, m_dSourceAreas);
+
+	const OfflineMapSourceSupport * psupport = NULL;
+	const SparseMatrix<double> * psmatApply = &m_mapRemap;
+	const DataArray1D<double> * pdSourceReadAreas = &m_dSourceAreas;
+	int nSourceReadCount = nSourceCount;
+
+	if (support.IsPartial()) {
+		psupport = &support;
+		psmatApply = &(support.GetCompactMatrix());
+		pdSourceReadAreas = &(support.GetCompactAreas());
+		nSourceReadCount = support.GetCompactCount();
+	}
+
+	if (support.IsPartial()) {
+		Announce("Reading %i of %i source columns", nSourceReadCount, nSourceCount);
+	}
+
+	// Keep the map resident on an accelerator, if one is available, for
+	// the duration of the application
+	SparseMatrixDevice<double> smatDevice(*psmatApply, m_fReorderForApply);
+	if (smatDevice.IsReordered()) {
+		Announce("Renumbered source and target points for locality");
+	}
+	if (smatDevice.IsOnDevice()) {
+		Announce("Applying map on target device %i", smatDevice.GetDevice());
+	}
+
+#if defined(_OPENMP)
+	// Allow the map to be applied by a nested team of threads while file
+	// operations are performed in parallel, until Apply returns
+	OpenMPActiveLevelsGuard guardActiveLevels(2);
+#endif
+
+	// Check for rectilinear data
+	bool fSourceRectilinear;
+	if (m_vecSourceDimSizes.size() == 1) {
+		fSourceRectilinear = false;
+	} else if (m_vecSourceDimSizes.size() == 2) {
+		fSourceRectilinear = true;
+	} else {
+		_EXCEPTIONT("m_vecSourceDimSizes undefined");
+	}
+
+	if (fSourceRectilinear) {
+		if (nSourceCount != m_vecSourceDimSizes[0] * m_vecSourceDimSizes[1]) {
+			_EXCEPTIONT("Rectilinear input expected in finite volume form");
+		}
+	}
+
+	bool fTargetRectilinear;
+	if (m_vecTargetDimSizes.size() == 1) {
+		fTargetRectilinear = false;
+	} else if (m_vecTargetDimSizes.size() == 2) {
+		fTargetRectilinear = true;
+	} else {
+		_EXCEPTIONT("m_vecTargetDimSizes undefined");
+	}
+
+	if (fTargetRectilinear) {
+		if (nTargetCount != m_vecTargetDimSizes[0] * m_vecTargetDimSizes[1]) {
+			printf("%i %i\n", nTargetCount,
+				m_vecTargetDimSizes[0] * m_vecTargetDimSizes[1]);
+
+			_EXCEPTIONT("Rectilinear output expected in finite volume form");
+		}
+	}
+
+	// Size of a single slice of source and target data
+	int nSourceSliceSize = nSourceCount;
+	if (m_vecSourceDimSizes.size() != 1) {
+		nSourceSliceSize = m_vecSourceDimSizes[0] * m_vecSourceDimSizes[1];
+	}
+
+	int nTargetSliceSize = nTargetCount;
+	if (m_vecTargetDimSizes.size() != 1) {
+		nTargetSliceSize = m_vecTargetDimSizes[0] * m_vecTargetDimSizes[1];
+	}
+
+	// Target
+	if (!fAppend) {
+		CopyNcFileAttributes(&ncSource, &ncTarget);
+	}
+
+	NcDim * dim0;
+	NcDim * dim1;
+
+	if (!fTargetRectilinear) {
+		dim0 = NcFile_GetDimIfExists(
+			ncTarget,
+			strNColName.c_str(),
+			nTargetCount);
+
+	} else {
+		dim0 = NcFile_GetDimIfExists(
+			ncTarget,
+			m_vecTargetDimNames[0].c_str(),
+			m_vecTargetDimSizes[0]);
+
+		dim1 = NcFile_GetDimIfExists(
+			ncTarget,
+			m_vecTargetDimNames[1].c_str(),
+			m_vecTargetDimSizes[1]);
+	}
+
+	// Generate variable list
+	std::vector<std::string> vecVariableList = vecVariables;
+
+	if (vecVariables.size() == 0) {
+		for (int v = 0; v < ncSource.num_vars(); v++) {
+			NcVar * var = ncSource.get_var(v);
+
+			if (fSourceRectilinear) {
+				if (var->num_dims() < 2) {
+					continue;
+
+				} else {
+					NcDim * dimA = var->get_dim(var->num_dims()-2);
+					NcDim * dimB = var->get_dim(var->num_dims()-1);
+
+					if (dimA->size() != m_vecSourceDimSizes[0]) {
+						continue;
+					}
+					if (dimB->size() != m_vecSourceDimSizes[1]) {
+						continue;
+					}
+				}
+
+			} else {
+				if (var->num_dims() < 1) {
+					continue;
+
+				} else {
+					NcDim * dim = var->get_dim(var->num_dims()-1);
+
+					if (dim->size() != nSourceCount) {
+						continue;
+					}
+
+					bool fDimensionName = false;
+					for (int d = 0; d < m_vecTargetDimNames.size(); d++) {
+						const char * szDimName = m_vecTargetDimNames[d].c_str();
+						if (strcmp(var->name(), szDimName) == 0) {
+							fDimensionName = true;
+							break;
+						}
+					}
+					if (fDimensionName) {
+						continue;
+					}
+				}
 			}
+
+			vecVariableList.push_back(var->name());
 		}
+	}
+
+#if defined(TEMPEST_MPIOMP)
+	if (nMPISize > 1) {
+		BroadcastStringList(vecVariableList);
+	}
+#endif
+
+	// Add lat/lon vector dimensions
+	if ((m_dVectorTargetCenterLon.GetRows() != 0) &&
+		(m_dVectorTargetCenterLat.GetRows() != 0)
+	) {
+		NcDim * dimLon;
+		if (m_vecTargetDimNames[0] == "lon") {
+			dimLon = dim0;
+		}
+		if (m_vecTargetDimNames[1] == "lon") {
+			dimLon = dim1;
+		}
+		NcVar * varLon = ncTarget.get_var("lon");
+		if (varLon == NULL) {
+			varLon = ncTarget.add_var("lon", ncDouble, dimLon);
+			if (varLon == NULL) {
+				_EXCEPTIONT("Cannot create variable \"lon\" in target file");
+			}
+
+			NcBool fNoErr = varLon->put(
+				&(m_dVectorTargetCenterLon[0]),
+				m_dVectorTargetCenterLon.GetRows());
+
+			if (!fNoErr) {
+				_EXCEPTION1("Error writing \"lon\" to NetCDF file (%i)", NcError::get_err());
+			}
+
+			varLon->add_att("bounds", "lon_bnds");
+			varLon->add_att("units", "degrees_east");
+			varLon->add_att("axis", "X");
+			varLon->add_att("long_name", "longitude");
+			varLon->add_att("standard_name", "longitude");
+
+		} else {
+			if (varLon->get_dim(0)->size() != dimLon->size()) {
+				_EXCEPTIONT("\"lon\" variable mismatch");
+			}
+		}
+
+		NcDim * dimLat;
+		if (m_vecTargetDimNames[0] == "lat") {
+			dimLat = dim0;
+		}
+		if (m_vecTargetDimNames[1] == "lat") {
+			dimLat = dim1;
+		}
+		NcVar * varLat = ncTarget.get_var("lat");
+		if (varLat == NULL) {
+			varLat = ncTarget.add_var("lat", ncDouble, dimLat);
+			if (varLat == NULL) {
+				_EXCEPTIONT("Cannot create variable \"lat\" in target file");
+			}
+
+			NcBool fNoErr = varLat->put(
+				&(m_dVectorTargetCenterLat[0]),
+				m_dVectorTargetCenterLat.GetRows());
+
+			if (!fNoErr) {
+				_EXCEPTION1("Error writing \"lon\" to NetCDF file (%i)", NcError::get_err());
+			}
+
+			varLat->add_att("bounds", "lat_bnds");
+			varLat->add_att("units", "degrees_north");
+			varLat->add_att("axis", "Y");
+			varLat->add_att("long_name", "latitude");
+			varLat->add_att("standard_name", "latitude");
+
+		} else {
+			if (varLat->get_dim(0)->size() != dimLat->size()) {
+				_EXCEPTIONT("\"lat\" variable mismatch");
+			}
+		}
+
+		// Output bounds variables
+		if ((m_dVectorTargetBoundsLon.GetRows() != 0) &&
+		    (m_dVectorTargetBoundsLat.GetRows() != 0) &&
+			(ncTarget.get_dim("bnds") != NULL)
+		) {
+			NcDim * dimBounds = ncTarget.add_dim("bnds", 2);
+
+			NcVar * varLonBounds =
+				ncTarget.add_var("lon_bnds", ncDouble, dimLon, dimBounds);
+
+			if (varLonBounds == NULL) {
+				_EXCEPTIONT("Cannot create variable \"lon_bnds\""
+					" in target file");
+			}
+
+			varLonBounds->put(&(m_dVectorTargetBoundsLon[0][0]),
+				m_dVectorTargetBoundsLon.GetRows(), 2);
+
+			NcVar * varLatBounds =
+				ncTarget.add_var("lat_bnds", ncDouble, dimLat, dimBounds);
+
+			if (varLatBounds == NULL) {
+				_EXCEPTIONT("Cannot create variable \"lat_bnds\""
+					" in target file");
+			}
+
+			varLatBounds->put(&(m_dVectorTargetBoundsLat[0][0]),
+				m_dVectorTargetBoundsLat.GetRows(), 2);
+		}
+
+
+	// Add lat/lon to unstructured data
+	} else if (!fTargetRectilinear) {
+		NcVar * varLon = ncTarget.get_var("lon");
+		if (varLon == NULL) {
+			varLon = ncTarget.add_var("lon", ncDouble, dim0);
+			if (m_dTargetCenterLon.GetRows() != dim0->size()) {
+				_EXCEPTION2("TargetCenterLon / NCol dimension size mismatch (%i, %i)",
+					m_dTargetCenterLon.GetRows(), dim0->size());
+			}
+			if (varLon == NULL) {
+				_EXCEPTIONT("Cannot create variable \"lon\" in target file");
+			}
+
+			varLon->put(
+				&(m_dTargetCenterLon[0]),
+				m_dTargetCenterLon.GetRows());
+
+			//varLon->add_att("bounds", "lon_bnds");
+			varLon->add_att("units", "degrees_east");
+			varLon->add_att("axis", "X");
+			varLon->add_att("long_name", "longitude");
+			varLon->add_att("standard_name", "longitude");
+
+		} else {
+			if (varLon->get_dim(0)->size() != dim0->size()) {
+				_EXCEPTIONT("\"lon\" variable mismatch");
+			}
+		}
+
+		NcVar * varLat = ncTarget.get_var("lat");
+		if (varLat == NULL) {
+			varLat = ncTarget.add_var("lat", ncDouble, dim0);
+			if (m_dTargetCenterLat.GetRows() != dim0->size()) {
+				_EXCEPTION2("TargetCenterLat / NCol dimension size mismatch (%i, %i)",
+					m_dTargetCenterLat.GetRows(), dim0->size());
+			}
+			if (varLat == NULL) {
+				_EXCEPTIONT("Cannot create variable \"lat\" in target file");
+			}
+
+			varLat->put(
+				&(m_dTargetCenterLat[0]),
+				m_dTargetCenterLat.GetRows());
+
+			//varLat->add_att("bounds", "lat_bnds");
+			varLat->add_att("units", "degrees_north");
+			varLat->add_att("axis", "Y");
+			varLat->add_att("long_name", "latitude");
+			varLat->add_att("standard_name", "latitude");
+
+		} else {
+			if (varLat->get_dim(0)->size() != dim0->size()) {
+				_EXCEPTIONT("\"lat\" variable mismatch");
+			}
+		}
+
+	// Non-latitude-longitude rectilinear mesh target
+	} else {
+		NcVar * varLon = ncTarget.get_var("lon");
+		if (varLon == NULL) {
+			varLon = ncTarget.add_var("lon", ncDouble, dim0, dim1);
+			if (m_dTargetCenterLon.GetRows() != dim0->size() * dim1->size()) {
+				_EXCEPTION3("TargetCenterLon / NCol dimension size mismatch (%i, %i x %i)",
+					m_dTargetCenterLon.GetRows(), dim0->size(), dim1->size());
+			}
+			if (varLon == NULL) {
+				_EXCEPTIONT("Cannot create variable \"lon\" in target file");
+			}
+
+			varLon->put(
+				&(m_dTargetCenterLon[0]),
+				dim0->size(),
+				dim1->size());
+
+			//varLon->add_att("bounds", "lon_bnds");
+			varLon->add_att("units", "degrees_east");
+			varLon->add_att("axis", "X");
+			varLon->add_att("long_name", "longitude");
+			varLon->add_att("standard_name", "longitude");
+
+		} else {
+			if (varLon->num_dims() != 2) {
+				_EXCEPTIONT("\"lon\" variable mismatch");
+			}
+			if (varLon->get_dim(0)->size() != dim0->size()) {
+				_EXCEPTIONT("\"lon\" variable mismatch");
+			}
+			if (varLon->get_dim(1)->size() != dim1->size()) {
+				_EXCEPTIONT("\"lon\" variable mismatch");
+			}
+		}
+
+		NcVar * varLat = ncTarget.get_var("lat");
+		if (varLat == NULL) {
+			varLat = ncTarget.add_var("lat", ncDouble, dim0, dim1);
+			if (m_dTargetCenterLat.GetRows() != dim0->size() * dim1->size()) {
+				_EXCEPTION3("TargetCenterLat / NCol dimension size mismatch (%i, %i x %i)",
+					m_dTargetCenterLat.GetRows(), dim0->size(), dim1->size());
+			}
+			if (varLat == NULL) {
+				_EXCEPTIONT("Cannot create variable \"lat\" in target file");
+			}
+
+			varLat->put(
+				&(m_dTargetCenterLat[0]),
+				dim0->size(),
+				dim1->size());
+
+			//varLat->add_att("bounds", "lat_bnds");
+			varLat->add_att("units", "degrees_north");
+			varLat->add_att("axis", "Y");
+			varLat->add_att("long_name", "latitude");
+			varLat->add_att("standard_name", "latitude");
+
+		} else {
+			if (varLat->num_dims() != 2) {
+				_EXCEPTIONT("\"lat\" variable mismatch");
+			}
+			if (varLat->get_dim(0)->size() != dim0->size()) {
+				_EXCEPTIONT("\"lat\" variable mismatch");
+			}
+			if (varLat->get_dim(1)->size() != dim1->size()) {
+				_EXCEPTIONT("\"lat\" variable mismatch");
+			}
+		}
+	}
+
+	// Variables are either remapped one at a time, or all set up first so
+	// that blocks of different variables are pipelined
+	bool fParallelVariables = m_fParallelVariables;
+#if defined(TEMPEST_MPIOMP)
+	if (nMPISize > 1) {
+		fParallelVariables = false;
+	}
+#endif
+
+	// Renormalization for missing values is performed where the map is
+	// applied, so it is not available in a distributed application
+	bool fRenormalize = m_fRenormalizeFillValues;
+#if defined(TEMPEST_MPIOMP)
+	if (nMPISize > 1) {
+		fRenormalize = false;
+	}
+#endif
+
+	std::vector<OfflineMapApplyPlan> vecPlans(vecVariableList.size());
+
+	// Loop through all variables
+	for (int v = 0; v < vecVariableList.size(); v++) {
+		NcVar * var = ncSource.get_var(vecVariableList[v].c_str());
+		if (var == NULL) {
+			_EXCEPTION1("Variable \"%s\" does not exist in source file",
+				vecVariableList[v].c_str());
+		}
+
+		OfflineMapApplyPlan & plan = vecPlans[v];
+		plan.strName = vecVariableList[v];
+
+		if (!fParallelVariables) {
+			AnnounceStartBlock(vecVariableList[v].c_str());
+		}
+
+		// Check for _FillValue
+		float flFillValue = m_flFillValueOverride;
+		double dFillValue = m_dFillValueOverride;
+		GetVariableFillValues(var, flFillValue, dFillValue);
+
+		// Construct an array of dimensions for this variable
+		int nVarTotalEntries = 1;
+
+		DataArray1D<NcDim *> vecDims(var->num_dims());
+
+		DataArray1D<NcDim *> vecDimsOut;
+		if (fTargetRectilinear) {
+
+			if (fSourceRectilinear) {
+				vecDimsOut.Allocate(var->num_dims());
+			} else {
+				vecDimsOut.Allocate(var->num_dims()+1);
+			}
+
+			vecDimsOut[vecDimsOut.GetRows()-2] = dim0;
+			vecDimsOut[vecDimsOut.GetRows()-1] = dim1;
+
+		} else {
+			if (fSourceRectilinear) {
+				if (var->num_dims() == 1) {
+					_EXCEPTIONT("Expected rectilinear source data to be stored in 2D");
+				}
+
+				vecDimsOut.Allocate(var->num_dims()-1);
+			} else {
+				vecDimsOut.Allocate(var->num_dims());
+			}
+
+			vecDimsOut[vecDimsOut.GetRows()-1] = dim0;
+		}
+
+		int nFreeDims = var->num_dims() - m_vecSourceDimSizes.size();
+
+		// Verify map is compatible with source variable
+		if (fSourceRectilinear) {
+			if (var->get_dim(var->num_dims()-2)->size() != m_vecSourceDimSizes[0]) {
+				_EXCEPTION4("Error: Source variable \"%s\" has inconsistent dimension size "
+					"for this map in dimension \"%s\".  Expected %i, found %i.",
+					var->name(),
+					var->get_dim(var->num_dims()-2)->name(),
+					m_vecSourceDimSizes[0],
+					var->get_dim(var->num_dims()-2)->size());
+			}
+			if (var->get_dim(var->num_dims()-1)->size() != m_vecSourceDimSizes[1]) {
+				_EXCEPTION4("Error: Source variable \"%s\" has inconsistent dimension size "
+					"for this map in dimension \"%s\".  Expected %i, found %i.",
+					var->name(),
+					var->get_dim(var->num_dims()-1)->name(),
+					m_vecSourceDimSizes[1],
+					var->get_dim(var->num_dims()-1)->size());
+			}
+
+		} else {
+			if (var->get_dim(var->num_dims()-1)->size() != nSourceCount) {
+				_EXCEPTION4("Error: Source variable \"%s\" has inconsistent dimension size "
+					"for this map in dimension \"%s\".  Expected %i, found %i.",
+					var->name(),
+					var->get_dim(var->num_dims()-1)->name(),
+					nSourceCount,
+					var->get_dim(var->num_dims()-1)->size());
+			}
+		}
+
+		// Add any missing dimension variables to target file
+		DataArray1D<long> & vecDimSizes = plan.vecDimSizes;
+		vecDimSizes.Allocate(nFreeDims);
+
+		for (int d = 0; d < nFreeDims; d++) {
+			vecDims[d] = var->get_dim(d);
+
+			long nDimSize = vecDims[d]->size();
+			std::string strDimName = vecDims[d]->name();
+
+			vecDimSizes[d] = nDimSize;
+			nVarTotalEntries *= nDimSize;
+
+			vecDimsOut[d] =
+				NcFile_GetDimIfExists(
+					ncTarget,
+					strDimName.c_str(),
+					nDimSize);
+
+			// Copy over associated variable, if it exists
+			NcVar * varAssocDimSource =
+				ncSource.get_var(strDimName.c_str());
+			if (varAssocDimSource != NULL) {
+				NcVar * varAssocDimTarget =
+					ncTarget.get_var(strDimName.c_str());
+				if (varAssocDimTarget == NULL) {
+					CopyNcVar(ncSource, ncTarget, strDimName);
+				}
+
+				NcAtt * attAssocDimBounds =
+					varAssocDimSource->get_att("bounds");
+				if (attAssocDimBounds != NULL) {
+					NcVar * varAssocDimBoundsSource =
+						ncSource.get_var(attAssocDimBounds->as_string(0));
+					NcVar * varAssocDimBoundsTarget =
+						ncTarget.get_var(attAssocDimBounds->as_string(0));
+					if ((varAssocDimBoundsSource != NULL) &&
+					    (varAssocDimBoundsTarget == NULL)
+					) {
+						CopyNcVar(
+							ncSource, ncTarget,
+							attAssocDimBounds->as_string(0));
+					}
+				}
+			}
+		}
+
+		// Create new output variable
+		NcVar * varOut;
+		if (fTargetDouble) {
+			varOut =
+				ncTarget.add_var(
+					vecVariableList[v].c_str(),
+					ncDouble,
+					vecDimsOut.GetRows(),
+					(const NcDim**)&(vecDimsOut[0]));
+
+		} else {
+			varOut =
+				ncTarget.add_var(
+					vecVariableList[v].c_str(),
+					ncFloat,
+					vecDimsOut.GetRows(),
+					(const NcDim**)&(vecDimsOut[0]));
+		}
+
+		if (varOut == NULL) {
+			_EXCEPTION1("Cannot create variable \"%s\" in output file",
+				vecVariableList[v].c_str());
+		}
+
+		CopyNcVarAttributes(var, varOut);
+
+		// Fix type of _FillValue
+		{
+			NcAtt * attFillValue = varOut->get_att("_FillValue");
+			if (attFillValue != NULL) {
+				if ((attFillValue->type() == ncFloat) &&
+				    (varOut->type() == ncDouble)
+				) {
+					double dFillValue = attFillValue->as_double(0);
+					attFillValue->remove();
+					varOut->add_att("_FillValue", dFillValue);
+
+				} else if (
+				    (attFillValue->type() == ncDouble) &&
+				    (varOut->type() == ncFloat)
+				) {
+					float flFillValue = attFillValue->as_float(0);
+					attFillValue->remove();
+					varOut->add_att("_FillValue", flFillValue);
+
+				} else if (attFillValue->type() != varOut->type()) {
+					_EXCEPTION1("Type incompatibility between inherited attribute"
+						" \"_FillValue\" and variable \"%s\"", varOut->name());
+				}
+			}
+		}
+
+		// Source and output counts
+		DataArray1D<long> nCountsIn(vecDims.GetRows());
+		DataArray1D<long> nCountsOut(vecDimsOut.GetRows());
+
+		// Get size
+		DataArray1D<long> & nGet = plan.nGet;
+		nGet.Allocate(nCountsIn.GetRows());
+		for (int d = 0; d < nGet.GetRows()-1; d++) {
+			nGet[d] = 1;
+		}
+		if (fSourceRectilinear) {
+			nGet[nGet.GetRows()-2] = m_vecSourceDimSizes[0];
+			nGet[nGet.GetRows()-1] = m_vecSourceDimSizes[1];
+
+		} else {
+			nGet[nGet.GetRows()-1] = nSourceCount;
+		}
+
+		// Put size
+		DataArray1D<long> & nPut = plan.nPut;
+		nPut.Allocate(nCountsOut.GetRows());
+		for (int d = 0; d < nPut.GetRows()-1; d++) {
+			nPut[d] = 1;
+		}
+		if (fTargetRectilinear) {
+			nPut[nPut.GetRows()-2] = m_vecTargetDimSizes[0];
+			nPut[nPut.GetRows()-1] = m_vecTargetDimSizes[1];
+		} else {
+			nPut[nPut.GetRows()-1] = nTargetCount;
+		}
+
+		// Set up reading and writing of this variable
+		OfflineMapApplyVariable & applyvar = plan.applyvar;
+		applyvar.var = var;
+		applyvar.varOut = varOut;
+		applyvar.pvecDimSizes = &vecDimSizes;
+		applyvar.pnGet = &nGet;
+		applyvar.pnPut = &nPut;
+		applyvar.nCountsIn.Allocate(nCountsIn.GetRows());
+		applyvar.nCountsOut.Allocate(nCountsOut.GetRows());
+		applyvar.psupport = psupport;
+		if (psupport != NULL) {
+			applyvar.nGetHyperslab = nGet;
+		}
+		applyvar.pdSourceAreas = pdSourceReadAreas;
+		applyvar.pdTargetAreas = &m_dTargetAreas;
+		applyvar.nSourceCount = nSourceReadCount;
+		applyvar.nTargetCount = nTargetCount;
+		applyvar.fTargetDouble = fTargetDouble;
+		applyvar.flFillValue = flFillValue;
+		applyvar.dFillValue = dFillValue;
+		applyvar.fRenormalize = fRenormalize;
+		applyvar.fHasValidReference = false;
+
+		// Float data written as float is remapped directly in single
+		// precision, with products accumulated in double precision
+		applyvar.fSinglePrecision = (var->type() == ncFloat) && (!fTargetDouble);
+
+		if (psupport != NULL) {
+			plan.nDataInSize = nSourceReadCount;
+		} else {
+			plan.nDataInSize = nSourceSliceSize;
+		}
+		plan.nDataOutSize = nTargetSliceSize;
+
+		// Slices are remapped in blocks, so that the map is only streamed
+		// from memory once for each block
+		int nBlockSize = OfflineMapApplyBlockSize;
+		if (nBlockSize > nVarTotalEntries) {
+			nBlockSize = nVarTotalEntries;
+		}
+
+		int nBlocks = 1;
+		if (nBlockSize > 0) {
+			nBlocks = (nVarTotalEntries + nBlockSize - 1) / nBlockSize;
+		}
+
+		// When there is more than one block, two blocks are used so that
+		// reading and writing of neighboring blocks overlaps the
+		// application of the map to the current block
+		size_t sBlockEntrySize = sizeof(double);
+		if (applyvar.fSinglePrecision) {
+			sBlockEntrySize = sizeof(float);
+		}
+		if (nBlocks > 1) {
+			sBlockEntrySize *= 2;
+		}
+		while ((nBlockSize > 1) &&
+		       (static_cast<size_t>(nBlockSize)
+		           * static_cast<size_t>(nSourceReadCount + nTargetCount)
+		           * sBlockEntrySize > OfflineMapApplyBlockMaximumBytes)
+		) {
+			nBlockSize /= 2;
+			nBlocks = (nVarTotalEntries + nBlockSize - 1) / nBlockSize;
+		}
+
+		plan.nTotalEntries = nVarTotalEntries;
+		plan.nBlockSize = nBlockSize;
+		plan.nBlocks = nBlocks;
+
+		if (fParallelVariables) {
+			continue;
+		}
+
+		plan.AllocateBuffers();
+
+#if defined(TEMPEST_MPIOMP)
+		// Blocks are read and remapped by the other ranks and written here
+		// in order as they arrive
+		if (nMPISize > 1) {
+			int nBlockParams[2] = {nBlockSize, nBlocks};
+			MPI_Bcast(nBlockParams, 2, MPI_INT, 0, MPI_COMM_WORLD);
+
+			OfflineMapApplyBlock block;
+			block.Allocate(
+				applyvar.fSinglePrecision, nSourceReadCount, nTargetCount, nBlockSize);
+
+			for (int iBlock = 0; iBlock < nBlocks; iBlock++) {
+				if (nVarTotalEntries == 0) {
+					break;
+				}
+
+				block.tBegin = iBlock * nBlockSize;
+				block.nBlock =
+					std::min(nBlockSize, nVarTotalEntries - block.tBegin);
+				block.RecvTargetData(
+					applyvar.fSinglePrecision,
+					DistributedBlockOwner(iBlock, nMPISize));
+
+				applyvar.WriteBlock(block);
+			}
+			plan.ReleaseBuffers();
+			AnnounceEndBlock(NULL);
+			continue;
+		}
+#endif
+
+		OfflineMapApplyBlock vecBlocks[2];
+		vecBlocks[0].Allocate(
+			applyvar.fSinglePrecision, nSourceReadCount, nTargetCount, nBlockSize);
+		if (nBlocks > 1) {
+			vecBlocks[1].Allocate(
+				applyvar.fSinglePrecision, nSourceReadCount, nTargetCount, nBlockSize);
+		}
+
+		if (nVarTotalEntries > 0) {
+			applyvar.ReadBlock(
+				vecBlocks[0], 0, std::min(nBlockSize, nVarTotalEntries));
+		}
+
+		for (int iBlock = 0; iBlock < nBlocks; iBlock++) {
+			OfflineMapApplyBlock & blockCurrent = vecBlocks[iBlock % 2];
+			OfflineMapApplyBlock & blockOther = vecBlocks[(iBlock + 1) % 2];
+
+			// NetCDF is not thread safe, so all file operations are
+			// performed by a single thread while the other thread (and any
+			// nested threads) applies the map to the current block
+			bool fIOError = false;
+			std::string strIOError;
+
+#pragma omp parallel sections num_threads(2) if (nBlocks > 1)
+			{
+#pragma omp section
+				{
+					try {
+						if (iBlock > 0) {
+							applyvar.WriteBlock(blockOther);
+						}
+						if (iBlock + 1 < nBlocks) {
+							int tBegin = (iBlock + 1) * nBlockSize;
+							applyvar.ReadBlock(
+								blockOther,
+								tBegin,
+								std::min(nBlockSize, nVarTotalEntries - tBegin));
+						}
+
+					} catch(Exception & e) {
+						fIOError = true;
+						strIOError = e.ToString();
+					}
+				}
+#pragma omp section
+				{
+					applyvar.ApplyBlock(smatDevice, blockCurrent);
+				}
+			}
+
+			if (fIOError) {
+				_EXCEPTION1("%s", strIOError.c_str());
+			}
+		}
+
+		if (nVarTotalEntries > 0) {
+			applyvar.WriteBlock(vecBlocks[(nBlocks - 1) % 2]);
+		}
+		plan.ReleaseBuffers();
+		AnnounceEndBlock(NULL);
+	}
+
+	if (!fParallelVariables) {
+		return;
+	}
+
+	// Blocks of all variables in order, as (variable, block) pairs
+	std::vector< std::pair<int, int> > vecTasks;
+	for (int v = 0; v < vecPlans.size(); v++) {
+		if (vecPlans[v].nTotalEntries == 0) {
+			continue;
+		}
+		for (int iBlock = 0; iBlock < vecPlans[v].nBlocks; iBlock++) {
+			vecTasks.push_back(std::pair<int, int>(v, iBlock));
+		}
+	}
+
+	const int nTasks = vecTasks.size();
+	if (nTasks == 0) {
+		return;
+	}
+
+	// As for a single variable, a single thread performs all file
+	// operations while the map is applied to the current block, but reading
+	// and writing now also overlaps the boundaries between variables.  Each
+	// block is reallocated when it is reused for a different variable.
+	OfflineMapApplyBlock vecBlocks[2];
+	int iBlockVariable[2] = {-1, -1};
+
+	{
+		OfflineMapApplyPlan & plan = vecPlans[vecTasks[0].first];
+		plan.AllocateBuffers();
+		plan.AllocateBlock(vecBlocks[0]);
+		iBlockVariable[0] = vecTasks[0].first;
+		plan.ReadBlock(vecBlocks[0], 0);
+	}
+
+	for (int t = 0; t < nTasks; t++) {
+		OfflineMapApplyBlock & blockCurrent = vecBlocks[t % 2];
+		OfflineMapApplyBlock & blockOther = vecBlocks[(t + 1) % 2];
+
+		bool fIOError = false;
+		std::string strIOError;
+
+#pragma omp parallel sections num_threads(2) if (nTasks > 1)
+		{
+#pragma omp section
+			{
+				try {
+					// Write the previous block
+					if (t > 0) {
+						OfflineMapApplyPlan & plan = vecPlans[vecTasks[t-1].first];
+						if (vecTasks[t-1].second == 0) {
+							AnnounceStartBlock(plan.strName.c_str());
+						}
+						plan.applyvar.WriteBlock(blockOther);
+						if (vecTasks[t-1].second == plan.nBlocks - 1) {
+							plan.ReleaseBuffers();
+							AnnounceEndBlock(NULL);
+						}
+					}
+
+					// Read the next block
+					if (t + 1 < nTasks) {
+						const int v = vecTasks[t+1].first;
+						OfflineMapApplyPlan & plan = vecPlans[v];
+						if (vecTasks[t+1].second == 0) {
+							plan.AllocateBuffers();
+						}
+						if (iBlockVariable[(t + 1) % 2] != v) {
+							plan.AllocateBlock(blockOther);
+							iBlockVariable[(t + 1) % 2] = v;
+						}
+						plan.ReadBlock(blockOther, vecTasks[t+1].second);
+					}
+
+				} catch(Exception & e) {
+					fIOError = true;
+					strIOError = e.ToString();
+				}
+			}
+#pragma omp section
+			{
+				vecPlans[vecTasks[t].first].applyvar.ApplyBlock(
+					smatDevice, blockCurrent);
+			}
+		}
+
+		if (fIOError) {
+			_EXCEPTION1("%s", strIOError.c_str());
+		}
+	}
+
+	// Write the last block
+	{
+		OfflineMapApplyPlan & plan = vecPlans[vecTasks[nTasks-1].first];
+		if (vecTasks[nTasks-1].second == 0) {
+			AnnounceStartBlock(plan.strName.c_str());
+		}
+		plan.applyvar.WriteBlock(vecBlocks[(nTasks - 1) % 2]);
+		plan.ReleaseBuffers();
+		AnnounceEndBlock(NULL);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+#if defined(TEMPEST_MPIOMP)
+void OfflineMap::ApplyDistributedWorker(
+	const std::string & strSourceDataFile,
+	bool fTargetDouble
+) {
+	int nMPIRank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &nMPIRank);
+
+	int nMPISize;
+	MPI_Comm_size(MPI_COMM_WORLD, &nMPISize);
+
+	// Open source data file
+	NcFile ncSource(strSourceDataFile.c_str(), NcFile::ReadOnly);
+	if (!ncSource.is_valid()) {
+		_EXCEPTION1("Cannot open source data file \"%s\"",
+			strSourceDataFile.c_str());
+	}
+
+	// Number of source and target regions
+	int nSourceCount = m_dSourceAreas.GetRows();
+	int nTargetCount = m_dTargetAreas.GetRows();
+
+	// Convert the map to CSR form for application
+	m_mapRemap.Finalize();
+
+	// Only the part of each source slice referenced by the map is read
+	// when it is small compared to the slice
+	OfflineMapSourceSupport support;
+	support.Initialize(m_mapRemap, m_vecSourceDimSizes, m_dSourceAreas);
+
+	const OfflineMapSourceSupport * psupport = NULL;
+	const SparseMatrix<double> * psmatApply = &m_mapRemap;
+	const DataArray1D<double> * pdSourceReadAreas = &m_dSourceAreas;
+	int nSourceReadCount = nSourceCount;
+
+	if (support.IsPartial()) {
+		psupport = &support;
+		psmatApply = &(support.GetCompactMatrix());
+		pdSourceReadAreas = &(support.GetCompactAreas());
+		nSourceReadCount = support.GetCompactCount();
+	}
+
+	SparseMatrixDevice<double> smatDevice(*psmatApply, m_fReorderForApply);
+
+	// Size of a single slice of source data
+	int nSourceSliceSize = nSourceCount;
+	if (m_vecSourceDimSizes.size() != 1) {
+		nSourceSliceSize = m_vecSourceDimSizes[0] * m_vecSourceDimSizes[1];
+	}
+
+	// Variable list, as determined by rank 0
+	std::vector<std::string> vecVariableList;
+	BroadcastStringList(vecVariableList);
+
+	for (int v = 0; v < vecVariableList.size(); v++) {
+		NcVar * var = ncSource.get_var(vecVariableList[v].c_str());
+		if (var == NULL) {
+			_EXCEPTION1("Variable \"%s\" does not exist in source file",
+				vecVariableList[v].c_str());
+		}
+
+		// Check for _FillValue
+		float flFillValue = m_flFillValueOverride;
+		double dFillValue = m_dFillValueOverride;
+		GetVariableFillValues(var, flFillValue, dFillValue);
+
+		// Sizes of the free dimensions
+		int nFreeDims = var->num_dims() - m_vecSourceDimSizes.size();
+		if (nFreeDims < 0) {
+			_EXCEPTION1("Source variable \"%s\" has too few dimensions",
+				var->name());
+		}
+
+		int nVarTotalEntries = 1;
+		DataArray1D<long> vecDimSizes(nFreeDims);
+		for (int d = 0; d < nFreeDims; d++) {
+			vecDimSizes[d] = var->get_dim(d)->size();
+			nVarTotalEntries *= vecDimSizes[d];
+		}
+
+		// Get size
+		DataArray1D<long> nGet(var->num_dims());
+		for (int d = 0; d < nGet.GetRows()-1; d++) {
+			nGet[d] = 1;
+		}
+		if (m_vecSourceDimSizes.size() == 2) {
+			nGet[nGet.GetRows()-2] = m_vecSourceDimSizes[0];
+			nGet[nGet.GetRows()-1] = m_vecSourceDimSizes[1];
+		} else {
+			nGet[nGet.GetRows()-1] = nSourceCount;
+		}
+
+		// Set up reading of this variable
+		OfflineMapApplyVariable applyvar;
+		applyvar.var = var;
+		applyvar.varOut = NULL;
+		applyvar.pvecDimSizes = &vecDimSizes;
+		applyvar.pnGet = &nGet;
+		applyvar.pnPut = NULL;
+		applyvar.nCountsIn.Allocate(nGet.GetRows());
+		applyvar.psupport = psupport;
+		if (psupport != NULL) {
+			applyvar.nGetHyperslab = nGet;
+		}
+		applyvar.pdSourceAreas = pdSourceReadAreas;
+		applyvar.pdTargetAreas = &m_dTargetAreas;
+		applyvar.nSourceCount = nSourceReadCount;
+		applyvar.nTargetCount = nTargetCount;
+		applyvar.fTargetDouble = fTargetDouble;
+		applyvar.flFillValue = flFillValue;
+		applyvar.dFillValue = dFillValue;
+		applyvar.fRenormalize = false;
+		applyvar.fHasValidReference = false;
+		applyvar.fSinglePrecision = (var->type() == ncFloat) && (!fTargetDouble);
+
+		if (psupport != NULL) {
+			applyvar.dataIn.Allocate(nSourceReadCount);
+		} else {
+			applyvar.dataIn.Allocate(nSourceSliceSize);
+		}
+		applyvar.dataInDouble.Allocate(nSourceReadCount);
+
+		// Blocking, as determined by rank 0
+		int nBlockParams[2];
+		MPI_Bcast(nBlockParams, 2, MPI_INT, 0, MPI_COMM_WORLD);
+
+		const int nBlockSize = nBlockParams[0];
+		const int nBlocks = nBlockParams[1];
+
+		if (nVarTotalEntries == 0) {
+			continue;
+		}
+
+		OfflineMapApplyBlock block;
+		block.Allocate(
+			applyvar.fSinglePrecision, nSourceReadCount, nTargetCount, nBlockSize);
+
+		for (int iBlock = 0; iBlock < nBlocks; iBlock++) {
+			if (DistributedBlockOwner(iBlock, nMPISize) != nMPIRank) {
+				continue;
+			}
+
+			int tBegin = iBlock * nBlockSize;
+			applyvar.ReadBlock(
+				block,
+				tBegin,
+				std::min(nBlockSize, nVarTotalEntries - tBegin));
+
+			applyvar.ApplyBlock(smatDevice, block);
+
+			block.SendTargetData(applyvar.fSinglePrecision, 0);
+		}
+	}
+}
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OfflineMap::Read(
+	const std::string & strSource,
+	std::map<std::string, std::string> * pmapAttributes,
+	NcFile::FileFormat * peFileFormat
+) {
+	// Native binary map files are memory mapped rather than decoded
+	if (IsBinaryMapFile(strSource)) {
+		ReadBinary(strSource, pmapAttributes);
+		if (peFileFormat != NULL) {
+			*peFileFormat = NcFile::Netcdf4;
+		}
+		return;
+	}
+
+	NcFile ncMap(strSource.c_str(), NcFile::ReadOnly);
+	if (!ncMap.is_valid()) {
+		_EXCEPTION1("Unable to open input map file \"%s\"",
+			strSource.c_str());
+	}
+
+	// Read netcdf file format
+	NcFile::FileFormat eFileFormat = ncMap.get_format();
+
+	if (peFileFormat != NULL) {
+		*peFileFormat = eFileFormat;
+	}
+
+	// Read input dimensions entries
+	NcDim * dimSrcGridRank = ncMap.get_dim("src_grid_rank");
+	if (dimSrcGridRank == NULL) {
+		_EXCEPTION1("Map file \"%s\" does not contain variable"
+			"\"src_grid_rank\"", strSource.c_str());
+	}
+
+	NcDim * dimDstGridRank = ncMap.get_dim("dst_grid_rank");
+	if (dimDstGridRank == NULL) {
+		_EXCEPTION1("Map file \"%s\" does not contain variable"
+			"\"dst_grid_rank\"", strSource.c_str());
+	}
+
+	int nSrcGridDims = (int)(dimSrcGridRank->size());
+	int nDstGridDims = (int)(dimDstGridRank->size());
+
+	NcVar * varSrcGridDims = ncMap.get_var("src_grid_dims");
+	if (varSrcGridDims == NULL) {
+		_EXCEPTION1("Map file \"%s\" does not contain variable"
+			"\"src_grid_dims\"", strSource.c_str());
+	}
+
+	NcVar * varDstGridDims = ncMap.get_var("dst_grid_dims");
+	if (varSrcGridDims == NULL) {
+		_EXCEPTION1("Map file \"%s\" does not contain variable"
+			"\"dst_grid_dims\"", strSource.c_str());
+	}
+
+	m_vecSourceDimSizes.resize(nSrcGridDims);
+	m_vecSourceDimNames.resize(nSrcGridDims);
+
+	m_vecTargetDimSizes.resize(nDstGridDims);
+	m_vecTargetDimNames.resize(nDstGridDims);
+
+	varSrcGridDims->get(&(m_vecSourceDimSizes[0]), nSrcGridDims);
+	varDstGridDims->get(&(m_vecTargetDimSizes[0]), nDstGridDims);
+
+	for (int i = 0; i < nSrcGridDims/2; i++) {
+		int iTemp = m_vecSourceDimSizes[i];
+		m_vecSourceDimSizes[i] = m_vecSourceDimSizes[nSrcGridDims - i - 1];
+		m_vecSourceDimSizes[nSrcGridDims - i - 1] = iTemp;
+	}
+
+	for (int i = 0; i < nSrcGridDims; i++) {
+		char szDim[64];
+		sprintf(szDim, "name%i", nSrcGridDims - i - 1);
+		NcAtt * attDim = varSrcGridDims->get_att(szDim);
+		if (attDim != NULL) {
+			m_vecSourceDimNames[i] = attDim->as_string(0);
+		} else {
+			sprintf(szDim, "dim%i", nSrcGridDims - i - 1);
+			m_vecSourceDimNames[i] = szDim;
+		}
+	}
+
+	for (int i = 0; i < nDstGridDims/2; i++) {
+		int iTemp = m_vecTargetDimSizes[i];
+		m_vecTargetDimSizes[i] = m_vecTargetDimSizes[nDstGridDims - i - 1];
+		m_vecTargetDimSizes[nDstGridDims - i - 1] = iTemp;
+	}
+
+	for (int i = 0; i < nDstGridDims; i++) {
+		char szDim[64];
+		sprintf(szDim, "name%i", nDstGridDims - i - 1);
+		NcAtt * attDim = varDstGridDims->get_att(szDim);
+		if (attDim != NULL) {
+			m_vecTargetDimNames[i] = attDim->as_string(0);
+		} else {
+			sprintf(szDim, "dim%i", nDstGridDims - i - 1);
+			m_vecTargetDimNames[i] = szDim;
+		}
+	}
+
+	// Source and Target mesh resolutions
+	NcDim * dimNA = ncMap.get_dim("n_a");
+	if (dimNA == NULL) {
+		_EXCEPTIONT("Input map missing dimension \"n_a\"");
+	}
+
+	NcDim * dimNB = ncMap.get_dim("n_b");
+	if (dimNB == NULL) {
+		_EXCEPTIONT("Input map missing dimension \"n_b\"");
+	}
+
+	int nA = dimNA->size();
+	int nB = dimNB->size();
+
+	// Vertex arrays are optional
+	NcDim * dimNVA = ncMap.get_dim("nv_a");
+	NcDim * dimNVB = ncMap.get_dim("nv_b");
+
+	int nVA = (dimNVA == NULL)?(0):(dimNVA->size());
+	int nVB = (dimNVB == NULL)?(0):(dimNVB->size());
+
+	if (!m_fReadVertexArrays) {
+		nVA = 0;
+		nVB = 0;
+	}
+
+	const int nCA = (m_fReadSourceCenters)?(nA):(0);
+
+	m_pmeshSourceCoordinates = NULL;
+	m_pmeshTargetCoordinates = NULL;
+
+	// Read coordinates
+	NcVar * varYCA = ncMap.get_var("yc_a");
+	NcVar * varYCB = ncMap.get_var("yc_b");
+
+	NcVar * varXCA = ncMap.get_var("xc_a");
+	NcVar * varXCB = ncMap.get_var("xc_b");
+
+	NcVar * varYVA = ncMap.get_var("yv_a");
+	NcVar * varYVB = ncMap.get_var("yv_b");
+
+	NcVar * varXVA = ncMap.get_var("xv_a");
+	NcVar * varXVB = ncMap.get_var("xv_b");
+
+	if (varYCA == NULL) {
+		_EXCEPTION1("Map file \"%s\" does not contain variable \"yc_a\":"
+			"\nPossibly an earlier version of map",
+			strSource.c_str());
+	}
+	if (varYCB == NULL) {
+		_EXCEPTION1("Map file \"%s\" does not contain variable \"yc_b\":"
+			"\nPossibly an earlier version of map",
+			strSource.c_str());
+	}
+	if (varXCA == NULL) {
+		_EXCEPTION1("Map file \"%s\" does not contain variable \"xc_a\":"
+			"\nPossibly an earlier version of map",
+			strSource.c_str());
+	}
+	if (varXCB == NULL) {
+		_EXCEPTION1("Map file \"%s\" does not contain variable \"xc_b\":"
+			"\nPossibly an earlier version of map",
+			strSource.c_str());
+	}
+	if ((nVA != 0) && ((varXVA == NULL) || (varYVA == NULL))) {
+		_EXCEPTION1("Map file \"%s\" does not contain variables \"xv_a\" "
+			"and \"yv_a\"", strSource.c_str());
+	}
+	if ((nVB != 0) && ((varXVB == NULL) || (varYVB == NULL))) {
+		_EXCEPTION1("Map file \"%s\" does not contain variables \"xv_b\" "
+			"and \"yv_b\"", strSource.c_str());
+	}
+
+	m_dSourceCenterLat.Allocate(nCA);
+	m_dTargetCenterLat.Allocate(nB);
+
+	m_dSourceCenterLon.Allocate(nCA);
+	m_dTargetCenterLon.Allocate(nB);
+
+	m_dSourceVertexLat.Allocate(nA, nVA);
+	m_dTargetVertexLat.Allocate(nB, nVB);
+
+	m_dSourceVertexLon.Allocate(nA, nVA);
+	m_dTargetVertexLon.Allocate(nB, nVB);
+
+	if (nCA != 0) {
+		varYCA->get(&(m_dSourceCenterLat[0]), nA);
+		varXCA->get(&(m_dSourceCenterLon[0]), nA);
+	}
+
+	varYCB->get(&(m_dTargetCenterLat[0]), nB);
+	varXCB->get(&(m_dTargetCenterLon[0]), nB);
+
+	if (nVA != 0) {
+		varYVA->get(&(m_dSourceVertexLat[0][0]), nA, nVA);
+		varXVA->get(&(m_dSourceVertexLon[0][0]), nA, nVA);
+	}
+	if (nVB != 0) {
+		varYVB->get(&(m_dTargetVertexLat[0][0]), nB, nVB);
+		varXVB->get(&(m_dTargetVertexLon[0][0]), nB, nVB);
+	}
+
+	// Read vector centers and bounds
+	NcDim * dimLatB = ncMap.get_dim("lat_b");
+	NcDim * dimLonB = ncMap.get_dim("lon_b");
+
+	if ((dimLatB != NULL) && (dimLonB != NULL)) {
+		NcVar * varLatCB = ncMap.get_var("latc_b");
+		NcVar * varLonCB = ncMap.get_var("lonc_b");
+
+		m_dVectorTargetCenterLat.Allocate(dimLatB->size());
+		m_dVectorTargetCenterLon.Allocate(dimLonB->size());
+
+		varLatCB->get(&(m_dVectorTargetCenterLat[0]), dimLatB->size());
+		varLonCB->get(&(m_dVectorTargetCenterLon[0]), dimLonB->size());
+
+		NcVar * varLatBounds = ncMap.get_var("lat_bnds");
+		NcVar * varLonBounds = ncMap.get_var("lon_bnds");
+
+		m_dVectorTargetBoundsLat.Allocate(dimLatB->size(), 2);
+		m_dVectorTargetBoundsLon.Allocate(dimLonB->size(), 2);
+
+		varLatBounds->get(&(m_dVectorTargetBoundsLat[0][0]),
+			dimLatB->size(), 2);
+		varLonBounds->get(&(m_dVectorTargetBoundsLon[0][0]),
+			dimLonB->size(), 2);
+	}
+
+	// Read areas
+	m_dSourceAreas.Allocate(nA);
+	m_dTargetAreas.Allocate(nB);
+
+	NcVar * varAreaA = ncMap.get_var("area_a");
+	if (varAreaA == NULL) {
+		_EXCEPTION1("Map file \"%s\" does not contain variable \"area_a\"",
+			strSource.c_str());
+	}
+	varAreaA->get(&(m_dSourceAreas[0]), nA);
+
+	NcVar * varAreaB = ncMap.get_var("area_b");
+	if (varAreaB == NULL) {
+		_EXCEPTION1("Map file \"%s\" does not contain variable \"area_b\"",
+			strSource.c_str());
+	}
+	varAreaB->get(&(m_dTargetAreas[0]), nB);
+
+	// Read masks
+	NcVar * varMaskA = ncMap.get_var("mask_a");
+	if (varMaskA != NULL) {
+		m_iSourceMask.Allocate(nA);
+		varMaskA->get(&(m_iSourceMask[0]), nA);
+	}
+
+	NcVar * varMaskB = ncMap.get_var("mask_b");
+	if (varMaskB != NULL) {
+		m_iTargetMask.Allocate(nB);
+		varMaskB->get(&(m_iTargetMask[0]), nB);
+	}
+
+	// Read SparseMatrix entries
+	NcDim * dimNS = ncMap.get_dim("n_s");
+	if (dimNS == NULL) {
+		_EXCEPTION1("Map file \"%s\" does not contain dimension \"n_s\"",
+			strSource.c_str());
+	}
+
+	NcVar * varRow = ncMap.get_var("row");
+	if (varRow == NULL) {
+		_EXCEPTION1("Map file \"%s\" does not contain variable \"row\"",
+			strSource.c_str());
+	}
+
+	NcVar * varCol = ncMap.get_var("col");
+	if (varRow == NULL) {
+		_EXCEPTION1("Map file \"%s\" does not contain variable \"col\"",
+			strSource.c_str());
+	}
+
+	NcVar * varS = ncMap.get_var("S");
+	if (varRow == NULL) {
+		_EXCEPTION1("Map file \"%s\" does not contain variable \"S\"",
+			strSource.c_str());
+	}
+
+	// The number of nonzeros may exceed 2^31
+	long nS = dimNS->size();
+
+	DataArray1D<int> vecRow;
+	DataArray1D<int> vecCol;
+	DataArray1D<double> vecS;
 
-		NcVar * varLat = ncTarget.get_var("lat");
-		if (varLat == NULL) {
-			varLat = ncTarget.add_var("lat", ncDouble, dim0, dim1);
-			if (m_dTargetCenterLat.GetRows() != dim0->size() * dim1->size()) {
-				_EXCEPTION3("TargetCenterLat / NCol dimension size mismatch (%i, %i x %i)",
-					m_dTargetCenterLat.GetRows(), dim0->size(), dim1->size());
-			}
-			if (varLat == NULL) {
-				_EXCEPTIONT("Cannot create variable \"lat\" in target file");
-			}
+	if (m_vecReadTargetRows.size() == 0) {
+		vecRow.Allocate(nS);
+		vecCol.Allocate(nS);
+		vecS.Allocate(nS);
 
-			varLat->put(
-				&(m_dTargetCenterLat[0]),
-				dim0->size(),
-				dim1->size());
+		varRow->set_cur((long)0);
+		varRow->get(&(vecRow[0]), nS);
 
-			//varLat->add_att("bounds", "lat_bnds");
-			varLat->add_att("units", "degrees_north");
-			varLat->add_att("axis", "Y");
-			varLat->add_att("long_name", "latitude");
-			varLat->add_att("standard_name", "latitude");
+		varCol->set_cur((long)0);
+		varCol->get(&(vecCol[0]), nS);
 
-		} else {
-			if (varLat->num_dims() != 2) {
-				_EXCEPTIONT("\"lat\" variable mismatch");
-			}
-			if (varLat->get_dim(0)->size() != dim0->size()) {
-				_EXCEPTIONT("\"lat\" variable mismatch");
-			}
-			if (varLat->get_dim(1)->size() != dim1->size()) {
-				_EXCEPTIONT("\"lat\" variable mismatch");
-			}
-		}
-	}
+		varS->set_cur((long)0);
+		varS->get(&(vecS[0]), nS);
 
-	// Loop through all variables
-	for (int v = 0; v < vecVariableList.size(); v++) {
-		NcVar * var = ncSource.get_var(vecVariableList[v].c_str());
-		if (var == NULL) {
-			_EXCEPTION1("Variable \"%s\" does not exist in source file",
-				vecVariableList[v].c_str());
+		// Decrement vecRow and vecCol
+		for (size_t i = 0; i < vecRow.GetRows(); i++) {
+			vecRow[i]--;
+			vecCol[i]--;
 		}
 
-		AnnounceStartBlock(vecVariableList[v].c_str());
-
-		// Check for _FillValue
-		float flFillValue = m_flFillValueOverride;
-		double dFillValue = m_dFillValueOverride;
-		for (int a = 0; a < var->num_atts(); a++) {
-			NcAtt * att = var->get_att(a);
-			if ((strcmp(att->name(), "_FillValue") == 0) ||
-			    (strcmp(att->name(), "missing_value") == 0)
-			) {
-				if (att->type() == ncDouble) {
-					dFillValue = att->as_double(0);
-				} else if (att->type() == ncFloat) {
-					flFillValue = att->as_float(0);
-				} else {
-					_EXCEPTION1("Invalid type for attribute \"%s\"", att->name());
-				}
+	// Only keep entries in the selected rows, reading the entries in chunks
+	} else {
+		std::vector<char> vecRowSelected(nB, 0);
+		for (size_t i = 0; i < m_vecReadTargetRows.size(); i++) {
+			const int ix = m_vecReadTargetRows[i];
+			if ((ix < 0) || (ix >= nB)) {
+				_EXCEPTION2("Target index %i out of range in map "
+					"with %i target degrees of freedom", ix + 1, nB);
 			}
+			vecRowSelected[ix] = 1;
 		}
 
-		// Construct an array of dimensions for this variable
-		int nVarTotalEntries = 1;
+		std::vector<int> vecRowKeep;
+		std::vector<int> vecColKeep;
+		std::vector<double> vecSKeep;
 
-		DataArray1D<NcDim *> vecDims(var->num_dims());
+		const long nChunkMax = std::min(nS,
+			static_cast<long>(GetIOBufferItems(
+				OfflineMapReadChunkEntries,
+				2 * sizeof(int) + sizeof(double))));
 
-		DataArray1D<NcDim *> vecDimsOut;
-		if (fTargetRectilinear) {
+		DataArray1D<int> vecRowChunk(nChunkMax);
+		DataArray1D<int> vecColChunk(nChunkMax);
+		DataArray1D<double> vecSChunk(nChunkMax);
 
-			if (fSourceRectilinear) {
-				vecDimsOut.Allocate(var->num_dims());
-			} else {
-				vecDimsOut.Allocate(var->num_dims()+1);
-			}
+		for (long lBegin = 0; lBegin < nS; lBegin += nChunkMax) {
+			const long nChunk = std::min(nChunkMax, nS - lBegin);
 
-			vecDimsOut[vecDimsOut.GetRows()-2] = dim0;
-			vecDimsOut[vecDimsOut.GetRows()-1] = dim1;
+			varRow->set_cur(lBegin);
+			varRow->get(&(vecRowChunk[0]), nChunk);
 
-		} else {
-			if (fSourceRectilinear) {
-				if (var->num_dims() == 1) {
-					_EXCEPTIONT("Expected rectilinear source data to be stored in 2D");
+			// Rows are usually sorted, so most chunks can be skipped
+			// without reading the columns and weights
+			bool fChunkSelected = false;
+			for (long i = 0; i < nChunk; i++) {
+				const int iRow = vecRowChunk[i] - 1;
+				if ((iRow >= 0) && (iRow < nB) && vecRowSelected[iRow]) {
+					fChunkSelected = true;
+					break;
 				}
+			}
+			if (!fChunkSelected) {
+				continue;
+			}
 
-				vecDimsOut.Allocate(var->num_dims()-1);
-			} else {
-				vecDimsOut.Allocate(var->num_dims());
+			varCol->set_cur(lBegin);
+			varCol->get(&(vecColChunk[0]), nChunk);
+
+			varS->set_cur(lBegin);
+			varS->get(&(vecSChunk[0]), nChunk);
+
+			for (long i = 0; i < nChunk; i++) {
+				const int iRow = vecRowChunk[i] - 1;
+				if ((iRow >= 0) && (iRow < nB) && vecRowSelected[iRow]) {
+					vecRowKeep.push_back(iRow);
+					vecColKeep.push_back(vecColChunk[i] - 1);
+					vecSKeep.push_back(vecSChunk[i]);
+				}
 			}
+		}
 
-			vecDimsOut[vecDimsOut.GetRows()-1] = dim0;
+		vecRow.Allocate(vecRowKeep.size());
+		vecCol.Allocate(vecColKeep.size());
+		vecS.Allocate(vecSKeep.size());
+
+		for (size_t i = 0; i < vecRowKeep.size(); i++) {
+			vecRow[i] = vecRowKeep[i];
+			vecCol[i] = vecColKeep[i];
+			vecS[i] = vecSKeep[i];
 		}
+	}
 
-		int nFreeDims = var->num_dims() - m_vecSourceDimSizes.size();
+	// Set the entries of the map in CSR form
+	m_mapRemap.SetFinalizedEntries(vecRow, vecCol, vecS);
 
-		// Verify map is compatible with source variable
-		if (fSourceRectilinear) {
-			if (var->get_dim(var->num_dims()-2)->size() != m_vecSourceDimSizes[0]) {
-				_EXCEPTION4("Error: Source variable \"%s\" has inconsistent dimension size "
-					"for this map in dimension \"%s\".  Expected %i, found %i.",
-					var->name(),
-					var->get_dim(var->num_dims()-2)->name(),
-					m_vecSourceDimSizes[0],
-					var->get_dim(var->num_dims()-2)->size());
-			}
-			if (var->get_dim(var->num_dims()-1)->size() != m_vecSourceDimSizes[1]) {
-				_EXCEPTION4("Error: Source variable \"%s\" has inconsistent dimension size "
-					"for this map in dimension \"%s\".  Expected %i, found %i.",
-					var->name(),
-					var->get_dim(var->num_dims()-1)->name(),
-					m_vecSourceDimSizes[1],
-					var->get_dim(var->num_dims()-1)->size());
-			}
+	m_pmmapBinary.reset();
 
-		} else {
-			if (var->get_dim(var->num_dims()-1)->size() != nSourceCount) {
-				_EXCEPTION4("Error: Source variable \"%s\" has inconsistent dimension size "
-					"for this map in dimension \"%s\".  Expected %i, found %i.",
-					var->name(),
-					var->get_dim(var->num_dims()-1)->name(),
-					nSourceCount,
-					var->get_dim(var->num_dims()-1)->size());
+	// Load file attributes
+	if (pmapAttributes != NULL) {
+		for (int a = 0; a < ncMap.num_atts(); a++) {
+			NcAtt * attGlobal = ncMap.get_att(a);
+			if (attGlobal == NULL) {
+				_EXCEPTIONT("Logic error");
 			}
+
+			std::pair<std::string, std::string> prAttribute(
+				attGlobal->name(),
+				attGlobal->as_string(0));
+
+			pmapAttributes->insert(prAttribute);
 		}
+	}
+}
 
-		// Add any missing dimension variables to target file
-		DataArray1D<long> vecDimSizes(nFreeDims);
+///////////////////////////////////////////////////////////////////////////////
 
-		for (int d = 0; d < nFreeDims; d++) {
-			vecDims[d] = var->get_dim(d);
+void OfflineMap::Write(
+	const std::string & strTarget,
+	const std::map<std::string, std::string> & mapAttributes,
+	NcFile::FileFormat eOutputFormat
+) {
+	// The classic formats limit the number of nonzeros to fewer than 2^31
+	const size_t sNonZeros = m_mapRemap.GetNonZeroCount();
+	if ((sNonZeros > static_cast<size_t>(INT_MAX)) &&
+	    (eOutputFormat != NcFile::Netcdf4) &&
+	    (eOutputFormat != NcFile::Netcdf4Classic)
+	) {
+		_EXCEPTION2("Map file \"%s\" has %lu nonzeros and must be written "
+			"in netcdf4 or netcdf4_classic format",
+			strTarget.c_str(), sNonZeros);
+	}
 
-			long nDimSize = vecDims[d]->size();
-			std::string strDimName = vecDims[d]->name();
+	// Temporarily change error reporting
+	NcError error_temp(NcError::verbose_fatal);
 
-			vecDimSizes[d] = nDimSize;
-			nVarTotalEntries *= nDimSize;
+	// Open an output file
+	NcFile ncMap(strTarget.c_str(), NcFile::Replace, NULL, 0, eOutputFormat);
+	if (!ncMap.is_valid()) {
+		_EXCEPTION1("Unable to open output map file \"%s\"",
+			strTarget.c_str());
+	}
 
-			vecDimsOut[d] =
-				NcFile_GetDimIfExists(
-					ncTarget,
-					strDimName.c_str(),
-					nDimSize);
+	// Attributes
+	ncMap.add_att("Title", "TempestRemap Offline Regridding Weight Generator");
 
-			// Copy over associated variable, if it exists
-			NcVar * varAssocDimSource =
-				ncSource.get_var(strDimName.c_str());
-			if (varAssocDimSource != NULL) {
-				NcVar * varAssocDimTarget =
-					ncTarget.get_var(strDimName.c_str());
-				if (varAssocDimTarget == NULL) {
-					CopyNcVar(ncSource, ncTarget, strDimName);
-				}
+	// Map dimensions
+	int nA = (int)(m_dSourceAreas.GetRows());
+	int nB = (int)(m_dTargetAreas.GetRows());
 
-				NcAtt * attAssocDimBounds =
-					varAssocDimSource->get_att("bounds");
-				if (attAssocDimBounds != NULL) {
-					NcVar * varAssocDimBoundsSource =
-						ncSource.get_var(attAssocDimBounds->as_string(0));
-					NcVar * varAssocDimBoundsTarget =
-						ncTarget.get_var(attAssocDimBounds->as_string(0));
-					if ((varAssocDimBoundsSource != NULL) &&
-					    (varAssocDimBoundsTarget == NULL)
-					) {
-						CopyNcVar(
-							ncSource, ncTarget,
-							attAssocDimBounds->as_string(0));
-					}
-				}
-			}
-		}
+	// Write output dimensions entries
+	int nSrcGridDims = (int)(m_vecSourceDimSizes.size());
+	int nDstGridDims = (int)(m_vecTargetDimSizes.size());
 
-		// Create new output variable
-		NcVar * varOut;
-		if (fTargetDouble) {
-			varOut =
-				ncTarget.add_var(
-					vecVariableList[v].c_str(),
-					ncDouble,
-					vecDimsOut.GetRows(),
-					(const NcDim**)&(vecDimsOut[0]));
+	NcDim * dimSrcGridRank = ncMap.add_dim("src_grid_rank", nSrcGridDims);
+	NcDim * dimDstGridRank = ncMap.add_dim("dst_grid_rank", nDstGridDims);
 
-		} else {
-			varOut =
-				ncTarget.add_var(
-					vecVariableList[v].c_str(),
-					ncFloat,
-					vecDimsOut.GetRows(),
-					(const NcDim**)&(vecDimsOut[0]));
-		}
+	NcVar * varSrcGridDims =
+		ncMap.add_var("src_grid_dims", ncInt, dimSrcGridRank);
+	NcVar * varDstGridDims =
+		ncMap.add_var("dst_grid_dims", ncInt, dimDstGridRank);
 
-		if (varOut == NULL) {
-			_EXCEPTION1("Cannot create variable \"%s\" in output file",
-				vecVariableList[v].c_str());
+	char szDim[64];
+	if ((nSrcGridDims == 1) && (m_vecSourceDimSizes[0] != nA)) {
+		varSrcGridDims->put(&nA, 1);
+		varSrcGridDims->add_att("name0", "num_dof");
+
+	} else {
+		for (int i = 0; i < m_vecSourceDimSizes.size(); i++) {
+			varSrcGridDims->set_cur(nSrcGridDims - i - 1);
+			varSrcGridDims->put(&(m_vecSourceDimSizes[i]), 1);
 		}
 
-		CopyNcVarAttributes(var, varOut);
+		for (int i = 0; i < m_vecSourceDimSizes.size(); i++) {
+			sprintf(szDim, "name%i", i);
+			varSrcGridDims->add_att(szDim,
+				m_vecSourceDimNames[nSrcGridDims - i - 1].c_str());
+		}
+	}
 
-		// Fix type of _FillValue
-		{
-			NcAtt * attFillValue = varOut->get_att("_FillValue");
-			if (attFillValue != NULL) {
-				if ((attFillValue->type() == ncFloat) &&
-				    (varOut->type() == ncDouble)
-				) {
-					double dFillValue = attFillValue->as_double(0);
-					attFillValue->remove();
-					varOut->add_att("_FillValue", dFillValue);
+	if ((nDstGridDims == 1) && (m_vecTargetDimSizes[0] != nB)) {
+		varDstGridDims->put(&nB, 1);
+		varDstGridDims->add_att("name0", "num_dof");
 
-				} else if (
-				    (attFillValue->type() == ncDouble) &&
-				    (varOut->type() == ncFloat)
-				) {
-					float flFillValue = attFillValue->as_float(0);
-					attFillValue->remove();
-					varOut->add_att("_FillValue", flFillValue);
+	} else {
+		for (int i = 0; i < m_vecTargetDimSizes.size(); i++) {
+			varDstGridDims->set_cur(nDstGridDims - i - 1);
+			varDstGridDims->put(&(m_vecTargetDimSizes[i]), 1);
+		}
 
-				} else if (attFillValue->type() != varOut->type()) {
-					_EXCEPTION1("Type incompatibility between inherited attribute"
-						" \"_FillValue\" and variable \"%s\"", varOut->name());
-				}
-			}
+		for (int i = 0; i < m_vecTargetDimSizes.size(); i++) {
+			sprintf(szDim, "name%i", i);
+			varDstGridDims->add_att(szDim,
+				m_vecTargetDimNames[nDstGridDims - i - 1].c_str());
 		}
+	}
 
-		// Source and output counts
-		DataArray1D<long> nCountsIn(vecDims.GetRows());
-		DataArray1D<long> nCountsOut(vecDimsOut.GetRows());
+	// Source and Target mesh resolutions
+	NcDim * dimNA = ncMap.add_dim("n_a", nA);
+	NcDim * dimNB = ncMap.add_dim("n_b", nB);
 
-		// Get size
-		DataArray1D<long> nGet(nCountsIn.GetRows());
-		for (int d = 0; d < nGet.GetRows()-1; d++) {
-			nGet[d] = 1;
-		}
-		if (fSourceRectilinear) {
-			nGet[nGet.GetRows()-2] = m_vecSourceDimSizes[0];
-			nGet[nGet.GetRows()-1] = m_vecSourceDimSizes[1];
+	// Coordinates of finite-volume meshes that have not been computed are
+	// streamed directly from the mesh
+	const Mesh * pmeshSource = m_pmeshSourceCoordinates;
+	const Mesh * pmeshTarget = m_pmeshTargetCoordinates;
 
-		} else {
-			nGet[nGet.GetRows()-1] = nSourceCount;
-		}
+	if ((pmeshSource != NULL) && (pmeshSource->faces.size() != nA)) {
+		_EXCEPTIONT("Mismatch between source mesh and nA");
+	}
+	if ((pmeshTarget != NULL) && (pmeshTarget->faces.size() != nB)) {
+		_EXCEPTIONT("Mismatch between target mesh and nB");
+	}
 
-		// Put size
-		DataArray1D<long> nPut(nCountsOut.GetRows());
-		for (int d = 0; d < nPut.GetRows()-1; d++) {
-			nPut[d] = 1;
+	// Number of nodes per Face
+	int nSourceNodesPerFace = m_dSourceVertexLon.GetColumns();
+	int nTargetNodesPerFace = m_dTargetVertexLon.GetColumns();
+
+	if (pmeshSource != NULL) {
+		nSourceNodesPerFace = 0;
+		for (int i = 0; i < nA; i++) {
+			nSourceNodesPerFace =
+				std::max(nSourceNodesPerFace,
+					static_cast<int>(pmeshSource->faces[i].edges.size()));
 		}
-		if (fTargetRectilinear) {
-			nPut[nPut.GetRows()-2] = m_vecTargetDimSizes[0];
-			nPut[nPut.GetRows()-1] = m_vecTargetDimSizes[1];
-		} else {
-			nPut[nPut.GetRows()-1] = nTargetCount;
+	}
+	if (pmeshTarget != NULL) {
+		nTargetNodesPerFace = 0;
+		for (int i = 0; i < nB; i++) {
+			nTargetNodesPerFace =
+				std::max(nTargetNodesPerFace,
+					static_cast<int>(pmeshTarget->faces[i].edges.size()));
 		}
+	}
 
-		// Loop through all entries
-		for (int t = 0; t < nVarTotalEntries; t++) {
-
-			long tt = static_cast<long>(t);
-			for (int d = vecDimSizes.GetRows()-1; d >= 0; d--) {
-				nCountsIn[d]  = tt % vecDimSizes[d];
-				nCountsOut[d] = tt % vecDimSizes[d];
-				tt /= vecDimSizes[d];
-			}
+	// Vertex arrays are omitted if requested or unavailable
+	const bool fSourceVertices =
+		m_fWriteVertexArrays && (nSourceNodesPerFace != 0);
+	const bool fTargetVertices =
+		m_fWriteVertexArrays && (nTargetNodesPerFace != 0);
 
-			for (int d = vecDimSizes.GetRows(); d < nCountsIn.GetRows(); d++) {
-				nCountsIn[d] = 0;
-			}
-			for (int d = vecDimSizes.GetRows(); d < nCountsOut.GetRows(); d++) {
-				nCountsOut[d] = 0;
-			}
+	// Write coordinates
+	NcVar * varYCA = ncMap.add_var("yc_a", ncDouble, dimNA);
+	SetNcVarChunking(ncMap, varYCA);
+	NcVar * varYCB = ncMap.add_var("yc_b", ncDouble, dimNB);
+	SetNcVarChunking(ncMap, varYCB);
 
-			// Get the data
-			var->set_cur(&(nCountsIn[0]));
+	NcVar * varXCA = ncMap.add_var("xc_a", ncDouble, dimNA);
+	SetNcVarChunking(ncMap, varXCA);
+	NcVar * varXCB = ncMap.add_var("xc_b", ncDouble, dimNB);
+	SetNcVarChunking(ncMap, varXCB);
 
-			// Load data as Float, cast to Double
-			if (var->type() == ncFloat) {
-				var->get(&(dataIn[0]), &(nGet[0]));
+	varYCA->add_att("units", "degrees");
+	varYCB->add_att("units", "degrees");
 
-				if (flFillValue != 0.0f) {
-					for (int i = 0; i < nSourceCount; i++) {
-						if (dataIn[i] == flFillValue) {
-							dataInDouble[i] = 0.0;
-						} else {
-							dataInDouble[i] = static_cast<double>(dataIn[i]);
-						}
-					}
+	varXCA->add_att("units", "degrees");
+	varXCB->add_att("units", "degrees");
 
-				} else {
-					for (int i = 0; i < nSourceCount; i++) {
-						dataInDouble[i] = static_cast<double>(dataIn[i]);
-					}
-				}
+	NcVar * varYVA = NULL;
+	NcVar * varXVA = NULL;
+	if (fSourceVertices) {
+		NcDim * dimNVA = ncMap.add_dim("nv_a", nSourceNodesPerFace);
 
-			// Load data as Double
-			} else {
-				var->get(&(dataInDouble[0]), &(nGet[0]));
+		varYVA = ncMap.add_var("yv_a", ncDouble, dimNA, dimNVA);
+		SetNcVarChunking(ncMap, varYVA);
+		varXVA = ncMap.add_var("xv_a", ncDouble, dimNA, dimNVA);
+		SetNcVarChunking(ncMap, varXVA);
 
-				if (dFillValue != 0.0) {
-					for (int i = 0; i < nSourceCount; i++) {
-						if (dataInDouble[i] == dFillValue) {
-							dataInDouble[i] = 0.0;
-						}
-					}
-				}
-			}
+		varYVA->add_att("units", "degrees");
+		varXVA->add_att("units", "degrees");
+	}
 
-			// Announce input mass
-			double dSourceMass = 0.0;
-			double dSourceMin  = dataInDouble[0];
-			double dSourceMax  = dataInDouble[0];
-			for (int i = 0; i < nSourceCount; i++) {
-				dSourceMass += dataInDouble[i] * m_dSourceAreas[i];
-				if (dataInDouble[i] < dSourceMin) {
-					dSourceMin = dataInDouble[i];
-				}
-				if (dataInDouble[i] > dSourceMax) {
-					dSourceMax = dataInDouble[i];
-				}
-			}
-/*
-			for (int d = 0; d < nCountsIn.GetRows(); d++) {
-				printf("%li ", nCountsIn[d]);
-			}
-			printf(" : ");
-			for (int d = 0; d < nCountsOut.GetRows(); d++) {
-				printf("%li ", nCountsOut[d]);
-			}
-			printf("\n");
-*/
-			Announce("Source Mass: %1.15e Min %1.10e Max %1.10e",
-				dSourceMass, dSourceMin, dSourceMax);
+	NcVar * varYVB = NULL;
+	NcVar * varXVB = NULL;
+	if (fTargetVertices) {
+		NcDim * dimNVB = ncMap.add_dim("nv_b", nTargetNodesPerFace);
 
-			// Apply the offline map to the data
-			m_mapRemap.Apply(dataInDouble, dataOutDouble);
+		varYVB = ncMap.add_var("yv_b", ncDouble, dimNB, dimNVB);
+		SetNcVarChunking(ncMap, varYVB);
+		varXVB = ncMap.add_var("xv_b", ncDouble, dimNB, dimNVB);
+		SetNcVarChunking(ncMap, varXVB);
 
-			// Announce output mass
-			double dTargetMass = 0.0;
-			double dTargetMin  = dataOutDouble[0];
-			double dTargetMax  = dataOutDouble[0];
-			for (int i = 0; i < nTargetCount; i++) {
-				dTargetMass += dataOutDouble[i] * m_dTargetAreas[i];
-				if (dataOutDouble[i] < dTargetMin) {
-					dTargetMin = dataOutDouble[i];
-				}
-				if (dataOutDouble[i] > dTargetMax) {
-					dTargetMax = dataOutDouble[i];
-				}
-			}
-			Announce("Target Mass: %1.15e Min %1.10e Max %1.10e",
-				dTargetMass, dTargetMin, dTargetMax);
+		varYVB->add_att("units", "degrees");
+		varXVB->add_att("units", "degrees");
+	}
 
-			// Write the data
-			if (fTargetDouble) {
-				varOut->set_cur(&(nCountsOut[0]));
-				NcBool fNoErr = varOut->put(&(dataOutDouble[0]), &(nPut[0]));
-				if (!fNoErr) {
-					_EXCEPTION1("Error writing to NetCDF file (%i)", NcError::get_err());
-				}
+	// Verify dimensionality
+	if (pmeshSource == NULL) {
+		if (m_dSourceCenterLon.GetRows() != nA) {
+			_EXCEPTIONT("Mismatch between m_dSourceCenterLon and nA");
+		}
+		if (m_dSourceCenterLat.GetRows() != nA) {
+			_EXCEPTIONT("Mismatch between m_dSourceCenterLat and nA");
+		}
+		if (fSourceVertices && (m_dSourceVertexLon.GetRows() != nA)) {
+			_EXCEPTIONT("Mismatch between m_dSourceVertexLon and nA");
+		}
+		if (fSourceVertices && (m_dSourceVertexLat.GetRows() != nA)) {
+			_EXCEPTIONT("Mismatch between m_dSourceVertexLat and nA");
+		}
+	}
+	if (pmeshTarget == NULL) {
+		if (m_dTargetCenterLon.GetRows() != nB) {
+			_EXCEPTIONT("Mismatch between m_dTargetCenterLon and nB");
+		}
+		if (m_dTargetCenterLat.GetRows() != nB) {
+			_EXCEPTIONT("Mismatch between m_dTargetCenterLat and nB");
+		}
+		if (fTargetVertices && (m_dTargetVertexLon.GetRows() != nB)) {
+			_EXCEPTIONT("Mismatch between m_dTargetVertexLon and nB");
+		}
+		if (fTargetVertices && (m_dTargetVertexLat.GetRows() != nB)) {
+			_EXCEPTIONT("Mismatch between m_dTargetVertexLat and nB");
+		}
+	}
 
-			} else {
-				// Cast the data to float
-				for (int i = 0; i < dataOut.GetRows(); i++) {
-					dataOut[i] = static_cast<float>(dataOutDouble[i]);
-				}
+	if (pmeshSource != NULL) {
+		WriteCoordinatesFromMeshFV(
+			*pmeshSource, nSourceNodesPerFace,
+			varXCA, varYCA, varXVA, varYVA);
 
-				// Write the data as float
-				varOut->set_cur(&(nCountsOut[0]));
-				NcBool fNoErr = varOut->put(&(dataOut[0]), &(nPut[0]));
-				if (!fNoErr) {
-					_EXCEPTION1("Error writing to NetCDF file (%i)", NcError::get_err());
-				}
+	} else {
+		varYCA->put(&(m_dSourceCenterLat[0]), nA);
+		varXCA->put(&(m_dSourceCenterLon[0]), nA);
 
-				//}
-			}
+		if (fSourceVertices) {
+			varYVA->put(&(m_dSourceVertexLat[0][0]), nA, nSourceNodesPerFace);
+			varXVA->put(&(m_dSourceVertexLon[0][0]), nA, nSourceNodesPerFace);
 		}
-		AnnounceEndBlock(NULL);
 	}
-}
 
-///////////////////////////////////////////////////////////////////////////////
+	if (pmeshTarget != NULL) {
+		WriteCoordinatesFromMeshFV(
+			*pmeshTarget, nTargetNodesPerFace,
+			varXCB, varYCB, varXVB, varYVB);
 
-void OfflineMap::Read(
-	const std::string & strSource,
-	std::map<std::string, std::string> * pmapAttributes,
-	NcFile::FileFormat * peFileFormat
-) {
-	NcFile ncMap(strSource.c_str(), NcFile::ReadOnly);
-	if (!ncMap.is_valid()) {
-		_EXCEPTION1("Unable to open input map file \"%s\"",
-			strSource.c_str());
+	} else {
+		varYCB->put(&(m_dTargetCenterLat[0]), nB);
+		varXCB->put(&(m_dTargetCenterLon[0]), nB);
+
+		if (fTargetVertices) {
+			varYVB->put(&(m_dTargetVertexLat[0][0]), nB, nTargetNodesPerFace);
+			varXVB->put(&(m_dTargetVertexLon[0][0]), nB, nTargetNodesPerFace);
+		}
 	}
 
-	// Read netcdf file format
-	NcFile::FileFormat eFileFormat = ncMap.get_format();
+	// Write vector centers
+	if ((m_dVectorTargetCenterLat.GetRows() != 0) &&
+		(m_dVectorTargetCenterLon.GetRows() != 0)
+	) {
+		NcDim * dimLatB =
+			ncMap.add_dim("lat_b", m_dVectorTargetCenterLat.GetRows());
+		NcDim * dimLonB =
+			ncMap.add_dim("lon_b", m_dVectorTargetCenterLon.GetRows());
 
-	if (peFileFormat != NULL) {
-		*peFileFormat = eFileFormat;
-	}
+		NcVar * varLatCB = ncMap.add_var("latc_b", ncDouble, dimLatB);
+		NcVar * varLonCB = ncMap.add_var("lonc_b", ncDouble, dimLonB);
 
-	// Read input dimensions entries
-	NcDim * dimSrcGridRank = ncMap.get_dim("src_grid_rank");
-	if (dimSrcGridRank == NULL) {
-		_EXCEPTION1("Map file \"%s\" does not contain variable"
-			"\"src_grid_rank\"", strSource.c_str());
-	}
+		varLatCB->put(&(m_dVectorTargetCenterLat[0]), dimLatB->size());
+		varLonCB->put(&(m_dVectorTargetCenterLon[0]), dimLonB->size());
 
-	NcDim * dimDstGridRank = ncMap.get_dim("dst_grid_rank");
-	if (dimDstGridRank == NULL) {
-		_EXCEPTION1("Map file \"%s\" does not contain variable"
-			"\"dst_grid_rank\"", strSource.c_str());
+		NcDim * dimBounds = ncMap.add_dim("bnds", 2);
+		NcVar * varLatBounds =
+			ncMap.add_var("lat_bnds", ncDouble, dimLatB, dimBounds);
+		NcVar * varLonBounds =
+			ncMap.add_var("lon_bnds", ncDouble, dimLonB, dimBounds);
+
+		varLatBounds->put(&(m_dVectorTargetBoundsLat[0][0]),
+			m_dVectorTargetBoundsLat.GetRows(), 2);
+		varLonBounds->put(&(m_dVectorTargetBoundsLon[0][0]),
+			m_dVectorTargetBoundsLon.GetRows(), 2);
 	}
 
-	int nSrcGridDims = (int)(dimSrcGridRank->size());
-	int nDstGridDims = (int)(dimDstGridRank->size());
+	// Write areas
+	NcVar * varAreaA = ncMap.add_var("area_a", ncDouble, dimNA);
+	SetNcVarChunking(ncMap, varAreaA);
+	varAreaA->put(&(m_dSourceAreas[0]), nA);
+	varAreaA->add_att("units", "steradians");
 
-	NcVar * varSrcGridDims = ncMap.get_var("src_grid_dims");
-	if (varSrcGridDims == NULL) {
-		_EXCEPTION1("Map file \"%s\" does not contain variable"
-			"\"src_grid_dims\"", strSource.c_str());
-	}
+	NcVar * varAreaB = ncMap.add_var("area_b", ncDouble, dimNB);
+	SetNcVarChunking(ncMap, varAreaB);
+	varAreaB->put(&(m_dTargetAreas[0]), nB);
+	varAreaB->add_att("units", "steradians");
 
-	NcVar * varDstGridDims = ncMap.get_var("dst_grid_dims");
-	if (varSrcGridDims == NULL) {
-		_EXCEPTION1("Map file \"%s\" does not contain variable"
-			"\"dst_grid_dims\"", strSource.c_str());
+	// Write masks
+	if (m_iSourceMask.IsAttached()) {
+		NcVar * varMaskA = ncMap.add_var("mask_a", ncInt, dimNA);
+		SetNcVarChunking(ncMap, varMaskA);
+		varMaskA->put(&(m_iSourceMask[0]), nA);
+		varMaskA->add_att("units", "unitless");
+
+		if (!m_iTargetMask.IsAttached()) {
+			NcVar * varMaskB = ncMap.add_var("mask_b", ncInt, dimNB);
+			SetNcVarChunking(ncMap, varMaskB);
+			DataArray1D<int> iTargetMaskTemp(nB);
+			for (int i = 0; i < nB; i++) {
+				iTargetMaskTemp[i] = 1;
+			}
+			varMaskB->put(&(iTargetMaskTemp[0]), nB);
+			varMaskB->add_att("units", "unitless");
+		}
 	}
 
-	m_vecSourceDimSizes.resize(nSrcGridDims);
-	m_vecSourceDimNames.resize(nSrcGridDims);
+	if (m_iTargetMask.IsAttached()) {
+		if (!m_iSourceMask.IsAttached()) {
+			NcVar * varMaskA = ncMap.add_var("mask_a", ncInt, dimNA);
+			SetNcVarChunking(ncMap, varMaskA);
+			DataArray1D<int> iSourceMaskTemp(nA);
+			for (int i = 0; i < nA; i++) {
+				iSourceMaskTemp[i] = 1;
+			}
+			varMaskA->put(&(iSourceMaskTemp[0]), nA);
+			varMaskA->add_att("units", "unitless");
+		}
 
-	m_vecTargetDimSizes.resize(nDstGridDims);
-	m_vecTargetDimNames.resize(nDstGridDims);
+		NcVar * varMaskB = ncMap.add_var("mask_b", ncInt, dimNB);
+		SetNcVarChunking(ncMap, varMaskB);
+		varMaskB->put(&(m_iTargetMask[0]), nB);
+		varMaskB->add_att("units", "unitless");
+	}
 
-	varSrcGridDims->get(&(m_vecSourceDimSizes[0]), nSrcGridDims);
-	varDstGridDims->get(&(m_vecTargetDimSizes[0]), nDstGridDims);
+	// Write SparseMatrix entries
+	DataArray1D<int> vecRow;
+	DataArray1D<int> vecCol;
+	DataArray1D<double> vecS;
 
-	for (int i = 0; i < nSrcGridDims/2; i++) {
-		int iTemp = m_vecSourceDimSizes[i];
-		m_vecSourceDimSizes[i] = m_vecSourceDimSizes[nSrcGridDims - i - 1];
-		m_vecSourceDimSizes[nSrcGridDims - i - 1] = iTemp;
-	}
+	m_mapRemap.GetEntries(vecRow, vecCol, vecS);
 
-	for (int i = 0; i < nSrcGridDims; i++) {
-		char szDim[64];
-		sprintf(szDim, "name%i", nSrcGridDims - i - 1);
-		NcAtt * attDim = varSrcGridDims->get_att(szDim);
-		if (attDim != NULL) {
-			m_vecSourceDimNames[i] = attDim->as_string(0);
-		} else {
-			sprintf(szDim, "dim%i", nSrcGridDims - i - 1);
-			m_vecSourceDimNames[i] = szDim;
+	// Calculate and write fractional coverage arrays
+	{
+		DataArray1D<double> dFracA(nA);
+		DataArray1D<double> dFracB(nB);
+
+		for (size_t i = 0; i < vecS.GetRows(); i++) {
+			dFracA[vecCol[i]] += vecS[i] / m_dSourceAreas[vecCol[i]] * m_dTargetAreas[vecRow[i]];
+			dFracB[vecRow[i]] += vecS[i];
 		}
+
+		NcVar * varFracA = ncMap.add_var("frac_a", ncDouble, dimNA);
+		SetNcVarChunking(ncMap, varFracA);
+		varFracA->put(&(dFracA[0]), nA);
+		varFracA->add_att("name", "fraction of target coverage of source dof");
+		varFracA->add_att("units", "unitless");
+
+		NcVar * varFracB = ncMap.add_var("frac_b", ncDouble, dimNB);
+		SetNcVarChunking(ncMap, varFracB);
+		varFracB->put(&(dFracB[0]), nB);
+		varFracB->add_att("name", "fraction of source coverage of target dof");
+		varFracB->add_att("units", "unitless");
 	}
 
-	for (int i = 0; i < nDstGridDims/2; i++) {
-		int iTemp = m_vecTargetDimSizes[i];
-		m_vecTargetDimSizes[i] = m_vecTargetDimSizes[nDstGridDims - i - 1];
-		m_vecTargetDimSizes[nDstGridDims - i - 1] = iTemp;
+	// Increment vecRow and vecCol
+	for (size_t i = 0; i < vecRow.GetRows(); i++) {
+		vecRow[i]++;
+		vecCol[i]++;
 	}
 
-	for (int i = 0; i < nDstGridDims; i++) {
-		char szDim[64];
-		sprintf(szDim, "name%i", nDstGridDims - i - 1);
-		NcAtt * attDim = varDstGridDims->get_att(szDim);
-		if (attDim != NULL) {
-			m_vecTargetDimNames[i] = attDim->as_string(0);
-		} else {
-			sprintf(szDim, "dim%i", nDstGridDims - i - 1);
-			m_vecTargetDimNames[i] = szDim;
-		}
-	}
+	// Write out data
+	long nS = static_cast<long>(vecRow.GetRows());
+	NcDim * dimNS = ncMap.add_dim("n_s", nS);
 
-	// Source and Target mesh resolutions
-	NcDim * dimNA = ncMap.get_dim("n_a");
-	if (dimNA == NULL) {
-		_EXCEPTIONT("Input map missing dimension \"n_a\"");
-	}
+	NcVar * varRow = ncMap.add_var("row", ncInt, dimNS);
+	SetNcVarChunking(ncMap, varRow);
+	varRow->add_att("name", "sparse matrix target dof index");
+	varRow->add_att("first_index", "1");
 
-	NcDim * dimNB = ncMap.get_dim("n_b");
-	if (dimNB == NULL) {
-		_EXCEPTIONT("Input map missing dimension \"n_b\"");
-	}
+	NcVar * varCol = ncMap.add_var("col", ncInt, dimNS);
+	SetNcVarChunking(ncMap, varCol);
+	varCol->add_att("name", "sparse matrix source dof index");
+	varCol->add_att("first_index", "1");
 
-	int nA = dimNA->size();
-	int nB = dimNB->size();
+	NcVar * varS = ncMap.add_var("S", ncDouble, dimNS);
+	SetNcVarChunking(ncMap, varS);
+	varS->add_att("name", "sparse matrix coefficient");
 
-	NcDim * dimNVA = ncMap.get_dim("nv_a");
-	if (dimNA == NULL) {
-		_EXCEPTIONT("Input map missing dimension \"nv_a\"");
-	}
+	varRow->set_cur((long)0);
+	varRow->put(&(vecRow[0]), nS);
 
-	NcDim * dimNVB = ncMap.get_dim("nv_b");
-	if (dimNB == NULL) {
-		_EXCEPTIONT("Input map missing dimension \"nv_b\"");
-	}
+	varCol->set_cur((long)0);
+	varCol->put(&(vecCol[0]), nS);
 
-	int nVA = dimNVA->size();
-	int nVB = dimNVB->size();
+	varS->set_cur((long)0);
+	varS->put(&(vecS[0]), nS);
 
-	// Read coordinates
-	NcVar * varYCA = ncMap.get_var("yc_a");
-	NcVar * varYCB = ncMap.get_var("yc_b");
+	// Add global attributes
+	std::map<std::string, std::string>::const_iterator iterAttributes =
+		mapAttributes.begin();
+	for (; iterAttributes != mapAttributes.end(); iterAttributes++) {
+		ncMap.add_att(
+			iterAttributes->first.c_str(),
+			iterAttributes->second.c_str());
+	}
+}
 
-	NcVar * varXCA = ncMap.get_var("xc_a");
-	NcVar * varXCB = ncMap.get_var("xc_b");
+///////////////////////////////////////////////////////////////////////////////
 
-	NcVar * varYVA = ncMap.get_var("yv_a");
-	NcVar * varYVB = ncMap.get_var("yv_b");
+///	<summary>
+///		Identifier at the start of every native binary map file.
+///	</summary>
+static const char BinaryMapMagic[8] = {'T','R','M','A','P','B','I','N'};
+
+///	<summary>
+///		Version of the native binary map format.
+///	</summary>
+static const uint32_t BinaryMapVersion = 1;
+
+///	<summary>
+///		Version of the native binary map format with compact weights.
+///	</summary>
+static const uint32_t BinaryMapVersionCompact = 2;
+
+///	<summary>
+///		Marker used to detect files written with a different byte order.
+///	</summary>
+static const uint32_t BinaryMapByteOrderMark = 0x01020304;
+
+///	<summary>
+///		Size of the chunks that are hashed independently when computing the
+///		checksum of a native binary map file.
+///	</summary>
+static const size_t BinaryMapChecksumChunkBytes = 4 * 1024 * 1024;
+
+///	<summary>
+///		Header of a native binary map file.  The header is followed by a
+///		payload of blocks, each consisting of a 64-bit byte count followed by
+///		the block data padded to a multiple of 8 bytes.  Blocks appear in the
+///		order: source dimension sizes, target dimension sizes, source
+///		dimension names, target dimension names, attributes, xc_a, yc_a,
+///		xc_b, yc_b, xv_a, yv_a, xv_b, yv_b, latc_b, lonc_b, lat_bnds,
+///		lon_bnds, area_a, area_b, mask_a, mask_b, CSR row pointers, CSR
+///		columns and CSR values.  Maps with compact weights (version
+///		BinaryMapVersionCompact) instead end with the CSR row pointers,
+///		the delta encoded CSR columns, BinaryMapWeightParams, the row
+///		sums of the original weights and the encoded CSR values.
+///	</summary>
+struct BinaryMapHeader {
+	char szMagic[8];
+	uint32_t uVersion;
+	uint32_t uByteOrderMark;
+	uint64_t nSourceCount;
+	uint64_t nTargetCount;
+	uint64_t nSourceVertices;
+	uint64_t nTargetVertices;
+	uint64_t nRows;
+	uint64_t nCols;
+	uint64_t nNonZeros;
+	uint64_t sPayloadBytes;
+	uint64_t uChecksum;
+};
+
+///	<summary>
+///		Encoding of the weights of a native binary map file with compact
+///		weights.  Quantized weights are stored as the integer nearest to
+///		(w - dOffset) / dStep.  dMaxError is the largest error of any
+///		stored weight, before the rows are rescaled on load.
+///	</summary>
+struct BinaryMapWeightParams {
+	uint64_t uWeights;
+	double dOffset;
+	double dStep;
+	double dMaxError;
+};
 
-	NcVar * varXVA = ncMap.get_var("xv_a");
-	NcVar * varXVB = ncMap.get_var("xv_b");
+///////////////////////////////////////////////////////////////////////////////
 
-	if (varYCA == NULL) {
-		_EXCEPTION1("Map file \"%s\" does not contain variable \"yc_a\":"
-			"\nPossibly an earlier version of map",
-			strSource.c_str());
-	}
-	if (varYCB == NULL) {
-		_EXCEPTION1("Map file \"%s\" does not contain variable \"yc_b\":"
-			"\nPossibly an earlier version of map",
-			strSource.c_str());
-	}
-	if (varXCA == NULL) {
-		_EXCEPTION1("Map file \"%s\" does not contain variable \"xc_a\":"
-			"\nPossibly an earlier version of map",
-			strSource.c_str());
-	}
-	if (varXCB == NULL) {
-		_EXCEPTION1("Map file \"%s\" does not contain variable \"xc_b\":"
-			"\nPossibly an earlier version of map",
-			strSource.c_str());
-	}
-	if (varYVA == NULL) {
-		_EXCEPTION1("Map file \"%s\" does not contain variable \"yv_a\":"
-			"\nPossibly an earlier version of map",
-			strSource.c_str());
-	}
-	if (varYVB == NULL) {
-		_EXCEPTION1("Map file \"%s\" does not contain variable \"yv_b\":"
-			"\nPossibly an earlier version of map",
-			strSource.c_str());
+///	<summary>
+///		Checksum of a native binary map file payload.  Each chunk of the
+///		payload is hashed with 64-bit FNV-1a over 64-bit words, and the chunk
+///		hashes are then combined in the same way, so that the checksum of a
+///		mapped file can be verified in parallel.
+///	</summary>
+class BinaryMapChecksum {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	BinaryMapChecksum() :
+		m_uHash(FNVOffsetBasis),
+		m_uChunkHash(FNVOffsetBasis),
+		m_sChunkBytes(0)
+	{ }
+
+public:
+	///	<summary>
+	///		Hash an array of 64-bit words.
+	///	</summary>
+	static uint64_t HashWords(
+		const uint64_t * pWords,
+		size_t sWords,
+		uint64_t uHash
+	) {
+		for (size_t i = 0; i < sWords; i++) {
+			uHash ^= pWords[i];
+			uHash *= FNVPrime;
+		}
+		return uHash;
 	}
-	if (varXVA == NULL) {
-		_EXCEPTION1("Map file \"%s\" does not contain variable \"xv_a\":"
-			"\nPossibly an earlier version of map",
-			strSource.c_str());
+
+	///	<summary>
+	///		Add data to the checksum.  The size must be a multiple of 8 bytes.
+	///	</summary>
+	void Update(
+		const void * pData,
+		size_t sBytes
+	) {
+		const char * pBytes = static_cast<const char *>(pData);
+		while (sBytes != 0) {
+			size_t sTake = BinaryMapChecksumChunkBytes - m_sChunkBytes;
+			if (sTake > sBytes) {
+				sTake = sBytes;
+			}
+			m_uChunkHash = HashWords(
+				reinterpret_cast<const uint64_t *>(pBytes),
+				sTake / sizeof(uint64_t),
+				m_uChunkHash);
+
+			m_sChunkBytes += sTake;
+			pBytes += sTake;
+			sBytes -= sTake;
+
+			if (m_sChunkBytes == BinaryMapChecksumChunkBytes) {
+				m_uHash = HashWords(&m_uChunkHash, 1, m_uHash);
+				m_uChunkHash = FNVOffsetBasis;
+				m_sChunkBytes = 0;
+			}
+		}
 	}
-	if (varXVB == NULL) {
-		_EXCEPTION1("Map file \"%s\" does not contain variable \"xv_b\":"
-			"\nPossibly an earlier version of map",
-			strSource.c_str());
+
+	///	<summary>
+	///		Get the checksum of all data added.
+	///	</summary>
+	uint64_t GetChecksum() const {
+		if (m_sChunkBytes == 0) {
+			return m_uHash;
+		}
+		return HashWords(&m_uChunkHash, 1, m_uHash);
 	}
 
-	m_dSourceCenterLat.Allocate(nA);
-	m_dTargetCenterLat.Allocate(nB);
+	///	<summary>
+	///		Compute the checksum of a contiguous buffer, hashing chunks in
+	///		parallel.  The size must be a multiple of 8 bytes.
+	///	</summary>
+	static uint64_t Compute(
+		const void * pData,
+		size_t sBytes
+	) {
+		const char * pBytes = static_cast<const char *>(pData);
+		const long lChunks = static_cast<long>(
+			(sBytes + BinaryMapChecksumChunkBytes - 1)
+				/ BinaryMapChecksumChunkBytes);
+
+		std::vector<uint64_t> vecChunkHash(lChunks);
+
+#pragma omp parallel for
+		for (long c = 0; c < lChunks; c++) {
+			size_t sBegin = static_cast<size_t>(c) * BinaryMapChecksumChunkBytes;
+			size_t sEnd = sBegin + BinaryMapChecksumChunkBytes;
+			if (sEnd > sBytes) {
+				sEnd = sBytes;
+			}
+			vecChunkHash[c] = HashWords(
+				reinterpret_cast<const uint64_t *>(pBytes + sBegin),
+				(sEnd - sBegin) / sizeof(uint64_t),
+				FNVOffsetBasis);
+		}
 
-	m_dSourceCenterLon.Allocate(nA);
-	m_dTargetCenterLon.Allocate(nB);
+		uint64_t uHash = FNVOffsetBasis;
+		if (lChunks != 0) {
+			uHash = HashWords(&(vecChunkHash[0]), lChunks, uHash);
+		}
+		return uHash;
+	}
 
-	m_dSourceVertexLat.Allocate(nA, nVA);
-	m_dTargetVertexLat.Allocate(nB, nVB);
+private:
+	///	<summary>
+	///		FNV-1a parameters.
+	///	</summary>
+	static const uint64_t FNVOffsetBasis = 14695981039346656037ULL;
+	static const uint64_t FNVPrime = 1099511628211ULL;
 
-	m_dSourceVertexLon.Allocate(nA, nVA);
-	m_dTargetVertexLon.Allocate(nB, nVB);
+	///	<summary>
+	///		Combined hash of all completed chunks.
+	///	</summary>
+	uint64_t m_uHash;
 
-	varYCA->get(&(m_dSourceCenterLat[0]), nA);
-	varYCB->get(&(m_dTargetCenterLat[0]), nB);
+	///	<summary>
+	///		Hash of the current chunk.
+	///	</summary>
+	uint64_t m_uChunkHash;
 
-	varXCA->get(&(m_dSourceCenterLon[0]), nA);
-	varXCB->get(&(m_dTargetCenterLon[0]), nB);
+	///	<summary>
+	///		Number of bytes in the current chunk.
+	///	</summary>
+	size_t m_sChunkBytes;
+};
 
-	varYVA->get(&(m_dSourceVertexLat[0][0]), nA, nVA);
-	varYVB->get(&(m_dTargetVertexLat[0][0]), nB, nVB);
+///////////////////////////////////////////////////////////////////////////////
 
-	varXVA->get(&(m_dSourceVertexLon[0][0]), nA, nVA);
-	varXVB->get(&(m_dTargetVertexLon[0][0]), nB, nVB);
+///	<summary>
+///		Write a block of a native binary map file.
+///	</summary>
+static void WriteBinaryMapBlock(
+	FILE * fp,
+	const void * pData,
+	size_t sBytes,
+	BinaryMapChecksum & checksum,
+	uint64_t & sPayloadBytes
+) {
+	uint64_t uBytes = static_cast<uint64_t>(sBytes);
+	if (fwrite(&uBytes, sizeof(uint64_t), 1, fp) != 1) {
+		_EXCEPTIONT("Error writing binary map file");
+	}
+	checksum.Update(&uBytes, sizeof(uint64_t));
+	sPayloadBytes += sizeof(uint64_t);
+
+	// Stage data through a word-aligned buffer so it can be padded
+	const size_t sStageWords = 131072;
+	std::vector<uint64_t> vecStage(sStageWords);
+
+	const char * pBytes = static_cast<const char *>(pData);
+	size_t sOffset = 0;
+	while (sOffset < sBytes) {
+		size_t sCopy = sBytes - sOffset;
+		if (sCopy > sStageWords * sizeof(uint64_t)) {
+			sCopy = sStageWords * sizeof(uint64_t);
+		}
+		size_t sPadded =
+			(sCopy + sizeof(uint64_t) - 1) / sizeof(uint64_t) * sizeof(uint64_t);
 
-	// Read vector centers and bounds
-	NcDim * dimLatB = ncMap.get_dim("lat_b");
-	NcDim * dimLonB = ncMap.get_dim("lon_b");
+		vecStage[sPadded / sizeof(uint64_t) - 1] = 0;
+		memcpy(&(vecStage[0]), pBytes + sOffset, sCopy);
 
-	if ((dimLatB != NULL) && (dimLonB != NULL)) {
-		NcVar * varLatCB = ncMap.get_var("latc_b");
-		NcVar * varLonCB = ncMap.get_var("lonc_b");
+		if (fwrite(&(vecStage[0]), 1, sPadded, fp) != sPadded) {
+			_EXCEPTIONT("Error writing binary map file");
+		}
+		checksum.Update(&(vecStage[0]), sPadded);
+		sPayloadBytes += sPadded;
 
-		m_dVectorTargetCenterLat.Allocate(dimLatB->size());
-		m_dVectorTargetCenterLon.Allocate(dimLonB->size());
+		sOffset += sCopy;
+	}
+}
 
-		varLatCB->get(&(m_dVectorTargetCenterLat[0]), dimLatB->size());
-		varLonCB->get(&(m_dVectorTargetCenterLon[0]), dimLonB->size());
+///////////////////////////////////////////////////////////////////////////////
 
-		NcVar * varLatBounds = ncMap.get_var("lat_bnds");
-		NcVar * varLonBounds = ncMap.get_var("lon_bnds");
+///	<summary>
+///		Write a block of strings, each terminated by a null character, to a
+///		native binary map file.
+///	</summary>
+static void WriteBinaryMapStringBlock(
+	FILE * fp,
+	const std::vector<std::string> & vecStrings,
+	BinaryMapChecksum & checksum,
+	uint64_t & sPayloadBytes
+) {
+	std::string strBlock;
+	for (size_t i = 0; i < vecStrings.size(); i++) {
+		strBlock += vecStrings[i];
+		strBlock += '\0';
+	}
+	WriteBinaryMapBlock(
+		fp, strBlock.c_str(), strBlock.length(), checksum, sPayloadBytes);
+}
 
-		m_dVectorTargetBoundsLat.Allocate(dimLatB->size(), 2);
-		m_dVectorTargetBoundsLon.Allocate(dimLonB->size(), 2);
+///////////////////////////////////////////////////////////////////////////////
 
-		varLatBounds->get(&(m_dVectorTargetBoundsLat[0][0]),
-			dimLatB->size(), 2);
-		varLonBounds->get(&(m_dVectorTargetBoundsLon[0][0]),
-			dimLonB->size(), 2);
+///	<summary>
+///		Get the byte count of the next block of a memory mapped native binary
+///		map file without advancing past it.
+///	</summary>
+static size_t PeekBinaryMapBlockBytes(
+	const char * pPayload,
+	size_t sPayloadBytes,
+	size_t sOffset,
+	const char * szBlockName
+) {
+	if (sOffset + sizeof(uint64_t) > sPayloadBytes) {
+		_EXCEPTION1("Binary map file truncated before block \"%s\"",
+			szBlockName);
 	}
 
-	// Read areas
-	m_dSourceAreas.Allocate(nA);
-	m_dTargetAreas.Allocate(nB);
+	uint64_t uBytes;
+	memcpy(&uBytes, pPayload + sOffset, sizeof(uint64_t));
+	return static_cast<size_t>(uBytes);
+}
 
-	NcVar * varAreaA = ncMap.get_var("area_a");
-	if (varAreaA == NULL) {
-		_EXCEPTION1("Map file \"%s\" does not contain variable \"area_a\"",
-			strSource.c_str());
-	}
-	varAreaA->get(&(m_dSourceAreas[0]), nA);
+///////////////////////////////////////////////////////////////////////////////
 
-	NcVar * varAreaB = ncMap.get_var("area_b");
-	if (varAreaB == NULL) {
-		_EXCEPTION1("Map file \"%s\" does not contain variable \"area_b\"",
-			strSource.c_str());
+///	<summary>
+///		Locate the next block of a memory mapped native binary map file and
+///		verify it contains exactly sCount elements of type T.
+///	</summary>
+template <typename T>
+static const T * ReadBinaryMapBlock(
+	const char * pPayload,
+	size_t sPayloadBytes,
+	size_t & sOffset,
+	size_t sCount,
+	const char * szBlockName
+) {
+	if (sOffset + sizeof(uint64_t) > sPayloadBytes) {
+		_EXCEPTION1("Binary map file truncated before block \"%s\"",
+			szBlockName);
 	}
-	varAreaB->get(&(m_dTargetAreas[0]), nB);
 
-	// Read masks
-	NcVar * varMaskA = ncMap.get_var("mask_a");
-	if (varMaskA != NULL) {
-		m_iSourceMask.Allocate(nA);
-		varMaskA->get(&(m_iSourceMask[0]), nA);
-	}
+	uint64_t uBytes;
+	memcpy(&uBytes, pPayload + sOffset, sizeof(uint64_t));
+	sOffset += sizeof(uint64_t);
 
-	NcVar * varMaskB = ncMap.get_var("mask_b");
-	if (varMaskB != NULL) {
-		m_iTargetMask.Allocate(nB);
-		varMaskB->get(&(m_iTargetMask[0]), nB);
+	if (uBytes != sCount * sizeof(T)) {
+		_EXCEPTION3("Binary map block \"%s\" has size %lu (expected %lu)",
+			szBlockName,
+			static_cast<unsigned long>(uBytes),
+			static_cast<unsigned long>(sCount * sizeof(T)));
 	}
 
-	// Read SparseMatrix entries
-	NcDim * dimNS = ncMap.get_dim("n_s");
-	if (dimNS == NULL) {
-		_EXCEPTION1("Map file \"%s\" does not contain dimension \"n_s\"",
-			strSource.c_str());
+	size_t sPadded =
+		(uBytes + sizeof(uint64_t) - 1) / sizeof(uint64_t) * sizeof(uint64_t);
+	if (sOffset + sPadded > sPayloadBytes) {
+		_EXCEPTION1("Binary map file truncated in block \"%s\"",
+			szBlockName);
 	}
 
-	NcVar * varRow = ncMap.get_var("row");
-	if (varRow == NULL) {
-		_EXCEPTION1("Map file \"%s\" does not contain variable \"row\"",
-			strSource.c_str());
+	const T * pData = reinterpret_cast<const T *>(pPayload + sOffset);
+	sOffset += sPadded;
+	return pData;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Read the next block of a memory mapped native binary map file as a
+///		list of null-terminated strings.
+///	</summary>
+static void ReadBinaryMapStringBlock(
+	const char * pPayload,
+	size_t sPayloadBytes,
+	size_t & sOffset,
+	std::vector<std::string> & vecStrings,
+	const char * szBlockName
+) {
+	const size_t uBytes =
+		PeekBinaryMapBlockBytes(pPayload, sPayloadBytes, sOffset, szBlockName);
+
+	const char * pData =
+		ReadBinaryMapBlock<char>(
+			pPayload, sPayloadBytes, sOffset, uBytes, szBlockName);
+
+	vecStrings.clear();
+	size_t sBegin = 0;
+	for (size_t i = 0; i < uBytes; i++) {
+		if (pData[i] == '\0') {
+			vecStrings.push_back(std::string(pData + sBegin, i - sBegin));
+			sBegin = i + 1;
+		}
+	}
+	if (sBegin != uBytes) {
+		_EXCEPTION1("Binary map block \"%s\" is not null-terminated",
+			szBlockName);
 	}
+}
 
-	NcVar * varCol = ncMap.get_var("col");
-	if (varRow == NULL) {
-		_EXCEPTION1("Map file \"%s\" does not contain variable \"col\"",
-			strSource.c_str());
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Attach a DataArray1D to a block of a copy-on-write memory mapped
+///		native binary map file, without a copy.  The array retains the
+///		mapping.
+///	</summary>
+template <typename T>
+static void AttachBinaryMapBlock(
+	const T * pData,
+	size_t sCount,
+	DataArray1D<T> & data,
+	const std::shared_ptr<MemoryMappedFile> & pmmapFile
+) {
+	data.Detach();
+	data.SetSize(sCount);
+	if (sCount != 0) {
+		data.AttachToData(const_cast<T *>(pData), pmmapFile);
 	}
+}
 
-	NcVar * varS = ncMap.get_var("S");
-	if (varRow == NULL) {
-		_EXCEPTION1("Map file \"%s\" does not contain variable \"S\"",
-			strSource.c_str());
+///	<summary>
+///		Attach a DataArray2D to a block of a copy-on-write memory mapped
+///		native binary map file, without a copy.  The array retains the
+///		mapping.
+///	</summary>
+template <typename T>
+static void AttachBinaryMapBlock(
+	const T * pData,
+	size_t sRows,
+	size_t sColumns,
+	DataArray2D<T> & data,
+	const std::shared_ptr<MemoryMappedFile> & pmmapFile
+) {
+	data.Detach();
+	data.SetSize(sRows, sColumns);
+	if (sRows * sColumns != 0) {
+		data.AttachToData(const_cast<T *>(pData), pmmapFile);
 	}
+}
 
-	int nS = dimNS->size();
+///////////////////////////////////////////////////////////////////////////////
 
-	DataArray1D<int> vecRow(nS);
-	DataArray1D<int> vecCol(nS);
-	DataArray1D<double> vecS(nS);
+///	<summary>
+///		Delta encode the columns of a matrix in CSR form as variable-length
+///		(7 bits per byte) integers.  The first column of each row is stored
+///		as the zigzag encoded difference from the first column of the
+///		previous row, and the remaining columns as the difference from the
+///		previous column of the row.  The columns of each row must be sorted.
+///	</summary>
+static void EncodeBinaryMapColumns(
+	const DataArray1D<size_t> & dataRowPtr,
+	const DataArray1D<int> & dataCols,
+	std::vector<unsigned char> & vecEncoded
+) {
+	vecEncoded.clear();
+	vecEncoded.reserve(dataCols.GetRows() * 2);
+
+	const size_t nRows = dataRowPtr.GetRows() - 1;
+
+	int64_t iPrevFirst = 0;
+	for (size_t i = 0; i < nRows; i++) {
+		for (size_t j = dataRowPtr[i]; j < dataRowPtr[i+1]; j++) {
+			uint64_t uDelta;
+			if (j == dataRowPtr[i]) {
+				const int64_t iDelta =
+					static_cast<int64_t>(dataCols[j]) - iPrevFirst;
+				uDelta = (iDelta >= 0)?
+					(static_cast<uint64_t>(iDelta) << 1):
+					((static_cast<uint64_t>(-iDelta) << 1) - 1);
+				iPrevFirst = dataCols[j];
 
-	varRow->set_cur((long)0);
-	varRow->get(&(vecRow[0]), nS);
+			} else {
+				if (dataCols[j] < dataCols[j-1]) {
+					_EXCEPTIONT("Columns of compact binary map must be sorted");
+				}
+				uDelta = static_cast<uint64_t>(dataCols[j] - dataCols[j-1]);
+			}
 
-	varCol->set_cur((long)0);
-	varCol->get(&(vecCol[0]), nS);
+			while (uDelta >= 0x80) {
+				vecEncoded.push_back(
+					static_cast<unsigned char>((uDelta & 0x7F) | 0x80));
+				uDelta >>= 7;
+			}
+			vecEncoded.push_back(static_cast<unsigned char>(uDelta));
+		}
+	}
+}
 
-	varS->set_cur((long)0);
-	varS->get(&(vecS[0]), nS);
+///	<summary>
+///		Decode the columns of a matrix in CSR form written by
+///		EncodeBinaryMapColumns(), verifying that each column is in the
+///		range [0, nCols).
+///	</summary>
+static void DecodeBinaryMapColumns(
+	const size_t * pRowPtr,
+	size_t nRows,
+	size_t nCols,
+	const unsigned char * pEncoded,
+	size_t sEncodedBytes,
+	DataArray1D<int> & dataCols
+) {
+	size_t sByte = 0;
+	int64_t iPrevFirst = 0;
+	for (size_t i = 0; i < nRows; i++) {
+		for (size_t j = pRowPtr[i]; j < pRowPtr[i+1]; j++) {
+			uint64_t uDelta = 0;
+			int iShift = 0;
+			for (;;) {
+				if ((sByte == sEncodedBytes) || (iShift > 35)) {
+					_EXCEPTIONT("Invalid column encoding in binary map file");
+				}
+				const unsigned char c = pEncoded[sByte++];
+				uDelta |= static_cast<uint64_t>(c & 0x7F) << iShift;
+				iShift += 7;
+				if ((c & 0x80) == 0) {
+					break;
+				}
+			}
 
-	// Decrement vecRow and vecCol
-	for (int i = 0; i < vecRow.GetRows(); i++) {
-		vecRow[i]--;
-		vecCol[i]--;
+			int64_t iCol;
+			if (j == pRowPtr[i]) {
+				const int64_t iDelta = (uDelta & 1)?
+					(-static_cast<int64_t>((uDelta + 1) >> 1)):
+					(static_cast<int64_t>(uDelta >> 1));
+				iCol = iPrevFirst + iDelta;
+				iPrevFirst = iCol;
+			} else {
+				iCol = static_cast<int64_t>(dataCols[j-1])
+					+ static_cast<int64_t>(uDelta);
+			}
+			if ((iCol < 0) || (static_cast<uint64_t>(iCol) >= nCols)) {
+				_EXCEPTIONT("Invalid column encoding in binary map file");
+			}
+			dataCols[j] = static_cast<int>(iCol);
+		}
+	}
+	if (sByte != sEncodedBytes) {
+		_EXCEPTIONT("Invalid column encoding in binary map file");
 	}
+}
 
-	// Set the entries of the map
-	m_mapRemap.SetEntries(vecRow, vecCol, vecS);
+///	<summary>
+///		Verify that the nS columns of a matrix in CSR form read from a
+///		binary map file are in the range [0, nCols).
+///	</summary>
+static void ValidateBinaryMapColumns(
+	const int * pCols,
+	size_t nS,
+	size_t nCols
+) {
+	long lInvalid = 0;
 
-	// Load file attributes
-	if (pmapAttributes != NULL) {
-		for (int a = 0; a < ncMap.num_atts(); a++) {
-			NcAtt * attGlobal = ncMap.get_att(a);
-			if (attGlobal == NULL) {
-				_EXCEPTIONT("Logic error");
-			}
+#pragma omp parallel for schedule(static) reduction(+:lInvalid)
+	for (long j = 0; j < static_cast<long>(nS); j++) {
+		if ((pCols[j] < 0) || (static_cast<size_t>(pCols[j]) >= nCols)) {
+			lInvalid++;
+		}
+	}
 
-			std::pair<std::string, std::string> prAttribute(
-				attGlobal->name(),
-				attGlobal->as_string(0));
+	if (lInvalid != 0) {
+		_EXCEPTION1("Invalid columns (%li) in binary map file", lInvalid);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool OfflineMap::IsBinaryMapFile(
+	const std::string & strFile
+) {
+	FILE * fp = fopen(strFile.c_str(), "rb");
+	if (fp == NULL) {
+		return false;
+	}
 
-			pmapAttributes->insert(prAttribute);
-		}
+	char szMagic[8];
+	size_t sRead = fread(szMagic, 1, sizeof(szMagic), fp);
+	fclose(fp);
+
+	if (sRead != sizeof(szMagic)) {
+		return false;
 	}
+	return (memcmp(szMagic, BinaryMapMagic, sizeof(szMagic)) == 0);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void OfflineMap::Write(
-	const std::string & strTarget,
-	const std::map<std::string, std::string> & mapAttributes,
-	NcFile::FileFormat eOutputFormat
+void OfflineMap::ReadBinary(
+	const std::string & strSource,
+	std::map<std::string, std::string> * pmapAttributes
 ) {
-	// Temporarily change error reporting
-	NcError error_temp(NcError::verbose_fatal);
-
-	// Open an output file
-	NcFile ncMap(strTarget.c_str(), NcFile::Replace, NULL, 0, eOutputFormat);
-	if (!ncMap.is_valid()) {
-		_EXCEPTION1("Unable to open output map file \"%s\"",
-			strTarget.c_str());
+	if (sizeof(size_t) != sizeof(uint64_t)) {
+		_EXCEPTIONT("Binary map files require a 64-bit size_t");
 	}
 
-	// Attributes
-	ncMap.add_att("Title", "TempestRemap Offline Regridding Weight Generator");
+	// The mapping is copy-on-write so that arrays attached to it may be
+	// modified without affecting the file
+	std::shared_ptr<MemoryMappedFile> pmmapFile(new MemoryMappedFile);
+	pmmapFile->Open(strSource, true);
 
-	// Map dimensions
-	int nA = (int)(m_dSourceAreas.GetRows());
-	int nB = (int)(m_dTargetAreas.GetRows());
+	const MemoryMappedFile & mmapFile = *pmmapFile;
 
-	// Write output dimensions entries
-	int nSrcGridDims = (int)(m_vecSourceDimSizes.size());
-	int nDstGridDims = (int)(m_vecTargetDimSizes.size());
+	// Verify header
+	if (mmapFile.GetSize() < sizeof(BinaryMapHeader)) {
+		_EXCEPTION1("File \"%s\" is too small to be a binary map file",
+			strSource.c_str());
+	}
 
-	NcDim * dimSrcGridRank = ncMap.add_dim("src_grid_rank", nSrcGridDims);
-	NcDim * dimDstGridRank = ncMap.add_dim("dst_grid_rank", nDstGridDims);
+	const char * pFileData = static_cast<const char *>(mmapFile.GetData());
 
-	NcVar * varSrcGridDims =
-		ncMap.add_var("src_grid_dims", ncInt, dimSrcGridRank);
-	NcVar * varDstGridDims =
-		ncMap.add_var("dst_grid_dims", ncInt, dimDstGridRank);
+	BinaryMapHeader header;
+	memcpy(&header, pFileData, sizeof(BinaryMapHeader));
 
-	char szDim[64];
-	if ((nSrcGridDims == 1) && (m_vecSourceDimSizes[0] != nA)) {
-		varSrcGridDims->put(&nA, 1);
-		varSrcGridDims->add_att("name0", "num_dof");
+	if (memcmp(header.szMagic, BinaryMapMagic, sizeof(BinaryMapMagic)) != 0) {
+		_EXCEPTION1("File \"%s\" is not a binary map file",
+			strSource.c_str());
+	}
+	if (header.uByteOrderMark != BinaryMapByteOrderMark) {
+		_EXCEPTION1("Binary map file \"%s\" was written with a different byte order",
+			strSource.c_str());
+	}
+	if ((header.uVersion != BinaryMapVersion) &&
+	    (header.uVersion != BinaryMapVersionCompact)
+	) {
+		_EXCEPTION2("Binary map file \"%s\" has unsupported version %u",
+			strSource.c_str(), header.uVersion);
+	}
+	if (header.sPayloadBytes != mmapFile.GetSize() - sizeof(BinaryMapHeader)) {
+		_EXCEPTION1("Binary map file \"%s\" is truncated",
+			strSource.c_str());
+	}
 
-	} else {
-		for (int i = 0; i < m_vecSourceDimSizes.size(); i++) {
-			varSrcGridDims->set_cur(nSrcGridDims - i - 1);
-			varSrcGridDims->put(&(m_vecSourceDimSizes[i]), 1);
-		}
+	const char * pPayload = pFileData + sizeof(BinaryMapHeader);
+	const size_t sPayloadBytes = header.sPayloadBytes;
 
-		for (int i = 0; i < m_vecSourceDimSizes.size(); i++) {
-			sprintf(szDim, "name%i", i);
-			varSrcGridDims->add_att(szDim,
-				m_vecSourceDimNames[nSrcGridDims - i - 1].c_str());
-		}
+	if (BinaryMapChecksum::Compute(pPayload, sPayloadBytes) != header.uChecksum) {
+		_EXCEPTION1("Checksum mismatch in binary map file \"%s\"",
+			strSource.c_str());
 	}
 
-	if ((nDstGridDims == 1) && (m_vecTargetDimSizes[0] != nB)) {
-		varDstGridDims->put(&nB, 1);
-		varDstGridDims->add_att("name0", "num_dof");
+	const size_t nA = header.nSourceCount;
+	const size_t nB = header.nTargetCount;
+	const size_t nVA = header.nSourceVertices;
+	const size_t nVB = header.nTargetVertices;
+	const size_t nRows = header.nRows;
+	const size_t nS = header.nNonZeros;
+
+	size_t sOffset = 0;
+
+	// Read dimension sizes and names
+	size_t uBytes =
+		PeekBinaryMapBlockBytes(pPayload, sPayloadBytes, sOffset, "src_grid_dims");
+	const int * pSrcDimSizes =
+		ReadBinaryMapBlock<int>(pPayload, sPayloadBytes, sOffset,
+			uBytes / sizeof(int), "src_grid_dims");
+	m_vecSourceDimSizes.assign(pSrcDimSizes, pSrcDimSizes + uBytes / sizeof(int));
+
+	uBytes = PeekBinaryMapBlockBytes(pPayload, sPayloadBytes, sOffset, "dst_grid_dims");
+	const int * pDstDimSizes =
+		ReadBinaryMapBlock<int>(pPayload, sPayloadBytes, sOffset,
+			uBytes / sizeof(int), "dst_grid_dims");
+	m_vecTargetDimSizes.assign(pDstDimSizes, pDstDimSizes + uBytes / sizeof(int));
+
+	ReadBinaryMapStringBlock(pPayload, sPayloadBytes, sOffset,
+		m_vecSourceDimNames, "src_grid_names");
+	ReadBinaryMapStringBlock(pPayload, sPayloadBytes, sOffset,
+		m_vecTargetDimNames, "dst_grid_names");
+
+	if ((m_vecSourceDimNames.size() != m_vecSourceDimSizes.size()) ||
+	    (m_vecTargetDimNames.size() != m_vecTargetDimSizes.size())
+	) {
+		_EXCEPTION1("Binary map file \"%s\" has inconsistent dimensions",
+			strSource.c_str());
+	}
 
-	} else {
-		for (int i = 0; i < m_vecTargetDimSizes.size(); i++) {
-			varDstGridDims->set_cur(nDstGridDims - i - 1);
-			varDstGridDims->put(&(m_vecTargetDimSizes[i]), 1);
-		}
+	// Read attributes
+	std::vector<std::string> vecAttributes;
+	ReadBinaryMapStringBlock(pPayload, sPayloadBytes, sOffset,
+		vecAttributes, "attributes");
 
-		for (int i = 0; i < m_vecTargetDimSizes.size(); i++) {
-			sprintf(szDim, "name%i", i);
-			varDstGridDims->add_att(szDim,
-				m_vecTargetDimNames[nDstGridDims - i - 1].c_str());
+	if (vecAttributes.size() % 2 != 0) {
+		_EXCEPTION1("Binary map file \"%s\" has an invalid attribute block",
+			strSource.c_str());
+	}
+	if (pmapAttributes != NULL) {
+		for (size_t a = 0; a < vecAttributes.size(); a += 2) {
+			pmapAttributes->insert(
+				std::pair<std::string, std::string>(
+					vecAttributes[a], vecAttributes[a+1]));
 		}
 	}
 
-	// Source and Target mesh resolutions
-	NcDim * dimNA = ncMap.add_dim("n_a", nA);
-	NcDim * dimNB = ncMap.add_dim("n_b", nB);
+	// Attach coordinates, areas and masks to the mapping
+	m_pmeshSourceCoordinates = NULL;
+	m_pmeshTargetCoordinates = NULL;
+
+	AttachBinaryMapBlock(ReadBinaryMapBlock<double>(
+		pPayload, sPayloadBytes, sOffset, nA, "xc_a"), nA, m_dSourceCenterLon, pmmapFile);
+	AttachBinaryMapBlock(ReadBinaryMapBlock<double>(
+		pPayload, sPayloadBytes, sOffset, nA, "yc_a"), nA, m_dSourceCenterLat, pmmapFile);
+	AttachBinaryMapBlock(ReadBinaryMapBlock<double>(
+		pPayload, sPayloadBytes, sOffset, nB, "xc_b"), nB, m_dTargetCenterLon, pmmapFile);
+	AttachBinaryMapBlock(ReadBinaryMapBlock<double>(
+		pPayload, sPayloadBytes, sOffset, nB, "yc_b"), nB, m_dTargetCenterLat, pmmapFile);
+
+	AttachBinaryMapBlock(ReadBinaryMapBlock<double>(
+		pPayload, sPayloadBytes, sOffset, nA * nVA, "xv_a"),
+		nA, nVA, m_dSourceVertexLon, pmmapFile);
+	AttachBinaryMapBlock(ReadBinaryMapBlock<double>(
+		pPayload, sPayloadBytes, sOffset, nA * nVA, "yv_a"),
+		nA, nVA, m_dSourceVertexLat, pmmapFile);
+	AttachBinaryMapBlock(ReadBinaryMapBlock<double>(
+		pPayload, sPayloadBytes, sOffset, nB * nVB, "xv_b"),
+		nB, nVB, m_dTargetVertexLon, pmmapFile);
+	AttachBinaryMapBlock(ReadBinaryMapBlock<double>(
+		pPayload, sPayloadBytes, sOffset, nB * nVB, "yv_b"),
+		nB, nVB, m_dTargetVertexLat, pmmapFile);
 
-	// Number of nodes per Face
-	int nSourceNodesPerFace = m_dSourceVertexLon.GetColumns();
-	int nTargetNodesPerFace = m_dTargetVertexLon.GetColumns();
+	// Read vector centers and bounds
+	uBytes = PeekBinaryMapBlockBytes(pPayload, sPayloadBytes, sOffset, "latc_b");
+	const size_t nLatB = uBytes / sizeof(double);
+	AttachBinaryMapBlock(ReadBinaryMapBlock<double>(
+		pPayload, sPayloadBytes, sOffset, nLatB, "latc_b"),
+		nLatB, m_dVectorTargetCenterLat, pmmapFile);
+
+	uBytes = PeekBinaryMapBlockBytes(pPayload, sPayloadBytes, sOffset, "lonc_b");
+	const size_t nLonB = uBytes / sizeof(double);
+	AttachBinaryMapBlock(ReadBinaryMapBlock<double>(
+		pPayload, sPayloadBytes, sOffset, nLonB, "lonc_b"),
+		nLonB, m_dVectorTargetCenterLon, pmmapFile);
+
+	AttachBinaryMapBlock(ReadBinaryMapBlock<double>(
+		pPayload, sPayloadBytes, sOffset, 2 * nLatB, "lat_bnds"),
+		nLatB, 2, m_dVectorTargetBoundsLat, pmmapFile);
+	AttachBinaryMapBlock(ReadBinaryMapBlock<double>(
+		pPayload, sPayloadBytes, sOffset, 2 * nLonB, "lon_bnds"),
+		nLonB, 2, m_dVectorTargetBoundsLon, pmmapFile);
 
-	NcDim * dimNVA = ncMap.add_dim("nv_a", nSourceNodesPerFace);
-	NcDim * dimNVB = ncMap.add_dim("nv_b", nTargetNodesPerFace);
+	// Read areas
+	AttachBinaryMapBlock(ReadBinaryMapBlock<double>(
+		pPayload, sPayloadBytes, sOffset, nA, "area_a"), nA, m_dSourceAreas, pmmapFile);
+	AttachBinaryMapBlock(ReadBinaryMapBlock<double>(
+		pPayload, sPayloadBytes, sOffset, nB, "area_b"), nB, m_dTargetAreas, pmmapFile);
+
+	// Read masks, which are empty if not present
+	uBytes = PeekBinaryMapBlockBytes(pPayload, sPayloadBytes, sOffset, "mask_a");
+	const size_t nMaskA = (uBytes == 0)?(0):(nA);
+	AttachBinaryMapBlock(ReadBinaryMapBlock<int>(
+		pPayload, sPayloadBytes, sOffset, nMaskA, "mask_a"), nMaskA, m_iSourceMask, pmmapFile);
+
+	uBytes = PeekBinaryMapBlockBytes(pPayload, sPayloadBytes, sOffset, "mask_b");
+	const size_t nMaskB = (uBytes == 0)?(0):(nB);
+	AttachBinaryMapBlock(ReadBinaryMapBlock<int>(
+		pPayload, sPayloadBytes, sOffset, nMaskB, "mask_b"), nMaskB, m_iTargetMask, pmmapFile);
+
+	// The SparseMatrix is indexed by int
+	if ((header.nRows > static_cast<uint64_t>(INT_MAX)) ||
+	    (header.nCols > static_cast<uint64_t>(INT_MAX))
+	) {
+		_EXCEPTION1("Invalid matrix dimensions in binary map file \"%s\"",
+			strSource.c_str());
+	}
 
-	// Write coordinates
-	NcVar * varYCA = ncMap.add_var("yc_a", ncDouble, dimNA);
-	NcVar * varYCB = ncMap.add_var("yc_b", ncDouble, dimNB);
+	// Read the CSR row pointers, which must be nondecreasing so that each
+	// row refers to a valid range of entries
+	const size_t * pRowPtr =
+		ReadBinaryMapBlock<size_t>(
+			pPayload, sPayloadBytes, sOffset, nRows+1, "csr_row_ptr");
 
-	NcVar * varXCA = ncMap.add_var("xc_a", ncDouble, dimNA);
-	NcVar * varXCB = ncMap.add_var("xc_b", ncDouble, dimNB);
+	if (pRowPtr[0] != 0) {
+		_EXCEPTION1("Invalid CSR row pointers in binary map file \"%s\"",
+			strSource.c_str());
+	}
+	for (size_t i = 0; i < nRows; i++) {
+		if (pRowPtr[i+1] < pRowPtr[i]) {
+			_EXCEPTION1("Invalid CSR row pointers in binary map file \"%s\"",
+				strSource.c_str());
+		}
+	}
+	if (pRowPtr[nRows] != nS) {
+		_EXCEPTION1("Invalid CSR row pointers in binary map file \"%s\"",
+			strSource.c_str());
+	}
 
-	NcVar * varYVA = ncMap.add_var("yv_a", ncDouble, dimNA, dimNVA);
-	NcVar * varYVB = ncMap.add_var("yv_b", ncDouble, dimNB, dimNVB);
+	// Decode compact weights into memory, rescaling each row to the sum
+	// of its original weights
+	if (header.uVersion == BinaryMapVersionCompact) {
+		uBytes = PeekBinaryMapBlockBytes(
+			pPayload, sPayloadBytes, sOffset, "csr_col_deltas");
+		const unsigned char * pColsEncoded =
+			ReadBinaryMapBlock<unsigned char>(
+				pPayload, sPayloadBytes, sOffset, uBytes, "csr_col_deltas");
+
+		const BinaryMapWeightParams * pParams =
+			ReadBinaryMapBlock<BinaryMapWeightParams>(
+				pPayload, sPayloadBytes, sOffset, 1, "weight_params");
+		const double * pRowSums =
+			ReadBinaryMapBlock<double>(
+				pPayload, sPayloadBytes, sOffset, nRows, "row_sums");
+
+		DataArray1D<size_t> dataRowPtr(nRows+1);
+		memcpy(&(dataRowPtr[0]), pRowPtr, (nRows+1) * sizeof(size_t));
+
+		DataArray1D<int> dataCols(nS);
+		DataArray1D<double> dataValues(nS);
+
+		DecodeBinaryMapColumns(
+			pRowPtr, nRows, header.nCols, pColsEncoded, uBytes, dataCols);
+
+		if (pParams->uWeights == BinaryMapWeights_Single) {
+			const float * pValuesSingle =
+				ReadBinaryMapBlock<float>(
+					pPayload, sPayloadBytes, sOffset, nS, "csr_values");
+			for (size_t j = 0; j < nS; j++) {
+				dataValues[j] = static_cast<double>(pValuesSingle[j]);
+			}
 
-	NcVar * varXVA = ncMap.add_var("xv_a", ncDouble, dimNA, dimNVA);
-	NcVar * varXVB = ncMap.add_var("xv_b", ncDouble, dimNB, dimNVB);
+		} else if (pParams->uWeights == BinaryMapWeights_Quantized16) {
+			const uint16_t * pValuesQuantized =
+				ReadBinaryMapBlock<uint16_t>(
+					pPayload, sPayloadBytes, sOffset, nS, "csr_values");
+			for (size_t j = 0; j < nS; j++) {
+				dataValues[j] = pParams->dOffset
+					+ static_cast<double>(pValuesQuantized[j]) * pParams->dStep;
+			}
 
-	varYCA->add_att("units", "degrees");
-	varYCB->add_att("units", "degrees");
+		} else {
+			_EXCEPTION2("Binary map file \"%s\" has unsupported weight format %lu",
+				strSource.c_str(),
+				static_cast<unsigned long>(pParams->uWeights));
+		}
 
-	varXCA->add_att("units", "degrees");
-	varXCB->add_att("units", "degrees");
+		if (sOffset != sPayloadBytes) {
+			_EXCEPTION1("Unexpected trailing data in binary map file \"%s\"",
+				strSource.c_str());
+		}
 
-	varYVA->add_att("units", "degrees");
-	varYVB->add_att("units", "degrees");
+#pragma omp parallel for schedule(static)
+		for (long i = 0; i < static_cast<long>(nRows); i++) {
+			double dSum = 0.0;
+			for (size_t j = pRowPtr[i]; j < pRowPtr[i+1]; j++) {
+				dSum += dataValues[j];
+			}
+			if ((dSum == 0.0) || (pRowSums[i] == 0.0)) {
+				continue;
+			}
+			const double dScale = pRowSums[i] / dSum;
+			for (size_t j = pRowPtr[i]; j < pRowPtr[i+1]; j++) {
+				dataValues[j] *= dScale;
+			}
+		}
 
-	varXVA->add_att("units", "degrees");
-	varXVB->add_att("units", "degrees");
+		m_mapRemap.SetCSR(
+			static_cast<int>(nRows),
+			static_cast<int>(header.nCols),
+			std::move(dataRowPtr),
+			std::move(dataCols),
+			std::move(dataValues));
 
-	// Verify dimensionality
-	if (m_dSourceCenterLon.GetRows() != nA) {
-		_EXCEPTIONT("Mismatch between m_dSourceCenterLon and nA");
-	}
-	if (m_dSourceCenterLat.GetRows() != nA) {
-		_EXCEPTIONT("Mismatch between m_dSourceCenterLat and nA");
-	}
-	if (m_dTargetCenterLon.GetRows() != nB) {
-		_EXCEPTIONT("Mismatch between m_dTargetCenterLon and nB");
-	}
-	if (m_dTargetCenterLat.GetRows() != nB) {
-		_EXCEPTIONT("Mismatch between m_dTargetCenterLat and nB");
-	}
-	if (m_dSourceVertexLon.GetRows() != nA) {
-		_EXCEPTIONT("Mismatch between m_dSourceVertexLon and nA");
-	}
-	if (m_dSourceVertexLat.GetRows() != nA) {
-		_EXCEPTIONT("Mismatch between m_dSourceVertexLat and nA");
-	}
-	if (m_dTargetVertexLon.GetRows() != nB) {
-		_EXCEPTIONT("Mismatch between m_dTargetVertexLon and nB");
+		// The remaining arrays are attached to the mapping
+		m_pmmapBinary.reset();
+		return;
 	}
-	if (m_dTargetVertexLat.GetRows() != nB) {
-		_EXCEPTIONT("Mismatch between m_dTargetVertexLat and nB");
+
+	// Attach the SparseMatrix directly to the mapped CSR arrays
+	const int * pCols =
+		ReadBinaryMapBlock<int>(
+			pPayload, sPayloadBytes, sOffset, nS, "csr_cols");
+	const double * pValues =
+		ReadBinaryMapBlock<double>(
+			pPayload, sPayloadBytes, sOffset, nS, "csr_values");
+
+	if (sOffset != sPayloadBytes) {
+		_EXCEPTION1("Unexpected trailing data in binary map file \"%s\"",
+			strSource.c_str());
 	}
 
-	varYCA->put(&(m_dSourceCenterLat[0]), nA);
-	varYCB->put(&(m_dTargetCenterLat[0]), nB);
+	// Columns are used to index source data in Apply(), so they are
+	// verified even though the arrays are used in place
+	ValidateBinaryMapColumns(pCols, nS, header.nCols);
 
-	varXCA->put(&(m_dSourceCenterLon[0]), nA);
-	varXCB->put(&(m_dTargetCenterLon[0]), nB);
+	m_mapRemap.AttachCSR(
+		static_cast<int>(nRows),
+		static_cast<int>(header.nCols),
+		nS,
+		pRowPtr,
+		pCols,
+		pValues);
 
-	varYVA->put(&(m_dSourceVertexLat[0][0]), nA, nSourceNodesPerFace);
-	varYVB->put(&(m_dTargetVertexLat[0][0]), nB, nTargetNodesPerFace);
+	// Retain the mapping for the lifetime of the SparseMatrix view
+	m_pmmapBinary = pmmapFile;
+}
 
-	varXVA->put(&(m_dSourceVertexLon[0][0]), nA, nSourceNodesPerFace);
-	varXVB->put(&(m_dTargetVertexLon[0][0]), nB, nTargetNodesPerFace);
+///////////////////////////////////////////////////////////////////////////////
 
-	// Write vector centers
-	if ((m_dVectorTargetCenterLat.GetRows() != 0) &&
-		(m_dVectorTargetCenterLon.GetRows() != 0)
-	) {
-		NcDim * dimLatB =
-			ncMap.add_dim("lat_b", m_dVectorTargetCenterLat.GetRows());
-		NcDim * dimLonB =
-			ncMap.add_dim("lon_b", m_dVectorTargetCenterLon.GetRows());
+void OfflineMap::WriteBinary(
+	const std::string & strTarget,
+	const std::map<std::string, std::string> & mapAttributes,
+	BinaryMapWeights eWeights
+) {
+	if (sizeof(size_t) != sizeof(uint64_t)) {
+		_EXCEPTIONT("Binary map files require a 64-bit size_t");
+	}
 
-		NcVar * varLatCB = ncMap.add_var("latc_b", ncDouble, dimLatB);
-		NcVar * varLonCB = ncMap.add_var("lonc_b", ncDouble, dimLonB);
+	m_mapRemap.Finalize();
 
-		varLatCB->put(&(m_dVectorTargetCenterLat[0]), dimLatB->size());
-		varLonCB->put(&(m_dVectorTargetCenterLon[0]), dimLonB->size());
+	ResolveCoordinates();
 
-		NcDim * dimBounds = ncMap.add_dim("bnds", 2);
-		NcVar * varLatBounds =
-			ncMap.add_var("lat_bnds", ncDouble, dimLatB, dimBounds);
-		NcVar * varLonBounds =
-			ncMap.add_var("lon_bnds", ncDouble, dimLonB, dimBounds);
+	const DataArray1D<size_t> & dataRowPtr = m_mapRemap.GetCSRRowPointers();
+	const DataArray1D<int> & dataCols = m_mapRemap.GetCSRColumns();
+	const DataArray1D<double> & dataValues = m_mapRemap.GetCSRValues();
 
-		varLatBounds->put(&(m_dVectorTargetBoundsLat[0][0]),
-			m_dVectorTargetBoundsLat.GetRows(), 2);
-		varLonBounds->put(&(m_dVectorTargetBoundsLon[0][0]),
-			m_dVectorTargetBoundsLon.GetRows(), 2);
-	}
+	const size_t nS = dataValues.GetRows();
 
-	// Write areas
-	NcVar * varAreaA = ncMap.add_var("area_a", ncDouble, dimNA);
-	varAreaA->put(&(m_dSourceAreas[0]), nA);
-	varAreaA->add_att("units", "steradians");
+	// Encode compact weights
+	std::map<std::string, std::string> mapAttributesOut = mapAttributes;
 
-	NcVar * varAreaB = ncMap.add_var("area_b", ncDouble, dimNB);
-	varAreaB->put(&(m_dTargetAreas[0]), nB);
-	varAreaB->add_att("units", "steradians");
+	std::vector<unsigned char> vecColsEncoded;
+	DataArray1D<double> dRowSums;
+	DataArray1D<float> vecValuesSingle;
+	DataArray1D<uint16_t> vecValuesQuantized;
 
-	// Write masks
-	if (m_iSourceMask.IsAttached()) {
-		NcVar * varMaskA = ncMap.add_var("mask_a", ncInt, dimNA);
-		varMaskA->put(&(m_iSourceMask[0]), nA);
-		varMaskA->add_att("units", "unitless");
+	BinaryMapWeightParams params;
+	memset(&params, 0, sizeof(BinaryMapWeightParams));
+	params.uWeights = static_cast<uint64_t>(eWeights);
 
-		if (!m_iTargetMask.IsAttached()) {
-			NcVar * varMaskB = ncMap.add_var("mask_b", ncInt, dimNB);
-			DataArray1D<int> iTargetMaskTemp(nB);
-			for (int i = 0; i < nB; i++) {
-				iTargetMaskTemp[i] = 1;
-			}
-			varMaskB->put(&(iTargetMaskTemp[0]), nB);
-			varMaskB->add_att("units", "unitless");
-		}
-	}
+	if (eWeights != BinaryMapWeights_Double) {
+		EncodeBinaryMapColumns(dataRowPtr, dataCols, vecColsEncoded);
 
-	if (m_iTargetMask.IsAttached()) {
-		if (!m_iSourceMask.IsAttached()) {
-			NcVar * varMaskA = ncMap.add_var("mask_a", ncInt, dimNA);
-			DataArray1D<int> iSourceMaskTemp(nA);
-			for (int i = 0; i < nA; i++) {
-				iSourceMaskTemp[i] = 1;
-			}
-			varMaskA->put(&(iSourceMaskTemp[0]), nA);
-			varMaskA->add_att("units", "unitless");
-		}
+		CalculateRowSums(m_mapRemap, dRowSums);
 
-		NcVar * varMaskB = ncMap.add_var("mask_b", ncInt, dimNB);
-		varMaskB->put(&(m_iTargetMask[0]), nB);
-		varMaskB->add_att("units", "unitless");
-	}
+		if (eWeights == BinaryMapWeights_Single) {
+			vecValuesSingle.Allocate(nS);
+			for (size_t j = 0; j < nS; j++) {
+				vecValuesSingle[j] = static_cast<float>(dataValues[j]);
+				params.dMaxError = std::max(params.dMaxError,
+					fabs(static_cast<double>(vecValuesSingle[j]) - dataValues[j]));
+			}
 
-	// Write SparseMatrix entries
-	DataArray1D<int> vecRow;
-	DataArray1D<int> vecCol;
-	DataArray1D<double> vecS;
+		} else if (eWeights == BinaryMapWeights_Quantized16) {
+			double dMin = 0.0;
+			double dMax = 0.0;
+			for (size_t j = 0; j < nS; j++) {
+				if ((j == 0) || (dataValues[j] < dMin)) {
+					dMin = dataValues[j];
+				}
+				if ((j == 0) || (dataValues[j] > dMax)) {
+					dMax = dataValues[j];
+				}
+			}
 
-	m_mapRemap.GetEntries(vecRow, vecCol, vecS);
+			params.dOffset = dMin;
+			params.dStep = (dMax - dMin) / 65535.0;
+			if (params.dStep == 0.0) {
+				params.dStep = 1.0;
+			}
 
-	// Calculate and write fractional coverage arrays
-	{
-		DataArray1D<double> dFracA(nA);
-		DataArray1D<double> dFracB(nB);
+			vecValuesQuantized.Allocate(nS);
+			for (size_t j = 0; j < nS; j++) {
+				double dQ = floor((dataValues[j] - dMin) / params.dStep + 0.5);
+				dQ = std::max(0.0, std::min(65535.0, dQ));
+				vecValuesQuantized[j] = static_cast<uint16_t>(dQ);
+				params.dMaxError = std::max(params.dMaxError,
+					fabs(dMin + dQ * params.dStep - dataValues[j]));
+			}
 
-		for (int i = 0; i < vecS.GetRows(); i++) {
-			dFracA[vecCol[i]] += vecS[i] / m_dSourceAreas[vecCol[i]] * m_dTargetAreas[vecRow[i]];
-			dFracB[vecRow[i]] += vecS[i];
+		} else {
+			_EXCEPTIONT("Invalid binary map weight format");
 		}
 
-		NcVar * varFracA = ncMap.add_var("frac_a", ncDouble, dimNA);
-		varFracA->put(&(dFracA[0]), nA);
-		varFracA->add_att("name", "fraction of target coverage of source dof");
-		varFracA->add_att("units", "unitless");
+		char szMaxError[64];
+		snprintf(szMaxError, 64, "%1.15e", params.dMaxError);
+		mapAttributesOut["weight_max_error"] = szMaxError;
+	}
 
-		NcVar * varFracB = ncMap.add_var("frac_b", ncDouble, dimNB);
-		varFracB->put(&(dFracB[0]), nB);
-		varFracB->add_att("name", "fraction of source coverage of target dof");
-		varFracB->add_att("units", "unitless");
+	FILE * fp = fopen(strTarget.c_str(), "wb");
+	if (fp == NULL) {
+		_EXCEPTION1("Unable to open output map file \"%s\"",
+			strTarget.c_str());
 	}
 
-	// Increment vecRow and vecCol
-	for (int i = 0; i < vecRow.GetRows(); i++) {
-		vecRow[i]++;
-		vecCol[i]++;
+	BinaryMapHeader header;
+	memset(&header, 0, sizeof(BinaryMapHeader));
+	memcpy(header.szMagic, BinaryMapMagic, sizeof(BinaryMapMagic));
+	header.uVersion = (eWeights == BinaryMapWeights_Double)?
+		(BinaryMapVersion):(BinaryMapVersionCompact);
+	header.uByteOrderMark = BinaryMapByteOrderMark;
+	header.nSourceCount = m_dSourceAreas.GetRows();
+	header.nTargetCount = m_dTargetAreas.GetRows();
+	header.nSourceVertices = m_dSourceVertexLon.GetColumns();
+	header.nTargetVertices = m_dTargetVertexLon.GetColumns();
+	header.nRows = m_mapRemap.GetRows();
+	header.nCols = m_mapRemap.GetColumns();
+	header.nNonZeros = m_mapRemap.GetNonZeroCount();
+
+	if ((m_dSourceCenterLon.GetRows() != header.nSourceCount) ||
+	    (m_dTargetCenterLon.GetRows() != header.nTargetCount) ||
+	    ((header.nSourceVertices != 0) &&
+	     (m_dSourceVertexLon.GetRows() != header.nSourceCount)) ||
+	    ((header.nTargetVertices != 0) &&
+	     (m_dTargetVertexLon.GetRows() != header.nTargetCount))
+	) {
+		fclose(fp);
+		_EXCEPTIONT("Map coordinates inconsistent with map areas");
 	}
 
-	// Write out data
-	int nS = vecRow.GetRows();
-	NcDim * dimNS = ncMap.add_dim("n_s", nS);
+	// Write placeholder header, replaced once the checksum is known
+	if (fwrite(&header, sizeof(BinaryMapHeader), 1, fp) != 1) {
+		fclose(fp);
+		_EXCEPTION1("Error writing binary map file \"%s\"",
+			strTarget.c_str());
+	}
 
-	NcVar * varRow = ncMap.add_var("row", ncInt, dimNS);
-	varRow->add_att("name", "sparse matrix target dof index");
-	varRow->add_att("first_index", "1");
+	BinaryMapChecksum checksum;
+	uint64_t & sPayloadBytes = header.sPayloadBytes;
+
+	try {
+		// Dimensions
+		WriteBinaryMapBlock(fp,
+			(m_vecSourceDimSizes.size() == 0)?(NULL):(&(m_vecSourceDimSizes[0])),
+			m_vecSourceDimSizes.size() * sizeof(int), checksum, sPayloadBytes);
+		WriteBinaryMapBlock(fp,
+			(m_vecTargetDimSizes.size() == 0)?(NULL):(&(m_vecTargetDimSizes[0])),
+			m_vecTargetDimSizes.size() * sizeof(int), checksum, sPayloadBytes);
+		WriteBinaryMapStringBlock(fp,
+			m_vecSourceDimNames, checksum, sPayloadBytes);
+		WriteBinaryMapStringBlock(fp,
+			m_vecTargetDimNames, checksum, sPayloadBytes);
+
+		// Attributes
+		std::vector<std::string> vecAttributes;
+		std::map<std::string, std::string>::const_iterator iterAttributes =
+			mapAttributesOut.begin();
+		for (; iterAttributes != mapAttributesOut.end(); iterAttributes++) {
+			vecAttributes.push_back(iterAttributes->first);
+			vecAttributes.push_back(iterAttributes->second);
+		}
+		WriteBinaryMapStringBlock(fp, vecAttributes, checksum, sPayloadBytes);
+
+		// Coordinates
+		const DataArray1D<double> * vecCenters[4] = {
+			&m_dSourceCenterLon, &m_dSourceCenterLat,
+			&m_dTargetCenterLon, &m_dTargetCenterLat };
+		for (int i = 0; i < 4; i++) {
+			WriteBinaryMapBlock(fp, &((*vecCenters[i])[0]),
+				vecCenters[i]->GetRows() * sizeof(double), checksum, sPayloadBytes);
+		}
 
-	NcVar * varCol = ncMap.add_var("col", ncInt, dimNS);
-	varCol->add_att("name", "sparse matrix source dof index");
-	varCol->add_att("first_index", "1");
+		const DataArray2D<double> * vecVertices[4] = {
+			&m_dSourceVertexLon, &m_dSourceVertexLat,
+			&m_dTargetVertexLon, &m_dTargetVertexLat };
+		for (int i = 0; i < 4; i++) {
+			size_t sCount = vecVertices[i]->GetTotalSize();
+			WriteBinaryMapBlock(fp,
+				(sCount == 0)?(NULL):(&((*vecVertices[i])[0][0])),
+				sCount * sizeof(double), checksum, sPayloadBytes);
+		}
 
-	NcVar * varS = ncMap.add_var("S", ncDouble, dimNS);
-	varS->add_att("name", "sparse matrix coefficient");
+		// Vector centers and bounds
+		size_t nLatB = m_dVectorTargetCenterLat.GetRows();
+		size_t nLonB = m_dVectorTargetCenterLon.GetRows();
+		if ((m_dVectorTargetBoundsLat.GetRows() != nLatB) ||
+		    (m_dVectorTargetBoundsLon.GetRows() != nLonB)
+		) {
+			_EXCEPTIONT("Vector bounds inconsistent with vector centers");
+		}
 
-	varRow->set_cur((long)0);
-	varRow->put(&(vecRow[0]), nS);
+		WriteBinaryMapBlock(fp,
+			(nLatB == 0)?(NULL):(&(m_dVectorTargetCenterLat[0])),
+			nLatB * sizeof(double), checksum, sPayloadBytes);
+		WriteBinaryMapBlock(fp,
+			(nLonB == 0)?(NULL):(&(m_dVectorTargetCenterLon[0])),
+			nLonB * sizeof(double), checksum, sPayloadBytes);
+		WriteBinaryMapBlock(fp,
+			(nLatB == 0)?(NULL):(&(m_dVectorTargetBoundsLat[0][0])),
+			2 * nLatB * sizeof(double), checksum, sPayloadBytes);
+		WriteBinaryMapBlock(fp,
+			(nLonB == 0)?(NULL):(&(m_dVectorTargetBoundsLon[0][0])),
+			2 * nLonB * sizeof(double), checksum, sPayloadBytes);
+
+		// Areas
+		WriteBinaryMapBlock(fp, &(m_dSourceAreas[0]),
+			m_dSourceAreas.GetRows() * sizeof(double), checksum, sPayloadBytes);
+		WriteBinaryMapBlock(fp, &(m_dTargetAreas[0]),
+			m_dTargetAreas.GetRows() * sizeof(double), checksum, sPayloadBytes);
+
+		// Masks
+		WriteBinaryMapBlock(fp,
+			(m_iSourceMask.GetRows() == 0)?(NULL):(&(m_iSourceMask[0])),
+			m_iSourceMask.GetRows() * sizeof(int), checksum, sPayloadBytes);
+		WriteBinaryMapBlock(fp,
+			(m_iTargetMask.GetRows() == 0)?(NULL):(&(m_iTargetMask[0])),
+			m_iTargetMask.GetRows() * sizeof(int), checksum, sPayloadBytes);
+
+		// SparseMatrix in CSR form
+		WriteBinaryMapBlock(fp, &(dataRowPtr[0]),
+			dataRowPtr.GetRows() * sizeof(size_t), checksum, sPayloadBytes);
+
+		if (eWeights == BinaryMapWeights_Double) {
+			WriteBinaryMapBlock(fp,
+				(dataCols.GetRows() == 0)?(NULL):(&(dataCols[0])),
+				dataCols.GetRows() * sizeof(int), checksum, sPayloadBytes);
+			WriteBinaryMapBlock(fp,
+				(nS == 0)?(NULL):(&(dataValues[0])),
+				nS * sizeof(double), checksum, sPayloadBytes);
 
-	varCol->set_cur((long)0);
-	varCol->put(&(vecCol[0]), nS);
+		} else {
+			const size_t nRows = dataRowPtr.GetRows() - 1;
+
+			WriteBinaryMapBlock(fp,
+				(vecColsEncoded.size() == 0)?(NULL):(&(vecColsEncoded[0])),
+				vecColsEncoded.size(), checksum, sPayloadBytes);
+			WriteBinaryMapBlock(fp, &params,
+				sizeof(BinaryMapWeightParams), checksum, sPayloadBytes);
+			WriteBinaryMapBlock(fp,
+				(nRows == 0)?(NULL):(&(dRowSums[0])),
+				nRows * sizeof(double), checksum, sPayloadBytes);
+
+			if (eWeights == BinaryMapWeights_Single) {
+				WriteBinaryMapBlock(fp,
+					(nS == 0)?(NULL):(&(vecValuesSingle[0])),
+					nS * sizeof(float), checksum, sPayloadBytes);
+			} else {
+				WriteBinaryMapBlock(fp,
+					(nS == 0)?(NULL):(&(vecValuesQuantized[0])),
+					nS * sizeof(uint16_t), checksum, sPayloadBytes);
+			}
+		}
 
-	varS->set_cur((long)0);
-	varS->put(&(vecS[0]), nS);
+	} catch(...) {
+		fclose(fp);
+		throw;
+	}
 
-	// Add global attributes
-	std::map<std::string, std::string>::const_iterator iterAttributes =
-		mapAttributes.begin();
-	for (; iterAttributes != mapAttributes.end(); iterAttributes++) {
-		ncMap.add_att(
-			iterAttributes->first.c_str(),
-			iterAttributes->second.c_str());
+	// Write final header
+	header.uChecksum = checksum.GetChecksum();
+
+	if ((fseek(fp, 0, SEEK_SET) != 0) ||
+	    (fwrite(&header, sizeof(BinaryMapHeader), 1, fp) != 1)
+	) {
+		fclose(fp);
+		_EXCEPTION1("Error writing binary map file \"%s\"",
+			strTarget.c_str());
+	}
+
+	if (fclose(fp) != 0) {
+		_EXCEPTION1("Error writing binary map file \"%s\"",
+			strTarget.c_str());
 	}
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
 void OfflineMap::SetTranspose(
-	const OfflineMap & mapIn
+	const OfflineMap & mapIn,
+	bool fAreaWeighted
 ) {
 	m_dSourceAreas = mapIn.m_dTargetAreas;
 	m_dTargetAreas = mapIn.m_dSourceAreas;
@@ -2523,6 +5583,9 @@ void OfflineMap::SetTranspose(
 	m_iSourceMask = mapIn.m_iTargetMask;
 	m_iTargetMask = mapIn.m_iSourceMask;
 
+	m_pmeshSourceCoordinates = mapIn.m_pmeshTargetCoordinates;
+	m_pmeshTargetCoordinates = mapIn.m_pmeshSourceCoordinates;
+
 	m_dSourceCenterLon = mapIn.m_dTargetCenterLon;
 	m_dSourceCenterLat = mapIn.m_dTargetCenterLat;
 	m_dTargetCenterLon = mapIn.m_dSourceCenterLon;
@@ -2548,62 +5611,399 @@ void OfflineMap::SetTranspose(
 	m_vecTargetDimSizes = mapIn.m_vecSourceDimSizes;
 	m_vecTargetDimNames = mapIn.m_vecSourceDimNames;
 
-	DataArray1D<int> dataRows;
-	DataArray1D<int> dataCols;
-	DataArray1D<double> dataEntries;
+	// Transpose the map in CSR form
+	SparseMatrix<double> smatIn;
+	const SparseMatrix<double> * psmatIn = &(mapIn.m_mapRemap);
+	if (!psmatIn->IsFinalized()) {
+		smatIn = mapIn.m_mapRemap;
+		smatIn.Finalize();
+		psmatIn = &smatIn;
+	}
+
+	psmatIn->Transpose(m_mapRemap);
 
-	mapIn.m_mapRemap.GetEntries(dataRows, dataCols, dataEntries);
-/*
-	DataArray1D<double> dTargetCoverage(mapIn.m_dTargetAreas.GetRows());
-	for (size_t s = 0; s < dataEntries.GetRows(); s++) {
-		dTargetCoverage[dataRows[s]] +=
-			mapIn.m_dTargetAreas[dataRows[s]];
+	if (!fAreaWeighted) {
+		return;
 	}
-*/
-	for (size_t s = 0; s < dataEntries.GetRows(); s++) {
-		dataEntries[s] *=
-			mapIn.m_dTargetAreas[dataRows[s]]
-			/ mapIn.m_dSourceAreas[dataCols[s]];
+
+	// Entry (j,i) of the transpose is weighted by the ratio of the
+	// area of target face i to the area of source face j
+	DataArray1D<double> dInverseTargetAreas(m_dTargetAreas.GetRows());
+	for (int j = 0; j < dInverseTargetAreas.GetRows(); j++) {
+		dInverseTargetAreas[j] = 1.0 / m_dTargetAreas[j];
 	}
 
-	m_mapRemap.SetEntries(dataCols, dataRows, dataEntries);
+	m_mapRemap.ScaleEntries(dInverseTargetAreas, m_dSourceAreas);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
-int OfflineMap::IsConsistent(
-	double dTolerance,
-	const DataArray1D<int> & dataRows,
-	const DataArray1D<int> & dataCols,
-	const DataArray1D<double> & dataEntries,
-	DataArray1D<double> * pdRowSums
+void OfflineMap::SetComposition(
+	const OfflineMap & mapFirst,
+	const OfflineMap & mapSecond
 ) {
-	int nCount = 0;
+	if (mapFirst.m_dTargetAreas.GetRows() != mapSecond.m_dSourceAreas.GetRows()) {
+		_EXCEPTION2("Target grid of first map (%i faces) does not match"
+			" source grid of second map (%i faces)",
+			mapFirst.m_dTargetAreas.GetRows(),
+			mapSecond.m_dSourceAreas.GetRows());
+	}
+
+	// Source description from the first map
+	m_dSourceAreas = mapFirst.m_dSourceAreas;
+	m_iSourceMask = mapFirst.m_iSourceMask;
+	m_pmeshSourceCoordinates = mapFirst.m_pmeshSourceCoordinates;
+	m_dSourceCenterLon = mapFirst.m_dSourceCenterLon;
+	m_dSourceCenterLat = mapFirst.m_dSourceCenterLat;
+	m_dSourceVertexLon = mapFirst.m_dSourceVertexLon;
+	m_dSourceVertexLat = mapFirst.m_dSourceVertexLat;
+	m_dVectorSourceCenterLon = mapFirst.m_dVectorSourceCenterLon;
+	m_dVectorSourceCenterLat = mapFirst.m_dVectorSourceCenterLat;
+	m_dVectorSourceBoundsLon = mapFirst.m_dVectorSourceBoundsLon;
+	m_dVectorSourceBoundsLat = mapFirst.m_dVectorSourceBoundsLat;
+	m_vecSourceDimSizes = mapFirst.m_vecSourceDimSizes;
+	m_vecSourceDimNames = mapFirst.m_vecSourceDimNames;
+
+	// Target description from the second map
+	m_dTargetAreas = mapSecond.m_dTargetAreas;
+	m_iTargetMask = mapSecond.m_iTargetMask;
+	m_pmeshTargetCoordinates = mapSecond.m_pmeshTargetCoordinates;
+	m_dTargetCenterLon = mapSecond.m_dTargetCenterLon;
+	m_dTargetCenterLat = mapSecond.m_dTargetCenterLat;
+	m_dTargetVertexLon = mapSecond.m_dTargetVertexLon;
+	m_dTargetVertexLat = mapSecond.m_dTargetVertexLat;
+	m_dVectorTargetCenterLon = mapSecond.m_dVectorTargetCenterLon;
+	m_dVectorTargetCenterLat = mapSecond.m_dVectorTargetCenterLat;
+	m_dVectorTargetBoundsLon = mapSecond.m_dVectorTargetBoundsLon;
+	m_dVectorTargetBoundsLat = mapSecond.m_dVectorTargetBoundsLat;
+	m_vecTargetDimSizes = mapSecond.m_vecTargetDimSizes;
+	m_vecTargetDimNames = mapSecond.m_vecTargetDimNames;
+
+	// Multiply the maps in CSR form
+	SparseMatrix<double> smatFirst;
+	const SparseMatrix<double> * psmatFirst = &(mapFirst.m_mapRemap);
+	if (!psmatFirst->IsFinalized()) {
+		smatFirst = mapFirst.m_mapRemap;
+		smatFirst.Finalize();
+		psmatFirst = &smatFirst;
+	}
+
+	SparseMatrix<double> smatSecond;
+	const SparseMatrix<double> * psmatSecond = &(mapSecond.m_mapRemap);
+	if (!psmatSecond->IsFinalized()) {
+		smatSecond = mapSecond.m_mapRemap;
+		smatSecond.Finalize();
+		psmatSecond = &smatSecond;
+	}
+
+	psmatSecond->Multiply(*psmatFirst, m_mapRemap);
+}
 
-	// Calculate row sums
-	if (m_mapRemap.GetRows() < 1) {
-		_EXCEPTIONT("IsConservative() called on map with no rows");
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Add a value to a sum with Neumaier compensated summation.
+///	</summary>
+static inline void CompensatedAdd(
+	double & dSum,
+	double & dCompensation,
+	double dValue
+) {
+	const double dNewSum = dSum + dValue;
+	if (fabs(dSum) >= fabs(dValue)) {
+		dCompensation += (dSum - dNewSum) + dValue;
+	} else {
+		dCompensation += (dValue - dNewSum) + dSum;
+	}
+	dSum = dNewSum;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+const SparseMatrix<double> & OfflineMap::GetFinalizedMap(
+	SparseMatrix<double> & smatTemp
+) const {
+	if (m_mapRemap.IsFinalized()) {
+		return m_mapRemap;
+	}
+	smatTemp = m_mapRemap;
+	smatTemp.Finalize();
+	return smatTemp;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Copy the given degrees of freedom of an array with one entry per
+///		degree of freedom.  Arrays that have not been loaded (with fewer
+///		than sDofs entries) are left empty.
+///	</summary>
+template <typename T>
+static void SubsetDegreesOfFreedom(
+	const DataArray1D<T> & dataIn,
+	size_t sDofs,
+	const std::vector<int> & vecIx,
+	DataArray1D<T> & dataOut
+) {
+	DataArray1D<T> dataSubset;
+	if (dataIn.GetRows() == sDofs) {
+		dataSubset.Allocate(vecIx.size());
+		for (size_t i = 0; i < vecIx.size(); i++) {
+			dataSubset[i] = dataIn[vecIx[i]];
+		}
+	}
+	dataOut = std::move(dataSubset);
+}
+
+///	<summary>
+///		Copy the given rows of an array with one row per degree of freedom.
+///	</summary>
+template <typename T>
+static void SubsetDegreesOfFreedom(
+	const DataArray2D<T> & dataIn,
+	size_t sDofs,
+	const std::vector<int> & vecIx,
+	DataArray2D<T> & dataOut
+) {
+	DataArray2D<T> dataSubset;
+	if (dataIn.GetRows() == sDofs) {
+		const size_t sColumns = dataIn.GetColumns();
+		dataSubset.Allocate(vecIx.size(), sColumns);
+		for (size_t i = 0; i < vecIx.size(); i++) {
+		for (size_t j = 0; j < sColumns; j++) {
+			dataSubset[i][j] = dataIn[vecIx[i]][j];
+		}
+		}
+	}
+	dataOut = std::move(dataSubset);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OfflineMap::SetSubset(
+	const OfflineMap & mapIn,
+	const std::vector<int> & vecTargetIx,
+	std::vector<int> * pvecSourceIx
+) {
+	if (&mapIn == this) {
+		_EXCEPTIONT("Map cannot be set to a subset of itself");
+	}
+	if ((mapIn.m_pmeshSourceCoordinates != NULL) ||
+	    (mapIn.m_pmeshTargetCoordinates != NULL)
+	) {
+		_EXCEPTIONT("Coordinates of input map must be resolved before "
+			"taking a subset");
+	}
+
+	const int nA = static_cast<int>(mapIn.m_dSourceAreas.GetRows());
+	const int nB = static_cast<int>(mapIn.m_dTargetAreas.GetRows());
+
+	// Verify the target degrees of freedom
+	{
+		std::vector<char> vecTargetSelected(nB, 0);
+		for (size_t i = 0; i < vecTargetIx.size(); i++) {
+			const int ix = vecTargetIx[i];
+			if ((ix < 0) || (ix >= nB)) {
+				_EXCEPTION2("Target index %i out of range in map "
+					"with %i target degrees of freedom", ix + 1, nB);
+			}
+			if (vecTargetSelected[ix]) {
+				_EXCEPTION1("Target index %i repeated in subset", ix + 1);
+			}
+			vecTargetSelected[ix] = 1;
+		}
+	}
+
+	// Only the selected rows of the map are visited.  Rows beyond the last
+	// row with entries (such as rows discarded in Read()) are empty.
+	SparseMatrix<double> smatTemp;
+	const SparseMatrix<double> & smatIn = mapIn.GetFinalizedMap(smatTemp);
+
+	const int nRowsIn = smatIn.GetRows();
+	const DataArray1D<size_t> & dataRowPtr = smatIn.GetCSRRowPointers();
+	const DataArray1D<int> & dataCols = smatIn.GetCSRColumns();
+	const DataArray1D<double> & dataValues = smatIn.GetCSRValues();
+
+	// Compact the source degrees of freedom to those that are referenced,
+	// preserving their order
+	std::vector<int> vecSourceNewIx(nA, -1);
+	size_t sNonZeros = 0;
+	for (size_t i = 0; i < vecTargetIx.size(); i++) {
+		const int iRow = vecTargetIx[i];
+		if (iRow >= nRowsIn) {
+			continue;
+		}
+		for (size_t j = dataRowPtr[iRow]; j < dataRowPtr[iRow+1]; j++) {
+			const int iCol = dataCols[j];
+			if ((iCol < 0) || (iCol >= nA)) {
+				_EXCEPTION2("Source index %i out of range in map "
+					"with %i source degrees of freedom", iCol + 1, nA);
+			}
+			vecSourceNewIx[iCol] = 0;
+		}
+		sNonZeros += dataRowPtr[iRow+1] - dataRowPtr[iRow];
+	}
+
+	std::vector<int> vecSourceIx;
+	for (int i = 0; i < nA; i++) {
+		if (vecSourceNewIx[i] == 0) {
+			vecSourceNewIx[i] = static_cast<int>(vecSourceIx.size());
+			vecSourceIx.push_back(i);
+		}
+	}
+
+	// Extract the entries of the selected rows
+	DataArray1D<int> vecRow(sNonZeros);
+	DataArray1D<int> vecCol(sNonZeros);
+	DataArray1D<double> vecS(sNonZeros);
+
+	size_t ix = 0;
+	for (size_t i = 0; i < vecTargetIx.size(); i++) {
+		const int iRow = vecTargetIx[i];
+		if (iRow >= nRowsIn) {
+			continue;
+		}
+		for (size_t j = dataRowPtr[iRow]; j < dataRowPtr[iRow+1]; j++) {
+			vecRow[ix] = static_cast<int>(i);
+			vecCol[ix] = vecSourceNewIx[dataCols[j]];
+			vecS[ix] = dataValues[j];
+			ix++;
+		}
+	}
+
+	m_mapRemap.SetFinalizedEntries(vecRow, vecCol, vecS);
+
+	m_pmmapBinary.reset();
+
+	// Subset the arrays associated with each degree of freedom
+	SubsetDegreesOfFreedom(mapIn.m_dSourceAreas, nA, vecSourceIx, m_dSourceAreas);
+	SubsetDegreesOfFreedom(mapIn.m_dTargetAreas, nB, vecTargetIx, m_dTargetAreas);
+
+	SubsetDegreesOfFreedom(mapIn.m_iSourceMask, nA, vecSourceIx, m_iSourceMask);
+	SubsetDegreesOfFreedom(mapIn.m_iTargetMask, nB, vecTargetIx, m_iTargetMask);
+
+	SubsetDegreesOfFreedom(mapIn.m_dSourceCenterLon, nA, vecSourceIx, m_dSourceCenterLon);
+	SubsetDegreesOfFreedom(mapIn.m_dSourceCenterLat, nA, vecSourceIx, m_dSourceCenterLat);
+	SubsetDegreesOfFreedom(mapIn.m_dTargetCenterLon, nB, vecTargetIx, m_dTargetCenterLon);
+	SubsetDegreesOfFreedom(mapIn.m_dTargetCenterLat, nB, vecTargetIx, m_dTargetCenterLat);
+
+	SubsetDegreesOfFreedom(mapIn.m_dSourceVertexLon, nA, vecSourceIx, m_dSourceVertexLon);
+	SubsetDegreesOfFreedom(mapIn.m_dSourceVertexLat, nA, vecSourceIx, m_dSourceVertexLat);
+	SubsetDegreesOfFreedom(mapIn.m_dTargetVertexLon, nB, vecTargetIx, m_dTargetVertexLon);
+	SubsetDegreesOfFreedom(mapIn.m_dTargetVertexLat, nB, vecTargetIx, m_dTargetVertexLat);
+
+	m_pmeshSourceCoordinates = NULL;
+	m_pmeshTargetCoordinates = NULL;
+
+	// The subset grids are unstructured
+	m_dVectorSourceCenterLon = DataArray1D<double>();
+	m_dVectorSourceCenterLat = DataArray1D<double>();
+	m_dVectorSourceBoundsLon = DataArray2D<double>();
+	m_dVectorSourceBoundsLat = DataArray2D<double>();
+
+	m_dVectorTargetCenterLon = DataArray1D<double>();
+	m_dVectorTargetCenterLat = DataArray1D<double>();
+	m_dVectorTargetBoundsLon = DataArray2D<double>();
+	m_dVectorTargetBoundsLat = DataArray2D<double>();
+
+	m_vecSourceDimSizes.resize(1);
+	m_vecSourceDimSizes[0] = static_cast<int>(vecSourceIx.size());
+	m_vecSourceDimNames.resize(1);
+	m_vecSourceDimNames[0] = "num_dof";
+
+	m_vecTargetDimSizes.resize(1);
+	m_vecTargetDimSizes[0] = static_cast<int>(vecTargetIx.size());
+	m_vecTargetDimNames.resize(1);
+	m_vecTargetDimNames[0] = "num_dof";
+
+	if (pvecSourceIx != NULL) {
+		pvecSourceIx->swap(vecSourceIx);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OfflineMap::CalculateRowSums(
+	const SparseMatrix<double> & smatRemap,
+	DataArray1D<double> & dRowSums
+) const {
+	const DataArray1D<size_t> & dataRowPtr = smatRemap.GetCSRRowPointers();
+	const DataArray1D<double> & dataValues = smatRemap.GetCSRValues();
+
+	const int nRows = smatRemap.GetRows();
+
+	dRowSums.Allocate(std::max(nRows, (int)m_dTargetAreas.GetRows()));
+
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < nRows; i++) {
+		double dSum = 0.0;
+		double dCompensation = 0.0;
+		for (size_t j = dataRowPtr[i]; j < dataRowPtr[i+1]; j++) {
+			CompensatedAdd(dSum, dCompensation, dataValues[j]);
+		}
+		dRowSums[i] = dSum + dCompensation;
 	}
+}
 
-	bool fDeleteRowSums = false;
-	if (pdRowSums == NULL) {
-		pdRowSums = new DataArray1D<double>(m_mapRemap.GetRows());
-		fDeleteRowSums = true;
+///////////////////////////////////////////////////////////////////////////////
+
+void OfflineMap::CalculateColumnSums(
+	const SparseMatrix<double> & smatRemapTranspose,
+	DataArray1D<double> & dColSums
+) const {
+	const DataArray1D<size_t> & dataRowPtr =
+		smatRemapTranspose.GetCSRRowPointers();
+	const DataArray1D<int> & dataCols = smatRemapTranspose.GetCSRColumns();
+	const DataArray1D<double> & dataValues = smatRemapTranspose.GetCSRValues();
+
+	const int nCols = smatRemapTranspose.GetRows();
+
+	if (m_dSourceAreas.GetRows() < nCols) {
+		_EXCEPTIONT("Assertion failure: m_dSourceAreas.GetRows() < m_mapRemap.GetColumns()");
+	}
+	if (m_dTargetAreas.GetRows() < smatRemapTranspose.GetColumns()) {
+		_EXCEPTIONT("Assertion failure: m_dTargetAreas.GetRows() < m_mapRemap.GetRows()");
 	}
-	DataArray1D<double> & dRowSums = (*pdRowSums);
 
-	for (int i = 0; i < dataRows.GetRows(); i++) {
-		dRowSums[dataRows[i]] += dataEntries[i];
+	dColSums.Allocate(m_dSourceAreas.GetRows());
+
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < nCols; i++) {
+		double dSum = 0.0;
+		double dCompensation = 0.0;
+		for (size_t j = dataRowPtr[i]; j < dataRowPtr[i+1]; j++) {
+			CompensatedAdd(dSum, dCompensation,
+				dataValues[j] * m_dTargetAreas[dataCols[j]]);
+		}
+		dColSums[i] = (dSum + dCompensation) / m_dSourceAreas[i];
 	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+int OfflineMap::IsConsistent(
+	double dTolerance,
+	const DataArray1D<double> & dRowSums
+) {
+	int nCount = 0;
 
 	// Verify all row sums are equal to 1
+#pragma omp parallel for schedule(static) reduction(+:nCount)
 	for (int i = 0; i < dRowSums.GetRows(); i++) {
 		if (fabs(dRowSums[i] - 1.0) > dTolerance) {
 			nCount++;
-			if (nCount <= OfflineMapWarningMessageCount) {
-				Announce("OfflineMap is not consistent (row %i) [%1.15e != 1.0]",
-					i+1, dRowSums[i]);
-			}
+		}
+	}
+
+	int nReported = 0;
+	for (int i = 0; i < dRowSums.GetRows(); i++) {
+		if (nReported >= std::min(nCount, OfflineMapWarningMessageCount)) {
+			break;
+		}
+		if (fabs(dRowSums[i] - 1.0) > dTolerance) {
+			nReported++;
+			Announce("OfflineMap is not consistent (row %i) [%1.15e != 1.0]",
+				i+1, dRowSums[i]);
 		}
 	}
 	if (nCount > OfflineMapWarningMessageCount) {
@@ -2616,10 +6016,6 @@ int OfflineMap::IsConsistent(
 		}
 	}
 
-	if (fDeleteRowSums) {
-		delete pdRowSums;
-	}
-
 	return nCount;
 }
 
@@ -2627,45 +6023,27 @@ int OfflineMap::IsConsistent(
 
 int OfflineMap::IsConservative(
 	double dTolerance,
-	const DataArray1D<int> & dataRows,
-	const DataArray1D<int> & dataCols,
-	const DataArray1D<double> & dataEntries,
-	DataArray1D<double> * pdColumnSums
-
+	const DataArray1D<double> & dColSums
 ) {
 	int nCount = 0;
 
-	// Calculate column sums
-	if (m_mapRemap.GetColumns() < 1) {
-		_EXCEPTIONT("IsConservative() called on map with no columns");
-	}
-
-	bool fDeleteColumnSums = false;
-	if (pdColumnSums == NULL) {
-		pdColumnSums = new DataArray1D<double>(m_dSourceAreas.GetRows());
-		fDeleteColumnSums = true;
-	}
-	DataArray1D<double> & dColumnSums = (*pdColumnSums);
-
-	if (dColumnSums.GetRows() != m_dSourceAreas.GetRows()) {
-		_EXCEPTION2("Assertion failure: dColumnSums.GetRows() (%i) != m_dSourceAreas.GetRows() (%i)", dColumnSums.GetRows(), m_dSourceAreas.GetRows());
-	}
-	for (int i = 0; i < dataRows.GetRows(); i++) {
-		dColumnSums[dataCols[i]] +=
-			dataEntries[i] * m_dTargetAreas[dataRows[i]];
-	}
-	for (int i = 0; i < m_dSourceAreas.GetRows(); i++) {
-		dColumnSums[i] /= m_dSourceAreas[i];
-	}
-
 	// Verify all column sums equal the input Jacobian
-	for (int i = 0; i < dColumnSums.GetRows(); i++) {
-		if (fabs(dColumnSums[i] - 1.0) > dTolerance) {
+#pragma omp parallel for schedule(static) reduction(+:nCount)
+	for (int i = 0; i < dColSums.GetRows(); i++) {
+		if (fabs(dColSums[i] - 1.0) > dTolerance) {
 			nCount++;
-			if (nCount <= OfflineMapWarningMessageCount) {
-				Announce("OfflineMap is not conservative (col %i) [%1.15e != 1.0]",
-					i+1, dColumnSums[i]);
-			}
+		}
+	}
+
+	int nReported = 0;
+	for (int i = 0; i < dColSums.GetRows(); i++) {
+		if (nReported >= std::min(nCount, OfflineMapWarningMessageCount)) {
+			break;
+		}
+		if (fabs(dColSums[i] - 1.0) > dTolerance) {
+			nReported++;
+			Announce("OfflineMap is not conservative (col %i) [%1.15e != 1.0]",
+				i+1, dColSums[i]);
 		}
 	}
 	if (nCount > OfflineMapWarningMessageCount) {
@@ -2678,10 +6056,6 @@ int OfflineMap::IsConservative(
 		}
 	}
 
-	if (fDeleteColumnSums) {
-		delete pdColumnSums;
-	}
-
 	return nCount;
 }
 
@@ -2689,25 +6063,50 @@ int OfflineMap::IsConservative(
 
 int OfflineMap::IsMonotone(
 	double dTolerance,
-	const DataArray1D<int> & dataRows,
-	const DataArray1D<int> & dataCols,
-	const DataArray1D<double> & dataEntries
+	const SparseMatrix<double> & smatRemap
 ) {
+	const DataArray1D<size_t> & dataRowPtr = smatRemap.GetCSRRowPointers();
+	const DataArray1D<int> & dataCols = smatRemap.GetCSRColumns();
+	const DataArray1D<double> & dataValues = smatRemap.GetCSRValues();
+
+	const int nRows = smatRemap.GetRows();
+
 	int nCount = 0;
+	int nNaNCount = 0;
 
 	// Verify all entries are in the range [0,1]
-	for (int i = 0; i < dataRows.GetRows(); i++) {
-		if (std::isnan(dataEntries[i])) {
-			Announce("OfflineMap has NaN (s%i -> t%i)",
-				dataCols[i]+1, dataRows[i]+1);
+#pragma omp parallel for schedule(static) reduction(+:nCount,nNaNCount)
+	for (int i = 0; i < nRows; i++) {
+		for (size_t j = dataRowPtr[i]; j < dataRowPtr[i+1]; j++) {
+			if (std::isnan(dataValues[j])) {
+				nNaNCount++;
+			}
+			if ((dataValues[j] < -dTolerance) ||
+				(dataValues[j] > 1.0 + dTolerance)
+			) {
+				nCount++;
+			}
 		}
-		if ((dataEntries[i] < -dTolerance) ||
-			(dataEntries[i] > 1.0 + dTolerance)
-		) {
-			nCount++;
-			if (nCount <= OfflineMapWarningMessageCount) {
-				Announce("OfflineMap is not monotone (s%i -> t%i) %1.15e",
-					dataCols[i]+1, dataRows[i]+1, dataEntries[i]);
+	}
+
+	// Report in the order of entries
+	if ((nCount > 0) || (nNaNCount > 0)) {
+		int nReported = 0;
+		for (int i = 0; i < nRows; i++) {
+			for (size_t j = dataRowPtr[i]; j < dataRowPtr[i+1]; j++) {
+				if (std::isnan(dataValues[j])) {
+					Announce("OfflineMap has NaN (s%i -> t%i)",
+						dataCols[j]+1, i+1);
+				}
+				if ((dataValues[j] < -dTolerance) ||
+					(dataValues[j] > 1.0 + dTolerance)
+				) {
+					nReported++;
+					if (nReported <= OfflineMapWarningMessageCount) {
+						Announce("OfflineMap is not monotone (s%i -> t%i) %1.15e",
+							dataCols[j]+1, i+1, dataValues[j]);
+					}
+				}
 			}
 		}
 	}
@@ -2729,15 +6128,17 @@ int OfflineMap::IsMonotone(
 int OfflineMap::IsConsistent(
 	double dTolerance
 ) {
+	if (m_mapRemap.GetRows() < 1) {
+		_EXCEPTIONT("IsConsistent() called on map with no rows");
+	}
 
-	// Get map entries
-	DataArray1D<int> dataRows;
-	DataArray1D<int> dataCols;
-	DataArray1D<double> dataEntries;
+	SparseMatrix<double> smatTemp;
+	const SparseMatrix<double> & smatRemap = GetFinalizedMap(smatTemp);
 
-	m_mapRemap.GetEntries(dataRows, dataCols, dataEntries);
+	DataArray1D<double> dRowSums;
+	CalculateRowSums(smatRemap, dRowSums);
 
-	return IsConsistent(dTolerance, dataRows, dataCols, dataEntries);
+	return IsConsistent(dTolerance, dRowSums);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -2745,14 +6146,18 @@ int OfflineMap::IsConsistent(
 int OfflineMap::IsConservative(
 	double dTolerance
 ) {
-	// Get map entries
-	DataArray1D<int> dataRows;
-	DataArray1D<int> dataCols;
-	DataArray1D<double> dataEntries;
+	if (m_mapRemap.GetColumns() < 1) {
+		_EXCEPTIONT("IsConservative() called on map with no columns");
+	}
 
-	m_mapRemap.GetEntries(dataRows, dataCols, dataEntries);
+	SparseMatrix<double> smatTemp;
+	SparseMatrix<double> smatTranspose;
+	GetFinalizedMap(smatTemp).Transpose(smatTranspose);
 
-	return IsConservative(dTolerance, dataRows, dataCols, dataEntries);
+	DataArray1D<double> dColSums;
+	CalculateColumnSums(smatTranspose, dColSums);
+
+	return IsConservative(dTolerance, dColSums);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -2760,15 +6165,198 @@ int OfflineMap::IsConservative(
 int OfflineMap::IsMonotone(
 	double dTolerance
 ) {
+	SparseMatrix<double> smatTemp;
+	return IsMonotone(dTolerance, GetFinalizedMap(smatTemp));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+double OfflineMap::EnforceMonotonicity(
+	const SparseMatrix<double> & smatLowOrder,
+	double dTolerance
+) {
+	// Finalize both maps
+	m_mapRemap.Finalize();
+
+	SparseMatrix<double> smatTemp;
+	const SparseMatrix<double> * pLowOrder = &smatLowOrder;
+	if (!smatLowOrder.IsFinalized()) {
+		smatTemp = smatLowOrder;
+		smatTemp.Finalize();
+		pLowOrder = &smatTemp;
+	}
+
+	const DataArray1D<size_t> & dataRowPtrH = m_mapRemap.GetCSRRowPointers();
+	const DataArray1D<int> & dataColsH = m_mapRemap.GetCSRColumns();
+	const DataArray1D<double> & dataValuesH = m_mapRemap.GetCSRValues();
+
+	const DataArray1D<size_t> & dataRowPtrL = pLowOrder->GetCSRRowPointers();
+	const DataArray1D<int> & dataColsL = pLowOrder->GetCSRColumns();
+	const DataArray1D<double> & dataValuesL = pLowOrder->GetCSRValues();
+
+	const int nRowsH = m_mapRemap.GetRows();
+	const int nRowsL = pLowOrder->GetRows();
+	const int nRows = std::max(nRowsH, nRowsL);
+
+	// Blend factor required by each row, so that every entry of
+	// (1 - alpha) H + alpha L lies in [0,1]
+	DataArray1D<double> dRowAlpha(nRows);
+
+	int nLowOrderFail = 0;
+
+#pragma omp parallel for schedule(dynamic, 256) reduction(+:nLowOrderFail)
+	for (int i = 0; i < nRows; i++) {
+		size_t jH = (i < nRowsH)?(dataRowPtrH[i]):(0);
+		size_t jL = (i < nRowsL)?(dataRowPtrL[i]):(0);
+		const size_t jHEnd = (i < nRowsH)?(dataRowPtrH[i+1]):(0);
+		const size_t jLEnd = (i < nRowsL)?(dataRowPtrL[i+1]):(0);
+
+		double dAlpha = 0.0;
+
+		while ((jH < jHEnd) || (jL < jLEnd)) {
+			double dH = 0.0;
+			double dL = 0.0;
+			if ((jL == jLEnd) ||
+			    ((jH < jHEnd) && (dataColsH[jH] < dataColsL[jL]))
+			) {
+				dH = dataValuesH[jH];
+				jH++;
+
+			} else if ((jH == jHEnd) || (dataColsL[jL] < dataColsH[jH])) {
+				dL = dataValuesL[jL];
+				jL++;
+
+			} else {
+				dH = dataValuesH[jH];
+				dL = dataValuesL[jL];
+				jH++;
+				jL++;
+			}
+
+			if ((dL < -dTolerance) || (dL > 1.0 + dTolerance)) {
+				nLowOrderFail++;
+				continue;
+			}
+
+			double dNewAlpha = 0.0;
+			if (dH < -dTolerance) {
+				dNewAlpha = - dH / (dL - dH);
+			} else if (dH > 1.0 + dTolerance) {
+				dNewAlpha = (dH - 1.0) / (dH - dL);
+			}
+			if (dNewAlpha > dAlpha) {
+				dAlpha = dNewAlpha;
+			}
+		}
+
+		dRowAlpha[i] = dAlpha;
+	}
+
+	if (nLowOrderFail != 0) {
+		_EXCEPTION1("Low-order map is not monotone in %i entries",
+			nLowOrderFail);
+	}
+
+	// A single blend factor is used for the whole map, since blending rows
+	// with different factors would not preserve conservation
+	double dAlpha = 0.0;
+	int nLimitedRows = 0;
+	for (int i = 0; i < nRows; i++) {
+		if (dRowAlpha[i] > 0.0) {
+			nLimitedRows++;
+		}
+		if (dRowAlpha[i] > dAlpha) {
+			dAlpha = dRowAlpha[i];
+		}
+	}
+
+	Announce("Monotonicity required in %i rows (blend factor %1.15e)",
+		nLimitedRows, dAlpha);
+
+	if (dAlpha == 0.0) {
+		return dAlpha;
+	}
+
+	// Number of entries of the blended map in each row
+	std::vector<size_t> vecRowBegin(static_cast<size_t>(nRows) + 1, 0);
 
-	// Get map entries
-	DataArray1D<int> dataRows;
-	DataArray1D<int> dataCols;
-	DataArray1D<double> dataEntries;
+#pragma omp parallel for schedule(dynamic, 256)
+	for (int i = 0; i < nRows; i++) {
+		size_t jH = (i < nRowsH)?(dataRowPtrH[i]):(0);
+		size_t jL = (i < nRowsL)?(dataRowPtrL[i]):(0);
+		const size_t jHEnd = (i < nRowsH)?(dataRowPtrH[i+1]):(0);
+		const size_t jLEnd = (i < nRowsL)?(dataRowPtrL[i+1]):(0);
 
-	m_mapRemap.GetEntries(dataRows, dataCols, dataEntries);
+		size_t sCount = 0;
+		while ((jH < jHEnd) || (jL < jLEnd)) {
+			if ((jL == jLEnd) ||
+			    ((jH < jHEnd) && (dataColsH[jH] < dataColsL[jL]))
+			) {
+				jH++;
+			} else if ((jH == jHEnd) || (dataColsL[jL] < dataColsH[jH])) {
+				jL++;
+			} else {
+				jH++;
+				jL++;
+			}
+			sCount++;
+		}
+		vecRowBegin[i+1] = sCount;
+	}
+
+	for (int i = 0; i < nRows; i++) {
+		vecRowBegin[i+1] += vecRowBegin[i];
+	}
+
+	// Blend the maps
+	const size_t sNonZeros = vecRowBegin[nRows];
+
+	DataArray1D<int> vecRow(sNonZeros);
+	DataArray1D<int> vecCol(sNonZeros);
+	DataArray1D<double> vecS(sNonZeros);
+
+#pragma omp parallel for schedule(dynamic, 256)
+	for (int i = 0; i < nRows; i++) {
+		size_t jH = (i < nRowsH)?(dataRowPtrH[i]):(0);
+		size_t jL = (i < nRowsL)?(dataRowPtrL[i]):(0);
+		const size_t jHEnd = (i < nRowsH)?(dataRowPtrH[i+1]):(0);
+		const size_t jLEnd = (i < nRowsL)?(dataRowPtrL[i+1]):(0);
+
+		size_t ix = vecRowBegin[i];
+		while ((jH < jHEnd) || (jL < jLEnd)) {
+			int iCol;
+			double dH = 0.0;
+			double dL = 0.0;
+			if ((jL == jLEnd) ||
+			    ((jH < jHEnd) && (dataColsH[jH] < dataColsL[jL]))
+			) {
+				iCol = dataColsH[jH];
+				dH = dataValuesH[jH];
+				jH++;
+
+			} else if ((jH == jHEnd) || (dataColsL[jL] < dataColsH[jH])) {
+				iCol = dataColsL[jL];
+				dL = dataValuesL[jL];
+				jL++;
+
+			} else {
+				iCol = dataColsH[jH];
+				dH = dataValuesH[jH];
+				dL = dataValuesL[jL];
+				jH++;
+				jL++;
+			}
 
-	return IsMonotone(dTolerance, dataRows, dataCols, dataEntries);
+			vecRow[ix] = i;
+			vecCol[ix] = iCol;
+			vecS[ix] = (1.0 - dAlpha) * dH + dAlpha * dL;
+			ix++;
+		}
+	}
+
+	m_mapRemap.SetFinalizedEntries(vecRow, vecCol, vecS);
+
+	return dAlpha;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -2781,15 +6369,20 @@ bool OfflineMap::CheckMap(
 	double dStrictTolerance,
 	double dTotalOverlapArea
 ) {
-	// Get map entries
-	DataArray1D<int> dataRows;
-	DataArray1D<int> dataCols;
-	DataArray1D<double> dataEntries;
+	// Row and column sums are computed from the CSR form of the map and
+	// its transpose, each in a single parallel pass
+	SparseMatrix<double> smatTemp;
+	const SparseMatrix<double> & smatRemap = GetFinalizedMap(smatTemp);
 
-	m_mapRemap.GetEntries(dataRows, dataCols, dataEntries);
+	const DataArray1D<size_t> & dataRowPtr = smatRemap.GetCSRRowPointers();
+	const DataArray1D<int> & dataCols = smatRemap.GetCSRColumns();
+	const DataArray1D<double> & dataEntries = smatRemap.GetCSRValues();
+
+	const size_t sNonZeros = smatRemap.GetNonZeroCount();
+	const int nRows = smatRemap.GetRows();
 
 	// Verify at least one entry
-	if (dataEntries.GetRows() == 0) {
+	if (sNonZeros == 0) {
 		Announce("No entries found in map; aborting");
 		return true;
 	}
@@ -2806,8 +6399,14 @@ bool OfflineMap::CheckMap(
 		_EXCEPTIONT("Assertion failure: m_dTargetAreas.GetRows() < m_mapRemap.GetRows()");
 	}
 
-	DataArray1D<double> dRowSums(m_dTargetAreas.GetRows());
-	DataArray1D<double> dColSums(m_dSourceAreas.GetRows());
+	SparseMatrix<double> smatTranspose;
+	smatRemap.Transpose(smatTranspose);
+
+	DataArray1D<double> dRowSums;
+	DataArray1D<double> dColSums;
+
+	CalculateRowSums(smatRemap, dRowSums);
+	CalculateColumnSums(smatTranspose, dColSums);
 
 	// Announce
 	AnnounceBanner();
@@ -2817,46 +6416,31 @@ bool OfflineMap::CheckMap(
 	int nConsistentFail = 0;
 	if (fCheckConsistency) {
 		AnnounceStartBlock("Per-dof consistency  (tol %1.5e)", dNormalTolerance);
-		nConsistentFail =
-			IsConsistent(dNormalTolerance, dataRows, dataCols, dataEntries, &dRowSums);
+		nConsistentFail = IsConsistent(dNormalTolerance, dRowSums);
 		if (nConsistentFail == 0) {
 			AnnounceEndBlock("PASS");
 		} else {
 			AnnounceEndBlock(NULL);
 		}
-	} else {
-		for (int i = 0; i < dataRows.GetRows(); i++) {
-			dRowSums[dataRows[i]] += dataEntries[i];
-		}
 	}
 
 	// Check conservation
 	int nConservativeFail = 0;
 	if (fCheckConservation) {
 		AnnounceStartBlock("Per-dof conservation (tol %1.5e)", dNormalTolerance);
-		nConservativeFail =
-			IsConservative(dNormalTolerance, dataRows, dataCols, dataEntries, &dColSums);
+		nConservativeFail = IsConservative(dNormalTolerance, dColSums);
 		if (nConservativeFail == 0) {
 			AnnounceEndBlock("PASS");
 		} else {
 			AnnounceEndBlock(NULL);
 		}
-	} else {
-		if (m_dSourceAreas.GetRows() != dColSums.GetRows()) {
-			_EXCEPTIONT("Assertion failure: m_dSourceAreas.GetRows() != dColSums.GetRows()");
-		}
-		for (int i = 0; i < dataRows.GetRows(); i++) {
-			dColSums[dataCols[i]] +=
-				dataEntries[i] * m_dTargetAreas[dataRows[i]];
-		}
 	}
 
 	// Check monotonicity
 	int nMonotoneFail = 0;
 	if (fCheckMonotonicity) {
 		AnnounceStartBlock("Per-dof monotonicity (tol %1.5e)", dStrictTolerance);
-		nMonotoneFail =
-			IsMonotone(dStrictTolerance, dataRows, dataCols, dataEntries);
+		nMonotoneFail = IsMonotone(dStrictTolerance, smatRemap);
 		if (nMonotoneFail == 0) {
 			AnnounceEndBlock("PASS");
 		} else {
@@ -2866,14 +6450,16 @@ bool OfflineMap::CheckMap(
 	// Check nominal range of entries
 	} else {
 		AnnounceStartBlock("Weights within range [-10,+10]");
-		for (int i = 0; i < dataRows.GetRows(); i++) {
-			if (std::isnan(dataEntries[i])) {
-				Announce("OfflineMap has NaN (s%i -> t%i)",
-					dataCols[i]+1, dataRows[i]+1);
-
-			} else if ((dataEntries[i] < -10.0) || (dataEntries[i] > 10.0)) {
-				Announce("OfflineMap has unusually large weight (s%i -> t%i) %1.15e",
-					dataCols[i]+1, dataRows[i]+1, dataEntries[i]);
+		for (int i = 0; i < nRows; i++) {
+			for (size_t j = dataRowPtr[i]; j < dataRowPtr[i+1]; j++) {
+				if (std::isnan(dataEntries[j])) {
+					Announce("OfflineMap has NaN (s%i -> t%i)",
+						dataCols[j]+1, i+1);
+
+				} else if ((dataEntries[j] < -10.0) || (dataEntries[j] > 10.0)) {
+					Announce("OfflineMap has unusually large weight (s%i -> t%i) %1.15e",
+						dataCols[j]+1, i+1, dataEntries[j]);
+				}
 			}
 		}
 		AnnounceEndBlock("Done");
@@ -2884,71 +6470,92 @@ bool OfflineMap::CheckMap(
 		DataArray1D<int> nHistogramWeights(7);
 		DataArray1D<int> nHistogramRows(32);
 		DataArray1D<int> nHistogramCols(32);
-		DataArray1D<int> nNonzeroRowCount(m_mapRemap.GetRows());
-		DataArray1D<int> nNonzeroColCount(m_mapRemap.GetColumns());
 
-		int iMinCol = dataCols[0];
-		int iMaxCol = dataCols[0];
+		const DataArray1D<size_t> & dataColPtr =
+			smatTranspose.GetCSRRowPointers();
+
+		int iMinRow = 0;
+		while (dataRowPtr[iMinRow+1] == 0) {
+			iMinRow++;
+		}
+		int iMaxRow = nRows-1;
+		while (dataRowPtr[iMaxRow] == sNonZeros) {
+			iMaxRow--;
+		}
 
-		int iMinRow = dataRows[0];
-		int iMaxRow = dataRows[0];
+		int iMinCol = 0;
+		while (dataColPtr[iMinCol+1] == 0) {
+			iMinCol++;
+		}
+		int iMaxCol = smatTranspose.GetRows()-1;
+		while (dataColPtr[iMaxCol] == sNonZeros) {
+			iMaxCol--;
+		}
 
 		double dMinWeight = dataEntries[0];
 		double dMaxWeight = dataEntries[0];
 
-		for (int i = 0; i < dataRows.GetRows(); i++) {
-			if (dataCols[i] > iMaxCol) {
-				iMaxCol = dataCols[i];
-			}
-			if (dataCols[i] < iMinCol) {
-				iMinCol = dataCols[i];
-			}
-			if (dataRows[i] > iMaxRow) {
-				iMaxRow = dataRows[i];
-			}
-			if (dataRows[i] < iMinRow) {
-				iMinRow = dataRows[i];
-			}
-			if (!std::isnan(dataEntries[i])) {
-				if (dataEntries[i] < dMinWeight) {
-					dMinWeight = dataEntries[i];
+#pragma omp parallel
+		{
+			int nLocalHistogramWeights[7] = {0, 0, 0, 0, 0, 0, 0};
+			double dLocalMinWeight = dataEntries[0];
+			double dLocalMaxWeight = dataEntries[0];
+
+#pragma omp for schedule(static)
+			for (size_t i = 0; i < sNonZeros; i++) {
+				if (!std::isnan(dataEntries[i])) {
+					if (dataEntries[i] < dLocalMinWeight) {
+						dLocalMinWeight = dataEntries[i];
+					}
+					if (dataEntries[i] > dLocalMaxWeight) {
+						dLocalMaxWeight = dataEntries[i];
+					}
 				}
-				if (dataEntries[i] > dMaxWeight) {
-					dMaxWeight = dataEntries[i];
+
+				if (dataEntries[i] < -10.0) {
+					nLocalHistogramWeights[0]++;
+				} else if (dataEntries[i] < -1.0) {
+					nLocalHistogramWeights[1]++;
+				} else if (dataEntries[i] < - dStrictTolerance) {
+					nLocalHistogramWeights[2]++;
+				} else if (dataEntries[i] <= 1.0 + dStrictTolerance) {
+					nLocalHistogramWeights[3]++;
+				} else if (dataEntries[i] < 2.0) {
+					nLocalHistogramWeights[4]++;
+				} else if (dataEntries[i] < 10.0) {
+					nLocalHistogramWeights[5]++;
+				} else {
+					nLocalHistogramWeights[6]++;
 				}
 			}
 
-			nNonzeroRowCount[dataRows[i]]++;
-			nNonzeroColCount[dataCols[i]]++;
-
-			if (dataEntries[i] < -10.0) {
-				nHistogramWeights[0]++;
-			} else if (dataEntries[i] < -1.0) {
-				nHistogramWeights[1]++;
-			} else if (dataEntries[i] < - dStrictTolerance) {
-				nHistogramWeights[2]++;
-			} else if (dataEntries[i] <= 1.0 + dStrictTolerance) {
-				nHistogramWeights[3]++;
-			} else if (dataEntries[i] < 2.0) {
-				nHistogramWeights[4]++;
-			} else if (dataEntries[i] < 10.0) {
-				nHistogramWeights[5]++;
-			} else {
-				nHistogramWeights[6]++;
+#pragma omp critical
+			{
+				for (int k = 0; k < 7; k++) {
+					nHistogramWeights[k] += nLocalHistogramWeights[k];
+				}
+				if (dLocalMinWeight < dMinWeight) {
+					dMinWeight = dLocalMinWeight;
+				}
+				if (dLocalMaxWeight > dMaxWeight) {
+					dMaxWeight = dLocalMaxWeight;
+				}
 			}
 		}
 
-		for (int i = 0; i < nNonzeroRowCount.GetRows(); i++) {
-			if (nNonzeroRowCount[i] < 31) {
-				nHistogramRows[ nNonzeroRowCount[i] ]++;
+		for (int i = 0; i < nRows; i++) {
+			const size_t sRowNonZeros = dataRowPtr[i+1] - dataRowPtr[i];
+			if (sRowNonZeros < 31) {
+				nHistogramRows[ sRowNonZeros ]++;
 			} else {
 				nHistogramRows[31]++;
 			}
 		}
 
-		for (int i = 0; i < nNonzeroColCount.GetRows(); i++) {
-			if (nNonzeroColCount[i] < 31) {
-				nHistogramCols[ nNonzeroColCount[i] ]++;
+		for (int i = 0; i < smatTranspose.GetRows(); i++) {
+			const size_t sColNonZeros = dataColPtr[i+1] - dataColPtr[i];
+			if (sColNonZeros < 31) {
+				nHistogramCols[ sColNonZeros ]++;
 			} else {
 				nHistogramCols[31]++;
 			}
@@ -2980,40 +6587,27 @@ bool OfflineMap::CheckMap(
 			}
 		}
 
+		// Source and target fractions are the column and row sums
 		double dSourceMinFrac = DBL_MAX;
 		double dSourceMaxFrac = -DBL_MAX;
-		double dTargetMinFrac = DBL_MAX;
-		double dTargetMaxFrac = -DBL_MAX;
-		{
-			DataArray1D<double> dSourceFrac(m_dSourceAreas.GetRows());
-			DataArray1D<double> dTargetFrac(m_dTargetAreas.GetRows());
-
-			for (int i = 0; i < dataEntries.GetRows(); i++) {
-				dSourceFrac[dataCols[i]] +=
-					dataEntries[i]
-					/ m_dSourceAreas[dataCols[i]]
-					* m_dTargetAreas[dataRows[i]];
-				dTargetFrac[dataRows[i]] += dataEntries[i];
+		for (int i = 0; i < dColSums.GetRows(); i++) {
+			if (dColSums[i] < dSourceMinFrac) {
+				dSourceMinFrac = dColSums[i];
 			}
-
-			for (int i = 0; i < m_dSourceAreas.GetRows(); i++) {
-				if (dSourceFrac[i] < dSourceMinFrac) {
-					dSourceMinFrac = dSourceFrac[i];
-				}
-				if (dSourceFrac[i] > dSourceMaxFrac) {
-					dSourceMaxFrac = dSourceFrac[i];
-				}
+			if (dColSums[i] > dSourceMaxFrac) {
+				dSourceMaxFrac = dColSums[i];
 			}
+		}
 
-			for (int i = 0; i < m_dTargetAreas.GetRows(); i++) {
-				if (dTargetFrac[i] < dTargetMinFrac) {
-					dTargetMinFrac = dTargetFrac[i];
-				}
-				if (dTargetFrac[i] > dTargetMaxFrac) {
-					dTargetMaxFrac = dTargetFrac[i];
-				}
+		double dTargetMinFrac = DBL_MAX;
+		double dTargetMaxFrac = -DBL_MAX;
+		for (int i = 0; i < m_dTargetAreas.GetRows(); i++) {
+			if (dRowSums[i] < dTargetMinFrac) {
+				dTargetMinFrac = dRowSums[i];
+			}
+			if (dRowSums[i] > dTargetMaxFrac) {
+				dTargetMaxFrac = dRowSums[i];
 			}
-
 		}
 
 		int iSourceMinMask = INT_MAX;
@@ -3061,7 +6655,7 @@ bool OfflineMap::CheckMap(
 		}
 
 		Announce("");
-		Announce("  Total nonzero entries: %i", dataEntries.GetRows());
+		Announce("  Total nonzero entries: %lu", sNonZeros);
 		Announce("   Column index min/max: %i / %i (%i source dofs)",
 			iMinCol+1, iMaxCol+1, m_mapRemap.GetColumns());
 		Announce("      Row index min/max: %i / %i (%i target dofs)",
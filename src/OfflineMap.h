@@ -18,11 +18,13 @@
 #define _OFFLINEMAP_H_
 
 #include "SparseMatrix.h"
+#include "MemoryMappedFile.h"
 #include "DataArray1D.h"
 #include "DataArray2D.h"
 #include "DataArray3D.h"
 #include "netcdfcpp.h"
 #include <string>
+#include <memory>
 #include <vector>
 #include <cfloat>
 
@@ -57,6 +59,29 @@ public:
 
 typedef std::vector<EnforceBounds> EnforceBoundsVector;
 
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Storage of the weights of a native binary map file.  Maps with
+///		double precision weights are memory mapped and used in place.  The
+///		compact formats delta encode the columns of each row, store the
+///		weights in reduced precision and are decoded on load, with each
+///		row rescaled to its original row sum.
+///	</summary>
+enum BinaryMapWeights {
+	BinaryMapWeights_Double,
+	BinaryMapWeights_Single,
+	BinaryMapWeights_Quantized16
+};
+
+///	<summary>
+///		Parse a string that names a BinaryMapWeights format ("double",
+///		"single" or "q16").
+///	</summary>
+BinaryMapWeights ParseBinaryMapWeights(
+	const std::string & strBinaryMapWeights
+);
+
 ///	<summary>
 ///		Parse a string that encodes information on bounds preservation.
 ///	</summary>
@@ -78,7 +103,16 @@ public:
 	///	</summary>
 	OfflineMap() :
 		m_flFillValueOverride(FLT_MAX),
-		m_dFillValueOverride(DBL_MAX)
+		m_dFillValueOverride(DBL_MAX),
+		m_fDistributeSlices(false),
+		m_fParallelVariables(false),
+		m_fRenormalizeFillValues(false),
+		m_fReorderForApply(false),
+		m_pmeshSourceCoordinates(NULL),
+		m_pmeshTargetCoordinates(NULL),
+		m_fWriteVertexArrays(true),
+		m_fReadSourceCenters(true),
+		m_fReadVertexArrays(true)
 	{ }
 
 	///	<summary>
@@ -87,6 +121,28 @@ public:
 	virtual ~OfflineMap()
 	{ }
 
+	///	<summary>
+	///		Copy constructor.  Weights attached to a memory mapped file are
+	///		copied into memory owned by the new map.
+	///	</summary>
+	OfflineMap(const OfflineMap &) = default;
+
+	///	<summary>
+	///		Move constructor.  Prefer moving maps to copying them, since
+	///		moving does not copy the weights.
+	///	</summary>
+	OfflineMap(OfflineMap &&) = default;
+
+	///	<summary>
+	///		Copy assignment operator.
+	///	</summary>
+	OfflineMap & operator=(const OfflineMap &) = default;
+
+	///	<summary>
+	///		Move assignment operator.
+	///	</summary>
+	OfflineMap & operator=(OfflineMap &&) = default;
+
 public:
 	///	<summary>
 	///		Initialize the array of dimensions from a file.
@@ -175,9 +231,27 @@ protected:
 		DataArray2D<double> & dVectorBoundsLat
 	);
 
+	///	<summary>
+	///		Compute the coordinate arrays for a finite-volume mesh in chunks
+	///		of Faces and write them directly to the given variables.  The
+	///		vertex variables may be NULL.
+	///	</summary>
+	void WriteCoordinatesFromMeshFV(
+		const Mesh & mesh,
+		int nNodesPerFace,
+		NcVar * varCenterLon,
+		NcVar * varCenterLat,
+		NcVar * varVertexLon,
+		NcVar * varVertexLat
+	);
+
 public:
 	///	<summary>
 	///		Initialize the source coordinate arrays for a finite-volume mesh.
+	///		Unless the mesh is rectilinear the arrays are not computed here;
+	///		the map keeps a reference to the mesh and computes them on demand
+	///		(see ResolveCoordinates), so the mesh must outlive the map or
+	///		ResolveCoordinates must be called before it is destroyed.
 	///	</summary>
 	void InitializeSourceCoordinatesFromMeshFV(
 		const Mesh & meshSource
@@ -185,11 +259,30 @@ public:
 
 	///	<summary>
 	///		Initialize the target coordinate arrays for a finite-volume mesh.
+	///		As with InitializeSourceCoordinatesFromMeshFV, the arrays may be
+	///		computed on demand.
 	///	</summary>
 	void InitializeTargetCoordinatesFromMeshFV(
 		const Mesh & meshTarget
 	);
 
+	///	<summary>
+	///		Compute any coordinate arrays deferred by
+	///		InitializeSourceCoordinatesFromMeshFV or
+	///		InitializeTargetCoordinatesFromMeshFV, and release the reference
+	///		to the mesh.  Write() streams deferred coordinates directly from
+	///		the mesh without computing these arrays.
+	///	</summary>
+	void ResolveCoordinates();
+
+	///	<summary>
+	///		Set whether Write() includes the vertex arrays (xv_a, yv_a, xv_b
+	///		and yv_b) in the map file.
+	///	</summary>
+	void SetWriteVertexArrays(bool fWriteVertexArrays) {
+		m_fWriteVertexArrays = fWriteVertexArrays;
+	}
+
 	///	<summary>
 	///		Initialize the source coordinate arrays for a finite-element mesh.
 	///	</summary>
@@ -215,6 +308,7 @@ public:
 	///	</summary>
 	DataArray1D<double>& GetSourceCenterLon()
 	{
+		ResolveCoordinates();
 		return m_dSourceCenterLon;
 	}
 
@@ -231,6 +325,7 @@ public:
 	///	</summary>
 	DataArray1D<double>& GetSourceCenterLat()
 	{
+		ResolveCoordinates();
 		return m_dSourceCenterLat;
 	}
 
@@ -247,6 +342,7 @@ public:
 	///	</summary>
 	DataArray1D<double>& GetTargetCenterLon()
 	{
+		ResolveCoordinates();
 		return m_dTargetCenterLon;
 	}
 
@@ -263,6 +359,7 @@ public:
 	///	</summary>
 	DataArray1D<double>& GetTargetCenterLat()
 	{
+		ResolveCoordinates();
 		return m_dTargetCenterLat;
 	}
 
@@ -279,6 +376,7 @@ public:
 	///	</summary>
 	DataArray2D<double>& GetSourceVertexLon()
 	{
+		ResolveCoordinates();
 		return m_dSourceVertexLon;
 	}
 
@@ -295,6 +393,7 @@ public:
 	///	</summary>
 	DataArray2D<double>& GetTargetVertexLon()
 	{
+		ResolveCoordinates();
 		return m_dTargetVertexLon;
 	}
 
@@ -311,6 +410,7 @@ public:
 	///	</summary>
 	DataArray2D<double>& GetSourceVertexLat()
 	{
+		ResolveCoordinates();
 		return m_dSourceVertexLat;
 	}
 
@@ -327,6 +427,7 @@ public:
 	///	</summary>
 	DataArray2D<double>& GetTargetVertexLat()
 	{
+		ResolveCoordinates();
 		return m_dTargetVertexLat;
 	}
 
@@ -371,7 +472,8 @@ public:
 	);
 
 	///	<summary>
-	///		Read the OfflineMap from a NetCDF file.
+	///		Read the OfflineMap from a NetCDF file, or from a native binary
+	///		file if one is detected.
 	///	</summary>
 	virtual void Read(
 		const std::string & strSource,
@@ -389,33 +491,145 @@ public:
 	);
 
 	///	<summary>
-	///		Initialize a map that is the transverse of the given map.
+	///		Set whether Read() loads the source cell centers (xc_a and yc_a).
+	///		These are not needed to apply the map, but are needed to apply
+	///		its transpose.  Native binary maps are memory mapped and always
+	///		provide all arrays.
+	///	</summary>
+	void SetReadSourceCenters(bool fReadSourceCenters) {
+		m_fReadSourceCenters = fReadSourceCenters;
+	}
+
+	///	<summary>
+	///		Set whether Read() loads the vertex arrays (xv_a, yv_a, xv_b and
+	///		yv_b), which are not needed to apply the map.
+	///	</summary>
+	void SetReadVertexArrays(bool fReadVertexArrays) {
+		m_fReadVertexArrays = fReadVertexArrays;
+	}
+
+	///	<summary>
+	///		Set the target degrees of freedom (0-based) whose rows of the map
+	///		are kept when Read() loads a NetCDF map.  The weights are read in
+	///		chunks of OfflineMapReadChunkEntries and all other rows are
+	///		discarded, so only the selected rows are held in memory.  All
+	///		other arrays are read in full.  An empty list keeps every row.
+	///		Native binary maps are memory mapped and always provide all rows.
+	///	</summary>
+	void SetReadTargetRows(const std::vector<int> & vecReadTargetRows) {
+		m_vecReadTargetRows = vecReadTargetRows;
+	}
+
+	///	<summary>
+	///		Check if the given file is an OfflineMap in native binary format.
+	///	</summary>
+	static bool IsBinaryMapFile(
+		const std::string & strFile
+	);
+
+	///	<summary>
+	///		Read the OfflineMap from a native binary file.  The sparse
+	///		matrix is memory mapped and used in place without being copied,
+	///		unless it was written in a compact format, in which case it is
+	///		decoded into memory.
+	///	</summary>
+	void ReadBinary(
+		const std::string & strSource,
+		std::map<std::string, std::string> * pmapAttributes = NULL
+	);
+
+	///	<summary>
+	///		Write the OfflineMap to a native binary file, with attribute map.
+	///		Compact weight formats record the largest error of the stored
+	///		weights in the "weight_max_error" attribute.
+	///	</summary>
+	void WriteBinary(
+		const std::string & strTarget,
+		const std::map<std::string, std::string> & mapAttributes,
+		BinaryMapWeights eWeights = BinaryMapWeights_Double
+	);
+
+	///	<summary>
+	///		Initialize a map that is the transverse of the given map.  If
+	///		fAreaWeighted is true entry (j,i) is scaled by the ratio of the
+	///		area of target face i to the area of source face j, giving the
+	///		adjoint of the map with respect to the area-weighted inner
+	///		product; otherwise the plain transpose of the weights is used.
 	///	</summary>
 	void SetTranspose(
-		const OfflineMap & mapIn
+		const OfflineMap & mapIn,
+		bool fAreaWeighted = true
+	);
+
+	///	<summary>
+	///		Initialize a map that is the composition of two maps, which first
+	///		applies mapFirst and then mapSecond.  The target grid of mapFirst
+	///		must be the source grid of mapSecond.
+	///	</summary>
+	void SetComposition(
+		const OfflineMap & mapFirst,
+		const OfflineMap & mapSecond
+	);
+
+	///	<summary>
+	///		Initialize a map that is the restriction of the given map to a
+	///		subset of its target degrees of freedom, given by 0-based index
+	///		in vecTargetIx.  Row i of this map is row vecTargetIx[i] of mapIn,
+	///		and the source degrees of freedom are compacted to those referenced
+	///		by the selected rows, in increasing order.  Only the selected rows
+	///		of mapIn are visited, so a memory mapped map is never read in
+	///		full.  If pvecSourceIx is not NULL it is set to the index in mapIn
+	///		of each source degree of freedom of this map.  The grids of the
+	///		subset map are unstructured.
+	///	</summary>
+	void SetSubset(
+		const OfflineMap & mapIn,
+		const std::vector<int> & vecTargetIx,
+		std::vector<int> * pvecSourceIx = NULL
 	);
 
 private:
 	///	<summary>
-	///		Determine if the map is first-order accurate.
+	///		Get the map in CSR form, finalizing a copy in smatTemp if the
+	///		map itself has not been finalized.
+	///	</summary>
+	const SparseMatrix<double> & GetFinalizedMap(
+		SparseMatrix<double> & smatTemp
+	) const;
+
+	///	<summary>
+	///		Calculate the sum of each row of the map with compensated
+	///		summation.
+	///	</summary>
+	void CalculateRowSums(
+		const SparseMatrix<double> & smatRemap,
+		DataArray1D<double> & dRowSums
+	) const;
+
+	///	<summary>
+	///		Calculate the area-weighted sum of each column of the map, divided
+	///		by the source area, with compensated summation over the transpose
+	///		of the map.
+	///	</summary>
+	void CalculateColumnSums(
+		const SparseMatrix<double> & smatRemapTranspose,
+		DataArray1D<double> & dColSums
+	) const;
+
+	///	<summary>
+	///		Determine if the map is first-order accurate from its row sums.
 	///	</summary>
 	virtual int IsConsistent(
 		double dTolerance,
-		const DataArray1D<int> & dataRows,
-		const DataArray1D<int> & dataCols,
-		const DataArray1D<double> & dataEntries,
-		DataArray1D<double> * pdRowSums = NULL
+		const DataArray1D<double> & dRowSums
 	);
 
 	///	<summary>
-	///		Determine if the map is conservative.
+	///		Determine if the map is conservative from its column sums.
 	///	</summary>
 	virtual int IsConservative(
 		double dTolerance,
-		const DataArray1D<int> & dataRows,
-		const DataArray1D<int> & dataCols,
-		const DataArray1D<double> & dataEntries,
-		DataArray1D<double> * pdColSums = NULL
+		const DataArray1D<double> & dColSums
 	);
 
 	///	<summary>
@@ -423,9 +637,7 @@ private:
 	///	</summary>
 	virtual int IsMonotone(
 		double dTolerance,
-		const DataArray1D<int> & dataRows,
-		const DataArray1D<int> & dataCols,
-		const DataArray1D<double> & dataEntries
+		const SparseMatrix<double> & smatRemap
 	);
 
 public:
@@ -462,6 +674,21 @@ public:
 		double dTotalOverlapArea = 0.0
 	);
 
+	///	<summary>
+	///		Make the map monotone by blending it with a monotone low-order map
+	///		of the same source and target, as (1 - alpha) M + alpha L, using
+	///		the smallest alpha for which all entries lie in [0,1] (within
+	///		dTolerance).  Since alpha is the same for all rows, consistency
+	///		and conservation of the two maps are preserved.  The low-order map
+	///		should have the sparsity pattern of this map, as otherwise entries
+	///		of this map missing from the low-order map may require alpha = 1.
+	///		Returns the blend factor alpha.
+	///	</summary>
+	double EnforceMonotonicity(
+		const SparseMatrix<double> & smatLowOrder,
+		double dTolerance = 0.0
+	);
+
 public:
 	///	<summary>
 	///		Get the vector of areas associated with the source mesh.
@@ -604,6 +831,72 @@ public:
 		m_vecEnforcementBounds.clear();
 	}
 
+public:
+	///	<summary>
+	///		Distribute the slices of each variable over all MPI ranks in
+	///		Apply().  All ranks must then call Apply() with the same
+	///		arguments; each rank other than rank 0 reads and remaps its own
+	///		blocks of slices and rank 0 writes the target file.  Has no
+	///		effect unless built with TEMPEST_MPIOMP.
+	///	</summary>
+	void SetDistributeSlices(bool fDistributeSlices) {
+		m_fDistributeSlices = fDistributeSlices;
+	}
+
+	///	<summary>
+	///		Set up all variables before remapping in Apply(), so that reading
+	///		and writing of one variable overlaps the application of the map
+	///		to another.  File operations remain on a single thread, since
+	///		NetCDF is not thread safe.  Ignored by a distributed Apply().
+	///	</summary>
+	void SetParallelVariables(bool fParallelVariables) {
+		m_fParallelVariables = fParallelVariables;
+	}
+
+	///	<summary>
+	///		Rescale remapped values in Apply() so that the weights of valid
+	///		(non-fill) source values sum to the row sum of the map, and set
+	///		targets with no valid source values to the fill value.  The
+	///		pattern of missing values is detected from the first slice of
+	///		each variable and its scaling reused for all slices with the
+	///		same pattern.  Ignored by a distributed Apply().
+	///	</summary>
+	void SetRenormalizeFillValues(bool fRenormalizeFillValues) {
+		m_fRenormalizeFillValues = fRenormalizeFillValues;
+	}
+
+	///	<summary>
+	///		Renumber the source and target points internally when the map
+	///		is prepared for Apply() (or an OfflineMapApplySession), so that
+	///		the source values gathered by neighboring target points are
+	///		close in memory.  Data are permuted on the fly and results are
+	///		unchanged; this helps large unstructured grids whose numbering
+	///		scatters the sources of neighboring targets, at the cost of a
+	///		copy of the map.
+	///	</summary>
+	void SetReorderForApply(bool fReorderForApply) {
+		m_fReorderForApply = fReorderForApply;
+	}
+
+	///	<summary>
+	///		Check if the map is renumbered when prepared for Apply().
+	///	</summary>
+	bool GetReorderForApply() const {
+		return m_fReorderForApply;
+	}
+
+protected:
+#if defined(TEMPEST_MPIOMP)
+	///	<summary>
+	///		Read and remap the blocks of slices assigned to this rank by a
+	///		distributed Apply() on rank 0, and send them to rank 0.
+	///	</summary>
+	void ApplyDistributedWorker(
+		const std::string & strSourceDataFile,
+		bool fTargetDouble
+	);
+#endif
+
 protected:
 	///	<summary>
 	///		The SparseMatrix representing this operator.
@@ -747,6 +1040,65 @@ protected:
 	///	</summary>
 	EnforceBoundsVector m_vecEnforcementBounds;
 
+	///	<summary>
+	///		Distribute slices over MPI ranks in Apply().
+	///	</summary>
+	bool m_fDistributeSlices;
+
+	///	<summary>
+	///		Pipeline blocks of different variables in Apply().
+	///	</summary>
+	bool m_fParallelVariables;
+
+	///	<summary>
+	///		Renormalize for missing source values in Apply().
+	///	</summary>
+	bool m_fRenormalizeFillValues;
+
+	///	<summary>
+	///		Renumber source and target points for locality in Apply().
+	///	</summary>
+	bool m_fReorderForApply;
+
+	///	<summary>
+	///		Finite-volume source mesh from which the source coordinate arrays
+	///		are computed on demand, or NULL.
+	///	</summary>
+	const Mesh * m_pmeshSourceCoordinates;
+
+	///	<summary>
+	///		Finite-volume target mesh from which the target coordinate arrays
+	///		are computed on demand, or NULL.
+	///	</summary>
+	const Mesh * m_pmeshTargetCoordinates;
+
+	///	<summary>
+	///		Write the vertex arrays in Write().
+	///	</summary>
+	bool m_fWriteVertexArrays;
+
+	///	<summary>
+	///		Read the source cell centers in Read().
+	///	</summary>
+	bool m_fReadSourceCenters;
+
+	///	<summary>
+	///		Read the vertex arrays in Read().
+	///	</summary>
+	bool m_fReadVertexArrays;
+
+	///	<summary>
+	///		Target degrees of freedom whose rows are kept in Read(), or empty
+	///		to keep every row.
+	///	</summary>
+	std::vector<int> m_vecReadTargetRows;
+
+	///	<summary>
+	///		Memory mapped binary map file backing m_mapRemap, if any.  Other
+	///		arrays attached to the file retain the mapping themselves.
+	///	</summary>
+	std::shared_ptr<MemoryMappedFile> m_pmmapBinary;
+
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,220 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    OfflineMapApplySession.cpp
+///	\author  Paul Ullrich
+///	\version October 14, 2026
+///
+///	<remarks>
+///		Copyright 2026 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "OfflineMapApplySession.h"
+#include "Announce.h"
+#include "Exception.h"
+
+///////////////////////////////////////////////////////////////////////////////
+
+OfflineMapApplySession::OfflineMapApplySession(
+	const std::string & strMapFile
+) :
+	m_pmapOwned(NULL),
+	m_pmapRemap(NULL),
+	m_psmatDevice(NULL),
+	m_nSourceCount(0),
+	m_nTargetCount(0),
+	m_nReservedLevels(0)
+{
+	m_pmapOwned = new OfflineMap;
+	m_pmapRemap = m_pmapOwned;
+
+	try {
+		m_pmapOwned->SetReadSourceCenters(false);
+		m_pmapOwned->SetReadVertexArrays(false);
+		m_pmapOwned->Read(strMapFile);
+		Initialize();
+	} catch(...) {
+		delete m_pmapOwned;
+		throw;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+OfflineMapApplySession::OfflineMapApplySession(
+	OfflineMap & mapRemap
+) :
+	m_pmapOwned(NULL),
+	m_pmapRemap(&mapRemap),
+	m_psmatDevice(NULL),
+	m_nSourceCount(0),
+	m_nTargetCount(0),
+	m_nReservedLevels(0)
+{
+	Initialize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+OfflineMapApplySession::~OfflineMapApplySession() {
+	delete m_psmatDevice;
+	delete m_pmapOwned;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OfflineMapApplySession::Initialize() {
+
+	SparseMatrix<double> & smatRemap = m_pmapRemap->GetSparseMatrix();
+
+	// Field sizes are given by the map areas, which may exceed the extent
+	// of the nonzero entries
+	m_nSourceCount = static_cast<int>(m_pmapRemap->GetSourceAreas().GetRows());
+	m_nTargetCount = static_cast<int>(m_pmapRemap->GetTargetAreas().GetRows());
+
+	if (smatRemap.GetColumns() > m_nSourceCount) {
+		m_nSourceCount = smatRemap.GetColumns();
+	}
+	if (smatRemap.GetRows() > m_nTargetCount) {
+		m_nTargetCount = smatRemap.GetRows();
+	}
+	if ((m_nSourceCount == 0) || (m_nTargetCount == 0)) {
+		_EXCEPTIONT("OfflineMap is empty");
+	}
+
+	smatRemap.Finalize();
+
+	m_psmatDevice = new SparseMatrixDevice<double>(
+		smatRemap, m_pmapRemap->GetReorderForApply());
+
+	if (m_psmatDevice->IsOnDevice()) {
+		Announce("Map resident on target device %i",
+			m_psmatDevice->GetDevice());
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OfflineMapApplySession::Reserve(
+	int nLevels
+) {
+	if (nLevels <= m_nReservedLevels) {
+		return;
+	}
+
+	m_dataBlockIn.Allocate(m_nSourceCount, nLevels);
+	m_dataBlockOut.Allocate(m_nTargetCount, nLevels);
+
+	m_nReservedLevels = nLevels;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OfflineMapApplySession::Apply(
+	const double * pSource,
+	double * pTarget,
+	int nLevels
+) {
+	if (nLevels < 1) {
+		_EXCEPTION1("Invalid level count (%i)", nLevels);
+	}
+	if ((pSource == NULL) || (pTarget == NULL)) {
+		_EXCEPTIONT("NULL field pointer");
+	}
+
+	const size_t sSourceCount = static_cast<size_t>(m_nSourceCount);
+	const size_t sTargetCount = static_cast<size_t>(m_nTargetCount);
+
+	// A single level already has the layout of a block with one column,
+	// so the caller's buffers are used in place
+	if (nLevels == 1) {
+		DataArray2D<double> dataIn(sSourceCount, 1, false);
+		DataArray2D<double> dataOut(sTargetCount, 1, false);
+		dataIn.AttachToData(const_cast<double *>(pSource));
+		dataOut.AttachToData(pTarget);
+
+		m_psmatDevice->Apply(dataIn, dataOut, 1);
+		return;
+	}
+
+	Reserve(nLevels);
+
+	const size_t sLevels = static_cast<size_t>(nLevels);
+	const size_t sBlockStride = m_dataBlockIn.GetColumns();
+
+	// Transpose levels into the work buffers so that each map entry is
+	// read once for all levels
+	double * pBlockIn = m_dataBlockIn(0);
+#pragma omp parallel for schedule(static) \
+	if (sSourceCount * sLevels >= SparseMatrixParallelApplyThreshold)
+	for (int i = 0; i < m_nSourceCount; i++) {
+		double * pRow = pBlockIn + i * sBlockStride;
+		for (size_t k = 0; k < sLevels; k++) {
+			pRow[k] = pSource[k * sSourceCount + i];
+		}
+	}
+
+	m_psmatDevice->Apply(m_dataBlockIn, m_dataBlockOut, sLevels);
+
+	const double * pBlockOut = m_dataBlockOut(0);
+#pragma omp parallel for schedule(static) \
+	if (sTargetCount * sLevels >= SparseMatrixParallelApplyThreshold)
+	for (int i = 0; i < m_nTargetCount; i++) {
+		const double * pRow = pBlockOut + i * sBlockStride;
+		for (size_t k = 0; k < sLevels; k++) {
+			pTarget[k * sTargetCount + i] = pRow[k];
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OfflineMapApplySession::Apply(
+	const DataArray1D<double> & dataSource,
+	DataArray1D<double> & dataTarget
+) {
+	if (dataSource.GetRows() != static_cast<size_t>(m_nSourceCount)) {
+		_EXCEPTION2("Source field has incorrect size (%lu, expected %i)",
+			dataSource.GetRows(), m_nSourceCount);
+	}
+	if (dataTarget.GetRows() != static_cast<size_t>(m_nTargetCount)) {
+		_EXCEPTION2("Target field has incorrect size (%lu, expected %i)",
+			dataTarget.GetRows(), m_nTargetCount);
+	}
+
+	Apply(&(dataSource[0]), &(dataTarget[0]), 1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OfflineMapApplySession::Apply(
+	const DataArray2D<double> & dataSource,
+	DataArray2D<double> & dataTarget
+) {
+	if (dataSource.GetColumns() != static_cast<size_t>(m_nSourceCount)) {
+		_EXCEPTION2("Source field has incorrect size (%lu, expected %i)",
+			dataSource.GetColumns(), m_nSourceCount);
+	}
+	if (dataTarget.GetColumns() != static_cast<size_t>(m_nTargetCount)) {
+		_EXCEPTION2("Target field has incorrect size (%lu, expected %i)",
+			dataTarget.GetColumns(), m_nTargetCount);
+	}
+	if (dataSource.GetRows() != dataTarget.GetRows()) {
+		_EXCEPTION2("Source and target level counts differ (%lu, %lu)",
+			dataSource.GetRows(), dataTarget.GetRows());
+	}
+	if (dataSource.GetRows() == 0) {
+		return;
+	}
+
+	Apply(dataSource(0), dataTarget(0),
+		static_cast<int>(dataSource.GetRows()));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,180 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    OfflineMapApplySession.h
+///	\author  Paul Ullrich
+///	\version October 14, 2026
+///
+///	<remarks>
+///		Copyright 2026 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#ifndef _OFFLINEMAPAPPLYSESSION_H_
+#define _OFFLINEMAPAPPLYSESSION_H_
+
+#include "OfflineMap.h"
+#include "SparseMatrixDevice.h"
+#include "DataArray1D.h"
+#include "DataArray2D.h"
+
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		An OfflineMap prepared for repeated application to in-memory data,
+///		such as within the time loop of a coupler.  The map is loaded and
+///		finalized once, and work buffers for the largest number of levels
+///		requested so far are retained between calls, so that Apply() does
+///		no file I/O and, after Reserve(), no allocation.  Fields are stored
+///		level-major: level l of a field with n points occupies elements
+///		[l*n, (l+1)*n) of the buffer.  An OfflineMapApplySession is not safe
+///		for concurrent use by several threads.
+///	</summary>
+class OfflineMapApplySession {
+
+public:
+	///	<summary>
+	///		Construct the session by reading an OfflineMap from file.
+	///	</summary>
+	explicit OfflineMapApplySession(
+		const std::string & strMapFile
+	);
+
+	///	<summary>
+	///		Construct the session from an OfflineMap held by the caller,
+	///		which is finalized if needed and must outlive the session.
+	///	</summary>
+	explicit OfflineMapApplySession(
+		OfflineMap & mapRemap
+	);
+
+	///	<summary>
+	///		Destructor.
+	///	</summary>
+	~OfflineMapApplySession();
+
+private:
+	///	<summary>
+	///		Copy constructor (disabled).
+	///	</summary>
+	OfflineMapApplySession(const OfflineMapApplySession &);
+
+	///	<summary>
+	///		Assignment operator (disabled).
+	///	</summary>
+	OfflineMapApplySession & operator=(const OfflineMapApplySession &);
+
+	///	<summary>
+	///		Finalize the map and place it on the target device.
+	///	</summary>
+	void Initialize();
+
+public:
+	///	<summary>
+	///		Get the OfflineMap.
+	///	</summary>
+	const OfflineMap & GetOfflineMap() const {
+		return *m_pmapRemap;
+	}
+
+	///	<summary>
+	///		Get the number of points in a source field.
+	///	</summary>
+	int GetSourceCount() const {
+		return m_nSourceCount;
+	}
+
+	///	<summary>
+	///		Get the number of points in a target field.
+	///	</summary>
+	int GetTargetCount() const {
+		return m_nTargetCount;
+	}
+
+	///	<summary>
+	///		Ensure work buffers are available for fields of up to nLevels
+	///		levels, so that subsequent calls to Apply() do not allocate.
+	///	</summary>
+	void Reserve(
+		int nLevels
+	);
+
+	///	<summary>
+	///		Apply the map to nLevels levels of source data, writing nLevels
+	///		levels of target data.  pSource must hold nLevels *
+	///		GetSourceCount() values and pTarget nLevels * GetTargetCount()
+	///		values.  A single level is applied directly without the work
+	///		buffers.
+	///	</summary>
+	void Apply(
+		const double * pSource,
+		double * pTarget,
+		int nLevels = 1
+	);
+
+	///	<summary>
+	///		Apply the map to a single level.
+	///	</summary>
+	void Apply(
+		const DataArray1D<double> & dataSource,
+		DataArray1D<double> & dataTarget
+	);
+
+	///	<summary>
+	///		Apply the map to a field with one row per level.
+	///	</summary>
+	void Apply(
+		const DataArray2D<double> & dataSource,
+		DataArray2D<double> & dataTarget
+	);
+
+private:
+	///	<summary>
+	///		OfflineMap read from file, if not provided by the caller.
+	///	</summary>
+	OfflineMap * m_pmapOwned;
+
+	///	<summary>
+	///		The OfflineMap being applied.
+	///	</summary>
+	OfflineMap * m_pmapRemap;
+
+	///	<summary>
+	///		The finalized SparseMatrix, resident on the target device if
+	///		one is available.
+	///	</summary>
+	SparseMatrixDevice<double> * m_psmatDevice;
+
+	///	<summary>
+	///		Number of points in a source field.
+	///	</summary>
+	int m_nSourceCount;
+
+	///	<summary>
+	///		Number of points in a target field.
+	///	</summary>
+	int m_nTargetCount;
+
+	///	<summary>
+	///		Source and target work buffers, with one row per point and one
+	///		column per level.
+	///	</summary>
+	DataArray2D<double> m_dataBlockIn;
+	DataArray2D<double> m_dataBlockOut;
+
+	///	<summary>
+	///		Number of levels the work buffers can hold.
+	///	</summary>
+	int m_nReservedLevels;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif
+
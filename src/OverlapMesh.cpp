@@ -21,11 +21,30 @@
 
 #include "Announce.h"
 
-#include "kdtree.h"
+#include "PointKDTree.h"
+#include "FaceBVH.h"
+#include "OverlapMeshStatistics.h"
+#include "OverlapMeshCache.h"
 
 #include <unistd.h>
 #include <iostream>
 #include <queue>
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+#include <cstring>
+#include <cstdint>
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+#if defined(TEMPEST_MPIOMP)
+#include <mpi.h>
+#endif
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -130,7 +149,9 @@ typedef std::vector<PathSegment> PathSegmentVector;
 
 ///	<summary>
 ///		Generate a PathSegmentVector describing the path around the face
-///		ixCurrentSourceFace.
+///		ixCurrentSourceFace.  The starting face on the target mesh is chosen
+///		from vecTargetFaceCandidates, which must include every target face
+///		containing the first corner of the source face in ascending order.
 ///	</summary>
 template <
 	class MeshUtilities,
@@ -141,6 +162,7 @@ void GeneratePath(
 	const Mesh & meshTarget,
 	const std::vector<int> & vecTargetNodeMap,
 	int ixCurrentSourceFace,
+	const std::vector<int> & vecTargetFaceCandidates,
 	PathSegmentVector & vecTracedPath,
 	Mesh & meshOverlap
 ) {
@@ -148,6 +170,8 @@ void GeneratePath(
 	// MeshUtilities object
 	MeshUtilities utils;
 
+	OVERLAPMESH_STAT_WALK(walkPath, Histogram_PathTracingSteps);
+
 	// Get the NodeVectors
 	const NodeVector & nodevecSource = meshSource.nodes;
 	const NodeVector & nodevecTarget = meshTarget.nodes;
@@ -166,6 +190,7 @@ void GeneratePath(
 	utils.FindFaceFromNode(
 		meshTarget,
 		nodeCurrent,
+		vecTargetFaceCandidates,
 		aFindFaceStruct);
 
 	// No faces found
@@ -238,6 +263,8 @@ void GeneratePath(
 		// Repeat until we hit the end of this edge
 		for (;;) {
 
+			OVERLAPMESH_STAT_STEP(walkPath);
+
 			const Face & faceTargetCurrent =
 				meshTarget.faces[ixCurrentTargetFace];
 
@@ -1165,74 +1192,87 @@ ContinueToNextFace:
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void GenerateOverlapMesh_v1(
+///	<summary>
+///		Generate the overlap faces of source face ixCurrentSourceFace with
+///		the algorithm of GenerateOverlapMesh_v1(), appending intersection
+///		nodes and overlap faces to meshOverlap.  vecTracedPath is scratch
+///		storage.
+///	</summary>
+static void GenerateOverlapMeshFromFace_v1(
 	const Mesh & meshSource,
 	const Mesh & meshTarget,
-	Mesh & meshOverlap,
-    OverlapMeshMethod method,
-    const bool fVerbose
+	const std::vector<int> & vecTargetNodeMap,
+	int ixCurrentSourceFace,
+	const std::vector<int> & vecTargetFaceCandidates,
+	OverlapMeshMethod method,
+	PathSegmentVector & vecTracedPath,
+	Mesh & meshOverlap
 ) {
-	meshOverlap.Clear();
-
-	// Get the two NodeVectors
-	const NodeVector & nodevecSource = meshSource.nodes;
-	const NodeVector & nodevecTarget = meshTarget.nodes;
+#if defined(OVERLAPMESH_STATISTICS)
+	const size_t sInitialOverlapFaces = meshOverlap.faces.size();
+#endif
 
-	// Check for coincident Nodes between meshSource and meshTarget
-	std::vector<int> vecTargetNodeMap;
+#ifdef CHECK_AREAS
+	Real dSourceFaceArea = meshSource.CalculateFaceArea(ixCurrentSourceFace);
+#endif
 
-	int nCoincidentNodes =
-		BuildCoincidentNodeVector(
-			meshSource, meshTarget, vecTargetNodeMap);
+	// Generate the path
+	vecTracedPath.clear();
 
-    if (fVerbose) Announce("Number of coincident nodes between mesh A and B [%i]",
-		nCoincidentNodes);
+	// Fuzzy arithmetic (standard floating point operations)
+	if (method == OverlapMeshMethod_Fuzzy) {
+		GeneratePath<MeshUtilitiesFuzzy, Node>(
+			meshSource,
+			meshTarget,
+			vecTargetNodeMap,
+			ixCurrentSourceFace,
+			vecTargetFaceCandidates,
+			vecTracedPath,
+			meshOverlap
+		);
 
-	// Insert all nodes from the two NodeVectors
-	for (int i = 0; i < nodevecSource.size(); i++) {
-		meshOverlap.nodes.push_back(nodevecSource[i]);
-		//mapOverlapNodes.insert(NodeMap::value_type(nodevecSource[i], i));
+		GenerateOverlapFaces(
+			meshTarget,
+			vecTargetNodeMap,
+			vecTracedPath,
+			ixCurrentSourceFace,
+			meshOverlap
+		);
 	}
 
-	for (int i = 0; i < nodevecTarget.size(); i++) {
-		if (vecTargetNodeMap[i] == InvalidNode) {
-			int ix = static_cast<int>(meshOverlap.nodes.size());
-			meshOverlap.nodes.push_back(nodevecTarget[i]);
-			//mapOverlapNodes.insert(NodeMap::value_type(nodevecTarget[i], ix));
-			vecTargetNodeMap[i] = ix;
-		}
-	}
+	// Exact arithmetic
+	if (method == OverlapMeshMethod_Exact) {
+		GeneratePath<MeshUtilitiesExact, NodeExact>(
+			meshSource,
+			meshTarget,
+			vecTargetNodeMap,
+			ixCurrentSourceFace,
+			vecTargetFaceCandidates,
+			vecTracedPath,
+			meshOverlap
+		);
 
-/*
-	// Estimate meshOverlap size
-	int nMaximumFaceCount;
-	if (meshSource.faces.size() > meshTarget.faces.size()) {
-		nMaximumFaceCount = static_cast<int>(meshSource.faces.size());
-	} else {
-		nMaximumFaceCount = static_cast<int>(meshTarget.faces.size());
+		GenerateOverlapFaces(
+			meshTarget,
+			vecTargetNodeMap,
+			vecTracedPath,
+			ixCurrentSourceFace,
+			meshOverlap
+		);
 	}
-	meshOverlap.faces.reserve(2 * nMaximumFaceCount);
-*/
-	// Loop through all Faces on the first Mesh
-	int ixCurrentSourceFace = 0;
-
-	for (; ixCurrentSourceFace < meshSource.faces.size(); ixCurrentSourceFace++) {
-	//for (int ixCurrentSourceFace = 853; ixCurrentSourceFace < 854; ixCurrentSourceFace++) {
-
-#ifdef CHECK_AREAS
-		Real dSourceFaceArea = meshSource.CalculateFaceArea(ixCurrentSourceFace);
-#endif
 
-		// Generate the path
-		PathSegmentVector vecTracedPath;
+	// Mixed method; try Fuzzy arithmetic first
+	if (method == OverlapMeshMethod_Mixed) {
+		int nInitialOverlapNodes = meshOverlap.nodes.size();
+		int nInitialOverlapFaces = meshOverlap.faces.size();
 
-		// Fuzzy arithmetic (standard floating point operations)
-		if (method == OverlapMeshMethod_Fuzzy) {
+		try {
 			GeneratePath<MeshUtilitiesFuzzy, Node>(
 				meshSource,
 				meshTarget,
 				vecTargetNodeMap,
 				ixCurrentSourceFace,
+				vecTargetFaceCandidates,
 				vecTracedPath,
 				meshOverlap
 			);
@@ -1244,15 +1284,25 @@ void GenerateOverlapMesh_v1(
 				ixCurrentSourceFace,
 				meshOverlap
 			);
-		}
 
-		// Exact arithmetic
-		if (method == OverlapMeshMethod_Exact) {
+		} catch(Exception & e) {
+			printf("WARNING: Fuzzy arithmetic operations failed "
+				"with message:\n  \"%s\"\n  Trying exact arithmetic",
+				e.ToString().c_str());
+
+			vecTracedPath.clear();
+
+			meshOverlap.nodes.resize(nInitialOverlapNodes);
+			meshOverlap.faces.resize(nInitialOverlapFaces);
+			meshOverlap.vecSourceFaceIx.resize(nInitialOverlapFaces);
+			meshOverlap.vecTargetFaceIx.resize(nInitialOverlapFaces);
+
 			GeneratePath<MeshUtilitiesExact, NodeExact>(
 				meshSource,
 				meshTarget,
 				vecTargetNodeMap,
 				ixCurrentSourceFace,
+				vecTargetFaceCandidates,
 				vecTracedPath,
 				meshOverlap
 			);
@@ -1265,232 +1315,650 @@ void GenerateOverlapMesh_v1(
 				meshOverlap
 			);
 		}
-
-		// Mixed method; try Fuzzy arithmetic first
-		if (method == OverlapMeshMethod_Mixed) {
-			int nInitialOverlapNodes = meshOverlap.nodes.size();
-			int nInitialOverlapFaces = meshOverlap.faces.size();
-
-			try {
-				GeneratePath<MeshUtilitiesFuzzy, Node>(
-					meshSource,
-					meshTarget,
-					vecTargetNodeMap,
-					ixCurrentSourceFace,
-					vecTracedPath,
-					meshOverlap
-				);
-
-				GenerateOverlapFaces(
-					meshTarget,
-					vecTargetNodeMap,
-					vecTracedPath,
-					ixCurrentSourceFace,
-					meshOverlap
-				);
-
-			} catch(Exception & e) {
-				printf("WARNING: Fuzzy arithmetic operations failed "
-					"with message:\n  \"%s\"\n  Trying exact arithmetic",
-					e.ToString().c_str());
-
-				vecTracedPath.clear();
-
-				meshOverlap.nodes.resize(nInitialOverlapNodes);
-				meshOverlap.faces.resize(nInitialOverlapFaces);
-				meshOverlap.vecSourceFaceIx.resize(nInitialOverlapFaces);
-				meshOverlap.vecTargetFaceIx.resize(nInitialOverlapFaces);
-
-				GeneratePath<MeshUtilitiesExact, NodeExact>(
-					meshSource,
-					meshTarget,
-					vecTargetNodeMap,
-					ixCurrentSourceFace,
-					vecTracedPath,
-					meshOverlap
-				);
-
-				GenerateOverlapFaces(
-					meshTarget,
-					vecTargetNodeMap,
-					vecTracedPath,
-					ixCurrentSourceFace,
-					meshOverlap
-				);
-			}
-		}
+	}
 
 #ifdef CHECK_AREAS
-		int nMeshOverlapPrevFaces = meshOverlap.faces.size();
+	int nMeshOverlapPrevFaces = meshOverlap.faces.size();
 #endif
 
 #ifdef CHECK_AREAS
-		int nMeshOverlapCurrentFaces = meshOverlap.faces.size();
+	int nMeshOverlapCurrentFaces = meshOverlap.faces.size();
 
-		Real dOverlapAreas = 0.0;
-		for (int i = nMeshOverlapPrevFaces; i < nMeshOverlapCurrentFaces; i++) {
-			dOverlapAreas += meshOverlap.CalculateFaceArea(i);
-		}
+	Real dOverlapAreas = 0.0;
+	for (int i = nMeshOverlapPrevFaces; i < nMeshOverlapCurrentFaces; i++) {
+		dOverlapAreas += meshOverlap.CalculateFaceArea(i);
+	}
 
-		if (fabs(dOverlapAreas - dSourceFaceArea) > ReferenceTolerance) {
-			printf("Area inconsistency (%i : %1.15e %1.15e)\n",
-				ixCurrentSourceFace,
-				dSourceFaceArea,
-				dOverlapAreas);
-			_EXCEPTION();
-		}
+	if (fabs(dOverlapAreas - dSourceFaceArea) > ReferenceTolerance) {
+		printf("Area inconsistency (%i : %1.15e %1.15e)\n",
+			ixCurrentSourceFace,
+			dSourceFaceArea,
+			dOverlapAreas);
+		_EXCEPTION();
+	}
 #endif
 
 /*
-		if (!fSuccess) {
-			_EXCEPTIONT("OverlapMesh generation failed");
-		}
-*/
+	if (!fSuccess) {
+		_EXCEPTIONT("OverlapMesh generation failed");
 	}
+*/
+#if defined(OVERLAPMESH_STATISTICS)
+	OverlapMeshStatistics::Local().Sample(
+		OverlapMeshStatistics::Histogram_OverlapFacesPerSourceFace,
+		meshOverlap.faces.size() - sInitialOverlapFaces);
+#endif
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
-template <
-	class MeshUtilities,
-	class NodeIntersectType
->
-void GenerateOverlapFace(
+void GenerateOverlapMesh_v1(
 	const Mesh & meshSource,
 	const Mesh & meshTarget,
-	int iSourceFace,
-	int iTargetFace,
-    NodeVector & nodevecOutput
+	Mesh & meshOverlap,
+    OverlapMeshMethod method,
+    const bool fVerbose
 ) {
-/*
-  // Sutherland–Hodgman algorithm (pseudocode)
-  List outputList = subjectPolygon;
-  for (Edge clipEdge in clipPolygon) do
-     List inputList = outputList;
-     outputList.clear();
-     Point S = inputList.last;
-     for (Point E in inputList) do
-        if (E inside clipEdge) then
-           if (S not inside clipEdge) then
-              outputList.add(ComputeIntersection(S,E,clipEdge));
-           end if
-           outputList.add(E);
-        else if (S inside clipEdge) then
-           outputList.add(ComputeIntersection(S,E,clipEdge));
-        end if
-        S = E;
-     done
-  done
-*/
-	MeshUtilities utils;
+	meshOverlap.Clear();
 
-	// Use Sutherland–Hodgman algorithm to clip polygons
-	const NodeVector & nodesTarget = meshTarget.nodes;
-	const NodeVector & nodesSource = meshSource.nodes;
+	// Polygon clipping is only implemented for GenerateOverlapMesh_v2()
+	if (method == OverlapMeshMethod_Clip) {
+		method = OverlapMeshMethod_Fuzzy;
+	}
 
-	const Face & faceTarget = meshTarget.faces[iTargetFace];
-	const Face & faceSource = meshSource.faces[iSourceFace];
+	OVERLAPMESH_STAT_RESET();
 
-	const EdgeVector & evecTarget = faceTarget.edges;
-	const EdgeVector & evecSource = faceSource.edges;
+	// Get the two NodeVectors
+	const NodeVector & nodevecSource = meshSource.nodes;
+	const NodeVector & nodevecTarget = meshTarget.nodes;
 
-	// List outputList = subjectPolygon
-	for (int i = 0; i < evecTarget.size(); i++) {
-		nodevecOutput.push_back(nodesTarget[evecTarget[i][0]]);
-	}
+	// Check for coincident Nodes between meshSource and meshTarget
+	std::vector<int> vecTargetNodeMap;
 
-	// for (Edge clipEdge in clipPolygon) do
-	for (int i = 0; i < evecSource.size(); i++) {
+	int nCoincidentNodes =
+		BuildCoincidentNodeVector(
+			meshSource, meshTarget, vecTargetNodeMap);
 
-		// All points outside of source polygon
-		if (nodevecOutput.size() == 0) {
-			break;
-		}
+    if (fVerbose) Announce("Number of coincident nodes between mesh A and B [%i]",
+		nCoincidentNodes);
 
-		// List inputList = outputList;
-		NodeVector nodevecInput = nodevecOutput;
+	// Insert all nodes from the two NodeVectors
+	for (int i = 0; i < nodevecSource.size(); i++) {
+		meshOverlap.nodes.push_back(nodevecSource[i]);
+		//mapOverlapNodes.insert(NodeMap::value_type(nodevecSource[i], i));
+	}
 
-		// outputList.clear();
-		nodevecOutput.clear();
+	for (int i = 0; i < nodevecTarget.size(); i++) {
+		if (vecTargetNodeMap[i] == InvalidNode) {
+			int ix = static_cast<int>(meshOverlap.nodes.size());
+			meshOverlap.nodes.push_back(nodevecTarget[i]);
+			//mapOverlapNodes.insert(NodeMap::value_type(nodevecTarget[i], ix));
+			vecTargetNodeMap[i] = ix;
+		}
+	}
 
-		// Point S = inputList.last;
-		Node nodeS = nodevecInput[nodevecInput.size()-1];
+/*
+	// Estimate meshOverlap size
+	int nMaximumFaceCount;
+	if (meshSource.faces.size() > meshTarget.faces.size()) {
+		nMaximumFaceCount = static_cast<int>(meshSource.faces.size());
+	} else {
+		nMaximumFaceCount = static_cast<int>(meshTarget.faces.size());
+	}
+	meshOverlap.faces.reserve(2 * nMaximumFaceCount);
+*/
+	// Find candidate target faces containing the first corner of each
+	// source face, using a bounding volume hierarchy over the target mesh
+	std::vector< std::vector<int> > vecTargetFaceCandidates;
+	{
+		OVERLAPMESH_STAT_PHASE(Phase_SeedSearch);
 
-		int iNodeEdgeSideS =
-			utils.FindNodeEdgeSide(
-				nodesSource[evecSource[i][0]],
-				nodesSource[evecSource[i][1]],
-				evecSource[i].type,
-				nodeS);
+		NodeVector vecSourceCorners(meshSource.faces.size());
+		for (int i = 0; i < meshSource.faces.size(); i++) {
+			vecSourceCorners[i] = nodevecSource[meshSource.faces[i][0]];
+		}
 
-		//printf("===================\n");
-		//printf("S Side: %i\n", iNodeEdgeSideS);
+		FaceBVH bvhTarget(meshTarget);
 
-		// for (Point E in inputList) do
-		for (int iNodeE = 0; iNodeE < nodevecInput.size(); iNodeE++) {
-			const Node & nodeE = nodevecInput[iNodeE];
+		bvhTarget.FindCandidateFaces(vecSourceCorners, vecTargetFaceCandidates);
+	}
 
-			// if (E inside clipEdge) then
-			int iNodeEdgeSideE =
-				utils.FindNodeEdgeSide(
-					nodesSource[evecSource[i][0]],
-					nodesSource[evecSource[i][1]],
-					evecSource[i].type,
-					nodeE);
+	OVERLAPMESH_STAT_PHASE(Phase_OverlapFaces);
 
-			//printf("E Side: %i\n", iNodeEdgeSideE);
+	const int nSourceFaces = meshSource.faces.size();
 
-			if (iNodeEdgeSideE >= 0) {
+#if defined(_OPENMP)
+	// Generate overlap faces for blocks of source Faces in parallel.  Each
+	// thread appends intersection nodes to its own copy of the source and
+	// target nodes, and blocks are merged in order of source face so that
+	// the overlap mesh is identical to that generated serially.
+	if (!fVerbose && (omp_get_max_threads() > 1)) {
+		const int nBaseNodes = meshOverlap.nodes.size();
 
-				// if (S not inside clipEdge) then
-				if (iNodeEdgeSideS < 0) {
+		const int nBlocks =
+			(nSourceFaces + OverlapMeshParallelBlockSize - 1)
+				/ OverlapMeshParallelBlockSize;
 
-					// outputList.add(ComputeIntersection(S,E,clipEdge));
-					std::vector<Node> vecIntersections;
-					bool fCoincident =
-						utils.CalculateEdgeIntersectionsSemiClip(
-							nodeS,
-							nodeE,
-							Edge::Type_GreatCircleArc,
-							nodesSource[evecSource[i][0]],
-							nodesSource[evecSource[i][1]],
-							evecSource[i].type,
-							vecIntersections);
+		std::vector<Mesh> vecThreadMesh(omp_get_max_threads());
+		for (int t = 0; t < vecThreadMesh.size(); t++) {
+			vecThreadMesh[t].nodes = meshOverlap.nodes;
+		}
 
-/*
-					vecIntersections[0].Print("X");
+		int iError = 0;
+		std::string strError;
+
+#pragma omp parallel for schedule(dynamic) ordered
+		for (int b = 0; b < nBlocks; b++) {
+			const int ixBegin = b * OverlapMeshParallelBlockSize;
+			const int ixEnd =
+				std::min(ixBegin + OverlapMeshParallelBlockSize, nSourceFaces);
+
+			Mesh & meshBlock = vecThreadMesh[omp_get_thread_num()];
+			meshBlock.nodes.resize(nBaseNodes);
+			meshBlock.faces.clear();
+			meshBlock.vecSourceFaceIx.clear();
+			meshBlock.vecTargetFaceIx.clear();
+
+			int iErrorSoFar;
+#pragma omp atomic read
+			iErrorSoFar = iError;
+
+			std::string strBlockError;
+			if (iErrorSoFar == 0) {
+				try {
+					PathSegmentVector vecTracedPath;
+					for (int i = ixBegin; i < ixEnd; i++) {
+						GenerateOverlapMeshFromFace_v1(
+							meshSource,
+							meshTarget,
+							vecTargetNodeMap,
+							i,
+							vecTargetFaceCandidates[i],
+							method,
+							vecTracedPath,
+							meshBlock);
+					}
 
-					if (vecIntersections.size() != 1) {
-						printf("%i %i\n", iNodeEdgeSideE, iNodeEdgeSideS);
-						std::cout << vecIntersections.size() << std::endl;
+				} catch(Exception & e) {
+					strBlockError = e.ToString();
+				}
+			}
 
-						nodesSource[evecSource[i][0]].Print("S0");
-						nodesSource[evecSource[i][1]].Print("S1");
-						nodeS.Print("S");
-						nodeE.Print("E");
-						_EXCEPTIONT("Logic error");
-					}
-*/
-					if (vecIntersections.size() != 1) {
-						_EXCEPTIONT("Logic error");
+			// Merge blocks in order of source face index; intersection
+			// nodes follow the nodes of the source and target meshes
+#pragma omp ordered
+			{
+				if ((iError == 0) && (strBlockError != "")) {
+					strError = strBlockError;
+#pragma omp atomic write
+					iError = 1;
+				}
+				if (iError == 0) {
+					const int nNodeOffset =
+						meshOverlap.nodes.size() - nBaseNodes;
+
+					meshOverlap.nodes.insert(
+						meshOverlap.nodes.end(),
+						meshBlock.nodes.begin() + nBaseNodes,
+						meshBlock.nodes.end());
+
+					for (int f = 0; f < meshBlock.faces.size(); f++) {
+						Face & face = meshBlock.faces[f];
+						for (int i = 0; i < face.edges.size(); i++) {
+							if (face.edges[i][0] >= nBaseNodes) {
+								face.edges[i][0] += nNodeOffset;
+							}
+							if (face.edges[i][1] >= nBaseNodes) {
+								face.edges[i][1] += nNodeOffset;
+							}
+						}
+						meshOverlap.faces.push_back(std::move(face));
 					}
 
-					//vecIntersections[0].Print("Add");
-					nodevecOutput.push_back(vecIntersections[0]);
+					meshOverlap.vecSourceFaceIx.insert(
+						meshOverlap.vecSourceFaceIx.end(),
+						meshBlock.vecSourceFaceIx.begin(),
+						meshBlock.vecSourceFaceIx.end());
+					meshOverlap.vecTargetFaceIx.insert(
+						meshOverlap.vecTargetFaceIx.end(),
+						meshBlock.vecTargetFaceIx.begin(),
+						meshBlock.vecTargetFaceIx.end());
 				}
+			}
+		}
 
-				// outputList.add(E);
-				nodevecOutput.push_back(nodeE);
+		if (iError != 0) {
+			_EXCEPTION1("%s", strError.c_str());
+		}
 
-			// else if (S inside clipEdge) then
-			} else if (iNodeEdgeSideS >= 0) {
+	} else
+#endif
+	{
+		// Path around each source face, reused to avoid reallocation
+		PathSegmentVector vecTracedPath;
 
-				// outputList.add(ComputeIntersection(S,E,clipEdge));
-				std::vector<Node> vecIntersections;
-				bool fCoincident =
-					utils.CalculateEdgeIntersectionsSemiClip(
-						nodeS,
-						nodeE,
+		for (int i = 0; i < nSourceFaces; i++) {
+			GenerateOverlapMeshFromFace_v1(
+				meshSource,
+				meshTarget,
+				vecTargetNodeMap,
+				i,
+				vecTargetFaceCandidates[i],
+				method,
+				vecTracedPath,
+				meshOverlap);
+		}
+	}
+
+	OVERLAPMESH_STAT_PHASE_STOP(Phase_OverlapFaces);
+
+	OVERLAPMESH_STAT_REPORT();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A combinatorial identifier of a node of an overlap polygon.  Nodes
+///		of meshTarget and meshSource are identified by their index, and
+///		intersections of an edge of meshTarget with a great circle arc edge
+///		of meshSource, which are unique, by the sorted node indices of both
+///		edges.  Other nodes have an invalid identifier and are only
+///		identified by their coordinates.
+///	</summary>
+struct OverlapNodeKey {
+
+	///	<summary>
+	///		Constructor, producing an invalid identifier.
+	///	</summary>
+	OverlapNodeKey() {
+		ixTargetNode[0] = InvalidNode;
+		ixTargetNode[1] = InvalidNode;
+		ixSourceNode[0] = InvalidNode;
+		ixSourceNode[1] = InvalidNode;
+	}
+
+	///	<summary>
+	///		Check if this is a valid identifier.
+	///	</summary>
+	bool IsValid() const {
+		return (
+			(ixTargetNode[0] != InvalidNode) ||
+			(ixSourceNode[0] != InvalidNode));
+	}
+
+	///	<summary>
+	///		Equality operator.
+	///	</summary>
+	bool operator==(const OverlapNodeKey & key) const {
+		return (
+			(ixTargetNode[0] == key.ixTargetNode[0]) &&
+			(ixTargetNode[1] == key.ixTargetNode[1]) &&
+			(ixSourceNode[0] == key.ixSourceNode[0]) &&
+			(ixSourceNode[1] == key.ixSourceNode[1]));
+	}
+
+	///	<summary>
+	///		Node of meshTarget, or sorted nodes of the edge of meshTarget.
+	///	</summary>
+	int ixTargetNode[2];
+
+	///	<summary>
+	///		Node of meshSource, or sorted nodes of the edge of meshSource.
+	///	</summary>
+	int ixSourceNode[2];
+};
+
+///	<summary>
+///		Hasher for an OverlapNodeKey.
+///	</summary>
+struct OverlapNodeKeyHash {
+	std::size_t operator()(const OverlapNodeKey & key) const {
+		uint64_t h = static_cast<uint32_t>(key.ixTargetNode[0]);
+		h = h * 0x9E3779B97F4A7C15ULL + static_cast<uint32_t>(key.ixTargetNode[1]);
+		h = h * 0x9E3779B97F4A7C15ULL + static_cast<uint32_t>(key.ixSourceNode[0]);
+		h = h * 0x9E3779B97F4A7C15ULL + static_cast<uint32_t>(key.ixSourceNode[1]);
+		return static_cast<std::size_t>(h ^ (h >> 29));
+	}
+};
+
+///	<summary>
+///		A map between OverlapNodeKeys and indices of overlap mesh nodes.
+///	</summary>
+typedef std::unordered_map<OverlapNodeKey, int, OverlapNodeKeyHash>
+	OverlapNodeKeyMap;
+
+///	<summary>
+///		The edge of meshTarget or the great circle arc edge of meshSource on
+///		which an edge of an overlap polygon lies, given by its sorted node
+///		indices, or InvalidNode if the edge is not known.
+///	</summary>
+struct OverlapEdgeKey {
+
+	///	<summary>
+	///		Constructor, producing an unknown edge.
+	///	</summary>
+	OverlapEdgeKey() :
+		fSourceEdge(false)
+	{
+		ixNode[0] = InvalidNode;
+		ixNode[1] = InvalidNode;
+	}
+
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	OverlapEdgeKey(
+		int ixNode0,
+		int ixNode1,
+		bool a_fSourceEdge
+	) :
+		fSourceEdge(a_fSourceEdge)
+	{
+		ixNode[0] = std::min(ixNode0, ixNode1);
+		ixNode[1] = std::max(ixNode0, ixNode1);
+	}
+
+	///	<summary>
+	///		Sorted nodes of the edge.
+	///	</summary>
+	int ixNode[2];
+
+	///	<summary>
+	///		Flag indicating this is an edge of meshSource.
+	///	</summary>
+	bool fSourceEdge;
+};
+
+///	<summary>
+///		Combinatorial identifiers of the nodes of an overlap polygon, and
+///		for each node the edge on which the polygon edge from this node to
+///		the next lies.
+///	</summary>
+struct OverlapPolygonKeys {
+
+	///	<summary>
+	///		Remove all nodes.
+	///	</summary>
+	void clear() {
+		vecNodeKey.clear();
+		vecEdgeKey.clear();
+	}
+
+	///	<summary>
+	///		Exchange nodes with another OverlapPolygonKeys.
+	///	</summary>
+	void swap(OverlapPolygonKeys & keys) {
+		vecNodeKey.swap(keys.vecNodeKey);
+		vecEdgeKey.swap(keys.vecEdgeKey);
+	}
+
+	///	<summary>
+	///		Append a node.
+	///	</summary>
+	void push_back(
+		const OverlapNodeKey & keyNode,
+		const OverlapEdgeKey & keyEdge
+	) {
+		vecNodeKey.push_back(keyNode);
+		vecEdgeKey.push_back(keyEdge);
+	}
+
+	///	<summary>
+	///		Identifier of each node.
+	///	</summary>
+	std::vector<OverlapNodeKey> vecNodeKey;
+
+	///	<summary>
+	///		Edge following each node.
+	///	</summary>
+	std::vector<OverlapEdgeKey> vecEdgeKey;
+};
+
+///	<summary>
+///		Get the edge key of an edge of meshSource, which is unknown unless
+///		the edge is a great circle arc.
+///	</summary>
+inline OverlapEdgeKey GetSourceEdgeKey(
+	const Edge & edgeSource
+) {
+	if ((edgeSource.type != Edge::Type_GreatCircleArc) ||
+	    (edgeSource[0] == edgeSource[1])
+	) {
+		return OverlapEdgeKey();
+	}
+	return OverlapEdgeKey(edgeSource[0], edgeSource[1], true);
+}
+
+///	<summary>
+///		Get the identifier of the intersection of the polygon edge following
+///		node ix of keys with an edge of meshSource.  The intersection of two
+///		adjacent edges of meshSource is their shared node.
+///	</summary>
+inline OverlapNodeKey GetIntersectionNodeKey(
+	const OverlapPolygonKeys & keys,
+	int ix,
+	const OverlapEdgeKey & keyEdgeSource
+) {
+	OverlapNodeKey key;
+
+	const OverlapEdgeKey & keyEdge = keys.vecEdgeKey[ix];
+	if ((keyEdge.ixNode[0] == InvalidNode) ||
+	    (keyEdgeSource.ixNode[0] == InvalidNode)
+	) {
+		return key;
+	}
+
+	if (!keyEdge.fSourceEdge) {
+		key.ixTargetNode[0] = keyEdge.ixNode[0];
+		key.ixTargetNode[1] = keyEdge.ixNode[1];
+		key.ixSourceNode[0] = keyEdgeSource.ixNode[0];
+		key.ixSourceNode[1] = keyEdgeSource.ixNode[1];
+		return key;
+	}
+
+	// Find the node shared by both edges of meshSource
+	int nShared = 0;
+	for (int i = 0; i < 2; i++) {
+		if ((keyEdge.ixNode[i] == keyEdgeSource.ixNode[0]) ||
+		    (keyEdge.ixNode[i] == keyEdgeSource.ixNode[1])
+		) {
+			key.ixSourceNode[0] = keyEdge.ixNode[i];
+			nShared++;
+		}
+	}
+	if (nShared != 1) {
+		return OverlapNodeKey();
+	}
+
+	return key;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Compute the overlap polygon between two Faces, using nodevecInput,
+///		keysInput, vecNodeEdgeSides and vecIntersections as scratch storage.
+///		The combinatorial identifier of each node of the overlap polygon is
+///		stored in keysOutput.
+///	</summary>
+template <
+	class MeshUtilities,
+	class NodeIntersectType
+>
+static void GenerateOverlapFace(
+	const Mesh & meshSource,
+	const Mesh & meshTarget,
+	int iSourceFace,
+	int iTargetFace,
+    NodeVector & nodevecOutput,
+	NodeVector & nodevecInput,
+	OverlapPolygonKeys & keysOutput,
+	OverlapPolygonKeys & keysInput,
+	std::vector<int> & vecNodeEdgeSides,
+	std::vector<Node> & vecIntersections
+) {
+/*
+  // Sutherland–Hodgman algorithm (pseudocode)
+  List outputList = subjectPolygon;
+  for (Edge clipEdge in clipPolygon) do
+     List inputList = outputList;
+     outputList.clear();
+     Point S = inputList.last;
+     for (Point E in inputList) do
+        if (E inside clipEdge) then
+           if (S not inside clipEdge) then
+              outputList.add(ComputeIntersection(S,E,clipEdge));
+           end if
+           outputList.add(E);
+        else if (S inside clipEdge) then
+           outputList.add(ComputeIntersection(S,E,clipEdge));
+        end if
+        S = E;
+     done
+  done
+*/
+	MeshUtilities utils;
+
+	OVERLAPMESH_STAT_COUNT(Counter_PolygonClips);
+
+	// Use Sutherland–Hodgman algorithm to clip polygons
+	const NodeVector & nodesTarget = meshTarget.nodes;
+	const NodeVector & nodesSource = meshSource.nodes;
+
+	const Face & faceTarget = meshTarget.faces[iTargetFace];
+	const Face & faceSource = meshSource.faces[iSourceFace];
+
+	const EdgeVector & evecTarget = faceTarget.edges;
+	const EdgeVector & evecSource = faceSource.edges;
+
+	// List outputList = subjectPolygon
+	keysOutput.clear();
+	for (int i = 0; i < evecTarget.size(); i++) {
+		nodevecOutput.push_back(nodesTarget[evecTarget[i][0]]);
+
+		OverlapNodeKey key;
+		key.ixTargetNode[0] = evecTarget[i][0];
+		keysOutput.push_back(key,
+			OverlapEdgeKey(evecTarget[i][0], evecTarget[i][1], false));
+	}
+
+	// for (Edge clipEdge in clipPolygon) do
+	for (int i = 0; i < evecSource.size(); i++) {
+
+		// All points outside of source polygon
+		if (nodevecOutput.size() == 0) {
+			break;
+		}
+
+		// List inputList = outputList;
+		// outputList.clear();
+		nodevecInput.swap(nodevecOutput);
+		nodevecOutput.clear();
+
+		keysInput.swap(keysOutput);
+		keysOutput.clear();
+
+		const OverlapEdgeKey keyEdgeSource = GetSourceEdgeKey(evecSource[i]);
+
+		// Classify all points against clipEdge at once
+		utils.FindNodeEdgeSides(
+			nodesSource[evecSource[i][0]],
+			nodesSource[evecSource[i][1]],
+			evecSource[i].type,
+			nodevecInput,
+			vecNodeEdgeSides);
+
+		// Points entirely inside or entirely outside clipEdge produce no
+		// intersections
+		int nInside = 0;
+		for (int iNodeE = 0; iNodeE < nodevecInput.size(); iNodeE++) {
+			nInside += static_cast<int>(vecNodeEdgeSides[iNodeE] >= 0);
+		}
+		if (nInside == nodevecInput.size()) {
+			nodevecOutput.swap(nodevecInput);
+			keysOutput.swap(keysInput);
+			continue;
+		}
+		if (nInside == 0) {
+			break;
+		}
+
+		// Point S = inputList.last;
+		Node nodeS = nodevecInput[nodevecInput.size()-1];
+
+		int iNodeEdgeSideS = vecNodeEdgeSides[nodevecInput.size()-1];
+
+		int ixNodeS = nodevecInput.size()-1;
+
+		//printf("===================\n");
+		//printf("S Side: %i\n", iNodeEdgeSideS);
+
+		// for (Point E in inputList) do
+		for (int iNodeE = 0; iNodeE < nodevecInput.size(); iNodeE++) {
+			const Node & nodeE = nodevecInput[iNodeE];
+
+			// if (E inside clipEdge) then
+			int iNodeEdgeSideE = vecNodeEdgeSides[iNodeE];
+
+			//printf("E Side: %i\n", iNodeEdgeSideE);
+
+			if (iNodeEdgeSideE >= 0) {
+
+				// if (S not inside clipEdge) then
+				if (iNodeEdgeSideS < 0) {
+
+					// outputList.add(ComputeIntersection(S,E,clipEdge));
+					bool fCoincident =
+						utils.CalculateEdgeIntersectionsSemiClip(
+							nodeS,
+							nodeE,
+							Edge::Type_GreatCircleArc,
+							nodesSource[evecSource[i][0]],
+							nodesSource[evecSource[i][1]],
+							evecSource[i].type,
+							vecIntersections);
+
+/*
+					vecIntersections[0].Print("X");
+
+					if (vecIntersections.size() != 1) {
+						printf("%i %i\n", iNodeEdgeSideE, iNodeEdgeSideS);
+						std::cout << vecIntersections.size() << std::endl;
+
+						nodesSource[evecSource[i][0]].Print("S0");
+						nodesSource[evecSource[i][1]].Print("S1");
+						nodeS.Print("S");
+						nodeE.Print("E");
+						_EXCEPTIONT("Logic error");
+					}
+*/
+					if (vecIntersections.size() != 1) {
+						_EXCEPTIONT("Logic error");
+					}
+
+					//vecIntersections[0].Print("Add");
+					nodevecOutput.push_back(vecIntersections[0]);
+
+					// The intersection continues along the edge from S to E
+					keysOutput.push_back(
+						GetIntersectionNodeKey(keysInput, ixNodeS, keyEdgeSource),
+						keysInput.vecEdgeKey[ixNodeS]);
+				}
+
+				// outputList.add(E);
+				nodevecOutput.push_back(nodeE);
+				keysOutput.push_back(
+					keysInput.vecNodeKey[iNodeE],
+					keysInput.vecEdgeKey[iNodeE]);
+
+			// else if (S inside clipEdge) then
+			} else if (iNodeEdgeSideS >= 0) {
+
+				// outputList.add(ComputeIntersection(S,E,clipEdge));
+				bool fCoincident =
+					utils.CalculateEdgeIntersectionsSemiClip(
+						nodeS,
+						nodeE,
 						Edge::Type_GreatCircleArc,
 						nodesSource[evecSource[i][0]],
 						nodesSource[evecSource[i][1]],
@@ -1511,9 +1979,21 @@ void GenerateOverlapFace(
 */
 				if (fCoincident) {
 					//nodevecOutput.push_back(nodeE);
+
+					// The polygon edge following the last node no longer
+					// lies on a known edge
+					if (nodevecOutput.size() != 0) {
+						keysOutput.vecEdgeKey.back() = OverlapEdgeKey();
+					}
+
 				} else if (vecIntersections.size() == 1) {
 					nodevecOutput.push_back(vecIntersections[0]);
 
+					// The intersection continues along clipEdge
+					keysOutput.push_back(
+						GetIntersectionNodeKey(keysInput, ixNodeS, keyEdgeSource),
+						keyEdgeSource);
+
 				} else {
 					_EXCEPTIONT("Logic error");
 				}
@@ -1524,6 +2004,7 @@ void GenerateOverlapFace(
 			// S = E;
 			nodeS = nodeE;
 			iNodeEdgeSideS = iNodeEdgeSideE;
+			ixNodeS = iNodeE;
 		}
 /*
 		std::cout << nodevecOutput.size() << std::endl;
@@ -1548,24 +2029,191 @@ void GenerateOverlapFace(
 	// If the overlap consists of fewer than three nodes, ignore
 	if (nodevecOutput.size() < 3) {
 		nodevecOutput.clear();
+		keysOutput.clear();
 	}
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
-///	<summary>
-///		Find the Face in meshTarget containing node, searching near
-///		meshTarget Face with index ixTargetFaceSeed.
-///	</summary>
 template <
 	class MeshUtilities,
 	class NodeIntersectType
 >
-int FindFaceContainingNode(
+void GenerateOverlapFace(
 	const Mesh & meshSource,
 	const Mesh & meshTarget,
-	int ixSourceFaceSeed,
-	int ixTargetFaceSeed
+	int iSourceFace,
+	int iTargetFace,
+    NodeVector & nodevecOutput
+) {
+	NodeVector nodevecInput;
+	OverlapPolygonKeys keysOutput;
+	OverlapPolygonKeys keysInput;
+	std::vector<int> vecNodeEdgeSides;
+	std::vector<Node> vecIntersections;
+
+	GenerateOverlapFace<MeshUtilities, NodeIntersectType>(
+		meshSource,
+		meshTarget,
+		iSourceFace,
+		iTargetFace,
+		nodevecOutput,
+		nodevecInput,
+		keysOutput,
+		keysInput,
+		vecNodeEdgeSides,
+		vecIntersections);
+}
+
+template void GenerateOverlapFace<MeshUtilitiesFuzzy, Node>(
+	const Mesh & meshSource,
+	const Mesh & meshTarget,
+	int iSourceFace,
+	int iTargetFace,
+    NodeVector & nodevecOutput
+);
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Scratch storage for generating the overlap mesh associated with a
+///		source face.  One instance is reused for consecutive source faces on
+///		a thread, so containers keep their capacity and per-face temporaries
+///		are not reallocated.
+///	</summary>
+class OverlapFaceWorkspace {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	OverlapFaceWorkspace() :
+		m_iSearchStamp(0),
+		m_ixQueueFront(0)
+	{ }
+
+	///	<summary>
+	///		Begin a new breadth-first search over the Faces of a Mesh with
+	///		the given number of Faces.  All Faces become unexamined.
+	///	</summary>
+	void BeginSearch(
+		int nFaces
+	) {
+		if (static_cast<int>(m_vecSearchStamp.size()) != nFaces) {
+			m_vecSearchStamp.assign(nFaces, 0);
+			m_iSearchStamp = 0;
+		}
+		if (m_iSearchStamp == std::numeric_limits<int>::max()) {
+			std::fill(m_vecSearchStamp.begin(), m_vecSearchStamp.end(), 0);
+			m_iSearchStamp = 0;
+		}
+		m_iSearchStamp++;
+
+		m_vecQueue.clear();
+		m_ixQueueFront = 0;
+	}
+
+	///	<summary>
+	///		Add a Face to the back of the queue if it has not been examined
+	///		by the current search, and mark it as examined.
+	///	</summary>
+	void Push(
+		int ixFace
+	) {
+		if (m_vecSearchStamp[ixFace] != m_iSearchStamp) {
+			m_vecSearchStamp[ixFace] = m_iSearchStamp;
+			m_vecQueue.push_back(ixFace);
+		}
+	}
+
+	///	<summary>
+	///		Check if the queue is empty.
+	///	</summary>
+	bool Empty() const {
+		return (m_ixQueueFront == m_vecQueue.size());
+	}
+
+	///	<summary>
+	///		Remove and return the Face at the front of the queue.
+	///	</summary>
+	int Pop() {
+		return m_vecQueue[m_ixQueueFront++];
+	}
+
+public:
+	///	<summary>
+	///		Overlap polygon between a source and target Face.
+	///	</summary>
+	NodeVector nodevecOutput;
+
+	///	<summary>
+	///		Scratch polygon used while clipping.
+	///	</summary>
+	NodeVector nodevecInput;
+
+	///	<summary>
+	///		Combinatorial identifiers of the nodes of the overlap polygon.
+	///	</summary>
+	OverlapPolygonKeys keysOutput;
+
+	///	<summary>
+	///		Scratch identifiers used while clipping.
+	///	</summary>
+	OverlapPolygonKeys keysInput;
+
+	///	<summary>
+	///		Scratch side of each polygon node used while clipping.
+	///	</summary>
+	std::vector<int> vecNodeEdgeSides;
+
+	///	<summary>
+	///		Scratch intersections used while clipping.
+	///	</summary>
+	std::vector<Node> vecIntersections;
+
+	///	<summary>
+	///		Face used to compute the area of an overlap polygon.
+	///	</summary>
+	Face faceTemp;
+
+private:
+	///	<summary>
+	///		Search in which each Face was last examined.
+	///	</summary>
+	std::vector<int> m_vecSearchStamp;
+
+	///	<summary>
+	///		Index of the current search.
+	///	</summary>
+	int m_iSearchStamp;
+
+	///	<summary>
+	///		Faces queued by the current search, in order of insertion.
+	///	</summary>
+	std::vector<int> m_vecQueue;
+
+	///	<summary>
+	///		Index of the front of the queue in m_vecQueue.
+	///	</summary>
+	size_t m_ixQueueFront;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Find the Face in meshTarget containing node, searching near
+///		meshTarget Face with index ixTargetFaceSeed.
+///	</summary>
+template <
+	class MeshUtilities,
+	class NodeIntersectType
+>
+int FindFaceContainingNode(
+	const Mesh & meshSource,
+	const Mesh & meshTarget,
+	int ixSourceFaceSeed,
+	int ixTargetFaceSeed,
+	OverlapFaceWorkspace & workspace
 ) {
 	if (ixSourceFaceSeed > meshSource.faces.size()) {
 		_EXCEPTIONT("SourceFaceSeed greater than Source mesh size");
@@ -1591,26 +2239,22 @@ int FindFaceContainingNode(
 	Face::NodeLocation loc;
 	int ixLocation;
 
-	std::set<int> setExaminedTargetFaces;
-	std::queue<int> queueTargetFaces;
+	OVERLAPMESH_STAT_WALK(walkSeed, Histogram_SeedSearchWalkLength);
 
-	queueTargetFaces.push(ixTargetFaceSeed);
-	setExaminedTargetFaces.insert(ixTargetFaceSeed);
+	workspace.BeginSearch(meshTarget.faces.size());
+	workspace.Push(ixTargetFaceSeed);
 
 	int ixIterate = 0;
-	while (!queueTargetFaces.empty()) {
+	while (!workspace.Empty()) {
 
 		if ((OverlapFaceSearchMaximumFaces != (-1)) && (ixIterate > OverlapFaceSearchMaximumFaces)) {
 			Announce("Abandoning search after %i iterations", OverlapFaceSearchMaximumFaces);
 			return InvalidFace;
 		}
 
-		int ixCurrentTargetFace = queueTargetFaces.front();
-		queueTargetFaces.pop();
+		int ixCurrentTargetFace = workspace.Pop();
 
-		if (ixCurrentTargetFace == InvalidFace) {
-			continue;
-		}
+		OVERLAPMESH_STAT_STEP(walkSeed);
 
 		const Face & faceTarget = meshTarget.faces[ixCurrentTargetFace];
 
@@ -1628,14 +2272,20 @@ int FindFaceContainingNode(
 
 		// Node on boundary of target face; check for overlap
 		if (loc != Face::NodeLocation_Exterior) {
-			NodeVector nodevecOverlap;
+			NodeVector & nodevecOverlap = workspace.nodevecOutput;
+			nodevecOverlap.clear();
 
 			GenerateOverlapFace<MeshUtilities, Node>(
 				meshSource,
 				meshTarget,
 				ixSourceFaceSeed,
 				ixCurrentTargetFace,
-				nodevecOverlap
+				nodevecOverlap,
+				workspace.nodevecInput,
+				workspace.keysOutput,
+				workspace.keysInput,
+				workspace.vecNodeEdgeSides,
+				workspace.vecIntersections
 			);
 
 			if (nodevecOverlap.size() > 2) {
@@ -1665,12 +2315,8 @@ int FindFaceContainingNode(
 				_EXCEPTIONT("EdgeMap error");
 			}
 
-			std::set<int>::const_iterator iterFace =
-				setExaminedTargetFaces.find(iPushFace);
-
-			if (iterFace == setExaminedTargetFaces.end()) {
-				queueTargetFaces.push(iPushFace);
-				setExaminedTargetFaces.insert(iPushFace);
+			if (iPushFace != InvalidFace) {
+				workspace.Push(iPushFace);
 			}
 		}
 
@@ -1689,10 +2335,13 @@ void GenerateOverlapMeshFromFace(
 	int ixSourceFace,
 	Mesh & meshOverlap,
 	NodeMap & nodemapOverlap,
+	OverlapNodeKeyMap & keymapOverlap,
 	OverlapMeshMethod method,
     int ixTargetFaceSeed,
+	OverlapFaceWorkspace & workspace,
 	bool fAllowNoOverlap,
-    const bool fVerbose = true
+    const bool fVerbose = true,
+	const std::vector<char> * pvecTargetFaceConvex = NULL
 ) {
 	// Verify the EdgeMap exists in both meshSource and meshTarget
 	if (meshSource.edgemap.size() == 0) {
@@ -1704,9 +2353,6 @@ void GenerateOverlapMeshFromFace(
 			" to GenerateOverlapFace");
 	}
 
-	// Set of Faces on the Target Mesh that overlap ixSourceFace
-	std::set<int> setExaminedTargetFaces;
-
 	// Get the two NodeVectors
 	const NodeVector & nodevecSource = meshSource.nodes;
 	const NodeVector & nodevecTarget = meshTarget.nodes;
@@ -1733,7 +2379,8 @@ void GenerateOverlapMeshFromFace(
 			meshSource,
 			meshTarget,
 			ixSourceFace,
-			ixTargetFaceSeed);
+			ixTargetFaceSeed,
+			workspace);
 
 	if (ixCurrentTargetFace == InvalidFace) {
 		if (fAllowNoOverlap) {
@@ -1749,6 +2396,46 @@ void GenerateOverlapMeshFromFace(
     if (fVerbose) {
 		Announce("First overlap match %i", ixCurrentTargetFace);
 	}
+
+	// If the first overlapping target face is convex and contains every
+	// node of the source face, the source face lies entirely within it and
+	// no other target face overlaps the source face, so the search can stop
+	// without clipping the source face against the neighbors of the target
+	// face.  This is typical when meshSource is much finer than meshTarget.
+	bool fSourceFaceInsideTarget = false;
+	if ((pvecTargetFaceConvex != NULL) &&
+	    ((*pvecTargetFaceConvex)[ixCurrentTargetFace] != 0)
+	) {
+		const Face & faceSource = meshSource.faces[ixSourceFace];
+		const Face & faceTarget = meshTarget.faces[ixCurrentTargetFace];
+
+		fSourceFaceInsideTarget = true;
+		for (int i = 0; i < faceSource.edges.size(); i++) {
+			if (faceSource.edges[i].type != Edge::Type_GreatCircleArc) {
+				fSourceFaceInsideTarget = false;
+				break;
+			}
+
+			Face::NodeLocation loc;
+			int ixLocation;
+
+			utils.ContainsNode(
+				faceTarget,
+				nodevecTarget,
+				nodevecSource[faceSource[i]],
+				loc,
+				ixLocation);
+
+			if (loc != Face::NodeLocation_Interior) {
+				fSourceFaceInsideTarget = false;
+				break;
+			}
+		}
+
+		if (fSourceFaceInsideTarget) {
+			OVERLAPMESH_STAT_COUNT(Counter_SourceFacesInsideTarget);
+		}
+	}
 /*
 	// Verify starting Node is not on the Exterior
 	if (aFindFaceStruct.loc == Face::NodeLocation_Exterior) {
@@ -1758,11 +2445,15 @@ void GenerateOverlapMeshFromFace(
 	// Current target Face
 	int ixCurrentTargetFace = aFindFaceStruct.vecFaceIndices[0];
 */
-	std::queue<int> queueTargetFaces;
-	queueTargetFaces.push(ixCurrentTargetFace);
-	setExaminedTargetFaces.insert(ixCurrentTargetFace);
+	// Breadth-first search over Faces on the Target Mesh that overlap
+	// ixSourceFace
+	OVERLAPMESH_STAT_WALK(walkTested, Histogram_TargetFacesTestedPerSourceFace);
+	OVERLAPMESH_STAT_WALK(walkOverlap, Histogram_OverlapFacesPerSourceFace);
+
+	workspace.BeginSearch(meshTarget.faces.size());
+	workspace.Push(ixCurrentTargetFace);
 
-	while (!queueTargetFaces.empty()) {
+	while (!workspace.Empty()) {
 /*
 	meshSource.nodes[meshSource.faces[ixSourceFace][0]].Print("S");
 	meshTarget.nodes[meshTarget.faces[ixCurrentTargetFace][0]].Print("T");
@@ -1776,115 +2467,1350 @@ void GenerateOverlapMeshFromFace(
 	}
 */
 		// Get the next target face
-		ixCurrentTargetFace = queueTargetFaces.front();
-		queueTargetFaces.pop();
+		ixCurrentTargetFace = workspace.Pop();
+
+		OVERLAPMESH_STAT_STEP(walkTested);
 
-		if (ixCurrentTargetFace == InvalidFace) {
-			_EXCEPTIONT("Logic error");
-		}
 		const Face & faceTarget = meshTarget.faces[ixCurrentTargetFace];
 
 		// Find the overlap polygon
-		NodeVector nodevecOutput;
+		NodeVector & nodevecOutput = workspace.nodevecOutput;
+		nodevecOutput.clear();
 
 		GenerateOverlapFace<MeshUtilitiesFuzzy, Node>(
 			meshSource,
 			meshTarget,
 			ixSourceFace,
 			ixCurrentTargetFace,
-			nodevecOutput
+			nodevecOutput,
+			workspace.nodevecInput,
+			workspace.keysOutput,
+			workspace.keysInput,
+			workspace.vecNodeEdgeSides,
+			workspace.vecIntersections
 		);
 
-		if (nodevecOutput.size() == 0) {
+		if (nodevecOutput.size() == 0) {
+
+		} else if (nodevecOutput.size() < 3) {
+			_EXCEPTIONT("Overlap polygon consists of fewer than 3 nodes");
+
+		} else {
+
+			// Add all neighboring Faces into the queue of Target Faces
+			if (!fSourceFaceInsideTarget) {
+				for (int i = 0; i < faceTarget.edges.size(); i++) {
+					EdgeMapConstIterator iter =
+						edgemapTarget.find(faceTarget.edges[i]);
+
+					if (iter == edgemapTarget.end()) {
+						_EXCEPTIONT("Missing Edge in Target EdgeMap");
+					}
+
+					const FacePair & facepair = iter->second;
+
+					int iPushFace;
+					if (facepair[0] == ixCurrentTargetFace) {
+						iPushFace = facepair[1];
+
+					} else if (facepair[1] == ixCurrentTargetFace) {
+						iPushFace = facepair[0];
+
+					} else {
+						_EXCEPTIONT("EdgeMap error");
+					}
+
+					if (iPushFace == InvalidFace) {
+						continue;
+					}
+
+					workspace.Push(iPushFace);
+				}
+			}
+
+            if (fVerbose) {
+				Announce("Overlap with Face %i", ixCurrentTargetFace);
+			}
+
+			// Calculate face area
+			Face & faceTemp = workspace.faceTemp;
+			faceTemp.edges.resize(nodevecOutput.size());
+			for (int i = 0; i < nodevecOutput.size(); i++) {
+				faceTemp.SetNode(i, i);
+			}
+			Real dArea = CalculateFaceArea(faceTemp, nodevecOutput);
+
+			if (dArea < 1.0e-13) {
+				continue;
+/*
+				printf("%i %i %1.15e %i\n", ixSourceFace, ixCurrentTargetFace, dArea, nodevecOutput.size());
+				for (int i = 0; i < nodevecOutput.size(); i++) {
+					nodevecOutput[i].Print("");
+				}
+				//_EXCEPTION();
+*/
+			}
+
+			// Insert Face into meshOverlap
+			Face faceNew(nodevecOutput.size());
+			for (int i = 0; i < nodevecOutput.size(); i++) {
+#if defined(OVERLAPMESH_RETAIN_REPEATED_NODES)
+				faceNew.SetNode(i, meshOverlap.nodes.size());
+				meshOverlap.nodes.push_back(nodevecOutput[i]);
+#else
+				// Nodes with a combinatorial identifier are only located by
+				// their coordinates the first time they are found, which
+				// merges them with coincident nodes of other types
+				const OverlapNodeKey & key = workspace.keysOutput.vecNodeKey[i];
+
+				OverlapNodeKeyMap::iterator iterKey = keymapOverlap.end();
+				if (key.IsValid()) {
+					iterKey = keymapOverlap.find(key);
+					if (iterKey != keymapOverlap.end()) {
+						OVERLAPMESH_STAT_COUNT(Counter_NodeKeyLookups);
+						faceNew.SetNode(i, iterKey->second);
+						continue;
+					}
+				}
+
+				OVERLAPMESH_STAT_COUNT(Counter_NodeCoordinateLookups);
+
+				int ixNode;
+				NodeMapConstIterator iter
+					= nodemapOverlap.find(nodevecOutput[i]);
+
+				if (iter != nodemapOverlap.end()) {
+					ixNode = iter->second;
+				} else {
+					ixNode = nodemapOverlap.size();
+					nodemapOverlap.insert(
+						NodeMapPair(nodevecOutput[i], ixNode));
+				}
+				faceNew.SetNode(i, ixNode);
+
+				if (key.IsValid()) {
+					keymapOverlap.insert(
+						OverlapNodeKeyMap::value_type(key, ixNode));
+				}
+#endif
+			}
+			meshOverlap.faces.push_back(faceNew);
+
+			meshOverlap.vecSourceFaceIx.push_back(ixSourceFace);
+			meshOverlap.vecTargetFaceIx.push_back(ixCurrentTargetFace);
+
+			OVERLAPMESH_STAT_STEP(walkOverlap);
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Regenerates the overlap Faces of individual source Faces with exact
+///		arithmetic, using the algorithm of GenerateOverlapMesh_v1(), when
+///		the fuzzy algorithm of GenerateOverlapMesh_v2() fails.  The
+///		coincident node map and candidate search structures are only built
+///		on the first failure, so there is no cost if all source Faces
+///		succeed.  Source Faces may be regenerated concurrently.
+///	</summary>
+class OverlapMeshExactRetry {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	OverlapMeshExactRetry(
+		const Mesh & meshSource,
+		const Mesh & meshTarget
+	) :
+		m_meshSource(meshSource),
+		m_pmeshTarget(&meshTarget)
+	{ }
+
+public:
+	///	<summary>
+	///		Generate the overlap Faces of source Face ixSourceFace with exact
+	///		arithmetic and append them to meshOverlap, merging their Nodes
+	///		through nodemapOverlap.
+	///	</summary>
+	void GenerateOverlapMeshFromFace(
+		int ixSourceFace,
+		Mesh & meshOverlap,
+		NodeMap & nodemapOverlap
+	) {
+		std::call_once(m_flagInitialize,
+			&OverlapMeshExactRetry::Initialize, this);
+
+		std::vector<int> vecTargetFaceCandidates;
+		m_bvhTarget.FindCandidateFaces(
+			m_meshSource.nodes[m_meshSource.faces[ixSourceFace][0]],
+			vecTargetFaceCandidates);
+
+		// The algorithm of GenerateOverlapMesh_v1() refers to the Nodes of
+		// both meshes by their index in the overlap mesh
+		Mesh meshFace;
+		meshFace.nodes = m_nodesOverlap;
+
+		PathSegmentVector vecTracedPath;
+
+		GenerateOverlapMeshFromFace_v1(
+			m_meshSource,
+			*m_pmeshTarget,
+			m_vecTargetNodeMap,
+			ixSourceFace,
+			vecTargetFaceCandidates,
+			OverlapMeshMethod_Exact,
+			vecTracedPath,
+			meshFace);
+
+		for (int f = 0; f < meshFace.faces.size(); f++) {
+			const Face & faceRetry = meshFace.faces[f];
+
+			Face faceNew(faceRetry.edges.size());
+			for (int i = 0; i < faceRetry.edges.size(); i++) {
+				const Node & node = meshFace.nodes[faceRetry[i]];
+#if defined(OVERLAPMESH_RETAIN_REPEATED_NODES)
+				faceNew.SetNode(i, meshOverlap.nodes.size());
+				meshOverlap.nodes.push_back(node);
+#else
+				int ixNode;
+				NodeMapConstIterator iter = nodemapOverlap.find(node);
+
+				if (iter != nodemapOverlap.end()) {
+					ixNode = iter->second;
+				} else {
+					ixNode = nodemapOverlap.size();
+					nodemapOverlap.insert(NodeMapPair(node, ixNode));
+				}
+				faceNew.SetNode(i, ixNode);
+#endif
+			}
+			meshOverlap.faces.push_back(faceNew);
+
+			meshOverlap.vecSourceFaceIx.push_back(ixSourceFace);
+			meshOverlap.vecTargetFaceIx.push_back(meshFace.vecTargetFaceIx[f]);
+		}
+	}
+
+protected:
+	///	<summary>
+	///		Build the coincident node map, overlap mesh Nodes and candidate
+	///		search hierarchy used by GenerateOverlapMesh_v1(), which also
+	///		requires the reverse node array of the target mesh.
+	///	</summary>
+	void Initialize() {
+		if (m_pmeshTarget->revnodearray.size() == 0) {
+			m_meshTargetCopy = *m_pmeshTarget;
+			m_meshTargetCopy.ConstructReverseNodeArray();
+			m_pmeshTarget = &m_meshTargetCopy;
+		}
+
+		const Mesh & meshTarget = *m_pmeshTarget;
+
+		BuildCoincidentNodeVector(
+			m_meshSource, meshTarget, m_vecTargetNodeMap);
+
+		m_nodesOverlap = m_meshSource.nodes;
+		for (int i = 0; i < meshTarget.nodes.size(); i++) {
+			if (m_vecTargetNodeMap[i] == InvalidNode) {
+				m_vecTargetNodeMap[i] = m_nodesOverlap.size();
+				m_nodesOverlap.push_back(meshTarget.nodes[i]);
+			}
+		}
+
+		m_bvhTarget.Build(meshTarget);
+	}
+
+protected:
+	///	<summary>
+	///		Source mesh.
+	///	</summary>
+	const Mesh & m_meshSource;
+
+	///	<summary>
+	///		Target mesh, with a reverse node array.
+	///	</summary>
+	const Mesh * m_pmeshTarget;
+
+	///	<summary>
+	///		Copy of the target mesh, if it has no reverse node array.
+	///	</summary>
+	Mesh m_meshTargetCopy;
+
+	///	<summary>
+	///		Flag indicating that Initialize() has been called.
+	///	</summary>
+	std::once_flag m_flagInitialize;
+
+	///	<summary>
+	///		Index of each target Node among the overlap mesh Nodes.
+	///	</summary>
+	std::vector<int> m_vecTargetNodeMap;
+
+	///	<summary>
+	///		Nodes of the source mesh followed by Nodes of the target mesh
+	///		that are not coincident with source Nodes.
+	///	</summary>
+	NodeVector m_nodesOverlap;
+
+	///	<summary>
+	///		Bounding volume hierarchy over the target mesh.
+	///	</summary>
+	FaceBVH m_bvhTarget;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Generate the overlap mesh associated with a contiguous range of
+///		entries in the list of source faces vecSourceFaceIx.  The search for
+///		overlapping target faces starts from the corresponding entry of
+///		vecTargetFaceSeed.
+///	</summary>
+static void GenerateOverlapMeshFromFaceRange(
+	const Mesh & meshSource,
+	const Mesh & meshTarget,
+	const std::vector<int> & vecSourceFaceIx,
+	const std::vector<int> & vecTargetFaceSeed,
+	int ixBegin,
+	int ixEnd,
+	Mesh & meshOverlap,
+	NodeMap & nodemapOverlap,
+	OverlapNodeKeyMap & keymapOverlap,
+	OverlapFaceWorkspace & workspace,
+	OverlapMeshMethod method,
+	const bool fAllowNoOverlap,
+	const bool fVerbose,
+	const bool fAnnounceProgress,
+	const std::vector<char> & vecTargetFaceConvex,
+	OverlapMeshExactRetry * pretry,
+	int & nRetriedFaces
+) {
+	for (int ix = ixBegin; ix < ixEnd; ix++) {
+		const int i = vecSourceFaceIx[ix];
+
+		if (fVerbose) {
+			std::string strAnnounce = "Source Face " + std::to_string((long long)i);
+			AnnounceStartBlock(strAnnounce.c_str());
+		}
+		if (fAnnounceProgress && !fVerbose && ((ix % 1000) == 0)) {
+			std::string strAnnounce = "Source Face " + std::to_string((long long)ix);
+			Announce(strAnnounce.c_str());
+		}
+
+		// Target face near this source face
+		int iTargetFaceSeed = vecTargetFaceSeed[ix];
+
+		if (fVerbose) {
+			Announce("Nearest target face %i", iTargetFaceSeed);
+		}
+
+		const int nPrevOverlapFaces = meshOverlap.faces.size();
+		const int nPrevOverlapNodes = meshOverlap.nodes.size();
+
+		// Generate the overlap mesh associated with this source face
+		try {
+			GenerateOverlapMeshFromFace(
+				meshSource,
+				meshTarget,
+				i,
+				meshOverlap,
+				nodemapOverlap,
+				keymapOverlap,
+				method,
+				iTargetFaceSeed,
+				workspace,
+				fAllowNoOverlap,
+				fVerbose,
+				&vecTargetFaceConvex);
+
+		} catch(Exception & e) {
+			if (pretry == NULL) {
+				throw;
+			}
+			if (fVerbose) {
+				Announce("WARNING: Fuzzy arithmetic operations failed "
+					"with message:\n  \"%s\"\n  Trying exact arithmetic",
+					e.ToString().c_str());
+			}
+
+			// Discard partial output of this source face.  Nodes already
+			// inserted into nodemapOverlap are left unreferenced.
+			meshOverlap.nodes.resize(nPrevOverlapNodes);
+			meshOverlap.faces.resize(nPrevOverlapFaces);
+			meshOverlap.vecSourceFaceIx.resize(nPrevOverlapFaces);
+			meshOverlap.vecTargetFaceIx.resize(nPrevOverlapFaces);
+
+			pretry->GenerateOverlapMeshFromFace(
+				i, meshOverlap, nodemapOverlap);
+
+			nRetriedFaces++;
+		}
+
+		if (fVerbose) {
+			AnnounceEndBlock(NULL);
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+#if !defined(OVERLAPMESH_RETAIN_REPEATED_NODES)
+///	<summary>
+///		Insert all Nodes from a NodeMap into the node vector of a Mesh.
+///	</summary>
+static void CopyNodeMapToMesh(
+	const NodeMap & nodemap,
+	Mesh & mesh
+) {
+	mesh.nodes.resize(nodemap.size());
+
+	NodeMapConstIterator iter = nodemap.begin();
+	for (; iter != nodemap.end(); iter++) {
+		mesh.nodes[iter->second] = iter->first;
+	}
+}
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+#if defined(_OPENMP) && defined(OVERLAPMESH_USE_NODE_HASHMAP)
+///	<summary>
+///		Append the faces of an overlap mesh generated for a block of source
+///		faces to the global overlap mesh, with nodes given by the
+///		provisional indices of a ConcurrentNodeMap.
+///	</summary>
+static void AppendOverlapMeshBlock(
+	const Mesh & meshBlock,
+	const std::vector<int> & vecBlockNodeIx,
+	Mesh & meshOverlap
+) {
+	for (int f = 0; f < meshBlock.faces.size(); f++) {
+		const Face & faceBlock = meshBlock.faces[f];
+
+		Face faceNew(faceBlock.edges.size());
+		for (int i = 0; i < faceBlock.edges.size(); i++) {
+			faceNew.SetNode(i, vecBlockNodeIx[faceBlock[i]]);
+		}
+		meshOverlap.faces.push_back(faceNew);
+	}
+
+	meshOverlap.vecSourceFaceIx.insert(
+		meshOverlap.vecSourceFaceIx.end(),
+		meshBlock.vecSourceFaceIx.begin(),
+		meshBlock.vecSourceFaceIx.end());
+
+	meshOverlap.vecTargetFaceIx.insert(
+		meshOverlap.vecTargetFaceIx.end(),
+		meshBlock.vecTargetFaceIx.begin(),
+		meshBlock.vecTargetFaceIx.end());
+}
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Append an overlap mesh generated for a block of source faces, or
+///		read from a checkpoint, to the global overlap mesh, merging
+///		coincident nodes.  Nodes of the block
+///		are visited in order of first appearance so that the global node
+///		numbering follows the order of the source faces.
+///	</summary>
+static void MergeOverlapMeshBlock(
+	const Mesh & meshBlock,
+	Mesh & meshOverlap,
+	NodeMap & nodemapOverlap
+) {
+	std::vector<int> vecNodeIx(meshBlock.nodes.size());
+
+#if defined(OVERLAPMESH_RETAIN_REPEATED_NODES)
+	const int ixNodeOffset = meshOverlap.nodes.size();
+	meshOverlap.nodes.insert(
+		meshOverlap.nodes.end(),
+		meshBlock.nodes.begin(),
+		meshBlock.nodes.end());
+
+	for (int i = 0; i < vecNodeIx.size(); i++) {
+		vecNodeIx[i] = ixNodeOffset + i;
+	}
+#else
+	for (int i = 0; i < vecNodeIx.size(); i++) {
+		NodeMapConstIterator iter = nodemapOverlap.find(meshBlock.nodes[i]);
+
+		if (iter != nodemapOverlap.end()) {
+			vecNodeIx[i] = iter->second;
+		} else {
+			int iNextNodeMapOverlapIx = nodemapOverlap.size();
+			vecNodeIx[i] = iNextNodeMapOverlapIx;
+			nodemapOverlap.insert(
+				NodeMapPair(meshBlock.nodes[i], iNextNodeMapOverlapIx));
+		}
+	}
+#endif
+
+	for (int f = 0; f < meshBlock.faces.size(); f++) {
+		const Face & faceBlock = meshBlock.faces[f];
+
+		Face faceNew(faceBlock.edges.size());
+		for (int i = 0; i < faceBlock.edges.size(); i++) {
+			faceNew.SetNode(i, vecNodeIx[faceBlock[i]]);
+		}
+		meshOverlap.faces.push_back(faceNew);
+	}
+
+	meshOverlap.vecSourceFaceIx.insert(
+		meshOverlap.vecSourceFaceIx.end(),
+		meshBlock.vecSourceFaceIx.begin(),
+		meshBlock.vecSourceFaceIx.end());
+
+	meshOverlap.vecTargetFaceIx.insert(
+		meshOverlap.vecTargetFaceIx.end(),
+		meshBlock.vecTargetFaceIx.begin(),
+		meshBlock.vecTargetFaceIx.end());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+#if defined(TEMPEST_MPIOMP)
+///	<summary>
+///		Partition the faces of meshSource into nMPISize spatially compact
+///		pieces and return the indices of the faces in piece nMPIRank, in
+///		increasing order.  Faces are ordered along a space-filling curve
+///		which is then cut into pieces with equal numbers of faces.
+///	</summary>
+static void PartitionSourceFaces(
+	const Mesh & meshSource,
+	int nMPIRank,
+	int nMPISize,
+	std::vector<int> & vecSourceFaceIx
+) {
+	const int nSourceFaces = meshSource.faces.size();
+
+	std::vector<int> vecFaceOrder;
+	meshSource.GetSpaceFillingCurveOrder(vecFaceOrder);
+
+	const int ixBegin = static_cast<int>(
+		static_cast<long long>(nSourceFaces) * nMPIRank / nMPISize);
+	const int ixEnd = static_cast<int>(
+		static_cast<long long>(nSourceFaces) * (nMPIRank + 1) / nMPISize);
+
+	vecSourceFaceIx.assign(
+		vecFaceOrder.begin() + ixBegin,
+		vecFaceOrder.begin() + ixEnd);
+
+	std::sort(vecSourceFaceIx.begin(), vecSourceFaceIx.end());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Gather the pieces of the overlap mesh generated on each rank onto
+///		rank 0, merging coincident nodes along partition boundaries.  Each
+///		piece is ordered by source face and the pieces are interleaved so
+///		that the result is identical to the overlap mesh generated by a
+///		single process.  The overlap mesh is left empty on all other ranks.
+///	</summary>
+static void GatherOverlapMesh(
+	Mesh & meshOverlap,
+	int nMPIRank,
+	int nMPISize
+) {
+	enum {
+		TagSizes = 100,
+		TagNodes,
+		TagFaceSizes,
+		TagFaceNodes,
+		TagSourceFaceIx,
+		TagTargetFaceIx
+	};
+
+	// Send this piece to rank 0
+	if (nMPIRank != 0) {
+		const int nNodes = meshOverlap.nodes.size();
+		const int nFaces = meshOverlap.faces.size();
+
+		std::vector<double> vecNodes(3 * nNodes);
+		for (int i = 0; i < nNodes; i++) {
+			vecNodes[3*i  ] = meshOverlap.nodes[i].x;
+			vecNodes[3*i+1] = meshOverlap.nodes[i].y;
+			vecNodes[3*i+2] = meshOverlap.nodes[i].z;
+		}
+
+		std::vector<int> vecFaceSizes(nFaces);
+		std::vector<int> vecFaceNodes;
+		for (int f = 0; f < nFaces; f++) {
+			const Face & face = meshOverlap.faces[f];
+			vecFaceSizes[f] = face.edges.size();
+			for (int i = 0; i < face.edges.size(); i++) {
+				vecFaceNodes.push_back(face[i]);
+			}
+		}
+
+		int nSizes[3];
+		nSizes[0] = nNodes;
+		nSizes[1] = nFaces;
+		nSizes[2] = vecFaceNodes.size();
+
+		MPI_Send(nSizes, 3, MPI_INT, 0, TagSizes, MPI_COMM_WORLD);
+		MPI_Send(vecNodes.data(), 3 * nNodes, MPI_DOUBLE,
+			0, TagNodes, MPI_COMM_WORLD);
+		MPI_Send(vecFaceSizes.data(), nFaces, MPI_INT,
+			0, TagFaceSizes, MPI_COMM_WORLD);
+		MPI_Send(vecFaceNodes.data(), nSizes[2], MPI_INT,
+			0, TagFaceNodes, MPI_COMM_WORLD);
+		MPI_Send(meshOverlap.vecSourceFaceIx.data(), nFaces, MPI_INT,
+			0, TagSourceFaceIx, MPI_COMM_WORLD);
+		MPI_Send(meshOverlap.vecTargetFaceIx.data(), nFaces, MPI_INT,
+			0, TagTargetFaceIx, MPI_COMM_WORLD);
+
+		meshOverlap.nodes.clear();
+		meshOverlap.faces.clear();
+		meshOverlap.vecSourceFaceIx.clear();
+		meshOverlap.vecTargetFaceIx.clear();
+		return;
+	}
+
+	// Receive all pieces on rank 0
+	std::vector<Mesh> vecPieces(nMPISize);
+
+	vecPieces[0].nodes.swap(meshOverlap.nodes);
+	vecPieces[0].faces.swap(meshOverlap.faces);
+	vecPieces[0].vecSourceFaceIx.swap(meshOverlap.vecSourceFaceIx);
+	vecPieces[0].vecTargetFaceIx.swap(meshOverlap.vecTargetFaceIx);
+
+	for (int r = 1; r < nMPISize; r++) {
+		Mesh & meshPiece = vecPieces[r];
+
+		MPI_Status status;
+
+		int nSizes[3];
+		MPI_Recv(nSizes, 3, MPI_INT, r, TagSizes, MPI_COMM_WORLD, &status);
+
+		const int nNodes = nSizes[0];
+		const int nFaces = nSizes[1];
+
+		std::vector<double> vecNodes(3 * nNodes);
+		std::vector<int> vecFaceSizes(nFaces);
+		std::vector<int> vecFaceNodes(nSizes[2]);
+
+		MPI_Recv(vecNodes.data(), 3 * nNodes, MPI_DOUBLE,
+			r, TagNodes, MPI_COMM_WORLD, &status);
+		MPI_Recv(vecFaceSizes.data(), nFaces, MPI_INT,
+			r, TagFaceSizes, MPI_COMM_WORLD, &status);
+		MPI_Recv(vecFaceNodes.data(), nSizes[2], MPI_INT,
+			r, TagFaceNodes, MPI_COMM_WORLD, &status);
+
+		meshPiece.vecSourceFaceIx.resize(nFaces);
+		meshPiece.vecTargetFaceIx.resize(nFaces);
+
+		MPI_Recv(meshPiece.vecSourceFaceIx.data(), nFaces, MPI_INT,
+			r, TagSourceFaceIx, MPI_COMM_WORLD, &status);
+		MPI_Recv(meshPiece.vecTargetFaceIx.data(), nFaces, MPI_INT,
+			r, TagTargetFaceIx, MPI_COMM_WORLD, &status);
+
+		meshPiece.nodes.resize(nNodes);
+		for (int i = 0; i < nNodes; i++) {
+			meshPiece.nodes[i] =
+				Node(vecNodes[3*i], vecNodes[3*i+1], vecNodes[3*i+2]);
+		}
+
+		meshPiece.faces.reserve(nFaces);
+
+		int ixFaceNode = 0;
+		for (int f = 0; f < nFaces; f++) {
+			Face face(vecFaceSizes[f]);
+			for (int i = 0; i < vecFaceSizes[f]; i++) {
+				face.SetNode(i, vecFaceNodes[ixFaceNode++]);
+			}
+			meshPiece.faces.push_back(face);
+		}
+	}
+
+	// Merge pieces in order of source face index
+#if defined(OVERLAPMESH_USE_NODE_MULTIMAP)
+	NodeMap nodemapOverlap(ReferenceTolerance, OVERLAPMESH_BIN_WIDTH);
+#elif defined(OVERLAPMESH_USE_NODE_HASHMAP)
+	NodeMap nodemapOverlap(ReferenceTolerance, OVERLAPMESH_HASHMAP_CELL_WIDTH);
+#else
+	NodeMap nodemapOverlap;
+#endif
+
+	typedef std::pair<int, int> SourceFaceRankPair;
+
+	std::priority_queue<
+		SourceFaceRankPair,
+		std::vector<SourceFaceRankPair>,
+		std::greater<SourceFaceRankPair> > queueNext;
+
+	std::vector<int> vecNextFace(nMPISize, 0);
+	std::vector< std::vector<int> > vecNodeIx(nMPISize);
+
+	for (int r = 0; r < nMPISize; r++) {
+		vecNodeIx[r].resize(vecPieces[r].nodes.size(), InvalidNode);
+		if (vecPieces[r].faces.size() != 0) {
+			queueNext.push(
+				SourceFaceRankPair(vecPieces[r].vecSourceFaceIx[0], r));
+		}
+	}
+
+	while (!queueNext.empty()) {
+		const int r = queueNext.top().second;
+		queueNext.pop();
+
+		const Mesh & meshPiece = vecPieces[r];
+		const int f = vecNextFace[r]++;
+		const Face & facePiece = meshPiece.faces[f];
+
+		Face faceNew(facePiece.edges.size());
+		for (int i = 0; i < facePiece.edges.size(); i++) {
+			int & ixNode = vecNodeIx[r][facePiece[i]];
+			if (ixNode == InvalidNode) {
+#if defined(OVERLAPMESH_RETAIN_REPEATED_NODES)
+				ixNode = meshOverlap.nodes.size();
+				meshOverlap.nodes.push_back(meshPiece.nodes[facePiece[i]]);
+#else
+				NodeMapConstIterator iter =
+					nodemapOverlap.find(meshPiece.nodes[facePiece[i]]);
+
+				if (iter != nodemapOverlap.end()) {
+					ixNode = iter->second;
+				} else {
+					ixNode = nodemapOverlap.size();
+					nodemapOverlap.insert(
+						NodeMapPair(meshPiece.nodes[facePiece[i]], ixNode));
+				}
+#endif
+			}
+			faceNew.SetNode(i, ixNode);
+		}
+		meshOverlap.faces.push_back(faceNew);
+
+		meshOverlap.vecSourceFaceIx.push_back(meshPiece.vecSourceFaceIx[f]);
+		meshOverlap.vecTargetFaceIx.push_back(meshPiece.vecTargetFaceIx[f]);
+
+		if (f + 1 < meshPiece.faces.size()) {
+			queueNext.push(
+				SourceFaceRankPair(meshPiece.vecSourceFaceIx[f+1], r));
+		}
+	}
+
+#if !defined(OVERLAPMESH_RETAIN_REPEATED_NODES)
+	CopyNodeMapToMesh(nodemapOverlap, meshOverlap);
+#endif
+}
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Get the current time in seconds, for scheduling checkpoints.
+///	</summary>
+static double GetCheckpointTime() {
+	return std::chrono::duration<double>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Write the first nOverlapFaces Faces of meshOverlap, which cover the
+///		first nCompleted entries of the list of source faces, to a
+///		checkpoint.  The Nodes referenced by meshOverlap are given by
+///		nodesOverlap; only referenced Nodes are written, in order of first
+///		appearance.
+///	</summary>
+static void WriteOverlapMeshCheckpoint(
+	const OverlapMeshCheckpoint & checkpoint,
+	const Mesh & meshOverlap,
+	const NodeVector & nodesOverlap,
+	int nOverlapFaces,
+	int nCompleted
+) {
+	Mesh meshCheckpoint;
+	meshCheckpoint.type = Mesh::MeshType_Overlap;
+	meshCheckpoint.faces.reserve(nOverlapFaces);
+
+	std::vector<int> vecNodeIx(nodesOverlap.size(), InvalidNode);
+
+	for (int f = 0; f < nOverlapFaces; f++) {
+		const Face & face = meshOverlap.faces[f];
+
+		Face faceNew(face.edges.size());
+		for (int i = 0; i < face.edges.size(); i++) {
+			int & ixNode = vecNodeIx[face[i]];
+			if (ixNode == InvalidNode) {
+				ixNode = meshCheckpoint.nodes.size();
+				meshCheckpoint.nodes.push_back(nodesOverlap[face[i]]);
+			}
+			faceNew.SetNode(i, ixNode);
+		}
+		meshCheckpoint.faces.push_back(faceNew);
+	}
+
+	meshCheckpoint.vecSourceFaceIx.assign(
+		meshOverlap.vecSourceFaceIx.begin(),
+		meshOverlap.vecSourceFaceIx.begin() + nOverlapFaces);
+	meshCheckpoint.vecTargetFaceIx.assign(
+		meshOverlap.vecTargetFaceIx.begin(),
+		meshOverlap.vecTargetFaceIx.begin() + nOverlapFaces);
+
+	checkpoint.Write(meshCheckpoint, nCompleted);
+
+	Announce("Wrote checkpoint \"%s\" (%i source faces)",
+		checkpoint.GetCheckpointFileName().c_str(), nCompleted);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Write the first nOverlapFaces Faces of meshOverlap to a checkpoint,
+///		where Nodes are held in nodemapOverlap.
+///	</summary>
+static void WriteOverlapMeshCheckpoint(
+	const OverlapMeshCheckpoint & checkpoint,
+	const Mesh & meshOverlap,
+	const NodeMap & nodemapOverlap,
+	int nOverlapFaces,
+	int nCompleted
+) {
+#if defined(OVERLAPMESH_RETAIN_REPEATED_NODES)
+	WriteOverlapMeshCheckpoint(
+		checkpoint, meshOverlap, meshOverlap.nodes, nOverlapFaces, nCompleted);
+#else
+	Mesh meshNodes;
+	CopyNodeMapToMesh(nodemapOverlap, meshNodes);
+
+	WriteOverlapMeshCheckpoint(
+		checkpoint, meshOverlap, meshNodes.nodes, nOverlapFaces, nCompleted);
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+#if defined(_OPENMP) && defined(OVERLAPMESH_USE_NODE_HASHMAP)
+///	<summary>
+///		Record the coordinates of the Nodes of a block appended to the
+///		global overlap mesh by their provisional index in a
+///		ConcurrentNodeMap.  Blocks are appended in order, so the first
+///		coordinates recorded for each Node are those of its lowest priority.
+///	</summary>
+static void RecordProvisionalNodes(
+	const NodeVector & nodesBlock,
+	const std::vector<int> & vecBlockNodeIx,
+	NodeVector & nodesProvisional,
+	std::vector<char> & vecProvisionalSet
+) {
+	for (int i = 0; i < nodesBlock.size(); i++) {
+		const int ix = vecBlockNodeIx[i];
+		if (ix >= nodesProvisional.size()) {
+			nodesProvisional.resize(ix + 1);
+			vecProvisionalSet.resize(ix + 1, 0);
+		}
+		if (!vecProvisionalSet[ix]) {
+			nodesProvisional[ix] = nodesBlock[i];
+			vecProvisionalSet[ix] = 1;
+		}
+	}
+}
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Complete an overlap mesh generated from a list of source faces.
+///		Nodes left unreferenced by source faces regenerated with exact
+///		arithmetic are removed, and the checkpoint, if any, is removed.
+///	</summary>
+static void FinishOverlapMeshFromFaceList(
+	Mesh & meshOverlap,
+	const OverlapMeshCheckpoint * pcheckpoint,
+	int nRetriedFaces
+) {
+	if (nRetriedFaces != 0) {
+		Announce("Regenerated %i source faces with exact arithmetic",
+			nRetriedFaces);
+
+		std::vector<int> vecNodeIx(meshOverlap.nodes.size(), InvalidNode);
+		for (int f = 0; f < meshOverlap.faces.size(); f++) {
+			const Face & face = meshOverlap.faces[f];
+			for (int i = 0; i < face.edges.size(); i++) {
+				vecNodeIx[face[i]] = 0;
+			}
+		}
+
+		int nNodes = 0;
+		for (int i = 0; i < meshOverlap.nodes.size(); i++) {
+			if (vecNodeIx[i] != InvalidNode) {
+				vecNodeIx[i] = nNodes;
+				meshOverlap.nodes[nNodes] = meshOverlap.nodes[i];
+				nNodes++;
+			}
+		}
+		meshOverlap.nodes.resize(nNodes);
+
+		for (int f = 0; f < meshOverlap.faces.size(); f++) {
+			Face & face = meshOverlap.faces[f];
+			for (int i = 0; i < face.edges.size(); i++) {
+				face.SetNode(i, vecNodeIx[face[i]]);
+			}
+		}
+	}
+
+	if (pcheckpoint != NULL) {
+		pcheckpoint->Remove();
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Generate the overlap mesh associated with the given list of source
+///		faces.  In mixed mode source faces for which fuzzy arithmetic fails
+///		are regenerated with exact arithmetic.  If strCheckpointDir is not
+///		empty the overlap faces of completed blocks of source faces are
+///		periodically written to a checkpoint in that directory, and a
+///		checkpoint left by a failed run is resumed.
+///	</summary>
+static void GenerateOverlapMeshFromFaceList(
+	const Mesh & meshSource,
+	const Mesh & meshTarget,
+	const std::vector<int> & vecSourceFaceIx,
+	Mesh & meshOverlap,
+    OverlapMeshMethod method,
+	const bool fAllowNoOverlap,
+    const bool fVerbose,
+	const std::string & strCheckpointDir
+) {
+	// Convex meshes with great circle arc edges may be clipped directly
+	if (method == OverlapMeshMethod_Clip) {
+		if (GenerateOverlapMeshClip(
+				meshSource,
+				meshTarget,
+				vecSourceFaceIx,
+				meshOverlap,
+				fAllowNoOverlap)
+		) {
+			return;
+		}
+
+		Announce("Meshes are not convex with great circle arc edges; "
+			"using fuzzy overlap method");
+		method = OverlapMeshMethod_Fuzzy;
+	}
+
+#if defined(OVERLAPMESH_USE_NODE_MULTIMAP)
+	NodeMap nodemapOverlap(ReferenceTolerance, OVERLAPMESH_BIN_WIDTH);
+#elif defined(OVERLAPMESH_USE_NODE_HASHMAP)
+	NodeMap nodemapOverlap(ReferenceTolerance, OVERLAPMESH_HASHMAP_CELL_WIDTH);
+#else
+	NodeMap nodemapOverlap;
+#endif
+
+	const int nSourceFaces = vecSourceFaceIx.size();
+
+	// Resume from the checkpoint of a previous run.  Fuzzy and mixed runs
+	// generate the same overlap faces wherever fuzzy arithmetic succeeds,
+	// so a failed fuzzy run may be resumed in mixed mode.
+	std::unique_ptr<OverlapMeshCheckpoint> pcheckpoint;
+
+	Mesh meshResume;
+	int ixResume = 0;
+
+	if (strCheckpointDir != "") {
+		pcheckpoint.reset(
+			new OverlapMeshCheckpoint(
+				strCheckpointDir,
+				meshSource,
+				meshTarget,
+				vecSourceFaceIx,
+				(fAllowNoOverlap)?("v2_allownooverlap"):("v2")));
+
+		ixResume = pcheckpoint->Read(meshResume);
+
+		// Checkpoints are written at block boundaries
+		if ((ixResume % OverlapMeshParallelBlockSize != 0) &&
+			(ixResume != nSourceFaces)
+		) {
+			Announce("WARNING: Checkpoint \"%s\" does not end on a block "
+				"boundary; ignoring",
+				pcheckpoint->GetCheckpointFileName().c_str());
+			meshResume.Clear();
+			ixResume = 0;
+		}
+
+		if (ixResume != 0) {
+			Announce("Resuming from checkpoint \"%s\" (%i / %i source faces)",
+				pcheckpoint->GetCheckpointFileName().c_str(),
+				ixResume, nSourceFaces);
+		}
+	}
+
+	int ixLastCheckpoint = ixResume;
+	double dLastCheckpointTime = GetCheckpointTime();
+
+	// In mixed mode regenerate source faces that fail with exact arithmetic
+	std::unique_ptr<OverlapMeshExactRetry> pretry;
+	if (method == OverlapMeshMethod_Mixed) {
+		pretry.reset(new OverlapMeshExactRetry(meshSource, meshTarget));
+	}
+
+	int nRetriedFaces = 0;
+
+	// Find a target face near the first corner of each source face, using
+	// a kd-tree over the first corner of each target face
+	std::vector<int> vecTargetFaceSeed;
+	{
+		OVERLAPMESH_STAT_PHASE(Phase_SeedSearch);
+
+		NodeVector vecTargetCorners(meshTarget.faces.size());
+		for (int i = 0; i < meshTarget.faces.size(); i++) {
+			vecTargetCorners[i] = meshTarget.nodes[meshTarget.faces[i][0]];
+		}
+
+		NodeVector vecSourceCorners(nSourceFaces);
+		for (int ix = 0; ix < nSourceFaces; ix++) {
+			vecSourceCorners[ix] =
+				meshSource.nodes[meshSource.faces[vecSourceFaceIx[ix]][0]];
+		}
+
+		PointKDTree kdTarget(vecTargetCorners);
+
+		kdTarget.FindNearest(vecSourceCorners, vecTargetFaceSeed);
+	}
+
+	// Faces on meshTarget that are convex with great circle arc edges, which
+	// contain any source face whose nodes are all in their interior
+	std::vector<char> vecTargetFaceConvex(meshTarget.faces.size(), 0);
+
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < meshTarget.faces.size(); i++) {
+		const Face & faceTarget = meshTarget.faces[i];
+
+		bool fConvex = true;
+		for (int j = 0; j < faceTarget.edges.size(); j++) {
+			if (faceTarget.edges[j].type != Edge::Type_GreatCircleArc) {
+				fConvex = false;
+				break;
+			}
+		}
+		if (fConvex) {
+			fConvex = !IsFaceConcave(faceTarget, meshTarget.nodes);
+		}
+
+		vecTargetFaceConvex[i] = (fConvex)?(1):(0);
+	}
+
+#if defined(_OPENMP)
+	// Generate Overlap mesh for blocks of source Faces in parallel.  Per-face
+	// output in verbose mode would interleave, so it remains serial.
+	if (!fVerbose && (omp_get_max_threads() > 1)) {
+		const int nBlocks =
+			(nSourceFaces + OverlapMeshParallelBlockSize - 1)
+				/ OverlapMeshParallelBlockSize;
+
+		const int nResumeBlocks =
+			(ixResume + OverlapMeshParallelBlockSize - 1)
+				/ OverlapMeshParallelBlockSize;
+
+		Announce("Generating overlap faces using %i threads",
+			omp_get_max_threads());
+
+		int iError = 0;
+		std::string strError;
+
+		// Scratch storage for each thread
+		std::vector<OverlapFaceWorkspace> vecWorkspace(omp_get_max_threads());
+
+		OVERLAPMESH_STAT_PHASE(Phase_OverlapFaces);
+
+#if defined(OVERLAPMESH_USE_NODE_HASHMAP)
+		ConcurrentNodeMap nodemapConcurrent(
+			ReferenceTolerance, OVERLAPMESH_HASHMAP_CELL_WIDTH);
+
+		// Coordinates of appended Nodes by provisional index, for checkpoints
+		NodeVector nodesProvisional;
+		std::vector<char> vecProvisionalSet;
+
+		// Nodes of the checkpoint precede those of all remaining blocks
+		if (ixResume != 0) {
+			std::vector<int> vecResumeNodeIx(meshResume.nodes.size());
+			for (int i = 0; i < meshResume.nodes.size(); i++) {
+				vecResumeNodeIx[i] =
+					nodemapConcurrent.find_or_insert(
+						meshResume.nodes[i],
+						static_cast<uint64_t>(i));
+			}
+
+			AppendOverlapMeshBlock(meshResume, vecResumeNodeIx, meshOverlap);
+
+			if (pcheckpoint != NULL) {
+				RecordProvisionalNodes(
+					meshResume.nodes,
+					vecResumeNodeIx,
+					nodesProvisional,
+					vecProvisionalSet);
+			}
+		}
+#else
+		if (ixResume != 0) {
+			MergeOverlapMeshBlock(meshResume, meshOverlap, nodemapOverlap);
+		}
+#endif
+		meshResume.Clear();
+
+#pragma omp parallel for schedule(dynamic) ordered
+		for (int b = nResumeBlocks; b < nBlocks; b++) {
+			const int ixBegin = b * OverlapMeshParallelBlockSize;
+			const int ixEnd =
+				std::min(ixBegin + OverlapMeshParallelBlockSize, nSourceFaces);
+
+			Mesh meshBlock;
+#if defined(OVERLAPMESH_USE_NODE_HASHMAP)
+			std::vector<int> vecBlockNodeIx;
+#endif
+#if defined(OVERLAPMESH_USE_NODE_MULTIMAP)
+			NodeMap nodemapBlock(ReferenceTolerance, OVERLAPMESH_BIN_WIDTH);
+#elif defined(OVERLAPMESH_USE_NODE_HASHMAP)
+			NodeMap nodemapBlock(ReferenceTolerance, OVERLAPMESH_HASHMAP_CELL_WIDTH);
+#else
+			NodeMap nodemapBlock;
+#endif
+			OverlapNodeKeyMap keymapBlock;
+
+			int nBlockRetriedFaces = 0;
+
+			int iErrorSoFar;
+#pragma omp atomic read
+			iErrorSoFar = iError;
+
+			std::string strBlockError;
+			if (iErrorSoFar == 0) {
+				try {
+					GenerateOverlapMeshFromFaceRange(
+						meshSource,
+						meshTarget,
+						vecSourceFaceIx,
+						vecTargetFaceSeed,
+						ixBegin,
+						ixEnd,
+						meshBlock,
+						nodemapBlock,
+						keymapBlock,
+						vecWorkspace[omp_get_thread_num()],
+						method,
+						fAllowNoOverlap,
+						false,
+						false,
+						vecTargetFaceConvex,
+						pretry.get(),
+						nBlockRetriedFaces);
+
+#if !defined(OVERLAPMESH_RETAIN_REPEATED_NODES)
+					CopyNodeMapToMesh(nodemapBlock, meshBlock);
+#endif
+#if defined(OVERLAPMESH_USE_NODE_HASHMAP)
+					// Merge nodes with the global node map outside of the
+					// ordered region; the priority of each node reproduces
+					// the numbering of an ordered merge
+					vecBlockNodeIx.resize(meshBlock.nodes.size());
+					for (int i = 0; i < meshBlock.nodes.size(); i++) {
+						vecBlockNodeIx[i] =
+							nodemapConcurrent.find_or_insert(
+								meshBlock.nodes[i],
+								(static_cast<uint64_t>(b) << 32)
+									| static_cast<uint64_t>(i));
+					}
+#endif
+
+				} catch(Exception & e) {
+					strBlockError = e.ToString();
+				}
+			}
+
+			// Merge blocks in order of source face index
+#pragma omp ordered
+			{
+				bool fWriteCheckpoint = false;
+				int ixCheckpoint = 0;
+
+				if ((iError == 0) && (strBlockError != "")) {
+					strError = strBlockError;
+#pragma omp atomic write
+					iError = 1;
+
+					// Keep the blocks completed before the failure
+					fWriteCheckpoint = (ixBegin > ixLastCheckpoint);
+					ixCheckpoint = ixBegin;
+				}
+				if (iError == 0) {
+					if ((ixBegin / 1000) != (ixEnd / 1000)) {
+						Announce("Source Face %i", ixEnd);
+					}
+#if defined(OVERLAPMESH_USE_NODE_HASHMAP)
+					AppendOverlapMeshBlock(
+						meshBlock,
+						vecBlockNodeIx,
+						meshOverlap);
+
+					if (pcheckpoint != NULL) {
+						RecordProvisionalNodes(
+							meshBlock.nodes,
+							vecBlockNodeIx,
+							nodesProvisional,
+							vecProvisionalSet);
+					}
+#else
+					MergeOverlapMeshBlock(
+						meshBlock,
+						meshOverlap,
+						nodemapOverlap);
+#endif
+					nRetriedFaces += nBlockRetriedFaces;
+
+					fWriteCheckpoint =
+						(ixEnd < nSourceFaces) &&
+						(GetCheckpointTime() - dLastCheckpointTime
+							>= OverlapMeshCheckpointInterval);
+					ixCheckpoint = ixEnd;
+				}
+
+				if ((pcheckpoint != NULL) && fWriteCheckpoint) {
+					try {
+						WriteOverlapMeshCheckpoint(
+							*pcheckpoint,
+							meshOverlap,
+#if defined(OVERLAPMESH_USE_NODE_HASHMAP)
+							nodesProvisional,
+#else
+							nodemapOverlap,
+#endif
+							meshOverlap.faces.size(),
+							ixCheckpoint);
+
+						ixLastCheckpoint = ixCheckpoint;
+						dLastCheckpointTime = GetCheckpointTime();
+
+					} catch(Exception & e) {
+						if (iError == 0) {
+							strError = e.ToString();
+#pragma omp atomic write
+							iError = 1;
+						}
+					}
+				}
+			}
+		}
+
+		if (iError != 0) {
+			_EXCEPTION1("%s", strError.c_str());
+		}
 
-		} else if (nodevecOutput.size() < 3) {
-			_EXCEPTIONT("Overlap polygon consists of fewer than 3 nodes");
+		OVERLAPMESH_STAT_PHASE_STOP(Phase_OverlapFaces);
 
-		} else {
+#if defined(OVERLAPMESH_USE_NODE_HASHMAP)
+		// Number nodes in order of first appearance
+		OVERLAPMESH_STAT_PHASE(Phase_NodeNumbering);
 
-			// Add all neighboring Faces into the queue of Target Faces
-			for (int i = 0; i < faceTarget.edges.size(); i++) {
-				EdgeMapConstIterator iter =
-					edgemapTarget.find(faceTarget.edges[i]);
+		std::vector<int> vecNodeIx;
+		nodemapConcurrent.assign_indices(meshOverlap.nodes, vecNodeIx);
 
-				if (iter == edgemapTarget.end()) {
-					_EXCEPTIONT("Missing Edge in Target EdgeMap");
-				}
+		for (int f = 0; f < meshOverlap.faces.size(); f++) {
+			Face & face = meshOverlap.faces[f];
+			for (int i = 0; i < face.edges.size(); i++) {
+				face.SetNode(i, vecNodeIx[face[i]]);
+			}
+		}
 
-				const FacePair & facepair = iter->second;
+		FinishOverlapMeshFromFaceList(
+			meshOverlap, pcheckpoint.get(), nRetriedFaces);
+		return;
+#endif
 
-				int iPushFace;
-				if (facepair[0] == ixCurrentTargetFace) {
-					iPushFace = facepair[1];
+	} else
+#endif
+	{
+		OVERLAPMESH_STAT_PHASE(Phase_OverlapFaces);
 
-				} else if (facepair[1] == ixCurrentTargetFace) {
-					iPushFace = facepair[0];
+		OverlapFaceWorkspace workspace;
 
-				} else {
-					_EXCEPTIONT("EdgeMap error");
-				}
+		OverlapNodeKeyMap keymapOverlap;
 
-				if (iPushFace == InvalidFace) {
-					continue;
-				}
+		if (ixResume != 0) {
+			MergeOverlapMeshBlock(meshResume, meshOverlap, nodemapOverlap);
+			meshResume.Clear();
+		}
 
-				std::set<int>::const_iterator iterFace =
-					setExaminedTargetFaces.find(iPushFace);
+		// Generate Overlap mesh for each Face, in blocks which are
+		// periodically checkpointed
+		for (int ixBegin = ixResume; ixBegin < nSourceFaces;
+			ixBegin += OverlapMeshParallelBlockSize
+		) {
+			const int ixEnd =
+				std::min(ixBegin + OverlapMeshParallelBlockSize, nSourceFaces);
 
-				if (iterFace == setExaminedTargetFaces.end()) {
-					queueTargetFaces.push(iPushFace);
-					setExaminedTargetFaces.insert(iPushFace);
-				}
-			}
+			const int nPrevOverlapFaces = meshOverlap.faces.size();
 
-            if (fVerbose) {
-				Announce("Overlap with Face %i", ixCurrentTargetFace);
-			}
+			try {
+				GenerateOverlapMeshFromFaceRange(
+					meshSource,
+					meshTarget,
+					vecSourceFaceIx,
+					vecTargetFaceSeed,
+					ixBegin,
+					ixEnd,
+					meshOverlap,
+					nodemapOverlap,
+					keymapOverlap,
+					workspace,
+					method,
+					fAllowNoOverlap,
+					fVerbose,
+					true,
+					vecTargetFaceConvex,
+					pretry.get(),
+					nRetriedFaces);
 
-			// Calculate face area
-			Face faceTemp(nodevecOutput.size());
-			for (int i = 0; i < nodevecOutput.size(); i++) {
-				faceTemp.SetNode(i, i);
+			} catch(Exception & e) {
+				// Keep the blocks completed before the failure
+				if ((pcheckpoint != NULL) && (ixBegin > ixLastCheckpoint)) {
+					WriteOverlapMeshCheckpoint(
+						*pcheckpoint,
+						meshOverlap,
+						nodemapOverlap,
+						nPrevOverlapFaces,
+						ixBegin);
+				}
+				throw;
 			}
-			Real dArea = CalculateFaceArea(faceTemp, nodevecOutput);
 
-			if (dArea < 1.0e-13) {
-				continue;
-/*
-				printf("%i %i %1.15e %i\n", ixSourceFace, ixCurrentTargetFace, dArea, nodevecOutput.size());
-				for (int i = 0; i < nodevecOutput.size(); i++) {
-					nodevecOutput[i].Print("");
-				}
-				//_EXCEPTION();
-*/
+			if ((pcheckpoint != NULL) &&
+				(ixEnd < nSourceFaces) &&
+				(GetCheckpointTime() - dLastCheckpointTime
+					>= OverlapMeshCheckpointInterval)
+			) {
+				WriteOverlapMeshCheckpoint(
+					*pcheckpoint,
+					meshOverlap,
+					nodemapOverlap,
+					meshOverlap.faces.size(),
+					ixEnd);
+
+				ixLastCheckpoint = ixEnd;
+				dLastCheckpointTime = GetCheckpointTime();
 			}
+		}
+	}
 
-			// Insert Face into meshOverlap
-			Face faceNew(nodevecOutput.size());
-			for (int i = 0; i < nodevecOutput.size(); i++) {
-#if defined(OVERLAPMESH_RETAIN_REPEATED_NODES)
-				faceNew.SetNode(i, meshOverlap.nodes.size());
-				meshOverlap.nodes.push_back(nodevecOutput[i]);
-#else
-				NodeMapConstIterator iter
-					= nodemapOverlap.find(nodevecOutput[i]);
+#if !defined(OVERLAPMESH_RETAIN_REPEATED_NODES)
+	// Insert all Nodes from nodemapOverlap into meshOverlap.nodes
+	OVERLAPMESH_STAT_PHASE(Phase_NodeNumbering);
 
-				if (iter != nodemapOverlap.end()) {
-					faceNew.SetNode(i, iter->second);
-				} else {
-					int iNextNodeMapOverlapIx = nodemapOverlap.size();
-					faceNew.SetNode(i, iNextNodeMapOverlapIx);
-					nodemapOverlap.insert(
-						NodeMapPair(nodevecOutput[i], iNextNodeMapOverlapIx));
-				}
+	CopyNodeMapToMesh(nodemapOverlap, meshOverlap);
 #endif
-			}
-			meshOverlap.faces.push_back(faceNew);
 
-			meshOverlap.vecSourceFaceIx.push_back(ixSourceFace);
-			meshOverlap.vecTargetFaceIx.push_back(ixCurrentTargetFace);
-		}
-	}
+	FinishOverlapMeshFromFaceList(
+		meshOverlap, pcheckpoint.get(), nRetriedFaces);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -1895,99 +3821,126 @@ void GenerateOverlapMesh_v2(
 	Mesh & meshOverlap,
     OverlapMeshMethod method,
 	const bool fAllowNoOverlap,
-    const bool fVerbose
+    const bool fVerbose,
+	const bool fTargetMajor,
+	const std::string & strCheckpointDir
 ) {
-#if defined(OVERLAPMESH_RETAIN_REPEATED_NODES)
-	NodeMap nodemapOverlap;
-#endif
-#if defined(OVERLAPMESH_USE_UNSORTED_MAP)
-	NodeMap nodemapOverlap;
-#endif
-#if defined(OVERLAPMESH_USE_NODE_MULTIMAP)
-	NodeMap nodemapOverlap(ReferenceTolerance, OVERLAPMESH_BIN_WIDTH);
-#endif
+	// Generate the overlap mesh in target-major order, and then reorder
+	// overlap faces by source face
+	if (fTargetMajor) {
+		GenerateOverlapMesh_v2(
+			meshTarget,
+			meshSource,
+			meshOverlap,
+			method,
+			fAllowNoOverlap,
+			fVerbose,
+			false,
+			strCheckpointDir);
+
+		meshOverlap.ExchangeFirstAndSecondMesh();
+		return;
+	}
 
-	// Create a KD tree for fast searching of the target mesh
-	kdtree * kdTarget = kd_create(3);
+	const int nSourceFaces = meshSource.faces.size();
 
-	for (int i = 0; i < meshTarget.faces.size(); i++) {
-		int ixNodeCorner = meshTarget.faces[i][0];
-		kd_insert3(
-			kdTarget,
-			meshTarget.nodes[ixNodeCorner].x,
-			meshTarget.nodes[ixNodeCorner].y,
-			meshTarget.nodes[ixNodeCorner].z,
-			(void*)(&(meshTarget.faces[i])));
+	OVERLAPMESH_STAT_RESET();
+
+	std::vector<int> vecSourceFaceIx;
+
+#if defined(TEMPEST_MPIOMP)
+	// Distribute source faces over MPI ranks, if MPI has been initialized
+	int nMPIRank = 0;
+	int nMPISize = 1;
+
+	int fMPIInitialized = 0;
+	MPI_Initialized(&fMPIInitialized);
+	if (fMPIInitialized) {
+		MPI_Comm_rank(MPI_COMM_WORLD, &nMPIRank);
+		MPI_Comm_size(MPI_COMM_WORLD, &nMPISize);
 	}
 
-	// Generate Overlap mesh for each Face
-	for (int i = 0; i < meshSource.faces.size(); i++) {
-	//for (int i = 3999555; i < 3999555+1; i++) {
-        if (fVerbose) {
-			std::string strAnnounce = "Source Face " + std::to_string((long long)i);
-			AnnounceStartBlock(strAnnounce.c_str());
-		}
-		if (!fVerbose && ((i % 1000) == 0)) {
-			std::string strAnnounce = "Source Face " + std::to_string((long long)i);
-			Announce(strAnnounce.c_str());
-		}
+	if (nMPISize > 1) {
+		Announce("Partitioning %i source faces over %i ranks",
+			nSourceFaces, nMPISize);
 
-		// Find a Target face near this source face
-		int ixNodeCorner = meshSource.faces[i][0];
+		PartitionSourceFaces(
+			meshSource,
+			nMPIRank,
+			nMPISize,
+			vecSourceFaceIx);
+
+		// Errors must be reduced over all ranks prior to gathering
+		std::string strError;
+		try {
+			GenerateOverlapMeshFromFaceList(
+				meshSource,
+				meshTarget,
+				vecSourceFaceIx,
+				meshOverlap,
+				method,
+				fAllowNoOverlap,
+				fVerbose,
+				strCheckpointDir);
+
+		} catch(Exception & e) {
+			strError = e.ToString();
+		}
 
-		kdres * kdresTarget =
-			kd_nearest3(
-				kdTarget,
-				meshSource.nodes[ixNodeCorner].x,
-				meshSource.nodes[ixNodeCorner].y,
-				meshSource.nodes[ixNodeCorner].z);
+		int iErrorRank = (strError != "")?(nMPIRank):(nMPISize);
+		int iFirstErrorRank;
+		MPI_Allreduce(
+			&iErrorRank, &iFirstErrorRank, 1,
+			MPI_INT, MPI_MIN, MPI_COMM_WORLD);
 
-		Face * pFace = (Face *)(kd_res_item_data(kdresTarget));
+		if (strError != "") {
+			_EXCEPTION1("%s", strError.c_str());
+		}
+		if (iFirstErrorRank != nMPISize) {
+			_EXCEPTION1("Overlap mesh generation failed on rank %i",
+				iFirstErrorRank);
+		}
 
-		int iTargetFaceSeed = pFace - &(meshTarget.faces[0]);
+		// Assemble the overlap mesh on rank 0
+		GatherOverlapMesh(meshOverlap, nMPIRank, nMPISize);
 
-        if (fVerbose) {
-			Announce("Nearest target face %i", iTargetFaceSeed);
+	} else
+#endif
+	{
+		vecSourceFaceIx.resize(nSourceFaces);
+		for (int i = 0; i < nSourceFaces; i++) {
+			vecSourceFaceIx[i] = i;
 		}
 
-		// Generate the overlap mesh associated with this source face
-		GenerateOverlapMeshFromFace(
+		GenerateOverlapMeshFromFaceList(
 			meshSource,
 			meshTarget,
-			i,
+			vecSourceFaceIx,
 			meshOverlap,
-			nodemapOverlap,
 			method,
-            iTargetFaceSeed,
 			fAllowNoOverlap,
-            fVerbose);
-
-		if (fVerbose) {
-			AnnounceEndBlock(NULL);
-		}
+			fVerbose,
+			strCheckpointDir);
 	}
 
 	// Replace parent indices if meshSource has a MultiFaceMap
 	if (meshSource.vecMultiFaceMap.size() != 0) {
+		bool fSorted = true;
 		for (int f = 0; f < meshOverlap.faces.size(); f++) {
 			meshOverlap.vecSourceFaceIx[f] =
 				meshSource.vecMultiFaceMap[meshOverlap.vecSourceFaceIx[f]];
-		}
-	}
 
-	// Replace parent indices if meshTarget has a MultiFaceMap
-	if (meshTarget.vecMultiFaceMap.size() != 0) {
-		for (int f = 0; f < meshOverlap.faces.size(); f++) {
-			meshOverlap.vecTargetFaceIx[f] =
-				meshSource.vecMultiFaceMap[meshOverlap.vecTargetFaceIx[f]];
+			if ((f > 0) &&
+				(meshOverlap.vecSourceFaceIx[f] < meshOverlap.vecSourceFaceIx[f-1])
+			) {
+				fSorted = false;
+			}
 		}
-	}
 
-	// Replace parent indices if meshSource has a MultiFaceMap
-	if (meshSource.vecMultiFaceMap.size() != 0) {
-		for (int f = 0; f < meshOverlap.faces.size(); f++) {
-			meshOverlap.vecSourceFaceIx[f] =
-				meshSource.vecMultiFaceMap[meshOverlap.vecSourceFaceIx[f]];
+		// Overlap faces must be ordered by source face (the source mesh
+		// may have been reordered)
+		if (!fSorted) {
+			meshOverlap.SortBySourceFace();
 		}
 	}
 
@@ -1995,22 +3948,10 @@ void GenerateOverlapMesh_v2(
 	if (meshTarget.vecMultiFaceMap.size() != 0) {
 		for (int f = 0; f < meshOverlap.faces.size(); f++) {
 			meshOverlap.vecTargetFaceIx[f] =
-				meshSource.vecMultiFaceMap[meshOverlap.vecTargetFaceIx[f]];
+				meshTarget.vecMultiFaceMap[meshOverlap.vecTargetFaceIx[f]];
 		}
 	}
 
-	// Destroy the KD tree
-	kd_free(kdTarget);
-
-#if !defined(OVERLAPMESH_RETAIN_REPEATED_NODES)
-	// Insert all Nodes from nodemapOverlap into meshOverlap.nodes
-	meshOverlap.nodes.resize(nodemapOverlap.size());
-
-	NodeMapConstIterator iter = nodemapOverlap.begin();
-	for (; iter != nodemapOverlap.end(); iter++) {
-		meshOverlap.nodes[iter->second] = iter->first;
-	}
-#endif
 
 /*
 	// Check concavity of overlap mesh
@@ -2024,10 +3965,356 @@ void GenerateOverlapMesh_v2(
 	AnnounceEndBlock("Done");
 */
 	// Calculate Face areas
+	OVERLAPMESH_STAT_PHASE(Phase_FaceAreas);
+
 	//if (fVerbose) {
 	double dTotalAreaOverlap = meshOverlap.CalculateFaceAreas(false);
 	Announce("Overlap Mesh Geometric Area: %1.15e (%1.15e)", dTotalAreaOverlap, 4.0 * M_PI);
 	//}
+
+	OVERLAPMESH_STAT_PHASE_STOP(Phase_FaceAreas);
+
+	OVERLAPMESH_STAT_REPORT();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Get the local index of the lexicographically smallest node of a
+///		Face, which is used as the starting node when comparing Faces.
+///	</summary>
+static int GetFaceStartingNode(
+	const Mesh & mesh,
+	const Face & face
+) {
+	int iStart = 0;
+	for (int i = 1; i < face.edges.size(); i++) {
+		const Node & node = mesh.nodes[face[i]];
+		const Node & nodeStart = mesh.nodes[face[iStart]];
+		if ((node.x < nodeStart.x) ||
+		    ((node.x == nodeStart.x) && (node.y < nodeStart.y)) ||
+		    ((node.x == nodeStart.x) && (node.y == nodeStart.y) && (node.z < nodeStart.z))
+		) {
+			iStart = i;
+		}
+	}
+	return iStart;
+}
+
+///	<summary>
+///		Calculate a hash of the node coordinates and edge types of a Face,
+///		independent of the starting node.
+///	</summary>
+static uint64_t CalculateFaceGeometryHash(
+	const Mesh & mesh,
+	int ixFace
+) {
+	const Face & face = mesh.faces[ixFace];
+	const int nEdges = face.edges.size();
+	const int iStart = GetFaceStartingNode(mesh, face);
+
+	// FNV-1a
+	uint64_t uHash = 14695981039346656037ULL;
+	for (int i = 0; i < nEdges; i++) {
+		const int j = (iStart + i) % nEdges;
+		const Node & node = mesh.nodes[face[j]];
+
+		uint64_t uWords[4];
+		memcpy(&(uWords[0]), &(node.x), sizeof(double));
+		memcpy(&(uWords[1]), &(node.y), sizeof(double));
+		memcpy(&(uWords[2]), &(node.z), sizeof(double));
+		uWords[3] = static_cast<uint64_t>(face.edges[j].type);
+
+		for (int w = 0; w < 4; w++) {
+			uHash ^= uWords[w];
+			uHash *= 1099511628211ULL;
+		}
+	}
+	return uHash;
+}
+
+///	<summary>
+///		Check if two Faces have identical node coordinates and edge types,
+///		independent of the starting node.
+///	</summary>
+static bool AreFacesGeometricallyEqual(
+	const Mesh & meshA,
+	int ixFaceA,
+	const Mesh & meshB,
+	int ixFaceB
+) {
+	const Face & faceA = meshA.faces[ixFaceA];
+	const Face & faceB = meshB.faces[ixFaceB];
+	if (faceA.edges.size() != faceB.edges.size()) {
+		return false;
+	}
+
+	const int nEdges = faceA.edges.size();
+	const int iStartA = GetFaceStartingNode(meshA, faceA);
+	const int iStartB = GetFaceStartingNode(meshB, faceB);
+
+	for (int i = 0; i < nEdges; i++) {
+		const int jA = (iStartA + i) % nEdges;
+		const int jB = (iStartB + i) % nEdges;
+		const Node & nodeA = meshA.nodes[faceA[jA]];
+		const Node & nodeB = meshB.nodes[faceB[jB]];
+		if ((nodeA.x != nodeB.x) || (nodeA.y != nodeB.y) || (nodeA.z != nodeB.z)) {
+			return false;
+		}
+		if (faceA.edges[jA].type != faceB.edges[jB].type) {
+			return false;
+		}
+	}
+	return true;
+}
+
+///	<summary>
+///		Find the Face of meshPrev identical to each Face of mesh, or
+///		InvalidFace if there is none.
+///	</summary>
+static void MatchFacesByGeometry(
+	const Mesh & mesh,
+	const Mesh & meshPrev,
+	std::vector<int> & vecPrevFaceIx
+) {
+	const int nFaces = mesh.faces.size();
+	const int nPrevFaces = meshPrev.faces.size();
+
+	std::vector<uint64_t> vecPrevHash(nPrevFaces);
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < nPrevFaces; i++) {
+		vecPrevHash[i] = CalculateFaceGeometryHash(meshPrev, i);
+	}
+
+	std::unordered_multimap<uint64_t, int> mapPrevFaces;
+	mapPrevFaces.reserve(nPrevFaces);
+	for (int i = 0; i < nPrevFaces; i++) {
+		mapPrevFaces.insert(std::pair<uint64_t, int>(vecPrevHash[i], i));
+	}
+
+	vecPrevFaceIx.resize(nFaces);
+
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < nFaces; i++) {
+		vecPrevFaceIx[i] = InvalidFace;
+
+		typedef std::unordered_multimap<uint64_t, int>::const_iterator MapIterator;
+		std::pair<MapIterator, MapIterator> range =
+			mapPrevFaces.equal_range(CalculateFaceGeometryHash(mesh, i));
+
+		for (MapIterator iter = range.first; iter != range.second; iter++) {
+			if (AreFacesGeometricallyEqual(mesh, i, meshPrev, iter->second)) {
+				vecPrevFaceIx[i] = iter->second;
+				break;
+			}
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void GenerateOverlapMeshIncremental(
+	const Mesh & meshSource,
+	const Mesh & meshTarget,
+	const Mesh & meshSourcePrev,
+	const Mesh & meshTargetPrev,
+	const Mesh & meshOverlapPrev,
+	Mesh & meshOverlap,
+	OverlapMeshMethod method,
+	const bool fAllowNoOverlap,
+	const bool fVerbose
+) {
+	if ((meshSource.vecMultiFaceMap.size() != 0) ||
+	    (meshTarget.vecMultiFaceMap.size() != 0)
+	) {
+		_EXCEPTIONT("Incremental overlap mesh generation does not support "
+			"concave meshes");
+	}
+
+	const int nPrevOverlapFaces = meshOverlapPrev.faces.size();
+	if ((meshOverlapPrev.vecSourceFaceIx.size() != nPrevOverlapFaces) ||
+	    (meshOverlapPrev.vecTargetFaceIx.size() != nPrevOverlapFaces)
+	) {
+		_EXCEPTIONT("Previous overlap mesh has no parent Face indices");
+	}
+
+	// Match Faces to the previous meshes
+	AnnounceStartBlock("Matching Faces to previous meshes");
+
+	std::vector<int> vecSourcePrevIx;
+	MatchFacesByGeometry(meshSource, meshSourcePrev, vecSourcePrevIx);
+
+	std::vector<int> vecTargetPrevIx;
+	MatchFacesByGeometry(meshTarget, meshTargetPrev, vecTargetPrevIx);
+
+	std::vector<int> vecSourceNewIx(meshSourcePrev.faces.size(), InvalidFace);
+	int nMatchedSource = 0;
+	for (int i = 0; i < meshSource.faces.size(); i++) {
+		if (vecSourcePrevIx[i] != InvalidFace) {
+			vecSourceNewIx[vecSourcePrevIx[i]] = i;
+			nMatchedSource++;
+		}
+	}
+
+	std::vector<int> vecTargetNewIx(meshTargetPrev.faces.size(), InvalidFace);
+	int nMatchedTarget = 0;
+	for (int i = 0; i < meshTarget.faces.size(); i++) {
+		if (vecTargetPrevIx[i] != InvalidFace) {
+			vecTargetNewIx[vecTargetPrevIx[i]] = i;
+			nMatchedTarget++;
+		}
+	}
+
+	Announce("Source Faces unchanged: %i / %i",
+		nMatchedSource, static_cast<int>(meshSource.faces.size()));
+	Announce("Target Faces unchanged: %i / %i",
+		nMatchedTarget, static_cast<int>(meshTarget.faces.size()));
+
+	AnnounceEndBlock(NULL);
+
+	// Source Faces that are new, or that overlapped a target Face which no
+	// longer exists, must be overlapped again.  Target Faces that are new
+	// cover the area of the removed target Faces, so no other source Face
+	// can overlap them.
+	std::vector<bool> vecRecompute(meshSource.faces.size(), false);
+	for (int i = 0; i < meshSource.faces.size(); i++) {
+		if (vecSourcePrevIx[i] == InvalidFace) {
+			vecRecompute[i] = true;
+		}
+	}
+	for (int f = 0; f < nPrevOverlapFaces; f++) {
+		const int ixPrevSource = meshOverlapPrev.vecSourceFaceIx[f];
+		const int ixPrevTarget = meshOverlapPrev.vecTargetFaceIx[f];
+		if ((ixPrevSource < 0) || (ixPrevSource >= vecSourceNewIx.size()) ||
+		    (ixPrevTarget < 0) || (ixPrevTarget >= vecTargetNewIx.size())
+		) {
+			_EXCEPTION1("Previous overlap mesh Face %i has invalid parent "
+				"Face indices", f);
+		}
+		const int ixSource = vecSourceNewIx[ixPrevSource];
+		if ((ixSource != InvalidFace) &&
+		    (vecTargetNewIx[ixPrevTarget] == InvalidFace)
+		) {
+			vecRecompute[ixSource] = true;
+		}
+	}
+
+	std::vector<int> vecRecomputeSourceFaceIx;
+	for (int i = 0; i < meshSource.faces.size(); i++) {
+		if (vecRecompute[i]) {
+			vecRecomputeSourceFaceIx.push_back(i);
+		}
+	}
+
+	// Copy reused overlap Faces and the Nodes they refer to
+	meshOverlap.Clear();
+	meshOverlap.type = Mesh::MeshType_Overlap;
+
+	const bool fPrevAreas =
+		(meshOverlapPrev.vecFaceArea.GetRows() == nPrevOverlapFaces);
+
+	std::vector<double> vecReusedArea;
+	std::vector<int> vecPrevNodeIx(meshOverlapPrev.nodes.size(), InvalidNode);
+
+	for (int f = 0; f < nPrevOverlapFaces; f++) {
+		const int ixSource =
+			vecSourceNewIx[meshOverlapPrev.vecSourceFaceIx[f]];
+		if ((ixSource == InvalidFace) || vecRecompute[ixSource]) {
+			continue;
+		}
+
+		Face face = meshOverlapPrev.faces[f];
+		for (int i = 0; i < face.edges.size(); i++) {
+			int & ixNode = vecPrevNodeIx[face[i]];
+			if (ixNode == InvalidNode) {
+				ixNode = meshOverlap.nodes.size();
+				meshOverlap.nodes.push_back(meshOverlapPrev.nodes[face[i]]);
+			}
+		}
+		for (int i = 0; i < face.edges.size(); i++) {
+			face.edges[i][0] = vecPrevNodeIx[face.edges[i][0]];
+			face.edges[i][1] = vecPrevNodeIx[face.edges[i][1]];
+		}
+
+		meshOverlap.faces.push_back(face);
+		meshOverlap.vecSourceFaceIx.push_back(ixSource);
+		meshOverlap.vecTargetFaceIx.push_back(
+			vecTargetNewIx[meshOverlapPrev.vecTargetFaceIx[f]]);
+
+		if (fPrevAreas) {
+			vecReusedArea.push_back(meshOverlapPrev.vecFaceArea[f]);
+		}
+	}
+
+	const int nReusedFaces = meshOverlap.faces.size();
+
+	Announce("Reusing %i / %i previous overlap Faces",
+		nReusedFaces, nPrevOverlapFaces);
+	Announce("Overlapping %i source Faces",
+		static_cast<int>(vecRecomputeSourceFaceIx.size()));
+
+	// Overlap the remaining source Faces
+	Mesh meshOverlapNew;
+	if (vecRecomputeSourceFaceIx.size() != 0) {
+		GenerateOverlapMeshFromFaceList(
+			meshSource,
+			meshTarget,
+			vecRecomputeSourceFaceIx,
+			meshOverlapNew,
+			method,
+			fAllowNoOverlap,
+			fVerbose,
+			"");
+	}
+
+	const int nNewFaces = meshOverlapNew.faces.size();
+	if (fPrevAreas && (nNewFaces != 0)) {
+		meshOverlapNew.CalculateFaceAreas(false);
+	}
+
+	const int nNodeOffset = meshOverlap.nodes.size();
+	meshOverlap.nodes.insert(meshOverlap.nodes.end(),
+		meshOverlapNew.nodes.begin(), meshOverlapNew.nodes.end());
+
+	for (int f = 0; f < meshOverlapNew.faces.size(); f++) {
+		Face & face = meshOverlapNew.faces[f];
+		for (int i = 0; i < face.edges.size(); i++) {
+			face.edges[i][0] += nNodeOffset;
+			face.edges[i][1] += nNodeOffset;
+		}
+		meshOverlap.faces.push_back(std::move(face));
+	}
+	meshOverlap.vecSourceFaceIx.insert(meshOverlap.vecSourceFaceIx.end(),
+		meshOverlapNew.vecSourceFaceIx.begin(),
+		meshOverlapNew.vecSourceFaceIx.end());
+	meshOverlap.vecTargetFaceIx.insert(meshOverlap.vecTargetFaceIx.end(),
+		meshOverlapNew.vecTargetFaceIx.begin(),
+		meshOverlapNew.vecTargetFaceIx.end());
+
+	// Calculate Face areas, reusing the areas of previous overlap Faces
+	if (fPrevAreas) {
+		meshOverlap.vecFaceArea.Allocate(nReusedFaces + nNewFaces);
+		for (int f = 0; f < nReusedFaces; f++) {
+			meshOverlap.vecFaceArea[f] = vecReusedArea[f];
+		}
+		for (int f = 0; f < nNewFaces; f++) {
+			meshOverlap.vecFaceArea[nReusedFaces + f] =
+				meshOverlapNew.vecFaceArea[f];
+		}
+
+	} else {
+		meshOverlap.CalculateFaceAreas(false);
+	}
+
+	// Overlap Faces must be ordered by source Face
+	meshOverlap.SortBySourceFace();
+
+	double dTotalAreaOverlap = 0.0;
+	for (int f = 0; f < meshOverlap.vecFaceArea.GetRows(); f++) {
+		dTotalAreaOverlap += meshOverlap.vecFaceArea[f];
+	}
+	Announce("Overlap Mesh Geometric Area: %1.15e (%1.15e)",
+		dTotalAreaOverlap, 4.0 * M_PI);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -21,6 +21,8 @@
 
 #include "GridElements.h"
 
+#include <string>
+
 ///////////////////////////////////////////////////////////////////////////////
 
 ///	<summary>
@@ -29,7 +31,8 @@
 enum OverlapMeshMethod {
 	OverlapMeshMethod_Fuzzy,
 	OverlapMeshMethod_Exact,
-	OverlapMeshMethod_Mixed
+	OverlapMeshMethod_Mixed,
+	OverlapMeshMethod_Clip
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -67,7 +70,19 @@ void GenerateOverlapFace(
 
 ///	<summary>
 ///		Generate the mesh obtained by overlapping meshes meshSource and
-///		meshTarget.
+///		meshTarget.  When built with TEMPEST_MPIOMP and run on more than one
+///		MPI rank, source faces are partitioned spatially over the ranks and
+///		the complete overlap mesh is only returned on rank 0.  If
+///		fTargetMajor is set the search iterates over target faces, flooding
+///		into source faces, and the overlap faces are then reordered by source
+///		face; this keeps the working set in cache when meshTarget is much
+///		larger than meshSource.  With OverlapMeshMethod_Mixed only source
+///		faces for which fuzzy arithmetic fails are regenerated with exact
+///		arithmetic.  If strCheckpointDir is not empty, overlap faces of
+///		completed source faces are periodically written to a checkpoint in
+///		that directory, and also when generation fails, so that a rerun
+///		with the same meshes resumes where the failed run stopped.  The
+///		checkpoint is removed on success.
 ///	</summary>
 void GenerateOverlapMesh_v2(
 	const Mesh & meshSource,
@@ -75,7 +90,76 @@ void GenerateOverlapMesh_v2(
 	Mesh & meshOverlap,
     OverlapMeshMethod method,
 	const bool fAllowNoOverlap,
-    const bool verbose = true
+    const bool verbose = true,
+	const bool fTargetMajor = false,
+	const std::string & strCheckpointDir = ""
+);
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Generate the overlap mesh of meshSource and meshTarget by updating
+///		meshOverlapPrev, the overlap mesh of meshSourcePrev and
+///		meshTargetPrev.  Faces are matched to the previous meshes by their
+///		node coordinates and edge types, independent of their order.
+///		Overlap Faces of source Faces that are unchanged and only overlap
+///		unchanged target Faces are reused; all other source Faces are
+///		overlapped with meshTarget as in GenerateOverlapMesh_v2().  Meshes
+///		with a MultiFaceMap (convexified meshes) are not supported.
+///	</summary>
+void GenerateOverlapMeshIncremental(
+	const Mesh & meshSource,
+	const Mesh & meshTarget,
+	const Mesh & meshSourcePrev,
+	const Mesh & meshTargetPrev,
+	const Mesh & meshOverlapPrev,
+	Mesh & meshOverlap,
+	OverlapMeshMethod method,
+	const bool fAllowNoOverlap,
+	const bool fVerbose = true
+);
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Generate the overlap mesh of two rectilinear meshes, whose Faces are
+///		bounded by meridians and lines of constant latitude and form a
+///		tensor product of latitude and longitude intervals.  The overlap is
+///		computed from the sorted interval edges without polygon clipping,
+///		and overlap Face areas are computed analytically.  Returns false,
+///		leaving meshOverlap unchanged, if either mesh is not rectilinear,
+///		including meshes whose latitude edges are great circle arcs.
+///		Overlap Faces are sorted by source Face, and Face indices are
+///		mapped through vecMultiFaceMap of either mesh.
+///		When built with TEMPEST_MPIOMP the overlap mesh is only returned on
+///		rank 0, as with GenerateOverlapMesh_v2().
+///	</summary>
+bool GenerateOverlapMeshRLL(
+	const Mesh & meshSource,
+	const Mesh & meshTarget,
+	Mesh & meshOverlap
+);
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Generate the overlap mesh of the source Faces vecSourceFaceIx of
+///		meshSource with meshTarget by Sutherland-Hodgman clipping on the
+///		sphere.  Candidate target Faces of each source Face are found with a
+///		FaceBVH and each is clipped against the great circle planes of the
+///		source Face edges.  Pairs of Faces are clipped independently, so
+///		source Faces are processed in parallel without allocation per pair,
+///		and blocks are merged in order of source Face.  Returns false,
+///		leaving meshOverlap unchanged, unless every Face of both meshes is
+///		convex with great circle arc edges and lies within a hemisphere.
+///		This is used by GenerateOverlapMesh_v2() for OverlapMeshMethod_Clip.
+///	</summary>
+bool GenerateOverlapMeshClip(
+	const Mesh & meshSource,
+	const Mesh & meshTarget,
+	const std::vector<int> & vecSourceFaceIx,
+	Mesh & meshOverlap,
+	const bool fAllowNoOverlap
 );
 
 ///////////////////////////////////////////////////////////////////////////////
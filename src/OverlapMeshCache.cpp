@@ -0,0 +1,229 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    OverlapMeshCache.cpp
+///	\author  Paul Ullrich
+///	\version October 14, 2026
+///
+///	<remarks>
+///		Copyright 2026 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "OverlapMeshCache.h"
+#include "Announce.h"
+#include "Exception.h"
+
+#include <cstdio>
+
+///////////////////////////////////////////////////////////////////////////////
+
+OverlapMeshCache::OverlapMeshCache(
+	const std::string & strCacheDir,
+	const Mesh & meshSource,
+	const Mesh & meshTarget,
+	const std::string & strKey
+) :
+	m_nSourceFaces(meshSource.faces.size()),
+	m_nTargetFaces(meshTarget.faces.size())
+{
+	char szFile[64];
+	snprintf(szFile, sizeof(szFile), "ovmesh_%016llx_%016llx_",
+		static_cast<unsigned long long>(meshSource.CalculateHash()),
+		static_cast<unsigned long long>(meshTarget.CalculateHash()));
+
+	m_strFile = strCacheDir;
+	if ((m_strFile.length() != 0) && (m_strFile[m_strFile.length()-1] != '/')) {
+		m_strFile += "/";
+	}
+	m_strFile += szFile;
+	m_strFile += strKey;
+	m_strFile += ".cache";
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool OverlapMeshCache::Read(
+	Mesh & meshOverlap
+) const {
+	if (!Mesh::IsCacheFile(m_strFile)) {
+		return false;
+	}
+
+	try {
+		meshOverlap.ReadCache(m_strFile, Mesh::CacheSection_All);
+
+	} catch(Exception & e) {
+		Announce("WARNING: Overlap mesh cache file \"%s\" is corrupt (%s); "
+			"regenerating", m_strFile.c_str(), e.ToString().c_str());
+		meshOverlap.Clear();
+		return false;
+	}
+
+	// Verify the overlap mesh refers to Faces of the source and target meshes
+	const size_t nOverlapFaces = meshOverlap.faces.size();
+
+	bool fValid =
+		(meshOverlap.vecSourceFaceIx.size() == nOverlapFaces) &&
+		(meshOverlap.vecTargetFaceIx.size() == nOverlapFaces);
+
+	for (size_t i = 0; fValid && (i < nOverlapFaces); i++) {
+		fValid =
+			(meshOverlap.vecSourceFaceIx[i] >= 0) &&
+			(meshOverlap.vecSourceFaceIx[i] < m_nSourceFaces) &&
+			(meshOverlap.vecTargetFaceIx[i] >= 0) &&
+			(meshOverlap.vecTargetFaceIx[i] < m_nTargetFaces);
+	}
+
+	if (!fValid) {
+		Announce("WARNING: Overlap mesh cache file \"%s\" does not match "
+			"the input meshes; regenerating", m_strFile.c_str());
+		meshOverlap.Clear();
+		return false;
+	}
+
+	meshOverlap.type = Mesh::MeshType_Overlap;
+
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OverlapMeshCache::Write(
+	const Mesh & meshOverlap
+) const {
+	std::string strTempFile = m_strFile + ".tmp";
+
+	meshOverlap.WriteCache(strTempFile);
+
+	if (rename(strTempFile.c_str(), m_strFile.c_str()) != 0) {
+		remove(strTempFile.c_str());
+		_EXCEPTION1("Unable to write overlap mesh cache file \"%s\"",
+			m_strFile.c_str());
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+
+///	<summary>
+///		Get the key of a checkpoint, which extends the given key with a hash
+///		of the list of source Faces.
+///	</summary>
+static std::string GetCheckpointKey(
+	const std::vector<int> & vecSourceFaceIx,
+	const std::string & strKey
+) {
+	uint64_t uHash = 14695981039346656037ULL;
+	for (size_t i = 0; i < vecSourceFaceIx.size(); i++) {
+		uHash ^= static_cast<uint64_t>(static_cast<uint32_t>(vecSourceFaceIx[i]));
+		uHash *= 1099511628211ULL;
+	}
+
+	char szHash[32];
+	snprintf(szHash, sizeof(szHash), "_%016llx",
+		static_cast<unsigned long long>(uHash));
+
+	return std::string("checkpoint_") + strKey + szHash;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+OverlapMeshCheckpoint::OverlapMeshCheckpoint(
+	const std::string & strCheckpointDir,
+	const Mesh & meshSource,
+	const Mesh & meshTarget,
+	const std::vector<int> & vecSourceFaceIx,
+	const std::string & strKey
+) :
+	m_cache(
+		strCheckpointDir,
+		meshSource,
+		meshTarget,
+		GetCheckpointKey(vecSourceFaceIx, strKey)),
+	m_nSourceFaceIx(vecSourceFaceIx.size())
+{
+	m_strProgressFile = m_cache.GetCacheFileName() + ".progress";
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+int OverlapMeshCheckpoint::Read(
+	Mesh & meshOverlap
+) const {
+	FILE * fp = fopen(m_strProgressFile.c_str(), "r");
+	if (fp == NULL) {
+		return 0;
+	}
+
+	int nCompleted = 0;
+	int nOverlapFaces = 0;
+	const int nRead = fscanf(fp, "%i %i", &nCompleted, &nOverlapFaces);
+	fclose(fp);
+
+	if ((nRead != 2) ||
+		(nCompleted <= 0) ||
+		(nCompleted > m_nSourceFaceIx) ||
+		(nOverlapFaces < 0)
+	) {
+		Announce("WARNING: Checkpoint progress file \"%s\" is corrupt; "
+			"ignoring", m_strProgressFile.c_str());
+		return 0;
+	}
+
+	if (!m_cache.Read(meshOverlap)) {
+		return 0;
+	}
+
+	// The progress file is written after the overlap mesh, so a mismatch
+	// indicates an interrupted write
+	if (meshOverlap.faces.size() != nOverlapFaces) {
+		Announce("WARNING: Checkpoint file \"%s\" does not match its "
+			"progress file; ignoring",
+			m_cache.GetCacheFileName().c_str());
+		meshOverlap.Clear();
+		return 0;
+	}
+
+	return nCompleted;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OverlapMeshCheckpoint::Write(
+	const Mesh & meshOverlap,
+	int nCompleted
+) const {
+	m_cache.Write(meshOverlap);
+
+	std::string strTempFile = m_strProgressFile + ".tmp";
+
+	FILE * fp = fopen(strTempFile.c_str(), "w");
+	if (fp == NULL) {
+		_EXCEPTION1("Unable to write checkpoint progress file \"%s\"",
+			m_strProgressFile.c_str());
+	}
+	fprintf(fp, "%i %i\n",
+		nCompleted, static_cast<int>(meshOverlap.faces.size()));
+	fclose(fp);
+
+	if (rename(strTempFile.c_str(), m_strProgressFile.c_str()) != 0) {
+		remove(strTempFile.c_str());
+		_EXCEPTION1("Unable to write checkpoint progress file \"%s\"",
+			m_strProgressFile.c_str());
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OverlapMeshCheckpoint::Remove() const {
+	remove(m_strProgressFile.c_str());
+	remove(m_cache.GetCacheFileName().c_str());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
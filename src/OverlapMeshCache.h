@@ -0,0 +1,166 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    OverlapMeshCache.h
+///	\author  Paul Ullrich
+///	\version October 14, 2026
+///
+///	<remarks>
+///		Copyright 2026 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#ifndef _OVERLAPMESHCACHE_H_
+#define _OVERLAPMESHCACHE_H_
+
+#include "GridElements.h"
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A content-addressed cache of overlap meshes.  Overlap meshes are
+///		stored as native binary mesh cache files in a cache directory, named
+///		by the hashes of the source and target meshes and a key describing
+///		the options used to generate the overlap, so that maps between the
+///		same pair of meshes share a single overlap mesh.
+///	</summary>
+class OverlapMeshCache {
+
+public:
+	///	<summary>
+	///		Constructor.  The cache file name is determined from the source
+	///		and target meshes and the key.
+	///	</summary>
+	OverlapMeshCache(
+		const std::string & strCacheDir,
+		const Mesh & meshSource,
+		const Mesh & meshTarget,
+		const std::string & strKey
+	);
+
+public:
+	///	<summary>
+	///		Get the name of the cache file.
+	///	</summary>
+	const std::string & GetCacheFileName() const {
+		return m_strFile;
+	}
+
+	///	<summary>
+	///		Read the overlap mesh from the cache.  Returns false if there is
+	///		no cache file or it does not describe an overlap of the source and
+	///		target meshes.
+	///	</summary>
+	bool Read(
+		Mesh & meshOverlap
+	) const;
+
+	///	<summary>
+	///		Write the overlap mesh to the cache.  The file is written under a
+	///		temporary name and then renamed, so that concurrent runs never
+	///		read a partially written file.
+	///	</summary>
+	void Write(
+		const Mesh & meshOverlap
+	) const;
+
+protected:
+	///	<summary>
+	///		Name of the cache file.
+	///	</summary>
+	std::string m_strFile;
+
+	///	<summary>
+	///		Number of Faces in the source mesh.
+	///	</summary>
+	int m_nSourceFaces;
+
+	///	<summary>
+	///		Number of Faces in the target mesh.
+	///	</summary>
+	int m_nTargetFaces;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A checkpoint of a partially generated overlap mesh, which holds the
+///		overlap Faces of a leading range of entries of a list of source
+///		Faces.  The overlap mesh is stored as an OverlapMeshCache file,
+///		keyed additionally by the list of source Faces, with a small
+///		progress file recording the number of entries completed.
+///	</summary>
+class OverlapMeshCheckpoint {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	OverlapMeshCheckpoint(
+		const std::string & strCheckpointDir,
+		const Mesh & meshSource,
+		const Mesh & meshTarget,
+		const std::vector<int> & vecSourceFaceIx,
+		const std::string & strKey
+	);
+
+public:
+	///	<summary>
+	///		Get the name of the checkpoint file.
+	///	</summary>
+	const std::string & GetCheckpointFileName() const {
+		return m_cache.GetCacheFileName();
+	}
+
+	///	<summary>
+	///		Read the overlap mesh from the checkpoint and return the number
+	///		of entries of the list of source Faces it covers, or 0 if there
+	///		is no valid checkpoint.
+	///	</summary>
+	int Read(
+		Mesh & meshOverlap
+	) const;
+
+	///	<summary>
+	///		Write the overlap mesh of the first nCompleted entries of the
+	///		list of source Faces to the checkpoint.
+	///	</summary>
+	void Write(
+		const Mesh & meshOverlap,
+		int nCompleted
+	) const;
+
+	///	<summary>
+	///		Remove the checkpoint files.
+	///	</summary>
+	void Remove() const;
+
+protected:
+	///	<summary>
+	///		Cache holding the overlap mesh.
+	///	</summary>
+	OverlapMeshCache m_cache;
+
+	///	<summary>
+	///		Name of the progress file.
+	///	</summary>
+	std::string m_strProgressFile;
+
+	///	<summary>
+	///		Number of entries in the list of source Faces.
+	///	</summary>
+	int m_nSourceFaceIx;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif
+
@@ -0,0 +1,234 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    OverlapMeshStatistics.cpp
+///	\author  Paul Ullrich
+///	\version October 14, 2026
+///
+///	<remarks>
+///		Copyright 2026 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "OverlapMeshStatistics.h"
+
+#if defined(OVERLAPMESH_STATISTICS)
+
+#include "Announce.h"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Names of counters, histograms and phases in the report.
+///	</summary>
+static const char * s_szCounterNames[OverlapMeshStatistics::CounterCount] = {
+	"edge_intersection_tests",
+	"semiclip_intersection_tests",
+	"polygon_clips",
+	"source_faces_inside_target",
+	"node_key_lookups",
+	"node_coordinate_lookups"
+};
+
+static const char * s_szHistogramNames[OverlapMeshStatistics::HistogramCount] = {
+	"overlap_faces_per_source_face",
+	"target_faces_tested_per_source_face",
+	"seed_search_walk_length",
+	"path_tracing_steps",
+	"find_face_near_node_walk_length"
+};
+
+static const char * s_szPhaseNames[OverlapMeshStatistics::PhaseCount] = {
+	"seed_search",
+	"overlap_faces",
+	"node_numbering",
+	"face_areas"
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Mutex protecting the registry of thread statistics.
+///	</summary>
+static std::mutex s_mutexRegistry;
+
+///	<summary>
+///		Statistics of all live threads.
+///	</summary>
+static std::vector<OverlapMeshStatistics *> s_vecRegistry;
+
+///	<summary>
+///		Statistics of threads that have exited.
+///	</summary>
+static OverlapMeshStatistics s_statsRetired;
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Statistics of one thread, registered for the lifetime of the thread.
+///	</summary>
+struct OverlapMeshThreadStatistics {
+
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	OverlapMeshThreadStatistics() {
+		std::lock_guard<std::mutex> lock(s_mutexRegistry);
+		s_vecRegistry.push_back(&stats);
+	}
+
+	///	<summary>
+	///		Destructor.
+	///	</summary>
+	~OverlapMeshThreadStatistics() {
+		std::lock_guard<std::mutex> lock(s_mutexRegistry);
+		s_statsRetired.Add(stats);
+		s_vecRegistry.erase(
+			std::remove(s_vecRegistry.begin(), s_vecRegistry.end(), &stats),
+			s_vecRegistry.end());
+	}
+
+	///	<summary>
+	///		Statistics of this thread.
+	///	</summary>
+	OverlapMeshStatistics stats;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+OverlapMeshStatistics & OverlapMeshStatistics::Local() {
+	static thread_local OverlapMeshThreadStatistics s_statsThread;
+	return s_statsThread.stats;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OverlapMeshStatistics::Reset() {
+	std::lock_guard<std::mutex> lock(s_mutexRegistry);
+	for (size_t i = 0; i < s_vecRegistry.size(); i++) {
+		s_vecRegistry[i]->Clear();
+	}
+	s_statsRetired.Clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OverlapMeshStatistics::Report() {
+
+	OverlapMeshStatistics stats;
+	{
+		std::lock_guard<std::mutex> lock(s_mutexRegistry);
+		for (size_t i = 0; i < s_vecRegistry.size(); i++) {
+			stats.Add(*(s_vecRegistry[i]));
+		}
+		stats.Add(s_statsRetired);
+	}
+
+	AnnounceStartBlock("Overlap mesh statistics");
+
+	// Phases are timed on the thread calling GenerateOverlapMesh
+	for (int p = 0; p < PhaseCount; p++) {
+		if (stats.m_dPhaseTime[p] == 0.0) {
+			continue;
+		}
+		Announce("%s: %1.3f s", s_szPhaseNames[p], stats.m_dPhaseTime[p]);
+	}
+
+	for (int c = 0; c < CounterCount; c++) {
+		Announce("%s: %lli", s_szCounterNames[c], stats.m_nCounters[c]);
+		AnnounceCounter(s_szCounterNames[c],
+			static_cast<double>(stats.m_nCounters[c]));
+	}
+
+	for (int h = 0; h < HistogramCount; h++) {
+		const long long nSamples = stats.m_nHistogramSamples[h];
+		if (nSamples == 0) {
+			continue;
+		}
+
+		AnnounceStartBlock("%s: %lli samples, mean %1.2f, max %lli",
+			s_szHistogramNames[h],
+			nSamples,
+			static_cast<double>(stats.m_nHistogramSum[h])
+				/ static_cast<double>(nSamples),
+			stats.m_nHistogramMax[h]);
+
+		for (int b = 0; b < HistogramBins; b++) {
+			const long long nCount = stats.m_nHistogramBins[h][b];
+			if (nCount == 0) {
+				continue;
+			}
+			if (b == 0) {
+				Announce("[0]: %lli", nCount);
+			} else if (b == HistogramBins-1) {
+				Announce("[%lli, ...): %lli", 1LL << (b-1), nCount);
+			} else if (b == 1) {
+				Announce("[1]: %lli", nCount);
+			} else {
+				Announce("[%lli, %lli]: %lli",
+					1LL << (b-1), (1LL << b) - 1LL, nCount);
+			}
+		}
+
+		AnnounceEndBlock(NULL);
+
+		AnnounceCounter(s_szHistogramNames[h],
+			static_cast<double>(stats.m_nHistogramSum[h]));
+	}
+
+	AnnounceEndBlock(NULL);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OverlapMeshStatistics::Clear() {
+	for (int c = 0; c < CounterCount; c++) {
+		m_nCounters[c] = 0;
+	}
+	for (int h = 0; h < HistogramCount; h++) {
+		for (int b = 0; b < HistogramBins; b++) {
+			m_nHistogramBins[h][b] = 0;
+		}
+		m_nHistogramSamples[h] = 0;
+		m_nHistogramSum[h] = 0;
+		m_nHistogramMax[h] = 0;
+	}
+	for (int p = 0; p < PhaseCount; p++) {
+		m_dPhaseTime[p] = 0.0;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OverlapMeshStatistics::Add(
+	const OverlapMeshStatistics & stats
+) {
+	for (int c = 0; c < CounterCount; c++) {
+		m_nCounters[c] += stats.m_nCounters[c];
+	}
+	for (int h = 0; h < HistogramCount; h++) {
+		for (int b = 0; b < HistogramBins; b++) {
+			m_nHistogramBins[h][b] += stats.m_nHistogramBins[h][b];
+		}
+		m_nHistogramSamples[h] += stats.m_nHistogramSamples[h];
+		m_nHistogramSum[h] += stats.m_nHistogramSum[h];
+		m_nHistogramMax[h] =
+			std::max(m_nHistogramMax[h], stats.m_nHistogramMax[h]);
+	}
+	for (int p = 0; p < PhaseCount; p++) {
+		m_dPhaseTime[p] += stats.m_dPhaseTime[p];
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif
+
@@ -0,0 +1,323 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    OverlapMeshStatistics.h
+///	\author  Paul Ullrich
+///	\version October 14, 2026
+///
+///	<remarks>
+///		Copyright 2026 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#ifndef _OVERLAPMESHSTATISTICS_H_
+#define _OVERLAPMESHSTATISTICS_H_
+
+#include "Defines.h"
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Instrumentation of overlap mesh generation.  If OVERLAPMESH_STATISTICS is
+// defined (in Defines.h or on the command line) the macros below record
+// counters, histograms and phase timings in storage local to each thread,
+// which are combined and reported at the end of GenerateOverlapMesh.
+// Otherwise the macros expand to nothing.
+//
+// OVERLAPMESH_STAT_COUNT(counter)
+//     Increment an OverlapMeshStatistics::Counter.
+//
+// OVERLAPMESH_STAT_WALK(name, histogram)
+// OVERLAPMESH_STAT_STEP(name)
+//     Declare a walk, which counts the number of steps taken until the end
+//     of the enclosing scope and then adds this number to the histogram.
+//
+// OVERLAPMESH_STAT_PHASE(phase)
+// OVERLAPMESH_STAT_PHASE_STOP(phase)
+//     Add the wall time until OVERLAPMESH_STAT_PHASE_STOP, or otherwise until
+//     the end of the enclosing scope, to the phase.
+//
+#if defined(OVERLAPMESH_STATISTICS)
+
+#include <chrono>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Counters, histograms and phase timings of overlap mesh generation
+///		for one thread.
+///	</summary>
+class OverlapMeshStatistics {
+
+public:
+	///	<summary>
+	///		Counted operations.
+	///	</summary>
+	enum Counter {
+		Counter_EdgeIntersectionTests,
+		Counter_SemiClipIntersectionTests,
+		Counter_PolygonClips,
+		Counter_SourceFacesInsideTarget,
+		Counter_NodeKeyLookups,
+		Counter_NodeCoordinateLookups,
+		CounterCount
+	};
+
+	///	<summary>
+	///		Histogrammed quantities.
+	///	</summary>
+	enum Histogram {
+		Histogram_OverlapFacesPerSourceFace,
+		Histogram_TargetFacesTestedPerSourceFace,
+		Histogram_SeedSearchWalkLength,
+		Histogram_PathTracingSteps,
+		Histogram_FindFaceNearNodeWalkLength,
+		HistogramCount
+	};
+
+	///	<summary>
+	///		Timed phases.
+	///	</summary>
+	enum Phase {
+		Phase_SeedSearch,
+		Phase_OverlapFaces,
+		Phase_NodeNumbering,
+		Phase_FaceAreas,
+		PhaseCount
+	};
+
+	///	<summary>
+	///		Number of histogram bins.  Bin 0 holds the value 0 and bin k
+	///		holds values in [2^(k-1), 2^k), with the last bin unbounded.
+	///	</summary>
+	static const int HistogramBins = 24;
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	OverlapMeshStatistics() {
+		Clear();
+	}
+
+	///	<summary>
+	///		Get the statistics of the calling thread.
+	///	</summary>
+	static OverlapMeshStatistics & Local();
+
+	///	<summary>
+	///		Clear the statistics of all threads.
+	///	</summary>
+	static void Reset();
+
+	///	<summary>
+	///		Combine the statistics of all threads and report them with
+	///		Announce().  Totals are also added to the innermost Announce
+	///		block with AnnounceCounter().
+	///	</summary>
+	static void Report();
+
+public:
+	///	<summary>
+	///		Clear the statistics of this thread.
+	///	</summary>
+	void Clear();
+
+	///	<summary>
+	///		Add the statistics of another thread.
+	///	</summary>
+	void Add(const OverlapMeshStatistics & stats);
+
+	///	<summary>
+	///		Increment a counter.
+	///	</summary>
+	inline void Count(Counter counter) {
+		m_nCounters[counter]++;
+	}
+
+	///	<summary>
+	///		Add a value to a histogram.
+	///	</summary>
+	inline void Sample(Histogram histogram, long long nValue) {
+		int iBin = 0;
+		for (long long n = nValue; (n > 0) && (iBin < HistogramBins-1); n >>= 1) {
+			iBin++;
+		}
+		m_nHistogramBins[histogram][iBin]++;
+		m_nHistogramSamples[histogram]++;
+		m_nHistogramSum[histogram] += nValue;
+		if (nValue > m_nHistogramMax[histogram]) {
+			m_nHistogramMax[histogram] = nValue;
+		}
+	}
+
+	///	<summary>
+	///		Add wall time to a phase.
+	///	</summary>
+	inline void AddPhaseTime(Phase phase, double dSeconds) {
+		m_dPhaseTime[phase] += dSeconds;
+	}
+
+private:
+	///	<summary>
+	///		Counters.
+	///	</summary>
+	long long m_nCounters[CounterCount];
+
+	///	<summary>
+	///		Histogram bins, number of samples, sum and maximum of samples.
+	///	</summary>
+	long long m_nHistogramBins[HistogramCount][HistogramBins];
+	long long m_nHistogramSamples[HistogramCount];
+	long long m_nHistogramSum[HistogramCount];
+	long long m_nHistogramMax[HistogramCount];
+
+	///	<summary>
+	///		Wall time of each phase, in seconds.
+	///	</summary>
+	double m_dPhaseTime[PhaseCount];
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A count of steps added to a histogram on destruction.
+///	</summary>
+class OverlapMeshStatisticsWalk {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	explicit OverlapMeshStatisticsWalk(
+		OverlapMeshStatistics::Histogram histogram
+	) :
+		m_histogram(histogram),
+		m_nSteps(0)
+	{ }
+
+	///	<summary>
+	///		Destructor.
+	///	</summary>
+	~OverlapMeshStatisticsWalk() {
+		OverlapMeshStatistics::Local().Sample(m_histogram, m_nSteps);
+	}
+
+	///	<summary>
+	///		Take a step.
+	///	</summary>
+	inline void Step() {
+		m_nSteps++;
+	}
+
+private:
+	///	<summary>
+	///		Histogram receiving the number of steps.
+	///	</summary>
+	OverlapMeshStatistics::Histogram m_histogram;
+
+	///	<summary>
+	///		Number of steps taken.
+	///	</summary>
+	long long m_nSteps;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A wall clock timer added to a phase on destruction.
+///	</summary>
+class OverlapMeshStatisticsPhase {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	explicit OverlapMeshStatisticsPhase(
+		OverlapMeshStatistics::Phase phase
+	) :
+		m_phase(phase),
+		m_fStopped(false),
+		m_tpStart(std::chrono::steady_clock::now())
+	{ }
+
+	///	<summary>
+	///		Destructor.
+	///	</summary>
+	~OverlapMeshStatisticsPhase() {
+		Stop();
+	}
+
+	///	<summary>
+	///		Add the elapsed time to the phase, if not already stopped.
+	///	</summary>
+	void Stop() {
+		if (m_fStopped) {
+			return;
+		}
+		m_fStopped = true;
+
+		OverlapMeshStatistics::Local().AddPhaseTime(m_phase,
+			std::chrono::duration<double>(
+				std::chrono::steady_clock::now() - m_tpStart).count());
+	}
+
+private:
+	///	<summary>
+	///		Phase receiving the elapsed time.
+	///	</summary>
+	OverlapMeshStatistics::Phase m_phase;
+
+	///	<summary>
+	///		Flag indicating the elapsed time has been added.
+	///	</summary>
+	bool m_fStopped;
+
+	///	<summary>
+	///		Start time.
+	///	</summary>
+	std::chrono::steady_clock::time_point m_tpStart;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#define OVERLAPMESH_STAT_COUNT(counter) \
+	OverlapMeshStatistics::Local().Count(OverlapMeshStatistics::counter)
+
+#define OVERLAPMESH_STAT_WALK(name, histogram) \
+	OverlapMeshStatisticsWalk name(OverlapMeshStatistics::histogram)
+
+#define OVERLAPMESH_STAT_STEP(name) \
+	name.Step()
+
+#define OVERLAPMESH_STAT_PHASE(phase) \
+	OverlapMeshStatisticsPhase _statPhase##phase(OverlapMeshStatistics::phase)
+
+#define OVERLAPMESH_STAT_PHASE_STOP(phase) \
+	_statPhase##phase.Stop()
+
+#define OVERLAPMESH_STAT_RESET() \
+	OverlapMeshStatistics::Reset()
+
+#define OVERLAPMESH_STAT_REPORT() \
+	OverlapMeshStatistics::Report()
+
+#else
+
+#define OVERLAPMESH_STAT_COUNT(counter)
+#define OVERLAPMESH_STAT_WALK(name, histogram)
+#define OVERLAPMESH_STAT_STEP(name)
+#define OVERLAPMESH_STAT_PHASE(phase)
+#define OVERLAPMESH_STAT_PHASE_STOP(phase)
+#define OVERLAPMESH_STAT_RESET()
+#define OVERLAPMESH_STAT_REPORT()
+
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif
+
@@ -0,0 +1,108 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    PerformanceOptions.h
+///	\author  Paul Ullrich
+///	\version October 15, 2026
+///
+///	<remarks>
+///		Copyright 2026 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#ifndef _PERFORMANCEOPTIONS_H_
+#define _PERFORMANCEOPTIONS_H_
+
+#include <string>
+#include <cstddef>
+#include <cstdlib>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Process-wide performance options.  These are set from the shared
+///		--mem_limit, --io_buffer_mb and --profile_out parameters accepted
+///		by every tool, and may also be set directly by library users.
+///	</summary>
+struct PerformanceOptions {
+
+	///	<summary>
+	///		Default constructor.
+	///	</summary>
+	PerformanceOptions() :
+		sMemoryLimitBytes(0),
+		sIOBufferBytes(0)
+	{ }
+
+	///	<summary>
+	///		Memory available for assembling map weights, in bytes.  When
+	///		the entries of a map exceed this they are spilled to disk.
+	///		Zero for no limit.
+	///	</summary>
+	size_t sMemoryLimitBytes;
+
+	///	<summary>
+	///		Size of each buffer used for chunked file input, in bytes.
+	///		Zero for the defaults in Defines.h.
+	///	</summary>
+	size_t sIOBufferBytes;
+
+	///	<summary>
+	///		File to which the timer summary is written, or empty.
+	///	</summary>
+	std::string strProfileFile;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Get the process-wide performance options.
+///	</summary>
+inline PerformanceOptions & GetPerformanceOptions() {
+	static PerformanceOptions s_opts;
+	return s_opts;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Get the number of items of sItemBytes bytes that fit in one I/O
+///		buffer, or sDefaultItems if the I/O buffer size has not been set.
+///	</summary>
+inline size_t GetIOBufferItems(
+	size_t sDefaultItems,
+	size_t sItemBytes
+) {
+	const size_t sBytes = GetPerformanceOptions().sIOBufferBytes;
+	if (sBytes == 0) {
+		return sDefaultItems;
+	}
+	if (sBytes < sItemBytes) {
+		return 1;
+	}
+	return (sBytes / sItemBytes);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Get the directory for temporary files when map weights are spilled
+///		because of the memory limit and no directory was given:  the value
+///		of TMPDIR, or /tmp.
+///	</summary>
+inline std::string GetDefaultSpillDirectory() {
+	const char * szTmpDir = getenv("TMPDIR");
+	if ((szTmpDir != NULL) && (szTmpDir[0] != '\0')) {
+		return std::string(szTmpDir);
+	}
+	return std::string("/tmp");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif
+
@@ -0,0 +1,191 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    PointKDTree.cpp
+///	\author  Paul Ullrich
+///	\version October 14, 2026
+///
+///	<remarks>
+///		Copyright 2026 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "PointKDTree.h"
+
+#include <algorithm>
+#include <cfloat>
+
+///////////////////////////////////////////////////////////////////////////////
+
+void PointKDTree::Build(
+	const NodeVector & vecNodes
+) {
+	m_vecPoints.resize(vecNodes.size());
+
+	for (size_t i = 0; i < vecNodes.size(); i++) {
+		m_vecPoints[i].dX[0] = vecNodes[i].x;
+		m_vecPoints[i].dX[1] = vecNodes[i].y;
+		m_vecPoints[i].dX[2] = vecNodes[i].z;
+		m_vecPoints[i].ix = static_cast<int>(i);
+		m_vecPoints[i].iAxis = 0;
+	}
+
+	BuildSubtree(0, m_vecPoints.size());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void PointKDTree::BuildSubtree(
+	size_t ixBegin,
+	size_t ixEnd
+) {
+	if (ixEnd - ixBegin <= LeafSize) {
+		return;
+	}
+
+	// Split along the axis of greatest extent
+	double dMin[3] = { DBL_MAX, DBL_MAX, DBL_MAX };
+	double dMax[3] = { -DBL_MAX, -DBL_MAX, -DBL_MAX };
+
+	for (size_t i = ixBegin; i < ixEnd; i++) {
+		for (int d = 0; d < 3; d++) {
+			dMin[d] = std::min(dMin[d], m_vecPoints[i].dX[d]);
+			dMax[d] = std::max(dMax[d], m_vecPoints[i].dX[d]);
+		}
+	}
+
+	int iAxis = 0;
+	for (int d = 1; d < 3; d++) {
+		if (dMax[d] - dMin[d] > dMax[iAxis] - dMin[iAxis]) {
+			iAxis = d;
+		}
+	}
+
+	// Place the median point in the middle of the range
+	const size_t ixMid = ixBegin + (ixEnd - ixBegin) / 2;
+
+	std::nth_element(
+		m_vecPoints.begin() + ixBegin,
+		m_vecPoints.begin() + ixMid,
+		m_vecPoints.begin() + ixEnd,
+		[iAxis](const PackedPoint & a, const PackedPoint & b) {
+			return (a.dX[iAxis] < b.dX[iAxis]);
+		});
+
+	m_vecPoints[ixMid].iAxis = iAxis;
+
+	BuildSubtree(ixBegin, ixMid);
+	BuildSubtree(ixMid + 1, ixEnd);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void PointKDTree::FindNearestInSubtree(
+	size_t ixBegin,
+	size_t ixEnd,
+	const double dX[3],
+	double & dNearestDistSq,
+	int & ixNearest
+) const {
+
+	// Small subtrees are searched linearly
+	if (ixEnd - ixBegin <= LeafSize) {
+		for (size_t i = ixBegin; i < ixEnd; i++) {
+			const PackedPoint & point = m_vecPoints[i];
+
+			const double dDx = dX[0] - point.dX[0];
+			const double dDy = dX[1] - point.dX[1];
+			const double dDz = dX[2] - point.dX[2];
+
+			const double dDistSq = dDx * dDx + dDy * dDy + dDz * dDz;
+
+			if ((dDistSq < dNearestDistSq) ||
+			    ((dDistSq == dNearestDistSq) && (point.ix < ixNearest))
+			) {
+				dNearestDistSq = dDistSq;
+				ixNearest = point.ix;
+			}
+		}
+		return;
+	}
+
+	const size_t ixMid = ixBegin + (ixEnd - ixBegin) / 2;
+
+	const PackedPoint & point = m_vecPoints[ixMid];
+
+	const double dDx = dX[0] - point.dX[0];
+	const double dDy = dX[1] - point.dX[1];
+	const double dDz = dX[2] - point.dX[2];
+
+	const double dDistSq = dDx * dDx + dDy * dDy + dDz * dDz;
+
+	if ((dDistSq < dNearestDistSq) ||
+	    ((dDistSq == dNearestDistSq) && (point.ix < ixNearest))
+	) {
+		dNearestDistSq = dDistSq;
+		ixNearest = point.ix;
+	}
+
+	// Search the side of the splitting plane containing the query first.
+	// Points on the far side can only be equally near if the distance to
+	// the plane does not exceed the best distance found.
+	const double dPlaneDist = dX[point.iAxis] - point.dX[point.iAxis];
+
+	if (dPlaneDist < 0.0) {
+		FindNearestInSubtree(
+			ixBegin, ixMid, dX, dNearestDistSq, ixNearest);
+
+		if (dPlaneDist * dPlaneDist <= dNearestDistSq) {
+			FindNearestInSubtree(
+				ixMid + 1, ixEnd, dX, dNearestDistSq, ixNearest);
+		}
+
+	} else {
+		FindNearestInSubtree(
+			ixMid + 1, ixEnd, dX, dNearestDistSq, ixNearest);
+
+		if (dPlaneDist * dPlaneDist <= dNearestDistSq) {
+			FindNearestInSubtree(
+				ixBegin, ixMid, dX, dNearestDistSq, ixNearest);
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+int PointKDTree::FindNearest(
+	const Node & node
+) const {
+	const double dX[3] = { node.x, node.y, node.z };
+
+	double dNearestDistSq = DBL_MAX;
+	int ixNearest = InvalidIndex;
+
+	FindNearestInSubtree(
+		0, m_vecPoints.size(), dX, dNearestDistSq, ixNearest);
+
+	return ixNearest;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void PointKDTree::FindNearest(
+	const NodeVector & vecQuery,
+	std::vector<int> & vecNearest
+) const {
+	const int nQueries = vecQuery.size();
+
+	vecNearest.resize(nQueries);
+
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < nQueries; i++) {
+		vecNearest[i] = FindNearest(vecQuery[i]);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,144 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    PointKDTree.h
+///	\author  Paul Ullrich
+///	\version October 14, 2026
+///
+///	<remarks>
+///		Copyright 2026 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#ifndef _POINTKDTREE_H_
+#define _POINTKDTREE_H_
+
+#include "GridElements.h"
+
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		An implicit kd-tree over a fixed set of points in 3D Cartesian
+///		geometry.  Points are stored in a single packed array, with the
+///		splitting point of each subtree at the middle of its range, so no
+///		per-node allocation is needed.  Queries do not modify the tree and
+///		may be issued concurrently from multiple threads.
+///	</summary>
+class PointKDTree {
+
+public:
+	///	<summary>
+	///		Returned by FindNearest() when the tree is empty.
+	///	</summary>
+	static const int InvalidIndex = (-1);
+
+	///	<summary>
+	///		Maximum number of points in a subtree that is searched linearly.
+	///	</summary>
+	static const int LeafSize = 8;
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	PointKDTree() { }
+
+	///	<summary>
+	///		Construct the tree from a vector of points.  The index returned by
+	///		FindNearest() is the position of the point in this vector.
+	///	</summary>
+	PointKDTree(
+		const NodeVector & vecNodes
+	) {
+		Build(vecNodes);
+	}
+
+public:
+	///	<summary>
+	///		Build the tree from a vector of points, replacing the existing
+	///		contents.
+	///	</summary>
+	void Build(
+		const NodeVector & vecNodes
+	);
+
+	///	<summary>
+	///		Remove all points from the tree.
+	///	</summary>
+	void Clear() {
+		m_vecPoints.clear();
+	}
+
+	///	<summary>
+	///		Number of points in the tree.
+	///	</summary>
+	size_t size() const {
+		return m_vecPoints.size();
+	}
+
+	///	<summary>
+	///		Find the index of the point nearest to the given location.  If
+	///		several points are equally near the lowest index is returned, so
+	///		the result does not depend on the structure of the tree.
+	///	</summary>
+	int FindNearest(
+		const Node & node
+	) const;
+
+	///	<summary>
+	///		Find the index of the point nearest to each of the given
+	///		locations.  Queries are distributed over OpenMP threads.
+	///	</summary>
+	void FindNearest(
+		const NodeVector & vecQuery,
+		std::vector<int> & vecNearest
+	) const;
+
+private:
+	///	<summary>
+	///		A point in the tree, along with its original index and the
+	///		splitting axis of the subtree it is the root of.
+	///	</summary>
+	struct PackedPoint {
+		double dX[3];
+		int ix;
+		int iAxis;
+	};
+
+	///	<summary>
+	///		Recursively build the subtree over points [ixBegin, ixEnd).
+	///	</summary>
+	void BuildSubtree(
+		size_t ixBegin,
+		size_t ixEnd
+	);
+
+	///	<summary>
+	///		Recursively search the subtree over points [ixBegin, ixEnd),
+	///		updating the nearest point found so far.
+	///	</summary>
+	void FindNearestInSubtree(
+		size_t ixBegin,
+		size_t ixEnd,
+		const double dX[3],
+		double & dNearestDistSq,
+		int & ixNearest
+	) const;
+
+private:
+	///	<summary>
+	///		Points in kd-tree order.
+	///	</summary>
+	std::vector<PackedPoint> m_vecPoints;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif
+
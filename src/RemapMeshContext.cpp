@@ -0,0 +1,172 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    RemapMeshContext.cpp
+///	\author  Paul Ullrich
+///	\version October 14, 2026
+///
+///	<remarks>
+///		Copyright 2026 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "RemapMeshContext.h"
+#include "FiniteElementTools.h"
+#include "FiniteVolumeTools.h"
+#include "Announce.h"
+#include "Exception.h"
+
+///////////////////////////////////////////////////////////////////////////////
+
+RemapMeshContext::RemapMeshContext(
+	const std::string & strMeshFile,
+	bool fConcave
+) :
+	m_fConcave(fConcave),
+	m_fHasEdgeMap(false),
+	m_fHasReverseNodeArray(false),
+	m_fHasFaceAreas(false),
+	m_fHasMeshForOverlap(false),
+	m_fHasFaceCentroidTree(false),
+	m_dTotalArea(0.0)
+{
+	m_mesh.Read(strMeshFile);
+	m_mesh.RemoveZeroEdges();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+RemapMeshContext::RemapMeshContext(
+	const Mesh & mesh,
+	bool fConcave
+) :
+	m_mesh(mesh),
+	m_fConcave(fConcave),
+	m_fHasEdgeMap(false),
+	m_fHasReverseNodeArray(false),
+	m_fHasFaceAreas(false),
+	m_fHasMeshForOverlap(false),
+	m_fHasFaceCentroidTree(false),
+	m_dTotalArea(0.0)
+{ }
+
+///////////////////////////////////////////////////////////////////////////////
+
+void RemapMeshContext::RequireEdgeMap() {
+	if (!m_fHasEdgeMap) {
+		m_mesh.ConstructEdgeMap(false);
+		m_fHasEdgeMap = true;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void RemapMeshContext::RequireReverseNodeArray() {
+	if (!m_fHasReverseNodeArray) {
+		m_mesh.ConstructReverseNodeArray();
+		m_fHasReverseNodeArray = true;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+double RemapMeshContext::RequireFaceAreas() {
+	if (!m_fHasFaceAreas) {
+		m_dTotalArea = m_mesh.CalculateFaceAreas(m_fConcave);
+		m_vecGeometricFaceArea = m_mesh.vecFaceArea;
+		m_fHasFaceAreas = true;
+
+	} else {
+		m_mesh.vecFaceArea = m_vecGeometricFaceArea;
+	}
+
+	return m_dTotalArea;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+Mesh & RemapMeshContext::GetMeshForOverlap() {
+	if (!m_fConcave) {
+		RequireEdgeMap();
+		return m_mesh;
+	}
+
+	if (!m_fHasMeshForOverlap) {
+		ConvexifyMesh(m_mesh, m_meshConvex, false);
+		m_meshConvex.ConstructEdgeMap(false);
+		m_fHasMeshForOverlap = true;
+	}
+
+	return m_meshConvex;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+const NodeVector & RemapMeshContext::GetFaceCentroids() {
+	const int nFaces = m_mesh.faces.size();
+
+	if (m_vecFaceCentroids.size() != nFaces) {
+		m_vecFaceCentroids.resize(nFaces);
+
+#pragma omp parallel for schedule(static)
+		for (int i = 0; i < nFaces; i++) {
+			m_vecFaceCentroids[i] =
+				GetFaceCentroid(m_mesh.faces[i], m_mesh.nodes);
+		}
+	}
+
+	return m_vecFaceCentroids;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+const PointKDTree & RemapMeshContext::GetFaceCentroidTree() {
+	if (!m_fHasFaceCentroidTree) {
+		m_kdFaceCentroids.Build(GetFaceCentroids());
+		m_fHasFaceCentroidTree = true;
+	}
+
+	return m_kdFaceCentroids;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+double RemapMeshContext::GetGLLMetaData(
+	int nP,
+	bool fNoBubble,
+	DataArray3D<int> & dataGLLNodes,
+	DataArray3D<double> & dataGLLJacobian
+) {
+	GLLMetaDataKey key(nP, fNoBubble);
+
+	std::map<GLLMetaDataKey, GLLMetaData>::iterator iter =
+		m_mapGLLMetaData.find(key);
+
+	if (iter == m_mapGLLMetaData.end()) {
+		iter = m_mapGLLMetaData.insert(
+			std::pair<GLLMetaDataKey, GLLMetaData>(key, GLLMetaData())).first;
+
+		iter->second.dNumericalArea =
+			GenerateMetaData(
+				m_mesh,
+				nP,
+				fNoBubble,
+				iter->second.dataGLLNodes,
+				iter->second.dataGLLJacobian);
+
+	} else {
+		Announce("Reusing meta data (np %i)", nP);
+	}
+
+	dataGLLNodes = iter->second.dataGLLNodes;
+	dataGLLJacobian = iter->second.dataGLLJacobian;
+
+	return iter->second.dNumericalArea;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
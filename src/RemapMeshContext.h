@@ -0,0 +1,194 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    RemapMeshContext.h
+///	\author  Paul Ullrich
+///	\version October 14, 2026
+///
+///	<remarks>
+///		Copyright 2026 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#ifndef _REMAPMESHCONTEXT_H_
+#define _REMAPMESHCONTEXT_H_
+
+#include "GridElements.h"
+#include "DataArray1D.h"
+#include "DataArray3D.h"
+#include "PointKDTree.h"
+#include "FiniteVolumeStencilCache.h"
+
+#include <map>
+#include <string>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A Mesh together with structures derived from it that are needed for
+///		overlap mesh and map generation.  Each structure is built the first
+///		time it is requested and is then reused, so that an application
+///		generating many maps from the same Mesh pays for each only once.
+///		The Mesh must not be modified after any structure has been built.
+///		A RemapMeshContext is not safe for concurrent use by several threads.
+///	</summary>
+class RemapMeshContext {
+
+public:
+	///	<summary>
+	///		Construct the context by reading a Mesh from file.  Zero-length
+	///		edges are removed.
+	///	</summary>
+	RemapMeshContext(
+		const std::string & strMeshFile,
+		bool fConcave = false
+	);
+
+	///	<summary>
+	///		Construct the context from a copy of a Mesh.
+	///	</summary>
+	RemapMeshContext(
+		const Mesh & mesh,
+		bool fConcave = false
+	);
+
+public:
+	///	<summary>
+	///		Get the Mesh.  Face areas of the Mesh may be modified by map
+	///		generation and are restored by RequireFaceAreas().
+	///	</summary>
+	Mesh & GetMesh() {
+		return m_mesh;
+	}
+
+	///	<summary>
+	///		Check if the Mesh contains concave Faces.
+	///	</summary>
+	bool IsConcave() const {
+		return m_fConcave;
+	}
+
+	///	<summary>
+	///		Ensure the EdgeMap of the Mesh has been constructed.
+	///	</summary>
+	void RequireEdgeMap();
+
+	///	<summary>
+	///		Ensure the ReverseNodeArray of the Mesh has been constructed.
+	///	</summary>
+	void RequireReverseNodeArray();
+
+	///	<summary>
+	///		Ensure the Face areas of the Mesh hold their geometric values,
+	///		computing them on first use, and return the total area.
+	///	</summary>
+	double RequireFaceAreas();
+
+	///	<summary>
+	///		Get the Mesh to use for overlap mesh generation, with its EdgeMap
+	///		constructed.  For a concave Mesh this is a convexified copy whose
+	///		MultiFaceMap refers to the Faces of the original Mesh.
+	///	</summary>
+	Mesh & GetMeshForOverlap();
+
+	///	<summary>
+	///		Get the centroids of all Faces.
+	///	</summary>
+	const NodeVector & GetFaceCentroids();
+
+	///	<summary>
+	///		Get a PointKDTree over the centroids of all Faces.
+	///	</summary>
+	const PointKDTree & GetFaceCentroidTree();
+
+	///	<summary>
+	///		Get the finite volume reconstruction stencil cache of the Mesh,
+	///		which is held in memory for the lifetime of the context.
+	///	</summary>
+	FiniteVolumeStencilCache & GetStencilCache() {
+		return m_cacheStencil;
+	}
+
+	///	<summary>
+	///		Get the GLL metadata of the Mesh, as computed by
+	///		GenerateMetaData(), and return its numerical area.
+	///	</summary>
+	double GetGLLMetaData(
+		int nP,
+		bool fNoBubble,
+		DataArray3D<int> & dataGLLNodes,
+		DataArray3D<double> & dataGLLJacobian
+	);
+
+protected:
+	///	<summary>
+	///		GLL metadata for one order and bubble setting.
+	///	</summary>
+	struct GLLMetaData {
+		DataArray3D<int> dataGLLNodes;
+		DataArray3D<double> dataGLLJacobian;
+		double dNumericalArea;
+	};
+
+	///	<summary>
+	///		Key of the GLL metadata cache (order, no bubble).
+	///	</summary>
+	typedef std::pair<int, bool> GLLMetaDataKey;
+
+protected:
+	///	<summary>
+	///		The Mesh.
+	///	</summary>
+	Mesh m_mesh;
+
+	///	<summary>
+	///		Flag indicating the Mesh contains concave Faces.
+	///	</summary>
+	bool m_fConcave;
+
+	///	<summary>
+	///		Flags indicating which derived structures have been built.
+	///	</summary>
+	bool m_fHasEdgeMap;
+	bool m_fHasReverseNodeArray;
+	bool m_fHasFaceAreas;
+	bool m_fHasMeshForOverlap;
+	bool m_fHasFaceCentroidTree;
+
+	///	<summary>
+	///		Geometric Face areas and their total.
+	///	</summary>
+	DataArray1D<double> m_vecGeometricFaceArea;
+	double m_dTotalArea;
+
+	///	<summary>
+	///		Convexified Mesh used for overlap mesh generation.
+	///	</summary>
+	Mesh m_meshConvex;
+
+	///	<summary>
+	///		Face centroids and the PointKDTree built over them.
+	///	</summary>
+	NodeVector m_vecFaceCentroids;
+	PointKDTree m_kdFaceCentroids;
+
+	///	<summary>
+	///		Finite volume reconstruction stencils.
+	///	</summary>
+	FiniteVolumeStencilCache m_cacheStencil;
+
+	///	<summary>
+	///		GLL metadata.
+	///	</summary>
+	std::map<GLLMetaDataKey, GLLMetaData> m_mapGLLMetaData;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif
+
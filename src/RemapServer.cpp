@@ -0,0 +1,596 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    RemapServer.cpp
+///	\author  Paul Ullrich
+///	\version October 14, 2026
+///
+///	<remarks>
+///		Copyright 2026 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "RemapServer.h"
+#include "Announce.h"
+#include "Exception.h"
+
+#include <thread>
+#include <vector>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+
+#if !defined(_WIN32)
+#include <csignal>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void ParseVariableList(
+	const std::string & strVariables,
+	std::vector< std::string > & vecVariableStrings
+) {
+	int iVarBegin = 0;
+	int iVarCurrent = 0;
+
+	// Parse variable name
+	for (;;) {
+		if ((iVarCurrent >= strVariables.length()) ||
+			(strVariables[iVarCurrent] == ',') ||
+			(strVariables[iVarCurrent] == ' ')
+		) {
+			if (iVarCurrent == iVarBegin) {
+				if (iVarCurrent >= strVariables.length()) {
+					break;
+				}
+
+				continue;
+			}
+
+			vecVariableStrings.push_back(
+				strVariables.substr(iVarBegin, iVarCurrent - iVarBegin));
+
+			iVarBegin = iVarCurrent + 1;
+		}
+
+		iVarCurrent++;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Get the canonical path of a file, or the path itself if it cannot
+///		be resolved, so that maps may be requested by any equivalent path.
+///	</summary>
+static std::string CanonicalPath(
+	const std::string & strPath
+) {
+#if !defined(_WIN32)
+	char szResolved[PATH_MAX];
+	if (realpath(strPath.c_str(), szResolved) != NULL) {
+		return std::string(szResolved);
+	}
+#endif
+	return strPath;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// RemapServerRequest
+///////////////////////////////////////////////////////////////////////////////
+
+std::string RemapServerRequest::ToString() const {
+	std::string strLine;
+	strLine += "map=" + strMap;
+	strLine += "\tin_data=" + strInputData;
+	strLine += "\tout_data=" + strOutputData;
+	strLine += "\tvar=" + strVariables;
+	strLine += "\tncol_name=" + strNColName;
+	strLine += "\tpreserve=" + strPreserveVariables;
+	if (fOutputDouble) {
+		strLine += "\tout_double";
+	}
+	if (fPreserveAll) {
+		strLine += "\tpreserveall";
+	}
+	if (fShutdown) {
+		strLine += "\tshutdown";
+	}
+	return strLine;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void RemapServerRequest::FromString(
+	const std::string & strLine
+) {
+	(*this) = RemapServerRequest();
+
+	size_t sBegin = 0;
+	while (sBegin <= strLine.length()) {
+		size_t sEnd = strLine.find('\t', sBegin);
+		if (sEnd == std::string::npos) {
+			sEnd = strLine.length();
+		}
+
+		std::string strField = strLine.substr(sBegin, sEnd - sBegin);
+		sBegin = sEnd + 1;
+
+		if (strField.length() == 0) {
+			continue;
+		}
+
+		size_t sEquals = strField.find('=');
+		std::string strKey = strField.substr(0, sEquals);
+		std::string strValue;
+		if (sEquals != std::string::npos) {
+			strValue = strField.substr(sEquals + 1);
+		}
+
+		if (strKey == "map") {
+			strMap = strValue;
+		} else if (strKey == "in_data") {
+			strInputData = strValue;
+		} else if (strKey == "out_data") {
+			strOutputData = strValue;
+		} else if (strKey == "var") {
+			strVariables = strValue;
+		} else if (strKey == "ncol_name") {
+			strNColName = strValue;
+		} else if (strKey == "preserve") {
+			strPreserveVariables = strValue;
+		} else if (strKey == "out_double") {
+			fOutputDouble = true;
+		} else if (strKey == "preserveall") {
+			fPreserveAll = true;
+		} else if (strKey == "shutdown") {
+			fShutdown = true;
+		} else {
+			_EXCEPTION1("Unknown request field \"%s\"", strKey.c_str());
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// RemapServer
+///////////////////////////////////////////////////////////////////////////////
+
+RemapServer::RemapServer(
+	const ApplyOfflineMapOptions & optsApply
+) :
+	m_optsApply(optsApply),
+	m_fShutdown(false)
+{ }
+
+///////////////////////////////////////////////////////////////////////////////
+
+RemapServer::~RemapServer() {
+	std::map<std::string, ResidentMap *>::iterator iter =
+		m_mapResident.begin();
+	for (; iter != m_mapResident.end(); iter++) {
+		delete iter->second;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void RemapServer::AddMap(
+	const std::string & strMapFile
+) {
+	std::string strKey = CanonicalPath(strMapFile);
+	if (m_mapResident.find(strKey) != m_mapResident.end()) {
+		return;
+	}
+
+	AnnounceStartBlock("Loading offline map \"%s\"", strMapFile.c_str());
+
+	ResidentMap * pResident = new ResidentMap;
+	m_mapResident.insert(
+		std::pair<std::string, ResidentMap *>(strKey, pResident));
+
+	// Coordinates other than the target cell centers are not needed
+	pResident->mapRemap.SetReadVertexArrays(false);
+	if ((!m_optsApply.fTranspose) && (!m_optsApply.fAdjoint)) {
+		pResident->mapRemap.SetReadSourceCenters(false);
+	}
+	pResident->mapRemap.Read(strMapFile);
+
+	pResident->pmapApply = &(pResident->mapRemap);
+
+	if (m_optsApply.fTranspose || m_optsApply.fAdjoint) {
+		pResident->mapTranspose.SetTranspose(
+			pResident->mapRemap, m_optsApply.fAdjoint);
+		pResident->pmapApply = &(pResident->mapTranspose);
+	}
+
+	OfflineMap * pmapApply = pResident->pmapApply;
+	pmapApply->SetFillValueOverrideDbl(m_optsApply.dFillValueOverride);
+	pmapApply->SetFillValueOverride(
+		static_cast<float>(m_optsApply.dFillValueOverride));
+	pmapApply->SetEnforcementBounds(m_optsApply.strEnforceBounds);
+	pmapApply->SetParallelVariables(m_optsApply.fParallelVariables);
+	pmapApply->SetRenormalizeFillValues(m_optsApply.fRenormalize);
+	pmapApply->SetReorderForApply(m_optsApply.fReorder);
+
+	AnnounceEndBlock("Done");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Mutex held while a request is processed.  OfflineMap::Apply modifies
+///		the map state, and the NetCDF library and Announce are not
+///		thread-safe, so requests are processed one at a time across all maps
+///		and servers in the process.
+///	</summary>
+static std::mutex s_mutexApply;
+
+///////////////////////////////////////////////////////////////////////////////
+
+void RemapServer::ProcessRequest(
+	const RemapServerRequest & req
+) {
+	if (req.strInputData == "") {
+		_EXCEPTIONT("No input data (in_data) specified");
+	}
+	if (req.strOutputData == "") {
+		_EXCEPTIONT("No output data (out_data) specified");
+	}
+
+	// Find the map
+	ResidentMap * pResident = NULL;
+	if (req.strMap == "") {
+		if (m_mapResident.size() != 1) {
+			_EXCEPTIONT("Server has more than one map: map must be specified");
+		}
+		pResident = m_mapResident.begin()->second;
+
+	} else {
+		std::map<std::string, ResidentMap *>::iterator iter =
+			m_mapResident.find(CanonicalPath(req.strMap));
+		if (iter == m_mapResident.end()) {
+			_EXCEPTION1("Map \"%s\" is not resident on this server",
+				req.strMap.c_str());
+		}
+		pResident = iter->second;
+	}
+
+	std::vector< std::string > vecVariableStrings;
+	ParseVariableList(req.strVariables, vecVariableStrings);
+
+	std::vector< std::string > vecPreserveVariableStrings;
+	ParseVariableList(req.strPreserveVariables, vecPreserveVariableStrings);
+
+	if (req.fPreserveAll && (vecPreserveVariableStrings.size() != 0)) {
+		_EXCEPTIONT("preserveall and preserve cannot both be specified");
+	}
+
+	OfflineMap * pmapApply = pResident->pmapApply;
+
+	pmapApply->Apply(
+		req.strInputData,
+		req.strOutputData,
+		vecVariableStrings,
+		req.strNColName,
+		req.fOutputDouble,
+		false);
+
+	if (req.fPreserveAll) {
+		pmapApply->PreserveAllVariables(
+			req.strInputData,
+			req.strOutputData);
+
+	} else if (vecPreserveVariableStrings.size() != 0) {
+		pmapApply->PreserveVariables(
+			req.strInputData,
+			req.strOutputData,
+			vecPreserveVariableStrings);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+#if !defined(_WIN32)
+
+///	<summary>
+///		Read a line from a socket, without the newline.  Returns false if
+///		the connection is closed before a newline is received.
+///	</summary>
+static bool ReadSocketLine(
+	int fd,
+	std::string & strLine
+) {
+	strLine.clear();
+	char szBuffer[4096];
+	for (;;) {
+		ssize_t sRead = recv(fd, szBuffer, sizeof(szBuffer), 0);
+		if (sRead < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return false;
+		}
+		if (sRead == 0) {
+			return false;
+		}
+		const char * pNewline =
+			static_cast<const char *>(memchr(szBuffer, '\n', sRead));
+		if (pNewline != NULL) {
+			strLine.append(szBuffer, pNewline - szBuffer);
+			return true;
+		}
+		strLine.append(szBuffer, sRead);
+	}
+}
+
+///	<summary>
+///		Write a line to a socket.  Returns false on failure.
+///	</summary>
+static bool WriteSocketLine(
+	int fd,
+	const std::string & strLine
+) {
+	std::string strData = strLine + "\n";
+	size_t sWritten = 0;
+	while (sWritten < strData.length()) {
+		ssize_t sSent =
+			send(fd, strData.c_str() + sWritten, strData.length() - sWritten, 0);
+		if (sSent < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return false;
+		}
+		sWritten += sSent;
+	}
+	return true;
+}
+
+///	<summary>
+///		Fill in the address of a Unix domain socket.
+///	</summary>
+static void InitSocketAddress(
+	const std::string & strSocket,
+	struct sockaddr_un & addr
+) {
+	if (strSocket.length() >= sizeof(addr.sun_path)) {
+		_EXCEPTION1("Socket path \"%s\" is too long", strSocket.c_str());
+	}
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strncpy(addr.sun_path, strSocket.c_str(), sizeof(addr.sun_path) - 1);
+}
+
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+void RemapServer::HandleConnection(
+	int fdConnection
+) {
+#if !defined(_WIN32)
+	std::string strLine;
+	if (!ReadSocketLine(fdConnection, strLine)) {
+		return;
+	}
+
+	// Exceptions are reported to the client rather than stopping the server
+	std::string strReply = "OK";
+	try {
+		RemapServerRequest req;
+		req.FromString(strLine);
+
+		if (req.fShutdown) {
+			std::lock_guard<std::mutex> lock(m_mutexQueue);
+			m_fShutdown = true;
+
+		} else {
+			std::lock_guard<std::mutex> lock(s_mutexApply);
+			Announce("Request: %s -> %s",
+				req.strInputData.c_str(), req.strOutputData.c_str());
+			ProcessRequest(req);
+		}
+
+	} catch(Exception & e) {
+		strReply = "ERROR " + e.ToString();
+		std::lock_guard<std::mutex> lock(s_mutexApply);
+		Announce("Request failed: %s", e.ToString().c_str());
+
+	} catch(...) {
+		strReply = "ERROR Unknown exception";
+	}
+
+	WriteSocketLine(fdConnection, strReply);
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void RemapServer::ProcessConnections() {
+#if !defined(_WIN32)
+	for (;;) {
+		int fdConnection;
+		{
+			std::unique_lock<std::mutex> lock(m_mutexQueue);
+			while ((!m_fShutdown) && (m_dequeConnections.size() == 0)) {
+				m_condQueue.wait(lock);
+			}
+			if (m_dequeConnections.size() == 0) {
+				return;
+			}
+			fdConnection = m_dequeConnections.front();
+			m_dequeConnections.pop_front();
+		}
+
+		HandleConnection(fdConnection);
+		close(fdConnection);
+	}
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void RemapServer::Serve(
+	const std::string & strSocket,
+	int nWorkers
+) {
+#if defined(_WIN32)
+	_EXCEPTIONT("RemapServer is not supported on this platform");
+#else
+	if (m_mapResident.size() == 0) {
+		_EXCEPTIONT("No maps loaded on server");
+	}
+	if (nWorkers < 1) {
+		_EXCEPTION1("Invalid number of server workers (%i)", nWorkers);
+	}
+
+	// Clients that disconnect early must not terminate the server
+	signal(SIGPIPE, SIG_IGN);
+
+	struct sockaddr_un addr;
+	InitSocketAddress(strSocket, addr);
+
+	int fdListen = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fdListen < 0) {
+		_EXCEPTION1("Unable to create socket (%s)", strerror(errno));
+	}
+
+	unlink(strSocket.c_str());
+	if (bind(fdListen, (struct sockaddr *)(&addr), sizeof(addr)) != 0) {
+		close(fdListen);
+		_EXCEPTION2("Unable to bind socket \"%s\" (%s)",
+			strSocket.c_str(), strerror(errno));
+	}
+	if (listen(fdListen, SOMAXCONN) != 0) {
+		close(fdListen);
+		unlink(strSocket.c_str());
+		_EXCEPTION2("Unable to listen on socket \"%s\" (%s)",
+			strSocket.c_str(), strerror(errno));
+	}
+
+	Announce("Serving %lu map(s) on \"%s\" with %i worker(s)",
+		m_mapResident.size(), strSocket.c_str(), nWorkers);
+
+	m_fShutdown = false;
+
+	std::vector<std::thread> vecWorkers;
+	for (int i = 0; i < nWorkers; i++) {
+		vecWorkers.push_back(
+			std::thread(&RemapServer::ProcessConnections, this));
+	}
+
+	// Accept connections, polling so that a shutdown request is noticed
+	std::string strError;
+	for (;;) {
+		{
+			std::lock_guard<std::mutex> lock(m_mutexQueue);
+			if (m_fShutdown) {
+				break;
+			}
+		}
+
+		struct pollfd pfd;
+		pfd.fd = fdListen;
+		pfd.events = POLLIN;
+		pfd.revents = 0;
+
+		int nReady = poll(&pfd, 1, 250);
+		if (nReady < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			strError = strerror(errno);
+			break;
+		}
+		if (nReady == 0) {
+			continue;
+		}
+
+		int fdConnection = accept(fdListen, NULL, NULL);
+		if (fdConnection < 0) {
+			if ((errno == EINTR) || (errno == ECONNABORTED)) {
+				continue;
+			}
+			strError = strerror(errno);
+			break;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutexQueue);
+			m_dequeConnections.push_back(fdConnection);
+		}
+		m_condQueue.notify_one();
+	}
+
+	// Queued requests are completed before the workers exit
+	{
+		std::lock_guard<std::mutex> lock(m_mutexQueue);
+		m_fShutdown = true;
+	}
+	m_condQueue.notify_all();
+
+	for (int i = 0; i < nWorkers; i++) {
+		vecWorkers[i].join();
+	}
+
+	close(fdListen);
+	unlink(strSocket.c_str());
+
+	if (strError != "") {
+		_EXCEPTION1("Error accepting connections (%s)", strError.c_str());
+	}
+
+	Announce("Server shut down");
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void RemapServer::SendRequest(
+	const std::string & strSocket,
+	const RemapServerRequest & req
+) {
+#if defined(_WIN32)
+	_EXCEPTIONT("RemapServer is not supported on this platform");
+#else
+	struct sockaddr_un addr;
+	InitSocketAddress(strSocket, addr);
+
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0) {
+		_EXCEPTION1("Unable to create socket (%s)", strerror(errno));
+	}
+	if (connect(fd, (struct sockaddr *)(&addr), sizeof(addr)) != 0) {
+		close(fd);
+		_EXCEPTION2("Unable to connect to remap server \"%s\" (%s)",
+			strSocket.c_str(), strerror(errno));
+	}
+
+	std::string strReply;
+	bool fSuccess = WriteSocketLine(fd, req.ToString());
+	if (fSuccess) {
+		fSuccess = ReadSocketLine(fd, strReply);
+	}
+	close(fd);
+
+	if (!fSuccess) {
+		_EXCEPTION1("Lost connection to remap server \"%s\"",
+			strSocket.c_str());
+	}
+	if (strReply.compare(0, 2, "OK") != 0) {
+		_EXCEPTION1("Remap server: %s", strReply.c_str());
+	}
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,239 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    RemapServer.h
+///	\author  Paul Ullrich
+///	\version October 14, 2026
+///
+///	<remarks>
+///		Copyright 2026 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#ifndef _REMAPSERVER_H_
+#define _REMAPSERVER_H_
+
+#include "OfflineMap.h"
+#include "TempestRemapAPI.h"
+
+#include <string>
+#include <map>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A request to a RemapServer to apply a resident map to one data file.
+///		Requests are sent as a single line of tab-separated key=value fields.
+///	</summary>
+class RemapServerRequest {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	RemapServerRequest() :
+		strNColName("ncol"),
+		fOutputDouble(false),
+		fPreserveAll(false),
+		fShutdown(false)
+	{ }
+
+public:
+	///	<summary>
+	///		Encode the request as a line of text (without the newline).
+	///	</summary>
+	std::string ToString() const;
+
+	///	<summary>
+	///		Decode the request from a line of text.
+	///	</summary>
+	void FromString(
+		const std::string & strLine
+	);
+
+public:
+	///	<summary>
+	///		The map to apply, or empty if the server has a single map.
+	///	</summary>
+	std::string strMap;
+
+	///	<summary>
+	///		The input data file.
+	///	</summary>
+	std::string strInputData;
+
+	///	<summary>
+	///		The output data file.
+	///	</summary>
+	std::string strOutputData;
+
+	///	<summary>
+	///		A list of variables to operate on.
+	///	</summary>
+	std::string strVariables;
+
+	///	<summary>
+	///		The name of the unstructured dimension in the data.
+	///	</summary>
+	std::string strNColName;
+
+	///	<summary>
+	///		Output data using double precision.
+	///	</summary>
+	bool fOutputDouble;
+
+	///	<summary>
+	///		List of variables to preserve.
+	///	</summary>
+	std::string strPreserveVariables;
+
+	///	<summary>
+	///		Preserve all output variables.
+	///	</summary>
+	bool fPreserveAll;
+
+	///	<summary>
+	///		Stop the server once outstanding requests have been processed.
+	///	</summary>
+	bool fShutdown;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A long-lived server that keeps a set of OfflineMaps resident and
+///		applies them to data files on request over a Unix domain socket.
+///		Connections are handled by a pool of worker threads, which read
+///		requests and write replies concurrently, but since the NetCDF
+///		library is not thread-safe the requests themselves are applied one
+///		at a time.
+///	</summary>
+class RemapServer {
+
+public:
+	///	<summary>
+	///		Constructor.  The map options (fill value, bounds, renormalization,
+	///		transpose) of optsApply apply to every request.
+	///	</summary>
+	RemapServer(
+		const ApplyOfflineMapOptions & optsApply
+	);
+
+	///	<summary>
+	///		Destructor.
+	///	</summary>
+	~RemapServer();
+
+public:
+	///	<summary>
+	///		Load a map and keep it resident.
+	///	</summary>
+	void AddMap(
+		const std::string & strMapFile
+	);
+
+	///	<summary>
+	///		Listen on the given socket and process requests until a shutdown
+	///		request is received.
+	///	</summary>
+	void Serve(
+		const std::string & strSocket,
+		int nWorkers
+	);
+
+	///	<summary>
+	///		Send a request to the server listening on the given socket and
+	///		wait for it to be processed.  An Exception is thrown if the
+	///		server reports an error.
+	///	</summary>
+	static void SendRequest(
+		const std::string & strSocket,
+		const RemapServerRequest & req
+	);
+
+protected:
+	///	<summary>
+	///		Process a request using the resident maps.  Called with the
+	///		process-wide request mutex held.
+	///	</summary>
+	void ProcessRequest(
+		const RemapServerRequest & req
+	);
+
+	///	<summary>
+	///		Read a request from a connection, process it and send the reply.
+	///	</summary>
+	void HandleConnection(
+		int fdConnection
+	);
+
+	///	<summary>
+	///		Process connections from the queue until shutdown.
+	///	</summary>
+	void ProcessConnections();
+
+protected:
+	///	<summary>
+	///		A map kept resident by the server.
+	///	</summary>
+	struct ResidentMap {
+
+		///	<summary>
+		///		The map read from file.
+		///	</summary>
+		OfflineMap mapRemap;
+
+		///	<summary>
+		///		The transpose or adjoint of the map, if requested.
+		///	</summary>
+		OfflineMap mapTranspose;
+
+		///	<summary>
+		///		The map to apply.
+		///	</summary>
+		OfflineMap * pmapApply;
+	};
+
+	///	<summary>
+	///		The options used for all requests.
+	///	</summary>
+	ApplyOfflineMapOptions m_optsApply;
+
+	///	<summary>
+	///		The resident maps, indexed by the canonical path of the map file.
+	///	</summary>
+	std::map<std::string, ResidentMap *> m_mapResident;
+
+	///	<summary>
+	///		Mutex protecting the connection queue and shutdown flag.
+	///	</summary>
+	std::mutex m_mutexQueue;
+
+	///	<summary>
+	///		Condition variable signaled when a connection is queued or the
+	///		server shuts down.
+	///	</summary>
+	std::condition_variable m_condQueue;
+
+	///	<summary>
+	///		Accepted connections waiting for a worker.
+	///	</summary>
+	std::deque<int> m_dequeConnections;
+
+	///	<summary>
+	///		Flag indicating a shutdown request has been received.
+	///	</summary>
+	bool m_fShutdown;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif
+
@@ -25,12 +25,204 @@
 #include <cmath>
 #include <cfloat>
 #include <iostream>
+#include <map>
 #include <sstream>
+#include <vector>
 
 #include "netcdfcpp.h"
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		Longitude and latitude of a reference grid, together with the
+///		indices of the points of the grid that carry data.
+///	</summary>
+struct RestructureDataIndex {
+
+	///	<summary>
+	///		Longitude and latitude of all points of the reference grid.
+	///	</summary>
+	DataArray1D<double> dLon;
+	DataArray1D<double> dLat;
+
+	///	<summary>
+	///		_FillValue of the longitude variable.
+	///	</summary>
+	double dFillValueLon;
+
+	///	<summary>
+	///		Indices of points whose longitude is not _FillValue, in order.
+	///	</summary>
+	std::vector<long> vecDataIndex;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Get the index of a reference grid.  The index of the most recently
+///		used reference grid is cached, keyed by reference file and coordinate
+///		variable names, so that restructuring many files against the same
+///		reference grid reads its coordinates only once.
+///	</summary>
+static const RestructureDataIndex & GetRestructureDataIndex(
+	const std::string & strRefFile,
+	NcVar * varLon,
+	NcVar * varLat,
+	long lSpatialSize
+) {
+	static std::map<std::string, RestructureDataIndex> s_mapIndexCache;
+
+	const std::string strKey =
+		strRefFile + "\n" + varLon->name() + "\n" + varLat->name();
+
+	std::map<std::string, RestructureDataIndex>::iterator iter =
+		s_mapIndexCache.find(strKey);
+
+	if (iter != s_mapIndexCache.end()) {
+		if (iter->second.dLon.GetRows() != lSpatialSize) {
+			_EXCEPTION1("Reference file \"%s\" changed size since it was cached",
+				strRefFile.c_str());
+		}
+		Announce("Using cached index of reference file");
+		return iter->second;
+	}
+
+	// Only retain one reference grid, since each file may serve as its own
+	// reference when no reference file is given
+	s_mapIndexCache.clear();
+
+	RestructureDataIndex & index = s_mapIndexCache[strKey];
+
+	try {
+		// Load longitude and latitude data
+		index.dLon.Allocate(lSpatialSize);
+		index.dLat.Allocate(lSpatialSize);
+
+		if (varLon->num_dims() == 1) {
+			varLon->get(&(index.dLon[0]), lSpatialSize);
+			varLat->get(&(index.dLat[0]), lSpatialSize);
+		} else {
+			long lSize0 = varLon->get_dim(0)->size();
+			long lSize1 = varLon->get_dim(1)->size();
+			varLon->get(&(index.dLon[0]), lSize0, lSize1);
+			varLat->get(&(index.dLat[0]), lSize0, lSize1);
+		}
+
+		// Load _FillValue (if exists)
+		index.dFillValueLon = DBL_MAX;
+		NcAtt * attFillValueLon = varLon->get_att("_FillValue");
+		if (attFillValueLon != NULL) {
+			index.dFillValueLon = attFillValueLon->as_double(0);
+		}
+
+		// Points with data
+		for (long i = 0; i < lSpatialSize; i++) {
+			if (index.dLon[i] != index.dFillValueLon) {
+				index.vecDataIndex.push_back(i);
+			}
+		}
+
+	} catch(...) {
+		s_mapIndexCache.erase(strKey);
+		throw;
+	}
+
+	return index;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Parse a comma-separated list of variable names.
+///	</summary>
+static void ParseVariableList(
+	const std::string & strVariables,
+	std::vector<std::string> & vecVariableNames
+) {
+	size_t iLast = 0;
+	for (size_t i = 0; i <= strVariables.length(); i++) {
+		if ((i == strVariables.length()) || (strVariables[i] == ',')) {
+			if (i != iLast) {
+				vecVariableNames.push_back(
+					strVariables.substr(iLast, i - iLast));
+			}
+			iLast = i+1;
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Add the dimensions of a variable that precede its spatial dimensions
+///		to the output file, returning the number of slices they span.
+///	</summary>
+static long AddAuxiliaryDims(
+	NcFile & ncinfile,
+	NcFile & ncoutfile,
+	NcVar * varIn,
+	long lAuxDims,
+	std::vector<NcDim *> & vecDimOut
+) {
+	long lAuxDimSize = 1;
+	vecDimOut.clear();
+
+	for (long d = 0; d < lAuxDims; d++) {
+		NcDim * dimIn = varIn->get_dim(d);
+		NcDim * dimOut = ncoutfile.get_dim(dimIn->name());
+		if (dimOut != NULL) {
+			if (dimOut->size() != dimIn->size()) {
+				_EXCEPTION3("Size mismatch in dimension \"%s\" (in %lu / out %lu)",
+					dimIn->name(), dimIn->size(), dimOut->size());
+			}
+		} else {
+			dimOut = ncoutfile.add_dim(dimIn->name(), dimIn->size());
+			if (dimOut == NULL) {
+				_EXCEPTION1("Unable to create dimension \"%s\" in output file", dimIn->name());
+			}
+			CopyNcVarIfExists(ncinfile, ncoutfile, dimIn->name());
+		}
+		vecDimOut.push_back(dimOut);
+		lAuxDimSize *= dimOut->size();
+	}
+
+	return lAuxDimSize;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Set the auxiliary position of slice s and announce it.
+///	</summary>
+static void SetAuxiliaryPosition(
+	long s,
+	const std::vector<NcDim *> & vecDimOut,
+	std::vector<long> & vecPos
+) {
+	long lSlice = s;
+	for (long d = static_cast<long>(vecDimOut.size())-1; d >= 0; d--) {
+		vecPos[d] = lSlice % vecDimOut[d]->size();
+		lSlice /= vecDimOut[d]->size();
+	}
+
+	if (vecDimOut.size() > 0) {
+		std::stringstream ssPos;
+		for (size_t d = 0; d < vecDimOut.size(); d++) {
+			ssPos << vecDimOut[d]->name() << " (";
+			ssPos << vecPos[d];
+			ssPos << "/";
+			ssPos << vecDimOut[d]->size();
+			ssPos << ")";
+			if (d != vecDimOut.size()-1) {
+				ssPos << ", ";
+			}
+		}
+		Announce("%s", ssPos.str().c_str());
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 extern "C" 
 int RestructureData(
 	std::string strInputFile,
@@ -59,8 +251,9 @@ try {
 			strOutputFormat.c_str());
 	}
 
-	// No variable specified
-	bool fVariable = (strVariable != "");
+	// Variables to restructure
+	std::vector<std::string> vecVariables;
+	ParseVariableList(strVariable, vecVariables);
 
 	// If blank reference file, use input file
 	if (strRefFile == "") {
@@ -92,13 +285,14 @@ try {
 		_EXCEPTION1("Unable to load input file \"%s\"", strInputFile.c_str());
 	}
 
-	// Load variable in input file
-	NcVar * varIn = NULL;
-	if (fVariable) {
-		varIn = ncinfile.get_var(strVariable.c_str());
+	// Load variables in input file
+	std::vector<NcVar *> vecVarIn;
+	for (size_t v = 0; v < vecVariables.size(); v++) {
+		NcVar * varIn = ncinfile.get_var(vecVariables[v].c_str());
 		if (varIn == NULL) {
-			_EXCEPTION1("Unable to find variable \"%s\" in input file", strVariable.c_str());
+			_EXCEPTION1("Unable to find variable \"%s\" in input file", vecVariables[v].c_str());
 		}
+		vecVarIn.push_back(varIn);
 	}
 
 	// Output file
@@ -138,62 +332,62 @@ try {
 		}
 	}
 
-	// Load longitude and latitude data
-	DataArray1D<double> dLon(lSpatialSize);
-	DataArray1D<double> dLat(lSpatialSize);
+	// Longitude and latitude data and the points carrying data
+	const RestructureDataIndex & index =
+		GetRestructureDataIndex(strRefFile, varLon, varLat, lSpatialSize);
 
-	if (lSpatialDims == 1) {
-		varLon->get(&(dLon[0]), lSpatialSize);
-		varLat->get(&(dLat[0]), lSpatialSize);
-	} else {
-		varLon->get(&(dLon[0]), dimSpatial0->size(), dimSpatial1->size());
-		varLat->get(&(dLat[0]), dimSpatial0->size(), dimSpatial1->size());
-	}
+	const DataArray1D<double> & dLon = index.dLon;
+	const DataArray1D<double> & dLat = index.dLat;
+	const std::vector<long> & vecDataIndex = index.vecDataIndex;
 
-	// Load _FillValue (if exists)
-	double dFillValueLon = DBL_MAX;
-	NcAtt * attFillValueLon = varLon->get_att("_FillValue");
-	if (attFillValueLon != NULL) {
-		dFillValueLon = attFillValueLon->as_double(0);
-	}
+	const long lCount = static_cast<long>(vecDataIndex.size());
 
-	double dFillValueLat = DBL_MAX;
-	NcAtt * attFillValueLat = varLat->get_att("_FillValue");
-	if (attFillValueLat != NULL) {
-		dFillValueLat = attFillValueLat->as_double(0);
-	}
-
-	double dFillValueVar = DBL_MAX;
-	if (fVariable) {
-		NcAtt * attFillValueVar = varIn->get_att("_FillValue");
+	// Load _FillValue of each variable
+	std::vector<double> vecFillValueVar(vecVarIn.size(), DBL_MAX);
+	for (size_t v = 0; v < vecVarIn.size(); v++) {
+		NcAtt * attFillValueVar = vecVarIn[v]->get_att("_FillValue");
 		if (attFillValueVar != NULL) {
 			if (strFillValue != "") {
 				_EXCEPTIONT("--fillvalue can only be used when variable _FillValue attribute is not already defined");
 			}
-			dFillValueVar = attFillValueVar->as_double(0);
+			vecFillValueVar[v] = attFillValueVar->as_double(0);
 		} else if (strFillValue != "") {
-			dFillValueVar = std::stod(strFillValue);
+			vecFillValueVar[v] = std::stod(strFillValue);
 		}
 	}
 
-	// Variable
+	// Variable spatial dimensionality, which must be the same for all
+	// variables
 	long lVariableDims = lSpatialDims;
-	NcDim * dimVar0 = NULL;
-	NcDim * dimVar1 = NULL;
 
-	if (fVariable) {
-		lVariableDims = varIn->num_dims();
-		if (lVariableDims == 0) {
+	for (size_t v = 0; v < vecVarIn.size(); v++) {
+		NcVar * varIn = vecVarIn[v];
+
+		long lVarDims = varIn->num_dims();
+		if (lVarDims == 0) {
 			_EXCEPTIONT("Input variable has zero dimension");
 		}
-		if ((lVariableDims == 1) ||
-		    (std::string("ncol") == varIn->get_dim(lVariableDims-1)->name())
+		if ((lVarDims == 1) ||
+		    (std::string("ncol") == varIn->get_dim(lVarDims-1)->name())
 		) {
-			dimVar0 = varIn->get_dim(lVariableDims-1);
-			lVariableDims = 1;
+			if (varIn->get_dim(lVarDims-1)->size() != lCount) {
+				_EXCEPTION3("Variable \"%s\" has %li columns, but reference "
+					"file has %li degrees of freedom", varIn->name(),
+					varIn->get_dim(lVarDims-1)->size(), lCount);
+			}
+			lVarDims = 1;
 		} else {
-			dimVar0 = varIn->get_dim(lVariableDims-2);
-			dimVar1 = varIn->get_dim(lVariableDims-1);
+			if (varIn->get_dim(lVarDims-2)->size() * varIn->get_dim(lVarDims-1)->size() != lSpatialSize) {
+				_EXCEPTION1("Variable \"%s\" spatial size does not match "
+					"reference file", varIn->name());
+			}
+			lVarDims = 2;
+		}
+
+		if (v == 0) {
+			lVariableDims = lVarDims;
+		} else if (lVarDims != lVariableDims) {
+			_EXCEPTIONT("All variables must have the same spatial dimensionality");
 		}
 	}
 
@@ -205,8 +399,6 @@ try {
 		// 1D variable array -- convert to 2D
 		if (lVariableDims == 1) {
 
-			_ASSERT(dimVar0 != NULL);
-
 			AnnounceStartBlock("Converting 1D data to 2D");
 
 			// Copy longitude/latitude variables
@@ -233,55 +425,31 @@ try {
 			_ASSERT(dimX != NULL);
 			_ASSERT(dimY != NULL);
 
-			DataArray1D<float> dData(dimVar0->size());
-			DataArray1D<float> dDataOut(dimX->size() * dimY->size());
+			Announce("%li / %li degrees of freedom found", lCount, dimX->size() * dimY->size());
 
-			// Count number of degrees of freedom
-			{
-				long ixDOF = 0;
-				for (long i = 0; i < lSpatialSize; i++) {
-					if (dLon[i] != dFillValueLon) {
-						ixDOF++;
-					}
-				}
-				Announce("%li / %li degrees of freedom found", ixDOF, dimX->size() * dimY->size());
-			}
+			DataArray1D<float> dData(lCount);
+			DataArray1D<float> dDataOut(dimX->size() * dimY->size());
 
 			// Process variables
-			if (fVariable) {
+			for (size_t v = 0; v < vecVarIn.size(); v++) {
+				NcVar * varIn = vecVarIn[v];
+
+				const long lAuxDims = varIn->num_dims()-1;
 
 				// Create output dimension vector
-				long lAuxDimSize = 1;
 				std::vector<NcDim *> vecDimOut;
-				NcVar * varOut;
-
-				for (long d = 0; d < varIn->num_dims()-1; d++) {
-					NcDim * dimIn = varIn->get_dim(d);
-					NcDim * dimOut = ncoutfile.get_dim(dimIn->name());
-					if (dimOut != NULL) {
-						if (dimOut->size() != dimIn->size()) {
-							_EXCEPTION3("Size mismatch in dimension \"%s\" (in %lu / out %lu)",
-								dimIn->name(), dimIn->size(), dimOut->size());
-						}
-					} else {
-						dimOut = ncoutfile.add_dim(dimIn->name(), dimIn->size());
-						if (dimOut == NULL) {
-							_EXCEPTION1("Unable to create dimension \"%s\" in output file", dimIn->name());
-						}
-						CopyNcVarIfExists(ncinfile, ncoutfile, dimIn->name());
-					}
-					vecDimOut.push_back(dimOut);
-					lAuxDimSize *= dimOut->size();
-				}
+				long lAuxDimSize =
+					AddAuxiliaryDims(ncinfile, ncoutfile, varIn, lAuxDims, vecDimOut);
 
-				vecDimOut.push_back(dimX);
-				vecDimOut.push_back(dimY);
+				std::vector<NcDim *> vecVarDimOut = vecDimOut;
+				vecVarDimOut.push_back(dimX);
+				vecVarDimOut.push_back(dimY);
 
 				// Create output variable
-				varOut = ncoutfile.add_var(strVariable.c_str(), ncFloat, vecDimOut.size(), const_cast<const NcDim**>(&(vecDimOut[0])));
+				NcVar * varOut = ncoutfile.add_var(varIn->name(), ncFloat, vecVarDimOut.size(), const_cast<const NcDim**>(&(vecVarDimOut[0])));
 				if (varOut == NULL) {
 					_EXCEPTION2("Unable to create variable \"%s\" in file \"%s\"",
-						strVariable.c_str(), strOutputFile.c_str());
+						varIn->name(), strOutputFile.c_str());
 				}
 
 				CopyNcVarAttributes(varIn, varOut);
@@ -289,67 +457,40 @@ try {
 				if (strFillValue != "") {
 					NcAtt * attFillValue = varOut->get_att("_FillValue");
 					if (attFillValue == NULL) {
-						varOut->add_att("_FillValue", static_cast<float>(dFillValueVar));
+						varOut->add_att("_FillValue", static_cast<float>(vecFillValueVar[v]));
 					}
 				}
 
-				// Loop over all auxiliary indices and restructure
-				for (long s = 0; s < lAuxDimSize; s++) {
+				// Points without data keep the fill value for all slices
+				const float flFillValue = static_cast<float>(vecFillValueVar[v]);
+				for (size_t i = 0; i < dDataOut.GetRows(); i++) {
+					dDataOut[i] = flFillValue;
+				}
+
+				std::vector<long> vecVarInSize(lAuxDims+1, 1);
+				std::vector<long> vecVarInPos(lAuxDims+1, 0);
+
+				std::vector<long> vecVarOutSize(lAuxDims+2, 1);
+				std::vector<long> vecVarOutPos(lAuxDims+2, 0);
 
-					std::vector<long> vecVarInSize(varIn->num_dims(), 1);
-					std::vector<long> vecVarInPos(varIn->num_dims(), 0);
+				vecVarInSize[lAuxDims] = lCount;
+				vecVarOutSize[lAuxDims] = dimX->size();
+				vecVarOutSize[lAuxDims+1] = dimY->size();
 
-					std::vector<long> vecVarOutSize(varIn->num_dims()+1, 1);
-					std::vector<long> vecVarOutPos(varIn->num_dims()+1, 0);
+				// Loop over all auxiliary indices and restructure
+				for (long s = 0; s < lAuxDimSize; s++) {
 
-					long lAuxDimSizeTemp = lAuxDimSize;
-					for (long d = varIn->num_dims()-2; d >= 0; d--) {
-						vecVarInPos[d] = s % vecDimOut[d]->size();
+					SetAuxiliaryPosition(s, vecDimOut, vecVarInPos);
+					for (long d = 0; d < lAuxDims; d++) {
 						vecVarOutPos[d] = vecVarInPos[d];
-						lAuxDimSizeTemp = (lAuxDimSizeTemp - vecVarInPos[d]) / (vecDimOut[d]->size());
 					}
-					vecVarInSize[varIn->num_dims()-1] = varIn->get_dim(varIn->num_dims()-1)->size();
-					vecVarInPos[varIn->num_dims()-1] = 0;
-					vecVarOutSize[varIn->num_dims()-1] = dimX->size();
-					vecVarOutSize[varIn->num_dims()] = dimY->size();
-
-					if (lAuxDimSize > 0) {
-						std::stringstream ssPos;
-						for (long d = 0; d < varIn->num_dims()-1; d++) {
-							ssPos << vecDimOut[d]->name() << " (";
-							ssPos << vecVarInPos[d];
-							ssPos << "/";
-							ssPos << varIn->get_dim(d)->size();
-							ssPos << ")";
-							if (d != varIn->num_dims()-2) {
-								ssPos << ", ";
-							}
-						}
-						Announce("%s", ssPos.str().c_str());
-					}
-/*
-					std::cout << dData.GetRows() << std::endl;
 
-					for (int d = 0; d < vecVarInPos.size(); d++) {
-						printf("%li/%li ", vecVarInPos[d], vecVarInSize[d]);
-					}
-					printf("\n");
-					for (int d = 0; d < vecVarOutPos.size(); d++) {
-						printf("%li/%li ", vecVarOutPos[d], vecVarOutSize[d]);
-					}
-					printf("\n");
-*/
 					varIn->set_cur(&(vecVarInPos[0]));
 					varIn->get(&(dData[0]), &(vecVarInSize[0]));
 
-					long ixDOF = 0;
-					for (long i = 0; i < lSpatialSize; i++) {
-						if (dLon[i] != dFillValueLon) {
-							dDataOut[i] = dData[ixDOF];
-							ixDOF++;
-						} else{
-							dDataOut[i] = static_cast<float>(dFillValueVar);
-						}
+#pragma omp parallel for schedule(static)
+					for (long ix = 0; ix < lCount; ix++) {
+						dDataOut[vecDataIndex[ix]] = dData[ix];
 					}
 
 					varOut->set_cur(&(vecVarOutPos[0]));
@@ -364,21 +505,6 @@ try {
 
 			AnnounceStartBlock("Converting 2D data to 1D");
 
-			DataArray1D<float> dData(lSpatialSize);
-			if (fVariable) {
-				_ASSERT(dimVar0 != NULL);
-				_ASSERT(dimVar1 != NULL);
-				varIn->get(&(dData[0]), dimVar0->size(), dimVar1->size());
-			}
-
-			// Count number of non-fillvalue elements
-			long lCount = 0;
-			for (long i = 0; i < lSpatialSize; i++) {
-				if (dLon[i] != dFillValueLon) {
-					lCount++;
-				}
-			}
-
 			Announce("%li degrees of freedom found", lCount);
 
 			NcDim * dimNCol = ncoutfile.add_dim("ncol", lCount);
@@ -398,44 +524,83 @@ try {
 			CopyNcVarAttributes(varLon, varLonOut);
 			CopyNcVarAttributes(varLat, varLatOut);
 
-			NcVar * varOut = NULL;
-			if (strVariable != "") {
-				varOut = ncoutfile.add_var(strVariable.c_str(), ncFloat, dimNCol);
-				if (varOut == NULL) {
-					_EXCEPTION2("Unable to create variable \"%s\" in file \"%s\"",
-						strVariable.c_str(), strOutputFile.c_str());
-				}
-				CopyNcVarAttributes(varIn, varOut);
-			}
-
 			if (lCount == lSpatialSize) {
 				varLonOut->put(&(dLon[0]), lCount);
 				varLatOut->put(&(dLat[0]), lCount);
-				if (fVariable) {
-					varOut->put(&(dData[0]), lCount);
-				}
 
 			} else {
 				DataArray1D<double> dLonVectorized(lCount);
 				DataArray1D<double> dLatVectorized(lCount);
-				DataArray1D<float> dDataVectorized(lCount);
-
-				long ix = 0;
-				for (long i = 0; i < lSpatialSize; i++) {
-					if (dLon[i] != dFillValueLon) {
-						dLonVectorized[ix] = dLon[i];
-						dLatVectorized[ix] = dLat[i];
-						if (fVariable) {
-							dDataVectorized[ix] = dData[i];
-						}
-						ix++;
-					}
+
+#pragma omp parallel for schedule(static)
+				for (long ix = 0; ix < lCount; ix++) {
+					dLonVectorized[ix] = dLon[vecDataIndex[ix]];
+					dLatVectorized[ix] = dLat[vecDataIndex[ix]];
 				}
+
 				varLonOut->put(&(dLonVectorized[0]), lCount);
 				varLatOut->put(&(dLatVectorized[0]), lCount);
+			}
+
+			DataArray1D<float> dData(lSpatialSize);
+			DataArray1D<float> dDataVectorized(lCount);
+
+			// Process variables
+			for (size_t v = 0; v < vecVarIn.size(); v++) {
+				NcVar * varIn = vecVarIn[v];
+
+				const long lAuxDims = varIn->num_dims()-2;
+
+				// Create output dimension vector
+				std::vector<NcDim *> vecDimOut;
+				long lAuxDimSize =
+					AddAuxiliaryDims(ncinfile, ncoutfile, varIn, lAuxDims, vecDimOut);
+
+				std::vector<NcDim *> vecVarDimOut = vecDimOut;
+				vecVarDimOut.push_back(dimNCol);
+
+				// Create output variable
+				NcVar * varOut = ncoutfile.add_var(varIn->name(), ncFloat, vecVarDimOut.size(), const_cast<const NcDim**>(&(vecVarDimOut[0])));
+				if (varOut == NULL) {
+					_EXCEPTION2("Unable to create variable \"%s\" in file \"%s\"",
+						varIn->name(), strOutputFile.c_str());
+				}
+				CopyNcVarAttributes(varIn, varOut);
+
+				std::vector<long> vecVarInSize(lAuxDims+2, 1);
+				std::vector<long> vecVarInPos(lAuxDims+2, 0);
+
+				std::vector<long> vecVarOutSize(lAuxDims+1, 1);
+				std::vector<long> vecVarOutPos(lAuxDims+1, 0);
+
+				vecVarInSize[lAuxDims] = varIn->get_dim(lAuxDims)->size();
+				vecVarInSize[lAuxDims+1] = varIn->get_dim(lAuxDims+1)->size();
+				vecVarOutSize[lAuxDims] = lCount;
+
+				// Loop over all auxiliary indices and restructure
+				for (long s = 0; s < lAuxDimSize; s++) {
+
+					SetAuxiliaryPosition(s, vecDimOut, vecVarInPos);
+					for (long d = 0; d < lAuxDims; d++) {
+						vecVarOutPos[d] = vecVarInPos[d];
+					}
+
+					varIn->set_cur(&(vecVarInPos[0]));
+					varIn->get(&(dData[0]), &(vecVarInSize[0]));
+
+					varOut->set_cur(&(vecVarOutPos[0]));
+
+					if (lCount == lSpatialSize) {
+						varOut->put(&(dData[0]), &(vecVarOutSize[0]));
+						continue;
+					}
+
+#pragma omp parallel for schedule(static)
+					for (long ix = 0; ix < lCount; ix++) {
+						dDataVectorized[ix] = dData[vecDataIndex[ix]];
+					}
 
-				if (fVariable) {
-					varOut->put(&(dDataVectorized[0]), lCount);
+					varOut->put(&(dDataVectorized[0]), &(vecVarOutSize[0]));
 				}
 			}
 
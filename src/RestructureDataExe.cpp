@@ -18,9 +18,11 @@
 #include "GridElements.h"
 #include "Exception.h"
 #include "Announce.h"
+#include "STLStringHelper.h"
 
 #include <cmath>
 #include <iostream>
+#include <vector>
 
 #include "TempestRemapAPI.h"
 
@@ -31,6 +33,9 @@ int main(int argc, char** argv) {
 	// Input file
 	std::string strInputFile;
 
+	// List of input files
+	std::string strInputFileList;
+
 	// Variable name to restructure
 	std::string strVariable;
 
@@ -49,6 +54,9 @@ int main(int argc, char** argv) {
 	// Output filename
 	std::string strOutputFile;
 
+	// List of output files
+	std::string strOutputFileList;
+
 	// Output format
 	std::string strOutputFormat;
 
@@ -58,12 +66,14 @@ int main(int argc, char** argv) {
 	// Parse the command line
 	BeginCommandLine()
 	CommandLineString(strInputFile, "in_file", "");
+	CommandLineString(strInputFileList, "in_file_list", "");
 	CommandLineString(strVariable, "var", "");
 	CommandLineString(strFillValue, "fillvalue", "");
 	CommandLineString(strRefFile, "ref_file", "");
 	CommandLineString(strRefFileLonName, "ref_file_lon", "lon");
 	CommandLineString(strRefFileLatName, "ref_file_lat", "lat");
 	CommandLineString(strOutputFile, "out_file", "");
+	CommandLineString(strOutputFileList, "out_file_list", "");
 	CommandLineString(strOutputFormat, "out_format", "Netcdf4");
 	CommandLineBool(fVerbose, "verbose");
 	ParseCommandLine(argc, argv);
@@ -71,19 +81,59 @@ int main(int argc, char** argv) {
 
 	AnnounceBanner();
 
-	// Call the actual mesh generator
-	Mesh mesh;
-	int err = RestructureData(
-		strInputFile,
-		strVariable,
-		strFillValue,
-		strRefFile,
-		strRefFileLonName,
-		strRefFileLatName,
-		strOutputFile, 
-		strOutputFormat,
-		fVerbose);
-	if (err) exit(err);
+	// Build the lists of files to restructure
+	std::vector<std::string> vecInputFiles;
+	std::vector<std::string> vecOutputFiles;
+
+try {
+	if ((strInputFile != "") && (strInputFileList != "")) {
+		_EXCEPTIONT("Only one of --in_file or --in_file_list may be specified");
+	}
+	if ((strOutputFile != "") && (strOutputFileList != "")) {
+		_EXCEPTIONT("Only one of --out_file or --out_file_list may be specified");
+	}
+
+	if (strInputFileList != "") {
+		STLStringHelper::ParseFileList(strInputFileList, vecInputFiles);
+	} else {
+		vecInputFiles.push_back(strInputFile);
+	}
+
+	if (strOutputFileList != "") {
+		STLStringHelper::ParseFileList(strOutputFileList, vecOutputFiles);
+	} else {
+		vecOutputFiles.push_back(strOutputFile);
+	}
+
+	if (vecInputFiles.size() != vecOutputFiles.size()) {
+		_EXCEPTIONT("Mismatch in --in_file_list and --out_file_list file length");
+	}
+
+} catch(Exception & e) {
+	Announce(e.ToString().c_str());
+	return (-1);
+}
+
+	// Restructure each file; the index of the reference grid is cached
+	// between calls so it is only computed once
+	for (size_t f = 0; f < vecInputFiles.size(); f++) {
+		if (vecInputFiles.size() > 1) {
+			Announce("File %lu / %lu: %s",
+				f+1, vecInputFiles.size(), vecInputFiles[f].c_str());
+		}
+
+		int err = RestructureData(
+			vecInputFiles[f],
+			strVariable,
+			strFillValue,
+			strRefFile,
+			strRefFileLonName,
+			strRefFileLatName,
+			vecOutputFiles[f],
+			strOutputFormat,
+			fVerbose);
+		if (err) exit(err);
+	}
 
 	return 0;
 }
@@ -17,7 +17,11 @@
 #ifndef _STLSTRINGHELPER_H_
 #define _STLSTRINGHELPER_H_
 
+#include "Exception.h"
+
 #include <string>
+#include <vector>
+#include <fstream>
 
 #include <cstring>
 
@@ -150,6 +154,33 @@ static void RemoveWhitespaceInPlace(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		Read a list of files from a text file, one filename per line.
+///		Empty lines and lines beginning with '#' are ignored.
+///	</summary>
+inline static void ParseFileList(
+	const std::string & strFileList,
+	std::vector<std::string> & vecFiles
+) {
+	std::ifstream ifFileList(strFileList.c_str());
+	if (!ifFileList.is_open()) {
+		_EXCEPTION1("Unable to open file \"%s\"",
+			strFileList.c_str());
+	}
+	std::string strFileLine;
+	while (std::getline(ifFileList, strFileLine)) {
+		if (strFileLine.length() == 0) {
+			continue;
+		}
+		if (strFileLine[0] == '#') {
+			continue;
+		}
+		vecFiles.push_back(strFileLine);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 };
 
 #endif
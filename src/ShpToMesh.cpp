@@ -18,12 +18,16 @@
 #include "GridElements.h"
 #include "Exception.h"
 #include "Announce.h"
+#include "MemoryMappedFile.h"
 #include "order32.h"
 
 #include "netcdfcpp.h"
 
 #include <cmath>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -106,6 +110,264 @@ double SwapEndianDouble(const double num) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		Read a 32-bit integer stored in big-endian byte order.
+///	</summary>
+static int32_t ReadBigEndianInt32(const char * p) {
+	int32_t num;
+	memcpy(&num, p, sizeof(int32_t));
+	if (O32_HOST_ORDER == O32_LITTLE_ENDIAN) {
+		num = SwapEndianInt32(num);
+	}
+	return num;
+}
+
+///	<summary>
+///		Read a 32-bit integer stored in little-endian byte order.
+///	</summary>
+static int32_t ReadLittleEndianInt32(const char * p) {
+	int32_t num;
+	memcpy(&num, p, sizeof(int32_t));
+	if (O32_HOST_ORDER == O32_BIG_ENDIAN) {
+		num = SwapEndianInt32(num);
+	}
+	return num;
+}
+
+///	<summary>
+///		Read a double stored in little-endian byte order.
+///	</summary>
+static double ReadLittleEndianDouble(const char * p) {
+	double num;
+	memcpy(&num, p, sizeof(double));
+	if (O32_HOST_ORDER == O32_BIG_ENDIAN) {
+		num = SwapEndianDouble(num);
+	}
+	return num;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Size of the main file and index file headers, in bytes.
+///	</summary>
+static const size_t SHPHeaderBytes = 100;
+
+///	<summary>
+///		Size of a record header in the main file, in bytes.
+///	</summary>
+static const size_t SHPRecordHeaderBytes = 8;
+
+///	<summary>
+///		Size of the polygon record content preceding the parts array (shape
+///		type, bounding box, number of parts and number of points), in bytes.
+///	</summary>
+static const size_t SHPPolygonContentHeaderBytes = 44;
+
+///	<summary>
+///		A polygon record of the main file, located in the memory mapping.
+///	</summary>
+struct SHPPolygonRecord {
+
+	///	<summary>
+	///		Byte offset of the record header in the main file.
+	///	</summary>
+	size_t sOffset;
+
+	///	<summary>
+	///		Record number.
+	///	</summary>
+	int32_t iNumber;
+
+	///	<summary>
+	///		Bounding box and number of parts and points of the polygon.
+	///	</summary>
+	SHPPolygonHeader shppolyhead;
+
+	///	<summary>
+	///		Index of the largest part, its number of points and its first
+	///		and one past last points.
+	///	</summary>
+	int iLargestPart;
+	int nLargestPartSize;
+	int iLargestPartBeginIx;
+	int iLargestPartEndIx;
+
+	///	<summary>
+	///		Pointer to the point coordinates of the polygon.
+	///	</summary>
+	const char * pPoints;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Parse the polygon record at the given byte offset of the main file.
+///		Returns an empty string on success or a description of the error.
+///	</summary>
+static std::string ParseSHPPolygonRecord(
+	const char * pData,
+	size_t sSize,
+	size_t sOffset,
+	SHPPolygonRecord & shprec
+) {
+	shprec.sOffset = sOffset;
+
+	if (sOffset + SHPRecordHeaderBytes + SHPPolygonContentHeaderBytes > sSize) {
+		return std::string("Record extends past end of file");
+	}
+
+	const char * pRecord = pData + sOffset;
+
+	shprec.iNumber = ReadBigEndianInt32(pRecord);
+	const size_t sContentBytes =
+		2 * static_cast<size_t>(ReadBigEndianInt32(pRecord + 4));
+
+	if (sOffset + SHPRecordHeaderBytes + sContentBytes > sSize) {
+		return std::string("Record extends past end of file");
+	}
+	if (sContentBytes < SHPPolygonContentHeaderBytes) {
+		return std::string("Record too short for polygon");
+	}
+
+	const char * pContent = pRecord + SHPRecordHeaderBytes;
+
+	// Read the shape type
+	if (ReadLittleEndianInt32(pContent) != SHPPolygonType) {
+		return std::string("Record Polygon type expected");
+	}
+
+	// Read the polygon header
+	SHPPolygonHeader & shppolyhead = shprec.shppolyhead;
+	shppolyhead.dXmin = ReadLittleEndianDouble(pContent + 4);
+	shppolyhead.dYmin = ReadLittleEndianDouble(pContent + 12);
+	shppolyhead.dXmax = ReadLittleEndianDouble(pContent + 20);
+	shppolyhead.dYmax = ReadLittleEndianDouble(pContent + 28);
+	shppolyhead.nNumParts = ReadLittleEndianInt32(pContent + 36);
+	shppolyhead.nNumPoints = ReadLittleEndianInt32(pContent + 40);
+
+	// Sanity check
+	if ((shppolyhead.nNumParts < 1) || (shppolyhead.nNumParts > 0x1000000)) {
+		return std::string("Polygon NumParts exceeds sanity bound");
+	}
+	if ((shppolyhead.nNumPoints < 0) || (shppolyhead.nNumPoints > 0x1000000)) {
+		return std::string("Polygon NumPoints exceeds sanity bound");
+	}
+
+	const size_t sPartsBytes =
+		static_cast<size_t>(shppolyhead.nNumParts) * sizeof(int32_t);
+	const size_t sPointsBytes =
+		static_cast<size_t>(shppolyhead.nNumPoints) * 2 * sizeof(double);
+
+	if (SHPPolygonContentHeaderBytes + sPartsBytes + sPointsBytes > sContentBytes) {
+		return std::string("Polygon parts and points exceed record length");
+	}
+
+	const char * pParts = pContent + SHPPolygonContentHeaderBytes;
+	shprec.pPoints = pParts + sPartsBytes;
+
+	// Find the largest part
+	shprec.iLargestPart = 0;
+	shprec.nLargestPartSize = 0;
+	shprec.iLargestPartBeginIx = 0;
+	shprec.iLargestPartEndIx = shppolyhead.nNumPoints;
+
+	for (int i = 0; i < shppolyhead.nNumParts; i++) {
+		int iPartBeginIx = ReadLittleEndianInt32(pParts + i * sizeof(int32_t));
+		int iPartEndIx = shppolyhead.nNumPoints;
+		if (i != shppolyhead.nNumParts-1) {
+			iPartEndIx = ReadLittleEndianInt32(pParts + (i+1) * sizeof(int32_t));
+		}
+		if ((iPartBeginIx < 0) || (iPartEndIx < iPartBeginIx) ||
+		    (iPartEndIx > shppolyhead.nNumPoints)
+		) {
+			return std::string("Polygon part index out of range");
+		}
+
+		int nPartSize = iPartEndIx - iPartBeginIx;
+		if (nPartSize > shprec.nLargestPartSize) {
+			shprec.iLargestPart = i;
+			shprec.nLargestPartSize = nPartSize;
+			shprec.iLargestPartBeginIx = iPartBeginIx;
+			shprec.iLargestPartEndIx = iPartEndIx;
+		}
+	}
+
+	if (shppolyhead.nNumParts == 1) {
+		shprec.iLargestPartBeginIx = 0;
+		shprec.iLargestPartEndIx = shppolyhead.nNumPoints;
+		shprec.nLargestPartSize = shppolyhead.nNumPoints;
+	}
+
+	return std::string();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Get the byte offsets of all records in the main file, from the
+///		index (.shx) file if it exists, or otherwise by walking the record
+///		headers of the main file.
+///	</summary>
+static void GetSHPRecordOffsets(
+	const std::string & strInputFile,
+	const char * pData,
+	size_t sSize,
+	size_t sFileLength,
+	std::vector<size_t> & vecOffsets
+) {
+	vecOffsets.clear();
+
+	// Index file shares the name of the main file with extension .shx
+	std::string strIndexFile = strInputFile;
+	size_t sLength = strIndexFile.length();
+	if ((sLength > 4) && (strIndexFile[sLength-4] == '.')) {
+		const bool fUpper = (strIndexFile[sLength-1] == 'P');
+		strIndexFile[sLength-1] = fUpper ? 'X' : 'x';
+	} else {
+		strIndexFile += ".shx";
+	}
+
+	std::ifstream ifIndex(strIndexFile.c_str(), std::ios::in | std::ios::binary);
+	if ((strIndexFile != strInputFile) && ifIndex.is_open()) {
+		ifIndex.close();
+
+		MemoryMappedFile mmfIndex;
+		mmfIndex.Open(strIndexFile);
+
+		const char * pIndex = static_cast<const char *>(mmfIndex.GetData());
+		size_t sIndexSize = mmfIndex.GetSize();
+
+		if ((sIndexSize < SHPHeaderBytes) ||
+		    (ReadBigEndianInt32(pIndex) != SHPFileCodeRef)
+		) {
+			_EXCEPTION1("Index file \"%s\" does not appear to be a ESRI "
+				"Shapefile index", strIndexFile.c_str());
+		}
+
+		const size_t sRecords = (sIndexSize - SHPHeaderBytes) / 8;
+		vecOffsets.resize(sRecords);
+		for (size_t i = 0; i < sRecords; i++) {
+			vecOffsets[i] = 2 * static_cast<size_t>(
+				ReadBigEndianInt32(pIndex + SHPHeaderBytes + 8 * i));
+		}
+
+		Announce("Read %lu record offsets from \"%s\"",
+			sRecords, strIndexFile.c_str());
+		return;
+	}
+
+	// Walk the record headers of the main file
+	size_t sOffset = SHPHeaderBytes;
+	while (sOffset + SHPRecordHeaderBytes <= sFileLength) {
+		vecOffsets.push_back(sOffset);
+		sOffset += SHPRecordHeaderBytes
+			+ 2 * static_cast<size_t>(ReadBigEndianInt32(pData + sOffset + 4));
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 int main(int argc, char** argv) {
 
 	NcError error(NcError::silent_nonfatal);
@@ -135,6 +397,9 @@ try {
 	// Calculate and display area of mesh
 	bool fCalculateArea;
 
+	// Display information on every polygon
+	bool fVerbose;
+
 	// Parse the command line
 	BeginCommandLine()
 		CommandLineString(strInputFile, "in", "");
@@ -145,6 +410,7 @@ try {
 		CommandLineInt(iPolygonLast, "polygon_last", (-1));
 		CommandLineInt(nCoarsen, "coarsen", 1);
 		CommandLineBool(fCalculateArea, "calculatearea");
+		CommandLineBool(fVerbose, "verbose");
 
 		ParseCommandLine(argc, argv);
 	EndCommandLine(argv)
@@ -166,22 +432,27 @@ try {
 	// Load shapefile
 	AnnounceStartBlock("Loading shapefile");
 
-	std::ifstream shpfile(
-		strInputFile.c_str(), std::ios::in | std::ios::binary);
+	if (strXYUnits != "lonlat") {
+		_EXCEPTION1("Invalid units \"%s\"", strXYUnits.c_str());
+	}
 
-	SHPHeader shphead;
-	shpfile.read((char*)(&shphead), sizeof(SHPHeader));
+	MemoryMappedFile mmfShp;
+	mmfShp.Open(strInputFile);
 
-	if (O32_HOST_ORDER == O32_LITTLE_ENDIAN) {
-		shphead.iFileCode = SwapEndianInt32(shphead.iFileCode);
-		shphead.iFileLength = SwapEndianInt32(shphead.iFileLength);
-	} else if (O32_HOST_ORDER == O32_BIG_ENDIAN) {
-		shphead.iVersion = SwapEndianInt32(shphead.iVersion);
-		shphead.iShapeType = SwapEndianInt32(shphead.iShapeType);
-	} else {
-		_EXCEPTIONT("Invalid system Endian");
+	const char * pData = static_cast<const char *>(mmfShp.GetData());
+	const size_t sSize = mmfShp.GetSize();
+
+	if (sSize < SHPHeaderBytes) {
+		_EXCEPTIONT("Input file does not appear to be a ESRI Shapefile: "
+			"File too short");
 	}
 
+	SHPHeader shphead;
+	shphead.iFileCode = ReadBigEndianInt32(pData);
+	shphead.iFileLength = ReadBigEndianInt32(pData + 24);
+	shphead.iVersion = ReadLittleEndianInt32(pData + 28);
+	shphead.iShapeType = ReadLittleEndianInt32(pData + 32);
+
 	if (shphead.iFileCode != SHPFileCodeRef) {
 		_EXCEPTIONT("Input file does not appear to be a ESRI Shapefile: "
 			"File code mismatch");
@@ -193,210 +464,160 @@ try {
 		_EXCEPTIONT("Input file error: Polygon type expected");
 	}
 
-	SHPBounds shpbounds;
-	shpfile.read((char*)(&shpbounds), sizeof(SHPBounds));
-
-	if (O32_HOST_ORDER == O32_BIG_ENDIAN) {
-		shpbounds.dXmin = SwapEndianDouble(shpbounds.dXmin);
-		shpbounds.dYmin = SwapEndianDouble(shpbounds.dYmin);
-		shpbounds.dXmax = SwapEndianDouble(shpbounds.dXmax);
-		shpbounds.dYmax = SwapEndianDouble(shpbounds.dXmax);
-
-		shpbounds.dZmin = SwapEndianDouble(shpbounds.dZmin);
-		shpbounds.dZmax = SwapEndianDouble(shpbounds.dZmax);
-
-		shpbounds.dMmin = SwapEndianDouble(shpbounds.dMmin);
-		shpbounds.dMmax = SwapEndianDouble(shpbounds.dMmax);
+	// File length (in 16-bit words) may not exceed the mapped size
+	size_t sFileLength = 2 * static_cast<size_t>(shphead.iFileLength);
+	if (sFileLength > sSize) {
+		sFileLength = sSize;
 	}
 
-	// Current position (in 16-bit words)
-	int32_t iCurrentPosition = 50;
+	// Locate records
+	std::vector<size_t> vecOffsets;
+	GetSHPRecordOffsets(
+		strInputFile, pData, sSize, sFileLength, vecOffsets);
 
-	int32_t iPolygonIx = 1;
+	const int nRecords = static_cast<int>(vecOffsets.size());
 
-	// Exodus mesh
-	Mesh mesh;
+	Announce("Parsing %i records", nRecords);
 
-	// Load records
-	while (iCurrentPosition < shphead.iFileLength) {
+	// Parse records in parallel
+	std::vector<SHPPolygonRecord> vecRecords(nRecords);
+	std::vector<std::string> vecErrors(nRecords);
 
-		// Read the record header
-		SHPRecordHeader shprechead;
-		shpfile.read((char*)(&shprechead), sizeof(SHPRecordHeader));
-		if (shpfile.eof()) {
-			break;
-		}
+	int nErrors = 0;
 
-		if (O32_HOST_ORDER == O32_LITTLE_ENDIAN) {
-			shprechead.iNumber = SwapEndianInt32(shprechead.iNumber);
-			shprechead.nLength = SwapEndianInt32(shprechead.nLength);
+#pragma omp parallel for schedule(dynamic, 64) reduction(+:nErrors)
+	for (int r = 0; r < nRecords; r++) {
+		vecErrors[r] =
+			ParseSHPPolygonRecord(
+				pData, sFileLength, vecOffsets[r], vecRecords[r]);
+		if (vecErrors[r].length() != 0) {
+			nErrors++;
 		}
+	}
 
-		char szBuffer[128];
-		sprintf(szBuffer, "Polygon %i", shprechead.iNumber);
-		iPolygonIx++;
-		AnnounceStartBlock(szBuffer);
-
-		iCurrentPosition += shprechead.nLength;
-
-		// Read the shape type
-		int32_t iShapeType;
-		shpfile.read((char*)(&iShapeType), sizeof(int32_t));
-		if (shpfile.eof()) {
-			break;
+	if (nErrors != 0) {
+		for (int r = 0; r < nRecords; r++) {
+			if (vecErrors[r].length() != 0) {
+				_EXCEPTION2("Input file error in record at byte %lu: %s",
+					vecOffsets[r], vecErrors[r].c_str());
+			}
 		}
+	}
 
-		if (O32_HOST_ORDER == O32_BIG_ENDIAN) {
-			iShapeType = SwapEndianInt32(iShapeType);
-		}
-		if (iShapeType != SHPPolygonType) {
-			_EXCEPTIONT("Input file error: Record Polygon type expected");
+	// Select records and assign nodes to Faces
+	std::vector<int> vecRecordIx;
+	std::vector<size_t> vecNodeBegin(1, 0);
+
+	int nMultiPartPolygons = 0;
+
+	for (int r = 0; r < nRecords; r++) {
+		const SHPPolygonRecord & shprec = vecRecords[r];
+
+		if (fVerbose) {
+			char szBuffer[128];
+			sprintf(szBuffer, "Polygon %i", shprec.iNumber);
+			AnnounceStartBlock(szBuffer);
+			Announce("containing %i part(s) with %i points",
+				shprec.shppolyhead.nNumParts,
+				shprec.shppolyhead.nNumPoints);
+			Announce("Xmin: %3.5f", shprec.shppolyhead.dXmin);
+			Announce("Ymin: %3.5f", shprec.shppolyhead.dYmin);
+			Announce("Xmax: %3.5f", shprec.shppolyhead.dXmax);
+			Announce("Ymax: %3.5f", shprec.shppolyhead.dYmax);
+			if (shprec.shppolyhead.nNumParts > 1) {
+				Announce("Using part %i with %i points [%i, %i]",
+					shprec.iLargestPart, shprec.nLargestPartSize,
+					shprec.iLargestPartBeginIx, shprec.iLargestPartEndIx-1);
+			}
+			AnnounceEndBlock(NULL);
 		}
 
-		// Read the polygon header
-		SHPPolygonHeader shppolyhead;
-		shpfile.read((char*)(&shppolyhead), sizeof(SHPPolygonHeader));
-		if (shpfile.eof()) {
-			break;
+		if ((iPolygonFirst != (-1)) && (shprec.iNumber < iPolygonFirst)) {
+			continue;
 		}
-
-		if (O32_HOST_ORDER == O32_BIG_ENDIAN) {
-			shppolyhead.dXmin = SwapEndianDouble(shppolyhead.dXmin);
-			shppolyhead.dYmin = SwapEndianDouble(shppolyhead.dYmin);
-			shppolyhead.dXmax = SwapEndianDouble(shppolyhead.dXmax);
-			shppolyhead.dYmax = SwapEndianDouble(shppolyhead.dYmax);
-			shppolyhead.nNumParts = SwapEndianInt32(shppolyhead.nNumParts);
-			shppolyhead.nNumPoints = SwapEndianInt32(shppolyhead.nNumPoints);
+		if ((iPolygonLast != (-1)) && (shprec.iNumber > iPolygonLast)) {
+			continue;
 		}
 
-		// Sanity check
-		if (shppolyhead.nNumParts > 0x1000000) {
-			_EXCEPTION1("Polygon NumParts exceeds sanity bound (%i)",
-				shppolyhead.nNumParts);
-		}
-		if (shppolyhead.nNumPoints > 0x1000000) {
-			_EXCEPTION1("Polygon NumPoints exceeds sanity bound (%i)",
-				shppolyhead.nNumPoints);
-		}
-		Announce("containing %i part(s) with %i points",
-			shppolyhead.nNumParts,
-			shppolyhead.nNumPoints);
-		Announce("Xmin: %3.5f", shppolyhead.dXmin);
-		Announce("Ymin: %3.5f", shppolyhead.dYmin);
-		Announce("Xmax: %3.5f", shppolyhead.dXmax);
-		Announce("Ymax: %3.5f", shppolyhead.dYmax);
-
-		if (shppolyhead.nNumParts != 1) {
-			Announce("WARNING: Only polygons with 1 part currently supported"
-				" in Exodus format; ignoring remaining parts");
-			//_EXCEPTIONT("Only polygons with 1 part currently supported"
-			//	" in Exodus format");
+		if (shprec.shppolyhead.nNumParts != 1) {
+			nMultiPartPolygons++;
 		}
 
-		DataArray1D<int32_t> iPartBeginIx(shppolyhead.nNumParts+1);
-		shpfile.read((char*)&(iPartBeginIx[0]),
-			shppolyhead.nNumParts * sizeof(int32_t));
-		if (shpfile.eof()) {
-			break;
-		}
-		iPartBeginIx[shppolyhead.nNumParts] = shppolyhead.nNumPoints;
+		int nShpNodes =
+			(shprec.iLargestPartEndIx - shprec.iLargestPartBeginIx) / nCoarsen;
 
-		DataArray1D<double> dPoints(shppolyhead.nNumPoints * 2);
-		shpfile.read((char*)&(dPoints[0]),
-			shppolyhead.nNumPoints * 2 * sizeof(double));
-		if (shpfile.eof()) {
-			break;
-		}
+		vecRecordIx.push_back(r);
+		vecNodeBegin.push_back(vecNodeBegin.back() + nShpNodes);
+	}
 
-		if (O32_HOST_ORDER == O32_BIG_ENDIAN) {
-			for (int i = 0; i < shppolyhead.nNumParts; i++) {
-				iPartBeginIx[i] = SwapEndianInt32(iPartBeginIx[i]);
-			}
-			for (int i = 0; i < shppolyhead.nNumPoints * 2; i++) {
-				dPoints[i] = SwapEndianDouble(dPoints[i]);
-			}
-		}
+	if (nMultiPartPolygons != 0) {
+		Announce("WARNING: Only polygons with 1 part currently supported"
+			" in Exodus format; ignoring remaining parts of %i polygons",
+			nMultiPartPolygons);
+	}
 
-		if ((iPolygonFirst != (-1)) && (shprechead.iNumber < iPolygonFirst)) {
-			AnnounceEndBlock("Done");
-			continue;
-		}
+	// Exodus mesh
+	Mesh mesh;
 
-		if ((iPolygonLast != (-1)) && (shprechead.iNumber > iPolygonLast)) {
-			AnnounceEndBlock("Done");
-			continue;
-		}
+	const int nFaces = static_cast<int>(vecRecordIx.size());
 
-		// Find the largest part
-		int iLargestPartBeginIx = 0;
-		int iLargestPartEndIx = shppolyhead.nNumPoints;
-		if (shppolyhead.nNumParts > 1) {
-			int iMaxPartIx = 0;
-			int nMaxPartSize = 0;
-			for (int i = 0; i < iPartBeginIx.GetRows()-1; i++) {
-				int nPartSize = iPartBeginIx[i+1] - iPartBeginIx[i];
-				if (nPartSize > nMaxPartSize) {
-					iMaxPartIx = i;
-					nMaxPartSize = nPartSize;
-					iLargestPartBeginIx = iPartBeginIx[i];
-					iLargestPartEndIx = iPartBeginIx[i+1];
-				}
-			}
-			Announce("Using part %i with %i points [%i, %i]",
-				iMaxPartIx, nMaxPartSize,
-				iLargestPartBeginIx, iLargestPartEndIx-1);
-		}
-/*
-		FILE * fp = fopen("log.txt", "w");
-		for (int i = 0; i < shppolyhead.nNumPoints; i++) {
-			fprintf(fp, "%1.15e %1.15e\n", dPoints[2*i], dPoints[2*i+1]);
-		}
-		fclose(fp);
-*/
-		// Convert to Exodus mesh.
-		int nFaces = mesh.faces.size();
-		int nNodes = mesh.nodes.size();
+	mesh.faces.resize(nFaces);
+	mesh.nodes.resize(vecNodeBegin.back());
 
-		int nShpNodes = (iLargestPartEndIx - iLargestPartBeginIx) / nCoarsen;
+	Announce("Building mesh with %i faces and %lu nodes",
+		nFaces, mesh.nodes.size());
 
-		mesh.faces.resize(nFaces+1);
-		mesh.nodes.resize(nNodes + nShpNodes);
+	// Convert from longitude/latitude to XYZ
+#pragma omp parallel for schedule(dynamic, 64)
+	for (int f = 0; f < nFaces; f++) {
+		const SHPPolygonRecord & shprec = vecRecords[vecRecordIx[f]];
 
-		mesh.faces[nFaces] = Face(nShpNodes);
+		const int nShpNodes =
+			static_cast<int>(vecNodeBegin[f+1] - vecNodeBegin[f]);
+		const int nNodes = static_cast<int>(vecNodeBegin[f]);
 
-		// Convert from longitude/latitude to XYZ
-		if (strXYUnits == "lonlat") {
-			for (int i = 0; i < nShpNodes; i++) {
-				int ix = iLargestPartBeginIx + i * nCoarsen;
+		mesh.faces[f] = Face(nShpNodes);
 
-				double dLonRad = dPoints[2*ix] / 180.0 * M_PI;
-				double dLatRad = dPoints[2*ix+1] / 180.0 * M_PI;
+		for (int i = 0; i < nShpNodes; i++) {
+			int ix = shprec.iLargestPartBeginIx + i * nCoarsen;
 
-				mesh.nodes[nNodes+i].x = cos(dLatRad) * cos(dLonRad);
-				mesh.nodes[nNodes+i].y = cos(dLatRad) * sin(dLonRad);
-				mesh.nodes[nNodes+i].z = sin(dLatRad);
+			double dLonRad =
+				ReadLittleEndianDouble(
+					shprec.pPoints + (2*ix) * sizeof(double)) / 180.0 * M_PI;
+			double dLatRad =
+				ReadLittleEndianDouble(
+					shprec.pPoints + (2*ix+1) * sizeof(double)) / 180.0 * M_PI;
 
-				// Note that shapefile polygons are specified in clockwise order,
-				// whereas Exodus files request polygons to be specified in
-				// counter-clockwise order.  Hence we need to reorient these Faces.
-				mesh.faces[nFaces].SetNode(
-					nShpNodes - i - 1, nNodes + i);
-			}
+			mesh.nodes[nNodes+i].x = cos(dLatRad) * cos(dLonRad);
+			mesh.nodes[nNodes+i].y = cos(dLatRad) * sin(dLonRad);
+			mesh.nodes[nNodes+i].z = sin(dLatRad);
 
-		} else {
-			_EXCEPTION1("Invalid units \"%s\"", strXYUnits.c_str());
+			// Note that shapefile polygons are specified in clockwise order,
+			// whereas Exodus files request polygons to be specified in
+			// counter-clockwise order.  Hence we need to reorient these Faces.
+			mesh.faces[f].SetNode(
+				nShpNodes - i - 1, nNodes + i);
 		}
+	}
 
-		// Calculate Face area
-		if (fCalculateArea) {
-			double dArea =
-				CalculateFaceArea_Concave(
-					mesh.faces[nFaces], mesh.nodes);
+	// Calculate Face area
+	if (fCalculateArea) {
+		std::vector<double> vecArea(nFaces);
 
-			Announce("Area: %1.15e sr", dArea);
+#pragma omp parallel for schedule(dynamic, 64)
+		for (int f = 0; f < nFaces; f++) {
+			vecArea[f] =
+				CalculateFaceArea_Concave(
+					mesh.faces[f], mesh.nodes);
 		}
 
-		AnnounceEndBlock("Done");
+		double dTotalArea = 0.0;
+		for (int f = 0; f < nFaces; f++) {
+			Announce("Polygon %i area: %1.15e sr",
+				vecRecords[vecRecordIx[f]].iNumber, vecArea[f]);
+			dTotalArea += vecArea[f];
+		}
+		Announce("Total area: %1.15e sr", dTotalArea);
 	}
 
 	AnnounceEndBlock("Done");
@@ -404,8 +625,7 @@ try {
 	// Convexify the mesh
 	if (fConvexify) {
 		AnnounceStartBlock("Convexify mesh");
-		Mesh meshtemp = mesh;
-		ConvexifyMesh(meshtemp, mesh, true);
+		ConvexifyMesh(mesh, true);
 		AnnounceEndBlock("Done");
 	}
 
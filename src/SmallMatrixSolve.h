@@ -0,0 +1,178 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    SmallMatrixSolve.h
+///	\author  Paul Ullrich
+///	\version October 14, 2026
+///
+///	<remarks>
+///		Copyright 2026 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#ifndef _SMALLMATRIXSOLVE_H_
+#define _SMALLMATRIXSOLVE_H_
+
+#include <cfloat>
+#include <cmath>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		LU factorization with partial pivoting of a fixed-size dense matrix,
+///		following the unblocked algorithm of LAPACK dgetf2.  The matrix is
+///		factored once and may then be applied to many right-hand sides,
+///		which avoids the overhead of calling dgesv on tiny systems.
+///	</summary>
+template <int N>
+class SmallLUSolver {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	SmallLUSolver() :
+		m_fSingular(true)
+	{ }
+
+	///	<summary>
+	///		Factor a matrix stored in column-major order with leading
+	///		dimension N, as it would be passed to LAPACK.  Returns false if
+	///		the matrix is exactly singular.
+	///	</summary>
+	bool Factor(
+		const double * dA
+	) {
+		for (int i = 0; i < N * N; i++) {
+			m_dLU[i] = dA[i];
+		}
+
+		m_fSingular = false;
+
+		for (int j = 0; j < N; j++) {
+
+			// Find the pivot in this column
+			int p = j;
+			double dMax = fabs(m_dLU[j * N + j]);
+			for (int i = j + 1; i < N; i++) {
+				if (fabs(m_dLU[j * N + i]) > dMax) {
+					dMax = fabs(m_dLU[j * N + i]);
+					p = i;
+				}
+			}
+
+			m_iPivot[j] = p;
+
+			if (m_dLU[j * N + p] == 0.0) {
+				m_fSingular = true;
+				continue;
+			}
+
+			// Swap rows
+			if (p != j) {
+				for (int k = 0; k < N; k++) {
+					double dTemp = m_dLU[k * N + j];
+					m_dLU[k * N + j] = m_dLU[k * N + p];
+					m_dLU[k * N + p] = dTemp;
+				}
+			}
+
+			// Compute multipliers
+			const double dPivot = m_dLU[j * N + j];
+			if (fabs(dPivot) >= DBL_MIN) {
+				const double dInvPivot = 1.0 / dPivot;
+				for (int i = j + 1; i < N; i++) {
+					m_dLU[j * N + i] *= dInvPivot;
+				}
+			} else {
+				for (int i = j + 1; i < N; i++) {
+					m_dLU[j * N + i] /= dPivot;
+				}
+			}
+
+			// Update the trailing submatrix
+			for (int k = j + 1; k < N; k++) {
+				const double dTemp = m_dLU[k * N + j];
+				if (dTemp != 0.0) {
+					for (int i = j + 1; i < N; i++) {
+						m_dLU[k * N + i] -= m_dLU[j * N + i] * dTemp;
+					}
+				}
+			}
+		}
+
+		return (!m_fSingular);
+	}
+
+	///	<summary>
+	///		Determine if the factored matrix is exactly singular.
+	///	</summary>
+	bool IsSingular() const {
+		return m_fSingular;
+	}
+
+	///	<summary>
+	///		Solve the factored system in place.  As with dgesv, the
+	///		right-hand side is left unchanged if the matrix is singular.
+	///	</summary>
+	void Solve(
+		double * dB
+	) const {
+		if (m_fSingular) {
+			return;
+		}
+
+		// Apply row interchanges
+		for (int j = 0; j < N; j++) {
+			if (m_iPivot[j] != j) {
+				double dTemp = dB[j];
+				dB[j] = dB[m_iPivot[j]];
+				dB[m_iPivot[j]] = dTemp;
+			}
+		}
+
+		// Forward substitution with unit lower triangular factor
+		for (int k = 0; k < N; k++) {
+			if (dB[k] != 0.0) {
+				for (int i = k + 1; i < N; i++) {
+					dB[i] -= dB[k] * m_dLU[k * N + i];
+				}
+			}
+		}
+
+		// Back substitution with upper triangular factor
+		for (int k = N - 1; k >= 0; k--) {
+			if (dB[k] != 0.0) {
+				dB[k] /= m_dLU[k * N + k];
+				for (int i = 0; i < k; i++) {
+					dB[i] -= dB[k] * m_dLU[k * N + i];
+				}
+			}
+		}
+	}
+
+private:
+	///	<summary>
+	///		LU factors in column-major order.
+	///	</summary>
+	double m_dLU[N * N];
+
+	///	<summary>
+	///		Row interchanges applied during factorization.
+	///	</summary>
+	int m_iPivot[N];
+
+	///	<summary>
+	///		Flag indicating the matrix is exactly singular.
+	///	</summary>
+	bool m_fSingular;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif
+
@@ -19,39 +19,316 @@
 
 #include "Defines.h"
 #include "DataArray1D.h"
+#include "DataArray2D.h"
+#include "PerformanceOptions.h"
 
 #include <map>
+#include <vector>
+#include <queue>
+#include <string>
+#include <memory>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <algorithm>
+#include <utility>
+
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A temporary file holding a sorted run of SparseMatrix Triplets
+///		spilled to disk.  The file is removed when the run is destroyed.
+///	</summary>
+class SparseMatrixSpillRun {
+
+public:
+	///	<summary>
+	///		Constructor.  Create a new temporary file in the given directory
+	///		and write sTriplets entries of sTripletBytes bytes each.
+	///	</summary>
+	SparseMatrixSpillRun(
+		const std::string & strDir,
+		const void * pTriplets,
+		size_t sTriplets,
+		size_t sTripletBytes
+	) :
+		m_sTriplets(sTriplets)
+	{
+#if defined(_WIN32)
+		_EXCEPTIONT("Spilling SparseMatrix entries is not supported on Windows");
+#else
+		std::string strTemplate = strDir + "/tempest_spill_XXXXXX";
+		std::vector<char> vecTemplate(
+			strTemplate.c_str(), strTemplate.c_str() + strTemplate.length() + 1);
+
+		int fd = mkstemp(&(vecTemplate[0]));
+		if (fd == (-1)) {
+			_EXCEPTION1("Unable to create spill file in \"%s\"", strDir.c_str());
+		}
+		m_strFile = &(vecTemplate[0]);
+
+		FILE * fp = fdopen(fd, "wb");
+		if (fp == NULL) {
+			close(fd);
+			remove(m_strFile.c_str());
+			_EXCEPTION1("Unable to open spill file \"%s\"", m_strFile.c_str());
+		}
+		size_t sWritten = fwrite(pTriplets, sTripletBytes, sTriplets, fp);
+		int iClose = fclose(fp);
+		if ((sWritten != sTriplets) || (iClose != 0)) {
+			remove(m_strFile.c_str());
+			_EXCEPTION1("Unable to write spill file \"%s\"", m_strFile.c_str());
+		}
+#endif
+	}
+
+	///	<summary>
+	///		Destructor.
+	///	</summary>
+	~SparseMatrixSpillRun() {
+		remove(m_strFile.c_str());
+	}
+
+	///	<summary>
+	///		Get the name of the file.
+	///	</summary>
+	const std::string & GetFile() const {
+		return m_strFile;
+	}
+
+	///	<summary>
+	///		Get the number of Triplets in the file.
+	///	</summary>
+	size_t GetTripletCount() const {
+		return m_sTriplets;
+	}
+
+private:
+	SparseMatrixSpillRun(const SparseMatrixSpillRun &);
+	SparseMatrixSpillRun & operator=(const SparseMatrixSpillRun &);
+
+private:
+	///	<summary>
+	///		Name of the file.
+	///	</summary>
+	std::string m_strFile;
+
+	///	<summary>
+	///		Number of Triplets in the file.
+	///	</summary>
+	size_t m_sTriplets;
+};
 
 ///////////////////////////////////////////////////////////////////////////////
 
-template <typename DataType>
+///	<summary>
+///		A sparse matrix with entries of type DataType.  Row and column
+///		indices are of type IndexT, which may be a 64-bit integer for
+///		matrices with more than 2^31 rows or columns.  The number of
+///		nonzeros is always counted with size_t, so 32-bit indices suffice
+///		for matrices with more than 2^31 nonzeros.
+///	</summary>
+template <typename DataType, typename IndexT = int>
 class SparseMatrix {
 
 public:
+	///	<summary>
+	///		Type of row and column indices.
+	///	</summary>
+	typedef IndexT Index;
+
 	///	<summary>
 	///		Sparse matrix map.
 	///	</summary>
-	typedef typename std::pair<int, int> IndexType;
+	typedef typename std::pair<IndexT, IndexT> IndexType;
 	typedef typename std::map<IndexType, DataType> SparseMap;
 	typedef typename SparseMap::value_type SparseMapPair;
 	typedef typename SparseMap::iterator SparseMapIterator;
 	typedef typename SparseMap::const_iterator SparseMapConstIterator;
 	typedef typename std::pair<SparseMapIterator, bool> SparseMapInsertResult;
 
+	///	<summary>
+	///		Estimated memory used by each entry of the map, including the
+	///		tree node overhead.
+	///	</summary>
+	static const size_t SparseMapEntryBytes =
+		sizeof(SparseMapPair) + 4 * sizeof(void*);
+
+	///	<summary>
+	///		A (row, column, value) entry to be added to the SparseMatrix.
+	///	</summary>
+	struct Triplet {
+		IndexT iRow;
+		IndexT iCol;
+		DataType dValue;
+
+		Triplet() { }
+
+		Triplet(IndexT _iRow, IndexT _iCol, DataType _dValue) :
+			iRow(_iRow), iCol(_iCol), dValue(_dValue)
+		{ }
+
+		bool operator<(const Triplet & t) const {
+			if (iRow != t.iRow) {
+				return (iRow < t.iRow);
+			}
+			return (iCol < t.iCol);
+		}
+	};
+
+	///	<summary>
+	///		A vector of Triplets.
+	///	</summary>
+	typedef typename std::vector<Triplet> TripletVector;
+
 public:
 	///	<summary>
 	///		Default constructor.
 	///	</summary>
 	SparseMatrix() :
 		m_nRows(0),
-		m_nCols(0)
+		m_nCols(0),
+		m_sSpillThresholdBytes(0),
+		m_fFinalized(false),
+		m_fAttached(false)
 	{ }
 
+	///	<summary>
+	///		Copy constructor.  CSR arrays are copied into arrays owned by
+	///		this SparseMatrix, including arrays attached with AttachCSR().
+	///	</summary>
+	SparseMatrix(const SparseMatrix<DataType, IndexT> & mat) :
+		m_nRows(0),
+		m_nCols(0),
+		m_sSpillThresholdBytes(0),
+		m_fFinalized(false),
+		m_fAttached(false)
+	{
+		Copy(mat);
+	}
+
+	///	<summary>
+	///		Move constructor.  Entries and CSR arrays are transferred without
+	///		a copy; attached CSR arrays remain views of the same external data.
+	///	</summary>
+	SparseMatrix(SparseMatrix<DataType, IndexT> && mat) :
+		m_nRows(0),
+		m_nCols(0),
+		m_sSpillThresholdBytes(0),
+		m_fFinalized(false),
+		m_fAttached(false)
+	{
+		Take(mat);
+	}
+
+	///	<summary>
+	///		Assignment operator.
+	///	</summary>
+	SparseMatrix<DataType, IndexT> & operator=(const SparseMatrix<DataType, IndexT> & mat) {
+		if (this != &mat) {
+			ReleaseCSR();
+			Copy(mat);
+		}
+		return (*this);
+	}
+
+	///	<summary>
+	///		Move assignment operator.
+	///	</summary>
+	SparseMatrix<DataType, IndexT> & operator=(SparseMatrix<DataType, IndexT> && mat) {
+		if (this != &mat) {
+			m_mapEntries.clear();
+			m_strSpillDir.clear();
+			m_vecSpillRuns.clear();
+			ReleaseCSR();
+			Take(mat);
+		}
+		return (*this);
+	}
+
+private:
+	///	<summary>
+	///		Copy the entries of another SparseMatrix.  The CSR arrays of this
+	///		SparseMatrix must be released.
+	///	</summary>
+	void Copy(const SparseMatrix<DataType, IndexT> & mat) {
+		m_nRows = mat.m_nRows;
+		m_nCols = mat.m_nCols;
+		m_mapEntries = mat.m_mapEntries;
+		m_strSpillDir = mat.m_strSpillDir;
+		m_vecSpillRuns = mat.m_vecSpillRuns;
+		m_sSpillThresholdBytes = mat.m_sSpillThresholdBytes;
+		m_fFinalized = mat.m_fFinalized;
+
+		// Copies own their CSR arrays, so they are never attached
+		m_dataCSRRowPtr = mat.m_dataCSRRowPtr;
+		m_dataCSRCols = mat.m_dataCSRCols;
+		m_dataCSRValues = mat.m_dataCSRValues;
+		m_fAttached = false;
+	}
+
+	///	<summary>
+	///		Take the entries of another SparseMatrix, leaving it empty.
+	///		This SparseMatrix must be empty.
+	///	</summary>
+	void Take(SparseMatrix<DataType, IndexT> & mat) {
+		m_nRows = mat.m_nRows;
+		m_nCols = mat.m_nCols;
+		m_mapEntries.swap(mat.m_mapEntries);
+		m_strSpillDir.swap(mat.m_strSpillDir);
+		m_vecSpillRuns.swap(mat.m_vecSpillRuns);
+		m_sSpillThresholdBytes = mat.m_sSpillThresholdBytes;
+		m_fFinalized = mat.m_fFinalized;
+		m_fAttached = mat.m_fAttached;
+
+		if (m_fAttached) {
+			TakeView(m_dataCSRRowPtr, mat.m_dataCSRRowPtr);
+			TakeView(m_dataCSRCols, mat.m_dataCSRCols);
+			TakeView(m_dataCSRValues, mat.m_dataCSRValues);
+		} else {
+			m_dataCSRRowPtr = std::move(mat.m_dataCSRRowPtr);
+			m_dataCSRCols = std::move(mat.m_dataCSRCols);
+			m_dataCSRValues = std::move(mat.m_dataCSRValues);
+		}
+
+		mat.ReleaseCSR();
+		mat.m_nRows = 0;
+		mat.m_nCols = 0;
+	}
+
+	///	<summary>
+	///		Attach an array to the external data of another, without a copy.
+	///	</summary>
+	template <typename T>
+	static void TakeView(DataArray1D<T> & daTo, DataArray1D<T> & daFrom) {
+		if (!daFrom.IsAttached()) {
+			return;
+		}
+		daTo.SetSize(daFrom.GetRows());
+		daTo.AttachToData(static_cast<T *>(daFrom));
+		daFrom.Detach();
+		daFrom.SetSize(0);
+	}
+
 public:
 	///	<summary>
 	///		Accessor.
 	///	</summary>
-	DataType & operator()(int iRow, int iCol) {
+	DataType & operator()(IndexT iRow, IndexT iCol) {
+		if (m_fFinalized) {
+			_EXCEPTIONT("Attempting to modify a finalized SparseMatrix");
+		}
+
+		MergeSpillRuns();
+
 		SparseMapIterator iter = m_mapEntries.find(IndexType(iRow, iCol));
 		if (iter == m_mapEntries.end()) {
 			if (iRow >= m_nRows) {
@@ -75,30 +352,237 @@ public:
 	///	<summary>
 	///		Get the number of rows in the SparseMatrix.
 	///	</summary>
-	int GetRows() const {
+	IndexT GetRows() const {
 		return m_nRows;
 	}
 
 	///	<summary>
 	///		Get the number of columns in the SparseMatrix.
 	///	</summary>
-	int GetColumns() const {
+	IndexT GetColumns() const {
 		return m_nCols;
 	}
 
+	///	<summary>
+	///		Get the number of nonzero entries in the SparseMatrix.
+	///	</summary>
+	size_t GetNonZeroCount() const {
+		CheckNotSpilled();
+		if (m_fFinalized) {
+			return m_dataCSRValues.GetRows();
+		}
+		return m_mapEntries.size();
+	}
+
+	///	<summary>
+	///		Check if this SparseMatrix has been finalized.
+	///	</summary>
+	bool IsFinalized() const {
+		return m_fFinalized;
+	}
+
+	///	<summary>
+	///		Freeze the SparseMatrix by converting the map of entries into a
+	///		compressed sparse row (CSR) representation.  Once finalized the
+	///		entries can no longer be modified through operator().
+	///	</summary>
+	void Finalize() {
+		if (m_fFinalized) {
+			return;
+		}
+
+		if (m_vecSpillRuns.size() != 0) {
+			FinalizeSpillRuns();
+			m_fFinalized = true;
+			return;
+		}
+
+		const size_t sNonZeros = m_mapEntries.size();
+
+		m_dataCSRRowPtr.Allocate(m_nRows+1);
+		m_dataCSRCols.Allocate(sNonZeros);
+		m_dataCSRValues.Allocate(sNonZeros);
+
+		// The map is ordered by (row, col) so entries are already in CSR order
+		size_t ix = 0;
+		SparseMapConstIterator iter = m_mapEntries.begin();
+		for (; iter != m_mapEntries.end(); iter++) {
+			m_dataCSRRowPtr[iter->first.first+1]++;
+			m_dataCSRCols[ix] = iter->first.second;
+			m_dataCSRValues[ix] = iter->second;
+			ix++;
+		}
+		for (IndexT i = 0; i < m_nRows; i++) {
+			m_dataCSRRowPtr[i+1] += m_dataCSRRowPtr[i];
+		}
+
+		m_mapEntries.clear();
+
+		m_fFinalized = true;
+	}
+
+	///	<summary>
+	///		Convert a finalized SparseMatrix back into its modifiable form.
+	///	</summary>
+	void Unfinalize() {
+		if (!m_fFinalized) {
+			return;
+		}
+
+		m_mapEntries.clear();
+		for (IndexT i = 0; i < m_nRows; i++) {
+			for (size_t j = m_dataCSRRowPtr[i]; j < m_dataCSRRowPtr[i+1]; j++) {
+				m_mapEntries.insert(m_mapEntries.end(),
+					SparseMapPair(
+						IndexType(i, m_dataCSRCols[j]),
+						m_dataCSRValues[j]));
+			}
+		}
+
+		ReleaseCSR();
+	}
+
+	///	<summary>
+	///		Initialize a finalized SparseMatrix as a read-only view of
+	///		externally owned CSR arrays (such as a memory mapped file).  The
+	///		arrays must remain valid for the lifetime of the view or until
+	///		the entries of this SparseMatrix are replaced.
+	///	</summary>
+	void AttachCSR(
+		IndexT nRows,
+		IndexT nCols,
+		size_t sNonZeros,
+		const size_t * pRowPtr,
+		const IndexT * pCols,
+		const DataType * pValues
+	) {
+		if (pRowPtr[nRows] != sNonZeros) {
+			_EXCEPTIONT("CSR row pointers inconsistent with number of nonzeros");
+		}
+
+		m_mapEntries.clear();
+		m_vecSpillRuns.clear();
+		ReleaseCSR();
+
+		m_nRows = nRows;
+		m_nCols = nCols;
+
+		m_dataCSRRowPtr.SetSize(nRows+1);
+		m_dataCSRRowPtr.AttachToData(const_cast<size_t *>(pRowPtr));
+
+		if (sNonZeros != 0) {
+			m_dataCSRCols.SetSize(sNonZeros);
+			m_dataCSRCols.AttachToData(const_cast<IndexT *>(pCols));
+
+			m_dataCSRValues.SetSize(sNonZeros);
+			m_dataCSRValues.AttachToData(const_cast<DataType *>(pValues));
+		}
+
+		m_fFinalized = true;
+		m_fAttached = true;
+	}
+
+	///	<summary>
+	///		Initialize a finalized SparseMatrix from CSR arrays, taking
+	///		ownership of the arrays without a copy.  The columns of each row
+	///		must be sorted and unique.
+	///	</summary>
+	void SetCSR(
+		IndexT nRows,
+		IndexT nCols,
+		DataArray1D<size_t> && dataRowPtr,
+		DataArray1D<IndexT> && dataCols,
+		DataArray1D<DataType> && dataValues
+	) {
+		if (dataRowPtr.GetRows() != static_cast<size_t>(nRows) + 1) {
+			_EXCEPTIONT("CSR row pointers inconsistent with number of rows");
+		}
+		if ((dataRowPtr[nRows] != dataCols.GetRows()) ||
+		    (dataRowPtr[nRows] != dataValues.GetRows())
+		) {
+			_EXCEPTIONT("CSR row pointers inconsistent with number of nonzeros");
+		}
+
+		m_mapEntries.clear();
+		m_vecSpillRuns.clear();
+		ReleaseCSR();
+
+		m_nRows = nRows;
+		m_nCols = nCols;
+
+		m_dataCSRRowPtr = std::move(dataRowPtr);
+		m_dataCSRCols = std::move(dataCols);
+		m_dataCSRValues = std::move(dataValues);
+
+		m_fFinalized = true;
+	}
+
+	///	<summary>
+	///		Get the CSR row pointer array of a finalized SparseMatrix.
+	///	</summary>
+	const DataArray1D<size_t> & GetCSRRowPointers() const {
+		if (!m_fFinalized) {
+			_EXCEPTIONT("SparseMatrix has not been finalized");
+		}
+		return m_dataCSRRowPtr;
+	}
+
+	///	<summary>
+	///		Get the CSR column index array of a finalized SparseMatrix.
+	///	</summary>
+	const DataArray1D<IndexT> & GetCSRColumns() const {
+		if (!m_fFinalized) {
+			_EXCEPTIONT("SparseMatrix has not been finalized");
+		}
+		return m_dataCSRCols;
+	}
+
+	///	<summary>
+	///		Get the CSR value array of a finalized SparseMatrix.
+	///	</summary>
+	const DataArray1D<DataType> & GetCSRValues() const {
+		if (!m_fFinalized) {
+			_EXCEPTIONT("SparseMatrix has not been finalized");
+		}
+		return m_dataCSRValues;
+	}
+
 	///	<summary>
 	///		Get the entries of the SparseMatrix.
 	///	</summary>
 	void GetEntries(
-		DataArray1D<int> & dataRows,
-		DataArray1D<int> & dataCols,
+		DataArray1D<IndexT> & dataRows,
+		DataArray1D<IndexT> & dataCols,
 		DataArray1D<DataType> & dataEntries
 	) const {
+		if (m_fFinalized) {
+			const size_t sNonZeros = m_dataCSRValues.GetRows();
+
+			dataRows.Allocate(sNonZeros);
+			dataCols.Allocate(sNonZeros);
+			dataEntries.Allocate(sNonZeros);
+
+			for (IndexT i = 0; i < m_nRows; i++) {
+				for (size_t j = m_dataCSRRowPtr[i]; j < m_dataCSRRowPtr[i+1]; j++) {
+					dataRows[j] = i;
+				}
+			}
+			if (sNonZeros != 0) {
+				memcpy(&(dataCols[0]), &(m_dataCSRCols[0]),
+					sNonZeros * sizeof(IndexT));
+				memcpy(&(dataEntries[0]), &(m_dataCSRValues[0]),
+					sNonZeros * sizeof(DataType));
+			}
+			return;
+		}
+
+		CheckNotSpilled();
+
 		dataRows.Allocate(m_mapEntries.size());
 		dataCols.Allocate(m_mapEntries.size());
 		dataEntries.Allocate(m_mapEntries.size());
 
-		int ix = 0;
+		size_t ix = 0;
 
 		SparseMapConstIterator iter = m_mapEntries.begin();
 		for (; iter != m_mapEntries.end(); iter++) {
@@ -114,8 +598,8 @@ public:
 	///		Set the entries of the SparseMatrix in bulk.
 	///	</summary>
 	void SetEntries(
-		const DataArray1D<int> & dataRows,
-		const DataArray1D<int> & dataCols,
+		const DataArray1D<IndexT> & dataRows,
+		const DataArray1D<IndexT> & dataCols,
 		const DataArray1D<DataType> & dataEntries
 	) {
 		if (dataRows.GetRows() != dataCols.GetRows()) {
@@ -129,8 +613,11 @@ public:
 		m_nCols = 0;
 
 		m_mapEntries.clear();
+		m_vecSpillRuns.clear();
 
-		for (unsigned i = 0; i < dataRows.GetRows(); i++) {
+		ReleaseCSR();
+
+		for (size_t i = 0; i < dataRows.GetRows(); i++) {
 			if (dataRows[i] >= m_nRows) {
 				m_nRows = dataRows[i] + 1;
 			}
@@ -145,46 +632,1143 @@ public:
 		}
 	}
 
-public:
 	///	<summary>
-	///		Apply the sparse matrix to a DataArray1D.
+	///		Set the entries of the SparseMatrix in bulk and finalize it,
+	///		building the CSR arrays directly rather than through the map of
+	///		entries.  As with SetEntries(), only the first of repeated
+	///		entries is retained.  The result is identical to SetEntries()
+	///		followed by Finalize(), but requires far less memory for large
+	///		matrices.
 	///	</summary>
-	void Apply(
-		const DataArray1D<DataType> & dataVectorIn,
-		DataArray1D<DataType> & dataVectorOut
-	) const {
-/*
-		if (dataVectorIn.GetRows() != m_nCols) {
-			_EXCEPTION1("dataVectorIn has incorrect row count (%i)", m_nCols);
+	void SetFinalizedEntries(
+		const DataArray1D<IndexT> & dataRows,
+		const DataArray1D<IndexT> & dataCols,
+		const DataArray1D<DataType> & dataEntries
+	) {
+		if (dataRows.GetRows() != dataCols.GetRows()) {
+			_EXCEPTIONT("Mismatch between size of dataRows and dataCols");
 		}
-		if (dataVectorOut.GetRows() != m_nRows) {
-			_EXCEPTION1("dataVectorOut has incorrect row count (%i)", m_nRows);
+		if (dataRows.GetRows() != dataEntries.GetRows()) {
+			_EXCEPTIONT("Mismatch between size of dataRows and dataEntries");
 		}
-*/
-		dataVectorOut.Zero();
 
-		SparseMapConstIterator iter = m_mapEntries.begin();
-		for (; iter != m_mapEntries.end(); iter++) {
-			dataVectorOut[iter->first.first] +=
-				iter->second * dataVectorIn[iter->first.second];
+		const size_t sEntries = dataRows.GetRows();
+
+		m_nRows = 0;
+		m_nCols = 0;
+
+		m_mapEntries.clear();
+		m_vecSpillRuns.clear();
+
+		ReleaseCSR();
+
+		for (size_t i = 0; i < sEntries; i++) {
+			if ((dataRows[i] < 0) || (dataCols[i] < 0)) {
+				_EXCEPTIONT("Negative index in SparseMatrix entries");
+			}
+			if (dataRows[i] >= m_nRows) {
+				m_nRows = dataRows[i] + 1;
+			}
+			if (dataCols[i] >= m_nCols) {
+				m_nCols = dataCols[i] + 1;
+			}
+		}
+
+		// Distribute entries over rows, preserving their order within
+		// each row
+		std::vector<size_t> vecRowBegin(static_cast<size_t>(m_nRows) + 1, 0);
+		for (size_t i = 0; i < sEntries; i++) {
+			vecRowBegin[dataRows[i]+1]++;
+		}
+		for (IndexT i = 0; i < m_nRows; i++) {
+			vecRowBegin[i+1] += vecRowBegin[i];
+		}
+
+		std::vector< std::pair<IndexT, DataType> > vecRowEntries(sEntries);
+		{
+			std::vector<size_t> vecRowNext(
+				vecRowBegin.begin(), vecRowBegin.end() - 1);
+
+			for (size_t i = 0; i < sEntries; i++) {
+				vecRowEntries[vecRowNext[dataRows[i]]++] =
+					std::pair<IndexT, DataType>(dataCols[i], dataEntries[i]);
+			}
+		}
+
+		// Sort each row by column and remove repeated entries
+		m_dataCSRRowPtr.Allocate(static_cast<size_t>(m_nRows) + 1);
+
+#pragma omp parallel for schedule(dynamic, 256) if (sEntries >= SparseMatrixParallelApplyThreshold)
+		for (IndexT i = 0; i < m_nRows; i++) {
+			typename std::vector< std::pair<IndexT, DataType> >::iterator
+				iterBegin = vecRowEntries.begin() + vecRowBegin[i];
+			typename std::vector< std::pair<IndexT, DataType> >::iterator
+				iterEnd = vecRowEntries.begin() + vecRowBegin[i+1];
+
+			std::stable_sort(iterBegin, iterEnd, CompareFirst);
+			iterEnd = std::unique(iterBegin, iterEnd, EqualFirst);
+
+			m_dataCSRRowPtr[i+1] = static_cast<size_t>(iterEnd - iterBegin);
+		}
+
+		for (IndexT i = 0; i < m_nRows; i++) {
+			m_dataCSRRowPtr[i+1] += m_dataCSRRowPtr[i];
+		}
+
+		const size_t sNonZeros = m_dataCSRRowPtr[m_nRows];
+		m_dataCSRCols.Allocate(sNonZeros);
+		m_dataCSRValues.Allocate(sNonZeros);
+
+#pragma omp parallel for schedule(static) if (sEntries >= SparseMatrixParallelApplyThreshold)
+		for (IndexT i = 0; i < m_nRows; i++) {
+			const size_t ixBegin = vecRowBegin[i];
+			for (size_t j = m_dataCSRRowPtr[i]; j < m_dataCSRRowPtr[i+1]; j++) {
+				const std::pair<IndexT, DataType> & entry =
+					vecRowEntries[ixBegin + (j - m_dataCSRRowPtr[i])];
+				m_dataCSRCols[j] = entry.first;
+				m_dataCSRValues[j] = entry.second;
+			}
 		}
+
+		m_fFinalized = true;
 	}
 
-protected:
 	///	<summary>
-	///		Number of rows in the sparse matrix.
+	///		Add each Triplet to the entry at its row and column.  Values for
+	///		the same entry are accumulated in the order they appear in
+	///		vecTriplets, so the result is identical to applying operator()
+	///		to each Triplet in turn.  Triplets are grouped by row and sorted
+	///		over OpenMP threads, so each entry is only inserted once.
 	///	</summary>
-	int m_nRows;
+	void AddTriplets(
+		const TripletVector & vecTriplets
+	) {
+		std::vector<TripletRange> vecRanges(1);
+		vecRanges[0].first = (vecTriplets.size() == 0)?(NULL):(&(vecTriplets[0]));
+		vecRanges[0].second = vecTriplets.size();
+
+		AddTripletRanges(vecRanges);
+	}
 
 	///	<summary>
-	///		Number of columns in the sparse matrix.
+	///		Add the Triplets of each block, in order of the blocks, and
+	///		release the blocks.  Values for the same entry are accumulated in
+	///		order of the blocks and then of their position within each block,
+	///		so when blocks hold the weights of fixed ranges of source faces
+	///		computed by separate threads, the entries of the map are summed
+	///		in order of the source faces and are bitwise identical for any
+	///		number of threads.
 	///	</summary>
-	int m_nCols;
+	void AddBlockTriplets(
+		std::vector<TripletVector> & vecBlockTriplets
+	) {
+		std::vector<TripletRange> vecRanges;
+		vecRanges.reserve(vecBlockTriplets.size());
+		for (size_t b = 0; b < vecBlockTriplets.size(); b++) {
+			if (vecBlockTriplets[b].size() != 0) {
+				vecRanges.push_back(
+					TripletRange(
+						&(vecBlockTriplets[b][0]),
+						vecBlockTriplets[b].size()));
+			}
+		}
+
+		AddTripletRanges(vecRanges);
+
+		for (size_t b = 0; b < vecBlockTriplets.size(); b++) {
+			TripletVector().swap(vecBlockTriplets[b]);
+		}
+	}
+
+protected:
+	///	<summary>
+	///		A contiguous array of Triplets and its length.
+	///	</summary>
+	typedef std::pair<const Triplet *, size_t> TripletRange;
 
 	///	<summary>
-	///		Entries of the sparse matrix.
+	///		Add the Triplets of each range, in order of the ranges.  Triplets
+	///		are distributed over groups of contiguous rows and stably sorted
+	///		by row and column within each group, so the order in which values
+	///		are summed into each entry is the order of the input and does not
+	///		depend on the number of groups.
 	///	</summary>
-	SparseMap m_mapEntries;
+	void AddTripletRanges(
+		const std::vector<TripletRange> & vecRanges
+	) {
+		if (m_fFinalized) {
+			_EXCEPTIONT("Attempting to modify a finalized SparseMatrix");
+		}
+
+		size_t sTriplets = 0;
+		for (size_t r = 0; r < vecRanges.size(); r++) {
+			const Triplet * pTriplets = vecRanges[r].first;
+			for (size_t i = 0; i < vecRanges[r].second; i++) {
+				if (pTriplets[i].iRow >= m_nRows) {
+					m_nRows = pTriplets[i].iRow + 1;
+				}
+				if (pTriplets[i].iCol >= m_nCols) {
+					m_nCols = pTriplets[i].iCol + 1;
+				}
+			}
+			sTriplets += vecRanges[r].second;
+		}
+
+		if (sTriplets == 0) {
+			return;
+		}
+
+		// Distribute Triplets over groups of contiguous rows, preserving
+		// their order within each group
+		int nGroups = 1;
+#if defined(_OPENMP)
+		nGroups = omp_get_max_threads();
+#endif
+		const int64_t nGroups64 = nGroups;
+		const int64_t nRows = m_nRows;
+
+		std::vector<size_t> vecGroupBegin(nGroups+1, 0);
+		for (size_t r = 0; r < vecRanges.size(); r++) {
+			const Triplet * pTriplets = vecRanges[r].first;
+			for (size_t i = 0; i < vecRanges[r].second; i++) {
+				vecGroupBegin[(pTriplets[i].iRow * nGroups64) / nRows + 1]++;
+			}
+		}
+		for (int g = 0; g < nGroups; g++) {
+			vecGroupBegin[g+1] += vecGroupBegin[g];
+		}
+
+		TripletVector vecSorted(sTriplets);
+		{
+			std::vector<size_t> vecGroupNext(
+				vecGroupBegin.begin(), vecGroupBegin.end() - 1);
+
+			for (size_t r = 0; r < vecRanges.size(); r++) {
+				const Triplet * pTriplets = vecRanges[r].first;
+				for (size_t i = 0; i < vecRanges[r].second; i++) {
+					const int g =
+						static_cast<int>((pTriplets[i].iRow * nGroups64) / nRows);
+					vecSorted[vecGroupNext[g]++] = pTriplets[i];
+				}
+			}
+		}
+
+		// Sort each group by row and column; the sort is stable so values
+		// for the same entry remain in their original order
+#pragma omp parallel for schedule(dynamic, 1)
+		for (int g = 0; g < nGroups; g++) {
+			std::stable_sort(
+				vecSorted.begin() + vecGroupBegin[g],
+				vecSorted.begin() + vecGroupBegin[g+1]);
+		}
+
+		// Spill the sorted Triplets to a new run
+		if ((m_strSpillDir != "") && (m_sSpillThresholdBytes == 0)) {
+			SpillMapEntries();
+			WriteSpillRun(&(vecSorted[0]), sTriplets);
+			return;
+		}
+
+		// Accumulate values into each entry in order, appending new entries
+		SparseMapIterator iter = m_mapEntries.end();
+		for (size_t i = 0; i < sTriplets; i++) {
+			const Triplet & t = vecSorted[i];
+
+			if ((i == 0) ||
+			    (t.iRow != vecSorted[i-1].iRow) ||
+			    (t.iCol != vecSorted[i-1].iCol)
+			) {
+				iter = m_mapEntries.insert(
+					m_mapEntries.end(),
+					SparseMapPair(
+						IndexType(t.iRow, t.iCol), (DataType)(0)));
+			}
+			iter->second += t.dValue;
+		}
+
+		// Spill the map of entries once it exceeds the threshold, and all
+		// further Triplets as they are added, so that values are still
+		// summed in order when the runs are merged
+		if ((m_strSpillDir != "") &&
+		    (m_mapEntries.size() * SparseMapEntryBytes > m_sSpillThresholdBytes)
+		) {
+			SpillMapEntries();
+			m_sSpillThresholdBytes = 0;
+		}
+	}
+
+public:
+	///	<summary>
+	///		Spill the Triplets added to this SparseMatrix to sorted runs in
+	///		temporary files in strDir, rather than inserting them into the
+	///		map of entries.  The runs are merged when the SparseMatrix is
+	///		finalized, building the CSR arrays directly, so that the map of
+	///		entries is never held in memory.  Values for the same entry are
+	///		accumulated in the same order as without spilling, so the result
+	///		is identical.  Modifying an entry with operator() merges the runs
+	///		into the map of entries.  An empty strDir disables spilling.
+	///		If sThresholdBytes is nonzero, Triplets are inserted into the
+	///		map of entries as usual until its estimated size exceeds
+	///		sThresholdBytes, and are spilled from then on.
+	///	</summary>
+	void SetSpillDirectory(
+		const std::string & strDir,
+		size_t sThresholdBytes = 0
+	) {
+		if (m_fFinalized) {
+			_EXCEPTIONT("Attempting to modify a finalized SparseMatrix");
+		}
+		m_strSpillDir = strDir;
+		m_sSpillThresholdBytes = sThresholdBytes;
+		if ((m_strSpillDir != "") &&
+		    (m_mapEntries.size() * SparseMapEntryBytes > m_sSpillThresholdBytes)
+		) {
+			SpillMapEntries();
+			m_sSpillThresholdBytes = 0;
+		} else if (m_strSpillDir == "") {
+			MergeSpillRuns();
+		}
+	}
+
+	///	<summary>
+	///		Check if this SparseMatrix has entries spilled to disk that have
+	///		not yet been merged.
+	///	</summary>
+	bool HasSpilledEntries() const {
+		return (m_vecSpillRuns.size() != 0);
+	}
+
+protected:
+	///	<summary>
+	///		Throw an Exception if this SparseMatrix has unmerged entries.
+	///	</summary>
+	void CheckNotSpilled() const {
+		if (m_vecSpillRuns.size() != 0) {
+			_EXCEPTIONT("SparseMatrix has entries spilled to disk; "
+				"call Finalize() first");
+		}
+	}
+
+	///	<summary>
+	///		Write a sorted array of Triplets to a new run.
+	///	</summary>
+	void WriteSpillRun(
+		const Triplet * pTriplets,
+		size_t sTriplets
+	) {
+		if (sTriplets == 0) {
+			return;
+		}
+		m_vecSpillRuns.push_back(
+			std::shared_ptr<SparseMatrixSpillRun>(
+				new SparseMatrixSpillRun(
+					m_strSpillDir, pTriplets, sTriplets, sizeof(Triplet))));
+	}
+
+	///	<summary>
+	///		Move the map of entries to a new run.
+	///	</summary>
+	void SpillMapEntries() {
+		if (m_mapEntries.size() == 0) {
+			return;
+		}
+
+		TripletVector vecTriplets;
+		vecTriplets.reserve(m_mapEntries.size());
+
+		SparseMapConstIterator iter = m_mapEntries.begin();
+		for (; iter != m_mapEntries.end(); iter++) {
+			vecTriplets.push_back(
+				Triplet(iter->first.first, iter->first.second, iter->second));
+		}
+		m_mapEntries.clear();
+
+		WriteSpillRun(&(vecTriplets[0]), vecTriplets.size());
+	}
+
+	///	<summary>
+	///		A buffered sequential reader of a run.
+	///	</summary>
+	class SpillRunReader {
+
+	public:
+		///	<summary>
+		///		Constructor.
+		///	</summary>
+		SpillRunReader(
+			const SparseMatrixSpillRun & run
+		) :
+			m_fp(NULL),
+			m_sRemaining(run.GetTripletCount()),
+			m_sBuffered(0),
+			m_sNext(0)
+		{
+			m_fp = fopen(run.GetFile().c_str(), "rb");
+			if (m_fp == NULL) {
+				_EXCEPTION1("Unable to open spill file \"%s\"",
+					run.GetFile().c_str());
+			}
+			m_vecBuffer.resize(
+				std::min(m_sRemaining,
+					GetIOBufferItems(
+						SparseMatrixSpillReadBufferSize, sizeof(Triplet))));
+		}
+
+		///	<summary>
+		///		Destructor.
+		///	</summary>
+		~SpillRunReader() {
+			if (m_fp != NULL) {
+				fclose(m_fp);
+			}
+		}
+
+		///	<summary>
+		///		Get the next Triplet, returning false at the end of the run.
+		///	</summary>
+		bool Next(Triplet & t) {
+			if (m_sNext == m_sBuffered) {
+				if (m_sRemaining == 0) {
+					return false;
+				}
+				m_sBuffered = std::min(m_sRemaining, m_vecBuffer.size());
+				if (fread(&(m_vecBuffer[0]), sizeof(Triplet), m_sBuffered, m_fp)
+					!= m_sBuffered
+				) {
+					_EXCEPTIONT("Unable to read spill file");
+				}
+				m_sRemaining -= m_sBuffered;
+				m_sNext = 0;
+			}
+			t = m_vecBuffer[m_sNext++];
+			return true;
+		}
+
+	private:
+		SpillRunReader(const SpillRunReader &);
+		SpillRunReader & operator=(const SpillRunReader &);
+
+	private:
+		FILE * m_fp;
+		size_t m_sRemaining;
+		size_t m_sBuffered;
+		size_t m_sNext;
+		TripletVector m_vecBuffer;
+	};
+
+	///	<summary>
+	///		The head of a run in the k-way merge, ordered so that the
+	///		smallest (row, column) and then the earliest run is on top.
+	///	</summary>
+	struct SpillMergeHead {
+		Triplet t;
+		size_t ixRun;
+
+		bool operator<(const SpillMergeHead & h) const {
+			if (t.iRow != h.t.iRow) {
+				return (t.iRow > h.t.iRow);
+			}
+			if (t.iCol != h.t.iCol) {
+				return (t.iCol > h.t.iCol);
+			}
+			return (ixRun > h.ixRun);
+		}
+	};
+
+	///	<summary>
+	///		Merge all runs in order of (row, column), calling
+	///		fnEntry(iRow, iCol, dValue) once for each entry.  Values for the
+	///		same entry are summed in order of the runs and of their position
+	///		within each run.
+	///	</summary>
+	template <typename EntryFunction>
+	void ForEachSpilledEntry(
+		EntryFunction fnEntry
+	) const {
+		const size_t nRuns = m_vecSpillRuns.size();
+
+		std::vector< std::unique_ptr<SpillRunReader> > vecReaders(nRuns);
+		std::priority_queue<SpillMergeHead> queueHeads;
+
+		for (size_t r = 0; r < nRuns; r++) {
+			vecReaders[r].reset(new SpillRunReader(*(m_vecSpillRuns[r])));
+
+			SpillMergeHead head;
+			head.ixRun = r;
+			if (vecReaders[r]->Next(head.t)) {
+				queueHeads.push(head);
+			}
+		}
+
+		while (!queueHeads.empty()) {
+			const IndexT iRow = queueHeads.top().t.iRow;
+			const IndexT iCol = queueHeads.top().t.iCol;
+
+			DataType dValue = static_cast<DataType>(0);
+			while ((!queueHeads.empty()) &&
+			       (queueHeads.top().t.iRow == iRow) &&
+			       (queueHeads.top().t.iCol == iCol)
+			) {
+				SpillMergeHead head = queueHeads.top();
+				queueHeads.pop();
+
+				dValue += head.t.dValue;
+
+				if (vecReaders[head.ixRun]->Next(head.t)) {
+					queueHeads.push(head);
+				}
+			}
+
+			fnEntry(iRow, iCol, dValue);
+		}
+	}
+
+	///	<summary>
+	///		Merge all runs into the map of entries, which must be empty.
+	///	</summary>
+	void MergeSpillRuns() {
+		if (m_vecSpillRuns.size() == 0) {
+			return;
+		}
+
+		SparseMap & mapEntries = m_mapEntries;
+		ForEachSpilledEntry(
+			[&mapEntries](IndexT iRow, IndexT iCol, DataType dValue) {
+				mapEntries.insert(
+					mapEntries.end(),
+					SparseMapPair(IndexType(iRow, iCol), dValue));
+			});
+
+		m_vecSpillRuns.clear();
+	}
+
+	///	<summary>
+	///		Merge all runs into the CSR arrays of a finalized SparseMatrix.
+	///		The runs are read twice, first to count the entries of each row.
+	///	</summary>
+	void FinalizeSpillRuns() {
+		m_dataCSRRowPtr.Allocate(static_cast<size_t>(m_nRows) + 1);
+
+		DataArray1D<size_t> & dataRowPtr = m_dataCSRRowPtr;
+		ForEachSpilledEntry(
+			[&dataRowPtr](IndexT iRow, IndexT, DataType) {
+				dataRowPtr[iRow+1]++;
+			});
+
+		for (IndexT i = 0; i < m_nRows; i++) {
+			m_dataCSRRowPtr[i+1] += m_dataCSRRowPtr[i];
+		}
+
+		const size_t sNonZeros = m_dataCSRRowPtr[m_nRows];
+		m_dataCSRCols.Allocate(sNonZeros);
+		m_dataCSRValues.Allocate(sNonZeros);
+
+		size_t ix = 0;
+		DataArray1D<IndexT> & dataCols = m_dataCSRCols;
+		DataArray1D<DataType> & dataValues = m_dataCSRValues;
+		ForEachSpilledEntry(
+			[&ix, &dataCols, &dataValues](IndexT, IndexT iCol, DataType dValue) {
+				dataCols[ix] = iCol;
+				dataValues[ix] = dValue;
+				ix++;
+			});
+
+		m_vecSpillRuns.clear();
+	}
+
+public:
+	///	<summary>
+	///		Get an ordering of the rows and columns of a finalized
+	///		SparseMatrix that reduces the spread of the columns referenced
+	///		by neighboring rows, by a breadth-first (Cuthill-McKee) search
+	///		of the bipartite graph of rows and columns.  Each row is placed
+	///		after the rows sharing a column with it that were reached
+	///		before it, and each column when it is first referenced, so rows
+	///		close in the ordering read columns close in the ordering.  Each
+	///		connected component is searched from its lowest numbered row;
+	///		columns not referenced by any row are placed last.  On return
+	///		vecRowOrder[i] is the original index of the i-th row and
+	///		vecColOrder[j] the original index of the j-th column.
+	///	</summary>
+	void GetLocalityOrder(
+		std::vector<IndexT> & vecRowOrder,
+		std::vector<IndexT> & vecColOrder
+	) const {
+		if (!m_fFinalized) {
+			_EXCEPTIONT("SparseMatrix has not been finalized");
+		}
+
+		const size_t sNonZeros = m_dataCSRValues.GetRows();
+
+		// Rows referencing each column
+		std::vector<size_t> vecColPtr(static_cast<size_t>(m_nCols) + 1, 0);
+		for (size_t j = 0; j < sNonZeros; j++) {
+			vecColPtr[m_dataCSRCols[j]+1]++;
+		}
+		for (IndexT c = 0; c < m_nCols; c++) {
+			vecColPtr[c+1] += vecColPtr[c];
+		}
+
+		std::vector<IndexT> vecColRows(sNonZeros);
+		{
+			std::vector<size_t> vecColNext(
+				vecColPtr.begin(), vecColPtr.end() - 1);
+			for (IndexT i = 0; i < m_nRows; i++) {
+				for (size_t j = m_dataCSRRowPtr[i]; j < m_dataCSRRowPtr[i+1]; j++) {
+					vecColRows[vecColNext[m_dataCSRCols[j]]++] = i;
+				}
+			}
+		}
+
+		// Breadth-first search; vecRowOrder also serves as the queue
+		std::vector<char> vecRowVisited(m_nRows, 0);
+		std::vector<char> vecColVisited(m_nCols, 0);
+
+		vecRowOrder.clear();
+		vecRowOrder.reserve(m_nRows);
+		vecColOrder.clear();
+		vecColOrder.reserve(m_nCols);
+
+		size_t sQueueHead = 0;
+		for (IndexT iStart = 0; iStart < m_nRows; iStart++) {
+			if (vecRowVisited[iStart]) {
+				continue;
+			}
+			vecRowVisited[iStart] = 1;
+			vecRowOrder.push_back(iStart);
+
+			for (; sQueueHead < vecRowOrder.size(); sQueueHead++) {
+				const IndexT i = vecRowOrder[sQueueHead];
+				for (size_t j = m_dataCSRRowPtr[i]; j < m_dataCSRRowPtr[i+1]; j++) {
+					const IndexT c = m_dataCSRCols[j];
+					if (vecColVisited[c]) {
+						continue;
+					}
+					vecColVisited[c] = 1;
+					vecColOrder.push_back(c);
+
+					for (size_t k = vecColPtr[c]; k < vecColPtr[c+1]; k++) {
+						const IndexT i2 = vecColRows[k];
+						if (!vecRowVisited[i2]) {
+							vecRowVisited[i2] = 1;
+							vecRowOrder.push_back(i2);
+						}
+					}
+				}
+			}
+		}
+
+		for (IndexT c = 0; c < m_nCols; c++) {
+			if (!vecColVisited[c]) {
+				vecColOrder.push_back(c);
+			}
+		}
+	}
+
+	///	<summary>
+	///		Store the transpose of a finalized SparseMatrix in matT, which
+	///		is finalized.  Rows are distributed over OpenMP threads, and the
+	///		entries of each row of the transpose are ordered by column.
+	///	</summary>
+	void Transpose(
+		SparseMatrix<DataType, IndexT> & matT
+	) const {
+		if (!m_fFinalized) {
+			_EXCEPTIONT("SparseMatrix has not been finalized");
+		}
+		if (&matT == this) {
+			_EXCEPTIONT("Transpose() requires a distinct output SparseMatrix");
+		}
+
+		const size_t sNonZeros = m_dataCSRValues.GetRows();
+
+		int nThreads = 1;
+#if defined(_OPENMP)
+		if (sNonZeros >= SparseMatrixParallelApplyThreshold) {
+			nThreads = omp_get_max_threads();
+		}
+#endif
+
+		matT.m_mapEntries.clear();
+		matT.ReleaseCSR();
+		matT.m_nRows = m_nCols;
+		matT.m_nCols = m_nRows;
+		matT.m_dataCSRRowPtr.Allocate(m_nCols+1);
+		matT.m_dataCSRCols.Allocate(sNonZeros);
+		matT.m_dataCSRValues.Allocate(sNonZeros);
+
+		// Count the entries of each column of each thread's rows, then
+		// convert the counts into the offset at which each thread writes
+		// its entries of that column so that rows remain in order
+		std::vector<size_t> vecOffsets(
+			static_cast<size_t>(nThreads) * static_cast<size_t>(m_nCols), 0);
+
+#pragma omp parallel num_threads(nThreads)
+		{
+#if defined(_OPENMP)
+			const int nTeamThreads = omp_get_num_threads();
+			const int iThread = omp_get_thread_num();
+#else
+			const int nTeamThreads = 1;
+			const int iThread = 0;
+#endif
+			IndexT iRowBegin;
+			IndexT iRowEnd;
+			GetThreadRowRange(iThread, nTeamThreads, iRowBegin, iRowEnd);
+
+			size_t * pOffsets =
+				vecOffsets.data() + static_cast<size_t>(iThread) * m_nCols;
+
+			for (size_t j = m_dataCSRRowPtr[iRowBegin]; j < m_dataCSRRowPtr[iRowEnd]; j++) {
+				pOffsets[m_dataCSRCols[j]]++;
+			}
+
+#pragma omp barrier
+#pragma omp single
+			{
+				size_t sOffset = 0;
+				for (IndexT c = 0; c < m_nCols; c++) {
+					matT.m_dataCSRRowPtr[c] = sOffset;
+					for (int t = 0; t < nTeamThreads; t++) {
+						size_t & sCount =
+							vecOffsets[static_cast<size_t>(t) * m_nCols + c];
+						const size_t sThreadCount = sCount;
+						sCount = sOffset;
+						sOffset += sThreadCount;
+					}
+				}
+				matT.m_dataCSRRowPtr[m_nCols] = sOffset;
+			}
+
+			for (IndexT i = iRowBegin; i < iRowEnd; i++) {
+				for (size_t j = m_dataCSRRowPtr[i]; j < m_dataCSRRowPtr[i+1]; j++) {
+					const size_t ix = pOffsets[m_dataCSRCols[j]]++;
+					matT.m_dataCSRCols[ix] = i;
+					matT.m_dataCSRValues[ix] = m_dataCSRValues[j];
+				}
+			}
+		}
+
+		matT.m_fFinalized = true;
+	}
+
+	///	<summary>
+	///		Store the product of this finalized SparseMatrix and the finalized
+	///		SparseMatrix matB in matC, which is finalized.  Rows of the
+	///		product are computed in parallel over OpenMP threads, and the
+	///		entries of each row are summed in the order of the entries of
+	///		this SparseMatrix, so the result does not depend on the number
+	///		of threads.  Columns of this SparseMatrix beyond the last row
+	///		of matB correspond to empty rows of matB.
+	///	</summary>
+	void Multiply(
+		const SparseMatrix<DataType, IndexT> & matB,
+		SparseMatrix<DataType, IndexT> & matC
+	) const {
+		if (!m_fFinalized || !matB.m_fFinalized) {
+			_EXCEPTIONT("SparseMatrix has not been finalized");
+		}
+		if ((&matC == this) || (&matC == &matB)) {
+			_EXCEPTIONT("Multiply() requires a distinct output SparseMatrix");
+		}
+		const IndexT nColsC = matB.m_nCols;
+
+		matC.m_mapEntries.clear();
+		matC.ReleaseCSR();
+		matC.m_nRows = m_nRows;
+		matC.m_nCols = nColsC;
+		matC.m_dataCSRRowPtr.Allocate(m_nRows+1);
+
+		// Determine the number of nonzeros in each row of the product
+#pragma omp parallel
+		{
+			std::vector<IndexT> vecLastRow(nColsC, -1);
+
+#pragma omp for schedule(dynamic, 256)
+			for (IndexT i = 0; i < m_nRows; i++) {
+				size_t sRowNonZeros = 0;
+				for (size_t j = m_dataCSRRowPtr[i]; j < m_dataCSRRowPtr[i+1]; j++) {
+					const IndexT k = m_dataCSRCols[j];
+					if (k >= matB.m_nRows) {
+						continue;
+					}
+					for (size_t l = matB.m_dataCSRRowPtr[k]; l < matB.m_dataCSRRowPtr[k+1]; l++) {
+						const IndexT c = matB.m_dataCSRCols[l];
+						if (vecLastRow[c] != i) {
+							vecLastRow[c] = i;
+							sRowNonZeros++;
+						}
+					}
+				}
+				matC.m_dataCSRRowPtr[i+1] = sRowNonZeros;
+			}
+		}
+
+		for (IndexT i = 0; i < m_nRows; i++) {
+			matC.m_dataCSRRowPtr[i+1] += matC.m_dataCSRRowPtr[i];
+		}
+
+		const size_t sNonZeros = matC.m_dataCSRRowPtr[m_nRows];
+		matC.m_dataCSRCols.Allocate(sNonZeros);
+		matC.m_dataCSRValues.Allocate(sNonZeros);
+
+		// Accumulate the entries of each row of the product
+#pragma omp parallel
+		{
+			std::vector<IndexT> vecLastRow(nColsC, -1);
+			std::vector<DataType> vecSum(nColsC);
+
+#pragma omp for schedule(dynamic, 256)
+			for (IndexT i = 0; i < m_nRows; i++) {
+				const size_t ixBegin = matC.m_dataCSRRowPtr[i];
+				size_t ix = ixBegin;
+				for (size_t j = m_dataCSRRowPtr[i]; j < m_dataCSRRowPtr[i+1]; j++) {
+					const IndexT k = m_dataCSRCols[j];
+					if (k >= matB.m_nRows) {
+						continue;
+					}
+					const DataType dWeight = m_dataCSRValues[j];
+					for (size_t l = matB.m_dataCSRRowPtr[k]; l < matB.m_dataCSRRowPtr[k+1]; l++) {
+						const IndexT c = matB.m_dataCSRCols[l];
+						if (vecLastRow[c] != i) {
+							vecLastRow[c] = i;
+							vecSum[c] = dWeight * matB.m_dataCSRValues[l];
+							matC.m_dataCSRCols[ix++] = c;
+						} else {
+							vecSum[c] += dWeight * matB.m_dataCSRValues[l];
+						}
+					}
+				}
+
+				if (ix > ixBegin) {
+					IndexT * pCols = &(matC.m_dataCSRCols[0]);
+					std::sort(pCols + ixBegin, pCols + ix);
+					for (size_t j = ixBegin; j < ix; j++) {
+						matC.m_dataCSRValues[j] = vecSum[pCols[j]];
+					}
+				}
+			}
+		}
+
+		matC.m_fFinalized = true;
+	}
+
+	///	<summary>
+	///		Multiply each entry (i,j) of a finalized SparseMatrix by
+	///		dRowScale[i] * dColScale[j].  The CSR arrays must not have been
+	///		attached with AttachCSR().
+	///	</summary>
+	void ScaleEntries(
+		const DataArray1D<DataType> & dRowScale,
+		const DataArray1D<DataType> & dColScale
+	) {
+		if (!m_fFinalized) {
+			_EXCEPTIONT("SparseMatrix has not been finalized");
+		}
+		if (m_fAttached) {
+			_EXCEPTIONT("Attempting to modify an attached SparseMatrix");
+		}
+		if ((dRowScale.GetRows() < m_nRows) || (dColScale.GetRows() < m_nCols)) {
+			_EXCEPTIONT("Scale vectors smaller than SparseMatrix");
+		}
+
+#pragma omp parallel for schedule(static) if (m_dataCSRValues.GetRows() >= SparseMatrixParallelApplyThreshold)
+		for (IndexT i = 0; i < m_nRows; i++) {
+			for (size_t j = m_dataCSRRowPtr[i]; j < m_dataCSRRowPtr[i+1]; j++) {
+				m_dataCSRValues[j] *= dRowScale[i] * dColScale[m_dataCSRCols[j]];
+			}
+		}
+	}
+
+public:
+	///	<summary>
+	///		Apply the sparse matrix to a DataArray1D.  The vectors may be of
+	///		a different type than the matrix (such as float data with a double
+	///		matrix), in which case products are accumulated in DataType.
+	///	</summary>
+	template <typename VectorType>
+	void Apply(
+		const DataArray1D<VectorType> & dataVectorIn,
+		DataArray1D<VectorType> & dataVectorOut
+	) const {
+/*
+		if (dataVectorIn.GetRows() != m_nCols) {
+			_EXCEPTION1("dataVectorIn has incorrect row count (%i)", m_nCols);
+		}
+		if (dataVectorOut.GetRows() != m_nRows) {
+			_EXCEPTION1("dataVectorOut has incorrect row count (%i)", m_nRows);
+		}
+*/
+		if (m_fFinalized) {
+
+			// Rows are partitioned among threads so that each thread
+			// receives roughly the same number of nonzeros
+#pragma omp parallel \
+	if (m_dataCSRValues.GetRows() >= SparseMatrixParallelApplyThreshold)
+			{
+#if defined(_OPENMP)
+				const int nThreads = omp_get_num_threads();
+				const int iThread = omp_get_thread_num();
+#else
+				const int nThreads = 1;
+				const int iThread = 0;
+#endif
+				IndexT iRowBegin;
+				IndexT iRowEnd;
+				GetThreadRowRange(iThread, nThreads, iRowBegin, iRowEnd);
+
+				for (IndexT i = iRowBegin; i < iRowEnd; i++) {
+					DataType dSum = static_cast<DataType>(0);
+					for (size_t j = m_dataCSRRowPtr[i]; j < m_dataCSRRowPtr[i+1]; j++) {
+						dSum += m_dataCSRValues[j] * dataVectorIn[m_dataCSRCols[j]];
+					}
+					dataVectorOut[i] = static_cast<VectorType>(dSum);
+				}
+			}
+			for (size_t i = m_nRows; i < dataVectorOut.GetRows(); i++) {
+				dataVectorOut[i] = static_cast<VectorType>(0);
+			}
+			return;
+		}
+
+		CheckNotSpilled();
+
+		dataVectorOut.Zero();
+
+		// Entries of the map are ordered by row
+		SparseMapConstIterator iter = m_mapEntries.begin();
+		while (iter != m_mapEntries.end()) {
+			const IndexT iRow = iter->first.first;
+			DataType dSum = static_cast<DataType>(0);
+			for (; iter != m_mapEntries.end(); iter++) {
+				if (iter->first.first != iRow) {
+					break;
+				}
+				dSum += iter->second * dataVectorIn[iter->first.second];
+			}
+			dataVectorOut[iRow] = static_cast<VectorType>(dSum);
+		}
+	}
+
+	///	<summary>
+	///		Apply the sparse matrix to a block of sVectors vectors.  The
+	///		input block is stored with one row per matrix column and one
+	///		column per vector (and similarly for the output block), so that
+	///		each matrix entry is read once for the whole block.  Products
+	///		are accumulated in DataType.
+	///	</summary>
+	template <typename VectorType>
+	void Apply(
+		const DataArray2D<VectorType> & dataBlockIn,
+		DataArray2D<VectorType> & dataBlockOut,
+		size_t sVectors
+	) const {
+		if ((dataBlockIn.GetColumns() < sVectors) ||
+		    (dataBlockOut.GetColumns() < sVectors)
+		) {
+			_EXCEPTIONT("Block size exceeds DataArray2D column count");
+		}
+
+		if (m_fFinalized) {
+
+#pragma omp parallel \
+	if (m_dataCSRValues.GetRows() >= SparseMatrixParallelApplyThreshold)
+			{
+#if defined(_OPENMP)
+				const int nThreads = omp_get_num_threads();
+				const int iThread = omp_get_thread_num();
+#else
+				const int nThreads = 1;
+				const int iThread = 0;
+#endif
+				IndexT iRowBegin;
+				IndexT iRowEnd;
+				GetThreadRowRange(iThread, nThreads, iRowBegin, iRowEnd);
+
+				// Vectors are accumulated in chunks on the stack so that
+				// repeated calls do not allocate
+				const size_t ChunkSize = 32;
+				DataType dSum[ChunkSize];
+
+				for (IndexT i = iRowBegin; i < iRowEnd; i++) {
+					VectorType * pOut = dataBlockOut(i);
+					for (size_t k0 = 0; k0 < sVectors; k0 += ChunkSize) {
+						const size_t sChunk =
+							std::min(ChunkSize, sVectors - k0);
+						for (size_t k = 0; k < sChunk; k++) {
+							dSum[k] = static_cast<DataType>(0);
+						}
+						for (size_t j = m_dataCSRRowPtr[i]; j < m_dataCSRRowPtr[i+1]; j++) {
+							const DataType dWeight = m_dataCSRValues[j];
+							const VectorType * pIn =
+								dataBlockIn(m_dataCSRCols[j]) + k0;
+							for (size_t k = 0; k < sChunk; k++) {
+								dSum[k] += dWeight * pIn[k];
+							}
+						}
+						for (size_t k = 0; k < sChunk; k++) {
+							pOut[k0+k] = static_cast<VectorType>(dSum[k]);
+						}
+					}
+				}
+			}
+			for (size_t i = m_nRows; i < dataBlockOut.GetRows(); i++) {
+				VectorType * pOut = dataBlockOut(i);
+				for (size_t k = 0; k < sVectors; k++) {
+					pOut[k] = static_cast<VectorType>(0);
+				}
+			}
+			return;
+		}
+
+		CheckNotSpilled();
+
+		dataBlockOut.Zero();
+
+		DataArray1D<DataType> dSum(sVectors);
+
+		// Entries of the map are ordered by row
+		SparseMapConstIterator iter = m_mapEntries.begin();
+		while (iter != m_mapEntries.end()) {
+			const IndexT iRow = iter->first.first;
+			for (size_t k = 0; k < sVectors; k++) {
+				dSum[k] = static_cast<DataType>(0);
+			}
+			for (; iter != m_mapEntries.end(); iter++) {
+				if (iter->first.first != iRow) {
+					break;
+				}
+				const VectorType * pIn = dataBlockIn(iter->first.second);
+				for (size_t k = 0; k < sVectors; k++) {
+					dSum[k] += iter->second * pIn[k];
+				}
+			}
+			VectorType * pOut = dataBlockOut(iRow);
+			for (size_t k = 0; k < sVectors; k++) {
+				pOut[k] = static_cast<VectorType>(dSum[k]);
+			}
+		}
+	}
+
+private:
+	///	<summary>
+	///		Comparators of (column, value) pairs by column.
+	///	</summary>
+	static bool CompareFirst(
+		const std::pair<IndexT, DataType> & a,
+		const std::pair<IndexT, DataType> & b
+	) {
+		return (a.first < b.first);
+	}
+
+	static bool EqualFirst(
+		const std::pair<IndexT, DataType> & a,
+		const std::pair<IndexT, DataType> & b
+	) {
+		return (a.first == b.first);
+	}
+
+protected:
+	///	<summary>
+	///		Release the CSR arrays, whether owned or attached, and mark the
+	///		SparseMatrix as not finalized.
+	///	</summary>
+	void ReleaseCSR() {
+		m_dataCSRRowPtr.Detach();
+		m_dataCSRRowPtr.SetSize(0);
+		m_dataCSRCols.Detach();
+		m_dataCSRCols.SetSize(0);
+		m_dataCSRValues.Detach();
+		m_dataCSRValues.SetSize(0);
+
+		m_fFinalized = false;
+		m_fAttached = false;
+	}
+
+	///	<summary>
+	///		Get the range of rows of a finalized SparseMatrix assigned to a
+	///		given thread, chosen so that each thread receives roughly the
+	///		same number of nonzeros.
+	///	</summary>
+	void GetThreadRowRange(
+		int iThread,
+		int nThreads,
+		IndexT & iRowBegin,
+		IndexT & iRowEnd
+	) const {
+		const size_t sNonZeros = m_dataCSRValues.GetRows();
+		const size_t * pRowPtrBegin = &(m_dataCSRRowPtr[0]);
+		const size_t * pRowPtrEnd = pRowPtrBegin + m_nRows;
+
+		iRowBegin = static_cast<IndexT>(
+			std::lower_bound(pRowPtrBegin, pRowPtrEnd,
+				sNonZeros * iThread / nThreads) - pRowPtrBegin);
+
+		iRowEnd = m_nRows;
+		if (iThread != nThreads-1) {
+			iRowEnd = static_cast<IndexT>(
+				std::lower_bound(pRowPtrBegin, pRowPtrEnd,
+					sNonZeros * (iThread+1) / nThreads) - pRowPtrBegin);
+		}
+	}
+
+protected:
+	///	<summary>
+	///		Number of rows in the sparse matrix.
+	///	</summary>
+	IndexT m_nRows;
+
+	///	<summary>
+	///		Number of columns in the sparse matrix.
+	///	</summary>
+	IndexT m_nCols;
+
+	///	<summary>
+	///		Entries of the sparse matrix.
+	///	</summary>
+	SparseMap m_mapEntries;
+
+	///	<summary>
+	///		Directory for spilled Triplets, or empty if not spilling.
+	///	</summary>
+	std::string m_strSpillDir;
+
+	///	<summary>
+	///		Sorted runs of Triplets spilled to disk, in order of insertion.
+	///	</summary>
+	std::vector< std::shared_ptr<SparseMatrixSpillRun> > m_vecSpillRuns;
+
+	///	<summary>
+	///		Estimated size of the map of entries above which it is spilled,
+	///		or zero to spill all Triplets as they are added.  Reset to zero
+	///		once the map has been spilled.
+	///	</summary>
+	size_t m_sSpillThresholdBytes;
+
+	///	<summary>
+	///		Flag indicating the entries are stored in CSR format.
+	///	</summary>
+	bool m_fFinalized;
+
+	///	<summary>
+	///		Flag indicating the CSR arrays were attached with AttachCSR().
+	///	</summary>
+	bool m_fAttached;
+
+	///	<summary>
+	///		CSR row pointers (size m_nRows+1), valid if m_fFinalized.
+	///	</summary>
+	DataArray1D<size_t> m_dataCSRRowPtr;
+
+	///	<summary>
+	///		CSR column indices, valid if m_fFinalized.
+	///	</summary>
+	DataArray1D<IndexT> m_dataCSRCols;
+
+	///	<summary>
+	///		CSR values, valid if m_fFinalized.
+	///	</summary>
+	DataArray1D<DataType> m_dataCSRValues;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
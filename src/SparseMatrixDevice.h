@@ -0,0 +1,402 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    SparseMatrixDevice.h
+///	\author  Paul Ullrich
+///	\version October 14, 2026
+///
+///	<remarks>
+///		Copyright 2026 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#ifndef _SPARSEMATRIXDEVICE_H_
+#define _SPARSEMATRIXDEVICE_H_
+
+#include "SparseMatrix.h"
+#include "DataArray2D.h"
+#include "Exception.h"
+
+#include <vector>
+
+#if defined(TEMPEST_OMP_OFFLOAD)
+#if !defined(_OPENMP)
+#error "TEMPEST_OMP_OFFLOAD requires OpenMP"
+#endif
+#include <omp.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A finalized SparseMatrix whose CSR arrays are kept resident on an
+///		accelerator for repeated application to blocks of vectors.  When
+///		built with TEMPEST_OMP_OFFLOAD the arrays are copied to the default
+///		OpenMP target device on construction and released on destruction;
+///		each Apply() then only transfers the input and output blocks.
+///		Without TEMPEST_OMP_OFFLOAD, or if no target device is available,
+///		Apply() is performed on the host by the SparseMatrix itself.  The
+///		SparseMatrix must not be modified during the lifetime of this
+///		object.  Optionally the rows and columns are renumbered on
+///		construction with SparseMatrix::GetLocalityOrder(), so that the
+///		input values gathered by neighboring rows are close in memory;
+///		each Apply() then permutes its input and output blocks.  The
+///		entries of each row keep their original order, so the result is
+///		identical to applying the original SparseMatrix.
+///	</summary>
+template <typename DataType>
+class SparseMatrixDevice {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	explicit SparseMatrixDevice(
+		const SparseMatrix<DataType> & smat,
+		bool fReorder = false
+	) :
+		m_smat(smat),
+		m_psmatApply(&smat),
+		m_fReordered(false),
+		m_fOnDevice(false),
+		m_iDevice(0),
+		m_pRowPtr(NULL),
+		m_pCols(NULL),
+		m_pValues(NULL),
+		m_sNonZeros(0)
+	{
+		if (!smat.IsFinalized()) {
+			_EXCEPTIONT("SparseMatrix has not been finalized");
+		}
+
+		if (fReorder && (smat.GetRows() != 0)) {
+			Reorder();
+		}
+
+#if defined(TEMPEST_OMP_OFFLOAD)
+		if (omp_get_num_devices() == 0) {
+			return;
+		}
+
+		m_iDevice = omp_get_default_device();
+
+		const SparseMatrix<DataType> & smatApply = *m_psmatApply;
+
+		const int nRows = smatApply.GetRows();
+		m_sNonZeros = smatApply.GetCSRValues().GetRows();
+
+		m_pRowPtr = &(smatApply.GetCSRRowPointers()[0]);
+		if (m_sNonZeros != 0) {
+			m_pCols = &(smatApply.GetCSRColumns()[0]);
+			m_pValues = &(smatApply.GetCSRValues()[0]);
+		}
+
+		const size_t * pRowPtr = m_pRowPtr;
+		const int * pCols = m_pCols;
+		const DataType * pValues = m_pValues;
+		const size_t sNonZeros = m_sNonZeros;
+
+#pragma omp target enter data device(m_iDevice) \
+	map(to: pRowPtr[0:nRows+1], pCols[0:sNonZeros], pValues[0:sNonZeros])
+
+		m_fOnDevice = true;
+#endif
+	}
+
+	///	<summary>
+	///		Destructor.
+	///	</summary>
+	~SparseMatrixDevice() {
+#if defined(TEMPEST_OMP_OFFLOAD)
+		if (!m_fOnDevice) {
+			return;
+		}
+
+		const int nRows = m_psmatApply->GetRows();
+		const size_t * pRowPtr = m_pRowPtr;
+		const int * pCols = m_pCols;
+		const DataType * pValues = m_pValues;
+		const size_t sNonZeros = m_sNonZeros;
+
+#pragma omp target exit data device(m_iDevice) \
+	map(delete: pRowPtr[0:nRows+1], pCols[0:sNonZeros], pValues[0:sNonZeros])
+#endif
+	}
+
+private:
+	///	<summary>
+	///		Copy constructor (disabled).
+	///	</summary>
+	SparseMatrixDevice(const SparseMatrixDevice &);
+
+	///	<summary>
+	///		Assignment operator (disabled).
+	///	</summary>
+	SparseMatrixDevice & operator=(const SparseMatrixDevice &);
+
+	///	<summary>
+	///		Build the renumbered copy of the SparseMatrix.
+	///	</summary>
+	void Reorder() {
+		const int nRows = m_smat.GetRows();
+		const int nCols = m_smat.GetColumns();
+
+		m_smat.GetLocalityOrder(m_vecRowOrder, m_vecColOrder);
+
+		std::vector<int> vecColIndex(nCols);
+		for (int j = 0; j < nCols; j++) {
+			vecColIndex[m_vecColOrder[j]] = j;
+		}
+
+		const DataArray1D<size_t> & dataRowPtr = m_smat.GetCSRRowPointers();
+		const DataArray1D<int> & dataCols = m_smat.GetCSRColumns();
+		const DataArray1D<DataType> & dataValues = m_smat.GetCSRValues();
+
+		DataArray1D<size_t> dataRowPtrR(static_cast<size_t>(nRows) + 1);
+		for (int i = 0; i < nRows; i++) {
+			const int iRow = m_vecRowOrder[i];
+			dataRowPtrR[i+1] =
+				dataRowPtrR[i] + (dataRowPtr[iRow+1] - dataRowPtr[iRow]);
+		}
+
+		const size_t sNonZeros = dataRowPtrR[nRows];
+		DataArray1D<int> dataColsR(sNonZeros);
+		DataArray1D<DataType> dataValuesR(sNonZeros);
+
+#pragma omp parallel for schedule(static) \
+	if (sNonZeros >= SparseMatrixParallelApplyThreshold)
+		for (int i = 0; i < nRows; i++) {
+			const int iRow = m_vecRowOrder[i];
+			size_t jR = dataRowPtrR[i];
+			for (size_t j = dataRowPtr[iRow]; j < dataRowPtr[iRow+1]; j++) {
+				dataColsR[jR] = vecColIndex[dataCols[j]];
+				dataValuesR[jR] = dataValues[j];
+				jR++;
+			}
+		}
+
+		// The columns of each row are left in their original order, which
+		// Apply() does not require to be sorted
+		m_smatReordered.SetCSR(
+			nRows, nCols,
+			std::move(dataRowPtrR),
+			std::move(dataColsR),
+			std::move(dataValuesR));
+
+		m_psmatApply = &m_smatReordered;
+		m_fReordered = true;
+	}
+
+public:
+	///	<summary>
+	///		Check if the SparseMatrix is resident on a target device.
+	///	</summary>
+	bool IsOnDevice() const {
+		return m_fOnDevice;
+	}
+
+	///	<summary>
+	///		Get the target device number.
+	///	</summary>
+	int GetDevice() const {
+		return m_iDevice;
+	}
+
+	///	<summary>
+	///		Check if the rows and columns have been renumbered for locality.
+	///	</summary>
+	bool IsReordered() const {
+		return m_fReordered;
+	}
+
+	///	<summary>
+	///		Apply the sparse matrix to a block of sVectors vectors, with the
+	///		same layout and accumulation as SparseMatrix::Apply().
+	///	</summary>
+	template <typename VectorType>
+	void Apply(
+		const DataArray2D<VectorType> & dataBlockIn,
+		DataArray2D<VectorType> & dataBlockOut,
+		size_t sVectors
+	) const {
+		if (!m_fReordered) {
+			ApplyBlock(dataBlockIn, dataBlockOut, sVectors);
+			return;
+		}
+
+		if ((dataBlockIn.GetColumns() < sVectors) ||
+		    (dataBlockOut.GetColumns() < sVectors)
+		) {
+			_EXCEPTIONT("Block size exceeds DataArray2D column count");
+		}
+		if ((dataBlockIn.GetRows() < m_smat.GetColumns()) ||
+		    (dataBlockOut.GetRows() < m_smat.GetRows())
+		) {
+			_EXCEPTIONT("Block smaller than SparseMatrix");
+		}
+
+		const int nRows = m_smat.GetRows();
+		const int nCols = m_smat.GetColumns();
+
+		// Gather the input block in the renumbered order of the columns
+		DataArray2D<VectorType> dataIn(nCols, sVectors);
+		DataArray2D<VectorType> dataOut(nRows, sVectors);
+
+#pragma omp parallel for schedule(static) \
+	if ((static_cast<size_t>(nRows) + nCols) * sVectors \
+	    >= SparseMatrixParallelApplyThreshold)
+		for (int j = 0; j < nCols; j++) {
+			const VectorType * pIn = dataBlockIn(m_vecColOrder[j]);
+			VectorType * pInR = dataIn(j);
+			for (size_t k = 0; k < sVectors; k++) {
+				pInR[k] = pIn[k];
+			}
+		}
+
+		ApplyBlock(dataIn, dataOut, sVectors);
+
+		// Scatter the output block to the original order of the rows
+#pragma omp parallel for schedule(static) \
+	if ((static_cast<size_t>(nRows) + nCols) * sVectors \
+	    >= SparseMatrixParallelApplyThreshold)
+		for (int i = 0; i < nRows; i++) {
+			const VectorType * pOutR = dataOut(i);
+			VectorType * pOut = dataBlockOut(m_vecRowOrder[i]);
+			for (size_t k = 0; k < sVectors; k++) {
+				pOut[k] = pOutR[k];
+			}
+		}
+
+		for (size_t i = nRows; i < dataBlockOut.GetRows(); i++) {
+			VectorType * pOut = dataBlockOut(i);
+			for (size_t k = 0; k < sVectors; k++) {
+				pOut[k] = static_cast<VectorType>(0);
+			}
+		}
+	}
+
+private:
+	///	<summary>
+	///		Apply the (possibly renumbered) sparse matrix to a block of
+	///		sVectors vectors in its own ordering.
+	///	</summary>
+	template <typename VectorType>
+	void ApplyBlock(
+		const DataArray2D<VectorType> & dataBlockIn,
+		DataArray2D<VectorType> & dataBlockOut,
+		size_t sVectors
+	) const {
+		if (!m_fOnDevice) {
+			m_psmatApply->Apply(dataBlockIn, dataBlockOut, sVectors);
+			return;
+		}
+
+#if defined(TEMPEST_OMP_OFFLOAD)
+		if ((dataBlockIn.GetColumns() < sVectors) ||
+		    (dataBlockOut.GetColumns() < sVectors)
+		) {
+			_EXCEPTIONT("Block size exceeds DataArray2D column count");
+		}
+		if ((dataBlockIn.GetRows() < m_psmatApply->GetColumns()) ||
+		    (dataBlockOut.GetRows() < m_psmatApply->GetRows())
+		) {
+			_EXCEPTIONT("Block smaller than SparseMatrix");
+		}
+
+		const int nRows = m_psmatApply->GetRows();
+		const size_t sInStride = dataBlockIn.GetColumns();
+		const size_t sOutStride = dataBlockOut.GetColumns();
+		const size_t sInSize = m_psmatApply->GetColumns() * sInStride;
+		const size_t sOutSize = nRows * sOutStride;
+
+		const size_t * pRowPtr = m_pRowPtr;
+		const int * pCols = m_pCols;
+		const DataType * pValues = m_pValues;
+		const size_t sNonZeros = m_sNonZeros;
+
+		const VectorType * pIn = dataBlockIn(0);
+		VectorType * pOut = dataBlockOut(0);
+
+		// The map arrays are already present on the device, so only the
+		// input and output blocks are transferred
+#pragma omp target teams distribute parallel for device(m_iDevice) \
+	map(to: pRowPtr[0:nRows+1], pCols[0:sNonZeros], pValues[0:sNonZeros]) \
+	map(to: pIn[0:sInSize]) map(from: pOut[0:sOutSize])
+		for (int i = 0; i < nRows; i++) {
+			for (size_t k = 0; k < sVectors; k++) {
+				DataType dSum = static_cast<DataType>(0);
+				for (size_t j = pRowPtr[i]; j < pRowPtr[i+1]; j++) {
+					dSum += pValues[j] * pIn[pCols[j] * sInStride + k];
+				}
+				pOut[i * sOutStride + k] = static_cast<VectorType>(dSum);
+			}
+		}
+
+		for (size_t i = nRows; i < dataBlockOut.GetRows(); i++) {
+			VectorType * pOutRow = dataBlockOut(i);
+			for (size_t k = 0; k < sVectors; k++) {
+				pOutRow[k] = static_cast<VectorType>(0);
+			}
+		}
+#endif
+	}
+
+private:
+	///	<summary>
+	///		The SparseMatrix.
+	///	</summary>
+	const SparseMatrix<DataType> & m_smat;
+
+	///	<summary>
+	///		The SparseMatrix that is applied:  m_smat, or its renumbered
+	///		copy.
+	///	</summary>
+	const SparseMatrix<DataType> * m_psmatApply;
+
+	///	<summary>
+	///		Flag indicating the rows and columns have been renumbered.
+	///	</summary>
+	bool m_fReordered;
+
+	///	<summary>
+	///		The renumbered copy of m_smat, if m_fReordered.
+	///	</summary>
+	SparseMatrix<DataType> m_smatReordered;
+
+	///	<summary>
+	///		Original index of each renumbered row and column.
+	///	</summary>
+	std::vector<int> m_vecRowOrder;
+	std::vector<int> m_vecColOrder;
+
+	///	<summary>
+	///		Flag indicating the CSR arrays are resident on a target device.
+	///	</summary>
+	bool m_fOnDevice;
+
+	///	<summary>
+	///		Target device number.
+	///	</summary>
+	int m_iDevice;
+
+	///	<summary>
+	///		Host pointers to the CSR arrays mapped to the device.
+	///	</summary>
+	const size_t * m_pRowPtr;
+	const int * m_pCols;
+	const DataType * m_pValues;
+
+	///	<summary>
+	///		Number of nonzeros.
+	///	</summary>
+	size_t m_sNonZeros;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif
+
@@ -4,6 +4,8 @@
 #include "DataArray3D.h"
 #include "GridElements.h"
 #include "OfflineMap.h"
+#include "OfflineMapApplySession.h"
+#include "RemapMeshContext.h"
 #include "netcdfcpp.h"
 #include <string>
 
@@ -18,6 +20,15 @@ extern "C" {
 		std::string strOutputFile,
 		std::string strOutputFormat );
 
+	///	<summary>
+	///		Generate a cubed-sphere mesh and write it to an Exodus file in
+	///		chunks, without holding the whole mesh in memory.
+	///	</summary>
+	int GenerateCSMeshStreamed (
+		int nResolution,
+		std::string strOutputFile,
+		std::string strOutputFormat );
+
 	///	<summary>
 	///		Generate a transect mesh.
 	///	</summary>
@@ -71,6 +82,29 @@ extern "C" {
 		std::string strOutputFormat,
 		bool fVerbose );
 
+	///	<summary>
+	///		Generate a regular latitude-longitude mesh and write it to an
+	///		Exodus or SCRIP file (strOutputType is "exodus" or "scrip") in
+	///		chunks, without holding the whole mesh in memory.
+	///	</summary>
+	int GenerateRLLMeshStreamed (
+		int nLongitudes,
+		int nLatitudes,
+		double dLonBegin,
+		double dLonEnd,
+		double dLatBegin,
+		double dLatEnd,
+		bool fGlobalCap,
+		bool fFlipLatLon,
+		bool fForceGlobal,
+		std::string strInputFile,
+		std::string strInputFileLonName,
+		std::string strInputFileLatName,
+		std::string strOutputFile,
+		std::string strOutputFormat,
+		std::string strOutputType,
+		bool fVerbose );
+
 	///	<summary>
 	///		Generate a rectilinear mesh from a file.
 	///	</summary>
@@ -141,6 +175,10 @@ extern "C" {
 
 	///	<summary>
 	///		Compute the overlap mesh given a source and target mesh file names.
+	///		If the previous meshes and overlap mesh are given, the previous
+	///		overlap mesh is updated with GenerateOverlapMeshIncremental().
+	///		If strCheckpointDir is given, partial overlap meshes are
+	///		checkpointed to that directory and a failed run is resumed.
 	///	</summary>
 	int GenerateOverlapMesh (
 		std::string strMeshA,
@@ -153,12 +191,21 @@ extern "C" {
 		bool fHasConcaveFacesA = false,
 		bool fHasConcaveFacesB = false,
 		bool fAllowNoOverlap = false,
-		bool fVerbose = true );
+		bool fVerbose = true,
+		bool fReorder = false,
+		std::string strPrevMeshA = "",
+		std::string strPrevMeshB = "",
+		std::string strPrevOverlapMesh = "",
+		bool fTargetMajor = false,
+		std::string strCheckpointDir = "" );
 
 	///	<summary>
 	///		Compute the overlap mesh given two mesh objects.
 	///		This is an overloaded method which takes as arguments the source and target
-	///		meshes that are pre-loaded into memory.
+	///		meshes that are pre-loaded into memory.  If fTargetMajor is set the
+	///		overlap faces are generated by iterating over faces of mesh B.  If
+	///		strCheckpointDir is given, partial overlap meshes are checkpointed
+	///		to that directory and a failed run is resumed.
 	///	</summary>
 	int GenerateOverlapWithMeshes (
 		Mesh & meshA,
@@ -170,6 +217,23 @@ extern "C" {
 		bool fHasConcaveFacesA = false,
 		bool fHasConcaveFacesB = false,
 		bool fAllowNoOverlap = false,
+		bool fVerbose = true,
+		bool fTargetMajor = false,
+		std::string strCheckpointDir = "" );
+
+	///	<summary>
+	///		Compute the overlap mesh given two mesh contexts.  The edge maps
+	///		and convexified meshes held by the contexts are reused across
+	///		calls.
+	///	</summary>
+	int GenerateOverlapWithContexts (
+		RemapMeshContext & ctxA,
+		RemapMeshContext & ctxB,
+		Mesh & meshOverlap,
+		std::string strOverlapMesh,
+		std::string strOutputFormat,
+		std::string strMethod,
+		bool fAllowNoOverlap = false,
 		bool fVerbose = true );
 
 	// Old version of the implementation to compute the overlap mesh
@@ -190,7 +254,8 @@ extern "C" {
 		bool fNoBubble,
 		std::string strOutput,
 		DataArray3D<int> & dataGLLnodes,
-		DataArray3D<double> & dataGLLJacobian );
+		DataArray3D<double> & dataGLLJacobian,
+		NcFile::FileFormat eOutputFormat = NcFile::Classic );
 
 	///	<summary>
 	///		A structure containing optional arguments for GenerateOfflineMap.
@@ -216,7 +281,19 @@ extern "C" {
 			fNoCorrectAreas(false),
 			fNoConservation(false),
 			fNoCheck(false),
-			fSparseConstraints(false)
+			fSparseConstraints(false),
+			strStencilCacheDir(""),
+			strOverlapMethod("fuzzy"),
+			fAllowNoOverlap(false),
+			strOverlapCacheDir(""),
+			fOverlapTargetMajor(false),
+			strOverlapCheckpointDir(""),
+			iOutputDeflateLevel(0),
+			fOutputNoVertices(false),
+			nOutputChunkKB(0),
+			dQuadratureTolerance(0.0),
+			strSpillDir(""),
+			fFinalizeMap(false)
 		{ }
 
 	public:
@@ -295,6 +372,81 @@ extern "C" {
 		///		Use sparse constraints.
 		///	</summary>
 		bool fSparseConstraints;
+
+		///	<summary>
+		///		A directory for caching finite volume reconstruction stencils
+		///		of the source mesh.
+		///	</summary>
+		std::string strStencilCacheDir;
+
+		///	<summary>
+		///		Method used to generate the overlap mesh in memory when no
+		///		overlap mesh file is given (fuzzy|exact|mixed|clip).
+		///	</summary>
+		std::string strOverlapMethod;
+
+		///	<summary>
+		///		Allow source faces with no overlap when generating the
+		///		overlap mesh in memory.
+		///	</summary>
+		bool fAllowNoOverlap;
+
+		///	<summary>
+		///		A directory for caching overlap meshes generated in memory,
+		///		keyed by the contents of the source and target meshes.
+		///	</summary>
+		std::string strOverlapCacheDir;
+
+		///	<summary>
+		///		Generate the overlap mesh in memory by iterating over target
+		///		faces rather than source faces.
+		///	</summary>
+		bool fOverlapTargetMajor;
+
+		///	<summary>
+		///		A directory for checkpoints of overlap meshes generated in
+		///		memory, from which a failed run is resumed.
+		///	</summary>
+		std::string strOverlapCheckpointDir;
+
+		///	<summary>
+		///		Deflate level (0-9) of variables in NetCDF-4 output maps.
+		///	</summary>
+		int iOutputDeflateLevel;
+
+		///	<summary>
+		///		Omit the vertex arrays (xv_a, yv_a, xv_b, yv_b) from output maps.
+		///	</summary>
+		bool fOutputNoVertices;
+
+		///	<summary>
+		///		Target chunk size in KiB of variables in NetCDF-4 output maps,
+		///		or 0 for the default.
+		///	</summary>
+		int nOutputChunkKB;
+
+		///	<summary>
+		///		Tolerance on the estimated quadrature error of each overlap
+		///		triangle, below which lower order triangular quadrature rules
+		///		are used, or 0 to always use the full order rules.
+		///	</summary>
+		double dQuadratureTolerance;
+
+		///	<summary>
+		///		Directory in which map weights are spilled to temporary files
+		///		as they are computed and merged when the map is finalized,
+		///		or empty to accumulate weights in memory.  If a memory limit
+		///		is set in PerformanceOptions, weights are only spilled once
+		///		they exceed it (to TMPDIR if this is empty).
+		///	</summary>
+		std::string strSpillDir;
+
+		///	<summary>
+		///		Freeze the generated map to compressed sparse row form before
+		///		it is written, so that it can be applied without a further
+		///		conversion.  The map can then no longer be modified.
+		///	</summary>
+		bool fFinalizeMap;
 	};
 
 	///	<summary>
@@ -310,7 +462,35 @@ extern "C" {
 		OfflineMap & mapRemap );
 
 	///	<summary>
-	///		Generate the OfflineMap between input and output meshes.
+	///		Generate the OfflineMap between the meshes of two contexts.  Face
+	///		areas, edge maps, reverse node arrays, GLL metadata and finite
+	///		volume stencils held by the contexts are reused across calls.
+	///	</summary>
+	int GenerateOfflineMapWithContexts (
+		RemapMeshContext & ctxSource,
+		RemapMeshContext & ctxTarget,
+		Mesh & meshOverlap,
+		std::string strSourceType,
+		std::string strTargetType,
+		const GenerateOfflineMapAlgorithmOptions & optsAlg,
+		OfflineMap & mapRemap );
+
+	///	<summary>
+	///		Generate the overlap mesh between input and output meshes in
+	///		memory and use it directly to generate the OfflineMap, without
+	///		writing the overlap mesh to disk or recomputing its Face areas.
+	///	</summary>
+	int GenerateOverlapAndOfflineMapWithMeshes (
+		Mesh & meshSource,
+		Mesh & meshTarget,
+		std::string strSourceType,
+		std::string strTargetType,
+		const GenerateOfflineMapAlgorithmOptions & optsAlg,
+		OfflineMap & mapRemap );
+
+	///	<summary>
+	///		Generate the OfflineMap between input and output meshes.  If
+	///		strOverlapMesh is empty the overlap mesh is generated in memory.
 	///	</summary>
 	int GenerateOfflineMap (
 		std::string strSourceMesh,
@@ -321,6 +501,23 @@ extern "C" {
 		const GenerateOfflineMapAlgorithmOptions & optsAlg,
 		OfflineMap & mapRemap );
 
+	///	<summary>
+	///		Generate OfflineMaps from one input mesh to each of the output
+	///		meshes listed in strTargetMeshList, writing them to the map files
+	///		listed in strOutputMapList (one filename per line).  The input
+	///		mesh is read once, and its Face areas, edge map, reverse node
+	///		array, convexified mesh, GLL metadata and finite volume stencils
+	///		are built once and shared by all maps.  Overlap meshes are
+	///		generated in memory.
+	///	</summary>
+	int GenerateOfflineMapMultiTarget (
+		std::string strSourceMesh,
+		std::string strTargetMeshList,
+		std::string strOutputMapList,
+		std::string strSourceType,
+		std::string strTargetType,
+		const GenerateOfflineMapAlgorithmOptions & optsAlg );
+
 	///	<summary>
 	///		A structure containing optional arguments for outputs from GenerateOfflineMap.
 	///	</summary>
@@ -342,7 +539,21 @@ extern "C" {
 			strPreserveVariables(""),
 			fPreserveAll(false),
 			dFillValueOverride(0.0),
-			strLogDir("")
+			strLogDir(""),
+			fDistributeSlices(false),
+			fParallelVariables(false),
+			fRenormalize(false),
+			fTranspose(false),
+			fAdjoint(false),
+			fReorder(false),
+			strServerSocket(""),
+			nServerWorkers(2),
+			strConnectSocket(""),
+			fServerShutdown(false),
+			fBenchmark(false),
+			nBenchmarkLevels(32),
+			nBenchmarkTimes(4),
+			strBenchmarkThreads("")
 		{ }
 
 	public:
@@ -410,6 +621,87 @@ extern "C" {
 		///		A directory for writing log files.
 		///	</summary>
 		std::string strLogDir;
+
+		///	<summary>
+		///		Distribute the slices of each file over MPI ranks, rather than
+		///		distributing files (only with TEMPEST_MPIOMP).
+		///	</summary>
+		bool fDistributeSlices;
+
+		///	<summary>
+		///		Overlap reading and writing of each variable with remapping
+		///		of the neighboring variables.
+		///	</summary>
+		bool fParallelVariables;
+
+		///	<summary>
+		///		Renormalize the map for missing (fill) source values.
+		///	</summary>
+		bool fRenormalize;
+
+		///	<summary>
+		///		Apply the transpose of the map, mapping data on the target
+		///		grid to the source grid.
+		///	</summary>
+		bool fTranspose;
+
+		///	<summary>
+		///		Apply the area-weighted adjoint of the map (as generated by
+		///		GenerateTransposeMap), mapping data on the target grid to the
+		///		source grid.
+		///	</summary>
+		bool fAdjoint;
+
+		///	<summary>
+		///		Renumber source and target points internally when the map is
+		///		loaded, so that the map is applied with better locality.
+		///	</summary>
+		bool fReorder;
+
+		///	<summary>
+		///		Keep the maps resident and serve remap requests on this Unix
+		///		domain socket.
+		///	</summary>
+		std::string strServerSocket;
+
+		///	<summary>
+		///		Number of connections the server handles concurrently.
+		///		Requests are applied one at a time.
+		///	</summary>
+		int nServerWorkers;
+
+		///	<summary>
+		///		Send the remap request to the server on this Unix domain socket
+		///		rather than loading the map.
+		///	</summary>
+		std::string strConnectSocket;
+
+		///	<summary>
+		///		Request that the server on strConnectSocket shut down.
+		///	</summary>
+		bool fServerShutdown;
+
+		///	<summary>
+		///		Measure the throughput of applying the map to synthetic fields
+		///		rather than remapping data files.
+		///	</summary>
+		bool fBenchmark;
+
+		///	<summary>
+		///		Number of levels in each synthetic field of the benchmark.
+		///	</summary>
+		int nBenchmarkLevels;
+
+		///	<summary>
+		///		Number of time slices of synthetic fields in the benchmark.
+		///	</summary>
+		int nBenchmarkTimes;
+
+		///	<summary>
+		///		A list of thread counts over which the benchmark is repeated,
+		///		or empty for the current thread count.
+		///	</summary>
+		std::string strBenchmarkThreads;
 	};
 
 	///	<summary>
@@ -433,12 +725,30 @@ extern "C" {
 		const ApplyOfflineMapOptions & optsApply );
 
 	///	<summary>
-	///		Generate the connectivity data for a given input file.
+	///		Generate the connectivity data for a given input file.  Face
+	///		indices in vecConnectivity are 1-based.  The EdgeMap of meshIn
+	///		must be constructed.
 	///	</summary>
 	int GenerateConnectivityData(
 		const Mesh & meshIn,
 		std::vector< std::set<int> > & vecConnectivity );
 
+	///	<summary>
+	///		Generate the connectivity data for a given input file in
+	///		compressed sparse row format, suitable for graph partitioners.
+	///		The 0-based indices of faces adjacent to face f are stored in
+	///		increasing order in vecAdjacency[vecAdjacencyOffsets[f]] through
+	///		vecAdjacency[vecAdjacencyOffsets[f+1]-1].  Faces are adjacent if
+	///		they share an edge, which requires the EdgeMap of meshIn, or if
+	///		fNodeAdjacency is set, if they share a node, which requires the
+	///		ReverseNodeArray of meshIn.
+	///	</summary>
+	int GenerateConnectivityDataCSR(
+		const Mesh & meshIn,
+		bool fNodeAdjacency,
+		std::vector<size_t> & vecAdjacencyOffsets,
+		std::vector<int> & vecAdjacency );
+
 }
 
 #endif // TEMPESTREMAP_API_H
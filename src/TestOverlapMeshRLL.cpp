@@ -0,0 +1,255 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    TestOverlapMeshRLL.cpp
+///	\author  Paul Ullrich
+///	\version October 15, 2026
+///
+///	<remarks>
+///		Copyright 2026 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "Announce.h"
+#include "Exception.h"
+#include "GridElements.h"
+#include "OverlapMesh.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Tolerance on overlap Face areas.
+///	</summary>
+static const double TestAreaTolerance = 1.0e-12;
+
+///	<summary>
+///		Number of failed checks.
+///	</summary>
+static int s_nFailures = 0;
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Record the result of a check.
+///	</summary>
+static void Check(
+	bool fResult,
+	const char * szDescription
+) {
+	if (!fResult) {
+		printf("FAILED: %s\n", szDescription);
+		s_nFailures++;
+	} else {
+		printf("passed: %s\n", szDescription);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Generate a global rectilinear latitude-longitude mesh with uniform
+///		spacing, laid out as in GenerateRLLMesh, with its first meridian at
+///		dLonBegin (in radians).  Latitude edges are lines of constant
+///		latitude if fConstantLatitude is true and great circle arcs
+///		otherwise.  The area of each Face is stored in vecFaceArea.
+///	</summary>
+static void GenerateTestRLLMesh(
+	int nLongitudes,
+	int nLatitudes,
+	double dLonBegin,
+	bool fConstantLatitude,
+	Mesh & mesh
+) {
+	mesh.Clear();
+
+	const double dDeltaLon = 2.0 * M_PI / static_cast<double>(nLongitudes);
+	const double dDeltaLat = M_PI / static_cast<double>(nLatitudes);
+
+	// South pole, interior latitude lines and north pole
+	mesh.nodes.push_back(Node(0.0, 0.0, -1.0));
+	for (int j = 1; j < nLatitudes; j++) {
+		const double dLat = -0.5 * M_PI + dDeltaLat * static_cast<double>(j);
+		for (int i = 0; i < nLongitudes; i++) {
+			const double dLon = dLonBegin + dDeltaLon * static_cast<double>(i);
+			mesh.nodes.push_back(
+				Node(
+					cos(dLat) * cos(dLon),
+					cos(dLat) * sin(dLon),
+					sin(dLat)));
+		}
+	}
+	mesh.nodes.push_back(Node(0.0, 0.0, 1.0));
+
+	const int ixNorthPole = static_cast<int>(mesh.nodes.size()) - 1;
+
+	mesh.vecFaceArea.Allocate(nLongitudes * nLatitudes);
+
+	for (int j = 0; j < nLatitudes; j++) {
+		const int ixThisLat = (j - 1) * nLongitudes + 1;
+		const int ixNextLat = j * nLongitudes + 1;
+
+		for (int i = 0; i < nLongitudes; i++) {
+			const int iNext = (i + 1) % nLongitudes;
+
+			Face face(4);
+			if (j == 0) {
+				face.SetNode(0, 0);
+				face.SetNode(1, ixNextLat + iNext);
+				face.SetNode(2, ixNextLat + i);
+				face.SetNode(3, 0);
+
+			} else if (j == nLatitudes - 1) {
+				face.SetNode(0, ixNorthPole);
+				face.SetNode(1, ixThisLat + i);
+				face.SetNode(2, ixThisLat + iNext);
+				face.SetNode(3, ixNorthPole);
+
+			} else {
+				face.SetNode(0, ixThisLat + iNext);
+				face.SetNode(1, ixNextLat + iNext);
+				face.SetNode(2, ixNextLat + i);
+				face.SetNode(3, ixThisLat + i);
+			}
+
+			if (fConstantLatitude) {
+				face.edges[1].type = Edge::Type_ConstantLatitude;
+				face.edges[3].type = Edge::Type_ConstantLatitude;
+			}
+
+			mesh.faces.push_back(face);
+
+			const double dLatBegin =
+				-0.5 * M_PI + dDeltaLat * static_cast<double>(j);
+
+			mesh.vecFaceArea[j * nLongitudes + i] =
+				dDeltaLon * (sin(dLatBegin + dDeltaLat) - sin(dLatBegin));
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Verify that the overlap Faces of each source Face are contiguous.
+///	</summary>
+static bool IsGroupedBySourceFace(
+	const Mesh & meshOverlap
+) {
+	for (int f = 1; f < meshOverlap.vecSourceFaceIx.size(); f++) {
+		if (meshOverlap.vecSourceFaceIx[f] < meshOverlap.vecSourceFaceIx[f-1]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Verify that the overlap Face areas associated with each Face of a
+///		mesh sum to the area of that Face.
+///	</summary>
+static bool AreasMatch(
+	const Mesh & mesh,
+	const Mesh & meshOverlap,
+	const std::vector<int> & vecFaceIx
+) {
+	std::vector<double> vecArea(mesh.faces.size(), 0.0);
+	for (int f = 0; f < vecFaceIx.size(); f++) {
+		if ((vecFaceIx[f] < 0) || (vecFaceIx[f] >= mesh.faces.size())) {
+			return false;
+		}
+		vecArea[vecFaceIx[f]] += meshOverlap.vecFaceArea[f];
+	}
+	for (int i = 0; i < mesh.faces.size(); i++) {
+		if (fabs(vecArea[i] - mesh.vecFaceArea[i]) > TestAreaTolerance) {
+			return false;
+		}
+	}
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv) {
+
+try {
+	// Meshes of different resolution, with offset longitudes
+	Mesh meshSource;
+	Mesh meshTarget;
+
+	GenerateTestRLLMesh(36, 18, 0.0, true, meshSource);
+	GenerateTestRLLMesh(25, 13, 0.1, true, meshTarget);
+
+	{
+		Mesh meshOverlap;
+		bool fRLL = GenerateOverlapMeshRLL(meshSource, meshTarget, meshOverlap);
+
+		Check(fRLL, "constant latitude meshes use the rectilinear overlap");
+		Check(IsGroupedBySourceFace(meshOverlap),
+			"overlap faces are grouped by source face");
+		Check(AreasMatch(meshSource, meshOverlap, meshOverlap.vecSourceFaceIx),
+			"overlap areas sum to source face areas");
+		Check(AreasMatch(meshTarget, meshOverlap, meshOverlap.vecTargetFaceIx),
+			"overlap areas sum to target face areas");
+	}
+
+	// Faces reordered as by --reorder, with vecMultiFaceMap referring back
+	// to the original meshes
+	{
+		Mesh meshSourceReordered = meshSource;
+		Mesh meshTargetReordered = meshTarget;
+
+		meshSourceReordered.ReorderAlongSpaceFillingCurve();
+		meshTargetReordered.ReorderAlongSpaceFillingCurve();
+
+		Mesh meshOverlap;
+		bool fRLL =
+			GenerateOverlapMeshRLL(
+				meshSourceReordered, meshTargetReordered, meshOverlap);
+
+		Check(fRLL, "reordered meshes use the rectilinear overlap");
+		Check(IsGroupedBySourceFace(meshOverlap),
+			"overlap faces of reordered meshes are grouped by source face");
+		Check(AreasMatch(meshSource, meshOverlap, meshOverlap.vecSourceFaceIx),
+			"overlap areas of reordered meshes sum to original source face areas");
+		Check(AreasMatch(meshTarget, meshOverlap, meshOverlap.vecTargetFaceIx),
+			"overlap areas of reordered meshes sum to original target face areas");
+	}
+
+	// Great circle latitude edges are not rectilinear
+	{
+		Mesh meshSourceGC;
+		GenerateTestRLLMesh(36, 18, 0.0, false, meshSourceGC);
+
+		Mesh meshOverlap;
+		bool fRLL = GenerateOverlapMeshRLL(meshSourceGC, meshTarget, meshOverlap);
+
+		Check(!fRLL, "great circle latitude edges are rejected");
+	}
+
+} catch(Exception & e) {
+	Announce(e.ToString().c_str());
+	return (-1);
+
+} catch(...) {
+	return (-2);
+}
+
+	if (s_nFailures != 0) {
+		printf("%i check(s) failed\n", s_nFailures);
+		return (1);
+	}
+	return (0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
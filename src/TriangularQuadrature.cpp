@@ -17,13 +17,180 @@
 #include "TriangularQuadrature.h"
 #include "GaussQuadrature.h"
 
-#include <cstring>
+#include <cmath>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		12th order triangular quadrature rule (33 points).
+///	</summary>
+static constexpr double TriQuadrature12G[33][3] = {
+	{0.023565220452390, 0.488217389773805, 0.488217389773805},
+	{0.488217389773805, 0.023565220452390, 0.488217389773805},
+	{0.488217389773805, 0.488217389773805, 0.023565220452390},
+
+	{0.120551215411079, 0.439724392294460, 0.439724392294460},
+	{0.439724392294460, 0.120551215411079, 0.439724392294460},
+	{0.439724392294460, 0.439724392294460, 0.120551215411079},
+
+	{0.457579229975768, 0.271210385012116, 0.271210385012116},
+	{0.271210385012116, 0.457579229975768, 0.271210385012116},
+	{0.271210385012116, 0.271210385012116, 0.457579229975768},
+
+	{0.744847708916828, 0.127576145541586, 0.127576145541586},
+	{0.127576145541586, 0.744847708916828, 0.127576145541586},
+	{0.127576145541586, 0.127576145541586, 0.744847708916828},
+
+	{0.957365299093576, 0.021317350453210, 0.021317350453210},
+	{0.021317350453210, 0.957365299093576, 0.021317350453210},
+	{0.021317350453210, 0.021317350453210, 0.957365299093576},
+
+	{0.115343494534698, 0.275713269685514, 0.608943235779788},
+	{0.115343494534698, 0.608943235779788, 0.275713269685514},
+	{0.275713269685514, 0.115343494534698, 0.608943235779788},
+	{0.275713269685514, 0.608943235779788, 0.115343494534698},
+	{0.608943235779788, 0.115343494534698, 0.275713269685514},
+	{0.608943235779788, 0.275713269685514, 0.115343494534698},
+
+	{0.022838332222257, 0.281325580989940, 0.695836086787803},
+	{0.022838332222257, 0.695836086787803, 0.281325580989940},
+	{0.281325580989940, 0.022838332222257, 0.695836086787803},
+	{0.281325580989940, 0.695836086787803, 0.022838332222257},
+	{0.695836086787803, 0.022838332222257, 0.281325580989940},
+	{0.695836086787803, 0.281325580989940, 0.022838332222257},
+
+	{0.025734050548330, 0.116251915907597, 0.858014033544073},
+	{0.025734050548330, 0.858014033544073, 0.116251915907597},
+	{0.116251915907597, 0.025734050548330, 0.858014033544073},
+	{0.116251915907597, 0.858014033544073, 0.025734050548330},
+	{0.858014033544073, 0.025734050548330, 0.116251915907597},
+	{0.858014033544073, 0.116251915907597, 0.025734050548330}};
+
+static constexpr double TriQuadrature12W[33] =
+	{0.025731066440455, 0.025731066440455, 0.025731066440455,
+	 0.043692544538038, 0.043692544538038, 0.043692544538038,
+	 0.062858224217885, 0.062858224217885, 0.062858224217885,
+	 0.034796112930709, 0.034796112930709, 0.034796112930709,
+	 0.006166261051559, 0.006166261051559, 0.006166261051559,
+	 0.040371557766381, 0.040371557766381, 0.040371557766381,
+	 0.040371557766381, 0.040371557766381, 0.040371557766381,
+	 0.022356773202303, 0.022356773202303, 0.022356773202303,
+	 0.022356773202303, 0.022356773202303, 0.022356773202303,
+	 0.017316231108659, 0.017316231108659, 0.017316231108659,
+	 0.017316231108659, 0.017316231108659, 0.017316231108659};
+
+///	<summary>
+///		10th order triangular quadrature rule (25 points).
+///	</summary>
+static constexpr double TriQuadrature10G[25][3] = {
+	{0.333333333333333, 0.333333333333333, 0.333333333333333},
+	{0.028844733232685, 0.485577633383657, 0.485577633383657},
+	{0.485577633383657, 0.028844733232685, 0.485577633383657},
+	{0.485577633383657, 0.485577633383657, 0.028844733232685},
+	{0.781036849029926, 0.109481575485037, 0.109481575485037},
+	{0.109481575485037, 0.781036849029926, 0.109481575485037},
+	{0.109481575485037, 0.109481575485037, 0.781036849029926},
+	{0.141707219414880, 0.307939838764121, 0.550352941820999},
+	{0.141707219414880, 0.550352941820999, 0.307939838764121},
+	{0.307939838764121, 0.141707219414880, 0.550352941820999},
+	{0.307939838764121, 0.550352941820999, 0.141707219414880},
+	{0.550352941820999, 0.141707219414880, 0.307939838764121},
+	{0.550352941820999, 0.307939838764121, 0.141707219414880},
+	{0.025003534762686, 0.246672560639903, 0.728323904597411},
+	{0.025003534762686, 0.728323904597411, 0.246672560639903},
+	{0.246672560639903, 0.025003534762686, 0.728323904597411},
+	{0.246672560639903, 0.728323904597411, 0.025003534762686},
+	{0.728323904597411, 0.025003534762686, 0.246672560639903},
+	{0.728323904597411, 0.246672560639903, 0.025003534762686},
+	{0.009540815400299, 0.066803251012200, 0.923655933587500},
+	{0.009540815400299, 0.923655933587500, 0.066803251012200},
+	{0.066803251012200, 0.009540815400299, 0.923655933587500},
+	{0.066803251012200, 0.923655933587500, 0.009540815400299},
+	{0.923655933587500, 0.009540815400299, 0.066803251012200},
+	{0.923655933587500, 0.066803251012200, 0.009540815400299}};
+
+static constexpr double TriQuadrature10W[25] =
+	{0.090817990382754,
+	 0.036725957756467, 0.036725957756467, 0.036725957756467,
+	 0.045321059435528, 0.045321059435528, 0.045321059435528,
+	 0.072757916845420, 0.072757916845420, 0.072757916845420,
+	 0.072757916845420, 0.072757916845420, 0.072757916845420,
+	 0.028327242531057, 0.028327242531057, 0.028327242531057,
+	 0.028327242531057, 0.028327242531057, 0.028327242531057,
+	 0.009421666963733, 0.009421666963733, 0.009421666963733,
+	 0.009421666963733, 0.009421666963733, 0.009421666963733};
+
+///	<summary>
+///		8th order triangular quadrature rule (16 points).
+///	</summary>
+static constexpr double TriQuadrature8G[16][3] = {
+	{0.333333333333333, 0.333333333333333, 0.333333333333333},
+	{0.081414823414554, 0.459292588292723, 0.459292588292723},
+	{0.459292588292723, 0.081414823414554, 0.459292588292723},
+	{0.459292588292723, 0.459292588292723, 0.081414823414554},
+	{0.658861384496480, 0.170569307751760, 0.170569307751760},
+	{0.170569307751760, 0.658861384496480, 0.170569307751760},
+	{0.170569307751760, 0.170569307751760, 0.658861384496480},
+	{0.898905543365938, 0.050547228317031, 0.050547228317031},
+	{0.050547228317031, 0.898905543365938, 0.050547228317031},
+	{0.050547228317031, 0.050547228317031, 0.898905543365938},
+	{0.008394777409958, 0.263112829634638, 0.728492392955404},
+	{0.008394777409958, 0.728492392955404, 0.263112829634638},
+	{0.263112829634638, 0.008394777409958, 0.728492392955404},
+	{0.263112829634638, 0.728492392955404, 0.008394777409958},
+	{0.728492392955404, 0.263112829634638, 0.008394777409958},
+	{0.728492392955404, 0.008394777409958, 0.263112829634638}};
+
+static constexpr double TriQuadrature8W[16] =
+	{0.144315607677787,
+	 0.095091634267285, 0.095091634267285, 0.095091634267285,
+	 0.103217370534718, 0.103217370534718, 0.103217370534718,
+	 0.032458497623198, 0.032458497623198, 0.032458497623198,
+	 0.027230314174435, 0.027230314174435, 0.027230314174435,
+	 0.027230314174435, 0.027230314174435, 0.027230314174435};
+
+///	<summary>
+///		4th order triangular quadrature rule (6 points).
+///	</summary>
+static constexpr double TriQuadrature4G[6][3] = {
+	{0.108103018168070, 0.445948490915965, 0.445948490915965},
+	{0.445948490915965, 0.108103018168070, 0.445948490915965},
+	{0.445948490915965, 0.445948490915965, 0.108103018168070},
+	{0.816847572980458, 0.091576213509771, 0.091576213509771},
+	{0.091576213509771, 0.816847572980458, 0.091576213509771},
+	{0.091576213509771, 0.091576213509771, 0.816847572980458}};
+
+static constexpr double TriQuadrature4W[6] =
+	{0.223381589678011, 0.223381589678011, 0.223381589678011,
+	 0.109951743655322, 0.109951743655322, 0.109951743655322};
+
+///	<summary>
+///		2nd order triangular quadrature rule (3 points).
+///	</summary>
+static constexpr double TriQuadrature2G[3][3] = {
+	{2.0/3.0, 1.0/6.0, 1.0/6.0},
+	{1.0/6.0, 2.0/3.0, 1.0/6.0},
+	{1.0/6.0, 1.0/6.0, 2.0/3.0}};
+
+static constexpr double TriQuadrature2W[3] =
+	{1.0/3.0, 1.0/3.0, 1.0/3.0};
+
+///	<summary>
+///		1st order triangular quadrature rule (1 point).
+///	</summary>
+static constexpr double TriQuadrature1G[1][3] = {
+	{0.333333333333333, 0.333333333333333, 0.333333333333333}};
+
+static constexpr double TriQuadrature1W[1] =
+	{1.000000000000000};
 
 ///////////////////////////////////////////////////////////////////////////////
 
 TriangularQuadratureRule::TriangularQuadratureRule(
 	int nOrder
-) {
+) :
+	m_nOrder(nOrder)
+{
 /*
 	DataArray1D<double> dG;
 	DataArray1D<double> dW;
@@ -45,191 +212,102 @@ TriangularQuadratureRule::TriangularQuadratureRule(
 */
 	// 12th order quadrature rule (33 points)
 	if (nOrder == 12) {
-		const double TriQuadratureG[33][3] = {
-			{0.023565220452390, 0.488217389773805, 0.488217389773805},
-			{0.488217389773805, 0.023565220452390, 0.488217389773805},
-			{0.488217389773805, 0.488217389773805, 0.023565220452390},
-
-			{0.120551215411079, 0.439724392294460, 0.439724392294460},
-			{0.439724392294460, 0.120551215411079, 0.439724392294460},
-			{0.439724392294460, 0.439724392294460, 0.120551215411079},
-
-			{0.457579229975768, 0.271210385012116, 0.271210385012116},
-			{0.271210385012116, 0.457579229975768, 0.271210385012116},
-			{0.271210385012116, 0.271210385012116, 0.457579229975768},
-
-			{0.744847708916828, 0.127576145541586, 0.127576145541586},
-			{0.127576145541586, 0.744847708916828, 0.127576145541586},
-			{0.127576145541586, 0.127576145541586, 0.744847708916828},
-
-			{0.957365299093576, 0.021317350453210, 0.021317350453210},
-			{0.021317350453210, 0.957365299093576, 0.021317350453210},
-			{0.021317350453210, 0.021317350453210, 0.957365299093576},
-
-			{0.115343494534698, 0.275713269685514, 0.608943235779788},
-			{0.115343494534698, 0.608943235779788, 0.275713269685514},
-			{0.275713269685514, 0.115343494534698, 0.608943235779788},
-			{0.275713269685514, 0.608943235779788, 0.115343494534698},
-			{0.608943235779788, 0.115343494534698, 0.275713269685514},
-			{0.608943235779788, 0.275713269685514, 0.115343494534698},
-
-			{0.022838332222257, 0.281325580989940, 0.695836086787803},
-			{0.022838332222257, 0.695836086787803, 0.281325580989940},
-			{0.281325580989940, 0.022838332222257, 0.695836086787803},
-			{0.281325580989940, 0.695836086787803, 0.022838332222257},
-			{0.695836086787803, 0.022838332222257, 0.281325580989940},
-			{0.695836086787803, 0.281325580989940, 0.022838332222257},
-
-			{0.025734050548330, 0.116251915907597, 0.858014033544073},
-			{0.025734050548330, 0.858014033544073, 0.116251915907597},
-			{0.116251915907597, 0.025734050548330, 0.858014033544073},
-			{0.116251915907597, 0.858014033544073, 0.025734050548330},
-			{0.858014033544073, 0.025734050548330, 0.116251915907597},
-			{0.858014033544073, 0.116251915907597, 0.025734050548330}};
-
-		const double TriQuadratureW[33] =
-			{0.025731066440455, 0.025731066440455, 0.025731066440455,
-			 0.043692544538038, 0.043692544538038, 0.043692544538038,
-			 0.062858224217885, 0.062858224217885, 0.062858224217885,
-			 0.034796112930709, 0.034796112930709, 0.034796112930709,
-			 0.006166261051559, 0.006166261051559, 0.006166261051559,
-			 0.040371557766381, 0.040371557766381, 0.040371557766381,
-			 0.040371557766381, 0.040371557766381, 0.040371557766381,
-			 0.022356773202303, 0.022356773202303, 0.022356773202303,
-			 0.022356773202303, 0.022356773202303, 0.022356773202303,
-			 0.017316231108659, 0.017316231108659, 0.017316231108659,
-			 0.017316231108659, 0.017316231108659, 0.017316231108659};
-
-		m_nPoints = 33;
-
-		m_dG.Allocate(33, 3);
-		memcpy(&(m_dG[0][0]), &(TriQuadratureG[0][0]), 33 * 3 * sizeof(double));
-
-		m_dW.Allocate(33);
-		memcpy(&(m_dW[0]), &(TriQuadratureW[0]), 33 * sizeof(double));
+		AttachToTable(33, TriQuadrature12G, TriQuadrature12W);
 
 	// 10th order quadrature rule (25 points)
 	} else if (nOrder == 10) {
-		const double TriQuadratureG[25][3] = {
-			{0.333333333333333, 0.333333333333333, 0.333333333333333},
-			{0.028844733232685, 0.485577633383657, 0.485577633383657},
-			{0.485577633383657, 0.028844733232685, 0.485577633383657},
-			{0.485577633383657, 0.485577633383657, 0.028844733232685},
-			{0.781036849029926, 0.109481575485037, 0.109481575485037},
-			{0.109481575485037, 0.781036849029926, 0.109481575485037},
-			{0.109481575485037, 0.109481575485037, 0.781036849029926},
-			{0.141707219414880, 0.307939838764121, 0.550352941820999},
-			{0.141707219414880, 0.550352941820999, 0.307939838764121},
-			{0.307939838764121, 0.141707219414880, 0.550352941820999},
-			{0.307939838764121, 0.550352941820999, 0.141707219414880},
-			{0.550352941820999, 0.141707219414880, 0.307939838764121},
-			{0.550352941820999, 0.307939838764121, 0.141707219414880},
-			{0.025003534762686, 0.246672560639903, 0.728323904597411},
-			{0.025003534762686, 0.728323904597411, 0.246672560639903},
-			{0.246672560639903, 0.025003534762686, 0.728323904597411},
-			{0.246672560639903, 0.728323904597411, 0.025003534762686},
-			{0.728323904597411, 0.025003534762686, 0.246672560639903},
-			{0.728323904597411, 0.246672560639903, 0.025003534762686},
-			{0.009540815400299, 0.066803251012200, 0.923655933587500},
-			{0.009540815400299, 0.923655933587500, 0.066803251012200},
-			{0.066803251012200, 0.009540815400299, 0.923655933587500},
-			{0.066803251012200, 0.923655933587500, 0.009540815400299},
-			{0.923655933587500, 0.009540815400299, 0.066803251012200},
-			{0.923655933587500, 0.066803251012200, 0.009540815400299}};
-
-		const double TriQuadratureW[25] =
-			{0.090817990382754,
-			 0.036725957756467, 0.036725957756467, 0.036725957756467,
-			 0.045321059435528, 0.045321059435528, 0.045321059435528,
-			 0.072757916845420, 0.072757916845420, 0.072757916845420,
-			 0.072757916845420, 0.072757916845420, 0.072757916845420,
-			 0.028327242531057, 0.028327242531057, 0.028327242531057,
-			 0.028327242531057, 0.028327242531057, 0.028327242531057,
-			 0.009421666963733, 0.009421666963733, 0.009421666963733,
-			 0.009421666963733, 0.009421666963733, 0.009421666963733};
-
-		m_nPoints = 25;
-
-		m_dG.Allocate(25, 3);
-		memcpy(&(m_dG[0][0]), &(TriQuadratureG[0][0]), 25 * 3 * sizeof(double));
-
-		m_dW.Allocate(25);
-		memcpy(&(m_dW[0]), &(TriQuadratureW[0]), 25 * sizeof(double));
+		AttachToTable(25, TriQuadrature10G, TriQuadrature10W);
 
 	// 8th order quadrature rule (16 points)
 	} else if (nOrder == 8) {
-		const double TriQuadratureG[16][3] = {
-			{0.333333333333333, 0.333333333333333, 0.333333333333333},
-			{0.081414823414554, 0.459292588292723, 0.459292588292723},
-			{0.459292588292723, 0.081414823414554, 0.459292588292723},
-			{0.459292588292723, 0.459292588292723, 0.081414823414554},
-			{0.658861384496480, 0.170569307751760, 0.170569307751760},
-			{0.170569307751760, 0.658861384496480, 0.170569307751760},
-			{0.170569307751760, 0.170569307751760, 0.658861384496480},
-			{0.898905543365938, 0.050547228317031, 0.050547228317031},
-			{0.050547228317031, 0.898905543365938, 0.050547228317031},
-			{0.050547228317031, 0.050547228317031, 0.898905543365938},
-			{0.008394777409958, 0.263112829634638, 0.728492392955404},
-			{0.008394777409958, 0.728492392955404, 0.263112829634638},
-			{0.263112829634638, 0.008394777409958, 0.728492392955404},
-			{0.263112829634638, 0.728492392955404, 0.008394777409958},
-			{0.728492392955404, 0.263112829634638, 0.008394777409958},
-			{0.728492392955404, 0.008394777409958, 0.263112829634638}};
-
-		const double TriQuadratureW[16] =
-			{0.144315607677787,
-			 0.095091634267285, 0.095091634267285, 0.095091634267285,
-			 0.103217370534718, 0.103217370534718, 0.103217370534718,
-			 0.032458497623198, 0.032458497623198, 0.032458497623198,
-			 0.027230314174435, 0.027230314174435, 0.027230314174435,
-			 0.027230314174435, 0.027230314174435, 0.027230314174435};
-
-		m_nPoints = 16;
-
-		m_dG.Allocate(16, 3);
-		memcpy(&(m_dG[0][0]), &(TriQuadratureG[0][0]), 16 * 3 * sizeof(double));
-
-		m_dW.Allocate(16);
-		memcpy(&(m_dW[0]), &(TriQuadratureW[0]), 16 * sizeof(double));
+		AttachToTable(16, TriQuadrature8G, TriQuadrature8W);
 
 	// 4th order quadrature rule (6 points)
 	} else if (nOrder == 4) {
+		AttachToTable(6, TriQuadrature4G, TriQuadrature4W);
 
-		const double TriQuadratureG[6][3] = {
-			{0.108103018168070, 0.445948490915965, 0.445948490915965},
-			{0.445948490915965, 0.108103018168070, 0.445948490915965},
-			{0.445948490915965, 0.445948490915965, 0.108103018168070},
-			{0.816847572980458, 0.091576213509771, 0.091576213509771},
-			{0.091576213509771, 0.816847572980458, 0.091576213509771},
-			{0.091576213509771, 0.091576213509771, 0.816847572980458}};
+	// 2nd order quadrature rule (3 points)
+	} else if (nOrder == 2) {
+		AttachToTable(3, TriQuadrature2G, TriQuadrature2W);
 
-		const double TriQuadratureW[6] =
-			{0.223381589678011, 0.223381589678011, 0.223381589678011,
-			 0.109951743655322, 0.109951743655322, 0.109951743655322};
+	// 1st order quadrature rule (1 point)
+	} else if (nOrder == 1) {
+		AttachToTable(1, TriQuadrature1G, TriQuadrature1W);
 
-		m_nPoints = 6;
+	// Unsupported order
+	} else {
+		_EXCEPTIONT("Unsupported order of TriangularQuadratureRule");
+	}
+}
 
-		m_dG.Allocate(6, 3);
-		memcpy(&(m_dG[0][0]), &(TriQuadratureG[0][0]), 6 * 3 * sizeof(double));
+///////////////////////////////////////////////////////////////////////////////
 
-		m_dW.Allocate(6);
-		memcpy(&(m_dW[0]), &(TriQuadratureW[0]), 6 * sizeof(double));
+void TriangularQuadratureRule::AttachToTable(
+	int nPoints,
+	const double (*dG)[3],
+	const double * dW
+) {
+	m_nPoints = nPoints;
 
-	// 1st order quadrature rule (1 point)
-	} else if (nOrder == 1) {
+	m_dG.SetSize(nPoints, 3);
+	m_dG.AttachToData(const_cast<double *>(&(dG[0][0])));
 
-		m_dG.Allocate(1, 3);
-		m_dG[0][0] = 0.333333333333333;
-		m_dG[0][1] = 0.333333333333333;
-		m_dG[0][2] = 0.333333333333333;
+	m_dW.SetSize(nPoints);
+	m_dW.AttachToData(const_cast<double *>(dW));
+}
 
-		m_dW.Allocate(1);
-		m_dW[0] = 1.000000000000000;
+///////////////////////////////////////////////////////////////////////////////
 
-	// Unsupported order
-	} else {
-		_EXCEPTIONT("Unsupported order of TriangularQuadratureRule");
+AdaptiveTriangularQuadratureRule::AdaptiveTriangularQuadratureRule(
+	const TriangularQuadratureRule & triquadrule,
+	double dTolerance
+) :
+	m_dTolerance(dTolerance),
+	m_triquadrule1(1),
+	m_triquadrule2(2),
+	m_triquadrule4(4),
+	m_nRules(0)
+{
+	// Lower order rules are only used if a tolerance is given
+	if (dTolerance > 0.0) {
+		const TriangularQuadratureRule * pLowOrderRules[3] =
+			{&m_triquadrule1, &m_triquadrule2, &m_triquadrule4};
+
+		for (int i = 0; i < 3; i++) {
+			if (pLowOrderRules[i]->GetOrder() < triquadrule.GetOrder()) {
+				m_pRules[m_nRules] = pLowOrderRules[i];
+				m_nRules++;
+			}
+		}
+	}
+
+	m_pRules[m_nRules] = &triquadrule;
+	m_nRules++;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+int AdaptiveTriangularQuadratureRule::SelectRule(
+	double dTriArea,
+	double dDiameterSq,
+	double dRefArea
+) const {
+	if ((m_nRules == 1) || (dRefArea <= 0.0)) {
+		return (m_nRules-1);
+	}
+
+	const double dRelArea = fabs(dTriArea) / dRefArea;
+	const double dRelDiameter = sqrt(dDiameterSq / dRefArea);
+
+	for (int i = 0; i < m_nRules-1; i++) {
+		double dError =
+			dRelArea * pow(dRelDiameter, m_pRules[i]->GetOrder() + 1);
+
+		if (dError <= m_dTolerance) {
+			return i;
+		}
 	}
+	return (m_nRules-1);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -40,6 +40,13 @@ public:
 		int nOrder
 	);
 
+	///	<summary>
+	///		Get the order of the rule.
+	///	</summary>
+	int GetOrder() const {
+		return m_nOrder;
+	}
+
 	///	<summary>
 	///		Get the number of points in the rule.
 	///	</summary>
@@ -62,6 +69,22 @@ public:
 	}
 
 protected:
+	///	<summary>
+	///		Attach the coordinates and weights of this rule to a
+	///		compile-time table, so that construction does not allocate.
+	///	</summary>
+	void AttachToTable(
+		int nPoints,
+		const double (*dG)[3],
+		const double * dW
+	);
+
+protected:
+	///	<summary>
+	///		Order of the triangular quadrature rule.
+	///	</summary>
+	int m_nOrder;
+
 	///	<summary>
 	///		Number of points associated with triangular quadrature rule.
 	///	</summary>
@@ -80,5 +103,120 @@ protected:
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		A TriangularQuadratureRule together with the lower order rules, for
+///		selecting on each triangle the lowest order rule whose estimated
+///		error is within a tolerance.  The error of a rule of order q on a
+///		triangle of area A and diameter h, relative to the area A0 of the
+///		element whose basis is integrated, is estimated as
+///		(A / A0) (h^2 / A0)^((q+1)/2), so small triangles use low order
+///		rules.  With a tolerance of zero only the given rule is used.
+///	</summary>
+class AdaptiveTriangularQuadratureRule {
+
+public:
+	///	<summary>
+	///		Constructor.  The highest order rule is triquadrule, which must
+	///		outlive this object.
+	///	</summary>
+	AdaptiveTriangularQuadratureRule(
+		const TriangularQuadratureRule & triquadrule,
+		double dTolerance
+	);
+
+private:
+	///	<summary>
+	///		Copy constructor (disabled, since rules are referenced by address).
+	///	</summary>
+	AdaptiveTriangularQuadratureRule(
+		const AdaptiveTriangularQuadratureRule &
+	);
+
+public:
+	///	<summary>
+	///		Get the number of rules, in increasing order.
+	///	</summary>
+	int GetRuleCount() const {
+		return m_nRules;
+	}
+
+	///	<summary>
+	///		Get the specified rule.
+	///	</summary>
+	const TriangularQuadratureRule & GetRule(int i) const {
+		return *(m_pRules[i]);
+	}
+
+	///	<summary>
+	///		Get the index of the lowest order rule within tolerance on a
+	///		triangle with the given area and squared diameter.
+	///	</summary>
+	int SelectRule(
+		double dTriArea,
+		double dDiameterSq,
+		double dRefArea
+	) const;
+
+	///	<summary>
+	///		Get the index of the lowest order rule within tolerance on the
+	///		triangle with the given vertices.
+	///	</summary>
+	template <typename NodeType>
+	int SelectRule(
+		const NodeType & node0,
+		const NodeType & node1,
+		const NodeType & node2,
+		double dTriArea,
+		double dRefArea
+	) const {
+		if (m_nRules == 1) {
+			return 0;
+		}
+
+		const NodeType * pNodes[3] = {&node0, &node1, &node2};
+
+		double dDiameterSq = 0.0;
+		for (int i = 0; i < 3; i++) {
+			const NodeType & nodeA = *(pNodes[i]);
+			const NodeType & nodeB = *(pNodes[(i+1)%3]);
+
+			double dDx = nodeB.x - nodeA.x;
+			double dDy = nodeB.y - nodeA.y;
+			double dDz = nodeB.z - nodeA.z;
+			double dEdgeSq = dDx * dDx + dDy * dDy + dDz * dDz;
+			if (dEdgeSq > dDiameterSq) {
+				dDiameterSq = dEdgeSq;
+			}
+		}
+
+		return SelectRule(dTriArea, dDiameterSq, dRefArea);
+	}
+
+protected:
+	///	<summary>
+	///		Tolerance on the estimated error.
+	///	</summary>
+	double m_dTolerance;
+
+	///	<summary>
+	///		Lower order rules.
+	///	</summary>
+	TriangularQuadratureRule m_triquadrule1;
+	TriangularQuadratureRule m_triquadrule2;
+	TriangularQuadratureRule m_triquadrule4;
+
+	///	<summary>
+	///		Number of rules in use.
+	///	</summary>
+	int m_nRules;
+
+	///	<summary>
+	///		Rules in use, in increasing order.
+	///	</summary>
+	const TriangularQuadratureRule * m_pRules[4];
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
 #endif
 
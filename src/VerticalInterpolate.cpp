@@ -413,6 +413,11 @@ try {
 
 	DataArray2D<double> dOutputData(nValues, nSpatialDOFs);
 
+	// Interpolation points grouped by lower level index, so that each
+	// level of a variable only visits the points that use it
+	DataArray1D<long> lLevelBucketBegin(nVerticalDimSize+1);
+	DataArray1D<long> lLevelBucketEntries(nSpatialDOFs * nValues);
+
 	// Load old dimension (only used when --output_interp_level_value)
 	DataArray1D<double> dOldDimValues;
 	if (fOutputInterpLevelValue) {
@@ -474,12 +479,11 @@ try {
 			strAuxIndex.c_str(),
 			strSpatialRange.c_str());
 
-		nLevelIndexLower.Zero();
-
 		// Number of spatial points where the interpolation point has been found
 		long lDone = 0;
 
 		// Default level index to "not found"
+#pragma omp parallel for schedule(static)
 		for (int i = 0; i < nSpatialDOFs; i++) {
 			for (int k = 0; k < nValues; k++) {
 				nLevelIndexLower[i][k] = (-1);
@@ -504,6 +508,7 @@ try {
 
 			// Is vecValuesDouble[k] below the lowermost level value?
 			if ((!fOnlyInRange) && (l == lLevelBegin+1)) {
+#pragma omp parallel for schedule(static) reduction(+:lDone)
 				for (int i = 0; i < nSpatialDOFs; i++) {
 					const double dLower = (*pSliceDataLower)[i];
 					const double dUpper = (*pSliceDataUpper)[i];
@@ -543,6 +548,7 @@ try {
 
 			// Is vecValuesDouble[k] above the uppermost level value?
 			if ((!fOnlyInRange) && (l == lLevelLast)) {
+#pragma omp parallel for schedule(static) reduction(+:lDone)
 				for (int i = 0; i < nSpatialDOFs; i++) {
 					const double dLower = (*pSliceDataLower)[i];
 					const double dUpper = (*pSliceDataUpper)[i];
@@ -582,6 +588,7 @@ try {
 
 			// Is vecValuesDouble[k] somewhere in between?
 			if (l != lLevelBegin) {
+#pragma omp parallel for schedule(static) reduction(+:lDone)
 				for (int i = 0; i < nSpatialDOFs; i++) {
 					const double dLower = (*pSliceDataLower)[i];
 					const double dUpper = (*pSliceDataUpper)[i];
@@ -599,7 +606,7 @@ try {
 							//if (fabs(dUpper - dLower) < 1.0e-12) {
 							//	continue;
 							//}
-							nLevelIndexLower[i][k] = (int)(l);
+							nLevelIndexLower[i][k] = (int)(l-1);
 							dWeightLower[i][k] =
 								(dUpper - vecValuesDouble[k]) / (dUpper - dLower);
 							lDone++;
@@ -641,6 +648,35 @@ try {
 			}
 		}
 
+		///////////////////////////////////////////////////////////
+		// Group interpolation points by lower level index
+		lLevelBucketBegin.Zero();
+		for (int i = 0; i < nSpatialDOFs; i++) {
+			for (int k = 0; k < nValues; k++) {
+				if (nLevelIndexLower[i][k] != -1) {
+					lLevelBucketBegin[nLevelIndexLower[i][k]+1]++;
+				}
+			}
+		}
+		for (long l = 0; l < nVerticalDimSize; l++) {
+			lLevelBucketBegin[l+1] += lLevelBucketBegin[l];
+		}
+		{
+			DataArray1D<long> lLevelBucketNext(nVerticalDimSize);
+			for (long l = 0; l < nVerticalDimSize; l++) {
+				lLevelBucketNext[l] = lLevelBucketBegin[l];
+			}
+			for (int i = 0; i < nSpatialDOFs; i++) {
+				for (int k = 0; k < nValues; k++) {
+					const int iLevel = nLevelIndexLower[i][k];
+					if (iLevel != -1) {
+						lLevelBucketEntries[lLevelBucketNext[iLevel]++] =
+							static_cast<long>(i) * nValues + k;
+					}
+				}
+			}
+		}
+
 		///////////////////////////////////////////////////////////
 		// Linearly interpolate using level index
 		for (int v = 1; v < vecInputNcVars.size(); v++) {
@@ -685,12 +721,23 @@ try {
 
 				for (long l = lLevelBegin; l <= lLevelLast; l++) {
 
+					// Levels that bound no interpolation point are not read
+					const bool fLowerUsed =
+						(l != lLevelBegin) &&
+						(lLevelBucketBegin[l] != lLevelBucketBegin[l-1]);
+					const bool fUpperUsed =
+						(l != lLevelLast) &&
+						(lLevelBucketBegin[l+1] != lLevelBucketBegin[l]);
+
+					if (!fLowerUsed && !fUpperUsed) {
+						DataArray1D<double> * pSliceDataTemp = pSliceDataUpper;
+						pSliceDataUpper = pSliceDataLower;
+						pSliceDataLower = pSliceDataTemp;
+						continue;
+					}
+
 					// Load slice data
 					vecVarSlicePos[iVerticalDimIx] = l;
-					//for (int d = 0; d < nVarDims; d++) {
-					//	printf("%li %li;", vecVarSlicePos[d], vecVarSliceSize[d]);
-					//}
-					//printf("\n");
 
 					Announce("%s(%s%li/%li,%s)",
 						vecInputVariables[v].c_str(),
@@ -703,19 +750,22 @@ try {
 						&((*pSliceDataUpper)[0]),
 						&(vecVarSliceSize[0]));
 
-					if (l != lLevelBegin) {
-						for (int i = 0; i < nSpatialDOFs; i++) {
-							for (int k = 0; k < nValues; k++) {
-								if (nLevelIndexLower[i][k] == l-1) {
-									const double dWeight = dWeightLower[i][k];
-									if ((dWeight < 0.0) || (dWeight > 1.0)) {
-										printf("WARNING: %1.5e\n", dWeight);
-									}
-									dOutputData[k][i] =
-										dWeight * (*pSliceDataLower)[i]
-										+ (1.0 - dWeight) * (*pSliceDataUpper)[i];
-								}
+					if (fLowerUsed) {
+						const DataArray1D<double> & dSliceDataLower = *pSliceDataLower;
+						const DataArray1D<double> & dSliceDataUpper = *pSliceDataUpper;
+
+#pragma omp parallel for schedule(static)
+						for (long j = lLevelBucketBegin[l-1]; j < lLevelBucketBegin[l]; j++) {
+							const int i = static_cast<int>(lLevelBucketEntries[j] / nValues);
+							const int k = static_cast<int>(lLevelBucketEntries[j] % nValues);
+
+							const double dWeight = dWeightLower[i][k];
+							if ((dWeight < 0.0) || (dWeight > 1.0)) {
+								printf("WARNING: %1.5e\n", dWeight);
 							}
+							dOutputData[k][i] =
+								dWeight * dSliceDataLower[i]
+								+ (1.0 - dWeight) * dSliceDataUpper[i];
 						}
 					}
 
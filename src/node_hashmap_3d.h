@@ -0,0 +1,536 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    node_hashmap_3d.h
+///	\author  Paul Ullrich
+///	\version October 14, 2026
+///
+///	<remarks>
+///		Copyright 2026 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#ifndef _NODEHASHMAP3D_H_
+#define _NODEHASHMAP3D_H_
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A map from Nodes to data with floating point tolerance, stored as a
+///		spatial hash.  Space is divided into a uniform grid of cells and
+///		each value is entered in an open addressing table under the key of
+///		its cell.  Lookups probe every cell that could contain a Node within
+///		tolerance of the query, so two Nodes that compare equal are never
+///		both stored.  Values are stored and iterated in insertion order.
+///	</summary>
+template <
+	class NodeType,
+	class DataType
+> class node_hashmap_3d {
+public:
+	typedef std::pair<NodeType, DataType> value_type;
+
+	typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+	///	<summary>
+	///		Offset applied to each coordinate so that cell indices of points
+	///		on the unit sphere are positive.
+	///	</summary>
+	static constexpr double coordinate_offset = 2.123456789101112;
+
+	///	<summary>
+	///		Number of bits used for each cell index in a key.
+	///	</summary>
+	static const int key_bits = 21;
+
+private:
+	///	<summary>
+	///		A slot in the open addressing table.
+	///	</summary>
+	struct slot_type {
+		uint64_t key;
+		int ix;
+	};
+
+	///	<summary>
+	///		Index of an empty slot.
+	///	</summary>
+	static const int ix_empty = (-1);
+
+	///	<summary>
+	///		Initial number of slots in the table.
+	///	</summary>
+	static const size_t initial_slots = 1024;
+
+public:
+	///	<summary>
+	///		Constructor.  The cell width must be much larger than the
+	///		tolerance.  Cells whose indices agree modulo 2^key_bits share a
+	///		key, which only costs additional comparisons.
+	///	</summary>
+	node_hashmap_3d(
+		double tolerance = 1.0e-12,
+		double cell_width = 1.0e-3
+	) :
+		m_tolerance(tolerance),
+		m_inv_cell_width(1.0 / cell_width),
+		m_vecSlots(initial_slots),
+		m_mask(initial_slots - 1)
+	{
+		clear_slots();
+	}
+
+	///	<summary>
+	///		Begin const_iterator of this class.
+	///	</summary>
+	const_iterator begin() const {
+		return m_vecValues.begin();
+	}
+
+	///	<summary>
+	///		End const_iterator of this class.
+	///	</summary>
+	const_iterator end() const {
+		return m_vecValues.end();
+	}
+
+	///	<summary>
+	///		Number of Nodes stored in this object.
+	///	</summary>
+	size_t size() const {
+		return m_vecValues.size();
+	}
+
+	///	<summary>
+	///		Remove all Nodes from this object.
+	///	</summary>
+	void clear() {
+		m_vecValues.clear();
+		m_vecSlots.resize(initial_slots);
+		m_mask = initial_slots - 1;
+		clear_slots();
+	}
+
+	///	<summary>
+	///		Reserve space for the given number of Nodes.
+	///	</summary>
+	void reserve(
+		size_t n
+	) {
+		m_vecValues.reserve(n);
+		size_t nSlots = m_vecSlots.size();
+		while (nSlots < 2 * n) {
+			nSlots *= 2;
+		}
+		if (nSlots != m_vecSlots.size()) {
+			rehash(nSlots);
+		}
+	}
+
+	///	<summary>
+	///		Insert a given <NodeType, DataType> pair.  The caller is expected
+	///		to have verified with find() that the Node is not yet present.
+	///	</summary>
+	void insert(
+		const value_type & value
+	) {
+		if (2 * (m_vecValues.size() + 1) > m_vecSlots.size()) {
+			rehash(2 * m_vecSlots.size());
+		}
+
+		const int ix = static_cast<int>(m_vecValues.size());
+		m_vecValues.push_back(value);
+
+		int iCell[3];
+		cell_index(value.first, iCell);
+		insert_slot(cell_key(iCell[0], iCell[1], iCell[2]), ix);
+	}
+
+	///	<summary>
+	///		Find a given Node.  Returns end() if no Node within tolerance is
+	///		found.  Concurrent calls to find() are safe as long as no Nodes
+	///		are being inserted.
+	///	</summary>
+	const_iterator find(
+		const NodeType & node
+	) const {
+		int iBegin[3];
+		int iEnd[3];
+		cell_range(node, iBegin, iEnd);
+
+		for (int i = iBegin[0]; i <= iEnd[0]; i++) {
+		for (int j = iBegin[1]; j <= iEnd[1]; j++) {
+		for (int k = iBegin[2]; k <= iEnd[2]; k++) {
+			const uint64_t key = cell_key(i, j, k);
+
+			size_t s = slot_hash(key);
+			for (;; s = (s + 1) & m_mask) {
+				const slot_type & slot = m_vecSlots[s];
+				if (slot.ix == ix_empty) {
+					break;
+				}
+				if ((slot.key == key) && (m_vecValues[slot.ix].first == node)) {
+					return (m_vecValues.begin() + slot.ix);
+				}
+			}
+		}
+		}
+		}
+
+		return end();
+	}
+
+	///	<summary>
+	///		Cell index along one coordinate.
+	///	</summary>
+	inline int coordinate_cell(
+		double x
+	) const {
+		return static_cast<int>(floor((x + coordinate_offset) * m_inv_cell_width));
+	}
+
+	///	<summary>
+	///		Range of cells that may contain a Node within tolerance of the
+	///		given Node along one coordinate.
+	///	</summary>
+	inline void coordinate_cell_range(
+		double x,
+		int & iBegin,
+		int & iEnd
+	) const {
+		// Tolerance is doubled to absorb rounding in the cell computation
+		iBegin = coordinate_cell(x - 2.0 * m_tolerance);
+		iEnd = coordinate_cell(x + 2.0 * m_tolerance);
+	}
+
+private:
+	///	<summary>
+	///		Mark all slots as empty.
+	///	</summary>
+	void clear_slots() {
+		for (size_t s = 0; s < m_vecSlots.size(); s++) {
+			m_vecSlots[s].key = 0;
+			m_vecSlots[s].ix = ix_empty;
+		}
+	}
+
+	///	<summary>
+	///		Cell index of a Node.
+	///	</summary>
+	inline void cell_index(
+		const NodeType & node,
+		int iCell[3]
+	) const {
+		iCell[0] = coordinate_cell(node.x);
+		iCell[1] = coordinate_cell(node.y);
+		iCell[2] = coordinate_cell(node.z);
+	}
+
+	///	<summary>
+	///		Range of cells that may contain a Node within tolerance of the
+	///		given Node.
+	///	</summary>
+	inline void cell_range(
+		const NodeType & node,
+		int iBegin[3],
+		int iEnd[3]
+	) const {
+		coordinate_cell_range(node.x, iBegin[0], iEnd[0]);
+		coordinate_cell_range(node.y, iBegin[1], iEnd[1]);
+		coordinate_cell_range(node.z, iBegin[2], iEnd[2]);
+	}
+
+	///	<summary>
+	///		Key of the cell with given indices.
+	///	</summary>
+	inline uint64_t cell_key(
+		int i,
+		int j,
+		int k
+	) const {
+		static const uint64_t key_mask = (static_cast<uint64_t>(1) << key_bits) - 1;
+		return
+			  (static_cast<uint64_t>(i) & key_mask)
+			| ((static_cast<uint64_t>(j) & key_mask) << key_bits)
+			| ((static_cast<uint64_t>(k) & key_mask) << (2 * key_bits));
+	}
+
+	///	<summary>
+	///		Initial slot for a given key.
+	///	</summary>
+	inline size_t slot_hash(
+		uint64_t key
+	) const {
+		return static_cast<size_t>(
+			(key * static_cast<uint64_t>(0x9E3779B97F4A7C15ULL)) >> 20) & m_mask;
+	}
+
+	///	<summary>
+	///		Insert a key into the first free slot of its probe sequence.
+	///	</summary>
+	void insert_slot(
+		uint64_t key,
+		int ix
+	) {
+		size_t s = slot_hash(key);
+		while (m_vecSlots[s].ix != ix_empty) {
+			s = (s + 1) & m_mask;
+		}
+		m_vecSlots[s].key = key;
+		m_vecSlots[s].ix = ix;
+	}
+
+	///	<summary>
+	///		Resize the table and reinsert all values.
+	///	</summary>
+	void rehash(
+		size_t nSlots
+	) {
+		m_vecSlots.resize(nSlots);
+		m_mask = nSlots - 1;
+		clear_slots();
+
+		for (size_t ix = 0; ix < m_vecValues.size(); ix++) {
+			int iCell[3];
+			cell_index(m_vecValues[ix].first, iCell);
+			insert_slot(
+				cell_key(iCell[0], iCell[1], iCell[2]),
+				static_cast<int>(ix));
+		}
+	}
+
+private:
+	///	<summary>
+	///		The internal floating point tolerance for comparing two Nodes.
+	///	</summary>
+	const double m_tolerance;
+
+	///	<summary>
+	///		Inverse of the width of each cell.
+	///	</summary>
+	const double m_inv_cell_width;
+
+	///	<summary>
+	///		Values in insertion order.
+	///	</summary>
+	std::vector<value_type> m_vecValues;
+
+	///	<summary>
+	///		Open addressing table of slots.
+	///	</summary>
+	std::vector<slot_type> m_vecSlots;
+
+	///	<summary>
+	///		Mask applied to slot indices (number of slots minus one).
+	///	</summary>
+	size_t m_mask;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A set of Nodes with floating point tolerance that may be updated
+///		concurrently from multiple threads.  Space is divided into slabs of
+///		cells along the x coordinate, and slabs are distributed over shards
+///		that each hold a node_hashmap_3d protected by a mutex.  A query
+///		within tolerance of a slab boundary locks both adjacent shards.
+///
+///		Each Node is inserted with a priority.  Since the order in which
+///		threads reach the set is not deterministic, Nodes are identified by
+///		a provisional index until assign_indices() numbers them in order of
+///		the lowest priority of any coincident insertion, using the
+///		coordinates of that insertion.
+///	</summary>
+template <
+	class NodeType
+> class node_hashmap_3d_concurrent {
+
+public:
+	///	<summary>
+	///		Default number of shards.
+	///	</summary>
+	static const int default_shards = 64;
+
+private:
+	///	<summary>
+	///		A shard of the set.  Each stored Node is mapped to its
+	///		provisional index, with the lowest priority it was inserted with
+	///		and the coordinates of that insertion.
+	///	</summary>
+	struct shard_type {
+		shard_type(
+			double tolerance,
+			double cell_width
+		) :
+			map(tolerance, cell_width)
+		{ }
+
+		node_hashmap_3d<NodeType, int> map;
+		std::vector<uint64_t> vecPriority;
+		std::vector<NodeType> vecNodes;
+		std::mutex lock;
+	};
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	node_hashmap_3d_concurrent(
+		double tolerance = 1.0e-12,
+		double cell_width = 1.0e-3,
+		int shards = default_shards
+	) :
+		m_next_index(0)
+	{
+		for (int s = 0; s < shards; s++) {
+			m_vecShards.push_back(
+				std::unique_ptr<shard_type>(
+					new shard_type(tolerance, cell_width)));
+		}
+	}
+
+	///	<summary>
+	///		Number of Nodes stored in this object.
+	///	</summary>
+	size_t size() const {
+		return static_cast<size_t>(m_next_index.load());
+	}
+
+	///	<summary>
+	///		Find a given Node, inserting it if no Node within tolerance is
+	///		present, and return its provisional index.
+	///	</summary>
+	int find_or_insert(
+		const NodeType & node,
+		uint64_t priority
+	) {
+		const node_hashmap_3d<NodeType, int> & mapFirst = m_vecShards[0]->map;
+
+		int iBegin;
+		int iEnd;
+		mapFirst.coordinate_cell_range(node.x, iBegin, iEnd);
+
+		const int sHome = shard_index(mapFirst.coordinate_cell(node.x));
+		const int sBegin = shard_index(iBegin);
+		const int sEnd = shard_index(iEnd);
+
+		// Lock in ascending order to avoid deadlock
+		const int sLow = std::min(sBegin, sEnd);
+		const int sHigh = std::max(sBegin, sEnd);
+
+		std::unique_lock<std::mutex> lockLow(m_vecShards[sLow]->lock);
+		std::unique_lock<std::mutex> lockHigh;
+		if (sHigh != sLow) {
+			lockHigh = std::unique_lock<std::mutex>(m_vecShards[sHigh]->lock);
+		}
+
+		for (int s = sLow; ; s = sHigh) {
+			shard_type & shard = *(m_vecShards[s]);
+
+			typename node_hashmap_3d<NodeType, int>::const_iterator iter =
+				shard.map.find(node);
+
+			if (iter != shard.map.end()) {
+				const size_t ix = iter - shard.map.begin();
+				if (priority < shard.vecPriority[ix]) {
+					shard.vecPriority[ix] = priority;
+					shard.vecNodes[ix] = node;
+				}
+				return iter->second;
+			}
+
+			if (s == sHigh) {
+				break;
+			}
+		}
+
+		shard_type & shard = *(m_vecShards[sHome]);
+
+		const int ixNew = m_next_index++;
+		shard.map.insert(std::pair<NodeType, int>(node, ixNew));
+		shard.vecPriority.push_back(priority);
+		shard.vecNodes.push_back(node);
+
+		return ixNew;
+	}
+
+	///	<summary>
+	///		Number the stored Nodes in order of priority.  On return vecNodes
+	///		contains each Node at its final index and vecIndex maps each
+	///		provisional index to its final index.  No Nodes may be inserted
+	///		concurrently.
+	///	</summary>
+	void assign_indices(
+		std::vector<NodeType> & vecNodes,
+		std::vector<int> & vecIndex
+	) const {
+		const int nNodes = static_cast<int>(size());
+
+		std::vector< std::pair<uint64_t, int> > vecOrder(nNodes);
+		vecNodes.resize(nNodes);
+
+		for (size_t s = 0; s < m_vecShards.size(); s++) {
+			const shard_type & shard = *(m_vecShards[s]);
+
+			typename node_hashmap_3d<NodeType, int>::const_iterator iter =
+				shard.map.begin();
+			for (size_t ix = 0; iter != shard.map.end(); iter++, ix++) {
+				vecOrder[iter->second] =
+					std::pair<uint64_t, int>(shard.vecPriority[ix], iter->second);
+				vecNodes[iter->second] = shard.vecNodes[ix];
+			}
+		}
+
+		std::sort(vecOrder.begin(), vecOrder.end());
+
+		std::vector<NodeType> vecUnsortedNodes;
+		vecUnsortedNodes.swap(vecNodes);
+
+		vecNodes.resize(nNodes);
+		vecIndex.resize(nNodes);
+		for (int i = 0; i < nNodes; i++) {
+			vecIndex[vecOrder[i].second] = i;
+			vecNodes[i] = vecUnsortedNodes[vecOrder[i].second];
+		}
+	}
+
+private:
+	///	<summary>
+	///		Shard containing a given cell along the x coordinate.
+	///	</summary>
+	inline int shard_index(
+		int iCell
+	) const {
+		const int nShards = static_cast<int>(m_vecShards.size());
+		return ((iCell % nShards) + nShards) % nShards;
+	}
+
+private:
+	///	<summary>
+	///		Shards of the set.
+	///	</summary>
+	std::vector< std::unique_ptr<shard_type> > m_vecShards;
+
+	///	<summary>
+	///		Next provisional index.
+	///	</summary>
+	std::atomic<int> m_next_index;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif //_NODEHASHMAP3D_H_
+